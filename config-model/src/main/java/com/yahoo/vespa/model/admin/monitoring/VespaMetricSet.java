@@ -232,6 +232,18 @@ public class VespaMetricSet {
         metrics.add(new Metric("content.proton.documentdb.threading_service.index_field_inverter.maxpending.last"));
         metrics.add(new Metric("content.proton.documentdb.threading_service.index_field_writer.maxpending.last"));
         metrics.add(new Metric("content.proton.documentdb.threading_service.attribute_field_writer.maxpending.last"));
+        metrics.add(new Metric("content.proton.documentdb.threading_service.master.utilization.last"));
+        metrics.add(new Metric("content.proton.documentdb.threading_service.index.utilization.last"));
+        metrics.add(new Metric("content.proton.documentdb.threading_service.summary.utilization.last"));
+        metrics.add(new Metric("content.proton.documentdb.threading_service.index_field_inverter.utilization.last"));
+        metrics.add(new Metric("content.proton.documentdb.threading_service.index_field_writer.utilization.last"));
+        metrics.add(new Metric("content.proton.documentdb.threading_service.attribute_field_writer.utilization.last"));
+        metrics.add(new Metric("content.proton.documentdb.threading_service.master.wait_time.last"));
+        metrics.add(new Metric("content.proton.documentdb.threading_service.index.wait_time.last"));
+        metrics.add(new Metric("content.proton.documentdb.threading_service.summary.wait_time.last"));
+        metrics.add(new Metric("content.proton.documentdb.threading_service.index_field_inverter.wait_time.last"));
+        metrics.add(new Metric("content.proton.documentdb.threading_service.index_field_writer.wait_time.last"));
+        metrics.add(new Metric("content.proton.documentdb.threading_service.attribute_field_writer.wait_time.last"));
 
         // lid space
         metrics.add(new Metric("content.proton.documentdb.ready.lid_space.lid_bloat_factor.average"));
@@ -421,4 +421,19 @@ TEST_F("require that empty v3 reponse is correctly initialized", V3RequestFixtur
     f1.assertResponse(*response, "defaultBar");
 }
 
+TEST_FF("require that v3 responses with equal config md5 share decoded payload", V3RequestFixture(), V3RequestFixture()) {
+    const char *payload = "{\"barValue\":\"foobiar\"}";
+    f1.encodePayload(payload, strlen(payload), strlen(payload), CompressionType::UNCOMPRESSED);
+    f2.encodePayload(payload, strlen(payload), strlen(payload), CompressionType::UNCOMPRESSED);
+    std::unique_ptr<FRTConfigResponseV3> response1(f1.createResponse());
+    std::unique_ptr<FRTConfigResponseV3> response2(f2.createResponse());
+    ASSERT_TRUE(response1->validateResponse());
+    ASSERT_TRUE(response2->validateResponse());
+    response1->fill();
+    response2->fill();
+    EXPECT_TRUE(response1->getValue().getPayload().get() != nullptr);
+    EXPECT_TRUE(response1->getValue().getPayload().get() == response2->getValue().getPayload().get());
+    f2.assertResponse(*response2, "foobiar");
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -37,6 +37,7 @@ public:
     std::vector<vespalib::string> getLegacyFormat() const;
     const vespalib::string asJson() const;
     const vespalib::string getMd5() const { return _md5sum; }
+    const PayloadPtr & getPayload() const { return _payload; }
 
     void serializeV1(::vespalib::slime::Cursor & cursor) const;
     void serializeV2(::vespalib::slime::Cursor & cursor) const;
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "frtconfigresponsev3.h"
 #include "compressioninfo.h"
+#include "payloadcache.h"
 #include <vespa/fnet/frt/frt.h>
 
 #include <vespa/log/log.h>
@@ -53,6 +54,18 @@ const ConfigValue
 FRTConfigResponseV3::readConfigValue() const
 {
     vespalib::string md5(_data->get()[RESPONSE_CONFIG_MD5].asString().make_string());
+    // Subscribers to the same config share the decoded payload, so that it
+    // is only decoded and held once per process.
+    vespalib::string cacheKey;
+    if ( ! md5.empty()) {
+        const ConfigKey & key(getKey());
+        cacheKey = PayloadCache::makeKey(key.getDefNamespace(), key.getDefName(), key.getDefMd5(), md5);
+        PayloadPtr cached(PayloadCache::instance().lookup(cacheKey));
+        if (cached) {
+            LOG(spam, "reusing decoded config value md5(%s)", md5.c_str());
+            return ConfigValue(cached, md5);
+        }
+    }
     CompressionInfo info;
     info.deserialize(_data->get()[RESPONSE_COMPRESSION_INFO]);
     Slime * rawData = new Slime();
@@ -69,7 +82,11 @@ FRTConfigResponseV3::readConfigValue() const
     if (LOG_WOULD_LOG(spam)) {
         LOG(spam, "read config value md5(%s), payload size: %lu", md5.c_str(), data.memRef.size);
     }
-    return ConfigValue(PayloadPtr(new V3Payload(payloadData)), md5);
+    PayloadPtr payload(new V3Payload(payloadData));
+    if ( ! cacheKey.empty()) {
+        payload = PayloadCache::instance().insert(cacheKey, payload);
+    }
+    return ConfigValue(payload, md5);
 }
 
 } // namespace config
@@ -0,0 +1,79 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "payloadcache.h"
+#include <algorithm>
+
+namespace config {
+
+PayloadCache::PayloadCache()
+    : _lock(),
+      _payloads(),
+      _expireCheckLimit(16)
+{
+}
+
+PayloadCache::~PayloadCache() = default;
+
+PayloadCache &
+PayloadCache::instance()
+{
+    static PayloadCache cache;
+    return cache;
+}
+
+vespalib::string
+PayloadCache::makeKey(const vespalib::string & defNamespace, const vespalib::string & defName,
+                      const vespalib::string & defMd5, const vespalib::string & configMd5)
+{
+    vespalib::string key(defNamespace);
+    key.append('.').append(defName).append(':').append(defMd5).append('@').append(configMd5);
+    return key;
+}
+
+PayloadPtr
+PayloadCache::lookup(const vespalib::string & key) const
+{
+    vespalib::LockGuard guard(_lock);
+    auto found = _payloads.find(key);
+    if (found == _payloads.end()) {
+        return PayloadPtr();
+    }
+    return found->second.lock();
+}
+
+PayloadPtr
+PayloadCache::insert(const vespalib::string & key, const PayloadPtr & payload)
+{
+    vespalib::LockGuard guard(_lock);
+    std::weak_ptr<const protocol::Payload> & entry(_payloads[key]);
+    PayloadPtr existing(entry.lock());
+    if (existing) {
+        return existing;
+    }
+    entry = payload;
+    if (_payloads.size() >= _expireCheckLimit) {
+        removeExpired();
+        _expireCheckLimit = std::max(size_t(16), _payloads.size() * 2);
+    }
+    return payload;
+}
+
+void
+PayloadCache::removeExpired()
+{
+    for (auto it = _payloads.begin(); it != _payloads.end();) {
+        if (it->second.expired()) {
+            it = _payloads.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+size_t
+PayloadCache::size() const
+{
+    vespalib::LockGuard guard(_lock);
+    return _payloads.size();
+}
+
+}
@@ -0,0 +1,49 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/config/common/configvalue.h>
+#include <vespa/vespalib/util/sync.h>
+#include <map>
+
+namespace config {
+
+/**
+ * Process wide cache of decoded config payloads, keyed on config definition
+ * and config md5. Subscribers to the same config in a process share a single
+ * decoded payload instead of each decoding their own copy. Entries are only
+ * kept alive by the config values referencing them.
+ */
+class PayloadCache {
+public:
+    PayloadCache();
+    ~PayloadCache();
+
+    static PayloadCache & instance();
+
+    /**
+     * Returns the cached payload for the given key, or an empty pointer if
+     * no config value currently references it.
+     */
+    PayloadPtr lookup(const vespalib::string & key) const;
+
+    /**
+     * Inserts the given payload, unless another payload was inserted for the
+     * same key in the meantime. Returns the payload that should be used.
+     */
+    PayloadPtr insert(const vespalib::string & key, const PayloadPtr & payload);
+
+    size_t size() const;
+
+    static vespalib::string makeKey(const vespalib::string & defNamespace, const vespalib::string & defName,
+                                    const vespalib::string & defMd5, const vespalib::string & configMd5);
+private:
+    using PayloadMap = std::map<vespalib::string, std::weak_ptr<const protocol::Payload>>;
+
+    void removeExpired();
+
+    vespalib::Lock _lock;
+    PayloadMap     _payloads;
+    size_t         _expireCheckLimit;
+};
+
+}
@@ -33,6 +33,7 @@ struct FieldPathUpdateTestCase : public CppUnit::TestFixture {
     void tearDown() override;
 
     void testWhereClause();
+    void testCompiledPathsAreReused();
     void testNoIterateMapValues();
     void testRemoveField();
     void testApplyRemoveEntireListField();
@@ -72,6 +73,7 @@ struct FieldPathUpdateTestCase : public CppUnit::TestFixture {
 
     CPPUNIT_TEST_SUITE(FieldPathUpdateTestCase);
     CPPUNIT_TEST(testWhereClause);
+    CPPUNIT_TEST(testCompiledPathsAreReused);
     CPPUNIT_TEST(testNoIterateMapValues);
     CPPUNIT_TEST(testRemoveField);
     CPPUNIT_TEST(testApplyRemoveEntireListField);
@@ -353,6 +355,23 @@ FieldPathUpdateTestCase::testWhereClause()
     CPPUNIT_ASSERT_EQUAL(std::string("dicaprio"), update._str);
 }
 
+void
+FieldPathUpdateTestCase::testCompiledPathsAreReused()
+{
+    DocumentTypeRepo repo(getRepoConfig());
+    Document::UP doc1(createTestDocument(repo));
+    Document::UP doc2(createTestDocument(repo));
+    std::string where = "test.l1s1.structmap.value.smap{$x} == \"dicaprio\"";
+    TestFieldPathUpdate update("l1s1.structmap.value.smap{$x}", where);
+    update.applyTo(*doc1);
+    update.applyTo(*doc2);
+    CPPUNIT_ASSERT_EQUAL(std::string("dicaprio;dicaprio"), update._str);
+
+    TestFieldPathUpdate copy(update);
+    copy.applyTo(*doc1);
+    CPPUNIT_ASSERT_EQUAL(std::string("dicaprio"), copy._str);
+}
+
 void
 FieldPathUpdateTestCase::testNoIterateMapValues()
 {
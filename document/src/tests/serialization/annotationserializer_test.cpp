@@ -3,10 +3,12 @@
 #include <vespa/document/base/testdocrepo.h>
 #include <vespa/document/annotation/alternatespanlist.h>
 #include <vespa/document/annotation/annotation.h>
+#include <vespa/document/annotation/spanlist.h>
 #include <vespa/document/annotation/spantree.h>
 #include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/document/serialization/annotationdeserializer.h>
 #include <vespa/document/serialization/annotationserializer.h>
+#include <vespa/document/serialization/flatannotationreader.h>
 #include <vespa/document/serialization/vespadocumentdeserializer.h>
 #include <vespa/document/serialization/vespadocumentserializer.h>
 #include <vespa/document/repo/documenttyperepo.h>
@@ -34,6 +36,7 @@ class Test : public vespalib::TestApp {
     void requireThatAdvancedSpanTreeIsDeserialized();
     void requireThatSpanTreeCanBeSerialized();
     void requireThatUnknownAnnotationIsSkipped();
+    void requireThatFlatAnnotationReaderReadsTermAnnotations();
 
 public:
     int Main() override;
@@ -48,6 +51,7 @@ Test::Main()
     TEST_DO(requireThatAdvancedSpanTreeIsDeserialized());
     TEST_DO(requireThatSpanTreeCanBeSerialized());
     TEST_DO(requireThatUnknownAnnotationIsSkipped());
+    TEST_DO(requireThatFlatAnnotationReaderReadsTermAnnotations());
 
     TEST_DONE();
 }
@@ -267,6 +271,46 @@ void Test::requireThatUnknownAnnotationIsSkipped() {
     EXPECT_EQUAL(0u, stream.size());
 }
 
+void Test::requireThatFlatAnnotationReaderReadsTermAnnotations() {
+    SpanList::UP root(new SpanList);
+    const Span &foo = root->add(std::make_unique<Span>(0, 3));
+    const Span &bar = root->add(std::make_unique<Span>(4, 3));
+    SpanList &baz = root->add(std::make_unique<SpanList>());
+    baz.add(std::make_unique<Span>(8, 1));
+    baz.add(std::make_unique<Span>(9, 2));
+    SpanTree::UP tree(new SpanTree("linguistics", std::move(root)));
+    tree->annotate(foo, *AnnotationType::TERM);
+    tree->annotate(foo, *AnnotationType::TOKEN_TYPE);
+    tree->annotate(bar, std::make_unique<Annotation>(*AnnotationType::TERM,
+                                                     std::make_unique<StringFieldValue>("BAR")));
+    tree->annotate(baz, *AnnotationType::TERM);
+    tree->annotate(std::make_unique<Annotation>(*AnnotationType::TERM));
+
+    StringFieldValue::SpanTrees trees;
+    trees.push_back(std::move(tree));
+    DocumentTypeRepo type_repo;
+    FixedTypeRepo repo(type_repo);
+    StringFieldValue value("foo bar baz");
+    value.setSpanTrees(trees, repo);
+
+    FlatAnnotationReader reader;
+    EXPECT_FALSE(reader.read(StringFieldValue("foo"), "linguistics", AnnotationType::TERM->getId()));
+    EXPECT_FALSE(reader.read(value, "other", AnnotationType::TERM->getId()));
+    ASSERT_TRUE(reader.read(value, "linguistics", AnnotationType::TERM->getId()));
+    const auto &entries = reader.entries();
+    ASSERT_EQUAL(3u, entries.size());
+    EXPECT_EQUAL(0, entries[0].from);
+    EXPECT_EQUAL(3, entries[0].length);
+    EXPECT_FALSE(entries[0].hasValue);
+    EXPECT_EQUAL(4, entries[1].from);
+    EXPECT_EQUAL(3, entries[1].length);
+    EXPECT_TRUE(entries[1].hasValue);
+    EXPECT_EQUAL("BAR", entries[1].value);
+    EXPECT_EQUAL(8, entries[2].from);
+    EXPECT_EQUAL(3, entries[2].length);
+    EXPECT_FALSE(entries[2].hasValue);
+}
+
 }  // namespace
 
 TEST_APPHOOK(Test);
@@ -580,6 +580,38 @@ TEST("requireThatDocumentCanBeSerialized") {
     EXPECT_EQUAL(0, read_version);
 }
 
+TEST("requireThatDocumentCanBeDeserializedWithOnlyTheFieldsInFieldSet") {
+    const DocumentType &type = repo.getDocumentType();
+    const Field &header_field = type.getField("header field");
+    const Field &body_field = type.getField("body field");
+
+    Document value(type, DocumentId("doc::testdoc"));
+    value.setValue(header_field, IntFieldValue(42));
+    value.setValue(body_field, StringFieldValue("foobar"));
+    nbostream stream;
+    VespaDocumentSerializer serializer(stream);
+    serializer.write(value, COMPLETE);
+
+    Document read_value;
+    VespaDocumentDeserializer deserializer(repo, stream, serialization_version);
+    deserializer.setFieldSet(body_field);
+    deserializer.read(read_value);
+    EXPECT_EQUAL(0u, stream.size());
+    EXPECT_FALSE(read_value.hasValue(header_field));
+    ASSERT_TRUE(read_value.hasValue(body_field));
+    EXPECT_EQUAL(StringFieldValue("foobar"), *read_value.getValue(body_field));
+
+    Document expected(type, DocumentId("doc::testdoc"));
+    expected.setValue(body_field, StringFieldValue("foobar"));
+    nbostream reserialized;
+    VespaDocumentSerializer reserializer(reserialized);
+    reserializer.write(read_value, COMPLETE);
+    Document reread;
+    VespaDocumentDeserializer rereader(repo, reserialized, serialization_version);
+    rereader.read(reread);
+    EXPECT_EQUAL(expected, reread);
+}
+
 TEST("requireThatOldVersionDocumentCanBeDeserialized") {
     uint16_t old_version = 6;
     uint16_t data_size = 432;
@@ -166,18 +166,7 @@ FieldSet::stripFields(Document& doc,
         doc.clear();
         return;
     }
-    std::vector<const Field*> fieldsToRemove;
-    for (Document::const_iterator it(doc.begin()), e(doc.end());
-         it != e; ++it)
-    {
-        const Field& f(it.field());
-        if (!fieldsToKeep.contains(f)) {
-            fieldsToRemove.push_back(&f);
-        }
-    }
-    for (size_t i = 0; i < fieldsToRemove.size(); ++i) {
-        doc.remove(*fieldsToRemove[i]);
-    }
+    doc.getFields().retainFields(fieldsToKeep);
 }
 
 } // namespace document
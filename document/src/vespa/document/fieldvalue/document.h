@@ -118,6 +118,8 @@ public:
     /** Deserialize document contained in given bytebuffer. */
     void deserialize(const DocumentTypeRepo& repo, ByteBuffer& data);
     void deserialize(const DocumentTypeRepo& repo, vespalib::nbostream & os);
+    /** Deserialize document, keeping only the fields in the given field set. */
+    void deserialize(const DocumentTypeRepo& repo, vespalib::nbostream & os, const FieldSet & fields);
     /** Deserialize document contained in given bytebuffers. */
     void deserialize(const DocumentTypeRepo& repo, ByteBuffer& body, ByteBuffer& header);
     void deserializeHeader(const DocumentTypeRepo& repo, ByteBuffer& header);
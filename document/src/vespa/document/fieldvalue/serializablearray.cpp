@@ -178,6 +178,20 @@ SerializableArray::clear(int id)
     }
 }
 
+void
+SerializableArray::retain(const std::vector<int> & sortedIds)
+{
+    size_t kept = 0;
+    for (const Entry & entry : _entries) {
+        if (std::binary_search(sortedIds.begin(), sortedIds.end(), entry.id())) {
+            _entries[kept++] = entry;
+        } else if (_owned) {
+            _owned->erase(entry.id());
+        }
+    }
+    _entries.resize(kept);
+}
+
 void
 SerializableArray::deCompress() // throw (DeserializeException)
 {
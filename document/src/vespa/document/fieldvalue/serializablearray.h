@@ -151,6 +151,13 @@ public:
      */
     void clear(int id);
 
+    /**
+     * Drops all entries whose id is not in the given sorted list. Unlike
+     * clear(id) this neither decompresses nor touches the content of the
+     * remaining entries.
+     */
+    void retain(const std::vector<int> & sortedIds);
+
     /** Deletes all stored attributes. */
     void clear();
 
@@ -158,6 +158,31 @@ StructFieldValue::getRawFieldIds(vector<int> &raw_ids,
     raw_ids.erase(unique(raw_ids.begin(), raw_ids.end()), raw_ids.end());
 }
 
+void
+StructFieldValue::retainFields(const FieldSet& fieldSet)
+{
+    const StructDataType & type = getStructType();
+    vector<int> ids;
+    size_t count(0);
+    for (uint32_t i = 0; i < _chunks.size(); ++i) {
+        const SerializableArray::EntryMap & entries = _chunks[i].getEntries();
+        count += entries.size();
+        for (const SerializableArray::Entry & entry : entries) {
+            if (type.hasField(entry.id()) && fieldSet.contains(type.getField(entry.id()))) {
+                ids.push_back(entry.id());
+            }
+        }
+    }
+    if (ids.size() == count) {
+        return;
+    }
+    sort(ids.begin(), ids.end());
+    for (uint32_t i = 0; i < _chunks.size(); ++i) {
+        _chunks[i].retain(ids);
+    }
+    _hasChanged = true;
+}
+
 bool
 StructFieldValue::hasField(const vespalib::stringref & name) const
 {
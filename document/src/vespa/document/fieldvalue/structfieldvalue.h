@@ -80,6 +80,13 @@ public:
     void getRawFieldIds(std::vector<int> &raw_ids) const;
     void getRawFieldIds(std::vector<int> &raw_ids, const FieldSet& fieldSet) const;
 
+    /**
+     * Removes all fields not in the given field set. Only the field
+     * info is filtered; no field is deserialized and compressed
+     * content stays compressed until a kept field is accessed.
+     */
+    void retainFields(const FieldSet& fieldSet);
+
     void accept(FieldValueVisitor &visitor) override { visitor.visit(*this); }
     void accept(ConstFieldValueVisitor &visitor) const override { visitor.visit(*this); }
 
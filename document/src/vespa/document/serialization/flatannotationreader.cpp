@@ -0,0 +1,154 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "flatannotationreader.h"
+#include "util.h"
+#include <vespa/document/datatype/datatype.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <limits>
+
+using vespalib::nbostream;
+using vespalib::stringref;
+
+namespace document {
+
+namespace {
+
+// Skips a serialized string field value, returning the string.
+stringref
+readString(nbostream &stream)
+{
+    uint8_t coding = readValue<uint8_t>(stream);
+    size_t size = getInt1_4Bytes(stream);
+    stringref value(stream.peek(), (size > 0) ? size - 1 : 0);
+    stream.adjustReadPos(size);
+    if (coding & 0x40) {  // nested annotations
+        stream.adjustReadPos(readValue<uint32_t>(stream));
+    }
+    return value;
+}
+
+}  // namespace
+
+void
+FlatAnnotationReader::Extent::add(const Extent &rhs)
+{
+    begin = std::min(begin, rhs.begin);
+    end = std::max(end, rhs.end);
+}
+
+FlatAnnotationReader::FlatAnnotationReader()
+    : _nodes(),
+      _entries(),
+      _supported(true)
+{
+}
+
+FlatAnnotationReader::~FlatAnnotationReader() = default;
+
+bool
+FlatAnnotationReader::read(const StringFieldValue &value, stringref treeName, uint32_t annotationTypeId)
+{
+    _entries.clear();
+    if (!value.hasSpanTrees()) {
+        return false;
+    }
+    vespalib::ConstBufferRef serialized = value.getSerializedAnnotations();
+    nbostream stream(serialized.data(), serialized.size());
+    _supported = true;
+    uint32_t treeCount = getInt1_2_4Bytes(stream);
+    for (uint32_t i = 0; i < treeCount; ++i) {
+        bool wanted = readTreeName(stream, treeName);
+        _nodes.clear();
+        readSpanNode(stream);
+        if (!_supported || !readAnnotations(stream, annotationTypeId, wanted)) {
+            _entries.clear();
+            return false;
+        }
+        if (wanted) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+FlatAnnotationReader::readTreeName(nbostream &stream, stringref treeName)
+{
+    return (readString(stream) == treeName);
+}
+
+FlatAnnotationReader::Extent
+FlatAnnotationReader::readSpanNode(nbostream &stream)
+{
+    uint8_t type = readValue<uint8_t>(stream);
+    // Nodes are numbered in the order they are serialized, parents first.
+    size_t nodeId = _nodes.size();
+    _nodes.push_back(Extent{std::numeric_limits<int32_t>::max(), -1});
+    Extent extent{std::numeric_limits<int32_t>::max(), -1};
+    if (type == 1) {  // Span.ID
+        int32_t from = getInt1_2_4Bytes(stream);
+        int32_t length = getInt1_2_4Bytes(stream);
+        extent = Extent{from, from + length};
+    } else if (type == 2) {  // SpanList.ID
+        extent = readSpanList(stream);
+    } else if (type == 4) {  // AlternateSpanList.ID
+        uint32_t treeCount = getInt1_2_4Bytes(stream);
+        for (uint32_t i = 0; i < treeCount; ++i) {
+            readValue<double>(stream);  // probability
+            extent.add(readSpanList(stream));
+        }
+    } else {
+        _supported = false;
+    }
+    _nodes[nodeId] = extent;
+    return extent;
+}
+
+FlatAnnotationReader::Extent
+FlatAnnotationReader::readSpanList(nbostream &stream)
+{
+    Extent extent{std::numeric_limits<int32_t>::max(), -1};
+    uint32_t childCount = getInt1_2_4Bytes(stream);
+    for (uint32_t i = 0; _supported && (i < childCount); ++i) {
+        extent.add(readSpanNode(stream));
+    }
+    return extent;
+}
+
+bool
+FlatAnnotationReader::readAnnotations(nbostream &stream, uint32_t annotationTypeId, bool keep)
+{
+    uint32_t annotationCount = getInt1_2_4Bytes(stream);
+    if (keep) {
+        _entries.reserve(annotationCount);
+    }
+    for (uint32_t i = 0; i < annotationCount; ++i) {
+        uint32_t typeId = readValue<uint32_t>(stream);
+        uint8_t features = readValue<uint8_t>(stream);
+        uint32_t size = getInt1_2_4Bytes(stream);
+        size_t left = stream.size() - size;
+        if (!keep || (typeId != annotationTypeId) || !(features & 1)) {
+            stream.adjustReadPos(size);
+            continue;
+        }
+        uint32_t nodeId = getInt1_2_4Bytes(stream);
+        if (nodeId >= _nodes.size()) {
+            return false;
+        }
+        const Extent &extent = _nodes[nodeId];
+        Entry entry{extent.begin, extent.end - extent.begin, stringref(), false};
+        if (features & 2) {  // has value
+            if (readValue<uint32_t>(stream) != DataType::T_STRING) {
+                return false;
+            }
+            entry.value = readString(stream);
+            entry.hasValue = true;
+        }
+        stream.adjustReadPos(stream.size() - left);
+        _entries.push_back(entry);
+    }
+    return true;
+}
+
+}  // namespace document
@@ -0,0 +1,65 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <vector>
+
+namespace vespalib { class nbostream; }
+
+namespace document {
+
+class StringFieldValue;
+
+/**
+ * Reads the annotations of one type in one span tree of a string
+ * field value straight from their serialized form, without building
+ * span nodes, annotations or field values. Each annotation with a
+ * span node becomes a flat entry holding the extent of the span node
+ * and a reference to its string value, if it has one. The vectors are
+ * reused between values, so no allocation is done once they have
+ * grown large enough.
+ *
+ * Value references point into the serialized annotations of the
+ * string field value, and are valid as long as it is not modified.
+ **/
+class FlatAnnotationReader {
+public:
+    struct Entry {
+        int32_t             from;
+        int32_t             length;
+        vespalib::stringref value;
+        bool                hasValue;
+    };
+
+    FlatAnnotationReader();
+    ~FlatAnnotationReader();
+
+    /**
+     * Reads the annotations of the given type in the named span tree.
+     * Returns false when the value has no such tree, or when the tree
+     * uses something the flat form can not represent (annotation
+     * values that are not strings); the caller should then use the
+     * span tree API instead.
+     **/
+    bool read(const StringFieldValue &value, vespalib::stringref treeName, uint32_t annotationTypeId);
+    const std::vector<Entry> &entries() const { return _entries; }
+
+private:
+    struct Extent {
+        int32_t begin;
+        int32_t end;
+        void add(const Extent &rhs);
+    };
+
+    bool readTreeName(vespalib::nbostream &stream, vespalib::stringref treeName);
+    Extent readSpanNode(vespalib::nbostream &stream);
+    Extent readSpanList(vespalib::nbostream &stream);
+    bool readAnnotations(vespalib::nbostream &stream, uint32_t annotationTypeId, bool keep);
+
+    std::vector<Extent> _nodes;    // indexed by span node id
+    std::vector<Entry>  _entries;
+    bool                _supported;
+};
+
+}  // namespace document
@@ -19,6 +19,8 @@
 #include <vespa/document/fieldvalue/tensorfieldvalue.h>
 #include <vespa/document/fieldvalue/referencefieldvalue.h>
 #include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/datatype/structdatatype.h>
+#include <vespa/document/fieldset/fieldset.h>
 #include <vespa/vespalib/data/slime/binary_format.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/stllike/asciistream.h>
@@ -93,7 +95,7 @@ void VespaDocumentDeserializer::readDocument(Document &value) {
     uint32_t chunkCount = getChunkCount(content_code);
     value.getFields().reset();
     for (uint32_t i = 0; i < chunkCount; ++i) {
-        readStructNoReset(value.getFields());
+        readStructNoReset(value.getFields(), _fieldSet);
     }
 }
 
@@ -305,9 +307,64 @@ void readFieldInfo(nbostream& input, SerializableArray::EntryMap & field_info) {
         offset += size;
     }
 }
+
+bool
+keepField(const StructDataType &type, uint32_t id, const FieldSet &fieldSet)
+{
+    return type.hasField(id) && fieldSet.contains(type.getField(id));
+}
+
+size_t
+fieldInfoSize(const SerializableArray::EntryMap &field_info)
+{
+    size_t size = 0;
+    for (const SerializableArray::Entry &entry : field_info) {
+        size += entry.size();
+    }
+    return size;
+}
+
+/**
+ * Copies only the data of the fields in the field set. The other fields
+ * are left without data, to be dropped when the fields are retained.
+ */
+ByteBuffer::UP
+copyKeptFields(const StructDataType &type, const FieldSet &fieldSet, const char *data,
+               SerializableArray::EntryMap &field_info)
+{
+    SerializableArray::EntryMap copied;
+    vector<uint32_t> from;
+    copied.reserve(field_info.size());
+    from.reserve(field_info.size());
+    uint32_t offset = 0;
+    uint32_t kept_size = 0;
+    for (const SerializableArray::Entry &entry : field_info) {
+        if (keepField(type, entry.id(), fieldSet)) {
+            copied.emplace_back(entry.id(), entry.size(), kept_size);
+            from.push_back(offset);
+            kept_size += entry.size();
+        } else {
+            copied.emplace_back(entry.id(), 0, 0);
+            from.push_back(0);
+        }
+        offset += entry.size();
+    }
+    field_info.swap(copied);
+    ByteBuffer::UP buffer(new ByteBuffer(kept_size));
+    uint32_t pos = 0;
+    for (size_t i = 0; i < field_info.size(); ++i) {
+        memcpy(buffer->getBuffer() + pos, data + from[i], field_info[i].size());
+        pos += field_info[i].size();
+    }
+    return buffer;
+}
 }  // namespace
 
 void VespaDocumentDeserializer::readStructNoReset(StructFieldValue &value) {
+    readStructNoReset(value, nullptr);
+}
+
+void VespaDocumentDeserializer::readStructNoReset(StructFieldValue &value, const FieldSet *fieldSet) {
     size_t start_size = _stream.size();
     size_t data_size;
     if (_version < 6) {
@@ -339,13 +396,25 @@ void VespaDocumentDeserializer::readStructNoReset(StructFieldValue &value) {
     }
 
     if (data_size > 0) {
-        ByteBuffer::UP buffer(_stream.isLongLivedBuffer()
-                          ? new ByteBuffer(_stream.peek(), data_size)
-                          : ByteBuffer::copyBuffer(_stream.peek(), data_size));
+        ByteBuffer::UP buffer;
+        if ((fieldSet != nullptr) && !CompressionConfig::isCompressed(compression_type)
+            && !_stream.isLongLivedBuffer() && (fieldInfoSize(field_info) <= data_size))
+        {
+            const auto &type = static_cast<const StructDataType &>(*value.getDataType());
+            buffer = copyKeptFields(type, *fieldSet, _stream.peek(), field_info);
+        } else {
+            buffer.reset(_stream.isLongLivedBuffer()
+                         ? new ByteBuffer(_stream.peek(), data_size)
+                         : ByteBuffer::copyBuffer(_stream.peek(), data_size));
+        }
         LOG(spam, "Lazy deserializing into %s with _version %u",
             value.getDataType()->getName().c_str(), _version);
         value.lazyDeserialize(_repo, _version, std::move(field_info),
                               std::move(buffer), compression_type, uncompressed_size);
+        if (fieldSet != nullptr) {
+            // Compressed or shared data is kept as is, only the field info is filtered
+            value.retainFields(*fieldSet);
+        }
         _stream.adjustReadPos(data_size);
     }
 }
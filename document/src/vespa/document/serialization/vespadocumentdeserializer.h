@@ -12,12 +12,14 @@ namespace document {
 class DocumentId;
 class DocumentType;
 class DocumentTypeRepo;
+class FieldSet;
 class FieldValue;
 
 class VespaDocumentDeserializer : private FieldValueVisitor {
     vespalib::nbostream &_stream;
     FixedTypeRepo _repo;
     uint16_t _version;
+    const FieldSet *_fieldSet;
 
     void visit(AnnotationReferenceFieldValue &value) override { read(value); }
     void visit(ArrayFieldValue &value) override { read(value); }
@@ -38,20 +40,30 @@ class VespaDocumentDeserializer : private FieldValueVisitor {
     void visit(ReferenceFieldValue &value) override { read(value); }
 
     void readDocument(Document &value);
+    void readStructNoReset(StructFieldValue &value, const FieldSet *fieldSet);
 
 public:
     VespaDocumentDeserializer(const DocumentTypeRepo &repo, vespalib::nbostream &stream, uint16_t version) :
         _stream(stream),
         _repo(repo),
-        _version(version)
+        _version(version),
+        _fieldSet(nullptr)
     { }
 
     VespaDocumentDeserializer(const FixedTypeRepo &repo, vespalib::nbostream &stream, uint16_t version) :
         _stream(stream),
         _repo(repo),
-        _version(version)
+        _version(version),
+        _fieldSet(nullptr)
     { }
 
+    /**
+     * Only keep the given fields of the documents read. The other fields
+     * are skipped using their serialized size, and are neither copied
+     * nor decompressed.
+     */
+    void setFieldSet(const FieldSet &fieldSet) { _fieldSet = &fieldSet; }
+
     // returns NULL if the read doc type equals guess.
     const DocumentType *readDocType(const DocumentType &guess);
 
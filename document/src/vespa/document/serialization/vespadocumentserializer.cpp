@@ -93,9 +93,13 @@ VespaDocumentSerializer::getContentCode(bool hasHeader, bool hasBody) const
 
 void VespaDocumentSerializer::write(const Document &value,
                                     DocSerializationMode mode) {
-    nbostream doc_stream;
-    VespaDocumentSerializer doc_serializer(doc_stream);
-    doc_serializer.write(value.getId());
+    // The document is written straight into the output stream, and its
+    // size is filled in afterwards.
+    const uint16_t version = serialize_version;
+    _stream << version;
+    const size_t size_pos = _stream.size();
+    _stream << static_cast<uint32_t>(0);
+    write(value.getId());
 
     bool hasHeader = false;
     bool hasBody = false;
@@ -116,8 +120,8 @@ void VespaDocumentSerializer::write(const Document &value,
         hasBody = false;
     }
 
-    doc_stream << getContentCode(hasHeader, hasBody);
-    doc_serializer.write(value.getType());
+    _stream << getContentCode(hasHeader, hasBody);
+    write(value.getType());
 
     if (!structNeedsReserialization(value.getFields())) {
         // FIXME(vekterli):
@@ -127,28 +131,24 @@ void VespaDocumentSerializer::write(const Document &value,
         const StructFieldValue::Chunks & chunks = value.getFields().getChunks();
         if (hasHeader) {
             assert(chunks.size() >= 1);
-            doc_serializer.writeUnchanged(chunks[0]);
+            writeUnchanged(chunks[0]);
             if (hasBody) {
                 assert(chunks.size() == 2);
-                doc_serializer.writeUnchanged(chunks[1]);
+                writeUnchanged(chunks[1]);
             }
         } else if (hasBody) {
             assert(chunks.size() == 1);
-            doc_serializer.writeUnchanged(chunks[0]);
+            writeUnchanged(chunks[0]);
         }
     } else {
         if (hasHeader) {
-            doc_serializer.write(value.getFields(), HeaderFields());
+            write(value.getFields(), HeaderFields());
         }
         if (hasBody) {
-            doc_serializer.write(value.getFields(), BodyFields());
+            write(value.getFields(), BodyFields());
         }
     }
-
-    const uint16_t version = serialize_version;
-    _stream << version
-            << static_cast<uint32_t>(doc_stream.size());
-    _stream.write(doc_stream.peek(), doc_stream.size());
+    _stream.writeAt(size_pos, static_cast<uint32_t>(_stream.size() - size_pos - sizeof(uint32_t)));
 }
 
 void VespaDocumentSerializer::visit(const StructFieldValue &value)
@@ -387,12 +387,11 @@ void VespaDocumentSerializer::write(const WeightedSetFieldValue &value) {
     _stream << static_cast<uint32_t>(type->getNestedType().getId());
     _stream << static_cast<uint32_t>(value.size());
     for (const auto & entry : value) {
-        nbostream stream;
-        VespaDocumentSerializer serializer(stream);
-        serializer.write(*entry.first);
-        serializer.write(*entry.second);
-        _stream << static_cast<uint32_t>(stream.size());  // This is unused
-        _stream.write(stream.peek(), stream.size());
+        const size_t size_pos = _stream.size();
+        _stream << static_cast<uint32_t>(0);  // This is unused
+        write(*entry.first);
+        write(*entry.second);
+        _stream.writeAt(size_pos, static_cast<uint32_t>(_stream.size() - size_pos - sizeof(uint32_t)));
     }
 }
 
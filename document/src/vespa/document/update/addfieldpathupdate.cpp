@@ -92,8 +92,7 @@ AddFieldPathUpdate::deserialize(const DocumentTypeRepo& repo, const DataType& ty
 {
     FieldPathUpdate::deserialize(repo, type, stream);
 
-    FieldPath path;
-    type.buildFieldPath(path, getOriginalFieldPath());
+    const FieldPath & path = getFieldPath(type);
     const DataType& fieldType = getResultingDataType(path);
     assert(fieldType.inherits(ArrayDataType::classId));
     FieldValue::UP val = fieldType.createFieldValue();
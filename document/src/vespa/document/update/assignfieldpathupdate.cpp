@@ -230,8 +230,7 @@ AssignFieldPathUpdate::deserialize(const DocumentTypeRepo& repo, const DataType&
     if (flags & ARITHMETIC_EXPRESSION) {
         _expression = getString(stream);
     } else {
-        FieldPath path;
-        type.buildFieldPath(path, getOriginalFieldPath());
+        const FieldPath & path = getFieldPath(type);
         _newValue.reset(getResultingDataType(path).createFieldValue().release());
         VespaDocumentDeserializer deserializer(repo, stream, Document::getNewestSerializationVersion());
         deserializer.read(*_newValue);
@@ -34,15 +34,43 @@ parseDocumentSelection(vespalib::stringref query, const DocumentTypeRepo& repo)
 
 FieldPathUpdate::FieldPathUpdate() :
     _originalFieldPath(),
-    _originalWhereClause()
+    _originalWhereClause(),
+    _fieldPath(),
+    _fieldPathType(nullptr),
+    _whereClause(),
+    _whereClauseRepo(nullptr)
 { }
 
-FieldPathUpdate::FieldPathUpdate(const FieldPathUpdate &) = default;
-FieldPathUpdate & FieldPathUpdate::operator =(const FieldPathUpdate &) = default;
+FieldPathUpdate::FieldPathUpdate(const FieldPathUpdate & rhs) :
+    Cloneable(rhs),
+    Printable(rhs),
+    Identifiable(rhs),
+    _originalFieldPath(rhs._originalFieldPath),
+    _originalWhereClause(rhs._originalWhereClause),
+    _fieldPath(),
+    _fieldPathType(nullptr),
+    _whereClause(),
+    _whereClauseRepo(nullptr)
+{ }
+
+FieldPathUpdate &
+FieldPathUpdate::operator =(const FieldPathUpdate & rhs)
+{
+    if (this != &rhs) {
+        _originalFieldPath = rhs._originalFieldPath;
+        _originalWhereClause = rhs._originalWhereClause;
+        invalidateCompiled();
+    }
+    return *this;
+}
 
 FieldPathUpdate::FieldPathUpdate(stringref fieldPath, stringref whereClause) :
     _originalFieldPath(fieldPath),
-    _originalWhereClause(whereClause)
+    _originalWhereClause(whereClause),
+    _fieldPath(),
+    _fieldPathType(nullptr),
+    _whereClause(),
+    _whereClauseRepo(nullptr)
 { }
 
 FieldPathUpdate::~FieldPathUpdate() = default;
@@ -59,13 +87,11 @@ FieldPathUpdate::applyTo(Document& doc) const
 {
     std::unique_ptr<IteratorHandler> handler(getIteratorHandler(doc, *doc.getRepo()));
 
-    FieldPath path;
-    doc.getDataType()->buildFieldPath(path, _originalFieldPath);
+    const FieldPath & path = getFieldPath(*doc.getDataType());
     if (_originalWhereClause.empty()) {
         doc.iterateNested(path, *handler);
     } else {
-        std::unique_ptr<select::Node> whereClause = parseDocumentSelection(_originalWhereClause, *doc.getRepo());
-        select::ResultList results = whereClause->contains(doc);
+        select::ResultList results = getWhereClause(*doc.getRepo()).contains(doc);
         for (select::ResultList::const_iterator i = results.begin(); i != results.end(); ++i) {
             LOG(spam, "vars = %s", handler->getVariables().toString().c_str());
             if (*i->second == select::Result::True) {
@@ -83,11 +109,41 @@ FieldPathUpdate::print(std::ostream& out, bool, const std::string& indent) const
         << indent << "whereClause='" << _originalWhereClause << "'";
 }
 
+const FieldPath &
+FieldPathUpdate::getFieldPath(const DataType & type) const
+{
+    if (_fieldPathType != &type) {
+        FieldPath path;
+        type.buildFieldPath(path, _originalFieldPath);
+        _fieldPath = std::move(path);
+        _fieldPathType = &type;
+    }
+    return _fieldPath;
+}
+
+const select::Node &
+FieldPathUpdate::getWhereClause(const DocumentTypeRepo & repo) const
+{
+    if (_whereClauseRepo != &repo) {
+        _whereClause = parseDocumentSelection(_originalWhereClause, repo);
+        _whereClauseRepo = &repo;
+    }
+    return *_whereClause;
+}
+
+void
+FieldPathUpdate::invalidateCompiled()
+{
+    _fieldPath = FieldPath();
+    _fieldPathType = nullptr;
+    _whereClause.reset();
+    _whereClauseRepo = nullptr;
+}
+
 void
 FieldPathUpdate::checkCompatibility(const FieldValue& fv, const DataType & type) const
 {
-    FieldPath path;
-    type.buildFieldPath(path, _originalFieldPath);
+    const FieldPath & path = getFieldPath(type);
     if ( !getResultingDataType(path).isValueType(fv)) {
         throw IllegalArgumentException(
                 make_string("Cannot update a '%s' field with a '%s' value",
@@ -122,6 +178,7 @@ FieldPathUpdate::deserialize(const DocumentTypeRepo&, const DataType&, nbostream
 {
     _originalFieldPath = getString(stream);
     _originalWhereClause = getString(stream);
+    invalidateCompiled();
 }
 
 std::unique_ptr<FieldPathUpdate>
@@ -81,13 +81,27 @@ protected:
 
     /** @return the datatype of the last path element in the field path */
     const DataType& getResultingDataType(const FieldPath & path) const;
+    /**
+     * Returns the field path compiled for the given (document) type.
+     * It is only built once per type, so deserializing and applying
+     * an update share the same compiled path.
+     */
+    const FieldPath & getFieldPath(const DataType & type) const;
     enum SerializedMagic {AssignMagic=0, RemoveMagic=1, AddMagic=2};
 private:
     // TODO: rename to createIteratorHandler?
     virtual std::unique_ptr<fieldvalue::IteratorHandler> getIteratorHandler(Document& doc, const DocumentTypeRepo & repo) const = 0;
 
+    const select::Node & getWhereClause(const DocumentTypeRepo & repo) const;
+    void invalidateCompiled();
+
     vespalib::string _originalFieldPath;
     vespalib::string _originalWhereClause;
+    // Compiled forms of the above, built on first use and not copied.
+    mutable FieldPath                     _fieldPath;
+    mutable const DataType               *_fieldPathType;
+    mutable std::unique_ptr<select::Node> _whereClause;
+    mutable const DocumentTypeRepo       *_whereClauseRepo;
 };
 
 }
@@ -0,0 +1,169 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/data/slime/json_format.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/eval/eval/function.h>
+#include <vespa/eval/eval/interpreted_function.h>
+#include <vespa/eval/eval/lazy_params.h>
+#include <vespa/eval/eval/node_types.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/eval/value.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/eval/test/test_io.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <cstdlib>
+#include <new>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::slime::convenience;
+using slime::JsonFormat;
+using tensor::DefaultTensorEngine;
+
+//-----------------------------------------------------------------------------
+
+// Count heap allocations made while an evaluation is being tracked.
+// Note that stash chunks are allocated with malloc and are re-used
+// between evaluations, so they are not part of the numbers reported.
+
+namespace {
+bool   alloc_tracking = false;
+size_t alloc_count = 0;
+size_t alloc_bytes = 0;
+}
+
+void *operator new(size_t size) {
+    if (alloc_tracking) {
+        ++alloc_count;
+        alloc_bytes += size;
+    }
+    void *p = malloc(size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+//-----------------------------------------------------------------------------
+
+std::vector<vespalib::string> make_keys(size_t size) {
+    std::vector<vespalib::string> keys;
+    for (size_t i = 0; i < size; ++i) {
+        keys.push_back(make_string("k%zu", i));
+    }
+    return keys;
+}
+
+// Shape of the parameters used for a benchmark case. Sparse tensors
+// have only mapped dimensions, mixed tensors have 'x' mapped and all
+// other dimensions indexed, dense tensors have only indexed dimensions.
+struct Shape {
+    vespalib::string name;
+    bool sparse;
+    bool mixed;
+    Domain dim(const vespalib::string &dim_name, size_t size) const {
+        bool mapped = (sparse || (mixed && (dim_name == "x")));
+        return mapped ? Domain(dim_name, make_keys(size)) : Domain(dim_name, size);
+    }
+    TensorSpec make(const vespalib::string &d1, const vespalib::string &d2, size_t size) const {
+        return spec({dim(d1, size), dim(d2, size)}, Div10(N()));
+    }
+};
+
+std::vector<Shape> shapes() {
+    return {{"dense", false, false}, {"sparse", true, false}, {"mixed", false, true}};
+}
+
+struct Case {
+    vespalib::string op;
+    vespalib::string expr;
+    std::vector<std::pair<vespalib::string,vespalib::string>> param_dims;
+};
+
+std::vector<Case> cases() {
+    return {{"join",   "a+b",                    {{"x","y"},{"x","y"}}},
+            {"reduce", "reduce(a,sum,y)",        {{"x","y"}}},
+            {"rename", "rename(a,y,z)",          {{"x","y"}}},
+            {"matmul", "reduce(a*b,sum,y)",      {{"x","y"},{"y","z"}}},
+            {"map",    "map(a,f(x)(x*x+1))",     {{"x","y"}}},
+            {"concat", "concat(a,b,z)",          {{"x","y"},{"x","y"}}}};
+}
+
+//-----------------------------------------------------------------------------
+
+void run_case(const Case &c, const Shape &shape, size_t size, double budget,
+              const TensorEngine &engine, const vespalib::string &engine_name,
+              Cursor &results)
+{
+    Function fun = Function::parse(c.expr);
+    std::vector<Value::UP> param_values;
+    std::vector<Value::CREF> param_refs;
+    std::vector<ValueType> param_types;
+    for (const auto &dims: c.param_dims) {
+        param_values.push_back(engine.from_spec(shape.make(dims.first, dims.second, size)));
+        param_refs.emplace_back(*param_values.back());
+        param_types.push_back(param_values.back()->type());
+    }
+    NodeTypes types(fun, param_types);
+    InterpretedFunction ifun(engine, fun, types);
+    InterpretedFunction::Context ctx(ifun);
+    SimpleObjectParams params(param_refs);
+    ifun.eval(ctx, params);
+    alloc_count = 0;
+    alloc_bytes = 0;
+    alloc_tracking = true;
+    ifun.eval(ctx, params);
+    alloc_tracking = false;
+    double seconds = BenchmarkTimer::benchmark([&](){ ifun.eval(ctx, params); }, budget);
+    Cursor &result = results.addObject();
+    result.setString("op", c.op);
+    result.setString("shape", shape.name);
+    result.setLong("size", size);
+    result.setString("engine", engine_name);
+    result.setString("expr", c.expr);
+    result.setDouble("ns_per_op", seconds * 1000.0 * 1000.0 * 1000.0);
+    result.setLong("allocs_per_op", alloc_count);
+    result.setLong("bytes_per_op", alloc_bytes);
+    fprintf(stderr, "%-8s %-7s %5zu %-7s: %12.1f ns/op\n", c.op.c_str(), shape.name.c_str(),
+            size, engine_name.c_str(), seconds * 1000.0 * 1000.0 * 1000.0);
+}
+
+//-----------------------------------------------------------------------------
+
+int usage(const char *self) {
+    fprintf(stderr, "usage: %s <budget> <size>...\n", self);
+    fprintf(stderr, "  <budget>: time budget in seconds for each benchmark case\n");
+    fprintf(stderr, "  <size>: number of labels/indexes in each tensor dimension\n");
+    fprintf(stderr, "  benchmarks common tensor operations for dense, sparse and\n");
+    fprintf(stderr, "  mixed tensors with both the reference and the production\n");
+    fprintf(stderr, "  tensor engine and writes the results as json to stdout\n");
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    StdOut std_out;
+    if (argc < 3) {
+        return usage(argv[0]);
+    }
+    double budget = strtod(argv[1], nullptr);
+    Slime slime;
+    Cursor &results = slime.setObject().setArray("results");
+    for (int i = 2; i < argc; ++i) {
+        size_t size = strtoul(argv[i], nullptr, 10);
+        for (const Case &c: cases()) {
+            for (const Shape &shape: shapes()) {
+                run_case(c, shape, size, budget, SimpleTensorEngine::ref(), "simple", results);
+                run_case(c, shape, size, budget, DefaultTensorEngine::ref(), "default", results);
+            }
+        }
+    }
+    JsonFormat::encode(slime, std_out, false);
+    return 0;
+}
@@ -2,12 +2,14 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/eval/eval/gbdt.h>
 #include <vespa/eval/eval/vm_forest.h>
+#include <vespa/eval/eval/quick_scorer_forest.h>
 #include <vespa/eval/eval/function.h>
 #include <vespa/eval/eval/llvm/deinline_forest.h>
 #include <vespa/eval/eval/llvm/compiled_function.h>
 #include <vespa/eval/eval/interpreted_function.h>
 #include <vespa/eval/eval/simple_tensor_engine.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <limits>
 #include "model.cpp"
 
 using namespace vespalib::eval;
@@ -285,6 +287,36 @@ TEST("require that models with too large sets are rejected by general vm optimiz
 
 //-----------------------------------------------------------------------------
 
+TEST("require that quick scorer forest optimizer works") {
+    Function function = Function::parse("if((a<1),1.0,if((b<1),if((c<1),2.0,3.0),4.0))+"
+                                        "if((d<1),10.0,if((e<1),if((f<1),20.0,30.0),40.0))");
+    CompiledFunction compiled_function(function, PassParams::ARRAY, QuickScorerForest::optimize_chain);
+    ASSERT_EQUAL(1u, compiled_function.get_forests().size());
+    EXPECT_TRUE(dynamic_cast<QuickScorerForest*>(compiled_function.get_forests()[0].get()) != nullptr);
+    auto f = compiled_function.get_function();
+    EXPECT_EQUAL(11.0, f(&std::vector<double>({0.5, 0.0, 0.0, 0.5, 0.0, 0.0})[0]));
+    EXPECT_EQUAL(22.0, f(&std::vector<double>({1.5, 0.5, 0.5, 1.5, 0.5, 0.5})[0]));
+    EXPECT_EQUAL(33.0, f(&std::vector<double>({1.5, 0.5, 1.5, 1.5, 0.5, 1.5})[0]));
+    EXPECT_EQUAL(44.0, f(&std::vector<double>({1.5, 1.5, 0.0, 1.5, 1.5, 0.0})[0]));
+    EXPECT_EQUAL(44.0, f(&std::vector<double>({std::numeric_limits<double>::quiet_NaN(), 1.5, 0.0,
+                                               std::numeric_limits<double>::quiet_NaN(), 1.5, 0.0})[0]));
+}
+
+TEST("require that models with in checks or large trees are rejected by quick scorer forest optimizer") {
+    Function function = Function::parse(Model().less_percent(100).make_forest(300, 64));
+    auto trees = extract_trees(function.root());
+    ForestStats stats(trees);
+    EXPECT_TRUE(Optimize::apply_chain(QuickScorerForest::optimize_chain, stats, trees).valid());
+    stats.total_in_checks = 1;
+    EXPECT_TRUE(!Optimize::apply_chain(QuickScorerForest::optimize_chain, stats, trees).valid());
+    Function large_function = Function::parse(Model().less_percent(100).make_forest(10, 65));
+    auto large_trees = extract_trees(large_function.root());
+    ForestStats large_stats(large_trees);
+    EXPECT_TRUE(!Optimize::apply_chain(QuickScorerForest::optimize_chain, large_stats, large_trees).valid());
+}
+
+//-----------------------------------------------------------------------------
+
 double eval_compiled(const CompiledFunction &cfun, std::vector<double> &params) {
     ASSERT_EQUAL(params.size(), cfun.num_params());
     if (cfun.pass_params() == PassParams::ARRAY) {
@@ -306,16 +338,24 @@ TEST("require that forests evaluate to approximately the same for all evaluation
                     CompiledFunction none(function, pass_params, Optimize::none);
                     CompiledFunction deinline(function, pass_params, DeinlineForest::optimize_chain);
                     CompiledFunction vm_forest(function, pass_params, VMForest::optimize_chain);
+                    CompiledFunction quick_scorer(function, pass_params, QuickScorerForest::optimize_chain);
                     EXPECT_EQUAL(0u, none.get_forests().size());
                     ASSERT_EQUAL(1u, deinline.get_forests().size());
                     EXPECT_TRUE(dynamic_cast<DeinlineForest*>(deinline.get_forests()[0].get()) != nullptr);
                     ASSERT_EQUAL(1u, vm_forest.get_forests().size());
                     EXPECT_TRUE(dynamic_cast<VMForest*>(vm_forest.get_forests()[0].get()) != nullptr);
+                    if (less_percent == 100) {
+                        ASSERT_EQUAL(1u, quick_scorer.get_forests().size());
+                        EXPECT_TRUE(dynamic_cast<QuickScorerForest*>(quick_scorer.get_forests()[0].get()) != nullptr);
+                    } else {
+                        EXPECT_EQUAL(0u, quick_scorer.get_forests().size());
+                    }
                     std::vector<double> inputs(function.num_params(), 0.5);
                     double expected = eval_double(function, inputs);
                     EXPECT_APPROX(expected, eval_compiled(none, inputs), 1e-6);
                     EXPECT_APPROX(expected, eval_compiled(deinline, inputs), 1e-6);
                     EXPECT_APPROX(expected, eval_compiled(vm_forest, inputs), 1e-6);
+                    EXPECT_APPROX(expected, eval_compiled(quick_scorer, inputs), 1e-6);
                 }
             }
         }
@@ -345,6 +385,16 @@ TEST("require that lazy parameters are not suggested for GBDT models") {
     EXPECT_TRUE(!CompiledFunction::should_use_lazy_params(function));
 }
 
+TEST("require that lazy parameters are suggested for GBDT models that are not always evaluated") {
+    Function function = Function::parse(vespalib::make_string("if(fallback<1,%s,fallback)",
+                                                              Model().make_forest(10, 8).c_str()));
+    EXPECT_TRUE(CompiledFunction::should_use_lazy_params(function));
+    Function other = Function::parse(vespalib::make_string("if(fallback<1,%s,%s)",
+                                                           Model().make_forest(10, 8).c_str(),
+                                                           Model().make_forest(10, 8).c_str()));
+    EXPECT_TRUE(!CompiledFunction::should_use_lazy_params(other));
+}
+
 TEST("require that lazy parameters can be suggested for small GBDT models") {
     Function function = Function::parse("if((a<1),1.0,if((b in [1,2,3]),if((c in [1]),2.0,3.0),4.0))+"
                                         "if((d in [1]),10.0,if((e<1),20.0,30.0))+"
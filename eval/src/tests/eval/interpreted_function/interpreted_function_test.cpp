@@ -154,6 +154,44 @@ TEST("require that basic addition works") {
 
 //-----------------------------------------------------------------------------
 
+size_t planned_stash_chunk_size(const vespalib::string &expr, const vespalib::string &type_spec) {
+    Function fun = Function::parse(expr);
+    std::vector<ValueType> param_types(fun.num_params(), ValueType::from_spec(type_spec));
+    NodeTypes types(fun, param_types);
+    InterpretedFunction ifun(DefaultTensorEngine::ref(), fun, types);
+    return ifun.stash_chunk_size();
+}
+
+TEST("require that stash chunk size is planned from dense intermediate results") {
+    size_t small = planned_stash_chunk_size("a+10", "double");
+    size_t one_vector = planned_stash_chunk_size("a*b", "tensor(x[1000])");
+    size_t two_vectors = planned_stash_chunk_size("(a*b)*a", "tensor(x[1000])");
+    EXPECT_LESS(small, 4096u);
+    EXPECT_GREATER_EQUAL(one_vector, 4 * 1000 * sizeof(double));
+    EXPECT_GREATER_EQUAL(two_vectors, 2 * 1000 * sizeof(double));
+    EXPECT_LESS(planned_stash_chunk_size("reduce(a*b,sum)", "tensor(x[1000])"), one_vector);
+}
+
+TEST("require that planned stash chunk size is bounded") {
+    EXPECT_EQUAL(16u * 1024 * 1024, planned_stash_chunk_size("a*b", "tensor(x[10000000])"));
+}
+
+TEST("require that dense intermediate results can be evaluated repeatedly with a planned stash") {
+    Function fun = Function::parse("(a*b)+a");
+    NodeTypes types(fun, {ValueType::from_spec("tensor(x[3])"), ValueType::from_spec("tensor(x[3])")});
+    InterpretedFunction ifun(DefaultTensorEngine::ref(), fun, types);
+    InterpretedFunction::Context ctx(ifun);
+    auto a = DefaultTensorEngine::ref().from_spec(TensorSpec("tensor(x[3])").add({{"x",0}}, 1).add({{"x",1}}, 2).add({{"x",2}}, 3));
+    auto b = DefaultTensorEngine::ref().from_spec(TensorSpec("tensor(x[3])").add({{"x",0}}, 4).add({{"x",1}}, 5).add({{"x",2}}, 6));
+    SimpleObjectParams params({*a, *b});
+    auto expect = TensorSpec("tensor(x[3])").add({{"x",0}}, 5).add({{"x",1}}, 12).add({{"x",2}}, 21);
+    for (size_t i = 0; i < 3; ++i) {
+        EXPECT_EQUAL(expect, DefaultTensorEngine::ref().to_spec(ifun.eval(ctx, params)));
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 TEST("require that functions with non-compilable lambdas cannot be interpreted") {
     auto good_map = Function::parse("map(a,f(x)(x+1))");
     auto good_join = Function::parse("join(a,b,f(x,y)(x+y))");
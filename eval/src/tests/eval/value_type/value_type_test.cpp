@@ -463,4 +463,44 @@ TEST("require that 'either' gives appropriate type") {
     EXPECT_EQUAL(ValueType::either(mxy_32, mxy_22), mxy_any2);
 }
 
+TEST("require that tensor cell type is part of the type") {
+    ValueType t1 = ValueType::tensor_type({{"x", 3}});
+    ValueType t2 = ValueType::tensor_type({{"x", 3}}, ValueType::CellType::FLOAT);
+    ValueType t3 = ValueType::tensor_type({{"x", 3}}, ValueType::CellType::INT8);
+    EXPECT_TRUE(t1.cell_type() == ValueType::CellType::DOUBLE);
+    EXPECT_TRUE(t2.cell_type() == ValueType::CellType::FLOAT);
+    EXPECT_TRUE(t3.cell_type() == ValueType::CellType::INT8);
+    EXPECT_NOT_EQUAL(t1, t2);
+    EXPECT_NOT_EQUAL(t2, t3);
+    EXPECT_EQUAL(8u, ValueType::cell_size(t1.cell_type()));
+    EXPECT_EQUAL(4u, ValueType::cell_size(t2.cell_type()));
+    EXPECT_EQUAL(1u, ValueType::cell_size(t3.cell_type()));
+}
+
+TEST("require that tensor cell type can be parsed and printed") {
+    EXPECT_EQUAL("tensor<float>(x[3],y{})", ValueType::from_spec("tensor<float>(x[3],y{})").to_spec());
+    EXPECT_EQUAL("tensor<int8>(x[])", ValueType::from_spec("tensor < int8 > (x[])").to_spec());
+    EXPECT_EQUAL("tensor(x[3])", ValueType::from_spec("tensor<double>(x[3])").to_spec());
+    EXPECT_EQUAL("tensor<float>", ValueType::from_spec("tensor<float>").to_spec());
+    EXPECT_TRUE(ValueType::from_spec("tensor<float>(x[3])").cell_type() == ValueType::CellType::FLOAT);
+    EXPECT_TRUE(ValueType::from_spec("tensor<int16>(x[3])").is_error());
+    EXPECT_TRUE(ValueType::from_spec("tensor<float(x[3])").is_error());
+    EXPECT_TRUE(ValueType::from_spec("tensor<>(x[3])").is_error());
+}
+
+TEST("require that tensor operations keep or unify cell types") {
+    ValueType f_xy = ValueType::from_spec("tensor<float>(x[3],y[5])");
+    ValueType f_y = ValueType::from_spec("tensor<float>(y[5])");
+    ValueType d_y = ValueType::from_spec("tensor(y[5])");
+    EXPECT_EQUAL(ValueType::from_spec("tensor<float>(x[3])"), f_xy.reduce({"y"}));
+    EXPECT_EQUAL(ValueType::double_type(), f_xy.reduce({}));
+    EXPECT_EQUAL(ValueType::from_spec("tensor<float>(a[3],y[5])"), f_xy.rename({"x"}, {"a"}));
+    EXPECT_EQUAL(f_xy, ValueType::join(f_xy, f_y));
+    EXPECT_EQUAL(f_xy, ValueType::join(f_xy, ValueType::double_type()));
+    EXPECT_EQUAL(ValueType::from_spec("tensor(x[3],y[5])"), ValueType::join(f_xy, d_y));
+    EXPECT_EQUAL(ValueType::from_spec("tensor(y[10])"), ValueType::concat(f_y, d_y, "y"));
+    EXPECT_EQUAL(ValueType::from_spec("tensor<float>(y[10])"), ValueType::concat(f_y, f_y, "y"));
+    EXPECT_EQUAL(ValueType::from_spec("tensor(y[5])"), ValueType::either(f_y, d_y));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,113 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/simple_tensor.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_fused_reduce_function.h>
+#include <vespa/eval/tensor/dense/dense_dot_product_function.h>
+#include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/eval/test/eval_fixture.h>
+
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/stash.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::tensor;
+using namespace vespalib::eval::tensor_function;
+
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+EvalFixture::ParamRepo make_params() {
+    return EvalFixture::ParamRepo()
+        .add("a", spec(1.5))
+        .add("x5_A", spec({x(5)}, N()))
+        .add("x5_B", spec({x(5)}, Div10(N())))
+        .add("x4", spec({x(4)}, N()))
+        .add("x5y3_A", spec({x(5),y(3)}, N()))
+        .add("x5y3_B", spec({x(5),y(3)}, Div10(N())))
+        .add("x5_unbound", spec({x(5)}, N()), "tensor(x[])")
+        .add("x_sparse", spec({x({"a", "b", "c"})}, N()))
+        .add_mutable("mut_x5", spec({x(5)}, N()));
+}
+EvalFixture::ParamRepo param_repo = make_params();
+
+void verify_optimized(const vespalib::string &expr, bool has_map, Aggr aggr) {
+    EvalFixture fixture(prod_engine, expr, param_repo, true, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    auto info = fixture.find_all<DenseFusedReduceFunction>();
+    ASSERT_EQUAL(info.size(), 1u);
+    EXPECT_EQUAL(info[0]->map_fun() != nullptr, has_map);
+    EXPECT_TRUE(info[0]->aggr() == aggr);
+    EXPECT_TRUE(fixture.find_all<Join>().empty());
+    EXPECT_TRUE(fixture.find_all<Map>().empty());
+}
+
+void verify_not_optimized(const vespalib::string &expr) {
+    EvalFixture fixture(prod_engine, expr, param_repo, true, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    EXPECT_TRUE(fixture.find_all<DenseFusedReduceFunction>().empty());
+}
+
+TEST("require that full reduce of join is fused") {
+    TEST_DO(verify_optimized("reduce(x5_A-x5_B,sum)", false, Aggr::SUM));
+    TEST_DO(verify_optimized("reduce(x5y3_A+x5y3_B,sum)", false, Aggr::SUM));
+    TEST_DO(verify_optimized("reduce(x5y3_A-x5y3_B,sum,x,y)", false, Aggr::SUM));
+    TEST_DO(verify_optimized("reduce(join(x5_A,x5_B,f(a,b)(a*b+1)),sum)", false, Aggr::SUM));
+}
+
+TEST("require that full reduce of map of join is fused") {
+    TEST_DO(verify_optimized("reduce(map(x5_A-x5_B,f(x)(x*x)),sum)", true, Aggr::SUM));
+    TEST_DO(verify_optimized("reduce(map(x5y3_A*x5y3_B,f(x)(x+1)),sum)", true, Aggr::SUM));
+}
+
+TEST("require that all aggregators can be fused") {
+    TEST_DO(verify_optimized("reduce(x5_A-x5_B,avg)", false, Aggr::AVG));
+    TEST_DO(verify_optimized("reduce(x5_A-x5_B,count)", false, Aggr::COUNT));
+    TEST_DO(verify_optimized("reduce(x5_A-x5_B,prod)", false, Aggr::PROD));
+    TEST_DO(verify_optimized("reduce(x5_A-x5_B,max)", false, Aggr::MAX));
+    TEST_DO(verify_optimized("reduce(map(x5_A-x5_B,f(x)(x*x)),min)", true, Aggr::MIN));
+}
+
+TEST("require that joins with mutable operands can be fused") {
+    TEST_DO(verify_optimized("reduce(mut_x5-x5_A,sum)", false, Aggr::SUM));
+    TEST_DO(verify_optimized("reduce(map(x5_A*mut_x5,f(x)(x-1)),max)", true, Aggr::MAX));
+}
+
+TEST("require that dot products are left to the dot product function") {
+    EvalFixture fixture(prod_engine, "reduce(x5_A*x5_B,sum)", param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref("reduce(x5_A*x5_B,sum)", param_repo));
+    EXPECT_TRUE(fixture.find_all<DenseFusedReduceFunction>().empty());
+    EXPECT_EQUAL(fixture.find_all<DenseDotProductFunction>().size(), 1u);
+}
+
+TEST("require that partial reduce is not fused") {
+    TEST_DO(verify_not_optimized("reduce(x5y3_A-x5y3_B,sum,x)"));
+    TEST_DO(verify_not_optimized("reduce(map(x5y3_A-x5y3_B,f(x)(x*x)),sum,y)"));
+}
+
+TEST("require that reduce without elementwise join is not fused") {
+    TEST_DO(verify_not_optimized("reduce(x5_A,sum)"));
+    TEST_DO(verify_not_optimized("reduce(map(x5_A,f(x)(x*x)),sum)"));
+    TEST_DO(verify_not_optimized("reduce(x5_A*a,sum)"));
+    TEST_DO(verify_not_optimized("reduce(x5_A-x4,sum)"));
+    TEST_DO(verify_not_optimized("reduce(x5_A*x5y3_B,sum)"));
+}
+
+TEST("require that abstract and mapped tensors are not fused") {
+    TEST_DO(verify_not_optimized("reduce(x5_unbound-x5_A,sum)"));
+    TEST_DO(verify_not_optimized("reduce(x_sparse-x_sparse,sum)"));
+}
+
+TEST("require that fused reduce can be debug dumped") {
+    EvalFixture fixture(prod_engine, "reduce(map(x5_A-x5_B,f(x)(x*x)),sum)", param_repo, true);
+    auto info = fixture.find_all<DenseFusedReduceFunction>();
+    ASSERT_EQUAL(info.size(), 1u);
+    fprintf(stderr, "%s\n", info[0]->as_string().c_str());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
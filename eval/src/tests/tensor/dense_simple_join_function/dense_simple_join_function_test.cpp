@@ -0,0 +1,110 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/simple_tensor.h>
+#include <vespa/eval/eval/simple_tensor_engine.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_simple_join_function.h>
+#include <vespa/eval/tensor/dense/dense_inplace_join_function.h>
+#include <vespa/eval/tensor/dense/dense_tensor.h>
+#include <vespa/eval/eval/test/tensor_model.hpp>
+#include <vespa/eval/eval/test/eval_fixture.h>
+
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/stash.h>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::test;
+using namespace vespalib::tensor;
+using namespace vespalib::eval::tensor_function;
+
+const TensorEngine &prod_engine = DefaultTensorEngine::ref();
+
+EvalFixture::ParamRepo make_params() {
+    return EvalFixture::ParamRepo()
+        .add("a", spec(1.5))
+        .add("x5_A", spec({x(5)}, N()))
+        .add("x5_B", spec({x(5)}, N()))
+        .add("x5_C", spec({x(5)}, N()))
+        .add("x4", spec({x(4)}, N()))
+        .add("x5y3_A", spec({x(5),y(3)}, N()))
+        .add("x5y3_B", spec({x(5),y(3)}, N()))
+        .add("x5_unbound", spec({x(5)}, N()), "tensor(x[])")
+        .add("x_sparse", spec({x({"a", "b", "c"})}, N()))
+        .add_mutable("mut_x5", spec({x(5)}, N()));
+}
+EvalFixture::ParamRepo param_repo = make_params();
+
+void verify_optimized(const vespalib::string &expr, size_t simple_cnt, size_t inplace_cnt) {
+    EvalFixture fixture(prod_engine, expr, param_repo, true, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    for (size_t i = 0; i < fixture.num_params(); ++i) {
+        EXPECT_NOT_EQUAL(fixture.get_param(i), fixture.result());
+    }
+    EXPECT_EQUAL(fixture.find_all<DenseSimpleJoinFunction>().size(), simple_cnt);
+    EXPECT_EQUAL(fixture.find_all<DenseInplaceJoinFunction>().size(), inplace_cnt);
+}
+
+void verify_left_to_inplace_join(const vespalib::string &expr) {
+    EvalFixture fixture(prod_engine, expr, param_repo, true, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    EXPECT_TRUE(fixture.find_all<DenseSimpleJoinFunction>().empty());
+    EXPECT_EQUAL(fixture.find_all<DenseInplaceJoinFunction>().size(), 1u);
+}
+
+void verify_not_optimized(const vespalib::string &expr) {
+    EvalFixture fixture(prod_engine, expr, param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref(expr, param_repo));
+    auto info = fixture.find_all<DenseSimpleJoinFunction>();
+    EXPECT_TRUE(info.empty());
+}
+
+TEST("require that dense concrete tensors with the same type are optimized") {
+    TEST_DO(verify_optimized("x5_A-x5_B", 1, 0));
+    TEST_DO(verify_optimized("x5y3_A*x5y3_B", 1, 0));
+    TEST_DO(verify_optimized("join(x5_A,x5_B,f(a,b)(a*b+1))", 1, 0));
+}
+
+TEST("require that self-join operations can be optimized") {
+    TEST_DO(verify_optimized("x5_A+x5_A", 1, 0));
+}
+
+TEST("require that the result of a simple join is joined inplace by later operations") {
+    TEST_DO(verify_optimized("(x5_A-x5_B)*x5_C", 1, 1));
+    TEST_DO(verify_optimized("x5_A*(x5_B-x5_C)", 1, 1));
+    TEST_DO(verify_optimized("(x5_A-x5_B)*(x5_B-x5_C)", 2, 1));
+}
+
+TEST("require that joins with a mutable operand are left to inplace join") {
+    TEST_DO(verify_left_to_inplace_join("mut_x5-x5_A"));
+    TEST_DO(verify_left_to_inplace_join("x5_A-mut_x5"));
+}
+
+TEST("require that join(tensor,scalar) operations are not optimized") {
+    TEST_DO(verify_not_optimized("x5_A-a"));
+    TEST_DO(verify_not_optimized("a-x5_A"));
+}
+
+TEST("require that join with different tensor shapes are not optimized") {
+    TEST_DO(verify_not_optimized("x5_A-x4"));
+    TEST_DO(verify_not_optimized("x5_A*x5y3_B"));
+}
+
+TEST("require that abstract tensors are not optimized") {
+    TEST_DO(verify_not_optimized("x5_unbound+x5_A"));
+    TEST_DO(verify_not_optimized("x5_unbound+x5_unbound"));
+}
+
+TEST("require that mapped tensors are not optimized") {
+    TEST_DO(verify_not_optimized("x_sparse+x_sparse"));
+}
+
+TEST("require that dot products are still recognized") {
+    EvalFixture fixture(prod_engine, "reduce(x5_A*x5_B,sum)", param_repo, true);
+    EXPECT_EQUAL(fixture.result(), EvalFixture::ref("reduce(x5_A*x5_B,sum)", param_repo));
+    EXPECT_TRUE(fixture.find_all<DenseSimpleJoinFunction>().empty());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/eval/tensor/sparse/sparse_tensor_builder.h>
 #include <vespa/eval/tensor/sparse/sparse_tensor_address_combiner.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_cell_index.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 
 using namespace vespalib::tensor;
@@ -106,6 +107,55 @@ TEST("Test sparse tensor address combiner") {
 
 }
 
+SparseTensorAddressRef
+makeAddress(SparseTensorAddressBuilder &builder, const std::vector<vespalib::string> &labels)
+{
+    builder.clear();
+    for (const auto &label : labels) {
+        builder.add(label);
+    }
+    return builder.getAddressRef();
+}
+
+TEST("require that tensor cell index groups cells on common dimensions")
+{
+    SparseTensorBuilder builder;
+    builder.
+        add_label(builder.define_dimension("a"), "1").
+        add_label(builder.define_dimension("b"), "2").add_cell(10).
+        add_label(builder.define_dimension("a"), "1").
+        add_label(builder.define_dimension("b"), "3").add_cell(20).
+        add_label(builder.define_dimension("a"), "2").
+        add_label(builder.define_dimension("b"), "2").add_cell(30);
+    Tensor::UP tensor = builder.build();
+    const SparseTensor &sparseTensor = dynamic_cast<const SparseTensor &>(*tensor);
+    TensorCellIndex index(sparseTensor, ValueType::tensor_type({{"b"}, {"c"}}));
+    SparseTensorAddressBuilder keyBuilder;
+    const auto *cells = index.lookup(makeAddress(keyBuilder, {"2"}));
+    ASSERT_TRUE(cells != nullptr);
+    EXPECT_EQUAL(2u, cells->size());
+    double sum = 0;
+    for (const auto &cell : *cells) {
+        sum += cell.second;
+    }
+    EXPECT_EQUAL(40.0, sum);
+    cells = index.lookup(makeAddress(keyBuilder, {"3"}));
+    ASSERT_TRUE(cells != nullptr);
+    ASSERT_EQUAL(1u, cells->size());
+    EXPECT_EQUAL(20.0, (*cells)[0].second);
+    EXPECT_TRUE(index.lookup(makeAddress(keyBuilder, {"4"})) == nullptr);
+}
+
+TEST("require that tensor address projector keeps labels of common dimensions")
+{
+    TensorAddressProjector projector(ValueType::tensor_type({{"a"}, {"b"}, {"c"}}),
+                                     ValueType::tensor_type({{"a"}, {"c"}, {"d"}}));
+    SparseTensorAddressBuilder addressBuilder;
+    SparseTensorAddressBuilder expBuilder;
+    SparseTensorAddressRef projected = projector.project(makeAddress(addressBuilder, {"x", "y", "z"}));
+    EXPECT_TRUE(makeAddress(expBuilder, {"x", "z"}) == projected);
+}
+
 TEST("Test essential object sizes") {
     EXPECT_EQUAL(16u, sizeof(SparseTensorAddressRef));
     EXPECT_EQUAL(24u, sizeof(std::pair<SparseTensorAddressRef, double>));
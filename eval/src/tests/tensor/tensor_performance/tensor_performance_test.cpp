@@ -22,6 +22,7 @@ const vespalib::string dot_product_match_expr    = "reduce(query*document,sum)";
 const vespalib::string dot_product_multiply_expr = "reduce(query*document,sum)";
 const vespalib::string model_match_expr          = "reduce((query*document)*model,sum)";
 const vespalib::string matrix_product_expr       = "reduce(reduce((query+document)*model,sum,x),sum)";
+const vespalib::string squared_distance_expr     = "reduce(map(query-document,f(x)(x*x)),sum)";
 
 //-----------------------------------------------------------------------------
 
@@ -135,6 +136,19 @@ TEST("SMOKETEST - require that matrix product benchmark expression produces expe
     EXPECT_EQUAL(calculate_expression(matrix_product_expr, params), 17.0);
 }
 
+TEST("SMOKETEST - require that squared distance benchmark expression produces expected result") {
+    Params params;
+    params.add("query",    make_tensor(TensorSpec("tensor(x[3])")
+                                       .add({{"x",0}}, 1.0)
+                                       .add({{"x",1}}, 2.0)
+                                       .add({{"x",2}}, 3.0)));
+    params.add("document", make_tensor(TensorSpec("tensor(x[3])")
+                                       .add({{"x",0}}, 2.0)
+                                       .add({{"x",1}}, 2.0)
+                                       .add({{"x",2}}, 2.0)));
+    EXPECT_EQUAL(calculate_expression(squared_distance_expr, params), 2.0);
+}
+
 //-----------------------------------------------------------------------------
 
 struct DummyBuilder : TensorBuilder {
@@ -363,6 +377,18 @@ TEST("benchmark matrix product") {
     }
 }
 
+TEST("benchmark squared distance (fused map/join/reduce)") {
+    for (size_t size: {10, 25, 50, 100, 250, 1000}) {
+        Params params;
+        params.add("query",    make_tensor(DENSE, {DimensionSpec("x", size)}));
+        params.add("document", make_tensor(DENSE, {DimensionSpec("x", size)}));
+        double time_us = benchmark_expression_us(squared_distance_expr, params);
+        size_t saved_bytes = size * sizeof(double);
+        fprintf(stderr, "-- squared distance (%s) %zu vs %zu: %g us (%zu bytes of intermediate cells avoided)\n",
+                name(DENSE), size, size, time_us, saved_bytes);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -10,6 +10,7 @@
 #include <vespa/eval/tensor/serialization/sparse_binary_format.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/objects/hexdump.h>
+#include <vespa/vespalib/util/exceptions.h>
 #include <ostream>
 
 using namespace vespalib::tensor;
@@ -144,6 +145,18 @@ TEST_F("test tensor serialization for SparseTensor", SparseFixture)
 }
 
 
+TEST_F("test deserialization of sparse tensor with unsorted dimensions", SparseFixture)
+{
+    ExpBuffer buf({ 0x01, 0x02, 0x01, 0x79, 0x01, 0x78, 0x01, 0x01,
+                    0x34, 0x01, 0x32, 0x40, 0x08, 0x00, 0x00, 0x00,
+                    0x00, 0x00, 0x00 });
+    nbostream stream(&buf[0], buf.size());
+    auto tensor = TypedBinaryFormat::deserialize(stream);
+    EXPECT_EQUAL(0u, stream.size());
+    auto exp = f.createTensor({ {{{"x","2"}, {"y", "4"}}, 3} }, { "x", "y" });
+    EXPECT_EQUAL(*exp, *tensor);
+}
+
 struct DenseFixture
 {
     Tensor::UP createTensor(const DenseTensorCells &cells) {
@@ -252,4 +265,14 @@ TEST_F("test tensor serialization for DenseTensor", DenseFixture)
 }
 
 
+TEST_F("test deserialization of truncated DenseTensor fails", DenseFixture)
+{
+    Tensor::UP tensor = f.createTensor({ {{{"x",2}, {"y",4}}, 3} });
+    nbostream stream;
+    f.serialize(stream, *tensor);
+    nbostream truncated(stream.peek(), stream.size() - 1);
+    EXPECT_EXCEPTION(TypedBinaryFormat::deserialize(truncated), vespalib::IllegalStateException, "Stream failed");
+}
+
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -7,9 +7,11 @@
 #include "tensor_spec.h"
 #include "operation.h"
 #include "tensor_engine.h"
+#include "tensor_function.h"
 #include <vespa/vespalib/util/classname.h>
 #include <vespa/eval/eval/llvm/compile_cache.h>
 #include <vespa/vespalib/util/benchmark_timer.h>
+#include <algorithm>
 #include <set>
 
 #include "make_tensor_function.h"
@@ -33,13 +35,54 @@ const Function *get_lambda(const nodes::Node &node) {
     return nullptr;
 }
 
+// Upper bound on the stash memory kept by each evaluation context.
+constexpr size_t MAX_STASH_CHUNK_SIZE = 16 * 1024 * 1024;
+
+// Per-value overhead (tensor object, cleanup hooks) on top of the cells.
+constexpr size_t VALUE_OVERHEAD = 256;
+
+/**
+ * Plan the stash chunk size needed to hold all intermediate results
+ * of the given tensor function without allocating more memory. Only
+ * dense intermediate results with known size are planned for. A
+ * stash only places allocations smaller than a quarter of its chunk
+ * size inside its chunks; larger ones are allocated separately and
+ * released when the stash is cleared.
+ **/
+size_t plan_stash_chunk_size(const TensorFunction &function) {
+    size_t total = 0;
+    size_t max_value = 0;
+    std::vector<const TensorFunction *> todo({&function});
+    while (!todo.empty()) {
+        const TensorFunction &node = *todo.back();
+        todo.pop_back();
+        std::vector<TensorFunction::Child::CREF> children;
+        node.push_children(children);
+        for (const auto &child: children) {
+            todo.push_back(&child.get().get());
+        }
+        const ValueType &type = node.result_type();
+        if (!children.empty() && type.is_dense() && !type.is_abstract()) {
+            size_t cells = 1;
+            for (const auto &dim: type.dimensions()) {
+                cells *= dim.size;
+            }
+            size_t size = (cells * sizeof(double)) + VALUE_OVERHEAD;
+            total += size;
+            max_value = std::max(max_value, size);
+        }
+    }
+    size_t planned = std::max(total, 4 * max_value) + VALUE_OVERHEAD;
+    return (planned > MAX_STASH_CHUNK_SIZE) ? MAX_STASH_CHUNK_SIZE : planned;
+}
+
 } // namespace vespalib::<unnamed>
 
 
-InterpretedFunction::State::State(const TensorEngine &engine_in)
+InterpretedFunction::State::State(const TensorEngine &engine_in, size_t stash_chunk_size)
     : engine(engine_in),
       params(nullptr),
-      stash(),
+      stash(stash_chunk_size),
       stack(),
       program_offset(0)
 {
@@ -57,7 +100,7 @@ InterpretedFunction::State::init(const LazyParams &params_in) {
 }
 
 InterpretedFunction::Context::Context(const InterpretedFunction &ifun)
-    : _state(ifun._tensor_engine)
+    : _state(ifun._tensor_engine, ifun._stash_chunk_size)
 {
 }
 
@@ -65,6 +108,7 @@ InterpretedFunction::InterpretedFunction(const TensorEngine &engine, const Tenso
     : _program(),
       _stash(),
       _num_params(0),
+      _stash_chunk_size(plan_stash_chunk_size(function)),
       _tensor_engine(engine)
 {
     _program = compile_tensor_function(function, _stash);
@@ -74,11 +118,13 @@ InterpretedFunction::InterpretedFunction(const TensorEngine &engine, const nodes
     : _program(),
       _stash(),
       _num_params(num_params_in),
+      _stash_chunk_size(0),
       _tensor_engine(engine)
 {
     const TensorFunction &plain_fun = make_tensor_function(engine, root, types, _stash);
     const TensorFunction &optimized = engine.optimize(plain_fun, _stash);
     _program = compile_tensor_function(optimized, _stash);
+    _stash_chunk_size = plan_stash_chunk_size(optimized);
 }
 
 InterpretedFunction::~InterpretedFunction() {}
@@ -36,7 +36,7 @@ public:
         uint32_t                 program_offset;
         uint32_t                 if_cnt;
 
-        State(const TensorEngine &engine_in);
+        State(const TensorEngine &engine_in, size_t stash_chunk_size = 4096);
         ~State();
 
         void init(const LazyParams &params_in);
@@ -85,6 +85,7 @@ private:
     std::vector<Instruction> _program;
     Stash                    _stash;
     size_t                   _num_params;
+    size_t                   _stash_chunk_size;
     const TensorEngine      &_tensor_engine;
 
 public:
@@ -98,6 +99,7 @@ public:
     ~InterpretedFunction();
     size_t program_size() const { return _program.size(); }
     size_t num_params() const { return _num_params; }
+    size_t stash_chunk_size() const { return _stash_chunk_size; }
     const Value &eval(Context &ctx, const LazyParams &params) const;
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
     static Function::Issues detect_issues(const Function &function);
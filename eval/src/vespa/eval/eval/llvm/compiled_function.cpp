@@ -29,6 +29,25 @@ double empty_lazy_function(CompiledFunction::resolve_function, void *) { return
 
 double my_resolve(void *ctx, size_t idx) { return ((double *)ctx)[idx]; }
 
+// forests resolve all parameters before being evaluated, also when
+// passing lazy parameters; check if some forest is always evaluated
+bool has_unconditional_forest(const nodes::Node &node) {
+    if (node.is_forest()) {
+        return true;
+    }
+    if (auto if_node = nodes::as<nodes::If>(node)) {
+        return (has_unconditional_forest(if_node->cond()) ||
+                (has_unconditional_forest(if_node->true_expr()) &&
+                 has_unconditional_forest(if_node->false_expr())));
+    }
+    for (size_t i = 0; i < node.num_children(); ++i) {
+        if (has_unconditional_forest(node.get_child(i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace vespalib::eval::<unnamed>
 
 CompiledFunction::CompiledFunction(const Function &function_in, PassParams pass_params_in,
@@ -145,7 +164,7 @@ bool
 CompiledFunction::should_use_lazy_params(const Function &function)
 {
     if (gbdt::contains_gbdt(function.root(), 16)) {
-        return false; // contains gbdt
+        return !has_unconditional_forest(function.root()); // contains gbdt
     }
     auto usage = vespalib::eval::check_param_usage(function);
     for (double p_use: usage) {
@@ -0,0 +1,118 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "quick_scorer_forest.h"
+#include <vespa/eval/eval/basic_nodes.h>
+#include <vespa/eval/eval/call_nodes.h>
+#include <vespa/eval/eval/operator_nodes.h>
+#include <algorithm>
+#include <cassert>
+
+namespace vespalib {
+namespace eval {
+namespace gbdt {
+
+namespace {
+
+//-----------------------------------------------------------------------------
+
+constexpr size_t MAX_LEAFS = 64;
+
+using Check = QuickScorerForest::Check;
+
+struct TreeEncoder {
+    std::vector<std::vector<Check>> &checks;
+    std::vector<double> &leafs;
+    uint32_t tree;
+    size_t first_leaf;
+    TreeEncoder(std::vector<std::vector<Check>> &checks_in, std::vector<double> &leafs_in, uint32_t tree_in)
+        : checks(checks_in), leafs(leafs_in), tree(tree_in), first_leaf(leafs_in.size()) {}
+
+    // returns the number of leafs in the encoded sub-tree
+    size_t encode(const nodes::Node &node) {
+        auto if_node = nodes::as<nodes::If>(node);
+        if (if_node) {
+            auto less = nodes::as<nodes::Less>(if_node->cond());
+            assert(less);
+            auto symbol = nodes::as<nodes::Symbol>(less->lhs());
+            assert(symbol);
+            assert(less->rhs().is_const());
+            size_t offset = (leafs.size() - first_leaf);
+            size_t true_leafs = encode(if_node->true_expr());
+            assert((offset + true_leafs) < MAX_LEAFS);
+            uint64_t mask = ~(((uint64_t(1) << true_leafs) - 1) << offset);
+            checks[symbol->id()].emplace_back(less->rhs().get_const_value(), tree, mask);
+            return (true_leafs + encode(if_node->false_expr()));
+        } else {
+            assert(node.is_const());
+            leafs.push_back(node.get_const_value());
+            return 1;
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+} // namespace vespalib::eval::gbdt::<unnamed>
+
+QuickScorerForest::QuickScorerForest(const ForestStats &stats, const std::vector<const nodes::Node *> &trees)
+    : _checks(),
+      _feature_begin(),
+      _leafs(),
+      _tree_begin()
+{
+    std::vector<std::vector<Check>> feature_checks(stats.num_params);
+    for (const nodes::Node *tree: trees) {
+        _tree_begin.push_back(_leafs.size());
+        TreeEncoder encoder(feature_checks, _leafs, _tree_begin.size() - 1);
+        size_t num_leafs = encoder.encode(*tree);
+        assert(num_leafs <= MAX_LEAFS);
+    }
+    for (auto &checks: feature_checks) {
+        std::stable_sort(checks.begin(), checks.end(),
+                         [](const Check &a, const Check &b){ return (a.threshold < b.threshold); });
+        _feature_begin.push_back(_checks.size());
+        _checks.insert(_checks.end(), checks.begin(), checks.end());
+    }
+    _feature_begin.push_back(_checks.size());
+}
+
+Optimize::Result
+QuickScorerForest::optimize(const ForestStats &stats,
+                            const std::vector<const nodes::Node *> &trees)
+{
+    if ((stats.total_in_checks > 0) || (stats.tree_sizes.back().size > MAX_LEAFS)) {
+        return Optimize::Result();
+    }
+    return Optimize::Result(Forest::UP(new QuickScorerForest(stats, trees)), eval);
+}
+
+double
+QuickScorerForest::eval(const Forest *forest, const double *input)
+{
+    const QuickScorerForest &self = *((const QuickScorerForest *)forest);
+    std::vector<uint64_t> leaf_mask(self.num_trees(), ~uint64_t(0));
+    const Check *check = self._checks.data();
+    for (size_t feature = 0; (feature + 1) < self._feature_begin.size(); ++feature) {
+        double value = input[feature];
+        const Check *end = self._checks.data() + self._feature_begin[feature + 1];
+        // checks are sorted by threshold; stop at the first one that is true
+        // (note that a NaN input makes all checks false)
+        for (; (check < end) && !(value < check->threshold); ++check) {
+            leaf_mask[check->tree] &= check->mask;
+        }
+        check = end;
+    }
+    double sum = 0.0;
+    for (size_t tree = 0; tree < leaf_mask.size(); ++tree) {
+        sum += self._leafs[self._tree_begin[tree] + __builtin_ctzll(leaf_mask[tree])];
+    }
+    return sum;
+}
+
+Optimize::Chain QuickScorerForest::optimize_chain({optimize});
+
+//-----------------------------------------------------------------------------
+
+} // namespace vespalib::eval::gbdt
+} // namespace vespalib::eval
+} // namespace vespalib
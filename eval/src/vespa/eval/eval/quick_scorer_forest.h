@@ -0,0 +1,49 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "gbdt.h"
+
+namespace vespalib {
+namespace eval {
+namespace gbdt {
+
+/**
+ * GBDT forest optimizer using the QuickScorer evaluation strategy.
+ * Instead of traversing each tree, all checks are grouped by feature
+ * and sorted by threshold. Each false check clears the leaves of its
+ * true sub-tree from a per-tree leaf bitmask, and the exit leaf of
+ * each tree is the lowest bit left set. This trades the hard to
+ * predict branches of tree traversal for predictable linear scans.
+ * Only forests with less checks and at most 64 leaves per tree are
+ * supported.
+ **/
+class QuickScorerForest : public Forest
+{
+public:
+    struct Check {
+        double   threshold;
+        uint32_t tree;
+        uint64_t mask;
+        Check(double threshold_in, uint32_t tree_in, uint64_t mask_in)
+            : threshold(threshold_in), tree(tree_in), mask(mask_in) {}
+    };
+
+private:
+    std::vector<Check>    _checks;        // grouped by feature, sorted by threshold
+    std::vector<uint32_t> _feature_begin; // first check for each feature (+ end marker)
+    std::vector<double>   _leafs;         // leaf values for all trees, left to right
+    std::vector<uint32_t> _tree_begin;    // first leaf for each tree
+
+public:
+    QuickScorerForest(const ForestStats &stats, const std::vector<const nodes::Node *> &trees);
+    size_t num_trees() const { return _tree_begin.size(); }
+    static Optimize::Result optimize(const ForestStats &stats,
+                                     const std::vector<const nodes::Node *> &trees);
+    static double eval(const Forest *forest, const double *input);
+    static Optimize::Chain optimize_chain;
+};
+
+} // namespace vespalib::eval::gbdt
+} // namespace vespalib::eval
+} // namespace vespalib
@@ -174,7 +174,7 @@ ValueType::reduce(const std::vector<vespalib::string> &dimensions_in) const
     if (result.empty()) {
         return double_type();
     }
-    return tensor_type(std::move(result));
+    return tensor_type(std::move(result), _cell_type);
 }
 
 ValueType
@@ -195,17 +195,28 @@ ValueType::rename(const std::vector<vespalib::string> &from,
     if (!renamer.matched_all()) {
         return error_type();
     }
-    return tensor_type(dim_list);
+    return tensor_type(dim_list, _cell_type);
 }
 
 ValueType
-ValueType::tensor_type(std::vector<Dimension> dimensions_in)
+ValueType::tensor_type(std::vector<Dimension> dimensions_in, CellType cell_type)
 {
     sort_dimensions(dimensions_in);
     if (has_duplicates(dimensions_in)) {
         return error_type();
     }
-    return ValueType(Type::TENSOR, std::move(dimensions_in));
+    return ValueType(Type::TENSOR, cell_type, std::move(dimensions_in));
+}
+
+size_t
+ValueType::cell_size(CellType cell_type)
+{
+    switch (cell_type) {
+    case CellType::DOUBLE: return sizeof(double);
+    case CellType::FLOAT: return sizeof(float);
+    case CellType::INT8: return sizeof(int8_t);
+    }
+    abort();
 }
 
 ValueType
@@ -236,7 +247,7 @@ ValueType::join(const ValueType &lhs, const ValueType &rhs)
     if (result.mismatch) {
         return error_type();
     }
-    return tensor_type(std::move(result.dimensions));
+    return tensor_type(std::move(result.dimensions), unify_cell_types(lhs._cell_type, rhs._cell_type));
 }
 
 ValueType
@@ -262,7 +273,7 @@ ValueType::concat(const ValueType &lhs, const ValueType &rhs, const vespalib::st
     } else {
         result.dimensions.emplace_back(dimension, 2);
     }
-    return tensor_type(std::move(result.dimensions));
+    return tensor_type(std::move(result.dimensions), unify_cell_types(lhs._cell_type, rhs._cell_type));
 }
 
 ValueType
@@ -277,18 +288,19 @@ ValueType::either(const ValueType &one, const ValueType &other)
     if (!one.is_tensor() || !other.is_tensor()) {
         return any_type();
     }
+    CellType cell_type = unify_cell_types(one._cell_type, other._cell_type);
     if (one.dimensions().size() != other.dimensions().size()) {
-        return tensor_type({});
+        return tensor_type({}, cell_type);
     }
     std::vector<Dimension> dims;
     for (size_t i = 0; i < one.dimensions().size(); ++i) {
         const Dimension &a = one.dimensions()[i];
         const Dimension &b = other.dimensions()[i];
         if (a.name != b.name) {
-            return tensor_type({});
+            return tensor_type({}, cell_type);
         }
         if (a.is_mapped() != b.is_mapped()) {
-            return tensor_type({});
+            return tensor_type({}, cell_type);
         }
         if (a.size == b.size) {
             dims.push_back(a);
@@ -296,7 +308,7 @@ ValueType::either(const ValueType &one, const ValueType &other)
             dims.emplace_back(a.name, 0);
         }
     }
-    return tensor_type(std::move(dims));
+    return tensor_type(std::move(dims), cell_type);
 }
 
 std::ostream &
@@ -17,6 +17,12 @@ class ValueType
 {
 public:
     enum class Type { ANY, ERROR, DOUBLE, TENSOR };
+    /**
+     * How the cells of a tensor are stored. Evaluation is done with
+     * double precision; FLOAT and INT8 reduce the memory used to
+     * store tensors, e.g. in tensor attributes.
+     **/
+    enum class CellType : char { DOUBLE, FLOAT, INT8 };
     struct Dimension {
         using size_type = uint32_t;
         static constexpr size_type npos = -1;
@@ -37,12 +43,13 @@ public:
 
 private:
     Type _type;
+    CellType _cell_type;
     std::vector<Dimension> _dimensions;
 
     explicit ValueType(Type type_in)
-        : _type(type_in), _dimensions() {}
-    ValueType(Type type_in, std::vector<Dimension> &&dimensions_in)
-        : _type(type_in), _dimensions(std::move(dimensions_in)) {}
+        : _type(type_in), _cell_type(CellType::DOUBLE), _dimensions() {}
+    ValueType(Type type_in, CellType cell_type_in, std::vector<Dimension> &&dimensions_in)
+        : _type(type_in), _cell_type(cell_type_in), _dimensions(std::move(dimensions_in)) {}
 
 public:
     ValueType(ValueType &&) = default;
@@ -51,6 +58,7 @@ public:
     ValueType &operator=(const ValueType &) = default;
     ~ValueType();
     Type type() const { return _type; }
+    CellType cell_type() const { return _cell_type; }
     bool is_any() const { return (_type == Type::ANY); }
     bool is_error() const { return (_type == Type::ERROR); }
     bool is_double() const { return (_type == Type::DOUBLE); }
@@ -71,7 +79,9 @@ public:
         return (is_any() || (is_tensor() && (dimensions().empty())));
     }
     bool operator==(const ValueType &rhs) const {
-        return ((_type == rhs._type) && (_dimensions == rhs._dimensions));
+        return ((_type == rhs._type) &&
+                (_cell_type == rhs._cell_type) &&
+                (_dimensions == rhs._dimensions));
     }
     bool operator!=(const ValueType &rhs) const { return !(*this == rhs); }
 
@@ -82,7 +92,9 @@ public:
     static ValueType any_type() { return ValueType(Type::ANY); }
     static ValueType error_type() { return ValueType(Type::ERROR); };
     static ValueType double_type() { return ValueType(Type::DOUBLE); }
-    static ValueType tensor_type(std::vector<Dimension> dimensions_in);
+    static ValueType tensor_type(std::vector<Dimension> dimensions_in, CellType cell_type = CellType::DOUBLE);
+    static CellType unify_cell_types(CellType a, CellType b) { return (a == b) ? a : CellType::DOUBLE; }
+    static size_t cell_size(CellType cell_type);
     static ValueType from_spec(const vespalib::string &spec);
     vespalib::string to_spec() const;
     static ValueType join(const ValueType &lhs, const ValueType &rhs);
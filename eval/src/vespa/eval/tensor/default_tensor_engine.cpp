@@ -9,11 +9,13 @@
 #include "dense/dense_tensor_builder.h"
 #include "dense/dense_dot_product_function.h"
 #include "dense/dense_xw_product_function.h"
+#include "dense/dense_fused_reduce_function.h"
 #include "dense/dense_fast_rename_optimizer.h"
 #include "dense/dense_add_dimension_optimizer.h"
 #include "dense/dense_remove_dimension_optimizer.h"
 #include "dense/dense_inplace_join_function.h"
 #include "dense/dense_inplace_map_function.h"
+#include "dense/dense_simple_join_function.h"
 #include "dense/vector_from_doubles_function.h"
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/tensor_spec.h>
@@ -230,11 +232,13 @@ DefaultTensorEngine::optimize(const TensorFunction &expr, Stash &stash) const
         child.set(VectorFromDoublesFunction::optimize(child.get(), stash));
         child.set(DenseDotProductFunction::optimize(child.get(), stash));
         child.set(DenseXWProductFunction::optimize(child.get(), stash));
+        child.set(DenseFusedReduceFunction::optimize(child.get(), stash));
         child.set(DenseFastRenameOptimizer::optimize(child.get(), stash));
         child.set(DenseAddDimensionOptimizer::optimize(child.get(), stash));
         child.set(DenseRemoveDimensionOptimizer::optimize(child.get(), stash));
         child.set(DenseInplaceMapFunction::optimize(child.get(), stash));
         child.set(DenseInplaceJoinFunction::optimize(child.get(), stash));
+        child.set(DenseSimpleJoinFunction::optimize(child.get(), stash));
         nodes.pop_back();
     }
     LOG(debug, "tensor function after optimization:\n%s\n", root.get().as_string().c_str());
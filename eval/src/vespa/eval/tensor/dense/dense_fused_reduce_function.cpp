@@ -0,0 +1,126 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_fused_reduce_function.h"
+#include "dense_tensor_view.h"
+#include <vespa/vespalib/objects/objectvisitor.h>
+#include <vespa/eval/eval/value.h>
+
+namespace vespalib::tensor {
+
+using CellsRef = DenseTensorView::CellsRef;
+using eval::ValueType;
+using eval::TensorFunction;
+using eval::Aggr;
+using eval::Aggregator;
+using eval::as;
+using namespace eval::tensor_function;
+
+namespace {
+
+CellsRef getCellsRef(const eval::Value &value) {
+    const DenseTensorView &denseTensor = static_cast<const DenseTensorView &>(value);
+    return denseTensor.cellsRef();
+}
+
+struct FusedParams {
+    join_fun_t join_fun;
+    map_fun_t map_fun;
+    Aggr aggr;
+    FusedParams(join_fun_t join_fun_in, map_fun_t map_fun_in, Aggr aggr_in)
+        : join_fun(join_fun_in), map_fun(map_fun_in), aggr(aggr_in) {}
+};
+
+template <bool has_map>
+double calc_cell(const FusedParams &params, double lhs, double rhs) {
+    double value = params.join_fun(lhs, rhs);
+    return has_map ? params.map_fun(value) : value;
+}
+
+template <bool has_map, bool is_sum>
+void my_fused_reduce_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const FusedParams &params = *(const FusedParams *)param;
+    CellsRef lhs_cells = getCellsRef(state.peek(1));
+    CellsRef rhs_cells = getCellsRef(state.peek(0));
+    double result = 0.0;
+    if (is_sum) {
+        for (size_t i = 0; i < lhs_cells.size(); ++i) {
+            result += calc_cell<has_map>(params, lhs_cells[i], rhs_cells[i]);
+        }
+    } else if (lhs_cells.size() > 0) {
+        Aggregator &aggr = Aggregator::create(params.aggr, state.stash);
+        aggr.first(calc_cell<has_map>(params, lhs_cells[0], rhs_cells[0]));
+        for (size_t i = 1; i < lhs_cells.size(); ++i) {
+            aggr.next(calc_cell<has_map>(params, lhs_cells[i], rhs_cells[i]));
+        }
+        result = aggr.result();
+    }
+    state.pop_pop_push(state.stash.create<eval::DoubleValue>(result));
+}
+
+template <bool has_map>
+eval::InterpretedFunction::op_function select_op(Aggr aggr) {
+    return (aggr == Aggr::SUM) ? my_fused_reduce_op<has_map, true> : my_fused_reduce_op<has_map, false>;
+}
+
+bool sameShapeConcreteDenseTensors(const ValueType &a, const ValueType &b) {
+    return (a.is_dense() && !a.is_abstract() && (a == b));
+}
+
+} // namespace vespalib::tensor::<unnamed>
+
+
+DenseFusedReduceFunction::DenseFusedReduceFunction(const TensorFunction &lhs,
+                                                   const TensorFunction &rhs,
+                                                   join_fun_t join_fun,
+                                                   map_fun_t map_fun,
+                                                   Aggr aggr)
+    : Super(ValueType::double_type(), lhs, rhs),
+      _join_fun(join_fun),
+      _map_fun(map_fun),
+      _aggr(aggr)
+{
+}
+
+DenseFusedReduceFunction::~DenseFusedReduceFunction()
+{
+}
+
+eval::InterpretedFunction::Instruction
+DenseFusedReduceFunction::compile_self(Stash &stash) const
+{
+    const FusedParams &params = stash.create<FusedParams>(_join_fun, _map_fun, _aggr);
+    auto op = (_map_fun != nullptr) ? select_op<true>(_aggr) : select_op<false>(_aggr);
+    return eval::InterpretedFunction::Instruction(op, (uint64_t)(&params));
+}
+
+void
+DenseFusedReduceFunction::visit_self(vespalib::ObjectVisitor &visitor) const
+{
+    Super::visit_self(visitor);
+    visitor.visitBool("has_map", (_map_fun != nullptr));
+    visitor.visitString("aggr", *eval::AggrNames::name_of(_aggr));
+}
+
+const TensorFunction &
+DenseFusedReduceFunction::optimize(const eval::TensorFunction &expr, Stash &stash)
+{
+    const Reduce *reduce = as<Reduce>(expr);
+    if (reduce && reduce->result_type().is_double()) {
+        map_fun_t map_fun = nullptr;
+        const TensorFunction *child = &reduce->child();
+        if (auto map = as<Map>(*child)) {
+            map_fun = map->function();
+            child = &map->child();
+        }
+        if (auto join = as<Join>(*child)) {
+            const TensorFunction &lhs = join->lhs();
+            const TensorFunction &rhs = join->rhs();
+            if (sameShapeConcreteDenseTensors(lhs.result_type(), rhs.result_type())) {
+                return stash.create<DenseFusedReduceFunction>(lhs, rhs, join->function(), map_fun, reduce->aggr());
+            }
+        }
+    }
+    return expr;
+}
+
+} // namespace vespalib::tensor
@@ -0,0 +1,42 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/aggr.h>
+
+namespace vespalib::tensor {
+
+/**
+ * Tensor function for a full reduce of an elementwise join of two
+ * dense tensors with the same concrete type, optionally followed by a
+ * map: reduce(map(join(a,b,f),g),aggr). All steps are done in a single
+ * loop over the input cells, without creating intermediate tensors.
+ **/
+class DenseFusedReduceFunction : public eval::tensor_function::Op2
+{
+    using Super = eval::tensor_function::Op2;
+public:
+    using join_fun_t = ::vespalib::eval::tensor_function::join_fun_t;
+    using map_fun_t = ::vespalib::eval::tensor_function::map_fun_t;
+private:
+    join_fun_t _join_fun;
+    map_fun_t  _map_fun;
+    eval::Aggr _aggr;
+public:
+    DenseFusedReduceFunction(const TensorFunction &lhs,
+                             const TensorFunction &rhs,
+                             join_fun_t join_fun,
+                             map_fun_t map_fun,
+                             eval::Aggr aggr);
+    ~DenseFusedReduceFunction();
+    join_fun_t join_fun() const { return _join_fun; }
+    map_fun_t map_fun() const { return _map_fun; }
+    eval::Aggr aggr() const { return _aggr; }
+    bool result_is_mutable() const override { return true; }
+    eval::InterpretedFunction::Instruction compile_self(Stash &stash) const override;
+    void visit_self(vespalib::ObjectVisitor &visitor) const override;
+    static const eval::TensorFunction &optimize(const eval::TensorFunction &expr, Stash &stash);
+};
+
+} // namespace vespalib::tensor
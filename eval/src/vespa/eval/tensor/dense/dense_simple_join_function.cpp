@@ -0,0 +1,81 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_simple_join_function.h"
+#include "dense_tensor_view.h"
+#include <vespa/eval/eval/value.h>
+
+namespace vespalib::tensor {
+
+using CellsRef = DenseTensorView::CellsRef;
+using eval::ValueType;
+using eval::TensorFunction;
+using eval::as;
+using namespace eval::tensor_function;
+
+namespace {
+
+CellsRef getCellsRef(const eval::Value &value) {
+    const DenseTensorView &denseTensor = static_cast<const DenseTensorView &>(value);
+    return denseTensor.cellsRef();
+}
+
+struct JoinParams {
+    const ValueType &result_type;
+    join_fun_t function;
+    JoinParams(const ValueType &result_type_in, join_fun_t function_in)
+        : result_type(result_type_in), function(function_in) {}
+};
+
+void my_simple_join_op(eval::InterpretedFunction::State &state, uint64_t param) {
+    const JoinParams &params = *(JoinParams*)param;
+    CellsRef lhs_cells = getCellsRef(state.peek(1));
+    CellsRef rhs_cells = getCellsRef(state.peek(0));
+    ArrayRef<double> dst_cells = state.stash.create_array<double>(lhs_cells.size());
+    for (size_t i = 0; i < dst_cells.size(); ++i) {
+        dst_cells[i] = params.function(lhs_cells[i], rhs_cells[i]);
+    }
+    state.pop_pop_push(state.stash.create<DenseTensorView>(params.result_type, dst_cells));
+}
+
+bool sameShapeConcreteDenseTensors(const ValueType &a, const ValueType &b) {
+    return (a.is_dense() && !a.is_abstract() && (a == b));
+}
+
+} // namespace vespalib::tensor::<unnamed>
+
+
+DenseSimpleJoinFunction::DenseSimpleJoinFunction(const ValueType &result_type,
+                                                 const TensorFunction &lhs,
+                                                 const TensorFunction &rhs,
+                                                 join_fun_t function_in)
+    : eval::tensor_function::Join(result_type, lhs, rhs, function_in)
+{
+}
+
+DenseSimpleJoinFunction::~DenseSimpleJoinFunction()
+{
+}
+
+eval::InterpretedFunction::Instruction
+DenseSimpleJoinFunction::compile_self(Stash &stash) const
+{
+    const JoinParams &params = stash.create<JoinParams>(result_type(), function());
+    return eval::InterpretedFunction::Instruction(my_simple_join_op, (uint64_t)(&params));
+}
+
+const TensorFunction &
+DenseSimpleJoinFunction::optimize(const eval::TensorFunction &expr, Stash &stash)
+{
+    if (auto join = as<Join>(expr)) {
+        const TensorFunction &lhs = join->lhs();
+        const TensorFunction &rhs = join->rhs();
+        if (!lhs.result_is_mutable() && !rhs.result_is_mutable() &&
+            sameShapeConcreteDenseTensors(lhs.result_type(), rhs.result_type()))
+        {
+            return stash.create<DenseSimpleJoinFunction>(join->result_type(), lhs, rhs, join->function());
+        }
+    }
+    return expr;
+}
+
+} // namespace vespalib::tensor
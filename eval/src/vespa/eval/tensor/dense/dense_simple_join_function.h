@@ -0,0 +1,30 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+
+namespace vespalib::tensor {
+
+/**
+ * Tensor function for join operations on two dense tensors with the
+ * same concrete type where neither side may be overwritten. The cells
+ * are combined in a single loop into a new tensor, which may then be
+ * modified inplace by later operations.
+ **/
+class DenseSimpleJoinFunction : public eval::tensor_function::Join
+{
+    using Super = eval::tensor_function::Join;
+public:
+    using join_fun_t = ::vespalib::eval::tensor_function::join_fun_t;
+    DenseSimpleJoinFunction(const eval::ValueType &result_type,
+                            const TensorFunction &lhs,
+                            const TensorFunction &rhs,
+                            join_fun_t function_in);
+    ~DenseSimpleJoinFunction();
+    bool result_is_mutable() const override { return true; }
+    eval::InterpretedFunction::Instruction compile_self(Stash &stash) const override;
+    static const eval::TensorFunction &optimize(const eval::TensorFunction &expr, Stash &stash);
+};
+
+} // namespace vespalib::tensor
@@ -8,6 +8,7 @@
 #include <vespa/eval/eval/operation.h>
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <algorithm>
 #include <assert.h>
 
 namespace vespalib::tensor {
@@ -45,17 +46,22 @@ void multiDotProduct(const DenseXWProductFunction::Self &self,
 void transposedProduct(const DenseXWProductFunction::Self &self,
                        const XWInput &vectorCells, const XWInput &matrixCells, XWOutput &result)
 {
-    double *out = result.begin();
-    const double * const matrixP = matrixCells.cbegin();
+    // Walk the matrix in memory order and accumulate into all result
+    // cells at once, instead of striding through one column per result
+    // cell. Each result cell sees its terms in the same order as before.
+    double * const out = result.begin();
+    const double *matrixP = matrixCells.cbegin();
     const double * const vectorP = vectorCells.cbegin();
-    for (size_t row = 0; row < self._resultSize; ++row) {
-        double cell = 0;
-        for (size_t col = 0; col < self._vectorSize; ++col) {
-            cell += matrixP[col*self._resultSize + row] * vectorP[col];
+    std::fill(out, out + self._resultSize, 0.0);
+    for (size_t col = 0; col < self._vectorSize; ++col) {
+        const double factor = vectorP[col];
+        for (size_t row = 0; row < self._resultSize; ++row) {
+            out[row] += matrixP[row] * factor;
         }
-        *out++ = cell;
+        matrixP += self._resultSize;
     }
-    assert(out == result.end());
+    assert(matrixP == matrixCells.cend());
+    assert(out + self._resultSize == result.end());
 }
 
 template <bool commonDimensionInnermost>
@@ -39,6 +39,7 @@ private:
     };
 
     MutableValueType _concreteType;
+    Cells _convertedCells;
 
 public:
     MutableDenseTensorView(eval::ValueType type_in);
@@ -46,6 +47,16 @@ public:
     void setCells(CellsRef cells_in) {
         _cellsRef = cells_in;
     }
+    /**
+     * Set cells that are stored with another cell type than double. They
+     * are converted into a buffer owned by this view, which is reused
+     * between calls.
+     */
+    template <typename CellType>
+    void setConvertedCells(ConstArrayRef<CellType> cells_in) {
+        _convertedCells.assign(cells_in.cbegin(), cells_in.cend());
+        _cellsRef = CellsRef(_convertedCells.data(), _convertedCells.size());
+    }
     void setUnboundDimensions(const uint32_t *unboundDimSizeBegin, const uint32_t *unboundDimSizeEnd) {
         _concreteType.setUnboundDimensions(unboundDimSizeBegin, unboundDimSizeEnd);
     }
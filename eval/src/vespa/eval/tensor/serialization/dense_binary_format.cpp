@@ -54,11 +54,16 @@ DenseBinaryFormat::deserialize(nbostream &stream)
         dimensions.emplace_back(dimensionName, dimensionSize);
         cellsSize *= dimensionSize;
     }
-    cells.reserve(cellsSize);
-    double cellValue = 0.0;
-    for (size_t i = 0; i < cellsSize; ++i) {
-        stream >> cellValue;
-        cells.emplace_back(cellValue);
+    size_t cellsBytes = cellsSize * sizeof(double);
+    if (stream.size() < cellsBytes) {
+        // Fails the stream without allocating cells for a truncated tensor
+        stream.adjustReadPos(cellsBytes);
+    }
+    // Copy all cells in one go, then convert them from network byte order in place
+    cells.resize(cellsSize);
+    stream.read(cells.data(), cellsBytes);
+    for (auto &cell : cells) {
+        cell = nbo::n2h(cell);
     }
     return std::make_unique<DenseTensor>(makeValueType(std::move(dimensions)),
                                          std::move(cells));
@@ -5,6 +5,8 @@
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/tensor_builder.h>
 #include <vespa/eval/tensor/tensor_visitor.h>
+#include <vespa/eval/tensor/sparse/sparse_tensor_builder.h>
+#include <vespa/eval/tensor/sparse/direct_sparse_tensor_builder.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <sstream>
 #include <cassert>
@@ -36,6 +38,17 @@ writeTensorAddress(nbostream &output,
     assert(elemItr == elemItrEnd);
 }
 
+bool
+isSortedAndUnique(const std::vector<eval::ValueType::Dimension> &dimensions)
+{
+    for (size_t i = 1; i < dimensions.size(); ++i) {
+        if (!(dimensions[i - 1].name < dimensions[i].name)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }
 
 class SparseBinaryFormatSerializer : public TensorVisitor
@@ -121,5 +134,44 @@ SparseBinaryFormat::deserialize(nbostream &stream, TensorBuilder &builder)
 }
 
 
+std::unique_ptr<Tensor>
+SparseBinaryFormat::deserialize(nbostream &stream)
+{
+    auto read_pos = stream.rp();
+    vespalib::string str;
+    size_t dimensionsSize = stream.getInt1_4Bytes();
+    std::vector<eval::ValueType::Dimension> dimensions;
+    while (dimensions.size() < dimensionsSize) {
+        stream.readSmallString(str);
+        dimensions.emplace_back(str);
+    }
+    if (!isSortedAndUnique(dimensions)) {
+        stream.adjustReadPos(read_pos - stream.rp());
+        SparseTensorBuilder builder;
+        deserialize(stream, builder);
+        return builder.build();
+    }
+    // Labels are serialized in dimension order, which is also the
+    // order used by sparse tensor addresses, so each address can be
+    // built directly from the labels in the stream.
+    DirectTensorBuilder<SparseTensor> builder(eval::ValueType::tensor_type(std::move(dimensions)));
+    SparseTensorAddressBuilder address;
+    size_t cellsSize = stream.getInt1_4Bytes();
+    builder.reserve(cellsSize);
+    double cellValue = 0.0;
+    for (size_t cellIdx = 0; cellIdx < cellsSize; ++cellIdx) {
+        address.clear();
+        for (size_t dimension = 0; dimension < dimensionsSize; ++dimension) {
+            size_t labelSize = stream.getInt1_4Bytes();
+            address.add(vespalib::stringref(stream.peek(), labelSize));
+            stream.adjustReadPos(labelSize);
+        }
+        stream >> cellValue;
+        builder.insertCell(address, cellValue, [](double, double rhs) { return rhs; });
+    }
+    return builder.build();
+}
+
+
 } // namespace vespalib::tensor
 } // namespace vespalib
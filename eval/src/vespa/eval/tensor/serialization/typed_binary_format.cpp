@@ -4,7 +4,6 @@
 #include "sparse_binary_format.h"
 #include "dense_binary_format.h"
 #include <vespa/vespalib/objects/nbostream.h>
-#include <vespa/eval/tensor/default_tensor.h>
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/dense/dense_tensor.h>
 #include <vespa/eval/eval/simple_tensor.h>
@@ -40,9 +39,7 @@ TypedBinaryFormat::deserialize(nbostream &stream)
     auto read_pos = stream.rp();
     auto formatId = stream.getInt1_4Bytes();
     if (formatId == SPARSE_BINARY_FORMAT_TYPE) {
-        DefaultTensor::builder builder;
-        SparseBinaryFormat::deserialize(stream, builder);
-        return builder.build();
+        return SparseBinaryFormat::deserialize(stream);
     }
     if (formatId == DENSE_BINARY_FORMAT_TYPE) {
         return DenseBinaryFormat::deserialize(stream);
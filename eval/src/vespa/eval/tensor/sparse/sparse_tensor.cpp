@@ -9,8 +9,6 @@
 #include <vespa/eval/tensor/tensor_apply.h>
 #include <vespa/eval/tensor/tensor_visitor.h>
 #include <vespa/eval/eval/operation.h>
-#include <vespa/vespalib/stllike/hash_map.hpp>
-#include <vespa/vespalib/stllike/hash_map_equal.hpp>
 #include <vespa/vespalib/util/array_equal.hpp>
 
 using vespalib::eval::TensorSpec;
@@ -38,6 +36,7 @@ SparseTensor::SparseTensor(const eval::ValueType &type_in, const Cells &cells_in
       _cells(),
       _stash(STASH_CHUNK_SIZE)
 {
+    _cells.resize(cells_in.size());
     copyCells(_cells, cells_in, _stash);
 }
 
@@ -187,6 +186,3 @@ SparseTensor::reduce(join_fun_t op,
 }
 
 }
-
-VESPALIB_HASH_MAP_INSTANTIATE_H_E_M(vespalib::tensor::SparseTensorAddressRef, double, vespalib::hash<vespalib::tensor::SparseTensorAddressRef>,
-        std::equal_to<vespalib::tensor::SparseTensorAddressRef>, vespalib::hashtable_base::and_modulator);
@@ -7,7 +7,7 @@
 #include <vespa/eval/tensor/tensor_address.h>
 #include "sparse_tensor_address_ref.h"
 #include <vespa/eval/tensor/types.h>
-#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/swiss_hash_map.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/stash.h>
 
@@ -21,8 +21,7 @@ namespace vespalib::tensor {
 class SparseTensor : public Tensor
 {
 public:
-    using Cells = hash_map<SparseTensorAddressRef, double, hash<SparseTensorAddressRef>,
-            std::equal_to<SparseTensorAddressRef>, hashtable_base::and_modulator>;
+    using Cells = swiss_hash_map<SparseTensorAddressRef, double, hash<SparseTensorAddressRef>>;
 
     static constexpr size_t STASH_CHUNK_SIZE = 16384u;
 
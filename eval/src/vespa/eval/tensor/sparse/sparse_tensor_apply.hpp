@@ -4,8 +4,10 @@
 
 #include "sparse_tensor_apply.h"
 #include "sparse_tensor_address_combiner.h"
+#include "sparse_tensor_cell_index.h"
 #include <vespa/eval/tensor/direct_tensor_builder.h>
 #include "direct_sparse_tensor_builder.h"
+#include <cassert>
 
 namespace vespalib::tensor::sparse {
 
@@ -15,17 +17,33 @@ apply(const SparseTensor &lhs, const SparseTensor &rhs, Function &&func)
 {
     DirectTensorBuilder<SparseTensor> builder(lhs.combineDimensionsWith(rhs));
     TensorAddressCombiner addressCombiner(lhs.fast_type(), rhs.fast_type());
-    size_t estimatedCells = (lhs.cells().size() * rhs.cells().size());
-    if (addressCombiner.numOverlappingDimensions() != 0) {
-        estimatedCells = std::min(lhs.cells().size(), rhs.cells().size());
-    }
-    builder.reserve(estimatedCells*2);
-    for (const auto &lhsCell : lhs.cells()) {
-        for (const auto &rhsCell : rhs.cells()) {
-            bool combineSuccess = addressCombiner.combine(lhsCell.first, rhsCell.first);
-            if (combineSuccess) {
-                builder.insertCell(addressCombiner.getAddressRef(),
-                                   func(lhsCell.second, rhsCell.second));
+    if (addressCombiner.numOverlappingDimensions() == 0) {
+        builder.reserve(lhs.cells().size() * rhs.cells().size() * 2);
+        for (const auto &lhsCell : lhs.cells()) {
+            for (const auto &rhsCell : rhs.cells()) {
+                bool combineSuccess = addressCombiner.combine(lhsCell.first, rhsCell.first);
+                if (combineSuccess) {
+                    builder.insertCell(addressCombiner.getAddressRef(),
+                                       func(lhsCell.second, rhsCell.second));
+                }
+            }
+        }
+    } else {
+        // Only pairs of cells with equal labels in the common dimensions
+        // are combined; find them through an index instead of trying all.
+        builder.reserve(std::min(lhs.cells().size(), rhs.cells().size()) * 2);
+        TensorCellIndex rhsIndex(rhs, lhs.fast_type());
+        TensorAddressProjector lhsProjector(lhs.fast_type(), rhs.fast_type());
+        for (const auto &lhsCell : lhs.cells()) {
+            const auto *rhsCells = rhsIndex.lookup(lhsProjector.project(lhsCell.first));
+            if (rhsCells != nullptr) {
+                for (const auto &rhsCell : *rhsCells) {
+                    bool combineSuccess = addressCombiner.combine(lhsCell.first, rhsCell.first);
+                    assert(combineSuccess);
+                    (void) combineSuccess;
+                    builder.insertCell(addressCombiner.getAddressRef(),
+                                       func(lhsCell.second, rhsCell.second));
+                }
             }
         }
     }
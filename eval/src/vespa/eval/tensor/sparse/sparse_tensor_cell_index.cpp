@@ -0,0 +1,61 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sparse_tensor_cell_index.h"
+#include "sparse_tensor_address_decoder.h"
+#include <vespa/eval/eval/value_type.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+namespace vespalib::tensor::sparse {
+
+TensorAddressProjector::TensorAddressProjector(const eval::ValueType &type, const eval::ValueType &other)
+    : SparseTensorAddressBuilder(),
+      _keep()
+{
+    for (const auto &dim : type.dimensions()) {
+        _keep.push_back(other.dimension_index(dim.name) != eval::ValueType::Dimension::npos);
+    }
+}
+
+TensorAddressProjector::~TensorAddressProjector() = default;
+
+SparseTensorAddressRef
+TensorAddressProjector::project(SparseTensorAddressRef ref)
+{
+    clear();
+    ensure_room(ref.size());
+    SparseTensorAddressDecoder decoder(ref);
+    for (bool keep : _keep) {
+        if (keep) {
+            append(decoder.decodeLabel());
+        } else {
+            decoder.skipLabel();
+        }
+    }
+    return getAddressRef();
+}
+
+TensorCellIndex::TensorCellIndex(const SparseTensor &tensor, const eval::ValueType &other)
+    : _stash(),
+      _map(tensor.cells().size() * 2)
+{
+    TensorAddressProjector projector(tensor.fast_type(), other);
+    for (const auto &cell : tensor.cells()) {
+        SparseTensorAddressRef key = projector.project(cell.first);
+        auto itr = _map.find(key);
+        if (itr == _map.end()) {
+            itr = _map.insert(std::make_pair(SparseTensorAddressRef(key, _stash), CellList())).first;
+        }
+        itr->second.emplace_back(cell.first, cell.second);
+    }
+}
+
+TensorCellIndex::~TensorCellIndex() = default;
+
+const TensorCellIndex::CellList *
+TensorCellIndex::lookup(SparseTensorAddressRef key) const
+{
+    auto itr = _map.find(key);
+    return (itr != _map.end()) ? &itr->second : nullptr;
+}
+
+}
@@ -0,0 +1,50 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "sparse_tensor.h"
+#include "sparse_tensor_address_builder.h"
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/util/stash.h>
+#include <vector>
+
+namespace vespalib::eval { class ValueType; }
+namespace vespalib::tensor::sparse {
+
+/**
+ * Extracts the labels for the dimensions that a tensor type shares
+ * with another tensor type from tensor addresses of the first type.
+ */
+class TensorAddressProjector : public SparseTensorAddressBuilder
+{
+    std::vector<bool> _keep;
+public:
+    TensorAddressProjector(const eval::ValueType &type, const eval::ValueType &other);
+    ~TensorAddressProjector();
+    SparseTensorAddressRef project(SparseTensorAddressRef ref);
+};
+
+/**
+ * Hash index over the cells of a sparse tensor, keyed on the labels
+ * of the dimensions shared with another tensor type. Used when joining
+ * sparse tensors with common dimensions, so that only the pairs of
+ * cells that agree on the common dimensions are visited instead of
+ * all pairs of cells.
+ */
+class TensorCellIndex
+{
+public:
+    using Cell = std::pair<SparseTensorAddressRef, double>;
+    using CellList = std::vector<Cell>;
+private:
+    using Map = hash_map<SparseTensorAddressRef, CellList, hash<SparseTensorAddressRef>,
+                         std::equal_to<SparseTensorAddressRef>, hashtable_base::and_modulator>;
+    Stash _stash;
+    Map   _map;
+public:
+    TensorCellIndex(const SparseTensor &tensor, const eval::ValueType &other);
+    ~TensorCellIndex();
+    const CellList *lookup(SparseTensorAddressRef key) const;
+};
+
+}
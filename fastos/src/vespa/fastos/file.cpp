@@ -490,6 +490,12 @@ void FastOS_FileInterface::dropFromCache() const
 {
 }
 
+void FastOS_FileInterface::prefetch(int64_t position, size_t length) const
+{
+    (void) position;
+    (void) length;
+}
+
 FastOS_DirectoryScanInterface::FastOS_DirectoryScanInterface(const char *path)
     : _searchPath(strdup(path))
 {
@@ -587,6 +587,16 @@ public:
      **/
     virtual void dropFromCache() const;
 
+    /**
+     * Hint that the given part of the file will be read soon, so the
+     * file system can start reading it in the background. Does not
+     * wait for the data.
+     *
+     * @param position  File offset of the start of the range
+     * @param length    Length of the range in bytes
+     **/
+    virtual void prefetch(int64_t position, size_t length) const;
+
     enum Error
     {
         ERR_ZERO = 1,   // No error                       New style
@@ -18,7 +18,8 @@ const size_t FastOS_Linux_File::_directIOMemAlign = 4096;
 FastOS_Linux_File::FastOS_Linux_File(const char *filename)
     : FastOS_UNIX_File(filename),
       _cachedSize(-1),
-      _filePointer(-1)
+      _filePointer(-1),
+      _dropWrittenPages(false)
 {
 }
 
@@ -65,6 +66,9 @@ FastOS_Linux_File::writeInternal(int fh, const void *buffer, size_t length, int6
         const char *fileName = GetFileName();
         _failedHandler("write", fileName, error, writeOffset, length, writeRes);
         errno = error;
+    } else if (writeRes > 0 && _dropWrittenPages) {
+        // Pages written with O_SYNC are clean, drop them from the page cache like O_DIRECT would
+        posix_fadvise(fh, writeOffset, writeRes, POSIX_FADV_DONTNEED);
     }
     return writeRes;
 }
@@ -383,6 +387,7 @@ FastOS_Linux_File::Open(unsigned int openFlags, const char *filename)
     bool rc;
     _cachedSize = -1;
     _filePointer = -1;
+    _dropWrittenPages = false;
     if (_directIOEnabled && (_openFlags & FASTOS_FILE_OPEN_STDFLAGS) != 0) {
         _directIOEnabled = false;
     }
@@ -393,6 +398,7 @@ FastOS_Linux_File::Open(unsigned int openFlags, const char *filename)
         rc = FastOS_UNIX_File::Open(openFlags | FASTOS_FILE_OPEN_DIRECTIO, filename);
         if ( ! rc ) {  //Retry without directIO.
             rc = FastOS_UNIX_File::Open(openFlags | FASTOS_FILE_OPEN_SYNCWRITES, filename);
+            _dropWrittenPages = rc;
         }
         if (rc) {
             int fadviseOptions = getFAdviseOptions();
@@ -22,6 +22,7 @@ public:
 protected:
     int64_t _cachedSize;
     int64_t _filePointer;   // Only maintained/used in directio mode
+    bool    _dropWrittenPages;  // Direct IO was not supported by the file system
 
 public:
     FastOS_Linux_File (const char *filename = nullptr);
@@ -8,6 +8,7 @@
 *****************************************************************************/
 
 #include "file.h"
+#include <algorithm>
 #include <sstream>
 #include <cassert>
 #include <cstring>
@@ -248,6 +249,22 @@ void FastOS_UNIX_File::dropFromCache() const
     posix_fadvise(_filedes, 0, 0, POSIX_FADV_DONTNEED);
 }
 
+void FastOS_UNIX_File::prefetch(int64_t position, size_t length) const
+{
+    if (_mmapbase != nullptr) {
+        if (position >= int64_t(_mmaplen)) {
+            return;
+        }
+        length = std::min(length, _mmaplen - static_cast<size_t>(position));
+        // madvise requires a page aligned start address
+        size_t pageSize = getpagesize();
+        size_t pad = static_cast<size_t>(position) % pageSize;
+        posix_madvise(static_cast<char *>(_mmapbase) + (position - pad), length + pad, POSIX_MADV_WILLNEED);
+    } else {
+        posix_fadvise(_filedes, position, length, POSIX_FADV_WILLNEED);
+    }
+}
+
 
 bool
 FastOS_UNIX_File::Close(void)
@@ -86,6 +86,7 @@ public:
     bool Sync() override;
     bool SetSize(int64_t newSize) override;
     void dropFromCache() const override;
+    void prefetch(int64_t position, size_t length) const override;
 
     static bool Delete(const char *filename);
     static int GetLastOSError() { return errno; }
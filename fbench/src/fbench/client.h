@@ -97,6 +97,12 @@ struct ClientArguments
     /** Whether we should use POST in requests */
     bool        _usePostMode;
 
+    /**
+     * Max number of requests in flight on the connection of this
+     * client. Only used by the epoll driven client.
+     **/
+    int         _pipelineDepth;
+
     /**
      * Indicate whether to add benchmark data coverage headers
      **/
@@ -119,7 +125,7 @@ struct ClientArguments
                     bool keepAlive, bool headerBenchmarkdataCoverage,
                     uint64_t queryfileOffset, uint64_t queryfileEndOffset, bool singleQueryFile,
                     const std::string & queryStringToAppend, const std::string & extraHeaders,
-                    const std::string &authority, bool postMode)
+                    const std::string &authority, bool postMode, int pipelineDepth = 1)
         : _myNum(myNum),
           _totNum(totNum),
           _filenamePattern(filenamePattern),
@@ -134,6 +140,7 @@ struct ClientArguments
           _maxLineSize(maxLineSize),
           _keepAlive(keepAlive),
           _usePostMode(postMode),
+          _pipelineDepth(pipelineDepth),
           _headerBenchmarkdataCoverage(headerBenchmarkdataCoverage),
           _queryfileOffset(queryfileOffset),
           _queryfileEndOffset(queryfileEndOffset),
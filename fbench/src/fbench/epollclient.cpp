@@ -0,0 +1,602 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "epollclient.h"
+#include "urlreader.h"
+#include <util/timer.h>
+#include <util/clientstatus.h>
+#include <httpclient/httpclient.h>
+#include <util/filereader.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+
+namespace {
+
+const size_t READ_SIZE = 64 * 1024;
+
+double
+toMs(EpollClient::clock::duration d)
+{
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+}
+
+EpollClient::EpollClient(ClientArguments *args)
+    : _args(args),
+      _status(new ClientStatus()),
+      _masterTimer(new Timer()),
+      _reader(new FileReader()),
+      _urlSource(),
+      _output(),
+      _authority(_args->_authority),
+      _addr(),
+      _addrLen(0),
+      _epollFd(-1),
+      _fd(-1),
+      _connecting(false),
+      _events(0),
+      _requestsOnConnection(0),
+      _responsesOnConnection(0),
+      _inFlight(),
+      _writeBuf(),
+      _writePos(0),
+      _parser(),
+      _linebufsize(args->_maxLineSize),
+      _linebuf(new char[_linebufsize]),
+      _urlNumber(0),
+      _eof(false),
+      _nextSend(),
+      _scheduled(clock::time_point::max()),
+      _reuseCount(0),
+      _done(false)
+{
+    assert(args != NULL);
+    if (_authority.empty()) {
+        _authority = std::string(_args->_hostname) + ":" + std::to_string(_args->_port);
+    }
+}
+
+EpollClient::~EpollClient()
+{
+    if (_fd >= 0) {
+        close(_fd);
+    }
+    delete [] _linebuf;
+}
+
+bool
+EpollClient::start(int epollFd, clock::time_point now)
+{
+    char inputFilename[1024];
+    char outputFilename[1024];
+
+    _epollFd = epollFd;
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *result = nullptr;
+    std::string port = std::to_string(_args->_port);
+    if (getaddrinfo(_args->_hostname, port.c_str(), &hints, &result) != 0 || result == nullptr) {
+        printf("Client %d: ERROR: could not resolve '%s'\n", _args->_myNum, _args->_hostname);
+        _status->SetError("Could not resolve host name.");
+        _done = true;
+        return false;
+    }
+    memcpy(&_addr, result->ai_addr, result->ai_addrlen);
+    _addrLen = result->ai_addrlen;
+    freeaddrinfo(result);
+
+    // open query file
+    snprintf(inputFilename, 1024, _args->_filenamePattern, _args->_myNum);
+    if (!_reader->Open(inputFilename)) {
+        printf("Client %d: ERROR: could not open file '%s' [read mode]\n",
+               _args->_myNum, inputFilename);
+        _status->SetError("Could not open query file.");
+        _done = true;
+        return false;
+    }
+    if (_args->_outputPattern != NULL) {
+        snprintf(outputFilename, 1024, _args->_outputPattern, _args->_myNum);
+        _output = std::make_unique<std::ofstream>(outputFilename, std::ofstream::out | std::ofstream::binary);
+        if (_output->fail()) {
+            printf("Client %d: ERROR: could not open file '%s' [write mode]\n",
+                   _args->_myNum, outputFilename);
+            _status->SetError("Could not open output file.");
+            _done = true;
+            return false;
+        }
+        _output->write(FBENCH_DELIMITER + 1, strlen(FBENCH_DELIMITER) - 1);
+    }
+    if (_args->_ignoreCount == 0)
+        _masterTimer->Start();
+
+    // Start reading from offset
+    if ( _args->_singleQueryFile )
+        _reader->SetFilePos(_args->_queryfileOffset);
+
+    _urlSource = std::make_unique<UrlReader>(*_reader, *_args);
+    _nextSend = now + std::chrono::milliseconds(_args->_delay);
+    return true;
+}
+
+void
+EpollClient::queueRequests(clock::time_point now)
+{
+    while (!_eof && (int)_inFlight.size() < _args->_pipelineDepth && now >= _nextSend) {
+        int linelen = _urlSource->nextUrl(_linebuf, _linebufsize);
+        if (linelen > 0) {
+            ++_urlNumber;
+        } else {
+            if (_urlNumber == 0) {
+                fprintf(stderr, "Client %d: ERROR: could not read any lines from query file\n",
+                        _args->_myNum);
+                _status->SetError("Could not read any lines from query file.");
+            }
+            _eof = true;
+            break;
+        }
+        if (linelen >= _linebufsize) {
+            if (_args->_ignoreCount == 0)
+                _status->SkippedRequest();
+            continue;
+        }
+        if (linelen + (int)_args->_queryStringToAppend.length() < _linebufsize) {
+            strcat(_linebuf, _args->_queryStringToAppend.c_str());
+        }
+        int cLen = _args->_usePostMode ? _urlSource->nextContent() : 0;
+        Request request;
+        request.url = _linebuf;
+        request.data = HTTPClient::BuildRequest(_authority, _args->_extraHeaders, _args->_keepAlive,
+                                                _args->_headerBenchmarkdataCoverage,
+                                                _linebuf, _args->_usePostMode, cLen);
+        if (cLen > 0) {
+            request.data.append(_urlSource->content(), cLen);
+        }
+        request.start = now;
+        if (_fd >= 0 && _requestsOnConnection++ > 0) {
+            _reuseCount++;
+        }
+        _writeBuf += request.data;
+        _inFlight.push_back(std::move(request));
+
+        if (_args->_cycle > 0) {
+            _nextSend += std::chrono::milliseconds(_args->_cycle);
+            if (_nextSend < now) {
+                // could not keep up with the cycle time
+                if (_args->_ignoreCount == 0)
+                    _status->OverTime();
+                _nextSend = now;
+            }
+        } else if (_args->_cycle < 0) {
+            // wait for the response, see completed()
+            _nextSend = clock::time_point::max();
+        }
+    }
+}
+
+void
+EpollClient::connect()
+{
+    _fd = socket(_addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (_fd < 0) {
+        closeConnection(false);
+        return;
+    }
+    int one = 1;
+    setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (::connect(_fd, reinterpret_cast<const sockaddr *>(&_addr), _addrLen) != 0 && errno != EINPROGRESS) {
+        closeConnection(false);
+        return;
+    }
+    _connecting = true;
+    _events = EPOLLIN | EPOLLOUT;
+    epoll_event ev;
+    ev.events = _events;
+    ev.data.ptr = this;
+    if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, _fd, &ev) != 0) {
+        closeConnection(false);
+        return;
+    }
+    _requestsOnConnection = _inFlight.size();
+    _responsesOnConnection = 0;
+    _parser.Reset(_output.get() != nullptr);
+}
+
+void
+EpollClient::closeConnection(bool resend)
+{
+    if (_fd >= 0) {
+        close(_fd);
+        _fd = -1;
+    }
+    _connecting = false;
+    _events = 0;
+    _writeBuf.clear();
+    _writePos = 0;
+    if (resend) {
+        // requests without a response are sent again on a new connection
+        for (const Request &request : _inFlight) {
+            _writeBuf += request.data;
+        }
+    } else {
+        for (const Request &request : _inFlight) {
+            failed(request);
+        }
+        _inFlight.clear();
+    }
+}
+
+void
+EpollClient::failed(const Request &request)
+{
+    if (_output) {
+        _output->write("URL: ", strlen("URL: "));
+        _output->write(request.url.c_str(), request.url.size());
+        _output->write("\n\n", 2);
+        _output->write("\nFBENCH: URL FETCH FAILED!\n",
+                       strlen("\nFBENCH: URL FETCH FAILED!\n"));
+        _output->write(FBENCH_DELIMITER + 1, strlen(FBENCH_DELIMITER) - 1);
+    }
+    if (_args->_ignoreCount == 0) {
+        _status->RequestFailed();
+    } else {
+        _args->_ignoreCount--;
+        if (_args->_ignoreCount == 0)
+            _masterTimer->Start();
+    }
+}
+
+void
+EpollClient::completed(bool ok, clock::time_point now)
+{
+    const Request &request = _inFlight.front();
+    double ms = toMs(now - request.start);
+    int hits = _parser.GetTotalHitCount();
+    _status->AddRequestStatus(_parser.GetRequestStatus());
+    ok = ok && _parser.GetRequestStatus() == 200 && hits >= 0;
+    if (ok && hits == 0)
+        ++_status->_zeroHitQueries;
+    if (_output) {
+        char timestr[64];
+        _output->write("URL: ", strlen("URL: "));
+        _output->write(request.url.c_str(), request.url.size());
+        _output->write("\n\n", 2);
+        _output->write(_parser.GetHeaderInfo().c_str(), _parser.GetHeaderInfo().size());
+        _output->write("\r\n", 2);
+        _output->write(_parser.GetBody().c_str(), _parser.GetBody().size());
+        if (!ok) {
+            _output->write("\nFBENCH: URL FETCH FAILED!\n",
+                           strlen("\nFBENCH: URL FETCH FAILED!\n"));
+        } else {
+            sprintf(timestr, "\nTIME USED: %0.4f s\n", ms / 1000.0);
+            _output->write(timestr, strlen(timestr));
+        }
+        _output->write(FBENCH_DELIMITER + 1, strlen(FBENCH_DELIMITER) - 1);
+    }
+    if (_args->_ignoreCount == 0) {
+        if (ok && _parser.GetContentSize() >= (uint64_t)std::max(_args->_byteLimit, 0)) {
+            _status->ResponseTime(ms);
+        } else {
+            _status->RequestFailed();
+        }
+    } else {
+        _args->_ignoreCount--;
+        if (_args->_ignoreCount == 0)
+            _masterTimer->Start();
+    }
+    if (_args->_cycle < 0) {
+        _nextSend = now + (now - request.start);
+    }
+    _inFlight.pop_front();
+    _responsesOnConnection++;
+    // Update current time span to calculate Q/s
+    _status->SetRealTime(_masterTimer->GetCurrent());
+}
+
+void
+EpollClient::readResponses(clock::time_point now)
+{
+    char buf[READ_SIZE];
+    while (_fd >= 0) {
+        ssize_t res = read(_fd, buf, sizeof(buf));
+        if (res < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+        }
+        if (res <= 0) {
+            // connection closed by server or failed
+            _parser.ConnectionClosed();
+            if (_inFlight.empty()) {
+                closeConnection(false);
+            } else if (_parser.Done()) {
+                completed(true, now);
+                closeConnection(true);
+            } else if (_responsesOnConnection > 0 && !_parser.HeaderParsed()) {
+                // the server closed an idle keep-alive connection
+                closeConnection(true);
+            } else {
+                failed(_inFlight.front());
+                _inFlight.pop_front();
+                closeConnection(true);
+            }
+            return;
+        }
+        size_t pos = 0;
+        while (pos < (size_t)res) {
+            if (_inFlight.empty()) {
+                // unexpected data from server
+                closeConnection(false);
+                return;
+            }
+            ssize_t used = _parser.Feed(buf + pos, res - pos);
+            if (used < 0) {
+                completed(false, now);
+                closeConnection(true);
+                return;
+            }
+            pos += used;
+            if (_parser.Done()) {
+                bool keepAlive = _args->_keepAlive && _parser.KeepAlive();
+                completed(true, now);
+                _parser.Reset(_output.get() != nullptr);
+                if (!keepAlive) {
+                    closeConnection(true);
+                    return;
+                }
+            }
+        }
+    }
+}
+
+void
+EpollClient::writeRequests()
+{
+    while (_fd >= 0 && !_connecting && _writePos < _writeBuf.size()) {
+        ssize_t res = send(_fd, _writeBuf.data() + _writePos, _writeBuf.size() - _writePos, MSG_NOSIGNAL);
+        if (res < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            closeConnection(false);
+            return;
+        }
+        _writePos += res;
+    }
+    if (_writePos == _writeBuf.size()) {
+        _writeBuf.clear();
+        _writePos = 0;
+    }
+}
+
+void
+EpollClient::updateEvents()
+{
+    if (_fd < 0) {
+        return;
+    }
+    uint32_t events = EPOLLIN;
+    if (_connecting || _writePos < _writeBuf.size()) {
+        events |= EPOLLOUT;
+    }
+    if (events != _events) {
+        epoll_event ev;
+        ev.events = events;
+        ev.data.ptr = this;
+        epoll_ctl(_epollFd, EPOLL_CTL_MOD, _fd, &ev);
+        _events = events;
+    }
+}
+
+void
+EpollClient::handleEvents(uint32_t events, clock::time_point now)
+{
+    if (_done || _fd < 0) {
+        return;
+    }
+    if (_connecting) {
+        int error = 0;
+        socklen_t len = sizeof(error);
+        if (getsockopt(_fd, SOL_SOCKET, SO_ERROR, &error, &len) != 0) {
+            error = errno;
+        }
+        if (error != 0) {
+            closeConnection(false);
+            return;
+        }
+        if ((events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) == 0) {
+            return;
+        }
+        _connecting = false;
+    }
+    if ((events & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0) {
+        readResponses(now);
+    }
+    if ((events & EPOLLOUT) != 0) {
+        writeRequests();
+    }
+}
+
+void
+EpollClient::poll(clock::time_point now)
+{
+    if (_done) {
+        return;
+    }
+    queueRequests(now);
+    if (_fd < 0 && !_inFlight.empty()) {
+        connect();
+    }
+    writeRequests();
+    updateEvents();
+    if (_eof && _inFlight.empty()) {
+        finish();
+    }
+}
+
+EpollClient::clock::time_point
+EpollClient::nextWakeup() const
+{
+    if (_done || _eof || (int)_inFlight.size() >= _args->_pipelineDepth) {
+        return clock::time_point::max();
+    }
+    return _nextSend;
+}
+
+void
+EpollClient::finish()
+{
+    if (_done) {
+        return;
+    }
+    if (_fd >= 0) {
+        close(_fd);
+        _fd = -1;
+    }
+    _masterTimer->Stop();
+    _status->SetRealTime(_masterTimer->GetTimespan());
+    _status->SetReuseCount(_reuseCount);
+    printf(".");
+    fflush(stdout);
+    _done = true;
+}
+
+void
+EpollClient::stop()
+{
+    finish();
+}
+
+EpollLoop::EpollLoop()
+    : _clients(),
+      _epollFd(epoll_create1(EPOLL_CLOEXEC)),
+      _timeouts(),
+      _stop(false),
+      _done(false),
+      _thread()
+{
+}
+
+EpollLoop::~EpollLoop()
+{
+    if (_epollFd >= 0) {
+        close(_epollFd);
+    }
+}
+
+void
+EpollLoop::runMe(EpollLoop *me)
+{
+    me->run();
+}
+
+void
+EpollLoop::schedule(EpollClient &client)
+{
+    clock::time_point wakeup = client.nextWakeup();
+    if (wakeup != clock::time_point::max() && wakeup != client._scheduled) {
+        client._scheduled = wakeup;
+        _timeouts.push(std::make_pair(wakeup, &client));
+    }
+}
+
+void
+EpollLoop::run()
+{
+    std::vector<epoll_event> events(256);
+    clock::time_point now = clock::now();
+    size_t active = 0;
+    for (EpollClient *client : _clients) {
+        if (client->start(_epollFd, now)) {
+            ++active;
+            client->poll(now);
+            schedule(*client);
+        }
+    }
+    while (!_stop && active > 0) {
+        now = clock::now();
+        // wake up at least every 100 ms to notice stop
+        int timeout = 100;
+        while (!_timeouts.empty()) {
+            Timeout next = _timeouts.top();
+            if (next.first != next.second->_scheduled) {
+                _timeouts.pop(); // stale
+                continue;
+            }
+            if (next.first <= now) {
+                _timeouts.pop();
+                next.second->_scheduled = clock::time_point::max();
+                next.second->poll(now);
+                if (next.second->done()) {
+                    --active;
+                } else {
+                    schedule(*next.second);
+                }
+                continue;
+            }
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(next.first - now).count() + 1;
+            timeout = std::min(timeout, (int)ms);
+            break;
+        }
+        if (active == 0) {
+            break;
+        }
+        int n = epoll_wait(_epollFd, &events[0], events.size(), timeout);
+        now = clock::now();
+        for (int i = 0; i < n; ++i) {
+            EpollClient &client = *static_cast<EpollClient *>(events[i].data.ptr);
+            if (client.done()) {
+                continue;
+            }
+            client.handleEvents(events[i].events, now);
+            client.poll(now);
+            if (client.done()) {
+                --active;
+            } else {
+                schedule(client);
+            }
+        }
+    }
+    for (EpollClient *client : _clients) {
+        client->stop();
+    }
+    _done = true;
+}
+
+void
+EpollLoop::start()
+{
+    _thread = std::thread(EpollLoop::runMe, this);
+}
+
+void
+EpollLoop::stop()
+{
+    _stop = true;
+}
+
+bool
+EpollLoop::done()
+{
+    return _done;
+}
+
+void
+EpollLoop::join()
+{
+    _thread.join();
+}
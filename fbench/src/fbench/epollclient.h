@@ -0,0 +1,164 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "client.h"
+#include <httpclient/httpresponseparser.h>
+#include <sys/socket.h>
+#include <chrono>
+#include <deque>
+#include <queue>
+#include <vector>
+
+class Timer;
+class FileReader;
+class UrlReader;
+struct ClientStatus;
+
+/**
+ * A test client that does not have a thread of its own. It uses a
+ * non-blocking connection driven by an @ref EpollLoop shared with
+ * many other clients, so that a high query rate does not need
+ * thousands of threads. Requests may be pipelined on the HTTP/1.1
+ * connection, with up to _pipelineDepth requests in flight. Apart
+ * from that it behaves like @ref Client and is controlled by the
+ * same @ref ClientArguments.
+ **/
+class EpollClient
+{
+public:
+    typedef std::chrono::steady_clock clock;
+    typedef std::unique_ptr<EpollClient> UP;
+
+private:
+    struct Request {
+        std::string        url;
+        std::string        data;
+        clock::time_point  start;
+    };
+
+    std::unique_ptr<ClientArguments> _args;
+    std::unique_ptr<ClientStatus>    _status;
+    std::unique_ptr<Timer>           _masterTimer;
+    std::unique_ptr<FileReader>      _reader;
+    std::unique_ptr<UrlReader>       _urlSource;
+    std::unique_ptr<std::ofstream>   _output;
+    std::string                      _authority;
+    sockaddr_storage                 _addr;
+    socklen_t                        _addrLen;
+    int                              _epollFd;
+    int                              _fd;
+    bool                             _connecting;
+    uint32_t                         _events;
+    uint32_t                         _requestsOnConnection;
+    uint32_t                         _responsesOnConnection;
+    std::deque<Request>              _inFlight;
+    std::string                      _writeBuf;
+    size_t                           _writePos;
+    HTTPResponseParser               _parser;
+    int                              _linebufsize;
+    char                            *_linebuf;
+    size_t                           _urlNumber;
+    bool                             _eof;
+    clock::time_point                _nextSend;
+    clock::time_point                _scheduled;
+    uint64_t                         _reuseCount;
+    std::atomic<bool>                _done;
+
+    EpollClient(const EpollClient &);
+    EpollClient &operator=(const EpollClient &);
+
+    void queueRequests(clock::time_point now);
+    void connect();
+    void closeConnection(bool resend);
+    void readResponses(clock::time_point now);
+    void writeRequests();
+    void updateEvents();
+    void completed(bool ok, clock::time_point now);
+    void failed(const Request &request);
+    void finish();
+
+    friend class EpollLoop;
+
+public:
+    /**
+     * The client arguments given to this method becomes the
+     * responsibility of the client.
+     **/
+    EpollClient(ClientArguments *args);
+    ~EpollClient();
+
+    /**
+     * Open the query and output files and prepare for requests. Called
+     * by the loop thread.
+     *
+     * @return false if the client failed and is done.
+     * @param epollFd the epoll instance to register connections with.
+     * @param now the current time.
+     **/
+    bool start(int epollFd, clock::time_point now);
+
+    /**
+     * Handle readiness of the connection reported by epoll.
+     **/
+    void handleEvents(uint32_t events, clock::time_point now);
+
+    /**
+     * Send the requests that are due and keep the connection and its
+     * epoll registration up to date.
+     **/
+    void poll(clock::time_point now);
+
+    /**
+     * @return when this client next wants to send a request without
+     *         waiting for a response, or clock::time_point::max().
+     **/
+    clock::time_point nextWakeup() const;
+
+    /**
+     * Stop making requests and record the final statistics.
+     **/
+    void stop();
+
+    const ClientStatus & GetStatus() { return *_status; }
+    bool done() { return _done; }
+};
+
+/**
+ * A thread multiplexing the connections of a set of @ref EpollClient
+ * objects with epoll.
+ **/
+class EpollLoop
+{
+private:
+    typedef EpollClient::clock clock;
+    typedef std::pair<clock::time_point, EpollClient *> Timeout;
+
+    std::vector<EpollClient *>   _clients;
+    int                          _epollFd;
+    std::priority_queue<Timeout, std::vector<Timeout>, std::greater<Timeout>> _timeouts;
+    std::atomic<bool>            _stop;
+    std::atomic<bool>            _done;
+    std::thread                  _thread;
+
+    EpollLoop(const EpollLoop &);
+    EpollLoop &operator=(const EpollLoop &);
+
+    static void runMe(EpollLoop *loop);
+    void run();
+    void schedule(EpollClient &client);
+
+public:
+    typedef std::unique_ptr<EpollLoop> UP;
+    EpollLoop();
+    ~EpollLoop();
+
+    /**
+     * Add a client to be driven by this loop. Must be called before
+     * the loop is started.
+     **/
+    void add(EpollClient &client) { _clients.push_back(&client); }
+    void start();
+    void stop();
+    bool done();
+    void join();
+};
@@ -4,6 +4,7 @@
 #include <util/filereader.h>
 #include <util/clientstatus.h>
 #include "client.h"
+#include "epollclient.h"
 #include "fbench.h"
 #include <cstring>
 #include <cmath>
@@ -13,6 +14,9 @@ sig_atomic_t exitSignal = 0;
 
 FBench::FBench()
     : _clients(),
+      _epollClients(),
+      _epollLoops(),
+      _numClients(0),
       _ignoreCount(0),
       _cycle(0),
       _filenamePattern(NULL),
@@ -24,13 +28,17 @@ FBench::FBench()
       _usePostMode(false),
       _headerBenchmarkdataCoverage(false),
       _seconds(60),
-      _singleQueryFile(false)
+      _singleQueryFile(false),
+      _epollThreads(0),
+      _pipelineDepth(1)
 {
 }
 
 FBench::~FBench()
 {
     _clients.clear();
+    _epollLoops.clear();
+    _epollClients.clear();
     free(_filenamePattern);
     free(_outputPattern);
 }
@@ -41,9 +49,10 @@ FBench::InitBenchmark(int numClients, int ignoreCount, int cycle,
                       int byteLimit, int restartLimit, int maxLineSize,
                       bool keepAlive, bool headerBenchmarkdataCoverage, int seconds,
                       bool singleQueryFile, const std::string & queryStringToAppend, const std::string & extraHeaders,
-                      const std::string &authority, bool postMode)
+                      const std::string &authority, bool postMode,
+                      int epollThreads, int pipelineDepth)
 {
-    _clients.resize(numClients);
+    _numClients      = numClients;
     _ignoreCount     = ignoreCount;
     _cycle           = cycle;
 
@@ -63,6 +72,8 @@ FBench::InitBenchmark(int numClients, int ignoreCount, int cycle,
     _headerBenchmarkdataCoverage = headerBenchmarkdataCoverage;
     _seconds = seconds;
     _singleQueryFile = singleQueryFile;
+    _epollThreads    = epollThreads;
+    _pipelineDepth   = pipelineDepth;
 }
 
 void
@@ -70,24 +81,31 @@ FBench::CreateClients()
 {
     int spread = (_cycle > 1) ? _cycle : 1;
 
-    int i(0);
-    for(auto & client : _clients) {
+    for (int i = 0; i < _epollThreads; ++i) {
+        _epollLoops.push_back(std::make_unique<EpollLoop>());
+    }
+    for (int i = 0; i < _numClients; ++i) {
         uint64_t off_beg = 0;
         uint64_t off_end = 0;
         if (_singleQueryFile) {
             off_beg = _queryfileOffset[i];
             off_end = _queryfileOffset[i+1];
         }
-        client = std::make_unique<Client>(
-            new ClientArguments(i, _clients.size(), _filenamePattern,
-                                _outputPattern, _hostnames[i % _hostnames.size()].c_str(),
-                                _ports[i % _ports.size()], _cycle,
-                                random() % spread, _ignoreCount,
-                                _byteLimit, _restartLimit, _maxLineSize,
-                                _keepAlive, _headerBenchmarkdataCoverage,
-                                off_beg, off_end,
-                                _singleQueryFile, _queryStringToAppend, _extraHeaders, _authority, _usePostMode));
-        ++i;
+        auto args = new ClientArguments(i, _numClients, _filenamePattern,
+                                        _outputPattern, _hostnames[i % _hostnames.size()].c_str(),
+                                        _ports[i % _ports.size()], _cycle,
+                                        random() % spread, _ignoreCount,
+                                        _byteLimit, _restartLimit, _maxLineSize,
+                                        _keepAlive, _headerBenchmarkdataCoverage,
+                                        off_beg, off_end,
+                                        _singleQueryFile, _queryStringToAppend, _extraHeaders, _authority, _usePostMode,
+                                        _pipelineDepth);
+        if (_epollLoops.empty()) {
+            _clients.push_back(std::make_unique<Client>(args));
+        } else {
+            _epollClients.push_back(std::make_unique<EpollClient>(args));
+            _epollLoops[i % _epollLoops.size()]->add(*_epollClients.back());
+        }
     }
 }
 
@@ -100,9 +118,27 @@ FBench::ClientsDone()
             return false;
         }
     }
+    for (auto & loop : _epollLoops) {
+        if ( ! loop->done() ) {
+            return false;
+        }
+    }
     return done;
 }
 
+std::vector<const ClientStatus *>
+FBench::GetStatus()
+{
+    std::vector<const ClientStatus *> status;
+    for (auto & client : _clients) {
+        status.push_back(&client->GetStatus());
+    }
+    for (auto & client : _epollClients) {
+        status.push_back(&client->GetStatus());
+    }
+    return status;
+}
+
 void
 FBench::StartClients()
 {
@@ -110,6 +146,9 @@ FBench::StartClients()
     for (auto & client : _clients) {
         client->start();
     }
+    for (auto & loop : _epollLoops) {
+        loop->start();
+    }
 }
 
 void
@@ -119,10 +158,16 @@ FBench::StopClients()
     for (auto & client : _clients) {
         client->stop();
     }
+    for (auto & loop : _epollLoops) {
+        loop->stop();
+    }
     printf("\nClients stopped.\n");
     for (auto & client : _clients) {
         client->join();
     }
+    for (auto & loop : _epollLoops) {
+        loop->join();
+    }
     printf("\nClients Joined.\n");
 }
 
@@ -137,12 +182,12 @@ FBench::PrintSummary()
     int realNumClients = 0;
     
     int i = 0;
-    for (auto & client : _clients) {
-        if (client->GetStatus()._error) {
+    for (const ClientStatus *clientStatus : GetStatus()) {
+        if (clientStatus->_error) {
             printf("Client %d: %s => discarding client results.\n",
-                   i, client->GetStatus()._errorMsg.c_str());
+                   i, clientStatus->_errorMsg.c_str());
         } else {
-            status.Merge(client->GetStatus());
+            status.Merge(*clientStatus);
             ++realNumClients;
         }
         ++i;
@@ -165,7 +210,11 @@ FBench::PrintSummary()
         printf("connection reuse count -- %zu\n", status._reuseCnt);
     }
     printf("***************** Benchmark Summary *****************\n");
-    printf("clients:                %8ld\n", _clients.size());
+    printf("clients:                %8d\n", _numClients);
+    if (_epollThreads > 0) {
+        printf("epoll threads:          %8d\n", _epollThreads);
+        printf("pipeline depth:         %8d\n", _pipelineDepth);
+    }
     printf("ran for:                %8d seconds\n", _seconds);
     printf("cycle time:             %8d ms\n", _cycle);
     printf("lower response limit:   %8d bytes\n", _byteLimit);
@@ -194,6 +243,8 @@ FBench::PrintSummary()
     if (p99 > status._timetable.size() / status._timetableResolution - 1)
         printf("99 percentile:          %8.2f ms (approx)\n", p99);
     else         printf("99 percentile:          %8.2f ms\n", p99);
+    printf("99.9 percentile:        %8.2f ms (hdr)\n", status.GetHdrPercentile(99.9));
+    printf("99.99 percentile:       %8.2f ms (hdr)\n", status.GetHdrPercentile(99.99));
     printf("actual query rate:      %8.2f Q/s\n", actualRate);
     printf("utilization:            %8.2f %%\n",
            (maxRate > 0) ? 100 * (actualRate / maxRate) : 0);
@@ -210,7 +261,8 @@ FBench::Usage()
 {
     printf("usage: vespa-fbench [-H extraHeader] [-a queryStringToAppend ] [-n numClients] [-c cycleTime] [-l limit] [-i ignoreCount]\n");
     printf("              [-s seconds] [-q queryFilePattern] [-o outputFilePattern]\n");
-    printf("              [-r restartLimit] [-m maxLineSize] [-k] <hostname> <port>\n\n");
+    printf("              [-r restartLimit] [-m maxLineSize] [-k] [-e epollThreads] [-d pipelineDepth]\n");
+    printf("              <hostname> <port>\n\n");
     printf(" -H <str> : append extra header to each get request.\n");
     printf(" -A <str> : assign autority.  <str> should be hostname:port format. Overrides Host: header sent.\n");
     printf(" -P       : use POST for requests instead of GET.\n");
@@ -230,6 +282,8 @@ FBench::Usage()
     printf("            Can not be less than the minimum [1024].\n");
     printf(" -p <num> : print summary every <num> seconds.\n");
     printf(" -k       : disable HTTP keep-alive.\n");
+    printf(" -e <num> : run the clients on <num> epoll threads instead of one thread per client [0].\n");
+    printf(" -d <num> : with -e, pipeline up to <num> requests on each client connection [1].\n");
     printf(" -y       : write data on coverage to output file (must used with -x).\n");
     printf(" -z       : use single query file to be distributed between clients.\n\n");
     printf(" <hostname> : the host you want to benchmark.\n");
@@ -273,6 +327,8 @@ FBench::Main(int argc, char *argv[])
     std::string authority;
 
     int  printInterval = 0;
+    int  epollThreads = 0;
+    int  pipelineDepth = 1;
 
     // parse options and override defaults.
     int         idx;
@@ -282,7 +338,7 @@ FBench::Main(int argc, char *argv[])
 
     idx = 1;
     optError = false;
-    while((opt = GetOpt(argc, argv, "H:A:a:n:c:l:i:s:q:o:r:m:p:kxyzP", arg, idx)) != -1) {
+    while((opt = GetOpt(argc, argv, "H:A:a:n:c:l:i:s:q:o:r:m:p:kxyzPe:d:", arg, idx)) != -1) {
         switch(opt) {
         case 'A':
             authority = arg;
@@ -338,6 +394,16 @@ FBench::Main(int argc, char *argv[])
         case 'k':
             keepAlive = false;
             break;
+        case 'e':
+            epollThreads = atoi(arg);
+            if (epollThreads < 0)
+                optError = true;
+            break;
+        case 'd':
+            pipelineDepth = atoi(arg);
+            if (pipelineDepth < 1)
+                optError = true;
+            break;
         case 'x': 
             // consuming x for backwards compability. This turned on header benchmark data
             // but this is now always on. 
@@ -354,6 +420,11 @@ FBench::Main(int argc, char *argv[])
         }
     }
 
+    if (!keepAlive || epollThreads == 0) {
+        // pipelining needs persistent connections
+        pipelineDepth = 1;
+    }
+
     if ( argc < (idx + 2) || optError) {
         Usage();
         return -1;
@@ -423,7 +494,8 @@ FBench::Main(int argc, char *argv[])
                   keepAlive,
                   headerBenchmarkdataCoverage, seconds,
                   singleQueryFile, queryStringToAppend, extraHeaders,
-                  authority, usePostMode);
+                  authority, usePostMode,
+                  epollThreads, pipelineDepth);
 
     CreateClients();
     StartClients();
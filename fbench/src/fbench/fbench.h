@@ -11,6 +11,8 @@ class FBench
 {
 private:
     std::vector<Client::UP> _clients;
+    std::vector<EpollClient::UP> _epollClients;
+    std::vector<EpollLoop::UP> _epollLoops;
     int                 _numClients;
     int                 _ignoreCount;
     int                 _cycle;
@@ -31,18 +33,22 @@ private:
     std::string         _queryStringToAppend;
     std::string         _extraHeaders;
     std::string         _authority;
+    int                 _epollThreads;
+    int                 _pipelineDepth;
 
     void InitBenchmark(int numClients, int ignoreCount, int cycle,
                        const char *filenamePattern, const char *outputPattern,
                        int byteLimit, int restartLimit, int maxLineSize,
                        bool keepAlive, bool headerBenchmarkdataCoverage, int seconds,
                        bool singleQueryFile, const std::string & queryStringToAppend, const std::string & extraHeaders,
-                       const std::string &authority, bool postMode);
+                       const std::string &authority, bool postMode,
+                       int epollThreads, int pipelineDepth);
 
     void CreateClients();
     void StartClients();
     void StopClients();
     bool ClientsDone();
+    std::vector<const ClientStatus *> GetStatus();
     void PrintSummary();
 
     FBench(const FBench &);
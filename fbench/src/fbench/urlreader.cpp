@@ -0,0 +1,103 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "urlreader.h"
+#include "client.h"
+#include <util/filereader.h>
+#include <algorithm>
+#include <cstring>
+
+UrlReader::UrlReader(FileReader& reader, const ClientArguments &args)
+    : _reader(reader), _args(args), _restarts(0),
+      _contentbufsize(0), _leftOversLen(0),
+      _contentbuf(0), _leftOvers(0)
+{
+    if (_args._usePostMode) {
+        _contentbufsize = 16 * _args._maxLineSize;
+        _contentbuf = new char[_contentbufsize];
+    }
+}
+
+bool UrlReader::reset()
+{
+    if (_restarts == _args._restartLimit) {
+        return false;
+    } else if (_args._restartLimit > 0) {
+        _restarts++;
+    }
+    _reader.Reset();
+    // Start reading from offset
+    if (_args._singleQueryFile) {
+        _reader.SetFilePos(_args._queryfileOffset);
+    }
+    return true;
+}
+
+int UrlReader::findUrl(char *buf, int buflen)
+{
+    while (true) {
+        if ( _args._singleQueryFile && _reader.GetFilePos() >= _args._queryfileEndOffset ) {
+            // reached logical EOF
+            return -1;
+        }
+        int ll = _reader.ReadLine(buf, buflen);
+        if (ll < 0) {
+            // reached physical EOF
+            return ll;
+        }
+        if (ll > 0) {
+            if (buf[0] == '/' || !_args._usePostMode) {
+                // found URL
+                return ll;
+            }
+        }
+    }
+}
+
+int UrlReader::nextUrl(char *buf, int buflen)
+{
+    if (_leftOvers) {
+        int sz = std::min(_leftOversLen, buflen-1);
+        strncpy(buf, _leftOvers, sz);
+        buf[sz] = '\0';
+        _leftOvers = NULL;
+        return _leftOversLen;
+    }
+    int ll = findUrl(buf, buflen);
+    if (ll > 0) {
+        return ll;
+    }
+    if (reset()) {
+        // try again
+        ll = findUrl(buf, buflen);
+    }
+    return ll;
+}
+
+int UrlReader::nextContent()
+{
+    char *buf = _contentbuf;
+    int totLen = 0;
+    // make sure we don't chop leftover URL
+    while (totLen + _args._maxLineSize < _contentbufsize) {
+       // allow space for newline:
+       int room = _contentbufsize - totLen - 1;
+       int len = _reader.ReadLine(buf, room);
+       if (len < 0) {
+           // reached EOF
+           break;
+       }
+       len = std::min(len, room);
+       if (len > 0 && buf[0] == '/') {
+           // reached next URL
+           _leftOvers = buf;
+           _leftOversLen = len;
+           break;
+       }
+       buf += len;
+       totLen += len;
+       *buf++ = '\n';
+       totLen++;
+    }
+    // ignore last newline
+    return (totLen > 0) ? totLen-1 : 0;
+}
@@ -0,0 +1,28 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+class FileReader;
+struct ClientArguments;
+
+/**
+ * Reads the urls (and post content) a client should request from its
+ * query file, restarting from the beginning as allowed by the client
+ * arguments.
+ **/
+class UrlReader {
+    FileReader &_reader;
+    const ClientArguments &_args;
+    int _restarts;
+    int _contentbufsize;
+    int _leftOversLen;
+    char *_contentbuf;
+    const char *_leftOvers;
+public:
+    UrlReader(FileReader& reader, const ClientArguments &args);
+    bool reset();
+    int findUrl(char *buf, int buflen);
+    int nextUrl(char *buf, int buflen);
+    int nextContent();
+    const char *content() const { return _contentbuf; }
+    ~UrlReader() { delete [] _contentbuf; }
+};
@@ -95,70 +95,57 @@ HTTPClient::ReadLine(char *buf, size_t bufsize)
     return len;
 }
 
-bool
-HTTPClient::Connect(const char *url, bool usePost, const char *content, int cLen)
+std::string
+HTTPClient::BuildRequest(const std::string &authority, const std::string &extraHeaders,
+                         bool keepAlive, bool headerBenchmarkdataCoverage,
+                         const char *url, bool usePost, int contentLen)
 {
-    char tmp[4096];
-    char *req = NULL;
-    uint32_t req_max = 0;
-    uint32_t url_len = strlen(url);
-    uint32_t host_len = _hostname.size();
-
     // Add additional headers
-    std::string headers = _extraHeaders;
+    std::string headers = extraHeaders;
 
     // this is always requested to get robust info on total hit count.
     headers += "X-Yahoo-Vespa-Benchmarkdata: true\r\n";
 
-    if ( _headerBenchmarkdataCoverage ) {
+    if ( headerBenchmarkdataCoverage ) {
         headers += "X-Yahoo-Vespa-Benchmarkdata-Coverage: true\r\n";
     }
-
-    if (url_len + host_len + headers.length() + FIXED_REQ_MAX < sizeof(tmp)) {
-        req = tmp;
-        req_max = sizeof(tmp);
-    } else {
-        req_max = url_len + host_len + headers.length() + FIXED_REQ_MAX;
-        req = new char[req_max];
-        assert(req != NULL);
-    }
-
-    if (!_keepAlive) {
+    if (!keepAlive) {
         headers += "Connection: close\r\n";
     }
     headers += "User-Agent: fbench/4.2.10\r\n";
 
-    // create request
+    std::string req;
+    req.reserve(strlen(url) + authority.size() + headers.size() + FIXED_REQ_MAX);
+    req += usePost ? "POST " : "GET ";
+    req += url;
+    req += " HTTP/1.1\r\n"
+           "Host: ";
+    req += authority;
+    req += "\r\n";
     if (usePost) {
-        snprintf(req, req_max,
-                 "POST %s HTTP/1.1\r\n"
-                 "Host: %s\r\n"
-                 "Content-Length: %d\r\n"
-                 "%s"
-                 "\r\n",
-                 url, _authority.c_str(), cLen, headers.c_str());
-    } else {
-        snprintf(req, req_max,
-                 "GET %s HTTP/1.1\r\n"
-                 "Host: %s\r\n"
-                 "%s"
-                 "\r\n",
-                 url, _authority.c_str(), headers.c_str());
+        req += "Content-Length: " + std::to_string(contentLen) + "\r\n";
     }
+    req += headers;
+    req += "\r\n";
+    return req;
+}
+
+bool
+HTTPClient::Connect(const char *url, bool usePost, const char *content, int cLen)
+{
+    std::string req = BuildRequest(_authority, _extraHeaders, _keepAlive, _headerBenchmarkdataCoverage,
+                                   url, usePost, cLen);
 
     // try to reuse connection if keep-alive is enabled
     if (_keepAlive
         && _socket->IsOpened()
-        && _socket->Write(req, strlen(req)) == (ssize_t)strlen(req)
+        && _socket->Write(req.data(), req.size()) == (ssize_t)req.size()
         && (!usePost || _socket->Write(content, cLen) == (ssize_t)cLen)
         && FillBuffer() > 0) {
 
         // DEBUG
         // printf("Socket Connection reused!\n");
         _reuseCount++;
-        if (req != tmp) {
-            delete [] req;
-        }
         return true;
     } else {
         _socket->Close();
@@ -170,15 +157,12 @@ HTTPClient::Connect(const char *url, bool usePost, const char *content, int cLen
         && _socket->Connect()
         && _socket->SetNoDelay(true)
         && _socket->SetSoLinger(false, 0)
-        && _socket->Write(req, strlen(req)) == (ssize_t)strlen(req)
+        && _socket->Write(req.data(), req.size()) == (ssize_t)req.size()
         && (!usePost || _socket->Write(content, cLen) == (ssize_t)cLen))
     {
 
         // DEBUG
         // printf("New Socket connection!\n");
-        if (req != tmp) {
-            delete [] req;
-        }
         return true;
     } else {
         _socket->Close();
@@ -186,9 +170,6 @@ HTTPClient::Connect(const char *url, bool usePost, const char *content, int cLen
 
     // DEBUG
     // printf("Connect FAILED!\n");
-    if (req != tmp) {
-        delete [] req;
-    }
     return false;
 }
 
@@ -88,6 +88,9 @@ protected:
   };
   friend class HTTPClient::ChunkedReader;
 
+  // shares the header line splitting
+  friend class HTTPResponseParser;
+
   std::unique_ptr<FastOS_Socket>   _socket;
   std::string      _hostname;
   int              _port;
@@ -207,6 +210,23 @@ protected:
 
 public:
 
+  /**
+   * Create the HTTP request header for fetching the given url. This
+   * is shared with clients doing their own socket handling.
+   *
+   * @return the request header, including the terminating empty line.
+   * @param authority value of the Host header.
+   * @param extraHeaders additional header lines, each terminated by CRLF.
+   * @param keepAlive flag indicating if keep-alive should be enabled.
+   * @param headerBenchmarkdataCoverage whether to request coverage data.
+   * @param url the url to fetch.
+   * @param usePost whether to use POST in the request
+   * @param contentLen if usePost is true, length of content in bytes
+   **/
+  static std::string BuildRequest(const std::string &authority, const std::string &extraHeaders,
+                                  bool keepAlive, bool headerBenchmarkdataCoverage,
+                                  const char *url, bool usePost, int contentLen);
+
   /**
    * Create a HTTP client that may be used to fetch documents from the
    * given host.
@@ -0,0 +1,252 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "httpresponseparser.h"
+#include "httpclient.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+namespace {
+
+// same limit as the blocking client
+const size_t MAX_LINE = 4096;
+
+}
+
+HTTPResponseParser::HTTPResponseParser()
+    : _state(State::STATUS_LINE),
+      _line(),
+      _keepBody(false),
+      _body(),
+      _headerinfo(),
+      _httpVersion(0),
+      _requestStatus(0),
+      _totalHitCount(-1),
+      _connectionCloseGiven(false),
+      _keepAliveGiven(false),
+      _contentLengthGiven(false),
+      _chunkedEncodingGiven(false),
+      _contentLeft(0),
+      _dataRead(0)
+{
+}
+
+HTTPResponseParser::~HTTPResponseParser()
+{
+}
+
+void
+HTTPResponseParser::Reset(bool keepBody)
+{
+    _state = State::STATUS_LINE;
+    _line.clear();
+    _keepBody = keepBody;
+    _body.clear();
+    _headerinfo.clear();
+    _httpVersion = 0;
+    _requestStatus = 0;
+    _totalHitCount = -1;
+    _connectionCloseGiven = false;
+    _keepAliveGiven = false;
+    _contentLengthGiven = false;
+    _chunkedEncodingGiven = false;
+    _contentLeft = 0;
+    _dataRead = 0;
+}
+
+bool
+HTTPResponseParser::ParseStatusLine()
+{
+    int   argc;
+    char *argv[32];
+
+    if (strncmp(_line.c_str(), "HTTP/", 5) != 0) {
+        return false;
+    }
+    std::string line = _line;
+    HTTPClient::SplitString(&line[0], argc, argv, 32);
+    if (argc < 2) {
+        return false;
+    }
+    _httpVersion = (strncmp(argv[0], "HTTP/1.0", 8) == 0) ? 0 : 1;
+    _requestStatus = atoi(argv[1]);
+    return true;
+}
+
+void
+HTTPResponseParser::ParseHeaderLine()
+{
+    int   argc;
+    char *argv[32];
+
+    if (strncmp(_line.c_str(), "X-Yahoo-Vespa-", strlen("X-Yahoo-Vespa-")) == 0) {
+        const auto benchmark_data = _line.substr(14);
+        auto strpos = benchmark_data.find("TotalHitCount:");
+        if (strpos != std::string::npos) {
+            _totalHitCount = atoi(benchmark_data.substr(14).c_str());
+        }
+        _headerinfo += benchmark_data;
+        _headerinfo += "\n";
+    }
+    std::string line = _line;
+    HTTPClient::SplitString(&line[0], argc, argv, 32);
+    if (argc > 1) {
+        if (strcasecmp(argv[0], "connection:") == 0) {
+            for (int i = 1; i < argc; i++) {
+                if (strcasecmp(argv[i], "keep-alive") == 0) {
+                    _keepAliveGiven = true;
+                }
+                if (strcasecmp(argv[i], "close") == 0) {
+                    _connectionCloseGiven = true;
+                }
+            }
+        }
+        if (strcasecmp(argv[0], "content-length:") == 0) {
+            _contentLengthGiven = true;
+            _contentLeft = strtoull(argv[1], nullptr, 10);
+        }
+        if (strcasecmp(argv[0], "transfer-encoding:") == 0
+            && strcasecmp(argv[1], "chunked") == 0) {
+            _chunkedEncodingGiven = true;
+        }
+    }
+}
+
+void
+HTTPResponseParser::HeaderDone()
+{
+    if (_chunkedEncodingGiven) {
+        _state = State::CHUNK_HEADER;
+    } else if (_contentLengthGiven) {
+        _state = (_contentLeft > 0) ? State::CONTENT : State::DONE;
+    } else if ((_requestStatus >= 100 && _requestStatus < 200) ||
+               _requestStatus == 204 || _requestStatus == 304) {
+        // no content by definition
+        _state = State::DONE;
+    } else {
+        _state = State::UNTIL_CLOSE;
+    }
+}
+
+bool
+HTTPResponseParser::ParseChunkHeader()
+{
+    char *end = nullptr;
+    _contentLeft = strtoull(_line.c_str(), &end, 16);
+    if (end == _line.c_str()) {
+        return false;
+    }
+    _state = (_contentLeft > 0) ? State::CHUNK_DATA : State::TRAILER;
+    return true;
+}
+
+void
+HTTPResponseParser::AddContent(const char *data, size_t len)
+{
+    if (_keepBody) {
+        _body.append(data, len);
+    }
+    _dataRead += len;
+}
+
+ssize_t
+HTTPResponseParser::Feed(const char *data, size_t len)
+{
+    size_t pos = 0;
+    while (pos < len && _state != State::DONE && _state != State::FAILED) {
+        switch (_state) {
+        case State::CONTENT:
+        case State::CHUNK_DATA: {
+            size_t n = std::min(uint64_t(len - pos), _contentLeft);
+            AddContent(data + pos, n);
+            pos += n;
+            _contentLeft -= n;
+            if (_contentLeft == 0) {
+                _state = (_state == State::CONTENT) ? State::DONE : State::CHUNK_END;
+            }
+            break;
+        }
+        case State::UNTIL_CLOSE:
+            AddContent(data + pos, len - pos);
+            pos = len;
+            break;
+        default: {
+            // line based states
+            const char *nl = static_cast<const char *>(memchr(data + pos, '\n', len - pos));
+            size_t end = (nl != nullptr) ? (nl - data) : len;
+            _line.append(data + pos, end - pos);
+            pos = end;
+            if (_line.size() > MAX_LINE) {
+                _state = State::FAILED;
+                return -1;
+            }
+            if (nl == nullptr) {
+                break;
+            }
+            ++pos;
+            if (!_line.empty() && _line.back() == '\r') {
+                _line.pop_back();
+            }
+            bool ok = true;
+            switch (_state) {
+            case State::STATUS_LINE:
+                ok = ParseStatusLine();
+                _state = State::HEADER;
+                break;
+            case State::HEADER:
+                if (_line.empty()) {
+                    HeaderDone();
+                } else {
+                    ParseHeaderLine();
+                }
+                break;
+            case State::CHUNK_HEADER:
+                ok = ParseChunkHeader();
+                break;
+            case State::CHUNK_END:
+                ok = _line.empty();
+                _state = State::CHUNK_HEADER;
+                break;
+            case State::TRAILER:
+                if (_line.empty()) {
+                    _state = State::DONE;
+                }
+                break;
+            default:
+                break;
+            }
+            _line.clear();
+            if (!ok) {
+                _state = State::FAILED;
+                return -1;
+            }
+        }
+        }
+    }
+    return pos;
+}
+
+void
+HTTPResponseParser::ConnectionClosed()
+{
+    if (_state == State::UNTIL_CLOSE) {
+        _state = State::DONE;
+    } else if (_state != State::DONE) {
+        _state = State::FAILED;
+    }
+}
+
+bool
+HTTPResponseParser::HeaderParsed() const
+{
+    return (_state != State::STATUS_LINE && _state != State::HEADER);
+}
+
+bool
+HTTPResponseParser::KeepAlive() const
+{
+    return (_state == State::DONE
+            && !_connectionCloseGiven
+            && (_chunkedEncodingGiven || _contentLengthGiven || _requestStatus == 204 || _requestStatus == 304)
+            && (_httpVersion != 0 || _keepAliveGiven));
+}
@@ -0,0 +1,108 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+/**
+ * Incremental parser of HTTP responses, for clients doing their own
+ * non-blocking socket handling. Data is fed as it arrives from the
+ * connection and the parser stops at the end of each response, so
+ * that pipelined responses can be parsed one by one from the same
+ * data stream. Handles the same content length variants as @ref
+ * HTTPClient: Content-Length, chunked encoding and connection close.
+ **/
+class HTTPResponseParser
+{
+private:
+  enum class State {
+    STATUS_LINE,
+    HEADER,
+    CONTENT,
+    CHUNK_HEADER,
+    CHUNK_DATA,
+    CHUNK_END,
+    TRAILER,
+    UNTIL_CLOSE,
+    DONE,
+    FAILED
+  };
+
+  State            _state;
+  std::string      _line;
+  bool             _keepBody;
+  std::string      _body;
+  std::string      _headerinfo;
+  unsigned int     _httpVersion;
+  unsigned int     _requestStatus;
+  int              _totalHitCount;
+  bool             _connectionCloseGiven;
+  bool             _keepAliveGiven;
+  bool             _contentLengthGiven;
+  bool             _chunkedEncodingGiven;
+  uint64_t         _contentLeft;
+  uint64_t         _dataRead;
+
+  bool ParseStatusLine();
+  void ParseHeaderLine();
+  bool ParseChunkHeader();
+  void HeaderDone();
+  void AddContent(const char *data, size_t len);
+
+public:
+  HTTPResponseParser();
+  ~HTTPResponseParser();
+
+  /**
+   * Prepare for parsing the next response.
+   *
+   * @param keepBody whether the response content should be kept in
+   *        memory, to be obtained from @ref GetBody.
+   **/
+  void Reset(bool keepBody);
+
+  /**
+   * Parse data from the connection. Parsing stops at the end of the
+   * current response; any remaining data belongs to the next one.
+   *
+   * @return the number of bytes consumed, or -1 on a protocol error.
+   * @param data the data read from the connection.
+   * @param len the number of bytes in data.
+   **/
+  ssize_t Feed(const char *data, size_t len);
+
+  /**
+   * Tell the parser that the server closed the connection. This
+   * completes a response whose length is given by connection close.
+   **/
+  void ConnectionClosed();
+
+  /**
+   * @return whether the current response has been completely parsed.
+   **/
+  bool Done() const { return _state == State::DONE; }
+
+  /**
+   * @return whether the current response was malformed or cut short.
+   **/
+  bool Failed() const { return _state == State::FAILED; }
+
+  /**
+   * @return whether the header of the current response is parsed.
+   **/
+  bool HeaderParsed() const;
+
+  /**
+   * @return whether the connection may be used for more requests
+   *         after the current response, given that keep-alive was
+   *         requested.
+   **/
+  bool KeepAlive() const;
+
+  unsigned int GetRequestStatus() const { return _requestStatus; }
+  int GetTotalHitCount() const { return _totalHitCount; }
+  uint64_t GetContentSize() const { return _dataRead; }
+  const std::string &GetHeaderInfo() const { return _headerinfo; }
+  const std::string &GetBody() const { return _body; }
+};
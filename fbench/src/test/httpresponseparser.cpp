@@ -0,0 +1,84 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <httpclient/httpresponseparser.h>
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const char *pipelined =
+    "HTTP/1.1 200 OK\r\n"
+    "X-Yahoo-Vespa-TotalHitCount: 42\r\n"
+    "Content-Length: 5\r\n"
+    "\r\n"
+    "hello"
+    "HTTP/1.1 200 OK\r\n"
+    "Transfer-Encoding: chunked\r\n"
+    "\r\n"
+    "3\r\nabc\r\n"
+    "4\r\ndefg\r\n"
+    "0\r\n"
+    "\r\n"
+    "HTTP/1.0 404 Not Found\r\n"
+    "\r\n"
+    "gone";
+
+// feed the data 'step' bytes at a time, as if read in small pieces
+void
+parse(size_t step)
+{
+    HTTPResponseParser parser;
+    size_t len = strlen(pipelined);
+    size_t pos = 0;
+    const char *expectBody[] = { "hello", "abcdefg", "gone" };
+    unsigned int expectStatus[] = { 200, 200, 404 };
+    for (int i = 0; i < 3; ++i) {
+        parser.Reset(true);
+        while (!parser.Done() && pos < len) {
+            size_t n = std::min(step, len - pos);
+            ssize_t used = parser.Feed(pipelined + pos, n);
+            assert(used >= 0);
+            pos += used;
+        }
+        if (i == 2) {
+            assert(!parser.Done());
+            parser.ConnectionClosed();
+        }
+        assert(parser.Done());
+        assert(parser.GetRequestStatus() == expectStatus[i]);
+        assert(parser.GetBody() == expectBody[i]);
+        assert(parser.GetContentSize() == strlen(expectBody[i]));
+        assert(parser.KeepAlive() == (i < 2));
+        assert(parser.GetTotalHitCount() == ((i == 0) ? 42 : -1));
+    }
+    assert(pos == len);
+}
+
+}
+
+int
+main(int argc, char **argv)
+{
+    (void) argc;
+    (void) argv;
+
+    for (size_t step : { 1, 2, 7, 4096 }) {
+        printf("parsing pipelined responses %zu bytes at a time\n", step);
+        parse(step);
+    }
+
+    HTTPResponseParser parser;
+    parser.Reset(false);
+    const char *bad = "garbage\r\n";
+    assert(parser.Feed(bad, strlen(bad)) < 0);
+    assert(parser.Failed());
+
+    parser.Reset(false);
+    const char *cut = "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\nabc";
+    assert(parser.Feed(cut, strlen(cut)) == (ssize_t)strlen(cut));
+    parser.ConnectionClosed();
+    assert(parser.Failed());
+    printf("ok\n");
+    return 0;
+}
@@ -16,6 +16,7 @@ ClientStatus::ClientStatus()
       _timetableResolution(10),
       _timetable(10240 * _timetableResolution, 0),
       _higherCnt(0),
+      _histogram(),
       _minTime(0),
       _maxTime(0),
       _reuseCnt(0),
@@ -50,6 +51,7 @@ ClientStatus::ResponseTime(double ms)
         _higherCnt++;
     else
         _timetable[t]++;
+    _histogram.Record((uint64_t)(ms * 1000.0 + 0.5));
     _requestCnt++;
 }
 
@@ -86,6 +88,7 @@ ClientStatus::Merge(const ClientStatus & status)
     for (size_t i = 0; i < _timetable.size(); i++)
         _timetable[i] += status._timetable[i];
     _higherCnt += status._higherCnt;
+    _histogram.Merge(status._histogram);
     _reuseCnt += status._reuseCnt;
     _zeroHitQueries += status._zeroHitQueries;
 
@@ -175,3 +178,9 @@ ClientStatus::GetPercentile(double percent)
     }
     return (k * val1 + (1 - k) * val2) / _timetableResolution;
 }
+
+double
+ClientStatus::GetHdrPercentile(double percent)
+{
+    return _histogram.GetValueAtPercentile(percent) / 1000.0;
+}
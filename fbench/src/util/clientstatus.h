@@ -1,7 +1,9 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "hdrhistogram.h"
 #include <map>
+#include <string>
 #include <vector>
 
 /**
@@ -73,6 +75,12 @@ struct ClientStatus
      **/
     long   _higherCnt;
 
+    /**
+     * All response times in microseconds, for percentiles with bounded
+     * relative error also in the tail beyond the time table.
+     **/
+    HdrHistogram _histogram;
+
     /**
      * The minimum response time measured.
      **/
@@ -211,6 +219,16 @@ struct ClientStatus
      **/
     double GetPercentile(double percent);
 
+    /**
+     * Like @ref GetPercentile, but calculated from the HDR histogram of
+     * response times, which is accurate to 3 significant digits for
+     * all response times.
+     *
+     * @return the calculated percentile in milliseconds.
+     * @param percent percentile in the range [0,100].
+     **/
+    double GetHdrPercentile(double percent);
+
 private:
     ClientStatus(const ClientStatus &);
     ClientStatus &operator=(const ClientStatus &);
@@ -0,0 +1,81 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "hdrhistogram.h"
+#include <cmath>
+
+HdrHistogram::HdrHistogram()
+    : _counts(),
+      _totalCount(0)
+{
+}
+
+HdrHistogram::~HdrHistogram()
+{
+}
+
+size_t
+HdrHistogram::IndexOf(uint64_t value)
+{
+    // values below SUB_BUCKET_COUNT are exact, after that each power of
+    // two gets SUB_BUCKET_HALF buckets
+    if (value < SUB_BUCKET_COUNT) {
+        return value;
+    }
+    int shift = 63 - __builtin_clzll(value) - (SUB_BUCKET_BITS - 1);
+    return (shift * SUB_BUCKET_HALF) + (value >> shift);
+}
+
+uint64_t
+HdrHistogram::HighestEquivalentValue(size_t index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    int shift = (index / SUB_BUCKET_HALF) - 1;
+    uint64_t subBucket = index - (shift * SUB_BUCKET_HALF);
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void
+HdrHistogram::Record(uint64_t value)
+{
+    size_t index = IndexOf(value);
+    if (index >= _counts.size()) {
+        _counts.resize(index + 1, 0);
+    }
+    _counts[index]++;
+    _totalCount++;
+}
+
+void
+HdrHistogram::Merge(const HdrHistogram &other)
+{
+    if (other._counts.size() > _counts.size()) {
+        _counts.resize(other._counts.size(), 0);
+    }
+    for (size_t i = 0; i < other._counts.size(); i++) {
+        _counts[i] += other._counts[i];
+    }
+    _totalCount += other._totalCount;
+}
+
+uint64_t
+HdrHistogram::GetValueAtPercentile(double percent) const
+{
+    if (_totalCount == 0) {
+        return 0;
+    }
+    if (percent < 0.0) percent = 0.0;
+    if (percent > 100.0) percent = 100.0;
+    uint64_t target = (uint64_t)std::ceil((percent / 100.0) * _totalCount);
+    if (target == 0) {
+        target = 1;
+    }
+    uint64_t cnt = 0;
+    for (size_t i = 0; i < _counts.size(); i++) {
+        cnt += _counts[i];
+        if (cnt >= target) {
+            return HighestEquivalentValue(i);
+        }
+    }
+    return HighestEquivalentValue(_counts.size() - 1);
+}
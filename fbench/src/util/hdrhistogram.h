@@ -0,0 +1,62 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A histogram with HDR (high dynamic range) bucketing of integer
+ * values: each power of two range is split into the same number of
+ * linear sub-buckets, giving 3 significant decimal digits over the
+ * entire value range. Used to record response times in microseconds,
+ * where the fixed resolution time table in @ref ClientStatus only
+ * approximates the tail. Buckets are allocated as larger values are
+ * recorded.
+ **/
+class HdrHistogram
+{
+private:
+  static const int      SUB_BUCKET_BITS = 11;
+  static const uint64_t SUB_BUCKET_COUNT = uint64_t(1) << SUB_BUCKET_BITS;
+  static const uint64_t SUB_BUCKET_HALF = SUB_BUCKET_COUNT >> 1;
+
+  std::vector<uint64_t> _counts;
+  uint64_t              _totalCount;
+
+  static size_t IndexOf(uint64_t value);
+  static uint64_t HighestEquivalentValue(size_t index);
+
+public:
+  HdrHistogram();
+  ~HdrHistogram();
+
+  /**
+   * Record a single value.
+   *
+   * @param value the value to record.
+   **/
+  void Record(uint64_t value);
+
+  /**
+   * Add all values recorded in 'other' to this histogram.
+   *
+   * @param other the histogram to merge into this one.
+   **/
+  void Merge(const HdrHistogram &other);
+
+  /**
+   * @return the number of values recorded.
+   **/
+  uint64_t GetTotalCount() const { return _totalCount; }
+
+  /**
+   * The smallest recorded value (at the histogram precision) such
+   * that 'percent' percent of the recorded values are less than or
+   * equal to it.
+   *
+   * @return the value at the given percentile, or 0 if empty.
+   * @param percent the percentile, in the range [0,100].
+   **/
+  uint64_t GetValueAtPercentile(double percent) const;
+};
@@ -2,6 +2,7 @@
 
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/fnet/fnet.h>
+#include <vespa/fnet/local_shortcut.h>
 #include <vespa/vespalib/net/server_socket.h>
 #include <vespa/vespalib/util/sync.h>
 #include <vespa/vespalib/util/stringfmt.h>
@@ -33,7 +34,7 @@ AsyncResolver::SP make_resolver(AsyncResolver::HostResolver::SP host_resolver) {
 
 //-----------------------------------------------------------------------------
 
-struct TransportFixture : FNET_IPacketHandler, FNET_IConnectionCleanupHandler {
+struct TransportFixture : FNET_IPacketHandler, FNET_IConnectionCleanupHandler, FNET_IServerAdapter {
     FNET_SimplePacketStreamer streamer;
     FastOS_ThreadPool pool;
     FNET_Transport transport;
@@ -57,6 +58,8 @@ struct TransportFixture : FNET_IPacketHandler, FNET_IConnectionCleanupHandler {
         return FNET_FREE_CHANNEL;
     }
     void Cleanup(FNET_Connection *) override { conn_deleted.countDown(); }
+    bool InitAdminChannel(FNET_Channel *) override { return false; }
+    bool InitChannel(FNET_Channel *, uint32_t) override { return false; }
     FNET_Connection *connect(const vespalib::string &spec) {
         FNET_Connection *conn = transport.Connect(spec.c_str(), &streamer, this);
         ASSERT_TRUE(conn != nullptr);
@@ -119,4 +122,74 @@ TEST_MT_FFFF("require that async close can be called before async resolve comple
     }
 }
 
+struct ShortcutTransportFixture : TransportFixture {
+    ShortcutTransportFixture() : TransportFixture() { transport.SetLocalShortcut(true); }
+};
+
+ServerSocket make_shortcut_socket(const ServerSocket &tcp_socket) {
+    return ServerSocket(SocketSpec::from_name(fnet::LocalShortcut::name(tcp_socket.address().port())));
+}
+
+TEST("require that loopback addresses are local") {
+    EXPECT_TRUE(fnet::LocalShortcut::is_local(SocketAddress::select_remote(80, "127.0.0.1")));
+    EXPECT_FALSE(fnet::LocalShortcut::is_local(SocketAddress::from_name("foo")));
+    EXPECT_NOT_EQUAL(fnet::LocalShortcut::name(1234), fnet::LocalShortcut::name(1235));
+}
+
+TEST_MT_FFFF("require that connect uses local shortcut when available", 2,
+             ServerSocket("tcp/0"), ServerSocket(make_shortcut_socket(f1)),
+             ShortcutTransportFixture(), TimeBomb(60))
+{
+    if (thread_id == 0) {
+        SocketHandle socket = f2.accept();
+        EXPECT_TRUE(socket.valid());
+        TEST_BARRIER();
+    } else {
+        vespalib::string spec = make_string("tcp/localhost:%d", f1.address().port());
+        FNET_Connection *conn = f3.connect(spec);
+        TEST_BARRIER();
+        conn->Owner()->Close(conn);
+        EXPECT_TRUE(f3.conn_lost.await(60000));
+        conn->SubRef();
+        EXPECT_TRUE(f3.conn_deleted.await(60000));
+        f1.shutdown();
+    }
+}
+
+TEST_MT_FFF("require that connect falls back to tcp without local shortcut", 2,
+            ServerSocket("tcp/0"), ShortcutTransportFixture(), TimeBomb(60))
+{
+    if (thread_id == 0) {
+        SocketHandle socket = f1.accept();
+        EXPECT_TRUE(socket.valid());
+        TEST_BARRIER();
+    } else {
+        vespalib::string spec = make_string("tcp/localhost:%d", f1.address().port());
+        FNET_Connection *conn = f2.connect(spec);
+        TEST_BARRIER();
+        conn->Owner()->Close(conn);
+        EXPECT_TRUE(f2.conn_lost.await(60000));
+        conn->SubRef();
+        EXPECT_TRUE(f2.conn_deleted.await(60000));
+    }
+}
+
+TEST_FF("require that listen also listens on local shortcut when enabled", ShortcutTransportFixture(), TimeBomb(60)) {
+    FNET_Connector *connector = f1.transport.Listen("tcp/0", &f1.streamer, &f1);
+    ASSERT_TRUE(connector != nullptr);
+    SocketAddress shortcut = SocketAddress::from_name(fnet::LocalShortcut::name(connector->GetPortNumber()));
+    EXPECT_TRUE(shortcut.connect().valid());
+    connector->Owner()->Close(connector);
+    connector->SubRef();
+}
+
+TEST_FF("require that listen does not use local shortcut by default", TransportFixture(), TimeBomb(60)) {
+    FNET_Connector *connector = f1.transport.Listen("tcp/0", &f1.streamer, &f1);
+    ASSERT_TRUE(connector != nullptr);
+    SocketAddress shortcut = SocketAddress::from_name(fnet::LocalShortcut::name(connector->GetPortNumber()));
+    EXPECT_FALSE(shortcut.connect().valid());
+    connector->Owner()->Close(connector);
+    connector->SubRef();
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
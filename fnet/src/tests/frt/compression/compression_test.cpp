@@ -0,0 +1,82 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/fnet/frt/frt.h>
+#include <thread>
+
+struct Rpc {
+    FastOS_ThreadPool thread_pool;
+    FNET_Transport    transport;
+    FRT_Supervisor    orb;
+    Rpc(int compression_level)
+        : thread_pool(128 * 1024), transport(), orb(&transport, &thread_pool)
+    {
+        orb.SetCompressionLevel(compression_level);
+    }
+    ~Rpc() {
+        transport.ShutDown(true);
+        thread_pool.Close();
+    }
+};
+
+struct Server : Rpc {
+    Server(int compression_level) : Rpc(compression_level) {
+        ASSERT_TRUE(orb.Listen(0));
+        ASSERT_TRUE(transport.Start(&thread_pool));
+    }
+};
+
+struct Client : Rpc {
+    FRT_Target *target;
+    Client(int compression_level, Server &server) : Rpc(compression_level), target(nullptr) {
+        ASSERT_TRUE(transport.Start(&thread_pool));
+        target = orb.GetTarget(server.orb.GetListenPort());
+    }
+    ~Client() { target->SubRef(); }
+
+    void echo(const std::string &data) {
+        FRT_RPCRequest *req = orb.AllocRPCRequest();
+        req->SetMethodName("frt.rpc.echo");
+        req->GetParams()->AddData(data.data(), data.size());
+        target->InvokeSync(req, 60.0);
+        ASSERT_TRUE(req->CheckReturnTypes("x"));
+        FRT_DataValue &value = req->GetReturn()->GetValue(0)._data;
+        EXPECT_EQUAL(data, std::string(value._buf, value._len));
+        req->SubRef();
+    }
+
+    bool wait_for_compression() {
+        for (size_t i = 0; i < 1000; ++i) {
+            if (target->GetConnection()->OutputCompressionEnabled()) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+};
+
+std::string make_data(size_t len) {
+    std::string data;
+    for (size_t i = 0; data.size() < len; ++i) {
+        data += "message part " + std::to_string(i % 100) + ";";
+    }
+    return data;
+}
+
+TEST_FF("require that compressed connections deliver data unchanged", Server(3), Client(3, f1)) {
+    f2.echo(make_data(10));
+    EXPECT_TRUE(f2.wait_for_compression());
+    for (size_t len: {10, 300, 5000, 100000, 1000000}) {
+        f2.echo(make_data(len));
+        f2.echo(make_data(len));
+    }
+}
+
+TEST_FF("require that compression is not used when server does not enable it", Server(0), Client(3, f1)) {
+    f2.echo(make_data(5000));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(f2.target->GetConnection()->OutputCompressionEnabled());
+    f2.echo(make_data(5000));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -7,12 +7,18 @@
 
 using vespalib::BenchmarkTimer;
 
+enum class WriteMode { DIRECT, EVENT, BATCHED };
+
 struct Rpc : FRT_Invokable {
     FastOS_ThreadPool thread_pool;
     FNET_Transport    transport;
     FRT_Supervisor    orb;
-    Rpc(size_t num_threads)
-        : thread_pool(128 * 1024), transport(num_threads), orb(&transport, &thread_pool) {}
+    Rpc(size_t num_threads, WriteMode write_mode)
+        : thread_pool(128 * 1024), transport(num_threads), orb(&transport, &thread_pool)
+    {
+        transport.SetDirectWrite(write_mode == WriteMode::DIRECT);
+        transport.SetBatchedWrite(write_mode == WriteMode::BATCHED);
+    }
     void start() {
         ASSERT_TRUE(transport.Start(&thread_pool));
     }
@@ -31,7 +37,9 @@ struct Rpc : FRT_Invokable {
 
 struct Server : Rpc {
     uint32_t port;
-    Server(size_t num_threads) : Rpc(num_threads), port(listen()) {
+    Server(size_t num_threads, WriteMode write_mode = WriteMode::DIRECT)
+        : Rpc(num_threads, write_mode), port(listen())
+    {
         init_rpc();
         start();
     }
@@ -51,7 +59,9 @@ struct Server : Rpc {
 
 struct Client : Rpc {
     uint32_t port;
-    Client(size_t num_threads, const Server &server) : Rpc(num_threads), port(server.port) {
+    Client(size_t num_threads, const Server &server, WriteMode write_mode = WriteMode::DIRECT)
+        : Rpc(num_threads, write_mode), port(server.port)
+    {
         start();
     }
     FRT_Target *connect() { return Rpc::connect(port); }
@@ -126,4 +136,10 @@ TEST_MT_FFF("parallel rpc with 8/1 transport threads and 128 user threads",
 TEST_MT_FFF("parallel rpc with 8/8 transport threads and 128 user threads",
             128, Server(8), Client(8, f1), Result(num_threads)) { perform_test(thread_id, f2, f3); }
 
+TEST_MT_FFF("parallel rpc with 8/8 transport threads, 128 user threads and event driven writes",
+            128, Server(8, WriteMode::EVENT), Client(8, f1, WriteMode::EVENT), Result(num_threads)) { perform_test(thread_id, f2, f3); }
+
+TEST_MT_FFF("parallel rpc with 8/8 transport threads, 128 user threads and batched writes",
+            128, Server(8, WriteMode::BATCHED), Client(8, f1, WriteMode::BATCHED), Result(num_threads)) { perform_test(thread_id, f2, f3); }
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -927,6 +927,12 @@ TEST_F("invoke test", State()) {
     EXPECT_TRUE(_phase_error_cnt == 4);
     EXPECT_TRUE(_phase_abort_cnt == 4);
     EXPECT_TRUE(_phase_echo_cnt == 1);
+    const FNET_TransportMetrics &client_metrics = _state->_client.GetTransport()->GetMetrics();
+    const FNET_TransportMetrics &server_metrics = _state->_server.GetTransport()->GetMetrics();
+    EXPECT_TRUE(client_metrics._packetsWritten->value() > 0);
+    EXPECT_TRUE(server_metrics._packetsRead->value() > 0);
+    EXPECT_EQUAL(client_metrics._bytesWritten->value(), client_metrics._writeSize->snapshot().sum);
+    EXPECT_EQUAL(server_metrics._bytesRead->value(), server_metrics._readSize->snapshot().sum);
 }
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,6 +2,7 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/fnet/frt/values.h>
 #include <vespa/fnet/databuffer.h>
+#include <vespa/fnet/iexternaldatasink.h>
 #include <vespa/fnet/info.h>
 
 using vespalib::Stash;
@@ -203,6 +204,35 @@ TEST_FFFF("decode little if host is little", Stash(), FRT_Values(f1),
     }
 }
 
+struct SpliceSink : FNET_IExternalDataSink {
+    FNET_DataBuffer &dst;
+    std::vector<std::pair<const char *, uint32_t>> regions;
+    SpliceSink(FNET_DataBuffer &dst_in) : dst(dst_in), regions() {}
+    void AddExternalData(const char *data, uint32_t len) override {
+        regions.emplace_back(data, len);
+        dst.WriteBytesFast(data, len);
+    }
+};
+
+TEST_FFFF("large data values are handed over to external data sink", Stash(), FRT_Values(f1),
+          FNET_DataBuffer(), FRT_Values(f1))
+{
+    std::vector<char> small(100, 'a');
+    std::vector<char> large(FRT_Values::EXTERNAL_DATA_LIMIT + 10, 'b');
+    f2.AddData(&small[0], small.size());
+    f2.AddData(&large[0], large.size());
+    f2.AddInt32(42);
+    SpliceSink sink(f3);
+    f3.EnsureFree(f2.GetLength());
+    f2.EncodeCopy(&f3, &sink);
+    ASSERT_EQUAL(1u, sink.regions.size());
+    EXPECT_EQUAL(f2[1]._data._buf, sink.regions[0].first);
+    EXPECT_EQUAL(large.size(), sink.regions[0].second);
+    EXPECT_EQUAL(f2.GetLength(), f3.GetDataLen());
+    EXPECT_TRUE(f4.DecodeCopy(&f3, f3.GetDataLen()));
+    EXPECT_TRUE(f2.Equals(&f4));
+}
+
 TEST_FF("print values", Stash(), FRT_Values(f1)) {
     fillValues(f2);
     f2.Print();
@@ -10,5 +10,7 @@ FNET_Config::FNET_Config()
       _maxOutputBufferSize(0x10000),
       _tcpNoDelay(true),
       _logStats(false),
-      _directWrite(true)
+      _directWrite(true),
+      _batchedWrite(false),
+      _localShortcut(false)
 { }
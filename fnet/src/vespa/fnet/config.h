@@ -19,6 +19,8 @@ public:
     bool      _tcpNoDelay;
     bool      _logStats;
     bool      _directWrite;
+    bool      _batchedWrite;
+    bool      _localShortcut;
 
     FNET_Config();
 };
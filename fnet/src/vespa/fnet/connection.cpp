@@ -9,6 +9,10 @@
 #include "config.h"
 #include "transport_thread.h"
 #include "transport.h"
+#include "local_shortcut.h"
+#include <vespa/vespalib/util/zstdstream.h>
+#include <algorithm>
+#include <sys/uio.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".fnet");
@@ -147,7 +151,7 @@ FNET_Connection::SetState(State state)
 
 void
 FNET_Connection::HandlePacket(uint32_t plen, uint32_t pcode,
-                              uint32_t chid)
+                              uint32_t chid, FNET_DataBuffer &src)
 {
     FNET_Packet *packet;
     FNET_Channel *channel;
@@ -159,11 +163,11 @@ FNET_Connection::HandlePacket(uint32_t plen, uint32_t pcode,
     if (channel != nullptr) { // deliver packet on open channel
         channel->prefetch(); // Prefetch in the shadow of the lock operation in BeforeCallback.
         __builtin_prefetch(&_streamer);
-        __builtin_prefetch(&_input);
+        __builtin_prefetch(&src);
 
         BeforeCallback(guard, channel);
         __builtin_prefetch(channel->GetHandler(), 0);  // Prefetch the handler while packet is being decoded.
-        packet = _streamer->Decode(&_input, plen, pcode, channel->GetContext());
+        packet = _streamer->Decode(&src, plen, pcode, channel->GetContext());
         hp_rc = (packet != nullptr) ? channel->Receive(packet)
                 : channel->Receive(&FNET_ControlPacket::BadPacket);
         AfterCallback(guard);
@@ -189,7 +193,7 @@ FNET_Connection::HandlePacket(uint32_t plen, uint32_t pcode,
 
         if (_serverAdapter->InitChannel(channel, pcode)) {
 
-            packet = _streamer->Decode(&_input, plen, pcode, channel->GetContext());
+            packet = _streamer->Decode(&src, plen, pcode, channel->GetContext());
             hp_rc = (packet != nullptr) ? channel->Receive(packet)
                     : channel->Receive(&FNET_ControlPacket::BadPacket);
             AfterCallback(guard);
@@ -208,18 +212,40 @@ FNET_Connection::HandlePacket(uint32_t plen, uint32_t pcode,
             guard.unlock();
 
             LOG(debug, "Connection(%s): channel init failed", GetSpec());
-            _input.DataToDead(plen);
+            src.DataToDead(plen);
         }
 
     } else { // skip unhandled packet
 
         guard.unlock();
         LOG(spam, "Connection(%s): skipping unhandled packet", GetSpec());
-        _input.DataToDead(plen);
+        src.DataToDead(plen);
     }
 }
 
 
+bool
+FNET_Connection::InflatePacket(uint32_t plen)
+{
+    if (plen < sizeof(uint32_t)) {
+        return false;
+    }
+    uint32_t len = _input.ReadInt32();
+    plen -= sizeof(uint32_t);
+    if (!_decompressor) {
+        _decompressor = std::make_unique<vespalib::compression::ZStdStreamDecompressor>();
+    }
+    _inflated.Clear();
+    _inflated.EnsureFree(len);
+    bool ok = _decompressor->decompress(_input.GetData(), plen, _inflated.GetFree(), len);
+    _input.DataToDead(plen);
+    if (ok) {
+        _inflated.FreeToData(len);
+    }
+    return ok;
+}
+
+
 bool
 FNET_Connection::Read()
 {
@@ -246,7 +272,22 @@ FNET_Connection::Read()
 
             if (_flags._gotheader && _input.GetDataLen() >= _packetLength) {
                 readPackets++;
-                HandlePacket(_packetLength, _packetCode, _packetCHID);
+                if ((_packetCode & FNET_PCODE_COMPRESSED) != 0) {
+                    if (!InflatePacket(_packetLength)) {
+                        LOG(debug, "Connection(%s): could not decompress packet", GetSpec());
+                        broken = true;
+                        goto done_read;
+                    }
+                    HandlePacket(_inflated.GetDataLen(), _packetCode & ~FNET_PCODE_COMPRESSED,
+                                 _packetCHID, _inflated);
+                    _inflated.Clear();
+                    uint32_t maxSize = GetConfig()->_maxInputBufferSize;
+                    if (maxSize > 0 && _inflated.GetBufSize() > maxSize) {
+                        _inflated.Shrink(maxSize);
+                    }
+                } else {
+                    HandlePacket(_packetLength, _packetCode, _packetCHID, _input);
+                }
                 _flags._gotheader = false; // reset header flag.
             } else {
                 if (broken)
@@ -271,6 +312,7 @@ done_read:
         UpdateTimeOut();
         CountDataRead(readData);
         CountPacketRead(readPackets);
+        CountReadEvent(readPackets, readData);
         uint32_t maxSize = GetConfig()->_maxInputBufferSize;
         if (maxSize > 0 && _input.GetBufSize() > maxSize)
         {
@@ -295,6 +337,129 @@ done_read:
 }
 
 
+void
+FNET_Connection::ExternalDataSink::AddExternalData(const char *data, uint32_t len)
+{
+    if (len > 0) {
+        FNET_Connection &conn = connection;
+        conn._external.push_back(ExternalData{conn._outputPos + conn._output.GetDataLen(),
+                                              data, len, nullptr});
+    }
+}
+
+
+size_t
+FNET_Connection::PendingOutput() const
+{
+    size_t len = _output.GetDataLen();
+    for (const ExternalData &ext : _external) {
+        len += ext.len;
+    }
+    return len;
+}
+
+
+ssize_t
+FNET_Connection::WriteOutput()
+{
+    if (_external.empty()) {
+        return _socket.write(_output.GetData(), _output.GetDataLen());
+    }
+    struct iovec iov[FNET_WRITE_IOV];
+    int iovCnt = 0;
+    const uint64_t end = _outputPos + _output.GetDataLen();
+    uint64_t pos = _outputPos;
+    auto copied = [&](uint64_t to) {
+        iov[iovCnt].iov_base = _output.GetData() + (pos - _outputPos);
+        iov[iovCnt].iov_len  = to - pos;
+        ++iovCnt;
+        pos = to;
+    };
+    bool allExternal = true;
+    for (const ExternalData &ext : _external) {
+        if (iovCnt + 2 > FNET_WRITE_IOV) {
+            allExternal = false;
+            break;
+        }
+        if (ext.pos > pos) {
+            copied(ext.pos);
+        }
+        iov[iovCnt].iov_base = const_cast<char *>(ext.data);
+        iov[iovCnt].iov_len  = ext.len;
+        ++iovCnt;
+    }
+    if (allExternal && pos < end) {
+        copied(end);
+    }
+    return ::writev(_socket.get(), iov, iovCnt);
+}
+
+
+void
+FNET_Connection::ConsumeOutput(size_t len)
+{
+    while (len > 0) {
+        uint64_t copied = _output.GetDataLen();
+        if (!_external.empty()) {
+            copied = std::min(copied, _external.front().pos - _outputPos);
+        }
+        if (copied > 0) {
+            uint32_t n = std::min(copied, (uint64_t)len);
+            _output.DataToDead(n);
+            _outputPos += n;
+            len -= n;
+            continue;
+        }
+        assert(!_external.empty());
+        ExternalData &ext = _external.front();
+        uint32_t n = std::min((size_t)ext.len, len);
+        ext.data += n;
+        ext.len  -= n;
+        len      -= n;
+        if (ext.len == 0) {
+            if (ext.packet != nullptr) {
+                ext.packet->Free();
+            }
+            _external.pop_front();
+        }
+    }
+}
+
+
+void
+FNET_Connection::EncodeCompressed(FNET_Packet *packet, uint32_t chid)
+{
+    _streamer->Encode(packet, chid, &_frame);
+    if (_frame.GetDataLen() < 3 * sizeof(uint32_t) + FNET_COMPRESS_MIN_SIZE) {
+        _output.WriteBytes(_frame.GetData(), _frame.GetDataLen());
+        _frame.Clear();
+        return;
+    }
+    if (!_compressor) {
+        _compressor = std::make_unique<vespalib::compression::ZStdStreamCompressor>(_compressionLevel.load());
+    }
+    _frame.ReadInt32(); // packet length, replaced below
+    uint32_t pcode = _frame.ReadInt32();
+    uint32_t pchid = _frame.ReadInt32();
+    uint32_t len   = _frame.GetDataLen();
+    const uint32_t headerLen = 4 * sizeof(uint32_t);
+    size_t maxLen = vespalib::compression::ZStdStreamCompressor::maxCompressedSize(len);
+    _output.EnsureFree(headerLen + maxLen);
+    size_t clen = _compressor->compress(_frame.GetData(), len, _output.GetFree() + headerLen, maxLen);
+    assert(clen > 0);
+    _output.WriteInt32Fast(clen + 3 * sizeof(uint32_t));
+    _output.WriteInt32Fast(pcode | FNET_PCODE_COMPRESSED);
+    _output.WriteInt32Fast(pchid);
+    _output.WriteInt32Fast(len);
+    _output.FreeToData(clen);
+    _frame.Clear();
+    uint32_t maxSize = GetConfig()->_maxOutputBufferSize;
+    if (maxSize > 0 && _frame.GetBufSize() > maxSize) {
+        _frame.Shrink(maxSize);
+    }
+}
+
+
 bool
 FNET_Connection::Write(bool direct)
 {
@@ -311,38 +476,47 @@ FNET_Connection::Write(bool direct)
 
         // fill output buffer
 
-        while (_output.GetDataLen() < FNET_WRITE_SIZE) {
+        while (PendingOutput() < FNET_WRITE_SIZE) {
             if (_myQueue.IsEmpty_NoLock())
                 break;
 
             packet = _myQueue.DequeuePacket_NoLock(&context);
-            if (packet->IsRegularPacket()) { // ignore non-regular packets
-                _streamer->Encode(packet, context._value.INT, &_output);
+            if (packet->IsRegularPacket() && OutputCompressionEnabled()) {
+                EncodeCompressed(packet, context._value.INT);
                 writtenPackets++;
+            } else if (packet->IsRegularPacket()) { // ignore non-regular packets
+                size_t externalCnt = _external.size();
+                _streamer->EncodeExternal(packet, context._value.INT, &_output, _externalSink);
+                writtenPackets++;
+                if (_external.size() > externalCnt) {
+                    _external.back().packet = packet; // free when written
+                    continue;
+                }
             }
             packet->Free();
         }
 
-        if (_output.GetDataLen() == 0) {
+        if (PendingOutput() == 0) {
             res = 0;
             break;
         }
 
         // write data
 
-        res = _socket.write(_output.GetData(), _output.GetDataLen());
+        res = WriteOutput();
         writeCnt++;
         if (res > 0) {
-            _output.DataToDead((uint32_t)res);
+            ConsumeOutput((size_t)res);
             writtenData += (uint32_t)res;
             _output.resetIfEmpty();
         }
     } while (res > 0 &&
-             _output.GetDataLen() == 0 &&
+             PendingOutput() == 0 &&
              !_myQueue.IsEmpty_NoLock() &&
              writeCnt < FNET_WRITE_REDO);
 
     if (writtenData > 0) {
+        CountWriteEvent(writtenPackets, writtenData);
         uint32_t maxSize = GetConfig()->_maxOutputBufferSize;
         if (maxSize > 0 && _output.GetBufSize() > maxSize) {
             _output.Shrink(maxSize);
@@ -359,7 +533,7 @@ FNET_Connection::Write(bool direct)
     std::unique_lock<std::mutex> guard(_ioc_lock);
     _writeWork = _queue.GetPacketCnt_NoLock()
                  + _myQueue.GetPacketCnt_NoLock()
-                 + ((_output.GetDataLen() > 0) ? 1 : 0);
+                 + ((PendingOutput() > 0) ? 1 : 0);
     _flags._writeLock = false;
     if (_flags._discarding) {
         _ioc_cond.notify_all();
@@ -421,6 +595,14 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
       _queue(256),
       _myQueue(256),
       _output(FNET_WRITE_SIZE * 2),
+      _outputPos(0),
+      _external(),
+      _externalSink(*this),
+      _compressionLevel(0),
+      _compressor(),
+      _decompressor(),
+      _frame(),
+      _inflated(),
       _channels(),
       _callbackTarget(nullptr),
       _cleanup(nullptr)
@@ -456,6 +638,14 @@ FNET_Connection::FNET_Connection(FNET_TransportThread *owner,
       _queue(256),
       _myQueue(256),
       _output(FNET_WRITE_SIZE * 2),
+      _outputPos(0),
+      _external(),
+      _externalSink(*this),
+      _compressionLevel(0),
+      _compressor(),
+      _decompressor(),
+      _frame(),
+      _inflated(),
       _channels(),
       _callbackTarget(nullptr),
       _cleanup(nullptr)
@@ -476,6 +666,11 @@ FNET_Connection::~FNET_Connection()
     }
     assert(_cleanup == nullptr);
     assert(!_flags._writeLock);
+    for (const ExternalData &ext : _external) {
+        if (ext.packet != nullptr) {
+            ext.packet->Free();
+        }
+    }
 }
 
 
@@ -516,7 +711,17 @@ FNET_Connection::handle_add_event()
 {
     if (_resolve_handler) {
         auto tweak = [this](vespalib::SocketHandle &handle) { return Owner()->tune(handle); };
-        _socket = _resolve_handler->address.connect(tweak);
+        const vespalib::SocketAddress &address = _resolve_handler->address;
+        if (GetConfig()->_localShortcut && fnet::LocalShortcut::is_local(address)) {
+            // fails right away unless a local shortcut is listening for this port
+            _socket = vespalib::SocketAddress::from_name(fnet::LocalShortcut::name(address.port())).connect(tweak);
+            if (_socket.valid()) {
+                LOG(debug, "Connection(%s): using local shortcut", GetSpec());
+            }
+        }
+        if (!_socket.valid()) {
+            _socket = address.connect(tweak);
+        }
         _ioc_socket_fd = _socket.get();
         _resolve_handler.reset();
     }
@@ -707,6 +912,27 @@ FNET_Connection::HandleReadEvent()
 }
 
 
+bool
+FNET_Connection::flush_writes()
+{
+    if (_state != FNET_CONNECTED) {
+        return FNET_IOComponent::flush_writes();
+    }
+    if (!HandleWriteEvent()) {
+        return false;
+    }
+    bool writePending;
+    {
+        std::lock_guard<std::mutex> guard(_ioc_lock);
+        writePending = (_writeWork > 0);
+    }
+    if (writePending) {
+        EnableWriteEvent(true);
+    }
+    return true;
+}
+
+
 bool
 FNET_Connection::writePendingAfterConnect()
 {
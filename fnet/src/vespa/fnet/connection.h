@@ -7,8 +7,11 @@
 #include "context.h"
 #include "channellookup.h"
 #include "packetqueue.h"
+#include "iexternaldatasink.h"
 #include <vespa/vespalib/net/socket_handle.h>
 #include <vespa/vespalib/net/async_resolver.h>
+#include <atomic>
+#include <deque>
 
 class FNET_IPacketStreamer;
 class FNET_IServerAdapter;
@@ -46,6 +49,11 @@ public:
  * connection. Only the client side may open new channels on the
  * connection.
  **/
+namespace vespalib::compression {
+class ZStdStreamCompressor;
+class ZStdStreamDecompressor;
+}
+
 class FNET_Connection : public FNET_IOComponent
 {
 public:
@@ -60,9 +68,23 @@ public:
         FNET_READ_SIZE  = 8192,
         FNET_READ_REDO  = 10,
         FNET_WRITE_SIZE = 8192,
-        FNET_WRITE_REDO = 10
+        FNET_WRITE_REDO = 10,
+        FNET_WRITE_IOV  = 64
     };
 
+    /**
+     * Packet code flag marking a packet whose body is compressed with
+     * the streaming compressor of the sending connection. The body
+     * then starts with the uncompressed body length.
+     **/
+    static constexpr uint32_t FNET_PCODE_COMPRESSED = 0x80000000;
+
+    /**
+     * Packets with smaller bodies are sent uncompressed, also when
+     * output compression is enabled.
+     **/
+    static constexpr uint32_t FNET_COMPRESS_MIN_SIZE = 256;
+
 private:
     struct Flags {
         Flags() :
@@ -86,6 +108,23 @@ private:
         ~ResolveHandler();
     };
     using ResolveHandlerSP = std::shared_ptr<ResolveHandler>;
+    /**
+     * Payload region written directly from packet memory. 'pos' is the
+     * position in the output stream (counting only bytes copied into
+     * the output buffer) where the region belongs. 'packet' is freed
+     * when the region has been written.
+     **/
+    struct ExternalData {
+        uint64_t     pos;
+        const char  *data;
+        uint32_t     len;
+        FNET_Packet *packet;
+    };
+    struct ExternalDataSink : public FNET_IExternalDataSink {
+        FNET_Connection &connection;
+        ExternalDataSink(FNET_Connection &conn) : connection(conn) {}
+        void AddExternalData(const char *data, uint32_t len) override;
+    };
     FNET_IPacketStreamer    *_streamer;        // custom packet streamer
     FNET_IServerAdapter     *_serverAdapter;   // only on server side
     FNET_Channel            *_adminChannel;    // only on client side
@@ -103,6 +142,14 @@ private:
     FNET_PacketQueue_NoLock  _queue;           // outer output queue
     FNET_PacketQueue_NoLock  _myQueue;         // inner output queue
     FNET_DataBuffer          _output;          // output buffer
+    uint64_t                 _outputPos;       // stream pos of output buffer
+    std::deque<ExternalData> _external;        // external output regions
+    ExternalDataSink         _externalSink;    // used when encoding packets
+    std::atomic<int>         _compressionLevel; // output compression (0: off)
+    std::unique_ptr<vespalib::compression::ZStdStreamCompressor>   _compressor;
+    std::unique_ptr<vespalib::compression::ZStdStreamDecompressor> _decompressor;
+    FNET_DataBuffer          _frame;           // packet before compression
+    FNET_DataBuffer          _inflated;        // packet after decompression
     FNET_ChannelLookup       _channels;        // channel 'DB'
     FNET_Channel            *_callbackTarget;  // target of current callback
 
@@ -197,7 +244,49 @@ private:
      * @param pcode packet code
      * @param chid channel id
      **/
-    void HandlePacket(uint32_t plen, uint32_t pcode, uint32_t chid);
+    void HandlePacket(uint32_t plen, uint32_t pcode, uint32_t chid, FNET_DataBuffer &src);
+
+    /**
+     * Decompress a compressed packet body from the input buffer into
+     * the inflated buffer.
+     *
+     * @return false if the packet could not be decompressed.
+     * @param plen compressed packet length
+     **/
+    bool InflatePacket(uint32_t plen);
+
+    /**
+     * Encode a packet into the output buffer, compressing the packet
+     * body if output compression is enabled.
+     *
+     * @param packet the packet to encode
+     * @param chid channel id for packet
+     **/
+    void EncodeCompressed(FNET_Packet *packet, uint32_t chid);
+
+    /**
+     * @return number of output bytes ready to be written, including
+     *         external data regions.
+     **/
+    size_t PendingOutput() const;
+
+    /**
+     * Write pending output to the socket. External data regions are
+     * written with scatter-gather I/O, together with the surrounding
+     * data from the output buffer.
+     *
+     * @return bytes written, or -1 on error (errno is set)
+     **/
+    ssize_t WriteOutput();
+
+    /**
+     * Consume the given number of written bytes from the output buffer
+     * and the external data regions. Packets owning fully written
+     * regions are freed.
+     *
+     * @param len number of bytes written
+     **/
+    void ConsumeOutput(size_t len);
 
     /**
      * Read incoming data from socket.
@@ -218,6 +307,23 @@ private:
     bool writePendingAfterConnect();
 public:
 
+    /**
+     * Compress packets written on this connection with streaming zstd,
+     * starting with the next packet written. The peer must be known to
+     * accept compressed packets, which is negotiated by the FRT
+     * supervisor. Compression requires packet streamers using the
+     * standard FNET packet header, like FNET_SimplePacketStreamer.
+     * Compressed packets are always accepted as input.
+     *
+     * @param level zstd compression level
+     **/
+    void EnableOutputCompression(int level) { _compressionLevel.store(level); }
+
+    /**
+     * @return whether packets written on this connection are compressed
+     **/
+    bool OutputCompressionEnabled() const { return (_compressionLevel.load() != 0); }
+
     /**
      * Construct a connection in server aspect.
      *
@@ -487,6 +593,15 @@ public:
      **/
     bool HandleWriteEvent() override;
 
+
+    /**
+     * Called by the transport layer to write pending output without
+     * waiting for a write event (batched writes).
+     *
+     * @return false is connection broken, true otherwise.
+     **/
+    bool flush_writes() override;
+
     /**
      * @return Returns the size of this connection's output buffer.
      */
@@ -4,6 +4,7 @@
 #include "transport_thread.h"
 #include "transport.h"
 #include "connection.h"
+#include <cassert>
 
 
 #include <vespa/log/log.h>
@@ -20,7 +21,8 @@ FNET_Connector::FNET_Connector(FNET_TransportThread *owner,
     : FNET_IOComponent(owner, server_socket.get_fd(), spec, /* time-out = */ false),
       _streamer(streamer),
       _serverAdapter(serverAdapter),
-      _server_socket(std::move(server_socket))
+      _server_socket(std::move(server_socket)),
+      _shortcut(nullptr)
 {
 }
 
@@ -31,12 +33,25 @@ FNET_Connector::GetPortNumber() const {
 }
 
 
+void
+FNET_Connector::SetShortcut(FNET_Connector *shortcut)
+{
+    assert(_shortcut == nullptr);
+    _shortcut = shortcut;
+}
+
+
 void
 FNET_Connector::Close()
 {
     detach_selector();
     _ioc_socket_fd = -1;
     _server_socket = vespalib::ServerSocket();
+    if (_shortcut != nullptr) {
+        _shortcut->Owner()->Close(_shortcut);
+        _shortcut->SubRef();
+        _shortcut = nullptr;
+    }
 }
 
 
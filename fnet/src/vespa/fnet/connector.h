@@ -18,6 +18,7 @@ private:
     FNET_IPacketStreamer  *_streamer;
     FNET_IServerAdapter   *_serverAdapter;
     vespalib::ServerSocket _server_socket;
+    FNET_Connector        *_shortcut;
 
     FNET_Connector(const FNET_Connector &);
     FNET_Connector &operator=(const FNET_Connector &);
@@ -45,10 +46,21 @@ public:
      **/
     uint32_t GetPortNumber() const;
 
+    /**
+     * Attach the connector accepting local shortcut connections on
+     * behalf of this connector. This connector takes over the given
+     * reference and closes the shortcut connector when it is closed
+     * itself.
+     *
+     * @param shortcut connector listening on the local shortcut
+     **/
+    void SetShortcut(FNET_Connector *shortcut);
+
     /**
      * Close this connector. This method must be called in the transport
      * thread in order to avoid race conditions related to socket event
-     * registration, deregistration and triggering.
+     * registration, deregistration and triggering. Any attached
+     * shortcut connector is closed as well.
      **/
     void Close() override;
 
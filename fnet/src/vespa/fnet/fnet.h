@@ -45,6 +45,7 @@ class FNET_TransportThread;
 #include "ipacketfactory.h"
 #include "ipackethandler.h"
 #include "ipacketstreamer.h"
+#include "iexternaldatasink.h"
 #include "iserveradapter.h"
 #include "iexecutable.h"
 
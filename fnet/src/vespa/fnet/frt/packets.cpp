@@ -38,6 +38,20 @@ FRT_RPCRequestPacket::GetLength()
 
 void
 FRT_RPCRequestPacket::Encode(FNET_DataBuffer *dst)
+{
+    encode(dst, nullptr);
+}
+
+
+void
+FRT_RPCRequestPacket::EncodeExternal(FNET_DataBuffer *dst, FNET_IExternalDataSink &sink)
+{
+    encode(dst, ExternalDataSink(sink));
+}
+
+
+void
+FRT_RPCRequestPacket::encode(FNET_DataBuffer *dst, FNET_IExternalDataSink *sink)
 {
     uint32_t packet_endian = ((_flags & FLAG_FRT_RPC_LITTLE_ENDIAN) != 0)
                              ? FNET_Info::ENDIAN_LITTLE : FNET_Info::ENDIAN_BIG;
@@ -48,13 +62,13 @@ FRT_RPCRequestPacket::Encode(FNET_DataBuffer *dst)
         dst->WriteBytesFast(&tmp, sizeof(tmp));
         dst->WriteBytesFast(_req->GetMethodName(),
                             _req->GetMethodNameLen());
-        _req->GetParams()->EncodeCopy(dst);
+        _req->GetParams()->EncodeCopy(dst, sink);
     } else {
         assert(packet_endian == FNET_Info::ENDIAN_BIG);
         dst->WriteInt32Fast(_req->GetMethodNameLen());
         dst->WriteBytesFast(_req->GetMethodName(),
                             _req->GetMethodNameLen());
-        _req->GetParams()->EncodeBig(dst);
+        _req->GetParams()->EncodeBig(dst, sink);
     }
 }
 
@@ -120,16 +134,30 @@ FRT_RPCReplyPacket::GetLength()
 
 void
 FRT_RPCReplyPacket::Encode(FNET_DataBuffer *dst)
+{
+    encode(dst, nullptr);
+}
+
+
+void
+FRT_RPCReplyPacket::EncodeExternal(FNET_DataBuffer *dst, FNET_IExternalDataSink &sink)
+{
+    encode(dst, ExternalDataSink(sink));
+}
+
+
+void
+FRT_RPCReplyPacket::encode(FNET_DataBuffer *dst, FNET_IExternalDataSink *sink)
 {
     uint32_t packet_endian = ((_flags & FLAG_FRT_RPC_LITTLE_ENDIAN) != 0)
                              ? FNET_Info::ENDIAN_LITTLE : FNET_Info::ENDIAN_BIG;
     uint32_t host_endian = FNET_Info::GetEndian();
 
     if (packet_endian == host_endian) {
-        _req->GetReturn()->EncodeCopy(dst);
+        _req->GetReturn()->EncodeCopy(dst, sink);
     } else {
         assert(packet_endian == FNET_Info::ENDIAN_BIG);
-        _req->GetReturn()->EncodeBig(dst);
+        _req->GetReturn()->EncodeBig(dst, sink);
     }
 }
 
@@ -44,6 +44,14 @@ public:
     bool LittleEndian() { return (_flags & FLAG_FRT_RPC_LITTLE_ENDIAN) != 0; }
     bool NoReply() { return (_flags & FLAG_FRT_RPC_NOREPLY) != 0; }
 
+    /**
+     * Payload may only be referenced after encoding when this packet
+     * keeps the request alive until it is freed.
+     **/
+    FNET_IExternalDataSink *ExternalDataSink(FNET_IExternalDataSink &sink) {
+        return _ownsRef ? &sink : nullptr;
+    }
+
     ~FRT_RPCPacket();
     void Free() override;
 };
@@ -60,8 +68,11 @@ public:
     uint32_t GetPCODE() override;
     uint32_t GetLength() override;
     void Encode(FNET_DataBuffer *dst) override;
+    void EncodeExternal(FNET_DataBuffer *dst, FNET_IExternalDataSink &sink) override;
     bool Decode(FNET_DataBuffer *src, uint32_t len) override;
     vespalib::string Print(uint32_t indent = 0) override;
+private:
+    void encode(FNET_DataBuffer *dst, FNET_IExternalDataSink *sink);
 };
 
 
@@ -76,8 +87,11 @@ public:
     uint32_t GetPCODE() override;
     uint32_t GetLength() override;
     void Encode(FNET_DataBuffer *dst) override;
+    void EncodeExternal(FNET_DataBuffer *dst, FNET_IExternalDataSink &sink) override;
     bool Decode(FNET_DataBuffer *src, uint32_t len) override;
     vespalib::string Print(uint32_t indent = 0) override;
+private:
+    void encode(FNET_DataBuffer *dst, FNET_IExternalDataSink *sink);
 };
 
 
@@ -20,7 +20,9 @@ FRT_Supervisor::FRT_Supervisor(FNET_Transport *transport,
       _reflectionManager(),
       _rpcHooks(&_reflectionManager),
       _connHooks(*this),
-      _methodMismatchHook(nullptr)
+      _methodMismatchHook(nullptr),
+      _compressionLevel(0),
+      _compressionHooks(*this)
 {
     _rpcHooks.InitRPC(this);
 }
@@ -37,7 +39,9 @@ FRT_Supervisor::FRT_Supervisor(uint32_t threadStackSize,
       _reflectionManager(),
       _rpcHooks(&_reflectionManager),
       _connHooks(*this),
-      _methodMismatchHook(nullptr)
+      _methodMismatchHook(nullptr),
+      _compressionLevel(0),
+      _compressionHooks(*this)
 {
     _transport = new FNET_Transport();
     assert(_transport != nullptr);
@@ -110,8 +114,10 @@ FRT_Target *
 FRT_Supervisor::GetTarget(const char *spec)
 {
     FNET_TransportThread *thread = _transport->select_thread(spec, strlen(spec));
-    return new FRT_Target(thread->GetScheduler(),
-                          thread->Connect(spec, &_packetStreamer));
+    FRT_Target *target = new FRT_Target(thread->GetScheduler(),
+                                        thread->Connect(spec, &_packetStreamer));
+    NegotiateCompression(target);
+    return target;
 }
 
 
@@ -119,10 +125,42 @@ FRT_Target *
 FRT_Supervisor::Get2WayTarget(const char *spec, FNET_Context connContext)
 {
     FNET_TransportThread *thread = _transport->select_thread(spec, strlen(spec));
-    return new FRT_Target(thread->GetScheduler(),
-                          thread->Connect(spec, &_packetStreamer,
-                                  nullptr, FNET_Context(),
-                                  this, connContext));
+    FRT_Target *target = new FRT_Target(thread->GetScheduler(),
+                                        thread->Connect(spec, &_packetStreamer,
+                                                nullptr, FNET_Context(),
+                                                this, connContext));
+    NegotiateCompression(target);
+    return target;
+}
+
+
+void
+FRT_Supervisor::NegotiateCompression(FRT_Target *target)
+{
+    FNET_Connection *conn = target->GetConnection();
+    if (_compressionLevel == 0 || conn == nullptr) {
+        return;
+    }
+    FRT_RPCRequest *req = AllocRPCRequest();
+    req->SetMethodName("frt.rpc.negotiateCompression");
+    req->GetParams()->AddString("zstd");
+    conn->AddRef();
+    req->SetContext(FNET_Context((void *) conn));
+    target->InvokeAsync(req, 60.0, &_compressionHooks);
+}
+
+
+void
+FRT_Supervisor::CompressionHooks::RequestDone(FRT_RPCRequest *req)
+{
+    FNET_Connection *conn = (FNET_Connection *) req->GetContext()._value.VOIDP;
+    if (!req->IsError() && req->CheckReturnTypes("s") &&
+        strcmp(req->GetReturn()->GetValue(0)._string._str, "zstd") == 0)
+    {
+        conn->EnableOutputCompression(_parent._compressionLevel);
+    }
+    conn->SubRef();
+    req->SubRef();
 }
 
 
@@ -379,6 +417,14 @@ FRT_Supervisor::RPCHooks::InitRPC(FRT_Supervisor *supervisor)
     rb.ReturnDesc("returnNames", "Method return value names");
     rb.ReturnDesc("returnDesc",  "Method return value descriptions");
     //---------------------------------------------------------------------------
+    rb.DefineMethod("frt.rpc.negotiateCompression", "s", "s", true,
+                    FRT_METHOD(FRT_Supervisor::RPCHooks::RPC_NegotiateCompression),
+                    this);
+    rb.MethodDesc("Negotiate streaming compression of this connection");
+    rb.ParamDesc ("algorithms", "Comma separated list of algorithms supported by the client");
+    rb.ReturnDesc("algorithm",  "Algorithm used by both sides, or empty if none");
+    //---------------------------------------------------------------------------
+    _supervisor = supervisor;
 }
 
 
@@ -389,6 +435,29 @@ FRT_Supervisor::RPCHooks::RPC_Ping(FRT_RPCRequest *req)
 }
 
 
+void
+FRT_Supervisor::RPCHooks::RPC_NegotiateCompression(FRT_RPCRequest *req)
+{
+    vespalib::stringref algorithms(req->GetParams()->GetValue(0)._string._str,
+                                   req->GetParams()->GetValue(0)._string._len);
+    FNET_Connection *conn = req->GetConnection();
+    bool supported = false;
+    for (size_t pos = 0; pos != vespalib::stringref::npos && !supported; ) {
+        size_t end = algorithms.find(',', pos);
+        supported = (algorithms.substr(pos, end - pos) == "zstd");
+        pos = (end == vespalib::stringref::npos) ? end : end + 1;
+    }
+    if (supported && conn != nullptr && _supervisor->GetCompressionLevel() != 0) {
+        // The client accepts compressed input before asking, so the
+        // reply to this request may already be compressed.
+        conn->EnableOutputCompression(_supervisor->GetCompressionLevel());
+        req->GetReturn()->AddString("zstd");
+    } else {
+        req->GetReturn()->AddString("");
+    }
+}
+
+
 void
 FRT_Supervisor::RPCHooks::RPC_Echo(FRT_RPCRequest *req)
 {
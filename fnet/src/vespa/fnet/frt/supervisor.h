@@ -3,6 +3,7 @@
 #pragma once
 
 #include "invokable.h"
+#include "invoker.h"
 #include "packets.h"
 #include "reflection.h"
 #include <vespa/fnet/iserveradapter.h>
@@ -25,19 +26,38 @@ public:
     {
     private:
         FRT_ReflectionManager *_reflectionManager;
+        FRT_Supervisor        *_supervisor;
 
         RPCHooks(const RPCHooks &);
         RPCHooks &operator=(const RPCHooks &);
 
     public:
         RPCHooks(FRT_ReflectionManager *reflect)
-            : _reflectionManager(reflect) {}
+            : _reflectionManager(reflect), _supervisor(nullptr) {}
 
         void InitRPC(FRT_Supervisor *supervisor);
         void RPC_Ping(FRT_RPCRequest *req);
         void RPC_Echo(FRT_RPCRequest *req);
         void RPC_GetMethodList(FRT_RPCRequest *req);
         void RPC_GetMethodInfo(FRT_RPCRequest *req);
+        void RPC_NegotiateCompression(FRT_RPCRequest *req);
+    };
+
+    /**
+     * Handles the reply to compression negotiation on connections
+     * created by this supervisor.
+     **/
+    class CompressionHooks : public FRT_IRequestWait
+    {
+    private:
+        FRT_Supervisor &_parent;
+
+        CompressionHooks(const CompressionHooks &);
+        CompressionHooks &operator=(const CompressionHooks &);
+
+    public:
+        CompressionHooks(FRT_Supervisor &parent) : _parent(parent) {}
+        void RequestDone(FRT_RPCRequest *req) override;
     };
 
     class ConnHooks : public FNET_IConnectionCleanupHandler,
@@ -77,10 +97,14 @@ private:
     RPCHooks                   _rpcHooks;
     ConnHooks                  _connHooks;
     FRT_Method                *_methodMismatchHook;
+    int                        _compressionLevel;
+    CompressionHooks           _compressionHooks;
 
     FRT_Supervisor(const FRT_Supervisor &);
     FRT_Supervisor &operator=(const FRT_Supervisor &);
 
+    void NegotiateCompression(FRT_Target *target);
+
 public:
     FRT_Supervisor(FNET_Transport *transport,
                    FastOS_ThreadPool *threadPool);
@@ -106,6 +130,19 @@ public:
     FRT_Target *GetTarget(int port);
     FRT_RPCRequest *AllocRPCRequest(FRT_RPCRequest *tradein = nullptr);
 
+    /**
+     * Enable streaming zstd compression of connections with the given
+     * compression level, or disable it with level 0. Connections
+     * created by GetTarget negotiate compression with the server when
+     * they are created, and each side compresses its output when both
+     * sides have compression enabled. Connections already created are
+     * not affected. Compression is disabled by default.
+     *
+     * @param level zstd compression level
+     **/
+    void SetCompressionLevel(int level) { _compressionLevel = level; }
+    int GetCompressionLevel() const { return _compressionLevel; }
+
     // special hooks (implemented as RPC methods)
     void SetSessionInitHook(FRT_METHOD_PT  method, FRT_Invokable *handler);
     void SetSessionDownHook(FRT_METHOD_PT  method, FRT_Invokable *handler);
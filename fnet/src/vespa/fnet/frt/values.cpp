@@ -2,6 +2,7 @@
 
 #include "values.h"
 #include <vespa/fnet/databuffer.h>
+#include <vespa/fnet/iexternaldatasink.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <cassert>
 
@@ -24,6 +25,14 @@ char * copyData(char *dst, const void *src, size_t len) {
     return dst;
 }
 
+void encodeData(FNET_DataBuffer *dst, FNET_IExternalDataSink *sink, const FRT_DataValue &value) {
+    if ((sink != nullptr) && (value._len >= FRT_Values::EXTERNAL_DATA_LIMIT)) {
+        sink->AddExternalData(value._buf, value._len);
+    } else {
+        dst->WriteBytesFast(value._buf, value._len);
+    }
+}
+
 using vespalib::alloc::Alloc;
 class LocalBlob : public FRT_ISharedBlob
 {
@@ -70,6 +79,7 @@ private:
 }
 
 using fnet::BlobRef;
+using fnet::encodeData;
 using fnet::LocalBlob;
 
 FRT_Values::FRT_Values(Stash &stash)
@@ -1223,7 +1233,7 @@ error:
 
 
 void
-FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
+FRT_Values::EncodeCopy(FNET_DataBuffer *dst, FNET_IExternalDataSink *sink)
 {
     uint32_t numValues = _numValues;
     const char *p = _typeString;
@@ -1340,8 +1350,7 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
 
         case FRT_VALUE_DATA:
             dst->WriteBytesFast(&(_values[i]._data._len), sizeof(uint32_t));
-            dst->WriteBytesFast(_values[i]._data._buf,
-                                _values[i]._data._len);
+            encodeData(dst, sink, _values[i]._data);
             break;
 
         case FRT_VALUE_DATA_ARRAY:
@@ -1365,7 +1374,7 @@ FRT_Values::EncodeCopy(FNET_DataBuffer *dst)
 
 
 void
-FRT_Values::EncodeBig(FNET_DataBuffer *dst)
+FRT_Values::EncodeBig(FNET_DataBuffer *dst, FNET_IExternalDataSink *sink)
 {
     uint32_t numValues = _numValues;
     const char *p = _typeString;
@@ -1487,8 +1496,7 @@ FRT_Values::EncodeBig(FNET_DataBuffer *dst)
 
         case FRT_VALUE_DATA:
             dst->WriteInt32Fast(_values[i]._data._len);
-            dst->WriteBytesFast(_values[i]._data._buf,
-                                _values[i]._data._len);
+            encodeData(dst, sink, _values[i]._data);
             break;
 
         case FRT_VALUE_DATA_ARRAY:
@@ -12,6 +12,7 @@ namespace fnet {
     class BlobRef;
 }
 class FNET_DataBuffer;
+class FNET_IExternalDataSink;
 
 template <typename T>
 struct FRT_Array {
@@ -237,8 +238,14 @@ public:
     bool DecodeCopy(FNET_DataBuffer *dst, uint32_t len);
     bool DecodeBig(FNET_DataBuffer *dst, uint32_t len);
     bool DecodeLittle(FNET_DataBuffer *dst, uint32_t len);
-    void EncodeCopy(FNET_DataBuffer *dst);
-    void EncodeBig(FNET_DataBuffer *dst);
+    /**
+     * Data values of at least this size are handed over to the
+     * external data sink given when encoding, instead of being copied.
+     **/
+    static constexpr uint32_t EXTERNAL_DATA_LIMIT = 16 * 1024;
+
+    void EncodeCopy(FNET_DataBuffer *dst, FNET_IExternalDataSink *sink = nullptr);
+    void EncodeBig(FNET_DataBuffer *dst, FNET_IExternalDataSink *sink = nullptr);
     bool Equals(FRT_Values *values);
     static void Print(FRT_Value value, uint32_t type, uint32_t indent = 0);
     static bool Equals(FRT_Value a, FRT_Value b, uint32_t type);
@@ -0,0 +1,26 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Interface used when encoding packets to hand over large payload
+ * regions by reference instead of copying them into the output
+ * buffer. A region added to the sink is logically appended to the
+ * target databuffer at the point where it is added. The memory must
+ * stay valid until the packet that added it has been freed.
+ **/
+class FNET_IExternalDataSink
+{
+public:
+    virtual ~FNET_IExternalDataSink() {}
+
+    /**
+     * Add an external memory region to the encoded byte stream.
+     *
+     * @param data start of the region
+     * @param len number of bytes in the region
+     **/
+    virtual void AddExternalData(const char *data, uint32_t len) = 0;
+};
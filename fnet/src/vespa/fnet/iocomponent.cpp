@@ -2,6 +2,7 @@
 
 #include "iocomponent.h"
 #include "transport_thread.h"
+#include "transport.h"
 #include <cassert>
 #include <cstring>
 
@@ -13,6 +14,7 @@ FNET_IOComponent::FNET_IOComponent(FNET_TransportThread *owner,
       _ioc_prev(nullptr),
       _ioc_owner(owner),
       _ioc_counters(_ioc_owner->GetStatCounters()),
+      _ioc_metrics(&_ioc_owner->owner().GetMetrics()),
       _ioc_socket_fd(socket_fd),
       _ioc_selector(nullptr),
       _ioc_spec(nullptr),
@@ -119,6 +121,9 @@ FNET_IOComponent::detach_selector()
 void
 FNET_IOComponent::EnableReadEvent(bool enabled)
 {
+    if (_flags._ioc_readEnabled == enabled) {
+        return;
+    }
     _flags._ioc_readEnabled = enabled;
     if (_ioc_selector != nullptr) {
         _ioc_selector->update(_ioc_socket_fd, *this, _flags._ioc_readEnabled, _flags._ioc_writeEnabled);
@@ -129,6 +134,9 @@ FNET_IOComponent::EnableReadEvent(bool enabled)
 void
 FNET_IOComponent::EnableWriteEvent(bool enabled)
 {
+    if (_flags._ioc_writeEnabled == enabled) {
+        return;
+    }
     _flags._ioc_writeEnabled = enabled;
     if (_ioc_selector != nullptr) {
         _ioc_selector->update(_ioc_socket_fd, *this, _flags._ioc_readEnabled, _flags._ioc_writeEnabled);
@@ -136,6 +144,14 @@ FNET_IOComponent::EnableWriteEvent(bool enabled)
 }
 
 
+bool
+FNET_IOComponent::flush_writes()
+{
+    EnableWriteEvent(true);
+    return true;
+}
+
+
 bool
 FNET_IOComponent::handle_add_event()
 {
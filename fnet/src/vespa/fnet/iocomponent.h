@@ -46,6 +46,7 @@ protected:
     FNET_IOComponent        *_ioc_prev;          // prev in list
     FNET_TransportThread    *_ioc_owner;         // owner(TransportThread) ref.
     FNET_StatCounters       *_ioc_counters;      // stat counters
+    FNET_TransportMetrics   *_ioc_metrics;       // transport metrics
     int                      _ioc_socket_fd;     // source of events.
     Selector                *_ioc_selector;      // attached event selector
     char                    *_ioc_spec;          // connect/listen spec
@@ -212,6 +213,29 @@ public:
     { _ioc_counters->CountDataWrite(bytes); }
 
 
+    /**
+     * Count a completed read event in the metrics of the owning
+     * transport object. May be called from any thread.
+     *
+     * @param packets the number of packets read.
+     * @param bytes the number of bytes read.
+     **/
+    void CountReadEvent(uint32_t packets, uint32_t bytes)
+    { _ioc_metrics->CountRead(packets, bytes); }
+
+
+    /**
+     * Count a completed write event in the metrics of the owning
+     * transport object. May be called from any thread, so it is also
+     * used for direct writes.
+     *
+     * @param packets the number of packets written.
+     * @param bytes the number of bytes written.
+     **/
+    void CountWriteEvent(uint32_t packets, uint32_t bytes)
+    { _ioc_metrics->CountWrite(packets, bytes); }
+
+
     /**
      * Count direct written data. This method will increase an
      * internal counter. The shared stat counters may not be used
@@ -321,5 +345,17 @@ public:
      * @return false if broken, true otherwise.
      **/
     virtual bool HandleWriteEvent() = 0;
+
+
+    /**
+     * Called by the transport thread when batched writes are enabled
+     * and this component has asked for write events. Pending output
+     * should be written right away, and write events should only be
+     * enabled if the output could not be written in full. The default
+     * implementation simply enables write events.
+     *
+     * @return false if broken, true otherwise.
+     **/
+    virtual bool flush_writes();
 };
 
@@ -5,6 +5,7 @@
 #include "context.h"
 
 class FNET_DataBuffer;
+class FNET_IExternalDataSink;
 class FNET_Packet;
 
 /**
@@ -81,5 +82,24 @@ public:
      **/
     virtual void Encode(FNET_Packet *packet, uint32_t chid,
                         FNET_DataBuffer *dst) = 0;
+
+    /**
+     * This method is called to stream a packet to the given databuffer,
+     * allowing large payload regions to be handed over to the given
+     * sink instead of being copied. See @ref
+     * FNET_Packet::EncodeExternal. The default implementation streams
+     * the entire packet into the databuffer.
+     *
+     * @param packet the packet to stream
+     * @param chid channel id for packet
+     * @param dst the target buffer for streaming
+     * @param sink receiver of external payload regions
+     **/
+    virtual void EncodeExternal(FNET_Packet *packet, uint32_t chid,
+                                FNET_DataBuffer *dst, FNET_IExternalDataSink &sink)
+    {
+        (void) sink;
+        Encode(packet, chid, dst);
+    }
 };
 
@@ -0,0 +1,41 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "local_shortcut.h"
+#include <vespa/vespalib/net/socket_address.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <vector>
+
+namespace fnet {
+
+namespace {
+
+std::vector<vespalib::string> find_local_ip_addresses() {
+    std::vector<vespalib::string> result;
+    for (const auto &addr: vespalib::SocketAddress::get_interfaces()) {
+        result.push_back(addr.ip_address());
+    }
+    return result;
+}
+
+} // namespace fnet::<unnamed>
+
+vespalib::string
+LocalShortcut::name(int port)
+{
+    return vespalib::make_string("fnet-local-shortcut-%d", port);
+}
+
+bool
+LocalShortcut::is_local(const vespalib::SocketAddress &addr)
+{
+    if (!addr.is_ipv4() && !addr.is_ipv6()) {
+        return false;
+    }
+    static const std::vector<vespalib::string> local_ips = find_local_ip_addresses();
+    vespalib::string ip = addr.ip_address();
+    return ((ip == "127.0.0.1") || (ip == "::1") ||
+            (std::find(local_ips.begin(), local_ips.end(), ip) != local_ips.end()));
+}
+
+}
@@ -0,0 +1,35 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+
+namespace vespalib { class SocketAddress; }
+
+namespace fnet {
+
+/**
+ * Helper used to bypass the TCP stack for connections between
+ * processes on the same host. When enabled, a transport listening on
+ * a tcp port also listens on an abstract unix domain socket named
+ * after that port, and a transport connecting to a tcp address that
+ * belongs to this host tries that unix domain socket first, falling
+ * back to tcp if nobody is listening on it.
+ **/
+class LocalShortcut {
+private:
+    LocalShortcut() = delete;
+public:
+    /**
+     * The name of the unix domain socket used as a shortcut for the
+     * given tcp port.
+     **/
+    static vespalib::string name(int port);
+
+    /**
+     * Check whether the given address is an ip address of this host.
+     **/
+    static bool is_local(const vespalib::SocketAddress &addr);
+};
+
+}
@@ -5,6 +5,7 @@
 #include <vespa/vespalib/stllike/string.h>
 
 class FNET_DataBuffer;
+class FNET_IExternalDataSink;
 
 /**
  * This is a general superclass of all packets. Packets are used to
@@ -136,6 +137,22 @@ public:
     virtual void Encode(FNET_DataBuffer *dst) = 0;
 
 
+    /**
+     * Encode this packet into a DataBuffer, handing large payload
+     * regions over to the given sink instead of copying them. Regions
+     * given to the sink must stay valid until this packet is freed.
+     * The default implementation encodes the entire packet into the
+     * DataBuffer.
+     *
+     * @param dst the target databuffer
+     * @param sink receiver of external payload regions
+     **/
+    virtual void EncodeExternal(FNET_DataBuffer *dst, FNET_IExternalDataSink &sink) {
+        (void) sink;
+        Encode(dst);
+    }
+
+
     /**
      * Decode data from the given DataBuffer and store that information
      * in this object. This method may only be called on regular
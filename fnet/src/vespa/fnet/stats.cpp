@@ -36,6 +36,23 @@ FNET_StatCounters::Clear()
 
 //-----------------------------------------------
 
+FNET_TransportMetrics::FNET_TransportMetrics()
+    : _packetsRead(std::make_shared<vespalib::ShardedCounter>()),
+      _packetsWritten(std::make_shared<vespalib::ShardedCounter>()),
+      _bytesRead(std::make_shared<vespalib::ShardedCounter>()),
+      _bytesWritten(std::make_shared<vespalib::ShardedCounter>()),
+      _readSize(std::make_shared<vespalib::ShardedHistogram>()),
+      _writeSize(std::make_shared<vespalib::ShardedHistogram>())
+{
+}
+
+
+FNET_TransportMetrics::~FNET_TransportMetrics()
+{
+}
+
+//-----------------------------------------------
+
 FNET_Stats::FNET_Stats()
     : _eventLoopRate(0),
       _eventRate(0),
@@ -3,6 +3,9 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <vespa/vespalib/util/sharded_counter.h>
+#include <vespa/vespalib/util/sharded_histogram.h>
 
 /**
  * This class is used internally by @ref FNET_Transport objects to
@@ -35,6 +38,42 @@ public:
 
 //-----------------------------------------------
 
+/**
+ * Cumulative metrics for all threads in a @ref FNET_Transport
+ * object. Unlike @ref FNET_StatCounters these may be updated from any
+ * thread without locking, and are never reset. They are meant to be
+ * attached to a metrics manager, which takes care of computing rates
+ * and percentiles; obtain them by invoking the GetMetrics method on
+ * the transport object.
+ **/
+class FNET_TransportMetrics
+{
+public:
+    std::shared_ptr<vespalib::ShardedCounter>   _packetsRead;
+    std::shared_ptr<vespalib::ShardedCounter>   _packetsWritten;
+    std::shared_ptr<vespalib::ShardedCounter>   _bytesRead;
+    std::shared_ptr<vespalib::ShardedCounter>   _bytesWritten;
+    std::shared_ptr<vespalib::ShardedHistogram> _readSize;  // bytes per read event
+    std::shared_ptr<vespalib::ShardedHistogram> _writeSize; // bytes per write event
+
+    FNET_TransportMetrics();
+    ~FNET_TransportMetrics();
+
+    void CountRead(uint32_t packets, uint32_t bytes)
+    {
+        _packetsRead->add(packets);
+        _bytesRead->add(bytes);
+        _readSize->record(bytes);
+    }
+    void CountWrite(uint32_t packets, uint32_t bytes)
+    {
+        _packetsWritten->add(packets);
+        _bytesWritten->add(bytes);
+        _writeSize->record(bytes);
+    }
+};
+
+
 #define FNET_STATS_OLD_FACTOR 0.5
 #define FNET_STATS_NEW_FACTOR 0.5
 
@@ -24,6 +24,7 @@ struct HashState {
 
 FNET_Transport::FNET_Transport(vespalib::AsyncResolver::SP resolver, size_t num_threads)
     : _async_resolver(std::move(resolver)),
+      _metrics(),
       _threads()
 {
     assert(num_threads >= 1);
@@ -112,6 +113,14 @@ FNET_Transport::SetDirectWrite(bool directWrite)
     }
 }
 
+void
+FNET_Transport::SetBatchedWrite(bool batchedWrite)
+{
+    for (const auto &thread: _threads) {
+        thread->SetBatchedWrite(batchedWrite);
+    }
+}
+
 void
 FNET_Transport::SetTCPNoDelay(bool noDelay)
 {
@@ -120,6 +129,14 @@ FNET_Transport::SetTCPNoDelay(bool noDelay)
     }
 }
 
+void
+FNET_Transport::SetLocalShortcut(bool localShortcut)
+{
+    for (const auto &thread: _threads) {
+        thread->SetLocalShortcut(localShortcut);
+    }
+}
+
 void
 FNET_Transport::SetLogStats(bool logStats)
 {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "context.h"
+#include "stats.h"
 #include <memory>
 #include <vector>
 #include <vespa/vespalib/net/async_resolver.h>
@@ -28,6 +29,7 @@ private:
     using Threads = std::vector<Thread>;
 
     vespalib::AsyncResolver::SP _async_resolver;
+    FNET_TransportMetrics _metrics;
     Threads _threads;
 
 public:
@@ -56,6 +58,14 @@ public:
     void resolve_async(const vespalib::string &spec,
                        vespalib::AsyncResolver::ResultHandler::WP result_handler);
 
+    /**
+     * Obtain the cumulative metrics for all threads in this
+     * transport. Each metric may be attached to a metrics manager.
+     *
+     * @return transport metrics
+     **/
+    FNET_TransportMetrics &GetMetrics() { return _metrics; }
+
     /**
      * Select one of the underlying transport threads. The selection
      * is based on hashing the given key as well as the current stack
@@ -172,6 +182,17 @@ public:
      **/
     void SetDirectWrite(bool directWrite);
 
+    /**
+     * Enable or disable batched writes. When enabled, pending output
+     * is written by the transport threads once per event loop
+     * iteration instead of waiting for write events, which saves
+     * syscalls when direct write is disabled. This is disabled by
+     * default.
+     *
+     * @param batchedWrite enable batched write?
+     **/
+    void SetBatchedWrite(bool batchedWrite);
+
     /**
      * Enable or disable use of the TCP_NODELAY flag with sockets
      * created by this transport object.
@@ -180,6 +201,19 @@ public:
      **/
     void SetTCPNoDelay(bool noDelay);
 
+    /**
+     * Enable or disable the local shortcut. When enabled, listening
+     * on a tcp port will also listen on a unix domain socket named
+     * after the port, and connecting to a tcp address on this host
+     * will use that unix domain socket when available. This avoids
+     * the overhead of loopback tcp between co-located processes. Both
+     * endpoints need the shortcut enabled for it to be used. This is
+     * disabled by default.
+     *
+     * @param localShortcut enable local shortcut?
+     **/
+    void SetLocalShortcut(bool localShortcut);
+
     /**
      * Enable or disable logging of FNET statistics. This feature is
      * disabled by default.
@@ -7,6 +7,7 @@
 #include "connector.h"
 #include "connection.h"
 #include "transport.h"
+#include "local_shortcut.h"
 #include <vespa/vespalib/util/sync.h>
 #include <vespa/vespalib/net/socket_spec.h>
 #include <vespa/vespalib/net/server_socket.h>
@@ -220,6 +221,7 @@ FNET_TransportThread::FNET_TransportThread(FNET_Transport &owner_in)
       _componentCnt(0),
       _deleteList(nullptr),
       _selector(),
+      _flushList(),
       _queue(),
       _myQueue(),
       _lock(),
@@ -261,11 +263,15 @@ FNET_Connector*
 FNET_TransportThread::Listen(const char *spec, FNET_IPacketStreamer *streamer,
                              FNET_IServerAdapter *serverAdapter)
 {
-    ServerSocket server_socket{SocketSpec(spec)};
+    SocketSpec socket_spec(spec);
+    ServerSocket server_socket{socket_spec};
     if (server_socket.valid() && server_socket.set_blocking(false)) {
         FNET_Connector *connector = new FNET_Connector(this, streamer, serverAdapter, spec, std::move(server_socket));
         connector->EnableReadEvent(true);
         connector->AddRef_NoLock();
+        if (_config._localShortcut && socket_spec.path().empty() && socket_spec.name().empty()) {
+            ListenShortcut(*connector, streamer, serverAdapter);
+        }
         Add(connector, /* needRef = */ false);
         return connector;
     }
@@ -273,6 +279,26 @@ FNET_TransportThread::Listen(const char *spec, FNET_IPacketStreamer *streamer,
 }
 
 
+void
+FNET_TransportThread::ListenShortcut(FNET_Connector &connector, FNET_IPacketStreamer *streamer,
+                                     FNET_IServerAdapter *serverAdapter)
+{
+    SocketSpec socket_spec = SocketSpec::from_name(fnet::LocalShortcut::name(connector.GetPortNumber()));
+    ServerSocket server_socket{socket_spec};
+    if (server_socket.valid() && server_socket.set_blocking(false)) {
+        FNET_Connector *shortcut = new FNET_Connector(this, streamer, serverAdapter, socket_spec.spec().c_str(),
+                                                      std::move(server_socket));
+        shortcut->EnableReadEvent(true);
+        shortcut->AddRef_NoLock();
+        Add(shortcut, /* needRef = */ false);
+        connector.SetShortcut(shortcut);
+    } else {
+        LOG(debug, "Listen(%s): unable to listen on local shortcut '%s', using tcp only",
+            connector.GetSpec(), socket_spec.spec().c_str());
+    }
+}
+
+
 FNET_Connection*
 FNET_TransportThread::Connect(const char *spec, FNET_IPacketStreamer *streamer,
                               FNET_IPacketHandler *adminHandler,
@@ -478,8 +504,12 @@ FNET_TransportThread::handle_wakeup()
             context._value.IOC->SubRef();
             break;
         case FNET_ControlPacket::FNET_CMD_IOC_ENABLE_WRITE:
-            context._value.IOC->EnableWriteEvent(true);
-            context._value.IOC->SubRef();
+            if (_config._batchedWrite) {
+                _flushList.push_back(context._value.IOC); // keep ref until flushed
+            } else {
+                context._value.IOC->EnableWriteEvent(true);
+                context._value.IOC->SubRef();
+            }
             break;
         case FNET_ControlPacket::FNET_CMD_IOC_DISABLE_WRITE:
             context._value.IOC->EnableWriteEvent(false);
@@ -498,6 +528,25 @@ FNET_TransportThread::handle_wakeup()
 }
 
 
+void
+FNET_TransportThread::flush_writes()
+{
+    for (FNET_IOComponent *comp : _flushList) {
+        if (comp->_flags._ioc_delete) {
+            // already closed
+        } else if (!comp->_flags._ioc_added) {
+            comp->EnableWriteEvent(true);
+        } else if (!comp->flush_writes()) {
+            RemoveComponent(comp);
+            comp->Close();
+            AddDeleteComponent(comp);
+        }
+        comp->SubRef();
+    }
+    _flushList.clear();
+}
+
+
 void
 FNET_TransportThread::handle_event(FNET_IOComponent &ctx, bool read, bool write)
 {
@@ -557,6 +606,9 @@ FNET_TransportThread::EventLoopIteration()
         CountIOEvent(_selector.num_events());
         _selector.dispatch(*this);
 
+        // write output from components posted to during this iteration
+        flush_writes();
+
         // handle IOC time-outs
         if (_config._iocTimeOut > 0) {
 
@@ -12,6 +12,7 @@
 #include <vespa/vespalib/net/socket_handle.h>
 #include <vespa/vespalib/net/selector.h>
 #include <mutex>
+#include <vector>
 #include <condition_variable>
 
 class FNET_Transport;
@@ -63,6 +64,7 @@ private:
     uint32_t                 _componentCnt;   // # of components
     FNET_IOComponent        *_deleteList;     // IOC delete list
     Selector                 _selector;       // I/O event generator
+    std::vector<FNET_IOComponent *> _flushList; // IOCs with batched writes
     FNET_PacketQueue_NoLock  _queue;          // outer event queue
     FNET_PacketQueue_NoLock  _myQueue;        // inner event queue
     std::mutex               _lock;           // used for synchronization
@@ -127,6 +129,13 @@ private:
     void FlushDeleteList();
 
 
+    /**
+     * Write pending output for all IO Components in the flush list
+     * (batched writes). Broken components are closed.
+     **/
+    void flush_writes();
+
+
     /**
      * Post an event (ControlPacket) on the transport thread event
      * queue. This is done to tell the transport thread that it needs to
@@ -207,6 +216,16 @@ private:
     FNET_Config *GetConfig() { return &_config; }
 
 
+    /**
+     * Listen on the local shortcut for the tcp port of the given
+     * connector, and attach the resulting connector to it. Failing to
+     * listen on the shortcut is not an error, as clients will fall
+     * back to tcp.
+     **/
+    void ListenShortcut(FNET_Connector &connector, FNET_IPacketStreamer *streamer,
+                        FNET_IServerAdapter *serverAdapter);
+
+
 public:
     /**
      * Construct a transport object. To activate your newly created
@@ -357,6 +376,22 @@ public:
     }
 
 
+    /**
+     * Enable or disable batched writes. When enabled, connections
+     * asking for write events are instead flushed once per event loop
+     * iteration, after all I/O events have been handled. Write events
+     * are only enabled for connections that could not write all their
+     * output. This saves event registration syscalls and event loop
+     * round-trips when many packets are posted without direct write.
+     * This is disabled by default.
+     *
+     * @param batchedWrite enable batched write?
+     **/
+    void SetBatchedWrite(bool batchedWrite) {
+        _config._batchedWrite = batchedWrite;
+    }
+
+
     /**
      * Enable or disable use of the TCP_NODELAY flag with sockets
      * created by this transport object.
@@ -366,6 +401,22 @@ public:
     void SetTCPNoDelay(bool noDelay) { _config._tcpNoDelay = noDelay; }
 
 
+    /**
+     * Enable or disable the local shortcut. When enabled, listening
+     * on a tcp port will also listen on a unix domain socket named
+     * after the port, and connecting to a tcp address on this host
+     * will use that unix domain socket when available. This avoids
+     * the overhead of loopback tcp between co-located processes. Both
+     * endpoints need the shortcut enabled for it to be used. This is
+     * disabled by default.
+     *
+     * @param localShortcut enable local shortcut?
+     **/
+    void SetLocalShortcut(bool localShortcut) {
+        _config._localShortcut = localShortcut;
+    }
+
+
     /**
      * Enable or disable logging of FNET statistics. This feature is
      * disabled by default.
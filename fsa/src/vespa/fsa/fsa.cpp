@@ -95,6 +95,7 @@ FSA::FSA(const char *file, FileAccessMethod fam) :
   _state(NULL), _symbol(NULL), _size(0),
   _data(NULL), _data_size(0), _data_type(DATA_VARIABLE), _fixed_data_size(0),
   _has_perfect_hash(false),_perf_hash(NULL),
+  _transition(NULL),
   _start(0), _ok(false)
 {
   _ok = read(file, fam);
@@ -106,6 +107,7 @@ FSA::FSA(const std::string &file, FileAccessMethod fam) :
   _state(NULL), _symbol(NULL), _size(0),
   _data(NULL), _data_size(0), _data_type(DATA_VARIABLE), _fixed_data_size(0),
   _has_perfect_hash(false),_perf_hash(NULL),
+  _transition(NULL),
   _start(0), _ok(false)
 {
   _ok = read(file.c_str(), fam);
@@ -116,6 +118,7 @@ FSA::FSA(const std::string &file, FileAccessMethod fam) :
 
 FSA::~FSA()
 {
+  if(_transition!=NULL) free(_transition);
   if(_mmap_addr!=NULL && _mmap_addr!=MAP_FAILED){
     munmap(_mmap_addr,_mmap_length);
   }
@@ -134,6 +137,8 @@ void FSA::reset()
 {
   _version = 0;
   _serial = 0;
+  if(_transition!=NULL) free(_transition);
+  _transition=NULL;
   if(_mmap_addr!=NULL && _mmap_addr!=MAP_FAILED){
     munmap(_mmap_addr,_mmap_length);
   }
@@ -284,9 +289,29 @@ bool FSA::read(const char *file, FileAccessMethod fam)
     return false;
   }
 
+  packTransitions();
+
   return true;
 }
 // }}}
+// {{{ FSA::packTransitions()
+
+void FSA::packTransitions()
+{
+  if(_size==0 || _state==NULL || _symbol==NULL)
+    return;
+  for(uint32_t i=0;i<_size;i++){
+    if(_state[i]>0xffffff)
+      return;
+  }
+  _transition = (uint32_t*)malloc(_size*sizeof(uint32_t));
+  if(_transition==NULL)
+    return;
+  for(uint32_t i=0;i<_size;i++){
+    _transition[i] = (_state[i]<<8) | _symbol[i];
+  }
+}
+// }}}
 // {{{ FSA::revLookup()
 
 std::string FSA::revLookup(hash_t hash) const
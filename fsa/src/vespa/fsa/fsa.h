@@ -2050,10 +2050,22 @@ private:
   bool           _has_perfect_hash;      /**< Indicator of perfect hash present. */
   hash_t        *_perf_hash;             /**< Perfect hash table, if present.    */
 
+  uint32_t      *_transition;            /**< Packed state and symbol tables, if they fit. */
+
   state_t        _start;                 /**< Index of start state.              */
 
   bool           _ok;                    /**< Flag set if object initialization succeeded. */
 
+  /**
+   * @brief Build the packed transition table.
+   *
+   * Packs the state and symbol of each cell into one 32 bit word
+   * (state<<8|symbol), so a delta transition only touches one cache
+   * line instead of one in each table. Only done when all states fit
+   * in 24 bits, otherwise the separate tables are used.
+   */
+  void packTransitions();
+
 public:
 
   /**
@@ -2140,6 +2152,10 @@ public:
     // if(!fs)
     //  return 0;
     state_t nfs=fs+in;
+    if(_transition!=NULL){
+      uint32_t t=_transition[nfs];
+      return ((symbol_t)t==in) ? (t>>8) : 0;
+    }
     if(_symbol[nfs]==in)
       return _state[nfs];
     else
@@ -2283,8 +2299,10 @@ private:
     _data(d._data), _data_size(d._data_size), _data_type(d._data_type),
     _fixed_data_size(d._fixed_data_size),
     _has_perfect_hash(d._perf_hash!=NULL),_perf_hash(d._perf_hash),
+    _transition(NULL),
     _start(d._start)
   {
+    packTransitions();
   }
 
   /**
@@ -63,6 +63,8 @@ void AuxTest::init()
         &AuxTest::TestSpecialTokenRegistry;
     test_methods_["TestWhiteSpacePreserved"] =
         &AuxTest::TestWhiteSpacePreserved;
+    test_methods_["TestNoMatchingTerm"] =
+        &AuxTest::TestNoMatchingTerm;
 }
 
 
@@ -614,6 +616,30 @@ void AuxTest::TestEndHit()
 
 
 
+void AuxTest::TestNoMatchingTerm()
+{
+    juniper::QueryParser q("AND(match,text)");
+    juniper::QueryHandle qh(q, "dynlength.120", juniper::_Juniper->getModifier());
+    const char* contents[] = {
+        "There is no hit in this plain ascii content",
+        "Here the MATCH and the Text only differ in case",
+        "Ingen treff p\xc3\xa5 dette, men match finnes her",
+        "Ingen treff p\xc3\xa5 dette heller"
+    };
+    int expected_hits[] = { 0, 2, 1, 0 };
+
+    for (int i = 0; i < 4; i++) {
+        juniper::Result* res = juniper::Analyse(juniper::TestConfig, &qh,
+                contents[i], strlen(contents[i]), 0, 0, 0);
+        _test(res != NULL);
+        res->Scan();
+        _test(res->_matcher->TotalHits() == expected_hits[i]);
+        juniper::ReleaseResult(res);
+    }
+}
+
+
+
 class TokenChecker : public ITokenProcessor
 {
 private:
@@ -49,6 +49,7 @@ private:
     void TestLargeBlockChinese();
     void TestSpecialTokenRegistry();
     void TestWhiteSpacePreserved();
+    void TestNoMatchingTerm();
 
     bool assertChar(ucs4_t act, char exp);
 
@@ -102,6 +102,45 @@ Result::~Result()
 }
 
 
+/**
+ * Tokenizing the text is by far the most expensive part of matching,
+ * and is wasted when no query term occurs in it. For plain ASCII text
+ * every token is a (case folded) substring of the text, so when no
+ * query term is found as a substring there can be no matches, as a
+ * term only matches tokens starting with it. Other text, and queries
+ * with wildcards, reductions or special tokens, are always tokenized.
+ */
+bool Result::MayMatch() const
+{
+    if (_mo->HasReductions() || !_registry->getSpecialTokens().empty()) return true;
+    std::vector<std::string> terms;
+    terms.reserve(_mo->TermCount());
+    for (size_t i = 0; i < _mo->TermCount(); i++) {
+        QueryTerm* q = _mo->Term(i);
+        if (q->is_wildcard() || q->ucs4_len == 0) return true;
+        std::string term;
+        term.reserve(q->ucs4_len);
+        for (size_t j = 0; j < q->ucs4_len; j++) {
+            ucs4_t c = q->ucs4_term()[j];
+            if (c >= 0x80) return true;
+            term.push_back(tolower(c));
+        }
+        terms.push_back(std::move(term));
+    }
+    std::string text;
+    text.reserve(_docsum_len);
+    for (size_t i = 0; i < _docsum_len; i++) {
+        unsigned char c = _docsum[i];
+        if (c >= 0x80) return true;
+        text.push_back(tolower(c));
+    }
+    for (const std::string& term : terms) {
+        if (text.find(term) != std::string::npos) return true;
+    }
+    return false;
+}
+
+
 long Result::GetRelevancy()
 {
     if (!_mo) return PROXIMITYBOOST_NOCONSTRAINT_OFFSET;
@@ -23,7 +23,11 @@ public:
         if (!_scan_done)
         {
             _tokenizer->SetText(_docsum, _docsum_len);
-            _tokenizer->scan();
+            if (MayMatch()) {
+                _tokenizer->scan();
+            } else {
+                _tokenizer->skip_to_end();
+            }
             _scan_done = true;
         }
     }
@@ -47,6 +51,8 @@ public:
     std::unique_ptr<SpecialTokenRegistry> _registry;
     std::unique_ptr<JuniperTokenizer> _tokenizer;
 private:
+    bool MayMatch() const;
+
     std::vector<Summary*> _summaries; // Active summaries for this result
     bool _scan_done;  // State of the result - is text scan done?
 
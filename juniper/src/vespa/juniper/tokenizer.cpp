@@ -66,3 +66,13 @@ void JuniperTokenizer::scan()
     token.token = NULL;
     _successor->handle_end(token);
 }
+
+
+void JuniperTokenizer::skip_to_end()
+{
+    ITokenProcessor::Token token;
+    token.bytepos = _len;
+    token.bytelen = 0;
+    token.token = NULL;
+    _successor->handle_end(token);
+}
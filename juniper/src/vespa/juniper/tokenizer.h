@@ -21,6 +21,8 @@ public:
 
     // Scan the input and dispatch to the successor
     void scan();
+    // Only report the end of the input to the successor, for input known to hold no matches
+    void skip_to_end();
 private:
     Fast_WordFolder* _wordfolder;
     const char* _text;  // The current input text
@@ -43,6 +43,13 @@ ConfSub::configure(std::unique_ptr<LogdConfig> cfg)
         _needToConnect = true;
     }
     _statePort = newconf.stateport;
+    if (newconf.logserver.batchsize > 0) {
+        _fw.setBatchSize(newconf.logserver.batchsize);
+    } else {
+        LOG(config, "bad logserver.batchsize=%d must be positive",
+            newconf.logserver.batchsize);
+    }
+    _fw.setRateLimit(newconf.logserver.ratelimit);
 
     ForwardMap forwardMap;
     forwardMap[Logger::fatal] = newconf.loglevel.fatal.forward;
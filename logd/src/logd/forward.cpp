@@ -16,27 +16,49 @@ Forwarder::Forwarder(Metrics &metrics)
       _metrics(metrics),
       _forwardMap(),
       _levelparser(),
+      _pending(),
+      _batchSize(65536),
+      _rateLimit(0),
       knownServices(),
-      _badLines(0)
+      _badLines(0),
+      _droppedLines(0)
 {}
 Forwarder::~Forwarder() {}
 
 void
 Forwarder::forwardText(const char *text, int len)
 {
-    int wsize = write(_logserverfd, text, len);
-
-    if (wsize != len) {
+    int done = 0;
+    while (done < len) {
+        int wsize = write(_logserverfd, text + done, len - done);
         if (wsize > 0) {
-            LOG(warning, "only wrote %d of %d bytes to logserver", wsize, len);
+            done += wsize;
+        } else if (wsize < 0 && errno == EINTR) {
+            continue;
         } else {
-            LOG(warning, "problem sending data to logserver: %s", strerror(errno));
+            if (done > 0) {
+                LOG(warning, "only wrote %d of %d bytes to logserver", done, len);
+            } else {
+                LOG(warning, "problem sending data to logserver: %s", strerror(errno));
+            }
+            throw ConnectionException("problem sending data");
         }
-
-        throw ConnectionException("problem sending data");
     }
 }
 
+void
+Forwarder::flush()
+{
+    if (_pending.empty()) {
+        return;
+    }
+    // a failed batch is not kept, the watcher resumes from the last
+    // offset saved after a successful flush and reads it again
+    std::string batch;
+    batch.swap(_pending);
+    forwardText(batch.data(), batch.size());
+}
+
 void
 Forwarder::sendMode()
 {
@@ -61,7 +83,10 @@ Forwarder::forwardLine(const char *line, const char *eol)
     assert (line[linelen - 1] == '\n');
 
     if (parseline(line, eol)) {
-        forwardText(line, linelen);
+        _pending.append(line, linelen);
+        if (_pending.size() >= _batchSize) {
+            flush();
+        }
     }
 }
 
@@ -178,14 +203,28 @@ Forwarder::parseline(const char *linestart, const char *lineend)
     // Check overrides
     ForwardMap::iterator found = _forwardMap.find(l);
     if (found != _forwardMap.end()) {
-        return found->second;
+        if (!found->second) {
+            return false;
+        }
+        if (_rateLimit <= 0) {
+            return true;
+        }
     }
 
     Service *svcp = knownServices.getService(service.c_str());
     Component *cp = svcp->getComponent(component.c_str());
-    cp->remember(logtime, pid);
-    bool retval = cp->shouldForward(l);
-    return retval;
+    if (found == _forwardMap.end()) {
+        cp->remember(logtime, pid);
+        if (!cp->shouldForward(l)) {
+            return false;
+        }
+    }
+    if (_rateLimit > 0 && !cp->withinRate(logtime, _rateLimit)) {
+        _metrics.countDropped(service);
+        ++_droppedLines;
+        return false;
+    }
+    return true;
 }
 
 LogLevel
@@ -4,6 +4,7 @@
 #include "metrics.h"
 #include <vespa/vespalib/util/hashmap.h>
 #include <map>
+#include <string>
 
 namespace logdemon {
 
@@ -27,6 +28,9 @@ private:
     Metrics &_metrics;
     ForwardMap _forwardMap;
     LevelParser _levelparser;
+    std::string _pending;
+    size_t _batchSize;
+    int _rateLimit;
     const char *copystr(const char *b, const char *e) {
         int len = e - b;
         char *ret = new char[len+1];
@@ -38,12 +42,19 @@ private:
 public:
     Services knownServices;
     int _badLines;
+    int _droppedLines;
     Forwarder(Metrics &metrics);
     ~Forwarder();
     void forwardText(const char *text, int len);
+    // queues the line for the next batch, flushing when the batch is full
     void forwardLine(const char *line, const char *eol);
+    // writes all queued lines to the logserver
+    void flush();
+    size_t pendingBytes() const { return _pending.size(); }
+    void setBatchSize(size_t batchSize) { _batchSize = batchSize; }
+    void setRateLimit(int linesPerSecond) { _rateLimit = linesPerSecond; }
     void setForwardMap(const ForwardMap & forwardMap) { _forwardMap = forwardMap; }
-    void setLogserverFD(int fd) { _logserverfd = fd; }
+    void setLogserverFD(int fd) { _logserverfd = fd; _pending.clear(); }
     int  getLogserverFD() { return _logserverfd; }
     void sendMode();
 };
@@ -15,13 +15,16 @@ struct Metrics {
     const Dimension loglevel;
     const Dimension servicename;
     const Counter loglines;
+    const Counter droppedlines;
 
     Metrics(std::shared_ptr<MetricsManager> m)
         : metrics(m),
           loglevel(metrics->dimension("loglevel")),
           servicename(metrics->dimension("service")),
           loglines(metrics->counter("logd.processed.lines",
-                  "how many log lines have been processed"))
+                  "how many log lines have been processed")),
+          droppedlines(metrics->counter("logd.dropped.lines",
+                  "how many log lines were not forwarded due to rate limiting"))
     {}
 
     ~Metrics() {}
@@ -34,6 +37,13 @@ struct Metrics {
                   .bind(servicename, service);
         loglines.add(1, p);
     }
+
+    void countDropped(const vespalib::string &service) const
+    {
+        Point p = metrics->pointBuilder()
+                  .bind(servicename, service);
+        droppedlines.add(1, p);
+    }
 };
 
 } // namespace logdemon
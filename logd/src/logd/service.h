@@ -15,6 +15,8 @@ class Component
     unsigned long _isforwarding;
     double        _lastseen;
     int           _lastpid;
+    long          _window;
+    int           _windowLines;
     const char   *_myservice;
     char         *_myname;
     char         *_logctlname;
@@ -37,6 +39,7 @@ public:
     bool shouldLogAtAll(LogLevel level);
     Component(const char *servicename, const char *name)
         : _isforwarding(defFwd), _lastseen(0.0), _lastpid(0),
+          _window(0), _windowLines(0),
           _myservice(servicename), _myname(strdup(name)),
           _logctlname(strdup(name))
         {
@@ -50,6 +53,15 @@ public:
         }
     ~Component() { free(_myname); free(_logctlname); }
     void remember(double t, int p) { _lastseen = t; _lastpid = p; }
+    // counts a line logged at time t, false if over limit lines this second
+    bool withinRate(double t, int limit) {
+        long second = static_cast<long>(t);
+        if (second > _window) {
+            _window = second;
+            _windowLines = 0;
+        }
+        return (++_windowLines <= limit);
+    }
     double lastSeen() const { return _lastseen; }
     double lastPid() const  { return _lastpid; }
 };
@@ -10,6 +10,8 @@
 #include <glob.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <vespa/vespalib/util/sig_catch.h>
@@ -19,19 +21,15 @@ LOG_SETUP("");
 namespace logdemon {
 namespace {
 
-// wait until 1 second has passed since "start"
-void snooze(const struct timeval &start)
+long usecsSince(const struct timeval &start)
 {
-    struct timeval sincestart;
-    gettimeofday(&sincestart, 0);
-    // compute time elapsed since start:
-    sincestart.tv_sec  -= start.tv_sec;
-    sincestart.tv_usec -= start.tv_usec;
-
-    // how many microseconds to wait:
-    long wait_usecs = (1000000 - sincestart.tv_usec);
-    wait_usecs     -= (1000000 * sincestart.tv_sec);
+    struct timeval now;
+    gettimeofday(&now, 0);
+    return (1000000L * (now.tv_sec - start.tv_sec)) + (now.tv_usec - start.tv_usec);
+}
 
+void sleepUsecs(long wait_usecs)
+{
     if (wait_usecs <= 0) {
         // already used enough time, no sleep
         return;
@@ -48,6 +46,34 @@ void snooze(const struct timeval &start)
     }
 }
 
+// a tick lasts at least this long, so lines written in bursts are batched
+const long min_tick_usecs = 100000;
+
+// wait until 1 second has passed since "start", or less if notifyfd
+// reports activity in the log directory
+void snooze(const struct timeval &start, int notifyfd)
+{
+    if (notifyfd < 0) {
+        sleepUsecs(1000000 - usecsSince(start));
+        return;
+    }
+    sleepUsecs(min_tick_usecs - usecsSince(start));
+    long wait_usecs = 1000000 - usecsSince(start);
+    if (wait_usecs > 0) {
+        struct pollfd pfd;
+        pfd.fd = notifyfd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, (wait_usecs + 999) / 1000) < 0 && errno != EINTR) {
+            LOG(error, "poll on inotify fd failed: %s", strerror(errno));
+            throw SomethingBad("poll failed");
+        }
+    }
+    // only the wakeup matters, not the events themselves
+    char events[4096];
+    while (read(notifyfd, events, sizeof(events)) > 0) { }
+}
+
 int elapsed(struct timeval &start) {
     struct timeval now;
     gettimeofday(&now, 0);
@@ -66,12 +92,16 @@ Watcher::Watcher(ConfSub &cfs, Forwarder &fw)
     : _buffer(new char[bufsiz]),
       _confsubscriber(cfs),
       _forwarder(fw),
-      _wfd(-1)
+      _wfd(-1),
+      _notifyfd(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
 {
     if (_buffer == NULL) {
         LOG(error, "could not allocate 1MB memory");
         throw SomethingBad("out of memory");
     }
+    if (_notifyfd < 0) {
+        LOG(warning, "inotify_init1 failed, polling logfile every second: %s", strerror(errno));
+    }
 }
 
 Watcher::~Watcher()
@@ -81,6 +111,9 @@ Watcher::~Watcher()
         LOG(debug, "~Watcher closing %d", _wfd);
         close(_wfd);
     }
+    if (_notifyfd >= 0) {
+        close(_notifyfd);
+    }
 }
 
 
@@ -186,6 +219,20 @@ Watcher::watchfile()
         throw SomethingBad("too long filename in watchfile");
     }
 
+    if (_notifyfd >= 0) {
+        std::string dir(filename);
+        size_t slash = dir.rfind('/');
+        dir = (slash == std::string::npos) ? "." : dir.substr(0, slash + 1);
+        if (inotify_add_watch(_notifyfd, dir.c_str(),
+                              IN_MODIFY | IN_CREATE | IN_MOVED_FROM | IN_MOVED_TO) < 0)
+        {
+            LOG(warning, "cannot watch %s, polling logfile every second: %s",
+                dir.c_str(), strerror(errno));
+            close(_notifyfd);
+            _notifyfd = -1;
+        }
+    }
+
     ExternalPerformer performer(_forwarder, _forwarder.knownServices);
     CmdBuf cmdbuf;
 
@@ -272,6 +319,8 @@ Watcher::watchfile()
             }
         }
 
+        // the saved offset must not pass lines that were not yet sent
+        _forwarder.flush();
         already.offset = offset;
         already.st_dev = sb.st_dev;
         already.st_ino = sb.st_ino;
@@ -349,7 +398,7 @@ Watcher::watchfile()
         if (catcher.receivedStopSignal()) {
             throw SigTermException("caught signal");
         }
-        snooze(tickStart);
+        snooze(tickStart, _notifyfd);
         if (catcher.receivedStopSignal()) {
             throw SigTermException("caught signal");
         }
@@ -360,6 +409,12 @@ Watcher::watchfile()
                 _forwarder._badLines = 0;
                 sleepcount=0;
             }
+            if (_forwarder._droppedLines) {
+                LOG(warning, "dropped %d loglines over the rate limit",
+                    _forwarder._droppedLines);
+                _forwarder._droppedLines = 0;
+                sleepcount=0;
+            }
         }
     }
 }
@@ -9,6 +9,7 @@ private:
     ConfSub&   _confsubscriber;
     Forwarder& _forwarder;
     int _wfd;
+    int _notifyfd;
 
     Watcher(const Watcher& other);
     Watcher& operator=(const Watcher& other);
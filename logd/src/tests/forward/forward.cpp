@@ -37,16 +37,27 @@ struct ForwardFixture {
         return ss.str();
     }
 
-    void verifyForward(bool doForward) {
-        const std::string & line(logLine);
-        forwarder.forwardLine(line.c_str(), line.c_str() + line.length());
+    ssize_t forwardedBytes() {
         fsync(fd);
         int rfd = open(fname.c_str(), O_RDONLY);
-        char *buffer[2048];
-        ssize_t bytes = read(rfd, buffer, 2048);
-        ssize_t expected = doForward ? line.length() : 0;
-        EXPECT_EQUAL(expected, bytes);
+        char buffer[8192];
+        ssize_t bytes = read(rfd, buffer, sizeof(buffer));
         close(rfd);
+        return bytes;
+    }
+
+    void forwardLines(int count) {
+        const std::string & line(logLine);
+        for (int i = 0; i < count; ++i) {
+            forwarder.forwardLine(line.c_str(), line.c_str() + line.length());
+        }
+    }
+
+    void verifyForward(bool doForward) {
+        forwardLines(1);
+        forwarder.flush();
+        ssize_t expected = doForward ? logLine.length() : 0;
+        EXPECT_EQUAL(expected, forwardedBytes());
     }
 };
 
@@ -67,4 +78,31 @@ TEST_FF("require that forwarder does not forward if not set", Forwarder(m), Forw
     f2.verifyForward(false);
 }
 
+TEST_FF("require that forwarded lines are written in batches", Forwarder(m), ForwardFixture(f1, "forward.txt")) {
+    ForwardMap forwardMap;
+    forwardMap[Logger::event] = true;
+    f1.setForwardMap(forwardMap);
+    f1.setBatchSize(3 * f2.logLine.length());
+    f2.forwardLines(2);
+    EXPECT_EQUAL(2 * f2.logLine.length(), f1.pendingBytes());
+    EXPECT_EQUAL(0, f2.forwardedBytes());
+    f2.forwardLines(2);
+    EXPECT_EQUAL(f2.logLine.length(), f1.pendingBytes());
+    EXPECT_EQUAL(ssize_t(3 * f2.logLine.length()), f2.forwardedBytes());
+    f1.flush();
+    EXPECT_EQUAL(0u, f1.pendingBytes());
+    EXPECT_EQUAL(ssize_t(4 * f2.logLine.length()), f2.forwardedBytes());
+}
+
+TEST_FF("require that lines over the rate limit are dropped", Forwarder(m), ForwardFixture(f1, "forward.txt")) {
+    ForwardMap forwardMap;
+    forwardMap[Logger::event] = true;
+    f1.setForwardMap(forwardMap);
+    f1.setRateLimit(3);
+    f2.forwardLines(5);
+    f1.flush();
+    EXPECT_EQUAL(ssize_t(3 * f2.logLine.length()), f2.forwardedBytes());
+    EXPECT_EQUAL(2, f1._droppedLines);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,87 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/messagebus/messagebus.h>
+#include <vespa/messagebus/network/rpcnetworkparams.h>
+#include <vespa/messagebus/testlib/receptor.h>
+#include <vespa/messagebus/testlib/simplemessage.h>
+#include <vespa/messagebus/testlib/simplereply.h>
+#include <vespa/messagebus/testlib/simpleprotocol.h>
+#include <vespa/messagebus/testlib/slobrok.h>
+#include <vespa/messagebus/testlib/testserver.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <set>
+
+using namespace mbus;
+
+TEST_SETUP(Test);
+
+Message::UP
+createMessage(const string &value)
+{
+    Message::UP msg(new SimpleMessage(value));
+    msg->getTrace().setLevel(9);
+    return msg;
+}
+
+void
+sendAndReply(SourceSession &src, Receptor &srcHandler, DestinationSession &dst, Receptor &dstHandler,
+             uint32_t numMessages, const string &expectedTrace)
+{
+    std::set<string> expected;
+    for (uint32_t i = 0; i < numMessages; ++i) {
+        string value = vespalib::make_string("msg%u", i);
+        expected.insert("reply:" + value);
+        EXPECT_TRUE(src.send(createMessage(value), Route::parse("dst/session")).isAccepted());
+    }
+    std::vector<Message::UP> msgs;
+    for (uint32_t i = 0; i < numMessages; ++i) {
+        Message::UP msg = dstHandler.getMessage();
+        ASSERT_TRUE(msg.get() != nullptr);
+        msgs.push_back(std::move(msg));
+    }
+    // Reply in reverse order, so that replies must be matched to their messages.
+    while (!msgs.empty()) {
+        Message::UP msg = std::move(msgs.back());
+        msgs.pop_back();
+        Reply::UP reply(new SimpleReply("reply:" + static_cast<SimpleMessage&>(*msg).getValue()));
+        msg->swapState(*reply);
+        dst.reply(std::move(reply));
+    }
+    std::set<string> actual;
+    for (uint32_t i = 0; i < numMessages; ++i) {
+        Reply::UP reply = srcHandler.getReply();
+        ASSERT_TRUE(reply.get() != nullptr);
+        EXPECT_FALSE(reply->hasErrors());
+        EXPECT_EQUAL(SimpleProtocol::REPLY, reply->getType());
+        EXPECT_TRUE(reply->getTrace().toString().find(expectedTrace) != string::npos);
+        actual.insert(static_cast<SimpleReply&>(*reply).getValue());
+    }
+    EXPECT_TRUE(expected == actual);
+}
+
+int
+Test::Main()
+{
+    TEST_INIT("batching_test");
+
+    Slobrok slobrok;
+    TestServer srcServer(MessageBusParams().addProtocol(IProtocol::SP(new SimpleProtocol())),
+                         RPCNetworkParams().setSlobrokConfig(slobrok.config())
+                         .setBatchWindowSecs(1.0).setMaxBatchSize(4));
+    TestServer dstServer(MessageBusParams().addProtocol(IProtocol::SP(new SimpleProtocol())),
+                         RPCNetworkParams().setIdentity(Identity("dst")).setSlobrokConfig(slobrok.config()));
+    Receptor srcHandler;
+    Receptor dstHandler;
+    SourceSession::UP src = srcServer.mb.createSourceSession(SourceSessionParams().setReplyHandler(srcHandler));
+    DestinationSession::UP dst = dstServer.mb.createDestinationSession(
+            DestinationSessionParams().setName("session").setMessageHandler(dstHandler));
+    ASSERT_TRUE(srcServer.waitSlobrok("dst/session", 1u));
+
+    // Full batches are sent without waiting for the batch window.
+    TEST_DO(sendAndReply(*src, srcHandler, *dst, dstHandler, 8, "in a batch of 4 messages"));
+    // A lone message is sent once the batch window expires.
+    TEST_DO(sendAndReply(*src, srcHandler, *dst, dstHandler, 1, "in a batch of 1 messages"));
+
+    TEST_DONE();
+}
@@ -92,6 +92,27 @@ Test::Main()
     pool.flushTargets(false);
     EXPECT_EQUAL(0u, pool.size());
 
+    // Assert that a sharded pool reuses and expires targets the same way.
+    std::unique_ptr<PoolTimer> shardedPtr(new PoolTimer());
+    PoolTimer &shardedTimer = *shardedPtr;
+    RPCTargetPool shardedPool(std::move(shardedPtr), 0.666, 4);
+    RPCTarget::SP target1 = shardedPool.getTarget(orb, adr1);
+    RPCTarget::SP target2 = shardedPool.getTarget(orb, adr2);
+    ASSERT_TRUE(target1.get() != NULL);
+    ASSERT_TRUE(target2.get() != NULL);
+    EXPECT_TRUE(target1 == shardedPool.getTarget(orb, adr1));
+    EXPECT_TRUE(target2 == shardedPool.getTarget(orb, adr2));
+    ASSERT_TRUE((target = shardedPool.getTarget(orb, adr3)).get() != NULL); target.reset();
+    EXPECT_EQUAL(3u, shardedPool.size());
+    shardedTimer.millis += 999;
+    shardedPool.flushTargets(false);
+    EXPECT_EQUAL(2u, shardedPool.size());
+    target1.reset();
+    target2.reset();
+    shardedTimer.millis += 999;
+    shardedPool.flushTargets(false);
+    EXPECT_EQUAL(0u, shardedPool.size());
+
     orb.ShutDown(true);
 
     TEST_DONE();
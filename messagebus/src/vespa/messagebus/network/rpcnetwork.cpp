@@ -18,6 +18,7 @@
 #include <vespa/fnet/scheduler.h>
 #include <vespa/fnet/transport.h>
 #include <vespa/fnet/frt/supervisor.h>
+#include <algorithm>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -110,10 +111,11 @@ RPCNetwork::RPCNetwork(const RPCNetworkParams &params) :
     _owner(nullptr),
     _ident(params.getIdentity()),
     _threadPool(std::make_unique<FastOS_ThreadPool>(128000, 0)),
-    _transport(std::make_unique<FNET_Transport>()),
+    _transport(std::make_unique<FNET_Transport>(std::max(1u, params.getNumNetworkThreads()))),
     _orb(std::make_unique<FRT_Supervisor>(_transport.get(), nullptr)),
     _scheduler(*_transport->GetScheduler()),
-    _targetPool(std::make_unique<RPCTargetPool>(params.getConnectionExpireSecs())),
+    _targetPool(std::make_unique<RPCTargetPool>(params.getConnectionExpireSecs(),
+                                                  std::max(1u, params.getNumThreads()))),
     _targetPoolTask(_scheduler, *_targetPool),
     _servicePool(std::make_unique<RPCServicePool>(*this, 4096)),
     _slobrokCfgFactory(std::make_unique<slobrok::ConfiguratorFactory>(params.getSlobrokConfig())),
@@ -126,7 +128,9 @@ RPCNetwork::RPCNetwork(const RPCNetworkParams &params) :
     _sendAdapters(),
     _compressionConfig(params.getCompressionConfig()),
     _allowDispatchForEncode(params.getDispatchOnEncode()),
-    _allowDispatchForDecode(params.getDispatchOnDecode())
+    _allowDispatchForDecode(params.getDispatchOnDecode()),
+    _batchWindowSecs(params.getBatchWindowSecs()),
+    _maxBatchSize(params.getMaxBatchSize())
 {
     _transport->SetDirectWrite(false);
     _transport->SetMaxInputBufferSize(params.getMaxInputBufferSize());
@@ -361,6 +365,7 @@ RPCNetwork::send(RPCNetwork::SendContext &ctx)
 void
 RPCNetwork::sync()
 {
+    _sendV2->flushBatches();
     SyncTask task(_scheduler);
     _executor->sync();
     task.await();
@@ -369,6 +374,7 @@ RPCNetwork::sync()
 void
 RPCNetwork::shutdown()
 {
+    _sendV2->flushBatches();
     _transport->ShutDown(false);
     _threadPool->Close();
     _executor->shutdown();
@@ -27,6 +27,7 @@ class RPCServicePool;
 class RPCTargetPool;
 class RPCNetworkParams;
 class RPCServiceAddress;
+class RPCSendV2;
 
 /**
  * Network implementation based on RPC. This class is responsible for
@@ -74,11 +75,13 @@ private:
     int                                             _requestedPort;
     std::unique_ptr<vespalib::ThreadStackExecutor>  _executor;
     std::unique_ptr<RPCSendAdapter>                 _sendV1;
-    std::unique_ptr<RPCSendAdapter>                 _sendV2;
+    std::unique_ptr<RPCSendV2>                      _sendV2;
     SendAdapterMap                                  _sendAdapters;
     CompressionConfig                               _compressionConfig;
     bool                                            _allowDispatchForEncode;
     bool                                            _allowDispatchForDecode;
+    double                                          _batchWindowSecs;
+    uint32_t                                        _maxBatchSize;
 
 
     /**
@@ -232,6 +235,8 @@ public:
     vespalib::Executor & getExecutor() const { return *_executor; }
     bool allowDispatchForEncode() const { return _allowDispatchForEncode; }
     bool allowDispatchForDecode() const { return _allowDispatchForDecode; }
+    double getBatchWindowSecs() const { return _batchWindowSecs; }
+    uint32_t getMaxBatchSize() const { return _maxBatchSize; }
 
 };
 
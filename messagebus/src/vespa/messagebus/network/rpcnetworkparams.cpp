@@ -11,9 +11,12 @@ RPCNetworkParams::RPCNetworkParams() :
     _maxInputBufferSize(256*1024),
     _maxOutputBufferSize(256*1024),
     _numThreads(4),
+    _numNetworkThreads(1),
     _dispatchOnEncode(true),
     _dispatchOnDecode(false),
     _connectionExpireSecs(600),
+    _batchWindowSecs(0.0),
+    _maxBatchSize(64),
     _compressionConfig(CompressionConfig::LZ4, 6, 90, 1024)
 { }
 
@@ -20,9 +20,12 @@ private:
     uint32_t          _maxInputBufferSize;
     uint32_t          _maxOutputBufferSize;
     uint32_t          _numThreads;
+    uint32_t          _numNetworkThreads;
     bool              _dispatchOnEncode;
     bool              _dispatchOnDecode;
     double            _connectionExpireSecs;
+    double            _batchWindowSecs;
+    uint32_t          _maxBatchSize;
     CompressionConfig _compressionConfig;
 
 public:
@@ -112,6 +115,20 @@ public:
 
     uint32_t getNumThreads() const { return _numThreads; }
 
+    /**
+     * Sets number of transport threads used for network io. Connections
+     * are spread over the transport threads by the hash of their target.
+     *
+     * @param numNetworkThreads number of transport threads
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setNumNetworkThreads(uint32_t numNetworkThreads) {
+        _numNetworkThreads = numNetworkThreads;
+        return *this;
+    }
+
+    uint32_t getNumNetworkThreads() const { return _numNetworkThreads; }
+
     /**
      * Returns the number of seconds before an idle network connection expires.
      *
@@ -132,6 +149,49 @@ public:
         return *this;
     }
 
+    /**
+     * Returns the number of seconds messages to the same recipient may be held back so that they can be
+     * sent together in a single batch request. Zero disables batching.
+     *
+     * @return The number of seconds.
+     */
+    double getBatchWindowSecs() const {
+        return _batchWindowSecs;
+    }
+
+    /**
+     * Sets the number of seconds messages to the same recipient may be held back so that they can be
+     * sent together in a single batch request. Zero disables batching.
+     *
+     * @param secs The number of seconds.
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setBatchWindowSecs(double secs) {
+        _batchWindowSecs = secs;
+        return *this;
+    }
+
+    /**
+     * Returns the maximum number of messages sent in a single batch request.
+     *
+     * @return The maximum batch size.
+     */
+    uint32_t getMaxBatchSize() const {
+        return _maxBatchSize;
+    }
+
+    /**
+     * Sets the maximum number of messages sent in a single batch request. A batch is sent as soon as it
+     * reaches this size, without waiting for the batch window to expire.
+     *
+     * @param maxBatchSize The maximum batch size.
+     * @return This, to allow chaining.
+     */
+    RPCNetworkParams &setMaxBatchSize(uint32_t maxBatchSize) {
+        _maxBatchSize = maxBatchSize;
+        return *this;
+    }
+
     /**
      * Returns the maximum input buffer size allowed for the underlying FNET connection.
      *
@@ -10,6 +10,7 @@
 #include <vespa/fnet/channel.h>
 #include <vespa/fnet/frt/reflection.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/trace/latency_trace.h>
 #include <vespa/vespalib/util/lambdatask.h>
 
 #include <vespa/vespalib/data/slime/cursor.h>
@@ -34,6 +35,11 @@ public:
     void fill(const vespalib::Memory & name, vespalib::slime::Cursor & v) const override {
         v.setData(name, vespalib::Memory(_payload.data(), _payload.size()));
     }
+    Blob toBlob() const override {
+        Blob blob(_payload.size());
+        memcpy(blob.data(), _payload.data(), _payload.size());
+        return blob;
+    }
 private:
     BlobRef _payload;
 };
@@ -49,6 +55,9 @@ public:
     void fill(const vespalib::Memory & name, vespalib::slime::Cursor & v) const override {
         v.setData(name, vespalib::Memory(_payload.data(), _payload.size()));
     }
+    Blob toBlob() const override {
+        return std::move(_payload);
+    }
 private:
     mutable Blob _payload;
 };
@@ -160,26 +169,12 @@ RPCSend::doRequestDone(FRT_RPCRequest *req) {
     Trace & trace = ctx->getTrace();
     if (!req->CheckReturnTypes(getReturnSpec())) {
         reply.reset(new EmptyReply());
-        switch (req->GetErrorCode()) {
-            case FRTE_RPC_TIMEOUT:
-                error = Error(ErrorCode::TIMEOUT,
-                              make_string("A timeout occured while waiting for '%s' (%g seconds expired); %s",
-                                          serviceName.c_str(), ctx->getTimeout(), req->GetErrorMessage()));
-                break;
-            case FRTE_RPC_CONNECTION:
-                error = Error(ErrorCode::CONNECTION_ERROR,
-                              make_string("A connection error occured for '%s'; %s",
-                                          serviceName.c_str(), req->GetErrorMessage()));
-                break;
-            default:
-                error = Error(ErrorCode::NETWORK_ERROR,
-                              make_string("A network error occured for '%s'; %s",
-                                          serviceName.c_str(), req->GetErrorMessage()));
-        }
+        error = createNetworkError(*req, serviceName, ctx->getTimeout());
     } else {
         FRT_Values &ret = *req->GetReturn();
         reply = createReply(ret, serviceName, error, trace.getRoot());
     }
+    vespalib::LatencyTrace::add(trace, "mbus_roundtrip", ctx->getElapsedMillis());
     if (trace.shouldTrace(TraceLevel::SEND_RECEIVE)) {
         trace.trace(TraceLevel::SEND_RECEIVE,
                     make_string("Reply (type %d) received at %s.", reply->getType(), _clientIdent.c_str()));
@@ -192,6 +187,25 @@ RPCSend::doRequestDone(FRT_RPCRequest *req) {
     req->SubRef();
 }
 
+Error
+RPCSend::createNetworkError(FRT_RPCRequest &req, const string &serviceName, double timeout) const
+{
+    switch (req.GetErrorCode()) {
+        case FRTE_RPC_TIMEOUT:
+            return Error(ErrorCode::TIMEOUT,
+                         make_string("A timeout occured while waiting for '%s' (%g seconds expired); %s",
+                                     serviceName.c_str(), timeout, req.GetErrorMessage()));
+        case FRTE_RPC_CONNECTION:
+            return Error(ErrorCode::CONNECTION_ERROR,
+                         make_string("A connection error occured for '%s'; %s",
+                                     serviceName.c_str(), req.GetErrorMessage()));
+        default:
+            return Error(ErrorCode::NETWORK_ERROR,
+                         make_string("A network error occured for '%s'; %s",
+                                     serviceName.c_str(), req.GetErrorMessage()));
+    }
+}
+
 std::unique_ptr<Reply>
 RPCSend::decode(vespalib::stringref protocolName, const vespalib::Version & version, BlobRef payload, Error & error) const
 {
@@ -27,6 +27,7 @@ public:
     virtual ~PayLoadFiller() { }
     virtual void fill(FRT_Values & v) const = 0;
     virtual void fill(const vespalib::Memory & name, vespalib::slime::Cursor & v) const = 0;
+    virtual Blob toBlob() const = 0;
 };
 
 class RPCSend : public RPCSendAdapter,
@@ -64,8 +65,9 @@ protected:
     virtual void createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const = 0;
     virtual std::unique_ptr<Params> toParams(const FRT_Values &param) const = 0;
 
-    void send(RoutingNode &recipient, const vespalib::Version &version,
-              const PayLoadFiller & filler, uint64_t timeRemaining);
+    virtual void send(RoutingNode &recipient, const vespalib::Version &version,
+                      const PayLoadFiller & filler, uint64_t timeRemaining);
+    Error createNetworkError(FRT_RPCRequest &req, const string &serviceName, double timeout) const;
     std::unique_ptr<Reply> decode(vespalib::stringref protocol, const vespalib::Version & version,
                                   BlobRef payload, Error & error) const;
     /**
@@ -77,6 +79,7 @@ protected:
      * @param err        The error to reply with.
      */
     void replyError(FRT_RPCRequest *req, const vespalib::Version &version, uint32_t traceLevel, const Error &err);
+    void attach(RPCNetwork &net) override;
 public:
     RPCSend();
     ~RPCSend();
@@ -86,7 +89,6 @@ private:
     void doRequest(FRT_RPCRequest *req, const IProtocol * protocol, std::unique_ptr<Params> params);
     void doRequestDone(FRT_RPCRequest *req);
     void doHandleReply(const IProtocol * protocol, std::unique_ptr<Reply> reply);
-    void attach(RPCNetwork &net) final override;
     void handleDiscard(Context ctx) final override;
     void sendByHandover(RoutingNode &recipient, const vespalib::Version &version,
                         Blob payload, uint64_t timeRemaining) final override;
@@ -3,6 +3,7 @@
 
 #include <vespa/messagebus/trace.h>
 #include <vespa/messagebus/routing/routingnode.h>
+#include <vespa/fastos/timestamp.h>
 
 namespace mbus::network::internal {
 /**
@@ -14,6 +15,7 @@ private:
     mbus::RoutingNode &_recipient;
     mbus::Trace        _trace;
     double             _timeout;
+    fastos::StopWatch  _timer;
 
 public:
     typedef std::unique_ptr<SendContext> UP;
@@ -22,10 +24,15 @@ public:
     SendContext(mbus::RoutingNode &recipient, uint64_t timeRemaining)
             : _recipient(recipient),
               _trace(recipient.getTrace().getLevel()),
-              _timeout(timeRemaining * 0.001) { }
+              _timeout(timeRemaining * 0.001),
+              _timer()
+    {
+        _timer.start();
+    }
     mbus::RoutingNode &getRecipient() { return _recipient; }
     mbus::Trace &getTrace() { return _trace; }
     double getTimeout() { return _timeout; }
+    double getElapsedMillis() { _timer.stop(); return _timer.elapsed().sec() * 1000.0; }
 };
 
 /**
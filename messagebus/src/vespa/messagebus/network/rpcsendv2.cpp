@@ -1,15 +1,21 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "rpcsendv2.h"
+#include "rpcsend_private.h"
 #include "rpcnetwork.h"
 #include "rpcserviceaddress.h"
 #include <vespa/messagebus/emptyreply.h>
+#include <vespa/messagebus/errorcode.h>
+#include <vespa/messagebus/iprotocol.h>
 #include <vespa/messagebus/tracelevel.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/trace/latency_trace.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/fnet/frt/reflection.h>
+#include <vespa/fnet/task.h>
 
 using vespalib::make_string;
 using vespalib::compression::CompressionConfig;
@@ -21,6 +27,7 @@ using vespalib::stringref;
 using vespalib::Memory;
 using vespalib::Slime;
 using vespalib::Version;
+using vespalib::makeLambdaTask;
 using namespace vespalib::slime;
 
 namespace mbus {
@@ -30,6 +37,9 @@ namespace {
 const char *METHOD_NAME   = "mbus.slime";
 const char *METHOD_PARAMS = "bixbix";
 const char *METHOD_RETURN = "bixbix";
+const char *BATCH_METHOD_NAME   = "mbus.slimeBatch";
+const char *BATCH_METHOD_PARAMS = "bix";
+const char *BATCH_METHOD_RETURN = "bix";
 
 Memory VERSION_F("version");
 Memory ROUTE_F("route");
@@ -46,9 +56,73 @@ Memory ERRORS_F("errors");
 Memory CODE_F("code");
 Memory MSG_F("msg");
 Memory SERVICE_F("service");
+Memory MESSAGES_F("messages");
+Memory REPLIES_F("replies");
 
 }
 
+using network::internal::SendContext;
+
+struct RPCSendV2::PendingMessage {
+    RoutingNode       &_recipient;
+    Version            _version;
+    Blob               _payload;
+    uint64_t           _timeRemaining;
+    SendContext::UP    _ctx;
+
+    PendingMessage(RoutingNode &recipient, const Version &version, Blob payload, uint64_t timeRemaining)
+        : _recipient(recipient),
+          _version(version),
+          _payload(std::move(payload)),
+          _timeRemaining(timeRemaining),
+          _ctx(std::make_unique<SendContext>(recipient, timeRemaining))
+    { }
+};
+
+class RPCSendV2::BatchRequestDone : public FRT_IRequestWait {
+public:
+    explicit BatchRequestDone(RPCSendV2 &owner) : _owner(owner) { }
+    void RequestDone(FRT_RPCRequest *req) override { _owner.batchDone(req); }
+private:
+    RPCSendV2 &_owner;
+};
+
+class RPCSendV2::FlushTask : public FNET_Task {
+public:
+    FlushTask(FNET_Scheduler &scheduler, RPCSendV2 &owner) : FNET_Task(&scheduler), _owner(owner) { }
+    void PerformTask() override { _owner.flushBatches(); }
+private:
+    RPCSendV2 &_owner;
+};
+
+RPCSendV2::RPCSendV2() :
+    RPCSend(),
+    _batchLock(),
+    _batches(),
+    _unbatchedTargets(),
+    _batchDone(std::make_unique<BatchRequestDone>(*this)),
+    _flushTask(),
+    _flushScheduled(false),
+    _batchWindow(0.0),
+    _maxBatchSize(1)
+{ }
+
+RPCSendV2::~RPCSendV2()
+{
+    if (_flushTask) {
+        _flushTask->Kill();
+    }
+}
+
+void
+RPCSendV2::attach(RPCNetwork &net)
+{
+    RPCSend::attach(net);
+    _batchWindow = net.getBatchWindowSecs();
+    _maxBatchSize = std::max(1u, net.getMaxBatchSize());
+    _flushTask = std::make_unique<FlushTask>(net.getScheduler(), *this);
+}
+
 bool RPCSendV2::isCompatible(stringref method, stringref request, stringref response)
 {
     return  (method == METHOD_NAME) &&
@@ -73,6 +147,16 @@ RPCSendV2::build(FRT_ReflectionBuilder & builder)
     builder.ReturnDesc("body_encoding",  "0=raw, 6=lz4");
     builder.ReturnDesc("body_decoded_size", "Uncompressed body blob size");
     builder.ReturnDesc("body_payload", "The reply body blob in slime.");
+
+    builder.DefineMethod(BATCH_METHOD_NAME, BATCH_METHOD_PARAMS, BATCH_METHOD_RETURN, true,
+                         FRT_METHOD(RPCSendV2::invokeBatch), this);
+    builder.MethodDesc("Send a batch of message bus slime requests and get a batch of replies back.");
+    builder.ParamDesc("encoding", "0=raw, 6=lz4");
+    builder.ParamDesc("decoded_size", "Uncompressed blob size");
+    builder.ParamDesc("payload", "The messages in slime");
+    builder.ReturnDesc("encoding",  "0=raw, 6=lz4");
+    builder.ReturnDesc("decoded_size", "Uncompressed blob size");
+    builder.ReturnDesc("payload", "The replies in slime, in the same order as the messages.");
 }
 
 const char *
@@ -96,6 +180,71 @@ private:
     }
     DataBuffer _buf;
 };
+
+void
+encodeSlime(const Slime &slime, const CompressionConfig &config, FRT_Values &values)
+{
+    OutputBuf rBuf(8192);
+    BinaryFormat::encode(slime, rBuf);
+    ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
+    DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
+    CompressionConfig::Type type = compress(config, toCompress, buf, false);
+
+    values.AddInt8(type);
+    values.AddInt32(toCompress.size());
+    const auto bufferLength = buf.getDataLen();
+    assert(bufferLength <= INT32_MAX);
+    values.AddData(buf.stealBuffer(), bufferLength);
+}
+
+void
+decodeSlime(const FRT_Values &values, uint32_t offset, Slime &slime)
+{
+    uint8_t encoding = values[offset]._intval8;
+    uint32_t uncompressedSize = values[offset + 1]._intval32;
+    DataBuffer uncompressed(values[offset + 2]._data._buf, values[offset + 2]._data._len);
+    ConstBufferRef blob(values[offset + 2]._data._buf, values[offset + 2]._data._len);
+    decompress(CompressionConfig::toType(encoding), uncompressedSize, blob, uncompressed, true);
+    assert(uncompressedSize == uncompressed.getDataLen());
+    BinaryFormat::decode(Memory(uncompressed.getData(), uncompressed.getDataLen()), slime);
+}
+
+void
+fillRequest(Cursor & root, const Version &version, const Route & route, const RPCServiceAddress & address,
+            const Message & msg, uint32_t traceLevel, uint64_t timeRemaining)
+{
+    root.setString(VERSION_F, version.toString());
+    root.setString(ROUTE_F, route.toString());
+    root.setString(SESSION_F, address.getSessionName());
+    root.setBool(USERETRY_F, msg.getRetryEnabled());
+    root.setLong(RETRY_F, msg.getRetry());
+    root.setLong(TIMELEFT_F, timeRemaining);
+    root.setString(PROTOCOL_F, msg.getProtocol());
+    root.setLong(TRACELEVEL_F, traceLevel);
+}
+
+void
+fillResponse(Cursor & root, const string & version, Reply & reply, const Blob & payload)
+{
+    root.setString(VERSION_F, version);
+    root.setDouble(RETRYDELAY_F, reply.getRetryDelay());
+    root.setString(PROTOCOL_F, reply.getProtocol());
+    root.setData(BLOB_F, vespalib::Memory(payload.data(), payload.size()));
+    if (reply.getTrace().getLevel() > 0) {
+        root.setString(TRACE_F, reply.getTrace().getRoot().encode());
+    }
+
+    if (reply.getNumErrors() > 0) {
+        Cursor & array = root.setArray(ERRORS_F);
+        for (uint32_t i = 0; i < reply.getNumErrors(); ++i) {
+            Cursor & error = array.addObject();
+            error.setLong(CODE_F, reply.getError(i).getCode());
+            error.setString(MSG_F, reply.getError(i).getMessage());
+            error.setString(SERVICE_F, reply.getError(i).getService().c_str());
+        }
+    }
+}
+
 }
 
 void
@@ -112,72 +261,64 @@ RPCSendV2::encodeRequest(FRT_RPCRequest &req, const Version &version, const Rout
 
     Slime slime;
     Cursor & root = slime.setObject();
-
-    root.setString(VERSION_F, version.toString());
-    root.setString(ROUTE_F, route.toString());
-    root.setString(SESSION_F, address.getSessionName());
-    root.setBool(USERETRY_F, msg.getRetryEnabled());
-    root.setLong(RETRY_F, msg.getRetry());
-    root.setLong(TIMELEFT_F, timeRemaining);
-    root.setString(PROTOCOL_F, msg.getProtocol());
-    root.setLong(TRACELEVEL_F, traceLevel);
+    fillRequest(root, version, route, address, msg, traceLevel, timeRemaining);
     filler.fill(BLOB_F, root);
 
-    OutputBuf rBuf(8192);
-    BinaryFormat::encode(slime, rBuf);
-    ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
-    DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
-
-    args.AddInt8(type);
-    args.AddInt32(toCompress.size());
-    const auto bufferLength = buf.getDataLen();
-    assert(bufferLength <= INT32_MAX);
-    args.AddData(buf.stealBuffer(), bufferLength);
+    encodeSlime(slime, _net->getCompressionConfig(), args);
 }
 
 namespace {
 
-class ParamsV2 : public RPCSend::Params
+class SlimeParams : public RPCSend::Params
 {
 public:
-    ParamsV2(const FRT_Values &arg)
-        : _slime()
-    {
-        uint8_t encoding = arg[3]._intval8;
-        uint32_t uncompressedSize = arg[4]._intval32;
-        DataBuffer uncompressed(arg[5]._data._buf, arg[5]._data._len);
-        ConstBufferRef blob(arg[5]._data._buf, arg[5]._data._len);
-        decompress(CompressionConfig::toType(encoding), uncompressedSize, blob, uncompressed, true);
-        assert(uncompressedSize == uncompressed.getDataLen());
-        BinaryFormat::decode(Memory(uncompressed.getData(), uncompressed.getDataLen()), _slime);
-    }
-
-    uint32_t getTraceLevel() const override { return _slime.get()[TRACELEVEL_F].asLong(); }
-    bool useRetry() const override { return _slime.get()[USERETRY_F].asBool(); }
-    uint32_t getRetries() const override { return _slime.get()[RETRY_F].asLong(); }
-    uint64_t getRemainingTime() const override { return _slime.get()[TIMELEFT_F].asLong(); }
+    uint32_t getTraceLevel() const override { return root()[TRACELEVEL_F].asLong(); }
+    bool useRetry() const override { return root()[USERETRY_F].asBool(); }
+    uint32_t getRetries() const override { return root()[RETRY_F].asLong(); }
+    uint64_t getRemainingTime() const override { return root()[TIMELEFT_F].asLong(); }
 
     Version getVersion() const override {
-        return Version(_slime.get()[VERSION_F].asString().make_stringref());
+        return Version(root()[VERSION_F].asString().make_stringref());
     }
     stringref getRoute() const override {
-        return _slime.get()[ROUTE_F].asString().make_stringref();
+        return root()[ROUTE_F].asString().make_stringref();
     }
     stringref getSession() const override {
-        return _slime.get()[SESSION_F].asString().make_stringref();
+        return root()[SESSION_F].asString().make_stringref();
     }
     stringref getProtocol() const override {
-        return _slime.get()[PROTOCOL_F].asString().make_stringref();
+        return root()[PROTOCOL_F].asString().make_stringref();
     }
     BlobRef getPayload() const override {
-        Memory m = _slime.get()[BLOB_F].asData();
+        Memory m = root()[BLOB_F].asData();
         return BlobRef(m.data, m.size);
     }
 private:
+    virtual const Inspector & root() const = 0;
+};
+
+class ParamsV2 : public SlimeParams
+{
+public:
+    ParamsV2(const FRT_Values &arg)
+        : _slime()
+    {
+        decodeSlime(arg, 3, _slime);
+    }
+private:
+    const Inspector & root() const override { return _slime.get(); }
     Slime _slime;
 };
 
+class BatchParams : public SlimeParams
+{
+public:
+    BatchParams(const Inspector &root) : _root(root) { }
+private:
+    const Inspector & root() const override { return _root; }
+    const Inspector & _root;
+};
+
 }
 
 std::unique_ptr<RPCSend::Params>
@@ -190,15 +331,15 @@ std::unique_ptr<Reply>
 RPCSendV2::createReply(const FRT_Values & ret, const string & serviceName,
                        Error & error, vespalib::TraceNode & rootTrace) const
 {
-    uint8_t encoding = ret[3]._intval8;
-    uint32_t uncompressedSize = ret[4]._intval32;
-    DataBuffer uncompressed(ret[5]._data._buf, ret[5]._data._len);
-    ConstBufferRef blob(ret[5]._data._buf, ret[5]._data._len);
-    decompress(CompressionConfig::toType(encoding), uncompressedSize, blob, uncompressed, true);
-    assert(uncompressedSize == uncompressed.getDataLen());
     Slime slime;
-    BinaryFormat::decode(Memory(uncompressed.getData(), uncompressed.getDataLen()), slime);
-    Inspector & root = slime.get();
+    decodeSlime(ret, 3, slime);
+    return createReply(slime.get(), serviceName, error, rootTrace);
+}
+
+std::unique_ptr<Reply>
+RPCSendV2::createReply(const Inspector & root, const string & serviceName,
+                       Error & error, vespalib::TraceNode & rootTrace) const
+{
     Version version(root[VERSION_F].asString().make_string());
     Memory payload = root[BLOB_F].asData();
 
@@ -230,38 +371,328 @@ RPCSendV2::createResponse(FRT_Values & ret, const string & version, Reply & repl
     ret.AddData("", 0);
 
     Slime slime;
-    Cursor & root = slime.setObject();
+    fillResponse(slime.setObject(), version, reply, payload);
+    encodeSlime(slime, _net->getCompressionConfig(), ret);
+}
 
-    root.setString(VERSION_F, version);
-    root.setDouble(RETRYDELAY_F, reply.getRetryDelay());
-    root.setString(PROTOCOL_F, reply.getProtocol());
-    root.setData(BLOB_F, vespalib::Memory(payload.data(), payload.size()));
-    if (reply.getTrace().getLevel() > 0) {
-        root.setString(TRACE_F, reply.getTrace().getRoot().encode());
+void
+RPCSendV2::send(RoutingNode &recipient, const Version &version,
+                const PayLoadFiller & filler, uint64_t timeRemaining)
+{
+    if ((_batchWindow <= 0.0) || recipient.getRoute().getHop(0).getIgnoreResult()) {
+        RPCSend::send(recipient, version, filler, timeRemaining);
+        return;
+    }
+    RPCServiceAddress &address = static_cast<RPCServiceAddress&>(recipient.getServiceAddress());
+    {
+        vespalib::LockGuard guard(_batchLock);
+        if (_unbatchedTargets.find(address.getConnectionSpec()) != _unbatchedTargets.end()) {
+            guard.unlock();
+            RPCSend::send(recipient, version, filler, timeRemaining);
+            return;
+        }
+    }
+    auto pending = std::make_unique<PendingMessage>(recipient, version, filler.toBlob(), timeRemaining);
+    PendingList full;
+    bool schedule = false;
+    {
+        vespalib::LockGuard guard(_batchLock);
+        RPCTarget *target = &address.getTarget();
+        PendingList &batch = _batches[target];
+        batch.push_back(std::move(pending));
+        if (batch.size() >= _maxBatchSize) {
+            full.swap(batch);
+            _batches.erase(target);
+        } else if (!_flushScheduled) {
+            _flushScheduled = true;
+            schedule = true;
+        }
     }
+    if (!full.empty()) {
+        sendBatch(std::move(full));
+    }
+    if (schedule) {
+        _flushTask->Schedule(_batchWindow);
+    }
+}
 
-    if (reply.getNumErrors() > 0) {
-        Cursor & array = root.setArray(ERRORS_F);
-        for (uint32_t i = 0; i < reply.getNumErrors(); ++i) {
-            Cursor & error = array.addObject();
-            error.setLong(CODE_F, reply.getError(i).getCode());
-            error.setString(MSG_F, reply.getError(i).getMessage());
-            error.setString(SERVICE_F, reply.getError(i).getService().c_str());
+void
+RPCSendV2::flushBatches()
+{
+    BatchMap batches;
+    {
+        vespalib::LockGuard guard(_batchLock);
+        batches.swap(_batches);
+        _flushScheduled = false;
+    }
+    for (auto & entry : batches) {
+        sendBatch(std::move(entry.second));
+    }
+}
+
+void
+RPCSendV2::sendBatch(PendingList batch)
+{
+    RPCServiceAddress &address = static_cast<RPCServiceAddress&>(batch.front()->_recipient.getServiceAddress());
+    Slime slime;
+    Cursor & messages = slime.setObject().setArray(MESSAGES_F);
+    double timeout = 0.0;
+    for (const auto & pending : batch) {
+        RoutingNode &recipient = pending->_recipient;
+        Route route = recipient.getRoute();
+        route.removeHop(0);
+        Cursor & root = messages.addObject();
+        fillRequest(root, pending->_version, route, static_cast<RPCServiceAddress&>(recipient.getServiceAddress()),
+                    recipient.getMessage(), recipient.getTrace().getLevel(), pending->_timeRemaining);
+        root.setData(BLOB_F, Memory(pending->_payload.data(), pending->_payload.size()));
+
+        SendContext &ctx = *pending->_ctx;
+        if (ctx.getTrace().shouldTrace(TraceLevel::SEND_RECEIVE)) {
+            ctx.getTrace().trace(TraceLevel::SEND_RECEIVE,
+                                 make_string("Sending message (version %s) from %s to '%s' with %.2f seconds timeout "
+                                             "in a batch of %zu messages.",
+                                             pending->_version.toString().c_str(), _clientIdent.c_str(),
+                                             address.getServiceName().c_str(), ctx.getTimeout(), batch.size()));
         }
+        timeout = std::max(timeout, ctx.getTimeout());
     }
 
-    OutputBuf rBuf(8192);
-    BinaryFormat::encode(slime, rBuf);
-    ConstBufferRef toCompress(rBuf.getBuf().getData(), rBuf.getBuf().getDataLen());
-    DataBuffer buf(vespalib::roundUp2inN(rBuf.getBuf().getDataLen()));
-    CompressionConfig::Type type = compress(_net->getCompressionConfig(), toCompress, buf, false);
+    FRT_RPCRequest *req = _net->allocRequest();
+    req->SetMethodName(BATCH_METHOD_NAME);
+    encodeSlime(slime, _net->getCompressionConfig(), *req->GetParams());
+    RPCTarget &target = address.getTarget();
+    req->SetContext(FNET_Context(new PendingList(std::move(batch))));
+    target.getFRTTarget().InvokeAsync(req, timeout, _batchDone.get());
+}
 
-    ret.AddInt8(type);
-    ret.AddInt32(toCompress.size());
-    const auto bufferLength = buf.getDataLen();
-    assert(bufferLength <= INT32_MAX);
-    ret.AddData(buf.stealBuffer(), bufferLength);
+void
+RPCSendV2::batchDone(FRT_RPCRequest *req)
+{
+    std::unique_ptr<PendingList> batch(static_cast<PendingList*>(req->GetContext()._value.VOIDP));
+    RPCServiceAddress &address = static_cast<RPCServiceAddress&>(batch->front()->_recipient.getServiceAddress());
+    const string serviceName = address.getServiceName();
+    if (!req->CheckReturnTypes(BATCH_METHOD_RETURN) && (req->GetErrorCode() == FRTE_RPC_NO_SUCH_METHOD)) {
+        // The recipient does not support batching, so resend the messages one by one.
+        {
+            vespalib::LockGuard guard(_batchLock);
+            _unbatchedTargets.insert(address.getConnectionSpec());
+        }
+        for (const auto & pending : *batch) {
+            static_cast<RPCSendAdapter&>(*this).sendByHandover(pending->_recipient, pending->_version,
+                                                               std::move(pending->_payload), pending->_timeRemaining);
+        }
+        req->SubRef();
+        return;
+    }
+    Slime slime;
+    bool ok = req->CheckReturnTypes(BATCH_METHOD_RETURN);
+    if (ok) {
+        decodeSlime(*req->GetReturn(), 0, slime);
+    }
+    Inspector & replies = slime.get()[REPLIES_F];
+    for (uint32_t i = 0; i < batch->size(); ++i) {
+        PendingMessage &pending = *(*batch)[i];
+        Trace & trace = pending._ctx->getTrace();
+        Reply::UP reply;
+        Error error;
+        if (!ok) {
+            reply.reset(new EmptyReply());
+            error = createNetworkError(*req, serviceName, pending._ctx->getTimeout());
+        } else if (i < replies.entries()) {
+            reply = createReply(replies[i], serviceName, error, trace.getRoot());
+        } else {
+            reply.reset(new EmptyReply());
+            error = Error(ErrorCode::NETWORK_ERROR,
+                          make_string("Batch reply from '%s' is missing the reply to message %u.",
+                                      serviceName.c_str(), i));
+        }
+        vespalib::LatencyTrace::add(trace, "mbus_roundtrip", pending._ctx->getElapsedMillis());
+        if (trace.shouldTrace(TraceLevel::SEND_RECEIVE)) {
+            trace.trace(TraceLevel::SEND_RECEIVE,
+                        make_string("Reply (type %d) received at %s.", reply->getType(), _clientIdent.c_str()));
+        }
+        reply->getTrace().swap(trace);
+        if (error.getCode() != ErrorCode::NONE) {
+            reply->addError(error);
+        }
+        _net->getOwner().deliverReply(std::move(reply), pending._recipient);
+    }
+    req->SubRef();
+}
 
+/**
+ * Delivers the messages of a single batch request, and collects their replies. The batch request is
+ * returned once every message has been replied to, after which this object deletes itself.
+ */
+class RPCSendV2::BatchReplyHandler : public IReplyHandler,
+                                     public IDiscardHandler
+{
+public:
+    BatchReplyHandler(RPCSendV2 &owner, FRT_RPCRequest &req)
+        : _owner(owner),
+          _req(req),
+          _slime(),
+          _lock(),
+          _replies(),
+          _pending(0)
+    {
+        decodeSlime(*req.GetParams(), 0, _slime);
+        _req.DiscardBlobs();
+    }
+
+    bool requireSequencing() const {
+        Inspector & messages = _slime.get()[MESSAGES_F];
+        for (uint32_t i = 0; i < messages.entries(); ++i) {
+            const IProtocol * protocol = _owner._net->getOwner().getProtocol(BatchParams(messages[i]).getProtocol());
+            if ((protocol != nullptr) && protocol->requireSequencing()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void deliver() {
+        Inspector & messages = _slime.get()[MESSAGES_F];
+        const uint32_t numMessages = messages.entries();
+        _replies.resize(numMessages);
+        _pending = numMessages + 1;
+        for (uint32_t i = 0; i < numMessages; ++i) {
+            deliver(i, BatchParams(messages[i]));
+        }
+        done();
+    }
+
+    void handleReply(Reply::UP reply) override {
+        uint32_t index = reply->getContext().value.UINT64;
+        const string &version = _replies[index]._version;
+        if (reply->getTrace().shouldTrace(TraceLevel::SEND_RECEIVE)) {
+            reply->getTrace().trace(TraceLevel::SEND_RECEIVE, make_string("Sending reply (version %s) from %s.",
+                                                                          version.c_str(), _owner._serverIdent.c_str()));
+        }
+        Blob payload(0);
+        if (reply->getType() != 0) {
+            const IProtocol * protocol = _owner._net->getOwner().getProtocol(reply->getProtocol());
+            if (protocol != nullptr) {
+                payload = protocol->encode(Version(version), *reply);
+            }
+            if (payload.size() == 0) {
+                reply->addError(Error(ErrorCode::ENCODE_ERROR, "An error occured while encoding the reply, see log."));
+            }
+        }
+        setReply(index, std::move(reply), std::move(payload));
+    }
+
+    void handleDiscard(Context ctx) override {
+        uint32_t index = ctx.value.UINT64;
+        Reply::UP reply(new EmptyReply());
+        reply->addError(Error(ErrorCode::UNKNOWN_SESSION,
+                              make_string("Message was discarded by %s.", _owner._serverIdent.c_str())));
+        setReply(index, std::move(reply), Blob(0));
+    }
+
+private:
+    struct ReplySlot {
+        string     _version;
+        Reply::UP  _reply;
+        Blob       _payload;
+
+        ReplySlot() : _version(), _reply(), _payload(0) { }
+    };
+
+    void deliver(uint32_t index, const BatchParams &params) {
+        _replies[index]._version = params.getVersion().toString();
+        IProtocol * protocol = _owner._net->getOwner().getProtocol(params.getProtocol());
+        if (protocol == nullptr) {
+            replyError(index, params, Error(ErrorCode::UNKNOWN_PROTOCOL,
+                                            make_string("Protocol '%s' is not known by %s.",
+                                                        params.getProtocol().c_str(), _owner._serverIdent.c_str())));
+            return;
+        }
+        Routable::UP routable = protocol->decode(params.getVersion(), params.getPayload());
+        if ( ! routable ) {
+            replyError(index, params, Error(ErrorCode::DECODE_ERROR,
+                                            make_string("Protocol '%s' failed to decode routable.",
+                                                        params.getProtocol().c_str())));
+            return;
+        }
+        if (routable->isReply()) {
+            replyError(index, params, Error(ErrorCode::DECODE_ERROR,
+                                            "Payload decoded to a reply when expecting a mesage."));
+            return;
+        }
+        Message::UP msg(static_cast<Message*>(routable.release()));
+        vespalib::stringref route = params.getRoute();
+        if (!route.empty()) {
+            msg->setRoute(Route::parse(route));
+        }
+        msg->setContext(Context(uint64_t(index)));
+        msg->pushHandler(*this, *this);
+        msg->setRetryEnabled(params.useRetry());
+        msg->setRetry(params.getRetries());
+        msg->setTimeReceivedNow();
+        msg->setTimeRemaining(params.getRemainingTime());
+        msg->getTrace().setLevel(params.getTraceLevel());
+        if (msg->getTrace().shouldTrace(TraceLevel::SEND_RECEIVE)) {
+            msg->getTrace().trace(TraceLevel::SEND_RECEIVE,
+                                  make_string("Message (type %d) received at %s for session '%s'.",
+                                              msg->getType(), _owner._serverIdent.c_str(),
+                                              string(params.getSession()).c_str()));
+        }
+        _owner._net->getOwner().deliverMessage(std::move(msg), params.getSession());
+    }
+
+    void replyError(uint32_t index, const BatchParams &params, const Error &err) {
+        Reply::UP reply(new EmptyReply());
+        reply->getTrace().setLevel(params.getTraceLevel());
+        reply->addError(err);
+        setReply(index, std::move(reply), Blob(0));
+    }
+
+    void setReply(uint32_t index, Reply::UP reply, Blob payload) {
+        ReplySlot &slot = _replies[index];
+        slot._reply = std::move(reply);
+        slot._payload = std::move(payload);
+        done();
+    }
+
+    void done() {
+        {
+            vespalib::LockGuard guard(_lock);
+            if (--_pending > 0) {
+                return;
+            }
+        }
+        Slime slime;
+        Cursor & replies = slime.setObject().setArray(REPLIES_F);
+        for (ReplySlot &slot : _replies) {
+            fillResponse(replies.addObject(), slot._version, *slot._reply, slot._payload);
+        }
+        encodeSlime(slime, _owner._net->getCompressionConfig(), *_req.GetReturn());
+        _req.Return();
+        delete this;
+    }
+
+    RPCSendV2              &_owner;
+    FRT_RPCRequest         &_req;
+    Slime                   _slime;
+    vespalib::Lock          _lock;
+    std::vector<ReplySlot>  _replies;
+    uint32_t                _pending;
+};
+
+void
+RPCSendV2::invokeBatch(FRT_RPCRequest *req)
+{
+    req->Detach();
+    auto handler = new BatchReplyHandler(*this, *req); // deletes self
+    if (handler->requireSequencing() || !_net->allowDispatchForDecode()) {
+        handler->deliver();
+    } else {
+        auto rejected = _net->getExecutor().execute(makeLambdaTask([handler]() {
+            handler->deliver();
+        }));
+        assert (!rejected);
+    }
 }
 
 } // namespace mbus
@@ -2,13 +2,50 @@
 #pragma once
 
 #include "rpcsend.h"
+#include <vespa/vespalib/util/sync.h>
+#include <map>
+#include <set>
+
+namespace vespalib::slime { struct Inspector; }
 
 namespace mbus {
 
+class RPCTarget;
+
+/**
+ * Sends messages using the slime based rpc method. When the network is configured with a batch window,
+ * messages to the same target are held back for at most that long and sent together in a single batch
+ * request. Each message in a batch is still routed, traced and replied to individually.
+ */
 class RPCSendV2 : public RPCSend {
 public:
+    RPCSendV2();
+    ~RPCSendV2() override;
     static bool isCompatible(vespalib::stringref method, vespalib::stringref request, vespalib::stringref response);
+
+    void attach(RPCNetwork &net) override;
+
+    /**
+     * Sends all messages currently held back for batching.
+     */
+    void flushBatches();
 private:
+    struct PendingMessage;
+    class BatchRequestDone;
+    class BatchReplyHandler;
+    class FlushTask;
+    using PendingList = std::vector<std::unique_ptr<PendingMessage>>;
+    using BatchMap = std::map<RPCTarget *, PendingList>;
+
+    vespalib::Lock                    _batchLock;
+    BatchMap                          _batches;
+    std::set<string>                  _unbatchedTargets;
+    std::unique_ptr<BatchRequestDone> _batchDone;
+    std::unique_ptr<FlushTask>        _flushTask;
+    bool                              _flushScheduled;
+    double                            _batchWindow;
+    uint32_t                          _maxBatchSize;
+
     void build(FRT_ReflectionBuilder & builder) override;
     const char * getReturnSpec() const override;
     std::unique_ptr<Params> toParams(const FRT_Values &param) const override;
@@ -19,6 +56,14 @@ private:
     std::unique_ptr<Reply> createReply(const FRT_Values & response, const string & serviceName,
                                        Error & error, vespalib::TraceNode & rootTrace) const override;
     void createResponse(FRT_Values & ret, const string & version, Reply & reply, Blob payload) const override;
+    void send(RoutingNode &recipient, const vespalib::Version &version,
+              const PayLoadFiller & filler, uint64_t timeRemaining) override;
+
+    std::unique_ptr<Reply> createReply(const vespalib::slime::Inspector & root, const string & serviceName,
+                                       Error & error, vespalib::TraceNode & rootTrace) const;
+    void sendBatch(PendingList batch);
+    void batchDone(FRT_RPCRequest *req);
+    void invokeBatch(FRT_RPCRequest *req);
 };
 
 } // namespace mbus
@@ -1,6 +1,8 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "rpctargetpool.h"
 #include <vespa/messagebus/systemtimer.h>
+#include <vespa/vespalib/stllike/hash_fun.h>
+#include <algorithm>
 
 namespace mbus {
 
@@ -9,32 +11,49 @@ RPCTargetPool::Entry::Entry(RPCTarget::SP target, uint64_t lastUse) :
     _lastUse(lastUse)
 { }
 
-RPCTargetPool::RPCTargetPool(double expireSecs) :
+RPCTargetPool::Shard::Shard() :
     _lock(),
-    _targets(),
-    _timer(new SystemTimer()),
-    _expireMillis(static_cast<uint64_t>(expireSecs * 1000))
+    _targets()
 { }
 
-RPCTargetPool::RPCTargetPool(ITimer::UP timer, double expireSecs) :
-    _lock(),
-    _targets(),
+RPCTargetPool::Shard::~Shard() = default;
+
+RPCTargetPool::RPCTargetPool(double expireSecs, uint32_t numShards) :
+    RPCTargetPool(std::make_unique<SystemTimer>(), expireSecs, numShards)
+{ }
+
+RPCTargetPool::RPCTargetPool(ITimer::UP timer, double expireSecs, uint32_t numShards) :
+    _shards(),
     _timer(std::move(timer)),
     _expireMillis(static_cast<uint64_t>(expireSecs * 1000))
-{ }
+{
+    numShards = std::max(1u, numShards);
+    _shards.reserve(numShards);
+    for (uint32_t i = 0; i < numShards; ++i) {
+        _shards.push_back(std::make_unique<Shard>());
+    }
+}
 
 RPCTargetPool::~RPCTargetPool()
 {
     flushTargets(true);
 }
 
+RPCTargetPool::Shard &
+RPCTargetPool::getShard(const string &spec)
+{
+    if (_shards.size() == 1) {
+        return *_shards[0];
+    }
+    return *_shards[vespalib::hashValue(spec.c_str()) % _shards.size()];
+}
+
 void
-RPCTargetPool::flushTargets(bool force)
+RPCTargetPool::flushShard(Shard &shard, uint64_t currentTime, bool force)
 {
-    uint64_t currentTime = _timer->getMilliTime();
-    vespalib::LockGuard guard(_lock);
-    TargetMap::iterator it = _targets.begin();
-    while (it != _targets.end()) {
+    vespalib::LockGuard guard(shard._lock);
+    TargetMap::iterator it = shard._targets.begin();
+    while (it != shard._targets.end()) {
         Entry &entry = it->second;
         if (entry._target.get() != nullptr) {
             if (entry._target.use_count() > 1) {
@@ -49,33 +68,48 @@ RPCTargetPool::flushTargets(bool force)
                 }
             }
         }
-        _targets.erase(it++); // postfix increment to move the iterator
+        shard._targets.erase(it++); // postfix increment to move the iterator
+    }
+}
+
+void
+RPCTargetPool::flushTargets(bool force)
+{
+    uint64_t currentTime = _timer->getMilliTime();
+    for (const auto &shard : _shards) {
+        flushShard(*shard, currentTime, force);
     }
 }
 
 size_t
 RPCTargetPool::size()
 {
-    vespalib::LockGuard guard(_lock);
-    return _targets.size();
+    size_t ret = 0;
+    for (const auto &shard : _shards) {
+        vespalib::LockGuard guard(shard->_lock);
+        ret += shard->_targets.size();
+    }
+    return ret;
 }
 
 RPCTarget::SP
 RPCTargetPool::getTarget(FRT_Supervisor &orb, const RPCServiceAddress &address)
 {
-    vespalib::LockGuard guard(_lock);
     string spec = address.getConnectionSpec();
-    TargetMap::iterator it = _targets.find(spec);
-    if (it != _targets.end()) {
+    uint64_t currentTime = _timer->getMilliTime();
+    Shard &shard = getShard(spec);
+    vespalib::LockGuard guard(shard._lock);
+    TargetMap::iterator it = shard._targets.find(spec);
+    if (it != shard._targets.end()) {
         Entry &entry = it->second;
         if (entry._target->isValid()) {
-            entry._lastUse = _timer->getMilliTime();
+            entry._lastUse = currentTime;
             return entry._target;
         }
-        _targets.erase(it);
+        shard._targets.erase(it);
     }
     RPCTarget::SP ret(new RPCTarget(spec, orb));
-    _targets.insert(TargetMap::value_type(spec, Entry(ret, _timer->getMilliTime())));
+    shard._targets.insert(TargetMap::value_type(spec, Entry(ret, currentTime)));
     return ret;
 }
 
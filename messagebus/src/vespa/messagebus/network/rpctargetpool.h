@@ -6,6 +6,8 @@
 #include <vespa/messagebus/itimer.h>
 #include <vespa/vespalib/util/sync.h>
 #include <map>
+#include <memory>
+#include <vector>
 
 class FRT_Supervisor;
 
@@ -30,10 +32,25 @@ private:
     };
     typedef std::map<string, Entry> TargetMap;
 
-    vespalib::Lock _lock;
-    TargetMap      _targets;
-    ITimer::UP     _timer;
-    uint64_t       _expireMillis;
+    /**
+     * Targets are spread over a number of independently locked shards by the
+     * hash of their connection spec, so that threads sending to different
+     * targets rarely contend for the same lock.
+     */
+    struct Shard {
+        vespalib::Lock _lock;
+        TargetMap      _targets;
+
+        Shard();
+        ~Shard();
+    };
+
+    std::vector<std::unique_ptr<Shard>> _shards;
+    ITimer::UP                          _timer;
+    uint64_t                            _expireMillis;
+
+    Shard &getShard(const string &spec);
+    void flushShard(Shard &shard, uint64_t currentTime, bool force);
 
 public:
     RPCTargetPool(const RPCTargetPool &) = delete;
@@ -45,8 +62,9 @@ public:
      *
      * @param expireSecs The number of seconds until an idle connection is
      *                   closed.
+     * @param numShards  The number of independently locked target shards.
      */
-    RPCTargetPool(double expireSecs);
+    RPCTargetPool(double expireSecs, uint32_t numShards = 1);
 
     /**
      * Constructs a new instance of this class, using the given {@link Timer}
@@ -56,8 +74,9 @@ public:
      * @param timer      The timer to use for connection expiration.
      * @param expireSecs The number of seconds until an idle connection is
      *                   closed.
+     * @param numShards  The number of independently locked target shards.
      */
-    RPCTargetPool(ITimer::UP timer, double expireSecs);
+    RPCTargetPool(ITimer::UP timer, double expireSecs, uint32_t numShards = 1);
 
     /**
      * Destructor. Frees any allocated resources.
@@ -89,7 +108,7 @@ public:
     /**
      * Returns the number of targets currently contained in this.
      *
-     * @return The size of the internal map.
+     * @return The total size of the internal maps.
      */
     size_t size();
 };
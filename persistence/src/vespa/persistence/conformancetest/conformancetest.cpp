@@ -565,6 +565,35 @@ void ConformanceTest::testPut() {
     }
 }
 
+void ConformanceTest::testPutMultiple() {
+    document::TestDocMan testDocMan;
+    _factory->clear();
+    PersistenceProvider::UP spi(getSpi(*_factory, testDocMan));
+    Context context(defaultLoadType, Priority(0), Trace::TraceLevel(0));
+
+    Bucket bucket(makeSpiBucket(BucketId(8, 0x01)));
+    PutBatch puts;
+    for (uint32_t i = 0; i < 3; ++i) {
+        puts.emplace_back(Timestamp(i + 1), testDocMan.createRandomDocumentAtLocation(0x01, i));
+    }
+    spi->createBucket(bucket, context);
+
+    std::vector<Result> results = spi->putMultiple(bucket, puts, context);
+    CPPUNIT_ASSERT_EQUAL(puts.size(), results.size());
+    for (const Result& result : results) {
+        CPPUNIT_ASSERT_EQUAL(Result(), result);
+    }
+    spi->flush(bucket, context);
+
+    const BucketInfo info = spi->getBucketInfo(bucket).getBucketInfo();
+    CPPUNIT_ASSERT_EQUAL(3, (int)info.getDocumentCount());
+    for (const auto& put : puts) {
+        GetResult gr = spi->get(bucket, document::AllFields(), put.second->getId(), context);
+        CPPUNIT_ASSERT_EQUAL(Result::NONE, gr.getErrorCode());
+        CPPUNIT_ASSERT_EQUAL(put.first, gr.getTimestamp());
+    }
+}
+
 void ConformanceTest::testPutNewDocumentVersion() {
     document::TestDocMan testDocMan;
     _factory->clear();
@@ -17,6 +17,7 @@
 #define DEFINE_CONFORMANCE_TESTS() \
     CPPUNIT_TEST(testBasics); \
     CPPUNIT_TEST(testPut); \
+    CPPUNIT_TEST(testPutMultiple); \
     CPPUNIT_TEST(testPutNewDocumentVersion); \
     CPPUNIT_TEST(testPutOlderDocumentVersion); \
     CPPUNIT_TEST(testPutDuplicate); \
@@ -222,6 +223,7 @@ public:
 
     /** Test that the various document operations work as intended. */
     void testPut();
+    void testPutMultiple();
     void testPutNewDocumentVersion();
     void testPutOlderDocumentVersion();
     void testPutDuplicate();
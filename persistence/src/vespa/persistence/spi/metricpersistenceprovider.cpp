@@ -49,7 +49,7 @@ Impl::ResultMetrics::ResultMetrics(const char* opName)
 Impl::MetricPersistenceProvider(PersistenceProvider& next)
     : metrics::MetricSet("spi", "", ""),
       _next(&next),
-      _functionMetrics(23)
+      _functionMetrics(24)
 {
     defineResultMetrics(0, "initialize");
     defineResultMetrics(1, "getPartitionStates");
@@ -74,6 +74,7 @@ Impl::MetricPersistenceProvider(PersistenceProvider& next)
     defineResultMetrics(20, "split");
     defineResultMetrics(21, "join");
     defineResultMetrics(22, "move");
+    defineResultMetrics(23, "putMultiple");
 }
 
 Impl::~MetricPersistenceProvider() { }
@@ -150,6 +151,23 @@ Impl::put(const Bucket& v1, Timestamp v2, const DocumentSP& v3, Context& v4)
     return r;
 }
 
+std::vector<Result>
+Impl::putMultiple(const Bucket& v1, const PutBatch& v2, Context& v3)
+{
+    PRE_PROCESS(23);
+    std::vector<Result> r(_next->putMultiple(v1, v2, v3));
+    // Report the batch once, as failed if any of its puts failed.
+    Result batchResult;
+    for (const Result& result : r) {
+        if (result.hasError()) {
+            batchResult = result;
+            break;
+        }
+    }
+    POST_PROCESS(23, batchResult);
+    return r;
+}
+
 RemoveResult
 Impl::remove(const Bucket& v1, Timestamp v2, const DocumentId& v3, Context& v4)
 {
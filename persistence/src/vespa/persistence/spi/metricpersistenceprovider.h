@@ -39,6 +39,7 @@ public:
     Result setActiveState(const Bucket&, BucketInfo::ActiveState) override;
     BucketInfoResult getBucketInfo(const Bucket&) const override;
     Result put(const Bucket&, Timestamp, const DocumentSP&, Context&) override;
+    std::vector<Result> putMultiple(const Bucket&, const PutBatch&, Context&) override;
     RemoveResult remove(const Bucket&, Timestamp, const DocumentId&, Context&) override;
     RemoveResult removeIfFound(const Bucket&, Timestamp, const DocumentId&, Context&) override;
     Result removeEntry(const Bucket&, Timestamp, Context&) override;
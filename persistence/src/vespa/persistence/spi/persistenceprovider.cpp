@@ -7,6 +7,17 @@ namespace spi {
 
 PersistenceProvider::~PersistenceProvider() { }
 
+std::vector<Result>
+PersistenceProvider::putMultiple(const Bucket& bucket, const PutBatch& puts, Context& context)
+{
+    std::vector<Result> results;
+    results.reserve(puts.size());
+    for (const auto& put : puts) {
+        results.push_back(this->put(bucket, put.first, put.second, context));
+    }
+    return results;
+}
+
 } // spi
 } // storage
 
@@ -113,6 +113,15 @@ struct PersistenceProvider
      */
     virtual Result put(const Bucket&, Timestamp, const DocumentSP&, Context&) = 0;
 
+    /**
+     * Store the given documents, all belonging to the given bucket, at their
+     * given microsecond times. Returns one result per document, in the same
+     * order as the documents were given. The default implementation calls
+     * put() for each document in turn; providers that can overlap or
+     * amortize the work of multiple puts should override it.
+     */
+    virtual std::vector<Result> putMultiple(const Bucket&, const PutBatch&, Context&);
+
     /**
      * This remove function assumes that there exist something to be removed.
      * The data to be removed may not exist on this node though, so all remove
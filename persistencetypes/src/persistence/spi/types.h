@@ -98,6 +98,7 @@ using DocumentUP = std::unique_ptr<document::Document>;
 using DocumentIdUP = std::unique_ptr<document::DocumentId>;
 using DocumentSP = std::shared_ptr<document::Document>;
 using DocumentUpdateSP = std::shared_ptr<document::DocumentUpdate>;
+using PutBatch = std::vector<std::pair<Timestamp, DocumentSP>>;
 
 enum IncludedVersions {
     NEWEST_DOCUMENT_ONLY,
@@ -13,9 +13,14 @@ Config::Config() :
     _enableOnlyBitVector(false),
     _isFilter(false),
     _fastAccess(false),
+    _packed(false),
+    _mmapLoad(false),
+    _hashDictionary(false),
+    _hugePages(false),
     _growStrategy(),
     _compactionStrategy(),
     _predicateParams(),
+    _hnswIndexParams(),
     _tensorType(vespalib::eval::ValueType::error_type())
 {
 }
@@ -32,9 +37,14 @@ Config::Config(BasicType bt,
       _enableOnlyBitVector(false),
       _isFilter(false),
       _fastAccess(false),
+      _packed(false),
+      _mmapLoad(false),
+      _hashDictionary(false),
+      _hugePages(false),
       _growStrategy(),
       _compactionStrategy(),
       _predicateParams(),
+      _hnswIndexParams(),
       _tensorType(vespalib::eval::ValueType::error_type())
 {
 }
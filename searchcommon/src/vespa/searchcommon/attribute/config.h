@@ -4,6 +4,7 @@
 
 #include "basictype.h"
 #include "collectiontype.h"
+#include "hnsw_index_params.h"
 #include "predicate_params.h"
 #include <vespa/searchcommon/common/growstrategy.h>
 #include <vespa/searchcommon/common/compaction_strategy.h>
@@ -27,6 +28,7 @@ public:
     bool fastSearch()                     const { return _fastSearch; }
     bool huge()                           const { return _huge; }
     const PredicateParams &predicateParams() const { return _predicateParams; }
+    const HnswIndexParams &hnswIndexParams() const { return _hnswIndexParams; }
     vespalib::eval::ValueType tensorType() const { return _tensorType; }
 
     /**
@@ -49,11 +51,38 @@ public:
      */
     bool fastAccess() const { return _fastAccess; }
 
+    /**
+     * Check if a single value integer attribute should store its values
+     * frame-of-reference encoded in blocks of documents.
+     */
+    bool packed() const { return _packed; }
+
+    /**
+     * Check if a single value numeric attribute without fast-search should
+     * be loaded by mapping its saved data file into memory instead of
+     * copying it. The file must not be rewritten in place while loaded.
+     */
+    bool mmapLoad() const { return _mmapLoad; }
+
+    /**
+     * Check if an enumerated attribute should maintain a hash index in
+     * its dictionary for term lookups. Range and prefix lookups still
+     * use the ordered dictionary.
+     */
+    bool hashDictionary() const { return _hashDictionary; }
+
+    /**
+     * Check if the large buffers of the attribute should be aligned to
+     * and backed by huge pages.
+     */
+    bool hugePages() const { return _hugePages; }
+
     const GrowStrategy & getGrowStrategy() const { return _growStrategy; }
     const CompactionStrategy &getCompactionStrategy() const { return _compactionStrategy; }
     void setHuge(bool v)                         { _huge = v; }
     void setFastSearch(bool v)                   { _fastSearch = v; }
     void setPredicateParams(const PredicateParams &v) { _predicateParams = v; }
+    void setHnswIndexParams(const HnswIndexParams &v) { _hnswIndexParams = v; }
     void setTensorType(const vespalib::eval::ValueType &tensorType_in) {
         _tensorType = tensorType_in;
     }
@@ -84,6 +113,10 @@ public:
     }
 
     void setFastAccess(bool v) { _fastAccess = v; }
+    void setPacked(bool v) { _packed = v; }
+    void setMmapLoad(bool v) { _mmapLoad = v; }
+    void setHashDictionary(bool v) { _hashDictionary = v; }
+    void setHugePages(bool v) { _hugePages = v; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config &setCompactionStrategy(const CompactionStrategy &compactionStrategy) { _compactionStrategy = compactionStrategy; return *this; }
     bool operator!=(const Config &b) const { return !(operator==(b)); }
@@ -99,9 +132,14 @@ public:
                _enableOnlyBitVector == b._enableOnlyBitVector &&
                _isFilter == b._isFilter &&
                _fastAccess == b._fastAccess &&
+               _packed == b._packed &&
+               _mmapLoad == b._mmapLoad &&
+               _hashDictionary == b._hashDictionary &&
+               _hugePages == b._hugePages &&
                _growStrategy == b._growStrategy &&
                _compactionStrategy == b._compactionStrategy &&
                _predicateParams == b._predicateParams &&
+               _hnswIndexParams == b._hnswIndexParams &&
             (_basicType.type() != BasicType::Type::TENSOR ||
              _tensorType == b._tensorType);
     }
@@ -115,9 +153,14 @@ private:
     bool           _enableOnlyBitVector;
     bool           _isFilter;
     bool           _fastAccess;
+    bool           _packed;
+    bool           _mmapLoad;
+    bool           _hashDictionary;
+    bool           _hugePages;
     GrowStrategy   _growStrategy;
     CompactionStrategy _compactionStrategy;
     PredicateParams    _predicateParams;
+    HnswIndexParams    _hnswIndexParams;
     vespalib::eval::ValueType _tensorType;
 };
 }  // namespace attribute
@@ -0,0 +1,42 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+
+namespace search {
+namespace attribute {
+
+/*
+ * Parameters for the hnsw nearest neighbor index of dense tensor attributes.
+ */
+class HnswIndexParams
+{
+    bool _enabled;
+    uint32_t _max_links_per_node;
+    uint32_t _neighbors_to_explore_at_insert;
+public:
+    HnswIndexParams()
+        : _enabled(false),
+          _max_links_per_node(16),
+          _neighbors_to_explore_at_insert(200)
+    {
+    }
+
+    bool enabled() const { return _enabled; }
+    /* Max number of links per node on the upper levels, twice this on level 0 */
+    uint32_t max_links_per_node() const { return _max_links_per_node; }
+    /* Number of candidates to explore when finding the neighbors of a new node */
+    uint32_t neighbors_to_explore_at_insert() const { return _neighbors_to_explore_at_insert; }
+    void setEnabled(bool v) { _enabled = v; }
+    void setMaxLinksPerNode(uint32_t v) { _max_links_per_node = v; }
+    void setNeighborsToExploreAtInsert(uint32_t v) { _neighbors_to_explore_at_insert = v; }
+    bool operator==(const HnswIndexParams &rhs) const {
+        return ((_enabled == rhs._enabled) &&
+                (_max_links_per_node == rhs._max_links_per_node) &&
+                (_neighbors_to_explore_at_insert == rhs._neighbors_to_explore_at_insert));
+    }
+};
+
+}  // namespace attribute
+}  // namespace search
@@ -134,6 +134,49 @@ public:
      **/
     virtual EnumHandle getEnum(DocId doc)   const = 0;
 
+    /**
+     * Returns the first value stored for each of the given documents as
+     * an integer. Implementations may override this to read all values in
+     * one tight loop instead of making one virtual call per document.
+     *
+     * @param docIds the document identifiers
+     * @param numDocs the number of documents
+     * @param values buffer receiving one value per document
+     **/
+    virtual void getIntBatch(const DocId * docIds, uint32_t numDocs, largeint_t * values) const {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            values[i] = getInt(docIds[i]);
+        }
+    }
+
+    /**
+     * Returns the first value stored for each of the given documents as
+     * a floating point number. See getIntBatch.
+     *
+     * @param docIds the document identifiers
+     * @param numDocs the number of documents
+     * @param values buffer receiving one value per document
+     **/
+    virtual void getFloatBatch(const DocId * docIds, uint32_t numDocs, double * values) const {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            values[i] = getFloat(docIds[i]);
+        }
+    }
+
+    /**
+     * Returns the first value stored for each of the given documents as
+     * an enum value. See getIntBatch.
+     *
+     * @param docIds the document identifiers
+     * @param numDocs the number of documents
+     * @param values buffer receiving one value per document
+     **/
+    virtual void getEnumBatch(const DocId * docIds, uint32_t numDocs, EnumHandle * values) const {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            values[i] = getEnum(docIds[i]);
+        }
+    }
+
     /**
      * Copies the values stored for the given document into the given buffer.
      *
@@ -14,22 +14,28 @@ class CompactionStrategy
 private:
     double _maxDeadBytesRatio; // Max ratio of dead bytes before compaction
     double _maxDeadAddressSpaceRatio; // Max ratio of dead address space before compaction
+    uint32_t _maxCompactRefsPerStep; // Max refs moved per compaction step, 0 means no limit
 public:
     CompactionStrategy()
         : _maxDeadBytesRatio(0.2),
-          _maxDeadAddressSpaceRatio(0.2)
+          _maxDeadAddressSpaceRatio(0.2),
+          _maxCompactRefsPerStep(0u)
     {
     }
-    CompactionStrategy(double maxDeadBytesRatio, double maxDeadAddressSpaceRatio)
+    CompactionStrategy(double maxDeadBytesRatio, double maxDeadAddressSpaceRatio,
+                       uint32_t maxCompactRefsPerStep = 0u)
         : _maxDeadBytesRatio(maxDeadBytesRatio),
-          _maxDeadAddressSpaceRatio(maxDeadAddressSpaceRatio)
+          _maxDeadAddressSpaceRatio(maxDeadAddressSpaceRatio),
+          _maxCompactRefsPerStep(maxCompactRefsPerStep)
     {
     }
     double getMaxDeadBytesRatio() const { return _maxDeadBytesRatio; }
     double getMaxDeadAddressSpaceRatio() const { return _maxDeadAddressSpaceRatio; }
+    uint32_t getMaxCompactRefsPerStep() const { return _maxCompactRefsPerStep; }
     bool operator==(const CompactionStrategy & rhs) const {
         return _maxDeadBytesRatio == rhs._maxDeadBytesRatio &&
-            _maxDeadAddressSpaceRatio == rhs._maxDeadAddressSpaceRatio;
+            _maxDeadAddressSpaceRatio == rhs._maxDeadAddressSpaceRatio &&
+            _maxCompactRefsPerStep == rhs._maxCompactRefsPerStep;
     }
     bool operator!=(const CompactionStrategy & rhs) const { return !(operator==(rhs)); }
 };
@@ -0,0 +1,521 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/config/helper/configgetter.hpp>
+#include <vespa/config-bucketspaces.h>
+#include <vespa/document/bucket/fixed_bucket_spaces.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/bytefieldvalue.h>
+#include <vespa/document/fieldvalue/doublefieldvalue.h>
+#include <vespa/document/fieldvalue/floatfieldvalue.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/longfieldvalue.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/update/assignvalueupdate.h>
+#include <vespa/document/update/documentupdate.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/fastos/app.h>
+#include <vespa/searchcore/proton/common/hw_info.h>
+#include <vespa/searchcore/proton/matching/querylimiter.h>
+#include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
+#include <vespa/searchcore/proton/metrics/metricswireservice.h>
+#include <vespa/searchcore/proton/reference/document_db_reference_registry.h>
+#include <vespa/searchcore/proton/server/bootstrapconfig.h>
+#include <vespa/searchcore/proton/server/documentdb.h>
+#include <vespa/searchcore/proton/server/documentdbconfigmanager.h>
+#include <vespa/searchcore/proton/server/idocumentdbowner.h>
+#include <vespa/searchcore/proton/server/memoryconfigstore.h>
+#include <vespa/searchcore/proton/server/persistencehandlerproxy.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/transactionlog/translogserver.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <random>
+
+#include <vespa/log/log.h>
+LOG_SETUP("vespa-proton-feed-bench");
+
+using namespace proton;
+using cloud::config::filedistribution::FiledistributorrpcConfig;
+using document::Document;
+using document::DocumentId;
+using document::DocumentType;
+using document::DocumentTypeRepo;
+using document::DocumentUpdate;
+using document::DocumenttypesConfig;
+using document::Field;
+using search::TuneFileDocumentDB;
+using search::index::DummyFileHeaderContext;
+using search::transactionlog::TransLogServer;
+using vespa::config::content::core::BucketspacesConfig;
+using vespa::config::search::core::ProtonConfig;
+using vespa::config::search::core::ProtonConfigBuilder;
+using vespalib::make_string;
+
+namespace {
+
+using steady_clock = std::chrono::steady_clock;
+
+struct Params {
+    vespalib::string configDir;
+    vespalib::string docType;
+    vespalib::string baseDir;
+    vespalib::string dumpDir;
+    vespalib::string updateField;
+    uint32_t         numDocs;
+    uint32_t         window;
+    uint32_t         syncInterval;
+    uint32_t         indexingThreads;
+    double           visibilityDelay;
+    int              tlsPort;
+    bool             updates;
+    bool             removes;
+    Params()
+        : configDir(), docType(), baseDir("feed-bench"), dumpDir(), updateField(),
+          numDocs(100000), window(1000), syncInterval(0), indexingThreads(1),
+          visibilityDelay(0.0), tlsPort(19599), updates(false), removes(false)
+    {}
+};
+
+struct BenchDBOwner : IDocumentDBOwner {
+    std::shared_ptr<IDocumentDBReferenceRegistry> _registry;
+    vespalib::eval::ConstantTensorLoader _tensorLoader;
+
+    BenchDBOwner()
+        : _registry(std::make_shared<DocumentDBReferenceRegistry>()),
+          _tensorLoader(vespalib::tensor::DefaultTensorEngine::ref())
+    {}
+    bool isInitializing() const override { return false; }
+    uint32_t getDistributionKey() const override { return -1; }
+    std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const override {
+        return _registry;
+    }
+    const vespalib::eval::ConstantValueFactory &getConstantValueFactory() const override {
+        return _tensorLoader;
+    }
+};
+
+/**
+ * Limits the number of operations in flight and collects the latency
+ * from an operation is handed to the feed handler until it is acked.
+ **/
+class PendingOps
+{
+private:
+    std::mutex              _lock;
+    std::condition_variable _cond;
+    uint32_t                _window;
+    uint32_t                _pending;
+    std::vector<double>     _latencies; // ms
+    size_t                  _errors;
+
+public:
+    PendingOps(uint32_t window) : _lock(), _cond(), _window(window), _pending(0), _latencies(), _errors(0) {}
+    void begin() {
+        std::unique_lock<std::mutex> guard(_lock);
+        _cond.wait(guard, [this]() { return _pending < _window; });
+        ++_pending;
+    }
+    void done(double latencyMs, bool ok) {
+        std::lock_guard<std::mutex> guard(_lock);
+        _latencies.push_back(latencyMs);
+        if (!ok) {
+            ++_errors;
+        }
+        --_pending;
+        _cond.notify_all();
+    }
+    void waitIdle() {
+        std::unique_lock<std::mutex> guard(_lock);
+        _cond.wait(guard, [this]() { return _pending == 0; });
+    }
+    std::vector<double> takeLatencies() {
+        std::lock_guard<std::mutex> guard(_lock);
+        std::vector<double> result;
+        result.swap(_latencies);
+        return result;
+    }
+    size_t takeErrors() {
+        std::lock_guard<std::mutex> guard(_lock);
+        size_t result = _errors;
+        _errors = 0;
+        return result;
+    }
+};
+
+/**
+ * Transport for a single operation; the feed token acks through it
+ * when the operation is done.
+ **/
+struct OpTransport : feedtoken::ITransport {
+    PendingOps              *pending;
+    steady_clock::time_point start;
+    OpTransport() : pending(nullptr), start() {}
+    void send(ResultUP result, bool) override {
+        double ms = std::chrono::duration<double, std::milli>(steady_clock::now() - start).count();
+        pending->done(ms, !result->hasError());
+    }
+};
+
+double
+percentile(const std::vector<double> &sorted, double per)
+{
+    size_t idx = std::min(sorted.size() - 1, (size_t)((sorted.size() - 1) * (per / 100.0) + 0.5));
+    return sorted[idx];
+}
+
+void
+reportExecutor(const char *name, const vespalib::ExecutorStats &stats)
+{
+    fprintf(stdout, "  %-22s tasks: %8zu  utilization: %5.3f  cpu: %5.3f  avg wait: %8.3f ms  p99 run: %8.3f ms\n",
+            name, stats.executedTasks, stats.getUtilization(), stats.getCpuUtilization(),
+            stats.getAverageWaitTime() * 1000.0, stats.getRunTimePercentile(0.99) * 1000.0);
+}
+
+void
+reportPhase(const char *phase, double elapsedSec, std::vector<double> latencies, size_t errors,
+            const ExecutorThreadingServiceStats &stats)
+{
+    std::sort(latencies.begin(), latencies.end());
+    fprintf(stdout, "%s:\n", phase);
+    fprintf(stdout, "  operations: %zu\n", latencies.size());
+    fprintf(stdout, "  errors: %zu\n", errors);
+    fprintf(stdout, "  elapsed: %.3f s\n", elapsedSec);
+    fprintf(stdout, "  throughput: %.2f ops/s\n", (elapsedSec > 0.0) ? (latencies.size() / elapsedSec) : 0.0);
+    if (!latencies.empty()) {
+        fprintf(stdout, "  latency (ms): min %.3f, 50%% %.3f, 90%% %.3f, 99%% %.3f, max %.3f\n",
+                latencies.front(), percentile(latencies, 50.0), percentile(latencies, 90.0),
+                percentile(latencies, 99.0), latencies.back());
+    }
+    fprintf(stdout, "  executors:\n");
+    reportExecutor("master", stats.getMasterExecutorStats());
+    reportExecutor("index", stats.getIndexExecutorStats());
+    reportExecutor("summary", stats.getSummaryExecutorStats());
+    reportExecutor("index field inverter", stats.getIndexFieldInverterExecutorStats());
+    reportExecutor("index field writer", stats.getIndexFieldWriterExecutorStats());
+    reportExecutor("attribute field writer", stats.getAttributeFieldWriterExecutorStats());
+}
+
+/**
+ * Documents with random values in the string and numeric fields of
+ * the document type. Other fields are left empty.
+ **/
+std::vector<Document::SP>
+makeDocuments(const DocumentType &docType, uint32_t numDocs)
+{
+    std::mt19937 rnd(42);
+    std::uniform_int_distribution<int> word(0, 9999);
+    std::vector<Document::SP> docs;
+    docs.reserve(numDocs);
+    Field::Set fields = docType.getFieldSet();
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        auto doc = std::make_shared<Document>(docType, DocumentId(make_string("id:bench:%s::%u", docType.getName().c_str(), i)));
+        for (const Field *field : fields) {
+            switch (field->getDataType().getId()) {
+            case document::DataType::T_STRING:
+                doc->setValue(*field, document::StringFieldValue(make_string("w%d w%d w%d", word(rnd), word(rnd), word(rnd))));
+                break;
+            case document::DataType::T_INT:
+                doc->setValue(*field, document::IntFieldValue(word(rnd)));
+                break;
+            case document::DataType::T_LONG:
+                doc->setValue(*field, document::LongFieldValue(word(rnd)));
+                break;
+            case document::DataType::T_BYTE:
+                doc->setValue(*field, document::ByteFieldValue(word(rnd) % 128));
+                break;
+            case document::DataType::T_FLOAT:
+                doc->setValue(*field, document::FloatFieldValue(word(rnd) / 100.0));
+                break;
+            case document::DataType::T_DOUBLE:
+                doc->setValue(*field, document::DoubleFieldValue(word(rnd) / 100.0));
+                break;
+            default:
+                break;
+            }
+        }
+        docs.push_back(doc);
+    }
+    return docs;
+}
+
+bool
+readFile(const vespalib::string &name, std::vector<char> &buf)
+{
+    std::ifstream in(name.c_str(), std::ios::binary);
+    if (!in) {
+        return false;
+    }
+    buf.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return true;
+}
+
+/**
+ * Documents serialized by vespa-dump-feed; doc.idx holds the size of
+ * each document in doc.dat.
+ **/
+bool
+loadDocuments(const DocumentTypeRepo &repo, const vespalib::string &dir, std::vector<Document::SP> &docs)
+{
+    std::vector<char> idx;
+    std::vector<char> dat;
+    if (!readFile(dir + "/doc.idx", idx) || !readFile(dir + "/doc.dat", dat)) {
+        return false;
+    }
+    vespalib::nbostream idxStream(idx.data(), idx.size());
+    size_t offset = 0;
+    while (idxStream.size() >= sizeof(uint64_t)) {
+        uint64_t size = 0;
+        idxStream >> size;
+        if (offset + size > dat.size()) {
+            return false;
+        }
+        vespalib::nbostream docStream(dat.data() + offset, size);
+        docs.push_back(std::make_shared<Document>(repo, docStream));
+        offset += size;
+    }
+    return true;
+}
+
+storage::spi::Bucket
+getBucket(const DocumentId &id)
+{
+    document::BucketId bucketId(16, id.getGlobalId().convertToBucketId().getRawId());
+    return storage::spi::Bucket(document::Bucket(document::FixedBucketSpaces::default_space(), bucketId.stripUnused()),
+                                storage::spi::PartitionId(0));
+}
+
+} // namespace <unnamed>
+
+class App : public FastOS_Application
+{
+private:
+    Params _params;
+
+    void usage();
+    bool parseOpts();
+    std::shared_ptr<ProtonConfig> makeProtonConfig() const;
+
+public:
+    int Main() override;
+};
+
+void
+App::usage()
+{
+    fprintf(stderr, "Benchmark the feed path of a single document db, below the persistence and network layers.\n");
+    fprintf(stderr, "usage: %s [options] <config-dir> <document-type>\n", _argv[0]);
+    fprintf(stderr, "  config-dir: document db config files (documenttypes, attributes, indexschema, summary, ...)\n");
+    fprintf(stderr, "options:\n");
+    fprintf(stderr, "  -b dir      base directory for the document db and transaction log (default 'feed-bench')\n");
+    fprintf(stderr, "  -d dir      feed documents dumped by vespa-dump-feed instead of synthetic documents\n");
+    fprintf(stderr, "  -n docs     number of synthetic documents (default 100000)\n");
+    fprintf(stderr, "  -w window   max operations in flight (default 1000)\n");
+    fprintf(stderr, "  -U          update all documents after feeding them\n");
+    fprintf(stderr, "  -f field    field assigned by the updates (default first field with a value)\n");
+    fprintf(stderr, "  -R          remove all documents at the end\n");
+    fprintf(stderr, "  -s ops      sync the transaction log every 'ops' operations (default never)\n");
+    fprintf(stderr, "  -v seconds  visibility delay (default 0)\n");
+    fprintf(stderr, "  -t threads  indexing threads (default 1)\n");
+    fprintf(stderr, "  -p port     transaction log server port (default 19599)\n");
+}
+
+bool
+App::parseOpts()
+{
+    char c = '?';
+    const char *optArg = NULL;
+    int optInd = 0;
+    while ((c = GetOpt("b:d:n:w:Uf:Rs:v:t:p:h", optArg, optInd)) != -1) {
+        switch (c) {
+        case 'b':
+            _params.baseDir = optArg;
+            break;
+        case 'd':
+            _params.dumpDir = optArg;
+            break;
+        case 'n':
+            _params.numDocs = atoi(optArg);
+            break;
+        case 'w':
+            _params.window = std::max(1, atoi(optArg));
+            break;
+        case 'U':
+            _params.updates = true;
+            break;
+        case 'f':
+            _params.updateField = optArg;
+            break;
+        case 'R':
+            _params.removes = true;
+            break;
+        case 's':
+            _params.syncInterval = atoi(optArg);
+            break;
+        case 'v':
+            _params.visibilityDelay = strtod(optArg, nullptr);
+            break;
+        case 't':
+            _params.indexingThreads = std::max(1, atoi(optArg));
+            break;
+        case 'p':
+            _params.tlsPort = atoi(optArg);
+            break;
+        default:
+            return false;
+        }
+    }
+    if (_argc != optInd + 2) {
+        return false;
+    }
+    _params.configDir = _argv[optInd];
+    _params.docType = _argv[optInd + 1];
+    return true;
+}
+
+std::shared_ptr<ProtonConfig>
+App::makeProtonConfig() const
+{
+    ProtonConfigBuilder builder;
+    builder.indexing.threads = _params.indexingThreads;
+    builder.maxvisibilitydelay = std::max(builder.maxvisibilitydelay, _params.visibilityDelay);
+    ProtonConfigBuilder::Documentdb ddb;
+    ddb.inputdoctypename = _params.docType;
+    ddb.configid = _params.docType;
+    ddb.visibilitydelay = _params.visibilityDelay;
+    builder.documentdb.push_back(ddb);
+    return std::make_shared<ProtonConfig>(builder);
+}
+
+int
+App::Main()
+{
+    if (!parseOpts()) {
+        usage();
+        return 1;
+    }
+    config::DirSpec spec(_params.configDir);
+    std::shared_ptr<DocumenttypesConfig> typesConfig(config::ConfigGetter<DocumenttypesConfig>::getConfig("", spec));
+    auto repo = std::make_shared<const DocumentTypeRepo>(*typesConfig);
+    const DocumentType *docType = repo->getDocumentType(_params.docType);
+    if (docType == nullptr) {
+        fprintf(stderr, "error: unknown document type '%s'\n", _params.docType.c_str());
+        return 1;
+    }
+    std::vector<Document::SP> docs;
+    if (!_params.dumpDir.empty()) {
+        if (!loadDocuments(*repo, _params.dumpDir, docs)) {
+            fprintf(stderr, "error: could not load documents from '%s'\n", _params.dumpDir.c_str());
+            return 1;
+        }
+    } else {
+        docs = makeDocuments(*docType, _params.numDocs);
+    }
+    if (docs.empty()) {
+        fprintf(stderr, "error: no documents to feed\n");
+        return 1;
+    }
+    const Field *updateField = nullptr;
+    if (!_params.updateField.empty()) {
+        if (!docType->hasField(_params.updateField)) {
+            fprintf(stderr, "error: unknown update field '%s'\n", _params.updateField.c_str());
+            return 1;
+        }
+        updateField = &docType->getField(_params.updateField);
+    } else {
+        for (const Field *field : docType->getFieldSet()) {
+            if (docs[0]->hasValue(*field)) {
+                updateField = field;
+                break;
+            }
+        }
+    }
+    if (_params.updates && (updateField == nullptr)) {
+        fprintf(stderr, "error: no field to update\n");
+        return 1;
+    }
+
+    vespalib::mkdir(_params.baseDir, false);
+    DummyFileHeaderContext fileHeaderContext;
+    TransLogServer tls("tls", _params.tlsPort, _params.baseDir, fileHeaderContext);
+    std::shared_ptr<ProtonConfig> protonConfig = makeProtonConfig();
+    auto bootstrap = std::make_shared<BootstrapConfig>(1, typesConfig, repo, protonConfig,
+                                                       std::make_shared<FiledistributorrpcConfig>(),
+                                                       std::make_shared<BucketspacesConfig>(),
+                                                       std::make_shared<TuneFileDocumentDB>(), HwInfo());
+    DocumentDBConfigHelper mgr(spec, _params.docType);
+    mgr.forwardConfig(bootstrap);
+    mgr.nextGeneration(0);
+    BenchDBOwner owner;
+    DummyWireService wireService;
+    matching::QueryLimiter queryLimiter;
+    vespalib::Clock docDbClock;
+    vespalib::ThreadStackExecutor summaryExecutor(8, 128 * 1024);
+    auto docDb = std::make_shared<DocumentDB>(_params.baseDir, mgr.getConfig(), make_string("tcp/localhost:%d", _params.tlsPort),
+                                              queryLimiter, docDbClock, DocTypeName(_params.docType),
+                                              document::FixedBucketSpaces::default_space(), *protonConfig, owner,
+                                              summaryExecutor, summaryExecutor, tls, wireService, fileHeaderContext,
+                                              std::make_unique<MemoryConfigStore>(),
+                                              std::make_shared<vespalib::ThreadStackExecutor>(16, 128 * 1024), HwInfo());
+    docDb->start();
+    docDb->waitForOnlineState();
+    auto handler = std::make_unique<PersistenceHandlerProxy>(docDb);
+
+    PendingOps pending(_params.window);
+    std::vector<OpTransport> transports(docs.size());
+    uint64_t timestamp = 0;
+    auto runPhase = [&](const char *phase, auto feedOne) {
+        docDb->sampleExecutorStats();
+        auto start = steady_clock::now();
+        for (size_t i = 0; i < docs.size(); ++i) {
+            pending.begin();
+            OpTransport &transport = transports[i];
+            transport.pending = &pending;
+            transport.start = steady_clock::now();
+            feedOne(feedtoken::make(transport), *docs[i], i, storage::spi::Timestamp(++timestamp));
+            if ((_params.syncInterval != 0) && (((i + 1) % _params.syncInterval) == 0)) {
+                docDb->sync(docDb->getCurrentSerialNumber());
+            }
+        }
+        pending.waitIdle();
+        double elapsed = std::chrono::duration<double>(steady_clock::now() - start).count();
+        reportPhase(phase, elapsed, pending.takeLatencies(), pending.takeErrors(), docDb->sampleExecutorStats());
+    };
+    runPhase("put", [&](FeedToken token, const Document &doc, size_t, storage::spi::Timestamp ts) {
+        handler->handlePut(std::move(token), getBucket(doc.getId()), ts, std::make_shared<Document>(doc));
+    });
+    if (_params.updates) {
+        runPhase("update", [&](FeedToken token, const Document &doc, size_t i, storage::spi::Timestamp ts) {
+            // assign the value of the next document, so that the field actually changes
+            document::FieldValue::UP value = docs[(i + 1) % docs.size()]->getValue(*updateField);
+            auto upd = std::make_shared<DocumentUpdate>(*repo, *docType, doc.getId());
+            if (value) {
+                upd->addUpdate(document::FieldUpdate(*updateField).addUpdate(document::AssignValueUpdate(*value)));
+            }
+            handler->handleUpdate(std::move(token), getBucket(doc.getId()), ts, upd);
+        });
+    }
+    if (_params.removes) {
+        runPhase("remove", [&](FeedToken token, const Document &doc, size_t, storage::spi::Timestamp ts) {
+            handler->handleRemove(std::move(token), getBucket(doc.getId()), ts, doc.getId());
+        });
+    }
+    handler.reset();
+    docDb->close();
+    return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+    App app;
+    return app.Entry(argc, argv);
+}
@@ -0,0 +1,356 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/fastos/app.h>
+#include <vespa/fnet/fnet.h>
+#include <vespa/searchlib/common/mapnames.h>
+#include <vespa/searchlib/common/packets.h>
+#include <vespa/searchlib/query/tree/querybuilder.h>
+#include <vespa/searchlib/query/tree/simplequery.h>
+#include <vespa/searchlib/query/tree/stackdumpcreator.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <vespa/log/log.h>
+LOG_SETUP("vespa-proton-query-bench");
+
+using namespace search::fs4transport;
+using search::query::Node;
+using search::query::QueryBuilder;
+using search::query::SimpleQueryNodeTypes;
+using search::query::StackDumpCreator;
+using search::query::Weight;
+using vespalib::make_string;
+
+namespace {
+
+/**
+ * A query ready to be sent to proton; the stack dump of the AND of
+ * all terms on a line in the query file.
+ **/
+struct Query {
+    vespalib::string stackDump;
+    uint32_t         numStackItems;
+};
+
+/**
+ * Each line holds terms separated by space, either 'index:word' or
+ * just 'word' for the default index.
+ **/
+bool
+parseQuery(const std::string &line, Query &query)
+{
+    std::vector<std::pair<std::string, std::string>> terms;
+    std::istringstream in(line);
+    std::string word;
+    while (in >> word) {
+        size_t colon = word.find(':');
+        if ((colon != std::string::npos) && (colon > 0) && (colon + 1 < word.size())) {
+            terms.emplace_back(word.substr(0, colon), word.substr(colon + 1));
+        } else {
+            terms.emplace_back("default", word);
+        }
+    }
+    if (terms.empty()) {
+        return false;
+    }
+    QueryBuilder<SimpleQueryNodeTypes> builder;
+    if (terms.size() > 1) {
+        builder.addAnd(terms.size());
+    }
+    for (size_t i = 0; i < terms.size(); ++i) {
+        builder.addStringTerm(terms[i].second, terms[i].first, i + 1, Weight(100));
+    }
+    Node::UP node = builder.build();
+    query.stackDump = StackDumpCreator::create(*node);
+    query.numStackItems = (terms.size() > 1) ? (terms.size() + 1) : 1;
+    return true;
+}
+
+struct Params {
+    vespalib::string spec;
+    vespalib::string ranking;
+    uint32_t         clients;
+    uint32_t         iterations;
+    uint32_t         maxHits;
+    uint32_t         timeoutMs;
+    bool             traceCost;
+    Params() : spec(), ranking("default"), clients(1), iterations(1), maxHits(10), timeoutMs(5000), traceCost(false) {}
+};
+
+/**
+ * Collects latencies and the per-phase timings reported in the match
+ * trace of the replies, shared by all clients.
+ **/
+class Stats
+{
+private:
+    std::mutex                           _lock;
+    std::vector<double>                  _latencies; // ms
+    size_t                               _errors;
+    std::map<vespalib::string, double>   _trace;     // sum of trace values per name
+    size_t                               _traced;
+
+public:
+    Stats() : _lock(), _latencies(), _errors(0), _trace(), _traced(0) {}
+    void addError() {
+        std::lock_guard<std::mutex> guard(_lock);
+        ++_errors;
+    }
+    void addReply(double latencyMs, const FS4Packet_QUERYRESULTX &reply) {
+        std::lock_guard<std::mutex> guard(_lock);
+        _latencies.push_back(latencyMs);
+        bool traced = false;
+        for (const FS4Properties &props : reply._propsVector) {
+            if (vespalib::stringref(props.getName(), props.getNameLen()) != search::MapNames::TRACE) {
+                continue;
+            }
+            for (uint32_t i = 0; i < props.size(); ++i) {
+                vespalib::string key(props.getKey(i), props.getKeyLen(i));
+                vespalib::string value(props.getValue(i), props.getValueLen(i));
+                _trace[key] += strtod(value.c_str(), nullptr);
+                traced = true;
+            }
+        }
+        if (traced) {
+            ++_traced;
+        }
+    }
+    void report(double elapsedSec);
+};
+
+double
+percentile(const std::vector<double> &sorted, double per)
+{
+    size_t idx = std::min(sorted.size() - 1, (size_t)((sorted.size() - 1) * (per / 100.0) + 0.5));
+    return sorted[idx];
+}
+
+void
+Stats::report(double elapsedSec)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    std::sort(_latencies.begin(), _latencies.end());
+    fprintf(stdout, "queries: %zu\n", _latencies.size());
+    fprintf(stdout, "errors: %zu\n", _errors);
+    fprintf(stdout, "elapsed: %.3f s\n", elapsedSec);
+    fprintf(stdout, "throughput: %.2f q/s\n", (elapsedSec > 0.0) ? (_latencies.size() / elapsedSec) : 0.0);
+    if (_latencies.empty()) {
+        return;
+    }
+    double total = 0.0;
+    for (double latency : _latencies) {
+        total += latency;
+    }
+    fprintf(stdout, "latency (ms):\n");
+    fprintf(stdout, "  min: %.3f\n", _latencies.front());
+    fprintf(stdout, "  avg: %.3f\n", total / _latencies.size());
+    fprintf(stdout, "  max: %.3f\n", _latencies.back());
+    for (double per : {50.0, 90.0, 95.0, 99.0, 99.9}) {
+        fprintf(stdout, "  %g%%: %.3f\n", per, percentile(_latencies, per));
+    }
+    fprintf(stdout, "latency histogram (ms):\n");
+    double limit = 1.0;
+    size_t pos = 0;
+    while (pos < _latencies.size()) {
+        size_t end = std::upper_bound(_latencies.begin() + pos, _latencies.end(), limit) - _latencies.begin();
+        if (end > pos) {
+            fprintf(stdout, "  <= %8g: %zu\n", limit, end - pos);
+        }
+        pos = end;
+        limit *= 2.0;
+    }
+    if (_traced > 0) {
+        fprintf(stdout, "match trace averages over %zu replies:\n", _traced);
+        for (const auto &entry : _trace) {
+            fprintf(stdout, "  %s: %g\n", entry.first.c_str(), entry.second / _traced);
+        }
+    }
+}
+
+/**
+ * Sends the queries one at a time over its own connection, waiting
+ * for each reply before sending the next query.
+ **/
+void
+runClient(FNET_Transport &transport, const Params &params, const std::vector<Query> &queries,
+          uint32_t clientId, Stats &stats)
+{
+    FNET_Connection *conn = transport.Connect(params.spec.c_str(), &FS4PersistentPacketStreamer::Instance);
+    if (conn == nullptr) {
+        LOG(error, "client %u could not connect to '%s'", clientId, params.spec.c_str());
+        return;
+    }
+    FNET_Context ctx;
+    for (uint32_t iter = 0; iter < params.iterations; ++iter) {
+        for (size_t q = 0; q < queries.size(); ++q) {
+            // spread the clients over the query file
+            const Query &query = queries[(q + clientId) % queries.size()];
+            auto packet = new FS4Packet_QUERYX();
+            packet->_features = QF_PARSEDQUERY | QF_RANKP;
+            packet->_offset = 0;
+            packet->_maxhits = params.maxHits;
+            packet->setRanking(params.ranking);
+            packet->setTimeout(fastos::TimeStamp(params.timeoutMs * fastos::TimeStamp::MS));
+            packet->_numStackItems = query.numStackItems;
+            packet->setStackDump(query.stackDump);
+            if (params.traceCost) {
+                packet->_features |= QF_PROPERTIES;
+                packet->_propsVector.resize(1);
+                FS4Properties &rank = packet->_propsVector[0];
+                rank.setName(search::MapNames::RANK);
+                rank.allocEntries(1);
+                rank.setKey(0, "vespa.matching.trace.cost");
+                rank.setValue(0, "true");
+            }
+            FNET_PacketQueue replies;
+            FNET_Channel *channel = conn->OpenChannel(&replies, FNET_Context());
+            if (channel == nullptr) {
+                packet->Free();
+                stats.addError();
+                continue;
+            }
+            auto start = std::chrono::steady_clock::now();
+            channel->Send(packet);
+            FNET_Packet *reply = replies.DequeuePacket(params.timeoutMs + 1000, &ctx);
+            auto end = std::chrono::steady_clock::now();
+            if ((reply != nullptr) && (reply->GetPCODE() == PCODE_QUERYRESULTX)) {
+                double ms = std::chrono::duration<double, std::milli>(end - start).count();
+                stats.addReply(ms, static_cast<FS4Packet_QUERYRESULTX &>(*reply));
+            } else {
+                stats.addError();
+            }
+            if (reply != nullptr) {
+                reply->Free();
+            }
+            channel->CloseAndFree();
+        }
+    }
+    conn->SubRef();
+}
+
+} // namespace <unnamed>
+
+class App : public FastOS_Application
+{
+private:
+    Params _params;
+
+    void usage();
+    bool parseOpts(vespalib::string &queryFile);
+
+public:
+    int Main() override;
+};
+
+void
+App::usage()
+{
+    fprintf(stderr, "Benchmark matching and ranking in proton by sending queries directly to its search port.\n");
+    fprintf(stderr, "usage: %s [options] <spec> <query-file>\n", _argv[0]);
+    fprintf(stderr, "  spec: connect spec of the search port, e.g. tcp/localhost:19108\n");
+    fprintf(stderr, "  query-file: one query per line; terms are 'index:word' or 'word' and are AND'ed\n");
+    fprintf(stderr, "options:\n");
+    fprintf(stderr, "  -c clients     number of concurrent clients (default 1)\n");
+    fprintf(stderr, "  -n iterations  number of passes over the query file per client (default 1)\n");
+    fprintf(stderr, "  -r ranking     rank profile (default 'default')\n");
+    fprintf(stderr, "  -m hits        max hits per query (default 10)\n");
+    fprintf(stderr, "  -t timeout     query timeout in ms (default 5000)\n");
+    fprintf(stderr, "  -T             request the match trace and report per-phase timings\n");
+}
+
+bool
+App::parseOpts(vespalib::string &queryFile)
+{
+    char c = '?';
+    const char *optArg = NULL;
+    int optInd = 0;
+    while ((c = GetOpt("c:n:r:m:t:Th", optArg, optInd)) != -1) {
+        switch (c) {
+        case 'c':
+            _params.clients = std::max(1, atoi(optArg));
+            break;
+        case 'n':
+            _params.iterations = std::max(1, atoi(optArg));
+            break;
+        case 'r':
+            _params.ranking = optArg;
+            break;
+        case 'm':
+            _params.maxHits = atoi(optArg);
+            break;
+        case 't':
+            _params.timeoutMs = atoi(optArg);
+            break;
+        case 'T':
+            _params.traceCost = true;
+            break;
+        default:
+            return false;
+        }
+    }
+    if (_argc != optInd + 2) {
+        return false;
+    }
+    _params.spec = _argv[optInd];
+    queryFile = _argv[optInd + 1];
+    return true;
+}
+
+int
+App::Main()
+{
+    vespalib::string queryFile;
+    if (!parseOpts(queryFile)) {
+        usage();
+        return 1;
+    }
+    std::vector<Query> queries;
+    std::ifstream in(queryFile.c_str());
+    if (!in) {
+        fprintf(stderr, "error: could not open query file '%s'\n", queryFile.c_str());
+        return 1;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        Query query;
+        if (parseQuery(line, query)) {
+            queries.push_back(std::move(query));
+        }
+    }
+    if (queries.empty()) {
+        fprintf(stderr, "error: no queries in '%s'\n", queryFile.c_str());
+        return 1;
+    }
+    FastOS_ThreadPool pool(128 * 1024);
+    FNET_Transport transport;
+    if (!transport.Start(&pool)) {
+        fprintf(stderr, "error: could not start transport\n");
+        return 1;
+    }
+    Stats stats;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    for (uint32_t i = 0; i < _params.clients; ++i) {
+        clients.emplace_back(runClient, std::ref(transport), std::cref(_params), std::cref(queries), i, std::ref(stats));
+    }
+    for (std::thread &client : clients) {
+        client.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    transport.ShutDown(true);
+    stats.report(std::chrono::duration<double>(end - start).count());
+    return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+    App app;
+    return app.Entry(argc, argv);
+}
@@ -6,6 +6,7 @@ LOG_SETUP("randomrow_test");
 #include <vespa/searchcore/fdispatch/search/plain_dataset.h>
 
 using fdispatch::StateOfRows;
+using fdispatch::LatencyEstimate;
 
 TEST("requireThatEmpyStateReturnsRowZero")
 {
@@ -85,4 +86,37 @@ TEST("require randomness")
     EXPECT_EQUAL(333ul, counts[2]);
 }
 
+TEST("requireThatLatencyEstimateTracksAverageAndDeviation")
+{
+    LatencyEstimate e(10);
+    EXPECT_EQUAL(0u, e.getNumSamples());
+    e.update(1.0);
+    EXPECT_EQUAL(1.0, e.getAverage());
+    EXPECT_EQUAL(0.5, e.getDeviation());
+    e.update(2.0);
+    EXPECT_APPROX(1.1, e.getAverage(), 0.000001);
+    EXPECT_APPROX(0.55, e.getDeviation(), 0.000001);
+    EXPECT_APPROX(2.2, e.getTailEstimate(), 0.000001);
+    EXPECT_EQUAL(2u, e.getNumSamples());
+}
+
+TEST("requireThatLaggingNodeIsDetected")
+{
+    LatencyEstimate fast(10);
+    LatencyEstimate slow(10);
+    for (uint32_t i(0); i + 1 < LatencyEstimate::MIN_SAMPLES; i++) {
+        fast.update(0.010);
+        slow.update(0.500);
+    }
+    EXPECT_FALSE(slow.isLaggingBehind(fast));
+    fast.update(0.010);
+    slow.update(0.500);
+    EXPECT_TRUE(slow.isLaggingBehind(fast));
+    EXPECT_FALSE(fast.isLaggingBehind(slow));
+    for (uint32_t i(0); i < 100; i++) {
+        slow.update(0.010);
+    }
+    EXPECT_FALSE(slow.isLaggingBehind(fast));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -374,6 +374,43 @@ TEST_F("testGroupingSession", DoomFixture()) {
 
 }
 
+TEST_F("require that retained grouping session can serve continuation passes again", DoomFixture()) {
+    MyWorld world;
+    world.basicSetup();
+    Grouping request;
+    request.setId(0)
+           .setFirstLevel(0)
+           .setLastLevel(0)
+           .addLevel(createGL(MU<AttributeNode>("attr1"), MU<AttributeNode>("attr2")))
+           .addLevel(createGL(MU<AttributeNode>("attr2"), MU<AttributeNode>("attr3")));
+
+    GroupingContext initContext(f1.clock, f1.timeOfDoom);
+    initContext.addGrouping(GroupingContext::GroupingPtr(new Grouping(request)));
+    GroupingSession session(SessionId("foo"), initContext, world.attributeContext);
+    session.retain(f1.timeOfDoom);
+    RankedHit hits[] = { RankedHit(0, 10.0), RankedHit(1, 20.0), RankedHit(2, 30.0) };
+    session.getGroupingManager().groupInRelevanceOrder(hits, 3);
+    session.continueExecution(initContext);
+    Grouping firstLevel(*initContext.getGroupingList()[0]);
+    EXPECT_EQUAL(3u, firstLevel.getRoot().getChildrenSize());
+
+    auto lastPass = [&]() {
+        GroupingContext context(f1.clock, f1.timeOfDoom);
+        GroupingContext::GroupingPtr r(new Grouping(firstLevel));
+        r->setFirstLevel(1);
+        r->setLastLevel(2);
+        context.addGrouping(r);
+        session.continueExecution(context);
+        EXPECT_EQUAL(3u, r->getRoot().getChildrenSize());
+        EXPECT_EQUAL(1u, r->getRoot().getChild(0).getChildrenSize());
+        return r->asString();
+    };
+    vespalib::string first = lastPass();
+    ASSERT_TRUE(!session.finished());
+    EXPECT_EQUAL(first, lastPass());
+    ASSERT_TRUE(!session.finished());
+}
+
 TEST_F("testEmptySessionId", DoomFixture()) {
     MyWorld world;
     world.basicSetup();
@@ -540,4 +577,20 @@ TEST_F("test session timeout", DoomFixture()) {
     ASSERT_EQUAL(0u, stats.numCached);
 }
 
+TEST_F("require that grouping sessions are kept for the configured time to live", DoomFixture()) {
+    MyWorld world;
+    world.basicSetup();
+    SessionManager mgr(2, 0, fastos::TimeStamp::Seconds(3600));
+    SessionId id1("foo");
+    GroupingContext initContext1(f1.clock, 10);
+    GroupingSession::UP s1(new GroupingSession(id1, initContext1, world.attributeContext));
+    mgr.insert(std::move(s1));
+    mgr.pruneTimedOutSessions(11);
+    SessionManager::Stats stats(mgr.getGroupingStats());
+    ASSERT_EQUAL(1u, stats.numCached);
+    mgr.pruneTimedOutSessions(fastos::TimeStamp::FUTURE);
+    stats = mgr.getGroupingStats();
+    ASSERT_EQUAL(0u, stats.numCached);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
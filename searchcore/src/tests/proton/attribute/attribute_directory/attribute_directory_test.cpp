@@ -220,6 +220,32 @@ TEST_F("Test that we can prune attribute snapshots", Fixture)
     TEST_DO(f.assertSnapshots("foo", "v4"));
 }
 
+TEST_F("Test that pruning keeps full snapshot below delta snapshot", Fixture)
+{
+    auto dir = f.createFooAttrDir();
+    auto writer = dir->getWriter();
+    writer->createInvalidSnapshot(2);
+    writer->markValidSnapshot(2);
+    writer->createInvalidSnapshot(4);
+    writer->markValidSnapshot(4);
+    writer->createInvalidSnapshot(6);
+    writer->markValidDeltaSnapshot(6, 4);
+    writer.reset();
+    EXPECT_EQUAL(6u, dir->getFlushedSerialNum());
+    EXPECT_EQUAL(4u, dir->getFullSnapshotSerialNum());
+    dir->getWriter()->invalidateOldSnapshots();
+    TEST_DO(f.assertSnapshots("foo", "i2,v4,v6"));
+    dir->getWriter()->removeInvalidSnapshots();
+    TEST_DO(f.assertSnapshots("foo", "v4,v6"));
+    writer = dir->getWriter();
+    writer->createInvalidSnapshot(8);
+    writer->markValidSnapshot(8);
+    writer.reset();
+    EXPECT_EQUAL(8u, dir->getFullSnapshotSerialNum());
+    dir->getWriter()->invalidateOldSnapshots();
+    TEST_DO(f.assertSnapshots("foo", "i4,i6,v8"));
+}
+
 TEST_F("Test that attribute directory is not removed if valid snapshots remain", Fixture)
 {
     TEST_DO(f.setupFooSnapshots(20));
@@ -4,6 +4,7 @@
 #include <vespa/searchcommon/attribute/attributecontent.h>
 #include <vespa/searchcommon/attribute/iattributevector.h>
 #include <vespa/searchcore/proton/attribute/attribute_collection_spec_factory.h>
+#include <vespa/searchcore/proton/attribute/attribute_factory.h>
 #include <vespa/searchcore/proton/attribute/attribute_manager_initializer.h>
 #include <vespa/searchcore/proton/attribute/attribute_writer.h>
 #include <vespa/searchcore/proton/attribute/attributemanager.h>
@@ -854,6 +855,42 @@ TEST_F("require that shrink flushtarget is handed over to new attribute manager"
     EXPECT_EQUAL(am1->getShrinker("a1"), am3->getShrinker("a1"));
 }
 
+TEST_F("require that reconfig with shared executor loads attributes in parallel", BaseFixture)
+{
+    vespalib::ThreadStackExecutor sharedExecutor(3, 128 * 1024);
+    AVConfig fastSearch = INT32_SINGLE;
+    fastSearch.setFastSearch(true);
+    {
+        proton::AttributeManager am0(test_dir, "test.subdb", TuneFileAttributes(),
+                                     f._fileHeaderContext, f._attributeFieldWriter, f._hwInfo);
+        fillAttribute(am0.addAttribute({"a1", INT32_SINGLE}, 1), 20, 11, 10);
+        fillAttribute(am0.addAttribute({"a2", fastSearch}, 1), 20, 12, 10);
+        fillAttribute(am0.addAttribute({"a3", INT32_SINGLE}, 1), 20, 13, 10);
+        am0.flushAll(10);
+    }
+    auto am1 = std::make_shared<proton::AttributeManager>
+               (test_dir, "test.subdb", TuneFileAttributes(),
+                f._fileHeaderContext, f._attributeFieldWriter,
+                std::make_shared<proton::AttributeFactory>(), f._hwInfo, &sharedExecutor);
+    AttrSpecList newSpec;
+    newSpec.push_back(AttributeSpec("a1", INT32_SINGLE));
+    newSpec.push_back(AttributeSpec("a2", fastSearch));
+    newSpec.push_back(AttributeSpec("a3", INT32_SINGLE));
+    newSpec.push_back(AttributeSpec("a4", INT32_SINGLE));
+    auto am2 = am1->create(AttrMgrSpec(newSpec, 21, 10));
+    AttributeGuard::UP a1 = am2->getAttribute("a1");
+    AttributeGuard::UP a2 = am2->getAttribute("a2");
+    AttributeGuard::UP a3 = am2->getAttribute("a3");
+    AttributeGuard::UP a4 = am2->getAttribute("a4");
+    EXPECT_EQUAL(21u, (*a1)->getNumDocs());
+    EXPECT_EQUAL(11, (*a1)->getInt(20));
+    EXPECT_EQUAL(12, (*a2)->getInt(20));
+    EXPECT_EQUAL(13, (*a3)->getInt(20));
+    EXPECT_EQUAL(21u, (*a4)->getNumDocs());
+    EXPECT_TRUE(search::attribute::isUndefined<int32_t>((*a4)->getInt(20)));
+    sharedExecutor.sync();
+}
+
 TEST_MAIN()
 {
     vespalib::rmdir(test_dir, true);
@@ -4,15 +4,19 @@
 
 #include <vespa/searchcore/proton/server/idocumentdbowner.h>
 #include <vespa/searchcore/proton/reference/document_db_reference_registry.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/vespalib/stllike/string.h>
 
 namespace proton {
 
 struct DummyDBOwner : IDocumentDBOwner {
     std::shared_ptr<IDocumentDBReferenceRegistry> _registry;
+    vespalib::eval::ConstantTensorLoader _tensorLoader;
 
     DummyDBOwner()
-        : _registry(std::make_shared<DocumentDBReferenceRegistry>())
+        : _registry(std::make_shared<DocumentDBReferenceRegistry>()),
+          _tensorLoader(vespalib::tensor::DefaultTensorEngine::ref())
     {}
     ~DummyDBOwner() {}
 
@@ -22,6 +26,9 @@ struct DummyDBOwner : IDocumentDBOwner {
     std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const override {
         return _registry;
     }
+    const vespalib::eval::ConstantValueFactory &getConstantValueFactory() const override {
+        return _tensorLoader;
+    }
 };
 
 } // namespace proton
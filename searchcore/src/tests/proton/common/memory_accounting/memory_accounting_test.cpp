@@ -0,0 +1,108 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/log/log.h>
+LOG_SETUP("memory_accounting_test");
+
+#include <vespa/searchcore/proton/common/memory_accounting.h>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/testkit/testapp.h>
+
+using namespace proton;
+using search::MemoryUsage;
+using vespalib::Slime;
+
+struct MyReporter : IMemoryAccountingReporter
+{
+    size_t allocated;
+    MyReporter(size_t allocated_in) : allocated(allocated_in) {}
+    void reportMemoryUsage(MemoryAccountingNode &node) const override {
+        node.child("attribute").add(MemoryUsage(allocated, allocated / 2, 10, 5));
+        node.child("index").add(MemoryUsage(100, 50, 0, 0));
+    }
+};
+
+vespalib::string
+toString(const MemoryAccountingNode &node)
+{
+    Slime slime;
+    node.convertToSlime(slime.setObject());
+    return slime.toString();
+}
+
+TEST("require that node total includes usage of children")
+{
+    MemoryAccountingNode root("root");
+    root.add(MemoryUsage(10, 5, 1, 1));
+    root.child("a").add(MemoryUsage(100, 50, 2, 0));
+    root.child("a").child("b").add(MemoryUsage(1000, 500, 0, 3));
+    EXPECT_EQUAL(1u, root.getChildren().size());
+    MemoryUsage total = root.getTotal();
+    EXPECT_EQUAL(1110u, total.allocatedBytes());
+    EXPECT_EQUAL(555u, total.usedBytes());
+    EXPECT_EQUAL(3u, total.deadBytes());
+    EXPECT_EQUAL(4u, total.allocatedBytesOnHold());
+    EXPECT_EQUAL(100u, root.child("a").getOwnUsage().allocatedBytes());
+}
+
+TEST("require that reporters are asked when collecting")
+{
+    MemoryAccountingRegistry registry;
+    MyReporter first(1000);
+    MyReporter second(2000);
+    auto firstRegistration = registry.add("first", first);
+    auto secondRegistration = registry.add("second", second);
+    double seconds = -1.0;
+    MemoryAccountingNode::UP root = registry.collect(seconds);
+    EXPECT_EQUAL(0.0, seconds);
+    EXPECT_EQUAL(3200u, root->getTotal().allocatedBytes());
+    EXPECT_EQUAL(1100u, root->child("first").getTotal().allocatedBytes());
+    EXPECT_EQUAL(2000u, root->child("second").child("attribute").getTotal().allocatedBytes());
+    secondRegistration.reset();
+    root = registry.collect(seconds);
+    EXPECT_EQUAL(1u, root->getChildren().size());
+    EXPECT_EQUAL(1100u, root->getTotal().allocatedBytes());
+}
+
+TEST("require that deltas are relative to the previous collect")
+{
+    MemoryAccountingRegistry registry;
+    MyReporter reporter(1000);
+    auto registration = registry.add("db", reporter);
+    double seconds = 0.0;
+    MemoryAccountingNode::UP root = registry.collect(seconds);
+    EXPECT_EQUAL(
+            "{\n"
+            "    \"allocated\": 1100,\n"
+            "    \"used\": 550,\n"
+            "    \"dead\": 10,\n"
+            "    \"onHold\": 5,\n"
+            "    \"db\": {\n"
+            "        \"allocated\": 1100,\n"
+            "        \"used\": 550,\n"
+            "        \"dead\": 10,\n"
+            "        \"onHold\": 5,\n"
+            "        \"attribute\": {\n"
+            "            \"allocated\": 1000,\n"
+            "            \"used\": 500,\n"
+            "            \"dead\": 10,\n"
+            "            \"onHold\": 5\n"
+            "        },\n"
+            "        \"index\": {\n"
+            "            \"allocated\": 100,\n"
+            "            \"used\": 50,\n"
+            "            \"dead\": 0,\n"
+            "            \"onHold\": 0\n"
+            "        }\n"
+            "    }\n"
+            "}\n",
+            toString(*root));
+    reporter.allocated = 800;
+    root = registry.collect(seconds);
+    EXPECT_TRUE(seconds >= 0.0);
+    Slime slime;
+    root->convertToSlime(slime.setObject());
+    EXPECT_EQUAL(-200, slime.get()["allocatedDelta"].asLong());
+    EXPECT_EQUAL(-200, slime.get()["db"]["attribute"]["allocatedDelta"].asLong());
+    EXPECT_EQUAL(0, slime.get()["db"]["index"]["allocatedDelta"].asLong());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
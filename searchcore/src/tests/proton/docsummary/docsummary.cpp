@@ -30,6 +30,7 @@
 #include <vespa/searchlib/tensor/tensor_attribute.h>
 #include <vespa/searchlib/transactionlog/nosyncproxy.h>
 #include <vespa/searchlib/transactionlog/translogserver.h>
+#include <vespa/searchsummary/docsummary/summaryfieldconverter.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/encoding/base64.h>
 #include <vespa/config-bucketspaces.h>
@@ -322,6 +323,7 @@ private:
                 bool relaxed = false);
 
     void requireThatAdapterHandlesAllFieldTypes();
+    void requireThatAdapterWritesFieldValuesAsConverterWould();
     void requireThatAdapterHandlesMultipleDocuments();
     void requireThatAdapterHandlesDocumentIdField();
     void requireThatDocsumRequestIsProcessed();
@@ -944,6 +946,101 @@ Test::requireThatAnnotationsAreUsed()
                             "dynamicstring", dsa, 1));
 }
 
+void
+Test::requireThatAdapterWritesFieldValuesAsConverterWould()
+{
+    Schema s;
+    s.addSummaryField(Schema::SummaryField("a", schema::DataType::INT8));
+    s.addSummaryField(Schema::SummaryField("b", schema::DataType::INT16));
+    s.addSummaryField(Schema::SummaryField("c", schema::DataType::INT32));
+    s.addSummaryField(Schema::SummaryField("d", schema::DataType::INT64));
+    s.addSummaryField(Schema::SummaryField("e", schema::DataType::FLOAT));
+    s.addSummaryField(Schema::SummaryField("f", schema::DataType::DOUBLE));
+    s.addIndexField(Schema::IndexField("g", schema::DataType::STRING));
+    s.addSummaryField(Schema::SummaryField("g", schema::DataType::STRING));
+    s.addSummaryField(Schema::SummaryField("h", schema::DataType::STRING));
+    s.addSummaryField(Schema::SummaryField("i", schema::DataType::RAW));
+    s.addIndexField(Schema::IndexField("dynamicstring", schema::DataType::STRING));
+    s.addSummaryField(Schema::SummaryField("dynamicstring", schema::DataType::STRING));
+
+    std::string raw("foo");
+    raw += '\0';
+    raw += "bar";
+
+    BuildContext bc(s);
+    bc._bld.startDocument("doc::0");
+    bc._bld.startSummaryField("a").addInt(-128).endField();
+    bc._bld.startSummaryField("b").addInt(-32768).endField();
+    bc._bld.startSummaryField("c").addInt(-2147483648L).endField();
+    bc._bld.startSummaryField("d").addInt(-4294967296L).endField();
+    bc._bld.startSummaryField("e").addFloat(-1234.56).endField();
+    bc._bld.startSummaryField("f").addFloat(-9876.54).endField();
+    bc._bld.startIndexField("g").addStr("foo").addStr("bar").addTermAnnotation("baz").endField();
+    bc._bld.startSummaryField("h").addStr("").endField();
+    bc._bld.startSummaryField("i").addRaw(raw.c_str(), raw.size()).endField();
+    bc._bld.startIndexField("dynamicstring").
+        setAutoAnnotate(false).
+        addStr("foo").
+        addSpan().
+        addAlphabeticTokenAnnotation().
+        addTermAnnotation().
+        addNoWordStr(" ").
+        addSpan().
+        addSpaceTokenAnnotation().
+        addStr("bar").
+        addSpan().
+        addAlphabeticTokenAnnotation().
+        addTermAnnotation("baz").
+        setAutoAnnotate(true).
+        endField();
+    bc.endDocument(0);
+
+    // All fields but the markup field "dynamicstring" are written without
+    // going through SummaryFieldConverter; the output must not change.
+    Document::UP doc = bc._str.read(0, *bc._repo);
+    ASSERT_TRUE(doc.get() != NULL);
+    auto convert = [&](const vespalib::string &name) {
+        bool markup = getMarkupFields().find(name) != getMarkupFields().end();
+        return SummaryFieldConverter::convertSummaryField(markup, *doc->getValue(name));
+    };
+    auto asString = [](const GeneralResultPtr &res, const char *name) {
+        return std::string(res->GetEntry(name)->_stringval, res->GetEntry(name)->_stringlen);
+    };
+
+    DocumentStoreAdapter dsa(bc._str,
+                             *bc._repo,
+                             getResultConfig(), "class0",
+                             bc.createFieldCacheRepo(getResultConfig())->getFieldCache("class0"),
+                             getMarkupFields());
+    GeneralResultPtr res = getResult(dsa, 0);
+    EXPECT_EQUAL(-128, static_cast<int8_t>(res->GetEntry("a")->_intval));
+    EXPECT_EQUAL(convert("a")->getAsInt(), static_cast<int8_t>(res->GetEntry("a")->_intval));
+    EXPECT_EQUAL(-32768, static_cast<int16_t>(res->GetEntry("b")->_intval));
+    EXPECT_EQUAL(convert("b")->getAsInt(), static_cast<int16_t>(res->GetEntry("b")->_intval));
+    EXPECT_EQUAL(-2147483648L, static_cast<int32_t>(res->GetEntry("c")->_intval));
+    EXPECT_EQUAL(convert("c")->getAsInt(), static_cast<int32_t>(res->GetEntry("c")->_intval));
+    EXPECT_EQUAL(-4294967296L, static_cast<int64_t>(res->GetEntry("d")->_int64val));
+    EXPECT_EQUAL(convert("d")->getAsLong(), static_cast<int64_t>(res->GetEntry("d")->_int64val));
+    EXPECT_APPROX(-1234.56, res->GetEntry("e")->_doubleval, 10e-5);
+    EXPECT_EQUAL(convert("e")->getAsDouble(), res->GetEntry("e")->_doubleval);
+    EXPECT_APPROX(-9876.54, res->GetEntry("f")->_doubleval, 10e-5);
+    EXPECT_EQUAL(convert("f")->getAsDouble(), res->GetEntry("f")->_doubleval);
+    EXPECT_EQUAL("foo bar", asString(res, "g"));
+    EXPECT_EQUAL(convert("g")->getAsString(), asString(res, "g"));
+    EXPECT_EQUAL("", asString(res, "h"));
+    EXPECT_EQUAL(convert("h")->getAsString(), asString(res, "h"));
+    EXPECT_EQUAL(raw, std::string(res->GetEntry("i")->_dataval, res->GetEntry("i")->_datalen));
+    std::pair<const char *, size_t> convertedRaw = convert("i")->getAsRaw();
+    EXPECT_EQUAL(std::string(convertedRaw.first, convertedRaw.second),
+                 std::string(res->GetEntry("i")->_dataval, res->GetEntry("i")->_datalen));
+    EXPECT_EQUAL(TERM_EMPTY + "foo" + TERM_SEP +
+                 " " + TERM_SEP +
+                 TERM_ORIG + "bar" + TERM_INDEX + "baz" + TERM_END +
+                 TERM_SEP,
+                 asString(res, "dynamicstring"));
+    EXPECT_EQUAL(convert("dynamicstring")->getAsString(), asString(res, "dynamicstring"));
+}
+
 void
 Test::requireThatUrisAreUsed()
 {
@@ -1304,6 +1401,7 @@ Test::Main()
     }
     TEST_DO(requireThatSummaryAdapterHandlesPutAndRemove());
     TEST_DO(requireThatAdapterHandlesAllFieldTypes());
+    TEST_DO(requireThatAdapterWritesFieldValuesAsConverterWould());
     TEST_DO(requireThatAdapterHandlesMultipleDocuments());
     TEST_DO(requireThatAdapterHandlesDocumentIdField());
     TEST_DO(requireThatDocsumRequestIsProcessed());
@@ -187,6 +187,20 @@ struct VisitRecordingUnitDR : UnitDR {
     }
 };
 
+struct PrefetchRecordingUnitDR : UnitDR {
+    mutable LidVector prefetched_lids;
+
+    PrefetchRecordingUnitDR(document::Document::UP d, Timestamp t, Bucket b, bool r)
+        : UnitDR(std::move(d), t, b, r),
+          prefetched_lids()
+    {
+    }
+
+    void prefetchDocuments(const LidVector &lids) const override {
+        prefetched_lids.insert(prefetched_lids.end(), lids.begin(), lids.end());
+    }
+};
+
 struct AttrUnitDR : public UnitDR
 {
     MockAttributeManager _amgr;
@@ -534,6 +548,31 @@ TEST("require that docid limit is honoured") {
     EXPECT_EQUAL(0u, res.getEntries().size());
 }
 
+TEST("require that prefetch hints the documents in the bucket to the retrievers") {
+    auto inBucket = std::make_shared<PrefetchRecordingUnitDR>(
+            Document::UP(new Document(*DataType::DOCUMENT, DocumentId("doc:foo:1"))), Timestamp(2), bucket(5), false);
+    auto otherBucket = std::make_shared<PrefetchRecordingUnitDR>(
+            Document::UP(new Document(*DataType::DOCUMENT, DocumentId("doc:foo:2"))), Timestamp(3), bucket(6), false);
+    DocumentIterator itr(bucket(5), document::AllFields(), selectAll(), newestV(), -1, false);
+    itr.add(inBucket);
+    itr.add(otherBucket);
+    itr.prefetch();
+    ASSERT_EQUAL(1u, inBucket->prefetched_lids.size());
+    EXPECT_EQUAL(inBucket->docid, inBucket->prefetched_lids[0]);
+    EXPECT_EQUAL(0u, otherBucket->prefetched_lids.size());
+    IterateResult res = itr.iterate(largeNum);
+    EXPECT_EQUAL(1u, res.getEntries().size());
+}
+
+TEST("require that prefetch is skipped for meta-data only iteration") {
+    auto retriever = std::make_shared<PrefetchRecordingUnitDR>(
+            Document::UP(new Document(*DataType::DOCUMENT, DocumentId("doc:foo:1"))), Timestamp(2), bucket(5), false);
+    DocumentIterator itr(bucket(5), document::NoFields(), selectAll(), newestV(), -1, false);
+    itr.add(retriever);
+    itr.prefetch();
+    EXPECT_EQUAL(0u, retriever->prefetched_lids.size());
+}
+
 TEST("require that remove entries can be iterated") {
     DocumentIterator itr(bucket(5), document::AllFields(), selectAll(), newestV(), -1, false);
     itr.add(rem("doc:foo:1", Timestamp(2), bucket(5)));
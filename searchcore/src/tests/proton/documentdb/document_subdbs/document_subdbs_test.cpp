@@ -2,6 +2,8 @@
 
 #include <vespa/config-bucketspaces.h>
 #include <vespa/document/test/make_bucket_space.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/searchcore/proton/attribute/imported_attributes_repo.h>
 #include <vespa/searchcore/proton/bucketdb/bucketdbhandler.h>
 #include <vespa/searchcore/proton/common/hw_info.h>
@@ -224,6 +226,7 @@ struct MySearchableContext
     MyFastAccessContext _fastUpdCtx;
     QueryLimiter _queryLimiter;
     vespalib::Clock _clock;
+    vespalib::eval::ConstantTensorLoader _tensorLoader;
     SearchableContext _ctx;
     MySearchableContext(IThreadingService &writeService,
                         ThreadStackExecutorBase &executor,
@@ -244,7 +247,8 @@ MySearchableContext::MySearchableContext(IThreadingService &writeService, Thread
                                          IBucketDBHandlerInitializer & bucketDBHandlerInitializer)
     : _fastUpdCtx(writeService, executor, bucketDB, bucketDBHandlerInitializer),
       _queryLimiter(), _clock(),
-      _ctx(_fastUpdCtx._ctx, _queryLimiter, _clock, executor)
+      _tensorLoader(vespalib::tensor::DefaultTensorEngine::ref()),
+      _ctx(_fastUpdCtx._ctx, _queryLimiter, _clock, _tensorLoader, executor)
 {}
 MySearchableContext::~MySearchableContext() {}
 
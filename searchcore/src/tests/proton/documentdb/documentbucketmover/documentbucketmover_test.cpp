@@ -98,7 +98,8 @@ struct MyDocumentRetriever : public DocumentRetrieverBaseForTest
 {
     std::shared_ptr<const DocumentTypeRepo> _repo;
     DocumentVector       _docs;
-    MyDocumentRetriever(std::shared_ptr<const DocumentTypeRepo> repo) : _repo(repo), _docs() {
+    mutable uint32_t     _visitCount;
+    MyDocumentRetriever(std::shared_ptr<const DocumentTypeRepo> repo) : _repo(repo), _docs(), _visitCount(0) {
         _docs.push_back(Document::SP()); // lid 0 invalid
     }
     virtual const document::DocumentTypeRepo &getDocumentTypeRepo() const override { return *_repo; }
@@ -108,6 +109,10 @@ struct MyDocumentRetriever : public DocumentRetrieverBaseForTest
     virtual Document::UP getDocument(DocumentIdT lid) const override {
         return Document::UP(_docs[lid]->clone());
     }
+    void visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor, ReadConsistency readConsistency) const override {
+        ++_visitCount;
+        DocumentRetrieverBaseForTest::visitDocuments(lids, visitor, readConsistency);
+    }
 
     virtual CachedSelect::SP
     parseSelect(const vespalib::string &) const override
@@ -291,6 +296,18 @@ TEST_F("require that bucket is cached when IDocumentMoveHandler handles move ope
     EXPECT_FALSE(f._bucketDb.takeGuard()->isCachedBucket(f._source.bucket(1)));
 }
 
+TEST_F("require that documents are read with one document store visit per batch", MoveFixture)
+{
+    f.setupForBucket(f._source.bucket(1), 6, 9);
+    f.moveDocuments(2);
+    EXPECT_EQUAL(2u, f._handler._moves.size());
+    EXPECT_EQUAL(1u, f._source._realRetriever->_visitCount);
+    f.moveDocuments(5);
+    EXPECT_TRUE(f._mover.bucketDone());
+    EXPECT_EQUAL(5u, f._handler._moves.size());
+    EXPECT_EQUAL(2u, f._source._realRetriever->_visitCount);
+}
+
 TEST_F("require that we can move documents in several steps", MoveFixture)
 {
     f.setupForBucket(f._source.bucket(1), 6, 9);
@@ -122,14 +122,16 @@ struct ParamsContext
     DocTypeName                          _docTypeName;
     SearchableFeedView::PersistentParams _params;
 
-    ParamsContext(const vespalib::string &docType, const vespalib::string &baseDir);
+    ParamsContext(const vespalib::string &docType, const vespalib::string &baseDir,
+                  SerialNum flushedDocumentStoreSerialNum = 0);
     ~ParamsContext();
     const SearchableFeedView::PersistentParams &getParams() const { return _params; }
 };
 
-ParamsContext::ParamsContext(const vespalib::string &docType, const vespalib::string &baseDir)
+ParamsContext::ParamsContext(const vespalib::string &docType, const vespalib::string &baseDir,
+                             SerialNum flushedDocumentStoreSerialNum)
     : _docTypeName(docType),
-      _params(0, 0, _docTypeName, subdb_id, SubDbType::READY)
+      _params(0, flushedDocumentStoreSerialNum, _docTypeName, subdb_id, SubDbType::READY)
 {
     (void) baseDir;
 }
@@ -220,15 +222,18 @@ struct MyDocumentStore : public test::DummyDocumentStore
     DocMap           _docs;
     uint64_t         _lastSyncToken;
     uint32_t         _compactLidSpaceLidLimit;
+    mutable uint32_t _readCount;
     MyDocumentStore(const document::DocumentTypeRepo & repo)
         : test::DummyDocumentStore("."),
           _repo(repo),
           _docs(),
           _lastSyncToken(0),
-          _compactLidSpaceLidLimit(0)
+          _compactLidSpaceLidLimit(0),
+          _readCount(0)
     {}
     ~MyDocumentStore() override;
     Document::UP read(DocumentIdT lid, const document::DocumentTypeRepo &) const override {
+        ++_readCount;
         DocMap::const_iterator itr = _docs.find(lid);
         if (itr != _docs.end()) {
             Document::UP retval(itr->second->clone());
@@ -520,7 +525,7 @@ struct FixtureBase
     CommitTimeTracker     _commitTimeTracker;
     SerialNum             serial;
     std::shared_ptr<MyGidToLidChangeHandler> _gidToLidChangeHandler;
-    FixtureBase(TimeStamp visibilityDelay);
+    FixtureBase(TimeStamp visibilityDelay, SerialNum flushedDocumentStoreSerialNum = 0);
 
     virtual ~FixtureBase();
 
@@ -685,7 +690,7 @@ struct FixtureBase
 };
 
 
-FixtureBase::FixtureBase(TimeStamp visibilityDelay)
+FixtureBase::FixtureBase(TimeStamp visibilityDelay, SerialNum flushedDocumentStoreSerialNum)
     : _tracer(),
       sc(),
       iw(new MyIndexWriter(_tracer)),
@@ -697,7 +702,7 @@ FixtureBase::FixtureBase(TimeStamp visibilityDelay)
       _docIdLimit(0u),
       _dmscReal(new DocumentMetaStoreContext(std::make_shared<BucketDBOwner>())),
       _dmsc(new test::DocumentMetaStoreContextObserver(*_dmscReal)),
-      pc(sc._builder->getDocumentType().getName(), "fileconfig_test"),
+      pc(sc._builder->getDocumentType().getName(), "fileconfig_test", flushedDocumentStoreSerialNum),
       _writeServiceReal(),
       _writeService(_writeServiceReal),
       _lidReuseDelayer(_writeService, _dmsc->get()),
@@ -745,8 +750,8 @@ struct SearchableFeedViewFixture : public FixtureBase
 struct FastAccessFeedViewFixture : public FixtureBase
 {
     FastAccessFeedView fv;
-    FastAccessFeedViewFixture(TimeStamp visibilityDelay = 0) :
-        FixtureBase(visibilityDelay),
+    FastAccessFeedViewFixture(TimeStamp visibilityDelay = 0, SerialNum flushedDocumentStoreSerialNum = 0) :
+        FixtureBase(visibilityDelay, flushedDocumentStoreSerialNum),
         fv(StoreOnlyFeedView::Context(sa,
                 sc._schema,
                 _dmsc,
@@ -1093,6 +1098,21 @@ TEST_F("require that update to non fast-access attribute also updates document s
     putDocumentAndUpdate(f, "a1");
 
     EXPECT_EQUAL(2u, f.msa._store._lastSyncToken); // document store updated
+    EXPECT_EQUAL(1u, f.msa._store._readCount);
+    assertAttributeUpdate(2u, DocumentId("doc:test:1"), 1, f.maw);
+}
+
+TEST_F("require that update replayed behind flushed document store does not read document",
+        FastAccessFeedViewFixture(0, 10))
+{
+    DocumentContext dc1 = f.doc1();
+    f.putAndWait(dc1);
+    DocumentContext dc2("doc:test:1", 20, f.getBuilder());
+    dc2.addFieldUpdate(f.getBuilder(), "a1");
+    f.updateAndWait(dc2);
+
+    EXPECT_EQUAL(0u, f.msa._store._lastSyncToken); // document store not updated
+    EXPECT_EQUAL(0u, f.msa._store._readCount);
     assertAttributeUpdate(2u, DocumentId("doc:test:1"), 1, f.maw);
 }
 
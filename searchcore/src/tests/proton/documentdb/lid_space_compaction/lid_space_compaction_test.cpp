@@ -238,10 +238,11 @@ struct JobFixtureBase
                    double resourceLimitFactor = RESOURCE_LIMIT_FACTOR,
                    double interval = JOB_DELAY,
                    bool nodeRetired = false,
-                   uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS)
+                   uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS,
+                   uint32_t maxDocsToMove = 1)
         : _handler(maxOutstandingMoveOps != MAX_OUTSTANDING_MOVE_OPS),
           _job(DocumentDBLidSpaceCompactionConfig(interval,
-                  allowedLidBloat, allowedLidBloatFactor, false, maxDocsToScan),
+                  allowedLidBloat, allowedLidBloatFactor, false, maxDocsToScan, maxDocsToMove),
                _handler, _storer, _frozenHandler, _diskMemUsageNotifier,
                BlockableMaintenanceJobConfig(resourceLimitFactor, maxOutstandingMoveOps),
                _clusterStateHandler, nodeRetired)
@@ -339,9 +340,10 @@ struct JobFixture : public JobFixtureBase {
                double resourceLimitFactor = RESOURCE_LIMIT_FACTOR,
                double interval = JOB_DELAY,
                bool nodeRetired = false,
-               uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS)
+               uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS,
+               uint32_t maxDocsToMove = 1)
         : JobFixtureBase(allowedLidBloat, allowedLidBloatFactor, maxDocsToScan, resourceLimitFactor,
-                         interval, nodeRetired, maxOutstandingMoveOps),
+                         interval, nodeRetired, maxOutstandingMoveOps, maxDocsToMove),
           _jobRunner(_job)
     {}
 };
@@ -419,6 +421,19 @@ TEST_F("require that job returns false when multiple move operations or compacti
     TEST_DO(f.assertJobContext(4, 7, 3, 7, 1));
 }
 
+TEST_F("require that several documents are moved per run when max docs to move is above 1",
+       JobFixture(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, MAX_DOCS_TO_SCAN, RESOURCE_LIMIT_FACTOR,
+                  JOB_DELAY, false, MAX_OUTSTANDING_MOVE_OPS, 2))
+{
+    f.setupThreeDocumentsToCompact();
+    EXPECT_FALSE(f.run());
+    TEST_DO(f.assertJobContext(3, 8, 2, 0, 0));
+    EXPECT_FALSE(f.run()); // moves the last document and ends the scan
+    TEST_DO(f.assertJobContext(4, 7, 3, 0, 0));
+    f.compact();
+    TEST_DO(f.assertJobContext(4, 7, 3, 7, 1));
+}
+
 TEST_F("require that job is blocked if trying to move document for frozen bucket", JobFixture)
 {
     f._frozenHandler._bucket = BUCKET_ID_1;
@@ -2103,6 +2103,35 @@ TEST("require that multiple lids can be removed with removeBatch()")
     TEST_DO(assertLidGidFound(4, dms));
 }
 
+TEST("require that removeBatch() updates bucket db like single removes")
+{
+    DocumentMetaStore batchDms(createBucketDB());
+    DocumentMetaStore singleDms(createBucketDB());
+    batchDms.constructFreeList();
+    singleDms.constructFreeList();
+    std::vector<BucketId> bucketIds;
+    for (uint32_t lid = 1; lid <= 12; ++lid) {
+        GlobalId gid = createGid(lid % 3, lid);
+        BucketId bucketId(gid.convertToBucketId());
+        bucketId.setUsedBits(numBucketBits);
+        EXPECT_EQUAL(lid, addGid(batchDms, gid, bucketId, Timestamp(lid + timestampBias), lid));
+        EXPECT_EQUAL(lid, addGid(singleDms, gid, bucketId, Timestamp(lid + timestampBias), lid));
+        bucketIds.push_back(bucketId.stripUnused());
+    }
+    std::vector<uint32_t> lidsToRemove({1, 4, 7, 2, 5, 11, 12});
+    batchDms.removeBatch(lidsToRemove, 13);
+    for (uint32_t lid : lidsToRemove) {
+        EXPECT_TRUE(singleDms.remove(lid));
+    }
+    for (const auto &bucketId : bucketIds) {
+        BucketInfo expInfo = singleDms.getBucketDB().takeGuard()->get(bucketId);
+        BucketInfo actInfo = batchDms.getBucketDB().takeGuard()->get(bucketId);
+        EXPECT_EQUAL(expInfo, actInfo);
+    }
+    BucketInfo info = batchDms.getBucketDB().takeGuard()->get(bucketIds[0]);
+    EXPECT_EQUAL(1u, info.getDocumentCount());
+}
+
 }
 
 TEST_MAIN()
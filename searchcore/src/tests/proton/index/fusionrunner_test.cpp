@@ -85,7 +85,7 @@ public:
           _fileHeaderContext(),
           _threadingService(),
           _ops(_fileHeaderContext,
-               TuneFileIndexManager(), 0,
+               TuneFileIndexManager(), 0, 0,
                _threadingService)
     {}
     ~Test() {}
@@ -126,7 +126,7 @@ void Test::setUp() {
     FastOS_FileInterface::EmptyAndRemoveDirectory(base_dir.c_str());
     _fusion_runner.reset(new FusionRunner(base_dir, getSchema(),
                                  TuneFileAttributes(),
-                                 _fileHeaderContext));
+                                 _fileHeaderContext, 2));
     const string selector_base = base_dir + "/index.flush.0/selector";
     _selector.reset(new FixedSourceSelector(0, selector_base));
     _fusion_spec = FusionSpec();
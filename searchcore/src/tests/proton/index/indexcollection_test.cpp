@@ -4,6 +4,7 @@
 #include <vespa/searchcorespi/index/warmupindexcollection.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/fastos/file.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("indexcollection_test");
@@ -14,6 +15,7 @@ using search::FixedSourceSelector;
 using namespace proton;
 using namespace searchcorespi;
 using searchcorespi::index::WarmupConfig;
+using searchcorespi::index::WarmupTermLog;
 
 namespace {
 
@@ -30,6 +32,8 @@ class Test : public vespalib::TestApp,
     void requireThatSearchablesCanBeAppended(IndexCollection::UP fsc);
     void requireThatSearchablesCanBeReplaced(IndexCollection::UP fsc);
     void requireThatReplaceAndRenumberUpdatesCollectionAfterFusion();
+    void requireThatWarmupTermLogKeepsNewestTerms();
+    void requireThatWarmupTermLogCanBeSavedAndLoaded();
     IndexCollection::UP createWarmup(const IndexCollection::SP & prev, const IndexCollection::SP & next);
     virtual void warmupDone(ISearchableIndexCollection::SP current) override {
         (void) current;
@@ -63,6 +67,8 @@ Test::Main()
     TEST_DO(requireThatSearchablesCanBeAppended(IndexCollection::UP(new IndexCollection(_selector))));
     TEST_DO(requireThatSearchablesCanBeReplaced(IndexCollection::UP(new IndexCollection(_selector))));
     TEST_DO(requireThatReplaceAndRenumberUpdatesCollectionAfterFusion());
+    TEST_DO(requireThatWarmupTermLogKeepsNewestTerms());
+    TEST_DO(requireThatWarmupTermLogCanBeSavedAndLoaded());
     {
         IndexCollection::SP prev(new IndexCollection(_selector));
         IndexCollection::SP next(new IndexCollection(_selector));
@@ -123,6 +129,46 @@ void Test::requireThatReplaceAndRenumberUpdatesCollectionAfterFusion() {
     EXPECT_EQUAL(_source2.get(), &new_fsc->getSearchable(1));
 }
 
+void Test::requireThatWarmupTermLogKeepsNewestTerms() {
+    WarmupTermLog log(2);
+    log.add(0, false, "f0", "a");
+    log.add(1, true, "f1", "b");
+    log.add(0, false, "f0", "c");
+    std::vector<WarmupTermLog::Entry> entries = log.getEntries();
+    ASSERT_EQUAL(2u, entries.size());
+    EXPECT_EQUAL(1u, entries[0].fieldId);
+    EXPECT_TRUE(entries[0].filter);
+    EXPECT_EQUAL("f1", entries[0].fieldName);
+    EXPECT_EQUAL("b", entries[0].term);
+    EXPECT_EQUAL("c", entries[1].term);
+}
+
+void Test::requireThatWarmupTermLogCanBeSavedAndLoaded() {
+    const vespalib::string fileName("warmup_terms.txt");
+    WarmupTermLog log(10);
+    log.add(3, false, "f3", "foo");
+    log.add(4, true, "f4", "bar");
+    log.add(4, false, "f4", "tab\tbed");
+    EXPECT_TRUE(log.save(fileName));
+
+    WarmupTermLog loaded(10);
+    EXPECT_TRUE(loaded.load(fileName));
+    std::vector<WarmupTermLog::Entry> entries = loaded.getEntries();
+    ASSERT_EQUAL(2u, entries.size());
+    EXPECT_EQUAL(3u, entries[0].fieldId);
+    EXPECT_FALSE(entries[0].filter);
+    EXPECT_EQUAL("f3", entries[0].fieldName);
+    EXPECT_EQUAL("foo", entries[0].term);
+    EXPECT_EQUAL(4u, entries[1].fieldId);
+    EXPECT_TRUE(entries[1].filter);
+    EXPECT_EQUAL("bar", entries[1].term);
+
+    WarmupTermLog missing(10);
+    EXPECT_TRUE(missing.load("no_such_file.txt"));
+    EXPECT_EQUAL(0u, missing.size());
+    FastOS_File::Delete(fileName.c_str());
+}
+
 }  // namespace
 
 TEST_APPHOOK(Test);
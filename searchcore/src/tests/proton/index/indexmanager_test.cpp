@@ -134,8 +134,9 @@ struct Fixture {
         _writeService.index().sync();
     }
     void flushIndexManager();
+    void checkpointIndexManager();
     Document::UP addDocument(uint32_t docid);
-    void resetIndexManager();
+    void resetIndexManager(double checkpointInterval = 0.0);
     void removeDocument(uint32_t docId, SerialNum serialNum) {
         runAsIndex([&]() { _index_manager->removeDocument(docId, serialNum);
                               _index_manager->commit(serialNum,
@@ -159,6 +160,16 @@ void Fixture::flushIndexManager() {
     }
 }
 
+void Fixture::checkpointIndexManager() {
+    vespalib::Executor::Task::UP task;
+    SerialNum serialNum = _index_manager->getCurrentSerialNum();
+    auto &maintainer = _index_manager->getMaintainer();
+    runAsMaster([&]() { task = maintainer.initCheckpoint(serialNum); });
+    if (task.get()) {
+        task->run();
+    }
+}
+
 Document::UP Fixture::addDocument(uint32_t id) {
     Document::UP doc = buildDocument(_builder, id, "foo");
     SerialNum serialNum = ++_serial_num;
@@ -169,13 +180,13 @@ Document::UP Fixture::addDocument(uint32_t id) {
     return doc;
 }
 
-void Fixture::resetIndexManager() {
+void Fixture::resetIndexManager(double checkpointInterval) {
     _index_manager.reset(0);
     _index_manager.reset(
             new IndexManager(index_dir, searchcorespi::index::WarmupConfig(), 2, 0, getSchema(), 1,
                              _reconfigurer, _writeService, _writeService.getMasterExecutor(),
                              TuneFileIndexManager(), TuneFileAttributes(),
-                             _fileHeaderContext));
+                             _fileHeaderContext, 0, checkpointInterval));
 }
 
 
@@ -415,6 +426,46 @@ TEST_F("requireThatFusionStatsAreCalculated", Fixture) {
     ASSERT_TRUE(f._index_manager->getMaintainer().getFusionStats().diskUsage > 0);
 }
 
+TEST_F("requireThatFusedDiskUsageLimitsFusionDiskGain", Fixture) {
+    for (size_t i = 0; i < 4; ++i) {
+        f.addDocument(docid + i);
+        f.flushIndexManager();
+    }
+    IndexMaintainer &maintainer = f._index_manager->getMaintainer();
+    EXPECT_EQUAL(0u, maintainer.getFusionStats().fusedDiskUsage);
+    IndexFusionTarget(maintainer).initFlush(0)->run();
+    IndexMaintainer::FusionStats stats = maintainer.getFusionStats();
+    EXPECT_TRUE(stats.fusedDiskUsage > 0);
+    EXPECT_EQUAL(stats.diskUsage, stats.fusedDiskUsage);
+    f.addDocument(docid);
+    f.flushIndexManager();
+    stats = maintainer.getFusionStats();
+    EXPECT_TRUE(stats.diskUsage > stats.fusedDiskUsage);
+    IFlushTarget::DiskGain gain = IndexFusionTarget(maintainer).getApproxDiskGain();
+    EXPECT_TRUE(static_cast<uint64_t>(gain.gain()) <= stats.diskUsage - stats.fusedDiskUsage);
+}
+
+TEST_F("requireThatWriteStatsAreTracked", Fixture) {
+    IndexMaintainer &maintainer = f._index_manager->getMaintainer();
+    EXPECT_EQUAL(0u, f._index_manager->getWriteStats().getBytesWritten());
+    f.addDocument(docid);
+    f.addDocument(docid + 1);
+    f.flushIndexManager();
+    IndexWriteStats stats = f._index_manager->getWriteStats();
+    EXPECT_EQUAL(2u, stats.getDocumentsIngested());
+    EXPECT_TRUE(stats.getFlushBytesWritten() > 0);
+    EXPECT_EQUAL(0u, stats.getFusionBytesWritten());
+    EXPECT_EQUAL(1.0, stats.getWriteAmplification());
+    f.addDocument(docid + 2);
+    f.flushIndexManager();
+    IndexFusionTarget(maintainer).initFlush(0)->run();
+    stats = f._index_manager->getWriteStats();
+    EXPECT_EQUAL(3u, stats.getDocumentsIngested());
+    EXPECT_TRUE(stats.getFusionBytesWritten() > 0);
+    EXPECT_TRUE(stats.getWriteAmplification() > 1.0);
+    EXPECT_EQUAL(static_cast<double>(stats.getBytesWritten()) / 3, stats.getBytesWrittenPerDocument());
+}
+
 TEST_F("requireThatPutDocumentUpdatesSerialNum", Fixture) {
     f._serial_num = 0;
     EXPECT_EQUAL(0u, f._index_manager->getCurrentSerialNum());
@@ -719,6 +770,59 @@ TEST_F("require that indexes manager stats can be generated", Fixture)
     TEST_DO(f.assertStats(1, 1, 1, 2));
 }
 
+bool checkpointExists() {
+    return FastOS_File((index_dir + "/memoryindex.checkpoint").c_str()).OpenReadOnly();
+}
+
+TEST_F("require that memory index checkpoint is loaded on startup", Fixture)
+{
+    f.resetIndexManager(60.0);
+    EXPECT_EQUAL(3u, f._index_manager->getFlushTargets().size());
+    f.addDocument(docid);
+    f.flushIndexManager();
+    f.addDocument(docid + 1);
+    f.removeDocument(docid, ++f._serial_num);
+    f.checkpointIndexManager();
+    EXPECT_TRUE(checkpointExists());
+    EXPECT_EQUAL(3u, f._index_manager->getFlushedSerialNum());
+
+    f.resetIndexManager(60.0);
+    EXPECT_EQUAL(3u, f._index_manager->getFlushedSerialNum());
+    EXPECT_EQUAL(3u, f._index_manager->getCurrentSerialNum());
+    TEST_DO(f.assertStats(1, 1, 1, 3));
+    IIndexCollection::SP fsc = f._index_manager->getMaintainer().getSourceCollection();
+    EXPECT_EQUAL(2u, getSource(*fsc, docid));
+    EXPECT_EQUAL(2u, getSource(*fsc, docid + 1));
+    fsc.reset();
+
+    f.flushIndexManager();
+    EXPECT_FALSE(checkpointExists());
+    EXPECT_EQUAL(3u, f._index_manager->getFlushedSerialNum());
+    f.resetIndexManager(60.0);
+    TEST_DO(f.assertStats(2, 1, 3, 3));
+}
+
+TEST_F("require that stale memory index checkpoint is removed on startup", Fixture)
+{
+    const string checkpoint = index_dir + "/memoryindex.checkpoint";
+    const string saved = index_dir + "/saved.checkpoint";
+    f.resetIndexManager(60.0);
+    f.addDocument(docid);
+    f.checkpointIndexManager();
+    EXPECT_EQUAL(1u, f._index_manager->getFlushedSerialNum());
+    ASSERT_TRUE(FastOS_FileInterface::CopyFile(checkpoint.c_str(), saved.c_str()));
+    f.addDocument(docid + 1);
+    f.flushIndexManager();
+    EXPECT_FALSE(checkpointExists());
+    f._index_manager.reset(0);
+    // Checkpoint left behind by a crash before it was removed after flush
+    ASSERT_TRUE(FastOS_File::Rename(saved.c_str(), checkpoint.c_str()));
+    f.resetIndexManager(60.0);
+    EXPECT_FALSE(checkpointExists());
+    EXPECT_EQUAL(2u, f._index_manager->getFlushedSerialNum());
+    TEST_DO(f.assertStats(1, 1, 2, 2));
+}
+
 }  // namespace
 
 TEST_MAIN() {
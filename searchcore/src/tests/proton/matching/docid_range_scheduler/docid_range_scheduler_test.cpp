@@ -305,4 +305,90 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+TEST("require that the work-stealing scheduler hands out tasks from the front of each thread's part") {
+    WorkStealingDocidRangeScheduler scheduler(2, 2, 17);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 16u);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1,3)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(9,11)));
+    EXPECT_EQUAL(scheduler.total_size(0), 2u);
+    EXPECT_EQUAL(scheduler.total_size(1), 2u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 12u);
+    TEST_DO(verify_range(scheduler.total_span(0), DocidRange(1,17)));
+    TEST_DO(verify_range(scheduler.total_span(1), DocidRange(1,17)));
+}
+
+TEST("require that the work-stealing scheduler does not leave tasks smaller than the minimal task size") {
+    WorkStealingDocidRangeScheduler scheduler(1, 3, 6);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1,6)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+}
+
+TEST("require that an idle thread steals the back half of the largest remaining range") {
+    WorkStealingDocidRangeScheduler scheduler(3, 2, 25);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1,3)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(9,11)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(17,19)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(11,13)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(13,15)));
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(15,17)));
+    EXPECT_EQUAL(scheduler.steal_count(1), 0u);
+    TEST_DO(verify_range(scheduler.next_range(1), DocidRange(6,9)));
+    EXPECT_EQUAL(scheduler.steal_count(1), 1u);
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(3,6)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(22,25)));
+    EXPECT_EQUAL(scheduler.steal_count(0), 1u);
+    EXPECT_EQUAL(scheduler.steal_count(2), 0u);
+    TEST_DO(verify_range(scheduler.next_range(2), DocidRange(19,22)));
+    EXPECT_EQUAL(scheduler.total_size(0), 8u);
+    EXPECT_EQUAL(scheduler.total_size(1), 11u);
+    EXPECT_EQUAL(scheduler.total_size(2), 5u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST_MT_FF("require that the work-stealing scheduler handles no documents",
+           4, WorkStealingDocidRangeScheduler(num_threads, 1, 1), TimeBomb(60))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        TEST_ERROR("no threads should get any work");
+    }
+    EXPECT_EQUAL(f1.steal_count(thread_id), 0u);
+}
+
+TEST_MT_FFF("require that the work-stealing scheduler assigns each docid exactly once",
+            8, WorkStealingDocidRangeScheduler(num_threads, 7, 100001),
+            std::vector<std::atomic<uint32_t>>(100001), TimeBomb(60))
+{
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        for (uint32_t docid = docid_range.begin; docid < docid_range.end; ++docid) {
+            f2[docid].fetch_add(1, std::memory_order_relaxed);
+        }
+        if (thread_id == 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(10));
+        }
+    }
+    TEST_BARRIER();
+    if (thread_id == 0) {
+        size_t total = 0;
+        for (size_t i = 0; i < num_threads; ++i) {
+            total += f1.total_size(i);
+        }
+        EXPECT_EQUAL(total, 100000u);
+        EXPECT_EQUAL(f1.unassigned_size(), 0u);
+        EXPECT_EQUAL(f2[0].load(), 0u);
+        for (uint32_t docid = 1; docid < f2.size(); ++docid) {
+            if (!EXPECT_EQUAL(f2[docid].load(), 1u)) {
+                break;
+            }
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
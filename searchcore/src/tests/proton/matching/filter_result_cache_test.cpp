@@ -0,0 +1,108 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchcore/proton/matching/filter_result_cache.h>
+#include <vespa/searchlib/common/bitvector.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("filter_result_cache_test");
+
+using namespace proton::matching;
+using search::BitVector;
+using BitVectorSP = FilterResultCache::BitVectorSP;
+
+BitVectorSP make_bits(uint32_t docid_limit, std::initializer_list<uint32_t> hits) {
+    std::shared_ptr<BitVector> bits(BitVector::create(docid_limit).release());
+    for (uint32_t docid : hits) {
+        bits->setBit(docid);
+    }
+    bits->invalidateCachedCount();
+    return bits;
+}
+
+TEST("require that cached filter results can be looked up") {
+    FilterResultCache cache(1000000);
+    EXPECT_TRUE(cache.enabled());
+    EXPECT_FALSE(cache.lookup("foo", 1));
+    cache.insert("foo", 1, make_bits(100, {3, 5, 7}));
+    BitVectorSP bits = cache.lookup("foo", 1);
+    ASSERT_TRUE(bits);
+    EXPECT_EQUAL(3u, bits->countTrueBits());
+    EXPECT_TRUE(bits->testBit(5));
+    FilterResultCache::Stats stats = cache.getStats();
+    EXPECT_EQUAL(1u, stats.numHits);
+    EXPECT_EQUAL(1u, stats.numMisses);
+    EXPECT_EQUAL(1u, stats.numCached);
+}
+
+TEST("require that results from other generations are not used") {
+    FilterResultCache cache(1000000);
+    cache.insert("foo", 1, make_bits(100, {3}));
+    EXPECT_FALSE(cache.lookup("foo", 2));
+    EXPECT_EQUAL(0u, cache.getStats().numCached);
+    EXPECT_EQUAL(0u, cache.getStats().memoryUsage);
+    cache.insert("foo", 2, make_bits(100, {4}));
+    cache.insert("foo", 1, make_bits(100, {3}));
+    BitVectorSP bits = cache.lookup("foo", 2);
+    ASSERT_TRUE(bits);
+    EXPECT_TRUE(bits->testBit(4));
+}
+
+TEST("require that least recently used results are evicted to respect memory limit") {
+    FilterResultCache probe(1000000);
+    probe.insert("a", 1, make_bits(8000, {}));
+    size_t entry_size = probe.getStats().memoryUsage;
+    FilterResultCache cache(2 * entry_size);
+    cache.insert("a", 1, make_bits(8000, {}));
+    cache.insert("b", 1, make_bits(8000, {}));
+    EXPECT_TRUE(cache.lookup("a", 1));
+    cache.insert("c", 1, make_bits(8000, {}));
+    EXPECT_EQUAL(2u, cache.getStats().numCached);
+    EXPECT_TRUE(cache.lookup("a", 1));
+    EXPECT_FALSE(cache.lookup("b", 1));
+    EXPECT_TRUE(cache.lookup("c", 1));
+}
+
+TEST("require that disabled cache does not store results") {
+    FilterResultCache cache(0);
+    EXPECT_FALSE(cache.enabled());
+    cache.insert("foo", 1, make_bits(100, {3}));
+    EXPECT_FALSE(cache.lookup("foo", 1));
+}
+
+TEST("require that frequency sketch counts keys") {
+    FrequencySketch sketch(64, 1000);
+    EXPECT_EQUAL(0u, sketch.estimate(17));
+    EXPECT_EQUAL(1u, sketch.add(17));
+    EXPECT_EQUAL(2u, sketch.add(17));
+    EXPECT_EQUAL(2u, sketch.estimate(17));
+    for (uint64_t hash = 100; hash < 120; ++hash) {
+        sketch.add(hash << 20);
+    }
+    EXPECT_GREATER_EQUAL(sketch.estimate(17), 2u);
+}
+
+TEST("require that frequency sketch forgets old keys") {
+    FrequencySketch sketch(64, 10);
+    for (size_t i = 0; i < 8; ++i) {
+        sketch.add(17);
+    }
+    EXPECT_EQUAL(8u, sketch.estimate(17));
+    sketch.add(18);
+    sketch.add(18);
+    sketch.add(18);
+    EXPECT_EQUAL(4u, sketch.estimate(17));
+}
+
+TEST("require that only keys used often are admitted") {
+    FilterResultCache cache(1000000);
+    for (uint32_t i = 1; i < FilterResultCache::ADMISSION_FREQUENCY; ++i) {
+        EXPECT_FALSE(cache.admit("foo"));
+    }
+    EXPECT_TRUE(cache.admit("foo"));
+    EXPECT_TRUE(cache.admit("foo"));
+    EXPECT_FALSE(cache.admit("bar"));
+    EXPECT_EQUAL(FilterResultCache::ADMISSION_FREQUENCY, cache.getStats().numRejected);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,91 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchcore/proton/matching/match_loop_communicator.h>
+#include <vespa/vespalib/util/rendezvous.h>
+#include <vespa/vespalib/util/priority_queue.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+
+using namespace proton::matching;
+using namespace vespalib;
+
+typedef MatchLoopCommunicator::feature_t feature_t;
+typedef MatchLoopCommunicator::Hits Hits;
+
+//-----------------------------------------------------------------------------
+
+// the original rendezvous based selection, used as a baseline
+struct RendezvousSelectBest : Rendezvous<Hits, size_t> {
+    size_t topN;
+    RendezvousSelectBest(size_t n, size_t topN_in)
+        : Rendezvous<Hits, size_t>(n), topN(topN_in) {}
+    bool cmp(const uint32_t &a, const uint32_t &b) {
+        return (in(a)[out(a)].second > in(b)[out(b)].second);
+    }
+    struct Cmp {
+        RendezvousSelectBest &sb;
+        Cmp(RendezvousSelectBest &sb_in) : sb(sb_in) {}
+        bool operator()(const uint32_t &a, const uint32_t &b) const { return sb.cmp(a, b); }
+    };
+    void mingle() override {
+        PriorityQueue<uint32_t, Cmp> queue(Cmp(*this));
+        for (size_t i = 0; i < size(); ++i) {
+            if (!in(i).empty()) {
+                queue.push(i);
+            }
+        }
+        for (size_t picked = 0; picked < topN && !queue.empty(); ++picked) {
+            uint32_t i = queue.front();
+            if (in(i).size() > ++out(i)) {
+                queue.adjust();
+            } else {
+                queue.pop_front();
+            }
+        }
+    }
+};
+
+Hits make_hits(size_t thread_id, size_t num_threads, size_t topN) {
+    Hits hits;
+    for (size_t i = 0; i < topN; ++i) {
+        hits.emplace_back(uint32_t(i * num_threads + thread_id), feature_t((topN - i) * num_threads + thread_id));
+    }
+    return hits;
+}
+
+template <typename SELECT>
+double measure(const Hits &hits, SELECT select) {
+    BenchmarkTimer timer(1.0);
+    for (size_t i = 0; i < 32; ++i) {
+        TEST_BARRIER();
+        timer.before();
+        (void) select(hits);
+        TEST_BARRIER();
+        timer.after();
+    }
+    return timer.min_time();
+}
+
+void benchmark(size_t thread_id, size_t num_threads) {
+    for (size_t topN: {10, 100, 1000}) {
+        MatchLoopCommunicator tree(num_threads, topN);
+        RendezvousSelectBest baseline(num_threads, topN);
+        Hits hits = make_hits(thread_id, num_threads, topN);
+        double tree_s = measure(hits, [&](const auto &in){ return tree.selectBest(in); });
+        double baseline_s = measure(hits, [&](const auto &in){ return baseline.rendezvous(in); });
+        if (thread_id == 0) {
+            fprintf(stderr, "threads: %zu, topN: %zu, rendezvous: %g us, tree: %g us\n",
+                    num_threads, topN, baseline_s * 1000.0 * 1000.0, tree_s * 1000.0 * 1000.0);
+        }
+        EXPECT_EQUAL(tree.selectBest(hits), baseline.rendezvous(hits));
+    }
+}
+
+TEST_MT("benchmark selectBest with 2 threads", 2) { benchmark(thread_id, num_threads); }
+TEST_MT("benchmark selectBest with 8 threads", 8) { benchmark(thread_id, num_threads); }
+TEST_MT("benchmark selectBest with 16 threads", 16) { benchmark(thread_id, num_threads); }
+TEST_MT("benchmark selectBest with 48 threads", 48) { benchmark(thread_id, num_threads); }
+
+//-----------------------------------------------------------------------------
+
+TEST_MAIN() { TEST_RUN_ALL(); }
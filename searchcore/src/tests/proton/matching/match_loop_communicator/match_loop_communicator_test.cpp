@@ -5,23 +5,35 @@
 
 using namespace proton::matching;
 
-using vespalib::Box;
 using vespalib::make_box;
 
 typedef MatchLoopCommunicator::Range Range;
 typedef MatchLoopCommunicator::RangePair RangePair;
 typedef MatchLoopCommunicator::feature_t feature_t;
 typedef MatchLoopCommunicator::Matches Matches;
+typedef MatchLoopCommunicator::Hit Hit;
+typedef MatchLoopCommunicator::Hits Hits;
+typedef MatchLoopCommunicator::TaggedHit TaggedHit;
+typedef MatchLoopCommunicator::TaggedHits TaggedHits;
+
+Hits makeHits(const std::vector<feature_t> &scores, uint32_t docid = 1) {
+    Hits hits;
+    for (feature_t score: scores) {
+        hits.emplace_back(docid++, score);
+    }
+    return hits;
+}
 
-std::vector<feature_t> makeScores(size_t id) {
+Hits makeScores(size_t id) {
+    uint32_t docid = 1 + id * 100;
     switch (id) {
-    case 0: return make_box<feature_t>(5.4, 4.4, 3.4, 2.4, 1.4);
-    case 1: return make_box<feature_t>(5.3, 4.3, 3.3, 2.3, 1.3);
-    case 2: return make_box<feature_t>(5.2, 4.2, 3.2, 2.2, 1.2);
-    case 3: return make_box<feature_t>(5.1, 4.1, 3.1, 2.1, 1.1);
-    case 4: return make_box<feature_t>(5.0, 4.0, 3.0, 2.0, 1.0);
+    case 0: return makeHits(make_box<feature_t>(5.4, 4.4, 3.4, 2.4, 1.4), docid);
+    case 1: return makeHits(make_box<feature_t>(5.3, 4.3, 3.3, 2.3, 1.3), docid);
+    case 2: return makeHits(make_box<feature_t>(5.2, 4.2, 3.2, 2.2, 1.2), docid);
+    case 3: return makeHits(make_box<feature_t>(5.1, 4.1, 3.1, 2.1, 1.1), docid);
+    case 4: return makeHits(make_box<feature_t>(5.0, 4.0, 3.0, 2.0, 1.0), docid);
     }
-    return Box<feature_t>();
+    return Hits();
 }
 
 RangePair makeRanges(size_t id) {
@@ -36,13 +48,13 @@ RangePair makeRanges(size_t id) {
 }
 
 TEST_F("require that selectBest gives appropriate results for single thread", MatchLoopCommunicator(num_threads, 3)) {
-    EXPECT_EQUAL(2u, f1.selectBest(make_box<feature_t>(5, 4)));
-    EXPECT_EQUAL(3u, f1.selectBest(make_box<feature_t>(5, 4, 3)));
-    EXPECT_EQUAL(3u, f1.selectBest(make_box<feature_t>(5, 4, 3, 2)));
+    EXPECT_EQUAL(2u, f1.selectBest(makeHits(make_box<feature_t>(5, 4))));
+    EXPECT_EQUAL(3u, f1.selectBest(makeHits(make_box<feature_t>(5, 4, 3))));
+    EXPECT_EQUAL(3u, f1.selectBest(makeHits(make_box<feature_t>(5, 4, 3, 2))));
 }
 
 TEST_MT_F("require that selectBest works with no hits", 10, MatchLoopCommunicator(num_threads, 10)) {
-    EXPECT_EQUAL(0u, f1.selectBest(Box<feature_t>()));
+    EXPECT_EQUAL(0u, f1.selectBest(Hits()));
 }
 
 TEST_MT_F("require that selectBest works with too many hits from all threads", 5, MatchLoopCommunicator(num_threads, 13)) {
@@ -75,6 +87,16 @@ TEST_MT_F("require that selectBest works with some empty threads", 10, MatchLoop
     }
 }
 
+TEST_MT_F("require that selectBest breaks ties on docid", 2, MatchLoopCommunicator(num_threads, 3)) {
+    for (size_t i = 0; i < 10; ++i) {
+        if (thread_id == 0) {
+            EXPECT_EQUAL(2u, f1.selectBest(Hits({{10, 5.0}, {30, 5.0}})));
+        } else {
+            EXPECT_EQUAL(1u, f1.selectBest(Hits({{20, 5.0}, {40, 5.0}})));
+        }
+    }
+}
+
 TEST_F("require that rangeCover is identity function for single thread", MatchLoopCommunicator(num_threads, 5)) {
     RangePair res = f1.rangeCover(std::make_pair(Range(2, 4), Range(3, 5)));
     EXPECT_EQUAL(2, res.first.low);
@@ -114,4 +136,45 @@ TEST_MT_F("require that count_matches will count hits and docs across threads",
     EXPECT_APPROX(freq, f1.estimate_match_frequency(Matches(thread_id, thread_id + 10)), 0.00001);
 }
 
+Hits makeCandidates(size_t id) {
+    Hits hits;
+    for (size_t i = 0; i < 4; ++i) {
+        hits.emplace_back(id * 10 + i, 10.0 - i);
+    }
+    return hits;
+}
+
+TEST_MT_F("require that second phase work is shared evenly in score order", 3, MatchLoopCommunicator(num_threads, 12)) {
+    TaggedHits work = f1.get_second_phase_work(makeCandidates(thread_id), thread_id);
+    ASSERT_EQUAL(4u, work.size());
+    for (size_t i = 0; i < work.size(); ++i) {
+        EXPECT_EQUAL(thread_id * 10 + i, work[i].first.first);
+        EXPECT_EQUAL(thread_id, work[i].second);
+    }
+}
+
+TEST_MT_F("require that second phase work only depends on thread id", 4, MatchLoopCommunicator(num_threads, 4)) {
+    Hits candidates;
+    if (thread_id == 3) {
+        candidates = make_box<Hit>(Hit(30, 4.0), Hit(31, 3.0), Hit(32, 2.0), Hit(33, 1.0));
+    }
+    TaggedHits work = f1.get_second_phase_work(candidates, thread_id);
+    ASSERT_EQUAL(1u, work.size());
+    EXPECT_EQUAL(30u + thread_id, work[0].first.first);
+    EXPECT_EQUAL(3u, work[0].second);
+}
+
+TEST_MT_F("require that second phase results are returned to the owning thread sorted on docid", 3, MatchLoopCommunicator(num_threads, 12)) {
+    TaggedHits results;
+    for (size_t owner = 0; owner < num_threads; ++owner) {
+        results.emplace_back(Hit(owner * 10 + 5 - thread_id, thread_id), owner);
+    }
+    Hits hits = f1.complete_second_phase(results, thread_id);
+    ASSERT_EQUAL(3u, hits.size());
+    for (size_t i = 0; i < hits.size(); ++i) {
+        EXPECT_EQUAL(thread_id * 10 + 3 + i, hits[i].first);
+        EXPECT_EQUAL(2.0 - i, hits[i].second);
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
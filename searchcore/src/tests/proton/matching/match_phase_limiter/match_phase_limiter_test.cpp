@@ -204,6 +204,7 @@ TEST("require that no limiter has no behavior") {
     ASSERT_TRUE(ms != nullptr);
     EXPECT_EQUAL("search", ms->term);
     EXPECT_FALSE(limiter.was_limited());
+    EXPECT_EQUAL(0.0, limiter.setup_time());
 }
 
 TEST("require that the match phase limiter may chose not to limit the query") {
@@ -42,6 +42,16 @@ TEST("requireThatDocCountsAddUp") {
     EXPECT_EQUAL(2u, stats.limited_queries());
 }
 
+TEST("requireThatResultCacheCountsAddUp") {
+    MatchingStats stats;
+    EXPECT_EQUAL(0u, stats.cache_hits());
+    EXPECT_EQUAL(0u, stats.cache_misses());
+    EXPECT_EQUAL(&stats.add(MatchingStats().cache_hits(3).cache_misses(1)), &stats);
+    EXPECT_EQUAL(&stats.add(MatchingStats().cache_hits(2).cache_misses(4)), &stats);
+    EXPECT_EQUAL(5u, stats.cache_hits());
+    EXPECT_EQUAL(5u, stats.cache_misses());
+}
+
 TEST("requireThatAverageTimesAreRecorded") {
     MatchingStats stats;
     EXPECT_APPROX(0.0, stats.matchTimeAvg(), 0.00001);
@@ -88,6 +98,35 @@ TEST("requireThatAverageTimesAreRecorded") {
     EXPECT_EQUAL(4u, stats.queryLatencyCount());
 }
 
+TEST("requireThatQueryCostIsRecorded") {
+    MatchingStats stats;
+    stats.blueprintCreationTime(0.1).postingFetchTime(0.2).queryCpuTime(1.0).queryAllocatedBytes(1000);
+    stats.add(MatchingStats().blueprintCreationTime(0.3).postingFetchTime(0.4).queryCpuTime(3.0).queryAllocatedBytes(3000));
+    EXPECT_APPROX(0.2, stats.blueprintCreationTimeAvg(), 0.00001);
+    EXPECT_APPROX(0.3, stats.postingFetchTimeAvg(), 0.00001);
+    EXPECT_APPROX(2.0, stats.queryCpuTimeAvg(), 0.00001);
+    EXPECT_APPROX(1.0, stats.queryCpuTimeMin(), 0.00001);
+    EXPECT_APPROX(3.0, stats.queryCpuTimeMax(), 0.00001);
+    EXPECT_APPROX(2000.0, stats.queryAllocatedBytesAvg(), 0.00001);
+    EXPECT_EQUAL(2u, stats.queryCpuTimeCount());
+    stats.limiterSetupTime(0.5);
+    stats.add(MatchingStats().limiterSetupTime(0.7));
+    EXPECT_APPROX(0.6, stats.limiterSetupTimeAvg(), 0.00001);
+    EXPECT_EQUAL(2u, stats.limiterSetupTimeCount());
+
+    MatchingStats::Partition a;
+    a.cpu_time(0.5).first_phase_time(0.4).second_phase_time(0.1).allocated_bytes(100);
+    MatchingStats::Partition b;
+    b.cpu_time(1.5).first_phase_time(1.2).second_phase_time(0.3).allocated_bytes(300);
+    a.add(b);
+    EXPECT_APPROX(1.0, a.cpu_time_avg(), 0.00001);
+    EXPECT_APPROX(0.8, a.first_phase_time_avg(), 0.00001);
+    EXPECT_APPROX(0.2, a.second_phase_time_avg(), 0.00001);
+    EXPECT_APPROX(200.0, a.allocated_bytes_avg(), 0.00001);
+    EXPECT_APPROX(1.5, a.cpu_time_max(), 0.00001);
+    EXPECT_EQUAL(2u, a.cpu_time_count());
+}
+
 TEST("requireThatMinMaxTimesAreRecorded") {
     MatchingStats stats;
     EXPECT_APPROX(0.0, stats.matchTimeMin(), 0.00001);
@@ -151,8 +190,9 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(0u, all1.getNumPartitions());
 
     MatchingStats::Partition subPart;
-    subPart.docsCovered(7).docsMatched(3).docsRanked(2).docsReRanked(1)
+    subPart.docsCovered(7).docsMatched(3).docsRanked(2).docsReRanked(1).steals(4)
         .active_time(1.0).wait_time(0.5);
+    EXPECT_EQUAL(4u, subPart.steals());
     EXPECT_EQUAL(7u, subPart.docsCovered());
     EXPECT_EQUAL(3u, subPart.docsMatched());
     EXPECT_EQUAL(2u, subPart.docsRanked());
@@ -172,6 +212,8 @@ TEST("requireThatPartitionsAreAddedCorrectly") {
     EXPECT_EQUAL(2u, all1.docsRanked());
     EXPECT_EQUAL(1u, all1.docsReRanked());
     EXPECT_EQUAL(1u, all1.getNumPartitions());
+    EXPECT_EQUAL(4u, all1.steals());
+    EXPECT_EQUAL(4u, all1.getPartition(0).steals());
     EXPECT_EQUAL(7u, all1.getPartition(0).docsCovered());
     EXPECT_EQUAL(3u, all1.getPartition(0).docsMatched());
     EXPECT_EQUAL(2u, all1.getPartition(0).docsRanked());
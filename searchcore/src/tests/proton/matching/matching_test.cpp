@@ -157,6 +157,8 @@ struct MyWorld {
     SessionManager::SP      sessionManager;
     DocumentMetaStore       metaStore;
     MatchingStats           matchingStats;
+    vespalib::ShardedHistogram::Snapshot hotLatency;
+    uint64_t                hotDocsMatched;
     vespalib::Clock         clock;
     QueryLimiter            queryLimiter;
     EmptyConstantValueRepo  constantValueRepo;
@@ -353,6 +355,8 @@ struct MyWorld {
                            *sessionManager, metaStore,
                            std::move(owned_objects));
         matchingStats.add(matcher->getStats());
+        hotLatency = matcher->getHotMetrics().queryLatency->snapshot();
+        hotDocsMatched = matcher->getHotMetrics().docsMatched->value();
         return reply;
     }
 
@@ -404,6 +408,8 @@ MyWorld::MyWorld()
       sessionManager(),
       metaStore(std::make_shared<BucketDBOwner>()),
       matchingStats(),
+      hotLatency(),
+      hotDocsMatched(0),
       clock(),
       queryLimiter()
 {}
@@ -463,6 +469,8 @@ TEST("require that matching is performed (multi-threaded)") {
         EXPECT_EQUAL(9u, world.matchingStats.docsMatched());
         EXPECT_EQUAL(9u, reply->hits.size());
         EXPECT_GREATER(world.matchingStats.matchTimeAvg(), 0.0000001);
+        EXPECT_EQUAL(9u, world.hotDocsMatched);
+        EXPECT_EQUAL(1u, world.hotLatency.count);
     }
 }
 
@@ -589,6 +597,43 @@ TEST("require that grouping is performed (multi-threaded)") {
     }
 }
 
+TEST("require that partial groups from each match thread are merged") {
+    for (size_t threads = 1; threads <= 16; ++threads) {
+        MyWorld world;
+        world.basicSetup();
+        world.basicResults();
+        SearchRequest::SP request = world.createSimpleRequest("f1", "spread");
+        {
+            vespalib::nbostream buf;
+            vespalib::NBOSerializer os(buf);
+            uint32_t n = 1;
+            os << n;
+            GroupingLevel level;
+            level.setExpression(createAttr())
+                 .addResult(SumAggregationResult().setExpression(std::make_unique<AttributeNode>("a2")));
+            Grouping grequest;
+            grequest.addLevel(std::move(level)).setFirstLevel(0).setLastLevel(1);
+            grequest.serialize(os);
+            request->groupSpec.assign(buf.c_str(), buf.c_str() + buf.size());
+        }
+        SearchReply::UP reply = world.performSearch(request, threads);
+        vespalib::nbostream buf(&reply->groupResult[0], reply->groupResult.size());
+        vespalib::NBOSerializer is(buf);
+        uint32_t n;
+        is >> n;
+        EXPECT_EQUAL(1u, n);
+        Grouping gresult;
+        gresult.deserialize(is);
+        const Group &root = gresult.getRoot();
+        ASSERT_EQUAL(9u, root.getChildrenSize());
+        for (uint32_t i = 0; i < 9; ++i) {
+            int64_t docid = (i + 1) * 100;
+            EXPECT_EQUAL(docid, root.getChild(i).getId().getInteger());
+            EXPECT_EQUAL(docid * 2, root.getChild(i).getAggregationResult(0).getRank().getInteger());
+        }
+    }
+}
+
 TEST("require that summary features are filled") {
     MyWorld world;
     world.basicSetup();
@@ -712,6 +757,34 @@ TEST("require that getSummaryFeatures prefers cached query setup") {
     ASSERT_EQUAL(2u, fs->numDocs());  // "foo" has two hits
 }
 
+TEST("require that search session is kept implicitly for summary features") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    world.sessionManager = std::make_shared<SessionManager>(100, 0, fastos::TimeStamp(0), 0, 10);
+    SearchRequest::SP request = world.createSimpleRequest("f1", "foo");
+    request->sessionId.push_back('a');
+    world.performSearch(request, 1);
+    EXPECT_EQUAL(1u, world.sessionManager->getSearchStats().numInsert);
+
+    // the docsum request neither asks for the cached query nor has the same query
+    DocsumRequest::SP req = world.createSimpleDocsumRequest("f1", "spread");
+    req->sessionId = request->sessionId;
+    FeatureSet::SP fs = world.getSummaryFeatures(req);
+    EXPECT_EQUAL(2u, fs->numFeatures());
+    ASSERT_EQUAL(2u, fs->numDocs());  // "foo" from the session has two hits
+}
+
+TEST("require that search session is not kept implicitly when disabled") {
+    MyWorld world;
+    world.basicSetup();
+    world.basicResults();
+    SearchRequest::SP request = world.createSimpleRequest("f1", "foo");
+    request->sessionId.push_back('a');
+    world.performSearch(request, 1);
+    EXPECT_EQUAL(0u, world.sessionManager->getSearchStats().numInsert);
+}
+
 TEST("require that match params are set up straight with ranking on") {
     MatchParams p(1, 2, 4, 0.7, 0, 1, true, true);
     ASSERT_EQUAL(1u, p.numDocs);
@@ -811,6 +884,34 @@ TEST("require that match phase limiting works") {
     }
 }
 
+TEST("require that sorted queries can be limited in attribute order") {
+    MyWorld world;
+    world.basicSetup();
+    world.verbose_a1_result("all");
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = world.createSimpleRequest("a1", "all");
+    search::fef::Properties overrides;
+    MatchToolsFactory::UP mtf = matcher->create_match_tools_factory(*request, world.searchContext, world.attributeContext,
+                                                                    world.metaStore, overrides);
+    EXPECT_FALSE(mtf->match_limiter().is_enabled());
+    mtf->limit_sorted_query(NUM_DOCS, world.searchContext.getAttributes(), "a1", true, 0);
+    EXPECT_FALSE(mtf->match_limiter().is_enabled());
+    mtf->limit_sorted_query(NUM_DOCS, world.searchContext.getAttributes(), "a1", true, 10);
+    EXPECT_TRUE(mtf->match_limiter().is_enabled());
+    EXPECT_FALSE(mtf->match_limiter().was_limited());
+}
+
+TEST("require that sorted queries are not limited by default") {
+    MyWorld world;
+    world.basicSetup();
+    world.verbose_a1_result("all");
+    SearchRequest::SP request = world.createSimpleRequest("a1", "all");
+    request->sortSpec = "+a1";
+    SearchReply::UP reply = world.performSearch(request, 1);
+    EXPECT_EQUAL(985u, reply->totalHitCount);
+    EXPECT_EQUAL(0u, reply->coverage.getDegradeReason());
+}
+
 TEST("require that arithmetic used for rank drop limit works") {
     double small = -HUGE_VAL;
     double limit = -std::numeric_limits<feature_t>::quiet_NaN();
@@ -853,4 +954,43 @@ TEST("require that same element search works (note that this does not test/use t
     EXPECT_EQUAL(document::DocumentId("doc::20").getGlobalId(), reply->hits[0].gid);
 }
 
+TEST("require that match threads are reserved from a shared budget") {
+    QueryLimiter limiter;
+    {
+        QueryLimiter::ThreadReservation::UP unlimited = limiter.reserveMatchThreads(16);
+        EXPECT_EQUAL(16u, unlimited->size());
+    }
+    limiter.configureMatchThreads(8);
+    QueryLimiter::ThreadReservation::UP cheap = limiter.reserveMatchThreads(1);
+    QueryLimiter::ThreadReservation::UP heavy = limiter.reserveMatchThreads(6);
+    QueryLimiter::ThreadReservation::UP late = limiter.reserveMatchThreads(6);
+    QueryLimiter::ThreadReservation::UP starved = limiter.reserveMatchThreads(6);
+    EXPECT_EQUAL(1u, cheap->size());
+    EXPECT_EQUAL(6u, heavy->size());
+    EXPECT_EQUAL(1u, late->size());
+    EXPECT_EQUAL(1u, starved->size());
+    EXPECT_EQUAL(9u, limiter.getActiveMatchThreads());
+    heavy.reset();
+    EXPECT_EQUAL(3u, limiter.getActiveMatchThreads());
+    EXPECT_EQUAL(5u, limiter.reserveMatchThreads(6)->size());
+    EXPECT_EQUAL(3u, limiter.getActiveMatchThreads());
+}
+
+TEST("require that queries are admitted with the coverage the cpu budget allows") {
+    QueryLimiter limiter;
+    EXPECT_EQUAL(1.0, limiter.admit(100.0, 1.0)->coverage());
+    limiter.configureMatchThreads(4);
+    EXPECT_EQUAL(1.0, limiter.admit(0.0, 0.0)->coverage());
+    QueryLimiter::Admission::UP first = limiter.admit(2.0, 1.0);
+    EXPECT_EQUAL(1.0, first->coverage());
+    QueryLimiter::Admission::UP second = limiter.admit(4.0, 1.0);
+    EXPECT_EQUAL(0.5, second->coverage());
+    EXPECT_EQUAL(4.0, limiter.getPendingCost());
+    QueryLimiter::Admission::UP third = limiter.admit(1.0, 1.0);
+    EXPECT_TRUE(third->rejected());
+    first.reset();
+    EXPECT_EQUAL(2.0, limiter.getPendingCost());
+    EXPECT_FALSE(limiter.admit(1.0, 1.0)->rejected());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
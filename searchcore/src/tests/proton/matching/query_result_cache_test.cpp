@@ -0,0 +1,121 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("query_result_cache_test");
+
+using namespace proton::matching;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+
+SearchRequest make_request(const vespalib::string &ranking, uint32_t offset = 0) {
+    SearchRequest request;
+    request.ranking = ranking;
+    request.stackDump = {'a', 'b', 'c'};
+    request.offset = offset;
+    request.maxhits = 10;
+    return request;
+}
+
+SearchReply make_reply(size_t num_hits) {
+    SearchReply reply;
+    reply.totalHitCount = 100 + num_hits;
+    reply.maxRank = 42.0;
+    for (size_t i = 0; i < num_hits; ++i) {
+        reply.hits.emplace_back();
+        reply.hits.back().metric = double(num_hits - i);
+    }
+    reply.coverage.setActive(1000).setCovered(1000);
+    return reply;
+}
+
+TEST("require that key covers the parts of the request affecting the result") {
+    SearchRequest base = make_request("default");
+    vespalib::string key = QueryResultCache::makeKey(base);
+    EXPECT_EQUAL(key, QueryResultCache::makeKey(make_request("default")));
+    EXPECT_NOT_EQUAL(key, QueryResultCache::makeKey(make_request("other")));
+    EXPECT_NOT_EQUAL(key, QueryResultCache::makeKey(make_request("default", 5)));
+    SearchRequest with_props = make_request("default");
+    with_props.propertiesMap.lookupCreate(search::MapNames::RANK).add("foo", "1");
+    EXPECT_NOT_EQUAL(key, QueryResultCache::makeKey(with_props));
+    SearchRequest with_sort = make_request("default");
+    with_sort.sortSpec = "+foo";
+    EXPECT_NOT_EQUAL(key, QueryResultCache::makeKey(with_sort));
+}
+
+TEST("require that rank property order does not affect key") {
+    SearchRequest a = make_request("default");
+    a.propertiesMap.lookupCreate(search::MapNames::RANK).add("x", "1").add("y", "2");
+    SearchRequest b = make_request("default");
+    b.propertiesMap.lookupCreate(search::MapNames::RANK).add("y", "2").add("x", "1");
+    EXPECT_EQUAL(QueryResultCache::makeKey(a), QueryResultCache::makeKey(b));
+}
+
+TEST("require that cached replies can be looked up") {
+    QueryResultCache cache(1000000);
+    SearchReply reply;
+    EXPECT_FALSE(cache.lookup("foo", reply));
+    cache.insert("foo", cache.getGeneration(), make_reply(3));
+    EXPECT_TRUE(cache.lookup("foo", reply));
+    EXPECT_EQUAL(103u, reply.totalHitCount);
+    EXPECT_EQUAL(42.0, reply.maxRank);
+    EXPECT_EQUAL(1000u, reply.coverage.getCovered());
+    ASSERT_EQUAL(3u, reply.hits.size());
+    EXPECT_EQUAL(3.0, reply.hits[0].metric);
+    EXPECT_EQUAL(1.0, reply.hits[2].metric);
+    QueryResultCache::Stats stats = cache.getStats();
+    EXPECT_EQUAL(1u, stats.numHits);
+    EXPECT_EQUAL(1u, stats.numMisses);
+    EXPECT_EQUAL(1u, stats.numCached);
+}
+
+TEST("require that invalidation drops cached replies") {
+    QueryResultCache cache(1000000);
+    SearchReply reply;
+    cache.insert("foo", cache.getGeneration(), make_reply(3));
+    cache.invalidate();
+    EXPECT_FALSE(cache.lookup("foo", reply));
+    EXPECT_EQUAL(0u, cache.getStats().memoryUsage);
+}
+
+TEST("require that replies produced before invalidation are not cached") {
+    QueryResultCache cache(1000000);
+    SearchReply reply;
+    uint64_t generation = cache.getGeneration();
+    cache.invalidate();
+    cache.insert("foo", generation, make_reply(3));
+    EXPECT_FALSE(cache.lookup("foo", reply));
+}
+
+TEST("require that least recently used replies are evicted to respect memory limit") {
+    QueryResultCache probe(1000000);
+    probe.insert("a", probe.getGeneration(), make_reply(10));
+    size_t entry_size = probe.getStats().memoryUsage;
+    QueryResultCache cache(2 * entry_size);
+    SearchReply reply;
+    cache.insert("a", cache.getGeneration(), make_reply(10));
+    cache.insert("b", cache.getGeneration(), make_reply(10));
+    EXPECT_TRUE(cache.lookup("a", reply));
+    cache.insert("c", cache.getGeneration(), make_reply(10));
+    EXPECT_EQUAL(2u, cache.getStats().numCached);
+    EXPECT_TRUE(cache.lookup("a", reply));
+    EXPECT_FALSE(cache.lookup("b", reply));
+    EXPECT_TRUE(cache.lookup("c", reply));
+}
+
+TEST("require that disabled cache does not store replies") {
+    QueryResultCache empty(0);
+    EXPECT_FALSE(empty.enabled());
+    QueryResultCache cache(1000000);
+    EXPECT_TRUE(cache.enabled());
+    cache.setEnabled(false);
+    EXPECT_FALSE(cache.enabled());
+    SearchReply reply;
+    cache.insert("foo", cache.getGeneration(), make_reply(3));
+    EXPECT_FALSE(cache.lookup("foo", reply));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
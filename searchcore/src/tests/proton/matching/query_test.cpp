@@ -1,7 +1,9 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 // Unit tests for query.
 
+#include <vespa/searchcore/proton/matching/cached_filter.h>
 #include <vespa/searchcore/proton/matching/fakesearchcontext.h>
+#include <vespa/searchcore/proton/matching/filter_result_cache.h>
 #include <vespa/searchcore/proton/matching/matchdatareservevisitor.h>
 #include <vespa/searchcore/proton/matching/blueprintbuilder.h>
 #include <vespa/searchcore/proton/matching/query.h>
@@ -106,6 +108,8 @@ class Test : public vespalib::TestApp {
     void requireThatWeakAndBlueprintsAreCreatedCorrectly();
     void requireThatParallelWandBlueprintsAreCreatedCorrectly();
     void requireThatWhiteListBlueprintCanBeUsed();
+    void requireThatFilterResultsAreCached();
+    void requireThatFilterKeysIgnoreWeightsAndIds();
     void requireThatSameElementTermsAreProperlyPrefixed();
     void requireThatSameElementDoesNotAllocateMatchData();
     void requireThatSameElementIteratorsCanBeBuilt();
@@ -257,6 +261,7 @@ public:
     void visit(ProtonWandTerm &) override {}
     void visit(ProtonPredicateQuery &) override {}
     void visit(ProtonRegExpTerm &) override {}
+    void visit(ProtonNearestNeighborTerm &) override {}
 };
 
 void Test::requireThatTermsAreLookedUp() {
@@ -408,6 +413,7 @@ public:
     void visit(ProtonWandTerm &) override {}
     void visit(ProtonPredicateQuery &) override {}
     void visit(ProtonRegExpTerm &) override {}
+    void visit(ProtonNearestNeighborTerm &) override {}
 };
 
 void Test::requireThatTermDataIsFilledIn() {
@@ -879,6 +885,46 @@ Test::requireThatWhiteListBlueprintCanBeUsed()
     EXPECT_EQUAL(exp, act);
 }
 
+void
+Test::requireThatFilterResultsAreCached()
+{
+    QueryBuilder<ProtonNodeTypes> builder;
+    builder.addAnd(2);
+    builder.addStringTerm("foo", field, field_id, string_weight);
+    builder.addOr(2);
+    builder.addStringTerm("bar", field, field_id, string_weight).setRanked(false);
+    builder.addStringTerm("baz", field, field_id, string_weight).setRanked(false);
+    std::string stackDump = StackDumpCreator::create(*builder.build());
+
+    FakeSearchContext context(42);
+    context.addIdx(0).idx(0).getFake()
+        .addResult(field, "foo", FakeResult().doc(1).doc(3).doc(5).doc(7))
+        .addResult(field, "bar", FakeResult().doc(3))
+        .addResult(field, "baz", FakeResult().doc(7).doc(9));
+    context.setLimit(42);
+
+    FilterResultCache cache(1000000);
+    for (size_t i = 0; i < 2; ++i) {
+        Query query;
+        query.buildTree(stackDump, "", ViewResolver(), plain_index_env);
+        query.setFilterCache(cache, 1);
+        FakeRequestContext requestContext;
+        MatchDataLayout mdl;
+        query.reserveHandles(requestContext, context, mdl);
+        MatchData::UP md = mdl.createMatchData();
+
+        query.optimize();
+        query.fetchPostings();
+        SearchIterator::UP search = query.createSearch(*md);
+        SimpleResult exp = SimpleResult().addHit(3).addHit(7);
+        SimpleResult act;
+        act.search(*search);
+        EXPECT_EQUAL(exp, act);
+        EXPECT_EQUAL(i, cache.getStats().numHits);
+    }
+    EXPECT_EQUAL(1u, cache.getStats().numCached);
+}
+
 search::query::Node::UP
 make_same_element_stack_dump(const vespalib::string &prefix, const vespalib::string &term_prefix)
 {
@@ -894,6 +940,28 @@ make_same_element_stack_dump(const vespalib::string &prefix, const vespalib::str
     return query;
 }
 
+namespace {
+
+vespalib::string
+filterKey(const string &term, int32_t id, Weight weight, uint32_t distance) {
+    QueryBuilder<ProtonNodeTypes> builder;
+    builder.addNear(2, distance);
+    builder.addStringTerm(term, field, id, weight);
+    builder.addPrefixTerm("bar", field, id + 1, weight);
+    return createFilterKey(*builder.build());
+}
+
+}
+
+void
+Test::requireThatFilterKeysIgnoreWeightsAndIds()
+{
+    vespalib::string key = filterKey("foo", 1, Weight(100), 2);
+    EXPECT_EQUAL(key, filterKey("foo", 7, Weight(200), 2));
+    EXPECT_NOT_EQUAL(key, filterKey("fo", 1, Weight(100), 2));
+    EXPECT_NOT_EQUAL(key, filterKey("foo", 1, Weight(100), 3));
+}
+
 void
 Test::requireThatSameElementTermsAreProperlyPrefixed()
 {
@@ -984,6 +1052,8 @@ Test::Main()
     TEST_CALL(requireThatWeakAndBlueprintsAreCreatedCorrectly);
     TEST_CALL(requireThatParallelWandBlueprintsAreCreatedCorrectly);
     TEST_CALL(requireThatWhiteListBlueprintCanBeUsed);
+    TEST_CALL(requireThatFilterResultsAreCached);
+    TEST_CALL(requireThatFilterKeysIgnoreWeightsAndIds);
     TEST_CALL(requireThatSameElementTermsAreProperlyPrefixed);
     TEST_CALL(requireThatSameElementDoesNotAllocateMatchData);
     TEST_CALL(requireThatSameElementIteratorsCanBeBuilt);
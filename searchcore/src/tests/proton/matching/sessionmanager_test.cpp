@@ -59,6 +59,33 @@ TEST("require that SessionManager handles SearchSessions.") {
     EXPECT_FALSE(session.get());
 }
 
+TEST("require that implicit SearchSessions are bounded") {
+    fastos::TimeStamp doom(1000);
+    SessionManager session_manager(10, 0, fastos::TimeStamp(0), 0, 2);
+    EXPECT_TRUE(session_manager.cachesImplicitSearchSessions());
+    for (const char *id : {"foo", "bar", "baz"}) {
+        session_manager.insertImplicit(SearchSession::SP(new SearchSession(id, doom,
+            MatchToolsFactory::UP(), SearchSession::OwnershipBundle())));
+    }
+    session_manager.insert(SearchSession::SP(new SearchSession("qux", doom,
+        MatchToolsFactory::UP(), SearchSession::OwnershipBundle())));
+    TEST_DO(checkStats(session_manager.getSearchStats(), 3, 0, 1, 3, 0));
+    EXPECT_EQUAL(3u, session_manager.getNumSearchSessions());
+    EXPECT_TRUE(session_manager.pickSearch("foo").get());
+    EXPECT_TRUE(session_manager.pickSearch("qux").get());
+    EXPECT_FALSE(session_manager.pickSearch("baz").get());
+    session_manager.pruneTimedOutSessions(2000);
+    TEST_DO(checkStats(session_manager.getSearchStats(), 0, 2, 0, 0, 3));
+}
+
+TEST("require that implicit SearchSessions are disabled by default") {
+    SessionManager session_manager(10);
+    EXPECT_FALSE(session_manager.cachesImplicitSearchSessions());
+    session_manager.insertImplicit(SearchSession::SP(new SearchSession("foo", fastos::TimeStamp(1000),
+        MatchToolsFactory::UP(), SearchSession::OwnershipBundle())));
+    EXPECT_EQUAL(0u, session_manager.getNumSearchSessions());
+}
+
 TEST("require that SessionManager can be explored") {
     fastos::TimeStamp doom(1000);
     SessionManager session_manager(10);
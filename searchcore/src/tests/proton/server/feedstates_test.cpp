@@ -25,6 +25,7 @@ using document::DocumentId;
 using document::DocumentTypeRepo;
 using document::TestDocRepo;
 using search::transactionlog::Packet;
+using search::transactionlog::RPC;
 using search::SerialNum;
 using storage::spi::Timestamp;
 using vespalib::ConstBufferRef;
@@ -37,12 +38,16 @@ struct MyFeedView : public test::DummyFeedView {
     TestDocRepo repo;
     std::shared_ptr<const DocumentTypeRepo> repo_sp;
     int remove_handled;
+    std::vector<SerialNum> removed_serials;
 
     MyFeedView();
     ~MyFeedView();
 
     const std::shared_ptr<const DocumentTypeRepo> &getDocumentTypeRepo() const override { return repo_sp; }
-    void handleRemove(FeedToken , const RemoveOperation &) override { ++remove_handled; }
+    void handleRemove(FeedToken , const RemoveOperation &op) override {
+        ++remove_handled;
+        removed_serials.push_back(op.getSerialNum());
+    }
 };
 
 MyFeedView::MyFeedView() : repo_sp(repo.getTypeRepoSp()), remove_handled(0) {}
@@ -70,11 +75,11 @@ struct Fixture
     bucketdb::BucketDBHandler _bucketDBHandler;
     ReplayTransactionLogState state;
 
-    Fixture();
+    Fixture(uint32_t decodeThreads = 0);
     ~Fixture();
 };
 
-Fixture::Fixture()
+Fixture::Fixture(uint32_t decodeThreads)
     : feed_view1(),
       feed_view2(),
       feed_view_ptr(&feed_view1),
@@ -82,7 +87,7 @@ Fixture::Fixture()
       config_store(),
       _bucketDB(),
       _bucketDBHandler(_bucketDB),
-      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store)
+      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, decodeThreads)
 {
 }
 Fixture::~Fixture() = default;
@@ -95,11 +100,11 @@ struct RemoveOperationContext
     nbostream str;
     std::unique_ptr<Packet> packet;
 
-    RemoveOperationContext(search::SerialNum serial);
+    RemoveOperationContext(search::SerialNum serial, size_t numEntries = 1);
     ~RemoveOperationContext();
 };
 
-RemoveOperationContext::RemoveOperationContext(search::SerialNum serial)
+RemoveOperationContext::RemoveOperationContext(search::SerialNum serial, size_t numEntries)
     : doc_id("doc:foo:bar"),
       op(BucketFactory::getBucketId(doc_id), Timestamp(10), doc_id),
       str(), packet()
@@ -107,7 +112,9 @@ RemoveOperationContext::RemoveOperationContext(search::SerialNum serial)
     op.serialize(str);
     ConstBufferRef buf(str.c_str(), str.wp());
     packet.reset(new Packet());
-    packet->add(Packet::Entry(serial, FeedOperation::REMOVE, buf));
+    for (size_t i = 0; i < numEntries; ++i) {
+        packet->add(Packet::Entry(serial + i, FeedOperation::REMOVE, buf));
+    }
 }
 RemoveOperationContext::~RemoveOperationContext() = default;
 TEST_F("require that active FeedView can change during replay", Fixture)
@@ -139,6 +146,23 @@ TEST_F("require that replay progress is tracked", Fixture)
     EXPECT_EQUAL(0.5, progress.getProgress());
 }
 
+TEST_F("require that operations are replayed in order when decoded by separate threads", Fixture(4))
+{
+    RemoveOperationContext opCtx(10, 20);
+    TlsReplayProgress progress("test", 5, 45);
+    PacketWrapper::SP wrap(new PacketWrapper(*opCtx.packet, &progress));
+    InstantExecutor executor;
+
+    f.state.receive(wrap, executor);
+    wrap->gate.await();
+    EXPECT_EQUAL(20, f.feed_view1.remove_handled);
+    for (size_t i = 0; i < f.feed_view1.removed_serials.size(); ++i) {
+        EXPECT_EQUAL(10u + i, f.feed_view1.removed_serials[i]);
+    }
+    EXPECT_EQUAL(29u, progress.getCurrent());
+    EXPECT_EQUAL(RPC::OK, wrap->result);
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
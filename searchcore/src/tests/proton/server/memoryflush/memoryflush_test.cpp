@@ -45,6 +45,7 @@ private:
     SerialNum  _flushedSerial;
     TimeStamp  _lastFlushTime;
     bool       _urgentFlush;
+    uint64_t   _approxBytesToWriteToDisk;
 public:
     MyFlushTarget(const vespalib::string &name, MemoryGain memoryGain,
                   DiskGain diskGain, SerialNum flushedSerial,
@@ -54,15 +55,21 @@ public:
         _diskGain(diskGain),
         _flushedSerial(flushedSerial),
         _lastFlushTime(lastFlushTime),
-        _urgentFlush(urgentFlush)
+        _urgentFlush(urgentFlush),
+        _approxBytesToWriteToDisk(0)
     {
     }
+    MyFlushTarget &setApproxBytesToWriteToDisk(uint64_t bytes) {
+        _approxBytesToWriteToDisk = bytes;
+        return *this;
+    }
     // Implements IFlushTarget
     virtual MemoryGain getApproxMemoryGain() const override { return _memoryGain; }
     virtual DiskGain getApproxDiskGain() const override { return _diskGain; }
     virtual SerialNum getFlushedSerialNum() const override { return _flushedSerial; }
     virtual TimeStamp getLastFlushTime() const override { return _lastFlushTime; }
     virtual bool needUrgentFlush() const override { return _urgentFlush; }
+    virtual uint64_t getApproxBytesToWriteToDisk() const override { return _approxBytesToWriteToDisk; }
 };
 
 struct StringList : public std::vector<vespalib::string> {
@@ -312,6 +319,30 @@ requireThatWeHandleLargeSerialNumbersWhenOrderingByTlsSize()
                             flush.getFlushTargets(builder.list(), builder.tlsStats())));
 }
 
+void
+requireThatTlsSizeOrderConsidersBytesToWrite()
+{
+    ContextBuilder cb;
+    IFlushHandler::SP handler1(std::make_shared<MyFlushHandler>("handler1"));
+    IFlushHandler::SP handler2(std::make_shared<MyFlushHandler>("handler2"));
+    cb.addTls("handler1", {20 * gibi, 1001, 2000 });
+    cb.addTls("handler2", { 5 * gibi, 1001, 2000 });
+    auto t1 = std::make_shared<MyFlushTarget>("t1", MemoryGain(), DiskGain(), 1000, TimeStamp(), false);
+    auto t2 = createTargetT("t2", TimeStamp(), 1900);
+    auto t3 = std::make_shared<MyFlushTarget>("t3", MemoryGain(), DiskGain(), 1000, TimeStamp(), false);
+    auto t4 = createTargetT("t4", TimeStamp(), 1900);
+    t1->setApproxBytesToWriteToDisk(10 * gibi);  // frees 18 GiB of handler1 tls
+    t3->setApproxBytesToWriteToDisk(gibi / 10);  // frees 4.5 GiB of handler2 tls
+    cb.add(std::make_shared<FlushContext>(handler1, t1, 2000))
+      .add(std::make_shared<FlushContext>(handler1, t2, 2000))
+      .add(std::make_shared<FlushContext>(handler2, t3, 2000))
+      .add(std::make_shared<FlushContext>(handler2, t4, 2000));
+    MemoryFlush flush({1000, 3 * gibi, 1.0, 1000, 1.0, TimeStamp(30 * TimeStamp::SEC)});
+    // t2 and t4 do not free any tls before t1 and t3 are flushed
+    EXPECT_TRUE(assertOrder(StringList().add("t3").add("t1").add("t2").add("t4"),
+                            flush.getFlushTargets(cb.list(), cb.tlsStats())));
+}
+
 void
 requireThatOrderTypeIsPreserved()
 {
@@ -352,6 +383,7 @@ TEST_MAIN()
     TEST_DO(requireThatWeCanOrderByAge());
     TEST_DO(requireThatWeCanOrderByTlsSize());
     TEST_DO(requireThatWeHandleLargeSerialNumbersWhenOrderingByTlsSize());
+    TEST_DO(requireThatTlsSizeOrderConsidersBytesToWrite());
     TEST_DO(requireThatOrderTypeIsPreserved());
 }
 
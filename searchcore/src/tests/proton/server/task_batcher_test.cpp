@@ -0,0 +1,75 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for task_batcher.
+
+#include <vespa/log/log.h>
+LOG_SETUP("task_batcher_test");
+
+#include <vespa/searchcore/proton/server/task_batcher.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/gate.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <thread>
+
+using vespalib::Gate;
+using vespalib::ThreadStackExecutor;
+using vespalib::makeLambdaTask;
+
+using namespace proton;
+
+namespace {
+
+TEST("require that tasks are run in order") {
+    ThreadStackExecutor executor(1, 128 * 1024);
+    TaskBatcher batcher(executor, 1000);
+    std::vector<int> result;
+    for (int i = 0; i < 10000; ++i) {
+        batcher.execute(makeLambdaTask([&result, i]() { result.push_back(i); }));
+    }
+    executor.sync();
+    ASSERT_EQUAL(10000u, result.size());
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_EQUAL(i, result[i]);
+    }
+    EXPECT_LESS_EQUAL(batcher.getBatches(), 10000u);
+}
+
+TEST("require that tasks added while the executor is busy share one batch") {
+    ThreadStackExecutor executor(1, 128 * 1024);
+    TaskBatcher batcher(executor, 1000);
+    Gate gate;
+    executor.execute(makeLambdaTask([&gate]() { gate.await(); }));
+    size_t count = 0;
+    for (int i = 0; i < 100; ++i) {
+        batcher.execute(makeLambdaTask([&count]() { ++count; }));
+    }
+    EXPECT_EQUAL(1u, batcher.getBatches());
+    gate.countDown();
+    executor.sync();
+    EXPECT_EQUAL(100u, count);
+    batcher.execute(makeLambdaTask([&count]() { ++count; }));
+    executor.sync();
+    EXPECT_EQUAL(2u, batcher.getBatches());
+    EXPECT_EQUAL(101u, count);
+}
+
+TEST("require that adding blocks while too many tasks are pending") {
+    ThreadStackExecutor executor(1, 128 * 1024);
+    TaskBatcher batcher(executor, 10);
+    Gate gate;
+    executor.execute(makeLambdaTask([&gate]() { gate.await(); }));
+    size_t count = 0;
+    for (int i = 0; i < 10; ++i) {
+        batcher.execute(makeLambdaTask([&count]() { ++count; }));
+    }
+    std::thread releaser([&gate]() { gate.countDown(); });
+    batcher.execute(makeLambdaTask([&count]() { ++count; }));
+    releaser.join();
+    executor.sync();
+    EXPECT_EQUAL(11u, count);
+    EXPECT_EQUAL(2u, batcher.getBatches());
+}
+
+}  // namespace
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -3,6 +3,7 @@
 LOG_SETUP("visibility_handler_test");
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/searchcore/proton/server/visibilityhandler.h>
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
 #include <vespa/searchcore/proton/test/dummy_feed_view.h>
 #include <vespa/searchcore/proton/test/threading_service_observer.h>
 #include <vespa/searchcore/proton/server/executorthreadingservice.h>
@@ -15,6 +16,8 @@ using proton::ExecutorThreadingService;
 using proton::test::ThreadingServiceObserver;
 using proton::IFeedView;
 using proton::VisibilityHandler;
+using proton::AdaptiveVisibilityDelay;
+using proton::matching::QueryResultCache;
 using vespalib::makeLambdaTask;
 using fastos::TimeStamp;
 
@@ -38,24 +41,29 @@ class MyFeedView : public DummyFeedView
 {
     uint32_t _forceCommitCount;
     SerialNum _committedSerialNum;
+    std::shared_ptr<search::IDestructorCallback> _pendingDone;
 
 
 public:
     MyFeedView()
         : _forceCommitCount(0u),
-          _committedSerialNum(0u)
+          _committedSerialNum(0u),
+          _pendingDone()
     {
     }
 
-    void forceCommit(SerialNum serialNum) override
+    void forceCommit(SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onDone) override
     {
         EXPECT_TRUE(serialNum >= _committedSerialNum);
         _committedSerialNum = serialNum;
         ++_forceCommitCount;
+        _pendingDone = std::move(onDone);
     }
 
     uint32_t getForceCommitCount() const { return _forceCommitCount; }
     SerialNum getCommittedSerialNum() const { return _committedSerialNum; }
+    bool hasPendingDone() const { return bool(_pendingDone); }
+    void commitDone() { _pendingDone.reset(); }
 };
 
 
@@ -206,4 +214,114 @@ TEST_F("Check internal commitAndWait with nonzero visibility delay and no new fe
     f.testCommitAndWait(1.0, true, 0u, 0u, 1u, 1u, 0u);
 }
 
+TEST_F("Check that regular commit is skipped until adaptive visibility delay has passed", Fixture)
+{
+    f._visibilityHandler.setMinVisibilityDelay(TimeStamp::Seconds(10.0));
+    f.testCommit(100.0, false, 1u, 10u, 1u, 0u);
+    f.testCommit(100.0, false, 1u, 10u, 2u, 0u, 20u);
+    f.testCommitAndWait(100.0, false, 2u, 20u, 3u, 1u, 20u);
+}
+
+TEST_F("Check that result cache is invalidated when commit is done", Fixture)
+{
+    QueryResultCache cache(1024);
+    f._visibilityHandler.setResultCache(&cache);
+    f.testCommit(1.0, false, 1u, 10u, 1u, 0u);
+    uint64_t generation = cache.getGeneration();
+    EXPECT_TRUE(f._feedViewReal->hasPendingDone());
+    f._feedViewReal->commitDone();
+    EXPECT_EQUAL(generation + 1, cache.getGeneration());
+}
+
+TEST_F("Check that result cache is not invalidated by commit without new feed operations", Fixture)
+{
+    QueryResultCache cache(1024);
+    f._visibilityHandler.setResultCache(&cache);
+    f.testCommit(1.0, false, 1u, 10u, 1u, 0u);
+    f._feedViewReal->commitDone();
+    uint64_t generation = cache.getGeneration();
+    f._visibilityHandler.commit();
+    f._writeService.master().sync();
+    f.checkCommitPostCondition(2u, 10u, 2u, 0u);
+    EXPECT_FALSE(f._feedViewReal->hasPendingDone());
+    f._visibilityHandler.commitAndWait();
+    f.checkCommitPostCondition(2u, 10u, 2u, 1u);
+    EXPECT_EQUAL(generation, cache.getGeneration());
+}
+
+namespace {
+
+TimeStamp
+seconds(double value)
+{
+    return TimeStamp(TimeStamp::Seconds(value));
+}
+
+/*
+ * Commit at the given interval for a while, with the given feed rate
+ * and commit cost, and return the resulting delay in seconds.
+ */
+double
+adaptedDelay(AdaptiveVisibilityDelay &delay, double feedRate, double commitCost, double interval)
+{
+    double now = 1000.0;
+    double ops = 0.0;
+    delay.commitDone(seconds(now), 0u, seconds(commitCost));
+    for (uint32_t i = 0; i < 100; ++i) {
+        now += interval;
+        ops += feedRate * interval;
+        delay.commitDone(seconds(now), SerialNum(ops + 0.5), seconds(commitCost));
+    }
+    return delay.getDelay().sec();
+}
+
+}
+
+TEST("Check that visibility delay is fixed without min delay")
+{
+    AdaptiveVisibilityDelay delay;
+    delay.setDelays(seconds(0.0), seconds(1.0));
+    EXPECT_FALSE(delay.isAdaptive());
+    EXPECT_EQUAL(1.0, delay.getCheckInterval().sec());
+    EXPECT_EQUAL(1.0, adaptedDelay(delay, 10000.0, 0.5, 1.0));
+    EXPECT_TRUE(delay.isCommitDue(seconds(1000.0)));
+}
+
+TEST("Check that adaptive visibility delay stays at min delay when commits are cheap")
+{
+    AdaptiveVisibilityDelay delay;
+    delay.setDelays(seconds(0.1), seconds(1.0));
+    EXPECT_TRUE(delay.isAdaptive());
+    EXPECT_EQUAL(0.1, delay.getCheckInterval().sec());
+    EXPECT_EQUAL(0.1, adaptedDelay(delay, 100.0, 0.001, 0.1));
+}
+
+TEST("Check that adaptive visibility delay stays at min delay when feed rate is low")
+{
+    AdaptiveVisibilityDelay delay;
+    delay.setDelays(seconds(0.1), seconds(1.0));
+    EXPECT_EQUAL(0.1, adaptedDelay(delay, 1.0, 0.02, 1.0));
+    EXPECT_APPROX(1.0, delay.getFeedRate(), 0.01);
+}
+
+TEST("Check that adaptive visibility delay grows with feed rate and commit cost")
+{
+    AdaptiveVisibilityDelay delay;
+    delay.setDelays(seconds(0.1), seconds(1.0));
+    EXPECT_APPROX(0.4, adaptedDelay(delay, 1000.0, 0.02, 0.1), 0.01);
+    EXPECT_APPROX(1000.0, delay.getFeedRate(), 1.0);
+    EXPECT_APPROX(0.02, delay.getCommitCost(), 0.001);
+    EXPECT_EQUAL(1.0, adaptedDelay(delay, 1000.0, 0.1, 0.1));
+}
+
+TEST("Check that commit is due when adaptive visibility delay has passed")
+{
+    AdaptiveVisibilityDelay delay;
+    delay.setDelays(seconds(0.1), seconds(1.0));
+    EXPECT_APPROX(0.4, adaptedDelay(delay, 1000.0, 0.02, 0.1), 0.01);
+    double last = 1000.0 + 100 * 0.1;
+    EXPECT_FALSE(delay.isCommitDue(seconds(last + 0.2)));
+    EXPECT_TRUE(delay.isCommitDue(seconds(last + 0.4)));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
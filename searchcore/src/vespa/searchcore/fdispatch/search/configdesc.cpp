@@ -48,6 +48,7 @@ FastS_DataSetDesc::FastS_DataSetDesc(uint32_t datasetid)
       _higherCoverageMinSearchWait(0.0),
       _higherCoverageBaseSearchWait(0.1),
       _minimalSearchCoverage(100.0),
+      _incrementalMerge(false),
       _higherCoverageMaxDocSumWait(0.3),
       _higherCoverageMinDocSumWait(0.1),
       _higherCoverageBaseDocSumWait(0.1),
@@ -311,6 +312,7 @@ FastS_DataSetCollDesc::ReadConfig(const PartitionsConfig& partmap)
         dataset->setHigherCoverageMinSearchWait(dsconfig.higherCoverageMinsearchwait);
         dataset->setHigherCoverageBaseSearchWait(dsconfig.higherCoverageBasesearchwait);
         dataset->setMinimalSearchCoverage(dsconfig.minimalSearchcoverage);
+        dataset->setIncrementalMerge(dsconfig.incrementalmerge);
         dataset->setHigherCoverageMaxDocSumWait(dsconfig.higherCoverageMaxdocsumwait);
         dataset->setHigherCoverageMinDocSumWait(dsconfig.higherCoverageMindocsumwait);
         dataset->setHigherCoverageBaseDocSumWait(dsconfig.higherCoverageBasedocsumwait);
@@ -151,6 +151,7 @@ private:
     double   _higherCoverageMinSearchWait;
     double   _higherCoverageBaseSearchWait;
     double   _minimalSearchCoverage;
+    bool     _incrementalMerge;
     double   _higherCoverageMaxDocSumWait;
     double   _higherCoverageMinDocSumWait;
     double   _higherCoverageBaseDocSumWait;
@@ -291,6 +292,16 @@ public:
         return _minimalSearchCoverage;
     }
 
+    void
+    setIncrementalMerge(bool incrementalMerge) {
+        _incrementalMerge = incrementalMerge;
+    }
+
+    bool
+    getIncrementalMerge() const {
+        return _incrementalMerge;
+    }
+
     void
     setHigherCoverageMaxDocSumWait(double higherCoverageMaxDocSumWait) {
         _higherCoverageMaxDocSumWait = higherCoverageMaxDocSumWait;
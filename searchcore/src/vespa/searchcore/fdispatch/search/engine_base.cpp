@@ -16,6 +16,7 @@ FastS_EngineBase::stats_t::stats_t()
       _slowDocsumCnt(0),
       _slowQuerySecs(0.0),
       _slowDocsumSecs(0.0),
+      _queryLatency(20.0),
       _queueLenSampleAcc(0),
       _queueLenSampleCnt(0),
       _activecntSampleAcc(0),
@@ -207,8 +208,9 @@ void
 FastS_EngineBase::UpdateSearchTime(double tnow, double elapsed, bool timedout)
 {
     (void) tnow;
-    (void) elapsed;
     (void) timedout;
+    std::lock_guard<std::mutex> engineGuard(_lock);
+    _stats._queryLatency.update(elapsed);
 }
 
 void
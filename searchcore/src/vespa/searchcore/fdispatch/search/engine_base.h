@@ -48,6 +48,9 @@ public:
         double      _slowQuerySecs;
         double      _slowDocsumSecs;
 
+        // query latency, used to avoid nodes lagging behind their replicas
+        fdispatch::LatencyEstimate _queryLatency;
+
         // active cnt + queue len sampling
         uint32_t _queueLenSampleAcc;  // sum of reported queue lengths
         uint32_t _queueLenSampleCnt;  // number of reported queue lengths
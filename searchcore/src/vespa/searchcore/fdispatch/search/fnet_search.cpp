@@ -6,6 +6,7 @@
 #include "fnet_search.h"
 #include "mergehits.h"
 #include <vespa/searchlib/engine/packetconverter.h>
+#include <vespa/searchlib/engine/searchreply.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/xxhash/xxhash.h>
 
@@ -539,6 +540,8 @@ FastS_FNET_Search::FastS_FNET_Search(FastS_DataSetCollection *dsc,
       _startTime(timeKeeper->GetTime()),
       _timeout(dataset->GetAppContext()->GetFNETScheduler(), this),
       _util(),
+      _groupMerger(),
+      _partialMerger(),
       _dsc(dsc),
       _dataset(dataset),
       _datasetActiveCostRef(true),
@@ -611,6 +614,9 @@ FastS_FNET_Search::GotQueryResult(FastS_FNET_SearchNode *node,
         EncodePartIDs(node->getPartID(), node->GetRowID(),
                       (qrx->_features & search::fs4transport::QRF_MLD) != 0,
                       qrx->_hits, qrx->_hits + qrx->_numDocs);
+        if (_partialMerger) {
+            _partialMerger->AddNode(node);
+        }
         LOG(spam, "Got result from row(%d), part(%d) = hits(%d), numDocs(%" PRIu64 ")", node->GetRowID(), node->getPartID(), qrx->_numDocs, qrx->_totNumDocs);
         node->_flags._pendingQuery = false;
         _pendingQueries--;
@@ -837,7 +843,7 @@ void
 FastS_FNET_Search::MergeHits()
 {
     FastS_HitMerger<FastS_FNETMerge> merger(this);
-    merger.MergeHits();
+    merger.MergeHits(_partialMerger.get());
 
     if (_util.IsEstimate())
         return;
@@ -884,6 +890,16 @@ FastS_FNET_Search::CheckCoverage()
             cntNone++;
         }
     }
+    if (_queryTimeout && (_queryNodesTimedOut > 0)) {
+        // replies were given up on, either after reaching minimal coverage or at the query timeout
+        search::engine::SearchReply::Coverage coverage;
+        if (_queryWaitCalculated) {
+            coverage.degradeAdaptiveTimeout();
+        } else {
+            coverage.degradeTimeout();
+        }
+        degradedReason |= coverage.getDegradeReason();
+    }
     const ssize_t missingParts = cntNone - (_dataset->getSearchableCopies() - 1);
     if ((missingParts > 0) && (cntNone != _nodes.size())) {
         // TODO This is a dirty way of anticipating missing coverage.
@@ -1070,6 +1086,13 @@ FastS_FNET_Search::Search(uint32_t searchOffset,
                            ? _dataset->GetMaxHitsPerNode()
                            : _util.GetAlignedMaxHits();
 
+    // merge hits as replies arrive when ordering on rank only
+    if (_dataset->useIncrementalMerge() && !_util.IsEstimate() &&
+        !ShouldLimitHitsPerNode() && _queryArgs->sortSpec.empty())
+    {
+        _partialMerger = std::make_unique<FastS_PartialHitMerger<FastS_FNETMerge>>(_util.GetAlignedMaxHits());
+    }
+
     // set up expected _queryNodes, _pendingQueries and node->_flags._pendingQuery state
     for (FastS_FNET_SearchNode & node : _nodes) {
         if (node.IsConnected()) {
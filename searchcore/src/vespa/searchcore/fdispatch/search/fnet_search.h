@@ -13,6 +13,8 @@
 
 class FastS_FNET_Engine;
 class FastS_FNET_Search;
+struct FastS_FNETMerge;
+template <typename T> class FastS_PartialHitMerger;
 
 using search::fs4transport::FS4Packet_QUERYRESULTX;
 using search::fs4transport::FS4Packet_GETDOCSUMSX;
@@ -210,6 +212,7 @@ private:
     Timeout                  _timeout;
     FastS_QueryCacheUtil     _util;
     std::unique_ptr<search::grouping::MergingManager> _groupMerger;
+    std::unique_ptr<FastS_PartialHitMerger<FastS_FNETMerge>> _partialMerger;
     FastS_DataSetCollection *_dsc;  // owner keeps this alive
     FastS_FNET_DataSet      *_dataset;
     bool                     _datasetActiveCostRef;
@@ -7,6 +7,7 @@
 #include <vespa/searchcore/util/stlishheap.h>
 #include <vespa/vespalib/stllike/hash_set.h>
 #include <vespa/vespalib/stllike/hash_set.hpp>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".fdispatch.mergehits");
@@ -67,6 +68,81 @@ FastS_MergeCopyHit(typename T::HitType *src,
     dst->setDistributionKey(src->getDistributionKey());
 }
 
+//-----------------------------------------------------------------------------
+
+template <typename T>
+FastS_PartialHitMerger<T>::FastS_PartialHitMerger(uint32_t maxHits)
+    : _heap(),
+      _gids(maxHits * 3),
+      _maxHits(maxHits),
+      _numAdded(0),
+      _valid(true)
+{
+    _heap.reserve(maxHits + 1);
+}
+
+
+template <typename T>
+FastS_PartialHitMerger<T>::~FastS_PartialHitMerger() = default;
+
+
+template <typename T>
+void
+FastS_PartialHitMerger<T>::AddNode(NODE *node)
+{
+    uint32_t numDocs = 0;
+    uint64_t totalHits = 0;
+    search::HitRank maxRank = 0;
+    uint32_t sortDataDocs = 0;
+
+    if (!_valid || (_maxHits == 0) ||
+        !node->NT_InitMerge(&numDocs, &totalHits, &maxRank, &sortDataDocs))
+    {
+        return;
+    }
+    if (sortDataDocs > 0) {
+        _valid = false;
+        _heap.clear();
+        _gids.clear();
+        return;
+    }
+    for (; node->NT_GetNumHitsLeft() > 0; node->NT_NextHit()) {
+        Entry entry = { node->NT_GetHit(), _numAdded++ };
+        if ((_heap.size() == _maxHits) && !Better(entry, _heap.front())) {
+            break; // hits from a node are ordered on rank
+        }
+        if (!_gids.insert(entry._hit->HT_GetGlobalID()).second) {
+            continue;
+        }
+        _heap.push_back(entry);
+        std::push_heap(_heap.begin(), _heap.end(), Better);
+        if (_heap.size() > _maxHits) {
+            std::pop_heap(_heap.begin(), _heap.end(), Better);
+            _gids.erase(_heap.back()._hit->HT_GetGlobalID());
+            _heap.pop_back();
+        }
+    }
+}
+
+
+template <typename T>
+uint32_t
+FastS_PartialHitMerger<T>::Finish(FastS_hitresult *beg, FastS_hitresult *end)
+{
+    std::sort_heap(_heap.begin(), _heap.end(), Better);
+    FastS_hitresult *pt = beg;
+    for (const Entry &entry : _heap) {
+        if (pt == end) {
+            break;
+        }
+        FastS_MergeCopyHit<T>(entry._hit, pt++);
+    }
+    _heap.clear();
+    return (pt - beg);
+}
+
+//-----------------------------------------------------------------------------
+
 struct GlobalIdHasher {
     vespalib::hash_set<document::GlobalId, document::GlobalId::hash> seenSet;
     bool insert(const document::GlobalId & g_id) {
@@ -180,7 +256,7 @@ FastS_HitMerger<T>::AllocSortRef(uint32_t size)
 
 template <typename T>
 void
-FastS_HitMerger<T>::MergeHits()
+FastS_HitMerger<T>::MergeHits(FastS_PartialHitMerger<T> *partial)
 {
     uint32_t numNodes     = _search->ST_GetNumNodes();
     bool     dropSortData = _search->ST_ShouldDropSortData();
@@ -235,7 +311,10 @@ FastS_HitMerger<T>::MergeHits()
     _search->ST_SetNumHits(numDocs); // NB: allocs result buffer
 
     // do actual merging by invoking templated function
-    if (useSortData) {
+    if ((partial != NULL) && partial->IsValid() && !useSortData) {
+        numDocs = partial->Finish(_search->ST_GetAlignedHitBuf(),
+                                  _search->ST_GetAlignedHitBufEnd());
+    } else if (useSortData) {
         if (dropSortData) {
             numDocs = FastS_InternalMergeHits
                 <T, FastS_MergeFeatures<true, true> >(this);
@@ -277,6 +356,8 @@ FastS_HitMerger<T>::MergeHits()
 
 //-----------------------------------------------------------------------------
 
+template class FastS_PartialHitMerger<FastS_MergeHits_DummyMerge>; // for API check
+template class FastS_PartialHitMerger<FastS_FNETMerge>;
 template class FastS_HitMerger<FastS_MergeHits_DummyMerge>; // for API check
 template class FastS_HitMerger<FastS_FNETMerge>;
 
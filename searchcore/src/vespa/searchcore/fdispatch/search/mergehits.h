@@ -5,6 +5,8 @@
 #include <vespa/searchlib/common/sortdata.h>
 #include <vespa/searchlib/common/packets.h>
 #include <vespa/document/base/globalid.h>
+#include <vespa/vespalib/stllike/hash_set.h>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 
@@ -96,6 +98,65 @@ struct FastS_FNETMerge
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Bounded top-k over the hits of the nodes that have replied so far,
+ * updated as each reply arrives. When the last reply arrives only its
+ * own hits are left to merge, instead of all hits of all nodes.
+ *
+ * Only results ordered on rank are supported. A reply with sort data
+ * invalidates the partial merge, and the full merge is done instead.
+ * Hits with equal rank are ordered on arrival.
+ **/
+template <typename T>
+class FastS_PartialHitMerger
+{
+private:
+    FastS_PartialHitMerger(const FastS_PartialHitMerger &);
+    FastS_PartialHitMerger& operator=(const FastS_PartialHitMerger &);
+
+    typedef typename T::HitType  HIT;
+    typedef typename T::NodeType NODE;
+
+    struct Entry {
+        HIT      *_hit;
+        uint32_t  _order;
+    };
+
+    static bool Better(const Entry &a, const Entry &b) {
+        return ((a._hit->HT_GetMetric() > b._hit->HT_GetMetric()) ||
+                ((a._hit->HT_GetMetric() == b._hit->HT_GetMetric()) && (a._order < b._order)));
+    }
+
+    // heap with the worst hit kept on top
+    std::vector<Entry>    _heap;
+    vespalib::hash_set<document::GlobalId, document::GlobalId::hash> _gids;
+    uint32_t              _maxHits;
+    uint32_t              _numAdded;
+    bool                  _valid;
+
+public:
+    FastS_PartialHitMerger(uint32_t maxHits);
+    ~FastS_PartialHitMerger();
+
+    bool IsValid() const { return _valid; }
+    uint32_t GetNumHits() const { return _heap.size(); }
+
+    /**
+     * Merge the hits of a node that has replied. The hits stay owned
+     * by the node and must outlive this object.
+     **/
+    void AddNode(NODE *node);
+
+    /**
+     * Write the merged hits to the given buffer, best hit first.
+     *
+     * @return number of hits written
+     **/
+    uint32_t Finish(FastS_hitresult *beg, FastS_hitresult *end);
+};
+
+//-----------------------------------------------------------------------------
+
 template <typename T>
 class FastS_HitMerger
 {
@@ -154,5 +215,10 @@ public:
 
     search::common::SortData::Ref *GetSortRef() const { return _sortRef; }
 
-    void MergeHits();
+    /**
+     * Merge the hits of all nodes into the result of the search. If a
+     * valid partial merge is given, the hits are taken from it rather
+     * than merged again.
+     **/
+    void MergeHits(FastS_PartialHitMerger<T> *partial = NULL);
 };
@@ -207,6 +207,7 @@ FastS_PlainDataSet::FastS_PlainDataSet(FastS_AppContext *appCtx,
       _higherCoverageMinSearchWait(desc->getHigherCoverageMinSearchWait()),
       _higherCoverageBaseSearchWait(desc->getHigherCoverageBaseSearchWait()),
       _minimalSearchCoverage(desc->getMinimalSearchCoverage()),
+      _incrementalMerge(desc->getIncrementalMerge()),
       _higherCoverageMaxDocSumWait(desc->getHigherCoverageMaxDocSumWait()),
       _higherCoverageMinDocSumWait(desc->getHigherCoverageMinDocSumWait()),
       _higherCoverageBaseDocSumWait(desc->getHigherCoverageBaseDocSumWait()),
@@ -307,6 +308,21 @@ FastS_PlainDataSet::UseNewEngine(FastS_EngineBase *oldEngine,
         return false;
     }
 
+    /*
+     * Avoid an engine that is currently much slower than the other,
+     * e.g. due to a gc or compaction pause. It is still selected now
+     * and then to notice when it has recovered.
+     */
+    // NB: latency race condition
+    bool newLagging = newEngine->_stats._queryLatency.isLaggingBehind(oldEngine->_stats._queryLatency);
+    bool oldLagging = oldEngine->_stats._queryLatency.isLaggingBehind(newEngine->_stats._queryLatency);
+    if ((newLagging || oldLagging) && ((_randState.lrand48() % LAGGING_ENGINE_PROBE_RATE) != 0)) {
+        if (oldLagging) {
+            *oldCount = 1;
+        }
+        return oldLagging;
+    }
+
     return RefCostUseNewEngine(oldEngine, newEngine, oldCount);
 }
 
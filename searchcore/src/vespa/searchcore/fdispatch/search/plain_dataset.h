@@ -117,6 +117,7 @@ protected:
     double       _higherCoverageMinSearchWait;
     double       _higherCoverageBaseSearchWait;
     double       _minimalSearchCoverage;
+    bool         _incrementalMerge;
     double       _higherCoverageMaxDocSumWait;
     double       _higherCoverageMinDocSumWait;
     double       _higherCoverageBaseDocSumWait;
@@ -130,6 +131,9 @@ protected:
     std::vector<FastS_EngineBase *> _enginesArray;
     search::Rand48 _randState;
 
+    // one in this many selections ignores that an engine lags behind
+    static constexpr uint32_t LAGGING_ENGINE_PROBE_RATE = 16;
+
     void InsertEngine(FastS_EngineBase *engine);
     FastS_EngineBase *ExtractEngine();
     bool RefCostUseNewEngine(FastS_EngineBase *oldEngine, FastS_EngineBase *newEngine, unsigned int *oldCount);
@@ -189,6 +193,7 @@ public:
     double getHigherCoverageMaxSearchWait() const { return _higherCoverageMaxSearchWait; }
     double getHigherCoverageMinSearchWait() const { return _higherCoverageMinSearchWait; }
     double getMinimalSearchCoverage() const { return _minimalSearchCoverage; }
+    bool useIncrementalMerge() const { return _incrementalMerge; }
     double getHigherCoverageMaxDocSumWait() const { return _higherCoverageMaxDocSumWait; }
     double getHigherCoverageMinDocSumWait() const { return _higherCoverageMinDocSumWait; }
     double getHigherCoverageBaseDocSumWait() const { return _higherCoverageBaseDocSumWait; }
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchcore/fdispatch/search/rowstate.h>
+#include <cmath>
 
 namespace fdispatch {
 
@@ -9,6 +10,27 @@ void RowState::updateSearchTime(double searchTime)
     _avgSearchTime = (searchTime + (_decayRate-1)*_avgSearchTime)/_decayRate;
 }
 
+void
+LatencyEstimate::update(double latency)
+{
+    if (_numSamples == 0) {
+        _avg = latency;
+        _dev = latency / 2;
+    } else {
+        _dev = (std::abs(latency - _avg) + (_decayRate-1)*_dev)/_decayRate;
+        _avg = (latency + (_decayRate-1)*_avg)/_decayRate;
+    }
+    ++_numSamples;
+}
+
+bool
+LatencyEstimate::isLaggingBehind(const LatencyEstimate &other) const
+{
+    return ((_numSamples >= MIN_SAMPLES) &&
+            (other._numSamples >= MIN_SAMPLES) &&
+            (_avg > other.getTailEstimate()));
+}
+
 StateOfRows::StateOfRows(size_t numRows, double initialValue, double decayRate) :
    _rows(numRows, RowState(initialValue, decayRate)),
    _sumActiveDocs(0), _invalidActiveDocsCounter(0)
@@ -35,6 +35,41 @@ private:
     uint64_t _sumActiveDocs;
 };
 
+/**
+ * LatencyEstimate keeps track of the latency of a single search node as
+ * exponentially decaying average and mean deviation. Together they give a
+ * rough tail latency estimate, used to steer queries away from nodes that
+ * are temporarily much slower than their replicas, e.g. due to gc or
+ * compaction pauses.
+ **/
+class LatencyEstimate {
+public:
+    static constexpr uint32_t MIN_SAMPLES = 16;
+
+    explicit LatencyEstimate(double decayRate) :
+        _avg(0.0),
+        _dev(0.0),
+        _decayRate(decayRate),
+        _numSamples(0)
+    { }
+    void update(double latency);
+    double getAverage() const { return _avg; }
+    double getDeviation() const { return _dev; }
+    /** Roughly the 95th percentile for normally distributed latencies. */
+    double getTailEstimate() const { return _avg + 2 * _dev; }
+    uint32_t getNumSamples() const { return _numSamples; }
+    /**
+     * Returns true if the typical latency of this node is above the tail
+     * latency of the other node. Requires some samples for both.
+     **/
+    bool isLaggingBehind(const LatencyEstimate &other) const;
+private:
+    double   _avg;
+    double   _dev;
+    double   _decayRate;
+    uint32_t _numSamples;
+};
+
 /**
  * StateOfRows keeps track of the state of all rows/groups.
  * Currently used for tracking latency in groups. This latency
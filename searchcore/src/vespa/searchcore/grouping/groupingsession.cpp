@@ -20,7 +20,8 @@ GroupingSession::GroupingSession(const SessionId &sessionId,
     : _sessionId(sessionId),
       _mgrContext(std::make_unique<GroupingContext>(groupingContext)),
       _groupingManager(std::make_unique<GroupingManager>(*_mgrContext)),
-      _timeOfDoom(groupingContext.getTimeOfDoom())
+      _timeOfDoom(groupingContext.getTimeOfDoom()),
+      _retain(false)
 {
     init(groupingContext, attrCtx);
 }
@@ -78,6 +79,15 @@ GroupingSession::createThreadContext(size_t thread_id, const IAttributeContext &
     return ctx;
 }
 
+void
+GroupingSession::retain(fastos::TimeStamp timeOfDoom)
+{
+    _retain = true;
+    if (timeOfDoom > _timeOfDoom) {
+        _timeOfDoom = timeOfDoom;
+    }
+}
+
 void
 GroupingSession::continueExecution(GroupingContext & groupingContext)
 {
@@ -86,11 +96,18 @@ GroupingSession::continueExecution(GroupingContext & groupingContext)
         Grouping &origGrouping(**it);
         if (_groupingMap.find((*it)->getId()) != _groupingMap.end()) {
             Grouping &cachedGrouping(*_groupingMap[(*it)->getId()]);
-            cachedGrouping.prune(origGrouping);
-            origGrouping.mergePartial(cachedGrouping);
-            // No use in keeping it for the next round
-            if (origGrouping.getLastLevel() == cachedGrouping.getLastLevel()) {
-                _groupingMap.erase(origGrouping.getId());
+            if (_retain) {
+                // pruning only the copy keeps all groups for later passes
+                Grouping pruned(cachedGrouping);
+                pruned.prune(origGrouping);
+                origGrouping.mergePartial(pruned);
+            } else {
+                cachedGrouping.prune(origGrouping);
+                origGrouping.mergePartial(cachedGrouping);
+                // No use in keeping it for the next round
+                if (origGrouping.getLastLevel() == cachedGrouping.getLastLevel()) {
+                    _groupingMap.erase(origGrouping.getId());
+                }
             }
         }
         LOG(debug, "Continue execution result: %s", origGrouping.asString().c_str());
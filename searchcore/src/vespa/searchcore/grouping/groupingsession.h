@@ -31,6 +31,7 @@ private:
     std::unique_ptr<GroupingManager> _groupingManager;
     GroupingMap                      _groupingMap;
     fastos::TimeStamp                _timeOfDoom;
+    bool                             _retain;
 
 public:
     typedef std::unique_ptr<GroupingSession> UP;
@@ -100,6 +101,14 @@ public:
      **/
     void continueExecution(GroupingContext & context);
 
+    /**
+     * Keep the cached groups intact across passes, also after the
+     * last level has been returned, so that later continuation
+     * passes can pick any groups at any level. The session is kept
+     * at least until the given time.
+     **/
+    void retain(fastos::TimeStamp timeOfDoom);
+
     /**
      * Checks whether or not the session is finished.
      **/
@@ -3,6 +3,8 @@
 #include "attribute_directory.h"
 #include "attributedisklayout.h"
 #include <vespa/searchlib/util/filekit.h>
+#include <vespa/fastos/file.h>
+#include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <cassert>
@@ -27,6 +29,27 @@ getSnapshotDirComponent(uint64_t syncToken)
 
 namespace proton {
 
+const vespalib::string AttributeDirectory::deltaBaseSerialNumTag("baseSerialNum");
+
+namespace {
+
+SerialNum
+readDeltaBaseSerialNum(const vespalib::string &deltaFileName)
+{
+    FastOS_File file;
+    if (!file.OpenReadOnly((deltaFileName + ".dat").c_str())) {
+        return 0;
+    }
+    vespalib::FileHeader header;
+    header.readFile(file);
+    if (!header.hasTag(AttributeDirectory::deltaBaseSerialNumTag)) {
+        return 0;
+    }
+    return header.getTag(AttributeDirectory::deltaBaseSerialNumTag).asInteger();
+}
+
+}
+
 AttributeDirectory::AttributeDirectory(const std::shared_ptr<AttributeDiskLayout> &diskLayout,
                                        const vespalib::string &name)
     : _diskLayout(diskLayout),
@@ -35,13 +58,15 @@ AttributeDirectory::AttributeDirectory(const std::shared_ptr<AttributeDiskLayout
       _writer(nullptr),
       _mutex(),
       _cv(),
-      _snapInfo(getDirName())
+      _snapInfo(getDirName()),
+      _deltaBaseSerialNum(0)
 {
     _snapInfo.load();
     SerialNum flushedSerialNum = getFlushedSerialNum();
     if (flushedSerialNum != 0) {
         vespalib::string dirName = getSnapshotDir(flushedSerialNum);
         _lastFlushTime = search::FileKit::getModificationTime(dirName);
+        _deltaBaseSerialNum = readDeltaBaseSerialNum(getDeltaFileName(getAttributeFileName(flushedSerialNum)));
     }
 }
 
@@ -75,6 +100,17 @@ AttributeDirectory::getFlushedSerialNum() const
     return bestSnap.valid ? bestSnap.syncToken : 0;
 }
 
+SerialNum
+AttributeDirectory::getFullSnapshotSerialNum() const
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    IndexMetaInfo::Snapshot bestSnap = _snapInfo.getBestSnapshot();
+    if (!bestSnap.valid) {
+        return 0;
+    }
+    return (_deltaBaseSerialNum != 0) ? _deltaBaseSerialNum : bestSnap.syncToken;
+}
+
 fastos::TimeStamp
 AttributeDirectory::getLastFlushTime() const
 {
@@ -129,19 +165,37 @@ AttributeDirectory::markValidSnapshot(SerialNum serialNum)
         assert(!snap.valid);
         assert(snap.syncToken == serialNum);
         _snapInfo.validateSnapshot(serialNum);
+        _deltaBaseSerialNum = 0;
     }
     saveSnapInfo();
 }
 
 void
-AttributeDirectory::invalidateOldSnapshots(uint64_t serialNum)
+AttributeDirectory::markValidDeltaSnapshot(SerialNum serialNum, SerialNum baseSerialNum)
+{
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        auto snap = _snapInfo.getSnapshot(serialNum);
+        assert(!snap.valid);
+        assert(snap.syncToken == serialNum);
+        auto baseSnap = _snapInfo.getSnapshot(baseSerialNum);
+        assert(baseSnap.valid);
+        (void) baseSnap;
+        _snapInfo.validateSnapshot(serialNum);
+        _deltaBaseSerialNum = baseSerialNum;
+    }
+    saveSnapInfo();
+}
+
+void
+AttributeDirectory::invalidateOldSnapshots(SerialNum serialNum, SerialNum keepSerialNum)
 {
     std::vector<SerialNum> toInvalidate;
     {
         std::lock_guard<std::mutex> guard(_mutex);
         auto &list = _snapInfo.snapshots();
         for (const auto &snap : list) {
-            if (snap.valid && snap.syncToken < serialNum) {
+            if (snap.valid && snap.syncToken < serialNum && snap.syncToken != keepSerialNum) {
                 toInvalidate.emplace_back(snap.syncToken);
             }
         }
@@ -154,12 +208,19 @@ AttributeDirectory::invalidateOldSnapshots(uint64_t serialNum)
     }
 }
 
+void
+AttributeDirectory::invalidateOldSnapshots(SerialNum serialNum)
+{
+    invalidateOldSnapshots(serialNum, 0);
+}
+
 void
 AttributeDirectory::invalidateOldSnapshots()
 {
     auto best = _snapInfo.getBestSnapshot();
     if (best.valid) {
-        invalidateOldSnapshots(best.syncToken);
+        // A delta snapshot needs the full snapshot it is based on
+        invalidateOldSnapshots(best.syncToken, _deltaBaseSerialNum);
     }
 }
 
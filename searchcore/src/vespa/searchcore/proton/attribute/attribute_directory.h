@@ -32,12 +32,15 @@ private:
     mutable std::mutex     _mutex;
     std::condition_variable _cv;
     search::IndexMetaInfo  _snapInfo;
+    SerialNum              _deltaBaseSerialNum; // full snapshot below best snapshot, 0 if best is full
 
     void saveSnapInfo();
     vespalib::string getSnapshotDir(SerialNum serialNum);
     void setLastFlushTime(fastos::TimeStamp lastFlushTime);
     void createInvalidSnapshot(SerialNum serialNum);
     void markValidSnapshot(SerialNum serialNum);
+    void markValidDeltaSnapshot(SerialNum serialNum, SerialNum baseSerialNum);
+    void invalidateOldSnapshots(SerialNum serialNum, SerialNum keepSerialNum);
     void invalidateOldSnapshots(SerialNum serialNum);
     void invalidateOldSnapshots();
     void removeInvalidSnapshots();
@@ -66,6 +69,7 @@ public:
         void setLastFlushTime(fastos::TimeStamp lastFlushTime) { _dir.setLastFlushTime(lastFlushTime); }
         void createInvalidSnapshot(SerialNum serialNum) { _dir.createInvalidSnapshot(serialNum); }
         void markValidSnapshot(SerialNum serialNum) { _dir.markValidSnapshot(serialNum); }
+        void markValidDeltaSnapshot(SerialNum serialNum, SerialNum baseSerialNum) { _dir.markValidDeltaSnapshot(serialNum, baseSerialNum); }
         vespalib::string getSnapshotDir(SerialNum serialNum) { return _dir.getSnapshotDir(serialNum); }
 
         // methods called while pruning old snapshots or removing attribute
@@ -79,9 +83,17 @@ public:
     std::unique_ptr<Writer> getWriter();
     std::unique_ptr<Writer> tryGetWriter();
     SerialNum getFlushedSerialNum() const;
+    /*
+     * Returns serial number of the full snapshot that the best snapshot
+     * is based on, i.e. the best snapshot itself unless it only holds
+     * the docs changed since an older full snapshot.
+     */
+    SerialNum getFullSnapshotSerialNum() const;
     fastos::TimeStamp getLastFlushTime() const;
     bool empty() const;
     vespalib::string getAttributeFileName(SerialNum serialNum);
+    static vespalib::string getDeltaFileName(const vespalib::string &attrFileName) { return attrFileName + ".delta"; }
+    static const vespalib::string deltaBaseSerialNumTag;
 };
 
 } // namespace proton
@@ -167,7 +167,8 @@ AttributeVector::SP
 AttributeInitializer::tryLoadAttribute() const
 {
     search::SerialNum serialNum = _attrDir->getFlushedSerialNum();
-    vespalib::string attrFileName = _attrDir->getAttributeFileName(serialNum);
+    search::SerialNum fullSerialNum = _attrDir->getFullSnapshotSerialNum();
+    vespalib::string attrFileName = _attrDir->getAttributeFileName(fullSerialNum);
     AttributeVector::SP attr = _factory.create(attrFileName, _spec.getConfig());
     if (serialNum != 0) {
         AttributeHeader header = extractHeader(attrFileName);
@@ -175,7 +176,7 @@ AttributeInitializer::tryLoadAttribute() const
             setupEmptyAttribute(attr, serialNum, header);
             return attr;
         }
-        if (!loadAttribute(attr, serialNum)) {
+        if (!loadAttribute(attr, fullSerialNum, serialNum)) {
             return AttributeVector::SP();
         }
     } else {
@@ -186,16 +187,25 @@ AttributeInitializer::tryLoadAttribute() const
 
 bool
 AttributeInitializer::loadAttribute(const AttributeVectorSP &attr,
+                                    search::SerialNum fullSerialNum,
                                     search::SerialNum serialNum) const
 {
     assert(attr->hasLoadData());
     fastos::TimeStamp startTime = fastos::ClockSystem::now();
     EventLogger::loadAttributeStart(_documentSubDbName, attr->getName());
-    if (!attr->load()) {
+    // Changes to the loaded attribute vector are tracked relative to the full snapshot
+    attr->commit(fullSerialNum, fullSerialNum);
+    if (!attr->load(_loadExecutor)) {
         LOG(warning, "Could not load attribute vector '%s' from disk. "
                 "Returning empty attribute vector",
                 attr->getBaseFileName().c_str());
         return false;
+    } else if (fullSerialNum != serialNum &&
+               !attr->loadDelta(AttributeDirectory::getDeltaFileName(_attrDir->getAttributeFileName(serialNum)))) {
+        LOG(warning, "Could not load delta snapshot %" PRIu64 " of attribute vector '%s' from disk. "
+                "Returning empty attribute vector",
+                serialNum, attr->getBaseFileName().c_str());
+        return false;
     } else {
         attr->commit(serialNum, serialNum);
         fastos::TimeStamp endTime = fastos::ClockSystem::now();
@@ -238,12 +248,14 @@ AttributeInitializer::AttributeInitializer(const std::shared_ptr<AttributeDirect
                                            const vespalib::string &documentSubDbName,
                                            const AttributeSpec &spec,
                                            uint64_t currentSerialNum,
-                                           const IAttributeFactory &factory)
+                                           const IAttributeFactory &factory,
+                                           vespalib::Executor *loadExecutor)
     : _attrDir(attrDir),
       _documentSubDbName(documentSubDbName),
       _spec(spec),
       _currentSerialNum(currentSerialNum),
-      _factory(factory)
+      _factory(factory),
+      _loadExecutor(loadExecutor)
 {
 }
 
@@ -12,6 +12,8 @@ namespace search {
 namespace attribute { class AttributeHeader; }
 }
 
+namespace vespalib { class Executor; }
+
 namespace proton {
 
 class AttributeDirectory;
@@ -32,10 +34,12 @@ private:
     const AttributeSpec             _spec;
     const uint64_t                  _currentSerialNum;
     const IAttributeFactory        &_factory;
+    vespalib::Executor             *_loadExecutor;
 
     AttributeVectorSP tryLoadAttribute() const;
 
     bool loadAttribute(const AttributeVectorSP &attr,
+                       search::SerialNum fullSerialNum,
                        search::SerialNum serialNum) const;
 
     void setupEmptyAttribute(AttributeVectorSP &attr,
@@ -49,7 +53,8 @@ public:
                          const vespalib::string &documentSubDbName,
                          const AttributeSpec &spec,
                          uint64_t currentSerialNum,
-                         const IAttributeFactory &factory);
+                         const IAttributeFactory &factory,
+                         vespalib::Executor *loadExecutor = nullptr);
     ~AttributeInitializer();
 
     AttributeInitializerResult init() const;
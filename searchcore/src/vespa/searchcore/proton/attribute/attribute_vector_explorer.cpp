@@ -87,6 +87,11 @@ convertMultiValueToSlime(const MultiValueMappingBase &multiValue, Cursor &object
 {
     object.setLong("totalValueCnt", multiValue.getTotalValueCnt());
     convertMemoryUsageToSlime(multiValue.getMemoryUsage(), object.setObject("memoryUsage"));
+    if (multiValue.compactInProgress()) {
+        Cursor &compaction = object.setObject("compaction");
+        compaction.setLong("cursor", multiValue.getCompactCursor());
+        compaction.setLong("numKeys", multiValue.getNumKeys());
+    }
 }
 
 void
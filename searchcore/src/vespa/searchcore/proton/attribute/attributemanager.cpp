@@ -7,6 +7,7 @@
 #include "i_attribute_functor.h"
 #include "imported_attributes_context.h"
 #include "imported_attributes_repo.h"
+#include "parallel_attributes_initializer.h"
 #include "sequential_attributes_initializer.h"
 #include "flushableattribute.h"
 #include <vespa/searchcore/proton/flushengine/shrink_lid_space_flush_target.h>
@@ -206,7 +207,7 @@ AttributeManager::addNewAttributes(const Spec &newSpec,
 
         AttributeInitializer::UP initializer =
             std::make_unique<AttributeInitializer>(_diskLayout->createAttributeDir(aspec.getName()), _documentSubDbName,
-                        aspec, newSpec.getCurrentSerialNum(), *_factory);
+                        aspec, newSpec.getCurrentSerialNum(), *_factory, _sharedExecutor);
         initializerRegistry.add(std::move(initializer));
 
         // TODO: Might want to use hardlinks to make attribute vector
@@ -252,7 +253,8 @@ AttributeManager::AttributeManager(const vespalib::string &baseDir,
       _interlock(std::make_shared<search::attribute::Interlock>()),
       _attributeFieldWriter(attributeFieldWriter),
       _hwInfo(hwInfo),
-      _importedAttributes()
+      _importedAttributes(),
+      _sharedExecutor(nullptr)
 {
 }
 
@@ -264,7 +266,8 @@ AttributeManager::AttributeManager(const vespalib::string &baseDir,
                                    search::ISequencedTaskExecutor &
                                    attributeFieldWriter,
                                    const IAttributeFactory::SP &factory,
-                                   const HwInfo &hwInfo)
+                                   const HwInfo &hwInfo,
+                                   vespalib::Executor *sharedExecutor)
     : proton::IAttributeManager(),
       _attributes(),
       _flushables(),
@@ -277,7 +280,8 @@ AttributeManager::AttributeManager(const vespalib::string &baseDir,
       _interlock(std::make_shared<search::attribute::Interlock>()),
       _attributeFieldWriter(attributeFieldWriter),
       _hwInfo(hwInfo),
-      _importedAttributes()
+      _importedAttributes(),
+      _sharedExecutor(sharedExecutor)
 {
 }
 
@@ -296,7 +300,8 @@ AttributeManager::AttributeManager(const AttributeManager &currMgr,
       _interlock(currMgr._interlock),
       _attributeFieldWriter(currMgr._attributeFieldWriter),
       _hwInfo(currMgr._hwInfo),
-      _importedAttributes()
+      _importedAttributes(),
+      _sharedExecutor(currMgr._sharedExecutor)
 {
     Spec::AttributeList toBeAdded;
     transferExistingAttributes(currMgr, newSpec, toBeAdded);
@@ -471,6 +476,13 @@ AttributeManager::createContext() const
 proton::IAttributeManager::SP
 AttributeManager::create(const Spec &spec) const
 {
+    if (_sharedExecutor != nullptr) {
+        ParallelAttributesInitializer initializer(spec.getDocIdLimit(), *_sharedExecutor);
+        proton::AttributeManager::SP result = std::make_shared<AttributeManager>(*this, spec, initializer);
+        initializer.load();
+        result->addInitializedAttributes(initializer.getInitializedAttributes());
+        return result;
+    }
     SequentialAttributesInitializer initializer(spec.getDocIdLimit());
     proton::AttributeManager::SP result = std::make_shared<AttributeManager>(*this, spec, initializer);
     result->addInitializedAttributes(initializer.getInitializedAttributes());
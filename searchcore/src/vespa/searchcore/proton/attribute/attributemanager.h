@@ -30,6 +30,8 @@ namespace searchcorespi
 class IFlushTarget;
 }
 
+namespace vespalib { class Executor; }
+
 namespace proton
 {
 
@@ -93,6 +95,7 @@ private:
     search::ISequencedTaskExecutor &_attributeFieldWriter;
     HwInfo _hwInfo;
     std::unique_ptr<ImportedAttributesRepo> _importedAttributes;
+    vespalib::Executor *_sharedExecutor;
 
     AttributeVectorSP internalAddAttribute(const AttributeSpec &spec,
                                                      uint64_t serialNum,
@@ -132,7 +135,8 @@ public:
                      fileHeaderContext,
                      search::ISequencedTaskExecutor &attributeFieldWriter,
                      const IAttributeFactory::SP &factory,
-                     const HwInfo &hwInfo);
+                     const HwInfo &hwInfo,
+                     vespalib::Executor *sharedExecutor = nullptr);
 
     AttributeManager(const AttributeManager &currMgr,
                      const Spec &newSpec,
@@ -6,6 +6,7 @@
 #include <vespa/searchlib/attribute/attributesaver.h>
 #include <vespa/searchlib/util/dirtraverse.h>
 #include <vespa/searchlib/util/filekit.h>
+#include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/closuretask.h>
 #include <fstream>
@@ -30,6 +31,37 @@ using searchcorespi::IFlushTarget;
 
 namespace proton {
 
+namespace {
+
+/*
+ * Consolidate into a full snapshot when more than 1/10 of the docs
+ * have changed since the last full snapshot.
+ */
+constexpr uint32_t maxDeltaDocsDivisor = 10;
+
+class DeltaFileHeaderContext : public FileHeaderContext
+{
+    const FileHeaderContext &_parentFileHeaderContext;
+    SerialNum _baseSerialNum;
+
+public:
+    DeltaFileHeaderContext(const FileHeaderContext &parentFileHeaderContext, SerialNum baseSerialNum)
+        : FileHeaderContext(),
+          _parentFileHeaderContext(parentFileHeaderContext),
+          _baseSerialNum(baseSerialNum)
+    {
+    }
+
+    void addTags(vespalib::GenericHeader &header, const vespalib::string &name) const override {
+        _parentFileHeaderContext.addTags(header, name);
+        if (_baseSerialNum != 0u) {
+            header.putTag(vespalib::GenericHeader::Tag(AttributeDirectory::deltaBaseSerialNumTag, _baseSerialNum));
+        }
+    }
+};
+
+}
+
 /**
  * Task performing the actual flushing to disk.
  **/
@@ -39,6 +71,7 @@ private:
     search::AttributeMemorySaveTarget      _saveTarget;
     std::unique_ptr<search::AttributeSaver> _saver;
     uint64_t                          _syncToken;
+    uint64_t                          _deltaBaseSerialNum; // 0 unless saving a delta snapshot
     search::AttributeVector::BaseName _flushFile;
 
     bool saveAttribute(); // not updating snap info.
@@ -65,6 +98,7 @@ FlushableAttribute::Flusher::Flusher(FlushableAttribute & fattr, SerialNum syncT
       _saveTarget(),
       _saver(),
       _syncToken(syncToken),
+      _deltaBaseSerialNum(0),
       _flushFile("")
 {
     fattr._attr->commit(syncToken, syncToken);
@@ -72,7 +106,16 @@ FlushableAttribute::Flusher::Flusher(FlushableAttribute & fattr, SerialNum syncT
     // Called by attribute field writer executor
     _flushFile = writer.getSnapshotDir(_syncToken) + "/" + attr.getName();
     attr.setBaseFileName(_flushFile);
-    _saver = attr.initSave();
+    SerialNum fullSerialNum = _fattr._attrDir->getFullSnapshotSerialNum();
+    if (fullSerialNum != 0) {
+        _saver = attr.initDeltaSave(fullSerialNum, attr.getCommittedDocIdLimit() / maxDeltaDocsDivisor);
+        if (_saver) {
+            _deltaBaseSerialNum = fullSerialNum;
+        }
+    }
+    if (!_saver) {
+        _saver = attr.initSave();
+    }
     if (!_saver) {
         // New style background save not available, use old style save.
         attr.save(_saveTarget);
@@ -88,8 +131,9 @@ bool
 FlushableAttribute::Flusher::saveAttribute()
 {
     vespalib::mkdir(_flushFile.getDirName(), false);
-    SerialNumFileHeaderContext fileHeaderContext(_fattr._fileHeaderContext,
-                                                 _syncToken);
+    SerialNumFileHeaderContext serialNumFileHeaderContext(_fattr._fileHeaderContext,
+                                                          _syncToken);
+    DeltaFileHeaderContext fileHeaderContext(serialNumFileHeaderContext, _deltaBaseSerialNum);
     bool saveSuccess = true;
     if (_saver && _saver->hasGenerationGuard() &&
         _fattr._hwInfo.disk().slow()) {
@@ -119,7 +163,11 @@ FlushableAttribute::Flusher::flush(AttributeDirectory::Writer &writer)
             _flushFile.c_str());
         return false;
     }
-    writer.markValidSnapshot(_syncToken);
+    if (_deltaBaseSerialNum != 0) {
+        writer.markValidDeltaSnapshot(_syncToken, _deltaBaseSerialNum);
+    } else {
+        writer.markValidSnapshot(_syncToken);
+    }
     writer.setLastFlushTime(search::FileKit::getModificationTime(_flushFile.getDirName()));
     return true;
 }
@@ -0,0 +1,49 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "parallel_attributes_initializer.h"
+#include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/common/parallel_sort.h>
+
+using search::AttributeVector;
+
+namespace proton {
+
+ParallelAttributesInitializer::ParallelAttributesInitializer(uint32_t docIdLimit, vespalib::Executor &executor)
+    : AttributesInitializerBase(),
+      _docIdLimit(docIdLimit),
+      _executor(executor),
+      _initializers()
+{
+}
+
+ParallelAttributesInitializer::~ParallelAttributesInitializer() {}
+
+void
+ParallelAttributesInitializer::add(AttributeInitializer::UP initializer)
+{
+    _initializers.push_back(std::move(initializer));
+}
+
+void
+ParallelAttributesInitializer::load()
+{
+    AttributesVector results(_initializers.size(), AttributeInitializerResult(AttributeVector::SP()));
+    search::runParallelParts(_executor, _initializers.size(),
+                             [this, &results](size_t i)
+                             {
+                                 const AttributeInitializer &initializer = *_initializers[i];
+                                 results[i] = initializer.init();
+                                 if (results[i]) {
+                                     considerPadAttribute(*results[i].getAttribute(),
+                                                          initializer.getCurrentSerialNum(), _docIdLimit);
+                                 }
+                             });
+    for (const auto &result : results) {
+        if (result) {
+            _initializedAttributes.push_back(result);
+        }
+    }
+    _initializers.clear();
+}
+
+} // namespace proton
@@ -0,0 +1,36 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "attributes_initializer_base.h"
+
+namespace vespalib { class Executor; }
+
+namespace proton {
+
+/**
+ * Class that initializes and loads a set of attribute vectors
+ * concurrently using a shared executor. The calling thread takes part
+ * in the loading.
+ */
+class ParallelAttributesInitializer : public AttributesInitializerBase
+{
+private:
+    uint32_t _docIdLimit;
+    vespalib::Executor &_executor;
+    std::vector<AttributeInitializer::UP> _initializers;
+
+public:
+    ParallelAttributesInitializer(uint32_t docIdLimit, vespalib::Executor &executor);
+    ~ParallelAttributesInitializer();
+    AttributesVector getInitializedAttributes() const { return _initializedAttributes; }
+    virtual void add(AttributeInitializer::UP initializer) override;
+
+    /**
+     * Load all added attribute vectors. The initialized attributes are
+     * kept in the order they were added.
+     */
+    void load();
+};
+
+} // namespace proton
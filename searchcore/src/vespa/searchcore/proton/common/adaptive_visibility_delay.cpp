@@ -0,0 +1,83 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "adaptive_visibility_delay.h"
+#include <algorithm>
+
+namespace proton {
+
+namespace {
+
+// Weight of the newest sample in the moving averages
+constexpr double SAMPLE_WEIGHT = 0.25;
+
+double
+smooth(double average, double sample)
+{
+    return average + SAMPLE_WEIGHT * (sample - average);
+}
+
+}
+
+AdaptiveVisibilityDelay::AdaptiveVisibilityDelay()
+    : _minDelay(0),
+      _maxDelay(0),
+      _delay(0),
+      _lastCommitTime(0),
+      _lastCommitSerialNum(0),
+      _feedRate(0.0),
+      _commitCost(0.0)
+{
+}
+
+void
+AdaptiveVisibilityDelay::setDelays(TimeStamp minDelay, TimeStamp maxDelay)
+{
+    _minDelay = minDelay;
+    _maxDelay = maxDelay;
+    calcDelay();
+}
+
+bool
+AdaptiveVisibilityDelay::isCommitDue(TimeStamp now) const
+{
+    if (!isAdaptive()) {
+        return true;
+    }
+    // Checks happen every min delay, allow for some jitter in when they run
+    return ((now - _lastCommitTime) + TimeStamp(_minDelay.val() / 2)) >= _delay;
+}
+
+void
+AdaptiveVisibilityDelay::commitDone(TimeStamp now, SerialNum serialNum, TimeStamp commitCost)
+{
+    if ((_lastCommitTime > 0) && (now > _lastCommitTime) && (serialNum >= _lastCommitSerialNum)) {
+        double elapsed = (now - _lastCommitTime).sec();
+        _feedRate = smooth(_feedRate, (serialNum - _lastCommitSerialNum) / elapsed);
+    }
+    if (serialNum > _lastCommitSerialNum) {
+        // commits without changes are cheap and say little about the real cost
+        _commitCost = smooth(_commitCost, commitCost.sec());
+    }
+    _lastCommitTime = now;
+    _lastCommitSerialNum = serialNum;
+    calcDelay();
+}
+
+void
+AdaptiveVisibilityDelay::calcDelay()
+{
+    if (!isAdaptive()) {
+        _delay = _maxDelay;
+        return;
+    }
+    double minDelay = _minDelay.sec();
+    double commitsPerSec = std::min(_feedRate, 1.0 / minDelay);
+    if (commitsPerSec * _commitCost <= COMMIT_COST_BUDGET) {
+        _delay = _minDelay;
+    } else {
+        double wanted = std::min(_commitCost / COMMIT_COST_BUDGET, _maxDelay.sec());
+        _delay = TimeStamp(TimeStamp::Seconds(std::max(wanted, minDelay)));
+    }
+}
+
+} // namespace proton
@@ -0,0 +1,57 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/fastos/timestamp.h>
+#include <vespa/searchlib/common/serialnum.h>
+
+namespace proton {
+
+/**
+ * Policy for how long to wait between regular commits when a
+ * visibility delay is used.
+ *
+ * The feed rate and the cost of a commit are tracked as moving
+ * averages, sampled at each commit. As long as committing as often as
+ * the min delay (or as often as operations arrive, if that is less
+ * often) costs less than a small fraction of the time, the min delay
+ * is used. Otherwise the delay grows until the commit cost is within
+ * that fraction again, bounded by the max delay (the configured
+ * visibility delay). A min delay of 0 disables the policy, giving a
+ * fixed delay.
+ */
+class AdaptiveVisibilityDelay
+{
+public:
+    using TimeStamp = fastos::TimeStamp;
+    using SerialNum = search::SerialNum;
+    /** Max fraction of the time that should be spent committing. */
+    static constexpr double COMMIT_COST_BUDGET = 0.05;
+
+private:
+    TimeStamp _minDelay;
+    TimeStamp _maxDelay;
+    TimeStamp _delay;
+    TimeStamp _lastCommitTime;
+    SerialNum _lastCommitSerialNum;
+    double    _feedRate;   // operations per second
+    double    _commitCost; // seconds per commit
+
+    void calcDelay();
+public:
+    AdaptiveVisibilityDelay();
+
+    void setDelays(TimeStamp minDelay, TimeStamp maxDelay);
+    bool isAdaptive() const { return (_minDelay > 0) && (_minDelay < _maxDelay); }
+    /** The interval at which to check whether a regular commit is due. */
+    TimeStamp getCheckInterval() const { return isAdaptive() ? _minDelay : _maxDelay; }
+    bool isCommitDue(TimeStamp now) const;
+    void commitDone(TimeStamp now, SerialNum serialNum, TimeStamp commitCost);
+
+    TimeStamp getMinDelay() const { return _minDelay; }
+    TimeStamp getMaxDelay() const { return _maxDelay; }
+    TimeStamp getDelay() const { return _delay; }
+    double getFeedRate() const { return _feedRate; }
+    double getCommitCost() const { return _commitCost; }
+};
+
+} // namespace proton
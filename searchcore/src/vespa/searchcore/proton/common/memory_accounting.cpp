@@ -0,0 +1,136 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "memory_accounting.h"
+#include <vespa/vespalib/data/slime/cursor.h>
+#include <algorithm>
+#include <cassert>
+
+using vespalib::slime::Cursor;
+
+namespace proton {
+
+MemoryAccountingNode::MemoryAccountingNode(const vespalib::string &name)
+    : _name(name),
+      _usage(),
+      _children(),
+      _hasPrevious(false),
+      _previousAllocated(0)
+{
+}
+
+MemoryAccountingNode::~MemoryAccountingNode() = default;
+
+MemoryAccountingNode &
+MemoryAccountingNode::child(const vespalib::string &name)
+{
+    for (const auto &child : _children) {
+        if (child->getName() == name) {
+            return *child;
+        }
+    }
+    _children.push_back(std::make_unique<MemoryAccountingNode>(name));
+    return *_children.back();
+}
+
+search::MemoryUsage
+MemoryAccountingNode::getTotal() const
+{
+    search::MemoryUsage total = _usage;
+    for (const auto &child : _children) {
+        total.merge(child->getTotal());
+    }
+    return total;
+}
+
+void
+MemoryAccountingNode::updateHistory(const vespalib::string &path, History &history)
+{
+    auto itr = history.find(path);
+    _hasPrevious = (itr != history.end());
+    _previousAllocated = _hasPrevious ? itr->second : 0;
+    history[path] = getTotal().allocatedBytes();
+    for (const auto &child : _children) {
+        child->updateHistory(path + "/" + child->getName(), history);
+    }
+}
+
+void
+MemoryAccountingNode::convertToSlime(Cursor &object) const
+{
+    search::MemoryUsage total = getTotal();
+    object.setLong("allocated", total.allocatedBytes());
+    object.setLong("used", total.usedBytes());
+    object.setLong("dead", total.deadBytes());
+    object.setLong("onHold", total.allocatedBytesOnHold());
+    if (_hasPrevious) {
+        object.setLong("allocatedDelta", int64_t(total.allocatedBytes()) - int64_t(_previousAllocated));
+    }
+    for (const auto &child : _children) {
+        child->convertToSlime(object.setObject(child->getName()));
+    }
+}
+
+MemoryAccountingRegistry::Registration::Registration(MemoryAccountingRegistry &registry,
+                                                     const vespalib::string &name,
+                                                     const IMemoryAccountingReporter &reporter)
+    : _registry(registry),
+      _name(name),
+      _reporter(reporter)
+{
+}
+
+MemoryAccountingRegistry::Registration::~Registration()
+{
+    _registry.remove(*this);
+}
+
+MemoryAccountingRegistry::MemoryAccountingRegistry()
+    : _lock(),
+      _registrations(),
+      _history(),
+      _lastCollect(),
+      _collected(false)
+{
+}
+
+MemoryAccountingRegistry::~MemoryAccountingRegistry()
+{
+    assert(_registrations.empty());
+}
+
+void
+MemoryAccountingRegistry::remove(const Registration &registration)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = std::find(_registrations.begin(), _registrations.end(), &registration);
+    assert(itr != _registrations.end());
+    _registrations.erase(itr);
+}
+
+MemoryAccountingRegistry::Registration::UP
+MemoryAccountingRegistry::add(const vespalib::string &name, const IMemoryAccountingReporter &reporter)
+{
+    auto registration = std::make_unique<Registration>(*this, name, reporter);
+    std::lock_guard<std::mutex> guard(_lock);
+    _registrations.push_back(registration.get());
+    return registration;
+}
+
+MemoryAccountingNode::UP
+MemoryAccountingRegistry::collect(double &secondsSincePrevious)
+{
+    auto root = std::make_unique<MemoryAccountingNode>("");
+    std::lock_guard<std::mutex> guard(_lock);
+    // reporters cannot be unregistered while they are being asked
+    for (const Registration *registration : _registrations) {
+        registration->_reporter.reportMemoryUsage(root->child(registration->_name));
+    }
+    clock::time_point now = clock::now();
+    secondsSincePrevious = _collected ? std::chrono::duration<double>(now - _lastCollect).count() : 0.0;
+    _lastCollect = now;
+    _collected = true;
+    root->updateHistory("", _history);
+    return root;
+}
+
+} // namespace proton
@@ -0,0 +1,127 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/util/memoryusage.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vespalib::slime { struct Cursor; }
+
+namespace proton {
+
+/**
+ * Node in a tree of memory usage, e.g. document db -> sub db ->
+ * attribute. A node has its own memory usage in addition to the
+ * usage of its children.
+ */
+class MemoryAccountingNode
+{
+private:
+    vespalib::string                                   _name;
+    search::MemoryUsage                                _usage;
+    std::vector<std::unique_ptr<MemoryAccountingNode>> _children;
+    bool                                               _hasPrevious;
+    size_t                                             _previousAllocated;
+
+public:
+    using UP = std::unique_ptr<MemoryAccountingNode>;
+    using History = std::map<vespalib::string, size_t>;
+
+    explicit MemoryAccountingNode(const vespalib::string &name);
+    ~MemoryAccountingNode();
+
+    const vespalib::string &getName() const { return _name; }
+    const search::MemoryUsage &getOwnUsage() const { return _usage; }
+    const std::vector<UP> &getChildren() const { return _children; }
+
+    /**
+     * Get the child with the given name, adding it if needed.
+     */
+    MemoryAccountingNode &child(const vespalib::string &name);
+    void add(const search::MemoryUsage &usage) { _usage.merge(usage); }
+
+    /**
+     * Own usage plus the usage of all children.
+     */
+    search::MemoryUsage getTotal() const;
+
+    /**
+     * Remember the total allocated bytes of this subtree by path in
+     * the given history, after picking up the previous values as
+     * basis for the deltas.
+     */
+    void updateHistory(const vespalib::string &path, History &history);
+
+    void convertToSlime(vespalib::slime::Cursor &object) const;
+};
+
+/**
+ * Reports the memory usage of a component into an accounting node.
+ */
+struct IMemoryAccountingReporter
+{
+    virtual ~IMemoryAccountingReporter() = default;
+    virtual void reportMemoryUsage(MemoryAccountingNode &node) const = 0;
+};
+
+/**
+ * Registry of components that account for their memory usage. The
+ * usage tree is built on demand by asking all registered reporters,
+ * and deltas are relative to the previous time the tree was built.
+ */
+class MemoryAccountingRegistry
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * Keeps a reporter registered until destructed.
+     */
+    class Registration
+    {
+    private:
+        friend class MemoryAccountingRegistry;
+        MemoryAccountingRegistry        &_registry;
+        vespalib::string                 _name;
+        const IMemoryAccountingReporter &_reporter;
+    public:
+        using UP = std::unique_ptr<Registration>;
+        Registration(MemoryAccountingRegistry &registry, const vespalib::string &name,
+                     const IMemoryAccountingReporter &reporter);
+        ~Registration();
+    };
+
+private:
+    mutable std::mutex                 _lock;
+    std::vector<const Registration *>  _registrations;
+    MemoryAccountingNode::History      _history;
+    clock::time_point                  _lastCollect;
+    bool                               _collected;
+
+    void remove(const Registration &registration);
+
+public:
+    MemoryAccountingRegistry();
+    ~MemoryAccountingRegistry();
+
+    /**
+     * Register a reporter whose usage is put in a top level node
+     * with the given name. Reporters with the same name share node.
+     */
+    Registration::UP add(const vespalib::string &name, const IMemoryAccountingReporter &reporter);
+
+    /**
+     * Build the usage tree.
+     *
+     * @param secondsSincePrevious set to the time since the previous
+     *        tree was built, or 0 if this is the first.
+     */
+    MemoryAccountingNode::UP collect(double &secondsSincePrevious);
+};
+
+} // namespace proton
@@ -61,6 +61,32 @@ DocsumContext::initState()
     }
 }
 
+namespace {
+
+// Documents are prefetched in batches, so that no more are read after the request has expired.
+constexpr uint32_t PREFETCH_BATCH_SIZE = 64;
+
+}
+
+uint32_t
+DocsumContext::prefetch(const IDocsumWriter::ResolveClassInfo & rci, uint32_t begin)
+{
+    uint32_t end = std::min(begin + PREFETCH_BATCH_SIZE, _docsumState._docsumcnt);
+    if (rci.mustSkip || rci.allGenerated || ((end - begin) < 2) || _request.expired()) {
+        return end;
+    }
+    std::vector<uint32_t> docIds;
+    docIds.reserve(end - begin);
+    for (uint32_t i = begin; i < end; ++i) {
+        uint32_t docId = _docsumState._docsumbuf[i];
+        if (docId != search::endDocId) {
+            docIds.push_back(docId);
+        }
+    }
+    _docsumStore.prefetch(docIds);
+    return end;
+}
+
 DocsumReply::UP
 DocsumContext::createReply()
 {
@@ -70,7 +96,11 @@ DocsumContext::createReply()
     reply->docsums.resize(_docsumState._docsumcnt);
     SymbolTable::UP symbols = std::make_unique<SymbolTable>();
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(), _docsumStore.getSummaryClassId());
+    uint32_t prefetched = 0;
     for (uint32_t i = 0; i < _docsumState._docsumcnt; ++i) {
+        if (i == prefetched) {
+            prefetched = prefetch(rci, i);
+        }
         buf.reset();
         uint32_t docId = _docsumState._docsumbuf[i];
         reply->docsums[i].docid = docId;
@@ -114,8 +144,12 @@ DocsumContext::createSlimeReply()
     const Symbol docsumSym = response->insert(DOCSUM);
     IDocsumWriter::ResolveClassInfo rci = _docsumWriter.resolveClassInfo(_docsumState._args.getResultClassName(),
                                                                          _docsumStore.getSummaryClassId());
+    uint32_t prefetched = 0;
     uint32_t i(0);
     for (i = 0; (i < _docsumState._docsumcnt) && !_request.expired(); ++i) {
+        if (i == prefetched) {
+            prefetched = prefetch(rci, i);
+        }
         uint32_t docId = _docsumState._docsumbuf[i];
         Cursor & docSumC = array.addObject();
         ObjectSymbolInserter inserter(docSumC, docsumSym);
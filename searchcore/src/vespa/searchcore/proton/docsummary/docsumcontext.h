@@ -27,6 +27,7 @@ private:
     matching::SessionManager             & _sessionMgr;
 
     void initState();
+    uint32_t prefetch(const search::docsummary::IDocsumWriter::ResolveClassInfo & rci, uint32_t begin);
     search::engine::DocsumReply::UP createReply();
     std::unique_ptr<vespalib::Slime> createSlimeReply();
 
@@ -2,11 +2,18 @@
 
 #include "documentstoreadapter.h"
 #include <vespa/searchsummary/docsummary/summaryfieldconverter.h>
+#include <vespa/document/fieldvalue/doublefieldvalue.h>
+#include <vespa/document/fieldvalue/floatfieldvalue.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/longfieldvalue.h>
+#include <vespa/document/fieldvalue/rawfieldvalue.h>
+#include <vespa/document/fieldvalue/shortfieldvalue.h>
 #include <vespa/document/fieldvalue/stringfieldvalue.h>
 #include <vespa/eval/tensor/tensor.h>
 #include <vespa/eval/tensor/serialization/typed_binary_format.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/document/fieldvalue/tensorfieldvalue.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.docsummary.documentstoreadapter");
@@ -21,6 +28,35 @@ namespace {
 
 const vespalib::string DOCUMENT_ID_FIELD("documentid");
 
+/**
+ * Returns true if the field value can be written to the docsum blob as
+ * it is, i.e. SummaryFieldConverter would only make a copy of it.
+ */
+bool
+isDirectlyWritable(const FieldValue &value, bool markup)
+{
+    const unsigned int id = value.getClass().id();
+    if (id == StringFieldValue::classId) {
+        return !markup;
+    }
+    return (id == IntFieldValue::classId) ||
+           (id == LongFieldValue::classId) ||
+           (id == ShortFieldValue::classId) ||
+           (id == DoubleFieldValue::classId) ||
+           (id == FloatFieldValue::classId) ||
+           (id == RawFieldValue::classId);
+}
+
+class PrefetchVisitor : public search::IDocumentVisitor
+{
+public:
+    PrefetchVisitor(vespalib::hash_map<uint32_t, Document::UP> & documents) : _documents(documents) { }
+    void visit(uint32_t lid, Document::UP doc) override { _documents[lid] = std::move(doc); }
+    bool allowVisitCaching() const override { return false; }
+private:
+    vespalib::hash_map<uint32_t, Document::UP> & _documents;
+};
+
 }
 
 bool
@@ -141,6 +177,14 @@ DocumentStoreAdapter::convertFromSearchDoc(Document &doc, uint32_t docId)
             "writeField(%s): value(%s), type(%d)",
             fieldName.c_str(), fieldValue->toString().c_str(),
             entry->_type);
+        if (isDirectlyWritable(*fieldValue, markup)) {
+            if (!writeField(*fieldValue, entry->_type)) {
+                LOG(warning,
+                    "Error while writing field '%s' for docId %u",
+                    fieldName.c_str(), docId);
+            }
+            continue;
+        }
         FieldValue::UP convertedFieldValue =
             SummaryFieldConverter::convertSummaryField(markup, *fieldValue);
         if (convertedFieldValue.get() != NULL) {
@@ -176,7 +220,8 @@ DocumentStoreAdapter(const search::IDocumentStore & docStore,
                                              c_str()))),
       _resultPacker(&_resultConfig),
       _fieldCache(fieldCache),
-      _markupFields(markupFields)
+      _markupFields(markupFields),
+      _prefetched()
 {
 }
 
@@ -191,7 +236,14 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
             _resultClass->GetClassName(), getSummaryClassId());
         return DocsumStoreValue();
     }
-    Document::UP document = _docStore.read(docId, _repo);
+    Document::UP document;
+    auto found = _prefetched.find(docId);
+    if (found != _prefetched.end()) {
+        document = std::move(found->second);
+        _prefetched.erase(found);
+    } else {
+        document = _docStore.read(docId, _repo);
+    }
     if (document.get() == NULL) {
         LOG(debug,
             "Did not find summary document for docId %u. "
@@ -216,4 +268,11 @@ DocumentStoreAdapter::getMappedDocsum(uint32_t docId)
     return DocsumStoreValue(buf, buflen);
 }
 
+void
+DocumentStoreAdapter::prefetch(const std::vector<uint32_t> & docIds)
+{
+    PrefetchVisitor visitor(_prefetched);
+    _docStore.visit(docIds, _repo, visitor);
+}
+
 } // namespace proton
@@ -36,6 +36,7 @@ public:
         virtual search::docsummary::IDocsumWriter &getDocsumWriter() const = 0;
         virtual search::docsummary::ResultConfig &getResultConfig() = 0;
         virtual search::docsummary::IDocsumStore::UP createDocsumStore(const vespalib::string &resultClassName) = 0;
+        virtual const search::IDocumentStore &getDocumentStore() const = 0;
 
         // Inherit doc from IDocsumEnvironment
         virtual search::IAttributeManager *getAttributeManager() override = 0;
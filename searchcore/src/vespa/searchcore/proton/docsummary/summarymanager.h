@@ -47,6 +47,7 @@ public:
         search::docsummary::ResultConfig & getResultConfig() override { return *_docsumWriter->GetResultConfig(); }
 
         search::docsummary::IDocsumStore::UP createDocsumStore(const vespalib::string &resultClassName) override;
+        const search::IDocumentStore &getDocumentStore() const override { return *_docStore; }
 
         search::IAttributeManager * getAttributeManager() override { return _attributeMgr.get(); }
         vespalib::string lookupIndex(const vespalib::string & s) const override { (void) s; return ""; }
@@ -16,7 +16,7 @@
 #include <vespa/searchcore/proton/bucketdb/joinbucketssession.h>
 #include <vespa/searchcore/proton/bucketdb/splitbucketsession.h>
 #include <vespa/searchlib/util/bufferwriter.h>
-#include <vespa/searchlib/common/rcuvector.hpp>
+#include <vespa/searchlib/common/segmented_rcuvector.hpp>
 #include <vespa/searchlib/query/queryterm.h>
 #include <vespa/fastos/file.h>
 #include "document_meta_store_versions.h"
@@ -592,7 +592,7 @@ DocumentMetaStore::updateMetaData(DocId lid,
 }
 
 bool
-DocumentMetaStore::remove(DocId lid, BucketDBOwner::Guard &bucketGuard)
+DocumentMetaStore::removeFromTree(DocId lid)
 {
     if (!validLid(lid)) {
         return false;
@@ -607,6 +607,15 @@ DocumentMetaStore::remove(DocId lid, BucketDBOwner::Guard &bucketGuard)
                         lid, gid.toString().c_str()));
     }
     _lidAlloc.unregisterLid(lid);
+    return true;
+}
+
+bool
+DocumentMetaStore::remove(DocId lid, BucketDBOwner::Guard &bucketGuard)
+{
+    if (!removeFromTree(lid)) {
+        return false;
+    }
     RawDocumentMetaData &oldMetaData = _metaDataStore[lid];
     bucketGuard->remove(oldMetaData.getGid(),
                         oldMetaData.getBucketId().stripUnused(),
@@ -658,14 +667,29 @@ DocumentMetaStore::move(DocId fromLid, DocId toLid)
 void
 DocumentMetaStore::removeBatch(const std::vector<DocId> &lidsToRemove, const uint32_t docIdLimit)
 {
-    BucketDBOwner::Guard bucketGuard = _bucketDB->takeGuard();
+    // Bucket db changes are summed per bucket and applied afterwards, so
+    // the bucket db guard is not held while updating the gid tree.
+    std::vector<std::pair<BucketId, BucketState>> deltas;
     for (const auto &lid : lidsToRemove) {
         assert(lid > 0 && lid < docIdLimit);
         (void) docIdLimit;
 
-        bool removed = remove(lid, bucketGuard);
+        bool removed = removeFromTree(lid);
         assert(removed);
         (void) removed;
+        const RawDocumentMetaData &metaData = _metaDataStore[lid];
+        BucketId bucketId = metaData.getBucketId().stripUnused();
+        if (deltas.empty() || deltas.back().first != bucketId) {
+            deltas.emplace_back(bucketId, BucketState());
+        }
+        deltas.back().second.add(metaData.getGid(), metaData.getTimestamp(), metaData.getDocSize(),
+                                 _subDbType);
+    }
+    if (!deltas.empty()) {
+        BucketDBOwner::Guard bucketGuard = _bucketDB->takeGuard();
+        for (const auto &delta : deltas) {
+            bucketGuard->unloadBucket(delta.first, delta.second);
+        }
     }
     incGeneration();
 }
@@ -778,6 +802,13 @@ DocumentMetaStore::getLidUsageStats() const
                          highestUsedLid);
 }
 
+MemoryUsage
+DocumentMetaStore::getMemoryUsage() const
+{
+    const search::attribute::Status &status = getStatus();
+    return MemoryUsage(status.getAllocated(), status.getUsed(), status.getDead(), status.getOnHold());
+}
+
 Blueprint::UP
 DocumentMetaStore::createWhiteListBlueprint() const
 {
@@ -868,38 +899,16 @@ DocumentMetaStore::handleSplit(const bucketdb::SplitBucketSession &session)
         }
     }
 
-    TreeType::Iterator itr = lowerBound(source);
-    TreeType::Iterator end = upperBound(source);
+    // Documents of each target bucket are found in its own gid range
+    // within the source bucket, so only those ranges are visited.
+    // Documents relabeled to target1 are no longer labeled with the
+    // source bucket, so they are not picked up again for target2.
     bucketdb::BucketDeltaPair deltas;
-    for (; itr != end; ++itr) {
-        DocId lid = itr.getKey();
-        assert(validLid(lid));
-        RawDocumentMetaData &metaData = _metaDataStore[lid];
-        uint8_t bucketUsedBits = metaData.getBucketUsedBits();
-        assert(BucketId::validUsedBits(bucketUsedBits));
-        if (bucketUsedBits == source.getUsedBits()) {
-            BucketId t1(metaData.getGid().convertToBucketId());
-            BucketId t2(t1);
-            if (target1.valid()) {
-                t1.setUsedBits(target1.getUsedBits());
-            }
-            if (target2.valid()) {
-                t2.setUsedBits(target2.getUsedBits());
-            }
-            if (target1.valid() && t1 == target1) {
-                metaData.setBucketUsedBits(target1.getUsedBits());
-                deltas._delta1.add(metaData.getGid(),
-                                   metaData.getTimestamp(),
-                                   metaData.getDocSize(),
-                                   _subDbType);
-            } else if (target2.valid() && t2 == target2) {
-                metaData.setBucketUsedBits(target2.getUsedBits());
-                deltas._delta2.add(metaData.getGid(),
-                                   metaData.getTimestamp(),
-                                   metaData.getDocSize(),
-                                   _subDbType);
-            }
-        }
+    if (target1.valid() && source.contains(target1)) {
+        relabelBucket(target1, source.getUsedBits(), target1.getUsedBits(), deltas._delta1);
+    }
+    if (target2.valid() && source.contains(target2) && !(target1.valid() && target1.contains(target2))) {
+        relabelBucket(target2, source.getUsedBits(), target2.getUsedBits(), deltas._delta2);
     }
     return deltas;
     // Caller can remove source bucket if empty
@@ -913,22 +922,21 @@ DocumentMetaStore::handleJoin(const bucketdb::JoinBucketsSession &session)
     const BucketId &source2(session.getSource2());
     const BucketId &target(session.getTarget());
 
-    TreeType::Iterator itr = lowerBound(target);
-    TreeType::Iterator end = upperBound(target);
+    // Documents of each source bucket are found in its own gid range
+    // within the target bucket, so only those ranges are visited. A
+    // source equal to the target is handled first, as documents from
+    // the other source get the same bucket when relabeled.
     bucketdb::BucketDeltaPair deltas;
-    for (; itr != end; ++itr) {
-        DocId lid = itr.getKey();
-        assert(validLid(lid));
-        RawDocumentMetaData &metaData = _metaDataStore[lid];
-        assert(BucketId::validUsedBits(metaData.getBucketUsedBits()));
-        BucketId s(metaData.getBucketId());
-        if (source1.valid() && s == source1) {
-            metaData.setBucketUsedBits(target.getUsedBits());
-            deltas._delta1.add(metaData.getGid(), metaData.getTimestamp(), metaData.getDocSize(), _subDbType);
-        } else if (source2.valid() && s == source2) {
-            metaData.setBucketUsedBits(target.getUsedBits());
-            deltas._delta2.add(metaData.getGid(), metaData.getTimestamp(), metaData.getDocSize(), _subDbType);
-        }
+    bool joinSource1 = source1.valid() && target.contains(source1);
+    bool joinSource2 = source2.valid() && target.contains(source2) && source2 != source1;
+    if (joinSource2 && source2 == target) {
+        relabelBucket(source2, source2.getUsedBits(), target.getUsedBits(), deltas._delta2);
+    }
+    if (joinSource1) {
+        relabelBucket(source1, source1.getUsedBits(), target.getUsedBits(), deltas._delta1);
+    }
+    if (joinSource2 && source2 != target) {
+        relabelBucket(source2, source2.getUsedBits(), target.getUsedBits(), deltas._delta2);
     }
     if (_subDbType == SubDbType::READY) {
         bool movedSource1Docs = deltas._delta1.getReadyCount() != 0;
@@ -943,6 +951,24 @@ DocumentMetaStore::handleJoin(const bucketdb::JoinBucketsSession &session)
 }
 
 
+void
+DocumentMetaStore::relabelBucket(const BucketId &bucketId, uint8_t fromUsedBits, uint8_t toUsedBits,
+                                 bucketdb::BucketState &delta)
+{
+    TreeType::Iterator itr = lowerBound(bucketId);
+    TreeType::Iterator end = upperBound(bucketId);
+    for (; itr != end; ++itr) {
+        DocId lid = itr.getKey();
+        assert(validLid(lid));
+        RawDocumentMetaData &metaData = _metaDataStore[lid];
+        assert(BucketId::validUsedBits(metaData.getBucketUsedBits()));
+        if (metaData.getBucketUsedBits() == fromUsedBits) {
+            metaData.setBucketUsedBits(toUsedBits);
+            delta.add(metaData.getGid(), metaData.getTimestamp(), metaData.getDocSize(), _subDbType);
+        }
+    }
+}
+
 void
 DocumentMetaStore::setBucketState(const BucketId &bucketId, bool active)
 {
@@ -12,7 +12,7 @@
 #include "raw_document_meta_data.h"
 #include <vespa/searchcore/proton/bucketdb/bucket_db_owner.h>
 #include <vespa/searchcore/proton/common/subdbtype.h>
-#include <vespa/searchlib/common/rcuvector.h>
+#include <vespa/searchlib/common/segmented_rcuvector.h>
 #include <vespa/searchlib/attribute/singlesmallnumericattribute.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/docstore/ibucketizer.h>
@@ -21,6 +21,7 @@ namespace proton {
 
 namespace bucketdb {
 
+class BucketState;
 class SplitBucketSession;
 class JoinBucketsSession;
 
@@ -57,7 +58,7 @@ public:
 
 private:
     // maps from lid -> meta data
-    typedef search::attribute::RcuVectorBase<RawDocumentMetaData> MetaDataStore;
+    typedef search::attribute::SegmentedRcuVectorBase<RawDocumentMetaData> MetaDataStore;
     typedef documentmetastore::LidGidKeyComparator KeyComp;
 
     // Lids are stored as keys in the tree, sorted by their gid
@@ -115,6 +116,14 @@ private:
     void unload();
     void updateActiveLids(const BucketId &bucketId, bool active) override;
 
+    /**
+     * Relabels the documents in the gid range of the given bucket that
+     * are labeled with fromUsedBits to use toUsedBits instead, adding
+     * them to the given bucket delta.
+     */
+    void relabelBucket(const BucketId &bucketId, uint8_t fromUsedBits, uint8_t toUsedBits,
+                       bucketdb::BucketState &delta);
+
     /**
      * Implements DocumentMetaStoreAdapter
      */
@@ -133,6 +142,7 @@ private:
 
     VESPA_DLL_LOCAL DocId readNextDoc(documentmetastore::Reader & reader, TreeType::Builder & treeBuilder);
 
+    bool removeFromTree(DocId lid);
     bool remove(DocId lid, BucketDBOwner::Guard &bucketGuard);
 
 public:
@@ -206,6 +216,7 @@ public:
     DocId   getNumUsedLids() const override { return _lidAlloc.getNumUsedLids(); }
     DocId getNumActiveLids() const override { return _lidAlloc.getNumActiveLids(); }
     search::LidUsageStats getLidUsageStats() const override;
+    search::MemoryUsage getMemoryUsage() const override;
     search::queryeval::Blueprint::UP createWhiteListBlueprint() const override;
 
     /**
@@ -19,6 +19,13 @@ public:
 
     virtual bool operator()(const document::GlobalId &lhs,
                             const document::GlobalId &rhs) const = 0;
+
+    /**
+     * Returns true if the ordering is the bucket order of
+     * document::GlobalId::BucketOrderCmp, which lets the comparator of
+     * the lid<->gid btree compare inline instead of calling this.
+     */
+    virtual bool isBucketOrder() const { return false; }
 };
 
 
@@ -41,6 +48,8 @@ public:
                             const document::GlobalId &rhs) const override {
         return _comp(lhs, rhs);
     }
+
+    bool isBucketOrder() const override { return true; }
 };
 
 
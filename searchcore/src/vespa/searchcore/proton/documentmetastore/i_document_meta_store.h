@@ -9,6 +9,7 @@
 #include <vespa/searchlib/btree/btreenodeallocator.h>
 #include <vespa/searchlib/common/idocumentmetastore.h>
 #include <vespa/searchlib/common/serialnum.h>
+#include <vespa/searchlib/util/memoryusage.h>
 
 namespace proton {
 
@@ -82,6 +83,11 @@ struct IDocumentMetaStore : public search::IDocumentMetaStore,
      */
     virtual void compactLidSpace(DocId wantedLidLimit) = 0;
 
+    /*
+     * Memory usage as of the last commit.
+     */
+    virtual search::MemoryUsage getMemoryUsage() const = 0;
+
 };
 
 } // namespace proton
@@ -13,7 +13,9 @@ LidGidKeyComparator::LidGidKeyComparator(const document::GlobalId &gid,
                                          const IGidCompare &gidCompare)
     : _gid(gid),
       _metaDataStore(metaDataStore),
-      _gidCompare(gidCompare)
+      _gidCompare(gidCompare),
+      _bucketOrderCmp(),
+      _bucketOrder(gidCompare.isBucketOrder())
 {
 }
 
@@ -22,7 +24,9 @@ LidGidKeyComparator::LidGidKeyComparator(const RawDocumentMetaData &metaData,
                                          const IGidCompare &gidCompare)
     : _gid(metaData.getGid()),
       _metaDataStore(metaDataStore),
-      _gidCompare(gidCompare)
+      _gidCompare(gidCompare),
+      _bucketOrderCmp(),
+      _bucketOrder(gidCompare.isBucketOrder())
 {
 }
 
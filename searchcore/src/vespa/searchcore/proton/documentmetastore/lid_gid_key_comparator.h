@@ -5,7 +5,7 @@
 #include "gid_compare.h"
 #include "raw_document_meta_data.h"
 #include <vespa/document/base/globalid.h>
-#include <vespa/searchlib/common/rcuvector.h>
+#include <vespa/searchlib/common/segmented_rcuvector.h>
 #include <vespa/searchlib/common/idocumentmetastore.h>
 
 namespace proton {
@@ -22,11 +22,13 @@ public:
 
 private:
     typedef search::IDocumentMetaStore::DocId DocId;
-    typedef search::attribute::RcuVectorBase<RawDocumentMetaData> MetaDataStore;
+    typedef search::attribute::SegmentedRcuVectorBase<RawDocumentMetaData> MetaDataStore;
 
     const document::GlobalId &_gid;
     const MetaDataStore      &_metaDataStore;
     const IGidCompare        &_gidCompare;
+    document::GlobalId::BucketOrderCmp _bucketOrderCmp;
+    bool                      _bucketOrder;
 
     const document::GlobalId &getGid(DocId lid) const {
         if (lid != FIND_DOC_ID) {
@@ -50,7 +52,11 @@ public:
                         const IGidCompare &gidCompare);
 
     bool operator()(const DocId &lhs, const DocId &rhs) const {
-            return _gidCompare(getGid(lhs), getGid(rhs));
+        if (_bucketOrder) {
+            // Avoids a virtual call for every step of a btree search
+            return _bucketOrderCmp(getGid(lhs), getGid(rhs));
+        }
+        return _gidCompare(getGid(lhs), getGid(rhs));
     }
 
 };
@@ -2,6 +2,7 @@
 
 #include "putoperation.h"
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/vespalib/objects/nbostream.h>
 
 using document::BucketId;
 using document::Document;
@@ -13,7 +14,8 @@ namespace proton {
 
 PutOperation::PutOperation()
     : DocumentOperation(FeedOperation::PUT),
-      _doc()
+      _doc(),
+      _serializedDoc()
 { }
 
 
@@ -23,7 +25,8 @@ PutOperation::PutOperation(const BucketId &bucketId,
     : DocumentOperation(FeedOperation::PUT,
                         bucketId,
                         timestamp),
-      _doc(doc)
+      _doc(doc),
+      _serializedDoc()
 { }
 
 PutOperation::~PutOperation() { }
@@ -33,9 +36,11 @@ PutOperation::serialize(vespalib::nbostream &os) const
 {
     assertValidBucketId(_doc->getId());
     DocumentOperation::serialize(os);
-    size_t oldSize = os.size();
-    _doc->serialize(os);
-    _serializedDocSize = os.size() - oldSize;
+    auto docStream = std::make_shared<vespalib::nbostream>();
+    _doc->serialize(*docStream);
+    os.write(docStream->peek(), docStream->size());
+    _serializedDocSize = docStream->size();
+    _serializedDoc = std::move(docStream);
 }
 
 
@@ -44,9 +49,12 @@ PutOperation::deserialize(vespalib::nbostream &is,
                           const DocumentTypeRepo &repo)
 {
     DocumentOperation::deserialize(is, repo);
+    const char *docStart = is.peek();
     size_t oldSize = is.size();
     _doc.reset(new Document(repo, is));
     _serializedDocSize = oldSize - is.size();
+    vespalib::nbostream docStream(docStart, _serializedDocSize);
+    _serializedDoc = std::make_shared<vespalib::nbostream>(docStream);
 }
 
 void
@@ -56,6 +64,7 @@ PutOperation::deserializeDocument(const DocumentTypeRepo &repo)
     _doc->serialize(stream);
     auto fixedDoc = std::make_shared<Document>(repo, stream);
     _doc = std::move(fixedDoc);
+    _serializedDoc.reset();
 }
 
 vespalib::string
@@ -2,12 +2,14 @@
 
 #include "flush_engine_explorer.h"
 
+#include <vespa/searchlib/common/background_write_limiter.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 #include <vespa/vespalib/data/slime/inserter.h>
 
 using vespalib::slime::Cursor;
 using vespalib::slime::Inserter;
 using vespalib::StateExplorer;
+using search::BackgroundWriteLimiter;
 using searchcorespi::IFlushTarget;
 
 namespace proton {
@@ -57,6 +59,14 @@ convertToSlime(const FlushContext::List &allTargets,
     }
 }
 
+void
+convertToSlime(const BackgroundWriteLimiter::Stats &stats, Cursor &object)
+{
+    object.setLong("maxBytesPerSecond", stats.maxBytesPerSecond);
+    object.setLong("bytesWritten", stats.bytesWritten);
+    object.setDouble("throttledTime", stats.throttledTime);
+}
+
 }
 
 FlushEngineExplorer::FlushEngineExplorer(const FlushEngine &engine)
@@ -68,6 +78,7 @@ void
 FlushEngineExplorer::get_state(const Inserter &inserter, bool full) const
 {
     Cursor &object = inserter.insertObject();
+    convertToSlime(BackgroundWriteLimiter::instance().getStats(), object.setObject("writeLimit"));
     if (full) {
         fastos::TimeStamp now = fastos::ClockSystem::now();
         convertToSlime(_engine.getCurrentlyFlushingSet(), now, object.setArray("flushingTargets"));
@@ -21,6 +21,10 @@ namespace proton {
 
 namespace {
 
+using vespalib::Runnable;
+
+VESPA_THREAD_STACK_TAG(proton_flush_executor);
+
 search::SerialNum
 findOldestFlushedSerial(const IFlushTarget::List &lst,
                         const IFlushHandler &handler)
@@ -70,7 +74,7 @@ FlushEngine::FlushEngine(std::shared_ptr<flushengine::ITlsStatsFactory>
       _threadPool(128 * 1024),
       _strategy(strategy),
       _priorityStrategy(),
-      _executor(numThreads, 128 * 1024),
+      _executor(numThreads, 128 * 1024, proton_flush_executor),
       _lock(),
       _cond(),
       _handlers(),
@@ -5,14 +5,16 @@
 #include <vespa/searchcorespi/index/indexsearchablevisitor.h>
 
 using search::TuneFileSearch;
+using search::diskindex::PostingListCache;
 using searchcorespi::index::IndexReadUtilities;
 
 namespace proton {
 
 DiskIndexWrapper::DiskIndexWrapper(const vespalib::string &indexDir,
                                    const TuneFileSearch &tuneFileSearch,
-                                   size_t cacheSize)
-    : _index(indexDir, cacheSize),
+                                   size_t cacheSize,
+                                   PostingListCache::SP postingListCache)
+    : _index(indexDir, cacheSize, std::move(postingListCache)),
       _serialNum(0)
 {
     bool setupIndexOk = _index.setup(tuneFileSearch);
@@ -23,8 +25,9 @@ DiskIndexWrapper::DiskIndexWrapper(const vespalib::string &indexDir,
 
 DiskIndexWrapper::DiskIndexWrapper(const DiskIndexWrapper &oldIndex,
                                    const TuneFileSearch &tuneFileSearch,
-                                   size_t cacheSize)
-    : _index(oldIndex._index.getIndexDir(), cacheSize),
+                                   size_t cacheSize,
+                                   PostingListCache::SP postingListCache)
+    : _index(oldIndex._index.getIndexDir(), cacheSize, std::move(postingListCache)),
       _serialNum(0)
 {
     bool setupIndexOk = _index.setup(tuneFileSearch, oldIndex._index);
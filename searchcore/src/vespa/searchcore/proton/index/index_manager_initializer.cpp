@@ -13,6 +13,9 @@ IndexManagerInitializer(const vespalib::string &baseDir,
                         const searchcorespi::index::WarmupConfig & warmupCfg,
                         size_t maxFlushed,
                         size_t cacheSize,
+                        size_t postingListCacheSize,
+                        double checkpointInterval,
+                        bool blockMaxWeights,
                         const search::index::Schema &schema,
                         search::SerialNum serialNum,
                         searchcorespi::IIndexManager::Reconfigurer & reconfigurer,
@@ -26,6 +29,9 @@ IndexManagerInitializer(const vespalib::string &baseDir,
       _warmupCfg(warmupCfg),
       _maxFlushed(maxFlushed),
       _cacheSize(cacheSize),
+      _postingListCacheSize(postingListCacheSize),
+      _checkpointInterval(checkpointInterval),
+      _blockMaxWeights(blockMaxWeights),
       _schema(schema),
       _serialNum(serialNum),
       _reconfigurer(reconfigurer),
@@ -57,7 +63,10 @@ IndexManagerInitializer::run()
                      _warmupExecutor,
                      _tuneFileIndexManager,
                      _tuneFileAttributes,
-                     _fileHeaderContext);
+                     _fileHeaderContext,
+                     _postingListCacheSize,
+                     _checkpointInterval,
+                     _blockMaxWeights);
 }
 
 
@@ -19,6 +19,9 @@ class IndexManagerInitializer :  public initializer::InitializerTask
     const searchcorespi::index::WarmupConfig    _warmupCfg;
     size_t                                      _maxFlushed;
     size_t                                      _cacheSize;
+    size_t                                      _postingListCacheSize;
+    double                                      _checkpointInterval;
+    bool                                        _blockMaxWeights;
     const search::index::Schema                 _schema;
     search::SerialNum                           _serialNum;
     searchcorespi::IIndexManager::Reconfigurer &_reconfigurer;
@@ -34,6 +37,9 @@ public:
                             const searchcorespi::index::WarmupConfig & warmupCfg,
                             size_t maxFlushed,
                             size_t cacheSize,
+                            size_t postingListCacheSize,
+                            double checkpointInterval,
+                            bool blockMaxWeights,
                             const search::index::Schema &schema,
                             search::SerialNum serialNum,
                             searchcorespi::IIndexManager::Reconfigurer & reconfigurer,
@@ -7,6 +7,7 @@
 #include <vespa/searchlib/diskindex/fusion.h>
 
 using search::diskindex::Fusion;
+using search::diskindex::PostingListCache;
 using search::common::FileHeaderContext;
 using search::common::SerialNumFileHeaderContext;
 using search::index::Schema;
@@ -27,14 +28,20 @@ namespace proton {
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          size_t cacheSize,
+                                                         size_t postingListCacheSize,
                                                          searchcorespi::index::
                                                          IThreadingService &
-                                                         threadingService)
+                                                         threadingService,
+                                                         bool blockMaxWeights)
     : _cacheSize(cacheSize),
+      _postingListCache(postingListCacheSize > 0
+                        ? std::make_shared<PostingListCache>(postingListCacheSize)
+                        : PostingListCache::SP()),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexManager._indexing),
       _tuneFileSearch(tuneFileIndexManager._search),
-      _threadingService(threadingService)
+      _threadingService(threadingService),
+      _blockMaxWeights(blockMaxWeights)
 {
 }
 
@@ -46,20 +53,21 @@ IndexManager::MaintainerOperations::createMemoryIndex(const Schema &schema,
                                                    _fileHeaderContext,
                                                    _tuneFileIndexing,
                                                    _threadingService,
-                                                   serialNum));
+                                                   serialNum,
+                                                   _blockMaxWeights));
 }
 
 IDiskIndex::SP
 IndexManager::MaintainerOperations::loadDiskIndex(const vespalib::string &indexDir)
 {
-    return IDiskIndex::SP(new DiskIndexWrapper(indexDir, _tuneFileSearch, _cacheSize));
+    return IDiskIndex::SP(new DiskIndexWrapper(indexDir, _tuneFileSearch, _cacheSize, _postingListCache));
 }
 
 IDiskIndex::SP
 IndexManager::MaintainerOperations::reloadDiskIndex(const IDiskIndex &oldIndex)
 {
     return IDiskIndex::SP(new DiskIndexWrapper(dynamic_cast<const DiskIndexWrapper &>(oldIndex),
-                                               _tuneFileSearch, _cacheSize));
+                                               _tuneFileSearch, _cacheSize, _postingListCache));
 }
 
 bool
@@ -67,14 +75,16 @@ IndexManager::MaintainerOperations::runFusion(const Schema &schema,
                                               const vespalib::string &outputDir,
                                               const std::vector<vespalib::string> &sources,
                                               const SelectorArray &selectorArray,
-                                              SerialNum serialNum)
+                                              SerialNum serialNum,
+                                              uint32_t numThreads)
 {
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext,
                                                  serialNum);
     const bool dynamic_k_doc_pos_occ_format = false;
     return Fusion::merge(schema, outputDir, sources, selectorArray,
                          dynamic_k_doc_pos_occ_format,
-                         _tuneFileIndexing, fileHeaderContext);
+                         _tuneFileIndexing, fileHeaderContext, numThreads,
+                         _blockMaxWeights);
 }
 
 
@@ -89,15 +99,19 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            vespalib::ThreadExecutor & warmupExecutor,
                            const search::TuneFileIndexManager &tuneFileIndexManager,
                            const search::TuneFileAttributes &tuneFileAttributes,
-                           const search::common::FileHeaderContext &fileHeaderContext) :
+                           const search::common::FileHeaderContext &fileHeaderContext,
+                           size_t postingListCacheSize,
+                           double checkpointInterval,
+                           bool blockMaxWeights) :
     _operations(fileHeaderContext, tuneFileIndexManager, cacheSize,
-                threadingService),
+                postingListCacheSize, threadingService, blockMaxWeights),
     _maintainer(IndexMaintainerConfig(baseDir,
                                       warmup,
                                       maxFlushed,
                                       schema,
                                       serialNum,
-                                      tuneFileAttributes),
+                                      tuneFileAttributes,
+                                      checkpointInterval),
                 IndexMaintainerContext(threadingService,
                                        reconfigurer,
                                        fileHeaderContext,
@@ -110,5 +124,16 @@ IndexManager::~IndexManager()
 {
 }
 
+search::SearchableStats
+IndexManager::getSearchableStats() const
+{
+    search::SearchableStats stats = _maintainer.getSearchableStats();
+    const PostingListCache::SP &postingListCache = _operations.getPostingListCache();
+    if (postingListCache) {
+        stats.postingListCache(postingListCache->getStats());
+    }
+    return stats;
+}
+
 } // namespace proton
 
@@ -5,6 +5,7 @@
 #include <vespa/searchcorespi/index/iindexmanager.h>
 #include <vespa/searchcorespi/index/indexmaintainer.h>
 #include <vespa/searchcorespi/index/ithreadingservice.h>
+#include <vespa/searchlib/diskindex/posting_list_cache.h>
 
 namespace proton {
 
@@ -20,17 +21,24 @@ public:
     class MaintainerOperations : public searchcorespi::index::IIndexMaintainerOperations {
     private:
         const size_t _cacheSize;
+        // Shared by all disk indexes, empty if disabled
+        const search::diskindex::PostingListCache::SP _postingListCache;
         const search::common::FileHeaderContext &_fileHeaderContext;
         const search::TuneFileIndexing _tuneFileIndexing;
         const search::TuneFileSearch _tuneFileSearch;
         searchcorespi::index::IThreadingService &_threadingService;
+        // Store block max weights in flushed and fused posting lists
+        const bool _blockMaxWeights;
 
     public:
         MaintainerOperations(const search::common::FileHeaderContext &fileHeaderContext,
                              const search::TuneFileIndexManager &tuneFileIndexManager,
                              size_t cacheSize,
+                             size_t postingListCacheSize,
                              searchcorespi::index::IThreadingService &
-                             threadingService);
+                             threadingService,
+                             bool blockMaxWeights = false);
+        const search::diskindex::PostingListCache::SP &getPostingListCache() const { return _postingListCache; }
 
         virtual searchcorespi::index::IMemoryIndex::SP
         createMemoryIndex(const search::index::Schema &schema,
@@ -43,7 +51,8 @@ public:
                                const vespalib::string &outputDir,
                                const std::vector<vespalib::string> &sources,
                                const search::diskindex::SelectorArray &docIdSelector,
-                               search::SerialNum lastSerialNum) override;
+                               search::SerialNum lastSerialNum,
+                               uint32_t numThreads) override;
     };
 
 private:
@@ -64,7 +73,10 @@ public:
                  vespalib::ThreadExecutor & warmupExecutor,
                  const search::TuneFileIndexManager &tuneFileIndexManager,
                  const search::TuneFileAttributes &tuneFileAttributes,
-                 const search::common::FileHeaderContext &fileHeaderContext);
+                 const search::common::FileHeaderContext &fileHeaderContext,
+                 size_t postingListCacheSize = 0,
+                 double checkpointInterval = 0.0,
+                 bool blockMaxWeights = false);
     ~IndexManager();
 
     searchcorespi::index::IndexMaintainer &getMaintainer() {
@@ -104,8 +116,10 @@ public:
         return _maintainer.getSearchable();
     }
 
-    virtual search::SearchableStats getSearchableStats() const override {
-        return _maintainer.getSearchableStats();
+    virtual search::SearchableStats getSearchableStats() const override;
+
+    virtual searchcorespi::index::IndexWriteStats getWriteStats() const override {
+        return _maintainer.getWriteStats();
     }
 
     virtual searchcorespi::IFlushTarget::List getFlushTargets() override {
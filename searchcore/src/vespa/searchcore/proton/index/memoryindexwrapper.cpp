@@ -21,12 +21,14 @@ MemoryIndexWrapper::MemoryIndexWrapper(const search::index::Schema &schema,
                                        const TuneFileIndexing &tuneFileIndexing,
                                        searchcorespi::index::IThreadingService &
                                        threadingService,
-                                       search::SerialNum serialNum)
+                                       search::SerialNum serialNum,
+                                       bool blockMaxWeights)
     : _index(schema, threadingService.indexFieldInverter(),
              threadingService.indexFieldWriter()),
       _serialNum(serialNum),
       _fileHeaderContext(fileHeaderContext),
-      _tuneFileIndexing(tuneFileIndexing)
+      _tuneFileIndexing(tuneFileIndexing),
+      _blockMaxWeights(blockMaxWeights)
 {
 }
 
@@ -39,6 +41,7 @@ MemoryIndexWrapper::flushToDisk(const vespalib::string &flushDir,
     _index.freeze(); // TODO(geirst): is this needed anymore?
     IndexBuilder indexBuilder(_index.getSchema());
     indexBuilder.setPrefix(flushDir);
+    indexBuilder.setBlockMaxWeights(_blockMaxWeights);
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext,
                                                  serialNum);
     indexBuilder.open(docIdLimit, numWords, _tuneFileIndexing, fileHeaderContext);
@@ -46,6 +49,16 @@ MemoryIndexWrapper::flushToDisk(const vespalib::string &flushDir,
     indexBuilder.close();
 }
 
+bool
+MemoryIndexWrapper::loadCheckpoint(vespalib::nbostream &is, SerialNum serialNum)
+{
+    if (!_index.loadCheckpoint(is)) {
+        return false;
+    }
+    _serialNum.store(serialNum, std::memory_order_relaxed);
+    return true;
+}
+
 search::SerialNum
 MemoryIndexWrapper::getSerialNum() const
 {
@@ -22,6 +22,7 @@ private:
     std::atomic<SerialNum> _serialNum;
     const search::common::FileHeaderContext &_fileHeaderContext;
     const search::TuneFileIndexing _tuneFileIndexing;
+    const bool _blockMaxWeights;
 
 public:
     MemoryIndexWrapper(const search::index::Schema &schema,
@@ -29,7 +30,8 @@ public:
                        const search::TuneFileIndexing &tuneFileIndexing,
                        searchcorespi::index::IThreadingService &
                        threadingService,
-                       SerialNum serialNum);
+                       SerialNum serialNum,
+                       bool blockMaxWeights = false);
 
     /**
      * Implements searchcorespi::IndexSearchable
@@ -88,6 +90,10 @@ public:
         _index.pruneRemovedFields(schema);
     }
     void flushToDisk(const vespalib::string &flushDir, uint32_t docIdLimit, SerialNum serialNum) override;
+    void saveCheckpoint(vespalib::nbostream &os) override {
+        _index.saveCheckpoint(os);
+    }
+    bool loadCheckpoint(vespalib::nbostream &is, SerialNum serialNum) override;
 };
 
 } // namespace proton
@@ -9,6 +9,10 @@ LOG_SETUP(".proton.matchengine.matchengine");
 
 namespace {
 
+using vespalib::Runnable;
+
+VESPA_THREAD_STACK_TAG(proton_match_executor);
+
 class SearchTask : public vespalib::Executor::Task {
 private:
     proton::MatchEngine                   &_engine;
@@ -38,13 +42,14 @@ namespace proton {
 
 using namespace vespalib::slime;
 
-MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey)
+MatchEngine::MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey,
+                         bool bindToNumaNodes)
     : _lock(),
       _distributionKey(distributionKey),
       _closed(false),
       _handlers(),
-      _executor(std::max(size_t(1), numThreads / threadsPerSearch), 256 * 1024),
-      _threadBundlePool(std::max(size_t(1), threadsPerSearch)),
+      _executor(std::max(size_t(1), numThreads / threadsPerSearch), 256 * 1024, proton_match_executor),
+      _threadBundlePool(std::max(size_t(1), threadsPerSearch), bindToNumaNodes),
       _nodeUp(false)
 {
     // empty
@@ -45,8 +45,10 @@ public:
      * @param numThreads Number of threads allocated for handling search requests.
      * @param threadsPerSearch number of threads used for each search
      * @param distributionKey distributionkey of this node.
+     * @param bindToNumaNodes bind the threads of each search to a numa node.
      */
-    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey);
+    MatchEngine(size_t numThreads, size_t threadsPerSearch, uint32_t distributionKey,
+                bool bindToNumaNodes = false);
 
     /**
      * Frees any allocated resources. this will also stop all internal threads
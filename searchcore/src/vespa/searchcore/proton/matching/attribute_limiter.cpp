@@ -5,6 +5,7 @@
 #include <vespa/searchlib/fef/matchdatalayout.h>
 #include <vespa/searchlib/query/tree/range.h>
 #include <vespa/searchlib/query/tree/simplequery.h>
+#include <vespa/fastos/timestamp.h>
 
 using namespace search::queryeval;
 using namespace search::query;
@@ -30,6 +31,7 @@ AttributeLimiter::AttributeLimiter(Searchable &searchable_attributes,
       _match_datas(),
       _blueprint(),
       _estimatedHits(-1),
+      _setup_time_s(0.0),
       _diversityCutoffFactor(diversityCutoffFactor),
       _diversityCutoffStrategy(diversityCutoffStrategy)
 {
@@ -64,6 +66,8 @@ AttributeLimiter::create_search(size_t want_hits, size_t max_group_size, bool st
     search::fef::MatchDataLayout layout;
     auto my_handle = layout.allocTermField(my_field_id);
     if ( ! _blueprint ) {
+        fastos::StopWatch setup_time;
+        setup_time.start();
         const uint32_t no_unique_id = 0;
         string range_spec = make_string("[;;%s%zu", (_descending)? "-" : "", want_hits);
         if (max_group_size < want_hits) {
@@ -81,6 +85,8 @@ AttributeLimiter::create_search(size_t want_hits, size_t max_group_size, bool st
         _blueprint->fetchPostings(strictSearch);
         _estimatedHits = _blueprint->getState().estimate().estHits;
         _blueprint->freeze();
+        setup_time.stop();
+        _setup_time_s = setup_time.elapsed().sec();
     }
     _match_datas.push_back(layout.createMatchData());
     return _blueprint->createSearch(*_match_datas.back(), strictSearch);
@@ -35,6 +35,8 @@ public:
     search::queryeval::SearchIterator::UP create_search(size_t want_hits, size_t max_group_size, bool strictSearch);
     bool was_used() const { return ((!_match_datas.empty()) || (_blueprint.get() != nullptr)); }
     ssize_t getEstimatedHits() const { return _estimatedHits; }
+    /** Time spent creating the limiting search, including any diversity filtering. */
+    double setup_time() const { return _setup_time_s; }
     static DiversityCutoffStrategy toDiversityCutoffStrategy(const vespalib::stringref & strategy);
 private:
     const vespalib::string & toString(DiversityCutoffStrategy strategy);
@@ -47,6 +49,7 @@ private:
     std::vector<search::fef::MatchData::UP>    _match_datas;
     search::queryeval::Blueprint::UP           _blueprint;
     ssize_t                                    _estimatedHits;
+    double                                     _setup_time_s;
     double                                     _diversityCutoffFactor;
     DiversityCutoffStrategy                    _diversityCutoffStrategy;
 };
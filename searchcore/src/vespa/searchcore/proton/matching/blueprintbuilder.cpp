@@ -4,6 +4,10 @@
 #include "blueprintbuilder.h"
 #include "termdatafromnode.h"
 #include "same_element_builder.h"
+#include "cached_filter.h"
+#include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/query/tree/customtypevisitor.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
@@ -56,20 +60,23 @@ class BlueprintBuilderVisitor :
 private:
     const IRequestContext & _requestContext;
     ISearchContext &_context;
+    FilterResultCache *_filterCache;
     Blueprint::UP   _result;
 
     void buildChildren(IntermediateBlueprint &parent,
-                       const std::vector<search::query::Node *> &children)
+                       const std::vector<search::query::Node *> &children,
+                       FilterResultCache *filterCache)
     {
         for (size_t i = 0; i < children.size(); ++i) {
-            parent.addChild(BlueprintBuilder::build(_requestContext, *children[i], _context));
+            parent.addChild(BlueprintBuilder::build(_requestContext, *children[i], _context, filterCache));
         }
     }
 
+    // Children needing positions must not be replaced by cached filters
     template <typename NodeType>
-    void buildIntermediate(IntermediateBlueprint *b, NodeType &n) {
+    void buildIntermediate(IntermediateBlueprint *b, NodeType &n, bool positional = false) {
         std::unique_ptr<IntermediateBlueprint> blueprint(b);
-        buildChildren(*blueprint, n.getChildren());
+        buildChildren(*blueprint, n.getChildren(), positional ? nullptr : _filterCache);
         _result.reset(blueprint.release());
     }
 
@@ -133,6 +140,51 @@ private:
         n.setDocumentFrequency(_result->getState().estimate().estHits, _context.getDocIdLimit());
     }
 
+    /**
+     * Match an unranked single attribute term against the cached
+     * documents of the term, evaluating it into the cache if the term
+     * is used often enough. Entries are tagged with the attribute
+     * generation, which is bumped on every commit to the attribute.
+     */
+    template <typename NodeType>
+    Blueprint::UP buildCachedAttributeTerm(NodeType &n) {
+        const ProtonTermData::FieldEntry &field = n.field(0);
+        auto attribute = dynamic_cast<const search::AttributeVector *>(_requestContext.getAttribute(field.field_name));
+        if (attribute == nullptr) {
+            // e.g. imported attributes, which have no generation of their own
+            return Blueprint::UP();
+        }
+        uint64_t generation = attribute->getCurrentGeneration();
+        uint32_t docIdLimit = _context.getDocIdLimit();
+        vespalib::string key = field.field_name + "@" + createFilterKey(n);
+        FilterResultCache::BitVectorSP bits = _filterCache->lookup(key, generation);
+        if (!bits || (bits->size() != docIdLimit)) {
+            if (!_filterCache->admit(key)) {
+                return Blueprint::UP();
+            }
+            FieldSpecList attrField;
+            attrField.add(field.fieldSpec());
+            Blueprint::UP blueprint = _context.getAttributes().createBlueprint(_requestContext, attrField, n);
+            blueprint->setDocIdLimit(docIdLimit);
+            search::fef::MatchData md(search::fef::MatchData::params().numTermFields(field.getHandle() + 1));
+            bits = evaluateFilter(*blueprint, md, docIdLimit);
+            _filterCache->insert(key, generation, bits);
+        }
+        return std::make_unique<CachedFilterBlueprint>(std::move(bits));
+    }
+
+    template <typename NodeType>
+    void buildFilterTerm(NodeType &n) {
+        if ((_filterCache != nullptr) && !n.isRanked() && (n.numFields() == 1) && n.field(0).attribute_field) {
+            _result = buildCachedAttributeTerm(n);
+            if (_result) {
+                n.setDocumentFrequency(_result->getState().estimate().estHits, _context.getDocIdLimit());
+                return;
+            }
+        }
+        buildTerm(n);
+    }
+
 protected:
     void visit(ProtonAnd &n)         override { buildIntermediate(new AndBlueprint(), n); }
     void visit(ProtonAndNot &n)      override { buildIntermediate(new AndNotBlueprint(), n); }
@@ -140,30 +192,33 @@ protected:
     void visit(ProtonWeakAnd &n)     override { buildWeakAnd(n); }
     void visit(ProtonEquiv &n)       override { buildEquiv(n); }
     void visit(ProtonRank &n)        override { buildIntermediate(new RankBlueprint(), n); }
-    void visit(ProtonNear &n)        override { buildIntermediate(new NearBlueprint(n.getDistance()), n); }
-    void visit(ProtonONear &n)       override { buildIntermediate(new ONearBlueprint(n.getDistance()), n); }
+    void visit(ProtonNear &n)        override { buildIntermediate(new NearBlueprint(n.getDistance()), n, true); }
+    void visit(ProtonONear &n)       override { buildIntermediate(new ONearBlueprint(n.getDistance()), n, true); }
     void visit(ProtonSameElement &n) override { buildSameElement(n); }
 
 
-    void visit(ProtonWeightedSetTerm &n) override { buildTerm(n); }
+    void visit(ProtonWeightedSetTerm &n) override { buildFilterTerm(n); }
     void visit(ProtonDotProduct &n)      override { buildTerm(n); }
     void visit(ProtonWandTerm &n)        override { buildTerm(n); }
 
     void visit(ProtonPhrase &n)          override { buildTerm(n); }
-    void visit(ProtonNumberTerm &n)      override { buildTerm(n); }
+    void visit(ProtonNumberTerm &n)      override { buildFilterTerm(n); }
     void visit(ProtonLocationTerm &n)    override { buildTerm(n); }
-    void visit(ProtonPrefixTerm &n)      override { buildTerm(n); }
-    void visit(ProtonRangeTerm &n)       override { buildTerm(n); }
-    void visit(ProtonStringTerm &n)      override { buildTerm(n); }
-    void visit(ProtonSubstringTerm &n)   override { buildTerm(n); }
-    void visit(ProtonSuffixTerm &n)      override { buildTerm(n); }
+    void visit(ProtonPrefixTerm &n)      override { buildFilterTerm(n); }
+    void visit(ProtonRangeTerm &n)       override { buildFilterTerm(n); }
+    void visit(ProtonStringTerm &n)      override { buildFilterTerm(n); }
+    void visit(ProtonSubstringTerm &n)   override { buildFilterTerm(n); }
+    void visit(ProtonSuffixTerm &n)      override { buildFilterTerm(n); }
     void visit(ProtonPredicateQuery &n)  override { buildTerm(n); }
-    void visit(ProtonRegExpTerm &n)      override { buildTerm(n); }
+    void visit(ProtonRegExpTerm &n)      override { buildFilterTerm(n); }
+    void visit(ProtonNearestNeighborTerm &n) override { buildTerm(n); }
 
 public:
-    BlueprintBuilderVisitor(const IRequestContext & requestContext, ISearchContext &context) :
+    BlueprintBuilderVisitor(const IRequestContext & requestContext, ISearchContext &context,
+                            FilterResultCache *filterCache) :
         _requestContext(requestContext),
         _context(context),
+        _filterCache(filterCache),
         _result()
     { }
     Blueprint::UP build() {
@@ -177,9 +232,10 @@ public:
 search::queryeval::Blueprint::UP
 BlueprintBuilder::build(const IRequestContext & requestContext,
                         search::query::Node &node,
-                        ISearchContext &context)
+                        ISearchContext &context,
+                        FilterResultCache *filterCache)
 {
-    BlueprintBuilderVisitor visitor(requestContext, context);
+    BlueprintBuilderVisitor visitor(requestContext, context, filterCache);
     node.accept(visitor);
     Blueprint::UP result = visitor.build();
     result->setDocIdLimit(context.getDocIdLimit());
@@ -8,15 +8,20 @@
 
 namespace proton::matching {
 
+class FilterResultCache;
+
 struct BlueprintBuilder {
     /**
      * Build a tree of blueprints from the query tree and inject
      * blueprint meta-data back into corresponding query tree nodes.
+     * When a filter cache is given, unranked attribute terms that are
+     * used often are matched against cached bitvectors.
      */
     static search::queryeval::Blueprint::UP
     build(const search::queryeval::IRequestContext & requestContext,
           search::query::Node &node,
-          ISearchContext &context);
+          ISearchContext &context,
+          FilterResultCache *filterCache = nullptr);
 };
 
 }
@@ -0,0 +1,123 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "cached_filter.h"
+#include "querynodes.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/fef/matchdata.h>
+#include <vespa/searchlib/query/tree/templatetermvisitor.h>
+#include <vespa/searchlib/queryeval/termasstring.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <typeinfo>
+
+using search::BitVector;
+using search::fef::MatchData;
+using search::fef::TermFieldMatchData;
+using search::fef::TermFieldMatchDataArray;
+using search::query::Intermediate;
+using search::query::Node;
+using search::query::TemplateTermVisitor;
+using search::queryeval::Blueprint;
+using search::queryeval::FieldSpecBaseList;
+using search::queryeval::SearchIterator;
+using search::queryeval::SimpleLeafBlueprint;
+using search::queryeval::termAsString;
+
+namespace proton::matching {
+
+namespace {
+
+class FilterKeyBuilder : public TemplateTermVisitor<FilterKeyBuilder, ProtonNodeTypes>
+{
+private:
+    vespalib::asciistream _os;
+
+    void visitChildren(const std::vector<Node *> &children) {
+        _os << '(';
+        for (Node *child : children) {
+            child->accept(*this);
+        }
+        _os << ')';
+    }
+
+    void visitIntermediate(Intermediate &n, uint32_t distance = 0) {
+        _os << typeid(n).name() << ':' << distance;
+        visitChildren(n.getChildren());
+    }
+
+    template <class TermType>
+    void visitTermWithChildren(TermType &n) {
+        _os << typeid(n).name() << ':' << n.getView();
+        visitChildren(n.getChildren());
+    }
+
+public:
+    template <class TermType>
+    void visitTerm(TermType &n) {
+        _os << typeid(n).name() << ':' << n.getView() << ':' << termAsString(n) << ';';
+    }
+
+    void visit(ProtonNodeTypes::And &n) override { visitIntermediate(n); }
+    void visit(ProtonNodeTypes::AndNot &n) override { visitIntermediate(n); }
+    void visit(ProtonNodeTypes::Or &n) override { visitIntermediate(n); }
+    void visit(ProtonNodeTypes::Rank &n) override { visitIntermediate(n); }
+    void visit(ProtonNodeTypes::Near &n) override { visitIntermediate(n, n.getDistance()); }
+    void visit(ProtonNodeTypes::ONear &n) override { visitIntermediate(n, n.getDistance()); }
+    void visit(ProtonNodeTypes::Phrase &n) override { visitTermWithChildren(n); }
+    void visit(ProtonNodeTypes::WeightedSetTerm &n) override { visitTermWithChildren(n); }
+    void visit(ProtonNodeTypes::DotProduct &n) override { visitTermWithChildren(n); }
+
+    vespalib::string str() const { return _os.str(); }
+};
+
+}
+
+CachedFilterBlueprint::CachedFilterBlueprint(FilterResultCache::BitVectorSP bits)
+    : SimpleLeafBlueprint(FieldSpecBaseList()),
+      _bits(std::move(bits)),
+      _lock(),
+      _matchData()
+{
+    uint32_t hits = _bits->countTrueBits();
+    setEstimate(HitEstimate(hits, (hits == 0)));
+}
+
+CachedFilterBlueprint::~CachedFilterBlueprint() {}
+
+SearchIterator::UP
+CachedFilterBlueprint::createLeafSearch(const TermFieldMatchDataArray &tfmda, bool strict) const
+{
+    assert(tfmda.size() == 0);
+    (void) tfmda;
+    auto tfmd = std::make_unique<TermFieldMatchData>();
+    TermFieldMatchData &ref = *tfmd;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _matchData.push_back(std::move(tfmd));
+    }
+    return search::BitVectorIterator::create(_bits.get(), get_docid_limit(), ref, strict);
+}
+
+vespalib::string
+createFilterKey(Node &node)
+{
+    FilterKeyBuilder builder;
+    node.accept(builder);
+    return builder.str();
+}
+
+FilterResultCache::BitVectorSP
+evaluateFilter(Blueprint &filter, MatchData &md, uint32_t docIdLimit)
+{
+    filter.fetchPostings(true);
+    SearchIterator::UP search = filter.createSearch(md, true);
+    search->initRange(1, docIdLimit);
+    std::shared_ptr<BitVector> bits(BitVector::create(docIdLimit).release());
+    search->or_hits_into(*bits, 1);
+    bits->invalidateCachedCount();
+    // the count is cached on first use; do it before the result is shared
+    bits->countTrueBits();
+    return bits;
+}
+
+}
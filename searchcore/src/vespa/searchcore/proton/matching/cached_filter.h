@@ -0,0 +1,48 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "filter_result_cache.h"
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/tree/node.h>
+#include <vespa/searchlib/queryeval/leaf_blueprints.h>
+#include <mutex>
+
+namespace search::fef { class MatchData; }
+
+namespace proton::matching {
+
+/**
+ * Leaf blueprint matching the documents of a filter result taken
+ * from the filter result cache.
+ **/
+class CachedFilterBlueprint : public search::queryeval::SimpleLeafBlueprint
+{
+private:
+    FilterResultCache::BitVectorSP _bits;
+    mutable std::mutex _lock;
+    mutable std::vector<std::unique_ptr<search::fef::TermFieldMatchData>> _matchData;
+
+    search::queryeval::SearchIterator::UP
+    createLeafSearch(const search::fef::TermFieldMatchDataArray &tfmda, bool strict) const override;
+
+public:
+    CachedFilterBlueprint(FilterResultCache::BitVectorSP bits);
+    ~CachedFilterBlueprint();
+};
+
+/**
+ * Create the cache key of a filter subtree. Term weights and unique
+ * ids are left out, as they depend on the rest of the query and do
+ * not change which documents the filter matches.
+ **/
+vespalib::string createFilterKey(search::query::Node &node);
+
+/**
+ * Evaluate the given filter blueprint into a bitvector of the
+ * documents it matches.
+ **/
+FilterResultCache::BitVectorSP
+evaluateFilter(search::queryeval::Blueprint &filter, search::fef::MatchData &md, uint32_t docIdLimit);
+
+}
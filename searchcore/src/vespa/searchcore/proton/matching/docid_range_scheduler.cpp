@@ -160,4 +160,92 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+DocidRange
+WorkStealingDocidRangeScheduler::take_task(size_t thread_id)
+{
+    std::atomic<uint64_t> &todo = _workers[thread_id].todo;
+    uint64_t value = todo.load(std::memory_order_relaxed);
+    for (;;) {
+        DocidRange range = unpack(value);
+        if (range.empty()) {
+            return DocidRange();
+        }
+        uint32_t split = (range.size() < (2 * size_t(_min_task))) ? range.end : (range.begin + _min_task);
+        if (todo.compare_exchange_weak(value, pack(DocidRange(split, range.end)),
+                                       std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            return DocidRange(range.begin, split);
+        }
+    }
+}
+
+bool
+WorkStealingDocidRangeScheduler::steal(size_t thread_id)
+{
+    for (;;) {
+        size_t victim = thread_id;
+        uint64_t value = 0;
+        size_t best_size = 0;
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            if (i != thread_id) {
+                uint64_t candidate = _workers[i].todo.load(std::memory_order_relaxed);
+                size_t size = unpack(candidate).size();
+                if (size > best_size) {
+                    victim = i;
+                    value = candidate;
+                    best_size = size;
+                }
+            }
+        }
+        if (best_size == 0) {
+            return false;
+        }
+        DocidRange range = unpack(value);
+        uint32_t mid = range.begin + (range.size() / 2);
+        if (_workers[victim].todo.compare_exchange_strong(value, pack(DocidRange(range.begin, mid)),
+                                                          std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            // only the owner will try to take tasks from an empty range
+            _workers[thread_id].todo.store(pack(DocidRange(mid, range.end)), std::memory_order_release);
+            ++_workers[thread_id].steals;
+            return true;
+        }
+    }
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit)
+    : _splitter(DocidRange(1, docid_limit), num_threads),
+      _min_task(std::max(1u, min_task)),
+      _workers(num_threads)
+{
+    for (size_t i = 0; i < num_threads; ++i) {
+        _workers[i].todo.store(pack(_splitter.get(i)), std::memory_order_relaxed);
+    }
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() {}
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    DocidRange range = take_task(thread_id);
+    while (range.empty() && steal(thread_id)) {
+        range = take_task(thread_id);
+    }
+    _workers[thread_id].assigned += range.size();
+    return range;
+}
+
+size_t
+WorkStealingDocidRangeScheduler::unassigned_size() const
+{
+    size_t sum = 0;
+    for (const Worker &worker: _workers) {
+        sum += unpack(worker.todo.load(std::memory_order_relaxed)).size();
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+
 }
@@ -114,6 +114,7 @@ struct DocidRangeScheduler {
     virtual size_t unassigned_size() const = 0;
     virtual IdleObserver make_idle_observer() const = 0;
     virtual DocidRange share_range(size_t thread_id, DocidRange todo) = 0;
+    virtual size_t steal_count(size_t thread_id) const = 0;
     virtual ~DocidRangeScheduler() {}
 };
 
@@ -135,6 +136,7 @@ public:
     size_t unassigned_size() const override { return 0; }
     IdleObserver make_idle_observer() const override { return IdleObserver(); }
     DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t steal_count(size_t) const override { return 0; }
 };
 
 /**
@@ -162,6 +164,7 @@ public:
     size_t unassigned_size() const override { return _unassigned.load(std::memory_order::memory_order_relaxed); }
     IdleObserver make_idle_observer() const override { return IdleObserver(); }
     DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t steal_count(size_t) const override { return 0; }
 };
 
 /**
@@ -202,6 +205,47 @@ public:
     size_t unassigned_size() const override { return 0; }
     IdleObserver make_idle_observer() const override { return IdleObserver(_num_idle); }
     DocidRange share_range(size_t, DocidRange todo) override;
+    size_t steal_count(size_t) const override { return 0; }
+};
+
+/**
+ * A lock-free work-stealing scheduler. Each thread starts out owning
+ * an equal part of the docid space and consumes it from the front in
+ * tasks of (at least) the minimal task size. A thread that runs out
+ * of work steals the back half of the largest remaining range owned
+ * by another thread. The remaining range of each thread is packed
+ * into a single atomic value that is updated using compare-and-swap
+ * by both the owner and any thieves.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> todo;
+        size_t                assigned;
+        size_t                steals;
+        Worker() : todo(0), assigned(0), steals(0) {}
+    };
+    static uint64_t pack(DocidRange range) { return ((uint64_t(range.begin) << 32) | range.end); }
+    static DocidRange unpack(uint64_t value) { return DocidRange(uint32_t(value >> 32), uint32_t(value)); }
+
+    DocidRangeSplitter  _splitter;
+    uint32_t            _min_task;
+    std::vector<Worker> _workers;
+
+    VESPA_DLL_LOCAL DocidRange take_task(size_t thread_id);
+    VESPA_DLL_LOCAL bool steal(size_t thread_id);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit);
+    ~WorkStealingDocidRangeScheduler();
+    DocidRange first_range(size_t thread_id) override { return next_range(thread_id); }
+    DocidRange next_range(size_t thread_id) override;
+    DocidRange total_span(size_t) const override { return _splitter.full_range(); }
+    size_t total_size(size_t thread_id) const override { return _workers[thread_id].assigned; }
+    size_t unassigned_size() const override;
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+    size_t steal_count(size_t thread_id) const override { return _workers[thread_id].steals; }
 };
 
 }
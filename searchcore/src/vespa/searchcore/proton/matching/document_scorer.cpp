@@ -1,6 +1,8 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "document_scorer.h"
+#include <algorithm>
+#include <cassert>
 
 using search::feature_t;
 using search::fef::FeatureResolver;
@@ -36,5 +38,18 @@ DocumentScorer::score(uint32_t docId)
     return doScore(docId);
 }
 
+void
+DocumentScorer::score(IMatchLoopCommunicator::TaggedHits &hits)
+{
+    using TaggedHit = IMatchLoopCommunicator::TaggedHit;
+    std::sort(hits.begin(), hits.end(),
+              [](const TaggedHit &a, const TaggedHit &b) { return (a.first.first < b.first.first); });
+    for (TaggedHit &hit: hits) {
+        uint32_t docId = hit.first.first;
+        _searchItr.seek(docId);
+        hit.first.second = doScore(docId);
+    }
+}
+
 } // namespace proton::matching
 } // namespace proton
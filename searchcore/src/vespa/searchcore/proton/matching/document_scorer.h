@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "i_match_loop_communicator.h"
 #include <vespa/searchlib/fef/rank_program.h>
 #include <vespa/searchlib/queryeval/hitcollector.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
@@ -30,6 +31,13 @@ public:
     }
 
     virtual search::feature_t score(uint32_t docId) override;
+
+    /**
+     * Calculates the score of hits collected by any match thread. The
+     * hits are sorted on docId and the search iterator must cover the
+     * whole docid space.
+     **/
+    void score(IMatchLoopCommunicator::TaggedHits &hits);
 };
 
 } // namespace proton::matching
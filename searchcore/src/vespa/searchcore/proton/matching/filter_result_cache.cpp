@@ -0,0 +1,166 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "filter_result_cache.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+namespace proton::matching {
+
+namespace {
+
+size_t roundUp2inN(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+}
+
+FrequencySketch::FrequencySketch(size_t width, size_t sampleSize)
+    : _counters(NUM_ROWS * roundUp2inN(width), 0),
+      _mask(roundUp2inN(width) - 1),
+      _sampleSize(sampleSize),
+      _numAdded(0)
+{
+}
+
+FrequencySketch::~FrequencySketch() {}
+
+void
+FrequencySketch::age()
+{
+    for (uint8_t &counter : _counters) {
+        counter >>= 1;
+    }
+    _numAdded = 0;
+}
+
+uint32_t
+FrequencySketch::add(uint64_t hash)
+{
+    if (++_numAdded > _sampleSize) {
+        age();
+    }
+    uint32_t result = MAX_COUNT;
+    for (uint32_t row = 0; row < NUM_ROWS; ++row) {
+        uint8_t &counter = _counters[index(row, hash)];
+        if (counter < MAX_COUNT) {
+            ++counter;
+        }
+        result = std::min(result, uint32_t(counter));
+    }
+    return result;
+}
+
+uint32_t
+FrequencySketch::estimate(uint64_t hash) const
+{
+    uint32_t result = MAX_COUNT;
+    for (uint32_t row = 0; row < NUM_ROWS; ++row) {
+        result = std::min(result, uint32_t(_counters[index(row, hash)]));
+    }
+    return result;
+}
+
+FilterResultCache::FilterResultCache(size_t maxBytes)
+    : _maxBytes(maxBytes),
+      _lock(),
+      _map(),
+      _lru(),
+      _memoryUsage(0),
+      _sketch(enabled() ? 4096 : 1, 40960),
+      _stats()
+{
+}
+
+FilterResultCache::~FilterResultCache() {}
+
+void
+FilterResultCache::erase(const vespalib::string &key, const std::lock_guard<std::mutex> &)
+{
+    auto pos = _map.find(key);
+    _memoryUsage -= pos->second.memoryUsage;
+    _lru.erase(pos->second.lruPos);
+    _map.erase(pos);
+}
+
+void
+FilterResultCache::evict(const std::lock_guard<std::mutex> &guard)
+{
+    while ((_memoryUsage > _maxBytes) && !_lru.empty()) {
+        vespalib::string key = _lru.front();
+        erase(key, guard);
+    }
+}
+
+FilterResultCache::BitVectorSP
+FilterResultCache::lookup(const vespalib::string &key, uint64_t generation)
+{
+    BitVectorSP stale;
+    std::lock_guard<std::mutex> guard(_lock);
+    auto pos = _map.find(key);
+    if (pos == _map.end()) {
+        ++_stats.numMisses;
+        return BitVectorSP();
+    }
+    if (pos->second.generation != generation) {
+        ++_stats.numMisses;
+        stale = std::move(pos->second.bits);
+        erase(key, guard);
+        return BitVectorSP();
+    }
+    ++_stats.numHits;
+    _lru.splice(_lru.end(), _lru, pos->second.lruPos);
+    return pos->second.bits;
+}
+
+void
+FilterResultCache::insert(const vespalib::string &key, uint64_t generation, BitVectorSP bits)
+{
+    size_t memoryUsage = sizeof(Entry) + (2 * key.size()) + (bits->size() / 8);
+    if (!enabled() || (memoryUsage > _maxBytes)) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_lock);
+    auto pos = _map.find(key);
+    if (pos != _map.end()) {
+        if (pos->second.generation >= generation) {
+            return;
+        }
+        erase(key, guard);
+    }
+    Entry &entry = _map[key];
+    entry.generation = generation;
+    entry.bits = std::move(bits);
+    entry.memoryUsage = memoryUsage;
+    entry.lruPos = _lru.insert(_lru.end(), key);
+    _memoryUsage += memoryUsage;
+    evict(guard);
+}
+
+bool
+FilterResultCache::admit(const vespalib::string &key)
+{
+    uint64_t hash = vespalib::hashValue(key.data(), key.size());
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_sketch.add(hash) < ADMISSION_FREQUENCY) {
+        ++_stats.numRejected;
+        return false;
+    }
+    return true;
+}
+
+FilterResultCache::Stats
+FilterResultCache::getStats()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    Stats stats = _stats;
+    stats.numCached = _map.size();
+    stats.memoryUsage = _memoryUsage;
+    return stats;
+}
+
+}
@@ -0,0 +1,142 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace search { class BitVector; }
+
+namespace proton::matching {
+
+/**
+ * Count-min sketch estimating how often keys have been seen lately,
+ * using a fixed amount of memory. Estimates never undercount. All
+ * counters are halved each time the given number of keys have been
+ * added, so keys that were popular a long time ago fade out.
+ **/
+class FrequencySketch
+{
+private:
+    static constexpr uint32_t NUM_ROWS = 4;
+    static constexpr uint8_t MAX_COUNT = 255;
+
+    std::vector<uint8_t> _counters;
+    size_t               _mask;
+    size_t               _sampleSize;
+    size_t               _numAdded;
+
+    size_t index(uint32_t row, uint64_t hash) const {
+        uint64_t step = (hash >> 32) | 1;
+        return (row * (_mask + 1)) + ((hash + row * step) & _mask);
+    }
+    void age();
+
+public:
+    /**
+     * @param width number of counters per row, rounded up to a power of 2
+     * @param sampleSize number of keys added between each halving
+     **/
+    FrequencySketch(size_t width, size_t sampleSize);
+    ~FrequencySketch();
+
+    /** Count one more occurrence of the key, returning the new estimate. **/
+    uint32_t add(uint64_t hash);
+    uint32_t estimate(uint64_t hash) const;
+};
+
+/**
+ * Cache of the documents matched by filter subqueries, keyed on the
+ * normalized form of the filter subtree. Queries sharing an expensive
+ * filter (tenant, language, ACL) but differing in their ranked part
+ * will evaluate the filter once and match the rest against the cached
+ * bitvector. The cache is bounded by memory usage and evicts the
+ * least recently used entries first.
+ *
+ * Entries are tagged with the generation of the query result cache
+ * they were produced in, which changes whenever the visible documents
+ * change. An entry is only returned for the generation it was produced
+ * in.
+ *
+ * Single unranked attribute terms (tenant, language, ACL) are also
+ * cached, but those are tagged with the generation of the attribute
+ * instead. Each commit to the attribute bumps it, so these entries
+ * stay valid when other fields are fed. As most such terms are rare,
+ * an attribute term is only evaluated into a bitvector once it has
+ * been seen a few times lately, as tracked by a frequency sketch.
+ **/
+class FilterResultCache
+{
+public:
+    using BitVectorSP = std::shared_ptr<const search::BitVector>;
+
+    /** Generation given when the visible documents are not versioned. **/
+    static constexpr uint64_t NO_GENERATION = std::numeric_limits<uint64_t>::max();
+    static constexpr uint32_t ADMISSION_FREQUENCY = 3;
+
+    struct Stats {
+        Stats() : numHits(0), numMisses(0), numRejected(0), numCached(0), memoryUsage(0) {}
+        size_t numHits;
+        size_t numMisses;
+        size_t numRejected;
+        size_t numCached;
+        size_t memoryUsage;
+    };
+
+private:
+    using KeyList = std::list<vespalib::string>;
+
+    struct Entry {
+        uint64_t          generation;
+        BitVectorSP       bits;
+        size_t            memoryUsage;
+        KeyList::iterator lruPos;
+    };
+
+    const size_t                                _maxBytes;
+    mutable std::mutex                          _lock;
+    vespalib::hash_map<vespalib::string, Entry> _map;
+    KeyList                                     _lru;
+    size_t                                      _memoryUsage;
+    FrequencySketch                             _sketch;
+    Stats                                       _stats;
+
+    void erase(const vespalib::string &key, const std::lock_guard<std::mutex> &guard);
+    void evict(const std::lock_guard<std::mutex> &guard);
+
+public:
+    FilterResultCache(size_t maxBytes);
+    ~FilterResultCache();
+
+    bool enabled() const { return (_maxBytes > 0); }
+
+    /**
+     * Look up the cached result of a filter produced in the given
+     * generation.
+     *
+     * @return the matching documents, or an empty pointer on miss
+     **/
+    BitVectorSP lookup(const vespalib::string &key, uint64_t generation);
+
+    /**
+     * Insert the result of a filter produced after the given
+     * generation was sampled, replacing any entry from an older
+     * generation.
+     **/
+    void insert(const vespalib::string &key, uint64_t generation, BitVectorSP bits);
+
+    /**
+     * Count a use of the given key and tell whether it is used often
+     * enough for its result to be worth caching.
+     **/
+    bool admit(const vespalib::string &key);
+
+    Stats getStats();
+};
+
+}
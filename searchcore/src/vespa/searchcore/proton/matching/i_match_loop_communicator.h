@@ -6,6 +6,7 @@
 #include <vespa/searchlib/queryeval/scores.h>
 #include <utility>
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace proton {
@@ -15,6 +16,11 @@ struct IMatchLoopCommunicator {
     typedef search::feature_t feature_t;
     typedef search::queryeval::Scores Range;
     typedef std::pair<Range, Range> RangePair;
+    typedef std::pair<uint32_t, feature_t> Hit;
+    typedef std::vector<Hit> Hits;
+    // a hit tagged with the id of the thread that collected it
+    typedef std::pair<Hit, size_t> TaggedHit;
+    typedef std::vector<TaggedHit> TaggedHits;
     struct Matches {
         size_t hits;
         size_t docs;
@@ -26,7 +32,24 @@ struct IMatchLoopCommunicator {
         }
     };
     virtual double estimate_match_frequency(const Matches &matches) = 0;
-    virtual size_t selectBest(const std::vector<feature_t> &sortedScores) = 0;
+    /**
+     * Select the best hits across all threads and return how many of
+     * them the calling thread contributed. The hits must be sorted on
+     * descending score; equal scores are ordered on ascending docid,
+     * both within and across threads.
+     **/
+    virtual size_t selectBest(const Hits &sortedHits) = 0;
+    /**
+     * Pool the second phase candidates of all threads and hand out an
+     * even share of them to each thread, independent of which thread
+     * collected them.
+     **/
+    virtual TaggedHits get_second_phase_work(const Hits &candidates, size_t thread_id) = 0;
+    /**
+     * Return the second phase scores calculated by each thread to the
+     * threads that collected the hits, sorted on docid.
+     **/
+    virtual Hits complete_second_phase(const TaggedHits &results, size_t thread_id) = 0;
     virtual RangePair rangeCover(const RangePair &ranges) = 0;
     virtual ~IMatchLoopCommunicator() {}
 };
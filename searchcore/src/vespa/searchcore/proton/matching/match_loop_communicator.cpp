@@ -1,7 +1,8 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "match_loop_communicator.h"
-#include <vespa/vespalib/util/priority_queue.h>
+#include <algorithm>
+#include <thread>
 
 namespace proton {
 namespace matching {
@@ -9,7 +10,9 @@ namespace matching {
 MatchLoopCommunicator::MatchLoopCommunicator(size_t threads, size_t topN)
     : _estimate_match_frequency(threads),
       _selectBest(threads, topN),
-      _rangeCover(threads)
+      _rangeCover(threads),
+      _get_second_phase_work(threads),
+      _complete_second_phase(threads)
 {}
 MatchLoopCommunicator::~MatchLoopCommunicator() {}
 
@@ -30,23 +33,68 @@ MatchLoopCommunicator::EstimateMatchFrequency::mingle()
     }
 }
 
+MatchLoopCommunicator::SelectBest::SelectBest(size_t n, size_t topN)
+    : _size(n),
+      _topN(topN),
+      _slots(new Slot[n]),
+      _result(n, 0),
+      _arrivals(0),
+      _result_gen(0)
+{
+}
+
+MatchLoopCommunicator::SelectBest::~SelectBest() {}
+
 void
-MatchLoopCommunicator::SelectBest::mingle()
+MatchLoopCommunicator::SelectBest::merge(Slot &dst, const Slot &src) const
 {
-    vespalib::PriorityQueue<uint32_t, SelectCmp> queue(SelectCmp(*this));
-    for (size_t i = 0; i < size(); ++i) {
-        if (!in(i).empty()) {
-            queue.push(i);
+    dst.tmp.clear();
+    auto a = dst.best.begin();
+    auto b = src.best.begin();
+    while ((dst.tmp.size() < _topN) && ((a != dst.best.end()) || (b != src.best.end()))) {
+        if ((b == src.best.end()) || ((a != dst.best.end()) && !b->betterThan(*a))) {
+            dst.tmp.push_back(*a++);
+        } else {
+            dst.tmp.push_back(*b++);
         }
     }
-    for (size_t picked = 0; picked < topN && !queue.empty(); ++picked) {
-        uint32_t i = queue.front();
-        if (in(i).size() > ++out(i)) {
-            queue.adjust();
-        } else {
-            queue.pop_front();
+    dst.best.swap(dst.tmp);
+}
+
+size_t
+MatchLoopCommunicator::SelectBest::select(const Hits &sortedHits)
+{
+    size_t ticket = _arrivals.fetch_add(1, std::memory_order_relaxed);
+    size_t gen = (ticket / _size) + 1;
+    size_t me = (ticket % _size);
+    Slot &slot = _slots[me];
+    slot.best.clear();
+    for (size_t i = 0; i < sortedHits.size() && i < _topN; ++i) {
+        slot.best.push_back(Candidate{sortedHits[i].second, sortedHits[i].first, uint32_t(me)});
+    }
+    for (size_t step = 1; step < _size; step *= 2) {
+        if ((me % (2 * step)) != 0) {
+            slot.published.store(gen, std::memory_order_release);
+            while (_result_gen.load(std::memory_order_acquire) != gen) {
+                std::this_thread::yield();
+            }
+            return _result[me];
+        }
+        if (me + step < _size) {
+            const Slot &partner = _slots[me + step];
+            while (partner.published.load(std::memory_order_acquire) != gen) {
+                std::this_thread::yield();
+            }
+            merge(slot, partner);
         }
     }
+    std::fill(_result.begin(), _result.end(), 0);
+    for (const Candidate &candidate: slot.best) {
+        ++_result[candidate.slot];
+    }
+    size_t my_result = _result[0];
+    _result_gen.store(gen, std::memory_order_release);
+    return my_result;
 }
 
 void
@@ -72,5 +120,50 @@ MatchLoopCommunicator::RangeCover::mingle()
     }
 }
 
+void
+MatchLoopCommunicator::GetSecondPhaseWork::mingle()
+{
+    std::vector<size_t> slot_of_thread(size(), 0);
+    TaggedHits candidates;
+    for (size_t i = 0; i < size(); ++i) {
+        slot_of_thread[in(i).first] = i;
+        for (const Hit &hit: *in(i).second) {
+            candidates.emplace_back(hit, in(i).first);
+        }
+    }
+    // best first, with docid and thread id to break ties deterministically
+    std::sort(candidates.begin(), candidates.end(),
+              [](const TaggedHit &a, const TaggedHit &b) {
+                  if (a.first.second != b.first.second) {
+                      return (a.first.second > b.first.second);
+                  }
+                  if (a.first.first != b.first.first) {
+                      return (a.first.first < b.first.first);
+                  }
+                  return (a.second < b.second);
+              });
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        out(slot_of_thread[i % size()]).push_back(candidates[i]);
+    }
+}
+
+void
+MatchLoopCommunicator::CompleteSecondPhase::mingle()
+{
+    std::vector<size_t> slot_of_thread(size(), 0);
+    for (size_t i = 0; i < size(); ++i) {
+        slot_of_thread[in(i).first] = i;
+    }
+    for (size_t i = 0; i < size(); ++i) {
+        for (const TaggedHit &hit: *in(i).second) {
+            out(slot_of_thread[hit.second]).push_back(hit.first);
+        }
+    }
+    for (size_t i = 0; i < size(); ++i) {
+        std::sort(out(i).begin(), out(i).end(),
+                  [](const Hit &a, const Hit &b) { return (a.first < b.first); });
+    }
+}
+
 } // namespace matching
 } // namespace proton
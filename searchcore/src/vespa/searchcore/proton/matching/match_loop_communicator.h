@@ -4,6 +4,8 @@
 
 #include "i_match_loop_communicator.h"
 #include <vespa/vespalib/util/rendezvous.h>
+#include <atomic>
+#include <memory>
 
 namespace proton {
 namespace matching {
@@ -16,30 +18,72 @@ private:
             : vespalib::Rendezvous<Matches, double>(n) {}
         virtual void mingle() override;
     };
-    struct SelectBest : vespalib::Rendezvous<std::vector<feature_t>, size_t> {
-        size_t topN;
-        SelectBest(size_t n, size_t topN_in)
-            : vespalib::Rendezvous<std::vector<feature_t>, size_t>(n), topN(topN_in) {}
-        virtual void mingle() override;
-        bool cmp(const uint32_t &a, const uint32_t &b) {
-            return (in(a)[out(a)] > in(b)[out(b)]);
-        }
-    };
-    struct SelectCmp {
-        SelectBest &sb;
-        SelectCmp(SelectBest &sb_in) : sb(sb_in) {}
-        bool operator()(const uint32_t &a, const uint32_t &b) const {
-            return (sb.cmp(a, b));
-        }
+    /**
+     * Selects the best hits across all threads using a tree
+     * reduction. Threads are given slots in arrival order. In round r,
+     * the thread in slot i (with i a multiple of 2^(r+1)) merges the
+     * candidates of slot i + 2^r into its own, keeping the topN
+     * best. After log2(n) rounds slot 0 holds the global result and
+     * publishes how many hits each slot contributed. Threads only wait
+     * for their merge partner and for the final result, and never
+     * block on a lock. Per-slot state is padded to a cache line to
+     * avoid false sharing.
+     **/
+    class SelectBest {
+    private:
+        struct Candidate {
+            feature_t score;
+            uint32_t  docid;
+            uint32_t  slot;
+            bool betterThan(const Candidate &rhs) const {
+                // lowest docid wins a tie, as in the hit collector
+                return ((score > rhs.score) || ((score == rhs.score) && (docid < rhs.docid)));
+            }
+        };
+        struct alignas(64) Slot {
+            std::vector<Candidate> best;
+            std::vector<Candidate> tmp;
+            std::atomic<size_t>    published;
+            Slot() : best(), tmp(), published(0) {}
+        };
+        const size_t               _size;
+        const size_t               _topN;
+        std::unique_ptr<Slot[]>    _slots;
+        std::vector<size_t>        _result;
+        alignas(64) std::atomic<size_t> _arrivals;
+        alignas(64) std::atomic<size_t> _result_gen;
+
+        void merge(Slot &dst, const Slot &src) const;
+    public:
+        SelectBest(size_t n, size_t topN);
+        ~SelectBest();
+        size_t select(const Hits &sortedHits);
     };
     struct RangeCover : vespalib::Rendezvous<RangePair, RangePair> {
         RangeCover(size_t n)
             : vespalib::Rendezvous<RangePair, RangePair>(n) {}
         virtual void mingle() override;
     };
+    /**
+     * Candidates are handed out round robin in score order, so each
+     * thread gets about the same number of expensive hits. The share
+     * of a thread only depends on its thread id, not on arrival order.
+     **/
+    struct GetSecondPhaseWork : vespalib::Rendezvous<std::pair<size_t, const Hits *>, TaggedHits> {
+        GetSecondPhaseWork(size_t n)
+            : vespalib::Rendezvous<std::pair<size_t, const Hits *>, TaggedHits>(n) {}
+        virtual void mingle() override;
+    };
+    struct CompleteSecondPhase : vespalib::Rendezvous<std::pair<size_t, const TaggedHits *>, Hits> {
+        CompleteSecondPhase(size_t n)
+            : vespalib::Rendezvous<std::pair<size_t, const TaggedHits *>, Hits>(n) {}
+        virtual void mingle() override;
+    };
     EstimateMatchFrequency _estimate_match_frequency;
     SelectBest             _selectBest;
     RangeCover             _rangeCover;
+    GetSecondPhaseWork     _get_second_phase_work;
+    CompleteSecondPhase    _complete_second_phase;
 
 public:
     MatchLoopCommunicator(size_t threads, size_t topN);
@@ -48,12 +92,18 @@ public:
     virtual double estimate_match_frequency(const Matches &matches) override {
         return _estimate_match_frequency.rendezvous(matches);
     }
-    virtual size_t selectBest(const std::vector<feature_t> &sortedScores) override {
-        return _selectBest.rendezvous(sortedScores);
+    virtual size_t selectBest(const Hits &sortedHits) override {
+        return _selectBest.select(sortedHits);
     }
     virtual RangePair rangeCover(const RangePair &ranges) override {
         return _rangeCover.rendezvous(ranges);
     }
+    virtual TaggedHits get_second_phase_work(const Hits &candidates, size_t thread_id) override {
+        return _get_second_phase_work.rendezvous(std::make_pair(thread_id, &candidates));
+    }
+    virtual Hits complete_second_phase(const TaggedHits &results, size_t thread_id) override {
+        return _complete_second_phase.rendezvous(std::make_pair(thread_id, &results));
+    }
 };
 
 } // namespace matching
@@ -26,11 +26,17 @@ struct TimedMatchLoopCommunicator : IMatchLoopCommunicator {
     virtual double estimate_match_frequency(const Matches &matches) override {
         return communicator.estimate_match_frequency(matches);
     }
-    virtual size_t selectBest(const std::vector<feature_t> &sortedScores) override {
-        size_t result = communicator.selectBest(sortedScores);
+    virtual size_t selectBest(const Hits &sortedHits) override {
+        size_t result = communicator.selectBest(sortedHits);
         rerank_time.start();
         return result;
     }
+    virtual TaggedHits get_second_phase_work(const Hits &candidates, size_t thread_id) override {
+        return communicator.get_second_phase_work(candidates, thread_id);
+    }
+    virtual Hits complete_second_phase(const TaggedHits &results, size_t thread_id) override {
+        return communicator.complete_second_phase(results, thread_id);
+    }
     virtual RangePair rangeCover(const RangePair &ranges) override {
         RangePair result = communicator.rangeCover(ranges);
         rerank_time.stop();
@@ -39,8 +45,13 @@ struct TimedMatchLoopCommunicator : IMatchLoopCommunicator {
 };
 
 DocidRangeScheduler::UP
-createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
+createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, bool workStealing, uint32_t numDocs)
 {
+    if (workStealing) {
+        // aim for a fixed number of tasks per thread to bound both scheduling overhead and imbalance
+        uint32_t minTask = numDocs / (numThreads * 64);
+        return std::make_unique<WorkStealingDocidRangeScheduler>(numThreads, minTask, numDocs);
+    }
     if (numSearchPartitions == 0) {
         return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
     }
@@ -58,14 +69,16 @@ MatchMaster::match(const MatchParams &params,
                    const MatchToolsFactory &matchToolsFactory,
                    ResultProcessor &resultProcessor,
                    uint32_t distributionKey,
-                   uint32_t numSearchPartitions)
+                   uint32_t numSearchPartitions,
+                   bool workStealing)
 {
     fastos::StopWatch query_latency_time;
     query_latency_time.start();
     vespalib::DualMergeDirector mergeDirector(threadBundle.size());
     MatchLoopCommunicator communicator(threadBundle.size(), params.heapSize);
     TimedMatchLoopCommunicator timedCommunicator(communicator);
-    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs);
+    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions,
+                                                        workStealing, params.numDocs);
 
     std::vector<MatchThread::UP> threadState;
     std::vector<vespalib::Runnable*> targets;
@@ -86,17 +99,27 @@ MatchMaster::match(const MatchParams &params,
     double query_time_s = query_latency_time.elapsed().sec();
     double rerank_time_s = timedCommunicator.rerank_time.elapsed().sec();
     double match_time_s = 0.0;
+    double cpu_time_s = 0.0;
+    double allocated_bytes = 0.0;
     for (size_t i = 0; i < threadState.size(); ++i) {
+        const MatchingStats::Partition &thread_stats = threadState[i]->get_thread_stats();
         match_time_s = std::max(match_time_s, threadState[i]->get_match_time());
-        _stats.merge_partition(threadState[i]->get_thread_stats(), i);
+        cpu_time_s += thread_stats.cpu_time_avg();
+        allocated_bytes += thread_stats.allocated_bytes_avg();
+        _stats.merge_partition(thread_stats, i);
     }
     _stats.queryLatency(query_time_s);
     _stats.matchTime(match_time_s - rerank_time_s);
     _stats.rerankTime(rerank_time_s);
     _stats.groupingTime(query_time_s - match_time_s);
+    _stats.blueprintCreationTime(matchToolsFactory.blueprint_creation_time());
+    _stats.postingFetchTime(matchToolsFactory.posting_fetch_time());
+    _stats.queryCpuTime(cpu_time_s);
+    _stats.queryAllocatedBytes(allocated_bytes);
     _stats.queries(1);
     if (matchToolsFactory.match_limiter().was_limited()) {
         _stats.limited_queries(1);        
+        _stats.limiterSetupTime(matchToolsFactory.match_limiter().setup_time());
     }
     return reply;
 }
@@ -52,6 +52,7 @@ struct MaybeMatchPhaseLimiter {
     virtual SearchIterator::UP maybe_limit(SearchIterator::UP search, double match_freq, size_t num_docs) = 0;
     virtual void updateDocIdSpaceEstimate(size_t searchedDocIdSpace, size_t remainingDocIdSpace) = 0;
     virtual size_t getDocIdSpaceEstimate() const = 0;
+    virtual double setup_time() const = 0;
     virtual ~MaybeMatchPhaseLimiter() {}
 };
 
@@ -67,6 +68,7 @@ struct NoMatchPhaseLimiter : MaybeMatchPhaseLimiter {
     }
     void updateDocIdSpaceEstimate(size_t, size_t) override { }
     size_t getDocIdSpaceEstimate() const override { return std::numeric_limits<size_t>::max(); }
+    double setup_time() const override { return 0.0; }
 };
 
 /**
@@ -119,6 +121,7 @@ public:
     SearchIterator::UP maybe_limit(SearchIterator::UP search, double match_freq, size_t num_docs) override;
     void updateDocIdSpaceEstimate(size_t searchedDocIdSpace, size_t remainingDocIdSpace) override;
     size_t getDocIdSpaceEstimate() const override;
+    double setup_time() const override { return _limiter_factory.setup_time(); }
 };
 
 } // namespace proton::matching
@@ -11,6 +11,8 @@
 #include <vespa/searchcore/grouping/groupingmanager.h>
 #include <vespa/searchcore/grouping/groupingcontext.h>
 #include <vespa/searchlib/common/bitvector.h>
+#include <cassert>
+#include <time.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.match_thread");
@@ -40,6 +42,30 @@ struct WaitTimer {
     }
 };
 
+// Hands out second phase scores calculated by other threads. Hits
+// are sorted on docid and scored in increasing docid order.
+class PrecomputedScorer : public search::queryeval::HitCollector::DocumentScorer {
+    const IMatchLoopCommunicator::Hits &_hits;
+    size_t _pos;
+public:
+    PrecomputedScorer(const IMatchLoopCommunicator::Hits &hits) : _hits(hits), _pos(0) {}
+    search::feature_t score(uint32_t docId) override {
+        while (_pos < _hits.size() && _hits[_pos].first < docId) {
+            ++_pos;
+        }
+        assert(_pos < _hits.size() && _hits[_pos].first == docId);
+        return _hits[_pos].second;
+    }
+};
+
+double thread_cpu_time() {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0.0;
+    }
+    return (ts.tv_sec + (ts.tv_nsec * 1e-9));
+}
+
 // seek_next maps to SearchIterator::seekNext
 struct SimpleStrategy {
     static uint32_t seek_next(SearchIterator &search, uint32_t docid) {
@@ -64,6 +90,17 @@ LazyValue get_score_feature(const RankProgram &rankProgram) {
     return resolver.resolve(0);
 }
 
+// The upper bound may only be used to skip scoring when the outcome
+// is known to be the same; with a rank drop limit a skipped hit would
+// be kept even if its real score would have dropped it.
+bool use_bound(RankProgram *boundProgram, double rankDropLimit) {
+    return ((boundProgram != nullptr) && std::isnan(rankDropLimit));
+}
+
+LazyValue get_bound_feature(RankProgram *boundProgram) {
+    return (boundProgram != nullptr) ? get_score_feature(*boundProgram) : LazyValue(nullptr);
+}
+
 } // namespace proton::matching::<unnamed>
 
 //-----------------------------------------------------------------------------
@@ -71,8 +108,11 @@ LazyValue get_score_feature(const RankProgram &rankProgram) {
 MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollector &hits,
                               uint32_t num_threads)
     : matches(0),
+      pruned(0),
       _matches_limit(tools.match_limiter().sample_hits_per_thread(num_threads)),
       _score_feature(get_score_feature(tools.rank_program())),
+      _bound_feature(get_bound_feature(tools.bound_program())),
+      _use_bound(use_bound(tools.bound_program(), rankDropLimit)),
       _ranking(tools.rank_program()),
       _rankDropLimit(rankDropLimit),
       _hits(hits),
@@ -82,6 +122,15 @@ MatchThread::Context::Context(double rankDropLimit, MatchTools &tools, HitCollec
 
 void
 MatchThread::Context::rankHit(uint32_t docId) {
+    if (_use_bound) {
+        // a hit that cannot beat the current threshold is only stored as a docid
+        double bound = _bound_feature.as_number(docId);
+        if (bound <= _hits.getScoreThreshold()) {
+            _hits.addHit(docId, bound);
+            ++pruned;
+            return;
+        }
+    }
     double score = _score_feature.as_number(docId);
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
@@ -195,8 +244,9 @@ MatchThread::match_loop(MatchTools &tools, HitCollector &hits)
     thread_stats.docsCovered(docsCovered);
     thread_stats.docsMatched(matches);
     thread_stats.softDoomed(softDoomed);
+    thread_stats.steals(scheduler.steal_count(thread_id));
     if (do_rank) {
-        thread_stats.docsRanked(matches);
+        thread_stats.docsRanked(matches - context.pruned);
     }
 }
 
@@ -247,6 +297,28 @@ MatchThread::match_loop_helper(MatchTools &tools, HitCollector &hits)
 
 //-----------------------------------------------------------------------------
 
+void
+MatchThread::rerank_shared(MatchTools &tools, HitCollector &hits, size_t useHits)
+{
+    auto candidates = hits.getSortedHeapHits(useHits);
+    WaitTimer get_work_timer(wait_time_s);
+    auto work = communicator.get_second_phase_work(candidates, thread_id);
+    get_work_timer.done();
+    fastos::StopWatch second_phase_time;
+    second_phase_time.start();
+    tools.search().initRange(1, matchParams.numDocs);
+    DocumentScorer scorer(tools.rank_program(), tools.search());
+    scorer.score(work);
+    second_phase_time.stop();
+    thread_stats.docsReRanked(work.size());
+    thread_stats.second_phase_time(second_phase_time.elapsed().sec());
+    WaitTimer complete_timer(wait_time_s);
+    auto my_results = communicator.complete_second_phase(work, thread_id);
+    complete_timer.done();
+    PrecomputedScorer precomputed(my_results);
+    hits.reRank(precomputed, candidates.size());
+}
+
 search::ResultSet::UP
 MatchThread::findMatches(MatchTools &tools)
 {
@@ -259,19 +331,33 @@ MatchThread::findMatches(MatchTools &tools)
         LOG(debug, "SearchIterator after MultiBitVectorIteratorBase::optimize(): %s", tools.search().asString().c_str());
     }
     HitCollector hits(matchParams.numDocs, matchParams.arraySize, matchParams.heapSize);
+    fastos::StopWatch first_phase_time;
+    first_phase_time.start();
     match_loop_helper(tools, hits);
+    first_phase_time.stop();
+    thread_stats.first_phase_time(first_phase_time.elapsed().sec());
+    size_t allocated_bytes = tools.rank_program().count_used();
     if (tools.has_second_phase_rank()) {
         { // 2nd phase ranking
             tools.setup_second_phase();
+            allocated_bytes += tools.rank_program().count_used();
             DocidRange docid_range = scheduler.total_span(thread_id);
             tools.search().initRange(docid_range.begin, docid_range.end);
-            auto sorted_scores = hits.getSortedHeapScores();
+            auto sorted_hits = hits.getSortedHeapHits(matchParams.heapSize);
             WaitTimer select_best_timer(wait_time_s);
-            size_t useHits = communicator.selectBest(sorted_scores);
+            size_t useHits = communicator.selectBest(sorted_hits);
             select_best_timer.done();
-            DocumentScorer scorer(tools.rank_program(), tools.search());
-            uint32_t reRanked = hits.reRank(scorer, tools.getHardDoom().doom() ? 0 : useHits);
-            thread_stats.docsReRanked(reRanked);
+            if (num_threads > 1) {
+                rerank_shared(tools, hits, tools.getHardDoom().doom() ? 0 : useHits);
+            } else {
+                fastos::StopWatch second_phase_time;
+                second_phase_time.start();
+                DocumentScorer scorer(tools.rank_program(), tools.search());
+                uint32_t reRanked = hits.reRank(scorer, tools.getHardDoom().doom() ? 0 : useHits);
+                second_phase_time.stop();
+                thread_stats.docsReRanked(reRanked);
+                thread_stats.second_phase_time(second_phase_time.elapsed().sec());
+            }
         }
         { // rank scaling
             auto my_ranges = hits.getRanges();
@@ -375,6 +461,7 @@ MatchThread::MatchThread(size_t thread_id_in,
 void
 MatchThread::run()
 {
+    double cpu_start_s = thread_cpu_time();
     fastos::StopWatch total_time;
     fastos::StopWatch match_time;
     total_time.start();
@@ -398,6 +485,7 @@ MatchThread::run()
     total_time.stop();
     total_time_s = total_time.elapsed().sec();
     thread_stats.active_time(total_time_s - wait_time_s).wait_time(wait_time_s);
+    thread_stats.cpu_time(thread_cpu_time() - cpu_start_s);
     mergeDirector.dualMerge(thread_id, *resultContext->result, resultContext->groupingSource);
 }
 
@@ -59,9 +59,12 @@ private:
         bool    isAtLimit() const { return matches == _matches_limit; }
         bool   atSoftDoom() const { return _softDoom.doom(); }
         uint32_t                 matches;
+        uint32_t                 pruned;
     private:
         uint32_t                 _matches_limit;
         LazyValue                _score_feature;
+        LazyValue                _bound_feature;
+        bool                     _use_bound;
         RankProgram             &_ranking;
         double                   _rankDropLimit;
         HitCollector            &_hits;
@@ -85,6 +88,8 @@ private:
     template <bool do_rank> void match_loop_helper_rank(MatchTools &tools, HitCollector &hits);
     void match_loop_helper(MatchTools &tools, HitCollector &hits);
 
+    void rerank_shared(MatchTools &tools, HitCollector &hits, size_t useHits);
+
     search::ResultSet::UP findMatches(MatchTools &tools);
 
     void processResult(const Doom & hardDoom, search::ResultSet::UP result, ResultProcessor::Context &context);
@@ -3,6 +3,7 @@
 #include "match_tools.h"
 #include "querynodes.h"
 #include <vespa/searchlib/parsequery/stackdumpiterator.h>
+#include <vespa/vespalib/util/thread_arena.h>
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.match_tools");
 #include <vespa/searchlib/query/tree/querytreecreator.h>
@@ -18,6 +19,9 @@ namespace proton::matching {
 
 namespace {
 
+// Match data of the last query on this thread, reused by the next one
+thread_local MatchData::UP recycled_match_data;
+
 bool contains_all(const HandleRecorder::HandleSet &old_set,
                   const HandleRecorder::HandleSet &new_set)
 {
@@ -40,22 +44,29 @@ void tag_match_data(const HandleRecorder::HandleSet &handles, MatchData &match_d
 } // namespace proton::matching::<unnamed>
 
 void
-MatchTools::setup(search::fef::RankProgram::UP rank_program, double termwise_limit)
+MatchTools::setup(search::fef::RankProgram::UP rank_program, double termwise_limit, uint32_t termwise_or_limit,
+                  search::fef::RankProgram::UP bound_program)
 {
     if (_search) {
         _match_data->soft_reset();
     }
     _rank_program = std::move(rank_program);
+    _bound_program = std::move(bound_program);
     HandleRecorder recorder;
     {
         HandleRecorder::Binder bind(recorder);
         _rank_program->setup(*_match_data, _queryEnv, _featureOverrides);
+        if (_bound_program) {
+            _bound_program->setup(*_match_data, _queryEnv, _featureOverrides);
+        }
     }
     bool can_reuse_search = (_search && !_search_has_changed &&
                              contains_all(_used_handles, recorder.getHandles()));
     if (!can_reuse_search) {
         tag_match_data(recorder.getHandles(), *_match_data);
         _match_data->set_termwise_limit(termwise_limit);
+        _match_data->set_termwise_or_limit(termwise_or_limit);
+        vespalib::ThreadArena::Scope arena;
         _search = _query.createSearch(*_match_data);
         _used_handles = recorder.getHandles();
         _search_has_changed = false;
@@ -79,8 +90,9 @@ MatchTools::MatchTools(QueryLimiter & queryLimiter,
       _queryEnv(queryEnv),
       _rankSetup(rankSetup),
       _featureOverrides(featureOverrides),
-      _match_data(mdl.createMatchData()),
+      _match_data(mdl.createMatchData(std::move(recycled_match_data))),
       _rank_program(),
+      _bound_program(),
       _search(),
       _used_handles(),
       _search_has_changed(false)
@@ -89,6 +101,11 @@ MatchTools::MatchTools(QueryLimiter & queryLimiter,
 
 MatchTools::~MatchTools()
 {
+    // Drop everything referring to the match data before recycling it
+    _search.reset();
+    _bound_program.reset();
+    _rank_program.reset();
+    recycled_match_data = std::move(_match_data);
 }
 
 void
@@ -96,7 +113,10 @@ MatchTools::setup_first_phase()
 {
     setup(_rankSetup.create_first_phase_program(),
           TermwiseLimit::lookup(_queryEnv.getProperties(),
-                                _rankSetup.get_termwise_limit()));
+                                _rankSetup.get_termwise_limit()),
+          TermwiseOrLimit::lookup(_queryEnv.getProperties(),
+                                  _rankSetup.get_termwise_or_limit()),
+          _rankSetup.create_first_phase_bound_program());
 }
 
 void
@@ -132,25 +152,45 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                   const IIndexEnvironment    & indexEnv,
                   const RankSetup            & rankSetup,
                   const Properties           & rankProperties,
-                  const Properties           & featureOverrides)
+                  const Properties           & featureOverrides,
+                  FilterResultCache          * filterCache,
+                  uint64_t                     filterCacheGeneration)
     : _queryLimiter(queryLimiter),
-      _requestContext(softDoom, attributeContext),
+      _requestContext(softDoom, attributeContext, rankProperties),
       _hardDoom(hardDoom),
       _query(),
       _match_limiter(),
       _queryEnv(indexEnv, attributeContext, rankProperties),
       _mdl(),
       _rankSetup(rankSetup),
-      _featureOverrides(featureOverrides)
+      _featureOverrides(featureOverrides),
+      _blueprint_creation_time_s(0.0),
+      _posting_fetch_time_s(0.0)
 {
+    // the blueprints of this query are allocated together
+    vespalib::ThreadArena::Scope arena;
+    fastos::StopWatch blueprint_creation_time;
+    blueprint_creation_time.start();
     _valid = _query.buildTree(queryStack, location, viewResolver, indexEnv);
     if (_valid) {
         _query.extractTerms(_queryEnv.terms());
         _query.extractLocations(_queryEnv.locations());
         _query.setWhiteListBlueprint(metaStore.createWhiteListBlueprint());
+        if (filterCache != nullptr) {
+            _query.setFilterCache(*filterCache, filterCacheGeneration);
+        }
         _query.reserveHandles(_requestContext, searchContext, _mdl);
         _query.optimize();
-        _query.fetchPostings();
+        blueprint_creation_time.stop();
+        _blueprint_creation_time_s = blueprint_creation_time.elapsed().sec();
+        fastos::StopWatch posting_fetch_time;
+        posting_fetch_time.start();
+        uint32_t sampleBudget = EstimateSampleBudget::lookup(rankProperties,
+                                                             EstimateSampleBudget::lookup(indexEnv.getProperties()));
+        _query.fetchPostings(sampleBudget > 0);
+        _query.sampleEstimates(_mdl, sampleBudget);
+        posting_fetch_time.stop();
+        _posting_fetch_time_s = posting_fetch_time.elapsed().sec();
         _query.freeze();
         _rankSetup.prepareSharedState(_queryEnv, _queryEnv.getObjectStore());
         vespalib::string limit_attribute = DegradationAttribute::lookup(rankProperties);
@@ -187,6 +227,20 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
 
 MatchToolsFactory::~MatchToolsFactory() {}
 
+void
+MatchToolsFactory::limit_sorted_query(uint32_t docIdLimit, search::queryeval::Searchable &searchable_attributes,
+                                      const vespalib::string &attribute, bool ascending, size_t max_hits)
+{
+    if (_match_limiter->is_enabled() || (max_hits == 0)) {
+        return;
+    }
+    _match_limiter.reset(new MatchPhaseLimiter(docIdLimit, searchable_attributes, _requestContext,
+                    attribute, max_hits, !ascending, DegradationMaxFilterCoverage::DEFAULT_VALUE,
+                    DegradationSamplePercentage::DEFAULT_VALUE, DegradationPostFilterMultiplier::DEFAULT_VALUE,
+                    DiversityAttribute::DEFAULT_VALUE, DiversityMinGroups::DEFAULT_VALUE,
+                    DiversityCutoffFactor::DEFAULT_VALUE, AttributeLimiter::LOOSE));
+}
+
 MatchTools::UP
 MatchToolsFactory::createMatchTools() const
 {
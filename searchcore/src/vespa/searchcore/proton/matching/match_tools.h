@@ -33,10 +33,12 @@ private:
     const search::fef::Properties         &_featureOverrides;
     search::fef::MatchData::UP             _match_data;
     search::fef::RankProgram::UP           _rank_program;
+    search::fef::RankProgram::UP           _bound_program;
     search::queryeval::SearchIterator::UP  _search;
     HandleRecorder::HandleSet              _used_handles;
     bool                                   _search_has_changed;
-    void setup(search::fef::RankProgram::UP, double termwise_limit = 1.0);
+    void setup(search::fef::RankProgram::UP, double termwise_limit = 1.0, uint32_t termwise_or_limit = 0,
+               search::fef::RankProgram::UP bound_program = search::fef::RankProgram::UP());
 public:
     typedef std::unique_ptr<MatchTools> UP;
     MatchTools(const MatchTools &) = delete;
@@ -58,6 +60,7 @@ public:
     bool has_second_phase_rank() const { return !_rankSetup.getSecondPhaseRank().empty(); }
     const search::fef::MatchData &match_data() const { return *_match_data; }
     search::fef::RankProgram &rank_program() { return *_rank_program; }
+    search::fef::RankProgram *bound_program() { return _bound_program.get(); }
     search::queryeval::SearchIterator &search() { return *_search; }
     search::queryeval::SearchIterator::UP borrow_search() { return std::move(_search); }
     void give_back_search(search::queryeval::SearchIterator::UP search_in) { _search = std::move(search_in); }
@@ -81,6 +84,8 @@ private:
     const search::fef::RankSetup  & _rankSetup;
     const search::fef::Properties & _featureOverrides;
     bool                            _valid;
+    double                          _blueprint_creation_time_s;
+    double                          _posting_fetch_time_s;
 public:
     typedef std::unique_ptr<MatchToolsFactory> UP;
 
@@ -96,13 +101,24 @@ public:
                       const search::fef::IIndexEnvironment &indexEnv,
                       const search::fef::RankSetup &rankSetup,
                       const search::fef::Properties &rankProperties,
-                      const search::fef::Properties &featureOverrides);
+                      const search::fef::Properties &featureOverrides,
+                      FilterResultCache *filterCache = nullptr,
+                      uint64_t filterCacheGeneration = 0);
     ~MatchToolsFactory();
     bool valid() const { return _valid; }
     const MaybeMatchPhaseLimiter &match_limiter() const { return *_match_limiter; }
+    /**
+     * Limits matching of a query sorted on the given (fast-search)
+     * attribute to about max_hits hits taken in attribute order. Does
+     * nothing if match phase limiting is already configured.
+     **/
+    void limit_sorted_query(uint32_t docIdLimit, search::queryeval::Searchable &searchable_attributes,
+                            const vespalib::string &attribute, bool ascending, size_t max_hits);
     MatchTools::UP createMatchTools() const;
     search::queryeval::Blueprint::HitEstimate estimate() const { return _query.estimate(); }
     bool has_first_phase_rank() const { return !_rankSetup.getFirstPhaseRank().empty(); }
+    double blueprint_creation_time() const { return _blueprint_creation_time_s; }
+    double posting_fetch_time() const { return _posting_fetch_time_s; }
 };
 
 }
@@ -7,19 +7,23 @@
 #include "match_params.h"
 #include "matcher.h"
 #include "sessionmanager.h"
+#include "query_result_cache.h"
 #include <vespa/searchcore/grouping/groupingcontext.h>
+#include <vespa/searchlib/common/mapnames.h>
 #include <vespa/searchlib/engine/errorcodes.h>
 #include <vespa/searchlib/engine/docsumrequest.h>
 #include <vespa/searchlib/engine/searchrequest.h>
 #include <vespa/searchlib/engine/searchreply.h>
 #include <vespa/searchlib/features/setup.h>
 #include <vespa/searchlib/fef/test/plugin/setup.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.matcher");
 
 using search::fef::Properties;
 using namespace search::fef::indexproperties::matching;
+using search::fef::indexproperties::matchphase::SortedEarlyTermination;
 using namespace search::engine;
 using namespace search::grouping;
 using search::DocumentMetaData;
@@ -65,10 +69,33 @@ findFeatureSet(const DocsumRequest &req, MatchToolsFactory &mtf, bool summaryFea
     return MatchMaster::getFeatureSet(mtf, docs, summaryFeatures);
 }
 
+void
+traceCost(const MatchingStats &stats, Properties &trace)
+{
+    trace.add("cost.blueprint_creation_time", vespalib::make_string("%f", stats.blueprintCreationTimeAvg()));
+    trace.add("cost.posting_fetch_time", vespalib::make_string("%f", stats.postingFetchTimeAvg()));
+    trace.add("cost.query_latency", vespalib::make_string("%f", stats.queryLatencyAvg()));
+    trace.add("cost.cpu_time", vespalib::make_string("%f", stats.queryCpuTimeAvg()));
+    trace.add("cost.allocated_bytes", vespalib::make_string("%.0f", stats.queryAllocatedBytesAvg()));
+    for (size_t i = 0; i < stats.getNumPartitions(); ++i) {
+        const MatchingStats::Partition &partition = stats.getPartition(i);
+        vespalib::string prefix = vespalib::make_string("cost.thread.%zu.", i);
+        trace.add(prefix + "cpu_time", vespalib::make_string("%f", partition.cpu_time_avg()));
+        trace.add(prefix + "first_phase_time", vespalib::make_string("%f", partition.first_phase_time_avg()));
+        trace.add(prefix + "second_phase_time", vespalib::make_string("%f", partition.second_phase_time_avg()));
+        trace.add(prefix + "allocated_bytes", vespalib::make_string("%.0f", partition.allocated_bytes_avg()));
+    }
+}
+
 size_t numThreads(size_t hits, size_t minHits) {
     return static_cast<size_t>(std::ceil(double(hits) / double(minHits)));
 }
 
+// Smallest estimated single thread match time worth the coordination of another thread.
+constexpr double minSecondsPerThread = 0.001;
+// Queries matching fewer docs are too dominated by fixed costs to tell the cost per hit.
+constexpr size_t minDocsMatchedForCost = 1000;
+
 class LimitedThreadBundleWrapper final : public vespalib::ThreadBundle
 {
 public:
@@ -85,6 +112,40 @@ private:
     const uint32_t          _maxThreads;
 };
 
+/**
+ * Returns the attribute a sort spec orders on if it is a single
+ * single-value fast-search numeric attribute, or "" otherwise.
+ **/
+vespalib::string
+singleSortAttribute(const vespalib::string &sortSpec, IAttributeContext &attrContext, bool &ascending)
+{
+    size_t start = 0;
+    size_t end = sortSpec.size();
+    while ((start < end) && (sortSpec[start] == ' ')) {
+        ++start;
+    }
+    while ((end > start) && (sortSpec[end - 1] == ' ')) {
+        --end;
+    }
+    if (((end - start) < 2) || ((sortSpec[start] != '+') && (sortSpec[start] != '-'))) {
+        return "";
+    }
+    vespalib::string name = sortSpec.substr(start + 1, end - start - 1);
+    for (char c : name) {
+        if ((c == ' ') || (c == '(') || (c == '[')) { // several specs, sort functions or [rank]/[docid]
+            return "";
+        }
+    }
+    const search::attribute::IAttributeVector *attr = attrContext.getAttribute(name);
+    if ((attr == nullptr) || attr->hasMultiValue() || !attr->getIsFastSearch() ||
+        !(attr->isIntegerType() || attr->isFloatingPointType()))
+    {
+        return "";
+    }
+    ascending = (sortSpec[start] == '+');
+    return name;
+}
+
 bool willNotNeedRanking(const SearchRequest & request, const GroupingContext & groupingContext) {
     return (!groupingContext.needRanking() && (request.maxhits == 0))
            || (!request.sortSpec.empty() && (request.sortSpec.find("[rank]") == vespalib::string::npos));
@@ -98,9 +159,10 @@ Matcher::getFeatureSet(const DocsumRequest & req, ISearchContext & searchCtx, IA
 {
     SessionId sessionId(&req.sessionId[0], req.sessionId.size());
     if (!sessionId.empty()) {
+        // the session may also have been kept implicitly, without the query asking for it
         const Properties &cache_props = req.propertiesMap.cacheProperties();
         bool searchSessionCached = cache_props.lookup("query").found();
-        if (searchSessionCached) {
+        if (searchSessionCached || sessionMgr.cachesImplicitSearchSessions()) {
             SearchSession::SP session(sessionMgr.pickSearch(sessionId));
             if (session.get()) {
                 MatchToolsFactory &mtf = session->getMatchToolsFactory();
@@ -130,9 +192,11 @@ Matcher::Matcher(const search::index::Schema &schema, const Properties &props, c
       _viewResolver(ViewResolver::createFromSchema(schema)),
       _statsLock(),
       _stats(),
+      _hotMetrics(),
       _clock(clock),
       _queryLimiter(queryLimiter),
-      _distributionKey(distributionKey)
+      _distributionKey(distributionKey),
+      _secondsPerHit(0.0)
 {
     search::features::setup_search_features(_blueprintFactory);
     search::fef::test::setup_fef_test_plugin(_blueprintFactory);
@@ -143,6 +207,15 @@ Matcher::Matcher(const search::index::Schema &schema, const Properties &props, c
     }
 }
 
+Matcher::HotMetrics::HotMetrics()
+    : queryLatency(std::make_shared<vespalib::ShardedHistogram>()),
+      docsMatched(std::make_shared<vespalib::ShardedCounter>()),
+      docsRanked(std::make_shared<vespalib::ShardedCounter>())
+{
+}
+
+Matcher::HotMetrics::~HotMetrics() = default;
+
 MatchingStats
 Matcher::getStats()
 {
@@ -159,7 +232,8 @@ using search::fef::indexproperties::softtimeout::Factor;
 std::unique_ptr<MatchToolsFactory>
 Matcher::create_match_tools_factory(const search::engine::Request &request, ISearchContext &searchContext,
                                     IAttributeContext &attrContext, const search::IDocumentMetaStore &metaStore,
-                                    const Properties &feature_overrides) const
+                                    const Properties &feature_overrides, FilterResultCache *filterCache,
+                                    uint64_t filterCacheGeneration) const
 {
     const Properties & rankProperties = request.propertiesMap.rankProperties();
     bool softTimeoutEnabled = Enabled::lookup(rankProperties, _rankSetup->getSoftTimeoutEnabled());
@@ -175,7 +249,8 @@ Matcher::create_match_tools_factory(const search::engine::Request &request, ISea
     return std::make_unique<MatchToolsFactory>(_queryLimiter, vespalib::Doom(_clock, safeDoom),
                                                vespalib::Doom(_clock, request.getTimeOfDoom()), searchContext,
                                                attrContext, request.getStackRef(), request.location, _viewResolver,
-                                               metaStore, _indexEnv, *_rankSetup, rankProperties, feature_overrides);
+                                               metaStore, _indexEnv, *_rankSetup, rankProperties, feature_overrides,
+                                               filterCache, filterCacheGeneration);
 }
 
 SearchReply::UP
@@ -198,9 +273,30 @@ Matcher::computeNumThreadsPerSearch(Blueprint::HitEstimate hits, const Propertie
     if ((threads > 1) && (minHitsPerThread > 0)) {
         threads = (hits.empty) ? 1 : std::min(threads, numThreads(hits.estHits, minHitsPerThread));
     }
+    if ((threads > 1) && (_secondsPerHit.load(std::memory_order_relaxed) > 0.0)) {
+        size_t costThreads = static_cast<size_t>(estimateCost(hits) / minSecondsPerThread);
+        threads = std::min(threads, std::max(size_t(1), costThreads));
+    }
     return threads;
 }
 
+double
+Matcher::estimateCost(Blueprint::HitEstimate hits) const
+{
+    return (hits.empty) ? 0.0 : hits.estHits * _secondsPerHit.load(std::memory_order_relaxed);
+}
+
+void
+Matcher::updateSecondsPerHit(const MatchingStats &stats, size_t numThreads)
+{
+    if (stats.docsMatched() < minDocsMatchedForCost) {
+        return;
+    }
+    double sample = (stats.queryLatencyAvg() * numThreads) / stats.docsMatched();
+    double old = _secondsPerHit.load(std::memory_order_relaxed);
+    _secondsPerHit.store((old > 0.0) ? (0.9 * old + 0.1 * sample) : sample, std::memory_order_relaxed);
+}
+
 SearchReply::UP
 Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundle,
                ISearchContext &searchContext, IAttributeContext &attrContext,
@@ -218,10 +314,18 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
         SessionId sessionId(&request.sessionId[0], request.sessionId.size());
         bool shouldCacheSearchSession = false;
         bool shouldCacheGroupingSession = false;
+        bool implicitSearchSession = false;
         if (!sessionId.empty()) {
             const Properties &cache_props = request.propertiesMap.cacheProperties();
             shouldCacheGroupingSession = cache_props.lookup("grouping").found();
             shouldCacheSearchSession = cache_props.lookup("query").found();
+            if (!shouldCacheSearchSession && sessionMgr.cachesImplicitSearchSessions() &&
+                !_rankSetup->getSummaryFeatures().empty())
+            {
+                // the docsum request computing summary features can reuse this setup
+                shouldCacheSearchSession = true;
+                implicitSearchSession = true;
+            }
             if (shouldCacheGroupingSession) {
                 GroupingSession::UP session(sessionMgr.pickGrouping(sessionId));
                 if (session.get()) {
@@ -229,35 +333,96 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
                 }
             }
         }
+        bool shouldTraceCost = TraceCost::lookup(request.propertiesMap.rankProperties());
+        QueryResultCache &resultCache = sessionMgr.getResultCache();
+        bool useResultCache = (resultCache.enabled() && sessionId.empty() && request.groupSpec.empty() &&
+                               !shouldTraceCost);
+        vespalib::string cacheKey;
+        uint64_t cacheGeneration = 0;
+        if (useResultCache) {
+            cacheKey = QueryResultCache::makeKey(request);
+            cacheGeneration = resultCache.getGeneration();
+            if (resultCache.lookup(cacheKey, *reply)) {
+                my_stats.queries(1).cache_hits(1);
+                std::lock_guard<std::mutex> guard(_statsLock);
+                _stats.add(my_stats);
+                return reply;
+            }
+            my_stats.cache_misses(1);
+        }
         const Properties *feature_overrides = &request.propertiesMap.featureOverrides();
         if (shouldCacheSearchSession) {
             owned_objects.feature_overrides.reset(new Properties(*feature_overrides));
             feature_overrides = owned_objects.feature_overrides.get();
         }
+        // filter subtree results may be reused across queries under the same rules as full
+        // results, while attribute term results are versioned by the attribute itself
+        FilterResultCache *filterCache = nullptr;
+        if (sessionMgr.getFilterCache().enabled() && !shouldTraceCost) {
+            filterCache = &sessionMgr.getFilterCache();
+        }
+        uint64_t filterCacheGeneration = resultCache.enabled()
+                                         ? resultCache.getGeneration()
+                                         : FilterResultCache::NO_GENERATION;
         MatchToolsFactory::UP mtf = create_match_tools_factory(request, searchContext, attrContext,
-                                                               metaStore, *feature_overrides);
+                                                               metaStore, *feature_overrides,
+                                                               filterCache, filterCacheGeneration);
         if (!mtf->valid()) {
             reply->errorCode = ECODE_QUERY_PARSE_ERROR;
             reply->errorMessage = "query execution failed (invalid query)";
             return reply;
         }
 
-        MatchParams params(searchContext.getDocIdLimit(), _rankSetup->getHeapSize(), _rankSetup->getArraySize(),
+        const Properties & rankProperties = request.propertiesMap.rankProperties();
+        if (request.groupSpec.empty() &&
+            SortedEarlyTermination::lookup(rankProperties, SortedEarlyTermination::lookup(_indexEnv.getProperties())))
+        {
+            bool ascending = true;
+            vespalib::string sortAttribute = singleSortAttribute(request.sortSpec, attrContext, ascending);
+            if (!sortAttribute.empty()) {
+                mtf->limit_sorted_query(metaStore.getCommittedDocIdLimit(), searchContext.getAttributes(),
+                                        sortAttribute, ascending, request.offset + request.maxhits);
+            }
+        }
+
+        // Shed load up front rather than letting every query time out when the node is overloaded
+        QueryLimiter::Admission::UP admission = _queryLimiter.admit(estimateCost(mtf->estimate()),
+                                                                    request.getTimeLeft().sec());
+        if (admission->rejected()) {
+            reply->errorCode = ECODE_OVERLOADED;
+            reply->errorMessage = "query rejected, no cpu left for it before timeout";
+            return reply;
+        }
+        uint32_t docIdLimit = searchContext.getDocIdLimit();
+        double admission_coverage = admission->coverage();
+        bool admissionLimited = (admission_coverage < 1.0);
+        if (admissionLimited) {
+            docIdLimit = std::max(static_cast<uint32_t>(docIdLimit * admission_coverage), 1u);
+        }
+        MatchParams params(docIdLimit, _rankSetup->getHeapSize(), _rankSetup->getArraySize(),
                            _rankSetup->getRankScoreDropLimit(), request.offset, request.maxhits,
                            !_rankSetup->getSecondPhaseRank().empty(), !willNotNeedRanking(request, groupingContext));
 
         ResultProcessor rp(attrContext, metaStore, sessionMgr, groupingContext, sessionId,
                            request.sortSpec, params.offset, params.hits, request.should_drop_sort_data());
 
-        const Properties & rankProperties = request.propertiesMap.rankProperties();
-        size_t numThreadsPerSearch = computeNumThreadsPerSearch(mtf->estimate(), rankProperties);
+        // Cheap queries ask for few threads, and all queries share a limited number of match threads.
+        size_t wantedThreads = computeNumThreadsPerSearch(mtf->estimate(), rankProperties);
+        QueryLimiter::ThreadReservation::UP matchThreads = _queryLimiter.reserveMatchThreads(
+                std::min(wantedThreads, threadBundle.size()));
+        size_t numThreadsPerSearch = matchThreads->size();
         LimitedThreadBundleWrapper limitedThreadBundle(threadBundle, numThreadsPerSearch);
         MatchMaster master;
         uint32_t numSearchPartitions = NumSearchPartitions::lookup(rankProperties,
                                                                    _rankSetup->getNumSearchPartitions());
+        bool workStealing = WorkStealing::lookup(rankProperties, _rankSetup->getWorkStealing());
         ResultProcessor::Result::UP result = master.match(params, limitedThreadBundle, *mtf, rp,
-                                                          _distributionKey, numSearchPartitions);
+                                                          _distributionKey, numSearchPartitions,
+                                                          workStealing);
         my_stats = MatchMaster::getStats(std::move(master));
+        matchThreads.reset();
+        admission.reset();
+        updateSecondsPerHit(my_stats, numThreadsPerSearch);
 
         bool wasLimited = mtf->match_limiter().was_limited();
         size_t spaceEstimate = (my_stats.softDoomed())
@@ -268,9 +433,16 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
             SearchSession::SP session = std::make_shared<SearchSession>(sessionId, request.getTimeOfDoom(),
                                                                         std::move(mtf), std::move(owned_objects));
             session->releaseEnumGuards();
-            sessionMgr.insert(std::move(session));
+            if (implicitSearchSession) {
+                sessionMgr.insertImplicit(std::move(session));
+            } else {
+                sessionMgr.insert(std::move(session));
+            }
         }
         reply = std::move(result->_reply);
+        if (shouldTraceCost) {
+            traceCost(my_stats, reply->propertiesMap.lookupCreate(search::MapNames::TRACE));
+        }
 
         uint32_t numActiveLids = metaStore.getNumActiveLids();
         // note: this is actually totalSpace+1, since 0 is reserved
@@ -278,6 +450,9 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
         LOG(debug, "docid limit = %d", totalSpace);
         LOG(debug, "num active lids = %d", numActiveLids);
         LOG(debug, "space Estimate = %zd", spaceEstimate);
+        if (admissionLimited) {
+            spaceEstimate = std::min(spaceEstimate, size_t(params.numDocs));
+        }
         if (spaceEstimate >= totalSpace) {
             // estimate is too high, clamp it
             spaceEstimate = totalSpace;
@@ -297,16 +472,26 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
             coverage.degradeMatchPhase();
             LOG(debug, "was limited, degraded from match phase");
         }
+        if (admissionLimited) {
+            coverage.degradeAdaptiveTimeout();
+            LOG(debug, "admitted with reduced coverage %1.3f", admission_coverage);
+        }
         if (my_stats.softDoomed()) {
             coverage.degradeTimeout();
             LOG(debug, "soft doomed, degraded from timeout covered = %lu", coverage.getCovered());
         }
-        LOG(debug, "numThreadsPerSearch = %zu. Configured = %d, estimated hits=%d, totalHits=%ld , rankprofile=%s",
-            numThreadsPerSearch, _rankSetup->getNumThreadsPerSearch(), estHits, reply->totalHitCount,
+        LOG(debug, "numThreadsPerSearch = %zu. Wanted = %zu, configured = %d, estimated hits=%d, totalHits=%ld , rankprofile=%s",
+            numThreadsPerSearch, wantedThreads, _rankSetup->getNumThreadsPerSearch(), estHits, reply->totalHitCount,
             request.ranking.c_str());
+        if (useResultCache && !my_stats.softDoomed() && (reply->errorCode == 0)) {
+            resultCache.insert(cacheKey, cacheGeneration, *reply);
+        }
     }
     total_matching_time.stop();
     my_stats.queryCollateralTime(total_matching_time.elapsed().sec() - my_stats.queryLatencyAvg());
+    _hotMetrics.queryLatency->record(total_matching_time.elapsed().us());
+    _hotMetrics.docsMatched->add(my_stats.docsMatched());
+    _hotMetrics.docsRanked->add(my_stats.docsRanked());
     {
         fastos::TimeStamp softLimit = uint64_t((1.0 - _rankSetup->getSoftTimeoutTailCost()) * request.getTimeout());
         fastos::TimeStamp duration = request.getTimeUsed();
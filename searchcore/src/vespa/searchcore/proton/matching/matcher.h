@@ -15,7 +15,10 @@
 #include <vespa/searchlib/query/base.h>
 #include <vespa/vespalib/util/clock.h>
 #include <vespa/vespalib/util/closure.h>
+#include <vespa/vespalib/util/sharded_counter.h>
+#include <vespa/vespalib/util/sharded_histogram.h>
 #include <vespa/vespalib/util/thread_bundle.h>
+#include <atomic>
 #include <mutex>
 
 namespace search::grouping {
@@ -36,6 +39,7 @@ namespace proton::matching {
 
 class ISearchContext;
 class SessionManager;
+class FilterResultCache;
 class MatchToolsFactory;
 
 /**
@@ -43,6 +47,19 @@ class MatchToolsFactory;
  **/
 class Matcher
 {
+public:
+    /**
+     * Cumulative metrics updated by every query without taking the
+     * stats lock. These are never reset, and are meant to be attached
+     * to a metrics manager.
+     **/
+    struct HotMetrics {
+        std::shared_ptr<vespalib::ShardedHistogram> queryLatency; // microseconds
+        std::shared_ptr<vespalib::ShardedCounter>   docsMatched;
+        std::shared_ptr<vespalib::ShardedCounter>   docsRanked;
+        HotMetrics();
+        ~HotMetrics();
+    };
 private:
     IndexEnvironment              _indexEnv;
     search::fef::BlueprintFactory _blueprintFactory;
@@ -50,9 +67,11 @@ private:
     ViewResolver                  _viewResolver;
     std::mutex                    _statsLock;
     MatchingStats                 _stats;
+    HotMetrics                    _hotMetrics;
     const vespalib::Clock        &_clock;
     QueryLimiter                 &_queryLimiter;
     uint32_t                      _distributionKey;
+    std::atomic<double>           _secondsPerHit; // smoothed single thread cost per matched doc, 0 if unknown
 
     search::FeatureSet::SP
     getFeatureSet(const search::engine::DocsumRequest & req, ISearchContext & searchCtx,
@@ -65,6 +84,8 @@ private:
 
     size_t computeNumThreadsPerSearch(search::queryeval::Blueprint::HitEstimate hits,
                                       const search::fef::Properties & rankProperties) const;
+    double estimateCost(search::queryeval::Blueprint::HitEstimate hits) const;
+    void updateSecondsPerHit(const MatchingStats &stats, size_t numThreads);
 public:
     /**
      * Convenience typedefs.
@@ -97,6 +118,8 @@ public:
      **/
     MatchingStats getStats();
 
+    const HotMetrics &getHotMetrics() const { return _hotMetrics; }
+
     /**
      * Create the low-level tools needed to perform matching. This
      * function is exposed for testing purposes.
@@ -105,7 +128,9 @@ public:
     create_match_tools_factory(const search::engine::Request &request, ISearchContext &searchContext,
                                search::attribute::IAttributeContext &attrContext,
                                const search::IDocumentMetaStore &metaStore,
-                               const search::fef::Properties &feature_overrides) const;
+                               const search::fef::Properties &feature_overrides,
+                               FilterResultCache *filterCache = nullptr,
+                               uint64_t filterCacheGeneration = 0) const;
 
     /**
      * Perform a search against this matcher.
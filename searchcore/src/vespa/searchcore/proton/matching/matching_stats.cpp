@@ -18,17 +18,25 @@ MatchingStats::Partition &get_writable_partition(std::vector<MatchingStats::Part
 MatchingStats::MatchingStats()
     : _queries(0),
       _limited_queries(0),
+      _cache_hits(0),
+      _cache_misses(0),
       _docidSpaceCovered(0),
       _docsMatched(0),
       _docsRanked(0),
       _docsReRanked(0),
       _softDoomed(0),
+      _steals(0),
       _softDoomFactor(0.5),
       _queryCollateralTime(),
       _queryLatency(),
       _matchTime(),
       _groupingTime(),
       _rerankTime(),
+      _blueprintCreationTime(),
+      _postingFetchTime(),
+      _limiterSetupTime(),
+      _queryCpuTime(),
+      _queryAllocatedBytes(),
       _partitions()
 { }
 
@@ -43,6 +51,7 @@ MatchingStats::merge_partition(const Partition &partition, size_t id)
     _docsMatched += partition.docsMatched();
     _docsRanked += partition.docsRanked();
     _docsReRanked += partition.docsReRanked();
+    _steals += partition.steals();
     if (partition.softDoomed()) {
         _softDoomed = 1;
     }
@@ -55,18 +64,26 @@ MatchingStats::add(const MatchingStats &rhs)
 {
     _queries += rhs._queries;
     _limited_queries += rhs._limited_queries;
+    _cache_hits += rhs._cache_hits;
+    _cache_misses += rhs._cache_misses;
 
     _docidSpaceCovered += rhs._docidSpaceCovered;
     _docsMatched += rhs._docsMatched;
     _docsRanked += rhs._docsRanked;
     _docsReRanked += rhs._docsReRanked;
     _softDoomed += rhs.softDoomed();
+    _steals += rhs._steals;
 
     _queryCollateralTime.add(rhs._queryCollateralTime);
     _queryLatency.add(rhs._queryLatency);
     _matchTime.add(rhs._matchTime);
     _groupingTime.add(rhs._groupingTime);
     _rerankTime.add(rhs._rerankTime);
+    _blueprintCreationTime.add(rhs._blueprintCreationTime);
+    _postingFetchTime.add(rhs._postingFetchTime);
+    _limiterSetupTime.add(rhs._limiterSetupTime);
+    _queryCpuTime.add(rhs._queryCpuTime);
+    _queryAllocatedBytes.add(rhs._queryAllocatedBytes);
     for (size_t id = 0; id < rhs.getNumPartitions(); ++id) {
         get_writable_partition(_partitions, id).add(rhs.getPartition(id));
     }
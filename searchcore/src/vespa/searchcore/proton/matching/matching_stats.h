@@ -60,8 +60,13 @@ public:
         size_t _docsRanked;
         size_t _docsReRanked;
         size_t _softDoomed;
+        size_t _steals;
         Avg    _active_time;
         Avg    _wait_time;
+        Avg    _cpu_time;
+        Avg    _first_phase_time;
+        Avg    _second_phase_time;
+        Avg    _allocated_bytes;
     public:
         Partition()
             : _docsCovered(0),
@@ -69,8 +74,13 @@ public:
               _docsRanked(0),
               _docsReRanked(0),
               _softDoomed(0),
+              _steals(0),
               _active_time(),
-              _wait_time() { }
+              _wait_time(),
+              _cpu_time(),
+              _first_phase_time(),
+              _second_phase_time(),
+              _allocated_bytes() { }
 
         Partition &docsCovered(size_t value) { _docsCovered = value; return *this; }
         size_t docsCovered() const { return _docsCovered; }
@@ -82,6 +92,8 @@ public:
         size_t docsReRanked() const { return _docsReRanked; }
         Partition &softDoomed(bool v) { _softDoomed += v ? 1 : 0; return *this; }
         size_t softDoomed() const { return _softDoomed; }
+        Partition &steals(size_t value) { _steals = value; return *this; }
+        size_t steals() const { return _steals; }
 
         Partition &active_time(double time_s) { _active_time.set(time_s); return *this; }
         double active_time_avg() const { return _active_time.avg(); }
@@ -93,6 +105,26 @@ public:
         size_t wait_time_count() const { return _wait_time.count(); }
         double wait_time_min() const { return _wait_time.min(); }
         double wait_time_max() const { return _wait_time.max(); }
+        Partition &cpu_time(double time_s) { _cpu_time.set(time_s); return *this; }
+        double cpu_time_avg() const { return _cpu_time.avg(); }
+        size_t cpu_time_count() const { return _cpu_time.count(); }
+        double cpu_time_min() const { return _cpu_time.min(); }
+        double cpu_time_max() const { return _cpu_time.max(); }
+        Partition &first_phase_time(double time_s) { _first_phase_time.set(time_s); return *this; }
+        double first_phase_time_avg() const { return _first_phase_time.avg(); }
+        size_t first_phase_time_count() const { return _first_phase_time.count(); }
+        double first_phase_time_min() const { return _first_phase_time.min(); }
+        double first_phase_time_max() const { return _first_phase_time.max(); }
+        Partition &second_phase_time(double time_s) { _second_phase_time.set(time_s); return *this; }
+        double second_phase_time_avg() const { return _second_phase_time.avg(); }
+        size_t second_phase_time_count() const { return _second_phase_time.count(); }
+        double second_phase_time_min() const { return _second_phase_time.min(); }
+        double second_phase_time_max() const { return _second_phase_time.max(); }
+        Partition &allocated_bytes(double bytes) { _allocated_bytes.set(bytes); return *this; }
+        double allocated_bytes_avg() const { return _allocated_bytes.avg(); }
+        size_t allocated_bytes_count() const { return _allocated_bytes.count(); }
+        double allocated_bytes_min() const { return _allocated_bytes.min(); }
+        double allocated_bytes_max() const { return _allocated_bytes.max(); }
 
         Partition &add(const Partition &rhs) {
             _docsCovered += rhs.docsCovered();
@@ -100,9 +132,14 @@ public:
             _docsRanked += rhs._docsRanked;
             _docsReRanked += rhs._docsReRanked;
             _softDoomed += rhs._softDoomed;
+            _steals += rhs._steals;
 
             _active_time.add(rhs._active_time);
             _wait_time.add(rhs._wait_time);
+            _cpu_time.add(rhs._cpu_time);
+            _first_phase_time.add(rhs._first_phase_time);
+            _second_phase_time.add(rhs._second_phase_time);
+            _allocated_bytes.add(rhs._allocated_bytes);
             return *this;
         }
     };
@@ -110,17 +147,25 @@ public:
 private:
     size_t                 _queries;
     size_t                 _limited_queries;
+    size_t                 _cache_hits;
+    size_t                 _cache_misses;
     size_t                 _docidSpaceCovered;
     size_t                 _docsMatched;
     size_t                 _docsRanked;
     size_t                 _docsReRanked;
     size_t                 _softDoomed;
+    size_t                 _steals;
     double                 _softDoomFactor;
     Avg                    _queryCollateralTime;
     Avg                    _queryLatency;
     Avg                    _matchTime;
     Avg                    _groupingTime;
     Avg                    _rerankTime;
+    Avg                    _blueprintCreationTime;
+    Avg                    _postingFetchTime;
+    Avg                    _limiterSetupTime;
+    Avg                    _queryCpuTime;
+    Avg                    _queryAllocatedBytes;
     std::vector<Partition> _partitions;
 
 public:
@@ -137,6 +182,12 @@ public:
     MatchingStats &limited_queries(size_t value) { _limited_queries = value; return *this; }
     size_t limited_queries() const { return _limited_queries; }
 
+    MatchingStats &cache_hits(size_t value) { _cache_hits = value; return *this; }
+    size_t cache_hits() const { return _cache_hits; }
+
+    MatchingStats &cache_misses(size_t value) { _cache_misses = value; return *this; }
+    size_t cache_misses() const { return _cache_misses; }
+
     MatchingStats &docidSpaceCovered(size_t value) { _docidSpaceCovered = value; return *this; }
     size_t docidSpaceCovered() const { return _docidSpaceCovered; }
 
@@ -151,6 +202,9 @@ public:
 
     MatchingStats &softDoomed(size_t value) { _softDoomed = value; return *this; }
     size_t softDoomed() const { return _softDoomed; }
+    MatchingStats &steals(size_t value) { _steals = value; return *this; }
+    size_t steals() const { return _steals; }
+
     MatchingStats &softDoomFactor(double value) { _softDoomFactor = value; return *this; }
     double softDoomFactor() const { return _softDoomFactor; }
     MatchingStats &updatesoftDoomFactor(double hardLimit, double softLimit, double duration);
@@ -185,6 +239,36 @@ public:
     double rerankTimeMin() const { return _rerankTime.min(); }
     double rerankTimeMax() const { return _rerankTime.max(); }
 
+    MatchingStats &blueprintCreationTime(double time_s) { _blueprintCreationTime.set(time_s); return *this; }
+    double blueprintCreationTimeAvg() const { return _blueprintCreationTime.avg(); }
+    size_t blueprintCreationTimeCount() const { return _blueprintCreationTime.count(); }
+    double blueprintCreationTimeMin() const { return _blueprintCreationTime.min(); }
+    double blueprintCreationTimeMax() const { return _blueprintCreationTime.max(); }
+
+    MatchingStats &postingFetchTime(double time_s) { _postingFetchTime.set(time_s); return *this; }
+    double postingFetchTimeAvg() const { return _postingFetchTime.avg(); }
+    size_t postingFetchTimeCount() const { return _postingFetchTime.count(); }
+    double postingFetchTimeMin() const { return _postingFetchTime.min(); }
+    double postingFetchTimeMax() const { return _postingFetchTime.max(); }
+
+    MatchingStats &limiterSetupTime(double time_s) { _limiterSetupTime.set(time_s); return *this; }
+    double limiterSetupTimeAvg() const { return _limiterSetupTime.avg(); }
+    size_t limiterSetupTimeCount() const { return _limiterSetupTime.count(); }
+    double limiterSetupTimeMin() const { return _limiterSetupTime.min(); }
+    double limiterSetupTimeMax() const { return _limiterSetupTime.max(); }
+
+    MatchingStats &queryCpuTime(double time_s) { _queryCpuTime.set(time_s); return *this; }
+    double queryCpuTimeAvg() const { return _queryCpuTime.avg(); }
+    size_t queryCpuTimeCount() const { return _queryCpuTime.count(); }
+    double queryCpuTimeMin() const { return _queryCpuTime.min(); }
+    double queryCpuTimeMax() const { return _queryCpuTime.max(); }
+
+    MatchingStats &queryAllocatedBytes(double bytes) { _queryAllocatedBytes.set(bytes); return *this; }
+    double queryAllocatedBytesAvg() const { return _queryAllocatedBytes.avg(); }
+    size_t queryAllocatedBytesCount() const { return _queryAllocatedBytes.count(); }
+    double queryAllocatedBytesMin() const { return _queryAllocatedBytes.min(); }
+    double queryAllocatedBytesMax() const { return _queryAllocatedBytes.max(); }
+
     // used to merge in stats from each match thread
     MatchingStats &merge_partition(const Partition &partition, size_t id);
     size_t getNumPartitions() const { return _partitions.size(); }
@@ -6,12 +6,16 @@
 #include "resolveviewvisitor.h"
 #include "termdataextractor.h"
 #include "sameelementmodifier.h"
+#include "cached_filter.h"
 #include <vespa/document/datatype/positiondatatype.h>
 #include <vespa/searchlib/common/location.h>
+#include <vespa/searchlib/common/bitvector.h>
 #include <vespa/searchlib/parsequery/stackdumpiterator.h>
 #include <vespa/searchlib/query/tree/point.h>
 #include <vespa/searchlib/query/tree/rectangle.h>
+#include <vespa/searchlib/query/tree/templatetermvisitor.h>
 #include <vespa/searchlib/queryeval/intermediate_blueprints.h>
+#include <vespa/searchlib/queryeval/hit_estimate_sampler.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.matching.query");
@@ -26,9 +30,11 @@ using search::fef::MatchDataLayout;
 using search::fef::Location;
 using search::query::Node;
 using search::query::QueryTreeCreator;
+using search::query::TemplateTermVisitor;
 using search::query::Weight;
 using search::queryeval::AndBlueprint;
 using search::queryeval::Blueprint;
+using search::queryeval::HitEstimateSampler;
 using search::queryeval::IRequestContext;
 using search::queryeval::SearchIterator;
 using vespalib::string;
@@ -73,9 +79,50 @@ void AddLocationNode(const string &location_str, Node::UP &query_tree, Location
     }
     query_tree = std::move(new_base);
 }
+
+/**
+ * Checks that a subtree only holds unranked terms and no operators
+ * whose matches depend on scoring, so it can be replaced by the set
+ * of documents it matches.
+ **/
+class FilterDetector : public TemplateTermVisitor<FilterDetector, ProtonNodeTypes>
+{
+public:
+    bool is_filter = true;
+
+    template <class TermType>
+    void visitTerm(TermType &n) {
+        if (n.isRanked()) {
+            is_filter = false;
+        }
+    }
+
+    void visit(ProtonNodeTypes::Equiv &) override { is_filter = false; }
+    void visit(ProtonNodeTypes::SameElement &) override { is_filter = false; }
+    void visit(ProtonNodeTypes::WeakAnd &) override { is_filter = false; }
+    void visit(ProtonNodeTypes::WandTerm &) override { is_filter = false; }
+    void visit(ProtonNodeTypes::NearestNeighborTerm &) override { is_filter = false; }
+    void visit(ProtonNodeTypes::PredicateQuery &) override { is_filter = false; }
+};
+
+bool isFilter(Node &node) {
+    FilterDetector detector;
+    node.accept(detector);
+    return detector.is_filter;
+}
+
 }  // namespace
 
-Query::Query() = default;
+Query::Query()
+    : _query_tree(),
+      _blueprint(),
+      _location(),
+      _whiteListBlueprint(),
+      _filterCache(nullptr),
+      _filterCacheGeneration(0)
+{
+}
+
 Query::~Query() = default;
 
 bool
@@ -116,14 +163,62 @@ Query::setWhiteListBlueprint(Blueprint::UP whiteListBlueprint)
     _whiteListBlueprint = std::move(whiteListBlueprint);
 }
 
+void
+Query::setFilterCache(FilterResultCache &filterCache, uint64_t generation)
+{
+    _filterCache = &filterCache;
+    _filterCacheGeneration = generation;
+}
+
+void
+Query::cacheFilters(ISearchContext &context, const MatchDataLayout &mdl)
+{
+    auto *root = dynamic_cast<ProtonAnd *>(_query_tree.get());
+    auto *andBlueprint = dynamic_cast<AndBlueprint *>(_blueprint.get());
+    if ((root == nullptr) || (andBlueprint == nullptr) ||
+        (root->getChildren().size() != andBlueprint->childCnt()))
+    {
+        return;
+    }
+    uint32_t docIdLimit = context.getDocIdLimit();
+    MatchData::UP md;
+    size_t numCached = 0;
+    for (size_t i = 0; i < root->getChildren().size(); ++i) {
+        Node &node = *root->getChildren()[i];
+        if (!isFilter(node)) {
+            continue;
+        }
+        vespalib::string key = createFilterKey(node);
+        FilterResultCache::BitVectorSP bits = _filterCache->lookup(key, _filterCacheGeneration);
+        Blueprint::UP filter = andBlueprint->removeChild(i);
+        if (!bits || (bits->size() != docIdLimit)) {
+            if (!md) {
+                md = mdl.createMatchData();
+            }
+            bits = evaluateFilter(*filter, *md, docIdLimit);
+            _filterCache->insert(key, _filterCacheGeneration, bits);
+        }
+        auto cached = std::make_unique<CachedFilterBlueprint>(std::move(bits));
+        cached->setDocIdLimit(docIdLimit);
+        andBlueprint->insertChild(i, std::move(cached));
+        ++numCached;
+    }
+    if (numCached > 0) {
+        LOG(debug, "blueprint after using %zu cached filters:\n%s\n", numCached, _blueprint->asString().c_str());
+    }
+}
+
 void
 Query::reserveHandles(const IRequestContext & requestContext, ISearchContext &context, MatchDataLayout &mdl)
 {
     MatchDataReserveVisitor reserve_visitor(mdl);
     _query_tree->accept(reserve_visitor);
 
-    _blueprint = BlueprintBuilder::build(requestContext, *_query_tree, context);
+    _blueprint = BlueprintBuilder::build(requestContext, *_query_tree, context, _filterCache);
     LOG(debug, "original blueprint:\n%s\n", _blueprint->asString().c_str());
+    if ((_filterCache != nullptr) && (_filterCacheGeneration != FilterResultCache::NO_GENERATION)) {
+        cacheFilters(context, mdl);
+    }
     if (_whiteListBlueprint) {
         auto andBlueprint = std::make_unique<AndBlueprint>();
         (*andBlueprint)
@@ -143,11 +238,26 @@ Query::optimize()
 }
 
 void
-Query::fetchPostings()
+Query::fetchPostings(bool sampling)
 {
+    if (sampling) {
+        HitEstimateSampler::prepare(*_blueprint);
+    }
     _blueprint->fetchPostings(true);
 }
 
+void
+Query::sampleEstimates(const MatchDataLayout &mdl, uint32_t budget)
+{
+    if (budget == 0) {
+        return;
+    }
+    MatchData::UP md = mdl.createMatchData();
+    HitEstimateSampler sampler(*md, _blueprint->get_docid_limit(), budget);
+    size_t sampled = sampler.sample(*_blueprint);
+    LOG(debug, "blueprint after sampling estimates of %zu nodes:\n%s\n", sampled, _blueprint->asString().c_str());
+}
+
 void
 Query::freeze()
 {
@@ -14,6 +14,7 @@ namespace proton::matching {
 
 class ViewResolver;
 class ISearchContext;
+class FilterResultCache;
 
 class Query
 {
@@ -23,6 +24,10 @@ private:
     Blueprint::UP           _blueprint;
     search::fef::Location   _location;
     Blueprint::UP           _whiteListBlueprint;
+    FilterResultCache      *_filterCache;
+    uint64_t                _filterCacheGeneration;
+
+    void cacheFilters(ISearchContext &context, const search::fef::MatchDataLayout &mdl);
 
 public:
     Query();
@@ -63,6 +68,20 @@ public:
      **/
     void setWhiteListBlueprint(Blueprint::UP whiteListBlueprint);
 
+    /**
+     * Use the given cache for the results of unranked children of a
+     * root AND node. Such filters are evaluated into bitvectors when
+     * reserving handles, or taken from the cache if already evaluated
+     * in the given generation. Unranked attribute terms are cached
+     * regardless of the generation given here.
+     *
+     * @param filterCache cache of filter results
+     * @param generation generation of the visible documents, or
+     *                   FilterResultCache::NO_GENERATION to only cache
+     *                   attribute terms
+     **/
+    void setFilterCache(FilterResultCache &filterCache, uint64_t generation);
+
     /**
      * Reserve room for terms in the query in the given match data
      * layout. This function also prepares the createSearch function
@@ -84,7 +103,23 @@ public:
      * test to verify the original query without optimization.
      **/
     void optimize();
-    void fetchPostings();
+
+    /**
+     * Fetch postings for the query. If sampleEstimates is to be
+     * called afterwards, sampling must be enabled here, so that
+     * postings stay valid when AND children are re-sorted.
+     **/
+    void fetchPostings(bool sampling = false);
+
+    /**
+     * Correct the hit estimates of AND children by sampling their
+     * iterators and re-sort them. Must be called after
+     * fetchPostings(true) and before freeze.
+     *
+     * @param mdl match data layout used to create a temporary match data
+     * @param budget the number of docids that may be sampled, 0 disables sampling
+     **/
+    void sampleEstimates(const search::fef::MatchDataLayout &mdl, uint32_t budget);
     void freeze();
 
     /**
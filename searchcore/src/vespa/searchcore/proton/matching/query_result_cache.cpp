@@ -0,0 +1,177 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "query_result_cache.h"
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+
+namespace proton::matching {
+
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using search::fef::IPropertiesVisitor;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace {
+
+// length prefixed to keep the key unambiguous
+void append(vespalib::string &key, vespalib::stringref value) {
+    key.append(vespalib::make_string("%zu:", value.size()));
+    key.append(value.data(), value.size());
+}
+
+struct PropertyCollector : IPropertiesVisitor {
+    std::vector<std::pair<vespalib::string, Property::Values>> props;
+    void visitProperty(const Property::Value &key, const Property &values) override {
+        Property::Values list;
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            list.push_back(values.getAt(i));
+        }
+        props.emplace_back(key, std::move(list));
+    }
+};
+
+// properties are stored in a hash map; sort them to get a canonical form
+void append(vespalib::string &key, const Properties &props) {
+    PropertyCollector collector;
+    props.visitProperties(collector);
+    std::sort(collector.props.begin(), collector.props.end(),
+              [](const auto &a, const auto &b) { return (a.first < b.first); });
+    key.append(vespalib::make_string("%zu:", collector.props.size()));
+    for (const auto &prop: collector.props) {
+        append(key, prop.first);
+        key.append(vespalib::make_string("%zu:", prop.second.size()));
+        for (const auto &value: prop.second) {
+            append(key, value);
+        }
+    }
+}
+
+} // namespace proton::matching::<unnamed>
+
+QueryResultCache::QueryResultCache(size_t maxBytes)
+    : _maxBytes(maxBytes),
+      _enabled(true),
+      _generation(0),
+      _lock(),
+      _map(),
+      _lru(),
+      _memoryUsage(0),
+      _stats()
+{
+}
+
+QueryResultCache::~QueryResultCache() {}
+
+vespalib::string
+QueryResultCache::makeKey(const SearchRequest &request)
+{
+    vespalib::string key;
+    append(key, request.ranking);
+    append(key, request.getStackRef());
+    append(key, request.location);
+    append(key, request.sortSpec);
+    key.append(vespalib::make_string("%u:%u:%u:", request.offset, request.maxhits, request.queryFlags));
+    append(key, request.propertiesMap.rankProperties());
+    append(key, request.propertiesMap.featureOverrides());
+    append(key, request.propertiesMap.matchProperties());
+    return key;
+}
+
+void
+QueryResultCache::setEnabled(bool value)
+{
+    _enabled.store(value, std::memory_order_relaxed);
+    if (!value) {
+        invalidate();
+    }
+}
+
+void
+QueryResultCache::evict(const std::lock_guard<std::mutex> &)
+{
+    while ((_memoryUsage > _maxBytes) && !_lru.empty()) {
+        auto pos = _map.find(_lru.front());
+        _memoryUsage -= pos->second.memoryUsage;
+        _map.erase(pos);
+        _lru.pop_front();
+    }
+}
+
+bool
+QueryResultCache::lookup(const vespalib::string &key, SearchReply &reply)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto pos = _map.find(key);
+    if (pos == _map.end()) {
+        ++_stats.numMisses;
+        return false;
+    }
+    ++_stats.numHits;
+    Entry &entry = pos->second;
+    _lru.splice(_lru.end(), _lru, entry.lruPos);
+    reply.offset = entry.offset;
+    reply.totalHitCount = entry.totalHitCount;
+    reply.maxRank = entry.maxRank;
+    reply.sortIndex = entry.sortIndex;
+    reply.sortData = entry.sortData;
+    reply.coverage = entry.coverage;
+    reply.useWideHits = entry.useWideHits;
+    reply.hits = entry.hits;
+    return true;
+}
+
+void
+QueryResultCache::insert(const vespalib::string &key, uint64_t generation, const SearchReply &reply)
+{
+    size_t memoryUsage = sizeof(Entry) + (2 * key.size()) +
+                         (reply.hits.size() * sizeof(SearchReply::Hit)) +
+                         (reply.sortIndex.size() * sizeof(uint32_t)) + reply.sortData.size();
+    if (!enabled() || (memoryUsage > _maxBytes)) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_lock);
+    if ((generation != getGeneration()) || (_map.find(key) != _map.end())) {
+        return;
+    }
+    Entry &entry = _map[key];
+    entry.offset = reply.offset;
+    entry.totalHitCount = reply.totalHitCount;
+    entry.maxRank = reply.maxRank;
+    entry.sortIndex = reply.sortIndex;
+    entry.sortData = reply.sortData;
+    entry.coverage = reply.coverage;
+    entry.useWideHits = reply.useWideHits;
+    entry.hits = reply.hits;
+    entry.memoryUsage = memoryUsage;
+    entry.lruPos = _lru.insert(_lru.end(), key);
+    _memoryUsage += memoryUsage;
+    evict(guard);
+}
+
+void
+QueryResultCache::invalidate()
+{
+    vespalib::hash_map<vespalib::string, Entry> toDestruct;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _generation.fetch_add(1, std::memory_order_release);
+        toDestruct.swap(_map);
+        _lru.clear();
+        _memoryUsage = 0;
+    }
+}
+
+QueryResultCache::Stats
+QueryResultCache::getStats()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    Stats stats = _stats;
+    stats.numCached = _map.size();
+    stats.memoryUsage = _memoryUsage;
+    return stats;
+}
+
+}
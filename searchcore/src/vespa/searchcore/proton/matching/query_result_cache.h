@@ -0,0 +1,109 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <atomic>
+#include <list>
+#include <mutex>
+
+namespace search::engine { class SearchRequest; }
+
+namespace proton::matching {
+
+/**
+ * Cache of search replies, keyed on a canonical serialization of
+ * everything in a search request that affects its result: rank
+ * profile, query stack, location, sorting, hit window and the rank,
+ * feature and match properties. The cache is bounded by memory usage
+ * and evicts the least recently used entries first.
+ *
+ * All entries are dropped when the cache is invalidated, which must
+ * happen whenever the set of visible documents changes. A reply is
+ * only inserted if no invalidation happened after the generation it
+ * was produced in was sampled, so results computed against stale
+ * data are never cached.
+ **/
+class QueryResultCache
+{
+public:
+    struct Stats {
+        Stats() : numHits(0), numMisses(0), numCached(0), memoryUsage(0) {}
+        size_t numHits;
+        size_t numMisses;
+        size_t numCached;
+        size_t memoryUsage;
+    };
+
+private:
+    using SearchReply = search::engine::SearchReply;
+    using KeyList = std::list<vespalib::string>;
+
+    struct Entry {
+        uint32_t                      offset;
+        uint64_t                      totalHitCount;
+        search::HitRank               maxRank;
+        std::vector<uint32_t>         sortIndex;
+        std::vector<char>             sortData;
+        SearchReply::Coverage         coverage;
+        bool                          useWideHits;
+        std::vector<SearchReply::Hit> hits;
+        size_t                        memoryUsage;
+        KeyList::iterator             lruPos;
+    };
+
+    const size_t                            _maxBytes;
+    std::atomic<bool>                       _enabled;
+    std::atomic<uint64_t>                   _generation;
+    mutable std::mutex                      _lock;
+    vespalib::hash_map<vespalib::string, Entry> _map;
+    KeyList                                 _lru;
+    size_t                                  _memoryUsage;
+    Stats                                   _stats;
+
+    void evict(const std::lock_guard<std::mutex> &guard);
+
+public:
+    QueryResultCache(size_t maxBytes);
+    ~QueryResultCache();
+
+    /**
+     * Create a cache key for the given request. Requests producing
+     * the same key are guaranteed to produce the same reply as long
+     * as the visible documents do not change.
+     **/
+    static vespalib::string makeKey(const search::engine::SearchRequest &request);
+
+    bool enabled() const { return (_maxBytes > 0) && _enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool value);
+
+    /**
+     * The current generation. Sample this before producing a reply
+     * that is to be inserted into the cache.
+     **/
+    uint64_t getGeneration() const { return _generation.load(std::memory_order_acquire); }
+
+    /**
+     * Look up a cached reply and copy it into the given reply.
+     *
+     * @return true if the key was found
+     **/
+    bool lookup(const vespalib::string &key, SearchReply &reply);
+
+    /**
+     * Insert a reply produced after the given generation was sampled.
+     * The reply is dropped if the cache was invalidated since.
+     **/
+    void insert(const vespalib::string &key, uint64_t generation, const SearchReply &reply);
+
+    /**
+     * Drop all cached replies. Called when the set of visible
+     * documents changes.
+     **/
+    void invalidate();
+
+    Stats getStats();
+};
+
+}
@@ -1,5 +1,6 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "querylimiter.h"
+#include <algorithm>
 #include <chrono>
 
 namespace proton {
@@ -37,10 +38,50 @@ QueryLimiter::releaseToken()
     _cond.notify_one();
 }
 
+QueryLimiter::ThreadReservation::ThreadReservation(QueryLimiter & limiter, uint32_t threads) :
+    _limiter(limiter),
+    _threads(threads)
+{
+}
+
+QueryLimiter::ThreadReservation::~ThreadReservation()
+{
+    _limiter.releaseMatchThreads(_threads);
+}
+
+void
+QueryLimiter::releaseMatchThreads(uint32_t threads)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _activeMatchThreads -= threads;
+}
+
+QueryLimiter::Admission::Admission(QueryLimiter & limiter, double cost, double coverage) :
+    _limiter(limiter),
+    _cost(cost),
+    _coverage(coverage)
+{
+}
+
+QueryLimiter::Admission::~Admission()
+{
+    _limiter.releaseCost(_cost);
+}
+
+void
+QueryLimiter::releaseCost(double cost)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _pendingCost = std::max(_pendingCost - cost, 0.0);
+}
+
 QueryLimiter::QueryLimiter() :
     _lock(),
     _cond(),
     _activeThreads(0),
+    _activeMatchThreads(0),
+    _maxMatchThreads(0),
+    _pendingCost(0.0),
     _maxThreads(-1),
     _coverage(1.0),
     _minHits(std::numeric_limits<uint32_t>::max())
@@ -55,6 +96,55 @@ QueryLimiter::configure(int maxThreads, double coverage, uint32_t minHits)
     _minHits = minHits;
 }
 
+void
+QueryLimiter::configureMatchThreads(uint32_t maxMatchThreads)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _maxMatchThreads = maxMatchThreads;
+}
+
+QueryLimiter::ThreadReservation::UP
+QueryLimiter::reserveMatchThreads(uint32_t wanted)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    uint32_t threads = std::max(wanted, 1u);
+    if (_maxMatchThreads > 0) {
+        uint32_t available = (_activeMatchThreads < _maxMatchThreads) ? (_maxMatchThreads - _activeMatchThreads) : 0u;
+        threads = std::max(std::min(threads, available), 1u);
+    }
+    _activeMatchThreads += threads;
+    return std::make_unique<ThreadReservation>(*this, threads);
+}
+
+uint32_t
+QueryLimiter::getActiveMatchThreads() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _activeMatchThreads;
+}
+
+QueryLimiter::Admission::UP
+QueryLimiter::admit(double cost, double secondsLeft)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if ((_maxMatchThreads == 0) || !(cost > 0.0)) {
+        return std::make_unique<Admission>(*this, 0.0, 1.0);
+    }
+    // Cpu seconds left for this query when all admitted queries share the budget.
+    double available = std::max(secondsLeft, 0.0) * _maxMatchThreads - _pendingCost;
+    double coverage = std::min(std::max(available / cost, 0.0), 1.0);
+    double admittedCost = cost * coverage;
+    _pendingCost += admittedCost;
+    return std::make_unique<Admission>(*this, admittedCost, coverage);
+}
+
+double
+QueryLimiter::getPendingCost() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _pendingCost;
+}
+
 QueryLimiter::Token::UP
 QueryLimiter::getToken(const Doom & doom, uint32_t numDocs, uint32_t numHits, bool hasSorting, bool hasGrouping)
 {
@@ -20,10 +20,70 @@ public:
         typedef std::unique_ptr<Token> UP;
         virtual ~Token() { }
     };
+    /**
+     * Match threads reserved by one query from the budget shared by all
+     * queries. The threads are returned to the budget on destruction.
+     */
+    class ThreadReservation {
+    private:
+        QueryLimiter & _limiter;
+        uint32_t       _threads;
+    public:
+        typedef std::unique_ptr<ThreadReservation> UP;
+        ThreadReservation(QueryLimiter & limiter, uint32_t threads);
+        ThreadReservation(const ThreadReservation &) = delete;
+        ThreadReservation & operator = (const ThreadReservation &) = delete;
+        ~ThreadReservation();
+        uint32_t size() const { return _threads; }
+    };
+    /**
+     * Estimated cpu cost of an admitted query, counted against the cpu
+     * budget of the node until destroyed.
+     */
+    class Admission {
+    private:
+        QueryLimiter & _limiter;
+        double         _cost;
+        double         _coverage;
+    public:
+        typedef std::unique_ptr<Admission> UP;
+        Admission(QueryLimiter & limiter, double cost, double coverage);
+        Admission(const Admission &) = delete;
+        Admission & operator = (const Admission &) = delete;
+        ~Admission();
+        bool rejected() const { return _coverage <= 0.0; }
+        /** Fraction of the corpus the query is estimated to have cpu for before it times out. */
+        double coverage() const { return _coverage; }
+    };
 public:
     QueryLimiter();
     void configure(int maxThreads, double coverage, uint32_t minHits);
     Token::UP getToken(const Doom & doom, uint32_t numDocs, uint32_t numHits, bool hasSorting, bool hasGrouping);
+
+    /**
+     * Sets the number of match threads all queries may use together.
+     * 0 means no limit.
+     */
+    void configureMatchThreads(uint32_t maxMatchThreads);
+
+    /**
+     * Reserves up to the wanted number of match threads. Never blocks;
+     * when the budget is used up the query gets a single thread.
+     */
+    ThreadReservation::UP reserveMatchThreads(uint32_t wanted);
+    uint32_t getActiveMatchThreads() const;
+
+    /**
+     * Admits a query with the given estimated single thread cost in
+     * seconds. The match threads configured above are the cpu budget,
+     * shared by the estimated cost of all admitted queries still
+     * running. A query that will not get the cpu for all of its cost
+     * before the time left runs out is admitted with reduced coverage,
+     * and rejected if the cost already admitted uses up all the time.
+     * Queries of unknown cost (0) are always admitted in full.
+     */
+    Admission::UP admit(double cost, double secondsLeft);
+    double getPendingCost() const;
 private:
     class NoLimitToken : public Token {
     };
@@ -36,9 +96,14 @@ private:
     };
     void grabToken(const Doom & doom);
     void releaseToken();
-    std::mutex              _lock;
+    void releaseMatchThreads(uint32_t threads);
+    void releaseCost(double cost);
+    mutable std::mutex      _lock;
     std::condition_variable _cond;
     volatile int _activeThreads;
+    uint32_t     _activeMatchThreads;
+    uint32_t     _maxMatchThreads;
+    double       _pendingCost;
 
     // These are updated asynchronously at reconfig.
     volatile int      _maxThreads;
@@ -136,6 +136,7 @@ typedef ProtonTerm<search::query::DotProduct>      ProtonDotProduct;
 typedef ProtonTerm<search::query::WandTerm>        ProtonWandTerm;
 typedef ProtonTerm<search::query::PredicateQuery>  ProtonPredicateQuery;
 typedef ProtonTerm<search::query::RegExpTerm>      ProtonRegExpTerm;
+typedef ProtonTerm<search::query::NearestNeighborTerm> ProtonNearestNeighborTerm;
 
 struct ProtonNodeTypes {
     typedef ProtonAnd             And;
@@ -160,6 +161,7 @@ struct ProtonNodeTypes {
     typedef ProtonWandTerm        WandTerm;
     typedef ProtonPredicateQuery  PredicateQuery;
     typedef ProtonRegExpTerm      RegExpTerm;
+    typedef ProtonNearestNeighborTerm NearestNeighborTerm;
 };
 
 }
@@ -1,14 +1,25 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "requestcontext.h"
 #include <vespa/searchlib/attribute/attributevector.h>
+#include <vespa/searchlib/fef/properties.h>
+#include <vespa/eval/tensor/tensor.h>
+#include <vespa/eval/tensor/serialization/typed_binary_format.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/exceptions.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".proton.matching.requestcontext");
 
 namespace proton {
 
 using search::attribute::IAttributeVector;
+using vespalib::tensor::Tensor;
 
-RequestContext::RequestContext(const Doom & softDoom, IAttributeContext & attributeContext) :
+RequestContext::RequestContext(const Doom & softDoom, IAttributeContext & attributeContext,
+                               const search::fef::Properties & rankProperties) :
     _softDoom(softDoom),
-    _attributeContext(attributeContext)
+    _attributeContext(attributeContext),
+    _rankProperties(rankProperties)
 { }
 
 const search::attribute::IAttributeVector *
@@ -23,4 +34,25 @@ RequestContext::getAttributeStableEnum(const vespalib::string &name) const
     return _attributeContext.getAttributeStableEnum(name);
 }
 
+std::unique_ptr<Tensor>
+RequestContext::getQueryTensor(const vespalib::string &tensorName) const
+{
+    // Same lookup as done by the query() rank feature
+    search::fef::Property prop = _rankProperties.lookup(tensorName);
+    if (!prop.found()) {
+        prop = _rankProperties.lookup("$" + tensorName);
+    }
+    if (!prop.found() || prop.get().empty()) {
+        return std::unique_ptr<Tensor>();
+    }
+    const vespalib::string &value = prop.get();
+    vespalib::nbostream stream(value.data(), value.size());
+    try {
+        return vespalib::tensor::TypedBinaryFormat::deserialize(stream);
+    } catch (const vespalib::Exception &e) {
+        LOG(warning, "Query tensor '%s' could not be deserialized: %s", tensorName.c_str(), e.getMessage().c_str());
+        return std::unique_ptr<Tensor>();
+    }
+}
+
 }
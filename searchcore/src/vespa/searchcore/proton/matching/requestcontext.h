@@ -5,6 +5,8 @@
 #include <vespa/searchlib/queryeval/irequestcontext.h>
 #include <vespa/searchcommon/attribute/iattributecontext.h>
 
+namespace search::fef { class Properties; }
+
 namespace proton {
 
 class RequestContext : public search::queryeval::IRequestContext
@@ -12,13 +14,16 @@ class RequestContext : public search::queryeval::IRequestContext
 public:
     using IAttributeContext = search::attribute::IAttributeContext;
     using Doom = vespalib::Doom;
-    RequestContext(const Doom & softDoom, IAttributeContext & attributeContext);
+    RequestContext(const Doom & softDoom, IAttributeContext & attributeContext,
+                   const search::fef::Properties & rankProperties);
     const Doom & getSoftDoom() const override { return _softDoom; }
     const search::attribute::IAttributeVector *getAttribute(const vespalib::string &name) const override;
     const search::attribute::IAttributeVector *getAttributeStableEnum(const vespalib::string &name) const override;
+    std::unique_ptr<vespalib::tensor::Tensor> getQueryTensor(const vespalib::string &tensorName) const override;
 private:
-    const Doom          _softDoom;
-    IAttributeContext & _attributeContext;
+    const Doom                      _softDoom;
+    IAttributeContext             & _attributeContext;
+    const search::fef::Properties & _rankProperties;
 };
 
 }
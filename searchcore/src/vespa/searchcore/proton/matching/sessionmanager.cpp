@@ -87,10 +87,17 @@ template <typename T>
 struct SessionMap : SessionCacheBase {
     typedef typename T::SP EntrySP;
     vespalib::hash_map<SessionId, EntrySP> _map;
+    size_t _max_size; // 0 means unbounded
+
+    SessionMap(size_t max_size = 0) : _map(), _max_size(max_size) {}
 
     void insert(EntrySP session) {
         std::lock_guard<std::mutex> guard(_lock);
         const SessionId &id(session->getSessionId());
+        if ((_max_size != 0) && (_map.size() >= _max_size)) {
+            entryDropped(id);
+            return;
+        }
         _map.insert(std::make_pair(id, session));
         _stats.numInsert++;
     }
@@ -164,18 +171,40 @@ struct GroupingSessionCache : public SessionCache<search::grouping::GroupingSess
 };
 
 struct SearchSessionCache : public SessionMap<SearchSession> {
-
+    using Parent = SessionMap<SearchSession>;
+    using Parent::Parent;
 };
 
+namespace {
+
+void addStats(Stats &stats, const Stats &other) {
+    stats.numInsert += other.numInsert;
+    stats.numPick += other.numPick;
+    stats.numDropped += other.numDropped;
+    stats.numCached += other.numCached;
+    stats.numTimedout += other.numTimedout;
+}
+
+}
+
 
-SessionManager::SessionManager(uint32_t maxSize)
+SessionManager::SessionManager(uint32_t maxSize, size_t maxResultCacheBytes, fastos::TimeStamp groupingTtl,
+                               size_t maxFilterCacheBytes, uint32_t maxImplicitSearchSessions)
     : _grouping_cache(std::make_unique<GroupingSessionCache>(maxSize)),
-      _search_map(std::make_unique<SearchSessionCache>()) {
+      _search_map(std::make_unique<SearchSessionCache>()),
+      _implicit_search_map(std::make_unique<SearchSessionCache>(maxImplicitSearchSessions)),
+      _maxImplicitSearchSessions(maxImplicitSearchSessions),
+      _result_cache(maxResultCacheBytes),
+      _filter_cache(maxFilterCacheBytes),
+      _groupingTtl(groupingTtl) {
 }
 
 SessionManager::~SessionManager() { }
 
 void SessionManager::insert(search::grouping::GroupingSession::UP session) {
+    if (_groupingTtl.val() > 0) {
+        session->retain(fastos::TimeStamp(fastos::ClockSystem::now()) + _groupingTtl);
+    }
     _grouping_cache->insert(std::move(session));
 }
 
@@ -183,24 +212,36 @@ void SessionManager::insert(SearchSession::SP session) {
     _search_map->insert(std::move(session));
 }
 
+void SessionManager::insertImplicit(SearchSession::SP session) {
+    if (_maxImplicitSearchSessions != 0) {
+        _implicit_search_map->insert(std::move(session));
+    }
+}
+
 GroupingSession::UP SessionManager::pickGrouping(const SessionId &id) {
     return _grouping_cache->pick(id);
 }
 
 SearchSession::SP SessionManager::pickSearch(const SessionId &id) {
-    return _search_map->pick(id);
+    SearchSession::SP session = _search_map->pick(id);
+    if (!session) {
+        session = _implicit_search_map->pick(id);
+    }
+    return session;
 }
 
 std::vector<SessionManager::SearchSessionInfo>
 SessionManager::getSortedSearchSessionInfo() const
 {
     std::vector<SearchSessionInfo> sessions;
-    _search_map->each([&sessions](const SearchSession &session)
-                     {
-                         sessions.emplace_back(session.getSessionId(),
-                                 session.getCreateTime(),
-                                 session.getTimeOfDoom());
-                     });
+    auto collect = [&sessions](const SearchSession &session)
+                   {
+                       sessions.emplace_back(session.getSessionId(),
+                               session.getCreateTime(),
+                               session.getTimeOfDoom());
+                   };
+    _search_map->each(collect);
+    _implicit_search_map->each(collect);
     std::sort(sessions.begin(), sessions.end(),
               [](const SearchSessionInfo &a,
                  const SearchSessionInfo &b)
@@ -213,22 +254,26 @@ SessionManager::getSortedSearchSessionInfo() const
 void SessionManager::pruneTimedOutSessions(fastos::TimeStamp currentTime) {
     _grouping_cache->pruneTimedOutSessions(currentTime);
     _search_map->pruneTimedOutSessions(currentTime);
+    _implicit_search_map->pruneTimedOutSessions(currentTime);
 }
 
 void SessionManager::close() {
     pruneTimedOutSessions(fastos::TimeStamp::FUTURE);
     assert(_grouping_cache->empty());
     assert(_search_map->empty());
+    assert(_implicit_search_map->empty());
 }
 
 SessionManager::Stats SessionManager::getGroupingStats() {
     return _grouping_cache->getStats();
 }
 SessionManager::Stats SessionManager::getSearchStats() {
-    return _search_map->getStats();
+    Stats stats = _search_map->getStats();
+    addStats(stats, _implicit_search_map->getStats());
+    return stats;
 }
 size_t SessionManager::getNumSearchSessions() const {
-    return _search_map->size();
+    return _search_map->size() + _implicit_search_map->size();
 }
 
 }
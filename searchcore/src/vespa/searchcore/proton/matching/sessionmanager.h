@@ -3,6 +3,8 @@
 
 #include "search_session.h"
 #include "isessioncachepruner.h"
+#include "query_result_cache.h"
+#include "filter_result_cache.h"
 #include <vespa/searchcore/grouping/groupingsession.h>
 #include <vespa/searchcore/grouping/sessionid.h>
 #include <vespa/vespalib/stllike/lrucache_map.h>
@@ -44,12 +46,19 @@ public:
 private:
     std::unique_ptr<GroupingSessionCache> _grouping_cache;
     std::unique_ptr<SearchSessionCache> _search_map;
+    std::unique_ptr<SearchSessionCache> _implicit_search_map;
+    uint32_t _maxImplicitSearchSessions;
+    QueryResultCache _result_cache;
+    FilterResultCache _filter_cache;
+    fastos::TimeStamp _groupingTtl;
 
 public:
     typedef std::unique_ptr<SessionManager> UP;
     typedef std::shared_ptr<SessionManager> SP;
 
-    SessionManager(uint32_t maxSizeGrouping);
+    SessionManager(uint32_t maxSizeGrouping, size_t maxResultCacheBytes = 0,
+                   fastos::TimeStamp groupingTtl = fastos::TimeStamp(0),
+                   size_t maxFilterCacheBytes = 0, uint32_t maxImplicitSearchSessions = 0);
     ~SessionManager();
 
     void insert(search::grouping::GroupingSession::UP session);
@@ -57,11 +66,22 @@ public:
     Stats getGroupingStats();
 
     void insert(SearchSession::SP session);
+    /**
+     * Keeps a search session the query did not ask to cache, so that
+     * docsum requests for the same session id can reuse its setup. At
+     * most maxImplicitSearchSessions such sessions are kept, later ones
+     * are dropped until earlier ones time out.
+     */
+    void insertImplicit(SearchSession::SP session);
+    bool cachesImplicitSearchSessions() const { return (_maxImplicitSearchSessions != 0); }
     SearchSession::SP pickSearch(const SessionId &id);
     Stats getSearchStats();
     size_t getNumSearchSessions() const;
     std::vector<SearchSessionInfo> getSortedSearchSessionInfo() const;
 
+    QueryResultCache &getResultCache() { return _result_cache; }
+    FilterResultCache &getFilterCache() { return _filter_cache; }
+
     void pruneTimedOutSessions(fastos::TimeStamp currentTime) override;
     void close();
 };
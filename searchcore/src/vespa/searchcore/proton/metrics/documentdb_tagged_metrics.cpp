@@ -80,10 +80,21 @@ DocumentDBTaggedMetrics::AttributeMetrics::ResourceUsageMetrics::ResourceUsageMe
 
 DocumentDBTaggedMetrics::AttributeMetrics::ResourceUsageMetrics::~ResourceUsageMetrics() { }
 
+DocumentDBTaggedMetrics::IndexMetrics::PostingListCacheMetrics::PostingListCacheMetrics(MetricSet *parent)
+    : MetricSet("posting_list_cache", "", "Cache of posting lists read from disk indexes", parent),
+      memoryUsage("memory_usage", "", "Memory used by cached posting lists in bytes", this),
+      elements("elements", "", "Number of cached posting lists", this),
+      hits("hits", "", "Number of posting list reads served by the cache", this),
+      lookups("lookups", "", "Number of posting list reads looked up in the cache", this)
+{ }
+
+DocumentDBTaggedMetrics::IndexMetrics::PostingListCacheMetrics::~PostingListCacheMetrics() { }
+
 DocumentDBTaggedMetrics::IndexMetrics::IndexMetrics(MetricSet *parent)
     : MetricSet("index", "", "Index metrics (memory and disk) for this document db", parent),
       diskUsage("disk_usage", "", "Disk space usage in bytes", this),
-      memoryUsage(this)
+      memoryUsage(this),
+      postingListCache(this)
 { }
 
 DocumentDBTaggedMetrics::IndexMetrics::~IndexMetrics() { }
@@ -101,6 +112,16 @@ DocumentDBTaggedMetrics::MatchingMetrics::update(const MatchingStats &stats)
                                       stats.queryCollateralTimeMin(), stats.queryCollateralTimeMax());
     queryLatency.addValueBatch(stats.queryLatencyAvg(), stats.queryLatencyCount(),
                                stats.queryLatencyMin(), stats.queryLatencyMax());
+    blueprintCreationTime.addValueBatch(stats.blueprintCreationTimeAvg(), stats.blueprintCreationTimeCount(),
+                                        stats.blueprintCreationTimeMin(), stats.blueprintCreationTimeMax());
+    postingFetchTime.addValueBatch(stats.postingFetchTimeAvg(), stats.postingFetchTimeCount(),
+                                   stats.postingFetchTimeMin(), stats.postingFetchTimeMax());
+    limiterSetupTime.addValueBatch(stats.limiterSetupTimeAvg(), stats.limiterSetupTimeCount(),
+                                   stats.limiterSetupTimeMin(), stats.limiterSetupTimeMax());
+    queryCpuTime.addValueBatch(stats.queryCpuTimeAvg(), stats.queryCpuTimeCount(),
+                               stats.queryCpuTimeMin(), stats.queryCpuTimeMax());
+    queryAllocatedBytes.addValueBatch(stats.queryAllocatedBytesAvg(), stats.queryAllocatedBytesCount(),
+                                      stats.queryAllocatedBytesMin(), stats.queryAllocatedBytesMax());
 }
 
 DocumentDBTaggedMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
@@ -111,7 +132,12 @@ DocumentDBTaggedMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
       queries("queries", "", "Number of queries executed", this),
       softDoomFactor("soft_doom_factor", "", "Factor used to compute soft-timeout", this),
       queryCollateralTime("query_collateral_time", "", "Average time (sec) spent setting up and tearing down queries", this),
-      queryLatency("query_latency", "", "Average latency (sec) when matching a query", this)
+      queryLatency("query_latency", "", "Average latency (sec) when matching a query", this),
+      blueprintCreationTime("blueprint_creation_time", "", "Average time (sec) spent creating and optimizing the blueprint of a query", this),
+      postingFetchTime("posting_fetch_time", "", "Average time (sec) spent fetching postings for a query", this),
+      limiterSetupTime("limiter_setup_time", "", "Average time (sec) spent setting up match phase limiting for a limited query", this),
+      queryCpuTime("query_cpu_time", "", "Average cpu time (sec) used by all match threads for a query", this),
+      queryAllocatedBytes("query_allocated_bytes", "", "Average number of bytes allocated by all match threads for a query", this)
 { }
 
 DocumentDBTaggedMetrics::MatchingMetrics::~MatchingMetrics() {}
@@ -125,11 +151,18 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics
       docsReRanked("docs_reranked", "", "Number of documents re-ranked (second phase)", this),
       queries("queries", "", "Number of queries executed", this),
       limitedQueries("limited_queries", "", "Number of queries limited in match phase", this),
+      resultCacheHits("result_cache_hits", "", "Number of queries answered from the query result cache", this),
+      resultCacheMisses("result_cache_misses", "", "Number of cacheable queries not found in the query result cache", this),
       matchTime("match_time", "", "Average time (sec) for matching a query", this),
       groupingTime("grouping_time", "", "Average time (sec) spent on grouping", this),
       rerankTime("rerank_time", "", "Average time (sec) spent on 2nd phase ranking", this),
       queryCollateralTime("query_collateral_time", "", "Average time (sec) spent setting up and tearing down queries", this),
-      queryLatency("query_latency", "", "Average latency (sec) when matching a query", this)
+      queryLatency("query_latency", "", "Average latency (sec) when matching a query", this),
+      blueprintCreationTime("blueprint_creation_time", "", "Average time (sec) spent creating and optimizing the blueprint of a query", this),
+      postingFetchTime("posting_fetch_time", "", "Average time (sec) spent fetching postings for a query", this),
+      limiterSetupTime("limiter_setup_time", "", "Average time (sec) spent setting up match phase limiting for a limited query", this),
+      queryCpuTime("query_cpu_time", "", "Average cpu time (sec) used by all match threads for a query", this),
+      queryAllocatedBytes("query_allocated_bytes", "", "Average number of bytes allocated by all match threads for a query", this)
 {
     for (size_t i = 0; i < numDocIdPartitions; ++i) {
         vespalib::string partition(vespalib::make_string("docid_part%02ld", i));
@@ -145,7 +178,12 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::Do
     docsRanked("docs_ranked", "", "Number of documents ranked (first phase)", this),
     docsReRanked("docs_reranked", "", "Number of documents re-ranked (second phase)", this),
     activeTime("active_time", "", "Time (sec) spent doing actual work", this),
-    waitTime("wait_time", "", "Time (sec) spent waiting for other external threads and resources", this)
+    waitTime("wait_time", "", "Time (sec) spent waiting for other external threads and resources", this),
+    cpuTime("cpu_time", "", "Cpu time (sec) used by the match thread", this),
+    firstPhaseTime("first_phase_time", "", "Time (sec) spent matching and doing first phase ranking", this),
+    secondPhaseTime("second_phase_time", "", "Time (sec) spent doing second phase ranking", this),
+    allocatedBytes("allocated_bytes", "", "Bytes allocated for hits and rank programs", this),
+    steals("steals", "", "Number of docid ranges stolen from other threads", this)
 { }
 
 DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::~DocIdPartition() {}
@@ -160,6 +198,15 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::DocIdPartition::up
                              stats.active_time_min(), stats.active_time_max());
     waitTime.addValueBatch(stats.wait_time_avg(), stats.wait_time_count(),
                            stats.wait_time_min(), stats.wait_time_max());
+    cpuTime.addValueBatch(stats.cpu_time_avg(), stats.cpu_time_count(),
+                          stats.cpu_time_min(), stats.cpu_time_max());
+    firstPhaseTime.addValueBatch(stats.first_phase_time_avg(), stats.first_phase_time_count(),
+                                 stats.first_phase_time_min(), stats.first_phase_time_max());
+    secondPhaseTime.addValueBatch(stats.second_phase_time_avg(), stats.second_phase_time_count(),
+                                  stats.second_phase_time_min(), stats.second_phase_time_max());
+    allocatedBytes.addValueBatch(stats.allocated_bytes_avg(), stats.allocated_bytes_count(),
+                                 stats.allocated_bytes_min(), stats.allocated_bytes_max());
+    steals.inc(stats.steals());
 }
 
 void
@@ -170,6 +217,8 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const Match
     docsReRanked.inc(stats.docsReRanked());
     queries.inc(stats.queries());
     limitedQueries.inc(stats.limited_queries());
+    resultCacheHits.inc(stats.cache_hits());
+    resultCacheMisses.inc(stats.cache_misses());
     matchTime.addValueBatch(stats.matchTimeAvg(), stats.matchTimeCount(),
                             stats.matchTimeMin(), stats.matchTimeMax());
     groupingTime.addValueBatch(stats.groupingTimeAvg(), stats.groupingTimeCount(),
@@ -180,6 +229,16 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const Match
                                       stats.queryCollateralTimeMin(), stats.queryCollateralTimeMax());
     queryLatency.addValueBatch(stats.queryLatencyAvg(), stats.queryLatencyCount(),
                                stats.queryLatencyMin(), stats.queryLatencyMax());
+    blueprintCreationTime.addValueBatch(stats.blueprintCreationTimeAvg(), stats.blueprintCreationTimeCount(),
+                                        stats.blueprintCreationTimeMin(), stats.blueprintCreationTimeMax());
+    postingFetchTime.addValueBatch(stats.postingFetchTimeAvg(), stats.postingFetchTimeCount(),
+                                   stats.postingFetchTimeMin(), stats.postingFetchTimeMax());
+    limiterSetupTime.addValueBatch(stats.limiterSetupTimeAvg(), stats.limiterSetupTimeCount(),
+                                   stats.limiterSetupTimeMin(), stats.limiterSetupTimeMax());
+    queryCpuTime.addValueBatch(stats.queryCpuTimeAvg(), stats.queryCpuTimeCount(),
+                               stats.queryCpuTimeMin(), stats.queryCpuTimeMax());
+    queryAllocatedBytes.addValueBatch(stats.queryAllocatedBytesAvg(), stats.queryAllocatedBytesCount(),
+                                      stats.queryAllocatedBytesMin(), stats.queryAllocatedBytesMax());
     if (stats.getNumPartitions() > 0) {
         if (stats.getNumPartitions() <= partitions.size()) {
             for (size_t i = 0; i < stats.getNumPartitions(); ++i) {
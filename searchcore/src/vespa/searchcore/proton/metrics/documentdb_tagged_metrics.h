@@ -86,8 +86,20 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
 
     struct IndexMetrics : metrics::MetricSet
     {
+        struct PostingListCacheMetrics : metrics::MetricSet
+        {
+            metrics::LongValueMetric memoryUsage;
+            metrics::LongValueMetric elements;
+            metrics::LongCountMetric hits;
+            metrics::LongCountMetric lookups;
+
+            PostingListCacheMetrics(metrics::MetricSet *parent);
+            ~PostingListCacheMetrics();
+        };
+
         metrics::LongValueMetric diskUsage;
         MemoryUsageMetrics memoryUsage;
+        PostingListCacheMetrics postingListCache;
 
         IndexMetrics(metrics::MetricSet *parent);
         ~IndexMetrics();
@@ -101,6 +113,11 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
         metrics::DoubleValueMetric softDoomFactor;
         metrics::DoubleAverageMetric queryCollateralTime;
         metrics::DoubleAverageMetric queryLatency;
+        metrics::DoubleAverageMetric blueprintCreationTime;
+        metrics::DoubleAverageMetric postingFetchTime;
+        metrics::DoubleAverageMetric limiterSetupTime;
+        metrics::DoubleAverageMetric queryCpuTime;
+        metrics::DoubleAverageMetric queryAllocatedBytes;
 
         struct RankProfileMetrics : metrics::MetricSet {
             struct DocIdPartition : metrics::MetricSet {
@@ -109,6 +126,11 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
                 metrics::LongCountMetric docsReRanked;
                 metrics::DoubleAverageMetric activeTime;
                 metrics::DoubleAverageMetric waitTime;
+                metrics::DoubleAverageMetric cpuTime;
+                metrics::DoubleAverageMetric firstPhaseTime;
+                metrics::DoubleAverageMetric secondPhaseTime;
+                metrics::DoubleAverageMetric allocatedBytes;
+                metrics::LongCountMetric steals;
 
                 using UP = std::unique_ptr<DocIdPartition>;
                 DocIdPartition(const vespalib::string &name, metrics::MetricSet *parent);
@@ -123,11 +145,18 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             metrics::LongCountMetric     docsReRanked;
             metrics::LongCountMetric     queries;
             metrics::LongCountMetric     limitedQueries;
+            metrics::LongCountMetric     resultCacheHits;
+            metrics::LongCountMetric     resultCacheMisses;
             metrics::DoubleAverageMetric matchTime;
             metrics::DoubleAverageMetric groupingTime;
             metrics::DoubleAverageMetric rerankTime;
             metrics::DoubleAverageMetric queryCollateralTime;
             metrics::DoubleAverageMetric queryLatency;
+            metrics::DoubleAverageMetric blueprintCreationTime;
+            metrics::DoubleAverageMetric postingFetchTime;
+            metrics::DoubleAverageMetric limiterSetupTime;
+            metrics::DoubleAverageMetric queryCpuTime;
+            metrics::DoubleAverageMetric queryAllocatedBytes;
             DocIdPartitions              partitions;
 
             RankProfileMetrics(const vespalib::string &name,
@@ -10,13 +10,27 @@ ExecutorMetrics::update(const vespalib::ThreadStackExecutorBase::Stats &stats)
     maxPending.set(stats.maxPendingTasks);
     accepted.inc(stats.acceptedTasks);
     rejected.inc(stats.rejectedTasks);
+    executed.inc(stats.executedTasks);
+    utilization.set(stats.getUtilization());
+    cpuUtilization.set(stats.getCpuUtilization());
+    waitTime.set(stats.getAverageWaitTime());
+    maxWaitTime.set(stats.maxWaitTime);
+    runTime50.set(stats.getRunTimePercentile(0.50));
+    runTime99.set(stats.getRunTimePercentile(0.99));
 }
 
 ExecutorMetrics::ExecutorMetrics(const std::string &name, metrics::MetricSet *parent)
     : metrics::MetricSet(name, "", "Instance specific thread executor metrics", parent),
       maxPending("maxpending", "", "Maximum number of pending (active + queued) tasks", this),
       accepted("accepted", "", "Number of accepted tasks", this),
-      rejected("rejected", "", "Number of rejected tasks", this)
+      rejected("rejected", "", "Number of rejected tasks", this),
+      executed("executed", "", "Number of executed tasks", this),
+      utilization("utilization", "", "Ratio of worker thread time spent running tasks", this),
+      cpuUtilization("cpu_utilization", "", "Ratio of worker thread time spent on the cpu", this),
+      waitTime("wait_time", "", "Average time (sec) a task waited in the queue before it started running", this),
+      maxWaitTime("max_wait_time", "", "Max time (sec) a task waited in the queue before it started running", this),
+      runTime50("run_time_50_percentile", "", "Upper bound of the run time (sec) of 50 percent of the executed tasks", this),
+      runTime99("run_time_99_percentile", "", "Upper bound of the run time (sec) of 99 percent of the executed tasks", this)
 {
 }
 
@@ -14,6 +14,13 @@ struct ExecutorMetrics : metrics::MetricSet
     metrics::LongValueMetric maxPending;
     metrics::LongCountMetric accepted;
     metrics::LongCountMetric rejected;
+    metrics::LongCountMetric executed;
+    metrics::DoubleValueMetric utilization;
+    metrics::DoubleValueMetric cpuUtilization;
+    metrics::DoubleValueMetric waitTime;
+    metrics::DoubleValueMetric maxWaitTime;
+    metrics::DoubleValueMetric runTime50;
+    metrics::DoubleValueMetric runTime99;
 
     void update(const vespalib::ThreadStackExecutorBase::Stats &stats);
     ExecutorMetrics(const std::string &name, metrics::MetricSet *parent);
@@ -4,6 +4,7 @@
 
 using search::transactionlog::DomainInfo;
 using search::transactionlog::DomainStats;
+using search::transactionlog::SyncStats;
 
 namespace proton {
 
@@ -13,7 +14,10 @@ TransLogServerMetrics::DomainMetrics::DomainMetrics(metrics::MetricSet *parent,
             "Transaction log metrics for a document type", parent),
       entries("entries", "", "The current number of entries in the transaction log", this),
       diskUsage("disk_usage", "", "The disk usage (in bytes) of the transaction log", this),
-      replayTime("replay_time", "", "The replay time (in seconds) of the transaction log during start-up", this)
+      replayTime("replay_time", "", "The replay time (in seconds) of the transaction log during start-up", this),
+      syncLatency("sync_latency", "", "The time (in seconds) spent syncing the transaction log to disk", this),
+      syncBatchSize("sync_batch_size", "", "The number of entries made durable by each sync of the transaction log", this),
+      lastSyncStats()
 {
 }
 
@@ -25,6 +29,13 @@ TransLogServerMetrics::DomainMetrics::update(const DomainInfo &stats)
     entries.set(stats.numEntries);
     diskUsage.set(stats.byteSize);
     replayTime.set(stats.maxSessionRunTime.count());
+    const SyncStats &syncStats = stats.syncStats;
+    if (syncStats.numSyncs > lastSyncStats.numSyncs) {
+        uint32_t numSyncs = syncStats.numSyncs - lastSyncStats.numSyncs;
+        syncLatency.addTotalValueWithCount((syncStats.syncTime - lastSyncStats.syncTime).count(), numSyncs);
+        syncBatchSize.addTotalValueWithCount(syncStats.syncedEntries - lastSyncStats.syncedEntries, numSyncs);
+    }
+    lastSyncStats = syncStats;
 }
 
 void
@@ -18,6 +18,9 @@ public:
         metrics::LongValueMetric entries;
         metrics::LongValueMetric diskUsage;
         metrics::DoubleValueMetric replayTime;
+        metrics::DoubleAverageMetric syncLatency;
+        metrics::LongAverageMetric syncBatchSize;
+        search::transactionlog::SyncStats lastSyncStats;
 
         typedef std::unique_ptr<DomainMetrics> UP;
         DomainMetrics(metrics::MetricSet *parent, const vespalib::string &documentType);
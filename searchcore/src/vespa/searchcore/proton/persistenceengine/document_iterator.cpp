@@ -100,6 +100,30 @@ DocumentIterator::add(const IDocumentRetriever::SP &retriever)
     _sources.push_back(retriever);
 }
 
+void
+DocumentIterator::prefetch()
+{
+    if (_metaOnly || _fetchedData) {
+        return;
+    }
+    for (const IDocumentRetriever::SP & source : _sources) {
+        IDocumentRetriever::ReadGuard sourceReadGuard(source->getReadGuard());
+        search::DocumentMetaData::Vector metaData;
+        source->getBucketMetaData(_bucket, metaData);
+        uint32_t docIdLimit = source->getDocIdLimit();
+        IDocumentRetriever::LidVector lidsToPrefetch;
+        lidsToPrefetch.reserve(metaData.size());
+        for (const search::DocumentMetaData & meta : metaData) {
+            if (checkMeta(meta) && (meta.lid < docIdLimit)) {
+                lidsToPrefetch.push_back(meta.lid);
+            }
+        }
+        if ( ! lidsToPrefetch.empty()) {
+            source->prefetchDocuments(lidsToPrefetch);
+        }
+    }
+}
+
 IterateResult
 DocumentIterator::iterate(size_t maxBytes)
 {
@@ -46,6 +46,13 @@ public:
                      ReadConsistency readConsistency=ReadConsistency::STRONG);
     ~DocumentIterator();
     void add(const IDocumentRetriever::SP &retriever);
+    /**
+     * Start reading ahead the documents in the bucket, so that they are
+     * likely to be in memory when iterate() is called. The visitor creates
+     * iterators for the next buckets while still iterating the current one,
+     * so this overlaps disk reads across buckets.
+     */
+    void prefetch();
     storage::spi::IterateResult iterate(size_t maxBytes);
 };
 
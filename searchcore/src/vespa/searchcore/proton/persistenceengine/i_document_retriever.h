@@ -46,6 +46,11 @@ public:
      * @param Visitor to receive callback for each document found.
      */
     virtual void visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor, ReadConsistency readConsistency) const = 0;
+    /**
+     * Hint that the documents in the given list will soon be visited, so that the
+     * underlying storage can start reading them ahead of time. Default is a no-op.
+     */
+    virtual void prefetchDocuments(const LidVector &lids) const { (void) lids; }
 
     virtual CachedSelect::SP parseSelect(const vespalib::string &selection) const = 0;
 };
@@ -349,6 +349,53 @@ PersistenceEngine::put(const Bucket& b, Timestamp t, const document::Document::S
     return latch.getResult();
 }
 
+std::vector<PersistenceEngine::Result>
+PersistenceEngine::putMultiple(const Bucket& b, const storage::spi::PutBatch& puts, Context&)
+{
+    std::vector<Result> results(puts.size());
+    if (!_writeFilter.acceptWriteOperation()) {
+        IResourceWriteFilter::State state = _writeFilter.getAcceptState();
+        if (!state.acceptWriteOperation()) {
+            for (size_t i = 0; i < puts.size(); ++i) {
+                results[i] = Result(Result::RESOURCE_EXHAUSTED,
+                                    make_string("Put operation rejected for document '%s': '%s'",
+                                                puts[i].second->getId().toString().c_str(), state.message().c_str()));
+            }
+            return results;
+        }
+    }
+    std::shared_lock<std::shared_timed_mutex> rguard(_rwMutex);
+    // Hand all puts to the feed pipeline before waiting for any of them, so
+    // that they are processed and committed to the transaction log together.
+    std::vector<std::unique_ptr<TransportLatch>> latches(puts.size());
+    for (size_t i = 0; i < puts.size(); ++i) {
+        const document::Document::SP &doc = puts[i].second;
+        DocTypeName docType(doc->getType());
+        LOG(spam, "putMultiple(%s, %" PRIu64 ", (\"%s\", \"%s\"))", b.toString().c_str(),
+            static_cast<uint64_t>(puts[i].first.getValue()), docType.toString().c_str(), doc->getId().toString().c_str());
+        if (!doc->getId().hasDocType()) {
+            results[i] = Result(Result::PERMANENT_ERROR,
+                                make_string("Old id scheme not supported in elastic mode (%s)", doc->getId().toString().c_str()));
+            continue;
+        }
+        IPersistenceHandler::SP handler = getHandler(b.getBucketSpace(), docType);
+        if (!handler) {
+            results[i] = Result(Result::PERMANENT_ERROR,
+                                make_string("No handler for document type '%s'", docType.toString().c_str()));
+            continue;
+        }
+        latches[i] = std::make_unique<TransportLatch>(1);
+        handler->handlePut(feedtoken::make(*latches[i]), b, puts[i].first, doc);
+    }
+    for (size_t i = 0; i < puts.size(); ++i) {
+        if (latches[i]) {
+            latches[i]->await();
+            results[i] = latches[i]->getResult();
+        }
+    }
+    return results;
+}
+
 PersistenceEngine::RemoveResult
 PersistenceEngine::remove(const Bucket& b, Timestamp t, const DocumentId& did, Context&)
 {
@@ -458,6 +505,7 @@ PersistenceEngine::createIterator(const Bucket &bucket, const document::FieldSet
         }
     }
     entry->handler_sequence = HandlerSnapshot::release(std::move(*snapshot));
+    entry->it.prefetch();
 
     std::lock_guard<std::mutex> guard(_iterators_lock);
     static IteratorId id_counter(0);
@@ -101,6 +101,7 @@ public:
     Result setActiveState(const Bucket& bucket, BucketInfo::ActiveState newState) override;
     BucketInfoResult getBucketInfo(const Bucket&) const override;
     Result put(const Bucket&, Timestamp, const std::shared_ptr<document::Document>&, Context&) override;
+    std::vector<Result> putMultiple(const Bucket&, const storage::spi::PutBatch&, Context&) override;
     RemoveResult remove(const Bucket&, Timestamp, const document::DocumentId&, Context&) override;
     UpdateResult update(const Bucket&, Timestamp,
                         const std::shared_ptr<document::DocumentUpdate>&, Context&) override;
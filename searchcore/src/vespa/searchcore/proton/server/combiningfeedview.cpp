@@ -238,6 +238,14 @@ CombiningFeedView::forceCommit(search::SerialNum serialNum)
     }
 }
 
+void
+CombiningFeedView::forceCommit(search::SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onDone)
+{
+    for (const auto &view : _views) {
+        view->forceCommit(serialNum, onDone);
+    }
+}
+
 void
 CombiningFeedView::
 handlePruneRemovedDocuments(const PruneRemovedDocumentsOperation &pruneOp)
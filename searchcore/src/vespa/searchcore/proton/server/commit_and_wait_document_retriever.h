@@ -48,6 +48,9 @@ public:
         _commit.commitAndWait();
         _retriever->visitDocuments(lids, visitor, readConsistency);
     }
+    void prefetchDocuments(const LidVector &lids) const override {
+        _retriever->prefetchDocuments(lids);
+    }
 
     CachedSelect::SP parseSelect(const vespalib::string &selection) const override {
         return _retriever->parseSelect(selection);
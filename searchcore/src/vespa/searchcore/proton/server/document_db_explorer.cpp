@@ -4,6 +4,7 @@
 
 #include "document_meta_store_read_guards.h"
 #include "document_subdb_collection_explorer.h"
+#include "executor_threading_service_explorer.h"
 #include "maintenance_controller_explorer.h"
 #include <vespa/searchcore/proton/common/state_reporter_utils.h>
 #include <vespa/searchcore/proton/bucketdb/bucket_db_explorer.h>
@@ -42,17 +43,28 @@ DocumentDBExplorer::get_state(const Inserter &inserter, bool full) const
         documents.setLong("stored", dmss.numStoredDocs());
         documents.setLong("removed", dmss.numRemovedDocs());
     }
+    {
+        AdaptiveVisibilityDelay delay = _docDb->getVisibilityHandler().getAdaptiveVisibilityDelay();
+        Cursor &visibility = object.setObject("visibilityDelay");
+        visibility.setBool("adaptive", delay.isAdaptive());
+        visibility.setDouble("current", delay.getDelay().sec());
+        visibility.setDouble("min", delay.getMinDelay().sec());
+        visibility.setDouble("max", delay.getMaxDelay().sec());
+        visibility.setDouble("feedRate", delay.getFeedRate());
+        visibility.setDouble("commitCost", delay.getCommitCost());
+    }
 }
 
 const vespalib::string SUB_DB = "subdb";
 const vespalib::string BUCKET_DB = "bucketdb";
 const vespalib::string MAINTENANCE_CONTROLLER = "maintenancecontroller";
 const vespalib::string SESSION = "session";
+const vespalib::string THREADING_SERVICE = "threadingservice";
 
 std::vector<vespalib::string>
 DocumentDBExplorer::get_children_names() const
 {
-    return {SUB_DB, BUCKET_DB, MAINTENANCE_CONTROLLER, SESSION};
+    return {SUB_DB, BUCKET_DB, MAINTENANCE_CONTROLLER, SESSION, THREADING_SERVICE};
 }
 
 std::unique_ptr<StateExplorer>
@@ -71,6 +83,8 @@ DocumentDBExplorer::get_child(vespalib::stringref name) const
     } else if (name == SESSION) {
         return std::unique_ptr<StateExplorer>
             (new matching::SessionManagerExplorer(_docDb->session_manager()));
+    } else if (name == THREADING_SERVICE) {
+        return std::make_unique<ExecutorThreadingServiceExplorer>(_docDb->getLastExecutorStats());
     }
     return std::unique_ptr<StateExplorer>(nullptr);
 }
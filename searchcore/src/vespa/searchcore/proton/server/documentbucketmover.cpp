@@ -8,6 +8,7 @@
 #include <vespa/searchcore/proton/feedoperation/moveoperation.h>
 #include <vespa/searchcore/proton/persistenceengine/i_document_retriever.h>
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 
 using document::BucketId;
 using document::Document;
@@ -22,21 +23,14 @@ typedef IDocumentMetaStore::Iterator Iterator;
 void
 DocumentBucketMover::moveDocument(DocumentIdT lid,
                                   const document::GlobalId &gid,
-                                  Timestamp timestamp)
+                                  Timestamp timestamp,
+                                  Document::SP doc)
 {
-    Document::SP doc(_source->_retriever->getDocument(lid).release());
     if (!doc || doc->getId().getGlobalId() != gid)
         return; // Failed to retrieve document, removed or changed identity
-    // TODO(geirst): what if doc is NULL?
     BucketId bucketId = _bucket.stripUnused();
     MoveOperation op(bucketId, timestamp, doc, DbDocumentId(_source->_subDbId, lid), _targetSubDbId);
-
-    // We cache the bucket for the document we are going to move to avoid getting
-    // inconsistent bucket info (getBucketInfo()) while moving between ready and not-ready
-    // sub dbs as the bucket info is not updated atomically in this case.
-    _bucketDb->takeGuard()->cacheBucket(bucketId);
     _handler->handleMove(op, _limiter.beginOperation());
-    _bucketDb->takeGuard()->uncacheBucket();
 }
 
 
@@ -91,6 +85,27 @@ public:
     }
 };
 
+/**
+ * Collects the documents to move, which are visited in document store
+ * order rather than in the order they are moved.
+ */
+class MoveVisitor : public search::IDocumentVisitor
+{
+    vespalib::hash_map<DocumentIdT, Document::SP> _docs;
+public:
+    MoveVisitor(size_t numDocs) : _docs(numDocs * 2) { }
+    void visit(uint32_t lid, DocumentUP doc) override {
+        if (doc) {
+            _docs[lid] = Document::SP(doc.release());
+        }
+    }
+    bool allowVisitCaching() const override { return false; }
+    Document::SP getDocument(DocumentIdT lid) const {
+        auto itr = _docs.find(lid);
+        return (itr != _docs.end()) ? itr->second : Document::SP();
+    }
+};
+
 }
 
 void DocumentBucketMover::setBucketDone() {
@@ -130,9 +145,26 @@ DocumentBucketMover::moveDocuments(size_t maxDocsToMove)
     if (itr == end) {
         setBucketDone();
     }
+    if (toMove.empty()) {
+        return;
+    }
+    // Read all documents in the batch with a single pass over the document store
+    IDocumentRetriever::LidVector lids;
+    lids.reserve(toMove.size());
     for (const MoveKey & key : toMove) {
-        moveDocument(key._lid, key._gid, key._timestamp);
+        lids.push_back(key._lid);
     }
+    MoveVisitor visitor(toMove.size());
+    _source->_retriever->visitDocuments(lids, visitor, storage::spi::ReadConsistency::STRONG);
+
+    // We cache the bucket for the documents we are going to move to avoid getting
+    // inconsistent bucket info (getBucketInfo()) while moving between ready and not-ready
+    // sub dbs as the bucket info is not updated atomically in this case.
+    _bucketDb->takeGuard()->cacheBucket(_bucket.stripUnused());
+    for (const MoveKey & key : toMove) {
+        moveDocument(key._lid, key._gid, key._timestamp, visitor.getDocument(key._lid));
+    }
+    _bucketDb->takeGuard()->uncacheBucket();
 }
 
 
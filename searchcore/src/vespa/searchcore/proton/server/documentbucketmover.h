@@ -8,6 +8,8 @@
 #include <persistence/spi/types.h>
 #include "ifrozenbuckethandler.h"
 
+namespace document { class Document; }
+
 namespace proton {
 
 class BucketDBOwner;
@@ -35,7 +37,8 @@ private:
 
     void moveDocument(search::DocumentIdT lid,
                       const document::GlobalId &gid,
-                      storage::spi::Timestamp timestamp);
+                      storage::spi::Timestamp timestamp,
+                      std::shared_ptr<document::Document> doc);
 
     void setBucketDone();
 public:
@@ -16,6 +16,7 @@
 #include <vespa/searchcore/proton/attribute/attribute_writer.h>
 #include <vespa/searchcore/proton/attribute/imported_attributes_repo.h>
 #include <vespa/searchcore/proton/common/eventlogger.h>
+#include <vespa/searchcore/proton/common/memory_accounting.h>
 #include <vespa/searchcore/proton/common/statusreport.h>
 #include <vespa/searchcore/proton/feedoperation/noopoperation.h>
 #include <vespa/searchcore/proton/index/index_writer.h>
@@ -118,7 +119,11 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _bucketHandler(_writeService.master()),
       _protonIndexCfg(protonCfg.index),
       _config_store(std::move(config_store)),
-      _sessionManager(new matching::SessionManager(protonCfg.grouping.sessionmanager.maxentries)),
+      _sessionManager(new matching::SessionManager(protonCfg.grouping.sessionmanager.maxentries,
+                                                   protonCfg.search.resultcache.maxbytes,
+                                                   fastos::TimeStamp::Seconds(protonCfg.grouping.sessionmanager.ttl),
+                                                   protonCfg.search.filtercache.maxbytes,
+                                                   protonCfg.search.sessions.implicit.maxentries)),
       _metricsWireService(metricsWireService),
       _metricsHook(*this, _docTypeName.getName(), protonCfg.numthreadspersearch),
       _feedView(),
@@ -131,12 +136,14 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _feedHandler(_writeService, tlsSpec, docTypeName, _state, *this, _writeFilter, *this, tlsDirectWriter),
       _subDBs(*this, *this, _feedHandler, _docTypeName, _writeService, warmupExecutor,
               summaryExecutor, fileHeaderContext, metricsWireService, getMetricsCollection(),
-              queryLimiter, clock, _configMutex, _baseDir, protonCfg, hwInfo),
+              queryLimiter, clock, owner.getConstantValueFactory(), _configMutex, _baseDir, protonCfg, hwInfo),
       _maintenanceController(_writeService.master(), summaryExecutor, _docTypeName),
       _visibility(_feedHandler, _writeService, _feedView),
       _lidSpaceCompactionHandlers(),
       _jobTrackers(),
       _lastDocStoreCacheStats(),
+      _lastExecutorStatsMutex(),
+      _lastExecutorStats(),
       _calc()
 {
     assert(configSnapshot);
@@ -144,6 +151,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
     LOG(debug, "DocumentDB(%s): Creating database in directory '%s'",
         _docTypeName.toString().c_str(), _baseDir.c_str());
 
+    _visibility.setResultCache(&_sessionManager->getResultCache());
     _feedHandler.init(_config_store->getOldestSerialNum());
     _feedHandler.setBucketDBHandler(&_subDBs.getBucketDBHandler());
     saveInitialConfig(*configSnapshot);
@@ -169,6 +177,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
     }
     _writeFilter.setConfig(loaded_config->getMaintenanceConfigSP()->getAttributeUsageFilterConfig());
     fastos::TimeStamp visibilityDelay = loaded_config->getMaintenanceConfigSP()->getVisibilityDelay();
+    _visibility.setMinVisibilityDelay(loaded_config->getMaintenanceConfigSP()->getMinVisibilityDelay());
     _visibility.setVisibilityDelay(visibilityDelay);
     if (_visibility.getVisibilityDelay() > 0) {
         _writeService.setTaskLimit(_writeServiceConfig.semiUnboundTaskLimit(), _writeServiceConfig.defaultTaskLimit());
@@ -413,6 +422,7 @@ DocumentDB::applyConfig(DocumentDBConfig::SP configSnapshot, SerialNum serialNum
         _writeService.sync();
         fastos::TimeStamp visibilityDelay = configSnapshot->getMaintenanceConfigSP()->getVisibilityDelay();
         hasVisibilityDelayChanged = (visibilityDelay != _visibility.getVisibilityDelay());
+        _visibility.setMinVisibilityDelay(configSnapshot->getMaintenanceConfigSP()->getMinVisibilityDelay());
         _visibility.setVisibilityDelay(visibilityDelay);
     }
     if (_visibility.getVisibilityDelay() > 0) {
@@ -422,6 +432,10 @@ DocumentDB::applyConfig(DocumentDBConfig::SP configSnapshot, SerialNum serialNum
     }
     if (params.shouldSubDbsChange() || hasVisibilityDelayChanged) {
         applySubDBConfig(*configSnapshot, serialNum, params);
+        if (params.shouldMatchersChange()) {
+            // cached results were ranked with the old rank profiles
+            _sessionManager->getResultCache().invalidate();
+        }
         if (serialNum < _feedHandler.getSerialNum()) {
             // Not last entry in tls.  Reprocessing should already be done.
             _subDBs.getReprocessingRunner().reset();
@@ -680,7 +694,8 @@ DocumentDB::startTransactionLogReplay()
                                       getBackingStore().lastSyncToken(),
                                       oldestFlushedSerial,
                                       newestFlushedSerial,
-                                      *_config_store);
+                                      *_config_store,
+                                      _writeServiceConfig.indexingThreads());
     _initGate.countDown();
 
     LOG(debug, "DocumentDB(%s): Database started.", _docTypeName.toString().c_str());
@@ -979,6 +994,8 @@ DocumentDB::notifyClusterStateChanged(const IBucketStateCalculator::SP &newCalc)
             cfv->setCalculator(newCalc);
     }
     _subDBs.setBucketStateCalculator(newCalc);
+    // bucket activation may change the set of searchable documents
+    _sessionManager->getResultCache().invalidate();
 }
 
 
@@ -1018,6 +1035,11 @@ updateIndexMetrics(DocumentDBMetricsCollection &metrics, const search::Searchabl
     DocumentDBTaggedMetrics::IndexMetrics &indexMetrics = metrics.getTaggedMetrics().index;
     indexMetrics.diskUsage.set(stats.sizeOnDisk());
     indexMetrics.memoryUsage.update(stats.memoryUsage());
+    const CacheStats &postingListCacheStats = stats.postingListCache();
+    indexMetrics.postingListCache.memoryUsage.set(postingListCacheStats.memory_used);
+    indexMetrics.postingListCache.elements.set(postingListCacheStats.elements);
+    indexMetrics.postingListCache.hits.set(postingListCacheStats.hits);
+    indexMetrics.postingListCache.lookups.set(postingListCacheStats.hits + postingListCacheStats.misses);
 
     LegacyDocumentDBMetrics::IndexMetrics &legacyIndexMetrics = metrics.getLegacyMetrics().index;
     legacyIndexMetrics.memoryUsage.set(stats.memoryUsage().allocatedBytes());
@@ -1243,6 +1265,10 @@ DocumentDB::updateMetrics(DocumentDBMetricsCollection &metrics)
     }
     
     ExecutorThreadingServiceStats threadingServiceStats = _writeService.getStats();
+    {
+        lock_guard guard(_lastExecutorStatsMutex);
+        _lastExecutorStats = std::make_unique<ExecutorThreadingServiceStats>(threadingServiceStats);
+    }
     updateLegacyMetrics(metrics.getLegacyMetrics(), threadingServiceStats);
     updateIndexMetrics(metrics, _subDBs.getReadySubDB()->getSearchableStats());
     updateAttributeMetrics(metrics, _subDBs);
@@ -1250,6 +1276,57 @@ DocumentDB::updateMetrics(DocumentDBMetricsCollection &metrics)
     updateMetrics(metrics.getTaggedMetrics(), threadingServiceStats);
 }
 
+std::unique_ptr<ExecutorThreadingServiceStats>
+DocumentDB::getLastExecutorStats() const
+{
+    lock_guard guard(_lastExecutorStatsMutex);
+    if (!_lastExecutorStats) {
+        return std::unique_ptr<ExecutorThreadingServiceStats>();
+    }
+    return std::make_unique<ExecutorThreadingServiceStats>(*_lastExecutorStats);
+}
+
+ExecutorThreadingServiceStats
+DocumentDB::sampleExecutorStats()
+{
+    return _writeService.getStats();
+}
+
+void
+DocumentDB::reportMemoryUsage(MemoryAccountingNode &node) const
+{
+    for (const auto subDb : _subDBs) {
+        MemoryAccountingNode &subDbNode = node.child(subDb->getName());
+        proton::IAttributeManager::SP attrMgr(subDb->getAttributeManager());
+        if (attrMgr) {
+            MemoryAccountingNode &attrNode = subDbNode.child("attribute");
+            std::vector<search::AttributeGuard> list;
+            attrMgr->getAttributeListAll(list);
+            for (const auto &attr : list) {
+                const search::attribute::Status &status = attr->getStatus();
+                attrNode.child(attr->getName()).add(MemoryUsage(status.getAllocated(), status.getUsed(),
+                                                                status.getDead(), status.getOnHold()));
+            }
+        }
+        if (subDb->getIndexManager()) {
+            search::SearchableStats stats = subDb->getSearchableStats();
+            MemoryAccountingNode &indexNode = subDbNode.child("index");
+            indexNode.add(stats.memoryUsage());
+            size_t cacheUsed = stats.postingListCache().memory_used;
+            indexNode.child("postinglistcache").add(MemoryUsage(cacheUsed, cacheUsed, 0, 0));
+        }
+        const ISummaryManager::SP &summaryMgr = subDb->getSummaryManager();
+        if (summaryMgr) {
+            const search::IDocumentStore &backingStore = summaryMgr->getBackingStore();
+            MemoryAccountingNode &storeNode = subDbNode.child("documentstore");
+            storeNode.add(backingStore.getMemoryUsage());
+            size_t cacheUsed = backingStore.getCacheStats().memory_used;
+            storeNode.child("cache").add(MemoryUsage(cacheUsed, cacheUsed, 0, 0));
+        }
+        subDbNode.child("documentmetastore").add(subDb->getDocumentMetaStoreContext().get().getMemoryUsage());
+    }
+}
+
 void
 DocumentDB::updateLegacyMetrics(LegacyDocumentDBMetrics &metrics, const ExecutorThreadingServiceStats &threadingServiceStats)
 {
@@ -44,6 +44,7 @@ class IDocumentDBOwner;
 class MetricsWireService;
 class StatusReport;
 class ExecutorThreadingServiceStats;
+class MemoryAccountingNode;
 
 namespace matching { class SessionManager; }
 
@@ -131,6 +132,9 @@ private:
 
     // Last updated cache statistics. Necessary due to metrics implementation is upside down.
     search::CacheStats            _lastDocStoreCacheStats;
+    // Executor stats from the last metrics update, for the state explorer.
+    mutable std::mutex            _lastExecutorStatsMutex;
+    std::unique_ptr<ExecutorThreadingServiceStats> _lastExecutorStats;
     IBucketStateCalculator::SP    _calc;
 
     void registerReference();
@@ -259,6 +263,28 @@ public:
         return *_sessionManager;
     }
 
+    const VisibilityHandler &getVisibilityHandler() const { return _visibility; }
+
+    /**
+     * Executor stats for the last metrics interval, or nullptr before
+     * the first metrics update. This is used by the document db
+     * explorer.
+     **/
+    std::unique_ptr<ExecutorThreadingServiceStats> getLastExecutorStats() const;
+
+    /**
+     * Sample the executor stats of the write service. This resets the
+     * stats, so it is only for tools that do not update metrics.
+     **/
+    ExecutorThreadingServiceStats sampleExecutorStats();
+
+    /**
+     * Report memory usage per sub db and component (attributes,
+     * memory index, document store, document meta store) below the
+     * given node.
+     **/
+    void reportMemoryUsage(MemoryAccountingNode &node) const;
+
     /**
      * Frees any allocated resources. This will also stop the internal thread
      * and wait for it to finish. All pending tasks are deleted.
@@ -131,7 +131,9 @@ buildMaintenanceConfig(const BootstrapConfig::SP &bootstrapConfig,
                     proton.lidspacecompaction.interval,
                     proton.lidspacecompaction.allowedlidbloat,
                     proton.lidspacecompaction.allowedlidbloatfactor,
-                    isDocumentTypeGlobal),
+                    isDocumentTypeGlobal,
+                    DocumentDBLidSpaceCompactionConfig().getMaxDocsToScan(),
+                    proton.lidspacecompaction.maxdocstomove),
             AttributeUsageFilterConfig(
                     proton.writefilter.attribute.enumstorelimit,
                     proton.writefilter.attribute.multivaluelimit),
@@ -141,7 +143,8 @@ buildMaintenanceConfig(const BootstrapConfig::SP &bootstrapConfig,
                     proton.maintenancejobs.maxoutstandingmoveops),
             DocumentDBFlushConfig(
                     proton.index.maxflushed,
-                    proton.index.maxflushedretired));
+                    proton.index.maxflushedretired),
+            TimeStamp::Seconds(proton.minvisibilitydelay));
 }
 
 template<typename T>
@@ -158,17 +161,19 @@ deriveCompression(const T & config) {
 }
 
 DocumentStore::Config
-getStoreConfig(const ProtonConfig::Summary::Cache & cache, const HwInfo & hwInfo)
+getStoreConfig(const ProtonConfig::Summary & summary, const HwInfo & hwInfo)
 {
+    const ProtonConfig::Summary::Cache & cache(summary.cache);
     size_t maxBytes = (cache.maxbytes < 0)
                       ? (hwInfo.memory().sizeBytes()*std::min(50l, -cache.maxbytes))/100l
                       : cache.maxbytes;
-    return DocumentStore::Config(deriveCompression(cache.compression), maxBytes, cache.initialentries).allowVisitCaching(cache.allowvisitcaching);
+    return DocumentStore::Config(deriveCompression(cache.compression), maxBytes, cache.initialentries)
+            .allowVisitCaching(cache.allowvisitcaching).setMaxPrefetchHits(std::max(0, summary.prefetch.hits));
 }
 
 LogDocumentStore::Config
 deriveConfig(const ProtonConfig::Summary & summary, const ProtonConfig::Flush::Memory & flush, const HwInfo & hwInfo) {
-    DocumentStore::Config config(getStoreConfig(summary.cache, hwInfo));
+    DocumentStore::Config config(getStoreConfig(summary, hwInfo));
     const ProtonConfig::Summary::Log & log(summary.log);
     const ProtonConfig::Summary::Log::Chunk & chunk(log.chunk);
     WriteableFileChunk::Config fileConfig(deriveCompression(chunk.compression), chunk.maxbytes);
@@ -176,7 +181,11 @@ deriveConfig(const ProtonConfig::Summary & summary, const ProtonConfig::Flush::M
     logConfig.setMaxFileSize(log.maxfilesize)
             .setMaxDiskBloatFactor(std::min(flush.diskbloatfactor, flush.each.diskbloatfactor))
             .setMaxBucketSpread(log.maxbucketspread).setMinFileSizeFactor(log.minfilesizefactor)
+            .setMaxDictionarySize(chunk.dictionary.maxbytes)
             .compact2ActiveFile(log.compact2activefile).compactCompression(deriveCompression(log.compact.compression))
+            .compactByReadFrequency(log.compact.readfrequency)
+            .useLidInfoSnapshot(log.lidinfosnapshot)
+            .setReadThreads(std::max(0, log.readthreads))
             .setFileConfig(fileConfig).disableCrcOnRead(chunk.skipcrconread);
     return LogDocumentStore::Config(config, logConfig);
 }
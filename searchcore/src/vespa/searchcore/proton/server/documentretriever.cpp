@@ -129,6 +129,11 @@ void DocumentRetriever::visitDocuments(const LidVector & lids, search::IDocument
     _doc_store.visit(lids, getDocumentTypeRepo(), populater);
 }
 
+void DocumentRetriever::prefetchDocuments(const LidVector & lids) const
+{
+    _doc_store.prefetch(lids);
+}
+
 void DocumentRetriever::populate(DocumentIdT lid, Document & doc) const
 {
     for (const auto &field : _attributeFields) {
@@ -43,6 +43,7 @@ DocumentSubDBCollection::DocumentSubDBCollection(
         DocumentDBMetricsCollection &metrics,
         matching::QueryLimiter &queryLimiter,
         const vespalib::Clock &clock,
+        const vespalib::eval::ConstantValueFactory &constantValueFactory,
         std::mutex &configMutex,
         const vespalib::string &baseDir,
         const ProtonConfig &protonCfg,
@@ -98,9 +99,11 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                          AttributeMetricsCollection(metrics.getTaggedMetrics().ready.attributes,
                                                     metrics.getLegacyMetrics().ready.attributes),
                         &metrics.getLegacyMetrics().attributes,
-                        metricsWireService),
+                        metricsWireService,
+                        &warmupExecutor),
                         queryLimiter,
                         clock,
+                        constantValueFactory,
                         warmupExecutor)));
     _subDBs.push_back
         (new StoreOnlyDocSubDB(StoreOnlyDocSubDB::Config(docTypeName,
@@ -127,7 +130,8 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                         AttributeMetricsCollection(metrics.getTaggedMetrics().notReady.attributes,
                                                    metrics.getLegacyMetrics().notReady.attributes),
                         NULL,
-                        metricsWireService)));
+                        metricsWireService,
+                        &warmupExecutor)));
 }
 
 
@@ -12,6 +12,7 @@ namespace vespalib {
     class Clock;
     class ThreadExecutor;
     class ThreadStackExecutorBase;
+    namespace eval { struct ConstantValueFactory; }
 }
 
 namespace search {
@@ -88,6 +89,7 @@ public:
             DocumentDBMetricsCollection &metrics,
             matching::QueryLimiter & queryLimiter,
             const vespalib::Clock &clock,
+            const vespalib::eval::ConstantValueFactory &constantValueFactory,
             std::mutex &configMutex,
             const vespalib::string &baseDir,
             const vespa::config::search::core::ProtonConfig &protonCfg,
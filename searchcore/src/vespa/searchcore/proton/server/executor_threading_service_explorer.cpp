@@ -0,0 +1,68 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "executor_threading_service_explorer.h"
+#include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+
+using vespalib::ExecutorStats;
+using namespace vespalib::slime;
+
+namespace proton {
+
+namespace {
+
+void
+convertExecutorStatsToSlime(const ExecutorStats &stats, bool full, Cursor &object)
+{
+    object.setDouble("utilization", stats.getUtilization());
+    object.setDouble("cpuUtilization", stats.getCpuUtilization());
+    object.setLong("maxPending", stats.maxPendingTasks);
+    object.setLong("accepted", stats.acceptedTasks);
+    object.setLong("rejected", stats.rejectedTasks);
+    object.setLong("executed", stats.executedTasks);
+    object.setDouble("averageWaitTime", stats.getAverageWaitTime());
+    object.setDouble("maxWaitTime", stats.maxWaitTime);
+    object.setDouble("runTime50Percentile", stats.getRunTimePercentile(0.50));
+    object.setDouble("runTime99Percentile", stats.getRunTimePercentile(0.99));
+    if (full) {
+        object.setLong("threads", stats.threads);
+        object.setDouble("wallTime", stats.wallTime);
+        object.setDouble("busyTime", stats.busyTime);
+        object.setDouble("cpuTime", stats.cpuTime);
+        object.setDouble("waitTime", stats.waitTime);
+        Cursor &histogram = object.setArray("runTimeHistogram");
+        for (size_t i = 0; i < ExecutorStats::NUM_RUN_TIME_BUCKETS; ++i) {
+            if (stats.runTimeHistogram[i] != 0) {
+                Cursor &bucket = histogram.addObject();
+                bucket.setDouble("below", ExecutorStats::runTimeBucketLimit(i));
+                bucket.setLong("count", stats.runTimeHistogram[i]);
+            }
+        }
+    }
+}
+
+}
+
+ExecutorThreadingServiceExplorer::ExecutorThreadingServiceExplorer(std::unique_ptr<ExecutorThreadingServiceStats> stats)
+    : _stats(std::move(stats))
+{
+}
+
+ExecutorThreadingServiceExplorer::~ExecutorThreadingServiceExplorer() = default;
+
+void
+ExecutorThreadingServiceExplorer::get_state(const vespalib::slime::Inserter &inserter, bool full) const
+{
+    Cursor &object = inserter.insertObject();
+    if (!_stats) {
+        return;
+    }
+    convertExecutorStatsToSlime(_stats->getMasterExecutorStats(), full, object.setObject("master"));
+    convertExecutorStatsToSlime(_stats->getIndexExecutorStats(), full, object.setObject("index"));
+    convertExecutorStatsToSlime(_stats->getSummaryExecutorStats(), full, object.setObject("summary"));
+    convertExecutorStatsToSlime(_stats->getIndexFieldInverterExecutorStats(), full, object.setObject("indexFieldInverter"));
+    convertExecutorStatsToSlime(_stats->getIndexFieldWriterExecutorStats(), full, object.setObject("indexFieldWriter"));
+    convertExecutorStatsToSlime(_stats->getAttributeFieldWriterExecutorStats(), full, object.setObject("attributeFieldWriter"));
+}
+
+} // namespace proton
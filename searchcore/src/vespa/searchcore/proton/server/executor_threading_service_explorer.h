@@ -0,0 +1,28 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/net/state_explorer.h>
+#include <memory>
+
+namespace proton {
+
+class ExecutorThreadingServiceStats;
+
+/**
+ * Class used to explore the executors of a document db, using the
+ * stats from the last metrics interval.
+ */
+class ExecutorThreadingServiceExplorer : public vespalib::StateExplorer
+{
+private:
+    std::unique_ptr<ExecutorThreadingServiceStats> _stats;
+
+public:
+    ExecutorThreadingServiceExplorer(std::unique_ptr<ExecutorThreadingServiceStats> stats);
+    ~ExecutorThreadingServiceExplorer();
+
+    void get_state(const vespalib::slime::Inserter &inserter, bool full) const override;
+};
+
+} // namespace proton
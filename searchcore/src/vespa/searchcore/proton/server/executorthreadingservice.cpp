@@ -2,24 +2,44 @@
 
 #include "executorthreadingservice.h"
 #include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
+#include <vespa/searchlib/common/adaptivesequencedtaskexecutor.h>
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
 
 using vespalib::ThreadStackExecutorBase;
+using search::AdaptiveSequencedTaskExecutor;
 using search::SequencedTaskExecutor;
 
 namespace proton {
 
+namespace {
+
+/*
+ * Attribute writes are spread over more strands than threads, so
+ * that hot attributes are less likely to share a strand. Any thread
+ * can run any strand.
+ */
+constexpr uint32_t attributeFieldWriterStrandsPerThread = 4;
+
+using vespalib::Runnable;
+
+VESPA_THREAD_STACK_TAG(proton_feed_master_executor);
+VESPA_THREAD_STACK_TAG(proton_feed_index_executor);
+VESPA_THREAD_STACK_TAG(proton_feed_summary_executor);
+
+}
+
 ExecutorThreadingService::ExecutorThreadingService(uint32_t threads, uint32_t stackSize, uint32_t taskLimit)
 
-    : _masterExecutor(1, stackSize),
-      _indexExecutor(1, stackSize, taskLimit),
-      _summaryExecutor(1, stackSize, taskLimit),
+    : _masterExecutor(1, stackSize, proton_feed_master_executor),
+      _indexExecutor(1, stackSize, taskLimit, proton_feed_index_executor),
+      _summaryExecutor(1, stackSize, taskLimit, proton_feed_summary_executor),
       _masterService(_masterExecutor),
       _indexService(_indexExecutor),
       _summaryService(_summaryExecutor),
       _indexFieldInverter(std::make_unique<SequencedTaskExecutor>(threads, taskLimit)),
       _indexFieldWriter(std::make_unique<SequencedTaskExecutor>(threads, taskLimit)),
-      _attributeFieldWriter(std::make_unique<SequencedTaskExecutor>(threads, taskLimit))
+      _attributeFieldWriter(std::make_unique<AdaptiveSequencedTaskExecutor>(threads * attributeFieldWriterStrandsPerThread,
+                                                                            threads, taskLimit))
 {
 }
 
@@ -6,7 +6,10 @@
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 
-namespace search { class SequencedTaskExecutor; }
+namespace search {
+class AdaptiveSequencedTaskExecutor;
+class SequencedTaskExecutor;
+}
 namespace proton {
 
 class ExecutorThreadingServiceStats;
@@ -26,7 +29,7 @@ private:
     ExecutorThreadService _summaryService;
     std::unique_ptr<search::SequencedTaskExecutor> _indexFieldInverter;
     std::unique_ptr<search::SequencedTaskExecutor> _indexFieldWriter;
-    std::unique_ptr<search::SequencedTaskExecutor> _attributeFieldWriter;
+    std::unique_ptr<search::AdaptiveSequencedTaskExecutor> _attributeFieldWriter;
 
 public:
     /**
@@ -72,7 +72,8 @@ FastAccessDocSubDB::createAttributeManagerInitializer(const DocumentDBConfig &co
                                                _fileHeaderContext,
                                                _writeService.attributeFieldWriter(),
                                                attrFactory,
-                                               _hwInfo);
+                                               _hwInfo,
+                                               _attributeLoadExecutor);
     return std::make_shared<AttributeManagerInitializer>(configSerialNum,
                                                          documentMetaStoreInitTask,
                                                          documentMetaStore,
@@ -208,6 +209,7 @@ FastAccessDocSubDB::FastAccessDocSubDB(const Config &cfg, const Context &ctx)
       _totalAttributeMetrics(ctx._totalAttributeMetrics),
       _addMetrics(cfg._addMetrics),
       _metricsWireService(ctx._metricsWireService),
+      _attributeLoadExecutor(ctx._attributeLoadExecutor),
       _docIdLimit(0)
 { }
 
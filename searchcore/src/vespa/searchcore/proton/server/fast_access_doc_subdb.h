@@ -48,14 +48,17 @@ public:
         const AttributeMetricsCollection &_subAttributeMetrics;
         LegacyAttributeMetrics          *_totalAttributeMetrics;
         MetricsWireService              &_metricsWireService;
+        vespalib::Executor              *_attributeLoadExecutor;
         Context(const StoreOnlyDocSubDB::Context &storeOnlyCtx,
                 const AttributeMetricsCollection &subAttributeMetrics,
                 LegacyAttributeMetrics *totalAttributeMetrics,
-                MetricsWireService &metricsWireService)
+                MetricsWireService &metricsWireService,
+                vespalib::Executor *attributeLoadExecutor = nullptr)
         : _storeOnlyCtx(storeOnlyCtx),
           _subAttributeMetrics(subAttributeMetrics),
           _totalAttributeMetrics(totalAttributeMetrics),
-          _metricsWireService(metricsWireService)
+          _metricsWireService(metricsWireService),
+          _attributeLoadExecutor(attributeLoadExecutor)
         { }
     };
 
@@ -86,6 +89,7 @@ protected:
 
     const bool           _addMetrics;
     MetricsWireService  &_metricsWireService;
+    vespalib::Executor  *_attributeLoadExecutor;
     DocIdLimit           _docIdLimit;
 
     AttributeCollectionSpec::UP createAttributeSpec(const AttributesConfig &attrCfg, SerialNum serialNum) const;
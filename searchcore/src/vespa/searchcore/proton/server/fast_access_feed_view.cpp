@@ -45,6 +45,12 @@ FastAccessFeedView::updateAttributes(SerialNum serialNum, Lid lid, FutureDoc doc
     }
 }
 
+bool
+FastAccessFeedView::attributesNeedUpdatedDocument() const
+{
+    return _attributeWriter->hasStructFieldAttribute();
+}
+
 void
 FastAccessFeedView::removeAttributes(SerialNum serialNum, search::DocumentIdT lid,
                                      bool immediateCommit, OnRemoveDoneType onWriteDone)
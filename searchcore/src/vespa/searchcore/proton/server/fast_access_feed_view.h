@@ -46,6 +46,7 @@ private:
                           bool immediateCommit, OnOperationDoneType onWriteDone, IFieldUpdateCallback & onUpdate) override;
     void updateAttributes(SerialNum serialNum, Lid lid, FutureDoc doc,
                           bool immediateCommit, OnOperationDoneType onWriteDone) override;
+    bool attributesNeedUpdatedDocument() const override;
     void removeAttributes(SerialNum serialNum, search::DocumentIdT lid,
                           bool immediateCommit, OnRemoveDoneType onWriteDone) override;
 
@@ -180,6 +180,9 @@ public:
      * @param flushedSummaryMgrSerial The flushed serial number of the
      *                                document store.
      * @param config_store            Reference to the config store.
+     * @param decodeThreads           Number of threads used to deserialize
+     *                                operations, or 0 to deserialize them
+     *                                in the master thread.
      */
 
     void
@@ -187,7 +190,8 @@ public:
                          SerialNum flushedSummaryMgrSerial,
                          SerialNum oldestFlushedSerial,
                          SerialNum newestFlushedSerial,
-                         ConfigStore &config_store);
+                         ConfigStore &config_store,
+                         uint32_t decodeThreads = 0);
 
     /**
      * Called when a flush is done and allows pruning of the transaction log.
@@ -11,6 +11,9 @@
 #include <vespa/searchlib/common/idestructorcallback.h>
 #include <vespa/vespalib/util/closuretask.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/gate.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 
 #include <vespa/log/log.h>
@@ -22,6 +25,7 @@ using search::SerialNum;
 using vespalib::Executor;
 using vespalib::IllegalStateException;
 using vespalib::makeClosure;
+using vespalib::makeLambdaTask;
 using vespalib::makeTask;
 using vespalib::make_string;
 using proton::bucketdb::IBucketDBHandler;
@@ -64,6 +68,101 @@ handlePacket(PacketWrapper::SP wrap, EntryHandler entryHandler)
     wrap->gate.countDown();
 }
 
+struct DecodedOperation {
+    FeedOperation::UP op;
+    std::exception_ptr error;
+    vespalib::Gate done;
+};
+
+/**
+ * Decodes the given entries in parallel, while replaying them in order
+ * as soon as each one is decoded. None of the entries can be new config
+ * operations, so the deserialize repo does not change meanwhile.
+ */
+void
+decodeAndReplay(const std::vector<Packet::Entry> &entries, size_t start, size_t end,
+                ReplayPacketDispatcher &dispatcher, const document::DocumentTypeRepo &repo,
+                Executor &decodeExecutor, TlsReplayProgress *progress)
+{
+    std::vector<DecodedOperation> decoded(end - start);
+    for (size_t i(start); i < end; ++i) {
+        DecodedOperation &result = decoded[i - start];
+        const Packet::Entry &entry = entries[i];
+        Executor::Task::UP rejected = decodeExecutor.execute(makeLambdaTask([&result, &entry, &repo]() {
+            try {
+                result.op = ReplayPacketDispatcher::decodeEntry(entry, repo);
+            } catch (...) {
+                result.error = std::current_exception();
+            }
+            result.done.countDown();
+        }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    // All decode tasks must be done before returning, as they refer to local state.
+    std::exception_ptr error;
+    for (size_t i(start); i < end; ++i) {
+        DecodedOperation &result = decoded[i - start];
+        result.done.await();
+        if (error) {
+            continue;
+        }
+        try {
+            if (result.error) {
+                std::rethrow_exception(result.error);
+            }
+            dispatcher.replayOperation(*result.op);
+            result.op.reset();
+            if (progress != NULL) {
+                handleProgress(*progress, entries[i].serial());
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * Replays a packet while deserializing its operations in the decode
+ * executor. New config operations are replayed by the calling thread,
+ * after all operations before them, and operations after them are
+ * deserialized with the new repo.
+ */
+void
+handlePacketParallel(PacketWrapper::SP wrap, IReplayPacketHandler *packetHandler, Executor *decodeExecutor)
+{
+    std::vector<Packet::Entry> entries;
+    vespalib::nbostream_longlivedbuf handle(wrap->packet.getHandle().c_str(), wrap->packet.getHandle().size());
+    while (handle.size() > 0) {
+        entries.emplace_back();
+        entries.back().deserialize(handle);
+    }
+    ReplayPacketDispatcher dispatcher(*packetHandler);
+    size_t start(0);
+    while (start < entries.size()) {
+        size_t end(start);
+        while ((end < entries.size()) && (entries[end].type() != FeedOperation::NEW_CONFIG)) {
+            ++end;
+        }
+        decodeAndReplay(entries, start, end, dispatcher, packetHandler->getDeserializeRepo(),
+                        *decodeExecutor, wrap->progress);
+        if (end < entries.size()) {
+            dispatcher.replayEntry(entries[end]);
+            if (wrap->progress != NULL) {
+                handleProgress(*wrap->progress, entries[end].serial());
+            }
+            ++end;
+        }
+        start = end;
+    }
+    wrap->result = RPC::OK;
+    wrap->gate.countDown();
+}
+
 class TransactionLogReplayPacketHandler : public IReplayPacketHandler {
     IFeedView *& _feed_view_ptr;  // Pointer can be changed in executor thread.
     IBucketDBHandler &_bucketDBHandler;
@@ -152,16 +251,31 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IFeedView *& feed_view_ptr,
         IBucketDBHandler &bucketDBHandler,
         IReplayConfig &replay_config,
-        FeedConfigStore &config_store)
+        FeedConfigStore &config_store,
+        uint32_t decodeThreads)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
       _packet_handler(new TransactionLogReplayPacketHandler(
                       feed_view_ptr, bucketDBHandler,
-                      replay_config, config_store)) {
+                      replay_config, config_store)),
+      _decodeExecutor() {
+    if (decodeThreads > 0) {
+        _decodeExecutor = std::make_unique<vespalib::ThreadStackExecutor>(decodeThreads, 128 * 1024);
+    }
 }
 
+ReplayTransactionLogState::~ReplayTransactionLogState() = default;
+
 void ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap,
                                         Executor &executor) {
+    if (_decodeExecutor) {
+        IReplayPacketHandler *packetHandler = _packet_handler.get();
+        Executor *decodeExecutor = _decodeExecutor.get();
+        executor.execute(makeLambdaTask([wrap, packetHandler, decodeExecutor]() {
+            handlePacketParallel(wrap, packetHandler, decodeExecutor);
+        }));
+        return;
+    }
     EntryHandler closure = makeClosure(&startDispatch, _packet_handler.get());
     executor.execute(makeTask(makeClosure(&handlePacket, wrap, std::move(closure))));
 }
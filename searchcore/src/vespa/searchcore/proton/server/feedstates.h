@@ -6,6 +6,8 @@
 #include <vespa/searchcore/proton/server/feedstate.h>
 #include <vespa/searchcore/proton/server/ireplaypackethandler.h>
 
+namespace vespalib { class ThreadStackExecutor; }
+
 namespace proton {
 
 /**
@@ -42,17 +44,23 @@ public:
 /**
  * The feed handler is replaying the transaction log.
  * Replayed messages from the transaction log are sent to the active feed view.
+ *
+ * With decode threads, operations are deserialized by a separate executor
+ * while the executor given to receive() replays them in serial number order.
  */
 class ReplayTransactionLogState : public FeedState {
     vespalib::string _doc_type_name;
     std::unique_ptr<IReplayPacketHandler> _packet_handler;
+    std::unique_ptr<vespalib::ThreadStackExecutor> _decodeExecutor;
 
 public:
     ReplayTransactionLogState(const vespalib::string &name,
             IFeedView *& feed_view_ptr,
             bucketdb::IBucketDBHandler &bucketDBHandler,
             IReplayConfig &replay_config,
-            FeedConfigStore &config_store);
+            FeedConfigStore &config_store,
+            uint32_t decodeThreads = 0);
+    ~ReplayTransactionLogState() override;
 
     void handleOperation(FeedToken, FeedOperationUP op) override {
         throwExceptionInHandleOperation(_doc_type_name, *op);
@@ -28,10 +28,13 @@ class ForceCommitContext : public search::IDestructorCallback
     std::unique_ptr<ForceCommitDoneTask> _task;
     uint32_t    _committedDocIdLimit;
     DocIdLimit *_docIdLimit;
+    // Dropped last, after the committed docid limit has been bumped
+    std::shared_ptr<search::IDestructorCallback> _onDone;
 
 public:
     ForceCommitContext(vespalib::Executor &executor,
-                       IDocumentMetaStore &documentMetaStore);
+                       IDocumentMetaStore &documentMetaStore,
+                       std::shared_ptr<search::IDestructorCallback> onDone);
 
     ~ForceCommitContext() override;
 
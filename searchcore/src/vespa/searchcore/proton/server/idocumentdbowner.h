@@ -5,6 +5,8 @@
 #include <memory>
 #include <cstdint>
 
+namespace vespalib::eval { struct ConstantValueFactory; }
+
 namespace proton {
 
 class IDocumentDBReferenceRegistry;
@@ -17,6 +19,12 @@ public:
     virtual bool isInitializing() const = 0;
     virtual uint32_t getDistributionKey() const = 0;
     virtual std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const = 0;
+    /**
+     * Factory for rank constants, shared by all document dbs so that a
+     * constant used by several rank profiles or document types is only
+     * loaded once.
+     **/
+    virtual const vespalib::eval::ConstantValueFactory &getConstantValueFactory() const = 0;
 };
 
 } // namespace proton
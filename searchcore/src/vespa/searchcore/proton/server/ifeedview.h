@@ -59,6 +59,11 @@ public:
     virtual void heartBeat(search::SerialNum serialNum) = 0;
     virtual void sync() = 0;
     virtual void forceCommit(search::SerialNum serialNum) = 0;
+    /**
+     * Force commit, dropping onDone once the committed changes are
+     * visible to searches.
+     */
+    virtual void forceCommit(search::SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onDone) = 0;
     virtual void handlePruneRemovedDocuments(const PruneRemovedDocumentsOperation & pruneOp) = 0;
     virtual void handleCompactLidSpace(const CompactLidSpaceOperation &op) = 0;
 };
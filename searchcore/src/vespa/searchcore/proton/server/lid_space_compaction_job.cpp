@@ -45,24 +45,29 @@ LidSpaceCompactionJob::getNextDocument(const LidUsageStats &stats)
 bool
 LidSpaceCompactionJob::scanDocuments(const LidUsageStats &stats)
 {
-    if (_scanItr->valid()) {
-        DocumentMetaData document = getNextDocument(stats);
-        if (document.valid()) {
-            IFrozenBucketHandler::ExclusiveBucketGuard::UP bucketGuard = _frozenHandler.acquireExclusiveBucket(document.bucketId);
-            if ( ! bucketGuard ) {
-                // the job is blocked until the bucket for this document is thawed
-                setBlocked(BlockedReason::FROZEN_BUCKET);
-                _retryFrozenDocument = true;
-                return true;
-            } else {
-                MoveOperation::UP op = _handler.createMoveOperation(document, stats.getLowestFreeLid());
-                search::IDestructorCallback::SP context = _moveOpsLimiter->beginOperation();
-                _opStorer.storeOperation(*op, context);
-                _handler.handleMove(*op, std::move(context));
-                if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
-                    return true;
-                }
-            }
+    // Move up to max docs to move per run, each to the then lowest free lid
+    LidUsageStats currStats = stats;
+    for (uint32_t moved = 0; (moved < _cfg.getMaxDocsToMove()) && _scanItr->valid(); ++moved) {
+        if (moved > 0) {
+            currStats = _handler.getLidStatus();
+        }
+        DocumentMetaData document = getNextDocument(currStats);
+        if ( ! document.valid()) {
+            break;
+        }
+        IFrozenBucketHandler::ExclusiveBucketGuard::UP bucketGuard = _frozenHandler.acquireExclusiveBucket(document.bucketId);
+        if ( ! bucketGuard ) {
+            // the job is blocked until the bucket for this document is thawed
+            setBlocked(BlockedReason::FROZEN_BUCKET);
+            _retryFrozenDocument = true;
+            return true;
+        }
+        MoveOperation::UP op = _handler.createMoveOperation(document, currStats.getLowestFreeLid());
+        search::IDestructorCallback::SP context = _moveOpsLimiter->beginOperation();
+        _opStorer.storeOperation(*op, context);
+        _handler.handleMove(*op, std::move(context));
+        if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
+            return true;
         }
     }
     if (!_scanItr->valid()){
@@ -109,7 +109,10 @@ MaintenanceJobsInjector::injectJobs(MaintenanceController &controller,
     controller.registerJobInMasterThread(MUP(new HeartBeatJob(hbHandler, config.getHeartBeatConfig())));
     controller.registerJobInDefaultPool(MUP(new PruneSessionCacheJob(scPruner, config.getSessionCachePruneInterval())));
     if (config.getVisibilityDelay() > 0) {
-        controller.registerJobInMasterThread(MUP(new DocumentDBCommitJob(commit, config.getVisibilityDelay())));
+        fastos::TimeStamp minVisibilityDelay = config.getMinVisibilityDelay();
+        fastos::TimeStamp commitInterval = ((minVisibilityDelay > 0) && (minVisibilityDelay < config.getVisibilityDelay()))
+                                           ? minVisibilityDelay : config.getVisibilityDelay();
+        controller.registerJobInMasterThread(MUP(new DocumentDBCommitJob(commit, commitInterval)));
     }
     const MaintenanceDocumentSubDB &mRemSubDB(controller.getRemSubDB());
     MUP pruneRDjob(new PruneRemovedDocumentsJob(config.getPruneRemovedDocumentsConfig(), *mRemSubDB._metaStore,
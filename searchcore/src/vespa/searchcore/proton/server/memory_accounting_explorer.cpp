@@ -0,0 +1,43 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "memory_accounting_explorer.h"
+#include "disk_mem_usage_filter.h"
+#include <vespa/searchcore/proton/common/memory_accounting.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+
+using namespace vespalib::slime;
+
+namespace proton {
+
+MemoryAccountingExplorer::MemoryAccountingExplorer(MemoryAccountingRegistry &registry,
+                                                   const DiskMemUsageFilter *usageFilter)
+    : _registry(registry),
+      _usageFilter(usageFilter)
+{
+}
+
+void
+MemoryAccountingExplorer::get_state(const vespalib::slime::Inserter &inserter, bool full) const
+{
+    Cursor &object = inserter.insertObject();
+    double seconds = 0.0;
+    MemoryAccountingNode::UP root = _registry.collect(seconds);
+    if (seconds > 0.0) {
+        object.setDouble("interval", seconds);
+    }
+    size_t allocated = root->getTotal().allocatedBytes();
+    if (full) {
+        root->convertToSlime(object);
+    } else {
+        object.setLong("allocated", allocated);
+    }
+    if (_usageFilter != nullptr) {
+        vespalib::ProcessMemoryStats stats = _usageFilter->getMemoryStats();
+        size_t rss = stats.getAnonymousRss() + stats.getMappedRss();
+        object.setLong("rss", rss);
+        // allocations not attributed to any component, e.g. network buffers and query setup
+        object.setLong("unaccounted", int64_t(rss) - int64_t(allocated));
+    }
+}
+
+} // namespace proton
@@ -0,0 +1,28 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/net/state_explorer.h>
+
+namespace proton {
+
+class DiskMemUsageFilter;
+class MemoryAccountingRegistry;
+
+/**
+ * Class used to explore the memory usage of proton per component,
+ * with the change since the previous time it was explored.
+ */
+class MemoryAccountingExplorer : public vespalib::StateExplorer
+{
+private:
+    MemoryAccountingRegistry &_registry;
+    const DiskMemUsageFilter *_usageFilter;
+
+public:
+    MemoryAccountingExplorer(MemoryAccountingRegistry &registry, const DiskMemUsageFilter *usageFilter);
+
+    void get_state(const vespalib::slime::Inserter &inserter, bool full) const override;
+};
+
+} // namespace proton
@@ -123,6 +123,38 @@ computeGain(const IFlushTarget::DiskGain & gain) {
 
 }
 
+/**
+ * The transaction log of a handler can only be pruned up to the oldest
+ * flushed serial number among its targets. Flushing the oldest target
+ * thus saves the log bytes up to the next oldest target, while flushing
+ * any other target saves nothing yet. Dividing by the bytes written
+ * lets a cheap flush that frees a lot of log go before a large one.
+ */
+MemoryFlush::TlsGainPerWriteCost
+MemoryFlush::calculateTlsGainPerWriteCost(const FlushContext::List &targetList,
+                                          const flushengine::TlsStatsMap &tlsStatsMap)
+{
+    std::map<vespalib::string, FlushContext::List> perHandler;
+    for (const auto &ctx : targetList) {
+        perHandler[ctx->getHandler()->getName()].push_back(ctx);
+    }
+    TlsGainPerWriteCost result;
+    for (auto &entry : perHandler) {
+        FlushContext::List &contexts = entry.second;
+        std::sort(contexts.begin(), contexts.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs->getTarget()->getFlushedSerialNum() < rhs->getTarget()->getFlushedSerialNum();
+        });
+        const TlsStats &tlsStats = tlsStatsMap.getTlsStats(entry.first);
+        const IFlushTarget &oldest = *contexts[0]->getTarget();
+        uint64_t neededAfter = (contexts.size() > 1)
+                               ? estimateNeededTlsSizeForFlushTarget(tlsStats, contexts[1]->getTarget()->getFlushedSerialNum())
+                               : 0u;
+        uint64_t gain = estimateNeededTlsSizeForFlushTarget(tlsStats, oldest.getFlushedSerialNum()) - neededAfter;
+        result[contexts[0].get()] = double(gain) / std::max(oldest.getApproxBytesToWriteToDisk(), UINT64_C(1));
+    }
+    return result;
+}
+
 FlushContext::List
 MemoryFlush::getFlushTargets(const FlushContext::List &targetList,
                              const flushengine::TlsStatsMap & tlsStatsMap) const
@@ -197,7 +229,11 @@ MemoryFlush::getFlushTargets(const FlushContext::List &targetList,
         }
     }
     FlushContext::List fv(targetList);
-    std::sort(fv.begin(), fv.end(), CompareTarget(order, tlsStatsMap));
+    TlsGainPerWriteCost tlsGainPerWriteCost;
+    if (order == TLSSIZE) {
+        tlsGainPerWriteCost = calculateTlsGainPerWriteCost(targetList, tlsStatsMap);
+    }
+    std::sort(fv.begin(), fv.end(), CompareTarget(order, tlsStatsMap, tlsGainPerWriteCost));
     // No desired order and no urgent needs; no flush required at this moment.
     if (order == DEFAULT &&
         !fv.empty() &&
@@ -232,6 +268,13 @@ MemoryFlush::CompareTarget::operator()(const FlushContext::SP &lfc, const FlushC
     case MEMORY:
         return (lhs.getApproxMemoryGain().gain() > rhs.getApproxMemoryGain().gain());
     case TLSSIZE: {
+        auto lhsGain = _tlsGainPerWriteCost.find(lfc.get());
+        auto rhsGain = _tlsGainPerWriteCost.find(rfc.get());
+        double lhsGainPerWriteCost = (lhsGain != _tlsGainPerWriteCost.end()) ? lhsGain->second : 0.0;
+        double rhsGainPerWriteCost = (rhsGain != _tlsGainPerWriteCost.end()) ? rhsGain->second : 0.0;
+        if (lhsGainPerWriteCost != rhsGainPerWriteCost) {
+            return (lhsGainPerWriteCost > rhsGainPerWriteCost);
+        }
         const flushengine::TlsStats &lhsTlsStats = _tlsStatsMap.getTlsStats(lfc->getHandler()->getName());
         const flushengine::TlsStats &rhsTlsStats = _tlsStatsMap.getTlsStats(rfc->getHandler()->getName());
         SerialNum lhsFlushedSerialNum(lhs.getFlushedSerialNum());
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <vespa/searchcore/proton/flushengine/iflushstrategy.h>
+#include <map>
 #include <mutex>
 
 namespace proton {
@@ -44,20 +45,30 @@ private:
     /// The time when the strategy was started.
     fastos::TimeStamp  _startTime;
 
+    /// Transaction log bytes no longer needed per byte written, for each target
+    using TlsGainPerWriteCost = std::map<const FlushContext *, double>;
+
     class CompareTarget
     {
     public:
-        CompareTarget(OrderType order, const flushengine::TlsStatsMap &tlsStatsMap)
+        CompareTarget(OrderType order, const flushengine::TlsStatsMap &tlsStatsMap,
+                      const TlsGainPerWriteCost &tlsGainPerWriteCost)
             : _order(order),
-              _tlsStatsMap(tlsStatsMap)
+              _tlsStatsMap(tlsStatsMap),
+              _tlsGainPerWriteCost(tlsGainPerWriteCost)
         { }
 
         bool operator ()(const FlushContext::SP &lfc, const FlushContext::SP &rfc) const;
     private:
         OrderType     _order;
         const flushengine::TlsStatsMap &_tlsStatsMap;
+        const TlsGainPerWriteCost      &_tlsGainPerWriteCost;
     };
 
+    static TlsGainPerWriteCost
+    calculateTlsGainPerWriteCost(const FlushContext::List &targetList,
+                                 const flushengine::TlsStatsMap &tlsStatsMap);
+
 public:
     using SP = std::shared_ptr<MemoryFlush>;
 
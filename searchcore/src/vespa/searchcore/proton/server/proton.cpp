@@ -4,6 +4,7 @@
 #include "document_db_explorer.h"
 #include "fileconfigmanager.h"
 #include "flushhandlerproxy.h"
+#include "memory_accounting_explorer.h"
 #include "memoryflush.h"
 #include "persistencehandlerproxy.h"
 #include "prepare_restart_handler.h"
@@ -22,6 +23,8 @@
 #include <vespa/searchcore/proton/summaryengine/summaryengine.h>
 #include <vespa/searchcore/proton/summaryengine/docsum_by_slime.h>
 #include <vespa/searchcore/proton/matchengine/matchengine.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/searchlib/common/background_write_limiter.h>
 #include <vespa/searchlib/transactionlog/trans_log_server_explorer.h>
 #include <vespa/searchlib/util/fileheadertk.h>
 #include <vespa/document/base/exceptions.h>
@@ -60,6 +63,10 @@ namespace proton {
 namespace {
 
 using search::fs4transport::FS4PersistentPacketStreamer;
+using vespalib::Runnable;
+
+VESPA_THREAD_STACK_TAG(proton_shared_summary_executor);
+VESPA_THREAD_STACK_TAG(proton_warmup_executor);
 
 CompressionConfig::Type
 convert(InternalProtonType::Packetcompresstype type)
@@ -177,6 +184,9 @@ Proton::Proton(const config::ConfigUri & configUri,
       _diskMemUsageSampler(),
       _persistenceEngine(),
       _documentDBMap(),
+      _memoryAccounting(),
+      _documentDBMemoryReporter(*this),
+      _documentDBMemoryRegistration(_memoryAccounting.add("documentdb", _documentDBMemoryReporter)),
       _matchEngine(),
       _summaryEngine(),
       _docsumBySlime(),
@@ -198,6 +208,8 @@ Proton::Proton(const config::ConfigUri & configUri,
       _warmupExecutor(),
       _summaryExecutor(),
       _queryLimiter(),
+      _tensorLoader(vespalib::tensor::DefaultTensorEngine::ref()),
+      _constantValueCache(_tensorLoader),
       _clock(0.010),
       _threadPool(128 * 1024),
       _configGen(0),
@@ -249,7 +261,8 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
     _fileHeaderContext.setClusterName(protonConfig.clustername, protonConfig.basedir);
     _matchEngine = std::make_unique<MatchEngine>(protonConfig.numsearcherthreads,
                                                  protonConfig.numthreadspersearch,
-                                                 protonConfig.distributionkey);
+                                                 protonConfig.distributionkey,
+                                                 protonConfig.numa.bindsearchthreads);
     _distributionKey = protonConfig.distributionkey;
     _summaryEngine= std::make_unique<SummaryEngine>(protonConfig.numsummarythreads);
     _docsumBySlime = std::make_unique<DocsumBySlime>(*_summaryEngine);
@@ -290,10 +303,10 @@ Proton::init(const BootstrapConfig::SP & configSnapshot)
 
 
     vespalib::string fileConfigId;
-    _warmupExecutor.reset(new vespalib::ThreadStackExecutor(4, 128*1024));
+    _warmupExecutor.reset(new vespalib::ThreadStackExecutor(4, 128*1024, proton_warmup_executor));
 
     const size_t summaryThreads = deriveCompactionCompressionThreads(protonConfig, hwInfo.cpu());
-    _summaryExecutor.reset(new vespalib::BlockingThreadStackExecutor(summaryThreads, 128*1024, summaryThreads*16));
+    _summaryExecutor.reset(new vespalib::BlockingThreadStackExecutor(summaryThreads, 128*1024, summaryThreads*16, proton_shared_summary_executor));
     InitializeThreads initializeThreads;
     if (protonConfig.initialize.threads > 0) {
         initializeThreads = std::make_shared<vespalib::ThreadStackExecutor>(protonConfig.initialize.threads, 128 * 1024);
@@ -345,9 +358,14 @@ Proton::applyConfig(const BootstrapConfig::SP & configSnapshot)
     _queryLimiter.configure(protonConfig.search.memory.limiter.maxthreads,
                             protonConfig.search.memory.limiter.mincoverage,
                             protonConfig.search.memory.limiter.minhits);
+    int maxMatchThreads = protonConfig.search.matchthreads.max;
+    _queryLimiter.configureMatchThreads((maxMatchThreads == 0)
+                                        ? configSnapshot->getHwInfo().cpu().cores()
+                                        : std::max(maxMatchThreads, 0));
     const std::shared_ptr<const DocumentTypeRepo> repo = configSnapshot->getDocumentTypeRepoSP();
 
     _diskMemUsageSampler->setConfig(diskMemUsageSamplerConfig(protonConfig, configSnapshot->getHwInfo()));
+    search::BackgroundWriteLimiter::instance().setMaxBytesPerSecond(protonConfig.flush.io.maxbytespersecond);
     if (_memoryFlushConfigUpdater) {
         _memoryFlushConfigUpdater->setConfig(protonConfig.flush.memory);
         _flushEngine->kick();
@@ -398,6 +416,7 @@ Proton::~Proton()
     _customComponentRootToken.reset();
     _customComponentBindToken.reset();
     _stateServer.reset();
+    _documentDBMemoryRegistration.reset();
     if (_metricsEngine) {
         _metricsEngine->removeMetricsHook(_metricsHook);
         _metricsEngine->stop();
@@ -792,6 +811,7 @@ const vespalib::string DOCUMENT_DB = "documentdb";
 const vespalib::string FLUSH_ENGINE = "flushengine";
 const vespalib::string TLS_NAME = "tls";
 const vespalib::string RESOURCE_USAGE = "resourceusage";
+const vespalib::string MEMORY_USAGE = "memory";
 
 struct StateExplorerProxy : vespalib::StateExplorer {
     const StateExplorer &explorer;
@@ -837,7 +857,7 @@ Proton::get_state(const vespalib::slime::Inserter &, bool) const
 std::vector<vespalib::string>
 Proton::get_children_names() const
 {
-    std::vector<vespalib::string> names({DOCUMENT_DB, MATCH_ENGINE, FLUSH_ENGINE, TLS_NAME, RESOURCE_USAGE});
+    std::vector<vespalib::string> names({DOCUMENT_DB, MATCH_ENGINE, FLUSH_ENGINE, TLS_NAME, RESOURCE_USAGE, MEMORY_USAGE});
     return names;
 }
 
@@ -855,10 +875,22 @@ Proton::get_child(vespalib::stringref name) const
         return std::make_unique<search::transactionlog::TransLogServerExplorer>(_tls->getTransLogServer());
     } else if (name == RESOURCE_USAGE && _diskMemUsageSampler) {
         return std::make_unique<ResourceUsageExplorer>(_diskMemUsageSampler->writeFilter());
+    } else if (name == MEMORY_USAGE) {
+        const DiskMemUsageFilter *usageFilter = _diskMemUsageSampler ? &_diskMemUsageSampler->writeFilter() : nullptr;
+        return std::make_unique<MemoryAccountingExplorer>(_memoryAccounting, usageFilter);
     }
     return Explorer_UP(nullptr);
 }
 
+void
+Proton::reportDocumentDBMemoryUsage(MemoryAccountingNode &node) const
+{
+    std::shared_lock<std::shared_timed_mutex> guard(_mutex);
+    for (const auto &kv : _documentDBMap) {
+        kv.second->reportMemoryUsage(node.child(kv.first.getName()));
+    }
+}
+
 std::shared_ptr<IDocumentDBReferenceRegistry>
 Proton::getDocumentDBReferenceRegistry() const
 {
@@ -12,7 +12,10 @@
 #include "proton_config_fetcher.h"
 #include "proton_configurer.h"
 #include "rpc_hooks.h"
+#include <vespa/searchcore/proton/common/memory_accounting.h>
 #include <vespa/searchcore/proton/matching/querylimiter.h>
+#include <vespa/eval/eval/value_cache/constant_tensor_loader.h>
+#include <vespa/eval/eval/value_cache/constant_value_cache.h>
 #include <vespa/searchcore/proton/metrics/metrics_engine.h>
 #include <vespa/searchcore/proton/persistenceengine/i_resource_write_filter.h>
 #include <vespa/searchcore/proton/persistenceengine/ipersistenceengineowner.h>
@@ -72,6 +75,13 @@ private:
     };
     friend struct MetricsUpdateHook;
 
+    struct DocumentDBMemoryReporter : IMemoryAccountingReporter
+    {
+        const Proton &self;
+        DocumentDBMemoryReporter(const Proton &s) : self(s) {}
+        void reportMemoryUsage(MemoryAccountingNode &node) const override { self.reportDocumentDBMemoryUsage(node); }
+    };
+
     class ProtonFileHeaderContext : public search::common::FileHeaderContext
     {
         const Proton &_proton;
@@ -97,6 +107,9 @@ private:
     std::unique_ptr<DiskMemUsageSampler> _diskMemUsageSampler;
     PersistenceEngine::UP           _persistenceEngine;
     DocumentDBMap                   _documentDBMap;
+    mutable MemoryAccountingRegistry _memoryAccounting;
+    DocumentDBMemoryReporter        _documentDBMemoryReporter;
+    MemoryAccountingRegistry::Registration::UP _documentDBMemoryRegistration;
     std::unique_ptr<MatchEngine>   _matchEngine;
     std::unique_ptr<SummaryEngine>  _summaryEngine;
     std::unique_ptr<DocsumBySlime>  _docsumBySlime;
@@ -116,6 +129,8 @@ private:
     std::unique_ptr<vespalib::ThreadStackExecutorBase> _warmupExecutor;
     std::unique_ptr<vespalib::ThreadStackExecutorBase> _summaryExecutor;
     matching::QueryLimiter          _queryLimiter;
+    vespalib::eval::ConstantTensorLoader _tensorLoader;
+    vespalib::eval::ConstantValueCache   _constantValueCache;
     vespalib::Clock                 _clock;
     FastOS_ThreadPool               _threadPool;
     int64_t                         _configGen;
@@ -146,11 +161,13 @@ private:
      * threads at once.
      **/
     void updateMetrics(const vespalib::MonitorGuard &guard);
+    void reportDocumentDBMemoryUsage(MemoryAccountingNode &node) const;
     void waitForInitDone();
     void waitForOnlineState();
     uint32_t getDistributionKey() const override { return _distributionKey; }
     BootstrapConfig::SP getActiveConfigSnapshot() const;
     std::shared_ptr<IDocumentDBReferenceRegistry> getDocumentDBReferenceRegistry() const override;
+    const vespalib::eval::ConstantValueFactory &getConstantValueFactory() const override { return _constantValueCache; }
     bool updateNodeUp(BucketSpace bucketSpace, bool nodeUpInBucketSpace);
 public:
     typedef std::unique_ptr<Proton> UP;
@@ -198,6 +215,7 @@ public:
     StatusReport::List getStatusReports() const override;
 
     MatchEngine & getMatchEngine() { return *_matchEngine; }
+    MemoryAccountingRegistry & getMemoryAccounting() { return _memoryAccounting; }
     vespalib::ThreadStackExecutorBase & getExecutor() { return _executor; }
 
     bool isInitializing() const override { return _isInitializing; }
@@ -10,106 +10,154 @@ using vespalib::IllegalStateException;
 
 namespace proton {
 
-template <typename OperationType>
+namespace {
+
 void
-ReplayPacketDispatcher::replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry)
+checkAllDataConsumed(const vespalib::nbostream &is, const search::transactionlog::Packet::Entry &entry)
 {
-    op.deserialize(is, _handler.getDeserializeRepo());
-    op.setSerialNum(entry.serial());
-    store(op);
-    _handler.replay(op);
+    if (is.size() > 0) {
+        throw document::DeserializeException
+            (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
+                         entry.type(), is.size()));
+    }
 }
 
+FeedOperation::UP
+createOperation(uint32_t type)
+{
+    switch (type) {
+    case FeedOperation::PUT:
+        return std::make_unique<PutOperation>();
+    case FeedOperation::REMOVE:
+        return std::make_unique<RemoveOperation>();
+    case FeedOperation::UPDATE_42:
+    case FeedOperation::UPDATE:
+        return std::make_unique<UpdateOperation>(static_cast<FeedOperation::Type>(type));
+    case FeedOperation::NOOP:
+        return std::make_unique<NoopOperation>();
+    case FeedOperation::WIPE_HISTORY:
+        return std::make_unique<WipeHistoryOperation>();
+    case FeedOperation::DELETE_BUCKET:
+        return std::make_unique<DeleteBucketOperation>();
+    case FeedOperation::SPLIT_BUCKET:
+        return std::make_unique<SplitBucketOperation>();
+    case FeedOperation::JOIN_BUCKETS:
+        return std::make_unique<JoinBucketsOperation>();
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        return std::make_unique<PruneRemovedDocumentsOperation>();
+    case FeedOperation::SPOOLER_REPLAY_START:
+        return std::make_unique<SpoolerReplayStartOperation>();
+    case FeedOperation::SPOOLER_REPLAY_COMPLETE:
+        return std::make_unique<SpoolerReplayCompleteOperation>();
+    case FeedOperation::MOVE:
+        return std::make_unique<MoveOperation>();
+    case FeedOperation::CREATE_BUCKET:
+        return std::make_unique<CreateBucketOperation>();
+    case FeedOperation::COMPACT_LID_SPACE:
+        return std::make_unique<CompactLidSpaceOperation>();
+    default:
+        throw IllegalStateException
+            (make_string("Got packet entry with unknown type id '%u' from TLS", type));
+    }
+}
+
+}
+
+template <typename OperationType>
+void
+ReplayPacketDispatcher::replay(const FeedOperation &op)
+{
+    const OperationType &typedOp = static_cast<const OperationType &>(op);
+    store(typedOp);
+    _handler.replay(typedOp);
+}
 
 ReplayPacketDispatcher::ReplayPacketDispatcher(IReplayPacketHandler &handler)
     : _handler(handler)
 {
 }
 
+FeedOperation::UP
+ReplayPacketDispatcher::decodeEntry(const Packet::Entry &entry, const document::DocumentTypeRepo &repo)
+{
+    FeedOperation::UP op = createOperation(entry.type());
+    vespalib::nbostream is(entry.data().c_str(), entry.data().size());
+    op->deserialize(is, repo);
+    op->setSerialNum(entry.serial());
+    checkAllDataConsumed(is, entry);
+    return op;
+}
 
 void
-ReplayPacketDispatcher::replayEntry(const Packet::Entry &entry)
+ReplayPacketDispatcher::replayOperation(const FeedOperation &op)
 {
-    vespalib::nbostream is(entry.data().c_str(), entry.data().size());
-    switch (entry.type()) {
-    case FeedOperation::PUT: {
-        PutOperation op;
-        replay(op, is, entry);
-        break;
-    } case FeedOperation::REMOVE: {
-        RemoveOperation op;
-        replay(op, is, entry);
+    switch (op.getType()) {
+    case FeedOperation::PUT:
+        replay<PutOperation>(op);
         break;
-    } case FeedOperation::UPDATE_42:
-      case FeedOperation::UPDATE: {
-        UpdateOperation op(static_cast<FeedOperation::Type>(entry.type()));
-        replay(op, is, entry);
+    case FeedOperation::REMOVE:
+        replay<RemoveOperation>(op);
         break;
-    } case FeedOperation::NOOP: {
-        NoopOperation op;
-        replay(op, is, entry);
+    case FeedOperation::UPDATE_42:
+    case FeedOperation::UPDATE:
+        replay<UpdateOperation>(op);
         break;
-    } case FeedOperation::NEW_CONFIG: {
-        NewConfigOperation op(entry.serial(), _handler.getNewConfigStreamHandler());
-        op.deserialize(is, _handler.getDeserializeRepo());
-        _handler.replay(op);
+    case FeedOperation::NOOP:
+        replay<NoopOperation>(op);
         break;
-    } case FeedOperation::WIPE_HISTORY: {
-        WipeHistoryOperation op;
-        replay(op, is, entry);
+    case FeedOperation::WIPE_HISTORY:
+        replay<WipeHistoryOperation>(op);
         break;
-    } case FeedOperation::DELETE_BUCKET: {
-        DeleteBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::DELETE_BUCKET:
+        replay<DeleteBucketOperation>(op);
         break;
-    } case FeedOperation::SPLIT_BUCKET: {
-        SplitBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::SPLIT_BUCKET:
+        replay<SplitBucketOperation>(op);
         break;
-    } case FeedOperation::JOIN_BUCKETS: {
-        JoinBucketsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::JOIN_BUCKETS:
+        replay<JoinBucketsOperation>(op);
         break;
-    } case FeedOperation::PRUNE_REMOVED_DOCUMENTS: {
-        PruneRemovedDocumentsOperation op;
-        replay(op, is, entry);
+    case FeedOperation::PRUNE_REMOVED_DOCUMENTS:
+        replay<PruneRemovedDocumentsOperation>(op);
         break;
-    } case FeedOperation::SPOOLER_REPLAY_START: {
-        SpoolerReplayStartOperation op;
-        replay(op, is, entry);
+    case FeedOperation::SPOOLER_REPLAY_START:
+        replay<SpoolerReplayStartOperation>(op);
         break;
-    } case FeedOperation::SPOOLER_REPLAY_COMPLETE: {
-        SpoolerReplayCompleteOperation op;
-        replay(op, is, entry);
+    case FeedOperation::SPOOLER_REPLAY_COMPLETE:
+        replay<SpoolerReplayCompleteOperation>(op);
         break;
-    } case FeedOperation::MOVE: {
-        MoveOperation op;
-        replay(op, is, entry);
+    case FeedOperation::MOVE:
+        replay<MoveOperation>(op);
         break;
-    } case FeedOperation::CREATE_BUCKET: {
-        CreateBucketOperation op;
-        replay(op, is, entry);
+    case FeedOperation::CREATE_BUCKET:
+        replay<CreateBucketOperation>(op);
         break;
-    } case FeedOperation::COMPACT_LID_SPACE: {
-        CompactLidSpaceOperation op;
-        replay(op, is, entry);
+    case FeedOperation::COMPACT_LID_SPACE:
+        replay<CompactLidSpaceOperation>(op);
         break;
-    } default:
+    default:
         throw IllegalStateException
-            (make_string("Got packet entry with unknown type id '%u' from TLS",
-                         entry.type()));
-    }
-    if (is.size() > 0) {
-        throw document::DeserializeException
-            (make_string("Too much data in packet entry (type id '%u', %ld bytes)",
-                         entry.type(), is.size()));
+            (make_string("Cannot replay feed operation with type id '%u'", op.getType()));
     }
 }
 
+void
+ReplayPacketDispatcher::replayEntry(const Packet::Entry &entry)
+{
+    if (entry.type() == FeedOperation::NEW_CONFIG) {
+        vespalib::nbostream is(entry.data().c_str(), entry.data().size());
+        NewConfigOperation op(entry.serial(), _handler.getNewConfigStreamHandler());
+        op.deserialize(is, _handler.getDeserializeRepo());
+        _handler.replay(op);
+        checkAllDataConsumed(is, entry);
+    } else {
+        FeedOperation::UP op = decodeEntry(entry, _handler.getDeserializeRepo());
+        replayOperation(*op);
+    }
+}
 
 ReplayPacketDispatcher::~ReplayPacketDispatcher() = default;
 
-
 void
 ReplayPacketDispatcher::store(const FeedOperation &)
 {
@@ -4,6 +4,7 @@
 
 #include "ireplaypackethandler.h"
 #include <vespa/searchlib/transactionlog/common.h>
+#include <memory>
 
 namespace proton {
 
@@ -20,7 +21,7 @@ private:
     IReplayPacketHandler &_handler;
 
     template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
+    void replay(const FeedOperation &op);
 
 protected:
     virtual void store(const FeedOperation &op);
@@ -30,6 +31,21 @@ public:
     virtual ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+
+    /**
+     * Deserializes a packet entry into a feed operation without
+     * dispatching it. Does not depend on any state in the handler, so it
+     * can be called from other threads as long as the repo is kept alive.
+     * New config operations are not supported, as they must be
+     * deserialized in order by replayEntry().
+     */
+    static std::unique_ptr<FeedOperation> decodeEntry(const Packet::Entry &entry,
+                                                      const document::DocumentTypeRepo &repo);
+
+    /**
+     * Dispatches a feed operation created by decodeEntry().
+     */
+    void replayOperation(const FeedOperation &op);
 };
 
 } // namespace proton
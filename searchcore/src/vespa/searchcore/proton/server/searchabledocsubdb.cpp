@@ -16,7 +16,6 @@
 #include <vespa/searchcorespi/plugin/iindexmanagerfactory.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/vespalib/util/closuretask.h>
-#include <vespa/eval/tensor/default_tensor_engine.h>
 #include <vespa/vespalib/util/exceptions.h>
 
 using vespa::config::search::AttributesConfig;
@@ -43,9 +42,7 @@ SearchableDocSubDB::SearchableDocSubDB(const Config &cfg, const Context &ctx)
       _indexWriter(),
       _rSearchView(),
       _rFeedView(),
-      _tensorLoader(vespalib::tensor::DefaultTensorEngine::ref()),
-      _constantValueCache(_tensorLoader),
-      _constantValueRepo(_constantValueCache),
+      _constantValueRepo(ctx._constantValueFactory),
       _configurer(_iSummaryMgr, _rSearchView, _rFeedView, ctx._queryLimiter, _constantValueRepo, ctx._clock,
                   getSubDbName(), ctx._fastUpdCtx._storeOnlyCtx._owner.getDistributionKey()),
       _numSearcherThreads(cfg._numSearcherThreads),
@@ -100,9 +97,13 @@ createIndexManagerInitializer(const DocumentDBConfig &configSnapshot,
     // Note: const_cast for reconfigurer role
     return std::make_shared<IndexManagerInitializer>
         (vespaIndexDir,
-         searchcorespi::index::WarmupConfig(indexCfg.warmup.time, indexCfg.warmup.unpack),
+         searchcorespi::index::WarmupConfig(indexCfg.warmup.time, indexCfg.warmup.unpack,
+                                            indexCfg.warmup.recordedterms),
          indexCfg.maxflushed,
          indexCfg.cache.size,
+         indexCfg.cache.postinglist.maxbytes,
+         indexCfg.checkpoint.interval,
+         indexCfg.blockmaxweights,
          *schema,
          configSerialNum,
          const_cast<SearchableDocSubDB &>(*this),
@@ -48,6 +48,33 @@ convertGidsToLids(const DocsumRequest & request,
     }
 }
 
+/**
+ * Hints the document store with the lids of the top hits, so they are likely
+ * in the page cache when the docsum request for them arrives.
+ **/
+void
+prefetchHits(const SearchReply & reply, const IDocumentMetaStoreContext & metaStoreContext,
+             const search::IDocumentStore & docStore)
+{
+    const size_t numHits = std::min(reply.hits.size(), size_t(docStore.getMaxPrefetchHits()));
+    if (numHits == 0) {
+        return;
+    }
+    search::IDocumentStore::LidVector lids;
+    lids.reserve(numHits);
+    {
+        IDocumentMetaStoreContext::IReadGuard::UP readGuard = metaStoreContext.getReadGuard();
+        const search::IDocumentMetaStore & metaStore = readGuard->get();
+        uint32_t lid = 0;
+        for (size_t i = 0; i < numHits; ++i) {
+            if (metaStore.getLid(reply.hits[i].gid, lid)) {
+                lids.push_back(lid);
+            }
+        }
+    }
+    docStore.prefetch(lids);
+}
+
 bool
 requestHasLidAbove(const DocsumRequest & request, uint32_t docIdLimit)
 {
@@ -164,7 +191,11 @@ SearchView::getDocsumsInternal(const DocsumRequest & req)
 
 std::unique_ptr<SearchReply>
 SearchView::match(const ISearchHandler::SP &self, const SearchRequest &req, ThreadBundle &threadBundle) const {
-    return _matchView->match(self, req, threadBundle);
+    std::unique_ptr<SearchReply> reply = _matchView->match(self, req, threadBundle);
+    if (reply) {
+        prefetchHits(*reply, *_matchView->getDocumentMetaStore(), _summarySetup->getDocumentStore());
+    }
+    return reply;
 }
 
 } // namespace proton
@@ -42,6 +42,9 @@ namespace proton {
 
 namespace {
 
+// Max number of summary writes waiting for the summary executor
+constexpr uint32_t MAX_PENDING_SUMMARY_TASKS = 1000;
+
 class PutDoneContextForMove : public PutDoneContext {
 private:
     IDestructorCallback::SP _moveDoneCtx;
@@ -197,6 +200,7 @@ StoreOnlyFeedView::StoreOnlyFeedView(const Context &ctx, const PersistentParams
       _lidReuseDelayer(ctx._lidReuseDelayer),
       _commitTimeTracker(ctx._commitTimeTracker),
       _pendingLidTracker(),
+      _summaryBatcher(ctx._writeService.summary(), MAX_PENDING_SUMMARY_TASKS),
       _schema(ctx._schema),
       _writeService(ctx._writeService),
       _params(params),
@@ -217,7 +221,13 @@ StoreOnlyFeedView::sync()
 void
 StoreOnlyFeedView::forceCommit(SerialNum serialNum)
 {
-    forceCommit(serialNum, std::make_shared<ForceCommitContext>(_writeService.master(), _metaStore));
+    forceCommit(serialNum, search::IDestructorCallback::SP());
+}
+
+void
+StoreOnlyFeedView::forceCommit(SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onDone)
+{
+    forceCommit(serialNum, std::make_shared<ForceCommitContext>(_writeService.master(), _metaStore, std::move(onDone)));
 }
 
 void
@@ -290,7 +300,11 @@ StoreOnlyFeedView::internalPut(FeedToken token, const PutOperation &putOp)
         std::shared_ptr<PutDoneContext> onWriteDone =
             createPutDoneContext(std::move(token), _gidToLidChangeHandler, doc, gid, putOp.getLid(), serialNum,
                                  putOp.changedDbdId() && useDocumentMetaStore(serialNum));
-        putSummary(serialNum, putOp.getLid(), doc, onWriteDone);
+        if (putOp.getSerializedDocument()) {
+            putSummary(serialNum, putOp.getLid(), putOp.getSerializedDocument(), onWriteDone);
+        } else {
+            putSummary(serialNum, putOp.getLid(), doc, onWriteDone);
+        }
         putAttributes(serialNum, putOp.getLid(), *doc, immediateCommit, onWriteDone);
         putIndexedFields(serialNum, putOp.getLid(), doc, immediateCommit, onWriteDone);
     }
@@ -375,6 +389,20 @@ void StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, Document::SP do
             }));
 #pragma GCC diagnostic pop
 }
+void StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, std::shared_ptr<const vespalib::nbostream> serializedDoc,
+                                   OnOperationDoneType onDone)
+{
+    _pendingLidTracker.produce(lid);
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winline" // Avoid spurious inlining warning from GCC related to lambda destructor.
+    summaryExecutor().execute(
+            makeLambdaTask([serialNum, serializedDoc = std::move(serializedDoc), onDone, lid, this] {
+                (void) onDone;
+                _summaryAdapter->put(serialNum, lid, *serializedDoc);
+                _pendingLidTracker.consume(lid);
+            }));
+#pragma GCC diagnostic pop
+}
 void StoreOnlyFeedView::removeSummary(SerialNum serialNum, Lid lid, OnWriteDoneType onDone) {
     _pendingLidTracker.produce(lid);
     summaryExecutor().execute(
@@ -454,7 +482,9 @@ StoreOnlyFeedView::internalUpdate(FeedToken token, const UpdateOperation &updOp)
     UpdateScope updateScope(*_schema, upd);
     updateAttributes(serialNum, lid, upd, immediateCommit, onWriteDone, updateScope);
 
-    if (updateScope.hasIndexOrNonAttributeFields()) {
+    bool needUpdatedDocument = useDocumentStore(serialNum) || updateScope._indexedFields ||
+                               attributesNeedUpdatedDocument();
+    if (updateScope.hasIndexOrNonAttributeFields() && needUpdatedDocument) {
         PromisedDoc promisedDoc;
         FutureDoc futureDoc = promisedDoc.get_future().share();
         onWriteDone->setDocument(futureDoc);
@@ -792,7 +822,7 @@ StoreOnlyFeedView::handleCompactLidSpace(const CompactLidSpaceOperation &op)
     if (useDocumentMetaStore(serialNum)) {
         getDocumentMetaStore()->get().compactLidSpace(op.getLidLimit());
         std::shared_ptr<ForceCommitContext>
-            commitContext(std::make_shared<ForceCommitContext>(_writeService.master(), _metaStore));
+            commitContext(std::make_shared<ForceCommitContext>(_writeService.master(), _metaStore, search::IDestructorCallback::SP()));
         commitContext->holdUnblockShrinkLidSpace();
         forceCommit(serialNum, commitContext);
     }
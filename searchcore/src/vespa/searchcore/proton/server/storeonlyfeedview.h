@@ -8,6 +8,7 @@
 #include "replaypacketdispatcher.h"
 #include "searchcontext.h"
 #include "pendinglidtracker.h"
+#include "task_batcher.h"
 #include <vespa/searchcore/proton/common/doctypename.h>
 #include <vespa/searchcore/proton/attribute/ifieldupdatecallback.h>
 #include <vespa/searchcore/proton/common/feeddebugger.h>
@@ -123,6 +124,16 @@ public:
     };
 
 protected:
+    /**
+     * Tracks which kinds of fields an update touches. An update only
+     * touching attributes that can be updated in place is applied to the
+     * attributes alone, without reading and rewriting the document in the
+     * document store. Document retrieval and summaries take such fields
+     * from the attributes, so the stale values in the stored document are
+     * never seen. When replaying an update the document store already has
+     * the outcome of, the updated document is only made if the index or
+     * attributes need it.
+     */
     class UpdateScope : public IFieldUpdateCallback
     {
     private:
@@ -146,6 +157,7 @@ private:
     documentmetastore::ILidReuseDelayer     &_lidReuseDelayer;
     CommitTimeTracker                       &_commitTimeTracker;
     PendingLidTracker                        _pendingLidTracker;
+    TaskBatcher                              _summaryBatcher;
 
 protected:
     const search::index::Schema::SP          _schema;
@@ -155,11 +167,13 @@ protected:
     IGidToLidChangeHandler                  &_gidToLidChangeHandler;
 
 private:
-    searchcorespi::index::IThreadService & summaryExecutor() {
-        return _writeService.summary();
+    TaskBatcher & summaryExecutor() {
+        return _summaryBatcher;
     }
     void putSummary(SerialNum serialNum,  Lid lid, FutureStream doc, OnOperationDoneType onDone);
     void putSummary(SerialNum serialNum,  Lid lid, DocumentSP doc, OnOperationDoneType onDone);
+    void putSummary(SerialNum serialNum,  Lid lid, std::shared_ptr<const vespalib::nbostream> serializedDoc,
+                    OnOperationDoneType onDone);
     void removeSummary(SerialNum serialNum,  Lid lid, OnWriteDoneType onDone);
     void heartBeatSummary(SerialNum serialNum);
 
@@ -210,6 +224,12 @@ private:
     virtual void updateAttributes(SerialNum serialNum, Lid lid, FutureDoc doc,
                                   bool immediateCommit, OnOperationDoneType onWriteDone);
 
+    /**
+     * Returns true if some attributes are updated from the updated
+     * document instead of from the document update.
+     */
+    virtual bool attributesNeedUpdatedDocument() const { return false; }
+
     virtual void updateIndexedFields(SerialNum serialNum, Lid lid, FutureDoc doc,
                                      bool immediateCommit, OnOperationDoneType onWriteDone);
 
@@ -253,6 +273,7 @@ public:
     void heartBeat(search::SerialNum serialNum) override;
     void sync() override;
     void forceCommit(SerialNum serialNum) override;
+    void forceCommit(SerialNum serialNum, std::shared_ptr<search::IDestructorCallback> onDone) override;
     virtual void forceCommit(SerialNum serialNum, OnForceCommitDoneType onCommitDone);
 
     /**
@@ -0,0 +1,56 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "task_batcher.h"
+#include <vespa/vespalib/util/lambdatask.h>
+#include <algorithm>
+
+namespace proton {
+
+TaskBatcher::TaskBatcher(vespalib::Executor &executor, uint32_t maxPending)
+    : _executor(executor),
+      _maxPending(std::max(maxPending, 1u)),
+      _lock(),
+      _cond(),
+      _pending(),
+      _batches(0)
+{
+}
+
+TaskBatcher::~TaskBatcher() = default;
+
+void
+TaskBatcher::runBatch()
+{
+    TaskList batch;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        batch.swap(_pending);
+        _cond.notify_all();
+    }
+    for (Task::UP &task : batch) {
+        task->run();
+        task.reset();
+    }
+}
+
+void
+TaskBatcher::execute(Task::UP task)
+{
+    bool newBatch;
+    {
+        std::unique_lock<std::mutex> guard(_lock);
+        while (_pending.size() >= _maxPending) {
+            _cond.wait(guard);
+        }
+        _pending.push_back(std::move(task));
+        newBatch = (_pending.size() == 1);
+    }
+    // The first task of a batch schedules the run of the batch; later
+    // tasks join it until the executor thread picks it up.
+    if (newBatch) {
+        ++_batches;
+        _executor.execute(vespalib::makeLambdaTask([this]() { runBatch(); }));
+    }
+}
+
+} // namespace proton
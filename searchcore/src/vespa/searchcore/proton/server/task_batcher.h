@@ -0,0 +1,45 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/executor.h>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace proton {
+
+/**
+ * Collects tasks for a single threaded executor into batches, so that
+ * a stream of small feed operations costs one executor task per batch
+ * instead of one per operation. Tasks are run in the order they were
+ * added. A batch is closed when the executor thread picks it up, and
+ * adding blocks while the number of pending tasks is at the limit.
+ *
+ * Tasks must only be added from a single thread (the master thread).
+ * Syncing the underlying executor also waits for all tasks added
+ * before the sync started.
+ **/
+class TaskBatcher
+{
+private:
+    using Task = vespalib::Executor::Task;
+    using TaskList = std::vector<Task::UP>;
+
+    vespalib::Executor      &_executor;
+    const uint32_t           _maxPending;
+    std::mutex               _lock;
+    std::condition_variable  _cond;
+    TaskList                 _pending;
+    uint64_t                 _batches;
+
+    void runBatch();
+public:
+    TaskBatcher(vespalib::Executor &executor, uint32_t maxPending);
+    ~TaskBatcher();
+    void execute(Task::UP task);
+    /** Number of batches handed to the executor. */
+    uint64_t getBatches() const { return _batches; }
+};
+
+} // namespace proton
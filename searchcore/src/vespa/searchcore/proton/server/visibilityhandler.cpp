@@ -1,14 +1,38 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "visibilityhandler.h"
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
+#include <vespa/searchlib/common/idestructorcallback.h>
 #include <vespa/searchlib/common/isequencedtaskexecutor.h>
 #include <vespa/vespalib/util/closuretask.h>
 
 using vespalib::makeTask;
 using vespalib::makeClosure;
+using fastos::ClockSystem;
 
 namespace proton {
 
+namespace {
+
+/**
+ * Invalidates the query result cache when the last part of a commit
+ * is done, i.e. when the committed changes have become visible.
+ * Invalidating earlier would let queries racing with the commit cache
+ * results computed against the old documents.
+ */
+class InvalidateResultCacheContext : public search::IDestructorCallback
+{
+    matching::QueryResultCache &_resultCache;
+public:
+    InvalidateResultCacheContext(matching::QueryResultCache &resultCache)
+        : _resultCache(resultCache)
+    {
+    }
+    ~InvalidateResultCacheContext() override { _resultCache.invalidate(); }
+};
+
+}
+
 VisibilityHandler::VisibilityHandler(const IGetSerialNum & serial,
                                      IThreadingService &writeService,
                                      const FeedViewHolder & feedView)
@@ -16,19 +40,56 @@ VisibilityHandler::VisibilityHandler(const IGetSerialNum & serial,
       _writeService(writeService),
       _feedView(feedView),
       _visibilityDelay(0),
+      _minVisibilityDelay(0),
+      _adaptiveDelay(),
+      _adaptiveDelayLock(),
       _lastCommitSerialNum(0),
+      _resultCache(nullptr),
       _lock()
 {
 }
 
+void VisibilityHandler::setVisibilityDelay(TimeStamp visibilityDelay)
+{
+    _visibilityDelay = visibilityDelay;
+    {
+        std::lock_guard<std::mutex> guard(_adaptiveDelayLock);
+        _adaptiveDelay.setDelays(_minVisibilityDelay, _visibilityDelay);
+    }
+    if (_resultCache != nullptr) {
+        _resultCache->invalidate();
+        _resultCache->setEnabled(_visibilityDelay != 0);
+    }
+}
+
+void VisibilityHandler::setMinVisibilityDelay(TimeStamp minVisibilityDelay)
+{
+    _minVisibilityDelay = minVisibilityDelay;
+    std::lock_guard<std::mutex> guard(_adaptiveDelayLock);
+    _adaptiveDelay.setDelays(_minVisibilityDelay, _visibilityDelay);
+}
+
+AdaptiveVisibilityDelay VisibilityHandler::getAdaptiveVisibilityDelay() const
+{
+    std::lock_guard<std::mutex> guard(_adaptiveDelayLock);
+    return _adaptiveDelay;
+}
+
+void VisibilityHandler::setResultCache(matching::QueryResultCache *resultCache)
+{
+    _resultCache = resultCache;
+    if (_resultCache != nullptr) {
+        _resultCache->setEnabled(_visibilityDelay != 0);
+    }
+}
+
 void VisibilityHandler::commit()
 {
     if (_visibilityDelay != 0) {
         if (_writeService.master().isCurrentThread()) {
-            performCommit(true);
+            performRegularCommit();
         } else {
-            std::lock_guard<std::mutex> guard(_lock);
-            startCommit(guard, true);
+            _writeService.master().execute(makeTask(makeClosure(this, &VisibilityHandler::performRegularCommit)));
         }
     }
 }
@@ -63,13 +124,36 @@ bool VisibilityHandler::startCommit(const std::lock_guard<std::mutex> &unused, b
     return false;
 }
 
+void VisibilityHandler::performRegularCommit()
+{
+    // Called by master thread
+    bool due;
+    {
+        std::lock_guard<std::mutex> guard(_adaptiveDelayLock);
+        due = _adaptiveDelay.isCommitDue(ClockSystem::now());
+    }
+    if (due) {
+        performCommit(true);
+    }
+}
+
 void VisibilityHandler::performCommit(bool force)
 {
     // Called by master thread
     SerialNum current = _serial.getSerialNum();
     if ((current > _lastCommitSerialNum) || force) {
         IFeedView::SP feedView(_feedView.get());
-        feedView->forceCommit(current);
+        std::shared_ptr<search::IDestructorCallback> onDone;
+        if ((_resultCache != nullptr) && (current != _lastCommitSerialNum)) {
+            onDone = std::make_shared<InvalidateResultCacheContext>(*_resultCache);
+        }
+        TimeStamp start(ClockSystem::now());
+        feedView->forceCommit(current, std::move(onDone));
+        TimeStamp now(ClockSystem::now());
+        {
+            std::lock_guard<std::mutex> guard(_adaptiveDelayLock);
+            _adaptiveDelay.commitDone(now, current, now - start);
+        }
         _lastCommitSerialNum = current;
     }
 }
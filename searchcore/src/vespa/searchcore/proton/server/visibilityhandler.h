@@ -5,12 +5,15 @@
 #include <vespa/searchcore/proton/server/ifeedview.h>
 #include <vespa/searchcore/proton/server/icommitable.h>
 #include <vespa/searchcore/proton/server/igetserialnum.h>
+#include <vespa/searchcore/proton/common/adaptive_visibility_delay.h>
 #include <vespa/searchcorespi/index/ithreadingservice.h>
 #include <vespa/vespalib/util/varholder.h>
 #include <mutex>
 
 namespace proton {
 
+namespace matching { class QueryResultCache; }
+
 /**
  * Handle commit of changes withing the allowance of visibilitydelay.
  * It will both handle background commit jobs and the necessary commit and wait for sequencing.
@@ -26,18 +29,40 @@ public:
     VisibilityHandler(const IGetSerialNum &serial,
                       IThreadingService &threadingService,
                       const FeedViewHolder &feedView);
-    void setVisibilityDelay(TimeStamp visibilityDelay) { _visibilityDelay = visibilityDelay; }
+    void setVisibilityDelay(TimeStamp visibilityDelay);
+    /**
+     * Let regular commits adapt their interval to the feed rate and
+     * commit cost, between the given min delay and the visibility
+     * delay. A min delay of 0 gives a fixed interval.
+     **/
+    void setMinVisibilityDelay(TimeStamp minVisibilityDelay);
+    /**
+     * Set the query result cache to invalidate when changes become
+     * visible. The cache is only usable with a visibility delay, as
+     * changes are otherwise visible without a commit.
+     **/
+    void setResultCache(matching::QueryResultCache *resultCache);
     TimeStamp getVisibilityDelay() const { return _visibilityDelay; } 
+    AdaptiveVisibilityDelay getAdaptiveVisibilityDelay() const;
+    /**
+     * Regular commit, skipped when the adaptive visibility delay says
+     * it is not due yet.
+     **/
     void commit() override;
     virtual void commitAndWait() override;
 private:
     bool startCommit(const std::lock_guard<std::mutex> &unused, bool force);
     void performCommit(bool force);
+    void performRegularCommit();
     const IGetSerialNum  & _serial;
     IThreadingService    & _writeService;
     const FeedViewHolder & _feedView;
     TimeStamp              _visibilityDelay;
+    TimeStamp              _minVisibilityDelay;
+    AdaptiveVisibilityDelay _adaptiveDelay;
+    mutable std::mutex     _adaptiveDelayLock;
     SerialNum              _lastCommitSerialNum;
+    matching::QueryResultCache *_resultCache;
     std::mutex             _lock;
 };
 
@@ -116,8 +116,9 @@ DocsumByRPC::getDocsums(FRT_RPCRequest & req)
     ConstBufferRef blob(arg[2]._data._buf, arg[2]._data._len);
     decompress(CompressionConfig::toType(encoding), uncompressedSize, blob, uncompressed, true);
     assert(uncompressedSize == uncompressed.getDataLen());
+    // uncompressed outlives summariesToGet, no need to copy strings and data
     vespalib::Slime summariesToGet;
-    BinaryFormat::decode(Memory(uncompressed.getData(), uncompressed.getDataLen()), summariesToGet);
+    BinaryFormat::decode_borrowed(Memory(uncompressed.getData(), uncompressed.getDataLen()), summariesToGet);
 
     vespalib::Slime::UP summaries = _slimeDocsumServer.getDocsums(summariesToGet.get());
     assert(summaries);  // Mandatory, not optional.
@@ -12,6 +12,10 @@ using vespalib::slime::Inspector;
 
 namespace {
 
+using vespalib::Runnable;
+
+VESPA_THREAD_STACK_TAG(proton_docsum_executor);
+
 Memory DOCSUMS("docsums");
 
 class DocsumTask : public vespalib::Executor::Task {
@@ -60,7 +64,7 @@ SummaryEngine::SummaryEngine(size_t numThreads)
     : _lock(),
       _closed(false),
       _handlers(),
-      _executor(numThreads, 128 * 1024),
+      _executor(numThreads, 128 * 1024, proton_docsum_executor),
       _metrics(std::make_unique<DocsumMetrics>())
 { }
 
@@ -155,6 +155,9 @@ struct DocumentMetaStoreObserver : public IDocumentMetaStore
     virtual DocId getNumActiveLids() const override {
         return _store.getNumActiveLids();
     }
+    virtual search::MemoryUsage getMemoryUsage() const override {
+        return _store.getMemoryUsage();
+    }
     virtual bool getFreeListActive() const override {
         return _store.getFreeListActive();
     }
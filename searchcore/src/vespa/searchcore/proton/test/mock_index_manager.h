@@ -23,6 +23,9 @@ struct MockIndexManager : public searchcorespi::IIndexManager
     virtual search::SearchableStats getSearchableStats() const override {
         return search::SearchableStats();
     }
+    virtual searchcorespi::index::IndexWriteStats getWriteStats() const override {
+        return searchcorespi::index::IndexWriteStats();
+    }
     virtual searchcorespi::IFlushTarget::List getFlushTargets() override {
         return searchcorespi::IFlushTarget::List();
     }
@@ -30,6 +30,10 @@ public:
         SearchableStats s;
         return s;
     }
+    virtual index::IndexWriteStats getWriteStats() const override {
+        index::IndexWriteStats s;
+        return s;
+    }
     virtual searchcorespi::IFlushTarget::List getFlushTargets() override {
         searchcorespi::IFlushTarget::List l;
         return l;
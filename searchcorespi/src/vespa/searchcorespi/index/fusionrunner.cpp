@@ -30,11 +30,13 @@ namespace searchcorespi::index {
 FusionRunner::FusionRunner(const string &base_dir,
                            const Schema &schema,
                            const TuneFileAttributes &tuneFileAttributes,
-                           const FileHeaderContext &fileHeaderContext)
+                           const FileHeaderContext &fileHeaderContext,
+                           uint32_t numThreads)
     : _diskLayout(base_dir),
       _schema(schema),
       _tuneFileAttributes(tuneFileAttributes),
-      _fileHeaderContext(fileHeaderContext)
+      _fileHeaderContext(fileHeaderContext),
+      _numThreads(numThreads)
 { }
 
 FusionRunner::~FusionRunner() {
@@ -112,7 +114,7 @@ FusionRunner::fuse(const FusionSpec &fusion_spec,
     SelectorArray selector_array;
     readSelectorArray(selector_name, selector_array, id_map, fusion_spec.last_fusion_id);
 
-    if (!operations.runFusion(_schema, fusion_dir, sources, selector_array, lastSerialNum)) {
+    if (!operations.runFusion(_schema, fusion_dir, sources, selector_array, lastSerialNum, _numThreads)) {
         return 0;
     }
 
@@ -42,12 +42,14 @@ struct IIndexMaintainerOperations {
      * @param sources the directories of the input disk indexes.
      * @param selectorArray the array specifying in which input disk index a document is located.
      * @param lastSerialNum the serial number of the last operation in the last input disk index.
+     * @param numThreads the number of fields that can be merged in parallel.
      */
     virtual bool runFusion(const search::index::Schema &schema,
                            const vespalib::string &outputDir,
                            const std::vector<vespalib::string> &sources,
                            const search::diskindex::SelectorArray &selectorArray,
-                           search::SerialNum lastSerialNum) = 0;
+                           search::SerialNum lastSerialNum,
+                           uint32_t numThreads) = 0;
 };
 
 } // namespace index
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "index_write_stats.h"
 #include "indexsearchable.h"
 #include <vespa/searchcommon/common/schema.h>
 #include <vespa/searchcorespi/flush/flushstats.h>
@@ -139,6 +140,13 @@ public:
      */
     virtual search::SearchableStats getSearchableStats() const = 0;
 
+    /**
+     * Returns the bytes written by flush and fusion for this index manager.
+     *
+     * @return statistics used to estimate write amplification.
+     */
+    virtual index::IndexWriteStats getWriteStats() const = 0;
+
     /**
      * Returns the list of all flush targets contained in this index manager.
      *
@@ -15,6 +15,8 @@ class IDestructorCallback;
 
 }
 
+namespace vespalib { class nbostream; }
+
 namespace searchcorespi {
 namespace index {
 
@@ -77,6 +79,23 @@ struct IMemoryIndex : public searchcorespi::IndexSearchable {
                              uint32_t docIdLimit,
                              search::SerialNum serialNum) = 0;
 
+    /**
+     * Serializes the committed content of this memory index as a
+     * checkpoint image, see MemoryIndexCheckpoint.
+     *
+     * @param os the stream to serialize into.
+     */
+    virtual void saveCheckpoint(vespalib::nbostream &os) = 0;
+
+    /**
+     * Loads a checkpoint image into this empty memory index.
+     * Returns false if the image does not match the schema of this memory index.
+     *
+     * @param is the stream to load from.
+     * @param serialNum the serial number of the last operation in the image.
+     */
+    virtual bool loadCheckpoint(vespalib::nbostream &is, search::SerialNum serialNum) = 0;
+
     virtual void pruneRemovedFields(const search::index::Schema &schema) = 0;
     virtual search::index::Schema::SP getPrunedSchema() const = 0;
 };
@@ -2,6 +2,7 @@
 
 #include "index_manager_explorer.h"
 #include "index_manager_stats.h"
+#include "warmupindexcollection.h"
 
 #include <vespa/vespalib/data/slime/cursor.h>
 
@@ -9,6 +10,7 @@ using vespalib::slime::Cursor;
 using vespalib::slime::Inserter;
 using search::SearchableStats;
 using searchcorespi::index::DiskIndexStats;
+using searchcorespi::index::IndexWriteStats;
 using searchcorespi::index::MemoryIndexStats;
 
 namespace searchcorespi {
@@ -45,6 +47,27 @@ insertMemoryIndex(Cursor &arrayCursor, const MemoryIndexStats &memoryIndex)
     insertMemoryUsage(memoryIndexCursor, sstats.memoryUsage());
 }
 
+void
+insertWriteStats(Cursor &object, const IndexWriteStats &writeStats)
+{
+    Cursor &write = object.setObject("writeStats");
+    write.setLong("documentsIngested", writeStats.getDocumentsIngested());
+    write.setLong("flushBytesWritten", writeStats.getFlushBytesWritten());
+    write.setLong("fusionBytesWritten", writeStats.getFusionBytesWritten());
+    write.setDouble("bytesWrittenPerDocument", writeStats.getBytesWrittenPerDocument());
+    write.setDouble("writeAmplification", writeStats.getWriteAmplification());
+}
+
+void
+insertWarmup(Cursor &object, const WarmupIndexCollection &warmup)
+{
+    WarmupIndexCollection::ReplayProgress progress = warmup.getReplayProgress();
+    Cursor &warmupCursor = object.setObject("warmup");
+    warmupCursor.setLong("termsToReplay", progress.termsToReplay);
+    warmupCursor.setLong("termsReplayed", progress.termsReplayed);
+    warmupCursor.setDouble("secondsLeft", progress.secondsLeft);
+}
+
 }
 
 
@@ -68,6 +91,12 @@ IndexManagerExplorer::get_state(const Inserter &inserter, bool full) const
         for (const auto &memoryIndex : stats.getMemoryIndexes()) {
             insertMemoryIndex(memoryIndexArrayCursor, memoryIndex);
         }
+        insertWriteStats(object, stats.getWriteStats());
+        IndexSearchable::SP searchable = _mgr->getSearchable();
+        const auto *warmup = dynamic_cast<const WarmupIndexCollection *>(searchable.get());
+        if (warmup != nullptr) {
+            insertWarmup(object, *warmup);
+        }
     }
 }
 
@@ -36,13 +36,15 @@ public:
 
 IndexManagerStats::IndexManagerStats()
     : _diskIndexes(),
-      _memoryIndexes()
+      _memoryIndexes(),
+      _writeStats()
 {
 }
 
 IndexManagerStats::IndexManagerStats(const IIndexManager &indexManager)
     : _diskIndexes(),
-      _memoryIndexes()
+      _memoryIndexes(),
+      _writeStats(indexManager.getWriteStats())
 {
     Visitor visitor;
     IndexSearchable::SP searchable(indexManager.getSearchable());
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "disk_index_stats.h"
+#include "index_write_stats.h"
 #include "memory_index_stats.h"
 #include <vector>
 
@@ -15,6 +16,7 @@ class IIndexManager;
 class IndexManagerStats {
     std::vector<index::DiskIndexStats> _diskIndexes;
     std::vector<index::MemoryIndexStats> _memoryIndexes;
+    index::IndexWriteStats _writeStats;
 public:
     IndexManagerStats();
     IndexManagerStats(const IIndexManager &indexManager);
@@ -26,6 +28,9 @@ public:
     const std::vector<index::MemoryIndexStats> &getMemoryIndexes() const {
         return _memoryIndexes;
     }
+    const index::IndexWriteStats &getWriteStats() const {
+        return _writeStats;
+    }
 };
 
 } // namespace searchcorespi
@@ -0,0 +1,49 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstdint>
+
+namespace searchcorespi::index {
+
+/**
+ * Bytes written to disk by flush and fusion of indexes, relative to
+ * the number of documents put into the index, since the index manager
+ * was started. Used to tune fusion for write amplification.
+ */
+class IndexWriteStats {
+    uint64_t _documentsIngested;
+    uint64_t _flushBytesWritten;
+    uint64_t _fusionBytesWritten;
+public:
+    IndexWriteStats()
+        : _documentsIngested(0),
+          _flushBytesWritten(0),
+          _fusionBytesWritten(0)
+    {
+    }
+    IndexWriteStats(uint64_t documentsIngested, uint64_t flushBytesWritten, uint64_t fusionBytesWritten)
+        : _documentsIngested(documentsIngested),
+          _flushBytesWritten(flushBytesWritten),
+          _fusionBytesWritten(fusionBytesWritten)
+    {
+    }
+
+    uint64_t getDocumentsIngested() const { return _documentsIngested; }
+    uint64_t getFlushBytesWritten() const { return _flushBytesWritten; }
+    uint64_t getFusionBytesWritten() const { return _fusionBytesWritten; }
+    uint64_t getBytesWritten() const { return _flushBytesWritten + _fusionBytesWritten; }
+
+    double getBytesWrittenPerDocument() const {
+        return (_documentsIngested != 0) ? static_cast<double>(getBytesWritten()) / _documentsIngested : 0.0;
+    }
+
+    /**
+     * Returns the total bytes written per byte written by flush, which
+     * is how many times flushed data has been rewritten by fusion, plus one.
+     */
+    double getWriteAmplification() const {
+        return (_flushBytesWritten != 0) ? static_cast<double>(getBytesWritten()) / _flushBytesWritten : 0.0;
+    }
+};
+
+}
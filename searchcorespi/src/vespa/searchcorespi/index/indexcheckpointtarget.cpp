@@ -0,0 +1,60 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "indexcheckpointtarget.h"
+
+namespace searchcorespi::index {
+
+IndexCheckpointTarget::IndexCheckpointTarget(IndexMaintainer &indexMaintainer)
+    : IFlushTarget("memoryindex.checkpoint", Type::SYNC, Component::INDEX),
+      _indexMaintainer(indexMaintainer),
+      _flushStats(indexMaintainer.getFlushStats()),
+      _lastStats()
+{
+}
+
+IndexCheckpointTarget::~IndexCheckpointTarget() = default;
+
+IFlushTarget::MemoryGain
+IndexCheckpointTarget::getApproxMemoryGain() const
+{
+    return MemoryGain(0, 0);
+}
+
+IFlushTarget::DiskGain
+IndexCheckpointTarget::getApproxDiskGain() const
+{
+    return DiskGain(0, 0);
+}
+
+IFlushTarget::SerialNum
+IndexCheckpointTarget::getFlushedSerialNum() const
+{
+    return _indexMaintainer.getFlushedSerialNum();
+}
+
+IFlushTarget::Time
+IndexCheckpointTarget::getLastFlushTime() const
+{
+    return _indexMaintainer.getLastCheckpointTime();
+}
+
+bool
+IndexCheckpointTarget::needUrgentFlush() const
+{
+    return _indexMaintainer.needCheckpoint();
+}
+
+IFlushTarget::Task::UP
+IndexCheckpointTarget::initFlush(SerialNum serialNum)
+{
+    return _indexMaintainer.initCheckpoint(serialNum);
+}
+
+uint64_t
+IndexCheckpointTarget::getApproxBytesToWriteToDisk() const
+{
+    // The checkpoint is about as large as the flushed memory index
+    return _flushStats.disk_write_bytes;
+}
+
+}
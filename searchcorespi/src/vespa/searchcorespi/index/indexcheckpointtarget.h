@@ -0,0 +1,37 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "indexmaintainer.h"
+#include <vespa/searchcorespi/flush/iflushtarget.h>
+
+namespace searchcorespi::index {
+
+/**
+ * Flush target for writing a checkpoint of the memory index in an
+ * IndexMaintainer. It frees no memory, but lets the transaction log be
+ * pruned and restart only replay the operations after the checkpoint.
+ **/
+class IndexCheckpointTarget : public IFlushTarget {
+private:
+    IndexMaintainer &_indexMaintainer;
+    IndexMaintainer::FlushStats _flushStats;
+    FlushStats _lastStats;
+
+public:
+    IndexCheckpointTarget(IndexMaintainer &indexMaintainer);
+    ~IndexCheckpointTarget() override;
+
+    // Implements IFlushTarget
+    MemoryGain getApproxMemoryGain() const override;
+    DiskGain getApproxDiskGain() const override;
+    SerialNum getFlushedSerialNum() const override;
+    Time getLastFlushTime() const override;
+
+    bool needUrgentFlush() const override;
+
+    Task::UP initFlush(SerialNum currentSerial) override;
+    FlushStats getLastFlushStats() const override { return _lastStats; }
+    uint64_t getApproxBytesToWriteToDisk() const override;
+};
+
+}
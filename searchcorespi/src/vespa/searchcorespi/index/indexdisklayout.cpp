@@ -35,6 +35,18 @@ IndexDiskLayout::getFusionDir(uint32_t sourceId) const
     return ost.str();
 }
 
+vespalib::string
+IndexDiskLayout::getWarmupTermsFileName() const
+{
+    return _baseDir + "/warmup_terms.txt";
+}
+
+vespalib::string
+IndexDiskLayout::getMemoryIndexCheckpointFileName() const
+{
+    return _baseDir + "/memoryindex.checkpoint";
+}
+
 vespalib::string
 IndexDiskLayout::getSerialNumFileName(const vespalib::string &dir)
 {
@@ -23,6 +23,8 @@ public:
     IndexDiskLayout(const vespalib::string &baseDir);
     vespalib::string getFlushDir(uint32_t sourceId) const;
     vespalib::string getFusionDir(uint32_t sourceId) const;
+    vespalib::string getWarmupTermsFileName() const;
+    vespalib::string getMemoryIndexCheckpointFileName() const;
 
     static vespalib::string getSerialNumFileName(const vespalib::string &dir);
     static vespalib::string getSchemaFileName(const vespalib::string &dir);
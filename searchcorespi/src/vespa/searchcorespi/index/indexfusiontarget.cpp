@@ -39,7 +39,8 @@ IndexFusionTarget::IndexFusionTarget(IndexMaintainer &indexMaintainer)
       _lastStats()
 {
     _lastStats.setPathElementsToLog(7);
-    LOG(debug, "New target, Num flushed: %d, Disk usage: %" PRIu64, _fusionStats.numUnfused, _fusionStats.diskUsage);
+    LOG(debug, "New target, Num flushed: %d, Disk usage: %" PRIu64 ", Fused disk usage: %" PRIu64,
+        _fusionStats.numUnfused, _fusionStats.diskUsage, _fusionStats.fusedDiskUsage);
 }
 
 IndexFusionTarget::~IndexFusionTarget() {}
@@ -61,7 +62,10 @@ IndexFusionTarget::getApproxDiskGain() const
                                         static_cast<int>
                                         (_fusionStats.numUnfused - 1)
                                          ))));
-    diskUsageGain = std::min(diskUsageGain, diskUsageBefore);
+    // Merge similarly sized indexes: rewriting the fused index only pays
+    // off once the flushed indexes add up to a sizable part of it.
+    uint64_t unfusedDiskUsage = diskUsageBefore - std::min(_fusionStats.fusedDiskUsage, diskUsageBefore);
+    diskUsageGain = std::min(diskUsageGain, unfusedDiskUsage);
     if (!_fusionStats._canRunFusion)
         diskUsageGain = 0;
     return DiskGain(diskUsageBefore, diskUsageBefore - diskUsageGain);
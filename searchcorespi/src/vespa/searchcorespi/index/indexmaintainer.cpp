@@ -4,10 +4,13 @@
 #include "diskindexcleaner.h"
 #include "eventlogger.h"
 #include "fusionrunner.h"
+#include "indexcheckpointtarget.h"
 #include "indexflushtarget.h"
 #include "indexfusiontarget.h"
 #include "indexreadutilities.h"
+#include "indexsearchablevisitor.h"
 #include "indexwriteutilities.h"
+#include <vespa/searchlib/common/isequencedtaskexecutor.h>
 #include <vespa/searchlib/common/serialnumfileheadercontext.h>
 #include <vespa/searchlib/util/dirtraverse.h>
 #include <vespa/searchlib/util/filekit.h>
@@ -134,6 +137,29 @@ public:
 
 DiskIndexWithDestructorClosure::~DiskIndexWithDestructorClosure() {}
 
+/**
+ * Finds the disk usage of the disk index in the given directory.
+ * The same index can be visited twice while a new index collection
+ * is warming up.
+ */
+class FusedDiskUsageVisitor : public IndexSearchableVisitor
+{
+    const vespalib::string _fusionDir;
+    uint64_t _diskUsage;
+public:
+    FusedDiskUsageVisitor(const vespalib::string &fusionDir)
+        : _fusionDir(fusionDir),
+          _diskUsage(0)
+    { }
+    void visit(const IDiskIndex &index) override {
+        if (index.getIndexDir() == _fusionDir) {
+            _diskUsage = index.getSearchableStats().sizeOnDisk();
+        }
+    }
+    void visit(const IMemoryIndex &) override { }
+    uint64_t getDiskUsage() const { return _diskUsage; }
+};
+
 }  // namespace
 
 IndexMaintainer::FusionArgs::~FusionArgs() {
@@ -322,7 +348,9 @@ IndexMaintainer::flushMemoryIndex(IMemoryIndex &memoryIndex,
                                              serialNum);
     IndexWriteUtilities::writeSerialNum(serialNum, flushDir,
                                         _ctx.getFileHeaderContext());
-    return loadDiskIndex(flushDir);
+    IDiskIndex::SP diskIndex = loadDiskIndex(flushDir);
+    _flushBytesWritten.fetch_add(diskIndex->getSearchableStats().sizeOnDisk(), std::memory_order_relaxed);
+    return diskIndex;
 }
 
 ISearchableIndexCollection::UP
@@ -390,7 +418,8 @@ IndexMaintainer::swapInNewIndex(LockGuard & guard,
             LOG(debug, "Warming up a disk index.");
             indexes = std::make_shared<WarmupIndexCollection>
                       (_warmupConfig, getLeaf(guard, _source_list, true), indexes,
-                       static_cast<IDiskIndex &>(source), _ctx.getWarmupExecutor(), *this);
+                       static_cast<IDiskIndex &>(source), _ctx.getWarmupExecutor(), *this,
+                       _warmupTermLog);
         } else {
             LOG(debug, "No warmup needed as it is a memory index that is mapped in.");
         }
@@ -473,6 +502,7 @@ IndexMaintainer::doneInitFlush(FlushArgs *args, IMemoryIndex::SP *new_index)
             _source_selector_changes = 0;
         }
         _current_index = *new_index;
+        _current_index_base_serial_num = args->flush_serial_num;
     }
     if (args->_skippedEmptyLast) {
         replaceSource(_current_index_id, _current_index);
@@ -499,6 +529,7 @@ IndexMaintainer::doFlush(FlushArgs args)
     if (args.stats != NULL) {
         updateFlushStats(args);
     }
+    removeStaleCheckpoint();
 
     scheduleFusion(flushIds);
 }
@@ -698,6 +729,9 @@ IndexMaintainer::makeSureAllRemainingWarmupIsDone(ISearchableIndexCollection::SP
     LOG(info, "Sync warmupExecutor.");
     _ctx.getWarmupExecutor().sync();
     LOG(info, "Now the keep alive of the warmupindexcollection should be gone.");
+    if (_warmupTermLog) {
+        _warmupTermLog->save(_layout.getWarmupTermsFileName());
+    }
     return true;
 }
 
@@ -748,6 +782,7 @@ IndexMaintainer::doneSetSchema(SetSchemaArgs &args, IMemoryIndex::SP &newIndex)
             assert(_current_index_id < ISourceSelector::SOURCE_LIMIT);
             // Extra index to flush next time flushing is performed
             _frozenMemoryIndexes.emplace_back(args._oldIndex, freezeSerialNum, std::move(saveInfo), oldAbsoluteId);
+            _current_index_base_serial_num = freezeSerialNum;
         }
         _current_index = newIndex;
     }
@@ -817,15 +852,25 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
       _current_serial_num(0),
       _flush_serial_num(0),
       _lastFlushTime(),
+      _current_index_base_serial_num(0),
+      _checkpoint_serial_num(0),
+      _checkpoint_base_serial_num(0),
+      _lastCheckpointTime(),
+      _checkpointInterval(config.getCheckpointInterval()),
       _frozenMemoryIndexes(),
       _state_lock(),
       _index_update_lock(),
       _new_search_lock(),
       _remove_lock(),
+      _checkpoint_lock(),
       _fusion_spec(),
       _fusion_lock(),
       _maxFlushed(config.getMaxFlushed()),
       _maxFrozen(10),
+      _documentsIngested(0),
+      _flushBytesWritten(0),
+      _fusionBytesWritten(0),
+      _warmupTermLog(),
       _changeGens(),
       _schemaUpdateLock(),
       _tuneFileAttributes(config.getTuneFileAttributes()),
@@ -835,6 +880,10 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
     // Called by document db init executor thread
     _changeGens.bumpPruneGen();
     DiskIndexCleaner::clean(_base_dir, *_active_indexes);
+    if (_warmupConfig.getMaxRecordedTerms() > 0) {
+        _warmupTermLog = std::make_shared<WarmupTermLog>(_warmupConfig.getMaxRecordedTerms());
+        _warmupTermLog->load(_layout.getWarmupTermsFileName());
+    }
     FusionSpec spec = IndexReadUtilities::readFusionSpec(_base_dir);
     _next_id = 1 + (spec.flush_ids.empty() ? spec.last_fusion_id : spec.flush_ids.back());
     _last_fusion_id = spec.last_fusion_id;
@@ -865,6 +914,9 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
     _current_index = operations.createMemoryIndex(_schema, _current_serial_num);
     _current_index_id = getNewAbsoluteId() - _last_fusion_id;
     assert(_current_index_id < ISourceSelector::SOURCE_LIMIT);
+    _current_index_base_serial_num = _flush_serial_num;
+    _lastCheckpointTime = fastos::ClockSystem::now();
+    loadCheckpoint();
     ISearchableIndexCollection::UP sourceList(loadDiskIndexes(spec, ISearchableIndexCollection::UP(new IndexCollection(_selector))));
     LOG(debug, "Index manager created with flushed serial num %" PRIu64, _flush_serial_num);
     sourceList->append(_current_index_id, _current_index);
@@ -904,18 +956,151 @@ IndexMaintainer::initFlush(SerialNum serialNum, searchcorespi::FlushStats * stat
     (void) success;
     if (args._skippedEmptyLast && args._extraIndexes.empty()) {
         // No memory index to flush, it was empty
-        LockGuard lock(_state_lock);
-        _flush_serial_num = _current_serial_num;
-        _lastFlushTime = fastos::ClockSystem::now();
-        LOG(debug, "No memory index to flush. Update serial number and flush time to current: "
-            "flushSerialNum(%" PRIu64 "), lastFlushTime(%f)",
-            _flush_serial_num, _lastFlushTime.sec());
+        {
+            LockGuard lock(_state_lock);
+            _flush_serial_num = _current_serial_num;
+            _lastFlushTime = fastos::ClockSystem::now();
+            LOG(debug, "No memory index to flush. Update serial number and flush time to current: "
+                "flushSerialNum(%" PRIu64 "), lastFlushTime(%f)",
+                _flush_serial_num, _lastFlushTime.sec());
+        }
+        removeStaleCheckpoint();
         return FlushTask::UP();
     }
     SerialNum realSerialNum = args.flush_serial_num;
     return makeFlushTask(makeClosure(this, &IndexMaintainer::doFlush, std::move(args)), realSerialNum);
 }
 
+void
+IndexMaintainer::loadCheckpoint()
+{
+    // Called by document db init executor thread
+    const vespalib::string fileName = _layout.getMemoryIndexCheckpointFileName();
+    MemoryIndexCheckpoint checkpoint;
+    if (!checkpoint.load(fileName)) {
+        return;
+    }
+    bool loaded = false;
+    if (checkpoint.baseSerialNum == _flush_serial_num && checkpoint.serialNum > _flush_serial_num) {
+        try {
+            loaded = _current_index->loadCheckpoint(checkpoint.image, checkpoint.serialNum);
+        } catch (const vespalib::IllegalStateException &e) {
+            LOG(warning, "Unable to load memory index checkpoint '%s': %s", fileName.c_str(), e.what());
+            // Start over with an empty memory index
+            _current_index = _operations.createMemoryIndex(_schema, _current_serial_num);
+        }
+    }
+    if (!loaded) {
+        LOG(info, "Removing stale memory index checkpoint '%s' (base serial num %" PRIu64
+            ", flushed serial num %" PRIu64 ")",
+            fileName.c_str(), checkpoint.baseSerialNum, _flush_serial_num);
+        FastOS_File::Delete(fileName.c_str());
+        return;
+    }
+    for (uint32_t lid : checkpoint.lids) {
+        _selector->setSource(lid, _current_index_id);
+    }
+    _source_selector_changes = checkpoint.lids.size();
+    _current_serial_num = checkpoint.serialNum;
+    _checkpoint_serial_num = checkpoint.serialNum;
+    _checkpoint_base_serial_num = checkpoint.baseSerialNum;
+    LOG(info, "Loaded memory index checkpoint '%s' with %zu lids, serial num %" PRIu64,
+        fileName.c_str(), checkpoint.lids.size(), checkpoint.serialNum);
+}
+
+FlushTask::UP
+IndexMaintainer::initCheckpoint(SerialNum serialNum)
+{
+    assert(_ctx.getThreadingService().master().isCurrentThread()); // while flush engine scheduler thread waits
+    {
+        LockGuard lock(_index_update_lock);
+        _current_serial_num = std::max(_current_serial_num, serialNum);
+    }
+    scheduleCommit();
+    // Ensure that all index thread tasks accessing memory index have completed.
+    _ctx.getThreadingService().sync();
+    auto checkpoint = std::make_shared<MemoryIndexCheckpoint>();
+    {
+        LockGuard lock(_state_lock);
+        _lastCheckpointTime = fastos::ClockSystem::now();
+        if (_current_index_base_serial_num != _flush_serial_num ||
+            _current_serial_num <= std::max(_flush_serial_num, _checkpoint_serial_num) ||
+            (!_current_index->hasReceivedDocumentInsert() && _source_selector_changes == 0))
+        {
+            // Frozen memory indexes are not covered by a checkpoint, or nothing new to save
+            return FlushTask::UP();
+        }
+        checkpoint->baseSerialNum = _current_index_base_serial_num;
+        checkpoint->serialNum = _current_serial_num;
+        auto it = _selector->createIterator();
+        for (uint32_t lid = 0; lid < it->getDocIdLimit(); ++lid) {
+            if (it->getSource(lid) == _current_index_id) {
+                checkpoint->lids.push_back(lid);
+            }
+        }
+        _current_index->saveCheckpoint(checkpoint->image);
+    }
+    SerialNum realSerialNum = checkpoint->serialNum;
+    return makeFlushTask(makeClosure(this, &IndexMaintainer::doCheckpoint, std::move(checkpoint)), realSerialNum);
+}
+
+void
+IndexMaintainer::doCheckpoint(std::shared_ptr<MemoryIndexCheckpoint> checkpoint)
+{
+    // Called by a flush worker thread
+    LockGuard checkpoint_lock(_checkpoint_lock);
+    const vespalib::string fileName = _layout.getMemoryIndexCheckpointFileName();
+    if (!checkpoint->save(fileName, _ctx.getFileHeaderContext())) {
+        return;
+    }
+    _flushBytesWritten.fetch_add(checkpoint->image.size() + checkpoint->lids.size() * sizeof(uint32_t),
+                                 std::memory_order_relaxed);
+    bool stale = false;
+    {
+        LockGuard state_lock(_state_lock);
+        stale = (checkpoint->baseSerialNum != _flush_serial_num);
+        if (!stale) {
+            _checkpoint_serial_num = checkpoint->serialNum;
+            _checkpoint_base_serial_num = checkpoint->baseSerialNum;
+        }
+    }
+    if (stale) {
+        // Memory index was flushed while the checkpoint was written
+        FastOS_File::Delete(fileName.c_str());
+    } else {
+        LOG(debug, "Wrote memory index checkpoint with serial num %" PRIu64, checkpoint->serialNum);
+    }
+}
+
+void
+IndexMaintainer::removeStaleCheckpoint()
+{
+    LockGuard checkpoint_lock(_checkpoint_lock);
+    {
+        LockGuard state_lock(_state_lock);
+        if (_checkpoint_serial_num == 0 || _checkpoint_base_serial_num == _flush_serial_num) {
+            return;
+        }
+        _checkpoint_serial_num = 0;
+        _checkpoint_base_serial_num = 0;
+    }
+    FastOS_File::Delete(_layout.getMemoryIndexCheckpointFileName().c_str());
+}
+
+bool
+IndexMaintainer::needCheckpoint() const
+{
+    // Called by flush engine scheduler thread (from getFlushTargets())
+    if (_checkpointInterval <= 0.0) {
+        return false;
+    }
+    LockGuard state_lock(_state_lock);
+    fastos::TimeStamp now = fastos::ClockSystem::now();
+    return (_current_index_base_serial_num == _flush_serial_num) &&
+        (_current_serial_num > std::max(_flush_serial_num, _checkpoint_serial_num)) &&
+        ((now - _lastCheckpointTime).sec() >= _checkpointInterval);
+}
+
 FusionSpec
 IndexMaintainer::getFusionSpec()
 {
@@ -982,7 +1167,10 @@ IndexMaintainer::runFusion(const FusionSpec &fusion_spec)
     if (FastOS_File::Stat(lastSerialFile.c_str(), &statInfo)) {
         serialNum = IndexReadUtilities::readSerialNum(lastFlushDir);
     }
-    FusionRunner fusion_runner(_base_dir, args._schema, tuneFileAttributes, _ctx.getFileHeaderContext());
+    // Use as many threads for merging fields as for inverting them
+    uint32_t numFusionThreads = _ctx.getThreadingService().indexFieldInverter().getNumExecutors();
+    FusionRunner fusion_runner(_base_dir, args._schema, tuneFileAttributes, _ctx.getFileHeaderContext(),
+                               numFusionThreads);
     uint32_t new_fusion_id = fusion_runner.fuse(fusion_spec, serialNum, _operations);
     bool ok = (new_fusion_id != 0);
     if (ok) {
@@ -1009,6 +1197,7 @@ IndexMaintainer::runFusion(const FusionSpec &fusion_spec)
     }
     ChangeGens changeGens = getChangeGens();
     IDiskIndex::SP new_index(loadDiskIndex(new_fusion_dir));
+    _fusionBytesWritten.fetch_add(new_index->getSearchableStats().sizeOnDisk(), std::memory_order_relaxed);
 
     // Post processing after fusion operation has completed and new disk
     // index has been opened.
@@ -1088,15 +1277,30 @@ IndexMaintainer::getFusionStats() const
         stats.maxFlushed = _maxFlushed;
     }
     stats.diskUsage = source_list->getSearchableStats().sizeOnDisk();
+    uint32_t lastFusionId;
     {
         LockGuard guard(_fusion_lock);
         stats.numUnfused = _fusion_spec.flush_ids.size() + ((_fusion_spec.last_fusion_id != 0) ? 1 : 0);
         stats._canRunFusion = canRunFusion(_fusion_spec);
+        lastFusionId = _fusion_spec.last_fusion_id;
+    }
+    if (lastFusionId != 0) {
+        FusedDiskUsageVisitor visitor(getFusionDir(lastFusionId));
+        source_list->accept(visitor);
+        stats.fusedDiskUsage = visitor.getDiskUsage();
     }
     LOG(debug, "Get fusion stats. Disk usage: %" PRIu64 ", maxflushed: %d", stats.diskUsage, stats.maxFlushed);
     return stats;
 }
 
+IndexWriteStats
+IndexMaintainer::getWriteStats() const
+{
+    return IndexWriteStats(_documentsIngested.load(std::memory_order_relaxed),
+                           _flushBytesWritten.load(std::memory_order_relaxed),
+                           _fusionBytesWritten.load(std::memory_order_relaxed));
+}
+
 uint32_t
 IndexMaintainer::getNumFrozenMemoryIndexes(void) const
 {
@@ -1121,6 +1325,7 @@ IndexMaintainer::putDocument(uint32_t lid, const Document &doc, SerialNum serial
     _source_list->setSource(lid);
     ++_source_selector_changes;
     _current_serial_num = serialNum;
+    _documentsIngested.fetch_add(1, std::memory_order_relaxed);
 }
 
 void
@@ -1180,6 +1385,9 @@ IndexMaintainer::getFlushTargets(void)
     IFlushTarget::SP indexFusion(new IndexFusionTarget(*this));
     ret.push_back(indexFlush);
     ret.push_back(indexFusion);
+    if (_checkpointInterval > 0.0) {
+        ret.push_back(std::make_shared<IndexCheckpointTarget>(*this));
+    }
     return ret;
 }
 
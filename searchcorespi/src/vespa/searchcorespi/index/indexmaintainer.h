@@ -10,6 +10,7 @@
 #include "indexmaintainerconfig.h"
 #include "indexmaintainercontext.h"
 #include "imemoryindex.h"
+#include "memory_index_checkpoint.h"
 #include "warmupindexcollection.h"
 #include "ithreadingservice.h"
 #include "indexsearchable.h"
@@ -19,6 +20,7 @@
 #include <vespa/searchlib/attribute/fixedsourceselector.h>
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/util/sync.h>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -103,6 +105,14 @@ class IndexMaintainer : public IIndexManager,
     SerialNum         _current_serial_num;// Protected by IUL
     SerialNum         _flush_serial_num;  // Protected by SL
     fastos::TimeStamp _lastFlushTime; // Protected by SL
+    // Serial num of the disk index below the current memory index
+    SerialNum         _current_index_base_serial_num; // Protected by SL + IUL
+    // Last checkpoint of the current memory index, only valid while its
+    // base serial num is the flushed serial num.
+    SerialNum         _checkpoint_serial_num;      // Protected by SL
+    SerialNum         _checkpoint_base_serial_num; // Protected by SL
+    fastos::TimeStamp _lastCheckpointTime;         // Protected by SL
+    const double      _checkpointInterval;
     // Extra frozen memory indexes.  This list is empty unless new
     // memory index has been added by force (due to config change or
     // data structure limitations).
@@ -141,11 +151,16 @@ class IndexMaintainer : public IIndexManager,
     vespalib::Lock _index_update_lock;  // Inner lock (IUL)
     vespalib::Lock _new_search_lock;  // Inner lock   (NSL)
     vespalib::Lock _remove_lock;  // Lock for removing indexes.
+    vespalib::Lock _checkpoint_lock; // Serialize writing and removing checkpoint file, taken before SL.
     // Protected by SL + IUL
     FusionSpec     _fusion_spec;		// Protected by FL
     vespalib::Lock _fusion_lock;	// Fusion spec lock (FL)
     uint32_t       _maxFlushed;
     uint32_t       _maxFrozen;
+    std::atomic<uint64_t> _documentsIngested;
+    std::atomic<uint64_t> _flushBytesWritten;
+    std::atomic<uint64_t> _fusionBytesWritten;
+    WarmupTermLog::SP _warmupTermLog;   // Terms to replay when warming up the next disk index
     ChangeGens     _changeGens; // Protected by SL + IUL
     vespalib::Lock _schemaUpdateLock;	// Serialize rewrite of schema
     const search::TuneFileAttributes _tuneFileAttributes;
@@ -228,6 +243,10 @@ class IndexMaintainer : public IIndexManager,
     void reconfigureAfterFlush(FlushArgs &args, IDiskIndex::SP &diskIndex);
     bool doneFlush(FlushArgs *args, IDiskIndex::SP *disk_index);
 
+    void loadCheckpoint();
+    void doCheckpoint(std::shared_ptr<MemoryIndexCheckpoint> checkpoint);
+    void removeStaleCheckpoint();
+
 
     class FusionArgs
     {
@@ -302,6 +321,14 @@ public:
      * Updates flush stats when finished if specified.
      **/
     FlushTask::UP initFlush(SerialNum serialNum, FlushStats * stats);
+
+    /**
+     * Serializes the current memory index and returns a task writing
+     * it to the checkpoint file. A restart then loads the memory index
+     * from the checkpoint and only replays the operations after it.
+     **/
+    FlushTask::UP initCheckpoint(SerialNum serialNum);
+    bool needCheckpoint() const;
     FusionSpec getFusionSpec();
 
     /**
@@ -330,12 +357,14 @@ public:
     {
         FusionStats()
             : diskUsage(0),
+              fusedDiskUsage(0),
               maxFlushed(0),
               numUnfused(0),
               _canRunFusion(false)
         { }
 
         uint64_t diskUsage;
+        uint64_t fusedDiskUsage; // Part of diskUsage used by the last fusion index
         uint32_t maxFlushed;
         uint32_t numUnfused;
         bool _canRunFusion;
@@ -351,6 +380,8 @@ public:
     uint32_t getMaxFrozenMemoryIndexes() const { return _maxFrozen; }
 
     fastos::TimeStamp getLastFlushTime() const { return _lastFlushTime; }
+    fastos::TimeStamp getLastCheckpointTime() const { return _lastCheckpointTime; }
+    double getCheckpointInterval() const { return _checkpointInterval; }
 
     // Implements IIndexManager
     void putDocument(uint32_t lid, const Document &doc, SerialNum serialNum) override;
@@ -363,6 +394,10 @@ public:
     }
 
     SerialNum getFlushedSerialNum() const override {
+        vespalib::LockGuard lock(_state_lock);
+        if (_checkpoint_base_serial_num == _flush_serial_num) {
+            return std::max(_flush_serial_num, _checkpoint_serial_num);
+        }
         return _flush_serial_num;
     }
 
@@ -381,6 +416,8 @@ public:
         return _source_list->getSearchableStats();
     }
 
+    IndexWriteStats getWriteStats() const override;
+
     IFlushTarget::List getFlushTargets() override;
     void setSchema(const Schema & schema, SerialNum serialNum) override ;
     void setMaxFlushed(uint32_t maxFlushed) override;
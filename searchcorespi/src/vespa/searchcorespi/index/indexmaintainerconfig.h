@@ -20,6 +20,7 @@ private:
     const search::index::Schema _schema;
     const search::SerialNum _serialNum;
     const search::TuneFileAttributes _tuneFileAttributes;
+    const double _checkpointInterval;
 
 public:
     IndexMaintainerConfig(const vespalib::string &baseDir,
@@ -27,7 +28,8 @@ public:
                           size_t maxFlushed,
                           const search::index::Schema &schema,
                           const search::SerialNum serialNum,
-                          const search::TuneFileAttributes &tuneFileAttributes);
+                          const search::TuneFileAttributes &tuneFileAttributes,
+                          double checkpointInterval);
 
     ~IndexMaintainerConfig();
 
@@ -59,6 +61,11 @@ public:
     size_t getMaxFlushed() const {
         return _maxFlushed;
     }
+
+    /**
+     * Returns the number of seconds between checkpoints of the memory index, 0 disables them.
+     */
+    double getCheckpointInterval() const { return _checkpointInterval; }
 };
 
 }
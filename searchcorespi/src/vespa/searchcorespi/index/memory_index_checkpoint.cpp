@@ -0,0 +1,101 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "memory_index_checkpoint.h"
+#include <vespa/searchlib/common/fileheadercontext.h>
+#include <vespa/searchlib/util/fileutil.h>
+#include <vespa/fastlib/io/bufferedfile.h>
+#include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <cstring>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".searchcorespi.index.memory_index_checkpoint");
+
+using search::FileUtil;
+using vespalib::FileHeader;
+
+namespace searchcorespi::index {
+
+namespace {
+
+const vespalib::string baseSerialNumTag("baseSerialNum");
+const vespalib::string serialNumTag("serialNum");
+const vespalib::string numLidsTag("numLids");
+
+}
+
+MemoryIndexCheckpoint::MemoryIndexCheckpoint()
+    : baseSerialNum(0),
+      serialNum(0),
+      lids(),
+      image(),
+      _buffer()
+{
+}
+
+MemoryIndexCheckpoint::~MemoryIndexCheckpoint() = default;
+
+bool
+MemoryIndexCheckpoint::save(const vespalib::string &fileName,
+                            const search::common::FileHeaderContext &fileHeaderContext) const
+{
+    const vespalib::string tmpFileName = fileName + ".tmp";
+    Fast_BufferedFile file;
+    file.WriteOpen(tmpFileName.c_str());
+    FileHeader fileHeader;
+    fileHeaderContext.addTags(fileHeader, fileName);
+    fileHeader.putTag(FileHeader::Tag("desc", "Memory index checkpoint"));
+    fileHeader.putTag(FileHeader::Tag(baseSerialNumTag, baseSerialNum));
+    fileHeader.putTag(FileHeader::Tag(serialNumTag, serialNum));
+    fileHeader.putTag(FileHeader::Tag(numLidsTag, static_cast<uint64_t>(lids.size())));
+    bool ok = (fileHeader.writeFile(file) >= fileHeader.getSize());
+    ok = ok && file.CheckedWrite(lids.data(), lids.size() * sizeof(uint32_t));
+    ok = ok && file.CheckedWrite(image.peek(), image.size());
+    if (!file.Sync()) {
+        ok = false;
+    }
+    file.Close();
+    if (ok) {
+        FastOS_File renameFile(tmpFileName.c_str());
+        ok = renameFile.Rename(fileName.c_str());
+    }
+    if (!ok) {
+        LOG(warning, "Unable to write memory index checkpoint '%s'", fileName.c_str());
+        FastOS_File::Delete(tmpFileName.c_str());
+    }
+    return ok;
+}
+
+bool
+MemoryIndexCheckpoint::load(const vespalib::string &fileName)
+{
+    FastOS_StatInfo statInfo;
+    if (!FastOS_File::Stat(fileName.c_str(), &statInfo) || statInfo._size == 0) {
+        return false;
+    }
+    try {
+        _buffer = FileUtil::loadFile(fileName);
+    } catch (const vespalib::IllegalStateException &e) {
+        LOG(warning, "Unable to load memory index checkpoint '%s': %s", fileName.c_str(), e.what());
+        return false;
+    }
+    const vespalib::GenericHeader &header = _buffer->getHeader();
+    if (!header.hasTag(baseSerialNumTag) || !header.hasTag(serialNumTag) || !header.hasTag(numLidsTag)) {
+        LOG(warning, "Bad header in memory index checkpoint '%s'", fileName.c_str());
+        return false;
+    }
+    baseSerialNum = header.getTag(baseSerialNumTag).asInteger();
+    serialNum = header.getTag(serialNumTag).asInteger();
+    size_t lidsSize = header.getTag(numLidsTag).asInteger() * sizeof(uint32_t);
+    if (lidsSize > _buffer->size()) {
+        LOG(warning, "Truncated memory index checkpoint '%s'", fileName.c_str());
+        return false;
+    }
+    lids.resize(lidsSize / sizeof(uint32_t));
+    memcpy(lids.data(), _buffer->c_str(), lidsSize);
+    // Refer to the mapped file rather than copying the image
+    image = vespalib::nbostream_longlivedbuf(_buffer->c_str() + lidsSize, _buffer->size() - lidsSize);
+    return true;
+}
+
+}
@@ -0,0 +1,54 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/searchlib/common/serialnum.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <vector>
+
+namespace search::common { class FileHeaderContext; }
+namespace search::fileutil { class LoadedBuffer; }
+
+namespace searchcorespi::index {
+
+/**
+ * Checkpoint of the current memory index in an index maintainer. It
+ * holds the serialized memory index and the lids selecting it in the
+ * source selector, so a restart can load the memory index and only
+ * replay the transaction log after the checkpoint.
+ *
+ * The memory index only holds the operations after the disk index it
+ * is on top of, so the checkpoint is only valid as long as that is the
+ * last flushed disk index.
+ */
+struct MemoryIndexCheckpoint
+{
+    using SerialNum = search::SerialNum;
+
+    SerialNum             baseSerialNum; // Serial num of the disk index below the memory index
+    SerialNum             serialNum;     // Serial num of the last operation in the memory index
+    std::vector<uint32_t> lids;
+    vespalib::nbostream   image;         // See IMemoryIndex::saveCheckpoint()
+
+    MemoryIndexCheckpoint();
+    ~MemoryIndexCheckpoint();
+
+    /**
+     * Writes the checkpoint to a temporary file that is synced and
+     * renamed to the given name.
+     */
+    bool save(const vespalib::string &fileName,
+              const search::common::FileHeaderContext &fileHeaderContext) const;
+
+    /**
+     * Maps the given checkpoint file. The image refers to the mapped
+     * file until this checkpoint is destroyed.
+     */
+    bool load(const vespalib::string &fileName);
+
+private:
+    std::unique_ptr<search::fileutil::LoadedBuffer> _buffer;
+};
+
+}
@@ -0,0 +1,117 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "warmup_term_log.h"
+#include <vespa/vespalib/text/stringtokenizer.h>
+#include <vespa/fastos/file.h>
+#include <fstream>
+#include <cstdlib>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".searchcorespi.index.warmup_term_log");
+
+namespace searchcorespi::index {
+
+namespace {
+
+bool
+isSafe(const vespalib::string &s)
+{
+    return s.find('\t') == vespalib::string::npos && s.find('\n') == vespalib::string::npos;
+}
+
+}
+
+WarmupTermLog::WarmupTermLog(size_t maxTerms)
+    : _maxTerms(maxTerms),
+      _lock(),
+      _entries(),
+      _next(0)
+{
+}
+
+WarmupTermLog::~WarmupTermLog() = default;
+
+void
+WarmupTermLog::add(uint32_t fieldId, bool filter, const vespalib::string &fieldName, const vespalib::string &term)
+{
+    if (_maxTerms == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_entries.size() < _maxTerms) {
+        _entries.emplace_back(fieldId, filter, fieldName, term);
+    } else {
+        _entries[_next] = Entry(fieldId, filter, fieldName, term);
+        _next = (_next + 1) % _maxTerms;
+    }
+}
+
+std::vector<WarmupTermLog::Entry>
+WarmupTermLog::getEntries() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    std::vector<Entry> result;
+    result.reserve(_entries.size());
+    for (size_t i = 0; i < _entries.size(); ++i) {
+        result.push_back(_entries[(_next + i) % _entries.size()]);
+    }
+    return result;
+}
+
+size_t
+WarmupTermLog::size() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _entries.size();
+}
+
+bool
+WarmupTermLog::save(const vespalib::string &fileName) const
+{
+    vespalib::string tmpName = fileName + ".tmp";
+    {
+        std::ofstream file(tmpName.c_str());
+        if (!file) {
+            LOG(warning, "Could not open output file '%s'", tmpName.c_str());
+            return false;
+        }
+        for (const Entry &entry : getEntries()) {
+            if (isSafe(entry.fieldName) && isSafe(entry.term)) {
+                file << entry.fieldId << '\t' << (entry.filter ? 1 : 0) << '\t' <<
+                    entry.fieldName << '\t' << entry.term << '\n';
+            }
+        }
+        file.close();
+        if (file.fail()) {
+            LOG(warning, "Could not write to output file '%s'", tmpName.c_str());
+            return false;
+        }
+    }
+    if (!FastOS_File::Rename(tmpName.c_str(), fileName.c_str())) {
+        LOG(warning, "Could not rename '%s' to '%s'", tmpName.c_str(), fileName.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool
+WarmupTermLog::load(const vespalib::string &fileName)
+{
+    std::ifstream file(fileName.c_str());
+    if (!file) {
+        return true;
+    }
+    std::string line;
+    while (getline(file, line)) {
+        vespalib::StringTokenizer tokens(line, "\t", "");
+        if (tokens.size() != 4) {
+            LOG(warning, "Skipping malformed line in '%s'", fileName.c_str());
+            continue;
+        }
+        uint32_t fieldId = strtoul(vespalib::string(tokens[0]).c_str(), nullptr, 10);
+        add(fieldId, tokens[1] == "1", tokens[2], tokens[3]);
+    }
+    return true;
+}
+
+}
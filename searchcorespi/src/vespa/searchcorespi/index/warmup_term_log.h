@@ -0,0 +1,66 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace searchcorespi::index {
+
+/**
+ * Bounded log of query terms seen while warming up a disk index. When
+ * full, the oldest term is replaced. The log is saved to disk so the
+ * terms can be replayed against the next disk index to warm up, before
+ * it starts getting live queries.
+ *
+ * Thread safe.
+ */
+class WarmupTermLog
+{
+public:
+    using SP = std::shared_ptr<WarmupTermLog>;
+
+    struct Entry {
+        uint32_t         fieldId;
+        bool             filter;
+        vespalib::string fieldName;
+        vespalib::string term;
+
+        Entry(uint32_t fieldId_in, bool filter_in, const vespalib::string &fieldName_in, const vespalib::string &term_in)
+            : fieldId(fieldId_in), filter(filter_in), fieldName(fieldName_in), term(term_in)
+        { }
+    };
+
+private:
+    const size_t       _maxTerms;
+    mutable std::mutex _lock;
+    std::vector<Entry> _entries;
+    size_t             _next;     // Entry to replace when full
+
+public:
+    WarmupTermLog(size_t maxTerms);
+    ~WarmupTermLog();
+
+    void add(uint32_t fieldId, bool filter, const vespalib::string &fieldName, const vespalib::string &term);
+
+    /**
+     * Returns the terms in the log, oldest first.
+     */
+    std::vector<Entry> getEntries() const;
+    size_t size() const;
+    size_t getMaxTerms() const { return _maxTerms; }
+
+    /**
+     * Saves the terms to the given file, replacing it atomically.
+     * Terms containing tabs or newlines are skipped.
+     */
+    bool save(const vespalib::string &fileName) const;
+
+    /**
+     * Adds terms from the given file. A missing file is not an error.
+     */
+    bool load(const vespalib::string &fileName);
+};
+
+}
@@ -1,6 +1,8 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <cstdint>
+
 namespace searchcorespi {
 namespace index {
 
@@ -9,13 +11,20 @@ namespace index {
  **/
 class WarmupConfig {
 public:
-    WarmupConfig() : _duration(0.0), _unpack(false) { }
-    WarmupConfig(double duration, bool unpack) : _duration(duration), _unpack(unpack) { }
+    WarmupConfig() : _duration(0.0), _unpack(false), _maxRecordedTerms(0) { }
+    WarmupConfig(double duration, bool unpack, uint32_t maxRecordedTerms = 0)
+        : _duration(duration), _unpack(unpack), _maxRecordedTerms(maxRecordedTerms) { }
     double getDuration() const { return _duration; }
     bool getUnpack() const { return _unpack; }
+    /**
+     * Max number of query terms seen during warmup that are saved and
+     * replayed when warming up the next disk index. 0 disables replay.
+     */
+    uint32_t getMaxRecordedTerms() const { return _maxRecordedTerms; }
 private:
-    const double _duration;
-    const bool   _unpack;
+    const double   _duration;
+    const bool     _unpack;
+    const uint32_t _maxRecordedTerms;
 };
 
 }
@@ -3,6 +3,7 @@
 #include "idiskindex.h"
 #include <vespa/vespalib/util/closuretask.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
+#include <vespa/searchlib/query/tree/simplequery.h>
 #include <vespa/searchlib/query/tree/termnodes.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/stllike/hash_set.h>
@@ -12,7 +13,9 @@ LOG_SETUP(".searchcorespi.index.warmupindexcollection");
 
 namespace searchcorespi {
 
+using search::query::SimpleStringTerm;
 using search::query::StringBase;
+using search::query::Weight;
 using search::queryeval::Blueprint;
 using search::fef::MatchDataLayout;
 using search::queryeval::SearchIterator;
@@ -20,6 +23,7 @@ using search::queryeval::ISourceSelector;
 using vespalib::makeTask;
 using vespalib::makeClosure;
 using index::IDiskIndex;
+using index::WarmupTermLog;
 using fastos::TimeStamp;
 using fastos::ClockSystem;
 using TermMap = vespalib::hash_set<vespalib::string>;
@@ -34,7 +38,8 @@ WarmupIndexCollection::WarmupIndexCollection(const WarmupConfig & warmupConfig,
                                              ISearchableIndexCollection::SP next,
                                              IndexSearchable & warmup,
                                              vespalib::ThreadExecutor & executor,
-                                             IWarmupDone & warmupDone) :
+                                             IWarmupDone & warmupDone,
+                                             WarmupTermLog::SP termLog) :
     _warmupConfig(warmupConfig),
     _prev(prev),
     _next(next),
@@ -42,7 +47,10 @@ WarmupIndexCollection::WarmupIndexCollection(const WarmupConfig & warmupConfig,
     _executor(executor),
     _warmupDone(warmupDone),
     _warmupEndTime(ClockSystem::now() + TimeStamp::Seconds(warmupConfig.getDuration())),
-    _handledTerms(std::make_unique<FieldTermMap>())
+    _handledTerms(std::make_unique<FieldTermMap>()),
+    _termLog(std::move(termLog)),
+    _termsToReplay(0),
+    _termsReplayed(0)
 {
     if (next->valid()) {
         setCurrentIndex(next->getCurrentIndex());
@@ -51,6 +59,40 @@ WarmupIndexCollection::WarmupIndexCollection(const WarmupConfig & warmupConfig,
     }
     LOG(debug, "For %g seconds I will warm up '%s' %s unpack.", warmupConfig.getDuration(), typeid(_warmup).name(), warmupConfig.getUnpack() ? "with" : "without");
     LOG(debug, "%s", toString().c_str());
+    if (_termLog) {
+        replayRecordedTerms();
+    }
+}
+
+void
+WarmupIndexCollection::replayRecordedTerms()
+{
+    // Blueprints are created by the tasks, to keep dictionary lookups
+    // in the warmup threads.
+    for (const WarmupTermLog::Entry &entry : _termLog->getEntries()) {
+        if (handledBefore(entry.fieldId, entry.term)) {
+            continue;
+        }
+        ++_termsToReplay;
+        _executor.execute(std::make_unique<ReplayTask>(entry, *this));
+    }
+    if (_termsToReplay != 0) {
+        LOG(info, "Replaying %zu recorded terms to warm up '%s'", _termsToReplay, toString().c_str());
+    }
+}
+
+WarmupIndexCollection::ReplayProgress
+WarmupIndexCollection::getReplayProgress() const
+{
+    ReplayProgress progress;
+    progress.termsToReplay = _termsToReplay;
+    progress.termsReplayed = _termsReplayed.load(std::memory_order_relaxed);
+    fastos::TimeStamp now(fastos::ClockSystem::now());
+    std::lock_guard<std::mutex> guard(_lock);
+    progress.secondsLeft = (now < _warmupEndTime)
+                           ? (_warmupEndTime - now).sec()
+                           : 0.0;
+    return progress;
 }
 
 void
@@ -132,13 +174,18 @@ WarmupIndexCollection::handledBefore(uint32_t fieldId, const Node &term)
 {
     const StringBase * sb(dynamic_cast<const StringBase *>(&term));
     if (sb != NULL) {
-        const vespalib::string & s = sb->getTerm();
-        std::lock_guard<std::mutex> guard(_lock);
-        TermMap::insert_result found = (*_handledTerms)[fieldId].insert(s);
-        return ! found.second;
+        return handledBefore(fieldId, sb->getTerm());
     }
     return true;
 }
+
+bool
+WarmupIndexCollection::handledBefore(uint32_t fieldId, const vespalib::string &term)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    TermMap::insert_result found = (*_handledTerms)[fieldId].insert(term);
+    return ! found.second;
+}
 Blueprint::UP
 WarmupIndexCollection::createBlueprint(const IRequestContext & requestContext,
                                        const FieldSpec &field,
@@ -165,7 +212,13 @@ WarmupIndexCollection::createBlueprint(const IRequestContext & requestContext,
         const FieldSpec & f(fields[i]);
         FieldSpec fs(f.getName(), f.getFieldId(), mdl.allocTermField(f.getFieldId()), f.isFilter());
         fsl.add(fs);
-        needWarmUp = needWarmUp || ! handledBefore(fs.getFieldId(), term);
+        if (!handledBefore(fs.getFieldId(), term)) {
+            needWarmUp = true;
+            if (_termLog) {
+                const StringBase &sb(static_cast<const StringBase &>(term));
+                _termLog->add(f.getFieldId(), f.isFilter(), f.getName(), sb.getTerm());
+            }
+        }
     }
     if (needWarmUp) {
         Task::UP task(new WarmupTask(mdl.createMatchData(), *this));
@@ -215,22 +268,46 @@ WarmupIndexCollection::getSearchableSP(uint32_t i) const
     return _next->getSearchableSP(i);
 }
 
+void
+WarmupIndexCollection::warmup(Blueprint &blueprint, MatchData &matchData)
+{
+    LOG(debug, "Warming up %s", blueprint.asString().c_str());
+    blueprint.fetchPostings(true);
+    SearchIterator::UP it(blueprint.createSearch(matchData, true));
+    it->initFullRange();
+    for (uint32_t docId = it->seekFirst(1); !it->isAtEnd(); docId = it->seekNext(docId+1)) {
+        if (doUnpack()) {
+            it->unpack(docId);
+        }
+    }
+}
+
 void
 WarmupIndexCollection::WarmupTask::run()
 {
     if (_warmup._warmupEndTime != 0) {
-        LOG(debug, "Warming up %s", _bluePrint->asString().c_str());
-        _bluePrint->fetchPostings(true);
-        SearchIterator::UP it(_bluePrint->createSearch(*_matchData, true));
-        it->initFullRange();
-        for (uint32_t docId = it->seekFirst(1); !it->isAtEnd(); docId = it->seekNext(docId+1)) {
-            if (_warmup.doUnpack()) {
-                it->unpack(docId);
-            }
-        }
+        _warmup.warmup(*_bluePrint, *_matchData);
     } else {
         LOG(debug, "Warmup has finished, ignoring task.");
     }
 }
 
+void
+WarmupIndexCollection::ReplayTask::run()
+{
+    if (_warmup._warmupEndTime != 0) {
+        MatchDataLayout mdl;
+        FieldSpecList fsl;
+        fsl.add(FieldSpec(_entry.fieldName, _entry.fieldId, mdl.allocTermField(_entry.fieldId), _entry.filter));
+        SimpleStringTerm term(_entry.term, _entry.fieldName, 0, Weight(100));
+        MatchData::UP matchData(mdl.createMatchData());
+        FakeRequestContext requestContext;
+        Blueprint::UP blueprint(_warmup._warmup.createBlueprint(requestContext, fsl, term));
+        _warmup.warmup(*blueprint, *matchData);
+    } else {
+        LOG(debug, "Warmup has finished, ignoring replay task.");
+    }
+    _warmup._termsReplayed.fetch_add(1, std::memory_order_relaxed);
+}
+
 }
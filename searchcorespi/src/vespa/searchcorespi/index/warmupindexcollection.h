@@ -3,9 +3,11 @@
 #pragma once
 
 #include "isearchableindexcollection.h"
+#include "warmup_term_log.h"
 #include "warmupconfig.h"
 #include <vespa/vespalib/util/threadexecutor.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
+#include <atomic>
 
 namespace searchcorespi {
 
@@ -31,7 +33,8 @@ public:
                           ISearchableIndexCollection::SP next,
                           IndexSearchable & warmup,
                           vespalib::ThreadExecutor & executor,
-                          IWarmupDone & warmupDone);
+                          IWarmupDone & warmupDone,
+                          index::WarmupTermLog::SP termLog = index::WarmupTermLog::SP());
     ~WarmupIndexCollection();
     // Implements IIndexCollection
     const ISourceSelector &getSourceSelector() const override;
@@ -61,6 +64,17 @@ public:
     const ISearchableIndexCollection::SP & getNextIndexCollection() const { return _next; }
     vespalib::string toString() const override;
     bool doUnpack() const { return _warmupConfig.getUnpack(); }
+
+    /**
+     * Progress of replaying recorded terms against the index being
+     * warmed up.
+     */
+    struct ReplayProgress {
+        size_t termsToReplay;
+        size_t termsReplayed;
+        double secondsLeft; // Until warmup ends and the index goes live
+    };
+    ReplayProgress getReplayProgress() const;
 private:
     typedef search::fef::MatchData MatchData;
     typedef search::queryeval::FakeRequestContext FakeRequestContext;
@@ -89,8 +103,28 @@ private:
         FakeRequestContext       _requestContext;
     };
 
+    /**
+     * Looks up a recorded term in the index being warmed up and
+     * warms up its posting list.
+     */
+    class ReplayTask : public Task {
+    public:
+        ReplayTask(const index::WarmupTermLog::Entry &entry, WarmupIndexCollection & warmup) :
+            _warmup(warmup),
+            _entry(entry)
+        { }
+    private:
+        void run() override;
+        WarmupIndexCollection      & _warmup;
+        index::WarmupTermLog::Entry  _entry;
+    };
+
+    void warmup(Blueprint &blueprint, MatchData &matchData);
+
     void fireWarmup(Task::UP task);
     bool handledBefore(uint32_t fieldId, const Node &term);
+    bool handledBefore(uint32_t fieldId, const vespalib::string &term);
+    void replayRecordedTerms();
 
     const WarmupConfig               _warmupConfig;
     ISearchableIndexCollection::SP   _prev;
@@ -99,8 +133,11 @@ private:
     vespalib::ThreadExecutor       & _executor;
     IWarmupDone                    & _warmupDone;
     fastos::TimeStamp                _warmupEndTime;
-    std::mutex                       _lock;
+    mutable std::mutex               _lock;
     std::unique_ptr<FieldTermMap>    _handledTerms;
+    index::WarmupTermLog::SP         _termLog;
+    size_t                           _termsToReplay;
+    std::atomic<size_t>              _termsReplayed;
 };
 
 }  // namespace searchcorespi
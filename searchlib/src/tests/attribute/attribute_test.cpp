@@ -7,7 +7,9 @@
 #include <vespa/searchlib/attribute/attributefile.h>
 #include <vespa/searchlib/attribute/attributeguard.h>
 #include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributefilesavetarget.h>
 #include <vespa/searchlib/attribute/attributememorysavetarget.h>
+#include <vespa/searchlib/attribute/attributesaver.h>
 #include <vespa/searchlib/attribute/singlenumericattribute.h>
 #include <vespa/searchlib/attribute/multinumericattribute.h>
 #include <vespa/searchlib/attribute/singlestringattribute.h>
@@ -213,6 +215,7 @@ private:
     void testGeneration();
 
     void testCreateSerialNum();
+    void testDeltaSave();
 
     void testPredicateHeaderTags();
 
@@ -535,6 +538,16 @@ void AttributeTest::testReload()
         testReloadInt(iv1, iv2, iv3, 0);
         testReloadInt(iv1, iv2, iv3, 100);
     }
+    {
+        Config cfg(BasicType::INT32, CollectionType::SINGLE);
+        cfg.setMmapLoad(true);
+        AttributePtr iv1 = createAttribute("smint32_1", cfg);
+        AttributePtr iv2 = createAttribute("smint32_2", cfg);
+        AttributePtr iv3 = createAttribute("smint32_3", cfg);
+        testReloadInt(iv1, iv2, iv3, 0);
+        testReloadInt(iv1, iv2, iv3, 100);
+        testReloadInt(iv1, iv2, iv3, 5000);
+    }
     {
         AttributePtr iv1 = createAttribute("suint4_1", Config(BasicType::UINT4, CollectionType::SINGLE));
         AttributePtr iv2 = createAttribute("suint4_2", Config(BasicType::UINT4, CollectionType::SINGLE));
@@ -1993,6 +2006,50 @@ AttributeTest::testCreateSerialNum()
     EXPECT_EQUAL(42u, attr2->getCreateSerialNum());
 }
 
+void
+AttributeTest::testDeltaSave()
+{
+    Config cfg(BasicType::INT32);
+    AttributePtr attr = createAttribute("delta", cfg);
+    IntegerAttribute &v = static_cast<IntegerAttribute &>(*attr);
+    addDocs(attr, 1000);
+    for (uint32_t lid = 0; lid < 1000; ++lid) {
+        v.update(lid, lid);
+    }
+    attr->commit(10, 10);
+    EXPECT_TRUE(attr->save());
+    EXPECT_TRUE(attr->initDeltaSave(9, 100).get() == nullptr);
+
+    v.update(5, 500);
+    v.clearDoc(7);
+    AttributeVector::DocId lid;
+    attr->addDoc(lid);
+    v.update(lid, 1000);
+    attr->addDoc(lid);
+    attr->commit(20, 20);
+    auto saver = attr->initDeltaSave(10, 100);
+    ASSERT_TRUE(saver.get() != nullptr);
+    TuneFileAttributes tune;
+    DummyFileHeaderContext fileHeaderContext;
+    AttributeFileSaveTarget saveTarget(tune, fileHeaderContext);
+    EXPECT_TRUE(saver->save(saveTarget));
+
+    AttributePtr attr2 = createAttribute("delta", cfg);
+    EXPECT_TRUE(attr2->load());
+    EXPECT_EQUAL(1000u, attr2->getNumDocs());
+    EXPECT_TRUE(attr2->loadDelta(baseFileName("delta.delta")));
+    attr2->commit();
+    EXPECT_EQUAL(1002u, attr2->getNumDocs());
+    EXPECT_EQUAL(1002u, attr2->getCommittedDocIdLimit());
+    compare<IntegerAttribute, IntegerAttribute::largeint_t>(v, static_cast<IntegerAttribute &>(*attr2));
+
+    for (lid = 0; lid < 200; ++lid) {
+        v.update(lid, lid + 1);
+    }
+    attr->commit(30, 30);
+    EXPECT_TRUE(attr->initDeltaSave(10, 100).get() == nullptr);
+}
+
 void
 AttributeTest::testPredicateHeaderTags()
 {
@@ -2331,6 +2388,55 @@ void testNamePrefix() {
 
 }
 
+void
+testBatchGetters(const Config &cfg)
+{
+    AttributeVector::SP v = createAttribute("batch", cfg);
+    EXPECT_TRUE(v->addDocs(20));
+    for (uint32_t doc = 0; doc < 20; ++doc) {
+        if (v->isStringType()) {
+            auto &sv = static_cast<StringAttribute &>(*v);
+            vespalib::string value("s");
+            value += static_cast<char>('0' + doc % 7);
+            EXPECT_TRUE(cfg.collectionType() == CollectionType::SINGLE ? sv.update(doc, value) : sv.append(doc, value, 1));
+        } else if (v->isFloatingPointType()) {
+            auto &fv = static_cast<FloatingPointAttribute &>(*v);
+            EXPECT_TRUE(cfg.collectionType() == CollectionType::SINGLE ? fv.update(doc, doc * 0.5) : fv.append(doc, doc * 0.5, 1));
+        } else {
+            auto &iv = static_cast<IntegerAttribute &>(*v);
+            EXPECT_TRUE(cfg.collectionType() == CollectionType::SINGLE ? iv.update(doc, doc % 7) : iv.append(doc, doc % 7, 1));
+        }
+    }
+    v->commit(true);
+    std::vector<AttributeVector::DocId> docIds = { 5, 3, 17, 3, 0, 19 };
+    std::vector<AttributeVector::largeint_t> ints(docIds.size());
+    std::vector<double> floats(docIds.size());
+    std::vector<AttributeVector::EnumHandle> enums(docIds.size());
+    const search::attribute::IAttributeVector &attr = *v;
+    attr.getIntBatch(&docIds[0], docIds.size(), &ints[0]);
+    attr.getFloatBatch(&docIds[0], docIds.size(), &floats[0]);
+    attr.getEnumBatch(&docIds[0], docIds.size(), &enums[0]);
+    for (size_t i = 0; i < docIds.size(); ++i) {
+        EXPECT_EQUAL(attr.getInt(docIds[i]), ints[i]);
+        EXPECT_EQUAL(attr.getFloat(docIds[i]), floats[i]);
+        EXPECT_EQUAL(attr.getEnum(docIds[i]), enums[i]);
+    }
+}
+
+void
+testBatchGetters()
+{
+    Config fastSearch(BasicType::INT32, CollectionType::SINGLE);
+    fastSearch.setFastSearch(true);
+    TEST_DO(testBatchGetters(Config(BasicType::INT32, CollectionType::SINGLE)));
+    TEST_DO(testBatchGetters(fastSearch));
+    TEST_DO(testBatchGetters(Config(BasicType::UINT4, CollectionType::SINGLE)));
+    TEST_DO(testBatchGetters(Config(BasicType::INT32, CollectionType::ARRAY)));
+    TEST_DO(testBatchGetters(Config(BasicType::DOUBLE, CollectionType::SINGLE)));
+    TEST_DO(testBatchGetters(Config(BasicType::DOUBLE, CollectionType::WSET)));
+    TEST_DO(testBatchGetters(Config(BasicType::STRING, CollectionType::SINGLE)));
+}
+
 void
 deleteDataDirs()
 {
@@ -2372,12 +2478,14 @@ int AttributeTest::Main()
     testNullProtection();
     testGeneration();
     testCreateSerialNum();
+    TEST_DO(testDeltaSave());
     testPredicateHeaderTags();
     TEST_DO(testCompactLidSpace());
     TEST_DO(requireThatAddressSpaceUsageIsReported());
     testReaderDuringLastUpdate();
     TEST_DO(testPendingCompaction());
     TEST_DO(testNamePrefix());
+    TEST_DO(testBatchGetters());
 
     deleteDataDirs();
     TEST_DONE();
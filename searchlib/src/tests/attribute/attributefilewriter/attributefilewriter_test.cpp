@@ -33,7 +33,7 @@ struct Fixture {
     const vespalib::string _desc;
     AttributeFileWriter _writer;
 
-    Fixture()
+    Fixture(bool directIO = false)
         : _tuneFileAttributes(),
           _fileHeaderContext(),
           _header(),
@@ -43,6 +43,9 @@ struct Fixture {
                   _header,
                   _desc)
     {
+        if (directIO) {
+            _tuneFileAttributes._write.setWantDirectIO();
+        }
         removeTestFile();
     }
 
@@ -93,6 +96,53 @@ TEST_F("Test that buffer writer passes on written data", Fixture)
 }
 
 
+std::vector<char>
+makeData(size_t size)
+{
+    std::vector<char> a;
+    a.reserve(size);
+    search::Rand48 rnd;
+    for (size_t i = 0; i < size; ++i) {
+        a.emplace_back(static_cast<char>(rnd.lrand48()));
+    }
+    return a;
+}
+
+
+TEST_F("Test that buffer writer passes on full buffers with direct io", Fixture(true))
+{
+    std::vector<char> a(makeData(2 * AttributeFileBufferWriter::BUFFER_SIZE));
+    EXPECT_TRUE(f._writer.open(testFileName));
+    std::unique_ptr<BufferWriter> writer(f._writer.allocBufferWriter());
+    writer->write(&a[0], a.size());
+    writer->flush();
+    writer.reset();
+    f._writer.close();
+    fileutil::LoadedBuffer::UP loaded(FileUtil::loadFile(testFileName));
+    EXPECT_EQUAL(a.size(), loaded->size());
+    EXPECT_TRUE(memcmp(&a[0], loaded->buffer(), loaded->size()) == 0);
+}
+
+
+TEST_F("Test that direct buffer is written after buffer writer data", Fixture)
+{
+    std::vector<char> a(makeData(AttributeFileBufferWriter::BUFFER_SIZE));
+    EXPECT_TRUE(f._writer.open(testFileName));
+    std::unique_ptr<BufferWriter> writer(f._writer.allocBufferWriter());
+    writer->write(&a[0], a.size());
+    writer->flush();
+    IAttributeFileWriter::Buffer buf = f._writer.allocBuf(hello.size());
+    buf->writeBytes(hello.c_str(), hello.size());
+    f._writer.writeBuf(std::move(buf));
+    writer.reset();
+    f._writer.close();
+    fileutil::LoadedBuffer::UP loaded(FileUtil::loadFile(testFileName));
+    EXPECT_EQUAL(a.size() + hello.size(), loaded->size());
+    EXPECT_TRUE(memcmp(&a[0], loaded->buffer(), a.size()) == 0);
+    EXPECT_TRUE(memcmp(hello.c_str(), static_cast<const char *>(loaded->buffer()) + a.size(), hello.size()) == 0);
+}
+
+
 TEST_F("Test that we can pass buffer directly", Fixture)
 {
     using Buffer = IAttributeFileWriter::Buffer;
@@ -290,6 +290,30 @@ AttributeManagerTest::testConfigConvert()
         a.fastaccess = true;
         EXPECT_TRUE(CC::convert(a).fastAccess());
     }
+    { // packed
+        CACA a;
+        EXPECT_TRUE(!CC::convert(a).packed());
+        a.packed = true;
+        EXPECT_TRUE(CC::convert(a).packed());
+    }
+    { // mmapload
+        CACA a;
+        EXPECT_TRUE(!CC::convert(a).mmapLoad());
+        a.mmapload = true;
+        EXPECT_TRUE(CC::convert(a).mmapLoad());
+    }
+    { // hashdictionary
+        CACA a;
+        EXPECT_TRUE(!CC::convert(a).hashDictionary());
+        a.hashdictionary = true;
+        EXPECT_TRUE(CC::convert(a).hashDictionary());
+    }
+    { // hugepages
+        CACA a;
+        EXPECT_TRUE(!CC::convert(a).hugePages());
+        a.hugepages = true;
+        EXPECT_TRUE(CC::convert(a).hugePages());
+    }
     { // tensor
         CACA a;
         a.datatype = CACA::TENSOR;
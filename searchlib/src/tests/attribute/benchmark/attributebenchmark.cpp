@@ -10,6 +10,8 @@
 #include <vespa/searchlib/attribute/multistringattribute.h>
 #include <vespa/searchlib/attribute/attrvector.h>
 #include <vespa/searchlib/attribute/attributevector.hpp>
+#include <vespa/vespalib/data/slime/slime.h>
+#include <vespa/vespalib/data/simple_buffer.h>
 #include <vespa/fastos/thread.h>
 #include <vespa/fastos/app.h>
 #include <iostream>
@@ -30,6 +32,7 @@ typedef AttributeVector::DocId DocId;
 typedef search::attribute::Config AttrConfig;
 using search::attribute::BasicType;
 using search::attribute::CollectionType;
+using vespalib::slime::Cursor;
 
 namespace search {
 
@@ -61,14 +64,18 @@ private:
         bool _rangeSearch;
         uint32_t _prefixLength;
         bool _prefixSearch;
+        bool _sampleMemory;
+        double _compactionRatio;
+        vespalib::string _jsonFile;
 
 
         Config() : _attribute(""), _numDocs(0), _numUpdates(0), _numValues(0),
         _numSearchers(0), _numQueries(0), _searchersOnly(true), _validate(false), _populateRuns(0), _updateRuns(0),
         _commitFreq(0), _minValueCount(0), _maxValueCount(0), _minStringLen(0), _maxStringLen(0), _seed(0),
         _writeAttribute(false), _rangeStart(0), _rangeEnd(0), _rangeDelta(0), _rangeSearch(false),
-        _prefixLength(0), _prefixSearch(false) {}
+        _prefixLength(0), _prefixSearch(false), _sampleMemory(false), _compactionRatio(0), _jsonFile("") {}
         void printXML() const;
+        void toSlime(Cursor & obj) const;
     };
 
     class Resource {
@@ -103,9 +110,16 @@ private:
     FastOS_ThreadPool * _threadPool;
     Config _config;
     RandomGenerator _rndGen;
+    vespalib::Slime _result;
+    Cursor * _phases;
 
     void init(const Config & config);
     void usage();
+    bool createAttribute(AttributePtr & ptr);
+    Cursor & addPhase(const vespalib::string & type, uint32_t id);
+    void addMemoryUsage(const AttributePtr & ptr, Cursor & phase);
+    void addMemorySamples(const std::vector<MemorySample> & samples, Cursor & phase);
+    bool writeJSON() const;
 
     // benchmark helper methods
     void addDocs(const AttributePtr & ptr, uint32_t numDocs);
@@ -128,12 +142,15 @@ private:
     // Numeric Attribute
     void benchmarkNumeric(const AttributePtr & ptr);
 
+    // Floating point Attribute
+    void benchmarkFloat(const AttributePtr & ptr);
+
     // String Attribute
     void benchmarkString(const AttributePtr & ptr);
 
 
 public:
-    AttributeBenchmark() : _threadPool(NULL), _config(), _rndGen() {}
+    AttributeBenchmark() : _threadPool(NULL), _config(), _rndGen(), _result(), _phases(NULL) {}
     ~AttributeBenchmark() {
         if (_threadPool != NULL) {
             delete _threadPool;
@@ -169,14 +186,145 @@ AttributeBenchmark::Config::printXML() const
     std::cout << "<range-search>" << (_rangeSearch ? "true" : "false") << "</range-search>" << std::endl;
     std::cout << "<prefix-length>" << _prefixLength << "</range-length>" << std::endl;
     std::cout << "<prefix-search>" << (_prefixSearch ? "true" : "false") << "</prefix-search>" << std::endl;
+    std::cout << "<sample-memory>" << (_sampleMemory ? "true" : "false") << "</sample-memory>" << std::endl;
+    std::cout << "<compaction-ratio>" << _compactionRatio << "</compaction-ratio>" << std::endl;
     std::cout << "</config>" << std::endl;
 }
 
+void
+AttributeBenchmark::Config::toSlime(Cursor & obj) const
+{
+    obj.setString("attribute", _attribute);
+    obj.setLong("num-docs", _numDocs);
+    obj.setLong("num-updates", _numUpdates);
+    obj.setLong("num-values", _numValues);
+    obj.setLong("num-searchers", _numSearchers);
+    obj.setLong("num-queries", _numQueries);
+    obj.setBool("searchers-only", _searchersOnly);
+    obj.setBool("validate", _validate);
+    obj.setLong("populate-runs", _populateRuns);
+    obj.setLong("update-runs", _updateRuns);
+    obj.setLong("commit-freq", _commitFreq);
+    obj.setLong("min-value-count", _minValueCount);
+    obj.setLong("max-value-count", _maxValueCount);
+    obj.setLong("min-string-len", _minStringLen);
+    obj.setLong("max-string-len", _maxStringLen);
+    obj.setLong("seed", _seed);
+    obj.setLong("range-start", _rangeStart);
+    obj.setLong("range-end", _rangeEnd);
+    obj.setLong("range-delta", _rangeDelta);
+    obj.setBool("range-search", _rangeSearch);
+    obj.setLong("prefix-length", _prefixLength);
+    obj.setBool("prefix-search", _prefixSearch);
+    obj.setBool("sample-memory", _sampleMemory);
+    obj.setDouble("compaction-ratio", _compactionRatio);
+}
+
 void
 AttributeBenchmark::init(const Config & config)
 {
     _config = config;
     _rndGen.srand(_config._seed);
+    Cursor & root = _result.setObject();
+    _config.toSlime(root.setObject("config"));
+    _phases = &root.setArray("phases");
+}
+
+/**
+ * Creates the attribute given by the name <collection>[-fs]-<type>,
+ * where collection is s (single), a (array) or ws (weighted set), fs
+ * enables fast search and type is int8, int16, int32, int64, float,
+ * double or string.
+ **/
+bool
+AttributeBenchmark::createAttribute(AttributePtr & ptr)
+{
+    const vespalib::string & name = _config._attribute;
+    size_t first = name.find('-');
+    size_t last = name.rfind('-');
+    if (first == vespalib::string::npos) {
+        return false;
+    }
+    vespalib::string collection = name.substr(0, first);
+    vespalib::string flags = (first < last) ? name.substr(first + 1, last - first - 1) : vespalib::string("");
+    vespalib::string type = name.substr(last + 1);
+    CollectionType::Type ct;
+    if (collection == "s") {
+        ct = CollectionType::SINGLE;
+    } else if (collection == "a") {
+        ct = CollectionType::ARRAY;
+    } else if (collection == "ws") {
+        ct = CollectionType::WSET;
+    } else {
+        return false;
+    }
+    static const BasicType::Type types[] = { BasicType::INT8, BasicType::INT16, BasicType::INT32, BasicType::INT64,
+                                             BasicType::FLOAT, BasicType::DOUBLE, BasicType::STRING };
+    BasicType::Type bt = BasicType::NONE;
+    for (BasicType::Type t : types) {
+        if (type == BasicType(t).asString()) {
+            bt = t;
+        }
+    }
+    if ((bt == BasicType::NONE) || (!flags.empty() && (flags != "fs"))) {
+        return false;
+    }
+    AttrConfig cfg(bt, ct);
+    cfg.setFastSearch(flags == "fs");
+    if (_config._compactionRatio > 0) {
+        cfg.setCompactionStrategy(CompactionStrategy(_config._compactionRatio, _config._compactionRatio));
+    }
+    ptr = AttributeFactory::createAttribute(name, cfg);
+    std::cout << "<!-- Benchmark " << ptr->getClass().name() << " -->" << std::endl;
+    return true;
+}
+
+Cursor &
+AttributeBenchmark::addPhase(const vespalib::string & type, uint32_t id)
+{
+    Cursor & phase = _phases->addObject();
+    phase.setString("type", type);
+    phase.setLong("id", id);
+    return phase;
+}
+
+void
+AttributeBenchmark::addMemoryUsage(const AttributePtr & ptr, Cursor & phase)
+{
+    ptr->commit(true);
+    const attribute::Status & status = ptr->getStatus();
+    std::cout << "<memory-usage allocated='" << status.getAllocated() << "' used='" << status.getUsed()
+        << "' dead='" << status.getDead() << "' onhold='" << status.getOnHold() << "'/>" << std::endl;
+    Cursor & obj = phase.setObject("memory-usage");
+    obj.setLong("allocated", status.getAllocated());
+    obj.setLong("used", status.getUsed());
+    obj.setLong("dead", status.getDead());
+    obj.setLong("onhold", status.getOnHold());
+}
+
+void
+AttributeBenchmark::addMemorySamples(const std::vector<MemorySample> & samples, Cursor & phase)
+{
+    if (samples.empty()) {
+        return;
+    }
+    Cursor & arr = phase.setArray("memory-samples");
+    std::cout << "<memory-samples>" << std::endl;
+    for (const MemorySample & sample : samples) {
+        sample.printXML();
+        sample.toSlime(arr.addObject());
+    }
+    std::cout << "</memory-samples>" << std::endl;
+}
+
+bool
+AttributeBenchmark::writeJSON() const
+{
+    vespalib::SimpleBuffer buf;
+    vespalib::slime::JsonFormat::encode(_result, buf, false);
+    std::ofstream out(_config._jsonFile.c_str());
+    out << buf.get().make_string() << std::endl;
+    return out.good();
 }
 
 
@@ -204,9 +352,14 @@ AttributeBenchmark::benchmarkPopulate(const AttributePtr & ptr, const std::vecto
     AttributeUpdater<Vector, T, BT>
         updater(ptr, values, _rndGen, _config._validate, _config._commitFreq,
                 _config._minValueCount, _config._maxValueCount);
+    updater.setSampleMemory(_config._sampleMemory);
     updater.populate();
+    Cursor & phase = addPhase("populate", id);
     std::cout << "<populate id='" << id << "'>" << std::endl;
     updater.getStatus().printXML();
+    updater.getStatus().toSlime(phase.setObject("updater"));
+    addMemorySamples(updater.getMemorySamples(), phase);
+    addMemoryUsage(ptr, phase);
     std::cout << "</populate>" << std::endl;
     if (_config._validate) {
         std::cout << "<!-- All " << updater.getValidator().getTotalCnt()
@@ -222,9 +375,14 @@ AttributeBenchmark::benchmarkUpdate(const AttributePtr & ptr, const std::vector<
     AttributeUpdater<Vector, T, BT>
         updater(ptr, values, _rndGen, _config._validate, _config._commitFreq,
                 _config._minValueCount, _config._maxValueCount);
+    updater.setSampleMemory(_config._sampleMemory);
     updater.update(_config._numUpdates);
+    Cursor & phase = addPhase("update", id);
     std::cout << "<update id='" << id << "'>" << std::endl;
     updater.getStatus().printXML();
+    updater.getStatus().toSlime(phase.setObject("updater"));
+    addMemorySamples(updater.getMemorySamples(), phase);
+    addMemoryUsage(ptr, phase);
     std::cout << "</update>" << std::endl;
     if (_config._validate) {
         std::cout << "<!-- All " << updater.getValidator().getTotalCnt()
@@ -290,6 +448,8 @@ AttributeBenchmark::benchmarkSearch(const AttributePtr & ptr, const std::vector<
         std::cout << "<total-searcher-summary>" << std::endl;
         totalStatus.printXML();
         std::cout << "</total-searcher-summary>" << std::endl;
+        Cursor & phase = addPhase("search", 0);
+        totalStatus.toSlime(phase.setObject("searchers"));
     }
 }
 
@@ -303,12 +463,17 @@ AttributeBenchmark::benchmarkSearchWithUpdater(const AttributePtr & ptr,
         AttributeUpdaterThread<Vector, T, BT>
             updater(ptr, values, _rndGen, _config._validate, _config._commitFreq,
                     _config._minValueCount, _config._maxValueCount);
+        updater.setSampleMemory(_config._sampleMemory);
         _threadPool->NewThread(&updater);
         benchmarkSearch(ptr, values);
         updater.stop();
         updater.join();
+        Cursor & phase = addPhase("updater-during-search", 0);
         std::cout << "<updater-summary>" << std::endl;
         updater.getStatus().printXML();
+        updater.getStatus().toSlime(phase.setObject("updater"));
+        addMemorySamples(updater.getMemorySamples(), phase);
+        addMemoryUsage(ptr, phase);
         std::cout << "</updater-summary>" << std::endl;
         if (_config._validate) {
             std::cout << "<!-- All " << updater.getValidator().getTotalCnt()
@@ -379,6 +544,41 @@ AttributeBenchmark::benchmarkNumeric(const AttributePtr & ptr)
 }
 
 
+//-----------------------------------------------------------------------------
+// Floating point Attribute
+//-----------------------------------------------------------------------------
+void
+AttributeBenchmark::benchmarkFloat(const AttributePtr & ptr)
+{
+    std::vector<int32_t> values;
+    if (_config._rangeSearch) {
+        values.reserve(_config._numValues);
+        for (uint32_t i = 0; i < _config._numValues; ++i) {
+            values.push_back(i);
+        }
+    } else {
+        _rndGen.fillRandomIntegers(values, _config._numValues);
+    }
+
+    std::vector<int32_t> weights;
+    _rndGen.fillRandomIntegers(weights, _config._numValues);
+
+    std::vector<AttributeVector::WeightedFloat> weightedVector;
+    weightedVector.reserve(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        // keep range search values integral, otherwise use a fraction that prints exactly
+        double value = _config._rangeSearch ? values[i] : (values[i] / 4.0);
+        if (!ptr->hasWeightedSetType()) {
+            weightedVector.push_back(AttributeVector::WeightedFloat(value));
+        } else {
+            weightedVector.push_back(AttributeVector::WeightedFloat(value, weights[i]));
+        }
+    }
+    benchmarkAttribute<FloatingPointAttribute, AttributeVector::WeightedFloat, AttributeVector::WeightedFloat>
+        (ptr, weightedVector);
+}
+
+
 //-----------------------------------------------------------------------------
 // String Attribute
 //-----------------------------------------------------------------------------
@@ -455,12 +655,14 @@ AttributeBenchmark::usage()
     std::cout << "                          [-S rangeStart] [-E rangeEnd] [-D rangeDelta] [-L prefixLength]" << std::endl;
     std::cout << "                          [-b (searchers with updater)] [-R (range search)] [-P (prefix search)]" << std::endl;
     std::cout << "                          [-t (validate updates)] [-w (write attribute to disk)]" << std::endl;
-    std::cout << "                          <attribute>" << std::endl;
-    std::cout << " <attribute> : s-uint32, a-uint32, ws-uint32" << std::endl;
-    std::cout << "               s-fa-uint32, a-fa-uint32, ws-fa-uint32" << std::endl;
-    std::cout << "               s-fs-uint32, a-fs-uint32, ws-fs-uint32 ws-frs-uint32" << std::endl;
-    std::cout << "               s-string, a-string, ws-string" << std::endl;
-    std::cout << "               s-fs-string, a-fs-string, ws-fs-string ws-frs-string" << std::endl;
+    std::cout << "                          [-M (sample memory usage at each commit)] [-C compactionRatio]" << std::endl;
+    std::cout << "                          [-J jsonFile] <attribute>" << std::endl;
+    std::cout << " <attribute> : <collection>[-fs]-<type>, e.g. s-int32, a-fs-string, ws-double" << std::endl;
+    std::cout << "               collection: s (single), a (array), ws (weighted set)" << std::endl;
+    std::cout << "               fs: fast search (posting lists)" << std::endl;
+    std::cout << "               type: int8, int16, int32, int64, float, double, string" << std::endl;
+    std::cout << " -C : max dead bytes ratio before compaction; memory usage is checked at each commit" << std::endl;
+    std::cout << " -J : also write the results as JSON to the given file" << std::endl;
 }
 
 int
@@ -489,12 +691,15 @@ AttributeBenchmark::Main()
     dc._rangeSearch = false;
     dc._prefixLength = 2;
     dc._prefixSearch = false;
+    dc._sampleMemory = false;
+    dc._compactionRatio = 0;
+    dc._jsonFile = "";
 
     int idx = 1;
     char opt;
     const char * arg;
     bool optError = false;
-    while ((opt = GetOpt("n:u:v:s:q:p:r:c:l:h:i:a:e:S:E:D:L:bRPtw", arg, idx)) != -1) {
+    while ((opt = GetOpt("n:u:v:s:q:p:r:c:l:h:i:a:e:S:E:D:L:C:J:bRPtwM", arg, idx)) != -1) {
         switch (opt) {
         case 'n':
             dc._numDocs = atoi(arg);
@@ -562,6 +767,16 @@ AttributeBenchmark::Main()
         case 'w':
             dc._writeAttribute = true;
             break;
+        case 'M':
+            dc._sampleMemory = true;
+            break;
+        case 'C':
+            dc._compactionRatio = strtod(arg, NULL);
+            dc._sampleMemory = true;
+            break;
+        case 'J':
+            dc._jsonFile = arg;
+            break;
         default:
             optError = true;
             break;
@@ -582,79 +797,18 @@ AttributeBenchmark::Main()
     _config.printXML();
 
     AttributePtr ptr;
-
-    if (_config._attribute == "s-int32") {
-        std::cout << "<!-- Benchmark SingleValueNumericAttribute<int32_t> -->" << std::endl;
-        ptr = AttributeFactory::createAttribute("s-int32", AttrConfig(BasicType::INT32, CollectionType::SINGLE));
-        benchmarkNumeric(ptr);
-
-    } else if (_config._attribute == "a-int32") {
-        std::cout << "<!-- Benchmark MultiValueNumericAttribute<int32_t> (array) -->" << std::endl;
-        ptr = AttributeFactory::createAttribute("a-int32", AttrConfig(BasicType::INT32, CollectionType::ARRAY));
-        benchmarkNumeric(ptr);
-
-    } else if (_config._attribute == "ws-int32") {
-        std::cout << "<!-- Benchmark MultiValueNumericAttribute<int32_t> (wset) -->" << std::endl;
-        ptr = AttributeFactory::createAttribute("ws-int32", AttrConfig(BasicType::INT32, CollectionType::WSET));
-        benchmarkNumeric(ptr);
-
-    } else if (_config._attribute == "s-fs-int32") {
-        std::cout << "<!-- Benchmark SingleValueNumericPostingAttribute<int32_t> -->" << std::endl;
-        AttrConfig cfg(BasicType::INT32, CollectionType::SINGLE);
-        cfg.setFastSearch(true);
-        ptr = AttributeFactory::createAttribute("s-fs-int32", cfg);
-        benchmarkNumeric(ptr);
-
-    } else if (_config._attribute == "a-fs-int32") {
-        std::cout << "<!-- Benchmark MultiValueNumericPostingAttribute<int32_t> (array) -->" << std::endl;
-        AttrConfig cfg(BasicType::INT32, CollectionType::ARRAY);
-        cfg.setFastSearch(true);
-        ptr = AttributeFactory::createAttribute("a-fs-int32", cfg);
-        benchmarkNumeric(ptr);
-
-    } else if (_config._attribute == "ws-fs-int32") {
-        std::cout << "<!-- Benchmark MultiValueNumericPostingAttribute<int32_t> (wset) -->" << std::endl;
-        AttrConfig cfg(BasicType::INT32, CollectionType::WSET);
-        cfg.setFastSearch(true);
-        ptr = AttributeFactory::createAttribute("ws-fs-int32", cfg);
-        benchmarkNumeric(ptr);
-
-    } else if (_config._attribute == "s-string") {
-        std::cout << "<!-- Benchmark SingleValueStringAttribute -->" << std::endl;
-        ptr = AttributeFactory::createAttribute("s-string", AttrConfig(BasicType::STRING, CollectionType::SINGLE));
-        benchmarkString(ptr);
-
-    } else if (_config._attribute == "a-string") {
-        std::cout << "<!-- Benchmark ArrayStringAttribute (array) -->" << std::endl;
-        ptr = AttributeFactory::createAttribute("a-string", AttrConfig(BasicType::STRING, CollectionType::ARRAY));
-        benchmarkString(ptr);
-
-    } else if (_config._attribute == "ws-string") {
-        std::cout << "<!-- Benchmark WeightedSetStringAttribute (wset) -->" << std::endl;
-        ptr = AttributeFactory::createAttribute("ws-string", AttrConfig(BasicType::STRING, CollectionType::WSET));
-        benchmarkString(ptr);
-
-    } else if (_config._attribute == "s-fs-string") {
-        std::cout << "<!-- Benchmark SingleValueStringPostingAttribute (single fast search) -->" << std::endl;
-        AttrConfig cfg(BasicType::STRING, CollectionType::SINGLE);
-        cfg.setFastSearch(true);
-        ptr = AttributeFactory::createAttribute("s-fs-string", cfg);
-        benchmarkString(ptr);
-
-    } else if (_config._attribute == "a-fs-string") {
-        std::cout << "<!-- Benchmark ArrayStringPostingAttribute (array fast search) -->" << std::endl;
-        AttrConfig cfg(BasicType::STRING, CollectionType::ARRAY);
-        cfg.setFastSearch(true);
-        ptr = AttributeFactory::createAttribute("a-fs-string", cfg);
-        benchmarkString(ptr);
-
-    } else if (_config._attribute == "ws-fs-string") {
-        std::cout << "<!-- Benchmark WeightedSetStringPostingAttribute (wset fast search) -->" << std::endl;
-        AttrConfig cfg(BasicType::STRING, CollectionType::WSET);
-        cfg.setFastSearch(true);
-        ptr = AttributeFactory::createAttribute("ws-fs-string", cfg);
+    if (!createAttribute(ptr)) {
+        std::cout << "<!-- Unknown attribute '" << _config._attribute << "' -->" << std::endl;
+        std::cout << "</attribute-benchmark>" << std::endl;
+        usage();
+        return -1;
+    }
+    if (ptr->isStringType()) {
         benchmarkString(ptr);
-
+    } else if (ptr->isFloatingPointType()) {
+        benchmarkFloat(ptr);
+    } else {
+        benchmarkNumeric(ptr);
     }
 
     if (dc._writeAttribute) {
@@ -664,6 +818,10 @@ AttributeBenchmark::Main()
 
     std::cout << "</attribute-benchmark>" << std::endl;
 
+    if (!_config._jsonFile.empty() && !writeJSON()) {
+        std::cerr << "Failed to write JSON to '" << _config._jsonFile << "'" << std::endl;
+        return -1;
+    }
     return 0;
 }
 }
@@ -9,6 +9,7 @@
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/util/compress.h>
 #include <vespa/searchlib/parsequery/parse.h>
+#include <vespa/vespalib/data/slime/cursor.h>
 
 namespace search {
 
@@ -45,6 +46,13 @@ public:
         std::cout << "<total-hit-count>" << _totalHitCount << "</total-hit-count>" << std::endl;
         std::cout << "<avg-hit-count>" << avgHitCount() << "</avg-hit-count>" << std::endl;
     }
+    void toSlime(vespalib::slime::Cursor & obj) const {
+        obj.setDouble("total-search-time", _totalSearchTime);
+        obj.setDouble("avg-search-time", avgSearchTime());
+        obj.setDouble("search-throughput", searchThroughout());
+        obj.setLong("total-hit-count", _totalHitCount);
+        obj.setDouble("avg-hit-count", avgHitCount());
+    }
     double avgSearchTime() const {
         return _totalSearchTime / _numQueries;
     }
@@ -6,6 +6,7 @@
 #include <vespa/searchlib/util/randomgenerator.h>
 #include <vespa/searchlib/util/runnable.h>
 #include <vespa/searchlib/attribute/attribute.h>
+#include <vespa/vespalib/data/slime/cursor.h>
 
 #define VALIDATOR_STR(str) #str
 #define VALIDATOR_ASSERT(rc) reportAssert(rc, __FILE__, __LINE__, VALIDATOR_STR(rc))
@@ -69,6 +70,15 @@ public:
         std::cout << "<value-update-throughput>" << valueUpdateThroughput() << "</value-update-throughput>" << std::endl;
         std::cout << "<avg-value-update-time>" << avgValueUpdateTime() << "</avg-value-update-time>" << std::endl;
     }
+    void toSlime(vespalib::slime::Cursor & obj) const {
+        obj.setDouble("total-update-time", _totalUpdateTime);
+        obj.setLong("documents-updated", _numDocumentUpdates);
+        obj.setDouble("document-update-throughput", documentUpdateThroughput());
+        obj.setDouble("avg-document-update-time", avgDocumentUpdateTime());
+        obj.setLong("values-updated", _numValueUpdates);
+        obj.setDouble("value-update-throughput", valueUpdateThroughput());
+        obj.setDouble("avg-value-update-time", avgValueUpdateTime());
+    }
     double documentUpdateThroughput() const {
         return _numDocumentUpdates * 1000 / _totalUpdateTime;
     }
@@ -83,6 +93,34 @@ public:
     }
 };
 
+class MemorySample
+{
+public:
+    double _time; // ms since the updater started
+    uint64_t _numDocumentUpdates;
+    uint64_t _allocated;
+    uint64_t _used;
+    uint64_t _dead;
+    uint64_t _onHold;
+
+    MemorySample(double time, uint64_t numDocumentUpdates, const attribute::Status & status) :
+        _time(time), _numDocumentUpdates(numDocumentUpdates), _allocated(status.getAllocated()),
+        _used(status.getUsed()), _dead(status.getDead()), _onHold(status.getOnHold()) {}
+    void printXML() const {
+        std::cout << "<memory-sample time='" << _time << "' documents-updated='" << _numDocumentUpdates
+            << "' allocated='" << _allocated << "' used='" << _used << "' dead='" << _dead
+            << "' onhold='" << _onHold << "'/>" << std::endl;
+    }
+    void toSlime(vespalib::slime::Cursor & obj) const {
+        obj.setDouble("time", _time);
+        obj.setLong("documents-updated", _numDocumentUpdates);
+        obj.setLong("allocated", _allocated);
+        obj.setLong("used", _used);
+        obj.setLong("dead", _dead);
+        obj.setLong("onhold", _onHold);
+    }
+};
+
 // AttributeVectorInstance, AttributeVectorType, AttributeVectorBufferType
 template <typename Vector, typename T, typename BT>
 class AttributeUpdater
@@ -101,9 +139,11 @@ protected:
     FastOS_Time _timer;
     AttributeUpdaterStatus _status;
     AttributeValidator _validator;
+    std::vector<MemorySample> _memorySamples;
 
     // config
     bool _validate;
+    bool _sampleMemory; // sample memory usage at each commit, forcing a stat update (and compaction check)
     uint32_t _commitFreq;
     uint32_t _minValueCount;
     uint32_t _maxValueCount;
@@ -134,6 +174,12 @@ public:
     const AttributeValidator & getValidator() const {
         return _validator;
     }
+    void setSampleMemory(bool sampleMemory) {
+        _sampleMemory = sampleMemory;
+    }
+    const std::vector<MemorySample> & getMemorySamples() const {
+        return _memorySamples;
+    }
     void populate();
     void update(uint32_t numUpdates);
 };
@@ -143,7 +189,8 @@ AttributeUpdater<Vector, T, BT>::AttributeUpdater(const AttributePtr & attrPtr,
                  RandomGenerator & rndGen, bool validate, uint32_t commitFreq,
                  uint32_t minValueCount, uint32_t maxValueCount)
     :_attrPtr(attrPtr), _attrVec(*(static_cast<Vector *>(attrPtr.get()))), _values(values), _buffer(),
-     _getBuffer(), _rndGen(rndGen), _expected(), _timer(), _status(), _validator(), _validate(validate),
+     _getBuffer(), _rndGen(rndGen), _expected(), _timer(), _status(), _validator(), _memorySamples(),
+     _validate(validate), _sampleMemory(false),
      _commitFreq(commitFreq), _minValueCount(minValueCount), _maxValueCount(maxValueCount)
 {}
 
@@ -233,7 +280,7 @@ AttributeUpdater<Vector, T, BT>::commit()
 {
     AttributeGuard guard(this->_attrPtr);
     if (_validate) {
-        _attrPtr->commit();
+        _attrPtr->commit(_sampleMemory);
         _getBuffer.resize(_maxValueCount);
         for (typename AttributeCommit::iterator iter = _expected.begin();
              iter != _expected.end(); ++iter)
@@ -259,7 +306,10 @@ AttributeUpdater<Vector, T, BT>::commit()
         }
         _expected.clear();
     } else {
-        _attrPtr->commit();
+        _attrPtr->commit(_sampleMemory);
+    }
+    if (_sampleMemory) {
+        _memorySamples.emplace_back(_timer.MilliSecsToNow(), _status._numDocumentUpdates, _attrPtr->getStatus());
     }
 }
 
@@ -62,6 +62,7 @@ private:
     void testHoldListAndGeneration();
     void testMemoryUsage();
     void requireThatAddressSpaceUsageIsReported();
+    void requireThatHashIndexIsMaintained();
     void testBufferLimit();
 
     // helper methods
@@ -865,6 +866,70 @@ EnumStoreTest::checkReaders(const StringEnumStore & ses,
 }
 
 
+void
+EnumStoreTest::requireThatHashIndexIsMaintained()
+{
+    typedef StringEnumStore::FoldedComparatorType FoldedComparator;
+    StringEnumStore ses(100, false);
+    ses.enableHashIndex();
+    EXPECT_TRUE(ses.getEnumStoreDict().hasHashIndex());
+    EnumIndex idx;
+    std::vector<std::string> uniques;
+    for (uint32_t i = 0; i < 100; ++i) {
+        uniques.push_back(vespalib::make_string("Enum%02u", i));
+    }
+    for (const auto &value : uniques) {
+        ses.addEnum(value.c_str(), idx);
+        ses.incRefCount(idx);
+        EnumIndex dupIdx;
+        ses.addEnum(value.c_str(), dupIdx);
+        EXPECT_TRUE(idx == dupIdx);
+    }
+    ses.freezeTree();
+    const EnumStoreDictBase &dict = ses.getEnumStoreDict();
+    btree::BTreeNode::Ref root = dict.getFrozenRootRef();
+    for (const auto &value : uniques) {
+        EXPECT_TRUE(ses.findIndex(value.c_str(), idx));
+        EXPECT_EQUAL(value, std::string(ses.getValue(idx)));
+        EXPECT_TRUE(!ses.findIndex((value + "x").c_str(), idx));
+        EXPECT_EQUAL(1u, dict.lookupFrozenTerm(root, FoldedComparator(ses, value.c_str())));
+    }
+    EXPECT_TRUE(!ses.findIndex("enum00", idx));
+    EXPECT_EQUAL(1u, dict.lookupFrozenTerm(root, FoldedComparator(ses, "ENUM00")));
+    EXPECT_EQUAL(0u, dict.lookupFrozenTerm(root, FoldedComparator(ses, "enum")));
+
+    // remove every other value
+    for (uint32_t i = 0; i < uniques.size(); i += 2) {
+        EXPECT_TRUE(ses.findIndex(uniques[i].c_str(), idx));
+        ses.decRefCount(idx);
+    }
+    ses.freeUnusedEnums(false);
+    for (uint32_t i = 0; i < uniques.size(); ++i) {
+        EXPECT_EQUAL((i % 2) != 0, ses.findIndex(uniques[i].c_str(), idx));
+    }
+
+    // compaction moves all entries
+    EXPECT_TRUE(ses.performCompaction(1000));
+    for (uint32_t i = 0; i < uniques.size(); ++i) {
+        bool found = ses.findIndex(uniques[i].c_str(), idx);
+        EXPECT_EQUAL((i % 2) != 0, found);
+        if (found) {
+            EXPECT_EQUAL(1u, idx.bufferId());
+            EXPECT_EQUAL(uniques[i], std::string(ses.getValue(idx)));
+        }
+    }
+    EXPECT_EQUAL(50u, ses.getNumUniques());
+
+    DoubleEnumStore des(100, false);
+    des.enableHashIndex();
+    des.addEnum(std::numeric_limits<double>::quiet_NaN(), idx);
+    des.addEnum(-0.0, idx);
+    EXPECT_TRUE(des.findIndex(std::numeric_limits<double>::quiet_NaN(), idx));
+    EXPECT_TRUE(des.findIndex(0.0, idx));
+    EXPECT_TRUE(!des.findIndex(1.0, idx));
+}
+
+
 int
 EnumStoreTest::Main()
 {
@@ -880,6 +945,7 @@ EnumStoreTest::Main()
     testHoldListAndGeneration();
     testMemoryUsage();
     TEST_DO(requireThatAddressSpaceUsageIsReported());
+    TEST_DO(requireThatHashIndexIsMaintained());
     if (_argc > 1) {
         testBufferLimit(); // large test with 8 GB buffer
     }
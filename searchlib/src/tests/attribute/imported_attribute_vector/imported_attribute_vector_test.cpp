@@ -115,6 +115,25 @@ TEST_F("Single-valued integer attribute values can be retrieved via reference",
     EXPECT_EQUAL(5678, f.get_imported_attr()->getInt(DocId(3)));
 }
 
+TEST_F("Single-valued attribute values can be retrieved in batches via reference", Fixture)
+{
+    reset_with_single_value_reference_mappings<IntegerAttribute, int32_t>(
+            f, BasicType::INT32,
+            {{DocId(1), dummy_gid(3), DocId(3), 1234},
+             {DocId(3), dummy_gid(7), DocId(7), 5678}});
+
+    const DocId docIds[] = {3, 1, 4};
+    IAttributeVector::largeint_t ints[3];
+    f.get_imported_attr()->getIntBatch(docIds, 3, ints);
+    EXPECT_EQUAL(5678, ints[0]);
+    EXPECT_EQUAL(1234, ints[1]);
+    EXPECT_EQUAL(f.target_attr->getInt(DocId(0)), ints[2]);
+    double floats[3];
+    f.get_imported_attr()->getFloatBatch(docIds, 3, floats);
+    EXPECT_EQUAL(5678.0, floats[0]);
+    EXPECT_EQUAL(1234.0, floats[1]);
+}
+
 TEST_F("getValueCount() is 1 for mapped single value attribute", Fixture)
 {
     reset_with_single_value_reference_mappings<IntegerAttribute, int32_t>(
@@ -5,6 +5,7 @@
 #include <vespa/searchlib/attribute/multi_value_mapping.hpp>
 #include <vespa/searchlib/attribute/not_implemented_attribute.h>
 #include <vespa/searchlib/util/rand48.h>
+#include <vespa/searchcommon/common/compaction_strategy.h>
 #include <vespa/vespalib/util/generationhandler.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/stllike/hash_set.h>
@@ -137,6 +138,16 @@ public:
         _attr.commit();
         _attr.incGeneration();
     }
+
+    bool considerCompact(const search::CompactionStrategy &compactionStrategy) {
+        _mvMapping.updateStat();
+        bool result = _mvMapping.considerCompact(compactionStrategy);
+        _attr.commit();
+        _attr.incGeneration();
+        return result;
+    }
+    bool compactInProgress() const { return _mvMapping.compactInProgress(); }
+    uint32_t getCompactCursor() const { return _mvMapping.getCompactCursor(); }
 };
 
 class IntFixture : public Fixture<int>
@@ -183,6 +194,12 @@ public:
         _attr.incGeneration();
     }
 
+    void setRandomDoc(uint32_t docId) {
+        std::vector<int> values = makeValues();
+        _refMapping[docId] = values;
+        set(docId, values);
+    }
+
     void addRandomDocs(uint32_t count) {
         for (uint32_t i = 0; i < count; ++i) {
             addRandomDoc();
@@ -329,4 +346,34 @@ TEST_F("Test that compaction works", IntFixture(3, 64, 512, 129))
     EXPECT_LESS(bufferCountAfter, bufferCountBefore);
 }
 
+TEST_F("Test that compaction can be spread over several steps", IntFixture(3, 64, 512, 129))
+{
+    f.addRandomDocs(50000);
+    uint32_t docIdLimit = f.size();
+    for (uint32_t docId = 0; docId < docIdLimit; docId += 4) {
+        for (uint32_t i = docId; i < docId + 3 && i < docIdLimit; ++i) {
+            f.clearDoc(i);
+        }
+    }
+    uint32_t bufferCountBefore = f.countBuffers();
+    search::CompactionStrategy compactionStrategy(0.2, 1.0, 1000);
+    EXPECT_TRUE(f.considerCompact(compactionStrategy));
+    EXPECT_TRUE(f.compactInProgress());
+    EXPECT_EQUAL(1000u, f.getCompactCursor());
+    uint32_t steps = 1;
+    while (f.compactInProgress()) {
+        // Updates ahead of and behind the cursor must not be lost
+        f.setRandomDoc(docIdLimit - 1 - steps);
+        f.setRandomDoc(steps);
+        TEST_DO(f.checkRefMapping());
+        EXPECT_TRUE(f.considerCompact(compactionStrategy));
+        ++steps;
+    }
+    EXPECT_EQUAL((docIdLimit + 999) / 1000, steps);
+    EXPECT_EQUAL(0u, f.getCompactCursor());
+    TEST_DO(f.checkRefMapping());
+    LOG(info, "Compacted %u docs in %u steps, buffers %u -> %u",
+        docIdLimit, steps, bufferCountBefore, f.countBuffers());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
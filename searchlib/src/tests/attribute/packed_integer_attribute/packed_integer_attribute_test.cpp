@@ -0,0 +1,218 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/document/update/arithmeticvalueupdate.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributevector.hpp>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/singlepackedintegerattribute.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/query/queryterm.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/searchcommon/attribute/search_context_params.h>
+#include <random>
+
+#include <vespa/log/log.h>
+LOG_SETUP("packed_integer_attribute_test");
+
+using search::AttributeFactory;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::QueryTermSimple;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+using search::attribute::SearchContextParams;
+using search::fef::TermFieldMatchData;
+
+using AttributePtr = AttributeVector::SP;
+
+namespace {
+
+AttributePtr make_attribute(const vespalib::string &name, BasicType type, bool packed) {
+    Config cfg(type, CollectionType::SINGLE);
+    cfg.setPacked(packed);
+    AttributePtr attr = AttributeFactory::createAttribute(name, cfg);
+    return attr;
+}
+
+void add_docs(AttributeVector &attr, uint32_t numDocs) {
+    uint32_t startDoc;
+    uint32_t lastDoc;
+    attr.addDocs(startDoc, lastDoc, numDocs);
+    attr.commit();
+}
+
+std::vector<uint32_t> search(const AttributeVector &attr, const vespalib::string &term, bool strict) {
+    TermFieldMatchData md;
+    auto sc = attr.getSearch(std::make_unique<QueryTermSimple>(term, QueryTermSimple::WORD), SearchContextParams());
+    sc->fetchPostings(strict);
+    auto it = sc->createIterator(&md, strict);
+    it->initRange(1, attr.getCommittedDocIdLimit());
+    std::vector<uint32_t> hits;
+    for (uint32_t docId = 1; docId < attr.getCommittedDocIdLimit(); ++docId) {
+        if (strict) {
+            it->seek(docId);
+            if (it->isAtEnd()) {
+                break;
+            }
+            docId = it->getDocId();
+            hits.push_back(docId);
+        } else if (it->seek(docId)) {
+            hits.push_back(docId);
+        }
+    }
+    return hits;
+}
+
+void assert_same_values(const AttributeVector &expect, const AttributeVector &actual) {
+    ASSERT_EQUAL(expect.getNumDocs(), actual.getNumDocs());
+    for (uint32_t docId = 0; docId < expect.getNumDocs(); ++docId) {
+        EXPECT_EQUAL(expect.getInt(docId), actual.getInt(docId));
+    }
+}
+
+struct Fixture {
+    AttributePtr plain;
+    AttributePtr packed;
+    IntegerAttribute &plainInt;
+    IntegerAttribute &packedInt;
+    Fixture(BasicType type, uint32_t numDocs)
+        : plain(make_attribute("plain", type, false)),
+          packed(make_attribute("packed", type, true)),
+          plainInt(dynamic_cast<IntegerAttribute &>(*plain)),
+          packedInt(dynamic_cast<IntegerAttribute &>(*packed))
+    {
+        add_docs(*plain, numDocs);
+        add_docs(*packed, numDocs);
+    }
+    void update(uint32_t docId, int64_t value) {
+        plainInt.update(docId, value);
+        packedInt.update(docId, value);
+    }
+    void commit() {
+        plain->commit();
+        packed->commit();
+    }
+};
+
+}
+
+TEST("require that packed config creates packed attribute") {
+    AttributePtr attr = make_attribute("a", BasicType::INT32, true);
+    EXPECT_TRUE(dynamic_cast<search::SingleValuePackedIntegerAttribute<search::IntegerAttributeTemplate<int32_t>> *>(attr.get()) != nullptr);
+    attr = make_attribute("a", BasicType::INT32, false);
+    EXPECT_TRUE(dynamic_cast<search::SingleValuePackedIntegerAttribute<search::IntegerAttributeTemplate<int32_t>> *>(attr.get()) == nullptr);
+}
+
+TEST("require that new documents are undefined") {
+    Fixture f(BasicType::INT64, 200);
+    TEST_DO(assert_same_values(*f.plain, *f.packed));
+}
+
+TEST("require that values of growing range are stored") {
+    for (BasicType type : { BasicType::INT8, BasicType::INT16, BasicType::INT32, BasicType::INT64 }) {
+        Fixture f(type, 300);
+        int64_t maxValue = (int64_t(1) << (8 * BasicType(type).fixedSize() - 1)) - 1;
+        for (uint32_t docId = 1; docId < 300; ++docId) {
+            // spans all bit widths within a block as docId increases
+            f.update(docId, (docId & 1) ? (maxValue >> (63 - (docId % 64))) : -int64_t(docId % 100));
+        }
+        f.commit();
+        TEST_DO(assert_same_values(*f.plain, *f.packed));
+        f.update(5, 7);
+        f.update(6, maxValue);
+        f.update(7, -maxValue);
+        f.commit();
+        TEST_DO(assert_same_values(*f.plain, *f.packed));
+    }
+}
+
+TEST("require that updates, arithmetic and clear match the plain attribute") {
+    Fixture f(BasicType::INT32, 1000);
+    std::mt19937 rnd(42);
+    for (uint32_t round = 0; round < 20; ++round) {
+        for (uint32_t i = 0; i < 200; ++i) {
+            uint32_t docId = 1 + (rnd() % 999);
+            switch (rnd() % 5) {
+            case 0:
+                f.update(docId, int32_t(rnd()));
+                break;
+            case 1:
+                f.update(docId, rnd() % 16);
+                break;
+            case 2:
+                f.plainInt.apply(docId, document::ArithmeticValueUpdate(document::ArithmeticValueUpdate::Add, 3));
+                f.packedInt.apply(docId, document::ArithmeticValueUpdate(document::ArithmeticValueUpdate::Add, 3));
+                break;
+            case 3:
+                f.plain->clearDoc(docId);
+                f.packed->clearDoc(docId);
+                break;
+            default:
+                f.update(docId, 1000 + (rnd() % 100));
+                break;
+            }
+        }
+        f.commit();
+        TEST_DO(assert_same_values(*f.plain, *f.packed));
+    }
+}
+
+TEST("require that range search gives the same hits as the plain attribute") {
+    Fixture f(BasicType::INT64, 1000);
+    std::mt19937 rnd(7);
+    for (uint32_t docId = 1; docId < 1000; ++docId) {
+        if (docId < 200) {
+            f.update(docId, 50);
+        } else if (docId < 400) {
+            f.update(docId, rnd() % 100);
+        } else if (docId < 600) {
+            f.update(docId, int64_t(rnd()) << 20);
+        } else if ((docId % 3) != 0) {
+            f.update(docId, 10 + (rnd() % 5));
+        }
+    }
+    f.commit();
+    for (const char *term : { "50", "[10;20]", "[40;60]", "<12", ">90", "[-1000;1000000000]", "[100000;200000]", "99999" }) {
+        TEST_STATE(term);
+        for (bool strict : { true, false }) {
+            EXPECT_TRUE(search(*f.plain, term, strict) == search(*f.packed, term, strict));
+        }
+    }
+}
+
+TEST("require that packed values and memory usage are kept across save and load") {
+    Fixture f(BasicType::INT64, 1000);
+    for (uint32_t docId = 1; docId < 1000; ++docId) {
+        f.update(docId, 1500000000 + (docId % 7));
+    }
+    f.plain->commit(true);
+    f.packed->commit(true);
+    EXPECT_LESS(f.packed->getStatus().getUsed() * 4, f.plain->getStatus().getUsed());
+    EXPECT_TRUE(f.packed->saveAs("packed_saved"));
+    AttributePtr loaded = make_attribute("packed_saved", BasicType::INT64, true);
+    EXPECT_TRUE(loaded->load());
+    TEST_DO(assert_same_values(*f.plain, *loaded));
+    AttributePtr unpacked = make_attribute("packed_saved", BasicType::INT64, false);
+    EXPECT_TRUE(unpacked->load());
+    TEST_DO(assert_same_values(*f.plain, *unpacked));
+}
+
+TEST("require that lid space can be shrunk and grown again") {
+    Fixture f(BasicType::INT32, 200);
+    for (uint32_t docId = 1; docId < 200; ++docId) {
+        f.update(docId, docId);
+    }
+    f.commit();
+    for (AttributeVector *attr : { f.plain.get(), f.packed.get() }) {
+        attr->compactLidSpace(100);
+        attr->commit();
+        attr->shrinkLidSpace();
+    }
+    EXPECT_EQUAL(100u, f.packed->getNumDocs());
+    add_docs(*f.plain, 50);
+    add_docs(*f.packed, 50);
+    TEST_DO(assert_same_values(*f.plain, *f.packed));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -49,6 +49,9 @@ private:
     template <typename SelectorType>
     void requireThatSourcesAreCountedCorrectly();
     void requireThatSourcesAreCountedCorrectly();
+    template <typename SelectorType>
+    void requireThatRunsOfSingleSourceAreTracked();
+    void requireThatRunsOfSingleSourceAreTracked();
 };
 
 int
@@ -64,6 +67,7 @@ Test::Main()
     TEST_DO(requireThatSelectorCanSaveAndLoad());
     TEST_DO(requireThatCompleteSourceRangeIsHandled());
     TEST_DO(requireThatSourcesAreCountedCorrectly());
+    TEST_DO(requireThatRunsOfSingleSourceAreTracked());
 
     TEST_DONE();
 }
@@ -211,6 +215,42 @@ Test::requireThatSourcesAreCountedCorrectly()
     requireThatSourcesAreCountedCorrectly<FixedSourceSelector>();
 }
 
+template <typename SelectorType>
+void
+Test::requireThatRunsOfSingleSourceAreTracked()
+{
+    SelectorType selector(default_source, base_file_name, 1024);
+    for (uint32_t i = 256; i < 768; ++i) {
+        selector.setSource(i, 3);
+    }
+    selector.setSource(300, 4);
+    {
+        auto it = selector.createIterator();
+        EXPECT_EQUAL(256u, it->getRunEnd(0, default_source));
+        EXPECT_EQUAL(256u, it->getRunEnd(255, default_source));
+        EXPECT_EQUAL(257u, it->getRunEnd(256, 3));
+        EXPECT_EQUAL(301u, it->getRunEnd(300, 4));
+        EXPECT_EQUAL(768u, it->getRunEnd(600, 3));
+        EXPECT_EQUAL(1280u, it->getRunEnd(768, default_source));
+    }
+    selector.setSource(300, 3);
+    {
+        auto it = selector.createIterator();
+        EXPECT_EQUAL(768u, it->getRunEnd(256, 3));
+    }
+    const uint32_t diff = 2;
+    typename SelectorType::UP new_selector(selector.cloneAndSubtract(base_file_name2, diff));
+    auto it = new_selector->createIterator();
+    EXPECT_EQUAL(256u, it->getRunEnd(0, default_source - diff));
+    EXPECT_EQUAL(768u, it->getRunEnd(256, 1));
+}
+
+void
+Test::requireThatRunsOfSingleSourceAreTracked()
+{
+    requireThatRunsOfSingleSourceAreTracked<FixedSourceSelector>();
+}
+
 }  // namespace
 
 TEST_APPHOOK(Test);
@@ -494,6 +494,9 @@ public:
 
     void
     testRandNums();
+
+    void
+    testBatchDecode();
 };
 
 
@@ -606,10 +609,53 @@ TestFixture<bigEndian>::testRandNums()
 }
 
 
+template <bool bigEndian>
+void
+TestFixture<bigEndian>::testBatchDecode()
+{
+    constexpr uint32_t kValue = 3;
+    constexpr uint32_t width = 13;
+    std::vector<uint64_t> nums;
+    for (auto num : _randNums) {
+        nums.push_back(num & ((UINT64_C(1) << 20) - 1));
+    }
+    EC e;
+    search::ComprFileWriteContext wc(e);
+    wc.allocComprBuf(32768, 32768);
+    e.setupWrite(wc);
+    for (auto num : nums) {
+        e.encodeExpGolomb(num, kValue);
+        if (e._valI >= e._valE)
+            wc.writeComprBuffer(false);
+    }
+    for (auto num : nums) {
+        e.writeBits(num & ((UINT64_C(1) << width) - 1), width);
+        if (e._valI >= e._valE)
+            wc.writeComprBuffer(false);
+    }
+    e.flush();
+
+    DC dc(static_cast<const uint64_t *>(wc._comprBuf), 0);
+    std::vector<uint64_t> decoded(nums.size());
+    uint32_t done = 0;
+    for (uint32_t batch = 1; done < nums.size(); ++batch) {
+        batch = std::min(batch, static_cast<uint32_t>(nums.size() - done));
+        dc.decodeExpGolombSmallBatch(kValue, batch, &decoded[done]);
+        done += batch;
+    }
+    EXPECT_TRUE(nums == decoded);
+    dc.readBitsBatch(width, nums.size(), &decoded[0]);
+    for (uint32_t i = 0; i < nums.size(); ++i) {
+        EXPECT_EQUAL(nums[i] & ((UINT64_C(1) << width) - 1), decoded[i]);
+    }
+}
+
+
 TEST_F("Test bigendian expgolomb encoding/decoding", TestFixture<true>)
 {
     f.testRandNums();
     f.testBoundaries();
+    f.testBatchDecode();
 }
 
 
@@ -617,6 +663,7 @@ TEST_F("Test little expgolomb encoding/decoding", TestFixture<false>)
 {
     f.testRandNums();
     f.testBoundaries();
+    f.testBatchDecode();
 }
 
 
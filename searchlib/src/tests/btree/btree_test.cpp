@@ -190,6 +190,7 @@ private:
     void requireThatCornerCaseTreeFindWorks();
     void requireThatBasicTreeIteratorWorks();
     void requireThatTreeIteratorSeekWorks();
+    void requireThatTreeIteratorSeekBatchWorks();
     void requireThatTreeIteratorAssignWorks();
     void requireThatMemoryUsageIsCalculated();
     template <typename TreeType>
@@ -1002,6 +1003,40 @@ Test::requireThatTreeIteratorSeekWorks()
     }
 }
 
+void
+Test::requireThatTreeIteratorSeekBatchWorks()
+{
+    GenerationHandler g;
+    MyTree tree;
+    for (int i = 0; i < 40; i += 2) {
+        tree.insert(i, toStr(i));
+    }
+    {
+        MyTree::Iterator itr = tree.begin();
+        std::vector<MyKey> keys = { 1, 4, 5, 12, 20, 21, 36, 45, 50 };
+        std::vector<MyKey> found(keys.size());
+        uint32_t numFound = itr.seekBatch(&keys[0], keys.size(), &found[0]);
+        EXPECT_EQUAL(4u, numFound);
+        EXPECT_EQUAL(4, UNWRAP(found[0]));
+        EXPECT_EQUAL(12, UNWRAP(found[1]));
+        EXPECT_EQUAL(20, UNWRAP(found[2]));
+        EXPECT_EQUAL(36, UNWRAP(found[3]));
+        EXPECT_TRUE(!itr.valid());
+    }
+    {
+        MyTree::Iterator itr = tree.begin();
+        std::vector<MyKey> keys = { 0, 6, 8, 9 };
+        std::vector<MyKey> found(keys.size());
+        uint32_t numFound = itr.seekBatch(&keys[0], keys.size(), &found[0]);
+        EXPECT_EQUAL(3u, numFound);
+        EXPECT_EQUAL(0, UNWRAP(found[0]));
+        EXPECT_EQUAL(6, UNWRAP(found[1]));
+        EXPECT_EQUAL(8, UNWRAP(found[2]));
+        EXPECT_TRUE(itr.valid());
+        EXPECT_EQUAL(10, UNWRAP(itr.getKey()));
+    }
+}
+
 void
 Test::requireThatTreeIteratorAssignWorks()
 {
@@ -1508,6 +1543,7 @@ Test::Main()
     requireThatCornerCaseTreeFindWorks();
     requireThatBasicTreeIteratorWorks();
     requireThatTreeIteratorSeekWorks();
+    requireThatTreeIteratorSeekBatchWorks();
     requireThatTreeIteratorAssignWorks();
     requireThatMemoryUsageIsCalculated();
     requireThatLowerBoundWorks();
@@ -28,7 +28,9 @@ enum class IterateMethod
 {
     FORWARD,
     BACKWARDS,
-    LAMBDA
+    LAMBDA,
+    SEEK,
+    SEEK_BATCH
 };
 
 class IterateSpeed : public FastOS_Application
@@ -36,7 +38,7 @@ class IterateSpeed : public FastOS_Application
     template <typename Traits, IterateMethod iterateMethod>
     void
     workLoop(int loops, bool enableForward, bool enableBackwards,
-             bool enableLambda, int leafSlots);
+             bool enableLambda, bool enableSeek, int leafSlots);
     void usage();
     int Main() override;
 };
@@ -51,6 +53,10 @@ const char *iterateMethodName(IterateMethod iterateMethod)
         return "forward";
     case IterateMethod::BACKWARDS:
         return "backwards";
+    case IterateMethod::SEEK:
+        return "seek";
+    case IterateMethod::SEEK_BATCH:
+        return "seekbatch";
     default:
         return "lambda";
     }
@@ -61,11 +67,13 @@ const char *iterateMethodName(IterateMethod iterateMethod)
 template <typename Traits, IterateMethod iterateMethod>
 void
 IterateSpeed::workLoop(int loops, bool enableForward, bool enableBackwards,
-                       bool enableLambda, int leafSlots)
+                       bool enableLambda, bool enableSeek, int leafSlots)
 {
     if ((iterateMethod == IterateMethod::FORWARD && !enableForward) ||
         (iterateMethod == IterateMethod::BACKWARDS && !enableBackwards) ||
         (iterateMethod == IterateMethod::LAMBDA && !enableLambda) ||
+        ((iterateMethod == IterateMethod::SEEK ||
+          iterateMethod == IterateMethod::SEEK_BATCH) && !enableSeek) ||
         (leafSlots != 0 &&
          leafSlots != static_cast<int>(Traits::LEAF_SLOTS)))
         return;
@@ -83,6 +91,13 @@ IterateSpeed::workLoop(int loops, bool enableForward, bool enableBackwards,
     tree.assign(builder);
     assert(numEntries == tree.size());
     assert(tree.isValid());
+    // Every third key, as seen by the strict side of a skewed AND
+    const int seekStride = 3;
+    std::vector<int> seekKeys;
+    for (size_t i = 1; i < numEntries; i += seekStride) {
+        seekKeys.push_back(i);
+    }
+    std::vector<int> found(seekKeys.size());
     for (int l = 0; l < loops; ++l) {
         fastos::TimeStamp before = fastos::ClockSystem::now();
         uint64_t sum = 0;
@@ -102,6 +117,20 @@ IterateSpeed::workLoop(int loops, bool enableForward, bool enableBackwards,
                     sum += itr.getKey();
                     --itr;
                 }
+            } else if (iterateMethod == IterateMethod::SEEK) {
+                ConstIterator itr(BTreeNode::Ref(), tree.getAllocator());
+                itr.begin(tree.getRoot());
+                while (itr.valid()) {
+                    sum += itr.getKey();
+                    itr.seek(itr.getKey() + seekStride);
+                }
+            } else if (iterateMethod == IterateMethod::SEEK_BATCH) {
+                ConstIterator itr(BTreeNode::Ref(), tree.getAllocator());
+                itr.begin(tree.getRoot());
+                uint32_t numFound = itr.seekBatch(&seekKeys[0], seekKeys.size(), &found[0]);
+                for (uint32_t i = 0; i < numFound; ++i) {
+                    sum += found[i];
+                }
             } else {
                 tree.getAllocator().foreach_key(tree.getRoot(),
                                                 [&](int key) { sum += key; } );
@@ -130,7 +159,8 @@ IterateSpeed::usage()
            "[-b] "
            "[-c <numLoops>] "
            "[-f] "
-           "[-l]\n");
+           "[-l] "
+           "[-s]\n");
 }
 
 int
@@ -144,8 +174,9 @@ IterateSpeed::Main()
     bool backwards = false;
     bool forwards = false;
     bool lambda = false;
+    bool seek = false;
     int leafSlots = 0;
-    while ((c = GetOpt("F:bc:fl", optArg, argi)) != -1) {
+    while ((c = GetOpt("F:bc:fls", optArg, argi)) != -1) {
         switch (c) {
         case 'F':
             leafSlots = atoi(optArg);
@@ -162,15 +193,19 @@ IterateSpeed::Main()
         case 'l':
             lambda = true;
             break;
+        case 's':
+            seek = true;
+            break;
         default:
             usage();
             return 1;
         }
     }
-    if (!backwards && !forwards && !lambda) {
+    if (!backwards && !forwards && !lambda && !seek) {
         backwards = true;
         forwards = true;
         lambda = true;
+        seek = true;
     }
 
     using SmallTraits = BTreeTraits<4, 4, 31, false>;
@@ -178,29 +213,45 @@ IterateSpeed::Main()
     using LargeTraits = BTreeTraits<32, 16, 10, true>;
     using HugeTraits = BTreeTraits<64, 16, 10, true>;
     workLoop<SmallTraits, IterateMethod::FORWARD>(loops, forwards, backwards,
-                                                  lambda, leafSlots);
+                                                  lambda, seek, leafSlots);
     workLoop<DefTraits, IterateMethod::FORWARD>(loops, forwards, backwards,
-                                                lambda, leafSlots);
+                                                lambda, seek, leafSlots);
     workLoop<LargeTraits, IterateMethod::FORWARD>(loops, forwards, backwards,
-                                                  lambda, leafSlots);
+                                                  lambda, seek, leafSlots);
     workLoop<HugeTraits, IterateMethod::FORWARD>(loops, forwards, backwards,
-                                                 lambda, leafSlots);
+                                                 lambda, seek, leafSlots);
     workLoop<SmallTraits, IterateMethod::BACKWARDS>(loops, forwards, backwards,
-                                                    lambda, leafSlots);
+                                                    lambda, seek, leafSlots);
     workLoop<DefTraits, IterateMethod::BACKWARDS>(loops, forwards, backwards,
-                                                  lambda, leafSlots);
+                                                  lambda, seek, leafSlots);
     workLoop<LargeTraits, IterateMethod::BACKWARDS>(loops, forwards, backwards,
-                                                    lambda, leafSlots);
+                                                    lambda, seek, leafSlots);
     workLoop<HugeTraits, IterateMethod::BACKWARDS>(loops, forwards, backwards,
-                                                   lambda, leafSlots);
+                                                   lambda, seek, leafSlots);
     workLoop<SmallTraits, IterateMethod::LAMBDA>(loops, forwards, backwards,
-                                                 lambda, leafSlots);
+                                                 lambda, seek, leafSlots);
     workLoop<DefTraits, IterateMethod::LAMBDA>(loops, forwards, backwards,
-                                               lambda, leafSlots);
+                                               lambda, seek, leafSlots);
     workLoop<LargeTraits, IterateMethod::LAMBDA>(loops, forwards, backwards,
-                                                 lambda, leafSlots);
+                                                 lambda, seek, leafSlots);
     workLoop<HugeTraits, IterateMethod::LAMBDA>(loops, forwards, backwards,
-                                                lambda, leafSlots);
+                                                lambda, seek, leafSlots);
+    workLoop<SmallTraits, IterateMethod::SEEK>(loops, forwards, backwards,
+                                               lambda, seek, leafSlots);
+    workLoop<DefTraits, IterateMethod::SEEK>(loops, forwards, backwards,
+                                             lambda, seek, leafSlots);
+    workLoop<LargeTraits, IterateMethod::SEEK>(loops, forwards, backwards,
+                                               lambda, seek, leafSlots);
+    workLoop<HugeTraits, IterateMethod::SEEK>(loops, forwards, backwards,
+                                              lambda, seek, leafSlots);
+    workLoop<SmallTraits, IterateMethod::SEEK_BATCH>(loops, forwards, backwards,
+                                                     lambda, seek, leafSlots);
+    workLoop<DefTraits, IterateMethod::SEEK_BATCH>(loops, forwards, backwards,
+                                                   lambda, seek, leafSlots);
+    workLoop<LargeTraits, IterateMethod::SEEK_BATCH>(loops, forwards, backwards,
+                                                     lambda, seek, leafSlots);
+    workLoop<HugeTraits, IterateMethod::SEEK_BATCH>(loops, forwards, backwards,
+                                                    lambda, seek, leafSlots);
     return 0;
 }
 
@@ -0,0 +1,180 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/common/adaptivesequencedtaskexecutor.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/test/insertion_operators.h>
+#include <vespa/vespalib/util/gate.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <vespa/log/log.h>
+LOG_SETUP("adaptivesequencedtaskexecutor_test");
+
+namespace search::common {
+
+using ExecutorId = ISequencedTaskExecutor::ExecutorId;
+
+struct Fixture
+{
+    AdaptiveSequencedTaskExecutor _threads;
+
+    Fixture(uint32_t strands = 4, uint32_t threads = 2, uint32_t taskLimit = 1000)
+        : _threads(strands, threads, taskLimit)
+    {
+    }
+};
+
+TEST_F("require that tasks with same executor id are run in order", Fixture)
+{
+    std::mutex lock;
+    std::vector<std::vector<int>> seen(4);
+    for (int i = 0; i < 1000; ++i) {
+        for (uint32_t id = 0; id < 4; ++id) {
+            f._threads.execute(ExecutorId(id), [&, i, id]()
+                               {
+                                   std::lock_guard<std::mutex> guard(lock);
+                                   seen[id].push_back(i);
+                               });
+        }
+    }
+    f._threads.sync();
+    for (const auto &values : seen) {
+        ASSERT_EQUAL(1000u, values.size());
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQUAL(i, values[i]);
+        }
+    }
+}
+
+TEST_F("require that tasks with same executor id are never run concurrently", Fixture(2, 8))
+{
+    std::atomic<int> active[2];
+    std::atomic<int> overlaps(0);
+    for (auto &a : active) {
+        a = 0;
+    }
+    for (int i = 0; i < 4000; ++i) {
+        uint32_t id = ((i % 4) == 0) ? 1 : 0;
+        f._threads.execute(ExecutorId(id), [&, id]()
+                           {
+                               if (active[id].fetch_add(1) != 0) {
+                                   ++overlaps;
+                               }
+                               active[id].fetch_sub(1);
+                           });
+    }
+    f._threads.sync();
+    EXPECT_EQUAL(0, overlaps.load());
+}
+
+TEST_F("require that a blocked strand does not hold back other strands", Fixture(8, 2))
+{
+    vespalib::Gate blocker;
+    vespalib::Gate started;
+    f._threads.execute(ExecutorId(0), [&]() { started.countDown(); blocker.await(); });
+    started.await();
+    // strands 2, 4 and 6 would share a thread with strand 0 in a
+    // statically partitioned executor with 2 threads.
+    vespalib::CountDownLatch latch(7 * 10);
+    for (uint32_t id = 1; id < 8; ++id) {
+        for (int i = 0; i < 10; ++i) {
+            f._threads.execute(ExecutorId(id), [&]() { latch.countDown(); });
+        }
+    }
+    EXPECT_TRUE(latch.await(60000));
+    blocker.countDown();
+    f._threads.sync();
+}
+
+TEST_F("require that sync waits for all previously posted tasks", Fixture)
+{
+    std::atomic<int> done(0);
+    for (int i = 0; i < 100; ++i) {
+        f._threads.execute(ExecutorId(i % 4), [&]() { std::this_thread::sleep_for(std::chrono::microseconds(100)); ++done; });
+    }
+    f._threads.sync();
+    EXPECT_EQUAL(100, done.load());
+}
+
+TEST_F("require that per strand stats are tracked and reset", Fixture(3, 1))
+{
+    vespalib::Gate blocker;
+    vespalib::Gate started;
+    f._threads.execute(ExecutorId(0), [&]() { started.countDown(); blocker.await(); });
+    started.await();
+    for (int i = 0; i < 5; ++i) {
+        f._threads.execute(ExecutorId(1), [](){});
+    }
+    f._threads.execute(ExecutorId(2), [](){});
+    auto stats = f._threads.getStrandStats();
+    ASSERT_EQUAL(3u, stats.size());
+    EXPECT_EQUAL(0u, stats[0].queueDepth);
+    EXPECT_EQUAL(1u, stats[0].maxQueueDepth);
+    EXPECT_EQUAL(1u, stats[0].acceptedTasks);
+    EXPECT_EQUAL(5u, stats[1].queueDepth);
+    EXPECT_EQUAL(5u, stats[1].maxQueueDepth);
+    EXPECT_EQUAL(5u, stats[1].acceptedTasks);
+    EXPECT_EQUAL(1u, stats[2].queueDepth);
+    EXPECT_EQUAL(1u, stats[2].maxQueueDepth);
+    EXPECT_EQUAL(1u, stats[2].acceptedTasks);
+    auto totals = f._threads.getStats();
+    EXPECT_EQUAL(7u, totals.acceptedTasks);
+    EXPECT_EQUAL(7u, totals.maxPendingTasks);
+    EXPECT_EQUAL(0u, totals.executedTasks);
+    EXPECT_EQUAL(1u, totals.threads);
+    blocker.countDown();
+    f._threads.sync();
+    stats = f._threads.getStrandStats();
+    EXPECT_EQUAL(0u, stats[1].queueDepth);
+    EXPECT_EQUAL(5u, stats[1].maxQueueDepth);
+    EXPECT_EQUAL(0u, stats[1].acceptedTasks);
+    stats = f._threads.getStrandStats();
+    EXPECT_EQUAL(0u, stats[1].maxQueueDepth);
+    totals = f._threads.getStats();
+    EXPECT_EQUAL(0u, totals.acceptedTasks);
+    EXPECT_EQUAL(7u, totals.maxPendingTasks);
+    EXPECT_EQUAL(7u, totals.executedTasks);
+    EXPECT_GREATER(totals.busyTime, 0.0);
+    EXPECT_GREATER(totals.waitTime, 0.0);
+    EXPECT_GREATER(totals.maxWaitTime, 0.0);
+    totals = f._threads.getStats();
+    EXPECT_EQUAL(0u, totals.maxPendingTasks);
+}
+
+TEST_F("require that producer is blocked when strand task limit is reached", Fixture(2, 1, 2))
+{
+    vespalib::Gate blocker;
+    vespalib::Gate started;
+    f._threads.execute(ExecutorId(0), [&]() { started.countDown(); blocker.await(); });
+    started.await();
+    f._threads.execute(ExecutorId(0), [](){});
+    f._threads.execute(ExecutorId(0), [](){});
+    // other strands are not affected by the limit of strand 0
+    f._threads.execute(ExecutorId(1), [](){});
+    f._threads.execute(ExecutorId(1), [](){});
+    std::atomic<bool> posted(false);
+    std::thread producer([&]() { f._threads.execute(ExecutorId(0), [](){}); posted = true; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(posted.load());
+    blocker.countDown();
+    producer.join();
+    EXPECT_TRUE(posted.load());
+    f._threads.sync();
+}
+
+TEST_F("require that component ids are spread over strands", Fixture(3, 1))
+{
+    EXPECT_EQUAL(3u, f._threads.getNumExecutors());
+    EXPECT_EQUAL(0u, f._threads.getExecutorId(10).getId());
+    EXPECT_EQUAL(1u, f._threads.getExecutorId(11).getId());
+    EXPECT_EQUAL(2u, f._threads.getExecutorId(12).getId());
+    EXPECT_EQUAL(0u, f._threads.getExecutorId(13).getId());
+    EXPECT_EQUAL(1u, f._threads.getExecutorId(11).getId());
+}
+
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,50 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/common/background_write_limiter.h>
+
+using search::BackgroundWriteLimiter;
+
+double elapsed(BackgroundWriteLimiter::Clock::time_point start) {
+    return std::chrono::duration<double>(BackgroundWriteLimiter::Clock::now() - start).count();
+}
+
+TEST("require that writes are not throttled without a limit") {
+    BackgroundWriteLimiter limiter;
+    auto start = BackgroundWriteLimiter::Clock::now();
+    for (size_t i = 0; i < 1000; ++i) {
+        limiter.acquire(1024 * 1024);
+    }
+    EXPECT_LESS(elapsed(start), 1.0);
+    auto stats = limiter.getStats();
+    EXPECT_EQUAL(0u, stats.maxBytesPerSecond);
+    EXPECT_EQUAL(1000u * 1024 * 1024, stats.bytesWritten);
+    EXPECT_EQUAL(0.0, stats.throttledTime);
+}
+
+TEST("require that writes are throttled to the given rate") {
+    BackgroundWriteLimiter limiter;
+    limiter.setMaxBytesPerSecond(10 * 1000 * 1000);
+    auto start = BackgroundWriteLimiter::Clock::now();
+    for (size_t i = 0; i < 30; ++i) {
+        limiter.acquire(100 * 1000); // 3 MB at 10 MB/s, minus 100 ms burst
+    }
+    EXPECT_GREATER_EQUAL(elapsed(start), 0.19);
+    auto stats = limiter.getStats();
+    EXPECT_EQUAL(10u * 1000 * 1000, stats.maxBytesPerSecond);
+    EXPECT_EQUAL(3u * 1000 * 1000, stats.bytesWritten);
+    EXPECT_GREATER(stats.throttledTime, 0.0);
+}
+
+TEST("require that a short burst is not throttled") {
+    BackgroundWriteLimiter limiter;
+    limiter.setMaxBytesPerSecond(10 * 1000 * 1000);
+    limiter.acquire(500 * 1000);
+    EXPECT_EQUAL(0.0, limiter.getStats().throttledTime);
+}
+
+TEST("require that one limiter is shared by the process") {
+    EXPECT_EQUAL(&BackgroundWriteLimiter::instance(), &BackgroundWriteLimiter::instance());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
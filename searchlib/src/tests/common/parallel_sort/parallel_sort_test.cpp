@@ -0,0 +1,96 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/attribute/loadedenumvalue.h>
+#include <vespa/searchlib/common/parallel_sort.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <atomic>
+#include <future>
+#include <random>
+
+#include <vespa/log/log.h>
+LOG_SETUP("parallel_sort_test");
+
+using search::attribute::LoadedEnumAttribute;
+using search::attribute::LoadedEnumAttributeVector;
+using search::attribute::sortLoadedByEnum;
+using search::runParallelParts;
+using vespalib::ThreadStackExecutor;
+
+namespace {
+
+LoadedEnumAttributeVector
+makeLoaded(size_t numValues, uint32_t numEnums, uint32_t enumStep)
+{
+    std::mt19937 rnd(42);
+    LoadedEnumAttributeVector loaded;
+    for (size_t i = 0; i < numValues; ++i) {
+        loaded.push_back(LoadedEnumAttribute((rnd() % numEnums) * enumStep, i, 1));
+    }
+    std::shuffle(loaded.begin(), loaded.end(), rnd);
+    return loaded;
+}
+
+bool
+isSorted(const LoadedEnumAttributeVector &loaded)
+{
+    return std::is_sorted(loaded.begin(), loaded.end(), LoadedEnumAttribute::EnumCompare());
+}
+
+void
+checkSort(size_t numValues, uint32_t numEnums, uint32_t enumStep, ThreadStackExecutor *executor)
+{
+    LoadedEnumAttributeVector loaded = makeLoaded(numValues, numEnums, enumStep);
+    sortLoadedByEnum(loaded, executor);
+    EXPECT_EQUAL(numValues, loaded.size());
+    EXPECT_TRUE(isSorted(loaded));
+    std::vector<bool> seen(numValues, false);
+    for (const auto &value : loaded) {
+        seen[value.getDocId()] = true;
+    }
+    EXPECT_TRUE(std::find(seen.begin(), seen.end(), false) == seen.end());
+}
+
+}
+
+TEST("require that all parts are run once") {
+    ThreadStackExecutor executor(4, 128 * 1024);
+    std::vector<std::atomic<uint32_t>> counts(100);
+    runParallelParts(executor, counts.size(), [&](size_t part) { ++counts[part]; });
+    for (const auto &count : counts) {
+        EXPECT_EQUAL(1u, count.load());
+    }
+    runParallelParts(executor, 0, [&](size_t) { TEST_ERROR("no parts should be run"); });
+}
+
+TEST("require that parts can be run from a thread owned by a busy executor") {
+    ThreadStackExecutor executor(1, 128 * 1024);
+    std::promise<size_t> promise;
+    auto future = promise.get_future();
+    executor.execute(vespalib::makeLambdaTask([&]()
+                                              {
+                                                  std::atomic<size_t> sum(0);
+                                                  runParallelParts(executor, 10, [&](size_t part) { sum += part; });
+                                                  promise.set_value(sum);
+                                              }));
+    EXPECT_EQUAL(45u, future.get());
+    executor.sync();
+}
+
+TEST("require that loaded enum values are sorted without executor") {
+    checkSort(0, 10, 1, nullptr);
+    checkSort(1000, 10, 1, nullptr);
+    checkSort(200000, 1000, 1, nullptr);
+}
+
+TEST("require that loaded enum values are sorted with executor") {
+    ThreadStackExecutor executor(4, 128 * 1024);
+    checkSort(1000, 10, 1, &executor);
+    checkSort(200000, 1, 1, &executor);
+    checkSort(200000, 3, 1000000, &executor);
+    checkSort(200000, 1000, 1, &executor);
+    checkSort(500000, 100000, 17, &executor);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,6 +2,7 @@
 
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/searchlib/common/rcuvector.h>
+#include <vespa/searchlib/common/segmented_rcuvector.hpp>
 
 using namespace search::attribute;
 using search::MemoryUsage;
@@ -298,4 +299,62 @@ TEST("test small expand")
     g.trimHoldLists(2);
 }
 
+using SegmentedVector = SegmentedRcuVectorBase<int64_t>;
+constexpr size_t segmentSize = SegmentedVector::SEGMENT_SIZE;
+
+TEST("require that segmented vector stores values across segments")
+{
+    GenerationHolder g;
+    SegmentedVector v(1, 0, 1, g);
+    EXPECT_EQUAL(8192u, segmentSize);
+    EXPECT_EQUAL(segmentSize, v.capacity());
+    for (size_t i = 0; i < 3 * segmentSize + 5; ++i) {
+        v.push_back(i * 3);
+    }
+    EXPECT_EQUAL(3 * segmentSize + 5, v.size());
+    EXPECT_EQUAL(4 * segmentSize, v.capacity());
+    for (size_t i = 0; i < v.size(); ++i) {
+        EXPECT_EQUAL(int64_t(i * 3), v[i]);
+    }
+    g.clearHoldLists();
+}
+
+TEST("require that segmented vector only holds directory when growing")
+{
+    GenerationHolder g;
+    SegmentedVector v(1, 100, 0, g);
+    v.ensure_size(segmentSize, 7);
+    const int64_t *first = &v[0];
+    EXPECT_EQUAL(0u, g.getHeldBytes());
+    v.push_back(8); // adds one segment and grows the directory
+    EXPECT_EQUAL(2 * segmentSize, v.capacity());
+    EXPECT_EQUAL(first, &v[0]);
+    EXPECT_EQUAL(sizeof(int64_t *), g.getHeldBytes());
+    v.reserve(10 * segmentSize);
+    EXPECT_EQUAL(first, &v[0]);
+    EXPECT_EQUAL(10 * segmentSize, v.capacity());
+    EXPECT_EQUAL(3 * sizeof(int64_t *), g.getHeldBytes());
+    EXPECT_EQUAL(7, v[segmentSize - 1]);
+    EXPECT_EQUAL(8, v[segmentSize]);
+    g.clearHoldLists();
+}
+
+TEST("require that segmented vector shrink holds released segments")
+{
+    GenerationHolder g;
+    SegmentedVector v(1, 0, 1, g);
+    v.ensure_size(4 * segmentSize, 5);
+    size_t directoryHeld = g.getHeldBytes();
+    v.shrink(segmentSize + 1);
+    EXPECT_EQUAL(segmentSize + 1, v.size());
+    EXPECT_EQUAL(2 * segmentSize, v.capacity());
+    EXPECT_EQUAL(directoryHeld + 2 * segmentSize * sizeof(int64_t), g.getHeldBytes());
+    EXPECT_EQUAL(5, v[segmentSize]);
+    g.transferHoldLists(1);
+    g.trimHoldLists(2);
+    EXPECT_EQUAL(0u, g.getHeldBytes());
+    MemoryUsage usage = v.getMemoryUsage();
+    EXPECT_EQUAL((segmentSize + 1) * sizeof(int64_t) + 2 * sizeof(int64_t *), usage.usedBytes());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,78 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/diskindex/dictionary_bloom_filter.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/fastos/file.h>
+
+using search::diskindex::DictionaryBloomFilter;
+using search::index::DummyFileHeaderContext;
+using vespalib::make_string;
+
+namespace {
+
+std::vector<uint64_t>
+hashWords(const vespalib::string &prefix, uint32_t numWords)
+{
+    std::vector<uint64_t> hashes;
+    for (uint32_t i = 0; i < numWords; ++i) {
+        hashes.push_back(DictionaryBloomFilter::hash(make_string("%s%u", prefix.c_str(), i)));
+    }
+    return hashes;
+}
+
+uint32_t
+countFalsePositives(const DictionaryBloomFilter &filter, uint32_t numWords)
+{
+    uint32_t falsePositives = 0;
+    for (uint32_t i = 0; i < numWords; ++i) {
+        if (filter.mightContain(make_string("absent%u", i))) {
+            ++falsePositives;
+        }
+    }
+    return falsePositives;
+}
+
+}
+
+TEST("require that empty filter matches everything") {
+    DictionaryBloomFilter filter;
+    EXPECT_TRUE(filter.mightContain("foo"));
+    EXPECT_EQUAL(0u, filter.getMemoryUsage());
+}
+
+TEST("require that filter has no false negatives") {
+    DictionaryBloomFilter filter(hashWords("word", 10000));
+    for (uint32_t i = 0; i < 10000; ++i) {
+        EXPECT_TRUE(filter.mightContain(make_string("word%u", i)));
+    }
+}
+
+TEST("require that filter rejects most absent words") {
+    DictionaryBloomFilter filter(hashWords("word", 10000));
+    EXPECT_LESS(countFalsePositives(filter, 10000), 200u);
+    DictionaryBloomFilter emptyDictionary(std::vector<uint64_t>{});
+    EXPECT_EQUAL(1u, emptyDictionary.getNumBlocks());
+    EXPECT_EQUAL(0u, countFalsePositives(emptyDictionary, 1000));
+}
+
+TEST("require that filter can be saved and loaded") {
+    DummyFileHeaderContext fileHeaderContext;
+    DictionaryBloomFilter filter(hashWords("word", 1000));
+    vespalib::FileHeader header;
+    fileHeaderContext.addTags(header, "dictionary.bloom");
+    EXPECT_TRUE(filter.save("dictionary.bloom", search::TuneFileSeqWrite(), header));
+    DictionaryBloomFilter loaded;
+    EXPECT_TRUE(loaded.load("dictionary.bloom"));
+    EXPECT_EQUAL(filter.getNumBlocks(), loaded.getNumBlocks());
+    for (uint32_t i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(loaded.mightContain(make_string("word%u", i)));
+    }
+    EXPECT_EQUAL(countFalsePositives(filter, 1000), countFalsePositives(loaded, 1000));
+    EXPECT_FALSE(loaded.load("missing.bloom"));
+    FastOS_File::Delete("dictionary.bloom");
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
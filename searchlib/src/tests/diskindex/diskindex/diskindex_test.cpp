@@ -61,6 +61,7 @@ private:
     void requireThatBlueprintIsCreated();
     void requireThatBlueprintCanCreateSearchIterators();
     void requireThatSearchIteratorsConforms();
+    void requireThatDictionaryBloomFilterIsWritten(const vespalib::string &dir);
 public:
     Test();
     ~Test();
@@ -168,6 +169,16 @@ Test::requireThatLookupIsWorking(bool fieldEmpty,
     }
 }
 
+void
+Test::requireThatDictionaryBloomFilterIsWritten(const vespalib::string &dir)
+{
+    DictionaryBloomFilter filter;
+    EXPECT_TRUE(filter.load(dir + "/f2/dictionary.bloom"));
+    EXPECT_TRUE(filter.mightContain("w1"));
+    EXPECT_TRUE(filter.mightContain("w2"));
+    EXPECT_FALSE(filter.mightContain("wnot"));
+}
+
 void
 Test::requireThatWeCanReadPostingList()
 {
@@ -180,6 +191,15 @@ Test::requireThatWeCanReadPostingList()
         EXPECT_EQUAL("1,3", toString(*sb));
         delete sb;
     }
+    { // field 'f1', prefetched
+        LookupResult::UP r = _index->lookup(0, "w1");
+        _index->prefetchPostingList(*r);
+        PostingListHandle::UP h = _index->readPostingList(*r);
+        SearchIterator * sb = h->createIterator(r->counts, mda);
+        sb->initFullRange();
+        EXPECT_EQUAL("1,3", toString(*sb));
+        delete sb;
+    }
 }
 
 void
@@ -312,6 +332,7 @@ Test::Main()
     TEST_DO(requireThatLookupIsWorking(false, false, true));
     TEST_DO(openIndex("index/1", false, false, false, false, false));
     TEST_DO(requireThatLookupIsWorking(false, false, false));
+    TEST_DO(requireThatDictionaryBloomFilterIsWritten("index/1"));
     TEST_DO(requireThatWeCanReadPostingList());
     TEST_DO(requireThatWeCanReadBitVector());
     TEST_DO(requireThatBlueprintIsCreated());
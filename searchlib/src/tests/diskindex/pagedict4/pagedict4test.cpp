@@ -353,6 +353,21 @@ checkCounts(const std::string &word,
 }
 
 
+struct PrefixCollector : public DictionaryFileRandRead::PrefixVisitor
+{
+    std::vector<vespalib::string> _words;
+    std::vector<uint64_t> _wordNums;
+    std::vector<PostingListOffsetAndCounts> _offsetAndCounts;
+
+    void visit(const vespalib::stringref &word, uint64_t wordNum,
+               const PostingListOffsetAndCounts &offsetAndCounts) override
+    {
+        _words.push_back(word);
+        _wordNums.push_back(wordNum);
+        _offsetAndCounts.push_back(offsetAndCounts);
+    }
+};
+
 void
 testWords(const std::string &logname,
           search::Rand48 &rnd,
@@ -642,6 +657,76 @@ testWords(const std::string &logname,
         (void) closeres;
         LOG(info, "%s: pagedict4 randverify OK", logname.c_str());
     }
+    {
+        PageDict4RandRead drr(64 * 1024 * 1024);
+        search::TuneFileRandRead tuneFileRead;
+        bool openres = drr.open("fakedict", tuneFileRead);
+        assert(openres);
+        (void) openres;
+        PostingListOffsetAndCounts rOffsetAndCounts;
+        uint64_t wordNum = 1;
+        uint64_t checkWordNum = 0;
+        uint64_t wOffset = 0;
+        std::string missWord;
+        for (const auto &wc : myrand) {
+            makeCounts(counts, wc, chunkSize);
+            bool lres = drr.lookup(wc._word, checkWordNum, rOffsetAndCounts);
+            assert(lres);
+            (void) lres;
+            assert(rOffsetAndCounts._counts == counts);
+            assert(rOffsetAndCounts._offset == wOffset);
+            assert(checkWordNum == wordNum);
+            missWord = wc._word;
+            missWord.append(1, '\1');
+            lres = drr.lookup(missWord, checkWordNum, rOffsetAndCounts);
+            assert(!lres);
+            assert(checkWordNum == wordNum + 1);
+            wOffset += counts._bitLength;
+            ++wordNum;
+        }
+        // Second pass only hits decoded pages
+        search::CacheStats stats = drr.getPageCacheStats();
+        for (const auto &wc : myrand) {
+            bool lres = drr.lookup(wc._word, checkWordNum, rOffsetAndCounts);
+            assert(lres);
+            (void) lres;
+        }
+        assert(drr.getPageCacheStats().misses == stats.misses);
+
+        PrefixCollector all;
+        drr.visitPrefix("", all);
+        assert(all._words.size() == myrand.size());
+        wordNum = 1;
+        wOffset = 0;
+        for (size_t i = 0; i < myrand.size(); ++i, ++wordNum) {
+            makeCounts(counts, myrand[i], chunkSize);
+            assert(all._words[i] == myrand[i]._word);
+            assert(all._wordNums[i] == wordNum);
+            assert(all._offsetAndCounts[i]._offset == wOffset);
+            assert(all._offsetAndCounts[i]._counts == counts);
+            wOffset += counts._bitLength;
+        }
+        for (size_t i = 0; i < myrand.size(); i += 7) {
+            const std::string &prefix = myrand[i]._word;
+            PrefixCollector some;
+            drr.visitPrefix(prefix, some);
+            size_t expSize = 0;
+            while (i + expSize < myrand.size() &&
+                   myrand[i + expSize]._word.compare(0, prefix.size(), prefix) == 0) {
+                ++expSize;
+            }
+            assert(some._words.size() == expSize);
+            assert(some._words.front() == prefix);
+            assert(some._wordNums.front() == i + 1);
+        }
+        PrefixCollector none;
+        drr.visitPrefix("Thiswordhasbetternotbeindictionary", none);
+        assert(none._words.empty());
+        bool closeres = drr.close();
+        assert(closeres);
+        (void) closeres;
+        LOG(info, "%s: pagedict4 cached randverify OK", logname.c_str());
+    }
 }
 
 
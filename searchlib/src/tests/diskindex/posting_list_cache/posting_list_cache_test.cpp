@@ -0,0 +1,116 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/diskindex/posting_list_cache.h>
+#include <vespa/searchlib/index/postinglisthandle.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <cstdlib>
+
+using search::diskindex::PostingListCache;
+using search::index::PostingListHandle;
+using Key = PostingListCache::Key;
+
+namespace {
+
+constexpr size_t allocSize = 4096;
+
+void
+readPostingList(PostingListHandle &handle, uint64_t bitOffset, size_t size = allocSize)
+{
+    handle._allocMem = malloc(size);
+    handle._allocSize = size;
+    handle._mem = handle._allocMem;
+    handle._bitOffsetMem = bitOffset;
+    handle._firstSegment = 0;
+    handle._numSegments = 1;
+}
+
+bool
+lookupOrInsert(PostingListCache &cache, const Key &key)
+{
+    PostingListHandle handle;
+    if (cache.lookup(key, handle)) {
+        return true;
+    }
+    readPostingList(handle, key.bitOffset);
+    cache.insert(key, handle);
+    return false;
+}
+
+}
+
+TEST("require that inserted posting list is found and shared")
+{
+    PostingListCache cache(1024 * 1024);
+    Key key(PostingListCache::newFileId(), 128);
+    const void *mem = nullptr;
+    {
+        PostingListHandle handle;
+        EXPECT_FALSE(cache.lookup(key, handle));
+        readPostingList(handle, 64);
+        mem = handle._mem;
+        cache.insert(key, handle);
+        EXPECT_TRUE(handle._allocMem == nullptr);
+        EXPECT_EQUAL(mem, handle._sharedMem.get());
+    }
+    PostingListHandle handle;
+    EXPECT_TRUE(cache.lookup(key, handle));
+    EXPECT_EQUAL(mem, handle._mem);
+    EXPECT_EQUAL(64u, handle._bitOffsetMem);
+    EXPECT_EQUAL(1u, handle._numSegments);
+    EXPECT_FALSE(cache.lookup(Key(PostingListCache::newFileId(), 128), handle));
+
+    search::CacheStats stats = cache.getStats();
+    EXPECT_EQUAL(1u, stats.hits);
+    EXPECT_EQUAL(2u, stats.misses);
+    EXPECT_EQUAL(1u, stats.elements);
+    EXPECT_LESS(allocSize, stats.memory_used);
+}
+
+TEST("require that memory mapped and too large posting lists are not cached")
+{
+    PostingListCache cache(64 * 1024);
+    Key key(PostingListCache::newFileId(), 0);
+    char mapped[16];
+    PostingListHandle handle;
+    handle._mem = mapped;
+    cache.insert(key, handle);
+    readPostingList(handle, 0, 16 * 1024);
+    cache.insert(key, handle);
+    EXPECT_TRUE(handle._allocMem != nullptr);
+    EXPECT_EQUAL(0u, cache.getStats().elements);
+    EXPECT_EQUAL(1u, cache.getRejected());
+}
+
+TEST("require that frequently used posting list is not evicted by rarely used ones")
+{
+    PostingListCache cache(64 * 1024);
+    uint64_t fileId = PostingListCache::newFileId();
+    Key frequent(fileId, 0);
+    for (uint32_t i = 0; i < 5; ++i) {
+        lookupOrInsert(cache, frequent);
+    }
+    for (uint64_t i = 1; i <= 100; ++i) {
+        lookupOrInsert(cache, Key(fileId, i * 1000));
+    }
+    search::CacheStats stats = cache.getStats();
+    EXPECT_LESS_EQUAL(stats.memory_used, 64u * 1024);
+    EXPECT_LESS(1u, stats.elements);
+    EXPECT_LESS(0u, cache.getRejected());
+    EXPECT_TRUE(lookupOrInsert(cache, frequent));
+}
+
+TEST("require that posting list used more often than the victim is admitted")
+{
+    PostingListCache cache(64 * 1024);
+    uint64_t fileId = PostingListCache::newFileId();
+    uint64_t i = 1;
+    while (cache.getRejected() == 0) {
+        lookupOrInsert(cache, Key(fileId, i++ * 1000));
+    }
+    Key candidate(fileId, 0);
+    EXPECT_FALSE(lookupOrInsert(cache, candidate));
+    EXPECT_FALSE(lookupOrInsert(cache, candidate));
+    EXPECT_TRUE(lookupOrInsert(cache, candidate));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,61 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/searchlib/diskindex/zcbuf.h>
+#include <vespa/searchlib/diskindex/zcpostingiterators.h>
+#include <random>
+
+using search::diskindex::ZcBuf;
+using search::diskindex::zcDecodePadded;
+
+namespace {
+
+std::vector<uint32_t>
+makeValues()
+{
+    std::vector<uint32_t> values;
+    for (uint32_t shift = 0; shift < 32; ++shift) {
+        uint32_t val = static_cast<uint32_t>(1) << shift;
+        values.push_back(val - 1);
+        values.push_back(val);
+        values.push_back(val + 1);
+    }
+    values.push_back(std::numeric_limits<uint32_t>::max());
+    std::mt19937 gen(42);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        // Spread values over all encoded lengths
+        uint32_t bits = gen() % 33;
+        values.push_back((bits == 0) ? 0u : (gen() >> (32 - bits)));
+    }
+    return values;
+}
+
+}
+
+TEST("require that padded zc decode matches zc encode")
+{
+    std::vector<uint32_t> values = makeValues();
+    ZcBuf buf;
+    for (uint32_t val : values) {
+        buf.encode(val);
+    }
+    // Padding needed by zcDecodePadded
+    for (uint32_t i = 0; i < 8; ++i) {
+        buf.encode(0);
+    }
+    const uint8_t *valI = buf._mallocStart;
+    const uint8_t *refValI = buf._mallocStart;
+    for (uint32_t val : values) {
+        uint32_t refVal = 0;
+        ZCDECODE(refValI, refVal =);
+        uint32_t decoded = zcDecodePadded(valI);
+        EXPECT_EQUAL(val, refVal);
+        EXPECT_EQUAL(val, decoded);
+        EXPECT_EQUAL(refValI, valI);
+        if (val != decoded || refValI != valI) {
+            break;
+        }
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
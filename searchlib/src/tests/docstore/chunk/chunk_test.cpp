@@ -8,11 +8,14 @@
 #include <vespa/searchlib/docstore/chunkformats.h>
 #include <vespa/vespalib/objects/hexdump.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 LOG_SETUP("chunk_test");
 
 using namespace search;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
 
 TEST("require that Chunk obey limits")
 {
@@ -98,4 +101,69 @@ TEST("require that V2 can create and handle lz4, zstd, and none") {
     verifyChunkCompression(CompressionConfig::ZSTD, MY_LONG_STRING, strlen(MY_LONG_STRING), 282);
 }
 
+vespalib::string
+makeDocument(uint32_t id)
+{
+    return vespalib::make_string("{\"id\":\"id:music:music::%u\",\"title\":\"Title number %u\",\"artist\":\"Artist %u\","
+                                 "\"year\":%u,\"genre\":\"rock\",\"label\":\"Record label %u\"}",
+                                 id, id * 7, id % 113, 1950 + (id % 70), id % 31);
+}
+
+std::unique_ptr<ZStdDictionary>
+trainDictionary()
+{
+    std::vector<char> samples;
+    std::vector<size_t> sampleSizes;
+    for (uint32_t id(0); id < 2000; id++) {
+        vespalib::string doc = makeDocument(id);
+        samples.insert(samples.end(), doc.begin(), doc.end());
+        sampleSizes.push_back(doc.size());
+    }
+    return std::make_unique<ZStdDictionary>(ZStdDictionary::train(samples.data(), sampleSizes, 4096));
+}
+
+size_t
+packDocuments(Chunk & chunk, vespalib::DataBuffer & buffer)
+{
+    for (uint32_t lid(0); lid < 4; lid++) {
+        vespalib::string doc = makeDocument(100000 + lid);
+        chunk.append(lid, doc.c_str(), doc.size());
+    }
+    chunk.pack(7, buffer, CompressionConfig(CompressionConfig::ZSTD));
+    return buffer.getDataLen();
+}
+
+TEST("require that V3 compresses with the dictionary of the file") {
+    std::unique_ptr<ZStdDictionary> dictionary = trainDictionary();
+    Chunk v2(0, Chunk::Config(0x10000));
+    vespalib::DataBuffer v2Buffer;
+    size_t v2Size = packDocuments(v2, v2Buffer);
+    Chunk v3(0, Chunk::Config(0x10000, dictionary.get()));
+    vespalib::DataBuffer v3Buffer;
+    size_t v3Size = packDocuments(v3, v3Buffer);
+    EXPECT_EQUAL(ChunkFormatV3::VERSION, uint8_t(v3Buffer.getData()[0]));
+    EXPECT_LESS(v3Size, v2Size);
+
+    Chunk deserialized(0, v3Buffer.getData(), v3Buffer.getDataLen(), false, dictionary.get());
+    EXPECT_EQUAL(7u, deserialized.getLastSerial());
+    EXPECT_EQUAL(4u, deserialized.count());
+    for (uint32_t lid(0); lid < 4; lid++) {
+        vespalib::ConstBufferRef doc = deserialized.getLid(lid);
+        EXPECT_EQUAL(makeDocument(100000 + lid), vespalib::string(doc.c_str(), doc.size()));
+    }
+}
+
+TEST("require that V3 can not be read without the right dictionary") {
+    std::unique_ptr<ZStdDictionary> dictionary = trainDictionary();
+    Chunk v3(0, Chunk::Config(0x10000, dictionary.get()));
+    vespalib::DataBuffer buffer;
+    packDocuments(v3, buffer);
+    EXPECT_EXCEPTION(Chunk(0, buffer.getData(), buffer.getDataLen()), ChunkException, "no dictionary is available");
+    std::vector<char> other(dictionary->getData());
+    other[4] ^= 0x1; // Dictionary id
+    ZStdDictionary otherDictionary(std::move(other));
+    EXPECT_EXCEPTION(Chunk(0, buffer.getData(), buffer.getDataLen(), false, &otherDictionary), ChunkException,
+                     "but dictionary is");
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -69,6 +69,7 @@ TEST("require that DocumentStore::Config equality operator detects inequality")
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::NONE, 100000, 99));
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::NONE, 100001, 100));
     EXPECT_FALSE(C(CompressionConfig::NONE, 100000, 100) == C(CompressionConfig::LZ4, 100000, 100));
+    EXPECT_FALSE(C() == C().setMaxPrefetchHits(10));
 }
 
 TEST("require that LogDocumentStore::Config equality operator detects inequality") {
@@ -14,6 +14,8 @@
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <iomanip>
 
@@ -765,13 +767,17 @@ struct Fixture {
 
     Fixture(const vespalib::string &dirName = "tmp",
             bool dirCleanup = true,
-            size_t maxFileSize = 4096 * 2)
+            size_t maxFileSize = 4096 * 2,
+            bool useLidInfoSnapshot = false,
+            uint32_t readThreads = 0)
         : executor(1, 0x10000),
           dir(dirName),
           serialNum(0),
           fileHeaderCtx(),
           tlSyncer(),
-          store(executor, dirName, getBasicConfig(maxFileSize), GrowStrategy(),
+          store(executor, dirName,
+                getBasicConfig(maxFileSize).useLidInfoSnapshot(useLidInfoSnapshot).setReadThreads(readThreads),
+                GrowStrategy(),
                 TuneFileSummary(), fileHeaderCtx, tlSyncer, nullptr)
     {
         dir.cleanup(dirCleanup);
@@ -893,6 +899,93 @@ TEST("require that lid space can be compacted and entries from old files skipped
     }
 }
 
+std::vector<vespalib::string>
+describeFileChunks(const LogDataStore &store)
+{
+    std::vector<vespalib::string> result;
+    for (const auto &stat : store.getFileChunkStats()) {
+        result.push_back(vespalib::make_string("%lu:%lu:%lu:%lu:%u", stat.nameId(), stat.diskUsage(), stat.diskBloat(),
+                                               stat.lastFlushedSerialNum(), stat.docIdLimit()));
+    }
+    return result;
+}
+
+TEST("require that lid info snapshot restores lid map and file stats of frozen files")
+{
+    std::vector<vespalib::string> expFiles;
+    {
+        Fixture f("tmp", false, 4096 * 2, true);
+        f.writeUntilNewChunk(10);
+        f.write(11);
+        f.writeUntilNewChunk(100);
+        f.write(12);
+        f.write(101);
+        f.flush();
+        expFiles = describeFileChunks(f.store);
+    }
+    EXPECT_TRUE(vespalib::fileExists("tmp/lidinfo.snapshot"));
+    {
+        Fixture f("tmp", false, 4096 * 2, true);
+        EXPECT_EQUAL(expFiles, describeFileChunks(f.store));
+        TEST_DO(f.assertContent({10,11,12,13,100,101,102,103}, 104));
+        f.assertDocIdLimit(104);
+    }
+    {
+        Fixture f("tmp", true, 4096 * 2, false);
+        EXPECT_EQUAL(expFiles, describeFileChunks(f.store));
+        TEST_DO(f.assertContent({10,11,12,13,100,101,102,103}, 104));
+    }
+}
+
+TEST("require that files newer than lid info snapshot are read from idx files")
+{
+    {
+        Fixture f("tmp", false, 4096 * 2, true);
+        f.writeUntilNewChunk(10);
+        f.flush();
+    }
+    vespalib::copy("tmp/lidinfo.snapshot", "tmp/old.snapshot");
+    {
+        Fixture f("tmp", false, 4096 * 2, true);
+        f.write(10);
+        f.writeUntilNewChunk(100);
+        f.write(200);
+        f.flush();
+    }
+    vespalib::rename("tmp/old.snapshot", "tmp/lidinfo.snapshot");
+    {
+        Fixture f("tmp", true, 4096 * 2, true);
+        TEST_DO(f.assertContent({10,11,12,13,100,101,102,103,200}, 201));
+        f.assertDocIdLimit(201);
+    }
+}
+
+TEST("require that corrupt lid info snapshot is ignored")
+{
+    std::vector<vespalib::string> expFiles;
+    {
+        Fixture f("tmp", false, 4096 * 2, true);
+        f.writeUntilNewChunk(10);
+        f.write(20);
+        f.flush();
+        expFiles = describeFileChunks(f.store);
+    }
+    {
+        vespalib::File file("tmp/lidinfo.snapshot");
+        file.open(0);
+        char c = 0;
+        file.read(&c, 1, file.getFileSize() - 1);
+        c ^= 0x5a;
+        file.write(&c, 1, file.getFileSize() - 1);
+        file.close();
+    }
+    {
+        Fixture f("tmp", true, 4096 * 2, true);
+        EXPECT_EQUAL(expFiles, describeFileChunks(f.store));
+        TEST_DO(f.assertContent({10,11,12,13,20}, 21));
+    }
+}
+
 TEST_F("require that getLid() is protected by docIdLimit", Fixture)
 {
     f.write(1);
@@ -901,6 +994,81 @@ TEST_F("require that getLid() is protected by docIdLimit", Fixture)
     EXPECT_FALSE(f.store.getLid(guard, 2).valid());
 }
 
+struct CollectingVisitor : public IBufferVisitor {
+    std::map<uint32_t, vespalib::string> docs;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+        docs[lid] = vespalib::string(buf.c_str(), buf.size());
+    }
+};
+
+void
+verifyBatchedRead(Fixture &f)
+{
+    std::vector<uint32_t> lids;
+    for (uint32_t lid = 1; lid <= 40; ++lid) {
+        f.write(lid);
+        lids.push_back(lid);
+    }
+    EXPECT_LESS(1u, f.store.getFileChunkStats().size());
+    lids.push_back(41);
+    CollectingVisitor visitor;
+    f.store.read(lids, visitor);
+    EXPECT_EQUAL(40u, visitor.docs.size());
+    for (uint32_t lid = 1; lid <= 40; ++lid) {
+        EXPECT_EQUAL(genData(lid, 1024), visitor.docs[lid]);
+    }
+}
+
+TEST_F("require that batched read returns entries from all chunks and files", Fixture)
+{
+    TEST_DO(verifyBatchedRead(f));
+}
+
+TEST_F("require that batched read with read threads returns entries from all chunks and files",
+       Fixture("tmp", true, 4096 * 2, false, 2))
+{
+    TEST_DO(verifyBatchedRead(f));
+}
+
+TEST_F("require that prefetch accepts lids in files, in memory and outside the lid space", Fixture)
+{
+    std::set<uint32_t> written;
+    for (uint32_t lid = 1; lid <= 40; ++lid) {
+        f.write(lid);
+        written.insert(lid);
+    }
+    EXPECT_LESS(1u, f.store.getFileChunkStats().size());
+    std::vector<uint32_t> lids({40, 1, 2, 20, 41, 1000});
+    f.store.prefetch(lids);
+    TEST_DO(f.assertContent(written, 41));
+}
+
+TEST_F("require that reads are counted into read frequency classes when enabled", Fixture)
+{
+    f.write(1).write(2).write(3);
+    vespalib::DataBuffer buffer;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        f.store.read(1, buffer);
+    }
+    auto guard = f.store.getLidReadGuard();
+    EXPECT_EQUAL(0u, f.store.getReadFrequencyClass(guard, 1));
+
+    LogDataStore::Config config = f.store.getConfig();
+    f.store.reconfigure(config.compactByReadFrequency(true));
+    for (uint32_t i = 0; i < 5000; ++i) {
+        f.store.read(1, buffer);
+    }
+    CollectingVisitor visitor;
+    for (uint32_t i = 0; i < 5; ++i) {
+        f.store.read(std::vector<uint32_t>({2}), visitor);
+    }
+    EXPECT_EQUAL(LogDataStore::NUM_READ_FREQUENCY_CLASSES - 1, f.store.getReadFrequencyClass(guard, 1));
+    EXPECT_LESS(0u, f.store.getReadFrequencyClass(guard, 2));
+    EXPECT_GREATER(LogDataStore::NUM_READ_FREQUENCY_CLASSES - 1, f.store.getReadFrequencyClass(guard, 2));
+    EXPECT_EQUAL(0u, f.store.getReadFrequencyClass(guard, 3));
+    EXPECT_EQUAL(0u, f.store.getReadFrequencyClass(guard, 100));
+}
+
 TEST_F("require that lid space can be compacted and shrunk", Fixture)
 {
     f.write(1).write(2);
@@ -979,6 +1147,8 @@ TEST("require that config equality operator detects inequality") {
     EXPECT_FALSE(C() == C().disableCrcOnRead(true));
     EXPECT_FALSE(C() == C().compact2ActiveFile(false));
     EXPECT_FALSE(C() == C().compactCompression({CompressionConfig::ZSTD}));
+    EXPECT_FALSE(C() == C().compactByReadFrequency(true));
+    EXPECT_FALSE(C() == C().useLidInfoSnapshot(true));
 }
 
 TEST_MAIN() {
@@ -233,12 +233,16 @@ Benchmark::runFieldMatch(Config & cfg)
     FtFeatureTest ft(_factory, feature);
 
     setupPropertyMap(ft.getIndexEnv().getProperties(), cfg.getUnknown());
-    setupFieldMatch(ft, index, query, field, NULL, 0, 0.0f, 0);
+    setupFieldMatch(ft, index, query, field, NULL, 0, 0.0f, 1);
 
+    RankResult result;
     start();
     std::cout << "**** '" << cfg.getFeature() << "' ****" << std::endl;
     for (uint32_t i = 0; i < numRuns; ++i) {
-        // rank evaluation is now lazy, please re-write benchmark if needed
+        // rank evaluation is lazy per docid; alternate with a document without matches
+        // (cheap to evaluate) to have the matching document evaluated in every run.
+        ft.executeOnly(result, 1);
+        ft.executeOnly(result, 2);
     }
     sample();
 }
@@ -1183,6 +1183,8 @@ Test::testDotProduct()
             assertDotProduct(0,  "()",                    1, "wsint");
             assertDotProduct(0,  "(6:5,7:5)",             1, "wsint");
             assertDotProduct(55, "(1:1,2:2,3:3,4:4,5:5)", 1, "wsint");
+            assertDotProduct(20, "(2:10,2:15)",           1, "wsint");
+            assertDotProduct(55, "(1:1,2:2,3:3,4:4,5:5,6:6,7:7,8:8,9:9,10:10,11:11,12:12,13:13,14:14,15:15,16:16,17:17)", 1, "wsint");
         }
         std::vector<const char *> attributes = {"arrint", "arrfloat", "arrint_fast", "arrfloat_fast"};
         for (const char * name : attributes) {
@@ -234,6 +234,14 @@ TEST("test stuff") {
             p.add("vespa.rank.firstphase", "specialrank");
             EXPECT_EQUAL(rank::FirstPhase::lookup(p), vespalib::string("specialrank"));
         }
+        { // vespa.rank.firstphase.upperbound
+            EXPECT_EQUAL(rank::FirstPhaseUpperBound::NAME, vespalib::string("vespa.rank.firstphase.upperbound"));
+            EXPECT_EQUAL(rank::FirstPhaseUpperBound::DEFAULT_VALUE, vespalib::string(""));
+            Properties p;
+            EXPECT_EQUAL(rank::FirstPhaseUpperBound::lookup(p), vespalib::string(""));
+            p.add("vespa.rank.firstphase.upperbound", "attribute(popularity)");
+            EXPECT_EQUAL(rank::FirstPhaseUpperBound::lookup(p), vespalib::string("attribute(popularity)"));
+        }
         { // vespa.rank.secondphase
             EXPECT_EQUAL(rank::SecondPhase::NAME, vespalib::string("vespa.rank.secondphase"));
             EXPECT_EQUAL(rank::SecondPhase::DEFAULT_VALUE, vespalib::string(""));
@@ -270,6 +278,14 @@ TEST("test stuff") {
             p.add("vespa.matching.termwise_limit", "0.05");
             EXPECT_EQUAL(matching::TermwiseLimit::lookup(p), 0.05);
         }
+        { // vespa.matching.termwise_or_limit
+            EXPECT_EQUAL(matching::TermwiseOrLimit::NAME, vespalib::string("vespa.matching.termwise_or_limit"));
+            EXPECT_EQUAL(matching::TermwiseOrLimit::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::TermwiseOrLimit::lookup(p), 0u);
+            p.add("vespa.matching.termwise_or_limit", "64");
+            EXPECT_EQUAL(matching::TermwiseOrLimit::lookup(p), 64u);
+        }
         { // vespa.matching.numthreads
             EXPECT_EQUAL(matching::NumThreadsPerSearch::NAME, vespalib::string("vespa.matching.numthreadspersearch"));
             EXPECT_EQUAL(matching::NumThreadsPerSearch::DEFAULT_VALUE, std::numeric_limits<uint32_t>::max());
@@ -295,6 +311,31 @@ TEST("test stuff") {
             p.add("vespa.matching.numsearchpartitions", "50");
             EXPECT_EQUAL(matching::NumSearchPartitions::lookup(p), 50u);
         }
+        {
+            EXPECT_EQUAL(matching::EstimateSampleBudget::NAME, vespalib::string("vespa.matching.estimate_sample_budget"));
+            EXPECT_EQUAL(matching::EstimateSampleBudget::DEFAULT_VALUE, 0u);
+            Properties p;
+            EXPECT_EQUAL(matching::EstimateSampleBudget::lookup(p), 0u);
+            p.add("vespa.matching.estimate_sample_budget", "65536");
+            EXPECT_EQUAL(matching::EstimateSampleBudget::lookup(p), 65536u);
+        }
+        {
+            EXPECT_EQUAL(matching::WorkStealing::NAME, vespalib::string("vespa.matching.workstealing"));
+            EXPECT_EQUAL(matching::WorkStealing::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(matching::WorkStealing::lookup(p), false);
+            EXPECT_EQUAL(matching::WorkStealing::lookup(p, true), true);
+            p.add("vespa.matching.workstealing", "true");
+            EXPECT_EQUAL(matching::WorkStealing::lookup(p), true);
+        }
+        {
+            EXPECT_EQUAL(matching::TraceCost::NAME, vespalib::string("vespa.matching.trace.cost"));
+            EXPECT_EQUAL(matching::TraceCost::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(matching::TraceCost::lookup(p), false);
+            p.add("vespa.matching.trace.cost", "true");
+            EXPECT_EQUAL(matching::TraceCost::lookup(p), true);
+        }
         { // vespa.matchphase.degradation.attribute
             EXPECT_EQUAL(matchphase::DegradationAttribute::NAME, vespalib::string("vespa.matchphase.degradation.attribute"));
             EXPECT_EQUAL(matchphase::DegradationAttribute::DEFAULT_VALUE, "");
@@ -359,6 +400,15 @@ TEST("test stuff") {
             p.add("vespa.matchphase.diversity.mingroups", "5");
             EXPECT_EQUAL(matchphase::DiversityMinGroups::lookup(p), 5u);
         }
+        {
+            EXPECT_EQUAL(matchphase::SortedEarlyTermination::NAME, vespalib::string("vespa.matchphase.sorted.earlytermination"));
+            EXPECT_EQUAL(matchphase::SortedEarlyTermination::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(matchphase::SortedEarlyTermination::lookup(p), false);
+            EXPECT_EQUAL(matchphase::SortedEarlyTermination::lookup(p, true), true);
+            p.add("vespa.matchphase.sorted.earlytermination", "true");
+            EXPECT_EQUAL(matchphase::SortedEarlyTermination::lookup(p), true);
+        }
         { // vespa.hitcollector.heapsize
             EXPECT_EQUAL(hitcollector::HeapSize::NAME, vespalib::string("vespa.hitcollector.heapsize"));
             EXPECT_EQUAL(hitcollector::HeapSize::DEFAULT_VALUE, 100u);
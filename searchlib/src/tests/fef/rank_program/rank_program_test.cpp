@@ -339,6 +339,33 @@ TEST_F("require that interpreted ranking expressions are always lazy", Fixture()
     EXPECT_EQUAL(f1.track_cnt, 2u);
 }
 
+LazyValue find_feature(const RankProgram &program, const vespalib::string &name) {
+    auto result = program.get_all_features();
+    for (size_t i = 0; i < result.num_features(); ++i) {
+        if (result.name_of(i) == name) {
+            return result.resolve(i);
+        }
+    }
+    return LazyValue(nullptr);
+}
+
+TEST_F("require that compiled ranking expressions calculate direct inputs themselves", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "docid*2+track(docid)").compile();
+    auto direct = find_feature(f1.program, "docid").direct_number();
+    ASSERT_TRUE(direct.valid());
+    EXPECT_EQUAL(7.0, direct.get(7));
+    EXPECT_EQUAL(f1.get(expr_feature("rank"),  5), 15.0);
+    EXPECT_EQUAL(f1.get(expr_feature("rank"), 15), 45.0);
+    EXPECT_EQUAL(f1.track_cnt, 2u);
+}
+
+TEST_F("require that overridden inputs are not calculated directly", Fixture()) {
+    f1.lazy_expressions(false).add_expr("rank", "docid*2").override("docid", 3.0).compile();
+    EXPECT_TRUE(!find_feature(f1.program, "docid").direct_number().valid());
+    EXPECT_EQUAL(f1.get(expr_feature("rank"),  5), 6.0);
+    EXPECT_EQUAL(f1.get(expr_feature("rank"), 15), 6.0);
+}
+
 TEST_F("require that compiled ranking expressions are pure", Fixture()) {
     f1.lazy_expressions(false).add_expr("rank", "value(7)").compile();
     EXPECT_EQUAL(2u, count_features(f1.program));
@@ -242,4 +242,31 @@ TEST("require that MatchData soft_reset retains appropriate state") {
     EXPECT_EQUAL(new_term->getDocId(), TermFieldMatchData::invalidId());
 }
 
+TEST("require that recycled MatchData is reinitialized for the new layout") {
+    MatchDataLayout layout;
+    layout.allocTermField(3);
+    layout.allocTermField(5);
+    auto md = MatchData::makeTestInstance(10, 10);
+    md->set_termwise_limit(0.5);
+    md->resolveTermField(1)->tagAsNotNeeded();
+    md->resolveTermField(1)->setRawScore(42, 3.0);
+    for (uint32_t i = 0; i < 10; ++i) {
+        md->resolveTermField(0)->appendPosition(TermFieldMatchDataPosition(0, i, 1, 10));
+    }
+    const MatchData *old_md = md.get();
+    md = layout.createMatchData(std::move(md));
+    EXPECT_EQUAL(old_md, md.get());
+    EXPECT_EQUAL(md->getNumTermFields(), 2u);
+    EXPECT_EQUAL(md->get_termwise_limit(), 1.0);
+    for (uint32_t i = 0; i < 2; ++i) {
+        const auto *term = md->resolveTermField(i);
+        EXPECT_EQUAL(term->getFieldId(), (i == 0) ? 3u : 5u);
+        EXPECT_TRUE(!term->isNotNeeded());
+        EXPECT_EQUAL(term->getDocId(), TermFieldMatchData::invalidId());
+        EXPECT_EQUAL(term->size(), 0u);
+        EXPECT_EQUAL(term->getRawScore(), 0.0);
+    }
+    EXPECT_TRUE(layout.createMatchData(MatchData::UP()));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -145,6 +145,8 @@ public:
                    const Group &expect);
     void testAggregationSimple();
     void testAggregationLevels();
+    void testAggregationManyHits();
+    void testAggregationColumnar();
     void testAggregationMaxGroups();
     void testAggregationGroupOrder();
     void testAggregationGroupRank();
@@ -479,6 +481,110 @@ Test::testAggregationLevels()
     }
 }
 
+/**
+ * Verify aggregation over more hits than are prefetched in one batch,
+ * where nested levels only see a subset of the prefetched hits.
+ **/
+void
+Test::testAggregationManyHits()
+{
+    AggregationContext ctx;
+    IntAttrBuilder mod3("mod3");
+    IntAttrBuilder docid("docid");
+    FloatAttrBuilder half("half");
+    for (uint32_t i = 0; i < 1000; ++i) {
+        mod3.add(i % 3);
+        docid.add(i);
+        half.add(i * 0.5);
+        ctx.result().add(i, i % 7);
+    }
+    ctx.add(mod3.sp());
+    ctx.add(docid.sp());
+    ctx.add(half.sp());
+
+    Grouping request;
+    request.setRoot(Group().addResult(SumAggregationResult().setExpression(MU<AttributeNode>("half"))))
+           .addLevel(createGL(MU<AttributeNode>("mod3"), MU<AttributeNode>("docid")))
+           .setFirstLevel(0)
+           .setLastLevel(1);
+
+    Group expect;
+    expect.addResult(SumAggregationResult().setExpression(MU<AttributeNode>("half")).setResult(FloatResultNode(249750)))
+          .addChild(Group().setId(Int64ResultNode(0)).setRank(RawRank(6))
+                           .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("docid"))
+                                                            .setResult(Int64ResultNode(166833))))
+          .addChild(Group().setId(Int64ResultNode(1)).setRank(RawRank(6))
+                           .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("docid"))
+                                                            .setResult(Int64ResultNode(166167))))
+          .addChild(Group().setId(Int64ResultNode(2)).setRank(RawRank(6))
+                           .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("docid"))
+                                                            .setResult(Int64ResultNode(166500))));
+
+    EXPECT_TRUE(testAggregation(ctx, request, expect));
+}
+
+/**
+ * Verify that a single level grouping collecting plain attribute
+ * values, which is aggregated column by column, gives the expected
+ * groups and results.
+ **/
+void
+Test::testAggregationColumnar()
+{
+    AggregationContext ctx;
+    IntAttrBuilder mod5("mod5");
+    IntAttrBuilder docid("docid");
+    FloatAttrBuilder half("half");
+    int64_t sum[5] = {0, 0, 0, 0, 0};
+    uint64_t count[5] = {0, 0, 0, 0, 0};
+    for (uint32_t i = 0; i < 1000; ++i) {
+        mod5.add(i % 5);
+        docid.add(i);
+        half.add(i * 0.5);
+        sum[i % 5] += i;
+        ++count[i % 5];
+        ctx.result().add(i, i % 7);
+    }
+    ctx.add(mod5.sp());
+    ctx.add(docid.sp());
+    ctx.add(half.sp());
+
+    GroupingLevel level;
+    level.setExpression(MU<AttributeNode>("mod5"))
+         .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("docid")))
+         .addResult(CountAggregationResult().setExpression(MU<AttributeNode>("docid")))
+         .addResult(MinAggregationResult().setExpression(MU<AttributeNode>("half")))
+         .addResult(MaxAggregationResult().setExpression(MU<AttributeNode>("half")))
+         .addResult(AverageAggregationResult().setExpression(MU<AttributeNode>("docid")));
+    Grouping request;
+    request.addLevel(std::move(level))
+           .setFirstLevel(0)
+           .setLastLevel(1);
+
+    Group expect;
+    for (uint32_t g = 0; g < 5; ++g) {
+        expect.addChild(Group().setId(Int64ResultNode(g)).setRank(RawRank(6))
+                        .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("docid"))
+                                                         .setResult(Int64ResultNode(sum[g])))
+                        .addResult(CountAggregationResult(count[g]).setExpression(MU<AttributeNode>("docid")))
+                        .addResult(MinAggregationResult().setExpression(MU<AttributeNode>("half"))
+                                                         .setResult(FloatResultNode(g * 0.5)))
+                        .addResult(MaxAggregationResult().setExpression(MU<AttributeNode>("half"))
+                                                         .setResult(FloatResultNode((995 + g) * 0.5)))
+                        .addResult(AverageAggregationResult(MU<Int64ResultNode>(sum[g]), count[g])
+                                   .setExpression(MU<AttributeNode>("docid"))));
+    }
+    EXPECT_TRUE(testAggregation(ctx, request, expect));
+
+    // only the first groups seen are kept when the number of groups is capped
+    request.levels()[0].setMaxGroups(2);
+    Group capped;
+    for (uint32_t g = 0; g < 2; ++g) {
+        capped.addChild(Group(expect.getChild(g)));
+    }
+    EXPECT_TRUE(testAggregation(ctx, request, capped));
+}
+
 /**
  * Verify that the aggregation step does not create more groups than
  * indicated by the maxgroups parameter.
@@ -1899,6 +2005,8 @@ Test::Main()
     TEST_INIT("grouping_test");
     TEST_DO(testAggregationSimple());
     testAggregationLevels();
+    testAggregationManyHits();
+    testAggregationColumnar();
     testAggregationMaxGroups();
     testAggregationGroupOrder();
     testAggregationGroupRank();
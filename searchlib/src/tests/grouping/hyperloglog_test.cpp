@@ -86,6 +86,36 @@ TEST("require that mixed hyperloglogs can be merged") {
     EXPECT_EQUAL(0, hll.aggregate(500));
 }
 
+uint64_t mixHash(uint64_t i) {
+    uint64_t h = (i + 1) * 0x9e3779b97f4a7c15ul;
+    return (h ^ (h >> 31));
+}
+
+TEST("require that hyperloglog estimates unique counts") {
+    HyperLogLog<> hll;
+    EXPECT_EQUAL(0u, hll.estimateCount());
+    for (size_t i = 0; i < 200; ++i) {
+        hll.aggregate(mixHash(i));
+        hll.aggregate(mixHash(i));
+    }
+    EXPECT_EQUAL(200u, hll.estimateCount());  // exact while sparse
+    for (size_t i = 200; i < 10000; ++i) {
+        hll.aggregate(mixHash(i));
+    }
+    EXPECT_APPROX(10000.0, double(hll.estimateCount()), 500.0);
+}
+
+TEST("require that merged hyperloglogs estimate the union") {
+    HyperLogLog<> hll1;
+    HyperLogLog<> hll2;
+    for (size_t i = 0; i < 6000; ++i) {
+        hll1.aggregate(mixHash(i));
+        hll2.aggregate(mixHash(i + 4000));
+    }
+    hll1.merge(hll2);
+    EXPECT_APPROX(10000.0, double(hll1.estimateCount()), 500.0);
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
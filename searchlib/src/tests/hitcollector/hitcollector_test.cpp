@@ -251,6 +251,18 @@ TEST_F("require that scores for 2nd phase candidates can be retrieved", Descendi
     EXPECT_EQUAL(96, scores[4]);
 }
 
+TEST_F("require that 2nd phase candidates can be retrieved with docids", DescendingScoreFixture)
+{
+    f.addHits();
+    std::vector<HitCollector::Hit> hits = f.hc.getSortedHeapHits(3);
+    ASSERT_EQUAL(3u, hits.size());
+    for (uint32_t i = 0; i < hits.size(); ++i) {
+        EXPECT_EQUAL(i, hits[i].first);
+        EXPECT_EQUAL(100 - i, hits[i].second);
+    }
+    EXPECT_EQUAL(5u, f.hc.getSortedHeapHits(10).size());
+}
+
 TEST("require that score ranges can be read and set.") {
     std::pair<Scores, Scores> ranges =
         std::make_pair(Scores(1.0, 2.0), Scores(3.0, 4.0));
@@ -262,6 +274,23 @@ TEST("require that score ranges can be read and set.") {
     EXPECT_EQUAL(ranges.second.high, hc.getRanges().second.high);
 }
 
+TEST("require that score threshold tracks the lowest stored score") {
+    HitCollector hc(20, 3, 0);
+    EXPECT_EQUAL(-HUGE_VAL, hc.getScoreThreshold());
+    hc.addHit(0, 5);
+    hc.addHit(1, 7);
+    hc.addHit(2, 3);
+    EXPECT_EQUAL(-HUGE_VAL, hc.getScoreThreshold());
+    hc.addHit(3, 4);
+    EXPECT_EQUAL(4.0, hc.getScoreThreshold());
+    hc.addHit(4, 2);
+    EXPECT_EQUAL(4.0, hc.getScoreThreshold());
+    hc.addHit(5, 9);
+    EXPECT_EQUAL(5.0, hc.getScoreThreshold());
+    HitCollector no_scores(20, 0, 0);
+    EXPECT_EQUAL(HUGE_VAL, no_scores.getScoreThreshold());
+}
+
 TEST("testNoHitsToReRank") {
     uint32_t numDocs = 20;
     uint32_t maxHitsSize = 10;
@@ -531,4 +560,18 @@ TEST("require that hits can be added out of order only after passing array limit
     TEST_DO(checkResult(*rs.get(), nullptr));
 }
 
+TEST("require that memory usage covers collected hits") {
+    HitCollector hc(10000, 100, 10);
+    size_t initial = hc.getMemoryUsage();
+    for (uint32_t i = 0; i < 100; ++i) {
+        hc.addHit(i, i + 100);
+    }
+    EXPECT_GREATER_EQUAL(hc.getMemoryUsage(), 100 * sizeof(HitCollector::Hit));
+    EXPECT_GREATER_EQUAL(hc.getMemoryUsage(), initial);
+    for (uint32_t i = 100; i < 5000; ++i) {
+        hc.addHit(i, i + 100);
+    }
+    EXPECT_GREATER_EQUAL(hc.getMemoryUsage(), 100 * sizeof(HitCollector::Hit) + 10000 / 8);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -29,6 +29,7 @@ private:
     void requireThatFeaturesCanBeAddedAndRetrieved();
     void requireThatNextWordsAreWorking();
     void requireThatAddFeaturesTriggersChangeOfBuffer();
+    void requireThatFeaturesAreStoredWithoutPadding();
 
 public:
     Test();
@@ -202,6 +203,27 @@ Test::requireThatAddFeaturesTriggersChangeOfBuffer()
 }
 
 
+void
+Test::requireThatFeaturesAreStoredWithoutPadding()
+{
+    FeatureStore fs(getSchema());
+    DocIdAndFeatures act;
+    std::vector<std::pair<EntryRef, uint64_t>> refs;
+    for (uint32_t i = 1; i < 10; ++i) {
+        refs.push_back(fs.addFeatures(0, getFeatures(i, 1, i + 1)));
+    }
+    for (size_t i = 1; i < refs.size(); ++i) {
+        EXPECT_EQUAL(FeatureStore::RefType(refs[i - 1].first).offset() +
+                     (refs[i - 1].second + 7) / 8,
+                     FeatureStore::RefType(refs[i].first).offset());
+    }
+    for (uint32_t i = 1; i < 10; ++i) {
+        fs.getFeatures(0, refs[i - 1].first, act);
+        EXPECT_TRUE(assertFeatures(getFeatures(i, 1, i + 1), act));
+    }
+}
+
+
 Test::Test()
     : _schema()
 {
@@ -218,6 +240,7 @@ Test::Main()
     requireThatFeaturesCanBeAddedAndRetrieved();
     requireThatNextWordsAreWorking();
     requireThatAddFeaturesTriggersChangeOfBuffer();
+    requireThatFeaturesAreStoredWithoutPadding();
 
     TEST_DONE();
 }
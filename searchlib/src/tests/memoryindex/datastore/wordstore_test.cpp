@@ -13,6 +13,7 @@ class Test : public vespalib::TestApp {
 private:
     void requireThatWordsCanBeAddedAndRetrieved();
     void requireThatAddWordTriggersChangeOfBuffer();
+    void requireThatWordsAreStoredOnce();
 public:
     int Main() override;
 };
@@ -72,12 +73,41 @@ Test::requireThatAddWordTriggersChangeOfBuffer()
     EXPECT_EQUAL(4u, lastId);
 }
 
+void
+Test::requireThatWordsAreStoredOnce()
+{
+    WordStore ws;
+    EntryRef r1 = ws.addWord("foo");
+    EntryRef r2 = ws.addWord("foobar");
+    EntryRef r3 = ws.addWord("fo");
+    EXPECT_EQUAL(3u, ws.getNumWords());
+    EXPECT_EQUAL(r1.ref(), ws.addWord("foo").ref());
+    EXPECT_EQUAL(r2.ref(), ws.addWord("foobar").ref());
+    EXPECT_EQUAL(r3.ref(), ws.addWord("fo").ref());
+    EXPECT_EQUAL(3u, ws.getNumWords());
+    // Words are still found after the hash table has grown
+    std::vector<EntryRef> refs;
+    char wordStr[10];
+    for (size_t word = 0; word < 5000; ++word) {
+        sprintf(wordStr, "%zu", word);
+        refs.push_back(ws.addWord(std::string(wordStr)));
+    }
+    EXPECT_EQUAL(5003u, ws.getNumWords());
+    for (size_t word = 0; word < 5000; ++word) {
+        sprintf(wordStr, "%zu", word);
+        EXPECT_EQUAL(refs[word].ref(), ws.addWord(std::string(wordStr)).ref());
+    }
+    EXPECT_EQUAL(5003u, ws.getNumWords());
+    EXPECT_EQUAL(r1.ref(), ws.addWord("foo").ref());
+}
+
 int
 Test::Main()
 {
     TEST_INIT("wordstore_test");
 
     requireThatWordsCanBeAddedAndRetrieved();
+    requireThatWordsAreStoredOnce();
     requireThatAddWordTriggersChangeOfBuffer();
 
     TEST_DONE();
@@ -17,6 +17,7 @@
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
 #include <vespa/searchlib/test/searchiteratorverifier.h>
 #include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("dictionary_test");
@@ -618,6 +619,44 @@ TEST_F("requireThatAppendInsertWorks", Fixture)
     EXPECT_TRUE(assertPostingList("[5,10,20]", d.findFrozen("a", 0)));
 }
 
+TEST_F("require that bitvector changes are visible to readers after commit", Fixture)
+{
+    Dictionary d(f.getSchema());
+    SequencedTaskExecutor pushThreads(2);
+    MemoryFieldIndex &fieldIndex = *d.getFieldIndex(0);
+    WrapInserter inserter(d, 0);
+    inserter.word("a");
+    for (uint32_t docId = 1; docId <= 20; ++docId) {
+        inserter.add(docId);
+    }
+    inserter.flush();
+    const BitVector *bv = nullptr;
+    fieldIndex.findFrozen("a", bv);
+    EXPECT_TRUE(bv == nullptr);
+    myCommit(d, pushThreads);
+    auto guard = fieldIndex.takeGenerationGuard();
+    fieldIndex.findFrozen("a", bv);
+    ASSERT_TRUE(bv != nullptr);
+    EXPECT_EQUAL(20u, bv->countTrueBits());
+    inserter.rewind().word("a").remove(5).add(21).flush();
+    const BitVector *uncommitted = nullptr;
+    fieldIndex.findFrozen("a", uncommitted);
+    EXPECT_EQUAL(bv, uncommitted);
+    EXPECT_TRUE(bv->testBit(5));
+    EXPECT_EQUAL(20u, bv->countTrueBits());
+    myCommit(d, pushThreads);
+    const BitVector *committed = nullptr;
+    fieldIndex.findFrozen("a", committed);
+    ASSERT_TRUE(committed != nullptr);
+    EXPECT_NOT_EQUAL(bv, committed);
+    EXPECT_FALSE(committed->testBit(5));
+    EXPECT_TRUE(committed->testBit(21));
+    EXPECT_EQUAL(20u, committed->countTrueBits());
+    // The old copy is kept unchanged while the guard is held
+    EXPECT_TRUE(bv->testBit(5));
+    EXPECT_EQUAL(20u, bv->countTrueBits());
+}
+
 TEST_F("requireThatMultiplePostingListsCanExist", Fixture)
 {
     Dictionary d(f.getSchema());
@@ -1148,6 +1187,44 @@ TEST_F("requireThatInverterHandlesRemoveViaDocumentRemover",
     EXPECT_TRUE(assertPostingList("[]", f._d.find("c", 1)));
 }
 
+TEST_F("requireThatShardedInverterIsWorking", DictionaryFixture<Fixture>)
+{
+    DocumentInverter inv(f.getSchema(), f._invertThreads, f._pushThreads, 3);
+    EXPECT_EQUAL(3u, inv.getNumShards(0));
+    EXPECT_EQUAL(3u, inv.getNumShards(1));
+
+    for (uint32_t docId = 1; docId <= 6; ++docId) {
+        f._b.startDocument(vespalib::make_string("doc::%u", docId));
+        f._b.startIndexField("f0").addStr("a").addStr((docId & 1) ? "b" : "c").endField();
+        f._b.startIndexField("f1").addStr("a").endField();
+        Document::UP doc = f._b.endDocument();
+        inv.invertDocument(docId, *doc);
+    }
+    f._invertThreads.sync();
+    myPushDocument(inv, f._d);
+    f._pushThreads.sync();
+
+    EXPECT_TRUE(assertPostingList("[1,2,3,4,5,6]", f._d.find("a", 0)));
+    EXPECT_TRUE(assertPostingList("[1,3,5]", f._d.find("b", 0)));
+    EXPECT_TRUE(assertPostingList("[2,4,6]", f._d.find("c", 0)));
+    EXPECT_TRUE(assertPostingList("[1,2,3,4,5,6]", f._d.find("a", 1)));
+
+    f._b.startDocument("doc::2");
+    f._b.startIndexField("f0").addStr("b").endField();
+    Document::UP doc2 = f._b.endDocument();
+    inv.invertDocument(2, *doc2);
+    inv.removeDocument(3);
+    inv.removeDocument(4);
+    f._invertThreads.sync();
+    myPushDocument(inv, f._d);
+    f._pushThreads.sync();
+
+    EXPECT_TRUE(assertPostingList("[1,5,6]", f._d.find("a", 0)));
+    EXPECT_TRUE(assertPostingList("[1,2,5]", f._d.find("b", 0)));
+    EXPECT_TRUE(assertPostingList("[6]", f._d.find("c", 0)));
+    EXPECT_TRUE(assertPostingList("[1,5,6]", f._d.find("a", 1)));
+}
+
 class UriFixture
 {
 public:
@@ -1450,6 +1527,21 @@ TEST_F("require that insert tells which word ref that was inserted", Fixture)
     insertAndAssertTuple("c", 2, 22, d);
 }
 
+TEST_F("require that words are shared between fields", Fixture)
+{
+    Dictionary d(f.getSchema());
+    EntryRef f0Ref = WrapInserter(d, 0).word("a").add(10).flush().getWordRef();
+    EntryRef f1Ref = WrapInserter(d, 1).word("a").add(11).word("b").add(11).flush().getWordRef();
+    EXPECT_EQUAL(f0Ref.ref(), WrapInserter(d, 1).rewind().word("a").add(12).flush().getWordRef().ref());
+    EXPECT_NOT_EQUAL(f0Ref.ref(), f1Ref.ref());
+    const WordStore &wordStore = d.getFieldIndex(0)->getWordStore();
+    EXPECT_EQUAL(&wordStore, &d.getFieldIndex(1)->getWordStore());
+    EXPECT_EQUAL(2u, wordStore.getNumWords());
+    EXPECT_EQUAL(3u, d.getNumUniqueWords());
+    EXPECT_TRUE(assertPostingList("[10]", d.find("a", 0)));
+    EXPECT_TRUE(assertPostingList("[11,12]", d.find("a", 1)));
+}
+
 struct RemoverFixture : public Fixture
 {
     Dictionary      _d;
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/testkit/testapp.h>
 
 #include <vespa/searchlib/memoryindex/memoryindex.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
 #include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/fef/matchdatalayout.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
@@ -13,6 +14,7 @@
 #include <vespa/searchlib/queryeval/fake_searchable.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
 #include <vespa/searchlib/common/scheduletaskcallback.h>
@@ -441,4 +443,110 @@ TEST("requireThatWeCanFakeBitVector")
     }
 }
 
+SearchIterator::UP
+createSearch(Searchable &searchable, const std::string &word, bool filter, bool needUnpack, MatchData::UP &match_data)
+{
+    uint32_t fieldId = 0;
+    MatchDataLayout mdl;
+    FakeRequestContext requestContext;
+    TermFieldHandle handle = mdl.allocTermField(fieldId);
+    match_data = mdl.createMatchData();
+    if (!needUnpack) {
+        match_data->resolveTermField(handle)->tagAsNotNeeded();
+    }
+    FieldSpec field(title, fieldId, handle, filter);
+    FieldSpecList fields;
+    fields.add(field);
+    Blueprint::UP res = searchable.createBlueprint(requestContext, fields, makeTerm(word));
+    res->fetchPostings(true);
+    SearchIterator::UP search = res->createSearch(*match_data, true);
+    search->initFullRange();
+    return search;
+}
+
+TEST("requireThatFrequentWordsGetBitVector")
+{
+    Index index(Setup().field(title));
+    const uint32_t numDocs = 20;
+    for (uint32_t docId = 1; docId <= numDocs; ++docId) {
+        index.doc(docId).field(title).add(foo).commit();
+    }
+    index.doc(numDocs + 1).field(title).add(bar).commit();
+    index.remove(5);
+    MatchData::UP match_data;
+    {
+        SearchIterator::UP search = createSearch(index.index, foo, true, true, match_data);
+        EXPECT_TRUE(dynamic_cast<search::BitVectorIterator *>(search.get()) != NULL);
+        EXPECT_EQUAL("1,2,3,4,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20", toString(*search));
+    }
+    {
+        SearchIterator::UP search = createSearch(index.index, foo, false, false, match_data);
+        EXPECT_TRUE(dynamic_cast<search::BitVectorIterator *>(search.get()) != NULL);
+    }
+    {
+        SearchIterator::UP search = createSearch(index.index, foo, false, true, match_data);
+        EXPECT_TRUE(dynamic_cast<search::BitVectorIterator *>(search.get()) == NULL);
+        EXPECT_EQUAL("1,2,3,4,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20", toString(*search));
+    }
+    {
+        SearchIterator::UP search = createSearch(index.index, bar, true, true, match_data);
+        EXPECT_TRUE(dynamic_cast<BooleanMatchIteratorWrapper *>(search.get()) != NULL);
+        EXPECT_EQUAL("21", toString(*search));
+    }
+    index.doc(30).field(title).add(foo).commit();
+    {
+        SearchIterator::UP search = createSearch(index.index, foo, true, true, match_data);
+        EXPECT_EQUAL("1,2,3,4,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,30", toString(*search));
+    }
+}
+
+TEST("require that checkpoint image can be loaded into empty index")
+{
+    Index index(Setup().field(title).field(body));
+    index.doc(1).field(title).add(foo).add(bar).add(foo).field(body).add(foo).commit();
+    index.doc(4).field(title).add(bar).field(body).add(bar).add(bar).commit();
+    index.doc(2).field(title).add(foo).commit();
+    index.remove(2);
+    vespalib::nbostream os;
+    index.index.saveCheckpoint(os);
+
+    Index loaded(Setup().field(title).field(body));
+    EXPECT_TRUE(loaded.index.loadCheckpoint(os));
+    EXPECT_EQUAL(0u, os.size());
+    EXPECT_EQUAL(2u, loaded.index.getNumDocs());
+    EXPECT_EQUAL(5u, loaded.index.getDocIdLimit());
+    EXPECT_EQUAL(index.index.getNumWords(), loaded.index.getNumWords());
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(3).pos(0).pos(2),
+                            loaded.index, title, makeTerm(foo)));
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(3).pos(1)
+                            .doc(4).len(1).pos(0),
+                            loaded.index, title, makeTerm(bar)));
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(4).len(2).pos(0).pos(1),
+                            loaded.index, body, makeTerm(bar)));
+
+    // documents loaded from the image can be updated and removed
+    loaded.doc(4).field(title).add(foo).commit();
+    loaded.remove(1);
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(4).len(1).pos(0),
+                            loaded.index, title, makeTerm(foo)));
+    EXPECT_TRUE(verifyResult(FakeResult(),
+                            loaded.index, title, makeTerm(bar)));
+
+    // fields are matched by name, and removed fields are dropped
+    Index other(Setup().field(body));
+    index.index.saveCheckpoint(os);
+    EXPECT_TRUE(other.index.loadCheckpoint(os));
+    EXPECT_EQUAL(0u, os.size());
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(4).len(2).pos(0).pos(1),
+                            other.index, body, makeTerm(bar)));
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(1).pos(0),
+                            other.index, body, makeTerm(foo)));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,234 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "iteratorbm.h"
+#include <vespa/searchlib/common/bitvector.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+#include <vespa/searchlib/queryeval/andsearch.h>
+#include <vespa/searchlib/queryeval/orsearch.h>
+#include <vespa/searchlib/test/fakedata/fakeword.h>
+#include <vespa/searchlib/test/fakedata/fakeposting.h>
+#include <vespa/searchlib/test/fakedata/fakewordset.h>
+#include <vespa/searchlib/test/fakedata/fpfactory.h>
+#include <vespa/searchlib/util/rand48.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <chrono>
+#include <functional>
+#include <limits>
+
+using search::BitVector;
+using search::BitVectorIterator;
+using search::fef::TermFieldMatchData;
+using search::fef::TermFieldMatchDataArray;
+using search::queryeval::AndSearch;
+using search::queryeval::MultiSearch;
+using search::queryeval::OrSearch;
+using search::queryeval::SearchIterator;
+
+using namespace search::fakedata;
+
+namespace postinglistbm {
+
+namespace {
+
+struct ScanResult {
+    uint64_t seeks;
+    uint64_t hits;
+    double   ns;
+    ScanResult() : seeks(0), hits(0), ns(std::numeric_limits<double>::max()) {}
+};
+
+/*
+ * A strict scan seeks to the docid after each hit and follows the
+ * iterator to the next hit on a miss. A non-strict scan seeks every
+ * docid, which is what a non-strict iterator sees below a strict
+ * iterator with a hit in every document.
+ */
+ScanResult
+scan(SearchIterator &sb, uint32_t docIdLimit, bool strict, bool unpack)
+{
+    ScanResult res;
+    res.seeks = 0;
+    res.hits = 0;
+    auto before = std::chrono::steady_clock::now();
+    sb.initFullRange();
+    uint32_t docId = 1;
+    while (docId < docIdLimit) {
+        ++res.seeks;
+        if (sb.seek(docId)) {
+            ++res.hits;
+            if (unpack) {
+                sb.unpack(docId);
+            }
+            ++docId;
+        } else if (strict) {
+            docId = sb.getDocId();
+        } else {
+            ++docId;
+        }
+    }
+    auto after = std::chrono::steady_clock::now();
+    res.ns = std::chrono::duration<double, std::nano>(after - before).count();
+    return res;
+}
+
+typedef std::function<SearchIterator::UP(bool strict)> IteratorFactory;
+
+/*
+ * Best of the given number of loops, to hide noise from other
+ * processes; a new iterator is created for each loop.
+ */
+ScanResult
+bestScan(const IteratorFactory &factory, uint32_t docIdLimit, bool strict, bool unpack, unsigned int loops)
+{
+    ScanResult best;
+    for (unsigned int i = 0; i < loops; ++i) {
+        SearchIterator::UP sb = factory(strict);
+        ScanResult res = scan(*sb, docIdLimit, strict, unpack);
+        if (res.ns < best.ns) {
+            best = res;
+        }
+    }
+    return best;
+}
+
+void
+report(const std::string &name, uint32_t docIdLimit, const IteratorFactory &factory, unsigned int loops)
+{
+    for (bool strict : { true, false }) {
+        ScanResult plain = bestScan(factory, docIdLimit, strict, false, loops);
+        ScanResult unpacked = bestScan(factory, docIdLimit, strict, true, loops);
+        double unpackNs = (unpacked.ns > plain.ns) ? (unpacked.ns - plain.ns) : 0.0;
+        printf("iteratorbm %s %s: seeks=%" PRIu64 " hits=%" PRIu64
+               " ns/seek=%.2f ns/hit=%.2f ns/unpack=%.2f\n",
+               name.c_str(), strict ? "strict" : "nonstrict",
+               plain.seeks, plain.hits,
+               plain.ns / std::max(plain.seeks, uint64_t(1)),
+               plain.ns / std::max(plain.hits, uint64_t(1)),
+               unpackNs / std::max(unpacked.hits, uint64_t(1)));
+    }
+}
+
+std::unique_ptr<BitVector>
+makeBitVector(const FakePosting &posting, uint32_t docIdLimit)
+{
+    std::unique_ptr<BitVector> bv(BitVector::create(docIdLimit).release());
+    TermFieldMatchData md;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&md);
+    SearchIterator::UP sb(posting.createIterator(tfmda));
+    sb->initFullRange();
+    for (uint32_t docId = sb->seekFirst(1); docId < docIdLimit; docId = sb->seekFirst(docId + 1)) {
+        bv->setBit(docId);
+    }
+    bv->invalidateCachedCount();
+    return bv;
+}
+
+/*
+ * Match data for a benchmark; each iterator unpacks into its own
+ * term field match data.
+ */
+struct MatchData {
+    std::vector<std::unique_ptr<TermFieldMatchData>> md;
+    std::vector<TermFieldMatchDataArray> tfmda;
+    MatchData(size_t n) : md(), tfmda(n) {
+        for (size_t i = 0; i < n; ++i) {
+            md.emplace_back(new TermFieldMatchData());
+            tfmda[i].add(md.back().get());
+        }
+    }
+};
+
+}
+
+IteratorBenchmark::IteratorBenchmark()
+{
+}
+
+
+IteratorBenchmark::~IteratorBenchmark()
+{
+}
+
+
+void
+IteratorBenchmark::run(search::Rand48 &rnd,
+                       FakeWordSet &wordSet,
+                       unsigned int numDocs,
+                       const std::vector<uint32_t> &docFreqs,
+                       const std::vector<std::string> &postingTypes,
+                       unsigned int loops)
+{
+    std::vector<std::unique_ptr<FakeWord>> words;
+    for (uint32_t docFreq : docFreqs) {
+        words.emplace_back(new FakeWord(numDocs, docFreq, docFreq / 2,
+                                        vespalib::make_string("df%u", docFreq), rnd,
+                                        wordSet.getFieldsParams(), wordSet.getPackedIndex()));
+    }
+    std::vector<const FakeWord *> wordPtrs;
+    for (const auto &word : words) {
+        wordPtrs.push_back(word.get());
+    }
+    for (const std::string &postingType : postingTypes) {
+        std::unique_ptr<FPFactory> ff(getFPFactory(postingType, wordSet.getSchema()));
+        ff->setup(wordPtrs);
+        std::vector<FakePosting::SP> postings;
+        for (const auto &word : words) {
+            postings.push_back(ff->make(*word));
+        }
+        for (size_t i = 0; i < postings.size(); ++i) {
+            FakePosting &posting = *postings[i];
+            MatchData matchData(1);
+            report(vespalib::make_string("%s %s", postingType.c_str(), words[i]->getName().c_str()),
+                   numDocs,
+                   [&posting, &matchData](bool) {
+                       return SearchIterator::UP(posting.createIterator(matchData.tfmda[0]));
+                   },
+                   loops);
+        }
+        // pairs of neighbouring document frequencies, rarest first
+        for (size_t i = 0; i + 1 < postings.size(); ++i) {
+            const FakePosting &a = *postings[i];
+            const FakePosting &b = *postings[i + 1];
+            MatchData matchData(2);
+            std::string pair = vespalib::make_string("%s %s,%s", postingType.c_str(),
+                                                     words[i]->getName().c_str(),
+                                                     words[i + 1]->getName().c_str());
+            report(pair + " AND", numDocs,
+                   [&a, &b, &matchData](bool strict) {
+                       MultiSearch::Children children;
+                       children.push_back(a.createIterator(matchData.tfmda[0]));
+                       children.push_back(b.createIterator(matchData.tfmda[1]));
+                       return SearchIterator::UP(AndSearch::create(children, strict));
+                   },
+                   loops);
+            report(pair + " OR", numDocs,
+                   [&a, &b, &matchData](bool strict) {
+                       MultiSearch::Children children;
+                       children.push_back(a.createIterator(matchData.tfmda[0]));
+                       children.push_back(b.createIterator(matchData.tfmda[1]));
+                       return SearchIterator::UP(OrSearch::create(children, strict));
+                   },
+                   loops);
+        }
+    }
+    // bitvectors only depend on the documents of the word, not the posting format
+    if (!postingTypes.empty()) {
+        std::unique_ptr<FPFactory> ff(getFPFactory(postingTypes.front(), wordSet.getSchema()));
+        ff->setup(wordPtrs);
+        for (const auto &word : words) {
+            std::unique_ptr<BitVector> bv = makeBitVector(*ff->make(*word), numDocs);
+            TermFieldMatchData md;
+            const BitVector *bvp = bv.get();
+            report(vespalib::make_string("bitvector %s", word->getName().c_str()), numDocs,
+                   [bvp, numDocs, &md](bool strict) {
+                       return BitVectorIterator::create(bvp, numDocs, md, strict);
+                   },
+                   loops);
+        }
+    }
+}
+
+}
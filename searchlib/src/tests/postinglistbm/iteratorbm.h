@@ -0,0 +1,38 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vector>
+#include <string>
+
+namespace search {
+class Rand48;
+
+namespace fakedata { class FakeWordSet; }
+
+}
+
+namespace postinglistbm {
+
+/**
+ * Measures the cost of the search iterator stack on synthetic words
+ * with the given document frequencies: ns per seek, per hit and per
+ * unpack for each posting type alone (strict and non-strict), as
+ * bitvector iterators, and combined by AndSearch and OrSearch.
+ **/
+class IteratorBenchmark
+{
+public:
+    IteratorBenchmark();
+
+    ~IteratorBenchmark();
+
+    void
+    run(search::Rand48 &rnd,
+        search::fakedata::FakeWordSet &wordSet,
+        unsigned int numDocs,
+        const std::vector<uint32_t> &docFreqs,
+        const std::vector<std::string> &postingTypes,
+        unsigned int loops);
+};
+
+}
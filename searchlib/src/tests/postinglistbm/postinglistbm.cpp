@@ -4,6 +4,7 @@
 #include <vespa/searchlib/common/resultset.h>
 #include <vespa/searchlib/util/rand48.h>
 #include "andstress.h"
+#include "iteratorbm.h"
 #include <vespa/searchlib/test/fakedata/fakeword.h>
 #include <vespa/searchlib/test/fakedata/fakeposting.h>
 #include <vespa/searchlib/test/fakedata/fakewordset.h>
@@ -38,6 +39,7 @@ private:
     uint32_t _numWordsPerClass;
     std::vector<std::string> _postingTypes;
     uint32_t _loops;
+    std::vector<uint32_t> _docFreqs;
     unsigned int _skipCommonPairsRate;
     FakeWordSet _wordSet;
     uint32_t _stride;
@@ -66,6 +68,8 @@ PostingListBM::Usage()
            "[-a] "
            "[-c <commonDoqFreq>] "
            "[-d <numDocs>] "
+           "[-f <docFreq>[,<docFreq>...]] "
+           "[-i] "
            "[-l <numLoops>] "
            "[-s <stride>] "
            "[-t <postingType>] "
@@ -104,6 +108,7 @@ PostingListBM::PostingListBM()
       _numWordsPerClass(100),
       _postingTypes(),
       _loops(1),
+      _docFreqs(),
       _skipCommonPairsRate(1),
       _wordSet(),
       _stride(0),
@@ -324,14 +329,16 @@ PostingListBM::Main()
     char c;
     const char *optArg;
     bool doandstress;
+    bool doiteratorbm;
 
     doandstress = false;
+    doiteratorbm = false;
     argi = 1;
     bool hasElements = false;
     bool hasElementWeights = false;
     bool quick = false;
 
-    while ((c = GetOpt("C:ac:d:l:s:t:uvw:T:q", optArg, argi)) != -1) {
+    while ((c = GetOpt("C:ac:d:f:il:s:t:uvw:T:q", optArg, argi)) != -1) {
         switch(c) {
         case 'C':
             _skipCommonPairsRate = atoi(optArg);
@@ -360,6 +367,20 @@ PostingListBM::Main()
         case 'd':
             _numDocs = atoi(optArg);
             break;
+        case 'f':
+            for (const char *p = optArg; *p != '\0'; ) {
+                char *end = nullptr;
+                _docFreqs.push_back(strtoul(p, &end, 10));
+                if (end == p) {
+                    Usage();
+                    return 1;
+                }
+                p = (*end == ',') ? end + 1 : end;
+            }
+            break;
+        case 'i':
+            doiteratorbm = true;
+            break;
         case 'l':
             _loops = atoi(optArg);
             break;
@@ -406,6 +427,12 @@ PostingListBM::Main()
         Usage();
         return 1;
     }
+    for (uint32_t docFreq : _docFreqs) {
+        if (docFreq == 0 || docFreq > _numDocs) {
+            Usage();
+            return 1;
+        }
+    }
 
     _wordSet.setupParams(hasElements, hasElementWeights);
 
@@ -469,6 +496,15 @@ PostingListBM::Main()
                       _stride,
                       _unpack);
     }
+    if (doiteratorbm) {
+        if (_docFreqs.empty()) {
+            for (uint32_t divisor : { 1000u, 100u, 10u, 2u }) {
+                _docFreqs.push_back(std::max(_numDocs / divisor, 1u));
+            }
+        }
+        IteratorBenchmark iteratorbm;
+        iteratorbm.run(_rnd, _wordSet, _numDocs, _docFreqs, _postingTypes, _loops);
+    }
     return 0;
 }
 
@@ -54,6 +54,9 @@ struct MyDotProduct : DotProduct { MyDotProduct() : DotProduct("view", 0, Weight
 struct MyWandTerm : WandTerm { MyWandTerm() : WandTerm("view", 0, Weight(42), 57, 67, 77.7) {} };
 struct MyPredicateQuery : InitTerm<PredicateQuery> {};
 struct MyRegExpTerm : InitTerm<RegExpTerm>  {};
+struct MyNearestNeighborTerm : NearestNeighborTerm {
+    MyNearestNeighborTerm() : NearestNeighborTerm("query_tensor", "view", 0, Weight(42), 10) {}
+};
 
 struct MyQueryNodeTypes {
     typedef MyAnd And;
@@ -78,6 +81,7 @@ struct MyQueryNodeTypes {
     typedef MyWandTerm WandTerm;
     typedef MyPredicateQuery PredicateQuery;
     typedef MyRegExpTerm RegExpTerm;
+    typedef MyNearestNeighborTerm NearestNeighborTerm;
 };
 
 class MyCustomVisitor : public CustomTypeVisitor<MyQueryNodeTypes>
@@ -113,6 +117,7 @@ public:
     void visit(MyWandTerm &) override { setVisited<MyWandTerm>(); }
     void visit(MyPredicateQuery &) override { setVisited<MyPredicateQuery>(); }
     void visit(MyRegExpTerm &) override { setVisited<MyRegExpTerm>(); }
+    void visit(MyNearestNeighborTerm &) override { setVisited<MyNearestNeighborTerm>(); }
 };
 
 template <class T>
@@ -152,6 +157,7 @@ Test::Main()
     TEST_CALL(requireThatNodeIsVisited<MyWandTerm>);
     TEST_CALL(requireThatNodeIsVisited<MyPredicateQuery>);
     TEST_CALL(requireThatNodeIsVisited<MyRegExpTerm>);
+    TEST_CALL(requireThatNodeIsVisited<MyNearestNeighborTerm>);
 
     TEST_DONE();
 }
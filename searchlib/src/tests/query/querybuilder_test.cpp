@@ -48,7 +48,7 @@ PredicateQueryTerm::UP getPredicateQueryTerm() {
 template <class NodeTypes>
 Node::UP createQueryTree() {
     QueryBuilder<NodeTypes> builder;
-    builder.addAnd(10);
+    builder.addAnd(11);
     {
         builder.addRank(2);
         {
@@ -111,6 +111,7 @@ Node::UP createQueryTree() {
             builder.addStringTerm(str[5], view[5], id[5], weight[6]);
             builder.addStringTerm(str[6], view[6], id[6], weight[7]);
         }
+        builder.add_nearest_neighbor_term("query_tensor", "doc_tensor", id[3], weight[5], 7);
     }
     Node::UP node = builder.build();
     ASSERT_TRUE(node.get());
@@ -164,11 +165,12 @@ void checkQueryTreeTypes(Node *node) {
     typedef typename NodeTypes::WeakAnd WeakAnd;
     typedef typename NodeTypes::PredicateQuery PredicateQuery;
     typedef typename NodeTypes::RegExpTerm RegExpTerm;
+    typedef typename NodeTypes::NearestNeighborTerm NearestNeighborTerm;
 
     ASSERT_TRUE(node);
     And *and_node = dynamic_cast<And *>(node);
     ASSERT_TRUE(and_node);
-    EXPECT_EQUAL(10u, and_node->getChildren().size());
+    EXPECT_EQUAL(11u, and_node->getChildren().size());
 
 
     Rank *rank = dynamic_cast<Rank *>(and_node->getChildren()[0]);
@@ -286,6 +288,13 @@ void checkQueryTreeTypes(Node *node) {
     string_term = dynamic_cast<StringTerm *>(same->getChildren()[2]);
     EXPECT_TRUE(checkTerm(string_term, str[6], view[6], id[6], weight[7]));
 
+    auto* nearest_neighbor = dynamic_cast<NearestNeighborTerm *>(and_node->getChildren()[10]);
+    ASSERT_TRUE(nearest_neighbor != nullptr);
+    EXPECT_EQUAL("query_tensor", nearest_neighbor->get_query_tensor_name());
+    EXPECT_EQUAL("doc_tensor", nearest_neighbor->getView());
+    EXPECT_EQUAL(id[3], nearest_neighbor->getId());
+    EXPECT_EQUAL(weight[5].percent(), nearest_neighbor->getWeight().percent());
+    EXPECT_EQUAL(7u, nearest_neighbor->get_target_num_hits());
 }
 
 struct AbstractTypes {
@@ -310,6 +319,7 @@ struct AbstractTypes {
     typedef search::query::WeakAnd WeakAnd;
     typedef search::query::PredicateQuery PredicateQuery;
     typedef search::query::RegExpTerm RegExpTerm;
+    typedef search::query::NearestNeighborTerm NearestNeighborTerm;
 };
 
 // Builds a tree with simplequery and checks that the results have the
@@ -395,6 +405,12 @@ struct MyRegExpTerm : RegExpTerm {
         : RegExpTerm(t, f, i, w) {
     }
 };
+struct MyNearestNeighborTerm : NearestNeighborTerm {
+    MyNearestNeighborTerm(vespalib::stringref query_tensor_name, vespalib::stringref field_name,
+                          int32_t i, Weight w, uint32_t target_num_hits)
+        : NearestNeighborTerm(query_tensor_name, field_name, i, w, target_num_hits) {
+    }
+};
 
 struct MyQueryNodeTypes {
     typedef MyAnd And;
@@ -419,6 +435,7 @@ struct MyQueryNodeTypes {
     typedef MyWandTerm WandTerm;
     typedef MyPredicateQuery PredicateQuery;
     typedef MyRegExpTerm RegExpTerm;
+    typedef MyNearestNeighborTerm NearestNeighborTerm;
 };
 
 TEST("require that Custom Query Trees Can Be Built") {
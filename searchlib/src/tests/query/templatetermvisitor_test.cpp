@@ -71,6 +71,7 @@ void Test::requireThatAllTermsCanBeVisited() {
     EXPECT_TRUE(checkVisit<SimplePredicateQuery>());
     EXPECT_TRUE(checkVisit<SimpleRegExpTerm>());
     EXPECT_TRUE(checkVisit(new SimplePhrase("field", 0, Weight(0))));
+    EXPECT_TRUE(checkVisit(new SimpleNearestNeighborTerm("query_tensor", "doc_tensor", 0, Weight(0), 10)));
     EXPECT_TRUE(!checkVisit(new SimpleAnd));
     EXPECT_TRUE(!checkVisit(new SimpleAndNot));
     EXPECT_TRUE(!checkVisit(new SimpleEquiv(17, Weight(100))));
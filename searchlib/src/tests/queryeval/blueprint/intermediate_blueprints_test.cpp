@@ -19,6 +19,7 @@ LOG_SETUP("blueprint_test");
 #include <vespa/searchlib/queryeval/ranksearch.h>
 #include <vespa/searchlib/queryeval/wand/weak_and_search.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
+#include <vespa/searchlib/queryeval/hit_estimate_sampler.h>
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/searchlib/test/diskindex/testdiskindex.h>
 #include <vespa/searchlib/query/tree/simplequery.h>
@@ -1335,4 +1336,82 @@ TEST("require that ANDNOT without children is optimized to empty search") {
     EXPECT_EQUAL(expect_up->asString(), top_up->asString());
 }
 
+FakeResult make_hits(uint32_t begin, uint32_t end) {
+    FakeResult result;
+    for (uint32_t docid = begin; docid < end; ++docid) {
+        result.doc(docid);
+    }
+    return result;
+}
+
+TEST("require that sampled estimates reorder AND children") {
+    FieldSpec field("foo", 1, 1);
+    FakeBlueprint *leaf = new FakeBlueprint(field, make_hits(1, 151));
+    OrBlueprint *overlap = new OrBlueprint();
+    overlap->addChild(ap(new FakeBlueprint(field, make_hits(1, 101))));
+    overlap->addChild(ap(new FakeBlueprint(field, make_hits(1, 101))));
+    AndBlueprint *top = new AndBlueprint();
+    Blueprint::UP top_up(top);
+    top->addChild(ap(overlap));
+    top->addChild(ap(leaf));
+    top_up->setDocIdLimit(1001);
+    HitEstimateSampler::prepare(*top_up);
+    top_up->fetchPostings(true);
+    EXPECT_EQUAL(&top->getChild(0), leaf);
+    EXPECT_EQUAL(200u, overlap->getState().estimate().estHits);
+    MatchData::UP md = MatchData::makeTestInstance(100, 10);
+    EXPECT_EQUAL(0u, HitEstimateSampler(*md, 1001, 100).sample(*top_up));
+    EXPECT_EQUAL(&top->getChild(0), leaf);
+    EXPECT_EQUAL(2u, HitEstimateSampler(*md, 1001, 2000).sample(*top_up));
+    EXPECT_EQUAL(&top->getChild(0), overlap);
+    EXPECT_EQUAL(100u, overlap->getState().estimate().estHits);
+    EXPECT_EQUAL(150u, leaf->getState().estimate().estHits);
+    EXPECT_EQUAL(100u, top->getState().estimate().estHits);
+}
+
+struct StrictFetchRecorder : FakeBlueprint {
+    bool fetched_strict;
+    StrictFetchRecorder(const FieldSpec &field, const FakeResult &result)
+        : FakeBlueprint(field, result), fetched_strict(false) {}
+    void fetchPostings(bool strict) override {
+        fetched_strict = strict;
+        FakeBlueprint::fetchPostings(strict);
+    }
+};
+
+TEST("require that AND children fetch strict postings when prepared for sampling") {
+    FieldSpec field("foo", 1, 1);
+    auto *inner_first = new StrictFetchRecorder(field, make_hits(1, 11));
+    auto *inner_second = new StrictFetchRecorder(field, make_hits(1, 101));
+    auto *second = new StrictFetchRecorder(field, make_hits(1, 51));
+    AndBlueprint *inner = new AndBlueprint();
+    inner->addChild(ap(inner_first));
+    inner->addChild(ap(inner_second));
+    AndBlueprint *top = new AndBlueprint();
+    Blueprint::UP top_up(top);
+    top->addChild(ap(inner));
+    top->addChild(ap(second));
+    top_up->setDocIdLimit(1001);
+    EXPECT_EQUAL(&top->getChild(0), inner);
+    HitEstimateSampler::prepare(*top_up);
+    top_up->fetchPostings(true);
+    EXPECT_TRUE(inner_first->fetched_strict);
+    EXPECT_TRUE(inner_second->fetched_strict);
+    EXPECT_TRUE(second->fetched_strict);
+}
+
+TEST("require that only the first AND child fetches strict postings by default") {
+    FieldSpec field("foo", 1, 1);
+    auto *first = new StrictFetchRecorder(field, make_hits(1, 11));
+    auto *second = new StrictFetchRecorder(field, make_hits(1, 101));
+    AndBlueprint *top = new AndBlueprint();
+    Blueprint::UP top_up(top);
+    top->addChild(ap(first));
+    top->addChild(ap(second));
+    top_up->setDocIdLimit(1001);
+    top_up->fetchPostings(true);
+    EXPECT_TRUE(first->fetched_strict);
+    EXPECT_FALSE(second->fetched_strict);
+}
+
 TEST_MAIN() { TEST_DEBUG("lhs.out", "rhs.out"); TEST_RUN_ALL(); }
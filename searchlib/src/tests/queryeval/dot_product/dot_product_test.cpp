@@ -10,6 +10,7 @@
 #include <vespa/searchlib/queryeval/fake_result.h>
 #include <vespa/searchlib/queryeval/fake_searchable.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
+#include <vespa/searchlib/queryeval/wand/weak_and_heap.h>
 #include <vespa/searchlib/test/weightedchildrenverifiers.h>
 
 using namespace search;
@@ -221,6 +222,100 @@ private:
     }
 };
 
+using MatchParams = ParallelWeakAndSearch::MatchParams;
+
+struct DummyHeap : public WeakAndHeap {
+    DummyHeap() : WeakAndHeap(9001) {}
+    void adjust(score_t *, score_t *) override {}
+};
+
+class MaxScoreIteratorChildrenVerifier : public search::test::DwaIteratorChildrenVerifier {
+private:
+    SearchIterator::UP create(bool strict) const override {
+        MatchParams match_params(_dummy_heap, _dummy_heap.getMinScore(), 1.0, 1);
+        std::vector<IDocumentWeightAttribute::LookupResult> dict_entries;
+        for (size_t i = 0; i < _num_children; ++i) {
+            dict_entries.push_back(_helper.dwa().lookup(vespalib::make_string("%zu", i).c_str()));
+        }
+        return DotProductSearch::create(_tfmd, match_params, _weights, dict_entries, _helper.dwa(), strict);
+    }
+    mutable DummyHeap _dummy_heap;
+};
+
+struct MaxScoreFixture {
+    static constexpr uint32_t num_docs = 1000;
+    static constexpr uint32_t num_terms = 300;
+    DocumentWeightAttributeHelper helper;
+    std::vector<int32_t> weights;
+    std::vector<IDocumentWeightAttribute::LookupResult> dict_entries;
+    std::map<uint32_t, int64_t> expected; // full dot product of all matching documents
+    MaxScoreFixture() : helper(), weights(), dict_entries(), expected() {
+        helper.add_docs(num_docs);
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            for (uint32_t term = 0; term < num_terms; term += 1 + (docid % 7)) {
+                if (((docid + term) % 5) == 0) {
+                    helper.add_to_doc(docid, term, 1 + ((docid * 31 + term * 17) % 100));
+                }
+            }
+        }
+        for (uint32_t term = 0; term < num_terms; ++term) {
+            weights.push_back(1 + (term % 13) * (term % 13));
+            dict_entries.push_back(helper.dwa().lookup(vespalib::make_string("%u", term).c_str()));
+        }
+        TermFieldMatchData tfmd;
+        std::vector<DocumentWeightIterator> iterators;
+        for (const auto &entry : dict_entries) {
+            helper.dwa().create(entry.posting_idx, iterators);
+        }
+        SearchIterator::UP search = DotProductSearch::create(tfmd, weights, std::move(iterators));
+        search->initFullRange();
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            if (search->seek(docid)) {
+                search->unpack(docid);
+                expected[docid] = tfmd.getRawScore();
+            }
+        }
+    }
+    void verify(bool strict) {
+        SharedWeakAndPriorityQueue heap(10);
+        TermFieldMatchData tfmd;
+        SearchIterator::UP search = DotProductSearch::create(tfmd, MatchParams(heap, 0, 1.0, 1), weights,
+                                                             dict_entries, helper.dwa(), strict);
+        search->initFullRange();
+        std::map<uint32_t, int64_t> hits;
+        for (uint32_t docid = 1; docid < num_docs; ++docid) {
+            if (search->seek(docid)) {
+                search->unpack(docid);
+                hits[docid] = tfmd.getRawScore();
+            }
+        }
+        EXPECT_GREATER(heap.getMinScore(), 0);
+        EXPECT_LESS(hits.size(), expected.size());
+        size_t above_threshold = 0;
+        for (const auto &entry : expected) {
+            if (entry.second > heap.getMinScore()) {
+                ++above_threshold;
+                EXPECT_TRUE(hits.find(entry.first) != hits.end());
+            }
+        }
+        EXPECT_GREATER_EQUAL(above_threshold, 1u);
+        for (const auto &hit : hits) {
+            ASSERT_TRUE(expected.find(hit.first) != expected.end());
+            EXPECT_EQUAL(expected[hit.first], hit.second);
+        }
+    }
+};
+
+TEST_F("require that max score pruning returns full scores and all hits above the final threshold", MaxScoreFixture) {
+    TEST_DO(f1.verify(true));
+    TEST_DO(f1.verify(false));
+}
+
+TEST("verify search iterator conformance with max score pruning") {
+    MaxScoreIteratorChildrenVerifier verifier;
+    verifier.verify();
+}
+
 TEST("verify search iterator conformance with search iterator children") {
     IteratorChildrenVerifier verifier;
     verifier.verify();
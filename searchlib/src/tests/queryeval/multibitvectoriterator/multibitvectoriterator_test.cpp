@@ -11,6 +11,7 @@ LOG_SETUP("multibitvectoriterator_test");
 #include <vespa/searchlib/queryeval/orsearch.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+#include <vespa/vespalib/util/thread_arena.h>
 
 using namespace search::queryeval;
 using namespace search::fef;
@@ -27,6 +28,8 @@ public:
     void testOr();
     void testAndWith();
     void testEndGuard();
+    void testSparseStrictSeekAcrossChunks();
+    void testAlignmentInThreadArena();
     template<typename T>
     void testThatOptimizePreservesUnpack();
     template <typename T>
@@ -503,6 +506,66 @@ Test::testEndGuard()
     EXPECT_FALSE(m.seek(_bvs[0]->size()+987));
 }
 
+void
+Test::testSparseStrictSeekAcrossChunks()
+{
+    TermFieldMatchData tfmd;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&tfmd);
+    const H expected = {5, 511, 512, 4097, 9999};
+    std::vector<BitVector::UP> bvs;
+    for (size_t i(0); i < 2; i++) {
+        bvs.push_back(BitVector::create(10000));
+        for (uint32_t docId : expected) {
+            bvs.back()->setBit(docId);
+        }
+    }
+    bvs[0]->setBit(700);
+    bvs[1]->setBit(8000);
+    bvs[0]->invalidateCachedCount();
+    bvs[1]->invalidateCachedCount();
+
+    MultiSearch::Children children;
+    children.push_back(BitVectorIterator::create(bvs[0].get(), tfmda, true).release());
+    children.push_back(BitVectorIterator::create(bvs[1].get(), tfmda, true).release());
+    SearchIterator::UP s(AndSearch::create(children, true));
+    s = MultiBitVectorIteratorBase::optimize(std::move(s));
+    EXPECT_TRUE(dynamic_cast<const MultiBitVectorIteratorBase *>(s.get()) != NULL);
+    H hits = seek(*s, bvs[0]->size());
+    EXPECT_EQUAL(expected.size(), hits.size());
+    for (size_t i(0); i < std::min(hits.size(), expected.size()); i++) {
+        EXPECT_EQUAL(expected[i], hits[i]);
+    }
+    s->initFullRange();
+    EXPECT_FALSE(s->seek(1));
+    EXPECT_EQUAL(5u, s->getDocId());
+    EXPECT_FALSE(s->seek(513));
+    EXPECT_EQUAL(4097u, s->getDocId());
+    EXPECT_TRUE(s->seek(9999));
+    EXPECT_FALSE(s->seek(10000));
+    EXPECT_TRUE(s->isAtEnd());
+}
+
+void
+Test::testAlignmentInThreadArena()
+{
+    TermFieldMatchData tfmd;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&tfmd);
+    vespalib::ThreadArena::Scope scope;
+    for (size_t i(0); i < 3; i++) {
+        MultiSearch::Children children;
+        children.push_back(BitVectorIterator::create(_bvs[0].get(), tfmda, true).release());
+        children.push_back(BitVectorIterator::create(_bvs[1].get(), tfmda, true).release());
+        SearchIterator::UP s(AndSearch::create(children, true));
+        s = MultiBitVectorIteratorBase::optimize(std::move(s));
+        EXPECT_TRUE(dynamic_cast<const MultiBitVectorIteratorBase *>(s.get()) != NULL);
+        EXPECT_EQUAL(0u, reinterpret_cast<uintptr_t>(s.get()) % 64);
+        H hits = seek(*s, _bvs[0]->size());
+        EXPECT_TRUE(!hits.empty());
+    }
+}
+
 int
 Test::Main()
 {
@@ -514,6 +577,10 @@ Test::Main()
     TEST_FLUSH();
     testEndGuard();
     TEST_FLUSH();
+    testSparseStrictSeekAcrossChunks();
+    TEST_FLUSH();
+    testAlignmentInThreadArena();
+    TEST_FLUSH();
     testAndNot();
     TEST_FLUSH();
     testAnd();
@@ -407,6 +407,105 @@ TEST_F("require that dot product score is calculated", SearchFixture)
 }
 
 
+/**
+ * Search iterator over (docid, weight) pairs exposing block max
+ * weights for blocks of fixed size.
+ */
+struct BlockMaxSearch : public SearchIterator, public BlockMaxWeightInfo
+{
+    typedef std::vector<std::pair<uint32_t, int32_t> > Docs;
+    Docs                docs;
+    uint32_t            blockSize;
+    bool                enabled;
+    TermFieldMatchData &tfmd;
+    MinMaxPostingInfo   info;
+    size_t              pos;
+    uint32_t           &unpackCount;
+
+    BlockMaxSearch(const Docs &docs_in, uint32_t blockSize_in, bool enabled_in,
+                   TermFieldMatchData &tfmd_in, int32_t maxWeight, uint32_t &unpackCount_in)
+        : docs(docs_in), blockSize(blockSize_in), enabled(enabled_in), tfmd(tfmd_in),
+          info(1, maxWeight), pos(0), unpackCount(unpackCount_in)
+    {}
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        pos = 0;
+    }
+    void doSeek(uint32_t docid) override {
+        while (pos < docs.size() && docs[pos].first < docid) {
+            ++pos;
+        }
+        if (pos < docs.size()) {
+            setDocId(docs[pos].first);
+        } else {
+            setAtEnd();
+        }
+    }
+    void doUnpack(uint32_t docid) override {
+        ++unpackCount;
+        tfmd.reset(docid);
+        tfmd.appendPosition(search::fef::TermFieldMatchDataPosition(0, 0, docs[pos].second, 1));
+    }
+    const PostingInfo *getPostingInfo() const override { return &info; }
+    bool hasBlockMaxWeights() const override { return enabled; }
+    uint32_t getBlockMaxWeight(uint32_t docId, int32_t &maxWeight) override {
+        for (size_t begin = 0; begin < docs.size(); begin += blockSize) {
+            size_t end = std::min(begin + blockSize, docs.size());
+            if (docs[end - 1].first >= docId) {
+                maxWeight = docs[begin].second;
+                for (size_t i = begin; i < end; ++i) {
+                    maxWeight = std::max(maxWeight, docs[i].second);
+                }
+                return docs[end - 1].first;
+            }
+        }
+        maxWeight = std::numeric_limits<int32_t>::max();
+        return docId;
+    }
+};
+
+struct BlockMaxFixture
+{
+    SharedWeakAndPriorityQueue heap;
+    TermFieldMatchData         rootMatchData;
+    MatchParams                matchParams;
+    uint32_t                   unpackCount;
+    FakeResult                 result;
+
+    BlockMaxFixture(bool enabled)
+        : heap(1), rootMatchData(), matchParams(heap, 0, 1.0, 1), unpackCount(0), result()
+    {
+        MatchDataLayout layout;
+        TermFieldHandle handleA = layout.allocTermField(0);
+        TermFieldHandle handleB = layout.allocTermField(0);
+        MatchData::UP childrenMatchData = layout.createMatchData();
+        TermFieldMatchData *tfmdA = childrenMatchData->resolveTermField(handleA);
+        TermFieldMatchData *tfmdB = childrenMatchData->resolveTermField(handleB);
+        BlockMaxSearch::Docs docsA({{1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 1}, {6, 1}, {7, 100}, {8, 100}});
+        BlockMaxSearch::Docs docsB({{1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 1}, {6, 1}, {7, 1}, {8, 1}});
+        wand::Terms terms;
+        terms.push_back(wand::Term(new BlockMaxSearch(docsA, 2, enabled, *tfmdA, 100, unpackCount), 1, docsA.size(), tfmdA));
+        terms.push_back(wand::Term(new BlockMaxSearch(docsB, 2, enabled, *tfmdB, 1, unpackCount), 1, docsB.size(), tfmdB));
+        SearchIterator::UP search(ParallelWeakAndSearch::create(terms, matchParams,
+                                                                RankParams(rootMatchData, std::move(childrenMatchData)),
+                                                                true));
+        result = doSearch(*search, rootMatchData);
+    }
+};
+
+TEST("require that block max weights skip blocks that cannot beat the threshold")
+{
+    BlockMaxFixture plain(false);
+    BlockMaxFixture blockMax(true);
+    FakeResult expect = FakeResult()
+                        .doc(1).score(2)
+                        .doc(7).score(101);
+    EXPECT_EQUAL(expect, plain.result);
+    EXPECT_EQUAL(expect, blockMax.result);
+    EXPECT_LESS(blockMax.unpackCount, plain.unpackCount);
+}
+
+
 struct BlueprintFixtureBase
 {
     WandBlueprintSpec spec;
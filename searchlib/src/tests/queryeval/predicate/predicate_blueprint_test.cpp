@@ -235,6 +235,30 @@ TEST_F("require that blueprint can set up search with subqueries", Fixture) {
     EXPECT_FALSE(it->seek(doc_id));
 }
 
+TEST_F("require that range terms sharing labels are merged across subqueries", Fixture) {
+    PredicateTreeAnnotations annotations(1);
+    annotations.interval_map[PredicateHash::hash64("range_key=40-47")] =
+        std::vector<Interval>{{0x00010001}};
+    f.indexDocument(doc_id, annotations, 0x1);
+
+    SimplePredicateQuery query(PredicateQueryTerm::UP(new PredicateQueryTerm),
+                               "view", 0, Weight(1));
+    query.getTerm()->addRangeFeature("range_key", 42, 1);
+    query.getTerm()->addRangeFeature("range_key", 45, 2);
+
+    PredicateBlueprint blueprint(f.field, f.guard(), query);
+    blueprint.fetchPostings(true);
+    fef::TermFieldMatchData data;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&data);
+    SearchIterator::UP it = blueprint.createLeafSearch(tfmda, true);
+    ASSERT_TRUE(it.get());
+    it->initFullRange();
+    EXPECT_TRUE(it->seek(doc_id));
+    it->unpack(doc_id);
+    EXPECT_EQUAL(0x3u, data.getSubqueries());
+}
+
 }  // namespace
 
 TEST_MAIN() { TEST_RUN_ALL(); }
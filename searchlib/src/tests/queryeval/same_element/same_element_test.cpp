@@ -34,9 +34,9 @@ Blueprint::UP finalize(Blueprint::UP bp, bool strict) {
     return result;
 }
 
-SimpleResult find_matches(const std::vector<FakeResult> &children) {
+SimpleResult find_matches(const std::vector<FakeResult> &children, bool fake_attr = false) {
     auto md = MatchData::makeTestInstance(0, 0);
-    auto bp = finalize(make_blueprint(children), false);
+    auto bp = finalize(make_blueprint(children, fake_attr), false);
     auto search = bp->createSearch(*md, false);
     return SimpleResult().search(*search, 1000);
 }
@@ -69,6 +69,15 @@ TEST("require that children must match within same element") {
     EXPECT_EQUAL(result, expect);
 }
 
+TEST("require that attribute children match on element id without unpacking") {
+    auto a = make_result({{5, {1,3,7}}, {6, {1,4}}});
+    auto b = make_result({{5, {2,7,10}}, {6, {2,3}}});
+    auto c = make_result({{5, {0,7}}, {6, {4}}});
+    EXPECT_EQUAL(find_matches({a, b, c}, true), SimpleResult({5}));
+    EXPECT_EQUAL(find_matches({a, b}, true), SimpleResult({5}));
+    EXPECT_EQUAL(find_matches({a, c}, true), SimpleResult({5, 6}));
+}
+
 TEST("require that strict iterator seeks to next hit") {
     auto md = MatchData::makeTestInstance(0, 0);
     auto a = make_result({{5, {1,2}}, {7, {1,2}}, {8, {1,2}}, {9, {1,2}}});
@@ -50,6 +50,7 @@ class Test : public vespalib::TestApp {
     void requireThatStrictIteratorFindsNextMatch(bool useBlueprint);
     void requireThatPhrasesAreUnpacked(bool useBlueprint);
     void requireThatTermsCanBeEvaluatedInPriorityOrder();
+    void requireThatPhraseMustBeWithinOneElement();
     void requireThatBlueprintExposesFieldWithEstimate();
     void requireThatBlueprintForcesPositionDataOnChildren();
     void requireThatIteratorHonorsFutureDoom();
@@ -70,6 +71,7 @@ Test::Main()
     TEST_DO(requireThatStrictIteratorFindsNextMatch(false));
     TEST_DO(requireThatPhrasesAreUnpacked(false));
     TEST_DO(requireThatTermsCanBeEvaluatedInPriorityOrder());
+    TEST_DO(requireThatPhraseMustBeWithinOneElement());
 
     TEST_DO(requireThatIteratorFindsSimplePhrase(true));
     TEST_DO(requireThatIteratorFindsLongPhrase(true));
@@ -303,6 +305,29 @@ void Test::requireThatTermsCanBeEvaluatedInPriorityOrder() {
     EXPECT_TRUE(!search->seek(doc_no_match));
 }
 
+void Test::requireThatPhraseMustBeWithinOneElement() {
+    PhraseSearchTest test;
+    test.addTerm("foo", FakeResult()
+                 .doc(doc_match).elem(0).pos(5).elem(1).pos(2).elem(2).pos(0)
+                 .doc(doc_no_match).elem(0).pos(7));
+    test.addTerm("bar", FakeResult()
+                 .doc(doc_match).elem(0).pos(9).elem(1).pos(3).elem(2).pos(1)
+                 .doc(doc_no_match).elem(1).pos(8));
+    test.addTerm("baz", FakeResult()
+                 .doc(doc_match).elem(1).pos(4).elem(2).pos(7)
+                 .doc(doc_no_match).elem(1).pos(9));
+    test.setOrder({2, 1, 0});
+
+    test.fetchPostings(false);
+    unique_ptr<SearchIterator> search(test.createSearch(false));
+    EXPECT_TRUE(search->seek(doc_match));
+    search->unpack(doc_match);
+    ASSERT_EQUAL(1, std::distance(test.tmd().begin(), test.tmd().end()));
+    EXPECT_EQUAL(1u, test.tmd().begin()->getElementId());
+    EXPECT_EQUAL(2u, test.tmd().begin()->getPosition());
+    EXPECT_TRUE(!search->seek(doc_no_match));
+}
+
 void
 Test::requireThatBlueprintExposesFieldWithEstimate()
 {
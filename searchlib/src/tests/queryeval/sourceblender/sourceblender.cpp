@@ -139,6 +139,45 @@ TEST("test full sourceblender search") {
     EXPECT_EQUAL(expect_unpacked_c, uc->getUnpacked());
 }
 
+TEST("test sourceblender search over long single source runs") {
+    SimpleResult a;
+    SimpleResult b;
+
+    a.addHit(10).addHit(300).addHit(600).addHit(700).addHit(900);
+    b.addHit(5).addHit(310).addHit(600).addHit(701).addHit(800).addHit(1000);
+
+    // docs [512, 1024) are from source 2, except for 700
+    auto sel = make_unique<MySelector>(1);
+    for (uint32_t docId = 0; docId < 1024; ++docId) {
+        sel->setSource(docId, ((docId >= 512) && (docId != 700)) ? 2 : 1);
+    }
+
+    SimpleResult expect_result;
+    expect_result.addHit(10).addHit(300).addHit(600).addHit(700).addHit(701).addHit(800).addHit(1000);
+    SimpleResult expect_unpacked_a;
+    expect_unpacked_a.addHit(10).addHit(300).addHit(700);
+    SimpleResult expect_unpacked_b;
+    expect_unpacked_b.addHit(600).addHit(701).addHit(800).addHit(1000);
+
+    for (bool strict : {true, false}) {
+        UnpackChecker *ua = new UnpackChecker(new SimpleSearch(a));
+        UnpackChecker *ub = new UnpackChecker(new SimpleSearch(b));
+        SourceBlenderSearch::Children ab;
+        ab.push_back(SourceBlenderSearch::Child(ua, 1));
+        ab.push_back(SourceBlenderSearch::Child(ub, 2));
+        SearchIterator::UP blend(SourceBlenderSearch::create(sel->createIterator(), ab, strict));
+        SimpleResult result;
+        if (strict) {
+            result.search(*blend);
+        } else {
+            result.search(*blend, sel->getDocIdLimit());
+        }
+        EXPECT_EQUAL(expect_result, result);
+        EXPECT_EQUAL(expect_unpacked_a, ua->getUnpacked());
+        EXPECT_EQUAL(expect_unpacked_b, ub->getUnpacked());
+    }
+}
+
 using search::test::SearchIteratorVerifier;
 
 class Verifier : public SearchIteratorVerifier {
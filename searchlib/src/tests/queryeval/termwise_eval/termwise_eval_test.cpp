@@ -260,6 +260,59 @@ TEST("require that termwise filter search produces appropriate results") {
     }
 }
 
+TEST("require that windowed termwise search produces appropriate results") {
+    for (uint32_t window: {1, 2, 3, 4, 100}) {
+        for (uint32_t begin: {1, 2, 5}) {
+            for (uint32_t end: {6, 7, 10}) {
+                for (bool strict_search: {true, false}) {
+                    for (bool strict_wrapper: {true, false}) {
+                        TEST_STATE(make_string("window: %u, begin: %u, end: %u, strict_search: %s, strict_wrapper: %s",
+                                        window, begin, end, strict_search ? "true" : "false",
+                                        strict_wrapper ? "true" : "false").c_str());
+                        auto search = make_termwise(make_search(strict_search), strict_wrapper, window);
+                        TEST_DO(verify(make_expect(begin, end), *search, begin, end));
+                        auto filter = make_termwise(make_filter_search(strict_search), strict_wrapper, window);
+                        TEST_DO(verify(make_expect(begin, end), *filter, begin, end));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST("require that windowed termwise search skips windows without hits when strict") {
+    auto search = make_termwise(UP(OR({TERM({3}, true), TERM({9}, true)}, true)), true, 2);
+    search->initRange(1, 12);
+    EXPECT_FALSE(search->seek(1));
+    EXPECT_EQUAL(3u, search->getDocId());
+    EXPECT_FALSE(search->seek(4));
+    EXPECT_EQUAL(9u, search->getDocId());
+    EXPECT_FALSE(search->seek(10));
+    EXPECT_TRUE(search->isAtEnd());
+}
+
+TEST("require that windowed termwise search does not report window bounds as hits") {
+    auto search = make_termwise(UP(OR({TERM({7}, true), TERM({9}, true)}, true)), true, 2);
+    search->initRange(1, 12);
+    EXPECT_EQUAL(7u, search->getDocId());
+    EXPECT_FALSE(search->seek(2));
+    EXPECT_TRUE(search->seek(7));
+    search->initRange(10, 12);
+    EXPECT_TRUE(search->isAtEnd());
+    auto non_strict = make_termwise(UP(OR({TERM({7}, false), TERM({9}, false)}, false)), false, 2);
+    non_strict->initRange(1, 12);
+    EXPECT_EQUAL(0u, non_strict->getDocId());
+    EXPECT_FALSE(non_strict->seek(2));
+    EXPECT_TRUE(non_strict->seek(9));
+}
+
+TEST("require that windowed termwise wrapper is rewindable") {
+    auto search = make_termwise(make_search(true), true, 2);
+    TEST_DO(verify(make_expect(3, 7), *search, 3, 7));
+    TEST_DO(verify(make_expect(1, 5), *search, 1, 5));
+    TEST_DO(verify(make_expect(1, 5), *search, 1, 5));
+}
+
 TEST("require that termwise ANDNOT with single term works") {
     TEST_DO(verify({2,3,4}, *make_termwise(UP(ANDNOT({TERM({1,2,3,4,5}, true)}, true)), true), 2, 5));
 }
@@ -357,6 +410,13 @@ TEST("require that match data keeps track of the termwise limit") {
     EXPECT_EQUAL(0.03, md->get_termwise_limit());
 }
 
+TEST("require that match data keeps track of the termwise OR limit") {
+    auto md = make_match_data();
+    EXPECT_EQUAL(0u, md->get_termwise_or_limit());
+    md->set_termwise_or_limit(64);
+    EXPECT_EQUAL(64u, md->get_termwise_or_limit());
+}
+
 //-----------------------------------------------------------------------------
 
 TEST("require that terwise test search string dump is detailed enough") {
@@ -419,6 +479,26 @@ TEST("require that enough unranked termwise terms are present for termwise evalu
     }
 }
 
+TEST("require that OR with enough unranked termwise children is termwise regardless of hit rate") {
+    auto md = make_match_data();
+    md->set_termwise_limit(1.0);
+    md->set_termwise_or_limit(2);
+    md->resolveTermField(1)->tagAsNotNeeded();
+    md->resolveTermField(2)->tagAsNotNeeded();
+    OrBlueprint my_or;
+    my_or.addChild(UP(new MyBlueprint({1}, true, 1)));
+    my_or.addChild(UP(new MyBlueprint({2}, true, 2)));
+    my_or.addChild(UP(new MyBlueprint({3}, true, 3)));
+    for (bool strict: {true, false}) {
+        EXPECT_EQUAL(my_or.createSearch(*md, strict)->asString(),
+                     UP(ORs({make_termwise(UP(OR({TERM({1}, strict), TERM({2}, strict)}, strict)), strict).release(), TERM({3}, strict)}, strict))->asString());
+    }
+    md->set_termwise_or_limit(3);
+    for (bool strict: {true, false}) {
+        EXPECT_TRUE(my_or.createSearch(*md, strict)->asString().find("TermwiseSearch") == vespalib::string::npos);
+    }
+}
+
 TEST("require that termwise evaluation can be multi-level, but not duplicated") {
     auto md = make_match_data();
     md->set_termwise_limit(0.0);
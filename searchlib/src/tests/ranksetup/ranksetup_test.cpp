@@ -490,6 +490,7 @@ void RankSetupTest::testRankSetup()
     using namespace search::fef::indexproperties;
     IndexEnvironment env;
     env.getProperties().add(rank::FirstPhase::NAME, "firstphase");
+    env.getProperties().add(rank::FirstPhaseUpperBound::NAME, "firstphasebound");
     env.getProperties().add(rank::SecondPhase::NAME, "secondphase");
     env.getProperties().add(dump::Feature::NAME, "foo");
     env.getProperties().add(dump::Feature::NAME, "bar");
@@ -514,6 +515,7 @@ void RankSetupTest::testRankSetup()
     RankSetup rs(_factory, env);
     rs.configure();
     EXPECT_EQUAL(rs.getFirstPhaseRank(), vespalib::string("firstphase"));
+    EXPECT_EQUAL(rs.getFirstPhaseUpperBound(), vespalib::string("firstphasebound"));
     EXPECT_EQUAL(rs.getSecondPhaseRank(), vespalib::string("secondphase"));
     ASSERT_TRUE(rs.getDumpFeatures().size() == 2);
     EXPECT_EQUAL(rs.getDumpFeatures()[0], vespalib::string("foo"));
@@ -774,6 +776,7 @@ RankSetupTest::testFeatureNormalization()
     RankSetup rankSetup(factory, idxEnv);
 
     rankSetup.setFirstPhaseRank(" mysum ( value ( 1 ) , value ( 1 ) ) ");
+    rankSetup.setFirstPhaseUpperBound(" mysum ( value ( 1 ) , value ( 2 ) ) ");
     rankSetup.setSecondPhaseRank(" mysum ( value ( 2 ) , value ( 2 ) ) ");
     rankSetup.addSummaryFeature(" mysum ( value ( 5 ) , value ( 5 ) ) ");
     rankSetup.addSummaryFeature(" mysum ( \"value( 5 )\" , \"value( 5 )\" ) ");
@@ -787,13 +790,17 @@ RankSetupTest::testFeatureNormalization()
         QueryEnvironment queryEnv;
         MatchData::UP match_data = layout.createMatchData();
         RankProgram::UP firstPhaseProgram = rankSetup.create_first_phase_program();
+        RankProgram::UP firstPhaseBoundProgram = rankSetup.create_first_phase_bound_program();
         RankProgram::UP secondPhaseProgram = rankSetup.create_second_phase_program();
         RankProgram::UP summaryProgram = rankSetup.create_summary_program();
         firstPhaseProgram->setup(*match_data, queryEnv);
+        ASSERT_TRUE(firstPhaseBoundProgram.get() != nullptr);
+        firstPhaseBoundProgram->setup(*match_data, queryEnv);
         secondPhaseProgram->setup(*match_data, queryEnv);
         summaryProgram->setup(*match_data, queryEnv);
 
         EXPECT_APPROX(2.0, Utils::getScoreFeature(*firstPhaseProgram, 1), 0.001);
+        EXPECT_APPROX(3.0, Utils::getScoreFeature(*firstPhaseBoundProgram, 1), 0.001);
         EXPECT_APPROX(4.0, Utils::getScoreFeature(*secondPhaseProgram, 1), 0.001);
 
         { // rank seed features
@@ -363,6 +363,17 @@ void MultilevelSortTest::testSortMethod(int method)
         srand(time(NULL));
         sortAndCheck(spec, 5000, 8, strValues);
     }
+    {
+        // only fixed width keys, like sorting on (category, price desc, date)
+        std::vector<std::string> none;
+        std::vector<Spec> spec;
+        spec.push_back(Spec("int32", INT32));
+        spec.push_back(Spec("double", DOUBLE, false));
+        spec.push_back(Spec("int64", INT64));
+        spec.push_back(Spec("docid", DOCID));
+        srand(24680);
+        sortAndCheck(spec, 5000, 8, none);
+    }
     {
         std::vector<std::string> none;
         uint32_t num = 50;
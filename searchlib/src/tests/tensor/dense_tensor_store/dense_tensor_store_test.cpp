@@ -50,6 +50,14 @@ struct Fixture
         store.getTensor(ref, actTensor);
         EXPECT_EQUAL(expTensor.toSpec(), actTensor.toSpec());
     }
+    void assertConvertedTensor(const TensorSpec &tensorSpec, const TensorSpec &expSpec) {
+        Tensor::UP tensor = makeTensor(tensorSpec);
+        EntryRef ref = store.setTensor(*tensor);
+        EXPECT_EQUAL(expSpec, store.getTensor(ref)->toSpec());
+        MutableDenseTensorView view(store.type());
+        store.getTensor(ref, view);
+        EXPECT_EQUAL(expSpec, view.toSpec());
+    }
 };
 
 TEST_F("require that we can store 1d bound tensor", Fixture("tensor(x[3])"))
@@ -111,5 +119,43 @@ TEST_F("require that empty 3d tensor has size 1 in un-bound dimensions", Fixture
                                    add({{"x", 0}, {"y", 1}, {"z", 0}}, 0));
 }
 
+TEST_F("require that float cells use 4 bytes each and are converted when read", Fixture("tensor<float>(x[3])"))
+{
+    EXPECT_EQUAL(4u, f.store.getCellSize());
+    f.assertConvertedTensor(TensorSpec("tensor(x[3])").
+                                       add({{"x", 0}}, 2).
+                                       add({{"x", 1}}, 0.1).
+                                       add({{"x", 2}}, -5),
+                            TensorSpec("tensor<float>(x[3])").
+                                       add({{"x", 0}}, 2).
+                                       add({{"x", 1}}, float(0.1)).
+                                       add({{"x", 2}}, -5));
+}
+
+TEST_F("require that float cells can be stored for un-bound dimension", Fixture("tensor<float>(x[3],y[])"))
+{
+    f.assertConvertedTensor(TensorSpec("tensor(x[3],y[1])").
+                                       add({{"x", 0}, {"y", 0}}, 2).
+                                       add({{"x", 1}, {"y", 0}}, 3).
+                                       add({{"x", 2}, {"y", 0}}, 5),
+                            TensorSpec("tensor<float>(x[3],y[1])").
+                                       add({{"x", 0}, {"y", 0}}, 2).
+                                       add({{"x", 1}, {"y", 0}}, 3).
+                                       add({{"x", 2}, {"y", 0}}, 5));
+}
+
+TEST_F("require that int8 cells use 1 byte each and are converted when read", Fixture("tensor<int8>(x[3])"))
+{
+    EXPECT_EQUAL(1u, f.store.getCellSize());
+    f.assertConvertedTensor(TensorSpec("tensor(x[3])").
+                                       add({{"x", 0}}, 2).
+                                       add({{"x", 1}}, -128).
+                                       add({{"x", 2}}, 127),
+                            TensorSpec("tensor<int8>(x[3])").
+                                       add({{"x", 0}}, 2).
+                                       add({{"x", 1}}, -128).
+                                       add({{"x", 2}}, 127));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
 
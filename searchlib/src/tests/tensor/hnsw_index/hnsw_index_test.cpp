@@ -0,0 +1,165 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/log/log.h>
+LOG_SETUP("hnsw_index_test");
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/tensor/hnsw_index.h>
+#include <vespa/vespalib/util/generationhandler.h>
+#include <vector>
+
+using search::attribute::HnswIndexParams;
+using search::tensor::DocVectorAccess;
+using search::tensor::HnswIndex;
+using vespalib::GenerationHandler;
+using vespalib::GenerationHolder;
+
+using Neighbors = std::vector<HnswIndex::Neighbor>;
+
+class MyDocVectorAccess : public DocVectorAccess
+{
+    std::vector<std::vector<double>> _vectors;
+public:
+    MyDocVectorAccess() : _vectors() {}
+    void set(uint32_t docId, std::vector<double> vector) {
+        if (docId >= _vectors.size()) {
+            _vectors.resize(docId + 1);
+        }
+        _vectors[docId] = std::move(vector);
+    }
+    vespalib::ConstArrayRef<double> getVector(uint32_t docId) const override {
+        if (docId >= _vectors.size()) {
+            return vespalib::ConstArrayRef<double>();
+        }
+        return vespalib::ConstArrayRef<double>(_vectors[docId].data(), _vectors[docId].size());
+    }
+};
+
+HnswIndexParams
+makeParams(uint32_t maxLinksPerNode)
+{
+    HnswIndexParams params;
+    params.setEnabled(true);
+    params.setMaxLinksPerNode(maxLinksPerNode);
+    params.setNeighborsToExploreAtInsert(50);
+    return params;
+}
+
+struct Fixture
+{
+    MyDocVectorAccess vectors;
+    GenerationHandler genHandler;
+    GenerationHolder genHolder;
+    HnswIndex index;
+
+    Fixture(uint32_t maxLinksPerNode = 4)
+        : vectors(),
+          genHandler(),
+          genHolder(),
+          index(vectors, makeParams(maxLinksPerNode), genHolder)
+    {}
+    ~Fixture() {
+        commit();
+        genHolder.clearHoldLists();
+    }
+    void add(uint32_t docId, double x, double y) {
+        vectors.set(docId, {x, y});
+        index.addDocument(docId);
+        commit();
+    }
+    void remove(uint32_t docId) {
+        index.removeDocument(docId);
+        vectors.set(docId, {});
+        commit();
+    }
+    void commit() {
+        index.transferHoldLists(genHandler.getCurrentGeneration());
+        genHolder.transferHoldLists(genHandler.getCurrentGeneration());
+        genHandler.incGeneration();
+        genHandler.updateFirstUsedGeneration();
+        index.trimHoldLists(genHandler.getFirstUsedGeneration());
+        genHolder.trimHoldLists(genHandler.getFirstUsedGeneration());
+    }
+    Neighbors findTopK(uint32_t k, double x, double y) const {
+        std::vector<double> vector = {x, y};
+        return index.findTopK(k, vespalib::ConstArrayRef<double>(vector.data(), vector.size()), 100);
+    }
+    std::vector<uint32_t> topKDocIds(uint32_t k, double x, double y) const {
+        std::vector<uint32_t> result;
+        for (const auto &neighbor : findTopK(k, x, y)) {
+            result.push_back(neighbor.docId);
+        }
+        return result;
+    }
+};
+
+TEST_F("require that empty index has no hits", Fixture)
+{
+    EXPECT_EQUAL(0u, f.findTopK(10, 0.0, 0.0).size());
+}
+
+TEST_F("require that nearest documents are found", Fixture)
+{
+    f.add(1, 0.0, 0.0);
+    f.add(2, 3.0, 4.0);
+    f.add(3, 10.0, 10.0);
+    f.add(4, 1.0, 0.0);
+    auto hits = f.findTopK(2, 0.0, 0.0);
+    ASSERT_EQUAL(2u, hits.size());
+    EXPECT_EQUAL(1u, hits[0].docId);
+    EXPECT_EQUAL(0.0, hits[0].distance);
+    EXPECT_EQUAL(4u, hits[1].docId);
+    EXPECT_EQUAL(1.0, hits[1].distance);
+    hits = f.findTopK(10, 0.0, 0.0);
+    ASSERT_EQUAL(4u, hits.size());
+    EXPECT_EQUAL(2u, hits[2].docId);
+    EXPECT_EQUAL(5.0, hits[2].distance);
+    EXPECT_EQUAL(3u, hits[3].docId);
+}
+
+TEST_F("require that removed documents are not found", Fixture)
+{
+    f.add(1, 0.0, 0.0);
+    f.add(2, 1.0, 0.0);
+    f.add(3, 2.0, 0.0);
+    f.remove(1);
+    EXPECT_FALSE(f.index.hasDocument(1));
+    EXPECT_TRUE(f.index.hasDocument(2));
+    EXPECT_TRUE((std::vector<uint32_t>{2, 3}) == f.topKDocIds(10, 0.0, 0.0));
+    f.remove(2);
+    f.remove(3);
+    EXPECT_EQUAL(0u, f.findTopK(10, 0.0, 0.0).size());
+    f.add(2, 5.0, 0.0);
+    EXPECT_TRUE((std::vector<uint32_t>{2}) == f.topKDocIds(10, 0.0, 0.0));
+}
+
+TEST_F("require that many documents can be indexed and searched", Fixture(4))
+{
+    // Documents on a 20x20 grid, which forces shrinking of link arrays
+    for (uint32_t i = 0; i < 400; ++i) {
+        f.add(i + 1, i % 20, i / 20);
+    }
+    auto hits = f.findTopK(5, 10.0, 10.0);
+    ASSERT_EQUAL(5u, hits.size());
+    EXPECT_EQUAL(10u * 20 + 10 + 1, hits[0].docId);
+    EXPECT_EQUAL(0.0, hits[0].distance);
+    for (uint32_t i = 1; i < hits.size(); ++i) {
+        EXPECT_EQUAL(1.0, hits[i].distance);
+    }
+    for (uint32_t i = 0; i < 400; i += 2) {
+        f.remove(i + 1);
+    }
+    hits = f.findTopK(1, 0.0, 0.0);
+    ASSERT_EQUAL(1u, hits.size());
+    EXPECT_EQUAL(2u, hits[0].docId);
+    EXPECT_EQUAL(1.0, hits[0].distance);
+}
+
+TEST_F("require that memory usage is reported", Fixture)
+{
+    auto before = f.index.getMemoryUsage();
+    f.add(1, 0.0, 0.0);
+    f.add(2, 1.0, 0.0);
+    auto after = f.index.getMemoryUsage();
+    EXPECT_GREATER(after.usedBytes(), before.usedBytes());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -54,6 +54,7 @@ private:
     void testSync();
     void testTruncateOnShortRead();
     void testTruncateOnVersionMismatch();
+    void testCompressedEntries();
 };
 
 TEST_APPHOOK(Test);
@@ -116,6 +117,40 @@ RPC::Result CallBackManyTest::receive(const Packet & p)
     return RPC::OK;
 }
 
+std::string
+makeEntryData(SerialNum serial)
+{
+    // Every other entry is too small to be compressed.
+    size_t size = (serial % 2 == 0) ? 4000 : 8;
+    return std::string(size, 'a' + (serial % 26));
+}
+
+class CallBackCompressedTest : public TransLogClient::Visitor::Callback
+{
+private:
+    virtual RPC::Result receive(const Packet & packet) override;
+    virtual void eof()    override { _eof = true; }
+public:
+    CallBackCompressedTest() : _eof(false), _count(0), _mismatches(0) { }
+    bool      _eof;
+    size_t    _count;
+    size_t    _mismatches;
+};
+
+RPC::Result CallBackCompressedTest::receive(const Packet & p)
+{
+    nbostream_longlivedbuf h(p.getHandle().c_str(), p.getHandle().size());
+    while (h.size() > 0) {
+        Packet::Entry e;
+        e.deserialize(h);
+        if (std::string(e.data().c_str(), e.data().size()) != makeEntryData(e.serial())) {
+            _mismatches++;
+        }
+        _count++;
+    }
+    return RPC::OK;
+}
+
 class CallBackUpdate : public TransLogClient::Visitor::Callback
 {
 public:
@@ -768,6 +803,10 @@ Test::testSync()
 
     EXPECT_TRUE(s1->sync(2, syncedTo));
     EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
+    SyncStats syncStats = tlss.getDomainStats()["sync"].syncStats;
+    EXPECT_LESS_EQUAL(1u, syncStats.numSyncs);
+    EXPECT_EQUAL(TOTAL_NUM_ENTRIES, syncStats.syncedEntries);
+    EXPECT_LESS_EQUAL(syncStats.maxSyncTime.count(), syncStats.syncTime.count());
 }
 
 
@@ -872,6 +911,47 @@ Test::testTruncateOnShortRead()
 }
 
 
+void
+Test::testCompressedEntries()
+{
+    const unsigned int NUM_PACKETS = 20;
+    const unsigned int NUM_ENTRIES = 10;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+    DummyFileHeaderContext fileHeaderContext;
+    {
+        TransLogServer tlss("test14", 18377, ".", fileHeaderContext, 0x1000000, 4, DomainPart::xxh64,
+                            DomainPart::CompressionConfig(DomainPart::CompressionConfig::LZ4));
+        TransLogClient tls("tcp/localhost:18377");
+        createDomainTest(tls, "compressed", 0);
+        TransLogClient::Session::UP s1 = openDomainTest(tls, "compressed");
+        SerialNum serial(1);
+        for (size_t i(0); i < NUM_PACKETS; i++) {
+            Packet p(0x100000);
+            for (size_t j(0); j < NUM_ENTRIES; j++, serial++) {
+                std::string data = makeEntryData(serial);
+                ASSERT_TRUE(p.add(Packet::Entry(serial, 1, vespalib::ConstBufferRef(data.c_str(), data.size()))));
+            }
+            ASSERT_TRUE(s1->commit(vespalib::ConstBufferRef(p.getHandle().c_str(), p.getHandle().size())));
+        }
+        size_t uncompressedSize = (TOTAL_NUM_ENTRIES / 2) * (4000 + 8);
+        EXPECT_LESS(tlss.getDomainStats()["compressed"].byteSize, uncompressedSize);
+    }
+    {
+        // Compressed entries are read regardless of the configured compression.
+        TransLogServer tlss("test14", 18377, ".", fileHeaderContext, 0x1000000);
+        TransLogClient tls("tcp/localhost:18377");
+        TransLogClient::Session::UP s1 = openDomainTest(tls, "compressed");
+        CallBackCompressedTest ca;
+        TransLogClient::Visitor::UP visitor = tls.createVisitor("compressed", ca);
+        ASSERT_TRUE(visitor.get());
+        ASSERT_TRUE( visitor->visit(0, TOTAL_NUM_ENTRIES) );
+        for (size_t i(0); ! ca._eof && (i < 60000); i++ ) { FastOS_Thread::Sleep(10); }
+        ASSERT_TRUE( ca._eof );
+        EXPECT_EQUAL(TOTAL_NUM_ENTRIES, ca._count);
+        EXPECT_EQUAL(0u, ca._mismatches);
+    }
+}
+
 int Test::Main()
 {
     TEST_INIT("translogclient_test");
@@ -893,6 +973,8 @@ int Test::Main()
     testTruncateOnVersionMismatch();
 
     testCrcVersions();
+
+    testCompressedEntries();
     
     TEST_DONE();
 }
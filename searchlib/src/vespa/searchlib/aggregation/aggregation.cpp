@@ -456,7 +456,7 @@ int calculateRank(const Sketch<BucketBits, HashT> &sketch) {
         return static_cast<const SparseSketch<BucketBits, HashT>&>(sketch)
             .getSize();
     }
-    auto normal = static_cast<const NormalSketch<BucketBits, HashT>&>(sketch);
+    const auto &normal = static_cast<const NormalSketch<BucketBits, HashT>&>(sketch);
     int rank = 0;
     for (size_t i = 0; i < sketch.BUCKET_COUNT; ++i) {
         rank += normal.bucket[i];
@@ -471,14 +471,23 @@ void ExpressionCountAggregationResult::onMerge(const AggregationResult &r) {
     _hll.merge(result._hll);
     _rank.set(calculateRank(_hll.getSketch()));
 }
-void ExpressionCountAggregationResult::onAggregate(const ResultNode &result) {
-    size_t hash = result.hash();
+void ExpressionCountAggregationResult::aggregateHash(size_t hash) {
     const unsigned int seed = 42;
     hash = XXH32(&hash, sizeof(hash), seed);
     // The rank is a maintained sum of all buckets. This should give
     // almost the same ordering as the actual estimates.
     _rank += _hll.aggregate(hash);
 }
+void ExpressionCountAggregationResult::onAggregate(const ResultNode &result) {
+    if (result.isMultiValue()) {
+        const ResultNodeVector &values = static_cast<const ResultNodeVector &>(result);
+        for (size_t i(0), m(values.size()); i < m; i++) {
+            aggregateHash(values.get(i).hash());
+        }
+    } else {
+        aggregateHash(result.hash());
+    }
+}
 void ExpressionCountAggregationResult::onReset() {
     _hll = HyperLogLog<PRECISION>();
     _rank.set(0);
@@ -0,0 +1,311 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "columnaraggregator.h"
+#include "grouping.h"
+#include "sumaggregationresult.h"
+#include "countaggregationresult.h"
+#include "minaggregationresult.h"
+#include "maxaggregationresult.h"
+#include "averageaggregationresult.h"
+#include <vespa/searchlib/expression/attributenode.h>
+#include <vespa/searchlib/expression/constantnode.h>
+#include <vespa/searchlib/expression/floatresultnode.h>
+#include <vespa/searchlib/expression/integerresultnode.h>
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using search::expression::AttributeNode;
+using search::expression::ConstantNode;
+using search::expression::ExpressionNode;
+using search::expression::ExpressionTree;
+using search::expression::FloatResultNode;
+using search::expression::Int64ResultNode;
+using search::expression::NumericResultNode;
+using search::expression::ResultNode;
+using search::expression::SingleResultNode;
+
+namespace search::aggregation {
+
+namespace {
+
+using IAttributeVector = attribute::IAttributeVector;
+
+// group number of hits that did not get a group
+constexpr uint32_t SKIP = -1;
+
+// Single value numeric attribute read directly, without any wrapping expression
+const IAttributeVector *
+plainNumericAttribute(const ExpressionNode *node)
+{
+    if ((node == nullptr) || (node->getClass().id() != AttributeNode::classId)) {
+        return nullptr;
+    }
+    const IAttributeVector *attr = static_cast<const AttributeNode &>(*node).getAttribute();
+    if ((attr == nullptr) || attr->hasMultiValue() || !(attr->isIntegerType() || attr->isFloatingPointType())) {
+        return nullptr;
+    }
+    return attr;
+}
+
+bool
+hasPlainResult(const ExpressionNode &node)
+{
+    uint32_t id = node.getResult().getClass().id();
+    return ((id == Int64ResultNode::classId) || (id == FloatResultNode::classId));
+}
+
+// start values match what the aggregation results are reset to
+template <typename T>
+T
+initial(ColumnarAggregator::Op op)
+{
+    switch (op) {
+    case ColumnarAggregator::Op::MIN: return std::numeric_limits<T>::max();
+    case ColumnarAggregator::Op::MAX: return std::numeric_limits<T>::lowest();
+    default:                          return T(0);
+    }
+}
+
+template <typename T>
+void
+sumInto(const uint32_t *groups, const T *values, uint32_t numDocs, T *acc)
+{
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        if (groups[i] != SKIP) {
+            acc[groups[i]] += values[i];
+        }
+    }
+}
+
+template <typename T>
+void
+minInto(const uint32_t *groups, const T *values, uint32_t numDocs, T *acc)
+{
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        if ((groups[i] != SKIP) && (values[i] < acc[groups[i]])) {
+            acc[groups[i]] = values[i];
+        }
+    }
+}
+
+template <typename T>
+void
+maxInto(const uint32_t *groups, const T *values, uint32_t numDocs, T *acc)
+{
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        if ((groups[i] != SKIP) && (values[i] > acc[groups[i]])) {
+            acc[groups[i]] = values[i];
+        }
+    }
+}
+
+template <typename T>
+void
+accumulate(ColumnarAggregator::Op op, const uint32_t *groups, const T *values, uint32_t numDocs, T *acc)
+{
+    switch (op) {
+    case ColumnarAggregator::Op::SUM:
+    case ColumnarAggregator::Op::AVG:
+        sumInto(groups, values, numDocs, acc);
+        break;
+    case ColumnarAggregator::Op::MIN:
+        minInto(groups, values, numDocs, acc);
+        break;
+    case ColumnarAggregator::Op::MAX:
+        maxInto(groups, values, numDocs, acc);
+        break;
+    case ColumnarAggregator::Op::COUNT:
+        break;
+    }
+}
+
+} // namespace search::aggregation::<unnamed>
+
+std::unique_ptr<ColumnarAggregator>
+ColumnarAggregator::create(Grouping &grouping)
+{
+    const Grouping::GroupingLevelList &levels = grouping.getLevels();
+    const Group &root = grouping.getRoot();
+    if ((levels.size() != 1) || (grouping.getFirstLevel() != 0) ||
+        (root.getAggrSize() != 0) || (root.getChildrenSize() != 0))
+    {
+        return std::unique_ptr<ColumnarAggregator>();
+    }
+    const IAttributeVector *key = plainNumericAttribute(levels[0].getExpression().getRoot());
+    if ((key == nullptr) || !key->isIntegerType()) {
+        return std::unique_ptr<ColumnarAggregator>();
+    }
+    std::vector<Column> columns;
+    const Group &prototype = levels[0].getGroupPrototype();
+    for (uint32_t i(0), m(prototype.getAggrSize()); i < m; i++) {
+        const AggregationResult &aggr = prototype.getAggregationResult(i);
+        const ExpressionNode *expr = aggr.getExpression();
+        uint32_t id = aggr.getClass().id();
+        if (id == CountAggregationResult::classId) {
+            bool countable = (expr == nullptr) ||
+                             (((expr->getClass().id() == AttributeNode::classId) ||
+                               (expr->getClass().id() == ConstantNode::classId)) &&
+                              !expr->getResult().isMultiValue());
+            if (!countable) {
+                return std::unique_ptr<ColumnarAggregator>();
+            }
+            columns.emplace_back(Op::COUNT, nullptr, false);
+            continue;
+        }
+        const IAttributeVector *attr = plainNumericAttribute(expr);
+        if ((attr == nullptr) || !hasPlainResult(*expr)) {
+            return std::unique_ptr<ColumnarAggregator>();
+        }
+        bool isFloat = attr->isFloatingPointType();
+        if (id == SumAggregationResult::classId) {
+            columns.emplace_back(Op::SUM, attr, isFloat);
+        } else if (id == MinAggregationResult::classId) {
+            columns.emplace_back(Op::MIN, attr, isFloat);
+        } else if (id == MaxAggregationResult::classId) {
+            columns.emplace_back(Op::MAX, attr, isFloat);
+        } else if (id == AverageAggregationResult::classId) {
+            columns.emplace_back(Op::AVG, attr, isFloat);
+        } else {
+            return std::unique_ptr<ColumnarAggregator>();
+        }
+    }
+    return std::unique_ptr<ColumnarAggregator>(new ColumnarAggregator(grouping, *key, std::move(columns)));
+}
+
+ColumnarAggregator::ColumnarAggregator(Grouping &grouping, const IAttributeVector &key, std::vector<Column> columns)
+    : _grouping(grouping),
+      _key(key),
+      _collect(grouping.getLastLevel() > 0),
+      _columns(std::move(columns)),
+      _groupMap(),
+      _firstDoc(),
+      _rank(),
+      _count(),
+      _keyScratch(),
+      _groupScratch(),
+      _intScratch(),
+      _floatScratch()
+{
+}
+
+ColumnarAggregator::~ColumnarAggregator() = default;
+
+void
+ColumnarAggregator::grow()
+{
+    for (Column &column : _columns) {
+        if (column.op == Op::COUNT) {
+            continue;
+        }
+        if (column.isFloat) {
+            column.floats.push_back(initial<double>(column.op));
+        } else {
+            column.ints.push_back(initial<int64_t>(column.op));
+        }
+    }
+}
+
+void
+ColumnarAggregator::mapGroups(const DocId *docIds, const HitRank *ranks, uint32_t numDocs)
+{
+    const GroupingLevel &level = _grouping.getLevels()[0];
+    _keyScratch.resize(numDocs);
+    _groupScratch.resize(numDocs);
+    _key.getIntBatch(docIds, numDocs, &_keyScratch[0]);
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        HitRank rank = (ranks != nullptr) ? ranks[i] : 0.0;
+        uint32_t group = SKIP;
+        auto found = _groupMap.find(_keyScratch[i]);
+        if (found != _groupMap.end()) {
+            group = found->second;
+            _rank[group] = std::max(_rank[group], double(rank));
+        } else if (level.allowMoreGroups(_firstDoc.size())) {
+            group = _firstDoc.size();
+            _groupMap.insert(std::make_pair(_keyScratch[i], group));
+            _firstDoc.push_back(docIds[i]);
+            _rank.push_back(std::isnan(rank) ? -HUGE_VAL : rank);
+            _count.push_back(0);
+            grow();
+        }
+        if (group != SKIP) {
+            ++_count[group];
+        }
+        _groupScratch[i] = group;
+    }
+}
+
+void
+ColumnarAggregator::add(const DocId *docIds, const HitRank *ranks, uint32_t numDocs)
+{
+    if (numDocs == 0) {
+        return;
+    }
+    mapGroups(docIds, ranks, numDocs);
+    if (!_collect) {
+        return;
+    }
+    const uint32_t *groups = &_groupScratch[0];
+    for (Column &column : _columns) {
+        if (column.op == Op::COUNT) {
+            continue;
+        }
+        if (column.isFloat) {
+            _floatScratch.resize(numDocs);
+            column.attr->getFloatBatch(docIds, numDocs, &_floatScratch[0]);
+            accumulate(column.op, groups, &_floatScratch[0], numDocs, &column.floats[0]);
+        } else {
+            _intScratch.resize(numDocs);
+            column.attr->getIntBatch(docIds, numDocs, &_intScratch[0]);
+            accumulate(column.op, groups, &_intScratch[0], numDocs, &column.ints[0]);
+        }
+    }
+}
+
+void
+ColumnarAggregator::finish()
+{
+    const GroupingLevel &level = _grouping.getLevels()[0];
+    const ExpressionTree &selector = level.getExpression();
+    Group &root = _grouping.root();
+    for (uint32_t g(0), m(_firstDoc.size()); g < m; g++) {
+        // the first hit of each group gives the group id exactly as the generic path would
+        if (!selector.execute(_firstDoc[g], _rank[g])) {
+            throw std::runtime_error("Does not know how to handle failed select statements");
+        }
+        Group *group = root.groupSingle(selector.getResult(), _rank[g], level);
+        if ((group == nullptr) || !_collect) {
+            continue;
+        }
+        for (uint32_t i(0), n(_columns.size()); i < n; i++) {
+            const Column &column = _columns[i];
+            auto value = [&column, g]() -> NumericResultNode::UP {
+                if (column.isFloat) {
+                    return NumericResultNode::UP(new FloatResultNode(column.floats[g]));
+                }
+                return NumericResultNode::UP(new Int64ResultNode(column.ints[g]));
+            };
+            AggregationResult &aggr = group->getAggregationResult(i);
+            switch (column.op) {
+            case Op::SUM:
+                aggr.merge(SumAggregationResult(SingleResultNode::UP(value().release())));
+                break;
+            case Op::COUNT:
+                aggr.merge(CountAggregationResult(_count[g]));
+                break;
+            case Op::MIN:
+                aggr.merge(MinAggregationResult(ResultNode::CP(value().release())));
+                break;
+            case Op::MAX:
+                aggr.merge(MaxAggregationResult(*value()));
+                break;
+            case Op::AVG:
+                aggr.merge(AverageAggregationResult(value(), _count[g]));
+                break;
+            }
+        }
+    }
+}
+
+}
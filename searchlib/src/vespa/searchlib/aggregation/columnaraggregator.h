@@ -0,0 +1,73 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/searchlib/common/hitrank.h>
+#include <vespa/vespalib/stllike/swiss_hash_map.h>
+#include <memory>
+#include <vector>
+
+namespace search::attribute { class IAttributeVector; }
+
+namespace search::aggregation {
+
+class Grouping;
+
+/**
+ * Aggregates hits for the common grouping request of a single level
+ * grouping on a single value integer attribute, collecting only
+ * sum/count/min/max/avg of single value numeric attributes.
+ *
+ * Instead of evaluating the expression trees hit by hit, attribute
+ * values are fetched for a batch of hits at a time, every hit is
+ * mapped to a dense group number, and the aggregates are kept in flat
+ * arrays indexed by group number. The real groups are only created
+ * when finishing, which gives the same result as the generic path.
+ **/
+class ColumnarAggregator
+{
+public:
+    using IAttributeVector = attribute::IAttributeVector;
+    using DocId = uint32_t;
+
+    /**
+     * Returns an aggregator for the given (prepared) grouping, or
+     * nullptr if the grouping must use the generic path.
+     **/
+    static std::unique_ptr<ColumnarAggregator> create(Grouping &grouping);
+    ~ColumnarAggregator();
+
+    /** Aggregates a batch of hits; rank may be nullptr for unranked hits. */
+    void add(const DocId *docIds, const HitRank *ranks, uint32_t numDocs);
+    /** Creates the groups of the grouping tree from the collected aggregates. */
+    void finish();
+
+    enum class Op { SUM, COUNT, MIN, MAX, AVG };
+private:
+    struct Column {
+        Op                      op;
+        const IAttributeVector *attr; // nullptr when only counting
+        bool                    isFloat;
+        std::vector<int64_t>    ints;
+        std::vector<double>     floats;
+        Column(Op op_, const IAttributeVector *attr_, bool isFloat_) : op(op_), attr(attr_), isFloat(isFloat_), ints(), floats() {}
+    };
+
+    ColumnarAggregator(Grouping &grouping, const IAttributeVector &key, std::vector<Column> columns);
+    void grow();
+    void mapGroups(const DocId *docIds, const HitRank *ranks, uint32_t numDocs);
+
+    Grouping                                    &_grouping;
+    const IAttributeVector                      &_key;
+    bool                                         _collect;   // false when groups are created but not collected
+    std::vector<Column>                          _columns;
+    vespalib::swiss_hash_map<int64_t, uint32_t>  _groupMap;  // key value -> group number
+    std::vector<DocId>                           _firstDoc;  // per group, used to create its id
+    std::vector<double>                          _rank;      // per group
+    std::vector<uint64_t>                        _count;     // per group
+    std::vector<int64_t>                         _keyScratch;
+    std::vector<uint32_t>                        _groupScratch;
+    std::vector<int64_t>                         _intScratch;
+    std::vector<double>                          _floatScratch;
+};
+
+}
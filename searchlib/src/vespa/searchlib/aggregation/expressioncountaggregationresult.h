@@ -10,9 +10,13 @@ namespace search::aggregation {
 
 /**
  * Estimates the number of unique values of an expression that has
- * been observed. This class keeps track of the raw data needed for
- * estimation (the sketch). Actual estimation is done on the QR
- * server.
+ * been observed, i.e. uniquecount(expr). Each value of a multi-value
+ * result is counted separately. This class keeps track of the raw
+ * data needed for estimation (the sketch), which is what is
+ * serialized and merged, so partial results from several nodes can be
+ * merged before the count is estimated. The final estimate is done on
+ * the QR server, but getEstimatedUniqueCount() gives the same kind of
+ * estimate locally.
  */
 class ExpressionCountAggregationResult : public AggregationResult {
     static const int PRECISION = 10;
@@ -22,6 +26,7 @@ class ExpressionCountAggregationResult : public AggregationResult {
 
     const ResultNode & onGetRank() const override { return _rank; }
     void onPrepare(const ResultNode &, bool) override { }
+    void aggregateHash(size_t hash);
 public:
     DECLARE_AGGREGATIONRESULT(ExpressionCountAggregationResult);
     ExpressionCountAggregationResult();
@@ -29,6 +34,7 @@ public:
 
     void visitMembers(vespalib::ObjectVisitor &) const override {}
     const Sketch<PRECISION, uint32_t> &getSketch() const { return _hll.getSketch(); }
+    uint64_t getEstimatedUniqueCount() const { return _hll.estimateCount(); }
 };
 
 }
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "grouping.h"
+#include "columnaraggregator.h"
 #include "hitsaggregationresult.h"
 #include <vespa/searchlib/expression/stringresultnode.h>
 #include <vespa/searchlib/expression/enumresultnode.h>
@@ -25,6 +26,9 @@ namespace search::aggregation {
 
 namespace {
 
+// Number of hits whose attribute values are fetched in one batch
+constexpr unsigned int PREFETCH_SIZE = 256;
+
 void selectGroups(const vespalib::ObjectPredicate &p, vespalib::ObjectOperation &op,
                   Group &group, uint32_t first, uint32_t last, uint32_t curr)
 {
@@ -204,22 +208,86 @@ void Grouping::postProcess()
     sortById();
 }
 
+void Grouping::prefetch(const RankedHit * rankedHit, unsigned int len)
+{
+    DocId docIds[PREFETCH_SIZE];
+    for (unsigned int i(0); i < len; i++) {
+        docIds[i] = rankedHit[i]._docId;
+    }
+    // Only expressions evaluated for every hit in order are worth prefetching
+    AttributeNode::Prefetch prefetcher(docIds, len);
+    for (GroupingLevel & level : _levels) {
+        level.getExpression().select(prefetcher, prefetcher);
+    }
+    _root.select(prefetcher, prefetcher);
+}
+
 void Grouping::aggregateWithoutClock(const RankedHit * rankedHit, unsigned int len) {
-    for(unsigned int i(0); i < len; i++) {
-        aggregate(rankedHit[i]._docId, rankedHit[i]._rankValue);
+    for(unsigned int i(0); i < len; i += PREFETCH_SIZE) {
+        unsigned int m(std::min(len, i + PREFETCH_SIZE));
+        prefetch(rankedHit + i, m - i);
+        for(unsigned int j(i); j < m; j++) {
+            aggregate(rankedHit[j]._docId, rankedHit[j]._rankValue);
+        }
     }
+    prefetch(rankedHit, 0);
 }
 
 void Grouping::aggregateWithClock(const RankedHit * rankedHit, unsigned int len) {
-    for(unsigned int i(0); (i < len) && !hasExpired(); i++) {
-        aggregate(rankedHit[i]._docId, rankedHit[i]._rankValue);
+    for(unsigned int i(0); (i < len) && !hasExpired(); i += PREFETCH_SIZE) {
+        unsigned int m(std::min(len, i + PREFETCH_SIZE));
+        prefetch(rankedHit + i, m - i);
+        for(unsigned int j(i); (j < m) && !hasExpired(); j++) {
+            aggregate(rankedHit[j]._docId, rankedHit[j]._rankValue);
+        }
     }
+    prefetch(rankedHit, 0);
+}
+
+void Grouping::aggregateColumnar(ColumnarAggregator & columnar, const RankedHit * rankedHit, unsigned int len)
+{
+    DocId docIds[PREFETCH_SIZE];
+    HitRank ranks[PREFETCH_SIZE];
+    for(unsigned int i(0); (i < len) && ((_clock == NULL) || !hasExpired()); i += PREFETCH_SIZE) {
+        unsigned int m(std::min(len, i + PREFETCH_SIZE));
+        for(unsigned int j(i); j < m; j++) {
+            docIds[j - i] = rankedHit[j]._docId;
+            ranks[j - i] = rankedHit[j]._rankValue;
+        }
+        columnar.add(docIds, ranks, m - i);
+    }
+}
+
+void Grouping::aggregateColumnar(ColumnarAggregator & columnar, const BitVector & bVec)
+{
+    DocId docIds[PREFETCH_SIZE];
+    unsigned int sz(bVec.size());
+    unsigned int n(0);
+    size_t m((getTopN() > 0) ? getMaxN(sz) : sz);
+    for(DocId d(bVec.getFirstTrueBit()), i(0); (d < sz) && (i < m); d = bVec.getNextTrueBit(d+1), i++) {
+        docIds[n++] = d;
+        if (n == PREFETCH_SIZE) {
+            columnar.add(docIds, NULL, n);
+            n = 0;
+            if ((_clock != NULL) && hasExpired()) {
+                return;
+            }
+        }
+    }
+    columnar.add(docIds, NULL, n);
 }
 
 void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len)
 {
     bool isOrdered(! needResort());
     preAggregate(isOrdered);
+    std::unique_ptr<ColumnarAggregator> columnar(ColumnarAggregator::create(*this));
+    if (columnar) {
+        aggregateColumnar(*columnar, rankedHit, getMaxN(len));
+        columnar->finish();
+        postProcess();
+        return;
+    }
     HitsAggregationResult::SetOrdered pred;
     select(pred, pred);
     if (_clock == NULL) {
@@ -233,6 +301,16 @@ void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len)
 void Grouping::aggregate(const RankedHit * rankedHit, unsigned int len, const BitVector * bVec)
 {
     preAggregate(false);
+    std::unique_ptr<ColumnarAggregator> columnar(ColumnarAggregator::create(*this));
+    if (columnar) {
+        aggregateColumnar(*columnar, rankedHit, getMaxN(len));
+        if (bVec != NULL) {
+            aggregateColumnar(*columnar, *bVec);
+        }
+        columnar->finish();
+        postProcess();
+        return;
+    }
     if (_clock == NULL) {
         aggregateWithoutClock(rankedHit, getMaxN(len));
     } else {
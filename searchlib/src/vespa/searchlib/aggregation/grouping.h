@@ -12,6 +12,8 @@ class IDocumentMetaStore;
 
 namespace aggregation {
 
+class ColumnarAggregator;
+
 /**
  * This class represents a top-level grouping request.
  **/
@@ -34,8 +36,11 @@ private:
     fastos::TimeStamp      _timeOfDoom; // Used if clock is specified. This is time when request expires.
 
     bool hasExpired() const { return _clock->getTimeNS() >= _timeOfDoom; }
+    void prefetch(const RankedHit * rankedHit, unsigned int len);
     void aggregateWithoutClock(const RankedHit * rankedHit, unsigned int len);
     void aggregateWithClock(const RankedHit * rankedHit, unsigned int len);
+    void aggregateColumnar(ColumnarAggregator & columnar, const RankedHit * rankedHit, unsigned int len);
+    void aggregateColumnar(ColumnarAggregator & columnar, const BitVector & bVec);
     void postProcess();
 public:
     DECLARE_IDENTIFIABLE_NS2(search, aggregation, Grouping);
@@ -25,8 +25,14 @@
 #include <vespa/searchlib/queryeval/weighted_set_term_search.h>
 #include <vespa/searchlib/queryeval/weighted_set_term_blueprint.h>
 #include <vespa/searchlib/queryeval/get_weight_from_node.h>
+#include <vespa/searchlib/queryeval/nearest_neighbor_blueprint.h>
+#include <vespa/searchlib/tensor/dense_tensor_attribute.h>
+#include <vespa/eval/tensor/tensor.h>
+#include <vespa/eval/tensor/tensor_mapper.h>
+#include <vespa/eval/tensor/dense/dense_tensor_view.h>
 #include <vespa/vespalib/util/regexp.h>
 #include <sstream>
+#include <limits>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.attribute.attribute_blueprint_factory");
@@ -38,6 +44,7 @@ using search::fef::TermFieldMatchDataArray;
 using search::fef::TermFieldMatchDataPosition;
 using search::query::Location;
 using search::query::LocationTerm;
+using search::query::NearestNeighborTerm;
 using search::query::Node;
 using search::query::NumberTerm;
 using search::query::PredicateQuery;
@@ -56,6 +63,7 @@ using search::queryeval::DotProductBlueprint;
 using search::queryeval::FieldSpec;
 using search::queryeval::FieldSpecBaseList;
 using search::queryeval::IRequestContext;
+using search::queryeval::NearestNeighborBlueprint;
 using search::queryeval::NoUnpack;
 using search::queryeval::OrLikeSearch;
 using search::queryeval::OrSearch;
@@ -239,9 +247,19 @@ make_location_blueprint(const FieldSpec &field, const IAttributeVector &attribut
     {
         return std::make_unique<queryeval::EmptyBlueprint>(field);
     }
-    ZCurve::RangeVector rangeVector = ZCurve::find_ranges(
-            location.getMinX(), location.getMinY(),
-            location.getMaxX(), location.getMaxY());
+    ZCurve::RangeVector rangeVector;
+    if (location.getRankOnDistance() && (location.getRadius() != std::numeric_limits<uint32_t>::max())) {
+        // leave out the parts of the bounding box that are outside the radius
+        ZCurve::Circle circle(location.getX(), location.getY(), location.getRadius(), location.getXAspect());
+        rangeVector = ZCurve::find_ranges(location.getMinX(), location.getMinY(),
+                                          location.getMaxX(), location.getMaxY(), circle);
+        if (rangeVector.empty()) {
+            return std::make_unique<queryeval::EmptyBlueprint>(field);
+        }
+    } else {
+        rangeVector = ZCurve::find_ranges(location.getMinX(), location.getMinY(),
+                                          location.getMaxX(), location.getMaxY());
+    }
     auto pre_filter = std::make_unique<LocationPreFilterBlueprint>(field, attribute, rangeVector);
     if (!pre_filter->should_use()) {
         return post_filter;
@@ -358,11 +376,13 @@ public:
         if (_terms.size() == 0) {
             return std::make_unique<queryeval::EmptySearch>();
         }
-        return queryeval::ParallelWeakAndSearch::create(*tfmda[0],
-                queryeval::ParallelWeakAndSearch::MatchParams(_scores, _scoreThreshold,
-                                                              _thresholdBoostFactor, _scoresAdjustFrequency)
-                        .setDocIdLimit(get_docid_limit()),
-                _weights, _terms, _attr, strict);
+        queryeval::ParallelWeakAndSearch::MatchParams matchParams(_scores, _scoreThreshold,
+                                                                  _thresholdBoostFactor, _scoresAdjustFrequency);
+        matchParams.setDocIdLimit(get_docid_limit());
+        if (_terms.size() >= queryeval::DEFAULT_PARALLEL_WAND_MAX_SCORE_MIN_TERMS) {
+            return queryeval::DotProductSearch::create(*tfmda[0], matchParams, _weights, _terms, _attr, strict);
+        }
+        return queryeval::ParallelWeakAndSearch::create(*tfmda[0], matchParams, _weights, _terms, _attr, strict);
     }
 };
 
@@ -456,8 +476,37 @@ public:
         }
     }
 
+    void visitNearestNeighbor(NearestNeighborTerm &n) {
+        const auto *attr = dynamic_cast<const tensor::DenseTensorAttribute *>(&_attr);
+        if (attr == nullptr) {
+            LOG(warning, "Trying to apply a NearestNeighborTerm node to a non-dense tensor attribute '%s'.",
+                _attr.getName().c_str());
+            setResult(std::make_unique<queryeval::EmptyBlueprint>(_field));
+            return;
+        }
+        std::unique_ptr<vespalib::tensor::Tensor> query_tensor =
+            getRequestContext().getQueryTensor(n.get_query_tensor_name());
+        if (!query_tensor) {
+            LOG(warning, "Query tensor '%s' used by NearestNeighborTerm for attribute '%s' was not found.",
+                n.get_query_tensor_name().c_str(), _attr.getName().c_str());
+            setResult(std::make_unique<queryeval::EmptyBlueprint>(_field));
+            return;
+        }
+        auto mapped = vespalib::tensor::TensorMapper::mapToDense(*query_tensor, attr->getTensorType());
+        const auto *dense = dynamic_cast<const vespalib::tensor::DenseTensorView *>(mapped.get());
+        if (dense == nullptr) {
+            setResult(std::make_unique<queryeval::EmptyBlueprint>(_field));
+            return;
+        }
+        const auto &cells = dense->cellsRef();
+        std::vector<double> query_vector(cells.cbegin(), cells.cend());
+        setResult(std::make_unique<NearestNeighborBlueprint>(_field, *attr, std::move(query_vector),
+                                                             n.get_target_num_hits()));
+    }
+
     void visit(NumberTerm & n) override { visitTerm(n, true); }
     void visit(LocationTerm &n) override { visitLocation(n); }
+    void visit(NearestNeighborTerm &n) override { visitNearestNeighbor(n); }
     void visit(PrefixTerm & n) override { visitTerm(n); }
 
     void visit(RangeTerm &n) override {
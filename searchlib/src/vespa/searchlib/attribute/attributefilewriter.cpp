@@ -3,6 +3,7 @@
 #include "attributefilewriter.h"
 #include "attributefilebufferwriter.h"
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/searchlib/common/background_write_limiter.h>
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/searchlib/common/tunefileinfo.h>
 #include "attribute_header.h"
@@ -26,14 +27,17 @@ void
 writeDirectIOAligned(FastOS_FileInterface &file, const void *buf,
                      size_t length)
 {
+    BackgroundWriteLimiter &limiter(BackgroundWriteLimiter::instance());
     const char * data(static_cast<const char *>(buf));
     size_t remaining(length);
     for (size_t maxChunk(2048*1024); maxChunk >= MIN_ALIGNMENT; maxChunk >>= 1) {
         for ( ; remaining > maxChunk; remaining -= maxChunk, data += maxChunk) {
+            limiter.acquire(maxChunk);
             file.WriteBuf(data, maxChunk);
         }
     }
     if (remaining > 0) {
+        limiter.acquire(remaining);
         file.WriteBuf(data, remaining);
     }
 }
@@ -57,10 +61,13 @@ updateHeader(const vespalib::string &name, uint64_t fileBitSize)
 
 /*
  * BufferWriter implementation that passes full buffers on to
- * AttributeFileWriter.
+ * AttributeFileWriter. Two buffers are used, one is filled while the
+ * other is written in the background.
  */
 class FileBackedBufferWriter : public AttributeFileBufferWriter
 {
+    AttributeFileWriter &_owner;
+    Buffer _spare;
 public:
     FileBackedBufferWriter(AttributeFileWriter &fileWriter);
 
@@ -71,13 +78,17 @@ public:
 
 
 FileBackedBufferWriter::FileBackedBufferWriter(AttributeFileWriter &fileWriter)
-    : AttributeFileBufferWriter(fileWriter)
+    : AttributeFileBufferWriter(fileWriter),
+      _owner(fileWriter),
+      _spare(fileWriter.allocBuf(BUFFER_SIZE))
 {
 }
 
 
 FileBackedBufferWriter::~FileBackedBufferWriter()
 {
+    // The last full buffer might still be written from one of our buffers.
+    _owner.waitForPendingWrite();
 }
 
 
@@ -88,7 +99,14 @@ FileBackedBufferWriter::onFlush(size_t nowLen) {
                ((const char *) _buf->getFree(), nowLen));
     assert(buf->getDataLen() == nowLen);
     assert(buf->getData() == _buf->getFree());
-    _fileWriter.writeBuf(std::move(buf));
+    if (nowLen != BUFFER_SIZE) {
+        // Last buffer, complete it before returning to the saver.
+        _owner.writeBuf(std::move(buf));
+        return;
+    }
+    // Returns when the previous write from _spare is done.
+    _owner.writeBufAsync(std::move(buf));
+    std::swap(_buf, _spare);
 }
 
 }
@@ -104,11 +122,15 @@ AttributeFileWriter(const TuneFileAttributes &tuneFileAttributes,
       _fileHeaderContext(fileHeaderContext),
       _header(header),
       _desc(desc),
-      _fileBitSize(0)
+      _fileBitSize(0),
+      _pendingWrite()
 { }
 
 
-AttributeFileWriter::~AttributeFileWriter() { }
+AttributeFileWriter::~AttributeFileWriter()
+{
+    waitForPendingWrite();
+}
 
 
 bool
@@ -160,7 +182,7 @@ AttributeFileWriter::allocBuf(size_t size)
 
 
 void
-AttributeFileWriter::writeBuf(Buffer buf)
+AttributeFileWriter::writeBufNow(Buffer buf)
 {
     size_t bufLen = buf->getDataLen();
     // TODO: pad to DirectIO boundary when burning bridges
@@ -169,9 +191,45 @@ AttributeFileWriter::writeBuf(Buffer buf)
 }
 
 
+void
+AttributeFileWriter::writeBuf(Buffer buf)
+{
+    finishPendingWrite();
+    writeBufNow(std::move(buf));
+}
+
+
+void
+AttributeFileWriter::writeBufAsync(Buffer buf)
+{
+    finishPendingWrite();
+    _pendingWrite = std::async(std::launch::async,
+                               [this, buf = std::move(buf)]() mutable { writeBufNow(std::move(buf)); });
+}
+
+
+void
+AttributeFileWriter::finishPendingWrite()
+{
+    if (_pendingWrite.valid()) {
+        _pendingWrite.get();
+    }
+}
+
+
+void
+AttributeFileWriter::waitForPendingWrite()
+{
+    if (_pendingWrite.valid()) {
+        _pendingWrite.wait();
+    }
+}
+
+
 void
 AttributeFileWriter::close()
 {
+    finishPendingWrite();
     if (_file->IsOpened()) {
         _file->Sync();
         _file->Close();
@@ -4,6 +4,7 @@
 
 #include "iattributefilewriter.h"
 #include <vespa/vespalib/stllike/string.h>
+#include <future>
 
 class FastOS_FileInterface;
 
@@ -28,10 +29,13 @@ class AttributeFileWriter : public IAttributeFileWriter
     const attribute::AttributeHeader &_header;
     vespalib::string _desc;
     uint64_t _fileBitSize;
+    std::future<void> _pendingWrite;
 
     void addTags(vespalib::GenericHeader &header);
 
     void writeHeader();
+    void writeBufNow(Buffer buf);
+    void finishPendingWrite();
 public:
     AttributeFileWriter(const TuneFileAttributes &tuneFileAttributes,
                         const search::common::FileHeaderContext & fileHeaderContext,
@@ -41,6 +45,17 @@ public:
     virtual Buffer allocBuf(size_t size) override;
     virtual void writeBuf(Buffer buf) override;
     virtual std::unique_ptr<BufferWriter> allocBufferWriter() override;
+    /*
+     * Writes the given buffer in the background. The memory behind the
+     * buffer must be kept until the next call to any write method,
+     * waitForPendingWrite() or close().
+     */
+    void writeBufAsync(Buffer buf);
+    /*
+     * Waits for a background write to complete. Any failure is
+     * reported by the next write or close.
+     */
+    void waitForPendingWrite();
     bool open(const vespalib::string &fileName);
     void close();
 };
@@ -154,6 +154,50 @@ public:
     { }
 };
 
+/**
+ * Strict iterators delegating the search for the next hit to the
+ * search context, for search contexts able to match many documents at
+ * a time. The search context must provide
+ * findNextMatch(docId, endId), returning endId when there are no more
+ * hits.
+ *
+ * @param SC the specialized search context type associated with this iterator
+ */
+template <typename SC>
+class ScanAttributeIteratorStrict : public AttributeIteratorT<SC>
+{
+private:
+    using AttributeIteratorT<SC>::_concreteSearchCtx;
+    using AttributeIteratorT<SC>::setDocId;
+    using AttributeIteratorT<SC>::setAtEnd;
+    using AttributeIteratorT<SC>::isAtEnd;
+    using Trinary=vespalib::Trinary;
+    void doSeek(uint32_t docId) override;
+    Trinary is_strict() const override { return Trinary::True; }
+public:
+    ScanAttributeIteratorStrict(const SC &concreteSearchCtx, fef::TermFieldMatchData * matchData)
+        : AttributeIteratorT<SC>(concreteSearchCtx, matchData)
+    { }
+};
+
+
+template <typename SC>
+class FilterScanAttributeIteratorStrict : public FilterAttributeIteratorT<SC>
+{
+private:
+    using FilterAttributeIteratorT<SC>::_concreteSearchCtx;
+    using FilterAttributeIteratorT<SC>::setDocId;
+    using FilterAttributeIteratorT<SC>::setAtEnd;
+    using FilterAttributeIteratorT<SC>::isAtEnd;
+    using Trinary=vespalib::Trinary;
+    void doSeek(uint32_t docId) override;
+    Trinary is_strict() const override { return Trinary::True; }
+public:
+    FilterScanAttributeIteratorStrict(const SC &concreteSearchCtx, fef::TermFieldMatchData *matchData)
+        : FilterAttributeIteratorT<SC>(concreteSearchCtx, matchData)
+    { }
+};
+
 /**
  * This class acts as an iterator over documents that are results for
  * the subquery represented by the search context object associated
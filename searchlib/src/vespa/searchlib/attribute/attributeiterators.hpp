@@ -382,6 +382,38 @@ FilterAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
     setAtEnd();
 }
 
+template <typename SC>
+void
+ScanAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
+{
+    if (isAtEnd(docId)) {
+        setAtEnd();
+        return;
+    }
+    uint32_t nextId = _concreteSearchCtx.findNextMatch(docId, this->getEndId());
+    if (!isAtEnd(nextId)) {
+        setDocId(nextId);
+    } else {
+        setAtEnd();
+    }
+}
+
+template <typename SC>
+void
+FilterScanAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
+{
+    if (isAtEnd(docId)) {
+        setAtEnd();
+        return;
+    }
+    uint32_t nextId = _concreteSearchCtx.findNextMatch(docId, this->getEndId());
+    if (!isAtEnd(nextId)) {
+        setDocId(nextId);
+    } else {
+        setAtEnd();
+    }
+}
+
 template <typename SC>
 void
 AttributeIteratorT<SC>::or_hits_into(BitVector & result, uint32_t begin_id) {
@@ -7,6 +7,7 @@
 #include "attributesaver.h"
 #include "attributevector.hpp"
 #include "floatbase.h"
+#include "integerbase.h"
 #include "interlock.h"
 #include "ipostinglistattributebase.h"
 #include "ipostinglistsearchcontext.h"
@@ -19,6 +20,7 @@
 #include <vespa/searchlib/query/query.h>
 #include <vespa/searchlib/query/query_term_decoder.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/searchlib/util/fileutil.h>
 #include <vespa/vespalib/util/exceptions.h>
 
 #include <vespa/log/log.h>
@@ -176,11 +178,21 @@ AttributeVector::AttributeVector(const vespalib::stringref &baseFileName, const
       _compactLidSpaceGeneration(0u),
       _hasEnum(false),
       _loaded(false),
-      _enableEnumeratedSave(false)
+      _enableEnumeratedSave(false),
+      _nextStatUpdateTime(),
+      _loadExecutor(nullptr)
 { }
 
 AttributeVector::~AttributeVector() = default;
 
+vespalib::alloc::Alloc
+AttributeVector::getInitialAlloc(const Config &cfg)
+{
+    return cfg.hugePages()
+        ? vespalib::alloc::Alloc::allocHugePages()
+        : vespalib::alloc::Alloc::alloc();
+}
+
 void AttributeVector::updateStat(bool force) {
     if (force) {
         onUpdateStat();
@@ -430,7 +442,12 @@ AttributeVector::save(IAttributeSaveTarget &saveTarget)
 
 attribute::AttributeHeader
 AttributeVector::createAttributeHeader() const {
-    return attribute::AttributeHeader(getBaseFileName(),
+    return createAttributeHeader(getBaseFileName());
+}
+
+attribute::AttributeHeader
+AttributeVector::createAttributeHeader(const vespalib::string &fileName) const {
+    return attribute::AttributeHeader(fileName,
                                    getConfig().basicType(),
                                    getConfig().collectionType(),
                                    getConfig().basicType().type() == BasicType::Type::TENSOR
@@ -495,7 +512,14 @@ AttributeVector::isEnumeratedSaveFormat() const
 
 bool
 AttributeVector::load() {
+    return load(nullptr);
+}
+
+bool
+AttributeVector::load(vespalib::Executor *executor) {
+    _loadExecutor = executor;
     bool loaded = onLoad();
+    _loadExecutor = nullptr;
     if (loaded) {
         commit();
     }
@@ -752,6 +776,92 @@ AttributeVector::onInitSave()
     return std::unique_ptr<AttributeSaver>();
 }
 
+std::unique_ptr<AttributeSaver>
+AttributeVector::initDeltaSave(uint64_t baseSerialNum, uint32_t maxChangedDocs)
+{
+    commit();
+    return onInitDeltaSave(baseSerialNum, maxChangedDocs);
+}
+
+std::unique_ptr<AttributeSaver>
+AttributeVector::onInitDeltaSave(uint64_t, uint32_t)
+{
+    return std::unique_ptr<AttributeSaver>();
+}
+
+namespace {
+
+/*
+ * A delta holds all changed lids followed by their values, see
+ * SingleValueNumericAttribute::onInitDeltaSave().
+ */
+template <typename T, typename AttrT, typename ValueT>
+bool
+applyDelta(AttributeVector &attr, const fileutil::LoadedBuffer &buffer)
+{
+    const size_t entrySize(sizeof(uint32_t) + sizeof(T));
+    if ((buffer.size() % entrySize) != 0) {
+        return false;
+    }
+    AttrT &typedAttr = static_cast<AttrT &>(attr);
+    const size_t count(buffer.size() / entrySize);
+    const char *lids = static_cast<const char *>(buffer.buffer());
+    const char *values = lids + count * sizeof(uint32_t);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t lid;
+        T value;
+        memcpy(&lid, lids + i * sizeof(uint32_t), sizeof(uint32_t));
+        memcpy(&value, values + i * sizeof(T), sizeof(T));
+        if (lid >= attr.getNumDocs() || !typedAttr.update(lid, static_cast<ValueT>(value))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+bool
+AttributeVector::loadDelta(const vespalib::string &deltaBaseFileName)
+{
+    fileutil::LoadedBuffer::UP buffer(FileUtil::loadFile(deltaBaseFileName + ".dat"));
+    attribute::AttributeHeader header(attribute::AttributeHeader::extractTags(buffer->getHeader()));
+    const uint32_t numDocs(header.getNumDocs());
+    if (header.getBasicType().type() != getBasicType() ||
+        header.getCollectionType().type() != CollectionType::SINGLE ||
+        hasMultiValue() || numDocs < getNumDocs()) {
+        return false;
+    }
+    if (numDocs > getNumDocs() && !addDocs(numDocs - getNumDocs())) {
+        return false;
+    }
+    bool ok = false;
+    switch (getBasicType()) {
+    case BasicType::INT8:
+        ok = applyDelta<int8_t, IntegerAttribute, largeint_t>(*this, *buffer);
+        break;
+    case BasicType::INT16:
+        ok = applyDelta<int16_t, IntegerAttribute, largeint_t>(*this, *buffer);
+        break;
+    case BasicType::INT32:
+        ok = applyDelta<int32_t, IntegerAttribute, largeint_t>(*this, *buffer);
+        break;
+    case BasicType::INT64:
+        ok = applyDelta<int64_t, IntegerAttribute, largeint_t>(*this, *buffer);
+        break;
+    case BasicType::FLOAT:
+        ok = applyDelta<float, FloatingPointAttribute, double>(*this, *buffer);
+        break;
+    case BasicType::DOUBLE:
+        ok = applyDelta<double, FloatingPointAttribute, double>(*this, *buffer);
+        break;
+    default:
+        break;
+    }
+    commit();
+    return ok;
+}
+
 bool
 AttributeVector::hasActiveEnumGuards()
 {
@@ -36,6 +36,7 @@ namespace document {
 
 namespace vespalib {
     class GenericHeader;
+    class Executor;
 }
 
 namespace search {
@@ -329,6 +330,9 @@ protected:
         return _genHolder;
     }
 
+    /** Returns the executor given to load(), only set while onLoad() runs. **/
+    vespalib::Executor *getLoadExecutor() const { return _loadExecutor; }
+
     template<typename T>
     bool clearDoc(ChangeVectorT< ChangeTemplate<T> > &changes, DocId doc);
 
@@ -399,6 +403,11 @@ public:
     /** Return the fixed length of the attribute. If 0 then you must inquire each document. */
     size_t getFixedWidth() const override { return _config.basicType().fixedSize(); }
     const Config &getConfig() const { return _config; }
+    /**
+     * Returns an empty allocation with the allocation strategy selected by
+     * the given config, used as initial allocation for per document vectors.
+     */
+    static vespalib::alloc::Alloc getInitialAlloc(const Config &cfg);
     BasicType getInternalBasicType() const { return _config.basicType(); }
     CollectionType getInternalCollectionType() const { return _config.collectionType(); }
     const BaseName & getBaseFileName() const { return _baseFileName; }
@@ -451,12 +460,21 @@ public:
     bool save(IAttributeSaveTarget & saveTarget);
 
     attribute::AttributeHeader createAttributeHeader() const;
+    attribute::AttributeHeader createAttributeHeader(const vespalib::string &fileName) const;
 
     /** Returns whether this attribute has load data files on disk **/
     bool hasLoadData() const;
 
     bool isEnumeratedSaveFormat() const;
     bool load();
+    /**
+     * Load this attribute vector, using the given executor (if not
+     * null) to split expensive parts of the load, e.g. sorting of
+     * loaded enum values, into tasks. The calling thread takes part
+     * in the work, so it is safe to load from a thread owned by the
+     * same executor.
+     **/
+    bool load(vespalib::Executor *executor);
     void commit(bool forceStatUpdate = false);
     void commit(uint64_t firstSyncToken, uint64_t lastSyncToken);
     void setCreateSerialNum(uint64_t createSerialNum);
@@ -604,6 +622,7 @@ private:
     bool                   _loaded;
     bool                   _enableEnumeratedSave;
     fastos::TimeStamp      _nextStatUpdateTime;
+    vespalib::Executor    *_loadExecutor;
 
 ////// Locking strategy interface. only available from the Guards.
     /**
@@ -677,6 +696,21 @@ public:
     std::unique_ptr<AttributeSaver> initSave();
 
     virtual std::unique_ptr<AttributeSaver> onInitSave();
+
+    /**
+     * Returns a saver for the docs changed since the full save or load
+     * done at the given serial number, written to <basefilename>.delta.
+     * Returns nullptr when a full save is needed instead, e.g. when more
+     * than maxChangedDocs docs have changed or changes are not tracked.
+     */
+    std::unique_ptr<AttributeSaver> initDeltaSave(uint64_t baseSerialNum, uint32_t maxChangedDocs);
+    virtual std::unique_ptr<AttributeSaver> onInitDeltaSave(uint64_t baseSerialNum, uint32_t maxChangedDocs);
+    /**
+     * Applies a delta saved by initDeltaSave() on top of the loaded
+     * attribute vector. Works for all single value numeric attributes,
+     * independent of which one saved the delta.
+     */
+    bool loadDelta(const vespalib::string &deltaBaseFileName);
     virtual uint64_t getEstimatedSaveByteSize() const;
 
     static bool isEnumerated(const vespalib::GenericHeader &header);
@@ -69,6 +69,10 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     retval.setEnableOnlyBitVector(cfg.enableonlybitvector);
     retval.setIsFilter(cfg.enableonlybitvector);
     retval.setFastAccess(cfg.fastaccess);
+    retval.setPacked(cfg.packed);
+    retval.setMmapLoad(cfg.mmapload);
+    retval.setHashDictionary(cfg.hashdictionary);
+    retval.setHugePages(cfg.hugepages);
     predicateParams.setArity(cfg.arity);
     predicateParams.setBounds(cfg.lowerbound, cfg.upperbound);
     predicateParams.setDensePostingListThreshold(cfg.densepostinglistthreshold);
@@ -79,6 +83,11 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
         } else {
             retval.setTensorType(ValueType::tensor_type({}));
         }
+        HnswIndexParams hnswIndexParams;
+        hnswIndexParams.setEnabled(cfg.hnsw.enabled);
+        hnswIndexParams.setMaxLinksPerNode(cfg.hnsw.maxlinkspernode);
+        hnswIndexParams.setNeighborsToExploreAtInsert(cfg.hnsw.neighborstoexploreatinsert);
+        retval.setHnswIndexParams(hnswIndexParams);
     }
     return retval;
 }
@@ -6,6 +6,7 @@
 #include "reference_attribute.h"
 #include "attributevector.hpp"
 #include "singlenumericattribute.hpp"
+#include "singlepackedintegerattribute.h"
 #include "singlestringattribute.h"
 #include <vespa/searchlib/tensor/generic_tensor_attribute.h>
 #include <vespa/searchlib/tensor/dense_tensor_attribute.h>
@@ -33,17 +34,33 @@ AttributeFactory::createSingleStd(const vespalib::string & baseFileName, const C
         ret.reset(new SingleValueNibbleNumericAttribute(baseFileName, info.getGrowStrategy()));
         break;
     case BasicType::INT8:
-        ret.reset(new SingleValueNumericAttribute<IntegerAttributeTemplate<int8_t> >(baseFileName, info));
+        if (info.packed()) {
+            ret.reset(new SingleValuePackedIntegerAttribute<IntegerAttributeTemplate<int8_t> >(baseFileName, info));
+        } else {
+            ret.reset(new SingleValueNumericAttribute<IntegerAttributeTemplate<int8_t> >(baseFileName, info));
+        }
         break;
     case BasicType::INT16:
         // XXX: Unneeded since we don't have short document fields in java.
-        ret.reset(new SingleValueNumericAttribute<IntegerAttributeTemplate<int16_t> >(baseFileName, info));
+        if (info.packed()) {
+            ret.reset(new SingleValuePackedIntegerAttribute<IntegerAttributeTemplate<int16_t> >(baseFileName, info));
+        } else {
+            ret.reset(new SingleValueNumericAttribute<IntegerAttributeTemplate<int16_t> >(baseFileName, info));
+        }
         break;
     case BasicType::INT32:
-        ret.reset(new SingleValueNumericAttribute<IntegerAttributeTemplate<int32_t> >(baseFileName, info));
+        if (info.packed()) {
+            ret.reset(new SingleValuePackedIntegerAttribute<IntegerAttributeTemplate<int32_t> >(baseFileName, info));
+        } else {
+            ret.reset(new SingleValueNumericAttribute<IntegerAttributeTemplate<int32_t> >(baseFileName, info));
+        }
         break;
     case BasicType::INT64:
-        ret.reset(new SingleValueNumericAttribute<IntegerAttributeTemplate<int64_t> >(baseFileName, info));
+        if (info.packed()) {
+            ret.reset(new SingleValuePackedIntegerAttribute<IntegerAttributeTemplate<int64_t> >(baseFileName, info));
+        } else {
+            ret.reset(new SingleValueNumericAttribute<IntegerAttributeTemplate<int64_t> >(baseFileName, info));
+        }
         break;
     case BasicType::FLOAT:
         ret.reset(new SingleValueNumericAttribute<FloatingPointAttributeTemplate<float> >(baseFileName, info));
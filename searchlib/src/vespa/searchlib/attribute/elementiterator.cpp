@@ -35,6 +35,11 @@ ElementIterator::initRange(uint32_t beginid, uint32_t endid) {
     setDocId(_search->getDocId());
 }
 
+int32_t
+ElementIterator::find_element(uint32_t docid, int32_t elementId) const {
+    return _searchContext.find(docid, elementId);
+}
+
 ElementIterator::ElementIterator(SearchIterator::UP search, const ISearchContext & sc, fef::TermFieldMatchData & tfmd)
     : _search(std::move(search)),
       _searchContext(sc),
@@ -23,6 +23,12 @@ private:
 public:
     ElementIterator(SearchIterator::UP search, const ISearchContext & sc, fef::TermFieldMatchData & tfmd);
     ~ElementIterator();
+    /**
+     * Returns the first matching element id at or after the given one
+     * in the current document, or -1 if there is none. Lets callers
+     * skip between elements without unpacking all of them.
+     */
+    int32_t find_element(uint32_t docid, int32_t elementId) const;
 };
 
 }
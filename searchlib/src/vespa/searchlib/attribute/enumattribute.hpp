@@ -16,6 +16,12 @@ EnumAttribute(const vespalib::string &baseFileName,
       _enumStore(0, cfg.fastSearch())
 {
     this->setEnum(true);
+    if (cfg.hashDictionary()) {
+        _enumStore.enableHashIndex();
+    }
+    if (cfg.hugePages()) {
+        _enumStore.setHugePages(true);
+    }
 }
 
 template <typename B>
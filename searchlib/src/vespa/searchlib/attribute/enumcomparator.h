@@ -46,6 +46,10 @@ public:
     bool operator() (const EnumIndex & lhs, const EnumIndex & rhs) const override {
         return compare(getValue(lhs), getValue(rhs)) < 0;
     }
+    bool getFoldedHash(uint32_t &hash) const override {
+        hash = EntryType::foldedHash(_value);
+        return true;
+    }
 };
 
 
@@ -88,6 +92,12 @@ public:
                                        getValue(rhs), _prefixLen) < 0;
         return compareFolded(getValue(lhs), getValue(rhs)) < 0;
     }
+    bool getFoldedHash(uint32_t &hash) const override {
+        if (getUsePrefix()) {
+            return false;
+        }
+        return ParentType::getFoldedHash(hash);
+    }
 };
 
 
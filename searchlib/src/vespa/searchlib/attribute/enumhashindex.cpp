@@ -0,0 +1,155 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "enumhashindex.h"
+#include <cassert>
+#include <cstring>
+
+namespace search {
+
+using vespalib::alloc::Alloc;
+using vespalib::GenerationHeldAlloc;
+
+namespace {
+
+typedef std::atomic<uint64_t> Slot;
+
+}
+
+EnumHashIndex::EnumHashIndex()
+    : _buf(),
+      _table(nullptr),
+      _used(0u),
+      _dead(0u),
+      _genHolder()
+{
+    _buf = makeTable(0u);
+    _table.store(static_cast<const Slot *>(_buf.get()), std::memory_order_release);
+}
+
+EnumHashIndex::~EnumHashIndex()
+{
+    _genHolder.clearHoldLists();
+}
+
+Alloc
+EnumHashIndex::makeTable(uint32_t numEntries)
+{
+    // Leave the table at most half full after a rebuild
+    size_t size = MIN_SIZE;
+    while (size < 2 * static_cast<size_t>(numEntries)) {
+        size *= 2;
+    }
+    Alloc buf = Alloc::alloc((size + 1) * sizeof(Slot));
+    memset(buf.get(), 0, (size + 1) * sizeof(Slot));
+    static_cast<Slot *>(buf.get())[0].store(size - 1, std::memory_order_relaxed);
+    return buf;
+}
+
+void
+EnumHashIndex::fill(const Alloc &buf, uint32_t hash, EntryRef ref)
+{
+    const Slot *table = static_cast<const Slot *>(buf.get());
+    uint32_t mask = getMask(table);
+    Slot *slots = getSlots(table);
+    for (uint32_t i = hash & mask; ; i = (i + 1) & mask) {
+        if (slots[i].load(std::memory_order_relaxed) == EMPTY) {
+            slots[i].store(makeSlot(hash, ref), std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+void
+EnumHashIndex::publish(Alloc &&buf, uint32_t numEntries)
+{
+    _table.store(static_cast<const Slot *>(buf.get()), std::memory_order_release);
+    _buf.swap(buf);
+    vespalib::GenerationHeldBase::UP hold(new GenerationHeldAlloc<Alloc>(buf));
+    _genHolder.hold(std::move(hold));
+    _used = numEntries;
+    _dead = 0u;
+}
+
+void
+EnumHashIndex::rebuild(uint32_t numEntries)
+{
+    Alloc buf = makeTable(numEntries);
+    const Slot *table = _table.load(std::memory_order_relaxed);
+    uint32_t mask = getMask(table);
+    const Slot *slots = getSlots(table);
+    for (uint32_t i = 0; i <= mask; ++i) {
+        uint64_t slot = slots[i].load(std::memory_order_relaxed);
+        EntryRef ref(static_cast<uint32_t>(slot));
+        if (ref.valid()) {
+            fill(buf, static_cast<uint32_t>(slot >> 32), ref);
+        }
+    }
+    publish(std::move(buf), _used);
+}
+
+void
+EnumHashIndex::insert(uint32_t hash, EntryRef ref)
+{
+    assert(ref.valid());
+    const Slot *table = _table.load(std::memory_order_relaxed);
+    if ((static_cast<uint64_t>(_used + _dead) + 1) * 4 > (static_cast<uint64_t>(getMask(table)) + 1) * 3) {
+        rebuild(_used + 1);
+        table = _table.load(std::memory_order_relaxed);
+    }
+    uint32_t mask = getMask(table);
+    Slot *slots = getSlots(table);
+    for (uint32_t i = hash & mask; ; i = (i + 1) & mask) {
+        uint64_t slot = slots[i].load(std::memory_order_relaxed);
+        if (slot == EMPTY || slot == TOMBSTONE) {
+            if (slot == TOMBSTONE) {
+                --_dead;
+            }
+            slots[i].store(makeSlot(hash, ref), std::memory_order_release);
+            ++_used;
+            return;
+        }
+    }
+}
+
+void
+EnumHashIndex::remove(uint32_t hash, EntryRef ref)
+{
+    const Slot *table = _table.load(std::memory_order_relaxed);
+    uint32_t mask = getMask(table);
+    Slot *slots = getSlots(table);
+    uint64_t wanted = makeSlot(hash, ref);
+    for (uint32_t i = hash & mask; ; i = (i + 1) & mask) {
+        uint64_t slot = slots[i].load(std::memory_order_relaxed);
+        assert(slot != EMPTY);
+        if (slot == wanted) {
+            // Readers still probing past this slot must keep going
+            slots[i].store(TOMBSTONE, std::memory_order_release);
+            --_used;
+            ++_dead;
+            return;
+        }
+    }
+}
+
+void
+EnumHashIndex::assign(const std::vector<std::pair<uint32_t, EntryRef>> &entries)
+{
+    Alloc buf = makeTable(entries.size());
+    for (const auto &entry : entries) {
+        fill(buf, entry.first, entry.second);
+    }
+    publish(std::move(buf), entries.size());
+}
+
+MemoryUsage
+EnumHashIndex::getMemoryUsage() const
+{
+    MemoryUsage usage;
+    usage.incAllocatedBytes(_buf.size());
+    usage.incUsedBytes((static_cast<size_t>(_used) + _dead + 1) * sizeof(Slot));
+    usage.incDeadBytes(static_cast<size_t>(_dead) * sizeof(Slot));
+    usage.incAllocatedBytesOnHold(_genHolder.getHeldBytes());
+    return usage;
+}
+
+}
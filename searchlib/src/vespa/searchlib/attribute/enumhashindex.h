@@ -0,0 +1,110 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/datastore/entryref.h>
+#include <vespa/searchlib/util/memoryusage.h>
+#include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/util/generationholder.h>
+#include <atomic>
+#include <vector>
+
+namespace search {
+
+/**
+ * Open addressing hash index from folded value hash to enum store
+ * index, used to answer point lookups in the enum store dictionary
+ * without walking the btree.
+ *
+ * Each slot holds the 32-bit hash in the upper half and the entry
+ * reference in the lower half, so a slot is published with a single
+ * atomic store. Removed entries leave a tombstone until the table is
+ * rebuilt. The table is never more than 3/4 full, and a new table is
+ * built when that limit is reached. Readers may probe without locking,
+ * and the old table is put on hold until no reader can observe it.
+ * Only a single writer thread is allowed.
+ **/
+class EnumHashIndex
+{
+public:
+    typedef vespalib::GenerationHandler::generation_t generation_t;
+    typedef datastore::EntryRef EntryRef;
+
+private:
+    static constexpr uint64_t EMPTY = 0u;
+    static constexpr uint64_t TOMBSTONE = uint64_t(1) << 32;
+    static constexpr uint32_t MIN_SIZE = 16u;
+
+    vespalib::alloc::Alloc _buf;
+    // Word 0 of the table is the slot mask, followed by the slots
+    std::atomic<const std::atomic<uint64_t> *> _table;
+    uint32_t _used;
+    uint32_t _dead;
+    vespalib::GenerationHolder _genHolder;
+
+    static uint64_t makeSlot(uint32_t hash, EntryRef ref) {
+        return (static_cast<uint64_t>(hash) << 32) | ref.ref();
+    }
+    static uint32_t getMask(const std::atomic<uint64_t> *table) {
+        return static_cast<uint32_t>(table[0].load(std::memory_order_relaxed));
+    }
+    static std::atomic<uint64_t> *getSlots(const std::atomic<uint64_t> *table) {
+        return const_cast<std::atomic<uint64_t> *>(table) + 1;
+    }
+    static vespalib::alloc::Alloc makeTable(uint32_t numEntries);
+    static void fill(const vespalib::alloc::Alloc &buf, uint32_t hash, EntryRef ref);
+    void publish(vespalib::alloc::Alloc &&buf, uint32_t numEntries);
+    void rebuild(uint32_t numEntries);
+
+public:
+    EnumHashIndex();
+    ~EnumHashIndex();
+
+    /**
+     * Returns the entry with the given hash for which equal(ref) is
+     * true, or an invalid reference if there is none. Safe to call
+     * from reader threads.
+     **/
+    template <typename Equal>
+    EntryRef find(uint32_t hash, const Equal &equal) const {
+        const std::atomic<uint64_t> *table = _table.load(std::memory_order_acquire);
+        uint32_t mask = static_cast<uint32_t>(table[0].load(std::memory_order_relaxed));
+        const std::atomic<uint64_t> *slots = table + 1;
+        for (uint32_t i = hash & mask; ; i = (i + 1) & mask) {
+            uint64_t slot = slots[i].load(std::memory_order_acquire);
+            if (slot == EMPTY) {
+                return EntryRef();
+            }
+            EntryRef ref(static_cast<uint32_t>(slot));
+            if (ref.valid() && static_cast<uint32_t>(slot >> 32) == hash && equal(ref)) {
+                return ref;
+            }
+        }
+    }
+
+    /**
+     * Insert an entry that is not already present.
+     **/
+    void insert(uint32_t hash, EntryRef ref);
+
+    /**
+     * Remove an entry that is present.
+     **/
+    void remove(uint32_t hash, EntryRef ref);
+
+    /**
+     * Replace all entries with the given (hash, ref) pairs. The new
+     * table is published in one step, so readers observe either the
+     * old or the new set of entries.
+     **/
+    void assign(const std::vector<std::pair<uint32_t, EntryRef>> &entries);
+
+    void clear() { assign(std::vector<std::pair<uint32_t, EntryRef>>()); }
+
+    uint32_t size() const { return _used; }
+    MemoryUsage getMemoryUsage() const;
+    void transferHoldLists(generation_t generation) { _genHolder.transferHoldLists(generation); }
+    void trimHoldLists(generation_t firstUsed) { _genHolder.trimHoldLists(firstUsed); }
+};
+
+}
@@ -24,6 +24,33 @@ template <typename> class EnumStoreFoldedComparatorT;
  * Used as template argument for EnumStoreT.
  **/
 
+/**
+ * Used to hash numeric values consistently with the ordering used by
+ * the enum store, i.e. values that compare equal get the same hash.
+ **/
+struct NumericHashHelper
+{
+    static uint32_t mix(uint64_t bits) {
+        return static_cast<uint32_t>((bits * 0x9e3779b97f4a7c15ul) >> 32);
+    }
+    template <typename T>
+    static uint32_t hash(T value) {
+        return mix(static_cast<uint64_t>(static_cast<int64_t>(value)));
+    }
+    static uint32_t hash(float value) { return hash(static_cast<double>(value)); }
+    static uint32_t hash(double value) {
+        if (std::isnan(value)) {
+            return 0u;
+        }
+        if (value == 0.0) {
+            value = 0.0; // -0.0 and 0.0 compare equal
+        }
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return mix(bits);
+    }
+};
+
 template <typename T>
 class NumericEntryType {
 public:
@@ -31,6 +58,7 @@ public:
     static uint32_t size(Type)  { return fixedSize(); }
     static uint32_t fixedSize() { return sizeof(T); }
     static bool hasFold() { return false; }
+    static uint32_t foldedHash(Type value) { return NumericHashHelper::hash(value); }
 };
 
 /**
@@ -43,6 +71,7 @@ public:
     static uint32_t size(Type value) { return strlen(value) + fixedSize(); }
     static uint32_t fixedSize()      { return 1; }
     static bool hasFold() { return true; }
+    static uint32_t foldedHash(Type value) { return FoldedStringCompare().hashFolded(value); }
 };
 
 
@@ -122,6 +151,7 @@ public:
     Type     getValue(uint32_t idx) const { return getValue(Index(datastore::EntryRef(idx))); }
     Type     getValue(Index idx)    const { return getEntry(idx).getValue(); }
     uint32_t getFixedSize() const override { return Entry::fixedSize(); }
+    uint32_t getFoldedHash(Index idx) const override { return EntryType::foldedHash(getValue(idx)); }
 
     static uint32_t
     getEntrySize(Type value)
@@ -262,6 +262,9 @@ EnumStoreT<EntryType>::addEnum(Type value,
 
     // check if already present
     ComparatorType cmp(*this, value);
+    if (_enumDict->hasHashIndex() && _enumDict->findIndex(cmp, newIdx)) {
+        return;
+    }
     DictionaryIterator it(btree::BTreeNode::Ref(), dict.getAllocator());
     it.lower_bound(dict.getRoot(), Index(), cmp);
     if (it.valid() && !cmp(Index(), it.getKey())) {
@@ -278,6 +281,7 @@ EnumStoreT<EntryType>::addEnum(Type value,
 
     // update tree with new index
     dict.insert(it, newIdx, typename Dictionary::DataType());
+    _enumDict->insertHashIndex(newIdx);
 
     // Copy posting list idx from next entry if same
     // folded value.
@@ -374,6 +378,7 @@ EnumStoreT<EntryType>::reset(Builder &builder, Dictionary &dict)
 
     // reset Dictionary
     dict.assign(treeBuilder); // destructive copy of treeBuilder
+    _enumDict->rebuildHashIndex();
 }
 
 
@@ -453,6 +458,8 @@ EnumStoreT<EntryType>::performCompaction(Dictionary &dict)
     if (disabledReEnumerate) {
         newEnum = this->_nextEnum; // use old range of enum values
     }
+    // publish a hash table referencing the moved entries
+    _enumDict->rebuildHashIndex();
     this->postCompact(newEnum);
 }
 
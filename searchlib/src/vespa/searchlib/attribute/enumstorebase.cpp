@@ -317,7 +317,8 @@ vespalib::asciistream & operator << (vespalib::asciistream & os, const EnumStore
 
 
 EnumStoreDictBase::EnumStoreDictBase(EnumStoreBase &enumStore)
-    : _enumStore(enumStore)
+    : _enumStore(enumStore),
+      _hashIndex()
 {
 }
 
@@ -327,6 +328,48 @@ EnumStoreDictBase::~EnumStoreDictBase()
 }
 
 
+void
+EnumStoreDictBase::enableHashIndex()
+{
+    if (!_hashIndex) {
+        _hashIndex.reset(new EnumHashIndex());
+        rebuildHashIndex();
+    }
+}
+
+
+void
+EnumStoreDictBase::insertHashIndex(Index idx)
+{
+    if (_hashIndex) {
+        _hashIndex->insert(_enumStore.getFoldedHash(idx), idx);
+    }
+}
+
+
+bool
+EnumStoreDictBase::findHashIndex(const EnumStoreComparator &cmp,
+                                 Index &idx, bool &found) const
+{
+    uint32_t hash = 0;
+    if (!_hashIndex || !cmp.getFoldedHash(hash)) {
+        return false;
+    }
+    datastore::EntryRef ref =
+        _hashIndex->find(hash,
+                         [&cmp](datastore::EntryRef candidate)
+                         {
+                             Index cidx(candidate);
+                             return !cmp(Index(), cidx) && !cmp(cidx, Index());
+                         });
+    found = ref.valid();
+    if (found) {
+        idx = Index(ref);
+    }
+    return true;
+}
+
+
 template <typename Dictionary>
 EnumStoreDict<Dictionary>::EnumStoreDict(EnumStoreBase &enumStore)
     : EnumStoreDictBase(enumStore),
@@ -359,7 +402,11 @@ template <typename Dictionary>
 MemoryUsage
 EnumStoreDict<Dictionary>::getTreeMemoryUsage() const
 {
-    return _dict.getMemoryUsage();
+    MemoryUsage usage(_dict.getMemoryUsage());
+    if (_hashIndex) {
+        usage.merge(_hashIndex->getMemoryUsage());
+    }
+    return usage;
 }
 
 template <typename Dictionary>
@@ -400,7 +447,11 @@ EnumStoreDict<Dictionary>::deserialize(const void *src,
                                            size_t available,
                                            IndexVector &idx)
 {
-    return _enumStore.deserialize(src, available, idx, _dict);
+    ssize_t sz(_enumStore.deserialize(src, available, idx, _dict));
+    if (sz >= 0) {
+        rebuildHashIndex();
+    }
+    return sz;
 }
 
 
@@ -426,6 +477,9 @@ EnumStoreDict<Dictionary>::removeUnusedEnums(const IndexSet &unused,
          iter != mt; ++iter) {
         it.lower_bound(_dict.getRoot(), *iter, cmp);
         assert(it.valid() && !cmp(*iter, it.getKey()));
+        if (_hashIndex) {
+            _hashIndex->remove(_enumStore.getFoldedHash(*iter), *iter);
+        }
         if (Iterator::hasData() && fcmp != NULL) {
             typename Dictionary::DataType pidx(it.getData());
             _dict.remove(it);
@@ -482,6 +536,10 @@ bool
 EnumStoreDict<Dictionary>::findIndex(const EnumStoreComparator &cmp,
                                      Index &idx) const
 {
+    bool found = false;
+    if (findHashIndex(cmp, idx, found)) {
+        return found;
+    }
     typename Dictionary::Iterator itr = _dict.find(Index(), cmp);
     if (!itr.valid()) {
         return false;
@@ -496,6 +554,10 @@ bool
 EnumStoreDict<Dictionary>::findFrozenIndex(const EnumStoreComparator &cmp,
                                            Index &idx) const
 {
+    bool found = false;
+    if (findHashIndex(cmp, idx, found)) {
+        return found;
+    }
     typename Dictionary::ConstIterator itr =
         _dict.getFrozenView().find(Index(), cmp);
     if (!itr.valid()) {
@@ -506,11 +568,30 @@ EnumStoreDict<Dictionary>::findFrozenIndex(const EnumStoreComparator &cmp,
 }
 
 
+template <typename Dictionary>
+void
+EnumStoreDict<Dictionary>::rebuildHashIndex()
+{
+    if (!_hashIndex) {
+        return;
+    }
+    std::vector<std::pair<uint32_t, datastore::EntryRef>> entries;
+    entries.reserve(_dict.size());
+    for (typename Dictionary::Iterator it(_dict.begin()); it.valid(); ++it) {
+        entries.emplace_back(_enumStore.getFoldedHash(it.getKey()), it.getKey());
+    }
+    _hashIndex->assign(entries);
+}
+
+
 template <typename Dictionary>
 void
 EnumStoreDict<Dictionary>::onReset()
 {
     _dict.clear();
+    if (_hashIndex) {
+        _hashIndex->clear();
+    }
 }
 
 
@@ -519,6 +600,9 @@ void
 EnumStoreDict<Dictionary>::onTransferHoldLists(generation_t generation)
 {
     _dict.getAllocator().transferHoldLists(generation);
+    if (_hashIndex) {
+        _hashIndex->transferHoldLists(generation);
+    }
 }
 
 
@@ -527,6 +611,9 @@ void
 EnumStoreDict<Dictionary>::onTrimHoldLists(generation_t firstUsed)
 {
     _dict.getAllocator().trimHoldLists(firstUsed);
+    if (_hashIndex) {
+        _hashIndex->trimHoldLists(firstUsed);
+    }
 }
 
 
@@ -544,6 +631,11 @@ EnumStoreDict<Dictionary>::
 lookupFrozenTerm(BTreeNode::Ref frozenRootRef,
                  const EnumStoreComparator &comp) const
 {
+    Index idx;
+    bool found = false;
+    if (findHashIndex(comp, idx, found)) {
+        return found ? 1u : 0u;
+    }
     typename Dictionary::ConstIterator itr(BTreeNode::Ref(),
                                            _dict.getAllocator());
     itr.lower_bound(frozenRootRef, Index(), comp);
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "enumhashindex.h"
 #include <vespa/searchcommon/attribute/iattributevector.h>
 #include <vespa/searchlib/common/address_space.h>
 #include <vespa/searchlib/datastore/datastore.h>
@@ -58,11 +59,28 @@ public:
 
 protected:
     EnumStoreBase &_enumStore;
+    std::unique_ptr<EnumHashIndex> _hashIndex;
+
+    /**
+     * Look up the value given by the comparator in the hash index.
+     * Returns false if there is no hash index or the comparator does
+     * not provide a hash, in which case the btree must be used.
+     **/
+    bool findHashIndex(const EnumStoreComparator &cmp, Index &idx, bool &found) const;
 
 public:
     EnumStoreDictBase(EnumStoreBase &enumStore);
     virtual ~EnumStoreDictBase();
 
+    /**
+     * Maintain a hash index for point lookups alongside the btree.
+     **/
+    void enableHashIndex();
+    bool hasHashIndex() const { return static_cast<bool>(_hashIndex); }
+    void insertHashIndex(Index idx);
+    virtual void rebuildHashIndex() = 0;
+    virtual void setHugePages(bool hugePages) = 0;
+
     virtual void freezeTree() = 0;
     virtual uint32_t getNumUniques() const = 0;
     virtual MemoryUsage getTreeMemoryUsage() const = 0;
@@ -131,6 +149,8 @@ public:
 
     bool findIndex(const EnumStoreComparator &cmp, Index &idx) const override;
     bool findFrozenIndex(const EnumStoreComparator &cmp, Index &idx) const override;
+    void rebuildHashIndex() override;
+    void setHugePages(bool hugePages) override { _dict.setHugePages(hugePages); }
     void onReset() override;
     void onTransferHoldLists(generation_t generation) override;
     void onTrimHoldLists(generation_t firstUsed) override;
@@ -264,6 +284,7 @@ public:
     void reset(uint64_t initBufferSize);
 
     virtual uint32_t getFixedSize() const = 0;
+    virtual uint32_t getFoldedHash(Index idx) const = 0;
     size_t getMaxEnumOffset() const {
         return _store.getBufferState(_store.getActiveBufferId(TYPE_ID)).size();
     }
@@ -345,6 +366,11 @@ public:
 
     void fixupRefCounts(const EnumVector &hist) { _enumDict->fixupRefCounts(hist); }
     void freezeTree() { _enumDict->freezeTree(); }
+    void enableHashIndex() { _enumDict->enableHashIndex(); }
+    void setHugePages(bool hugePages) {
+        _store.setHugePages(hugePages);
+        _enumDict->setHugePages(hugePages);
+    }
 
     virtual bool performCompaction(uint64_t bytesNeeded) = 0;
 
@@ -371,6 +397,12 @@ public:
      * Uses the enum store to map from enum index to actual value.
      **/
     virtual bool operator() (const EnumIndex & lhs, const EnumIndex & rhs) const = 0;
+    /**
+     * Sets hash to the folded hash of the value used for an invalid enum
+     * index and returns true if values that are equal according to this
+     * comparator always have equal folded hashes.
+     **/
+    virtual bool getFoldedHash(uint32_t &hash) const { (void) hash; return false; }
 };
 
 
@@ -13,18 +13,22 @@ namespace {
 }
 
 FixedSourceSelector::Iterator::Iterator(const FixedSourceSelector & sourceSelector) :
-    IIterator(sourceSelector._source),
-    _attributeGuard(sourceSelector._realSource)
+    IIterator(sourceSelector._source, sourceSelector._runs),
+    _attributeGuard(sourceSelector._realSource),
+    _runsGuard(sourceSelector._realRuns)
 { }
 
 FixedSourceSelector::FixedSourceSelector(queryeval::Source defaultSource,
                                          const vespalib::string & attrBaseFileName,
                                          uint32_t initialNumDocs) :
     SourceSelector(defaultSource, AttributeVector::SP(new SourceStore(attrBaseFileName, getConfig()))),
-    _source(static_cast<SourceStore &>(*_realSource))
+    _source(static_cast<SourceStore &>(*_realSource)),
+    _realRuns(new SourceStore(attrBaseFileName + ".runs", getConfig())),
+    _runs(static_cast<SourceStore &>(*_realRuns))
 {
     reserve(initialNumDocs);
     _source.commit();
+    _runs.commit();
 }
 
 FixedSourceSelector::~FixedSourceSelector()
@@ -44,6 +48,8 @@ FixedSourceSelector::cloneAndSubtract(const vespalib::string & attrBaseFileName,
         selector->_source.set(docId, src);
     }
     selector->_source.commit();
+    selector->updateRuns(0, selector->_source.getNumDocs());
+    selector->_runs.commit();
     selector->setBaseId(getBaseId() + diff);
     return selector;
 }
@@ -59,6 +65,8 @@ FixedSourceSelector::load(const vespalib::string & baseFileName)
                                              0));
     selector->setBaseId(info->header()._baseId);
     selector->_source.load();
+    selector->updateRuns(0, selector->_source.getNumDocs());
+    selector->_runs.commit();
     return selector;
 }
 
@@ -72,6 +80,31 @@ void FixedSourceSelector::reserve(uint32_t numDocs)
         for (uint32_t i = maxDoc; i < newMaxDocIdPlussOne; ++i) {
             _source.set(i, getDefaultSource());
         }
+        updateRuns(maxDoc, newMaxDocIdPlussOne);
+    }
+}
+
+void
+FixedSourceSelector::updateRuns(uint32_t fromDocId, uint32_t toDocId)
+{
+    if (fromDocId >= toDocId) {
+        return;
+    }
+    const uint32_t numDocs(_source.getNumDocs());
+    const uint32_t firstBlock(fromDocId >> IIterator::RUN_BLOCK_BITS);
+    const uint32_t lastBlock((toDocId - 1) >> IIterator::RUN_BLOCK_BITS);
+    for (uint32_t newBlock(_runs.getNumDocs()); newBlock <= lastBlock; ) {
+        _runs.addDoc(newBlock);
+    }
+    for (uint32_t block = firstBlock; block <= lastBlock; ++block) {
+        const uint32_t begin(block << IIterator::RUN_BLOCK_BITS);
+        const uint32_t end(std::min(begin + (1u << IIterator::RUN_BLOCK_BITS), numDocs));
+        const queryeval::Source source(getSource(begin));
+        uint32_t docId(begin + 1);
+        while ((docId < end) && (getSource(docId) == source)) {
+            ++docId;
+        }
+        _runs.set(block, (docId == end) ? source : IIterator::MIXED_SOURCES);
     }
 }
 
@@ -84,8 +117,18 @@ FixedSourceSelector::setSource(uint32_t docId, queryeval::Source source)
      * far too.
      **/
     reserve(docId+1);
+    const uint32_t block(docId >> IIterator::RUN_BLOCK_BITS);
+    const queryeval::Source run(_runs.getFast(block));
+    if ((run != source) && (run != IIterator::MIXED_SOURCES)) {
+        // Break the run before the source changes, so readers never see a stale run.
+        _runs.set(block, IIterator::MIXED_SOURCES);
+    }
     _source.update(docId, source);
     _source.commit();
+    if (run == IIterator::MIXED_SOURCES) {
+        updateRuns(docId, docId + 1);
+    }
+    _runs.commit();
 }
 
 } // namespace search
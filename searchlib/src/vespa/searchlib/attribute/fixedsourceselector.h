@@ -10,18 +10,24 @@ namespace search {
 class FixedSourceSelector : public SourceSelector
 {
 private:
+    using IIterator = queryeval::sourceselector::Iterator;
+
     SourceStore & _source;
+    AttributeVector::SP _realRuns;
+    // Source per block of documents, see IIterator::getRunEnd
+    SourceStore & _runs;
     queryeval::Source getSource(uint32_t docId) const {
         return _source.getFast(docId);
     }
     void reserve(uint32_t numDocs);
+    void updateRuns(uint32_t fromDocId, uint32_t toDocId);
 
-    using IIterator = queryeval::sourceselector::Iterator;
 public:
     typedef std::unique_ptr<FixedSourceSelector> UP;
     class Iterator : public IIterator {
     private:
         AttributeGuard _attributeGuard;
+        AttributeGuard _runsGuard;
     public:
         Iterator(const FixedSourceSelector & sourceSelector);
     };
@@ -5,10 +5,35 @@
 #include "imported_search_context.h"
 #include "reference_attribute.h"
 #include <vespa/searchlib/query/queryterm.h>
+#include <algorithm>
 
 namespace search {
 namespace attribute {
 
+namespace {
+
+constexpr uint32_t TARGET_LID_BATCH_SIZE = 256;
+
+/*
+ * Maps the lids to target lids a chunk at a time, so the target
+ * attribute can read the values of a whole chunk in one call.
+ */
+template <typename T, typename TargetLids, typename Getter>
+void
+getTargetBatch(const TargetLids &targetLids, const uint32_t *docIds, uint32_t numDocs, T *values, Getter getter)
+{
+    uint32_t targetDocIds[TARGET_LID_BATCH_SIZE];
+    for (uint32_t i = 0; i < numDocs; i += TARGET_LID_BATCH_SIZE) {
+        uint32_t count = std::min(TARGET_LID_BATCH_SIZE, numDocs - i);
+        for (uint32_t j = 0; j < count; ++j) {
+            targetDocIds[j] = targetLids[docIds[i + j]];
+        }
+        getter(targetDocIds, count, values + i);
+    }
+}
+
+}
+
 ImportedAttributeVectorReadGuard::ImportedAttributeVectorReadGuard(
         const ImportedAttributeVector &imported_attribute,
         bool stableEnumGuard)
@@ -59,6 +84,24 @@ IAttributeVector::EnumHandle ImportedAttributeVectorReadGuard::getEnum(DocId doc
     return _target_attribute.getEnum(getTargetLid(doc));
 }
 
+void ImportedAttributeVectorReadGuard::getIntBatch(const DocId *docIds, uint32_t numDocs, largeint_t *values) const {
+    getTargetBatch(_targetLids, docIds, numDocs, values,
+                   [this](const DocId *targetDocIds, uint32_t count, largeint_t *targetValues)
+                   { _target_attribute.getIntBatch(targetDocIds, count, targetValues); });
+}
+
+void ImportedAttributeVectorReadGuard::getFloatBatch(const DocId *docIds, uint32_t numDocs, double *values) const {
+    getTargetBatch(_targetLids, docIds, numDocs, values,
+                   [this](const DocId *targetDocIds, uint32_t count, double *targetValues)
+                   { _target_attribute.getFloatBatch(targetDocIds, count, targetValues); });
+}
+
+void ImportedAttributeVectorReadGuard::getEnumBatch(const DocId *docIds, uint32_t numDocs, EnumHandle *values) const {
+    getTargetBatch(_targetLids, docIds, numDocs, values,
+                   [this](const DocId *targetDocIds, uint32_t count, EnumHandle *targetValues)
+                   { _target_attribute.getEnumBatch(targetDocIds, count, targetValues); });
+}
+
 uint32_t ImportedAttributeVectorReadGuard::get(DocId docId, largeint_t *buffer, uint32_t sz) const {
     return _target_attribute.get(getTargetLid(docId), buffer, sz);
 }
@@ -57,6 +57,9 @@ public:
     virtual double getFloat(DocId doc) const override;
     virtual const char *getString(DocId doc, char *buffer, size_t sz) const override;
     virtual EnumHandle getEnum(DocId doc) const override;
+    void getIntBatch(const DocId *docIds, uint32_t numDocs, largeint_t *values) const override;
+    void getFloatBatch(const DocId *docIds, uint32_t numDocs, double *values) const override;
+    void getEnumBatch(const DocId *docIds, uint32_t numDocs, EnumHandle *values) const override;
     virtual uint32_t get(DocId docId, largeint_t *buffer, uint32_t sz) const override;
     virtual uint32_t get(DocId docId, double *buffer, uint32_t sz) const override;
     virtual uint32_t get(DocId docId, const char **buffer, uint32_t sz) const override;
@@ -43,6 +43,13 @@ public:
         return _children[ref].getData();
     }
 
+    // posting lists in attributes have no block max weights
+    bool has_block_max() const { return false; }
+    uint32_t get_block_max_weight(uint16_t, uint32_t docid, int32_t &max_weight) {
+        max_weight = std::numeric_limits<int32_t>::max();
+        return docid;
+    }
+
     std::unique_ptr<BitVector> get_hits(uint32_t begin_id, uint32_t end_id);
     void or_hits_into(BitVector &result, uint32_t begin_id);
 
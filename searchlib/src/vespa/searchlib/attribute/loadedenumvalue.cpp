@@ -1,20 +1,28 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "loadedenumvalue.h"
+#include <vespa/searchlib/common/parallel_sort.h>
 #include <vespa/searchlib/common/sort.h>
 
 namespace search {
 namespace attribute {
 
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded)
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor)
 {
-    ShiftBasedRadixSorter<LoadedEnumAttribute,
-        LoadedEnumAttribute::EnumRadix,
-        LoadedEnumAttribute::EnumCompare, 56>::
-        radix_sort(LoadedEnumAttribute::EnumRadix(),
-                   LoadedEnumAttribute::EnumCompare(),
-                   &loaded[0], loaded.size(), 16);
+    if (loaded.empty()) {
+        return;
+    }
+    parallelBucketSort(LoadedEnumAttribute::EnumRadix(), &loaded[0], loaded.size(), executor,
+                       [](LoadedEnumAttribute *a, size_t n)
+                       {
+                           ShiftBasedRadixSorter<LoadedEnumAttribute,
+                               LoadedEnumAttribute::EnumRadix,
+                               LoadedEnumAttribute::EnumCompare, 56>::
+                               radix_sort(LoadedEnumAttribute::EnumRadix(),
+                                          LoadedEnumAttribute::EnumCompare(),
+                                          a, n, 16);
+                       });
 }
 
 } // namespace attribute
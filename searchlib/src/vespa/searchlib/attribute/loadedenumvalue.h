@@ -5,6 +5,8 @@
 #include <vespa/vespalib/util/array.h>
 #include <vespa/searchlib/attribute/enumstorebase.h>
 
+namespace vespalib { class Executor; }
+
 namespace search
 {
 
@@ -140,8 +142,13 @@ public:
     }
 };
 
+/**
+ * Sort loaded enum values on enum, then docid. If an executor is
+ * given, large vectors are split on enum ranges which are sorted
+ * concurrently.
+ */
 void
-sortLoadedByEnum(LoadedEnumAttributeVector &loaded);
+sortLoadedByEnum(LoadedEnumAttributeVector &loaded, vespalib::Executor *executor);
 
 } // namespace attribute
 
@@ -28,7 +28,8 @@ public:
     MultiValueMapping(const MultiValueMapping &) = delete;
     MultiValueMapping & operator = (const MultiValueMapping &) = delete;
     MultiValueMapping(const datastore::ArrayStoreConfig &storeCfg,
-                      const GrowStrategy &gs = GrowStrategy());
+                      const GrowStrategy &gs = GrowStrategy(),
+                      const vespalib::alloc::Alloc &initialAlloc = vespalib::alloc::Alloc::alloc());
     virtual ~MultiValueMapping();
     ConstArrayRef get(uint32_t docId) const { return _store.get(_indices[docId]); }
     ConstArrayRef getDataForIdx(EntryRef idx) const { return _store.get(idx); }
@@ -44,8 +45,9 @@ public:
     void prepareLoadFromMultiValue() { _store.setInitializing(true); }
 
     void doneLoadFromMultiValue() { _store.setInitializing(false); }
+    void setHugePages(bool hugePages) { _store.setHugePages(hugePages); }
 
-    virtual void compactWorst(bool compactMemory, bool compactAddressSpace) override;
+    datastore::ICompactionContext::UP startCompactWorst(bool compactMemory, bool compactAddressSpace) override;
 
     virtual AddressSpace getAddressSpaceUsage() const override;
     virtual MemoryUsage getArrayStoreMemoryUsage() const override;
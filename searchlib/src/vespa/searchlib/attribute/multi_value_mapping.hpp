@@ -10,8 +10,9 @@ namespace search {
 namespace attribute {
 
 template <typename EntryT, typename RefT>
-MultiValueMapping<EntryT,RefT>::MultiValueMapping(const datastore::ArrayStoreConfig &storeCfg, const GrowStrategy &gs)
-    : MultiValueMappingBase(gs, _store.getGenerationHolder()),
+MultiValueMapping<EntryT,RefT>::MultiValueMapping(const datastore::ArrayStoreConfig &storeCfg, const GrowStrategy &gs,
+                                                    const vespalib::alloc::Alloc &initialAlloc)
+    : MultiValueMappingBase(gs, _store.getGenerationHolder(), initialAlloc),
       _store(storeCfg)
 {
 }
@@ -19,6 +20,8 @@ MultiValueMapping<EntryT,RefT>::MultiValueMapping(const datastore::ArrayStoreCon
 template <typename EntryT, typename RefT>
 MultiValueMapping<EntryT,RefT>::~MultiValueMapping()
 {
+    // Finish compaction in progress while the store is still alive
+    _compactionContext.reset();
 }
 
 template <typename EntryT, typename RefT>
@@ -47,14 +50,10 @@ MultiValueMapping<EntryT,RefT>::replace(uint32_t docId, ConstArrayRef values)
 }
 
 template <typename EntryT, typename RefT>
-void
-MultiValueMapping<EntryT,RefT>::compactWorst(bool compactMemory, bool compactAddressSpace)
+datastore::ICompactionContext::UP
+MultiValueMapping<EntryT,RefT>::startCompactWorst(bool compactMemory, bool compactAddressSpace)
 {
-    datastore::ICompactionContext::UP compactionContext(_store.compactWorst(compactMemory, compactAddressSpace));
-    if (compactionContext) {
-        compactionContext->compact(vespalib::ArrayRef<EntryRef>(&_indices[0],
-                                                                _indices.size()));
-    }
+    return _store.compactWorst(compactMemory, compactAddressSpace);
 }
 
 template <typename EntryT, typename RefT>
@@ -2,6 +2,7 @@
 
 #include "multi_value_mapping_base.h"
 #include <vespa/searchcommon/common/compaction_strategy.h>
+#include <algorithm>
 
 namespace search {
 namespace attribute {
@@ -15,11 +16,14 @@ constexpr size_t DEAD_CLUSTERS_SLACK = 0x10000u;
 }
 
 MultiValueMappingBase::MultiValueMappingBase(const GrowStrategy &gs,
-                                               vespalib::GenerationHolder &genHolder)
-    : _indices(gs, genHolder),
+                                               vespalib::GenerationHolder &genHolder,
+                                               const vespalib::alloc::Alloc &initialAlloc)
+    : _indices(gs, genHolder, initialAlloc),
       _totalValues(0u),
       _cachedArrayStoreMemoryUsage(),
-      _cachedArrayStoreAddressSpaceUsage(0, 0, (1ull << 32))
+      _cachedArrayStoreAddressSpaceUsage(0, 0, (1ull << 32)),
+      _compactionContext(),
+      _compactCursor(0u)
 {
 }
 
@@ -84,9 +88,46 @@ MultiValueMappingBase::updateStat()
     return retval;
 }
 
+void
+MultiValueMappingBase::compactStep(uint32_t maxRefs)
+{
+    uint32_t limit = _indices.size();
+    uint32_t begin = std::min(_compactCursor, limit);
+    uint32_t end = limit;
+    if (maxRefs != 0u && maxRefs < end - begin) {
+        end = begin + maxRefs;
+    }
+    if (end > begin) {
+        _compactionContext->compact(vespalib::ArrayRef<EntryRef>(&_indices[begin], end - begin));
+    }
+    _compactCursor = end;
+    if (end >= limit) {
+        // All refs have been moved, compacted buffers are put on hold
+        _compactionContext.reset();
+        _compactCursor = 0u;
+    }
+}
+
+void
+MultiValueMappingBase::compactWorst(bool compactMemory, bool compactAddressSpace)
+{
+    if (_compactionContext) {
+        compactStep(0u);
+    }
+    _compactionContext = startCompactWorst(compactMemory, compactAddressSpace);
+    _compactCursor = 0u;
+    if (_compactionContext) {
+        compactStep(0u);
+    }
+}
+
 bool
 MultiValueMappingBase::considerCompact(const CompactionStrategy &compactionStrategy)
 {
+    if (_compactionContext) {
+        compactStep(compactionStrategy.getMaxCompactRefsPerStep());
+        return true;
+    }
     size_t usedBytes = _cachedArrayStoreMemoryUsage.usedBytes();
     size_t deadBytes = _cachedArrayStoreMemoryUsage.deadBytes();
     size_t usedClusters = _cachedArrayStoreAddressSpaceUsage.used();
@@ -96,7 +137,11 @@ MultiValueMappingBase::considerCompact(const CompactionStrategy &compactionStrat
     bool compactAddressSpace = ((deadClusters >= DEAD_CLUSTERS_SLACK) &&
                                 (usedClusters * compactionStrategy.getMaxDeadAddressSpaceRatio() < deadClusters));
     if (compactMemory || compactAddressSpace) {
-        compactWorst(compactMemory, compactAddressSpace);
+        _compactionContext = startCompactWorst(compactMemory, compactAddressSpace);
+        _compactCursor = 0u;
+        if (_compactionContext) {
+            compactStep(compactionStrategy.getMaxCompactRefsPerStep());
+        }
         return true;
     }
     return false;
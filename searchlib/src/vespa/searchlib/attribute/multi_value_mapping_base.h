@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/searchlib/datastore/entryref.h>
+#include <vespa/searchlib/datastore/i_compaction_context.h>
 #include <vespa/searchlib/common/rcuvector.h>
 #include <vespa/searchlib/common/address_space.h>
 #include <functional>
@@ -27,13 +28,18 @@ protected:
     size_t    _totalValues;
     MemoryUsage _cachedArrayStoreMemoryUsage;
     AddressSpace _cachedArrayStoreAddressSpaceUsage;
+    // Compaction in progress moves refs in [_compactCursor, size())
+    datastore::ICompactionContext::UP _compactionContext;
+    uint32_t  _compactCursor;
 
-    MultiValueMappingBase(const GrowStrategy &gs, vespalib::GenerationHolder &genHolder);
+    MultiValueMappingBase(const GrowStrategy &gs, vespalib::GenerationHolder &genHolder,
+                          const vespalib::alloc::Alloc &initialAlloc = vespalib::alloc::Alloc::alloc());
     virtual ~MultiValueMappingBase();
 
     void updateValueCount(size_t oldValues, size_t newValues) {
         _totalValues += newValues - oldValues;
     }
+    void compactStep(uint32_t maxRefs);
 public:
     using RefCopyVector = vespalib::Array<EntryRef>;
 
@@ -53,8 +59,24 @@ public:
 
     uint32_t getNumKeys() const { return _indices.size(); }
     uint32_t getCapacityKeys() const { return _indices.capacity(); }
-    virtual void compactWorst(bool compatMemory, bool compactAddressSpace) = 0;
+    virtual datastore::ICompactionContext::UP startCompactWorst(bool compactMemory, bool compactAddressSpace) = 0;
+
+    /**
+     * Compact the worst buffers, moving all refs at once. Finishes any
+     * compaction in progress first.
+     */
+    void compactWorst(bool compactMemory, bool compactAddressSpace);
+
+    /**
+     * Start compacting the worst buffers if there is too much dead
+     * memory or address space, or continue a compaction in progress.
+     * At most compactionStrategy.getMaxCompactRefsPerStep() refs are
+     * moved per call, and the compacted buffers are put on hold when
+     * the cursor has passed all documents.
+     */
     bool considerCompact(const CompactionStrategy &compactionStrategy);
+    bool compactInProgress() const { return static_cast<bool>(_compactionContext); }
+    uint32_t getCompactCursor() const { return _compactCursor; }
 };
 
 } // namespace search::attribute
@@ -198,6 +198,18 @@ public:
         (void) doc;
         return std::numeric_limits<uint32_t>::max(); // does not have enum
     }
+    void getIntBatch(const DocId * docIds, uint32_t numDocs, largeint_t * values) const override {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            MultiValueArrayRef docValues(this->_mvMapping.get(docIds[i]));
+            values[i] = static_cast<largeint_t>((docValues.size() > 0) ? docValues[0].value() : T());
+        }
+    }
+    void getFloatBatch(const DocId * docIds, uint32_t numDocs, double * values) const override {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            MultiValueArrayRef docValues(this->_mvMapping.get(docIds[i]));
+            values[i] = static_cast<double>((docValues.size() > 0) ? docValues[0].value() : T());
+        }
+    }
     uint32_t getAll(DocId doc, T * v, uint32_t sz) const override {
         return getHelper(doc, v, sz);
     }
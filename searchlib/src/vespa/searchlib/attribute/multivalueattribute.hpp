@@ -22,8 +22,12 @@ MultiValueAttribute(const vespalib::string &baseFileName,
                                                                multivalueattribute::SMALL_MEMORY_PAGE_SIZE,
                                                                8 * 1024,
                                                                cfg.getGrowStrategy().getMultiValueAllocGrowFactor()),
-                 cfg.getGrowStrategy())
+                 cfg.getGrowStrategy(),
+                 AttributeVector::getInitialAlloc(cfg))
 {
+    if (cfg.hugePages()) {
+        _mvMapping.setHugePages(true);
+    }
 }
 
 template <typename B, typename M>
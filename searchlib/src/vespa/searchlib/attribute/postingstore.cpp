@@ -75,6 +75,9 @@ PostingStore<DataT>::PostingStore(EnumPostingTree &dict, Status &status,
 {
     // TODO: Add type for bitvector
     _store.addType(&_bvType);
+    if (config.hugePages()) {
+        this->setHugePages(true);
+    }
     _store.initActiveBuffers();
     _store.enableFreeLists();
 }
@@ -5,6 +5,7 @@
 #include <vespa/fastlib/io/bufferedfile.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/searchlib/util/filesizecalculator.h>
+#include <unistd.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".search.attribute.readerbase");
@@ -130,6 +131,19 @@ extractFileSize(const vespalib::GenericHeader &header,
 }
 
 
+bool
+ReaderBase::canMapData() const
+{
+    return hasData() && ((_datHeaderLen % getpagesize()) == 0);
+}
+
+vespalib::alloc::Alloc
+ReaderBase::mapData() const
+{
+    return vespalib::alloc::Alloc::allocMMapFile(_datFile->GetFileName(), _datHeaderLen,
+                                              _datFileSize - _datHeaderLen);
+}
+
 void
 ReaderBase::rewind()
 {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/searchlib/util/fileutil.h>
+#include <vespa/vespalib/util/alloc.h>
 #include <cassert>
 
 namespace search {
@@ -47,6 +48,18 @@ public:
     const vespalib::GenericHeader &getDatHeader() const {
         return _datHeader;
     }
+
+    /**
+     * Returns whether the data in the dat file starts at a page
+     * boundary, which is required to map it.
+     */
+    bool canMapData() const;
+
+    /**
+     * Map the data in the dat file into private memory. Pages are
+     * shared with the page cache until they are modified.
+     */
+    vespalib::alloc::Alloc mapData() const;
 protected:
     std::unique_ptr<FastOS_FileInterface>  _datFile;
 private:
@@ -117,6 +117,11 @@ public:
     EnumHandle getEnum(DocId doc) const override {
        return getE(doc);
     }
+    void getEnumBatch(const DocId * docIds, uint32_t numDocs, EnumHandle * values) const override {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            values[i] = getE(docIds[i]);
+        }
+    }
     uint32_t get(DocId doc, EnumHandle * e, uint32_t sz) const override {
         if (sz > 0) {
             e[0] = getE(doc);
@@ -5,6 +5,7 @@
 #include "integerbase.h"
 #include "floatbase.h"
 #include <vespa/searchlib/common/rcuvector.h>
+#include <vespa/vespalib/stllike/hash_set.h>
 #include <limits>
 
 namespace search {
@@ -27,6 +28,20 @@ private:
     typedef attribute::RcuVectorBase<T> DataVector;
     DataVector _data;
 
+    // Docs changed since the last full save or load, written by delta saves.
+    static constexpr uint32_t MinTrackedChangedDocs = 1024;
+    vespalib::hash_set<DocId> _changedDocs;
+    uint64_t _changedDocsBaseSerialNum;
+    uint32_t _changedDocsBaseDocIdLimit;
+    bool _trackChangedDocs;
+
+    void resetChangedDocs(bool track);
+    void noteChangedDoc(DocId doc) {
+        if (_trackChangedDocs) {
+            _changedDocs.insert(doc);
+        }
+    }
+
     T getFromEnum(EnumHandle e) const override {
         (void) e;
         return T();
@@ -133,6 +148,16 @@ public:
     double getFloat(DocId doc) const override {
         return static_cast<double>(_data[doc]);
     }
+    void getIntBatch(const DocId * docIds, uint32_t numDocs, largeint_t * values) const override {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            values[i] = static_cast<largeint_t>(_data[docIds[i]]);
+        }
+    }
+    void getFloatBatch(const DocId * docIds, uint32_t numDocs, double * values) const override {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            values[i] = static_cast<double>(_data[docIds[i]]);
+        }
+    }
     uint32_t getEnum(DocId doc) const override {
         (void) doc;
         return std::numeric_limits<uint32_t>::max(); // does not have enum
@@ -179,6 +204,7 @@ public:
     void clearDocs(DocId lidLow, DocId lidLimit) override;
     void onShrinkLidSpace() override;
     std::unique_ptr<AttributeSaver> onInitSave() override;
+    std::unique_ptr<AttributeSaver> onInitDeltaSave(uint64_t baseSerialNum, uint32_t maxChangedDocs) override;
 };
 
 }
@@ -8,6 +8,7 @@
 #include "primitivereader.h"
 #include "attributeiterators.hpp"
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <algorithm>
 
 namespace search {
 
@@ -18,7 +19,12 @@ SingleValueNumericAttribute(const vespalib::string & baseFileName, const Attribu
     _data(c.getGrowStrategy().getDocsInitialCapacity(),
           c.getGrowStrategy().getDocsGrowPercent(),
           c.getGrowStrategy().getDocsGrowDelta(),
-          getGenerationHolder())
+          getGenerationHolder(),
+          AttributeVector::getInitialAlloc(c)),
+    _changedDocs(),
+    _changedDocsBaseSerialNum(0),
+    _changedDocsBaseDocIdLimit(0),
+    _trackChangedDocs(false)
 { }
 
 template <typename B>
@@ -40,15 +46,23 @@ SingleValueNumericAttribute<B>::onCommit()
             if (change._type == ChangeBase::UPDATE) {
                 std::atomic_thread_fence(std::memory_order_release);
                 _data[change._doc] = change._data;
+                noteChangedDoc(change._doc);
             } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
                 std::atomic_thread_fence(std::memory_order_release);
                 _data[change._doc] = this->applyArithmetic(_data[change._doc], change);
+                noteChangedDoc(change._doc);
             } else if (change._type == ChangeBase::CLEARDOC) {
                 std::atomic_thread_fence(std::memory_order_release);
                 _data[change._doc] = this->_defaultValue._data;
+                noteChangedDoc(change._doc);
             }
         }
     }
+    if (_trackChangedDocs &&
+        _changedDocs.size() > std::max(MinTrackedChangedDocs, this->getCommittedDocIdLimit() / 4)) {
+        // A delta this large is not worth writing, next save will be a full save.
+        resetChangedDocs(false);
+    }
 
     std::atomic_thread_fence(std::memory_order_release);
     this->removeAllOldGenerations();
@@ -119,6 +133,7 @@ SingleValueNumericAttribute<B>::onLoadEnumerated(ReaderBase &attrReader)
                                    udatBuffer->size() / sizeof(T));
     attribute::loadFromEnumeratedSingleValue(_data, getGenerationHolder(), attrReader,
                                              map, attribute::NoSaveLoadedEnum());
+    resetChangedDocs(true);
     return true;
 }
 
@@ -141,13 +156,19 @@ SingleValueNumericAttribute<B>::onLoad()
     const size_t sz(attrReader.getDataCount());
     getGenerationHolder().clearHoldLists();
     _data.reset();
-    _data.unsafe_reserve(sz);
-    for (uint32_t i = 0; i < sz; ++i) {
-        _data.push_back(attrReader.getNextData());
+    if (this->getConfig().mmapLoad() && attrReader.canMapData()) {
+        // Values are used in place, updated pages are copied on write
+        _data.unsafe_assign(attrReader.mapData(), sz);
+    } else {
+        _data.unsafe_reserve(sz);
+        for (uint32_t i = 0; i < sz; ++i) {
+            _data.push_back(attrReader.getNextData());
+        }
     }
 
     B::setNumDocs(sz);
     B::setCommittedDocIdLimit(sz);
+    resetChangedDocs(true);
 
     return true;
 }
@@ -188,6 +209,17 @@ SingleValueNumericAttribute<B>::onShrinkLidSpace()
     assert(_data.size() >= committedDocIdLimit);
     _data.shrink(committedDocIdLimit);
     this->setNumDocs(committedDocIdLimit);
+    resetChangedDocs(false);
+}
+
+template <typename B>
+void
+SingleValueNumericAttribute<B>::resetChangedDocs(bool track)
+{
+    _changedDocs.clear();
+    _changedDocsBaseSerialNum = this->getStatus().getLastSyncToken();
+    _changedDocsBaseDocIdLimit = this->getCommittedDocIdLimit();
+    _trackChangedDocs = track;
 }
 
 template <typename B>
@@ -196,10 +228,42 @@ SingleValueNumericAttribute<B>::onInitSave()
 {
     const uint32_t numDocs(this->getCommittedDocIdLimit());
     assert(numDocs <= _data.size());
+    resetChangedDocs(true);
     return std::make_unique<SingleValueNumericAttributeSaver>
         (this->createAttributeHeader(), &_data[0], numDocs * sizeof(T));
 }
 
+template <typename B>
+std::unique_ptr<AttributeSaver>
+SingleValueNumericAttribute<B>::onInitDeltaSave(uint64_t baseSerialNum, uint32_t maxChangedDocs)
+{
+    const uint32_t numDocs(this->getCommittedDocIdLimit());
+    if (!_trackChangedDocs || baseSerialNum != _changedDocsBaseSerialNum ||
+        _changedDocs.size() > maxChangedDocs || numDocs < _changedDocsBaseDocIdLimit) {
+        return std::unique_ptr<AttributeSaver>();
+    }
+    std::vector<DocId> lids;
+    lids.reserve(_changedDocs.size());
+    for (DocId lid : _changedDocs) {
+        if (lid < numDocs) {
+            lids.push_back(lid);
+        }
+    }
+    std::sort(lids.begin(), lids.end());
+    // All changed lids followed by their values
+    std::vector<char> buf(lids.size() * (sizeof(DocId) + sizeof(T)));
+    char *values = buf.data() + lids.size() * sizeof(DocId);
+    if (!lids.empty()) {
+        memcpy(buf.data(), &lids[0], lids.size() * sizeof(DocId));
+    }
+    for (size_t i = 0; i < lids.size(); ++i) {
+        T value = _data[lids[i]];
+        memcpy(values + i * sizeof(T), &value, sizeof(T));
+    }
+    return std::make_unique<SingleValueNumericAttributeSaver>
+        (this->createAttributeHeader(this->getBaseFileName() + ".delta"), buf.data(), buf.size());
+}
+
 template <typename B>
 template <typename M>
 bool SingleValueNumericAttribute<B>::SingleSearchContext<M>::valid() const { return M::isValid(); }
@@ -116,6 +116,16 @@ public:
     double getFloat(DocId doc) const override {
         return static_cast<double>(get(doc));
     }
+    void getIntBatch(const DocId * docIds, uint32_t numDocs, largeint_t * values) const override {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            values[i] = static_cast<largeint_t>(this->_enumStore.getValue(this->_enumIndices[docIds[i]]));
+        }
+    }
+    void getFloatBatch(const DocId * docIds, uint32_t numDocs, double * values) const override {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            values[i] = static_cast<double>(this->_enumStore.getValue(this->_enumIndices[docIds[i]]));
+        }
+    }
     uint32_t getAll(DocId doc, T * v, uint32_t sz) const override {
         if (sz > 0) {
             v[0] = get(doc);
@@ -0,0 +1,13 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "singlepackedintegerattribute.h"
+#include "singlepackedintegerattribute.hpp"
+
+namespace search {
+
+template class SingleValuePackedIntegerAttribute<IntegerAttributeTemplate<int8_t> >;
+template class SingleValuePackedIntegerAttribute<IntegerAttributeTemplate<int16_t> >;
+template class SingleValuePackedIntegerAttribute<IntegerAttributeTemplate<int32_t> >;
+template class SingleValuePackedIntegerAttribute<IntegerAttributeTemplate<int64_t> >;
+
+} // namespace search
@@ -0,0 +1,237 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "integerbase.h"
+#include <vespa/searchlib/common/rcuvector.h>
+#include <vespa/searchcommon/common/undefinedvalues.h>
+#include <limits>
+
+namespace search {
+
+/**
+ * Single value integer attribute storing its values frame-of-reference
+ * encoded in blocks of 64 documents. Each block holds a base value and
+ * a bit width, followed by the difference from the base for each
+ * document packed into 64-bit words. Bit widths are powers of two, so
+ * a value never straddles two words. When a block contains undefined
+ * values, the all-ones code is reserved for them.
+ *
+ * Blocks are immutable towards readers except for single word stores.
+ * A value that does not fit in its block causes the block to be
+ * encoded again into a new allocation. The old block is put on hold
+ * in the generation holder until no reader can observe it.
+ **/
+template <typename B>
+class SingleValuePackedIntegerAttribute : public B
+{
+private:
+    typedef typename B::BaseType      T;
+    typedef typename B::DocId         DocId;
+    typedef typename B::EnumHandle    EnumHandle;
+    typedef typename B::largeint_t    largeint_t;
+    typedef typename B::Weighted      Weighted;
+    typedef typename B::WeightedInt   WeightedInt;
+    typedef typename B::WeightedFloat WeightedFloat;
+    typedef typename B::WeightedEnum  WeightedEnum;
+    typedef typename B::generation_t generation_t;
+    typedef typename std::make_unsigned<T>::type U;
+    using B::getGenerationHolder;
+
+    static constexpr uint32_t BLOCK_SHIFT = 6;
+    static constexpr uint32_t BLOCK_SIZE = 1u << BLOCK_SHIFT;
+    static constexpr uint32_t BLOCK_MASK = BLOCK_SIZE - 1;
+    static constexpr uint32_t FULL_WIDTH = 8 * sizeof(T);
+    static constexpr uint32_t HEADER_WORDS = 2;
+    static constexpr uint64_t RESERVED_FLAG = 0x100;
+
+    class BlockHeld;
+
+    typedef attribute::RcuVectorBase<uint64_t *> BlockVector;
+    BlockVector _blocks;
+    size_t      _blockBytes;
+
+    static uint32_t width(const uint64_t *block) { return block[1] & 0xff; }
+    static bool hasReserved(const uint64_t *block) { return (block[1] & RESERVED_FLAG) != 0; }
+    static uint64_t codeMask(uint32_t w) { return (w == 64) ? ~uint64_t(0) : ((uint64_t(1) << w) - 1); }
+    static T fromCode(uint64_t base, uint64_t code) { return static_cast<T>(static_cast<U>(base + code)); }
+
+    static T decodeValue(const uint64_t *block, uint32_t idx) {
+        uint32_t w = width(block);
+        if (w == 0) {
+            return static_cast<T>(block[0]);
+        }
+        uint64_t mask = codeMask(w);
+        uint32_t bit = idx * w;
+        uint64_t code = (block[HEADER_WORDS + (bit >> 6)] >> (bit & 63)) & mask;
+        if (hasReserved(block) && (code == mask)) {
+            return attribute::getUndefined<T>();
+        }
+        return fromCode(block[0], code);
+    }
+
+    template <uint32_t W>
+    static void decodeCodes(const uint64_t *block, T *values);
+    static void decodeBlock(const uint64_t *block, T *values);
+    static size_t blockBytes(const uint64_t *block) { return (HEADER_WORDS + width(block)) * sizeof(uint64_t); }
+
+    uint64_t *encodeBlock(const T *values);
+    uint64_t *createUndefinedBlock();
+    void holdBlock(uint64_t *block);
+    void freeBlocks();
+    bool setValue(DocId doc, T v);
+
+    T getFromEnum(EnumHandle e) const override {
+        (void) e;
+        return T();
+    }
+
+    /*
+     * Specialization of SearchContext
+     */
+    class SingleSearchContext : public NumericAttribute::Range<T>, public AttributeVector::SearchContext
+    {
+    private:
+        const uint64_t * const * _blocks;
+
+        int32_t onFind(DocId docId, int32_t elemId, int32_t & weight) const override {
+            return find(docId, elemId, weight);
+        }
+
+        int32_t onFind(DocId docId, int elemId) const override {
+            return find(docId, elemId);
+        }
+
+        bool valid() const override;
+
+    public:
+        SingleSearchContext(std::unique_ptr<QueryTermSimple> qTerm, const NumericAttribute & toBeSearched);
+        int32_t find(DocId docId, int32_t elemId, int32_t & weight) const {
+            if ( elemId != 0) return -1;
+            const T v = decodeValue(_blocks[docId >> BLOCK_SHIFT], docId & BLOCK_MASK);
+            weight = 1;
+            return this->match(v) ? 0 : -1;
+        }
+
+        int32_t find(DocId docId, int elemId) const {
+            if ( elemId != 0) return -1;
+            const T v = decodeValue(_blocks[docId >> BLOCK_SHIFT], docId & BLOCK_MASK);
+            return this->match(v) ? 0 : -1;
+        }
+
+        /**
+         * Find the first matching document in [docId, endId), or
+         * endId if there is none. Blocks with a value range outside
+         * or inside the query range are decided without decoding, the
+         * others are decoded and matched a block at a time.
+         **/
+        uint32_t findNextMatch(uint32_t docId, uint32_t endId) const;
+
+        Int64Range getAsIntegerTerm() const override;
+
+        std::unique_ptr<queryeval::SearchIterator>
+        createFilterIterator(fef::TermFieldMatchData * matchData, bool strict) override;
+    };
+
+protected:
+    bool findEnum(T value, EnumHandle & e) const override {
+        (void) value; (void) e;
+        return false;
+    }
+
+public:
+    SingleValuePackedIntegerAttribute(const vespalib::string & baseFileName,
+                                      const AttributeVector::Config & c =
+                                      AttributeVector::Config(AttributeVector::
+                                              BasicType::fromType(T()),
+                                              attribute::CollectionType::SINGLE));
+
+    ~SingleValuePackedIntegerAttribute();
+
+    uint32_t getValueCount(DocId doc) const override {
+        if (doc >= B::getNumDocs()) {
+            return 0;
+        }
+        return 1;
+    }
+    void onCommit() override;
+    void onAddDocs(DocId lidLimit) override;
+    void onUpdateStat() override;
+    void removeOldGenerations(generation_t firstUsed) override;
+    void onGenerationChange(generation_t generation) override;
+    bool addDoc(DocId & doc) override;
+    bool onLoad() override;
+
+    AttributeVector::SearchContext::UP
+    getSearch(std::unique_ptr<QueryTermSimple> term, const attribute::SearchContextParams & params) const override;
+
+    T getFast(DocId doc) const {
+        return decodeValue(_blocks[doc >> BLOCK_SHIFT], doc & BLOCK_MASK);
+    }
+
+    //-------------------------------------------------------------------------
+    // new read api
+    //-------------------------------------------------------------------------
+    T get(DocId doc) const override {
+        return getFast(doc);
+    }
+    largeint_t getInt(DocId doc) const override {
+        return static_cast<largeint_t>(getFast(doc));
+    }
+    void getEnumValue(const EnumHandle * v, uint32_t *e, uint32_t sz) const override {
+        (void) v;
+        (void) e;
+        (void) sz;
+    }
+    double getFloat(DocId doc) const override {
+        return static_cast<double>(getFast(doc));
+    }
+    uint32_t getEnum(DocId doc) const override {
+        (void) doc;
+        return std::numeric_limits<uint32_t>::max(); // does not have enum
+    }
+    uint32_t getAll(DocId doc, T * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = getFast(doc);
+        return 1;
+    }
+    uint32_t get(DocId doc, largeint_t * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = static_cast<largeint_t>(getFast(doc));
+        return 1;
+    }
+    uint32_t get(DocId doc, double * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = static_cast<double>(getFast(doc));
+        return 1;
+    }
+    uint32_t get(DocId doc, EnumHandle * e, uint32_t sz) const override {
+        (void) sz;
+        e[0] = getEnum(doc);
+        return 1;
+    }
+    uint32_t getAll(DocId doc, Weighted * v, uint32_t sz) const override {
+        (void) doc; (void) v; (void) sz;
+        return 0;
+    }
+    uint32_t get(DocId doc, WeightedInt * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = WeightedInt(static_cast<largeint_t>(getFast(doc)));
+        return 1;
+    }
+    uint32_t get(DocId doc, WeightedFloat * v, uint32_t sz) const override {
+        (void) sz;
+        v[0] = WeightedFloat(static_cast<double>(getFast(doc)));
+        return 1;
+    }
+    uint32_t get(DocId doc, WeightedEnum * e, uint32_t sz) const override {
+        (void) doc; (void) e; (void) sz;
+        return 0;
+    }
+
+    void clearDocs(DocId lidLow, DocId lidLimit) override;
+    void onShrinkLidSpace() override;
+    std::unique_ptr<AttributeSaver> onInitSave() override;
+};
+
+}
@@ -0,0 +1,508 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "singlepackedintegerattribute.h"
+#include "attributevector.hpp"
+#include "singlenumericattributesaver.h"
+#include "primitivereader.h"
+#include "attributeiterators.hpp"
+#include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/vespalib/util/arrayref.h>
+#include <vespa/vespalib/util/optimized.h>
+
+namespace search {
+
+template <typename B>
+class SingleValuePackedIntegerAttribute<B>::BlockHeld : public vespalib::GenerationHeldBase
+{
+    uint64_t *_block;
+public:
+    BlockHeld(uint64_t *block)
+        : GenerationHeldBase(blockBytes(block)),
+          _block(block)
+    { }
+    ~BlockHeld() override { delete [] _block; }
+};
+
+template <typename B>
+SingleValuePackedIntegerAttribute<B>::
+SingleValuePackedIntegerAttribute(const vespalib::string & baseFileName, const AttributeVector::Config & c) :
+    B(baseFileName, c),
+    _blocks((c.getGrowStrategy().getDocsInitialCapacity() >> BLOCK_SHIFT) + 1,
+            c.getGrowStrategy().getDocsGrowPercent(),
+            (c.getGrowStrategy().getDocsGrowDelta() >> BLOCK_SHIFT) + 1,
+            getGenerationHolder()),
+    _blockBytes(0)
+{ }
+
+template <typename B>
+SingleValuePackedIntegerAttribute<B>::~SingleValuePackedIntegerAttribute()
+{
+    getGenerationHolder().clearHoldLists();
+    freeBlocks();
+}
+
+template <typename B>
+template <uint32_t W>
+void
+SingleValuePackedIntegerAttribute<B>::decodeCodes(const uint64_t *block, T *values)
+{
+    constexpr uint32_t PER_WORD = 64 / W;
+    const uint64_t mask = codeMask(W);
+    const uint64_t base = block[0];
+    const uint64_t *words = block + HEADER_WORDS;
+    if (hasReserved(block)) {
+        const T undefined = attribute::getUndefined<T>();
+        for (uint32_t i = 0; i < BLOCK_SIZE; ++i) {
+            uint64_t code = (words[i / PER_WORD] >> ((i % PER_WORD) * W)) & mask;
+            values[i] = (code == mask) ? undefined : fromCode(base, code);
+        }
+    } else {
+        for (uint32_t i = 0; i < BLOCK_SIZE; ++i) {
+            values[i] = fromCode(base, (words[i / PER_WORD] >> ((i % PER_WORD) * W)) & mask);
+        }
+    }
+}
+
+template <typename B>
+void
+SingleValuePackedIntegerAttribute<B>::decodeBlock(const uint64_t *block, T *values)
+{
+    switch (width(block)) {
+    case 0:
+        std::fill(values, values + BLOCK_SIZE, static_cast<T>(block[0]));
+        break;
+    case 1:
+        decodeCodes<1>(block, values);
+        break;
+    case 2:
+        decodeCodes<2>(block, values);
+        break;
+    case 4:
+        decodeCodes<4>(block, values);
+        break;
+    case 8:
+        decodeCodes<8>(block, values);
+        break;
+    case 16:
+        decodeCodes<16>(block, values);
+        break;
+    case 32:
+        decodeCodes<32>(block, values);
+        break;
+    default:
+        decodeCodes<64>(block, values);
+        break;
+    }
+}
+
+template <typename B>
+uint64_t *
+SingleValuePackedIntegerAttribute<B>::encodeBlock(const T *values)
+{
+    const T undefined = attribute::getUndefined<T>();
+    T minValue = std::numeric_limits<T>::max();
+    T maxValue = std::numeric_limits<T>::min();
+    bool hasUndefined = false;
+    for (uint32_t i = 0; i < BLOCK_SIZE; ++i) {
+        if (values[i] == undefined) {
+            hasUndefined = true;
+        } else {
+            minValue = std::min(minValue, values[i]);
+            maxValue = std::max(maxValue, values[i]);
+        }
+    }
+    uint32_t w = 0;
+    uint64_t base = static_cast<U>(minValue);
+    bool reserved = false;
+    if (minValue > maxValue) {
+        base = static_cast<U>(undefined);
+    } else if (hasUndefined || (minValue != maxValue)) {
+        uint64_t needed = static_cast<U>(static_cast<U>(maxValue) - static_cast<U>(minValue));
+        needed += (hasUndefined ? 1 : 0);
+        w = 1;
+        while ((w < FULL_WIDTH) && ((needed >> w) != 0)) {
+            w <<= 1;
+        }
+        if (w < FULL_WIDTH) {
+            reserved = hasUndefined;
+        } else {
+            w = FULL_WIDTH;
+            base = 0;
+        }
+    }
+    uint64_t *block = new uint64_t[HEADER_WORDS + w]();
+    block[0] = base;
+    block[1] = w | (reserved ? RESERVED_FLAG : 0);
+    if (w != 0) {
+        const uint64_t mask = codeMask(w);
+        uint64_t *words = block + HEADER_WORDS;
+        for (uint32_t i = 0; i < BLOCK_SIZE; ++i) {
+            uint64_t code = (reserved && (values[i] == undefined))
+                            ? mask
+                            : static_cast<U>(static_cast<U>(values[i]) - static_cast<U>(base));
+            uint32_t bit = i * w;
+            words[bit >> 6] |= code << (bit & 63);
+        }
+    }
+    _blockBytes += blockBytes(block);
+    return block;
+}
+
+template <typename B>
+uint64_t *
+SingleValuePackedIntegerAttribute<B>::createUndefinedBlock()
+{
+    uint64_t *block = new uint64_t[HEADER_WORDS];
+    block[0] = static_cast<U>(attribute::getUndefined<T>());
+    block[1] = 0;
+    _blockBytes += blockBytes(block);
+    return block;
+}
+
+template <typename B>
+void
+SingleValuePackedIntegerAttribute<B>::holdBlock(uint64_t *block)
+{
+    _blockBytes -= blockBytes(block);
+    getGenerationHolder().hold(std::make_unique<BlockHeld>(block));
+}
+
+template <typename B>
+void
+SingleValuePackedIntegerAttribute<B>::freeBlocks()
+{
+    for (size_t i = 0; i < _blocks.size(); ++i) {
+        delete [] _blocks[i];
+    }
+    _blocks.reset();
+    _blockBytes = 0;
+}
+
+template <typename B>
+bool
+SingleValuePackedIntegerAttribute<B>::setValue(DocId doc, T v)
+{
+    uint64_t *block = _blocks[doc >> BLOCK_SHIFT];
+    uint32_t idx = doc & BLOCK_MASK;
+    uint32_t w = width(block);
+    if (w != 0) {
+        const uint64_t mask = codeMask(w);
+        const bool reserved = hasReserved(block);
+        bool fits;
+        uint64_t code;
+        if (w == FULL_WIDTH) {
+            fits = true;
+            code = static_cast<U>(v);
+        } else if (reserved && (v == attribute::getUndefined<T>())) {
+            fits = true;
+            code = mask;
+        } else {
+            code = static_cast<U>(static_cast<U>(v) - static_cast<U>(block[0]));
+            fits = (v >= fromCode(block[0], 0)) && (reserved ? (code < mask) : (code <= mask));
+        }
+        if (fits) {
+            uint32_t bit = idx * w;
+            uint64_t &word = block[HEADER_WORDS + (bit >> 6)];
+            word = (word & ~(mask << (bit & 63))) | (code << (bit & 63));
+            return false;
+        }
+    } else if (v == fromCode(block[0], 0)) {
+        return false;
+    }
+    T values[BLOCK_SIZE];
+    decodeBlock(block, values);
+    values[idx] = v;
+    uint64_t *newBlock = encodeBlock(values);
+    std::atomic_thread_fence(std::memory_order_release);
+    _blocks[doc >> BLOCK_SHIFT] = newBlock;
+    holdBlock(block);
+    return true;
+}
+
+template <typename B>
+void
+SingleValuePackedIntegerAttribute<B>::onCommit()
+{
+    this->checkSetMaxValueCount(1);
+    bool replaced = false;
+
+    {
+        // apply updates
+        typename B::ValueModifier valueGuard(this->getValueModifier());
+        for (const auto & change : this->_changes) {
+            if (change._type == ChangeBase::UPDATE) {
+                std::atomic_thread_fence(std::memory_order_release);
+                replaced |= setValue(change._doc, change._data);
+            } else if (change._type >= ChangeBase::ADD && change._type <= ChangeBase::DIV) {
+                std::atomic_thread_fence(std::memory_order_release);
+                replaced |= setValue(change._doc, this->applyArithmetic(getFast(change._doc), change));
+            } else if (change._type == ChangeBase::CLEARDOC) {
+                std::atomic_thread_fence(std::memory_order_release);
+                replaced |= setValue(change._doc, this->_defaultValue._data);
+            }
+        }
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    if (replaced) {
+        this->incGeneration();
+    } else {
+        this->removeAllOldGenerations();
+    }
+
+    this->_changes.clear();
+}
+
+template <typename B>
+void
+SingleValuePackedIntegerAttribute<B>::onUpdateStat()
+{
+    MemoryUsage usage = _blocks.getMemoryUsage();
+    usage.incAllocatedBytes(_blockBytes);
+    usage.incUsedBytes(_blockBytes);
+    usage.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
+    usage.merge(this->getChangeVectorMemoryUsage());
+    uint32_t numDocs = B::getNumDocs();
+    this->updateStatistics(numDocs, numDocs,
+                           usage.allocatedBytes(), usage.usedBytes(), usage.deadBytes(), usage.allocatedBytesOnHold());
+}
+
+template <typename B>
+void
+SingleValuePackedIntegerAttribute<B>::onAddDocs(DocId lidLimit) {
+    _blocks.reserve((lidLimit >> BLOCK_SHIFT) + 1);
+}
+
+template <typename B>
+bool
+SingleValuePackedIntegerAttribute<B>::addDoc(DocId & doc) {
+    bool incGen;
+    if ((B::getNumDocs() & BLOCK_MASK) == 0) {
+        incGen = _blocks.isFull();
+        _blocks.push_back(createUndefinedBlock());
+    } else {
+        // the slot may still hold a value from before the lid space was shrunk
+        incGen = setValue(B::getNumDocs(), attribute::getUndefined<T>());
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    B::incNumDocs();
+    doc = B::getNumDocs() - 1;
+    this->updateUncommittedDocIdLimit(doc);
+    if (incGen) {
+        this->incGeneration();
+    } else
+        this->removeAllOldGenerations();
+    return true;
+}
+
+template <typename B>
+void
+SingleValuePackedIntegerAttribute<B>::removeOldGenerations(generation_t firstUsed)
+{
+    getGenerationHolder().trimHoldLists(firstUsed);
+}
+
+template <typename B>
+void
+SingleValuePackedIntegerAttribute<B>::onGenerationChange(generation_t generation)
+{
+    getGenerationHolder().transferHoldLists(generation - 1);
+}
+
+template <typename B>
+bool
+SingleValuePackedIntegerAttribute<B>::onLoad()
+{
+    PrimitiveReader<T> attrReader(*this);
+    bool ok(attrReader.getHasLoadData());
+
+    if (!ok)
+        return false;
+
+    this->setCreateSerialNum(attrReader.getCreateSerialNum());
+
+    getGenerationHolder().clearHoldLists();
+    freeBlocks();
+    T values[BLOCK_SIZE];
+    uint32_t numDocs;
+    if (attrReader.getEnumerated()) {
+        numDocs = attrReader.getEnumCount();
+        fileutil::LoadedBuffer::UP udatBuffer(this->loadUDAT());
+        assert((udatBuffer->size() % sizeof(T)) == 0);
+        vespalib::ConstArrayRef<T> map(reinterpret_cast<const T *>(udatBuffer->buffer()),
+                                       udatBuffer->size() / sizeof(T));
+        _blocks.unsafe_reserve((numDocs >> BLOCK_SHIFT) + 1);
+        for (uint32_t doc = 0; doc < numDocs; doc += BLOCK_SIZE) {
+            uint32_t count = std::min(BLOCK_SIZE, numDocs - doc);
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t enumValue = attrReader.getNextEnum();
+                assert(enumValue < map.size());
+                values[i] = map[enumValue];
+            }
+            std::fill(values + count, values + BLOCK_SIZE, attribute::getUndefined<T>());
+            _blocks.push_back(encodeBlock(values));
+        }
+    } else {
+        numDocs = attrReader.getDataCount();
+        _blocks.unsafe_reserve((numDocs >> BLOCK_SHIFT) + 1);
+        for (uint32_t doc = 0; doc < numDocs; doc += BLOCK_SIZE) {
+            uint32_t count = std::min(BLOCK_SIZE, numDocs - doc);
+            for (uint32_t i = 0; i < count; ++i) {
+                values[i] = attrReader.getNextData();
+            }
+            std::fill(values + count, values + BLOCK_SIZE, attribute::getUndefined<T>());
+            _blocks.push_back(encodeBlock(values));
+        }
+    }
+
+    B::setNumDocs(numDocs);
+    B::setCommittedDocIdLimit(numDocs);
+
+    return true;
+}
+
+template <typename B>
+AttributeVector::SearchContext::UP
+SingleValuePackedIntegerAttribute<B>::getSearch(QueryTermSimple::UP qTerm,
+                                                const attribute::SearchContextParams & params) const
+{
+    (void) params;
+    return AttributeVector::SearchContext::UP(new SingleSearchContext(std::move(qTerm), *this));
+}
+
+template <typename B>
+void
+SingleValuePackedIntegerAttribute<B>::clearDocs(DocId lidLow, DocId lidLimit)
+{
+    assert(lidLow <= lidLimit);
+    assert(lidLimit <= this->getNumDocs());
+    for (DocId lid = lidLow; lid < lidLimit; ++lid) {
+        if (!attribute::isUndefined(getFast(lid))) {
+            this->clearDoc(lid);
+        }
+    }
+}
+
+template <typename B>
+void
+SingleValuePackedIntegerAttribute<B>::onShrinkLidSpace()
+{
+    uint32_t committedDocIdLimit = this->getCommittedDocIdLimit();
+    assert(committedDocIdLimit < this->getNumDocs());
+    size_t numBlocks = (committedDocIdLimit + BLOCK_MASK) >> BLOCK_SHIFT;
+    for (size_t i = numBlocks; i < _blocks.size(); ++i) {
+        holdBlock(_blocks[i]);
+    }
+    _blocks.shrink(numBlocks);
+    this->setNumDocs(committedDocIdLimit);
+}
+
+template <typename B>
+std::unique_ptr<AttributeSaver>
+SingleValuePackedIntegerAttribute<B>::onInitSave()
+{
+    // Saved decoded, in the same format as SingleValueNumericAttribute
+    const uint32_t numDocs(this->getCommittedDocIdLimit());
+    std::vector<T> data(numDocs);
+    T values[BLOCK_SIZE];
+    for (uint32_t doc = 0; doc < numDocs; doc += BLOCK_SIZE) {
+        decodeBlock(_blocks[doc >> BLOCK_SHIFT], values);
+        std::copy(values, values + std::min(BLOCK_SIZE, numDocs - doc), data.begin() + doc);
+    }
+    return std::make_unique<SingleValueNumericAttributeSaver>
+        (this->createAttributeHeader(), data.data(), numDocs * sizeof(T));
+}
+
+template <typename B>
+bool SingleValuePackedIntegerAttribute<B>::SingleSearchContext::valid() const { return this->isValid(); }
+
+template <typename B>
+SingleValuePackedIntegerAttribute<B>::SingleSearchContext::SingleSearchContext(QueryTermSimple::UP qTerm,
+                                                                               const NumericAttribute & toBeSearched) :
+    NumericAttribute::Range<T>(*qTerm, true),
+    AttributeVector::SearchContext(toBeSearched),
+    _blocks(&static_cast<const SingleValuePackedIntegerAttribute<B> &>(toBeSearched)._blocks[0])
+{ }
+
+template <typename B>
+uint32_t
+SingleValuePackedIntegerAttribute<B>::SingleSearchContext::findNextMatch(uint32_t docId, uint32_t endId) const
+{
+    const bool undefinedMatch = this->match(attribute::getUndefined<T>());
+    T values[BLOCK_SIZE];
+    while (docId < endId) {
+        const uint64_t *block = _blocks[docId >> BLOCK_SHIFT];
+        const uint32_t blockStart = docId & ~BLOCK_MASK;
+        const uint32_t blockEnd = std::min(blockStart + BLOCK_SIZE, endId);
+        const uint32_t w = width(block);
+        bool anyMatch;
+        bool allMatch;
+        if (w == 0) {
+            allMatch = anyMatch = this->match(fromCode(block[0], 0));
+        } else if (w == FULL_WIDTH) {
+            anyMatch = true;
+            allMatch = false;
+        } else {
+            // compare as distances from the base to avoid overflowing T
+            const bool reserved = hasReserved(block);
+            const uint64_t maxCode = reserved ? (codeMask(w) - 1) : codeMask(w);
+            const T base = fromCode(block[0], 0);
+            const bool lowBelowBase = (this->_low <= base);
+            const bool noneInRange = (this->_high < base) ||
+                                     (!lowBelowBase &&
+                                      (static_cast<U>(static_cast<U>(this->_low) - static_cast<U>(base)) > maxCode));
+            const bool allInRange = lowBelowBase && (this->_high >= base) &&
+                                    (static_cast<U>(static_cast<U>(this->_high) - static_cast<U>(base)) >= maxCode);
+            anyMatch = !noneInRange || (reserved && undefinedMatch);
+            allMatch = allInRange && (!reserved || undefinedMatch);
+        }
+        if (allMatch) {
+            return docId;
+        }
+        if (anyMatch) {
+            decodeBlock(block, values);
+            uint64_t hits = 0;
+            for (uint32_t i = 0; i < BLOCK_SIZE; ++i) {
+                hits |= static_cast<uint64_t>(this->match(values[i])) << i;
+            }
+            hits &= ~uint64_t(0) << (docId - blockStart);
+            if (blockEnd - blockStart < BLOCK_SIZE) {
+                hits &= (uint64_t(1) << (blockEnd - blockStart)) - 1;
+            }
+            if (hits != 0) {
+                return blockStart + vespalib::Optimized::lsbIdx(hits);
+            }
+        }
+        docId = blockEnd;
+    }
+    return endId;
+}
+
+template <typename B>
+Int64Range
+SingleValuePackedIntegerAttribute<B>::SingleSearchContext::getAsIntegerTerm() const {
+    return this->getRange();
+}
+
+template <typename B>
+std::unique_ptr<queryeval::SearchIterator>
+SingleValuePackedIntegerAttribute<B>::SingleSearchContext::
+createFilterIterator(fef::TermFieldMatchData * matchData, bool strict)
+{
+    if (!valid()) {
+        return queryeval::SearchIterator::UP(new queryeval::EmptySearch());
+    }
+    if (getIsFilter()) {
+        return queryeval::SearchIterator::UP
+                (strict
+                 ? new FilterScanAttributeIteratorStrict<SingleSearchContext>(*this, matchData)
+                 : new FilterAttributeIteratorT<SingleSearchContext>(*this, matchData));
+    }
+    return queryeval::SearchIterator::UP
+            (strict
+             ? new ScanAttributeIteratorStrict<SingleSearchContext>(*this, matchData)
+             : new AttributeIteratorT<SingleSearchContext>(*this, matchData));
+}
+
+}
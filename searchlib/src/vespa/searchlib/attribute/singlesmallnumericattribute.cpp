@@ -27,7 +27,8 @@ SingleValueSmallNumericAttribute(const vespalib::string & baseFileName,
       _wordData(c.getGrowStrategy().getDocsInitialCapacity(),
                 c.getGrowStrategy().getDocsGrowPercent(),
                 c.getGrowStrategy().getDocsGrowDelta(),
-                getGenerationHolder())
+                getGenerationHolder(),
+                getInitialAlloc(c))
 {
     assert(_valueMask + 1 == (1u << (1u << valueShiftShift)));
     assert((_valueShiftMask + 1) * (1u << valueShiftShift) ==
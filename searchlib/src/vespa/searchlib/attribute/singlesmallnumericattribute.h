@@ -149,6 +149,16 @@ public:
     double getFloat(DocId doc) const override {
         return static_cast<double>(getFast(doc));
     }
+    void getIntBatch(const DocId * docIds, uint32_t numDocs, largeint_t * values) const override {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            values[i] = static_cast<largeint_t>(getFast(docIds[i]));
+        }
+    }
+    void getFloatBatch(const DocId * docIds, uint32_t numDocs, double * values) const override {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            values[i] = static_cast<double>(getFast(docIds[i]));
+        }
+    }
     uint32_t getEnum(DocId doc) const override {
         (void) doc;
         return std::numeric_limits<uint32_t>::max(); // does not have enum
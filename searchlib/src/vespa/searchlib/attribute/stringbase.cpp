@@ -403,7 +403,7 @@ StringAttribute::onLoadEnumerated(ReaderBase &attrReader)
         LOG(debug, "start sort loaded");
         timer.SetNow();
         
-        attribute::sortLoadedByEnum(loaded);
+        attribute::sortLoadedByEnum(loaded, getLoadExecutor());
         
         LOG(debug, "done sort loaded, %8.3f s elapsed",
             timer.MilliSecsToNow() / 1000);
@@ -1446,6 +1446,48 @@ public:
         return res;
     }
 
+    /**
+     * Read [count] values of [width] bits each (0 < width < 64) into
+     * [output].  The bit cache is kept in registers for the whole batch
+     * instead of being loaded from and stored to the context per value.
+     */
+    void
+    readBitsBatch(uint32_t width, uint32_t count, uint64_t *output)
+    {
+        UC64_DECODECONTEXT_CONSTRUCTOR(o, _);
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t length = width;
+            if (bigEndian) {
+                output[i] = oVal >> (64 - width);
+                oVal <<= width;
+            } else {
+                output[i] = oVal & CodingTables::_intMask64[width];
+                oVal >>= width;
+            }
+            UC64_READBITS(oVal, oCompr, oPreRead, oCacheInt, EC);
+        }
+        UC64_DECODECONTEXT_STORE(o, _);
+    }
+
+    /**
+     * Decode [count] small exp golomb codes with parameter [k] into
+     * [output], see UC64_DECODEEXPGOLOMB_SMALL.  Each code consumes at
+     * most one word of input, so the caller must ensure that [count]
+     * words are available before the end of the buffer.
+     */
+    void
+    decodeExpGolombSmallBatch(uint32_t k, uint32_t count, uint64_t *output)
+    {
+        UC64_DECODECONTEXT_CONSTRUCTOR(o, _);
+        uint32_t length;
+        uint64_t val64;
+        for (uint32_t i = 0; i < count; ++i) {
+            UC64_DECODEEXPGOLOMB_SMALL_NS(o, k, EC);
+            output[i] = val64;
+        }
+        UC64_DECODECONTEXT_STORE(o, _);
+    }
+
     void
     align(uint32_t alignment)
     {
@@ -1348,9 +1348,11 @@ lookup(const SSReader &ssReader,
         spStartOffset = ssReader._spFirstPageOffset;
     setDecoderPositionInPage(dL5, sparsePage, spStartOffset);
 
-    uint32_t l5Size = dL5.readBits(15);
-    uint32_t l4Size = dL5.readBits(15);
-    uint32_t l3Entries = dL5.readBits(15);
+    uint64_t pageHeader[3];
+    dL5.readBitsBatch(15, 3, pageHeader);
+    uint32_t l5Size = pageHeader[0];
+    uint32_t l4Size = pageHeader[1];
+    uint32_t l3Entries = pageHeader[2];
     uint32_t wordsSize = dL5.readBits(12);
     uint32_t l3Residue = l3Entries;
 
@@ -1544,9 +1546,11 @@ lookup(const SSReader &ssReader,
         pStartOffset = ssReader._pFirstPageOffset;
     setDecoderPositionInPage(dL2, page, pStartOffset);
 
-    uint32_t l2Size = dL2.readBits(15);
-    uint32_t l1Size = dL2.readBits(15);
-    uint32_t countsEntries = dL2.readBits(15);
+    uint64_t pageHeader[3];
+    dL2.readBitsBatch(15, 3, pageHeader);
+    uint32_t l2Size = pageHeader[0];
+    uint32_t l1Size = pageHeader[1];
+    uint32_t countsEntries = pageHeader[2];
     uint32_t wordsSize = dL2.readBits(12);
     uint32_t countsResidue = countsEntries;
 
@@ -1699,6 +1703,122 @@ lookup(const SSReader &ssReader,
    return _res;
 }
 
+PageDict4DecodedPage::PageDict4DecodedPage()
+    : _words(),
+      _wordOffsets(),
+      _counts(),
+      _startOffsets(),
+      _firstWordNum(1u)
+{
+}
+
+
+PageDict4DecodedPage::~PageDict4DecodedPage()
+{
+}
+
+
+void
+PageDict4DecodedPage::decode(const SSReader &ssReader,
+                             const void *page,
+                             const vespalib::stringref &l3Word,
+                             const vespalib::stringref &lastPWord,
+                             const StartOffset &l3StartOffset,
+                             uint64_t l3WordNum)
+{
+    DC dCounts;
+    dCounts.copyParams(ssReader.getSSD());
+
+    uint32_t pStartOffset = 0;
+    if (l3WordNum == 1)
+        pStartOffset = ssReader._pFirstPageOffset;
+    setDecoderPositionInPage(dCounts, page, pStartOffset);
+
+    uint64_t pageHeader[3];
+    dCounts.readBitsBatch(15, 3, pageHeader);
+    uint32_t l2Size = pageHeader[0];
+    uint32_t l1Size = pageHeader[1];
+    uint32_t countsEntries = pageHeader[2];
+    uint32_t wordsSize = dCounts.readBits(12);
+
+    _words.clear();
+    _wordOffsets.clear();
+    _counts.clear();
+    _startOffsets.clear();
+    _firstWordNum = l3WordNum;
+    _wordOffsets.reserve(countsEntries + 1);
+    _counts.reserve(countsEntries);
+    _startOffsets.reserve(countsEntries + 1);
+    _wordOffsets.push_back(0u);
+    _startOffsets.push_back(l3StartOffset);
+    if (countsEntries == 0) {
+        return; // Overflow page
+    }
+
+    // L2 and L1 skip info is only needed for partial decoding
+    setDecoderPositionInPage(dCounts, page,
+                             getPageHeaderBitSize() + pStartOffset + l2Size + l1Size);
+    const char *wordBuf = static_cast<const char *>(page) + getPageByteSize() - wordsSize;
+    _words.reserve(wordsSize + lastPWord.size());
+
+    vespalib::string word = l3Word;
+    StartOffset startOffset = l3StartOffset;
+    Counts counts;
+    uint32_t wordOffset = 0;
+    for (uint32_t i = 0; i < countsEntries; ++i) {
+        dCounts.readCounts(counts);
+        if (i + 1 < countsEntries) {
+            const char *countsWordBuf = wordBuf + wordOffset;
+            size_t lcp = *reinterpret_cast<const unsigned char *>(countsWordBuf);
+            ++countsWordBuf;
+            assert(lcp <= word.size());
+            word.resize(lcp);
+            word += countsWordBuf;
+            wordOffset += 2 + word.size() - lcp;
+        } else {
+            word = lastPWord;
+        }
+        _words.insert(_words.end(), word.begin(), word.end());
+        _wordOffsets.push_back(_words.size());
+        _counts.push_back(counts);
+        startOffset.adjust(counts);
+        _startOffsets.push_back(startOffset);
+    }
+}
+
+
+uint32_t
+PageDict4DecodedPage::lowerBound(const vespalib::stringref &key) const
+{
+    uint32_t low = 0;
+    uint32_t high = size();
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (getWord(mid) < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+
+size_t
+PageDict4DecodedPage::getMemoryUsage() const
+{
+    size_t usage = sizeof(*this) +
+                   _words.capacity() +
+                   _wordOffsets.capacity() * sizeof(uint32_t) +
+                   _counts.capacity() * sizeof(Counts) +
+                   _startOffsets.capacity() * sizeof(StartOffset);
+    for (const Counts &counts : _counts) {
+        usage += counts._segments.capacity() * sizeof(Counts::Segment);
+    }
+    return usage;
+}
+
+
 PageDict4Reader::PageDict4Reader(const SSReader &ssReader,
                                  DC &spd,
                                  DC &pd)
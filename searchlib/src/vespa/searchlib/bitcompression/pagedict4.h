@@ -649,6 +649,62 @@ public:
 };
 
 
+/*
+ * All entries of a page in the P file, decoded once so that later
+ * lookups in the page are binary searches instead of sequential
+ * decoding. Words are stored back to back in a single buffer.
+ *
+ * An overflow page has no entries. The overflow word itself, with
+ * word number getWordNum(0), is found in the SS file.
+ */
+class PageDict4DecodedPage : public PageDict4PageParams
+{
+public:
+    typedef PostingListCountFileDecodeContext DC;
+    typedef PageDict4SSReader SSReader;
+
+private:
+    std::vector<char> _words;
+    std::vector<uint32_t> _wordOffsets;     // size() + 1 entries
+    std::vector<Counts> _counts;
+    std::vector<StartOffset> _startOffsets; // size() + 1 entries
+    uint64_t _firstWordNum;
+
+public:
+    PageDict4DecodedPage();
+    ~PageDict4DecodedPage();
+
+    void
+    decode(const SSReader &ssReader,
+           const void *page,
+           const vespalib::stringref &l3Word,
+           const vespalib::stringref &lastPWord,
+           const StartOffset &l3StartOffset,
+           uint64_t l3WordNum);
+
+    uint32_t size() const { return _counts.size(); }
+
+    vespalib::stringref getWord(uint32_t idx) const {
+        return vespalib::stringref(_words.data() + _wordOffsets[idx],
+                                   _wordOffsets[idx + 1] - _wordOffsets[idx]);
+    }
+
+    const Counts &getCounts(uint32_t idx) const { return _counts[idx]; }
+
+    // Valid for idx <= size(), giving the position after the last word.
+    const StartOffset &getStartOffset(uint32_t idx) const { return _startOffsets[idx]; }
+    uint64_t getWordNum(uint32_t idx) const { return _firstWordNum + idx; }
+
+    /*
+     * Returns index of first word not less than key, or size() if
+     * all words are less than key.
+     */
+    uint32_t lowerBound(const vespalib::stringref &key) const;
+
+    size_t getMemoryUsage() const;
+};
+
+
 class PageDict4Reader : public PageDict4PageParams
 {
 public:
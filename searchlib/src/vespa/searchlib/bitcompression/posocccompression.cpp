@@ -33,6 +33,9 @@ namespace {
 vespalib::string EG64PosOccId = "EG64PosOcc.3"; // Dynamic k values
 vespalib::string EG64PosOccId2 = "EG64PosOcc.2";    // Fixed k values
 
+// Number of word position deltas decoded per batch when cooking features
+constexpr uint32_t WORDPOS_BATCH_SIZE = 64;
+
 }
 
 namespace search {
@@ -510,24 +513,30 @@ readFeatures(search::index::DocIdAndFeatures &features)
                                           K_VALUE_POSOCC_FIRST_WORDPOS,
                                           EC);
             wordPos = static_cast<uint32_t>(val64);
-            features._elements.back().incNumOccs();
             features._wordPositions.push_back(
                     WordDocElementWordPosFeatures(wordPos));
         } while (0);
-        for (uint32_t pos = 1; pos < numPositions; ++pos) {
+        features._elements.back().setNumOccs(numPositions);
+        features._wordPositions.reserve(features._wordPositions.size() + numPositions - 1);
+        uint64_t wordPosDeltas[WORDPOS_BATCH_SIZE];
+        for (uint32_t pos = 1; pos < numPositions;) {
             if (__builtin_expect(oCompr >= valE, false)) {
                 UC64_DECODECONTEXT_STORE(o, _);
                 _readContext->readComprBuffer();
                 valE = _valE;
                 UC64_DECODECONTEXT_LOAD(o, _);
             }
-            UC64_DECODEEXPGOLOMB_SMALL_NS(o,
-                                          K_VALUE_POSOCC_DELTA_WORDPOS,
-                                          EC);
-            wordPos += 1 + static_cast<uint32_t>(val64);
-            features._elements.back().incNumOccs();
-            features._wordPositions.push_back(
-                    WordDocElementWordPosFeatures(wordPos));
+            uint32_t batch = std::min(std::min(numPositions - pos, WORDPOS_BATCH_SIZE),
+                                      static_cast<uint32_t>(valE - oCompr));
+            UC64_DECODECONTEXT_STORE(o, _);
+            this->decodeExpGolombSmallBatch(K_VALUE_POSOCC_DELTA_WORDPOS, batch, wordPosDeltas);
+            UC64_DECODECONTEXT_LOAD(o, _);
+            for (uint32_t i = 0; i < batch; ++i) {
+                wordPos += 1 + static_cast<uint32_t>(wordPosDeltas[i]);
+                features._wordPositions.push_back(
+                        WordDocElementWordPosFeatures(wordPos));
+            }
+            pos += batch;
         }
     }
     UC64_DECODECONTEXT_STORE(o, _);
@@ -1004,20 +1013,27 @@ readFeatures(search::index::DocIdAndFeatures &features)
                             calcWordPosK(numPositions, elementLen);
 
         uint32_t wordPos = static_cast<uint32_t>(-1);
-        for (uint32_t pos = 0; pos < numPositions; ++pos) {
+        features._elements.back().setNumOccs(numPositions);
+        features._wordPositions.reserve(features._wordPositions.size() + numPositions);
+        uint64_t wordPosDeltas[WORDPOS_BATCH_SIZE];
+        for (uint32_t pos = 0; pos < numPositions;) {
             if (__builtin_expect(oCompr >= valE, false)) {
                 UC64_DECODECONTEXT_STORE(o, _);
                 _readContext->readComprBuffer();
                 valE = _valE;
                 UC64_DECODECONTEXT_LOAD(o, _);
             }
-            UC64_DECODEEXPGOLOMB_SMALL_NS(o,
-                                          wordPosK,
-                                          EC);
-            wordPos += 1 + static_cast<uint32_t>(val64);
-            features._elements.back().incNumOccs();
-            features._wordPositions.push_back(
-                    WordDocElementWordPosFeatures(wordPos));
+            uint32_t batch = std::min(std::min(numPositions - pos, WORDPOS_BATCH_SIZE),
+                                      static_cast<uint32_t>(valE - oCompr));
+            UC64_DECODECONTEXT_STORE(o, _);
+            this->decodeExpGolombSmallBatch(wordPosK, batch, wordPosDeltas);
+            UC64_DECODECONTEXT_LOAD(o, _);
+            for (uint32_t i = 0; i < batch; ++i) {
+                wordPos += 1 + static_cast<uint32_t>(wordPosDeltas[i]);
+                features._wordPositions.push_back(
+                        WordDocElementWordPosFeatures(wordPos));
+            }
+            pos += batch;
         }
     }
     UC64_DECODECONTEXT_STORE(o, _);
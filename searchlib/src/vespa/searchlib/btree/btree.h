@@ -60,6 +60,11 @@ public:
         _alloc.disableFreeLists();
     }
 
+    void
+    setHugePages(bool hugePages) {
+        _alloc.setHugePages(hugePages);
+    }
+
     void
     disableElemHoldList()
     {
@@ -236,7 +236,25 @@ private:
      */
     VESPA_DLL_LOCAL void findPrevLeafNode();
 
+    template <typename NodeType>
+    static void
+    prefetchNode(const NodeType *node)
+    {
+        const char *p = reinterpret_cast<const char *>(node);
+        for (size_t offset = 0; offset < sizeof(NodeType); offset += 64) {
+            __builtin_prefetch(p + offset, 0);
+        }
+    }
+
 protected:
+    /*
+     * Prefetch the leaf node following the current leaf node, or the
+     * next internal node on the path when the current leaf node is the
+     * last child of its parent. Called when moving to an adjacent leaf
+     * node, to hide cache misses when iterating in key order.
+     */
+    void prefetchNextLeafNode() const;
+
     /*
      * Report current position in tree.
      *
@@ -500,6 +518,7 @@ protected:
     using ParentType::_compatLeafNode;
     using ParentType::clearPath;
     using ParentType::setupEmpty;
+    using ParentType::prefetchNextLeafNode;
 public:
     using ParentType::end;
 
@@ -624,6 +643,23 @@ public:
     void
     linearSeek(const KeyType &key, CompareT comp = CompareT());
 
+    /**
+     * Seek to each of the given keys in turn and copy the keys present
+     * in the tree to the found array.  Keys must be sorted according
+     * to the tree ordering.  This amortizes the per seek overhead when
+     * intersecting a short list of keys with a large tree.  Iteration
+     * stops early when the iterator reaches the end of the tree.
+     *
+     * @param keys      Sorted keys to search for
+     * @param numKeys   Number of keys
+     * @param found     Buffer with room for numKeys keys
+     * @param comp      Comparator for the tree ordering.
+     * @return          Number of keys found
+     */
+    uint32_t
+    seekBatch(const KeyType *keys, uint32_t numKeys, KeyType *found,
+              CompareT comp = CompareT());
+
     /**
      * Step iterator forwards until it is at a position with a key
      * that is greater than the key argument.  Original position must
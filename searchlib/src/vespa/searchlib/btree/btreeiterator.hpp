@@ -216,6 +216,7 @@ findNextLeafNode()
                 node = inode->getChild(0);
             }
             _leaf.setNodeAndIdx(_allocator->mapLeafRef(node), 0u);
+            prefetchNextLeafNode();
             return;
         }
     }
@@ -223,6 +224,31 @@ findNextLeafNode()
 }
 
 
+template <typename KeyT, typename DataT, typename AggrT,
+          uint32_t INTERNAL_SLOTS, uint32_t LEAF_SLOTS, uint32_t PATH_SIZE>
+void
+BTreeIteratorBase<KeyT, DataT, AggrT, INTERNAL_SLOTS, LEAF_SLOTS, PATH_SIZE>::
+prefetchNextLeafNode() const
+{
+    if (_pathSize == 0) {
+        return;
+    }
+    const PathElement &parent = _path[0];
+    uint32_t idx = parent.getIdx() + 1;
+    if (idx < parent.getNode()->validSlots()) {
+        prefetchNode(_allocator->mapLeafRef(parent.getNode()->getChild(idx)));
+        return;
+    }
+    if (_pathSize > 1) {
+        const PathElement &grandParent = _path[1];
+        idx = grandParent.getIdx() + 1;
+        if (idx < grandParent.getNode()->validSlots()) {
+            prefetchNode(_allocator->mapInternalRef(grandParent.getNode()->getChild(idx)));
+        }
+    }
+}
+
+
 template <typename KeyT, typename DataT, typename AggrT,
           uint32_t INTERNAL_SLOTS, uint32_t LEAF_SLOTS, uint32_t PATH_SIZE>
 void
@@ -712,6 +738,8 @@ binarySeek(const KeyType & key, CompareT comp)
             end();
             return;
         } else {
+            // Seeking within the parent node indicates dense traversal
+            bool nearby = (level == 0);
             const InternalNodeType *node  = _path[level].getNode();
             uint32_t idx = _path[level].getIdx();
             idx = node->template lower_bound<CompareT>(idx + 1, key, comp);
@@ -724,6 +752,9 @@ binarySeek(const KeyType & key, CompareT comp)
             }
             lnode = _allocator->mapLeafRef(node->getChild(idx));
             _leaf.setNode(lnode);
+            if (nearby) {
+                prefetchNextLeafNode();
+            }
             lidx = 0;
         }
     }
@@ -761,6 +792,8 @@ linearSeek(const KeyType & key, CompareT comp)
             end();
             return;
         } else {
+            // Seeking within the parent node indicates dense traversal
+            bool nearby = (level == 0);
             const InternalNodeType *node  = _path[level].getNode();
             uint32_t idx = _path[level].getIdx();
             do {
@@ -778,6 +811,9 @@ linearSeek(const KeyType & key, CompareT comp)
             }
             lnode = _allocator->mapLeafRef(node->getChild(idx));
             _leaf.setNode(lnode);
+            if (nearby) {
+                prefetchNextLeafNode();
+            }
             lidx = 0;
         }
     }
@@ -787,6 +823,28 @@ linearSeek(const KeyType & key, CompareT comp)
     _leaf.setIdx(lidx);
 }
 
+template <typename KeyT, typename DataT, typename AggrT, typename CompareT,
+          typename TraitsT>
+uint32_t
+BTreeConstIterator<KeyT, DataT, AggrT, CompareT, TraitsT>::
+seekBatch(const KeyType *keys, uint32_t numKeys, KeyType *found, CompareT comp)
+{
+    uint32_t numFound = 0;
+    for (uint32_t i = 0; i < numKeys && _leaf.valid(); ++i) {
+        const KeyType &key = keys[i];
+        if (comp(_leaf.getKey(), key)) {
+            seek(key, comp);
+            if (!_leaf.valid()) {
+                break;
+            }
+        }
+        if (!comp(key, _leaf.getKey())) {
+            found[numFound++] = key;
+        }
+    }
+    return numFound;
+}
+
 template <typename KeyT, typename DataT, typename AggrT, typename CompareT,
           typename TraitsT>
 void
@@ -830,6 +888,8 @@ binarySeekPast(const KeyType & key, CompareT comp)
             end();
             return;
         } else {
+            // Seeking within the parent node indicates dense traversal
+            bool nearby = (level == 0);
             const InternalNodeType *node  = _path[level].getNode();
             uint32_t idx = _path[level].getIdx();
             idx = node->template upper_bound<CompareT>(idx + 1, key, comp);
@@ -842,6 +902,9 @@ binarySeekPast(const KeyType & key, CompareT comp)
             }
             lnode = _allocator->mapLeafRef(node->getChild(idx));
             _leaf.setNode(lnode);
+            if (nearby) {
+                prefetchNextLeafNode();
+            }
             lidx = 0;
         }
     }
@@ -879,6 +942,8 @@ linearSeekPast(const KeyType & key, CompareT comp)
             end();
             return;
         } else {
+            // Seeking within the parent node indicates dense traversal
+            bool nearby = (level == 0);
             const InternalNodeType *node  = _path[level].getNode();
             uint32_t idx = _path[level].getIdx();
             do {
@@ -896,6 +961,9 @@ linearSeekPast(const KeyType & key, CompareT comp)
             }
             lnode = _allocator->mapLeafRef(node->getChild(idx));
             _leaf.setNode(lnode);
+            if (nearby) {
+                prefetchNextLeafNode();
+            }
             lidx = 0;
         }
     }
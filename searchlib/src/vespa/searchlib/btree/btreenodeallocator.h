@@ -70,6 +70,11 @@ public:
         _nodeStore.disableFreeLists();
     }
 
+    void
+    setHugePages(bool hugePages) {
+        _nodeStore.setHugePages(hugePages);
+    }
+
     void
     disableElemHoldList()
     {
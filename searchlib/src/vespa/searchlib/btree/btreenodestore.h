@@ -85,6 +85,11 @@ public:
         _store.disableFreeLists();
     }
 
+    void
+    setHugePages(bool hugePages) {
+        _store.setHugePages(hugePages);
+    }
+
     void
     disableElemHoldList()
     {
@@ -109,6 +109,12 @@ public:
         _allocator.disableFreeLists();
     }
 
+    void
+    setHugePages(bool hugePages) {
+        _store.setHugePages(hugePages);
+        _allocator.setHugePages(hugePages);
+    }
+
     void
     disableElemHoldList()
     {
@@ -0,0 +1,244 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "adaptivesequencedtaskexecutor.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace search {
+
+namespace {
+
+constexpr uint32_t stackSize = 128 * 1024;
+
+}
+
+AdaptiveSequencedTaskExecutor::Strand::Strand()
+    : state(State::IDLE),
+      queue(),
+      acceptedSeq(0),
+      doneSeq(0),
+      maxQueueDepth(0),
+      acceptedTasks(0)
+{
+}
+
+AdaptiveSequencedTaskExecutor::Strand::~Strand()
+{
+    assert(queue.empty());
+}
+
+AdaptiveSequencedTaskExecutor::AdaptiveSequencedTaskExecutor(uint32_t strands, uint32_t threads, uint32_t taskLimit)
+    : _pool(std::make_unique<FastOS_ThreadPool>(stackSize)),
+      _mutex(),
+      _producerCond(),
+      _syncCond(),
+      _strands(strands),
+      _waitQueue(),
+      _idleWorkers(),
+      _ids(),
+      _taskLimit(taskLimit),
+      _blockedProducers(0),
+      _syncWaiters(0),
+      _pendingTasks(0),
+      _maxPendingTasks(0),
+      _acceptedTasks(0),
+      _taskStats(),
+      _statsStart(clock::now()),
+      _closed(false)
+{
+    assert(strands > 0);
+    assert(threads > 0);
+    assert(taskLimit > 0);
+    for (uint32_t i = 0; i < threads; ++i) {
+        FastOS_ThreadInterface *thread = _pool->NewThread(this);
+        assert(thread != nullptr);
+        (void) thread;
+    }
+}
+
+AdaptiveSequencedTaskExecutor::~AdaptiveSequencedTaskExecutor()
+{
+    sync();
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        _closed = true;
+        for (Worker *worker : _idleWorkers) {
+            worker->idle = false;
+            worker->cond.notify_one();
+        }
+        _idleWorkers.clear();
+    }
+    _pool->Close();
+}
+
+void
+AdaptiveSequencedTaskExecutor::Run(FastOS_ThreadInterface *, void *)
+{
+    Worker self;
+    std::unique_lock<std::mutex> guard(_mutex);
+    for (;;) {
+        if (self.strand == nullptr) {
+            if (!_waitQueue.empty()) {
+                self.strand = _waitQueue.front();
+                _waitQueue.pop_front();
+                self.strand->state = Strand::State::ACTIVE;
+            } else if (_closed) {
+                return;
+            } else {
+                self.accounting.flush(_taskStats, true);
+                self.idle = true;
+                _idleWorkers.push_back(&self);
+                self.cond.wait(guard, [&self]{ return !self.idle; });
+                self.accounting.wakeup();
+                continue;
+            }
+        }
+        Strand &strand = *self.strand;
+        assert(!strand.queue.empty());
+        QueuedTask task = std::move(strand.queue.front());
+        strand.queue.pop_front();
+        guard.unlock();
+        clock::time_point start = clock::now();
+        task.first->run();
+        task.first.reset();
+        self.accounting.taskDone(task.second, start, clock::now());
+        guard.lock();
+        self.accounting.flush(_taskStats, false);
+        ++strand.doneSeq;
+        --_pendingTasks;
+        if (_blockedProducers > 0) {
+            _producerCond.notify_all();
+        }
+        if (_syncWaiters > 0) {
+            _syncCond.notify_all();
+        }
+        if (strand.queue.empty()) {
+            strand.state = Strand::State::IDLE;
+            self.strand = nullptr;
+        } else if (!_waitQueue.empty()) {
+            strand.state = Strand::State::WAITING;
+            _waitQueue.push_back(&strand);
+            self.strand = nullptr;
+        }
+    }
+}
+
+bool
+AdaptiveSequencedTaskExecutor::isDone(const std::vector<uint64_t> &targets) const
+{
+    for (size_t i = 0; i < targets.size(); ++i) {
+        if (_strands[i].doneSeq < targets[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+AdaptiveSequencedTaskExecutor::setTaskLimit(uint32_t taskLimit)
+{
+    assert(taskLimit > 0);
+    std::lock_guard<std::mutex> guard(_mutex);
+    _taskLimit = taskLimit;
+    _producerCond.notify_all();
+}
+
+ISequencedTaskExecutor::ExecutorId
+AdaptiveSequencedTaskExecutor::getExecutorId(uint64_t componentId)
+{
+    auto itr = _ids.find(componentId);
+    if (itr == _ids.end()) {
+        auto insarg = std::make_pair(componentId, ExecutorId(_ids.size() % _strands.size()));
+        auto insres = _ids.insert(insarg);
+        assert(insres.second);
+        itr = insres.first;
+    }
+    return itr->second;
+}
+
+void
+AdaptiveSequencedTaskExecutor::executeTask(ExecutorId id, vespalib::Executor::Task::UP task)
+{
+    assert(id.getId() < _strands.size());
+    Strand &strand = _strands[id.getId()];
+    std::unique_lock<std::mutex> guard(_mutex);
+    assert(!_closed);
+    if (strand.queue.size() >= _taskLimit) {
+        ++_blockedProducers;
+        _producerCond.wait(guard, [&]{ return strand.queue.size() < _taskLimit; });
+        --_blockedProducers;
+    }
+    strand.queue.emplace_back(std::move(task), clock::now());
+    ++strand.acceptedSeq;
+    ++strand.acceptedTasks;
+    strand.maxQueueDepth = std::max(strand.maxQueueDepth, strand.queue.size());
+    ++_acceptedTasks;
+    ++_pendingTasks;
+    _maxPendingTasks = std::max(_maxPendingTasks, _pendingTasks);
+    if (strand.state == Strand::State::IDLE) {
+        if (!_idleWorkers.empty()) {
+            // hand the strand directly to an idle worker
+            Worker *worker = _idleWorkers.back();
+            _idleWorkers.pop_back();
+            worker->strand = &strand;
+            worker->idle = false;
+            strand.state = Strand::State::ACTIVE;
+            worker->cond.notify_one();
+        } else {
+            strand.state = Strand::State::WAITING;
+            _waitQueue.push_back(&strand);
+        }
+    }
+}
+
+void
+AdaptiveSequencedTaskExecutor::sync()
+{
+    std::unique_lock<std::mutex> guard(_mutex);
+    std::vector<uint64_t> targets;
+    targets.reserve(_strands.size());
+    for (const auto &strand : _strands) {
+        targets.push_back(strand.acceptedSeq);
+    }
+    ++_syncWaiters;
+    _syncCond.wait(guard, [&]{ return isDone(targets); });
+    --_syncWaiters;
+}
+
+AdaptiveSequencedTaskExecutor::Stats
+AdaptiveSequencedTaskExecutor::getStats()
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    clock::time_point now = clock::now();
+    Stats stats = _taskStats;
+    stats.maxPendingTasks = _maxPendingTasks;
+    stats.acceptedTasks = _acceptedTasks;
+    stats.threads = _pool->GetNumStartedThreads();
+    stats.wallTime = std::chrono::duration<double>(now - _statsStart).count();
+    _maxPendingTasks = _pendingTasks;
+    _acceptedTasks = 0;
+    _taskStats = Stats();
+    _statsStart = now;
+    return stats;
+}
+
+std::vector<AdaptiveSequencedTaskExecutor::StrandStats>
+AdaptiveSequencedTaskExecutor::getStrandStats()
+{
+    std::lock_guard<std::mutex> guard(_mutex);
+    std::vector<StrandStats> result;
+    result.reserve(_strands.size());
+    for (auto &strand : _strands) {
+        StrandStats stats;
+        stats.queueDepth = strand.queue.size();
+        stats.maxQueueDepth = strand.maxQueueDepth;
+        stats.acceptedTasks = strand.acceptedTasks;
+        strand.maxQueueDepth = strand.queue.size();
+        strand.acceptedTasks = 0;
+        result.push_back(stats);
+    }
+    return result;
+}
+
+} // namespace search
@@ -0,0 +1,120 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "isequencedtaskexecutor.h"
+#include <vespa/vespalib/util/executor_stats.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/fastos/thread.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace search {
+
+/**
+ * Class to run multiple tasks in parallel, but tasks with same
+ * id has to be run in sequence.
+ *
+ * Unlike SequencedTaskExecutor, strands (task queues, one per
+ * executor id) are not bound to a specific thread. A worker thread
+ * picks up any strand that has pending tasks and is not already being
+ * run by another worker, so a busy strand does not prevent other
+ * strands from using the remaining threads. At most one worker runs a
+ * given strand at any time, which preserves the ordering of tasks
+ * with the same id. When other strands are waiting, a worker moves on
+ * to the next waiting strand after each task.
+ */
+class AdaptiveSequencedTaskExecutor : public ISequencedTaskExecutor,
+                                      private FastOS_Runnable
+{
+public:
+    using Stats = vespalib::ExecutorStats;
+
+    /**
+     * Per strand statistics.
+     */
+    struct StrandStats {
+        size_t queueDepth;
+        size_t maxQueueDepth;
+        size_t acceptedTasks;
+        StrandStats() : queueDepth(0), maxQueueDepth(0), acceptedTasks(0) {}
+    };
+
+private:
+    using clock = vespalib::ExecutorThreadAccounting::clock;
+    // task with the time it was queued
+    using QueuedTask = std::pair<vespalib::Executor::Task::UP, clock::time_point>;
+
+    struct Strand {
+        enum class State { IDLE, WAITING, ACTIVE };
+        State                                    state;
+        std::deque<QueuedTask>                   queue;
+        uint64_t                                 acceptedSeq;
+        uint64_t                                 doneSeq;
+        size_t                                   maxQueueDepth;
+        size_t                                   acceptedTasks;
+        Strand();
+        ~Strand();
+    };
+
+    struct Worker {
+        std::condition_variable            cond;
+        Strand                            *strand;
+        bool                               idle;
+        vespalib::ExecutorThreadAccounting accounting;
+        Worker() : cond(), strand(nullptr), idle(false), accounting() {}
+    };
+
+    std::unique_ptr<FastOS_ThreadPool>     _pool;
+    std::mutex                             _mutex;
+    std::condition_variable                _producerCond;
+    std::condition_variable                _syncCond;
+    std::vector<Strand>                    _strands;
+    std::deque<Strand *>                   _waitQueue;
+    std::vector<Worker *>                  _idleWorkers;
+    vespalib::hash_map<size_t, ExecutorId> _ids;
+    uint32_t                               _taskLimit;
+    uint32_t                               _blockedProducers;
+    uint32_t                               _syncWaiters;
+    size_t                                 _pendingTasks;
+    size_t                                 _maxPendingTasks;
+    size_t                                 _acceptedTasks;
+    Stats                                  _taskStats;
+    clock::time_point                      _statsStart;
+    bool                                   _closed;
+
+    void Run(FastOS_ThreadInterface *, void *) override;
+    bool isDone(const std::vector<uint64_t> &targets) const;
+public:
+    using ISequencedTaskExecutor::getExecutorId;
+
+    /**
+     * @param strands   number of executor ids (task sequences)
+     * @param threads   number of worker threads shared by all strands
+     * @param taskLimit max number of queued tasks per strand before
+     *                  executeTask blocks
+     */
+    AdaptiveSequencedTaskExecutor(uint32_t strands, uint32_t threads, uint32_t taskLimit = 1000);
+    ~AdaptiveSequencedTaskExecutor() override;
+
+    void setTaskLimit(uint32_t taskLimit);
+    uint32_t getNumExecutors() const override { return _strands.size(); }
+    ExecutorId getExecutorId(uint64_t componentId) override;
+    void executeTask(ExecutorId id, vespalib::Executor::Task::UP task) override;
+    void sync() override;
+
+    /**
+     * Observe and reset stats for this object. Pending tasks include
+     * both queued tasks and tasks currently being run.
+     */
+    Stats getStats();
+
+    /**
+     * Observe and reset per strand stats, indexed by executor id.
+     */
+    std::vector<StrandStats> getStrandStats();
+};
+
+} // namespace search
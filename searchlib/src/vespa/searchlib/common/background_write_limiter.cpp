@@ -0,0 +1,75 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "background_write_limiter.h"
+#include <thread>
+
+namespace search {
+
+namespace {
+
+constexpr std::chrono::milliseconds BURST(100);
+
+}
+
+BackgroundWriteLimiter::BackgroundWriteLimiter()
+    : _lock(),
+      _maxBytesPerSecond(0),
+      _nextFree(),
+      _bytesWritten(0),
+      _throttledTime(Clock::duration::zero())
+{
+}
+
+BackgroundWriteLimiter::~BackgroundWriteLimiter() = default;
+
+void
+BackgroundWriteLimiter::setMaxBytesPerSecond(uint64_t maxBytesPerSecond)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _maxBytesPerSecond = maxBytesPerSecond;
+}
+
+void
+BackgroundWriteLimiter::acquire(size_t bytes)
+{
+    Clock::time_point wakeup;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _bytesWritten += bytes;
+        if (_maxBytesPerSecond == 0) {
+            return;
+        }
+        Clock::time_point now = Clock::now();
+        if (_nextFree < now - BURST) {
+            _nextFree = now - BURST;
+        }
+        _nextFree += std::chrono::duration_cast<Clock::duration>
+                     (std::chrono::duration<double>(double(bytes) / _maxBytesPerSecond));
+        if (_nextFree <= now) {
+            return;
+        }
+        wakeup = _nextFree;
+        _throttledTime += (wakeup - now);
+    }
+    std::this_thread::sleep_until(wakeup);
+}
+
+BackgroundWriteLimiter::Stats
+BackgroundWriteLimiter::getStats() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    Stats stats;
+    stats.maxBytesPerSecond = _maxBytesPerSecond;
+    stats.bytesWritten = _bytesWritten;
+    stats.throttledTime = std::chrono::duration<double>(_throttledTime).count();
+    return stats;
+}
+
+BackgroundWriteLimiter &
+BackgroundWriteLimiter::instance()
+{
+    static BackgroundWriteLimiter limiter;
+    return limiter;
+}
+
+}
@@ -0,0 +1,51 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace search {
+
+/**
+ * Limits the rate of disk writes done in the background (flushing
+ * attributes and indexes) so that they do not starve the reads done
+ * by queries on the same disk.
+ *
+ * Writers call acquire() before writing a block, and are put to sleep
+ * when they are ahead of the configured rate. A burst of 100 ms worth
+ * of writes is allowed before throttling starts. A rate of 0 means no
+ * limit. One instance is shared by all writers in the process.
+ */
+class BackgroundWriteLimiter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats {
+        uint64_t maxBytesPerSecond;
+        uint64_t bytesWritten;
+        double   throttledTime; // seconds writers have been put to sleep
+        Stats() : maxBytesPerSecond(0), bytesWritten(0), throttledTime(0.0) {}
+    };
+
+private:
+    mutable std::mutex _lock;
+    uint64_t           _maxBytesPerSecond;
+    Clock::time_point  _nextFree;
+    uint64_t           _bytesWritten;
+    Clock::duration    _throttledTime;
+
+public:
+    BackgroundWriteLimiter();
+    ~BackgroundWriteLimiter();
+
+    void setMaxBytesPerSecond(uint64_t maxBytesPerSecond);
+    /** Returns when the given number of bytes may be written. */
+    void acquire(size_t bytes);
+    Stats getStats() const;
+
+    static BackgroundWriteLimiter &instance();
+};
+
+}
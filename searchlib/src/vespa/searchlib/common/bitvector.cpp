@@ -20,6 +20,13 @@ using vespalib::alloc::Alloc;
 
 namespace {
 
+const IAccelrated &
+getAccelrator()
+{
+    static IAccelrated::UP accelrator = IAccelrated::getAccelrator();
+    return *accelrator;
+}
+
 void verifyContains(const search::BitVector & a, const search::BitVector & b) __attribute__((noinline));
 
 void verifyContains(const search::BitVector & a, const search::BitVector & b)
@@ -138,11 +145,7 @@ BitVector::count() const
 BitVector::Index
 BitVector::internalCount(const Word *tarr, size_t sz)
 {
-    Index count(0);
-    for (size_t i(0); i < sz; i++) {
-        count += Optimized::popCount(tarr[i]);
-    }
-    return count;
+    return getAccelrator().populationCount(tarr, sz);
 }
 
 BitVector::Index
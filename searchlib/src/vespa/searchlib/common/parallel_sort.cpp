@@ -0,0 +1,74 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "parallel_sort.h"
+#include <vespa/vespalib/util/lambdatask.h>
+#include <atomic>
+#include <memory>
+#include <condition_variable>
+#include <mutex>
+
+namespace search {
+
+namespace {
+
+/*
+ * Shared between the caller and the posted tasks. Tasks may be run
+ * after the caller has returned, but by then all parts are claimed
+ * and the task does not touch anything but this state.
+ */
+struct PartsState
+{
+    std::function<void(size_t)> _fn;
+    const size_t                _numParts;
+    std::atomic<size_t>         _nextPart;
+    std::mutex                  _lock;
+    std::condition_variable     _cond;
+    size_t                      _doneParts;
+
+    PartsState(const std::function<void(size_t)> &fn, size_t numParts)
+        : _fn(fn),
+          _numParts(numParts),
+          _nextPart(0),
+          _lock(),
+          _cond(),
+          _doneParts(0)
+    {
+    }
+
+    void drain() {
+        for (;;) {
+            size_t part = _nextPart.fetch_add(1);
+            if (part >= _numParts) {
+                return;
+            }
+            _fn(part);
+            std::lock_guard<std::mutex> guard(_lock);
+            if (++_doneParts == _numParts) {
+                _cond.notify_all();
+            }
+        }
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> guard(_lock);
+        _cond.wait(guard, [this]() { return _doneParts == _numParts; });
+    }
+};
+
+}
+
+void
+runParallelParts(vespalib::Executor &executor, size_t numParts, const std::function<void(size_t)> &fn)
+{
+    if (numParts == 0) {
+        return;
+    }
+    auto state = std::make_shared<PartsState>(fn, numParts);
+    for (size_t i = 1; i < numParts; ++i) {
+        executor.execute(vespalib::makeLambdaTask([state]() { state->drain(); }));
+    }
+    state->drain();
+    state->wait();
+}
+
+}
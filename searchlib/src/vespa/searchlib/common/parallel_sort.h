@@ -0,0 +1,100 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace vespalib { class Executor; }
+
+namespace search {
+
+/**
+ * Run fn(0) .. fn(numParts - 1) using the given executor. Parts are
+ * claimed dynamically both by tasks posted to the executor and by the
+ * calling thread, and the call returns when all parts are done. Since
+ * the calling thread only waits for parts already being processed by
+ * other threads, it is safe to call this from a thread owned by the
+ * executor, and tasks rejected by the executor are simply ignored.
+ **/
+void runParallelParts(vespalib::Executor &executor, size_t numParts, const std::function<void(size_t)> &fn);
+
+/**
+ * Sort a[0, n) by first distributing the elements in place into
+ * buckets on the leading bits of R(a[i]) - min(R), then sorting
+ * groups of buckets concurrently using sortRange(begin, count).
+ * Given that R provides the primary sort order, the result is
+ * the same as sortRange(a, n). Small arrays, or a null executor,
+ * give a plain call to sortRange.
+ **/
+template <typename T, typename GR, typename SortRange>
+void
+parallelBucketSort(GR R, T *a, size_t n, vespalib::Executor *executor, SortRange sortRange)
+{
+    constexpr size_t MIN_PARALLEL = 1u << 16;
+    constexpr uint64_t NUM_BUCKETS = 4096;
+    constexpr size_t NUM_PARTS = 64;
+    if ((executor == nullptr) || (n < MIN_PARALLEL)) {
+        sortRange(a, n);
+        return;
+    }
+    uint64_t minKey = R(a[0]);
+    uint64_t maxKey = minKey;
+    for (size_t i = 1; i < n; ++i) {
+        uint64_t key = R(a[i]);
+        minKey = std::min(minKey, key);
+        maxKey = std::max(maxKey, key);
+    }
+    uint32_t shift = 0;
+    while (((maxKey - minKey) >> shift) >= NUM_BUCKETS) {
+        ++shift;
+    }
+    uint32_t numBuckets = ((maxKey - minKey) >> shift) + 1;
+    if (numBuckets < 2) {
+        sortRange(a, n);
+        return;
+    }
+    auto bucket = [&](const T &v) -> uint32_t { return (R(v) - minKey) >> shift; };
+    std::vector<size_t> last(numBuckets + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        ++last[bucket(a[i]) + 1];
+    }
+    for (uint32_t b = 0; b < numBuckets; ++b) {
+        last[b + 1] += last[b];
+    }
+    std::vector<size_t> ptr(last.begin(), last.end() - 1);
+    // Follow permutation cycles until every bucket is filled
+    for (uint32_t b = 0; b < numBuckets; ++b) {
+        while (ptr[b] < last[b + 1]) {
+            T v = a[ptr[b]];
+            uint32_t vb = bucket(v);
+            while (vb != b) {
+                std::swap(v, a[ptr[vb]++]);
+                vb = bucket(v);
+            }
+            a[ptr[b]++] = v;
+        }
+    }
+    std::vector<uint32_t> partStart;
+    size_t partLimit = 0;
+    for (uint32_t b = 0; b < numBuckets; ++b) {
+        if (last[b] >= partLimit) {
+            partStart.push_back(b);
+            partLimit = last[b] + (n + NUM_PARTS - 1) / NUM_PARTS;
+        }
+    }
+    partStart.push_back(numBuckets);
+    runParallelParts(*executor, partStart.size() - 1,
+                     [&](size_t part)
+                     {
+                         size_t begin = last[partStart[part]];
+                         size_t end = last[partStart[part + 1]];
+                         if (end - begin > 1) {
+                             sortRange(a + begin, end - begin);
+                         }
+                     });
+}
+
+}
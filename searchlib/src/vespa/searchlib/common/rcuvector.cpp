@@ -14,6 +14,7 @@ template class RcuVectorBase<int32_t>;
 template class RcuVectorBase<int64_t>;
 template class RcuVectorBase<float>;
 template class RcuVectorBase<double>;
+template class RcuVectorBase<uint64_t *>;
 
 template class RcuVector<uint8_t>;
 template class RcuVector<uint16_t>;
@@ -34,6 +35,7 @@ template class RcuVectorHeld<int32_t>;
 template class RcuVectorHeld<int64_t>;
 template class RcuVectorHeld<float>;
 template class RcuVectorHeld<double>;
+template class RcuVectorHeld<uint64_t *>;
 
 }
 }
@@ -45,6 +45,7 @@ protected:
     using GenerationHolder = vespalib::GenerationHolder;
 private:
     Array              _data;
+    Alloc              _allocStrategy; // Used for all reallocations of _data
     size_t             _growPercent;
     size_t             _growDelta;
     GenerationHolder   &_genHolder;
@@ -121,6 +122,11 @@ public:
     const T & operator[](size_t i) const { return _data[i]; }
 
     void reset();
+    /**
+     * Replace the underlying data with the first n elements in the given
+     * buffer, e.g. a mapped file. Like reset(), it assumes no readers.
+     **/
+    void unsafe_assign(Alloc &&buf, size_t n);
     void shrink(size_t newSize) __attribute__((noinline));
 };
 
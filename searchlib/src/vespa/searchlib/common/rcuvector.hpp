@@ -42,17 +42,24 @@ template <typename T>
 void
 RcuVectorBase<T>::reset() {
     // Assumes no readers at this moment
-    Array().swap(_data);
+    Array(_allocStrategy).swap(_data);
     _data.reserve(16);
 }
 
+template <typename T>
+void
+RcuVectorBase<T>::unsafe_assign(Alloc &&buf, size_t n) {
+    assert(n * sizeof(T) <= buf.size());
+    Array(std::move(buf), n).swap(_data);
+}
+
 template <typename T>
 RcuVectorBase<T>::~RcuVectorBase() { }
 
 template <typename T>
 void
 RcuVectorBase<T>::expand(size_t newCapacity) {
-    std::unique_ptr<Array> tmpData(new Array());
+    std::unique_ptr<Array> tmpData(new Array(_allocStrategy));
     tmpData->reserve(newCapacity);
     for (const T & v : _data) {
         tmpData->push_back_fast(v);
@@ -84,7 +91,7 @@ RcuVectorBase<T>::shrink(size_t newSize)
         return;
     }
     if (!_data.try_unreserve(wantedCapacity)) {
-        std::unique_ptr <Array> tmpData(new Array());
+        std::unique_ptr <Array> tmpData(new Array(_allocStrategy));
         tmpData->reserve(wantedCapacity);
         tmpData->resize(newSize);
         for (uint32_t i = 0; i < newSize; ++i) {
@@ -104,6 +111,7 @@ template <typename T>
 RcuVectorBase<T>::RcuVectorBase(GenerationHolder &genHolder,
                                 const Alloc &initialAlloc)
     : _data(initialAlloc),
+      _allocStrategy(initialAlloc.create(0)),
       _growPercent(100),
       _growDelta(0),
       _genHolder(genHolder)
@@ -118,6 +126,7 @@ RcuVectorBase<T>::RcuVectorBase(size_t initialCapacity,
                                 GenerationHolder &genHolder,
                                 const Alloc &initialAlloc)
     : _data(initialAlloc),
+      _allocStrategy(initialAlloc.create(0)),
       _growPercent(growPercent),
       _growDelta(growDelta),
       _genHolder(genHolder)
@@ -0,0 +1,116 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "rcuvector.h"
+#include <vector>
+
+namespace search::attribute {
+
+namespace segmented_rcuvector {
+
+/**
+ * Number of bits in the largest power of two count of elements of the
+ * given size fitting in a segment of the given size.
+ **/
+constexpr size_t
+segmentBits(size_t elemSize, size_t segmentBytes, size_t bits = 0)
+{
+    return ((elemSize << (bits + 1)) > segmentBytes) ? bits : segmentBits(elemSize, segmentBytes, bits + 1);
+}
+
+}
+
+/**
+ * Vector class for elements of type T with the same read-copy-update
+ * semantics as RcuVectorBase, but storing the elements in fixed size
+ * segments found through a small directory. Growing the vector adds
+ * segments and only copies the directory, so the elements are never
+ * moved. This avoids holding both the old and the new copy of a large
+ * vector and stalling the writer thread while copying it.
+ *
+ * Capacity grows with the same grow parameters as RcuVectorBase, in
+ * whole segments. Indexed access costs one extra load.
+ **/
+template <typename T>
+class SegmentedRcuVectorBase
+{
+private:
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "Value type must be trivially destructible");
+
+    using Alloc = vespalib::alloc::Alloc;
+    using Directory = vespalib::Array<T *>;
+protected:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+    using GenerationHolder = vespalib::GenerationHolder;
+public:
+    static constexpr size_t SEGMENT_BYTES = 64 * 1024;
+    static constexpr size_t SEGMENT_BITS = segmented_rcuvector::segmentBits(sizeof(T), SEGMENT_BYTES);
+    static constexpr size_t SEGMENT_SIZE = size_t(1) << SEGMENT_BITS; // Elements per segment
+private:
+    Directory          _directory;
+    std::vector<Alloc> _segments;      // Owns the memory referenced from the directory
+    size_t             _size;
+    Alloc              _allocStrategy; // Used for all segment and directory allocations
+    size_t             _growPercent;
+    size_t             _growDelta;
+    GenerationHolder   &_genHolder;
+
+    size_t calcNewSize(size_t baseSize) const {
+        size_t delta = (baseSize * _growPercent / 100) + _growDelta;
+        return baseSize + std::max(delta, static_cast<size_t>(1));
+    }
+    static size_t numSegments(size_t n) { return (n + SEGMENT_SIZE - 1) >> SEGMENT_BITS; }
+    void expand(size_t newCapacity);
+    void expandDirectory(size_t wantedSegments);
+    T * elem(size_t i) const { return _directory[i >> SEGMENT_BITS] + (i & (SEGMENT_SIZE - 1)); }
+
+public:
+    using ValueType = T;
+    SegmentedRcuVectorBase(size_t initialCapacity, size_t growPercent, size_t growDelta,
+                           GenerationHolder &genHolder,
+                           const Alloc &initialAlloc = Alloc::alloc());
+    SegmentedRcuVectorBase(GrowStrategy growStrategy,
+                           GenerationHolder &genHolder,
+                           const Alloc &initialAlloc = Alloc::alloc());
+    ~SegmentedRcuVectorBase();
+
+    bool isFull() const { return _size == capacity(); }
+    MemoryUsage getMemoryUsage() const;
+
+    /**
+     * Elements are never moved, so reserving capacity is safe even
+     * with readers present.
+     **/
+    void unsafe_reserve(size_t n) { reserve(n); }
+    void ensure_size(size_t n, T fill = T());
+    void reserve(size_t n) {
+        if (n > capacity()) {
+            expand(n);
+        }
+    }
+    void push_back(const T & v) {
+        if (_size == capacity()) {
+            expand(calcNewSize(capacity()));
+        }
+        new (elem(_size)) T(v);
+        ++_size;
+    }
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+    size_t capacity() const { return _segments.size() * SEGMENT_SIZE; }
+    void clear() { _size = 0; }
+    T & operator[](size_t i) { return *elem(i); }
+    const T & operator[](size_t i) const { return *elem(i); }
+
+    /**
+     * Shrink to the given size and release segments no longer needed
+     * for the capacity given by the grow parameters. As for
+     * RcuVectorBase, readers must not use the old size afterwards.
+     **/
+    void shrink(size_t newSize) __attribute__((noinline));
+};
+
+}
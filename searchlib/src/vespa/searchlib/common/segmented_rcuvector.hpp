@@ -0,0 +1,106 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "segmented_rcuvector.h"
+#include "rcuvector.hpp"
+
+namespace search::attribute {
+
+template <typename T>
+SegmentedRcuVectorBase<T>::SegmentedRcuVectorBase(size_t initialCapacity,
+                                                  size_t growPercent,
+                                                  size_t growDelta,
+                                                  GenerationHolder &genHolder,
+                                                  const Alloc &initialAlloc)
+    : _directory(initialAlloc.create(0)),
+      _segments(),
+      _size(0),
+      _allocStrategy(initialAlloc.create(0)),
+      _growPercent(growPercent),
+      _growDelta(growDelta),
+      _genHolder(genHolder)
+{
+    reserve(std::max(initialCapacity, size_t(1)));
+}
+
+template <typename T>
+SegmentedRcuVectorBase<T>::SegmentedRcuVectorBase(GrowStrategy growStrategy,
+                                                  GenerationHolder &genHolder,
+                                                  const Alloc &initialAlloc)
+    : SegmentedRcuVectorBase(growStrategy.getDocsInitialCapacity(), growStrategy.getDocsGrowPercent(),
+                             growStrategy.getDocsGrowDelta(), genHolder, initialAlloc)
+{
+}
+
+template <typename T>
+SegmentedRcuVectorBase<T>::~SegmentedRcuVectorBase() = default;
+
+template <typename T>
+void
+SegmentedRcuVectorBase<T>::expandDirectory(size_t wantedSegments)
+{
+    auto tmpDirectory = std::make_unique<Directory>(_allocStrategy.create(0));
+    tmpDirectory->reserve(std::max(wantedSegments, 2 * _directory.capacity()));
+    for (T * segment : _directory) {
+        tmpDirectory->push_back_fast(segment);
+    }
+    tmpDirectory->swap(_directory); // atomic switch of directory
+    size_t holdSize = tmpDirectory->capacity() * sizeof(T *);
+    vespalib::GenerationHeldBase::UP hold(new RcuVectorHeld<Directory>(holdSize, std::move(tmpDirectory)));
+    _genHolder.hold(std::move(hold));
+}
+
+template <typename T>
+void
+SegmentedRcuVectorBase<T>::expand(size_t newCapacity)
+{
+    size_t wantedSegments = numSegments(newCapacity);
+    if (wantedSegments > _directory.capacity()) {
+        expandDirectory(wantedSegments);
+    }
+    while (_segments.size() < wantedSegments) {
+        _segments.push_back(_allocStrategy.create(SEGMENT_SIZE * sizeof(T)));
+        _directory.push_back_fast(static_cast<T *>(_segments.back().get()));
+    }
+}
+
+template <typename T>
+void
+SegmentedRcuVectorBase<T>::ensure_size(size_t n, T fill)
+{
+    reserve(n);
+    while (_size < n) {
+        new (elem(_size)) T(fill);
+        ++_size;
+    }
+}
+
+template <typename T>
+void
+SegmentedRcuVectorBase<T>::shrink(size_t newSize)
+{
+    assert(newSize <= _size);
+    _size = newSize;
+    size_t wantedSegments = std::max(numSegments(calcNewSize(newSize)), size_t(1));
+    while (_segments.size() > wantedSegments) {
+        auto segment = std::make_unique<Alloc>(std::move(_segments.back()));
+        _segments.pop_back();
+        _directory.resize(_segments.size());
+        size_t holdSize = SEGMENT_SIZE * sizeof(T);
+        vespalib::GenerationHeldBase::UP hold(new RcuVectorHeld<Alloc>(holdSize, std::move(segment)));
+        _genHolder.hold(std::move(hold));
+    }
+}
+
+template <typename T>
+MemoryUsage
+SegmentedRcuVectorBase<T>::getMemoryUsage() const
+{
+    MemoryUsage retval;
+    retval.incAllocatedBytes(capacity() * sizeof(T) + _directory.capacity() * sizeof(T *));
+    retval.incUsedBytes(_size * sizeof(T) + _directory.size() * sizeof(T *));
+    return retval;
+}
+
+}
@@ -218,6 +218,72 @@ FastS_SortSpec::realloc(uint32_t n, size_t & variableWidth, uint32_t & available
     return &_binarySortData[0] + byteUsed;
 }
 
+bool
+FastS_SortSpec::initFixedWidthSortData(const RankedHit *hits, uint32_t n, size_t width)
+{
+    _binarySortData.resize(width * n);
+    _sortDataArray.resize(n);
+    for (uint32_t i(0); i < n; ++i) {
+        SortData & sd = _sortDataArray[i];
+        sd._docId = hits[i]._docId;
+        sd._rankValue = hits[i]._rankValue;
+        sd._idx = i * width;
+        sd._len = width;
+        sd._pos = 0;
+    }
+    // One column at a time, so each inner loop only touches a single attribute.
+    size_t offset = 0;
+    for (auto iter = _vectors.begin(); (iter != _vectors.end()) && !_doom.doom(); ++iter) {
+        uint8_t *dst = &_binarySortData[0] + offset;
+        size_t columnWidth = 0;
+        switch (iter->_type) {
+        case ASC_DOCID:
+        case DESC_DOCID:
+            columnWidth = sizeof(hits->_docId) + sizeof(_partitionId);
+            for (uint32_t i(0); i < n; ++i, dst += width) {
+                if (iter->_type == ASC_DOCID) {
+                    serializeForSort<convertForSort<uint32_t, true> >(hits[i].getDocId(), dst);
+                    serializeForSort<convertForSort<uint16_t, true> >(_partitionId, dst + sizeof(hits->_docId));
+                } else {
+                    serializeForSort<convertForSort<uint32_t, false> >(hits[i].getDocId(), dst);
+                    serializeForSort<convertForSort<uint16_t, false> >(_partitionId, dst + sizeof(hits->_docId));
+                }
+            }
+            break;
+        case ASC_RANK:
+            columnWidth = sizeof(hits->_rankValue);
+            for (uint32_t i(0); i < n; ++i, dst += width) {
+                serializeForSort<convertForSort<search::HitRank, true> >(hits[i]._rankValue, dst);
+            }
+            break;
+        case DESC_RANK:
+            columnWidth = sizeof(hits->_rankValue);
+            for (uint32_t i(0); i < n; ++i, dst += width) {
+                serializeForSort<convertForSort<search::HitRank, false> >(hits[i]._rankValue, dst);
+            }
+            break;
+        case ASC_VECTOR:
+            columnWidth = iter->_vector->getFixedWidth();
+            for (uint32_t i(0); i < n; ++i, dst += width) {
+                if (iter->_vector->serializeForAscendingSort(hits[i].getDocId(), dst, columnWidth, iter->_converter) != long(columnWidth)) {
+                    return false;
+                }
+            }
+            break;
+        case DESC_VECTOR:
+            columnWidth = iter->_vector->getFixedWidth();
+            for (uint32_t i(0); i < n; ++i, dst += width) {
+                if (iter->_vector->serializeForDescendingSort(hits[i].getDocId(), dst, columnWidth, iter->_converter) != long(columnWidth)) {
+                    return false;
+                }
+            }
+            break;
+        }
+        offset += columnWidth;
+    }
+    return true;
+}
+
 void
 FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
 {
@@ -238,6 +304,12 @@ FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
             }
         }
     }
+    if ((variableWidth == 0) && (fixedWidth > 0)) {
+        if (initFixedWidthSortData(hits, n, fixedWidth)) {
+            return;
+        }
+        freeSortData();
+    }
     uint32_t dataSize = (fixedWidth + variableWidth) * n;
     uint32_t available = dataSize;
     _binarySortData.resize(dataSize);
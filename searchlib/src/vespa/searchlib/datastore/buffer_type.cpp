@@ -33,7 +33,8 @@ BufferTypeBase::BufferTypeBase(uint32_t clusterSize,
       _holdBuffers(0),
       _activeUsedElems(0),
       _holdUsedElems(0),
-      _lastUsedElems(nullptr)
+      _lastUsedElems(nullptr),
+      _hugePages(false)
 {
 }
 
@@ -25,6 +25,7 @@ protected:
     size_t _activeUsedElems;    // used elements in all but last active buffer
     size_t _holdUsedElems;  // used elements in all held buffers
     const size_t *_lastUsedElems; // used elements in last active buffer
+    bool _hugePages; // Allocate new buffers aligned to and backed by huge pages
 
 public:
     class CleanContext {
@@ -72,6 +73,12 @@ public:
     uint32_t getActiveBuffers() const { return _activeBuffers; }
     uint32_t getMaxClusters() const { return _maxClusters; }
     uint32_t getNumClustersForNewBuffer() const { return _numClustersForNewBuffer; }
+    /**
+     * Select whether buffers allocated from now on should be backed by
+     * huge pages. Buffers already allocated are not affected.
+     */
+    void setHugePages(bool hugePages) { _hugePages = hugePages; }
+    bool getHugePages() const { return _hugePages; }
 };
 
 
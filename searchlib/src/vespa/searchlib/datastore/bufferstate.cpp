@@ -111,7 +111,11 @@ BufferState::onActive(uint32_t bufferId, uint32_t typeId,
     (void) reservedElements;
     AllocResult alloc = calcAllocation(bufferId, *typeHandler, elementsNeeded, false);
     assert(alloc.elements >= reservedElements + elementsNeeded);
-    _buffer.create(alloc.bytes).swap(_buffer);
+    if (typeHandler->getHugePages()) {
+        Alloc::allocHugePages(alloc.bytes).swap(_buffer);
+    } else {
+        _buffer.create(alloc.bytes).swap(_buffer);
+    }
     buffer = _buffer.get();
     assert(buffer != NULL || alloc.elements == 0u);
     _allocElems = alloc.elements;
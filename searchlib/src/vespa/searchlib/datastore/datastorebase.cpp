@@ -264,6 +264,15 @@ DataStoreBase::disableFreeLists()
 }
 
 
+void
+DataStoreBase::setHugePages(bool hugePages)
+{
+    for (BufferTypeBase * typeHandler : _typeHandlers) {
+        typeHandler->setHugePages(hugePages);
+    }
+}
+
+
 void
 DataStoreBase::enableFreeList(uint32_t bufferId)
 {
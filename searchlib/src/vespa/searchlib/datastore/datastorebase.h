@@ -290,6 +290,12 @@ public:
      */
     void disableFreeLists();
 
+    /**
+     * Select whether new buffers for the registered buffer types should
+     * be backed by huge pages.
+     */
+    void setHugePages(bool hugePages);
+
     /**
      * Enable free list management.  This only works for fixed size elements.
      */
@@ -0,0 +1,131 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dictionary_bloom_filter.h"
+#include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/xxhash/xxhash.h>
+#include <vespa/fastos/file.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".diskindex.dictionary_bloom_filter");
+
+namespace search::diskindex {
+
+namespace {
+
+const vespalib::string numBlocksTag("numBlocks");
+const vespalib::string numProbesTag("numProbes");
+
+/**
+ * Bits within the block are taken from a remixed hash, as the block
+ * itself is selected by the low bits of the original hash.
+ */
+uint64_t
+probeBits(uint64_t hash)
+{
+    hash ^= hash >> 31;
+    hash *= 0x7fb5d329728ea185ul;
+    hash ^= hash >> 27;
+    return hash;
+}
+
+}
+
+DictionaryBloomFilter::DictionaryBloomFilter()
+    : _bits()
+{
+}
+
+DictionaryBloomFilter::DictionaryBloomFilter(const std::vector<uint64_t> &hashes)
+    : _bits()
+{
+    size_t numBlocks = (hashes.size() * BITS_PER_WORD + 511) / 512;
+    _bits.resize(std::max(numBlocks, size_t(1)) * BLOCK_WORDS);
+    for (uint64_t h : hashes) {
+        uint64_t *block = &_bits[(h % getNumBlocks()) * BLOCK_WORDS];
+        uint64_t probes = probeBits(h);
+        for (uint32_t i = 0; i < NUM_PROBES; ++i, probes >>= 9) {
+            block[(probes >> 6) & 7] |= (1ul << (probes & 63));
+        }
+    }
+}
+
+DictionaryBloomFilter::~DictionaryBloomFilter() = default;
+
+uint64_t
+DictionaryBloomFilter::hash(vespalib::stringref word)
+{
+    return XXH64(word.data(), word.size(), 0);
+}
+
+bool
+DictionaryBloomFilter::mightContain(uint64_t h) const
+{
+    if (_bits.empty()) {
+        return true;
+    }
+    const uint64_t *block = &_bits[(h % getNumBlocks()) * BLOCK_WORDS];
+    uint64_t probes = probeBits(h);
+    for (uint32_t i = 0; i < NUM_PROBES; ++i, probes >>= 9) {
+        if ((block[(probes >> 6) & 7] & (1ul << (probes & 63))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+DictionaryBloomFilter::save(const vespalib::string &fileName,
+                            const TuneFileSeqWrite &tuneFileWrite,
+                            vespalib::FileHeader &header) const
+{
+    FastOS_File file;
+    if (tuneFileWrite.getWantSyncWrites()) {
+        file.EnableSyncWrites();
+    }
+    if (!file.OpenWriteOnlyTruncate(fileName.c_str())) {
+        LOG(error, "Could not open dictionary bloom filter '%s' for write", fileName.c_str());
+        return false;
+    }
+    typedef vespalib::GenericHeader::Tag Tag;
+    header.putTag(Tag("desc", "Bloom filter over dictionary words"));
+    header.putTag(Tag(numBlocksTag, static_cast<uint64_t>(getNumBlocks())));
+    header.putTag(Tag(numProbesTag, static_cast<uint64_t>(NUM_PROBES)));
+    header.writeFile(file);
+    size_t bytes = _bits.size() * sizeof(uint64_t);
+    bool ok = (file.Write2(_bits.data(), bytes) == static_cast<ssize_t>(bytes));
+    ok = file.Sync() && ok;
+    ok = file.Close() && ok;
+    if (!ok) {
+        LOG(error, "Could not write dictionary bloom filter '%s'", fileName.c_str());
+    }
+    return ok;
+}
+
+bool
+DictionaryBloomFilter::load(const vespalib::string &fileName)
+{
+    FastOS_File file;
+    if (!file.OpenReadOnly(fileName.c_str())) {
+        return false;
+    }
+    vespalib::FileHeader header;
+    uint32_t headerLen = header.readFile(file);
+    if (!header.hasTag(numBlocksTag) || !header.hasTag(numProbesTag) ||
+        header.getTag(numProbesTag).asInteger() != NUM_PROBES)
+    {
+        LOG(warning, "Ignoring dictionary bloom filter '%s' with unknown layout", fileName.c_str());
+        return false;
+    }
+    size_t numWords = header.getTag(numBlocksTag).asInteger() * BLOCK_WORDS;
+    size_t bytes = numWords * sizeof(uint64_t);
+    if (file.GetSize() < static_cast<int64_t>(headerLen + bytes)) {
+        LOG(warning, "Truncated dictionary bloom filter '%s'", fileName.c_str());
+        return false;
+    }
+    std::vector<uint64_t> bits(numWords);
+    file.ReadBuf(bits.data(), bytes, headerLen);
+    _bits.swap(bits);
+    return true;
+}
+
+}
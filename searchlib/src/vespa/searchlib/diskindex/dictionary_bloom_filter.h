@@ -0,0 +1,57 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/searchlib/common/tunefileinfo.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vector>
+
+namespace vespalib { class FileHeader; }
+
+namespace search::diskindex {
+
+/**
+ * Bloom filter over the words in the dictionary of one field in a
+ * disk index. It is written next to the dictionary by FieldWriter and
+ * kept in memory by DiskIndex, which uses it to skip dictionary
+ * lookups for words that are not in the field. Most lookups of rare
+ * words miss in all but one of the disk indexes of a document db.
+ *
+ * The filter is blocked: all bits for a word are set in the same 512
+ * bit block, so a query touches a single cache line.
+ */
+class DictionaryBloomFilter
+{
+public:
+    static constexpr uint32_t BITS_PER_WORD = 10;
+    static constexpr uint32_t NUM_PROBES = 7;
+    static constexpr uint32_t BLOCK_WORDS = 8;  // 64 bit words per 512 bit block
+
+    DictionaryBloomFilter();
+    /**
+     * Build a filter holding the words with the given hashes.
+     */
+    explicit DictionaryBloomFilter(const std::vector<uint64_t> &hashes);
+    ~DictionaryBloomFilter();
+
+    static uint64_t hash(vespalib::stringref word);
+
+    bool mightContain(uint64_t hash) const;
+    bool mightContain(vespalib::stringref word) const { return mightContain(hash(word)); }
+
+    /**
+     * Write the filter to the given file. The header should already
+     * hold the tags from the file header context.
+     */
+    bool save(const vespalib::string &fileName,
+              const TuneFileSeqWrite &tuneFileWrite,
+              vespalib::FileHeader &header) const;
+    bool load(const vespalib::string &fileName);
+
+    size_t getNumBlocks() const { return _bits.size() / BLOCK_WORDS; }
+    size_t getMemoryUsage() const { return _bits.size() * sizeof(uint64_t); }
+
+private:
+    std::vector<uint64_t> _bits;
+};
+
+}
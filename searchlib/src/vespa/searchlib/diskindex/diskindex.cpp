@@ -44,15 +44,18 @@ DiskIndex::Key::Key(const IndexList & indexes, vespalib::stringref word) :
 { }
 DiskIndex::Key::~Key() { }
 
-DiskIndex::DiskIndex(const vespalib::string &indexDir, size_t cacheSize)
+DiskIndex::DiskIndex(const vespalib::string &indexDir, size_t cacheSize, PostingListCache::SP postingListCache)
     : _indexDir(indexDir),
       _cacheSize(cacheSize),
       _schema(),
       _postingFiles(),
+      _postingFileIds(),
       _bitVectorDicts(),
       _dicts(),
+      _dictFilters(),
       _tuneFileSearch(),
       _cache(*this, cacheSize),
+      _postingListCache(std::move(postingListCache)),
       _size(0)
 {
     calculateSize();
@@ -79,16 +82,24 @@ DiskIndex::loadSchema()
 bool
 DiskIndex::openDictionaries(const TuneFileSearch &tuneFileSearch)
 {
+    // Decoded dictionary pages get the same byte budget as the lookup cache, split across fields.
+    size_t pageCacheSize = _cacheSize / std::max(_schema.getNumIndexFields(), uint32_t(1));
     for (SchemaUtil::IndexIterator itr(_schema); itr.isValid(); ++itr) {
         vespalib::string dictName =
             _indexDir + "/" + itr.getName() + "/dictionary";
-        auto dict = std::make_unique<PageDict4RandRead>();
+        auto dict = std::make_unique<PageDict4RandRead>(pageCacheSize);
         if (!dict->open(dictName, tuneFileSearch._read)) {
             LOG(warning, "Could not open disk dictionary '%s'", dictName.c_str());
             _dicts.clear();
+            _dictFilters.clear();
             return false;
         }
         _dicts.push_back(std::move(dict));
+        auto filter = std::make_unique<DictionaryBloomFilter>();
+        if (!filter->load(dictName + ".bloom")) {
+            filter.reset();
+        }
+        _dictFilters.push_back(std::move(filter));
     }
     return true;
 }
@@ -146,6 +157,7 @@ DiskIndex::openField(const vespalib::string &fieldDir,
         return false;
     }
     _postingFiles.push_back(pFile);
+    _postingFileIds.push_back(PostingListCache::newFileId());
     _bitVectorDicts.push_back(bDict);
     return true;
 }
@@ -191,6 +203,7 @@ DiskIndex::setup(const TuneFileSearch &tuneFileSearch,
         } else {
             uint32_t oldPacked = oItr.getIndex();
             _postingFiles.push_back(old._postingFiles[oldPacked]);
+            _postingFileIds.push_back(old._postingFileIds[oldPacked]);
             _bitVectorDicts.push_back(old._bitVectorDicts[oldPacked]);
         }
     }
@@ -273,6 +286,7 @@ bool
 DiskIndex::read(const Key & key, LookupResultVector & result)
 {
     uint64_t wordNum(0);
+    const uint64_t wordHash = DictionaryBloomFilter::hash(key.getWord());
     const IndexList & indexes(key.getIndexes());
     result.resize(indexes.size());
     for (size_t i(0); i < result.size(); i++) {
@@ -282,7 +296,9 @@ DiskIndex::read(const Key & key, LookupResultVector & result)
         wordNum = 0;
         SchemaUtil::IndexIterator it(_schema, lr.indexId);
         uint32_t fieldId = it.getIndex();
-        if (fieldId < _dicts.size()) {
+        if (fieldId < _dicts.size() &&
+            (!_dictFilters[fieldId] || _dictFilters[fieldId]->mightContain(wordHash)))
+        {
             (void) _dicts[fieldId]->lookup(key.getWord(), wordNum,
                                            offsetAndCounts);
         }
@@ -304,16 +320,38 @@ DiskIndex::readPostingList(const LookupResult &lookupRes) const
     if (handle->_file == NULL) {
         return PostingListHandle::UP();
     }
+    PostingListCache::Key cacheKey(_postingFileIds[it.getIndex()], lookupRes.bitOffset);
+    if (_postingListCache && _postingListCache->lookup(cacheKey, *handle)) {
+        return handle;
+    }
     const uint32_t firstSegment = 0;
     const uint32_t numSegments = 0; // means all segments
     handle->_file->readPostingList(lookupRes.counts,
                                    firstSegment,
                                    numSegments,
                                    *handle);
+    if (_postingListCache) {
+        _postingListCache->insert(cacheKey, *handle);
+    }
     return handle;
 }
 
 
+void
+DiskIndex::prefetchPostingList(const LookupResult &lookupRes) const
+{
+    SchemaUtil::IndexIterator it(_schema, lookupRes.indexId);
+    const index::PostingListFileRandRead *file = _postingFiles[it.getIndex()].get();
+    if (file == NULL) {
+        return;
+    }
+    PostingListHandle handle;
+    handle._bitOffset = lookupRes.bitOffset;
+    handle._bitLength = lookupRes.counts._bitLength;
+    file->prefetchPostingList(handle);
+}
+
+
 BitVector::UP
 DiskIndex::readBitVector(const LookupResult &lookupRes) const
 {
@@ -395,6 +433,10 @@ public:
         const DiskIndex::LookupResult & lookupRes = _cache.lookup(termStr, _fieldId);
         if (lookupRes.valid()) {
             bool useBitVector = _field.isFilter();
+            if (!useBitVector) {
+                // Filter terms are likely to use a bit vector instead
+                _diskIndex.prefetchPostingList(lookupRes);
+            }
             DiskIndex::LookupResult::UP copy(new DiskIndex::LookupResult(lookupRes));
             setResult(make_UP(new DiskTermBlueprint(_field, _diskIndex, std::move(copy), useBitVector)));
         } else {
@@ -414,6 +456,7 @@ public:
     void visit(SuffixTerm &n)    override { visitTerm(n); }
     void visit(RegExpTerm &n)    override { visitTerm(n); }
     void visit(PredicateQuery &) override { }
+    void visit(NearestNeighborTerm &) override { }
 };
 
 
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "bitvectordictionary.h"
+#include "dictionary_bloom_filter.h"
+#include "posting_list_cache.h"
 #include "zcposoccrandread.h"
 #include <vespa/searchlib/index/dictionaryfile.h>
 #include <vespa/searchlib/queryeval/searchable.h>
@@ -73,10 +75,13 @@ private:
     size_t                                 _cacheSize;
     index::Schema                          _schema;
     std::vector<DiskPostingFile::SP>       _postingFiles;
+    std::vector<uint64_t>                  _postingFileIds;   // Posting list cache key per posting file
     std::vector<BitVectorDictionary::SP>   _bitVectorDicts;
     std::vector<std::unique_ptr<index::DictionaryFileRandRead>> _dicts;
+    std::vector<std::unique_ptr<DictionaryBloomFilter>> _dictFilters; // nullptr for indexes written without one
     TuneFileSearch                         _tuneFileSearch;
     Cache                                  _cache;
+    PostingListCache::SP                   _postingListCache;
     uint64_t                               _size;
 
     void calculateSize();
@@ -90,8 +95,12 @@ public:
      * described by the given schema.
      *
      * @param indexDir the directory where the disk index is located.
+     * @param cacheSize the byte budget of the dictionary lookup cache.
+     * @param postingListCache optional cache, shared with other disk
+     *                         indexes, for posting lists read from disk.
      **/
-    DiskIndex(const vespalib::string &indexDir, size_t cacheSize=0);
+    DiskIndex(const vespalib::string &indexDir, size_t cacheSize=0,
+              PostingListCache::SP postingListCache = PostingListCache::SP());
     ~DiskIndex();
 
     /**
@@ -123,6 +132,16 @@ public:
      **/
     index::PostingListHandle::UP readPostingList(const LookupResult &lookupRes) const;
 
+    /**
+     * Hint that the posting list corresponding to the given lookup
+     * result will be read soon. Called when creating the blueprints
+     * of a query, so the reads needed by all its terms are started
+     * before fetchPostings() reads them one at a time.
+     *
+     * @param lookupRes the result of the previous dictionary lookup.
+     **/
+    void prefetchPostingList(const LookupResult &lookupRes) const;
+
     /**
      * Read the bit vector corresponding to the given lookup result.
      *
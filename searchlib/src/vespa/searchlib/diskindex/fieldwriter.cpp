@@ -4,6 +4,9 @@
 #include "zcposocc.h"
 #include "extposocc.h"
 #include "pagedict4file.h"
+#include "dictionary_bloom_filter.h"
+#include <vespa/searchlib/common/fileheadercontext.h>
+#include <vespa/vespalib/data/fileheader.h>
 #include <vespa/vespalib/util/error.h>
 #include <vespa/log/log.h>
 
@@ -26,7 +29,10 @@ FieldWriter::FieldWriter(uint32_t docIdLimit,
       _numWordIds(numWordIds),
       _prefix(),
       _compactWordNum(0),
-      _word()
+      _word(),
+      _wordHashes(),
+      _tuneFileWrite(),
+      _bloomFilterHeader()
 {
 }
 
@@ -40,9 +46,11 @@ FieldWriter::open(const vespalib::string &prefix,
                   const Schema &schema,
                   const uint32_t indexId,
                   const TuneFileSeqWrite &tuneFileWrite,
-                  const FileHeaderContext &fileHeaderContext)
+                  const FileHeaderContext &fileHeaderContext,
+                  bool blockMaxWeights)
 {
     _prefix = prefix;
+    _tuneFileWrite = tuneFileWrite;
     vespalib::string name = prefix + "posocc.dat.compressed";
 
     PostingListParams params;
@@ -62,6 +70,9 @@ FieldWriter::open(const vespalib::string &prefix,
         countParams.set("minChunkDocs", minChunkDocs);
         params.set("minChunkDocs", minChunkDocs);
     }
+    if (blockMaxWeights) {
+        params.set("blockMaxWeights", true);
+    }
 
     _dictFile = std::make_unique<PageDict4FileSeqWrite>();
     _dictFile->setParams(countParams);
@@ -90,6 +101,10 @@ FieldWriter::open(const vespalib::string &prefix,
         return false;
     }
 
+    // Tag the bloom filter header now, as it is written when closing
+    _bloomFilterHeader = std::make_unique<vespalib::FileHeader>();
+    fileHeaderContext.addTags(*_bloomFilterHeader, _prefix + "dictionary.bloom");
+
     // Open output boolocc.bdat file
     vespalib::string booloccbidxname = _prefix + "boolocc";
     _bmapfile.open(booloccbidxname.c_str(), _docIdLimit, tuneFileWrite,
@@ -107,6 +122,7 @@ FieldWriter::flush()
     if (counts._numDocs != 0) {
         assert(_compactWordNum != 0);
         _dictFile->writeWord(_word, counts);
+        _wordHashes.push_back(DictionaryBloomFilter::hash(_word));
         // Write bitmap entries
         if (_bvc.getCrossedBitVectorLimit())
             _bmapfile.addWordSingle(_compactWordNum, _bvc.getBitVector());
@@ -165,12 +181,26 @@ FieldWriter::close()
         }
         _dictFile.reset();
     }
+    if (_bloomFilterHeader && !writeBloomFilter()) {
+        ret = false;
+    }
 
     _bmapfile.close();
     return ret;
 }
 
 
+bool
+FieldWriter::writeBloomFilter()
+{
+    DictionaryBloomFilter filter(_wordHashes);
+    std::vector<uint64_t>().swap(_wordHashes);
+    bool ok = filter.save(_prefix + "dictionary.bloom", _tuneFileWrite, *_bloomFilterHeader);
+    _bloomFilterHeader.reset();
+    return ok;
+}
+
+
 void
 FieldWriter::setFeatureParams(const PostingListParams &params)
 {
@@ -193,6 +223,7 @@ static const char *termOccNames[] =
     "posocc.ccnt",
     "posocc.cnt",
     "posocc.dat.compressed",
+    "dictionary.bloom",
     "dictionary.pdat",
     "dictionary.spdat",
     "dictionary.ssdat",
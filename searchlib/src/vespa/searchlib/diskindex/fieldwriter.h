@@ -8,6 +8,8 @@
 #include <vespa/searchlib/bitcompression/countcompression.h>
 #include <vespa/searchlib/bitcompression/posocccompression.h>
 
+namespace vespalib { class FileHeader; }
+
 namespace search {
 
 namespace diskindex {
@@ -51,8 +53,12 @@ private:
     vespalib::string _prefix;
     uint64_t _compactWordNum;
     vespalib::string _word;
+    std::vector<uint64_t> _wordHashes;  // Words written, for the dictionary bloom filter
+    TuneFileSeqWrite _tuneFileWrite;
+    std::unique_ptr<vespalib::FileHeader> _bloomFilterHeader;
 
     void flush();
+    bool writeBloomFilter();
 
 public:
     FieldWriter(uint32_t docIdLimit, uint64_t numWordIds);
@@ -74,7 +80,8 @@ public:
     bool open(const vespalib::string &prefix, uint32_t minSkipDocs, uint32_t minChunkDocs,
               bool dynamicKPosOccFormat, const Schema &schema, uint32_t indexId,
               const TuneFileSeqWrite &tuneFileWrite,
-              const search::common::FileHeaderContext &fileHeaderContext);
+              const search::common::FileHeaderContext &fileHeaderContext,
+              bool blockMaxWeights = false);
 
     bool close();
 
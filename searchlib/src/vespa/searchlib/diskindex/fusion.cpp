@@ -9,6 +9,9 @@
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/searchlib/common/documentsummary.h>
 #include <vespa/vespalib/util/error.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <atomic>
 #include <sstream>
 
 #include <vespa/log/log.h>
@@ -31,6 +34,20 @@ namespace search {
 
 namespace diskindex {
 
+namespace {
+
+/*
+ * Each field gets its own word number mapping file, since fields
+ * might be merged in parallel.
+ */
+vespalib::string
+getWordMapName(const vespalib::string &tmpPath, const vespalib::string &indexName)
+{
+    return tmpPath + "/old2new." + indexName + ".dat";
+}
+
+}
+
 void
 FusionInputIndex::setSchema(const Schema::SP &schema)
 {
@@ -43,8 +60,9 @@ Fusion::Fusion(bool dynamicKPosIndexFormat,
     : _schema(NULL),
       _oldIndexes(),
       _docIdLimit(0u),
-      _numWordIds(0u),
+      _numThreads(1u),
       _dynamicKPosIndexFormat(dynamicKPosIndexFormat),
+      _blockMaxWeights(false),
       _outDir("merged"),
       _tuneFileIndexing(tuneFileIndexing),
       _fileHeaderContext(fileHeaderContext)
@@ -53,7 +71,6 @@ Fusion::Fusion(bool dynamicKPosIndexFormat,
 
 Fusion::~Fusion()
 {
-    ReleaseMappingTables();
 }
 
 
@@ -105,7 +122,7 @@ Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
         auto reader(std::make_unique<DictionaryWordReader>());
         const vespalib::string &tmpindexpath = oi.getTmpPath();
         const vespalib::string &oldindexpath = oi.getPath();
-        vespalib::string wordMapName = tmpindexpath + "/old2new.dat";
+        vespalib::string wordMapName = getWordMapName(tmpindexpath, index.getName());
         vespalib::string fieldDir(oldindexpath + "/" + index.getName());
         vespalib::string dictName(fieldDir + "/dictionary");
         const Schema &oldSchema = oi.getSchema();
@@ -131,7 +148,9 @@ Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
 
 
 bool
-Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
+Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index,
+                             WordNumMappingList &wordNumMappings,
+                             uint64_t &numWordIds)
 {
     vespalib::string indexName = index.getName();
     LOG(debug, "Renumber word IDs for field %s", indexName.c_str());
@@ -146,7 +165,7 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
     heap.merge(out, 4);
     assert(heap.empty());
-    _numWordIds = out.getWordNum();
+    numWordIds = out.getWordNum();
 
     // Close files
     for (auto &i : readers) {
@@ -155,7 +174,7 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
     // Now read mapping files back into an array
     // XXX: avoid this, and instead make the array here
-    if (!ReadMappingFiles(&index))
+    if (!ReadMappingFiles(index, wordNumMappings))
         return false;
 
     LOG(debug, "Finished renumbering words IDs for field %s",
@@ -171,11 +190,29 @@ Fusion::mergeFields()
    typedef SchemaUtil::IndexIterator IndexIterator;
 
     const Schema &schema = getSchema();
-    for (IndexIterator index(schema); index.isValid(); ++index) {
-        if (!mergeField(index.getIndex()))
+    makeTmpDirs();
+    if (_numThreads <= 1) {
+        for (IndexIterator index(schema); index.isValid(); ++index) {
+            if (!mergeField(index.getIndex()))
+                return false;
+        }
+    } else {
+        // Fields are independent, each has its own input and output files
+        std::atomic<bool> failed(false);
+        vespalib::ThreadStackExecutor executor(_numThreads, 128 * 1024);
+        for (IndexIterator index(schema); index.isValid(); ++index) {
+            uint32_t id = index.getIndex();
+            executor.execute(vespalib::makeLambdaTask([this, id, &failed]()
+                                                      { if (!mergeField(id)) {
+                                                              failed = true;
+                                                          } }));
+        }
+        executor.sync();
+        executor.shutdown();
+        if (failed)
             return false;
     }
-    return true;
+    return CleanTmpDirs();
 }
 
 
@@ -201,16 +238,16 @@ Fusion::mergeField(uint32_t id)
     LOG(debug, "mergeField for field %s dir %s",
         indexName.c_str(), indexDir.c_str());
 
-    makeTmpDirs();
-
-    if (!renumberFieldWordIds(index)) {
+    WordNumMappingList wordNumMappings(_oldIndexes.size());
+    uint64_t numWordIds = 0;
+    if (!renumberFieldWordIds(index, wordNumMappings, numWordIds)) {
         LOG(error, "Could not renumber field word ids for field %s dir %s",
             indexName.c_str(), indexDir.c_str());
         return false;
     }
 
     // Tokamak
-    bool res = mergeFieldPostings(index);
+    bool res = mergeFieldPostings(index, wordNumMappings, numWordIds);
     if (!res) {
         LOG(error, "Could not merge field postings for field %s dir %s",
             indexName.c_str(), indexDir.c_str());
@@ -219,9 +256,6 @@ Fusion::mergeField(uint32_t id)
     if (!FileKit::createStamp(indexDir +  "/.mergeocc_done"))
         return false;
 
-    if (!CleanTmpDirs())
-        return false;
-
     LOG(debug, "Finished mergeField for field %s dir %s",
         indexName.c_str(), indexDir.c_str());
 
@@ -285,18 +319,21 @@ Fusion::selectCookedOrRawFeatures(Reader &reader, Writer &writer)
 
 bool
 Fusion::openInputFieldReaders(const SchemaUtil::IndexIterator &index,
+                              const WordNumMappingList &wordNumMappings,
                               std::vector<std::unique_ptr<FieldReader> > &
                               readers)
 {
     vespalib::string indexName = index.getName();
+    uint32_t oldIndexNum = 0;
     for (auto &i : _oldIndexes) {
         OldIndex &oi = *i;
+        const WordNumMapping &wordNumMapping = wordNumMappings[oldIndexNum++];
         const Schema &oldSchema = oi.getSchema();
         if (!index.hasOldFields(oldSchema, false)) {
             continue; // drop data
         }
         auto reader = FieldReader::allocFieldReader(index, oldSchema);
-        reader->setup(oi.getWordNumMapping(),
+        reader->setup(wordNumMapping,
                       oi.getDocIdMapping());
         if (!reader->open(oi.getPath() + "/" +
                           indexName + "/",
@@ -321,7 +358,8 @@ Fusion::openFieldWriter(const SchemaUtil::IndexIterator &index,
                      index.getSchema(),
                      index.getIndex(),
                      _tuneFileIndexing._write,
-                     _fileHeaderContext)) {
+                     _fileHeaderContext,
+                     _blockMaxWeights)) {
         LOG(error, "Could not open output posocc + dictionary in %s",
             dir.c_str());
         LOG_ABORT("should not be reached");
@@ -350,15 +388,17 @@ Fusion::setupMergeHeap(const std::vector<std::unique_ptr<FieldReader> > &
 
 
 bool
-Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index)
+Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index,
+                           const WordNumMappingList &wordNumMappings,
+                           uint64_t numWordIds)
 {
     std::vector<std::unique_ptr<FieldReader>> readers;
     PostingPriorityQueue<FieldReader> heap;
     /* OUTPUT */
-    FieldWriter fieldWriter(_docIdLimit, _numWordIds);
+    FieldWriter fieldWriter(_docIdLimit, numWordIds);
     vespalib::string indexName = index.getName();
 
-    if (!openInputFieldReaders(index, readers))
+    if (!openInputFieldReaders(index, wordNumMappings, readers))
         return false;
     if (!openFieldWriter(index, fieldWriter))
         return false;
@@ -382,15 +422,15 @@ Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index)
 
 
 bool
-Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
+Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator &index,
+                         WordNumMappingList &wordNumMappings)
 {
-    ReleaseMappingTables();
-
     size_t numberOfOldIndexes = _oldIndexes.size();
+    assert(wordNumMappings.size() == numberOfOldIndexes);
     for (uint32_t i = 0; i < numberOfOldIndexes; i++)
     {
         OldIndex &oi = *_oldIndexes[i];
-        WordNumMapping &wordNumMapping = oi.getWordNumMapping();
+        WordNumMapping &wordNumMapping = wordNumMappings[i];
         std::vector<uint32_t> oldIndexes;
         const Schema &oldSchema = oi.getSchema();
         if (!SchemaUtil::getIndexIds(oldSchema,
@@ -401,12 +441,12 @@ Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
             wordNumMapping.noMappingFile();
             continue;
         }
-        if (index && !index->hasOldFields(oldSchema, false)) {
+        if (!index.hasOldFields(oldSchema, false)) {
             continue; // drop data
         }
 
         // Open word mapping file
-        vespalib::string old2newname = oi.getTmpPath() + "/old2new.dat";
+        vespalib::string old2newname = getWordMapName(oi.getTmpPath(), index.getName());
         wordNumMapping.readMappingFile(old2newname, _tuneFileIndexing._read);
     }
 
@@ -414,19 +454,6 @@ Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
 }
 
 
-bool
-Fusion::ReleaseMappingTables()
-{
-    size_t numberOfOldIndexes = _oldIndexes.size();
-    for (uint32_t i = 0; i < numberOfOldIndexes; i++)
-    {
-        OldIndex &oi = *_oldIndexes[i];
-        oi.getWordNumMapping().clear();
-    }
-    return true;
-}
-
-
 void
 Fusion::makeTmpDirs()
 {
@@ -514,7 +541,9 @@ Fusion::merge(const Schema &schema,
               const SelectorArray &selector,
               bool dynamicKPosOccFormat,
               const TuneFileIndexing &tuneFileIndexing,
-              const FileHeaderContext &fileHeaderContext)
+              const FileHeaderContext &fileHeaderContext,
+              uint32_t numThreads,
+              bool blockMaxWeights)
 {
     assert(sources.size() <= 255);
     uint32_t docIdLimit = selector.size();
@@ -557,6 +586,8 @@ Fusion::merge(const Schema &schema,
                                          fileHeaderContext));
     fusion->setSchema(&schema);
     fusion->setOutDir(dir);
+    fusion->setNumThreads(numThreads);
+    fusion->setBlockMaxWeights(blockMaxWeights);
     fusion->SetOldIndexList(sources);
     if (!fusion->readSchemaFiles()) {
         LOG(error, "Cannot read schema files for source indexes");
@@ -8,6 +8,7 @@
 #include <vespa/searchlib/index/schemautil.h>
 #include <vector>
 #include <string>
+#include <algorithm>
 
 namespace search
 {
@@ -37,7 +38,6 @@ public:
     typedef diskindex::DocIdMapping DocIdMapping;
 private:
     vespalib::string _path;
-    WordNumMapping _wordNumMapping;
     DocIdMapping _docIdMapping;
     vespalib::string _tmpPath;
     index::Schema::SP _schema;
@@ -45,7 +45,6 @@ private:
 public:
     FusionInputIndex()
         : _path(),
-          _wordNumMapping(),
           _docIdMapping(),
           _tmpPath(),
           _schema()
@@ -81,18 +80,6 @@ public:
         return _tmpPath;
     }
 
-    const WordNumMapping &
-    getWordNumMapping() const
-    {
-        return _wordNumMapping;
-    }
-
-    WordNumMapping &
-    getWordNumMapping()
-    {
-        return _wordNumMapping;
-    }
-
     const DocIdMapping &
     getDocIdMapping() const
     {
@@ -122,6 +109,8 @@ class Fusion
 public:
     typedef search::index::Schema Schema;
     typedef search::index::SchemaUtil SchemaUtil;
+    // One word number mapping per old index, for the field being merged
+    typedef std::vector<WordNumMapping> WordNumMappingList;
 
 private:
     Fusion(const Fusion &);
@@ -137,9 +126,14 @@ public:
 
     void SetOldIndexList(const std::vector<vespalib::string> &oldIndexList);
 
+    /**
+     * Merge all fields. Fields are merged in parallel when more than
+     * one thread has been requested by setNumThreads().
+     */
     bool mergeFields();
     bool mergeField(uint32_t id);
     bool openInputFieldReaders(const SchemaUtil::IndexIterator &index,
+                               const WordNumMappingList &wordNumMappings,
                                std::vector<std::unique_ptr<FieldReader> > &
                                readers);
     bool openFieldWriter(const SchemaUtil::IndexIterator &index,
@@ -148,13 +142,17 @@ public:
                         readers,
                         FieldWriter &writer,
                         PostingPriorityQueue<FieldReader> &heap);
-    bool mergeFieldPostings(const SchemaUtil::IndexIterator &index);
+    bool mergeFieldPostings(const SchemaUtil::IndexIterator &index,
+                            const WordNumMappingList &wordNumMappings,
+                            uint64_t numWordIds);
     bool openInputWordReaders(const SchemaUtil::IndexIterator &index,
                               std::vector<
                                  std::unique_ptr<DictionaryWordReader> > &
                               readers,
                               PostingPriorityQueue<DictionaryWordReader> &heap);
-    bool renumberFieldWordIds(const SchemaUtil::IndexIterator &index);
+    bool renumberFieldWordIds(const SchemaUtil::IndexIterator &index,
+                              WordNumMappingList &wordNumMappings,
+                              uint64_t &numWordIds);
 
     void
     setSchema(const Schema *schema);
@@ -177,8 +175,8 @@ public:
     selectCookedOrRawFeatures(Reader &reader, Writer &writer);
 
 protected:
-    bool ReadMappingFiles(const SchemaUtil::IndexIterator *index);
-    bool ReleaseMappingTables();
+    bool ReadMappingFiles(const SchemaUtil::IndexIterator &index,
+                          WordNumMappingList &wordNumMappings);
 
     static unsigned int noGen()
     {
@@ -197,10 +195,13 @@ protected:
     // OUTPUT:
 
     uint32_t _docIdLimit;
-    uint64_t _numWordIds;
+
+    // Number of fields merged in parallel
+    uint32_t _numThreads;
 
     // Index format parameters.
     bool _dynamicKPosIndexFormat;
+    bool _blockMaxWeights;
 
     // Index location parameters
 
@@ -227,9 +228,15 @@ public:
     }
 
     void
-    setNumWordIds(uint64_t numWordIds)
+    setNumThreads(uint32_t numThreads)
+    {
+        _numThreads = std::max(1u, numThreads);
+    }
+
+    void
+    setBlockMaxWeights(bool blockMaxWeights)
     {
-        _numWordIds = numWordIds;
+        _blockMaxWeights = blockMaxWeights;
     }
 
     std::vector<std::shared_ptr<OldIndex> > &
@@ -246,6 +253,8 @@ public:
 
     /**
      * This method is used by new indexing pipeline to merge indexes.
+     * Up to numThreads fields are merged at the same time. Block max
+     * weights are stored in the merged posting lists if requested.
      */
     static bool
     merge(const Schema &schema,
@@ -254,7 +263,9 @@ public:
           const SelectorArray &docIdSelector,
           bool dynamicKPosOccFormat,
           const TuneFileIndexing &tuneFileIndexing,
-          const search::common::FileHeaderContext &fileHeaderContext);
+          const search::common::FileHeaderContext &fileHeaderContext,
+          uint32_t numThreads = 1,
+          bool blockMaxWeights = false);
 };
 
 } // namespace diskindex
@@ -50,7 +50,8 @@ public:
          const SchemaUtil::IndexIterator &index,
          uint32_t docIdLimit, uint64_t numWordIds,
          const TuneFileSeqWrite &tuneFileWrite,
-         const FileHeaderContext &fileHeaderContext);
+         const FileHeaderContext &fileHeaderContext,
+         bool blockMaxWeights);
 
     void
     close();
@@ -162,6 +163,7 @@ public:
     uint32_t _docRef;
     uint32_t _elRef;
     bool _valid;
+    bool _written;  // Files have been written and closed
     const Schema *_schema;  // Ptr to allow being std::vector member
     uint32_t _fieldId;
     IndexBuilder *_ib;  // Ptr to allow being std::vector member
@@ -223,6 +225,18 @@ public:
     void
     close();
 
+    bool
+    isOpen() const
+    {
+        return _files._fieldWriter != NULL;
+    }
+
+    bool
+    isWritten() const
+    {
+        return _written;
+    }
+
     uint32_t
     getIndexId() const
     {
@@ -286,7 +300,8 @@ FileHandle::open(const vespalib::stringref &dir,
                  const SchemaUtil::IndexIterator &index,
                  uint32_t docIdLimit, uint64_t numWordIds,
                  const TuneFileSeqWrite &tuneFileWrite,
-                 const FileHeaderContext &fileHeaderContext)
+                 const FileHeaderContext &fileHeaderContext,
+                 bool blockMaxWeights)
 {
     assert(_fieldWriter == NULL);
 
@@ -294,7 +309,7 @@ FileHandle::open(const vespalib::stringref &dir,
 
     if (!_fieldWriter->open(dir + "/", 64, 262144u, false,
                             index.getSchema(), index.getIndex(),
-                            tuneFileWrite, fileHeaderContext)) {
+                            tuneFileWrite, fileHeaderContext, blockMaxWeights)) {
         LOG(error, "Could not open term writer %s for write (%s)",
             dir.c_str(), getLastErrorString().c_str());
         LOG_ABORT("should not be reached");
@@ -330,6 +345,7 @@ IndexBuilder::FieldHandle::FieldHandle(const Schema &schema,
       _docRef(noDocRef()),
       _elRef(noElRef()),
       _valid(false),
+      _written(false),
       _schema(&schema),
       _fieldId(fieldId),
       _ib(ib),
@@ -475,7 +491,8 @@ IndexBuilder::FieldHandle::open(uint32_t docIdLimit, uint64_t numWordIds,
 {
     _files.open(getDir(),
                 SchemaUtil::IndexIterator(*_schema, getIndexId()),
-                docIdLimit, numWordIds, tuneFileWrite, fileHeaderContext);
+                docIdLimit, numWordIds, tuneFileWrite, fileHeaderContext,
+                _ib->_blockMaxWeights);
 }
 
 
@@ -483,6 +500,7 @@ void
 IndexBuilder::FieldHandle::close()
 {
     _files.close();
+    _written = true;
 }
 
 
@@ -533,6 +551,9 @@ IndexBuilder::IndexBuilder(const Schema &schema)
       _prefix(),
       _docIdLimit(0u),
       _numWordIds(0u),
+      _tuneFileWrite(),
+      _fileHeaderContext(NULL),
+      _blockMaxWeights(false),
       _schema(schema)
 {
     // TODO: Filter for text indexes
@@ -608,6 +629,11 @@ IndexBuilder::startField(uint32_t fieldId)
     assert(fieldId >= _lowestOKFieldId);
     _currentField = &_fields[fieldId];
     assert(_currentField != NULL);
+    if (_currentField->getValid()) {
+        assert(_fileHeaderContext != NULL);
+        _currentField->open(_docIdLimit, _numWordIds, _tuneFileWrite,
+                            *_fileHeaderContext);
+    }
 }
 
 
@@ -617,6 +643,9 @@ IndexBuilder::endField()
     assert(_curDocId == noDocId());
     assert(!_inWord);
     assert(_currentField != NULL);
+    if (_currentField->isOpen()) {
+        _currentField->close();
+    }
     _lowestOKFieldId = _currentField->_fieldId + 1;
     _currentField = NULL;
 }
@@ -673,6 +702,8 @@ IndexBuilder::open(uint32_t docIdLimit, uint64_t numWordIds,
 
     _docIdLimit = docIdLimit;
     _numWordIds = numWordIds;
+    _tuneFileWrite = tuneFileIndexing._write;
+    _fileHeaderContext = &fileHeaderContext;
     if (!_prefix.empty()) {
         vespalib::mkdir(_prefix, false);
     }
@@ -681,8 +712,6 @@ IndexBuilder::open(uint32_t docIdLimit, uint64_t numWordIds,
         if (!fh.getValid())
             continue;
         vespalib::mkdir(fh.getDir(), false);
-        fh.open(docIdLimit, numWordIds, tuneFileIndexing._write,
-                 fileHeaderContext);
         indexes.push_back(fh.getIndexId());
     }
     vespalib::string schemaFile = appendToPrefix("schema.txt");
@@ -696,9 +725,13 @@ IndexBuilder::open(uint32_t docIdLimit, uint64_t numWordIds,
 void
 IndexBuilder::close()
 {
+    assert(_currentField == NULL);
     // TODO: Filter for text indexes
     for (FieldHandle & fh : _fields) {
-        if (fh.getValid()) {
+        if (fh.getValid() && !fh.isWritten()) {
+            // Field was never started, write empty files for it
+            fh.open(_docIdLimit, _numWordIds, _tuneFileWrite,
+                    *_fileHeaderContext);
             fh.close();
         }
     }
@@ -33,6 +33,9 @@ private:
     vespalib::string         _prefix;
     uint32_t                 _docIdLimit;
     uint64_t                 _numWordIds;
+    TuneFileSeqWrite         _tuneFileWrite;
+    const search::common::FileHeaderContext *_fileHeaderContext;
+    bool                     _blockMaxWeights;
 
     const Schema &_schema;  // Ptr to allow being std::vector member
 
@@ -67,8 +70,21 @@ public:
     inline FieldHandle & getIndexFieldHandle(uint32_t fieldId); 
     void setPrefix(const vespalib::stringref &prefix);
 
+    /**
+     * Store block max weights in the posting lists written, for use
+     * by block-max WAND. Must be set before open().
+     */
+    void setBlockMaxWeights(bool blockMaxWeights) { _blockMaxWeights = blockMaxWeights; }
+
     vespalib::string appendToPrefix(const vespalib::stringref &name);
 
+    /**
+     * Prepare for writing the index. The files for a field are not
+     * opened until startField() and are closed by endField(), so only
+     * one field at a time holds write buffers. Fields that are never
+     * started get empty files at close(). The file header context
+     * must live until close().
+     */
     void
     open(uint32_t docIdLimit, uint64_t numWordIds,
          const TuneFileIndexing &tuneFileIndexing,
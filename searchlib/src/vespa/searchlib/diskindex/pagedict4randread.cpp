@@ -3,7 +3,9 @@
 #include "pagedict4randread.h"
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/fastos/file.h>
+#include <cstring>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.pagedict4randread");
@@ -14,6 +16,13 @@ vespalib::string myPId("PageDict4P.1");
 vespalib::string mySPId("PageDict4SP.1");
 vespalib::string mySSId("PageDict4SS.1");
 
+bool
+hasPrefix(const vespalib::stringref &word, const vespalib::stringref &prefix)
+{
+    return word.size() >= prefix.size() &&
+        memcmp(word.data(), prefix.data(), prefix.size()) == 0;
+}
+
 }
 
 using vespalib::getLastErrorString;
@@ -23,7 +32,7 @@ namespace search {
 namespace diskindex {
 
 
-PageDict4RandRead::PageDict4RandRead()
+PageDict4RandRead::PageDict4RandRead(size_t pageCacheMaxBytes)
     : DictionaryFileRandRead(),
       _ssReader(),
       _ssd(),
@@ -36,7 +45,14 @@ PageDict4RandRead::PageDict4RandRead()
       _pFileBitSize(0u),
       _ssHeaderLen(0u),
       _spHeaderLen(0u),
-      _pHeaderLen(0u)
+      _pHeaderLen(0u),
+      _pageCacheMaxBytes(pageCacheMaxBytes),
+      _pageCacheLock(),
+      _pageLru(),
+      _pageMap(),
+      _pageCacheBytes(0u),
+      _pageCacheHits(0u),
+      _pageCacheMisses(0u)
 {
     _ssd.setReadContext(&_ssReadContext);
 }
@@ -145,6 +161,73 @@ PageDict4RandRead::readPHeader()
 }
 
 
+void
+PageDict4RandRead::lookupSparsePage(const vespalib::stringref &word, const SSLookupRes &ssRes, SPLookupRes &spRes) const
+{
+    size_t pageSize = PageDict4PageParams::getPageByteSize();
+    const char *spData = static_cast<const char *>(_spfile->MemoryMapPtr(0));
+    spRes.lookup(*_ssReader,
+                 spData + pageSize * ssRes._sparsePageNum,
+                 word,
+                 ssRes._l6Word,
+                 ssRes._lastWord,
+                 ssRes._l6StartOffset,
+                 ssRes._l6WordNum,
+                 ssRes._pageNum);
+}
+
+
+std::shared_ptr<const PageDict4RandRead::DecodedPage>
+PageDict4RandRead::getDecodedPage(const SPLookupRes &spRes)
+{
+    if (_pageCacheMaxBytes > 0) {
+        std::lock_guard<std::mutex> guard(_pageCacheLock);
+        auto itr = _pageMap.find(spRes._pageNum);
+        if (itr != _pageMap.end()) {
+            ++_pageCacheHits;
+            _pageLru.splice(_pageLru.begin(), _pageLru, itr->second);
+            return itr->second->page;
+        }
+        ++_pageCacheMisses;
+    }
+    // Decode outside lock, racing threads decoding the same page is harmless.
+    auto page = std::make_shared<DecodedPage>();
+    size_t pageSize = PageDict4PageParams::getPageByteSize();
+    const char *pData = static_cast<const char *>(_pfile->MemoryMapPtr(0));
+    page->decode(*_ssReader,
+                 pData + pageSize * spRes._pageNum,
+                 spRes._l3Word,
+                 spRes._lastWord,
+                 spRes._l3StartOffset,
+                 spRes._l3WordNum);
+    if (_pageCacheMaxBytes > 0) {
+        size_t size = page->getMemoryUsage() + sizeof(CachedPage) + 4 * sizeof(void *);
+        std::lock_guard<std::mutex> guard(_pageCacheLock);
+        if (size <= _pageCacheMaxBytes && _pageMap.find(spRes._pageNum) == _pageMap.end()) {
+            while (!_pageLru.empty() && _pageCacheBytes + size > _pageCacheMaxBytes) {
+                _pageCacheBytes -= _pageLru.back().size;
+                _pageMap.erase(_pageLru.back().pageNum);
+                _pageLru.pop_back();
+            }
+            _pageLru.push_front(CachedPage{spRes._pageNum, page, size});
+            _pageMap[spRes._pageNum] = _pageLru.begin();
+            _pageCacheBytes += size;
+        }
+    }
+    return page;
+}
+
+
+void
+PageDict4RandRead::clearPageCache()
+{
+    std::lock_guard<std::mutex> guard(_pageCacheLock);
+    _pageMap.clear();
+    _pageLru.clear();
+    _pageCacheBytes = 0;
+}
+
+
 bool
 PageDict4RandRead::lookup(const vespalib::stringref &word,
                           uint64_t &wordNum,
@@ -165,39 +248,97 @@ PageDict4RandRead::lookup(const vespalib::stringref &word,
         wordNum = ssRes._l6WordNum;
         offsetAndCounts._counts = ssRes._counts;
         return true;
-    } else {
-        SPLookupRes spRes;
-        size_t pageSize = PageDict4PageParams::getPageByteSize();
-        const char *spData = static_cast<const char *>(_spfile->MemoryMapPtr(0));
-        spRes.lookup(*_ssReader,
-                     spData + pageSize * ssRes._sparsePageNum,
-                     word,
-                     ssRes._l6Word,
-                     ssRes._lastWord,
-                     ssRes._l6StartOffset,
-                     ssRes._l6WordNum,
-                     ssRes._pageNum);
-
-        PLookupRes pRes;
-        const char *pData = static_cast<const char *>
-                             (_pfile->MemoryMapPtr(0));
-        pRes.lookup(*_ssReader,
-                    pData + pageSize * spRes._pageNum,
-                    word,
-                    spRes._l3Word,
-                    spRes._lastWord,
-                    spRes._l3StartOffset,
-                    spRes._l3WordNum);
-        offsetAndCounts._offset = pRes._startOffset._fileOffset;
-        offsetAndCounts._accNumDocs = pRes._startOffset._accNumDocs;
-        wordNum = pRes._wordNum;
-        if (!pRes._res) {
+    }
+    SPLookupRes spRes;
+    lookupSparsePage(word, ssRes, spRes);
+    if (_pageCacheMaxBytes > 0) {
+        std::shared_ptr<const DecodedPage> page = getDecodedPage(spRes);
+        uint32_t idx = page->lowerBound(word);
+        const PageDict4PageParams::StartOffset &startOffset = page->getStartOffset(idx);
+        offsetAndCounts._offset = startOffset._fileOffset;
+        offsetAndCounts._accNumDocs = startOffset._accNumDocs;
+        wordNum = page->getWordNum(idx);
+        if (idx >= page->size() || page->getWord(idx) != word) {
             offsetAndCounts._counts.clear();
             return false;
         }
-        offsetAndCounts._counts = pRes._counts;
+        offsetAndCounts._counts = page->getCounts(idx);
         return true;
     }
+
+    PLookupRes pRes;
+    size_t pageSize = PageDict4PageParams::getPageByteSize();
+    const char *pData = static_cast<const char *>
+                         (_pfile->MemoryMapPtr(0));
+    pRes.lookup(*_ssReader,
+                pData + pageSize * spRes._pageNum,
+                word,
+                spRes._l3Word,
+                spRes._lastWord,
+                spRes._l3StartOffset,
+                spRes._l3WordNum);
+    offsetAndCounts._offset = pRes._startOffset._fileOffset;
+    offsetAndCounts._accNumDocs = pRes._startOffset._accNumDocs;
+    wordNum = pRes._wordNum;
+    if (!pRes._res) {
+        offsetAndCounts._counts.clear();
+        return false;
+    }
+    offsetAndCounts._counts = pRes._counts;
+    return true;
+}
+
+
+void
+PageDict4RandRead::visitPrefix(const vespalib::stringref &prefix, PrefixVisitor &visitor)
+{
+    PostingListOffsetAndCounts offsetAndCounts;
+    vespalib::string key = prefix;
+    for (;;) {
+        // Locate the first word not less than key
+        SSLookupRes ssRes(_ssReader->lookup(key));
+        if (!ssRes._res) {
+            return; // Beyond end of dictionary
+        }
+        if (ssRes._overflow) {
+            offsetAndCounts._offset = ssRes._startOffset._fileOffset;
+            offsetAndCounts._accNumDocs = ssRes._startOffset._accNumDocs;
+            offsetAndCounts._counts = ssRes._counts;
+            visitor.visit(key, ssRes._l6WordNum, offsetAndCounts);
+        } else {
+            SPLookupRes spRes;
+            lookupSparsePage(key, ssRes, spRes);
+            std::shared_ptr<const DecodedPage> page = getDecodedPage(spRes);
+            if (page->size() == 0) {
+                // Overflow page, next word is the overflow word
+                uint64_t wordNum = page->getWordNum(0);
+                SSLookupRes overflowRes(_ssReader->lookupOverflow(wordNum));
+                if (!hasPrefix(overflowRes._lastWord, prefix)) {
+                    return;
+                }
+                offsetAndCounts._offset = overflowRes._startOffset._fileOffset;
+                offsetAndCounts._accNumDocs = overflowRes._startOffset._accNumDocs;
+                offsetAndCounts._counts = overflowRes._counts;
+                visitor.visit(overflowRes._lastWord, wordNum, offsetAndCounts);
+                key = overflowRes._lastWord;
+            } else {
+                for (uint32_t idx = page->lowerBound(key); idx < page->size(); ++idx) {
+                    vespalib::stringref word = page->getWord(idx);
+                    if (!hasPrefix(word, prefix)) {
+                        return;
+                    }
+                    const PageDict4PageParams::StartOffset &startOffset = page->getStartOffset(idx);
+                    offsetAndCounts._offset = startOffset._fileOffset;
+                    offsetAndCounts._accNumDocs = startOffset._accNumDocs;
+                    offsetAndCounts._counts = page->getCounts(idx);
+                    visitor.visit(word, page->getWordNum(idx), offsetAndCounts);
+                }
+                key = page->getWord(page->size() - 1);
+            }
+        }
+        // Words never contain '\0', so this is the smallest possible successor
+        key.push_back('\1');
+    }
 }
 
 
@@ -256,6 +397,7 @@ PageDict4RandRead::open(const vespalib::string &name,
 bool
 PageDict4RandRead::close()
 {
+    clearPageCache();
     _ssReader.reset();
 
     _ssReadContext.dropComprBuf();
@@ -274,6 +416,14 @@ PageDict4RandRead::getNumWordIds() const
 }
 
 
+CacheStats
+PageDict4RandRead::getPageCacheStats() const
+{
+    std::lock_guard<std::mutex> guard(_pageCacheLock);
+    return CacheStats(_pageCacheHits, _pageCacheMisses, _pageMap.size(), _pageCacheBytes);
+}
+
+
 } // namespace diskindex
 
 } // namespace search
@@ -6,11 +6,22 @@
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/bitcompression/countcompression.h>
 #include <vespa/searchlib/bitcompression/pagedict4.h>
+#include <vespa/searchlib/docstore/cachestats.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <list>
+#include <mutex>
 
 namespace search {
 
 namespace diskindex {
 
+/**
+ * Random access reader for a page based dictionary.
+ *
+ * Pages in the P file can be kept decoded in an LRU cache with a byte
+ * budget. A lookup in a cached page is a binary search, and prefix
+ * visiting walks decoded pages instead of doing a lookup per word.
+ */
 class PageDict4RandRead : public index::DictionaryFileRandRead
 {
     typedef bitcompression::PostingListCountFileDecodeContext DC;
@@ -20,6 +31,7 @@ class PageDict4RandRead : public index::DictionaryFileRandRead
     typedef bitcompression::PageDict4SPLookupRes SPLookupRes;
     typedef bitcompression::PageDict4PLookupRes PLookupRes;
     typedef bitcompression::PageDict4PageParams PageDict4PageParams;
+    typedef bitcompression::PageDict4DecodedPage DecodedPage;
 
     typedef index::PostingListCounts PostingListCounts;
     typedef index::PostingListOffsetAndCounts PostingListOffsetAndCounts;
@@ -39,20 +51,44 @@ class PageDict4RandRead : public index::DictionaryFileRandRead
     uint32_t _spHeaderLen;
     uint32_t _pHeaderLen;
 
+    struct CachedPage {
+        uint64_t pageNum;
+        std::shared_ptr<const DecodedPage> page;
+        size_t size;
+    };
+    using PageLru = std::list<CachedPage>;
+
+    const size_t _pageCacheMaxBytes;
+    mutable std::mutex _pageCacheLock;
+    PageLru _pageLru;   // Most recently used first
+    vespalib::hash_map<uint64_t, PageLru::iterator> _pageMap;
+    size_t _pageCacheBytes;
+    size_t _pageCacheHits;
+    size_t _pageCacheMisses;
+
     void readSSHeader();
     void readSPHeader();
     void readPHeader();
+    void lookupSparsePage(const vespalib::stringref &word, const SSLookupRes &ssRes, SPLookupRes &spRes) const;
+    std::shared_ptr<const DecodedPage> getDecodedPage(const SPLookupRes &spRes);
+    void clearPageCache();
 public:
-    PageDict4RandRead();
+    /**
+     * @param pageCacheMaxBytes byte budget for decoded pages, 0 disables the cache.
+     */
+    PageDict4RandRead(size_t pageCacheMaxBytes = 0);
     ~PageDict4RandRead();
 
     bool lookup(const vespalib::stringref &word, uint64_t &wordNum,
                 PostingListOffsetAndCounts &offsetAndCounts) override;
 
+    void visitPrefix(const vespalib::stringref &prefix, PrefixVisitor &visitor) override;
+
     bool open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead) override;
 
     bool close() override;
     uint64_t getNumWordIds() const override;
+    CacheStats getPageCacheStats() const;
 };
 
 } // namespace diskindex
@@ -0,0 +1,190 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "posting_list_cache.h"
+#include <vespa/searchlib/index/postinglisthandle.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <atomic>
+#include <cstdlib>
+
+namespace search::diskindex {
+
+namespace {
+
+std::atomic<uint64_t> nextFileId(1);
+
+const uint64_t sketchSeeds[] = {
+    0xc3a5c85c97cb3127ul, 0xb492b66fbe98f273ul, 0x9ae16a3b2f90404ful, 0xcbf29ce484222325ul
+};
+
+size_t
+calcSketchWidth(size_t maxBytes)
+{
+    // About one counter per expected entry, assuming 4KiB posting lists.
+    size_t width = 1024;
+    while (width < (maxBytes / 4096) && width < (size_t(1) << 22)) {
+        width <<= 1;
+    }
+    return width;
+}
+
+}
+
+PostingListCache::FrequencySketch::FrequencySketch(size_t width)
+    : _counters(width * DEPTH),
+      _widthMask(width - 1),
+      _additions(0),
+      _resetLimit(10 * width)
+{
+}
+
+size_t
+PostingListCache::FrequencySketch::index(uint64_t hash, uint32_t row) const
+{
+    uint64_t h = (hash + sketchSeeds[row]) * sketchSeeds[row];
+    return row * (size_t(_widthMask) + 1) + ((h >> 32) & _widthMask);
+}
+
+void
+PostingListCache::FrequencySketch::increment(uint64_t hash)
+{
+    bool added = false;
+    for (uint32_t row = 0; row < DEPTH; ++row) {
+        uint8_t &counter = _counters[index(hash, row)];
+        if (counter < MAX_COUNT) {
+            ++counter;
+            added = true;
+        }
+    }
+    if (added && ++_additions >= _resetLimit) {
+        for (uint8_t &counter : _counters) {
+            counter >>= 1;
+        }
+        _additions /= 2;
+    }
+}
+
+uint32_t
+PostingListCache::FrequencySketch::estimate(uint64_t hash) const
+{
+    uint32_t result = MAX_COUNT;
+    for (uint32_t row = 0; row < DEPTH; ++row) {
+        result = std::min(result, uint32_t(_counters[index(hash, row)]));
+    }
+    return result;
+}
+
+PostingListCache::PostingListCache(size_t maxBytes)
+    : _maxBytes(maxBytes),
+      _lock(),
+      _lru(),
+      _map(),
+      _sketch(calcSketchWidth(maxBytes)),
+      _sizeBytes(0),
+      _hits(0),
+      _misses(0),
+      _rejected(0)
+{
+}
+
+PostingListCache::~PostingListCache() = default;
+
+uint64_t
+PostingListCache::newFileId()
+{
+    return nextFileId.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool
+PostingListCache::lookup(const Key &key, index::PostingListHandle &handle)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _sketch.increment(key.hash());
+    auto itr = _map.find(key);
+    if (itr == _map.end()) {
+        ++_misses;
+        return false;
+    }
+    ++_hits;
+    _lru.splice(_lru.begin(), _lru, itr->second);
+    const Entry &entry = *itr->second;
+    handle._firstSegment = entry.firstSegment;
+    handle._numSegments = entry.numSegments;
+    handle._bitOffsetMem = entry.bitOffsetMem;
+    handle._mem = entry.mem.get();
+    handle._sharedMem = entry.mem;
+    return true;
+}
+
+bool
+PostingListCache::admit(uint64_t hash, size_t size)
+{
+    if (size > _maxBytes / 8) {
+        return false;
+    }
+    uint32_t frequency = _sketch.estimate(hash);
+    size_t freed = 0;
+    for (auto itr = _lru.rbegin(); itr != _lru.rend() && _sizeBytes - freed + size > _maxBytes; ++itr) {
+        if (_sketch.estimate(itr->key.hash()) >= frequency) {
+            return false;
+        }
+        freed += itr->size;
+    }
+    return true;
+}
+
+void
+PostingListCache::evict(size_t size)
+{
+    while (!_lru.empty() && _sizeBytes + size > _maxBytes) {
+        Entry &victim = _lru.back();
+        _sizeBytes -= victim.size;
+        _map.erase(victim.key);
+        _lru.pop_back();
+    }
+}
+
+void
+PostingListCache::insert(const Key &key, index::PostingListHandle &handle)
+{
+    if (handle._allocMem == nullptr) {
+        return;
+    }
+    size_t size = entrySize(handle._allocSize);
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_map.find(key) != _map.end()) {
+        return; // Inserted by another thread
+    }
+    if (!admit(key.hash(), size)) {
+        ++_rejected;
+        return;
+    }
+    evict(size);
+    std::shared_ptr<void> mem(handle._allocMem, free);
+    handle._allocMem = nullptr;
+    handle._sharedMem = mem;
+    _lru.emplace_front(key);
+    Entry &entry = _lru.front();
+    entry.mem = std::move(mem);
+    entry.size = size;
+    entry.bitOffsetMem = handle._bitOffsetMem;
+    entry.firstSegment = handle._firstSegment;
+    entry.numSegments = handle._numSegments;
+    _map[key] = _lru.begin();
+    _sizeBytes += size;
+}
+
+CacheStats
+PostingListCache::getStats() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return CacheStats(_hits, _misses, _map.size(), _sizeBytes);
+}
+
+size_t
+PostingListCache::getRejected() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _rejected;
+}
+
+}
@@ -0,0 +1,125 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/docstore/cachestats.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace search::index { class PostingListHandle; }
+
+namespace search::diskindex {
+
+/**
+ * Cache of posting lists read from the posting list files of disk
+ * indexes. One instance is shared by all disk indexes of a document
+ * db. Cached posting lists live on the heap, so frequent terms are not
+ * evicted by summary fetches and index fusion filling the OS page cache.
+ *
+ * Entries are evicted in LRU order when the byte budget is exceeded.
+ * When room must be made, a new posting list is only admitted if it is
+ * estimated to be used more often than each of the entries it would
+ * evict (TinyLFU). Access frequencies are tracked by a count-min sketch
+ * that is halved periodically, so old popularity fades.
+ *
+ * Only posting lists read into memory are cached. Memory mapped posting
+ * files are already served from the page cache.
+ *
+ * Thread safe.
+ */
+class PostingListCache
+{
+public:
+    using SP = std::shared_ptr<PostingListCache>;
+
+    struct Key {
+        uint64_t fileId;
+        uint64_t bitOffset;
+
+        Key() : fileId(0), bitOffset(0) { }
+        Key(uint64_t fileId_in, uint64_t bitOffset_in) : fileId(fileId_in), bitOffset(bitOffset_in) { }
+        uint64_t hash() const { return (fileId * 0x9e3779b97f4a7c15ul) ^ bitOffset; }
+        bool operator==(const Key &rhs) const { return fileId == rhs.fileId && bitOffset == rhs.bitOffset; }
+    };
+
+private:
+    /**
+     * Count-min sketch with 4 bit counters, used to estimate how often a
+     * key has been looked up recently.
+     */
+    class FrequencySketch {
+        std::vector<uint8_t> _counters;   // DEPTH rows of _width counters
+        uint32_t             _widthMask;
+        uint64_t             _additions;
+        uint64_t             _resetLimit;
+
+        static constexpr uint32_t DEPTH = 4;
+        static constexpr uint8_t MAX_COUNT = 15;
+        size_t index(uint64_t hash, uint32_t row) const;
+    public:
+        FrequencySketch(size_t width);
+        void increment(uint64_t hash);
+        uint32_t estimate(uint64_t hash) const;
+    };
+
+    struct Entry {
+        Key                   key;
+        std::shared_ptr<void> mem;
+        size_t                size;
+        uint64_t              bitOffsetMem;
+        uint32_t              firstSegment;
+        uint32_t              numSegments;
+
+        Entry(const Key &key_in) : key(key_in), mem(), size(0), bitOffsetMem(0), firstSegment(0), numSegments(0) { }
+    };
+    using LruList = std::list<Entry>;
+    using Map = vespalib::hash_map<Key, LruList::iterator>;
+
+    const size_t       _maxBytes;
+    mutable std::mutex _lock;
+    LruList            _lru;   // Most recently used first
+    Map                _map;
+    FrequencySketch    _sketch;
+    size_t             _sizeBytes;
+    size_t             _hits;
+    size_t             _misses;
+    size_t             _rejected;
+
+    bool admit(uint64_t hash, size_t size);
+    void evict(size_t size);
+    static size_t entrySize(size_t allocSize) { return allocSize + sizeof(Entry) + sizeof(Key) + 4 * sizeof(void *); }
+
+public:
+    PostingListCache(size_t maxBytes);
+    ~PostingListCache();
+
+    /**
+     * Returns a new id to be used in keys for an opened posting list
+     * file. Ids are never reused, so entries for files that have been
+     * removed are never found again, and are evicted over time.
+     */
+    static uint64_t newFileId();
+
+    /**
+     * Sets the value portion of the handle to the cached posting list
+     * and returns true if the key is cached. Memory is shared with the
+     * cache. Counts the lookup for admission either way.
+     */
+    bool lookup(const Key &key, index::PostingListHandle &handle);
+
+    /**
+     * Offers a posting list that was just read to the cache. If it is
+     * admitted, the handle keeps using the same memory, now shared with
+     * the cache.
+     */
+    void insert(const Key &key, index::PostingListHandle &handle);
+
+    CacheStats getStats() const;
+    size_t getRejected() const;
+    size_t getMaxBytes() const { return _maxBytes; }
+};
+
+}
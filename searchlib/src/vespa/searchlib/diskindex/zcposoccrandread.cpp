@@ -44,7 +44,9 @@ ZcPosOccRandRead::ZcPosOccRandRead()
       _fileBitSize(0),
       _headerBitSize(0),
       _fieldsParams(),
-      _dynamicK(true)
+      _dynamicK(true),
+      _blockMaxWeights(false),
+      _directIO(false)
 { }
 
 
@@ -100,7 +102,9 @@ createIterator(const PostingListCounts &counts,
     if (numDocs < _minSkipDocs) {
         return new ZcRareWordPosOccIterator<true>(start, handle._bitLength, _docIdLimit, &_fieldsParams, matchData);
     } else {
-        return new ZcPosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, counts, &_fieldsParams, matchData);
+        auto iterator = new ZcPosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, counts, &_fieldsParams, matchData);
+        iterator->setBlockMaxWeights(_blockMaxWeights);
+        return iterator;
     }
 }
 
@@ -169,6 +173,23 @@ ZcPosOccRandRead::readPostingList(const PostingListCounts &counts,
 }
 
 
+void
+ZcPosOccRandRead::prefetchPostingList(const PostingListHandle &handle) const
+{
+    // Direct io reads would not use the prefetched pages
+    if (handle._bitLength == 0 || _directIO)
+        return;
+    uint64_t startOffset = (handle._bitOffset + _headerBitSize) >> 3;
+    uint64_t endOffset = (handle._bitOffset + _headerBitSize +
+                          handle._bitLength + 7) >> 3;
+    uint64_t len = endOffset - startOffset;
+    if (_file->IsMemoryMapped()) {
+        len = std::min(len, static_cast<uint64_t>(MAX_MAPPED_PREFETCH));
+    }
+    _file->prefetch(startOffset, len);
+}
+
+
 bool
 ZcPosOccRandRead::
 open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead)
@@ -184,6 +205,10 @@ open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead)
         return false;
     }
     _fileSize = _file->GetSize();
+    size_t memoryAlignment;
+    size_t transferGranularity;
+    size_t transferMaximum;
+    _directIO = _file->GetDirectIORestrictions(memoryAlignment, transferGranularity, transferMaximum);
 
     readHeader();
     return true;
@@ -231,6 +256,8 @@ ZcPosOccRandRead::readHeader()
     _minChunkDocs = header.getTag("minChunkDocs").asInteger();
     _docIdLimit = header.getTag("docIdLimit").asInteger();
     _minSkipDocs = header.getTag("minSkipDocs").asInteger();
+    _blockMaxWeights = header.hasTag("blockMaxWeights") &&
+                       header.getTag("blockMaxWeights").asInteger() != 0;
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
     // Align on 64-bit unit
@@ -305,7 +332,9 @@ createIterator(const PostingListCounts &counts,
     if (numDocs < _minSkipDocs) {
         return new Zc4RareWordPosOccIterator<true>(start, handle._bitLength, _docIdLimit, &_fieldsParams, matchData);
     } else {
-        return new Zc4PosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, counts, &_fieldsParams, matchData);
+        auto iterator = new Zc4PosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, counts, &_fieldsParams, matchData);
+        iterator->setBlockMaxWeights(_blockMaxWeights);
+        return iterator;
     }
 }
 
@@ -342,6 +371,8 @@ Zc4PosOccRandRead::readHeader()
     _minChunkDocs = header.getTag("minChunkDocs").asInteger();
     _docIdLimit = header.getTag("docIdLimit").asInteger();
     _minSkipDocs = header.getTag("minSkipDocs").asInteger();
+    _blockMaxWeights = header.hasTag("blockMaxWeights") &&
+                       header.getTag("blockMaxWeights").asInteger() != 0;
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
     // Align on 64-bit unit
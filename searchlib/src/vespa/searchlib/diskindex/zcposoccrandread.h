@@ -26,6 +26,14 @@ protected:
     uint64_t _headerBitSize;
     bitcompression::PosOccFieldsParams _fieldsParams;
     bool _dynamicK;
+    bool _blockMaxWeights;  // Block max weights present in skip words ?
+    bool _directIO;         // Reads bypass the page cache
+
+    /**
+     * Max number of bytes to prefetch for a memory mapped posting
+     * list. The iterator might skip most of a long posting list.
+     */
+    static constexpr size_t MAX_MAPPED_PREFETCH = 256 * 1024;
 
 
 public:
@@ -54,6 +62,8 @@ public:
                     uint32_t numSegments,
                     PostingListHandle &handle) override;
 
+    void prefetchPostingList(const PostingListHandle &handle) const override;
+
     bool open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead) override;
     bool close() override;
     virtual void readHeader();
@@ -7,6 +7,8 @@
 #include <vespa/searchlib/index/docidandfeatures.h>
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <limits>
+#include <fcntl.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.zcposting");
@@ -40,6 +42,7 @@ Zc4PostingSeqRead(PostingListCountFileSeqRead *countFile)
       _file(),
       _hasMore(false),
       _dynamicK(false),
+      _blockMaxWeights(false),
       _lastDocId(0),
       _minChunkDocs(1 << 30),
       _minSkipDocs(64),
@@ -49,6 +52,7 @@ Zc4PostingSeqRead(PostingListCountFileSeqRead *countFile)
       _l2Skip(),
       _l3Skip(),
       _l4Skip(),
+      _blockMax(),
       _numWords(0),
       _fileBitSize(0),
       _chunkNo(0),
@@ -311,6 +315,19 @@ Zc4PostingSeqRead::readWordStartWithSkip()
                                   EC);
         l4SkipSize = val64;
     }
+    uint32_t blockMaxSize = 0;
+    if (_blockMaxWeights) {
+        if (__builtin_expect(oCompr >= valE, false)) {
+            UC64_DECODECONTEXT_STORE(o, d._);
+            _readContext.readComprBuffer();
+            valE = d._valE;
+            UC64_DECODECONTEXT_LOAD(o, d._);
+        }
+        UC64BE_DECODEEXPGOLOMB_NS(o,
+                                  K_VALUE_ZCPOSTING_L1SKIPSIZE,
+                                  EC);
+        blockMaxSize = val64;
+    }
     UC64BE_DECODEEXPGOLOMB_NS(o,
                               K_VALUE_ZCPOSTING_FEATURESSIZE,
                               EC);
@@ -358,6 +375,7 @@ Zc4PostingSeqRead::readWordStartWithSkip()
     _l2Skip.clearReserve(l2SkipSize);
     _l3Skip.clearReserve(l3SkipSize);
     _l4Skip.clearReserve(l4SkipSize);
+    _blockMax.clearReserve(blockMaxSize);
     _decodeContext->readBytes(_zcDocIds._valI, docIdsSize);
     _zcDocIds._valE = _zcDocIds._valI + docIdsSize;
     if (l1SkipSize > 0)
@@ -372,6 +390,9 @@ Zc4PostingSeqRead::readWordStartWithSkip()
     if (l4SkipSize > 0)
         _decodeContext->readBytes(_l4Skip._valI, l4SkipSize);
     _l4Skip._valE = _l4Skip._valI + l4SkipSize;
+    if (blockMaxSize > 0)
+        _decodeContext->readBytes(_blockMax._valI, blockMaxSize);
+    _blockMax._valE = _blockMax._valI + blockMaxSize;
 
     if (l1SkipSize > 0)
         _l1SkipDocId = _l1Skip.decode() + 1 + _prevDocId;
@@ -464,8 +485,12 @@ bool
 Zc4PostingSeqRead::open(const vespalib::string &name,
                         const TuneFileSeqRead &tuneFileRead)
 {
-    if (tuneFileRead.getWantDirectIO())
+    if (tuneFileRead.getWantDirectIO()) {
         _file.EnableDirectIO();
+    } else {
+        // Posting lists are decoded from start to end, let the kernel read ahead more
+        _file.setFAdviseOptions(POSIX_FADV_SEQUENTIAL);
+    }
     bool res = _file.OpenReadOnly(name.c_str());
     if (res) {
         _readContext.setFile(&_file);
@@ -559,6 +584,8 @@ Zc4PostingSeqRead::readHeader()
     _docIdLimit = header.getTag("docIdLimit").asInteger();
     _minSkipDocs = header.getTag("minSkipDocs").asInteger();
     assert(header.getTag("endian").asString() == "big");
+    _blockMaxWeights = header.hasTag("blockMaxWeights") &&
+                       header.getTag("blockMaxWeights").asInteger() != 0;
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
     // Align on 64-bit unit
@@ -614,16 +641,19 @@ Zc4PostingSeqWrite(PostingListCountFileSeqWrite *countFile)
       _minSkipDocs(64),
       _docIdLimit(10000000),
       _docIds(),
+      _docMaxWeights(),
       _encodeFeatures(NULL),
       _featureOffset(0),
       _featureWriteContext(sizeof(uint64_t)),
       _writePos(0),
       _dynamicK(false),
+      _blockMaxWeights(false),
       _zcDocIds(),
       _l1Skip(),
       _l2Skip(),
       _l3Skip(),
       _l4Skip(),
+      _blockMax(),
       _numWords(0),
       _fileBitSize(0),
       _countFile(countFile)
@@ -657,6 +687,15 @@ writeDocIdAndFeatures(const DocIdAndFeatures &features)
     assert(static_cast<uint32_t>(featureSize) == featureSize);
     _docIds.push_back(std::make_pair(features._docId,
                                      static_cast<uint32_t>(featureSize)));
+    if (_blockMaxWeights) {
+        int32_t maxWeight = features._elements.empty() ?
+                            std::numeric_limits<int32_t>::max() :
+                            std::numeric_limits<int32_t>::min();
+        for (const auto &element : features._elements) {
+            maxWeight = std::max(maxWeight, element.getWeight());
+        }
+        _docMaxWeights.push_back(maxWeight);
+    }
     _featureOffset = writeOffset;
 }
 
@@ -732,6 +771,8 @@ Zc4PostingSeqWrite::readHeader(const vespalib::string &name)
     _docIdLimit = header.getTag("docIdLimit").asInteger();
     _minSkipDocs = header.getTag("minSkipDocs").asInteger();
     assert(header.getTag("endian").asString() == "big");
+    _blockMaxWeights = header.hasTag("blockMaxWeights") &&
+                       header.getTag("blockMaxWeights").asInteger() != 0;
     // Read feature decoding specific subheader using helper decode context
     f.readHeader(header, "features.");
     // Align on 64-bit unit
@@ -763,6 +804,9 @@ Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
     header.putTag(Tag("docIdLimit", _docIdLimit));
     header.putTag(Tag("minSkipDocs", _minSkipDocs));
     header.putTag(Tag("endian", "big"));
+    if (_blockMaxWeights) {
+        header.putTag(Tag("blockMaxWeights", 1));
+    }
     header.putTag(Tag("desc", "Posting list file"));
 
     f.writeHeader(header, "features.");
@@ -847,6 +891,7 @@ Zc4PostingSeqWrite::open(const vespalib::string &name,
     _l2Skip.maybeExpand();
     _l3Skip.maybeExpand();
     _l4Skip.maybeExpand();
+    _blockMax.maybeExpand();
     return true;    // Assume success
 }
 
@@ -890,6 +935,7 @@ setParams(const PostingListParams &params)
     params.get("docIdLimit", _docIdLimit);
     params.get("minChunkDocs", _minChunkDocs);
     params.get("minSkipDocs", _minSkipDocs);
+    params.get("blockMaxWeights", _blockMaxWeights);
 }
 
 
@@ -913,6 +959,7 @@ getParams(PostingListParams &params)
         params.set("minChunkDocs", _minChunkDocs);
     }
     params.set("minSkipDocs", _minSkipDocs);
+    params.set("blockMaxWeights", _blockMaxWeights);
 }
 
 
@@ -1090,6 +1137,32 @@ Zc4PostingSeqWrite::calcSkipInfo()
 }
 
 
+void
+Zc4PostingSeqWrite::calcBlockMaxWeights()
+{
+    assert(_docMaxWeights.size() == _docIds.size());
+    uint32_t lastBlockDocId = 0u;
+    if (!_counts._segments.empty()) {
+        lastBlockDocId = _counts._segments.back()._lastDoc;
+    }
+    size_t numDocs = _docIds.size();
+    for (size_t blockStart = 0; blockStart < numDocs; blockStart += L1SKIPSTRIDE) {
+        size_t blockEnd = std::min(blockStart + L1SKIPSTRIDE, numDocs);
+        int32_t maxWeight = std::numeric_limits<int32_t>::min();
+        for (size_t i = blockStart; i < blockEnd; ++i) {
+            maxWeight = std::max(maxWeight, _docMaxWeights[i]);
+        }
+        uint32_t blockDocId = _docIds[blockEnd - 1].first;
+        // Docid delta for last document in block
+        _blockMax.encode(blockDocId - lastBlockDocId - 1);
+        // Zigzag encoded max weight
+        _blockMax.encode((static_cast<uint32_t>(maxWeight) << 1) ^
+                         static_cast<uint32_t>(maxWeight >> 31));
+        lastBlockDocId = blockDocId;
+    }
+}
+
+
 void
 Zc4PostingSeqWrite::flushWordWithSkip(bool hasMore)
 {
@@ -1106,6 +1179,9 @@ Zc4PostingSeqWrite::flushWordWithSkip(bool hasMore)
 
     // TODO: Calculate docids size, possible also k parameter  */
     calcSkipInfo();
+    if (_blockMaxWeights) {
+        calcBlockMaxWeights();
+    }
 
     uint32_t docIdsSize = _zcDocIds.size();
     uint32_t l1SkipSize = _l1Skip.size();
@@ -1124,6 +1200,10 @@ Zc4PostingSeqWrite::flushWordWithSkip(bool hasMore)
             }
         }
     }
+    uint32_t blockMaxSize = _blockMax.size();
+    if (_blockMaxWeights) {
+        e.encodeExpGolomb(blockMaxSize, K_VALUE_ZCPOSTING_L1SKIPSIZE);
+    }
     e.encodeExpGolomb(_featureOffset, K_VALUE_ZCPOSTING_FEATURESSIZE);
 
     // Encode last document id in chunk or word.
@@ -1169,6 +1249,12 @@ Zc4PostingSeqWrite::flushWordWithSkip(bool hasMore)
                     0,
                     l4SkipSize * 8);
     }
+    if (blockMaxSize > 0) {
+        uint8_t *blockMax = _blockMax._mallocStart;
+        e.writeBits(reinterpret_cast<const uint64_t *>(blockMax),
+                    0,
+                    blockMaxSize * 8);
+    }
 
     // Write features
     e.writeBits(static_cast<const uint64_t *>(_featureWriteContext._comprBuf),
@@ -1191,6 +1277,7 @@ Zc4PostingSeqWrite::flushWordWithSkip(bool hasMore)
     _l2Skip.clear();
     _l3Skip.clear();
     _l4Skip.clear();
+    _blockMax.clear();
     resetWord();
 }
 
@@ -1234,6 +1321,7 @@ void
 Zc4PostingSeqWrite::resetWord()
 {
     _docIds.clear();
+    _docMaxWeights.clear();
     _encodeFeatures->setupWrite(_featureWriteContext);
     _featureOffset = 0;
 }
@@ -35,6 +35,7 @@ protected:
     FastOS_File _file;
     bool _hasMore;
     bool _dynamicK;         // Caclulate EG compression parameters ?
+    bool _blockMaxWeights;  // Block max weights present in skip words ?
     uint32_t _lastDocId;    // last document in chunk or word
     uint32_t _minChunkDocs; // # of documents needed for chunking
     uint32_t _minSkipDocs;  // # of documents needed for skipping
@@ -45,6 +46,7 @@ protected:
     ZcBuf _l2Skip;      // L2 skip info
     ZcBuf _l3Skip;      // L3 skip info
     ZcBuf _l4Skip;      // L4 skip info
+    ZcBuf _blockMax;    // Max weight per L1 skip block
 
     uint64_t _numWords;     // Number of words in file
     uint64_t _fileBitSize;
@@ -144,6 +146,8 @@ protected:
     // Unpacked document ids for word and feature sizes
     typedef std::pair<uint32_t, uint32_t> DocIdAndFeatureSize;
     std::vector<DocIdAndFeatureSize> _docIds;
+    // Max element weight for each buffered document
+    std::vector<int32_t> _docMaxWeights;
 
     // Buffer up features in memory
     EncodeContext *_encodeFeatures;
@@ -151,11 +155,13 @@ protected:
     search::ComprFileWriteContext _featureWriteContext;
     uint64_t _writePos; // Bit position for start of current word
     bool _dynamicK;     // Caclulate EG compression parameters ?
+    bool _blockMaxWeights; // Write block max weights for skip words ?
     ZcBuf _zcDocIds;    // Document id deltas
     ZcBuf _l1Skip;      // L1 skip info
     ZcBuf _l2Skip;      // L2 skip info
     ZcBuf _l3Skip;      // L3 skip info
     ZcBuf _l4Skip;      // L4 skip info
+    ZcBuf _blockMax;    // Max weight per L1 skip block
 
     uint64_t _numWords; // Number of words in file
     uint64_t _fileBitSize;
@@ -186,6 +192,13 @@ public:
     void flushChunk();
     void calcSkipInfo();
 
+    /**
+     * Calculate max element weight for each block of L1SKIPSTRIDE
+     * documents, used by block-max WAND to skip blocks that cannot
+     * contribute enough to the score.
+     */
+    void calcBlockMaxWeights();
+
     /**
      * Flush word with skip info to disk
      */
@@ -214,12 +214,30 @@ ZcPostingIteratorBase::ZcPostingIteratorBase(const TermFieldMatchDataArray &matc
       _l3(),
       _l4(),
       _chunk(),
+      _blockMax(),
       _featuresSize(0),
       _hasMore(false),
+      _blockMaxWeights(false),
       _chunkNo(0)
 {
 }
 
+
+uint32_t
+ZcPostingIteratorBase::getBlockMaxWeight(uint32_t docId, int32_t &maxWeight)
+{
+    while (docId > _blockMax._blockDocId && _blockMax._valI < _blockMax._valE) {
+        _blockMax.decodeBlock();
+    }
+    if (__builtin_expect(docId > _blockMax._blockDocId || _blockMax._valI == nullptr, false)) {
+        // Outside current chunk, no info available
+        maxWeight = std::numeric_limits<int32_t>::max();
+        return docId;
+    }
+    maxWeight = _blockMax._maxWeight;
+    return _blockMax._blockDocId;
+}
+
 template <bool bigEndian>
 ZcPostingIterator<bigEndian>::
 ZcPostingIterator(uint32_t minChunkDocs,
@@ -287,6 +305,11 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
         UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_L4SKIPSIZE, EC);
         l4SkipSize = val64;
     }
+    uint32_t blockMaxSize = 0;
+    if (_blockMaxWeights) {
+        UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_L1SKIPSIZE, EC);
+        blockMaxSize = val64;
+    }
     UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_FEATURESSIZE, EC);
     _featuresSize = val64;
     if (_dynamicK) {
@@ -320,6 +343,9 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     _l2.postSetup(_l1);
     _l3.postSetup(_l2);
     _l4.postSetup(_l3);
+    if (_blockMaxWeights) {
+        _blockMax.setup(prevDocId, bcompr, blockMaxSize);
+    }
     d.setByteCompr(bcompr);
     _hasMore = hasMore;
     // Save information about start of next chunk
@@ -549,7 +575,7 @@ ZcPostingIteratorBase::doSeek(uint32_t docId)
         assert(oDocId <= _l3._skipDocId);
         assert(oDocId <= _l4._skipDocId);
 #endif
-        ZCDECODE(oCompr, oDocId += 1 +);
+        oDocId += 1 + zcDecodePadded(oCompr);
 #if DEBUG_ZCPOSTING_PRINTF
         printf("Decode docId=%d\n",
                oDocId);
@@ -588,6 +614,7 @@ void ZcPostingIterator<bigEndian>::rewind(Position start)
     _hasMore = false;
     _chunk._lastDocId = 0;
     _chunkNo = 0;
+    _blockMax.clear();
 }
 
 
@@ -5,7 +5,9 @@
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/queryeval/iterators.h>
+#include <vespa/searchlib/queryeval/posting_info.h>
 #include <vespa/fastos/dynamiclibrary.h>
+#include <cstring>
 
 namespace search {
 
@@ -43,6 +45,30 @@ do {                                                         \
     }                                                        \
 } while (0)
 
+/*
+ * Decode one zc encoded value, same format as ZCDECODE, without a
+ * branch per byte. The length is found from the continuation bits of
+ * an 8 byte load, so up to 8 bytes are read even if the value is
+ * shorter. Posting list buffers are always padded for this, see
+ * ZcPosOccRandRead::readPostingList().
+ */
+inline uint32_t
+zcDecodePadded(const uint8_t *&valI)
+{
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "zcDecodePadded assumes little endian");
+    uint64_t word;
+    memcpy(&word, valI, sizeof(word));
+    // Last byte of value is the first one with high bit clear, at most 5 bytes
+    uint32_t bits = __builtin_ctzll(~word & 0x8080808080ull) + 1;
+    valI += (bits >> 3);
+    word &= (static_cast<uint64_t>(1) << bits) - 1;
+    return (word & 0x7f) |
+        ((word >> 1) & 0x3f80) |
+        ((word >> 2) & 0x1fc000) |
+        ((word >> 3) & 0xfe00000) |
+        ((word >> 4) & 0xf0000000);
+}
+
 class ZcIteratorBase : public queryeval::RankedSearchIteratorBase
 {
 protected:
@@ -103,7 +129,8 @@ public:
 };
 
 
-class ZcPostingIteratorBase : public ZcIteratorBase
+class ZcPostingIteratorBase : public ZcIteratorBase,
+                              public queryeval::BlockMaxWeightInfo
 {
 protected:
     const uint8_t *_valI;     // docid deltas
@@ -134,7 +161,7 @@ protected:
                 _valI = _valIBase = bcompr;
                 bcompr += skipSize;
                 _skipDocId = prevDocId + 1;
-                ZCDECODE(_valI, _skipDocId +=);
+                _skipDocId += zcDecodePadded(_valI);
             } else {
                 _valI = _valIBase = nullptr;
                 _skipDocId = lastDocId;
@@ -145,11 +172,11 @@ protected:
             _docIdPos = l0._valIBase;
         }
         void decodeSkipEntry() {
-            ZCDECODE(_valI, _docIdPos += 1 +);
-            ZCDECODE(_valI, _skipFeaturePos += 1 +);
+            _docIdPos += 1 + zcDecodePadded(_valI);
+            _skipFeaturePos += 1 + zcDecodePadded(_valI);
         }
         void nextDocId() {
-            ZCDECODE(_valI, _skipDocId += 1 +);
+            _skipDocId += 1 + zcDecodePadded(_valI);
         }
     };
 
@@ -171,7 +198,7 @@ protected:
         }
         void decodeSkipEntry() {
             L1Skip::decodeSkipEntry();
-            ZCDECODE(_valI, _l1Pos += 1 + );
+            _l1Pos += 1 + zcDecodePadded(_valI);
         }
     };
 
@@ -194,7 +221,7 @@ protected:
         }
         void decodeSkipEntry() {
             L2Skip::decodeSkipEntry();
-            ZCDECODE(_valI, _l2Pos += 1 + );
+            _l2Pos += 1 + zcDecodePadded(_valI);
         }
     };
 
@@ -219,7 +246,7 @@ protected:
 
         void decodeSkipEntry() {
             L3Skip::decodeSkipEntry();
-            ZCDECODE(_valI, _l3Pos += 1 + );
+            _l3Pos += 1 + zcDecodePadded(_valI);
         }
     };
 
@@ -234,18 +261,58 @@ protected:
         }
     };
 
+    // Helper class for block max weight info, decoded independently of
+    // the skip info since lookups are driven by other terms.
+    class BlockMax
+    {
+    public:
+        const uint8_t *_valI;
+        const uint8_t *_valE;
+        uint32_t _blockDocId;  // last docid in current block
+        int32_t _maxWeight;    // max weight in current block
+
+        BlockMax()
+            : _valI(nullptr),
+              _valE(nullptr),
+              _blockDocId(0),
+              _maxWeight(std::numeric_limits<int32_t>::max())
+        {
+        }
+
+        void setup(uint32_t prevDocId, const uint8_t *&bcompr, uint32_t blockMaxSize) {
+            _valI = bcompr;
+            _valE = bcompr + blockMaxSize;
+            bcompr += blockMaxSize;
+            _blockDocId = prevDocId;
+            _maxWeight = std::numeric_limits<int32_t>::max();
+        }
+        void clear() {
+            _valI = _valE = nullptr;
+            _blockDocId = 0;
+            _maxWeight = std::numeric_limits<int32_t>::max();
+        }
+        void decodeBlock() {
+            uint32_t zigzagWeight = 0;
+            _blockDocId += 1 + zcDecodePadded(_valI);
+            zigzagWeight = zcDecodePadded(_valI);
+            _maxWeight = static_cast<int32_t>((zigzagWeight >> 1) ^ (-(zigzagWeight & 1)));
+        }
+    };
+
     L1Skip _l1;
     L2Skip _l2;
     L3Skip _l3;
     L4Skip _l4;
     ChunkSkip _chunk;
+    BlockMax _blockMax;
     uint64_t _featuresSize;
     bool     _hasMore;
+    bool     _blockMaxWeights;
     uint32_t _chunkNo;
 
     void nextDocId(uint32_t prevDocId) {
         uint32_t docId = prevDocId + 1;
-        ZCDECODE(_valI, docId +=);
+        docId += zcDecodePadded(_valI);
         setDocId(docId);
     }
     virtual void featureSeek(uint64_t offset) = 0;
@@ -257,6 +324,14 @@ protected:
     void doSeek(uint32_t docId) override;
 public:
     ZcPostingIteratorBase(const fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit);
+
+    /**
+     * Enable use of block max weights stored after the skip info.
+     * Must match the posting file and be set before initRange.
+     */
+    void setBlockMaxWeights(bool blockMaxWeights) { _blockMaxWeights = blockMaxWeights; }
+    bool hasBlockMaxWeights() const override { return _blockMaxWeights; }
+    uint32_t getBlockMaxWeight(uint32_t docId, int32_t &maxWeight) override;
 };
 
 template <bool bigEndian>
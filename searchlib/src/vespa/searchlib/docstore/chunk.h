@@ -13,6 +13,8 @@ namespace vespalib {
     class DataBuffer;
 }
 
+namespace vespalib::compression { class ZStdDictionary; }
+
 namespace search {
 
 class ChunkFormat;
@@ -62,12 +64,19 @@ class Chunk {
 public:
     using UP = std::unique_ptr<Chunk>;
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using ZStdDictionary = vespalib::compression::ZStdDictionary;
     class Config {
     public:
-        Config(size_t maxBytes) : _maxBytes(maxBytes) { }
+        Config(size_t maxBytes) : _maxBytes(maxBytes), _dictionary(nullptr) { }
+        /**
+         * The dictionary is used when packing with zstd, and must outlive the chunk.
+         */
+        Config(size_t maxBytes, const ZStdDictionary * dictionary) : _maxBytes(maxBytes), _dictionary(dictionary) { }
         size_t getMaxBytes() const { return _maxBytes; }
+        const ZStdDictionary * getDictionary() const { return _dictionary; }
     private:
       size_t _maxBytes;
+      const ZStdDictionary * _dictionary;
     };
     class Entry {
     public:
@@ -85,7 +94,7 @@ public:
     };
     typedef std::vector<Entry> LidList;
     Chunk(uint32_t id, const Config & config);
-    Chunk(uint32_t id, const void * buffer, size_t len, bool skipcrc=false);
+    Chunk(uint32_t id, const void * buffer, size_t len, bool skipcrc=false, const ZStdDictionary * dictionary=nullptr);
     ~Chunk();
     LidMeta append(uint32_t lid, const void * buffer, size_t len);
     ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const;
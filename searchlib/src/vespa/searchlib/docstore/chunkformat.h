@@ -7,6 +7,8 @@
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/exception.h>
 
+namespace vespalib::compression { class ZStdDictionary; }
+
 namespace search {
 
 class ChunkException : public vespalib::Exception
@@ -22,6 +24,7 @@ public:
     virtual ~ChunkFormat();
     using UP = std::unique_ptr<ChunkFormat>;
     using CompressionConfig = vespalib::compression::CompressionConfig;
+    using ZStdDictionary = vespalib::compression::ZStdDictionary;
     vespalib::nbostream & getBuffer() { return _dataBuf; }
     const vespalib::nbostream & getBuffer() const { return _dataBuf; }
 
@@ -37,8 +40,10 @@ public:
      * param buffer Pointer to the serialized data
      * @param len Length of serialized data
      * @param indicate if crc verification shall be skipped.
+     * @param dictionary The zstd dictionary of the file the chunk was read from, if any.
      */
-    static ChunkFormat::UP deserialize(const void * buffer, size_t len, bool skipcrc);
+    static ChunkFormat::UP deserialize(const void * buffer, size_t len, bool skipcrc,
+                                       const ZStdDictionary * dictionary = nullptr);
     /**
      * return the maximum size a packet can have. It allows correct size estimation
      * need for direct io alignment.
@@ -67,6 +72,17 @@ protected:
      * Thows exception if check fails.
      */
     void verifyCrc(const vespalib::nbostream & is, uint32_t expected) const;
+    /**
+     * Compresses the body, appending it to dest.
+     * @return the compression type actually used.
+     */
+    virtual CompressionConfig::Type compressBody(const CompressionConfig & compression,
+                                                 const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest) const;
+    /**
+     * Decompresses the body. Uncompressed data may be swapped in.
+     */
+    virtual void decompressBody(CompressionConfig::Type type, size_t uncompressedLen,
+                                const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest) const;
 private:
     /**
      * Used when serializing to obtain correct version.
@@ -97,7 +113,7 @@ private:
      * @param buf Buffer to write into.
      */
     virtual void writeHeader(vespalib::DataBuffer & buf) const = 0;
-    
+
     static void verifyCompression(uint8_t type);
 
     vespalib::nbostream _dataBuf;
@@ -2,12 +2,16 @@
 
 #include "chunkformats.h"
 #include <vespa/vespalib/util/crc.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
 #include <vespa/vespalib/xxhash/xxhash.h>
 #include <vespa/vespalib/util/stringfmt.h>
 
 namespace search {
 
 using vespalib::make_string;
+using vespalib::compression::ZStdCompressor;
+using vespalib::compression::compress;
+using vespalib::compression::decompress;
 
 ChunkFormatV1::ChunkFormatV1(vespalib::nbostream & is) :
     ChunkFormat()
@@ -70,4 +74,87 @@ ChunkFormatV2::verifyMagic(vespalib::nbostream & is) const
     }
 }
 
+ChunkFormatV3::ChunkFormatV3(vespalib::nbostream & is, const ZStdDictionary * dictionary) :
+    ChunkFormat(),
+    _dictionary(dictionary)
+{
+    verifyHeader(is);
+    deserializeBody(is);
+}
+
+ChunkFormatV3::ChunkFormatV3(vespalib::nbostream & is, uint32_t expectedCrc, const ZStdDictionary * dictionary) :
+    ChunkFormat(),
+    _dictionary(dictionary)
+{
+    verifyCrc(is, expectedCrc);
+    verifyHeader(is);
+    deserializeBody(is);
+}
+
+ChunkFormatV3::ChunkFormatV3(size_t maxSize, const ZStdDictionary & dictionary) :
+    ChunkFormat(maxSize),
+    _dictionary(&dictionary)
+{
+}
+
+uint32_t
+ChunkFormatV3::computeCrc(const void * buf, size_t sz) const
+{
+    return XXH32(buf, sz, 0);
+}
+
+void
+ChunkFormatV3::writeHeader(vespalib::DataBuffer & buf) const
+{
+    buf.writeInt32(MAGIC);
+    buf.writeInt32(_dictionary->getId());
+}
+
+ChunkFormat::CompressionConfig::Type
+ChunkFormatV3::compressBody(const CompressionConfig & compression, const vespalib::ConstBufferRef & org,
+                            vespalib::DataBuffer & dest) const
+{
+    if ((compression.type != CompressionConfig::ZSTD) || (org.size() < compression.minSize)) {
+        return ChunkFormat::compressBody(compression, org, dest);
+    }
+    ZStdCompressor zstd(_dictionary);
+    CompressionConfig::Type type = compress(zstd, compression, org, dest);
+    if (type == CompressionConfig::NONE) {
+        dest.writeBytes(org.c_str(), org.size());
+    }
+    return type;
+}
+
+void
+ChunkFormatV3::decompressBody(CompressionConfig::Type type, size_t uncompressedLen, const vespalib::ConstBufferRef & org,
+                              vespalib::DataBuffer & dest) const
+{
+    if (type != CompressionConfig::ZSTD) {
+        ChunkFormat::decompressBody(type, uncompressedLen, org, dest);
+        return;
+    }
+    ZStdCompressor zstd(_dictionary);
+    decompress(zstd, uncompressedLen, org, dest, true);
+}
+
+void
+ChunkFormatV3::verifyHeader(vespalib::nbostream & is) const
+{
+    uint32_t magic;
+    is >> magic;
+    if (magic != MAGIC) {
+        throw ChunkException(make_string("Unknown magic %0x, expected %0x", magic, MAGIC), VESPA_STRLOC);
+    }
+    uint32_t dictionaryId;
+    is >> dictionaryId;
+    if (_dictionary == nullptr) {
+        throw ChunkException(make_string("Compressed with zstd dictionary %0x, but no dictionary is available",
+                                         dictionaryId), VESPA_STRLOC);
+    }
+    if (dictionaryId != _dictionary->getId()) {
+        throw ChunkException(make_string("Compressed with zstd dictionary %0x, but dictionary is %0x",
+                                         dictionaryId, _dictionary->getId()), VESPA_STRLOC);
+    }
+}
+
 } // namespace search
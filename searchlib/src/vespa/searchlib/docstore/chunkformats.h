@@ -44,5 +44,36 @@ private:
     void verifyMagic(vespalib::nbostream & is) const;
 };
 
+/**
+ * Same as V2, but zstd compressed bodies use the zstd dictionary of the
+ * file. The id of the dictionary follows the magic, so a chunk is never
+ * decompressed with the wrong dictionary. The dictionary must outlive
+ * the format.
+ */
+class ChunkFormatV3 : public ChunkFormat
+{
+public:
+    enum {VERSION=2, MAGIC=0x7a5d1c73};
+    ChunkFormatV3(vespalib::nbostream & is, const ZStdDictionary * dictionary);
+    ChunkFormatV3(vespalib::nbostream & is, uint32_t expectedCrc, const ZStdDictionary * dictionary);
+    ChunkFormatV3(size_t maxSize, const ZStdDictionary & dictionary);
+private:
+    bool includeSerializedSize() const override { return true; }
+    size_t getHeaderSize() const override {
+        // MAGIC + dictionary id
+        return 4 + 4;
+    }
+    uint8_t getVersion() const override { return VERSION; }
+    uint32_t computeCrc(const void * buf, size_t sz) const override;
+    void writeHeader(vespalib::DataBuffer & buf) const override;
+    CompressionConfig::Type compressBody(const CompressionConfig & compression,
+                                         const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest) const override;
+    void decompressBody(CompressionConfig::Type type, size_t uncompressedLen,
+                        const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest) const override;
+    void verifyHeader(vespalib::nbostream & is) const;
+
+    const ZStdDictionary * _dictionary;
+};
+
 } // namespace search
 
@@ -3,6 +3,7 @@
 #include "compacter.h"
 #include "logdatastore.h"
 #include <vespa/vespalib/util/array.hpp>
+#include <vespa/vespalib/util/zstdcompressor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.docstore.compacter");
@@ -19,8 +20,38 @@ Compacter::write(LockGuard guard, uint32_t chunkId, uint32_t lid, const void *bu
     _ds.write(std::move(guard), fileId, lid, buffer, sz);
 }
 
-BucketCompacter::BucketCompacter(size_t maxSignificantBucketBits, const CompressionConfig & compression, LogDataStore & ds, ThreadExecutor & executor, const IBucketizer & bucketizer, FileId source, FileId destination) :
+DictionarySampler::DictionarySampler(size_t maxBytes) :
+    _maxBytes(maxBytes),
+    _samples(),
+    _sampleSizes()
+{
+}
+
+DictionarySampler::~DictionarySampler() = default;
+
+void
+DictionarySampler::write(LockGuard guard, uint32_t chunkId, uint32_t lid, const void *buffer, size_t sz) {
+    (void) guard;
+    (void) chunkId;
+    (void) lid;
+    if ((sz > 0) && (_samples.size() + sz <= _maxBytes)) {
+        const char * data = static_cast<const char *>(buffer);
+        _samples.insert(_samples.end(), data, data + sz);
+        _sampleSizes.push_back(sz);
+    }
+}
+
+std::vector<char>
+DictionarySampler::train(size_t maxDictionarySize) const
+{
+    return vespalib::compression::ZStdDictionary::train(_samples.data(), _sampleSizes, maxDictionarySize);
+}
+
+BucketCompacter::BucketCompacter(size_t maxSignificantBucketBits, const CompressionConfig & compression, LogDataStore & ds,
+                                 ThreadExecutor & executor, const IBucketizer & bucketizer, FileId source, FileId destination,
+                                 bool orderByReadFrequency) :
     _unSignificantBucketBits((maxSignificantBucketBits > 8) ? (maxSignificantBucketBits - 8) : 0),
+    _orderByReadFrequency(orderByReadFrequency),
     _sourceFileId(source),
     _destinationFileId(destination),
     _ds(ds),
@@ -44,6 +75,21 @@ BucketCompacter::getDestinationId(const LockGuard & guard) const {
     return (_destinationFileId.isActive()) ? _ds.getActiveFileId(guard) : _destinationFileId;
 }
 
+size_t
+BucketCompacter::getStoreIndex(uint64_t sortableBucketId, uint32_t lid) const
+{
+    if ( ! _orderByReadFrequency) {
+        return (sortableBucketId >> _unSignificantBucketBits) % _tmpStore.size();
+    }
+    // The stores are drained in order, so the hottest class gets the first range of stores.
+    const size_t numClasses = LogDataStore::NUM_READ_FREQUENCY_CLASSES;
+    const size_t storesPerClass = _tmpStore.size() / numClasses;
+    const size_t coldness = numClasses - 1 - _ds.getReadFrequencyClass(_lidGuard, lid);
+    // 64 stores per class, so 2 bits fewer of the bucket id are used to pick the store.
+    const size_t bucketPart = (sortableBucketId >> (_unSignificantBucketBits + 2)) % storesPerClass;
+    return coldness * storesPerClass + bucketPart;
+}
+
 void
 BucketCompacter::write(LockGuard guard, uint32_t chunkId, uint32_t lid, const void *buffer, size_t sz)
 {
@@ -51,7 +97,7 @@ BucketCompacter::write(LockGuard guard, uint32_t chunkId, uint32_t lid, const vo
     guard.unlock();
     BucketId bucketId = (sz > 0) ? _bucketizer.getBucketOf(_bucketizerGuard, lid) : BucketId();
     uint64_t sortableBucketId = bucketId.toKey();
-    _tmpStore[(sortableBucketId >> _unSignificantBucketBits) % _tmpStore.size()].add(bucketId, chunkId, lid, buffer, sz);
+    _tmpStore[getStoreIndex(sortableBucketId, lid)].add(bucketId, chunkId, lid, buffer, sz);
     if ((_writeCount % 1000) == 0) {
         _bucketizerGuard = _bucketizer.getGuard();
     }
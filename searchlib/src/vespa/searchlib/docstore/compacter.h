@@ -25,11 +25,36 @@ private:
     LogDataStore & _ds;
 };
 
+/**
+ * Collects documents as samples for training a zstd dictionary,
+ * until the sample budget is spent.
+ */
+class DictionarySampler : public IWriteData
+{
+public:
+    DictionarySampler(size_t maxBytes);
+    ~DictionarySampler();
+    void write(LockGuard guard, uint32_t chunkId, uint32_t lid, const void *buffer, size_t sz) override;
+    void close() override { }
+    size_t getNumSamples() const { return _sampleSizes.size(); }
+    size_t getSampledBytes() const { return _samples.size(); }
+    /**
+     * @return the dictionary content, or empty if there were too few samples.
+     */
+    std::vector<char> train(size_t maxDictionarySize) const;
+private:
+    size_t              _maxBytes;
+    std::vector<char>   _samples;
+    std::vector<size_t> _sampleSizes;
+};
+
 /**
  * This will split the incoming data into buckets.
  * The buckets data will then be written out in bucket order.
  * The buckets will be ordered, and the objects inside the buckets will be further ordered.
  * All data are kept compressed to minimize memory usage.
+ * When ordering by read frequency, the most read documents are written first,
+ * and bucket order is kept within each read frequency class.
  **/
 class BucketCompacter : public IWriteData, public StoreByBucket::IWrite
 {
@@ -38,14 +63,17 @@ class BucketCompacter : public IWriteData, public StoreByBucket::IWrite
 public:
     using FileId = FileChunk::FileId;
     BucketCompacter(size_t maxSignificantBucketBits, const CompressionConfig & compression, LogDataStore & ds,
-                    ThreadExecutor & exeutor, const IBucketizer & bucketizer, FileId source, FileId destination);
+                    ThreadExecutor & exeutor, const IBucketizer & bucketizer, FileId source, FileId destination,
+                    bool orderByReadFrequency = false);
     void write(LockGuard guard, uint32_t chunkId, uint32_t lid, const void *buffer, size_t sz) override ;
     void write(BucketId bucketId, uint32_t chunkId, uint32_t lid, const void *buffer, size_t sz) override;
     void close() override;
 private:
     using GenerationHandler = vespalib::GenerationHandler;
     FileId getDestinationId(const LockGuard & guard) const;
+    size_t getStoreIndex(uint64_t sortableBucketId, uint32_t lid) const;
     size_t                     _unSignificantBucketBits;
+    bool                       _orderByReadFrequency;
     FileId                     _sourceFileId;
     FileId                     _destinationFileId;
     LogDataStore             & _ds;
@@ -8,6 +8,8 @@
 #include <vespa/vespalib/stllike/cache.hpp>
 #include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 using document::DocumentTypeRepo;
 using vespalib::compression::CompressionConfig;
@@ -18,6 +20,10 @@ namespace search {
 
 namespace {
 
+// Documents deserialized together when visiting for read.
+constexpr size_t VISIT_BATCH_SIZE = 256;
+constexpr uint32_t VISIT_THREADS = 4;
+
 class DocumentVisitorAdapter : public IBufferVisitor
 {
 public:
@@ -209,6 +215,7 @@ bool
 DocumentStore::Config::operator == (const Config &rhs) const {
     return (_maxCacheBytes == rhs._maxCacheBytes) &&
             (_allowVisitCaching == rhs._allowVisitCaching) &&
+            (_maxPrefetchHits == rhs._maxPrefetchHits) &&
             (_initialCacheEntries == rhs._initialCacheEntries) &&
             (_compression == rhs._compression);
 }
@@ -242,6 +249,23 @@ DocumentStore::useCache() const {
     return (_cache->capacityBytes() != 0) && (_cache->capacity() != 0);
 }
 
+void
+DocumentStore::prefetch(const LidVector & lids) const
+{
+    if ( ! useCache()) {
+        _backingStore.prefetch(lids);
+        return;
+    }
+    LidVector uncached;
+    uncached.reserve(lids.size());
+    for (uint32_t lid : lids) {
+        if ( ! _cache->hasKey(lid)) {
+            uncached.push_back(lid);
+        }
+    }
+    _backingStore.prefetch(uncached);
+}
+
 void
 DocumentStore::visit(const LidVector & lids, const DocumentTypeRepo &repo, IDocumentVisitor & visitor) const
 {
@@ -251,6 +275,21 @@ DocumentStore::visit(const LidVector & lids, const DocumentTypeRepo &repo, IDocu
         for (DocumentIdT lid : lids) {
             adapter.visit(lid, blobSet.get(lid));
         }
+    } else if (useCache()) {
+        // Documents already in the cache are not read again, the rest are read in one batch.
+        LidVector uncached;
+        uncached.reserve(lids.size());
+        for (DocumentIdT lid : lids) {
+            if (_cache->hasKey(lid)) {
+                Value value = _cache->read(lid);
+                if ( ! value.empty()) {
+                    visitor.visit(lid, value.deserializeDocument(repo));
+                }
+            } else {
+                uncached.push_back(lid);
+            }
+        }
+        _store->visit(uncached, repo, visitor);
     } else {
         _store->visit(lids, repo, visitor);
     }
@@ -474,18 +513,107 @@ WrapVisitor(Visitor &visitor,
 }
 
 
+/**
+ * Read visitor that deserializes the visited documents in batches
+ * spread over a few threads, and then hands them to the visitor in
+ * the order they were visited. Deserialization dominates the cost of
+ * a full visit (e.g. when reprocessing after a schema change), while
+ * the chunks themselves are already read in parallel by the backing
+ * store.
+ */
+class DocumentStore::BatchReadVisitor : public IDataStoreVisitor
+{
+    IDocumentStoreReadVisitor                        &_visitor;
+    const DocumentTypeRepo                           &_repo;
+    vespalib::ThreadStackExecutor                     _executor;
+    std::vector<uint32_t>                             _lids;
+    std::vector<Value>                                _values;
+    std::vector<std::shared_ptr<document::Document>>  _docs;
+
+    void deserialize(size_t begin, size_t end);
+public:
+    BatchReadVisitor(IDocumentStoreReadVisitor &visitor, const DocumentTypeRepo &repo);
+    ~BatchReadVisitor();
+    void visit(uint32_t lid, const void *buffer, size_t sz) override;
+    void flush();
+};
+
+DocumentStore::BatchReadVisitor::BatchReadVisitor(IDocumentStoreReadVisitor &visitor,
+                                                  const DocumentTypeRepo &repo)
+    : _visitor(visitor),
+      _repo(repo),
+      _executor(VISIT_THREADS, 128 * 1024),
+      _lids(),
+      _values(),
+      _docs()
+{
+    _lids.reserve(VISIT_BATCH_SIZE);
+    _values.reserve(VISIT_BATCH_SIZE);
+}
+
+DocumentStore::BatchReadVisitor::~BatchReadVisitor() = default;
+
+void
+DocumentStore::BatchReadVisitor::visit(uint32_t lid, const void *buffer, size_t sz)
+{
+    _lids.push_back(lid);
+    _values.emplace_back();
+    if (sz > 0) {
+        vespalib::DataBuffer buf(4096);
+        buf.clear();
+        buf.writeBytes(buffer, sz);
+        _values.back().set(std::move(buf), sz);
+    }
+    if (_lids.size() >= VISIT_BATCH_SIZE) {
+        flush();
+    }
+}
+
+void
+DocumentStore::BatchReadVisitor::deserialize(size_t begin, size_t end)
+{
+    for (size_t i = begin; i < end; ++i) {
+        if ( ! _values[i].empty()) {
+            _docs[i] = _values[i].deserializeDocument(_repo);
+        }
+    }
+}
+
+void
+DocumentStore::BatchReadVisitor::flush()
+{
+    size_t numDocs = _lids.size();
+    if (numDocs == 0) {
+        return;
+    }
+    _docs.resize(numDocs);
+    size_t perThread = (numDocs + VISIT_THREADS - 1) / VISIT_THREADS;
+    for (size_t begin = 0; begin < numDocs; begin += perThread) {
+        size_t end = std::min(begin + perThread, numDocs);
+        _executor.execute(vespalib::makeLambdaTask([this, begin, end]() { deserialize(begin, end); }));
+    }
+    _executor.sync();
+    for (size_t i = 0; i < numDocs; ++i) {
+        if ( ! _values[i].empty()) {
+            _visitor.visit(_lids[i], _docs[i]);
+        } else {
+            _visitor.visit(_lids[i]);
+        }
+    }
+    _lids.clear();
+    _values.clear();
+    _docs.clear();
+}
+
 void
 DocumentStore::accept(IDocumentStoreReadVisitor &visitor,
                       IDocumentStoreVisitorProgress &visitorProgress,
                       const DocumentTypeRepo &repo)
 {
-    WrapVisitor<IDocumentStoreReadVisitor> wrap(visitor, repo,
-                                                _store->getCompression(),
-                                                *this,
-                                                _backingStore.
-                                                tentativeLastSyncToken());
+    BatchReadVisitor wrap(visitor, repo);
     WrapVisitorProgress wrapVisitorProgress(visitorProgress);
     _backingStore.accept(wrap, wrapVisitorProgress, false);
+    wrap.flush();
 }
 
 
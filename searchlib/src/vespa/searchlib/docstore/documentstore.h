@@ -32,25 +32,30 @@ public:
             _compression(CompressionConfig::LZ4, 9, 70),
             _maxCacheBytes(1000000000),
             _initialCacheEntries(0),
-            _allowVisitCaching(false)
+            _allowVisitCaching(false),
+            _maxPrefetchHits(0)
         { }
         Config(const CompressionConfig & compression, size_t maxCacheBytes, size_t initialCacheEntries) :
             _compression((maxCacheBytes != 0) ? compression : CompressionConfig::NONE),
             _maxCacheBytes(maxCacheBytes),
             _initialCacheEntries(initialCacheEntries),
-            _allowVisitCaching(false)
+            _allowVisitCaching(false),
+            _maxPrefetchHits(0)
         { }
         const CompressionConfig & getCompression() const { return _compression; }
         size_t getMaxCacheBytes()   const { return _maxCacheBytes; }
         size_t getInitialCacheEntries() const { return _initialCacheEntries; }
         bool allowVisitCaching() const { return _allowVisitCaching; }
         Config & allowVisitCaching(bool allow) { _allowVisitCaching = allow; return *this; }
+        uint32_t getMaxPrefetchHits() const { return _maxPrefetchHits; }
+        Config & setMaxPrefetchHits(uint32_t v) { _maxPrefetchHits = v; return *this; }
         bool operator == (const Config &) const;
     private:
         CompressionConfig _compression;
         size_t _maxCacheBytes;
         size_t _initialCacheEntries;
         bool   _allowVisitCaching;
+        uint32_t _maxPrefetchHits;
     };
 
     /**
@@ -65,6 +70,8 @@ public:
 
     DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const override;
     void visit(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const override;
+    void prefetch(const LidVector & lids) const override;
+    uint32_t getMaxPrefetchHits() const override { return _config.getMaxPrefetchHits(); }
     void write(uint64_t synkToken, DocumentIdT lid, const document::Document& doc) override;
     void write(uint64_t synkToken, DocumentIdT lid, const vespalib::nbostream & os) override;
     void remove(uint64_t syncToken, DocumentIdT lid) override;
@@ -109,6 +116,7 @@ private:
 
     template <class> class WrapVisitor;
     class WrapVisitorProgress;
+    class BatchReadVisitor;
     Config                         _config;
     IDataStore &                   _backingStore;
     std::unique_ptr<BackingStore>  _store;
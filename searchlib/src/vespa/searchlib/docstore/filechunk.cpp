@@ -12,6 +12,8 @@
 #include <vespa/vespalib/util/blockingthreadstackexecutor.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/array.hpp>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <vespa/vespalib/encoding/base64.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/fastos/file.h>
 #include <future>
@@ -29,6 +31,7 @@ namespace {
 constexpr size_t ALIGNMENT=0x1000;
 constexpr size_t ENTRY_BIAS_SIZE=8;
 const vespalib::string DOC_ID_LIMIT_KEY("docIdLimit");
+const vespalib::string ZSTD_DICTIONARY_KEY("zstdDictionary");
 
 }
 
@@ -82,7 +85,8 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _idxHeaderLen(0u),
       _lastPersistedSerialNum(0),
       _docIdLimit(std::numeric_limits<uint32_t>::max()),
-      _modificationTime()
+      _modificationTime(),
+      _dictionary()
 {
     FastOS_File dataFile(_dataFileName.c_str());
     if (dataFile.OpenReadOnly()) {
@@ -250,6 +254,46 @@ FileChunk::updateLidMap(const LockGuard &guard, ISetLid &ds, uint64_t serialNum,
     return sz;
 }
 
+void
+FileChunk::saveLidMapState(vespalib::nbostream &os) const
+{
+    os << _idxHeaderLen << _docIdLimit << _lastPersistedSerialNum;
+    os << uint64_t(_addedBytes) << uint64_t(_erasedCount) << uint64_t(_erasedBytes);
+    os << uint64_t(_sumNumBuckets) << uint64_t(_numChunksWithBuckets) << uint64_t(_numUniqueBuckets);
+    os << uint32_t(_chunkInfo.size());
+    for (const ChunkInfo & chunkInfo : _chunkInfo) {
+        os << uint64_t(chunkInfo.getOffset()) << chunkInfo.getSize() << chunkInfo.getLastSerial();
+    }
+}
+
+void
+FileChunk::restoreLidMapState(vespalib::nbostream &is)
+{
+    assert(_chunkInfo.empty());
+    uint64_t addedBytes(0), erasedCount(0), erasedBytes(0);
+    uint64_t sumNumBuckets(0), numChunksWithBuckets(0), numUniqueBuckets(0);
+    uint32_t numChunks(0);
+    is >> _idxHeaderLen >> _docIdLimit >> _lastPersistedSerialNum;
+    is >> addedBytes >> erasedCount >> erasedBytes;
+    is >> sumNumBuckets >> numChunksWithBuckets >> numUniqueBuckets;
+    is >> numChunks;
+    _addedBytes = addedBytes;
+    _erasedCount = erasedCount;
+    _erasedBytes = erasedBytes;
+    _sumNumBuckets = sumNumBuckets;
+    _numChunksWithBuckets = numChunksWithBuckets;
+    _numUniqueBuckets = numUniqueBuckets;
+    _chunkInfo.reserve(numChunks);
+    for (uint32_t i(0); i < numChunks; i++) {
+        uint64_t offset(0), lastSerial(0);
+        uint32_t size(0);
+        is >> offset >> size >> lastSerial;
+        _chunkInfo.push_back(((offset != 0) || (size != 0) || (lastSerial != 0))
+                             ? ChunkInfo(offset, size, lastSerial)
+                             : ChunkInfo());
+    }
+}
+
 void
 FileChunk::enableRead()
 {
@@ -274,6 +318,20 @@ FileChunk::enableRead()
     if (_dataHeaderLen == 0u) {
         throw std::runtime_error(make_string("bad file header: %s", _dataFileName.c_str()));
     }
+    if ( ! _dictionary) {
+        readDictionary();
+    }
+}
+
+void
+FileChunk::readDictionary()
+{
+    vespalib::DataBuffer h(_dataHeaderLen, ALIGNMENT);
+    _file->read(0, h, _dataHeaderLen);
+    GenericHeader::BufferReader rd(h);
+    GenericHeader header;
+    header.read(rd);
+    _dictionary = readDictionary(header);
 }
 
 size_t FileChunk::adjustSize(size_t sz) {
@@ -349,7 +407,7 @@ FileChunk::appendTo(vespalib::ThreadExecutor & executor, const IGetLid & db, IWr
             const ChunkInfo & cInfo(_chunkInfo[chunkId]);
             vespalib::DataBuffer whole(0ul, ALIGNMENT);
             FileRandRead::FSP keepAlive(_file->read(cInfo.getOffset(), whole, cInfo.getSize()));
-            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen()));
+            promise.set_value(std::make_unique<Chunk>(chunkId, whole.getData(), whole.getDataLen(), false, _dictionary.get()));
         }));
 
         singleExecutor.execute(vespalib::makeLambdaTask([args = &fixedParams, chunk = std::move(futureChunk)]() mutable {
@@ -384,7 +442,7 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo c
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
         vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
@@ -409,10 +467,24 @@ FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
 {
     vespalib::DataBuffer whole(0ul, ALIGNMENT);
     FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead, _dictionary.get());
     return chunk.read(lid, buffer);
 }
 
+void
+FileChunk::prefetch(SubChunkId chunkId) const
+{
+    if (chunkId < _chunkInfo.size()) {
+        prefetch(_chunkInfo[chunkId]);
+    }
+}
+
+void
+FileChunk::prefetch(const ChunkInfo & chunkInfo) const
+{
+    _file->prefetch(chunkInfo.getOffset(), chunkInfo.getSize());
+}
+
 uint64_t
 FileChunk::readDataHeader(FileRandRead &datFile)
 {
@@ -471,6 +543,26 @@ FileChunk::writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit)
     header.putTag(vespalib::GenericHeader::Tag(DOC_ID_LIMIT_KEY, docIdLimit));
 }
 
+FileChunk::Dictionary
+FileChunk::readDictionary(const vespalib::GenericHeader &header)
+{
+    if ( ! header.hasTag(ZSTD_DICTIONARY_KEY)) {
+        return Dictionary();
+    }
+    const vespalib::string & encoded = header.getTag(ZSTD_DICTIONARY_KEY).asString();
+    std::string data = vespalib::Base64::decode(encoded.c_str(), encoded.size());
+    return std::make_shared<const vespalib::compression::ZStdDictionary>(std::vector<char>(data.begin(), data.end()));
+}
+
+void
+FileChunk::writeDictionary(vespalib::GenericHeader &header, const vespalib::compression::ZStdDictionary &dictionary)
+{
+    // Header string tags are zero terminated, so binary content must be encoded.
+    const std::vector<char> & data = dictionary.getData();
+    vespalib::string encoded(vespalib::Base64::encode(data.data(), data.size()));
+    header.putTag(vespalib::GenericHeader::Tag(ZSTD_DICTIONARY_KEY, encoded));
+}
+
 void
 FileChunk::verify(bool reportOnly) const
 {
@@ -485,7 +577,7 @@ FileChunk::verify(bool reportOnly) const
         vespalib::DataBuffer whole(0ul, ALIGNMENT);
         FileRandRead::FSP keepAlive(_file->read(ci.getOffset(), whole, ci.getSize()));
         try {
-            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen());
+            Chunk chunk(chunkId++, whole.getData(), whole.getDataLen(), false, _dictionary.get());
             assert(chunk.getLastSerial() >= lastSerial);
             lastSerial = chunk.getLastSerial();
             if (errorInPrev) {
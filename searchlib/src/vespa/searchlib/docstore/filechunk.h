@@ -15,8 +15,11 @@
 
 class FastOS_FileInterface;
 
+namespace vespalib::compression { class ZStdDictionary; }
+
 namespace vespalib {
     class DataBuffer;
+    class nbostream;
     class GenericHeader;
     class ThreadExecutor;
 }
@@ -105,13 +108,27 @@ public:
     typedef vespalib::hash_map<uint32_t, std::unique_ptr<vespalib::DataBuffer>> LidBufferMap;
     typedef std::unique_ptr<FileChunk> UP;
     typedef uint32_t SubChunkId;
+    using Dictionary = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     FileChunk(FileId fileId, NameId nameId, const vespalib::string &baseName, const TuneFileSummary &tune,
               const IBucketizer *bucketizer, bool skipCrcOnRead);
     virtual ~FileChunk();
 
     virtual size_t updateLidMap(const LockGuard &guard, ISetLid &lidMap, uint64_t serialNum, uint32_t docIdLimit);
+    /**
+     * Save the state updateLidMap() builds from the idx file, so a lid info snapshot
+     * can restore it later without reading the idx file. Only valid for frozen files.
+     */
+    void saveLidMapState(vespalib::nbostream &os) const;
+    /**
+     * Restore the state saved by saveLidMapState(). Used instead of updateLidMap().
+     */
+    void restoreLidMapState(vespalib::nbostream &is);
     virtual ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const;
     virtual void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const;
+    /**
+     * Hint that the given chunk will be read soon, so the file system can read it ahead.
+     */
+    virtual void prefetch(SubChunkId chunk) const;
     void remove(uint32_t lid, uint32_t size);
     virtual size_t getDiskFootprint() const { return _diskFootprint; }
     virtual size_t getMemoryFootprint() const;
@@ -158,6 +175,10 @@ public:
     size_t   getErasedBytes() const { return _erasedBytes; }
     uint64_t getLastPersistedSerialNum() const;
     uint32_t getDocIdLimit() const { return _docIdLimit; }
+    /**
+     * The zstd dictionary used by chunks in this file, or empty if none.
+     */
+    const Dictionary & getDictionary() const { return _dictionary; }
     virtual fastos::TimeStamp getModificationTime() const;
     virtual bool frozen() const { return true; }
     const vespalib::string & getName() const { return _name; }
@@ -234,8 +255,12 @@ protected:
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
     void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    void prefetch(const ChunkInfo & chunkInfo) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
+    static Dictionary readDictionary(const vespalib::GenericHeader &header);
+    static void writeDictionary(vespalib::GenericHeader &header, const vespalib::compression::ZStdDictionary &dictionary);
+    void readDictionary();
 
     typedef vespalib::Array<ChunkInfo> ChunkInfoVector;
     const IBucketizer * _bucketizer;
@@ -249,6 +274,7 @@ protected:
     uint64_t            _lastPersistedSerialNum;
     uint32_t            _docIdLimit; // Limit when the file was created. Stored in idx file header.
     fastos::TimeStamp   _modificationTime;
+    Dictionary          _dictionary; // Stored in dat file header.
 };
 
 } // namespace search
@@ -62,6 +62,12 @@ public:
     virtual ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const = 0;
     virtual void read(const LidVector & lids, IBufferVisitor & visitor) const = 0;
 
+    /**
+     * Hint that the given lids will be read soon. The data store may start reading
+     * their data into the page cache in the background. Does not wait for it.
+     */
+    virtual void prefetch(const LidVector & lids) const { (void) lids; }
+
     /**
      * Write data to the data store.
      * @param serialNum The official unique reference number for this operation.
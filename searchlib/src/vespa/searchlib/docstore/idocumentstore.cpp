@@ -15,4 +15,8 @@ void IDocumentStore::visit(const LidVector & lids, const document::DocumentTypeR
     }
 }
 
+void IDocumentStore::prefetch(const LidVector & lids) const {
+    (void) lids;
+}
+
 } // namespace search
@@ -87,6 +87,18 @@ public:
     virtual DocumentUP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const = 0;
     virtual void visit(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
 
+    /**
+     * Hint that the documents with the given lids will be read soon, e.g. the top hits of a
+     * query that will be filled. The store may start reading them into the page cache.
+     * Does not wait for the data.
+     **/
+    virtual void prefetch(const LidVector & lids) const;
+
+    /**
+     * The number of top hits of a query that should be passed to prefetch(). 0 disables it.
+     **/
+    virtual uint32_t getMaxPrefetchHits() const { return 0; }
+
     /**
      * Serialize and store a document.
      * @param doc The document to store
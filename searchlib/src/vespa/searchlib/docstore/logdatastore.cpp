@@ -6,9 +6,17 @@
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/searchlib/common/rcuvector.hpp>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/xxhash/xxhash.h>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -29,13 +37,26 @@ using docstore::StoreByBucket;
 using docstore::BucketCompacter;
 using namespace std::literals;
 
+namespace {
+
+const vespalib::string LID_INFO_SNAPSHOT_NAME("lidinfo.snapshot");
+const vespalib::string SERIAL_NUM_KEY("serialNum");
+const vespalib::string BODY_SIZE_KEY("bodySize");
+const vespalib::string CHECKSUM_KEY("checksum");
+
+}
+
 LogDataStore::Config::Config()
     : _maxFileSize(1000000000ul),
       _maxDiskBloatFactor(0.2),
       _maxBucketSpread(2.5),
       _minFileSizeFactor(0.2),
+      _maxDictionarySize(0),
       _skipCrcOnRead(false),
       _compact2ActiveFile(true),
+      _compactByReadFrequency(false),
+      _useLidInfoSnapshot(false),
+      _readThreads(0),
       _compactCompression(CompressionConfig::LZ4),
       _fileConfig()
 { }
@@ -46,7 +67,11 @@ LogDataStore::Config::operator == (const Config & rhs) const {
             (_maxDiskBloatFactor == rhs._maxDiskBloatFactor) &&
             (_maxFileSize == rhs._maxFileSize) &&
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
+            (_maxDictionarySize == rhs._maxDictionarySize) &&
             (_compact2ActiveFile == rhs._compact2ActiveFile) &&
+            (_compactByReadFrequency == rhs._compactByReadFrequency) &&
+            (_useLidInfoSnapshot == rhs._useLidInfoSnapshot) &&
+            (_readThreads == rhs._readThreads) &&
             (_skipCrcOnRead == rhs._skipCrcOnRead) &&
             (_compactCompression == rhs._compactCompression) &&
             (_fileConfig == rhs._fileConfig);
@@ -64,21 +89,31 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
       _lidInfo(growStrategy.getDocsInitialCapacity(),
                growStrategy.getDocsGrowPercent(),
                growStrategy.getDocsGrowDelta()),
+      _readCount(growStrategy.getDocsInitialCapacity(),
+                 growStrategy.getDocsGrowPercent(),
+                 growStrategy.getDocsGrowDelta()),
       _fileChunks(),
       _holdFileChunks(),
       _active(0),
       _prevActive(FileId::active()),
       _readOnly(readOnly),
       _executor(executor),
+      _readExecutor(),
       _initFlushSyncToken(0),
       _tlSyncer(tlSyncer),
       _bucketizer(bucketizer),
       _currentlyCompacting(),
-      _compactLidSpaceGeneration()
+      _compactLidSpaceGeneration(),
+      _dictionary()
 {
     // Reserve space for 1TB summary in order to avoid locking.
     _fileChunks.reserve(LidInfo::getFileIdLimit());
     _holdFileChunks.resize(LidInfo::getFileIdLimit());
+    if (config.getReadThreads() > 0) {
+        // Bounded, so that batched reads never queue up behind each other; rejected chunks are read inline.
+        _readExecutor = std::make_unique<vespalib::ThreadStackExecutor>(config.getReadThreads(), 128 * 1024,
+                                                                        config.getReadThreads());
+    }
 
     preload();
     updateLidMap(getLastFileChunkDocIdLimit());
@@ -108,6 +143,7 @@ LogDataStore::~LogDataStore()
     _executor.sync();
     _genHandler.updateFirstUsedGeneration();
     _lidInfo.removeOldGenerations(_genHandler.getFirstUsedGeneration());
+    _readCount.removeOldGenerations(_genHandler.getFirstUsedGeneration());
 }
 
 void
@@ -115,7 +151,11 @@ LogDataStore::updateLidMap(uint32_t lastFileChunkDocIdLimit)
 {
     uint64_t lastSerialNum(0);
     LockGuard guard(_updateLock);
-    for (size_t i = 0; i < _fileChunks.size(); ++i) {
+    size_t numRestored = loadLidInfoSnapshot(guard, lastFileChunkDocIdLimit);
+    if (numRestored > 0) {
+        lastSerialNum = _fileChunks[numRestored - 1]->getLastPersistedSerialNum();
+    }
+    for (size_t i = numRestored; i < _fileChunks.size(); ++i) {
         FileChunk::UP &chunk = _fileChunks[i];
         bool lastChunk = ((i + 1) == _fileChunks.size());
         uint32_t docIdLimit = lastChunk ? std::numeric_limits<uint32_t>::max() : lastFileChunkDocIdLimit;
@@ -124,6 +164,48 @@ LogDataStore::updateLidMap(uint32_t lastFileChunkDocIdLimit)
     }
 }
 
+namespace {
+
+/**
+ * Keeps a copy of the visited buffers, so chunks can be read in parallel
+ * and the buffers handed to the real visitor afterwards.
+ */
+class BufferedVisitor : public IBufferVisitor
+{
+public:
+    BufferedVisitor() : _entries(), _data(), _error() { }
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+        _entries.push_back(Entry{lid, _data.size(), buf.size()});
+        _data.insert(_data.end(), buf.c_str(), buf.c_str() + buf.size());
+    }
+    void replay(IBufferVisitor & visitor) const {
+        if (_error) {
+            std::rethrow_exception(_error);
+        }
+        for (const Entry & entry : _entries) {
+            visitor.visit(entry.lid, vespalib::ConstBufferRef(_data.data() + entry.offset, entry.size));
+        }
+    }
+    void setError(std::exception_ptr error) { _error = error; }
+private:
+    struct Entry {
+        uint32_t lid;
+        size_t   offset;
+        size_t   size;
+    };
+    std::vector<Entry> _entries;
+    std::vector<char>  _data;
+    std::exception_ptr _error;
+};
+
+bool
+sameChunk(const LidInfoWithLid & a, const LidInfoWithLid & b)
+{
+    return (a.getFileId() == b.getFileId()) && (a.getChunkId() == b.getChunkId());
+}
+
+}
+
 void
 LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
 {
@@ -134,25 +216,136 @@ LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
             LidInfo li = _lidInfo[lid];
             if (!li.empty() && li.valid()) {
                 orderedLids.emplace_back(li, lid);
+                countRead(lid);
             }
         }
     }
     if (orderedLids.empty()) { return; }
 
     std::sort(orderedLids.begin(), orderedLids.end());
-    uint32_t prevFile = orderedLids[0].getFileId();
-    uint32_t start = 0;
+    // Each chunk is read and decompressed once. All chunks but the last are read in parallel by
+    // the read executor when it has idle threads, while the calling thread reads the rest.
+    std::vector<size_t> chunkStarts;
+    chunkStarts.push_back(0);
     for (size_t curr(1); curr < orderedLids.size(); curr++) {
-        const LidInfoWithLid & li = orderedLids[curr];
-        if (prevFile != li.getFileId()) {
-            const FileChunk & fc(*_fileChunks[prevFile]);
-            fc.read(orderedLids.begin() + start, curr - start, visitor);
-            start = curr;
-            prevFile = li.getFileId();
+        if ( ! sameChunk(orderedLids[curr - 1], orderedLids[curr])) {
+            chunkStarts.push_back(curr);
+        }
+    }
+    chunkStarts.push_back(orderedLids.size());
+    const size_t numChunks = chunkStarts.size() - 1;
+    auto readChunk = [this, &orderedLids, &chunkStarts](size_t chunk, IBufferVisitor & chunkVisitor) {
+        const size_t start = chunkStarts[chunk];
+        const FileChunk & fc(*_fileChunks[orderedLids[start].getFileId()]);
+        fc.read(orderedLids.begin() + start, chunkStarts[chunk + 1] - start, chunkVisitor);
+    };
+    if ( ! _readExecutor || (numChunks == 1)) {
+        for (size_t chunk(0); chunk < numChunks; chunk++) {
+            readChunk(chunk, visitor);
+        }
+        return;
+    }
+    std::vector<BufferedVisitor> buffered(numChunks - 1);
+    vespalib::CountDownLatch latch(numChunks - 1);
+    for (size_t chunk(0); chunk + 1 < numChunks; chunk++) {
+        vespalib::Executor::Task::UP rejected = _readExecutor->execute(vespalib::makeLambdaTask([&, chunk]() {
+            try {
+                readChunk(chunk, buffered[chunk]);
+            } catch (...) {
+                buffered[chunk].setError(std::current_exception());
+            }
+            latch.countDown();
+        }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    try {
+        readChunk(numChunks - 1, visitor);
+    } catch (...) {
+        latch.await();
+        throw;
+    }
+    latch.await();
+    for (const BufferedVisitor & chunkVisitor : buffered) {
+        chunkVisitor.replay(visitor);
+    }
+}
+
+namespace {
+
+uint64_t
+nextRandom()
+{
+    static thread_local uint64_t state = 0x9e3779b97f4a7c15ul ^ reinterpret_cast<uintptr_t>(&state);
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+constexpr uint8_t MAX_READ_COUNT = 32;
+
+}
+
+void
+LogDataStore::countRead(uint32_t lid) const
+{
+    // Approximate counting: the counter c is incremented with probability 2^-c, so it
+    // estimates log2 of the number of reads with a single byte and few writes.
+    // Concurrent increments may be lost, which only makes the estimate less exact.
+    if ( ! _config.compactByReadFrequency() || (lid >= _readCount.size())) {
+        return;
+    }
+    uint8_t & count = _readCount[lid];
+    if ((count < MAX_READ_COUNT) && ((nextRandom() & ((uint64_t(1) << count) - 1)) == 0)) {
+        count++;
+    }
+}
+
+uint32_t
+LogDataStore::getReadFrequencyClass(const Guard & guard, uint32_t lid) const
+{
+    (void) guard;
+    if (lid >= _readCount.size()) {
+        return 0;
+    }
+    // The classes are roughly: never read, read up to 10, up to 200, and more times.
+    uint8_t count = _readCount[lid];
+    return (count == 0) ? 0 : (count <= 3) ? 1 : (count <= 7) ? 2 : 3;
+}
+
+void
+LogDataStore::decayReadCounts()
+{
+    // Halves the estimated read count, so documents that are no longer read cool down.
+    LockGuard guard(_updateLock);
+    for (size_t lid(0); lid < _readCount.size(); lid++) {
+        if (_readCount[lid] > 0) {
+            _readCount[lid]--;
+        }
+    }
+}
+
+void
+LogDataStore::prefetch(const LidVector & lids) const
+{
+    LidInfoWithLidV orderedLids;
+    GenerationHandler::Guard guard(_genHandler.takeGuard());
+    for (uint32_t lid : lids) {
+        if (lid < getDocIdLimit()) {
+            LidInfo li = _lidInfo[lid];
+            if (!li.empty() && li.valid()) {
+                orderedLids.emplace_back(li, lid);
+            }
+        }
+    }
+    std::sort(orderedLids.begin(), orderedLids.end());
+    for (size_t i(0); i < orderedLids.size(); i++) {
+        if ((i == 0) || ! sameChunk(orderedLids[i - 1], orderedLids[i])) {
+            _fileChunks[orderedLids[i].getFileId()]->prefetch(orderedLids[i].getChunkId());
         }
     }
-    const FileChunk & fc(*_fileChunks[prevFile]);
-    fc.read(orderedLids.begin() + start, orderedLids.size() - start, visitor);
 }
 
 ssize_t
@@ -164,6 +357,7 @@ LogDataStore::read(uint32_t lid, vespalib::DataBuffer& buffer) const
         {
             GenerationHandler::Guard guard(_genHandler.takeGuard());
             li = _lidInfo[lid];
+            countRead(lid);
         }
         if (!li.empty() && li.valid()) {
             const FileChunk & fc(*_fileChunks[li.getFileId()]);
@@ -339,9 +533,219 @@ LogDataStore::flush(uint64_t syncToken)
     }
     active->flushPendingChunks(syncToken);
     activeHolder.reset();
+    if (_config.useLidInfoSnapshot()) {
+        writeLidInfoSnapshot(syncToken);
+    }
     LOG(info, "Flushing. %s",bloatMsg(getDiskBloat(), getDiskFootprint()).c_str());
 }
 
+vespalib::string
+LogDataStore::createLidInfoSnapshotFileName() const
+{
+    return getBaseDir() + "/" + LID_INFO_SNAPSHOT_NAME;
+}
+
+namespace {
+
+bool
+getFileSizes(const vespalib::string & name, uint64_t & idxSize, uint64_t & datSize)
+{
+    FastOS_StatInfo idxStat;
+    FastOS_StatInfo datStat;
+    if ( ! FastOS_File::Stat(FileChunk::createIdxFileName(name).c_str(), &idxStat) ||
+         ! FastOS_File::Stat(FileChunk::createDatFileName(name).c_str(), &datStat))
+    {
+        return false;
+    }
+    idxSize = idxStat._size;
+    datSize = datStat._size;
+    return true;
+}
+
+}
+
+/*
+ * The snapshot covers all frozen files. They are listed in name order, which is also the
+ * order they get file ids in at startup, so the file ids in the lid map are rewritten to
+ * that order. Lids that live in the active file are stored as invalid, and are set again
+ * when the active file is read at startup.
+ */
+void
+LogDataStore::writeLidInfoSnapshot(SerialNum syncToken)
+{
+    vespalib::nbostream os;
+    {
+        LockGuard guard(_updateLock);
+        if ( ! _currentlyCompacting.empty()) {
+            LOG(debug, "Skipping lid info snapshot for '%s' while compacting", getBaseDir().c_str());
+            return;
+        }
+        std::vector<const FileChunk *> files;
+        for (const FileChunk::UP & fc : _fileChunks) {
+            if (fc && (fc->getFileId() != getActiveFileId(guard))) {
+                if ( ! fc->frozen()) {
+                    LOG(debug, "Skipping lid info snapshot for '%s' since '%s' is not frozen",
+                        getBaseDir().c_str(), fc->getName().c_str());
+                    return;
+                }
+                files.push_back(fc.get());
+            }
+        }
+        std::sort(files.begin(), files.end(), [](const FileChunk * a, const FileChunk * b) {
+            return a->getNameId() < b->getNameId();
+        });
+        std::vector<uint32_t> snapshotFileId(_fileChunks.size(), LidInfo::getFileIdLimit());
+        os << uint32_t(files.size());
+        for (size_t i(0); i < files.size(); i++) {
+            uint64_t idxSize(0), datSize(0);
+            if ( ! getFileSizes(files[i]->getName(), idxSize, datSize)) {
+                LOG(warning, "Failed to stat '%s'. Skipping lid info snapshot", files[i]->getName().c_str());
+                return;
+            }
+            os << files[i]->getNameId().getId() << idxSize << datSize;
+            snapshotFileId[files[i]->getFileId().getId()] = i;
+        }
+        for (const FileChunk * fc : files) {
+            fc->saveLidMapState(os);
+        }
+        // Note: Feed latency spike
+        uint32_t docIdLimit = getDocIdLimit();
+        os << docIdLimit;
+        for (uint32_t lid(0); lid < docIdLimit; lid++) {
+            LidInfo lidInfo(_lidInfo[lid]);
+            if (lidInfo.valid() && (snapshotFileId[lidInfo.getFileId()] < LidInfo::getFileIdLimit())) {
+                os << uint64_t(LidInfo(snapshotFileId[lidInfo.getFileId()], lidInfo.getChunkId(), lidInfo.size()));
+            } else {
+                os << uint64_t(LidInfo());
+            }
+        }
+    }
+    typedef vespalib::FileHeader::Tag Tag;
+    vespalib::string name(createLidInfoSnapshotFileName());
+    vespalib::string tmpName(name + ".tmp");
+    vespalib::FileHeader h;
+    FastOS_File file(tmpName.c_str());
+    if ( ! file.OpenWriteOnlyTruncate()) {
+        LOG(warning, "Failed opening '%s' for writing lid info snapshot: %s",
+            tmpName.c_str(), getLastErrorString().c_str());
+        return;
+    }
+    _fileHeaderContext.addTags(h, file.GetFileName());
+    h.putTag(Tag("desc", "Log data store lid info snapshot"));
+    h.putTag(Tag(SERIAL_NUM_KEY, syncToken));
+    h.putTag(Tag(BODY_SIZE_KEY, os.size()));
+    h.putTag(Tag(CHECKSUM_KEY, uint64_t(XXH64(os.peek(), os.size(), 0))));
+    h.writeFile(file);
+    file.WriteBuf(os.peek(), os.size());
+    if ( ! file.Sync() || ! file.Close()) {
+        LOG(warning, "Failed writing lid info snapshot '%s': %s", tmpName.c_str(), getLastErrorString().c_str());
+        FastOS_File::Delete(tmpName.c_str());
+        return;
+    }
+    try {
+        vespalib::rename(tmpName, name, false, false);
+    } catch (const vespalib::IoException & e) {
+        LOG(warning, "Failed renaming lid info snapshot '%s': %s", tmpName.c_str(), e.what());
+        FastOS_File::Delete(tmpName.c_str());
+        return;
+    }
+    LOG(debug, "Wrote lid info snapshot '%s' at serial %ld", name.c_str(), syncToken);
+}
+
+/*
+ * Restore the lid map and the state of the files covered by the snapshot. The covered files
+ * must be the oldest files, with the same sizes as when the snapshot was written, and the
+ * active file can not be covered. Returns the number of files restored. 0 means that the
+ * snapshot was not usable, and that all files must be read.
+ */
+size_t
+LogDataStore::loadLidInfoSnapshot(const LockGuard & guard, uint32_t lastFileChunkDocIdLimit)
+{
+    vespalib::string name(createLidInfoSnapshotFileName());
+    FastOS_File file(name.c_str());
+    file.enableMemoryMap(0);
+    if ( ! _config.useLidInfoSnapshot() || ! file.OpenReadOnly()) {
+        return 0;
+    }
+    if ( ! file.IsMemoryMapped()) {
+        LOG(warning, "Lid info snapshot '%s' could not be memory mapped. Ignoring it", name.c_str());
+        return 0;
+    }
+    const char * body(nullptr);
+    uint64_t bodySize(0);
+    uint64_t serialNum(0);
+    try {
+        vespalib::FileHeader h;
+        uint64_t headerLen = h.readFile(file);
+        bodySize = h.getTag(BODY_SIZE_KEY).asInteger();
+        serialNum = h.getTag(SERIAL_NUM_KEY).asInteger();
+        if (headerLen + bodySize != uint64_t(file.GetSize())) {
+            LOG(warning, "Lid info snapshot '%s' has size %ld, expected %ld. Ignoring it",
+                name.c_str(), file.GetSize(), headerLen + bodySize);
+            return 0;
+        }
+        body = static_cast<const char *>(file.MemoryMapPtr(headerLen));
+        if (uint64_t(h.getTag(CHECKSUM_KEY).asInteger()) != uint64_t(XXH64(body, bodySize, 0))) {
+            LOG(warning, "Lid info snapshot '%s' has wrong checksum. Ignoring it", name.c_str());
+            return 0;
+        }
+    } catch (const vespalib::Exception & e) {
+        LOG(warning, "Failed reading header of lid info snapshot '%s': %s. Ignoring it", name.c_str(), e.what());
+        return 0;
+    }
+    vespalib::nbostream is(body, bodySize);
+    uint32_t numFiles(0);
+    is >> numFiles;
+    if ((numFiles == 0) || (numFiles >= _fileChunks.size())) {
+        LOG(info, "Lid info snapshot '%s' covers %u files, but only %zu are frozen. Ignoring it",
+            name.c_str(), numFiles, _fileChunks.size() - 1);
+        return 0;
+    }
+    for (uint32_t i(0); i < numFiles; i++) {
+        uint64_t nameId(0), idxSize(0), datSize(0);
+        uint64_t currIdxSize(0), currDatSize(0);
+        is >> nameId >> idxSize >> datSize;
+        const FileChunk & fc(*_fileChunks[i]);
+        if ((fc.getNameId() != NameId(nameId)) ||
+            ! getFileSizes(fc.getName(), currIdxSize, currDatSize) ||
+            (idxSize != currIdxSize) || (datSize != currDatSize))
+        {
+            LOG(info, "Lid info snapshot '%s' does not match file '%s'. Ignoring it", name.c_str(), fc.getName().c_str());
+            return 0;
+        }
+    }
+    for (uint32_t i(0); i < numFiles; i++) {
+        _fileChunks[i]->restoreLidMapState(is);
+    }
+    uint32_t docIdLimit(0);
+    is >> docIdLimit;
+    if (docIdLimit > _lidInfo.size()) {
+        _lidInfo.ensure_size(docIdLimit, LidInfo());
+        _readCount.ensure_size(docIdLimit, 0);
+        incGeneration();
+    }
+    uint32_t restoredDocIdLimit(0);
+    for (uint32_t lid(0); lid < docIdLimit; lid++) {
+        uint64_t rep(0);
+        is >> rep;
+        LidInfo lidInfo(rep);
+        if ( ! lidInfo.valid()) {
+            continue;
+        }
+        if (lid < lastFileChunkDocIdLimit) {
+            _lidInfo[lid] = lidInfo;
+            restoredDocIdLimit = lid + 1;
+        } else {
+            _fileChunks[lidInfo.getFileId()]->remove(lid, lidInfo.size());
+        }
+    }
+    updateDocIdLimit(restoredDocIdLimit);
+    (void) guard;
+    LOG(info, "Restored %u of %zu files in '%s' from lid info snapshot at serial %ld",
+        numFiles, _fileChunks.size(), getBaseDir().c_str(), serialNum);
+    return numFiles;
+}
+
 
 uint64_t
 LogDataStore::initFlush(uint64_t syncToken)
@@ -466,6 +870,9 @@ void LogDataStore::compactFile(FileId fileId)
     NameId compactedNameId = fc->getNameId();
     LOG(info, "Compacting file '%s' which has bloat '%2.2f' and bucket-spread '%1.4f",
               fc->getName().c_str(), 100*fc->getDiskBloat()/double(fc->getDiskFootprint()), fc->getBucketSpread());
+    if (useDictionary()) {
+        trainDictionary(*fc);
+    }
     IWriteData::UP compacter;
     FileId destinationFileId = FileId::active();
     if (_bucketizer) {
@@ -476,7 +883,8 @@ void LogDataStore::compactFile(FileId fileId)
         }
         size_t numSignificantBucketBits = computeNumberOfSignificantBucketIdBits(*_bucketizer, fc->getFileId());
         compacter.reset(new BucketCompacter(numSignificantBucketBits, _config.compactCompression(), *this, _executor,
-                                            *_bucketizer, fc->getFileId(), destinationFileId));
+                                            *_bucketizer, fc->getFileId(), destinationFileId,
+                                            _config.compactByReadFrequency()));
     } else {
         compacter.reset(new docstore::Compacter(*this));
     }
@@ -519,10 +927,45 @@ void LogDataStore::compactFile(FileId fileId)
         std::this_thread::sleep_for(1s);;
     }
     toDie->erase();
+    if (_config.compactByReadFrequency() && _bucketizer) {
+        decayReadCounts();
+    }
     LockGuard guard(_updateLock);
     _currentlyCompacting.erase(compactedNameId);
 }
 
+bool
+LogDataStore::useDictionary() const
+{
+    return (_config.getMaxDictionarySize() > 0) &&
+           (_config.getFileConfig().getCompression().type == CompressionConfig::ZSTD);
+}
+
+void
+LogDataStore::trainDictionary(FileChunk & fc)
+{
+    const size_t maxDictionarySize = _config.getMaxDictionarySize();
+    // zstd recommends about 100 times the dictionary size of samples.
+    const size_t sampleBytes = maxDictionarySize * 100;
+    // Read twice what is needed if chunks were full of live documents.
+    const size_t maxChunkBytes = std::max(_config.getFileConfig().getMaxChunkBytes(), size_t(1));
+    const uint32_t numChunks = std::min(size_t(fc.getNumChunks()), 2 * ((sampleBytes + maxChunkBytes - 1) / maxChunkBytes));
+    docstore::DictionarySampler sampler(sampleBytes);
+    fc.appendTo(_executor, *this, sampler, numChunks, nullptr);
+    std::vector<char> data = sampler.train(maxDictionarySize);
+    if (data.empty()) {
+        LOG(info, "Keeping current zstd dictionary, too few documents (%zu) in file '%s' to train a new one",
+                  sampler.getNumSamples(), fc.getName().c_str());
+        return;
+    }
+    auto dictionary = std::make_shared<const vespalib::compression::ZStdDictionary>(std::move(data));
+    LOG(info, "Trained zstd dictionary %0x of %zu bytes from %zu documents (%zu bytes) in file '%s'",
+              dictionary->getId(), dictionary->size(), sampler.getNumSamples(), sampler.getSampledBytes(),
+              fc.getName().c_str());
+    LockGuard guard(_updateLock);
+    _dictionary = std::move(dictionary);
+}
+
 size_t
 LogDataStore::memoryUsed() const
 {
@@ -542,7 +985,7 @@ size_t
 LogDataStore::memoryMeta() const
 {
     LockGuard guard(_updateLock);
-    size_t sz(_lidInfo.getMemoryUsage().allocatedBytes());
+    size_t sz(_lidInfo.getMemoryUsage().allocatedBytes() + _readCount.getMemoryUsage().allocatedBytes());
     for (const FileChunk::UP & fc : _fileChunks) {
         if (fc) {
             sz += fc->getMemoryMetaFootprint();
@@ -649,7 +1092,8 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
     FileChunk::UP file(new WriteableFileChunk(_executor, fileId, nameId, getBaseDir(),
                                               serialNum, docIdLimit,
                                               _config.getFileConfig(), _tune, _fileHeaderContext,
-                                              _bucketizer.get(), _config.crcOnReadDisabled()));
+                                              _bucketizer.get(), _config.crcOnReadDisabled(),
+                                              useDictionary() ? _dictionary : FileChunk::Dictionary()));
     file->enableRead();
     return file;
 }
@@ -796,6 +1240,7 @@ LogDataStore::preload()
     }
     _active = FileId(_fileChunks.size() - 1);
     _prevActive = _active.prev();
+    _dictionary = _fileChunks[_active.getId()]->getDictionary();
 }
 
 uint32_t
@@ -946,12 +1391,14 @@ LogDataStore::setLid(const LockGuard &guard, uint32_t lid, const LidInfo &meta)
     if (lid < _lidInfo.size()) {
         _genHandler.updateFirstUsedGeneration();
         _lidInfo.removeOldGenerations(_genHandler.getFirstUsedGeneration());
+        _readCount.removeOldGenerations(_genHandler.getFirstUsedGeneration());
         const LidInfo &prev = _lidInfo[lid];
         if (prev.valid()) {
             _fileChunks[prev.getFileId()]->remove(lid, prev.size());
         }
     } else {
         _lidInfo.ensure_size(lid+1, LidInfo());
+        _readCount.ensure_size(lid+1, 0);
         incGeneration();
     }
     updateDocIdLimit(lid + 1);
@@ -962,9 +1409,11 @@ void
 LogDataStore::incGeneration()
 {
     _lidInfo.setGeneration(_genHandler.getNextGeneration());
+    _readCount.setGeneration(_genHandler.getNextGeneration());
     _genHandler.incGeneration();
     _genHandler.updateFirstUsedGeneration();
     _lidInfo.removeOldGenerations(_genHandler.getFirstUsedGeneration());
+    _readCount.removeOldGenerations(_genHandler.getFirstUsedGeneration());
 }
 
 size_t
@@ -1165,6 +1614,7 @@ LogDataStore::getMemoryUsage() const
     LockGuard guard(_updateLock);
     MemoryUsage result;
     result.merge(_lidInfo.getMemoryUsage());
+    result.merge(_readCount.getMemoryUsage());
     for (const auto &fileChunk : _fileChunks) {
         if (fileChunk) {
             result.merge(fileChunk->getMemoryUsage());
@@ -1196,6 +1646,7 @@ LogDataStore::compactLidSpace(uint32_t wantedDocLidLimit)
     assert(wantedDocLidLimit <= getDocIdLimit());
     for (size_t i = wantedDocLidLimit; i < _lidInfo.size(); ++i) {
         _lidInfo[i] = LidInfo();
+        _readCount[i] = 0;
     }
     setDocIdLimit(wantedDocLidLimit);
     _compactLidSpaceGeneration = _genHandler.getCurrentGeneration();
@@ -1223,7 +1674,7 @@ LogDataStore::getEstimatedShrinkLidSpaceGain() const
     if (!canShrinkLidSpace(guard)) {
         return 0;
     }
-    return (_lidInfo.size() - getDocIdLimit()) * sizeof(uint64_t);
+    return (_lidInfo.size() - getDocIdLimit()) * (sizeof(uint64_t) + sizeof(uint8_t));
 }
 
 void
@@ -1234,6 +1685,7 @@ LogDataStore::shrinkLidSpace()
         return;
     }
     _lidInfo.shrink(getDocIdLimit());
+    _readCount.shrink(getDocIdLimit());
     incGeneration();
 }
 
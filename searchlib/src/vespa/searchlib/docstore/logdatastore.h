@@ -42,18 +42,46 @@ public:
         Config & setMaxDiskBloatFactor(double v) { _maxDiskBloatFactor = v; return *this; }
         Config & setMaxBucketSpread(double v) { _maxBucketSpread = v; return *this; }
         Config & setMinFileSizeFactor(double v) { _minFileSizeFactor = v; return *this; }
+        /**
+         * Max size of the zstd dictionary trained from live documents when compacting a file.
+         * New files compress their chunks with the dictionary when chunk compression is zstd.
+         * 0 disables dictionary compression.
+         */
+        Config & setMaxDictionarySize(size_t v) { _maxDictionarySize = v; return *this; }
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
+        /**
+         * Count reads per lid, and let compaction place the most read documents first, so they
+         * share chunks and stay in the page cache. Bucket order is kept within each read
+         * frequency class. Only used when compacting with a bucketizer.
+         */
+        Config & compactByReadFrequency(bool v) { _compactByReadFrequency = v; return *this; }
+        /**
+         * Write a snapshot of the lid map and the state of all frozen files at flush, and use it
+         * at startup instead of reading the idx files of the files it covers.
+         */
+        Config & useLidInfoSnapshot(bool v) { _useLidInfoSnapshot = v; return *this; }
+        /**
+         * Number of threads dedicated to reading chunks in parallel when reading many lids in
+         * one batch. A chunk that would have to wait for a busy read thread is read by the
+         * calling thread instead. 0 reads all chunks in the calling thread. Only used when the
+         * store is constructed.
+         */
+        Config & setReadThreads(uint32_t v) { _readThreads = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
 
         size_t getMaxFileSize() const { return _maxFileSize; }
         double getMaxDiskBloatFactor() const { return _maxDiskBloatFactor; }
         double getMaxBucketSpread() const { return _maxBucketSpread; }
         double getMinFileSizeFactor() const { return _minFileSizeFactor; }
+        size_t getMaxDictionarySize() const { return _maxDictionarySize; }
 
         bool crcOnReadDisabled() const { return _skipCrcOnRead; }
         bool compact2ActiveFile() const { return _compact2ActiveFile; }
         const CompressionConfig & compactCompression() const { return _compactCompression; }
+        bool compactByReadFrequency() const { return _compactByReadFrequency; }
+        bool useLidInfoSnapshot() const { return _useLidInfoSnapshot; }
+        uint32_t getReadThreads() const { return _readThreads; }
 
         const WriteableFileChunk::Config & getFileConfig() const { return _fileConfig; }
         Config & disableCrcOnRead(bool v) { _skipCrcOnRead = v; return *this;}
@@ -65,8 +93,12 @@ public:
         double                      _maxDiskBloatFactor;
         double                      _maxBucketSpread;
         double                      _minFileSizeFactor;
+        size_t                      _maxDictionarySize;
         bool                        _skipCrcOnRead;
         bool                        _compact2ActiveFile;
+        bool                        _compactByReadFrequency;
+        bool                        _useLidInfoSnapshot;
+        uint32_t                    _readThreads;
         CompressionConfig           _compactCompression;
         WriteableFileChunk::Config  _fileConfig;
     };
@@ -96,6 +128,7 @@ public:
     // Implements IDataStore API
     ssize_t read(uint32_t lid, vespalib::DataBuffer & buffer) const override;
     void read(const LidVector & lids, IBufferVisitor & visitor) const override;
+    void prefetch(const LidVector & lids) const override;
     void write(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len) override;
     void remove(uint64_t serialNum, uint32_t lid) override;
     void flush(uint64_t syncToken) override;
@@ -159,6 +192,14 @@ public:
             return LidInfo();
         }
     }
+    static constexpr uint32_t NUM_READ_FREQUENCY_CLASSES = 4;
+
+    /**
+     * Return how often the given lid has been read, as a class in the
+     * range [0, NUM_READ_FREQUENCY_CLASSES). 0 means (almost) never read.
+     */
+    uint32_t getReadFrequencyClass(const Guard & guard, uint32_t lid) const;
+
     FileId getActiveFileId(const vespalib::LockGuard & guard) const {
         assert(guard.locks(_updateLock));
         (void) guard;
@@ -188,11 +229,19 @@ private:
 
     void compactWorst(double bloatLimit, double spreadLimit);
     void compactFile(FileId chunkId);
+    bool useDictionary() const;
+    void trainDictionary(FileChunk & fc);
 
     typedef attribute::RcuVector<uint64_t> LidInfoVector;
+    typedef attribute::RcuVector<uint8_t> ReadCountVector;
     typedef std::vector<FileChunk::UP> FileChunkVector;
 
+    void countRead(uint32_t lid) const;
+    void decayReadCounts();
     void updateLidMap(uint32_t lastFileChunkDocIdLimit);
+    size_t loadLidInfoSnapshot(const LockGuard & guard, uint32_t lastFileChunkDocIdLimit);
+    void writeLidInfoSnapshot(SerialNum syncToken);
+    vespalib::string createLidInfoSnapshotFileName() const;
     void preload();
     uint32_t getLastFileChunkDocIdLimit();
     void verifyModificationTime(const NameIdSet & partList);
@@ -275,6 +324,7 @@ private:
     const search::common::FileHeaderContext &_fileHeaderContext;
     mutable vespalib::GenerationHandler      _genHandler;
     LidInfoVector                            _lidInfo;
+    mutable ReadCountVector                  _readCount; // Approximate log2 of reads per lid
     FileChunkVector                          _fileChunks;
     std::vector<uint32_t>                    _holdFileChunks;
     FileId                                   _active;
@@ -282,11 +332,13 @@ private:
     vespalib::Lock                           _updateLock;
     bool                                     _readOnly;
     vespalib::ThreadExecutor                &_executor;
+    std::unique_ptr<vespalib::ThreadExecutor> _readExecutor;
     SerialNum                                _initFlushSyncToken;
     transactionlog::SyncProxy               &_tlSyncer;
     IBucketizer::SP                          _bucketizer;
     NameIdSet                                _currentlyCompacting;
     uint64_t                                 _compactLidSpaceGeneration;
+    FileChunk::Dictionary                    _dictionary; // Used by new files
 };
 
 } // namespace search
@@ -18,6 +18,10 @@ public:
     typedef std::shared_ptr<FastOS_FileInterface> FSP;
     virtual ~FileRandRead() { }
     virtual FSP read(size_t offset, vespalib::DataBuffer & buffer, size_t sz) = 0;
+    /**
+     * Hint that the given range will be read soon. Does not wait for it.
+     */
+    virtual void prefetch(size_t offset, size_t sz) = 0;
     virtual int64_t getSize() = 0;
 };
 
@@ -47,6 +47,13 @@ DirectIORandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
     return FSP();
 }
 
+void
+DirectIORandRead::prefetch(size_t offset, size_t sz)
+{
+    // Direct IO bypasses the page cache, so there is nothing to read ahead into.
+    (void) offset;
+    (void) sz;
+}
 
 int64_t
 DirectIORandRead::getSize()
@@ -84,6 +91,12 @@ MMapRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
     return FSP();
 }
 
+void
+MMapRandRead::prefetch(size_t offset, size_t sz)
+{
+    _file->prefetch(offset, sz);
+}
+
 int64_t
 MMapRandRead::getSize() {
     return _file->GetSize();
@@ -140,6 +153,13 @@ MMapRandReadDynamic::read(size_t offset, vespalib::DataBuffer & buffer, size_t s
     return file;
 }
 
+void
+MMapRandReadDynamic::prefetch(size_t offset, size_t sz)
+{
+    FSP file(_holder.get());
+    file->prefetch(offset, sz);
+}
+
 bool
 MMapRandReadDynamic::contains(const FastOS_FileInterface & file, size_t sz) {
     return (sz == 0) || (file.MemoryMapPtr(sz - 1) != nullptr);
@@ -161,6 +181,12 @@ NormalRandRead::read(size_t offset, vespalib::DataBuffer & buffer, size_t sz)
     return FSP();
 }
 
+void
+NormalRandRead::prefetch(size_t offset, size_t sz)
+{
+    _file->prefetch(offset, sz);
+}
+
 int64_t
 NormalRandRead::getSize()
 {
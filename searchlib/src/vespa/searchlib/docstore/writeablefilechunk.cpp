@@ -86,7 +86,8 @@ WriteableFileChunk(vespalib::ThreadExecutor &executor,
                    const TuneFileSummary &tune,
                    const FileHeaderContext &fileHeaderContext,
                    const IBucketizer * bucketizer,
-                   bool skipCrcOnRead)
+                   bool skipCrcOnRead,
+                   const Dictionary & dictionary)
     : FileChunk(fileId, nameId, baseName, tune, bucketizer, skipCrcOnRead),
       _config(config),
       _serialNum(initialSerialNum),
@@ -102,7 +103,7 @@ WriteableFileChunk(vespalib::ThreadExecutor &executor,
       _idxFileSize(0),
       _currentDiskFootprint(0),
       _nextChunkId(1),
-      _active(new Chunk(0, Chunk::Config(config.getMaxChunkBytes()))),
+      _active(),
       _alignment(1),
       _granularity(1),
       _maxChunkSize(0x100000),
@@ -121,6 +122,8 @@ WriteableFileChunk(vespalib::ThreadExecutor &executor,
     if (_dataFile.OpenReadWrite()) {
         readDataHeader();
         if (_dataHeaderLen == 0) {
+            // A new file uses the given dictionary, an existing one keeps the dictionary in its header.
+            _dictionary = dictionary;
             writeDataHeader(fileHeaderContext);
         }
         _dataFile.SetPosition(_dataFile.GetSize());
@@ -140,6 +143,7 @@ WriteableFileChunk(vespalib::ThreadExecutor &executor,
     } else {
         throw SummaryException("Failed opening data file", _dataFile, VESPA_STRLOC);
     }
+    _active.reset(new Chunk(0, getChunkConfig()));
     _firstChunkIdToBeWritten = _active->getId();
     updateCurrentDiskFootprint();
 }
@@ -177,7 +181,7 @@ WriteableFileChunk::updateLidMap(const LockGuard &guard, ISetLid &ds, uint64_t s
 {
     size_t sz = FileChunk::updateLidMap(guard, ds, serialNum, docIdLimit);
     _nextChunkId = _chunkInfo.size();
-    _active.reset( new Chunk(_nextChunkId++, Chunk::Config(_config.getMaxChunkBytes())));
+    _active.reset( new Chunk(_nextChunkId++, getChunkConfig()));
     _serialNum = getLastPersistedSerialNum();
     _firstChunkIdToBeWritten = _active->getId();
     setDiskFootprint(0);
@@ -265,6 +269,24 @@ WriteableFileChunk::read(uint32_t lid, SubChunkId chunkId, vespalib::DataBuffer
     return FileChunk::read(lid, chunkId, chunkInfo, buffer);
 }
 
+void
+WriteableFileChunk::prefetch(SubChunkId chunkId) const
+{
+    if (frozen()) {
+        FileChunk::prefetch(chunkId);
+        return;
+    }
+    ChunkInfo chunkInfo;
+    {
+        LockGuard guard(_lock);
+        if ((chunkId >= _chunkInfo.size()) || !_chunkInfo[chunkId].valid()) {
+            return; // Still in memory
+        }
+        chunkInfo = _chunkInfo[chunkId];
+    }
+    FileChunk::prefetch(chunkInfo);
+}
+
 void
 WriteableFileChunk::internalFlush(uint32_t chunkId, uint64_t serialNum)
 {
@@ -639,7 +661,7 @@ int32_t WriteableFileChunk::flushLastIfNonEmpty(bool force)
         chunkId = _active->getId();
         _chunkMap[chunkId] = std::move(_active);
         assert(_nextChunkId < LidInfo::getChunkIdLimit());
-        _active.reset(new Chunk(_nextChunkId++, Chunk::Config(_config.getMaxChunkBytes())));
+        _active.reset(new Chunk(_nextChunkId++, getChunkConfig()));
     }
     return chunkId;
 }
@@ -727,6 +749,7 @@ WriteableFileChunk::readDataHeader()
         FileHeader h;
         _dataHeaderLen = h.readFile(_dataFile);
         _dataFile.SetPosition(_dataHeaderLen);
+        _dictionary = readDictionary(h);
     } catch (IllegalHeaderException &e) {
         _dataFile.SetPosition(0);
         try {
@@ -793,6 +816,9 @@ WriteableFileChunk::writeDataHeader(const FileHeaderContext &fileHeaderContext)
     assert(_dataFile.GetPosition() == 0);
     fileHeaderContext.addTags(h, _dataFile.GetFileName());
     h.putTag(Tag("desc", "Log data store chunk data"));
+    if (_dictionary) {
+        writeDictionary(h, *_dictionary);
+    }
     _dataHeaderLen = h.writeFile(_dataFile);
 }
 
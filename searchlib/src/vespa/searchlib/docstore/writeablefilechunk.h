@@ -46,11 +46,13 @@ public:
                        const vespalib::string & baseName, uint64_t initialSerialNum,
                        uint32_t docIdLimit, const Config & config,
                        const TuneFileSummary &tune, const common::FileHeaderContext &fileHeaderContext,
-                       const IBucketizer * bucketizer, bool crcOnReadDisabled);
+                       const IBucketizer * bucketizer, bool crcOnReadDisabled,
+                       const Dictionary & dictionary = Dictionary());
     ~WriteableFileChunk();
 
     ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const override;
     void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const override;
+    void prefetch(SubChunkId chunk) const override;
 
     LidInfo append(uint64_t serialNum, uint32_t lid, const void * buffer, size_t len);
     void flush(bool block, uint64_t syncToken);
@@ -102,6 +104,7 @@ private:
     void updateCurrentDiskFootprint();
     size_t getDiskFootprint(const vespalib::MonitorGuard & guard) const;
     std::unique_ptr<FastOS_FileInterface> openIdx();
+    Chunk::Config getChunkConfig() const { return Chunk::Config(_config.getMaxChunkBytes(), _dictionary.get()); }
 
     Config            _config;
     SerialNum         _serialNum;
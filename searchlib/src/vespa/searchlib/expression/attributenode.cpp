@@ -50,7 +50,11 @@ AttributeNode::AttributeNode() :
     _hasMultiValue(false),
     _useEnumOptimization(false),
     _handler(),
-    _attributeName()
+    _attributeName(),
+    _prefetchDocIds(),
+    _prefetchedInts(),
+    _prefetchedFloats(),
+    _prefetchPos(0)
 {}
 
 AttributeNode::~AttributeNode() {}
@@ -61,7 +65,11 @@ AttributeNode::AttributeNode(const vespalib::stringref &name) :
     _hasMultiValue(false),
     _useEnumOptimization(false),
     _handler(),
-    _attributeName(name)
+    _attributeName(name),
+    _prefetchDocIds(),
+    _prefetchedInts(),
+    _prefetchedFloats(),
+    _prefetchPos(0)
 {}
 AttributeNode::AttributeNode(const IAttributeVector & attribute) :
     FunctionNode(),
@@ -69,7 +77,11 @@ AttributeNode::AttributeNode(const IAttributeVector & attribute) :
     _hasMultiValue(attribute.hasMultiValue()),
     _useEnumOptimization(false),
     _handler(),
-    _attributeName(attribute.getName())
+    _attributeName(attribute.getName()),
+    _prefetchDocIds(),
+    _prefetchedInts(),
+    _prefetchedFloats(),
+    _prefetchPos(0)
 {}
 
 AttributeNode::AttributeNode(const AttributeNode & attribute) :
@@ -78,7 +90,11 @@ AttributeNode::AttributeNode(const AttributeNode & attribute) :
     _hasMultiValue(attribute._hasMultiValue),
     _useEnumOptimization(attribute._useEnumOptimization),
     _handler(),
-    _attributeName(attribute._attributeName)
+    _attributeName(attribute._attributeName),
+    _prefetchDocIds(),
+    _prefetchedInts(),
+    _prefetchedFloats(),
+    _prefetchPos(0)
 {
     _scratchResult->setDocId(0);
 }
@@ -92,6 +108,7 @@ AttributeNode & AttributeNode::operator = (const AttributeNode & attr)
         _useEnumOptimization = attr._useEnumOptimization;
         _scratchResult.reset(attr._scratchResult->clone());
         _scratchResult->setDocId(0);
+        prefetch(nullptr, 0);
     }
     return *this;
 }
@@ -222,10 +239,50 @@ void AttributeNode::EnumHandler::handle(const AttributeResult & r)
     }
 }
 
+void AttributeNode::prefetch(const DocId * docIds, uint32_t numDocs)
+{
+    _prefetchDocIds.clear();
+    _prefetchedInts.clear();
+    _prefetchedFloats.clear();
+    _prefetchPos = 0;
+    const IAttributeVector * attribute = getAttribute();
+    if ((attribute == nullptr) || _hasMultiValue || (numDocs == 0)) {
+        return;
+    }
+    if (attribute->isIntegerType()) {
+        _prefetchedInts.resize(numDocs);
+        attribute->getIntBatch(docIds, numDocs, &_prefetchedInts[0]);
+    } else if (attribute->isFloatingPointType()) {
+        _prefetchedFloats.resize(numDocs);
+        attribute->getFloatBatch(docIds, numDocs, &_prefetchedFloats[0]);
+    } else {
+        return;
+    }
+    _prefetchDocIds.assign(docIds, docIds + numDocs);
+}
+
+bool AttributeNode::findPrefetched(DocId docId) const
+{
+    // Nested grouping levels see a subset of the documents, but in the same order
+    for (uint32_t i(_prefetchPos), m(_prefetchDocIds.size()); i < m; i++) {
+        if (_prefetchDocIds[i] == docId) {
+            _prefetchPos = i + 1;
+            return true;
+        }
+    }
+    return false;
+}
+
 bool AttributeNode::onExecute() const
 {
     if (_hasMultiValue) {
         _handler->handle(*_scratchResult);
+    } else if ( ! _prefetchDocIds.empty() && findPrefetched(_scratchResult->getDocId())) {
+        if ( ! _prefetchedInts.empty()) {
+            updateResult().set(Int64ResultNode(_prefetchedInts[_prefetchPos - 1]));
+        } else {
+            updateResult().set(FloatResultNode(_prefetchedFloats[_prefetchPos - 1]));
+        }
     } else {
         updateResult().set(*_scratchResult);
     }
@@ -252,6 +309,7 @@ void AttributeNode::wireAttributes(const IAttributeContext & attrCtx)
 void AttributeNode::cleanup()
 {
     _scratchResult.reset();
+    prefetch(nullptr, 0);
 }
 
 Serializer & AttributeNode::onSerialize(Serializer & os) const
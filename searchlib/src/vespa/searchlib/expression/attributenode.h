@@ -66,6 +66,17 @@ public:
         bool check(const vespalib::Identifiable &obj) const override { return obj.inherits(AttributeNode::classId); }
     };
 
+    class Prefetch : public vespalib::ObjectOperation, public vespalib::ObjectPredicate
+    {
+    public:
+        Prefetch(const DocId * docIds, uint32_t numDocs) : _docIds(docIds), _numDocs(numDocs) { }
+    private:
+        void execute(vespalib::Identifiable &obj) override { static_cast<AttributeNode &>(obj).prefetch(_docIds, _numDocs); }
+        bool check(const vespalib::Identifiable &obj) const override { return obj.inherits(AttributeNode::classId); }
+        const DocId * _docIds;
+        uint32_t      _numDocs;
+    };
+
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
     DECLARE_EXPRESSIONNODE(AttributeNode);
     AttributeNode();
@@ -82,7 +93,17 @@ public:
 
     void useEnumOptimization(bool use=true) { _useEnumOptimization = use; }
     bool hasMultiValue() const { return _hasMultiValue; }
+
+    /**
+     * Fetch the values of the given documents with a single batch call
+     * to the attribute vector. Documents executed later in the same order
+     * are served from the fetched values, other documents fall back to
+     * the per document lookup. Only single value numeric attributes are
+     * prefetched. Call with no documents to drop the fetched values.
+     **/
+    void prefetch(const DocId * docIds, uint32_t numDocs);
 private:
+    bool findPrefetched(DocId docId) const;
     void cleanup();
     void wireAttributes(const search::attribute::IAttributeContext & attrCtx) override;
     void onPrepare(bool preserveAccurateTypes) override;
@@ -151,6 +172,10 @@ private:
     mutable bool                _useEnumOptimization;
     std::unique_ptr<Handler>    _handler;
     vespalib::string            _attributeName;
+    std::vector<DocId>          _prefetchDocIds;
+    std::vector<int64_t>        _prefetchedInts;
+    std::vector<double>         _prefetchedFloats;
+    mutable uint32_t            _prefetchPos;
 };
 
 }
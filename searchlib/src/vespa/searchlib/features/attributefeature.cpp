@@ -114,6 +114,8 @@ public:
      */
     SingleAttributeExecutor(const T & attribute) : _attribute(attribute) { }
     void execute(uint32_t docId) override;
+    fef::DirectNumber get_direct_number() const override { return fef::DirectNumber(&getValue, &_attribute); }
+    static feature_t getValue(const void *attribute, uint32_t docId);
 };
 
 class CountOnlyAttributeExecutor : public fef::FeatureExecutor {
@@ -177,15 +179,21 @@ public:
     void execute(uint32_t docId) override;
 };
 
+template <typename T>
+feature_t
+SingleAttributeExecutor<T>::getValue(const void *attribute, uint32_t docId)
+{
+    typename T::LoadedValueType v = static_cast<const T *>(attribute)->getFast(docId);
+    return __builtin_expect(attribute::isUndefined(v), false)
+           ? attribute::getUndefined<search::feature_t>()
+           : util::getAsFeature(v);
+}
+
 template <typename T>
 void
 SingleAttributeExecutor<T>::execute(uint32_t docId)
 {
-    typename T::LoadedValueType v = _attribute.getFast(docId);
-    // value
-    outputs().set_number(0, __builtin_expect(attribute::isUndefined(v), false)
-                         ? attribute::getUndefined<search::feature_t>()
-                         : util::getAsFeature(v));
+    outputs().set_number(0, getValue(&_attribute, docId)); // value
     outputs().set_number(1, 0.0f);  // weight
     outputs().set_number(2, 0.0f);  // contains
     outputs().set_number(3, 1.0f);  // count
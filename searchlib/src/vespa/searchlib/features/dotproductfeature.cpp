@@ -55,10 +55,16 @@ DotProductExecutor<Vector, Buffer>::execute(uint32_t docId)
     feature_t val = 0;
     if (!_queryVector.getDimMap().empty()) {
         _buffer.fill(*_attribute, docId);
-        for (size_t i = 0; i < _buffer.size(); ++i) {
-            typename Vector::HashMap::const_iterator itr = _queryVector.getDimMap().find(_buffer[i].getValue());
-            if (itr != _end) {
-                val += _buffer[i].getWeight() * itr->second;
+        if (_queryVector.useScan()) {
+            for (size_t i = 0; i < _buffer.size(); ++i) {
+                val += _buffer[i].getWeight() * _queryVector.scan(_buffer[i].getValue());
+            }
+        } else {
+            for (size_t i = 0; i < _buffer.size(); ++i) {
+                typename Vector::HashMap::const_iterator itr = _queryVector.getDimMap().find(_buffer[i].getValue());
+                if (itr != _end) {
+                    val += _buffer[i].getWeight() * itr->second;
+                }
             }
         }
     }
@@ -50,10 +50,18 @@ public:
     typedef std::pair<DimensionVType, ComponentType> Element; // <dimension, component>
     typedef std::vector<Element>                    Vector;
     typedef vespalib::hash_map<DimensionHType, ComponentType, vespalib::hash<DimensionHType>, HashMapComparator> HashMap;
+    /**
+     * Numeric query vectors with at most this many dimensions are
+     * matched by comparing against all dimensions, which is cheaper
+     * than hashing every attribute value.
+     */
+    static constexpr size_t MAX_SCANNED_DIMS = 16;
 protected:
     VectorBase();
     Vector _vector;
     HashMap _dimMap; // dimension -> component
+    std::vector<DimensionHType> _scanDims;
+    std::vector<ComponentType>  _scanComponents;
 public:
     ~VectorBase();
     const Vector & getVector() const { return _vector; }
@@ -64,8 +72,29 @@ public:
         for (size_t i = 0; i < _vector.size(); ++i) {
             _dimMap.insert(std::make_pair(conv.convert(_vector[i].first), _vector[i].second));
         }
+        _scanDims.clear();
+        _scanComponents.clear();
+        if (std::is_arithmetic<DimensionHType>::value && (_dimMap.size() <= MAX_SCANNED_DIMS)) {
+            // Taken from the map, as only the first of duplicate dimensions is used
+            for (const auto & entry : _dimMap) {
+                _scanDims.push_back(entry.first);
+                _scanComponents.push_back(entry.second);
+            }
+        }
     }
     const HashMap & getDimMap() const { return _dimMap; }
+    bool useScan() const { return !_scanDims.empty(); }
+    /**
+     * Returns the component of the given dimension, or 0. Compares
+     * against all dimensions without branching so it vectorizes.
+     */
+    ComponentType scan(DimensionHType dim) const {
+        ComponentType component = 0;
+        for (size_t i = 0; i < _scanDims.size(); ++i) {
+            component += (_scanDims[i] == dim) ? _scanComponents[i] : ComponentType(0);
+        }
+        return component;
+    }
 };
 
 /**
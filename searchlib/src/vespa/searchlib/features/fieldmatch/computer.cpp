@@ -5,8 +5,8 @@
 #include <vespa/searchlib/fef/properties.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/locale/c.h>
+#include <algorithm>
 #include <iostream>
-#include <set>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".features.fieldmatch.computer");
@@ -36,7 +36,11 @@ Computer::Computer(const vespalib::string &propertyNamespace, const PhraseSplitt
     _simpleMetrics(params),
     _segments(),
     _alternativeSegmentationsTried(0),
-    _cachedHits()
+    _cachedHits(),
+    _uniqueTerms(),
+    _firstOccs(),
+    _weightedOccurrences(),
+    _significantOccurrences()
 {
     // Store term data for all terms searching in this field
     for (uint32_t i = 0; i < splitter.getNumTerms(); ++i) {
@@ -165,6 +169,9 @@ Computer::findClosestInFieldBySemanticDistance(int i, int previousJ, uint32_t st
         }
 
         const BitVector & hits = _cachedHits[i].bitvector;
+        if (previousJ >= 0 && (uint32_t)previousJ <= _fieldLength) {
+            return findClosestCachedHit(hits, previousJ, startSemanticDistance);
+        }
 
         for (uint32_t distance = startSemanticDistance; distance < _fieldLength; distance++) {
             int j = semanticDistanceToFieldIndex(distance, previousJ);
@@ -201,6 +208,46 @@ Computer::findClosestInFieldBySemanticDistance(int i, int previousJ, uint32_t st
     return -1;
 }
 
+int
+Computer::findClosestCachedHit(const BitVector &hits, uint32_t zeroJ, uint32_t startSemanticDistance) const
+{
+    // Visits the four segments of semanticDistanceToFieldIndex() in order of increasing distance.
+    uint32_t firstSegmentLength = std::min(_params.getProximityLimit(), _fieldLength - zeroJ);
+    uint32_t secondSegmentLength = std::min(_params.getProximityLimit(), zeroJ);
+    uint32_t secondSegmentEnd = firstSegmentLength + secondSegmentLength;
+    uint32_t thirdSegmentEnd = _fieldLength - zeroJ + secondSegmentLength;
+    uint32_t distance = startSemanticDistance;
+    if (distance < firstSegmentLength) { // close, in order
+        uint32_t j = hits.getNextTrueBit(zeroJ + distance);
+        if (j < zeroJ + firstSegmentLength) {
+            return j - zeroJ;
+        }
+        distance = firstSegmentLength;
+    }
+    if (distance < secondSegmentEnd) { // close, reversed
+        uint32_t start = zeroJ - 1 - (distance - firstSegmentLength);
+        uint32_t j = hits.getPrevTrueBit(start);
+        if (hits.testBit(j) && j >= zeroJ - secondSegmentLength) {
+            return zeroJ - 1 - j + firstSegmentLength;
+        }
+        distance = secondSegmentEnd;
+    }
+    if (distance < thirdSegmentEnd) { // far, in order
+        uint32_t j = hits.getNextTrueBit(zeroJ + distance - secondSegmentLength);
+        if (j < _fieldLength) {
+            return j - zeroJ + secondSegmentLength;
+        }
+        distance = thirdSegmentEnd;
+    }
+    if (distance < _fieldLength) { // far, reversed
+        uint32_t j = hits.getPrevTrueBit(_fieldLength - distance - 1);
+        if (hits.testBit(j)) {
+            return _fieldLength - j - 1;
+        }
+    }
+    return -1;
+}
+
 int
 Computer::semanticDistanceToFieldIndex(int semanticDistance, uint32_t zeroJ) const
 {
@@ -474,8 +521,8 @@ void
 Computer::setOccurrenceCounts(Metrics &metrics)
 {
     // Find all unique query terms.
-    std::vector<uint32_t> uniqueTerms;
-    std::set<uint32_t> firstOccs;
+    _uniqueTerms.clear();
+    _firstOccs.clear();
     for (uint32_t i = 0; i < _queryTermFieldMatch.size(); ++i) {
         const TermFieldMatchData *termFieldMatch = _queryTermFieldMatch[i];
         if (termFieldMatch == NULL) {
@@ -483,16 +530,19 @@ Computer::setOccurrenceCounts(Metrics &metrics)
         }
         FieldPositionsIterator it = termFieldMatch->getIterator();
         if (it.valid()) {
-            if (firstOccs.find(it.getPosition()) == firstOccs.end()) {
-                uniqueTerms.push_back(i);
-                firstOccs.insert(it.getPosition());
+            if (std::find(_firstOccs.begin(), _firstOccs.end(), it.getPosition()) == _firstOccs.end()) {
+                _uniqueTerms.push_back(i);
+                _firstOccs.push_back(it.getPosition());
             }
         }
     }
 
     // Commence occurence logic.
-    std::vector<feature_t> weightedOccurrences;
-    std::vector<feature_t> significantOccurrences;
+    std::vector<uint32_t> &uniqueTerms = _uniqueTerms;
+    std::vector<feature_t> &weightedOccurrences = _weightedOccurrences;
+    std::vector<feature_t> &significantOccurrences = _significantOccurrences;
+    weightedOccurrences.clear();
+    significantOccurrences.clear();
 
     uint32_t divider = std::min(_fieldLength, (uint32_t)(_params.getMaxOccurrences() * uniqueTerms.size()));
     uint32_t maxOccurence = std::min(_fieldLength, _params.getMaxOccurrences());
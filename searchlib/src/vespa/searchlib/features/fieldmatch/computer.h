@@ -321,6 +321,17 @@ private:
      */
     void setOccurrenceCounts(Metrics &metrics);
 
+    /**
+     * Finds the closest cached hit by semantic distance, scanning the bitvector a word at a time
+     * instead of testing one field index at a time.
+     *
+     * @param hits                  The cached hits of a query term.
+     * @param zeroJ                 The previous field index, no larger than the field length.
+     * @param startSemanticDistance The semantic distance we must be larger than or equal to.
+     * @return The semantic distance of the closest hit, or -1 if there are none.
+     */
+    int findClosestCachedHit(const search::BitVector &hits, uint32_t zeroJ, uint32_t startSemanticDistance) const;
+
     void handleError(uint32_t fieldPos, uint32_t docId) const __attribute__((noinline));
 
 
@@ -362,6 +373,12 @@ private:
     std::vector<SegmentData>                   _segments;       // Known segment starting points.
     uint32_t                                   _alternativeSegmentationsTried;
     std::vector<BitVectorData>                 _cachedHits;
+
+    // scratch space for setOccurrenceCounts(), kept to avoid allocating per docid
+    std::vector<uint32_t>                      _uniqueTerms;
+    std::vector<uint32_t>                      _firstOccs;
+    std::vector<feature_t>                     _weightedOccurrences;
+    std::vector<feature_t>                     _significantOccurrences;
 };
 
 } // fieldmatch
@@ -52,7 +52,10 @@ private:
     typedef double (*arr_function)(const double *);
     arr_function _ranking_function;
     std::vector<double> _params;
+    std::vector<std::pair<uint32_t, fef::DirectNumber>> _direct; // inputs calculated as part of this executor
+    std::vector<uint32_t> _indirect;
 
+    void handle_bind_inputs(ConstArrayRef<fef::LazyValue> inputs) override;
 public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
@@ -113,22 +116,33 @@ public:
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
     : _ranking_function(compiled_function.get_function()),
-      _params(compiled_function.num_params(), 0.0)
+      _params(compiled_function.num_params(), 0.0),
+      _direct(),
+      _indirect()
 {
 }
 
 void
-CompiledRankingExpressionExecutor::execute(uint32_t)
+CompiledRankingExpressionExecutor::handle_bind_inputs(ConstArrayRef<fef::LazyValue> inputs)
 {
-    size_t i(0);
-    for (; (i + 4) < _params.size(); i += 4) {
-        _params[i+0] = inputs().get_number(i+0);
-        _params[i+1] = inputs().get_number(i+1);
-        _params[i+2] = inputs().get_number(i+2);
-        _params[i+3] = inputs().get_number(i+3);
+    for (uint32_t i = 0; i < inputs.size(); ++i) {
+        fef::DirectNumber direct = inputs[i].direct_number();
+        if (direct.valid()) {
+            _direct.emplace_back(i, direct);
+        } else {
+            _indirect.push_back(i);
+        }
+    }
+}
+
+void
+CompiledRankingExpressionExecutor::execute(uint32_t docId)
+{
+    for (const auto &input: _direct) {
+        _params[input.first] = input.second.get(docId);
     }
-    for (; i < _params.size(); ++i) {
-        _params[i] = inputs().get_number(i);
+    for (uint32_t idx: _indirect) {
+        _params[idx] = inputs().get_number(idx);
     }
     outputs().set_number(0, _ranking_function(&_params[0]));
 }
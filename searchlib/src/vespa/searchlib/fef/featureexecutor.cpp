@@ -17,6 +17,12 @@ FeatureExecutor::isPure()
     return false;
 }
 
+DirectNumber
+FeatureExecutor::get_direct_number() const
+{
+    return DirectNumber();
+}
+
 void
 FeatureExecutor::handle_bind_inputs(vespalib::ConstArrayRef<LazyValue>)
 {
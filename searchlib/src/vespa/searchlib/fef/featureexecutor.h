@@ -13,6 +13,21 @@ namespace fef {
 
 class FeatureExecutor;
 
+/**
+ * A function calculating a number feature value directly from the
+ * underlying data for a document, together with the context it
+ * needs. Used to fuse cheap inputs into the executors consuming them.
+ **/
+struct DirectNumber {
+    using function = feature_t (*)(const void *ctx, uint32_t docid);
+    function fun;
+    const void *ctx;
+    DirectNumber() : fun(nullptr), ctx(nullptr) {}
+    DirectNumber(function fun_in, const void *ctx_in) : fun(fun_in), ctx(ctx_in) {}
+    bool valid() const { return (fun != nullptr); }
+    feature_t get(uint32_t docid) const { return fun(ctx, docid); }
+};
+
 /**
  * A LazyValue is a reference to a value that can be calculated by a
  * FeatureExecutor when needed. Actual Values and FeatureExecutors are
@@ -35,6 +50,7 @@ public:
     }
     inline double as_number(uint32_t docid) const;
     inline vespalib::eval::Value::CREF as_object(uint32_t docid) const;
+    inline DirectNumber direct_number() const;
 };
 
 /**
@@ -140,6 +156,20 @@ public:
      **/
     virtual bool isPure();
 
+    /**
+     * Returns a function calculating the first output of this feature
+     * executor directly, for executors where that is cheap (like
+     * reading a single value attribute). An executor consuming that
+     * output may then calculate it as part of its own execution
+     * instead of having this executor run for each document. The
+     * function must give the same value as executing this
+     * executor. This method is implemented to return an invalid
+     * function by default.
+     *
+     * @return function calculating the first output, or an invalid one
+     **/
+    virtual DirectNumber get_direct_number() const;
+
     /**
      * Make sure this executor has been executed for the given
      * document.
@@ -173,6 +203,13 @@ vespalib::eval::Value::CREF LazyValue::as_object(uint32_t docid) const {
     return _value->as_object;
 }
 
+DirectNumber LazyValue::direct_number() const {
+    if ((_executor != nullptr) && (_value == _executor->outputs().get_raw(0))) {
+        return _executor->get_direct_number();
+    }
+    return DirectNumber();
+}
+
 feature_t FeatureExecutor::Inputs::get_number(size_t idx) const {
     return _inputs[idx].as_number(_docid);
 }
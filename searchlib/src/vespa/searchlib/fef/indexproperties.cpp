@@ -97,6 +97,15 @@ FirstPhase::lookup(const Properties &props)
     return lookupString(props, NAME, DEFAULT_VALUE);
 }
 
+const vespalib::string FirstPhaseUpperBound::NAME("vespa.rank.firstphase.upperbound");
+const vespalib::string FirstPhaseUpperBound::DEFAULT_VALUE("");
+
+vespalib::string
+FirstPhaseUpperBound::lookup(const Properties &props)
+{
+    return lookupString(props, NAME, DEFAULT_VALUE);
+}
+
 const vespalib::string SecondPhase::NAME("vespa.rank.secondphase");
 const vespalib::string SecondPhase::DEFAULT_VALUE("");
 
@@ -160,6 +169,21 @@ TermwiseLimit::lookup(const Properties &props, double defaultValue)
     return lookupDouble(props, NAME, defaultValue);
 }
 
+const vespalib::string TermwiseOrLimit::NAME("vespa.matching.termwise_or_limit");
+const uint32_t TermwiseOrLimit::DEFAULT_VALUE(0);
+
+uint32_t
+TermwiseOrLimit::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+TermwiseOrLimit::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
 const vespalib::string NumThreadsPerSearch::NAME("vespa.matching.numthreadspersearch");
 const uint32_t NumThreadsPerSearch::DEFAULT_VALUE(std::numeric_limits<uint32_t>::max());
 
@@ -190,6 +214,45 @@ NumSearchPartitions::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string EstimateSampleBudget::NAME("vespa.matching.estimate_sample_budget");
+const uint32_t EstimateSampleBudget::DEFAULT_VALUE(0);
+
+uint32_t
+EstimateSampleBudget::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+uint32_t
+EstimateSampleBudget::lookup(const Properties &props, uint32_t defaultValue)
+{
+    return lookupUint32(props, NAME, defaultValue);
+}
+
+const vespalib::string WorkStealing::NAME("vespa.matching.workstealing");
+const bool WorkStealing::DEFAULT_VALUE(false);
+
+bool
+WorkStealing::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+WorkStealing::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
+const vespalib::string TraceCost::NAME("vespa.matching.trace.cost");
+const bool TraceCost::DEFAULT_VALUE(false);
+
+bool
+TraceCost::lookup(const Properties &props)
+{
+    return lookupBool(props, NAME, DEFAULT_VALUE);
+}
+
 const vespalib::string MinHitsPerThread::NAME("vespa.matching.minhitsperthread");
 const uint32_t MinHitsPerThread::DEFAULT_VALUE(0);
 
@@ -331,6 +394,21 @@ DiversityCutoffStrategy::lookup(const Properties &props)
     return lookupString(props, NAME, DEFAULT_VALUE);
 }
 
+const vespalib::string SortedEarlyTermination::NAME("vespa.matchphase.sorted.earlytermination");
+const bool SortedEarlyTermination::DEFAULT_VALUE(false);
+
+bool
+SortedEarlyTermination::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+SortedEarlyTermination::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
 
 }
 
@@ -42,6 +42,19 @@ namespace rank {
         static vespalib::string lookup(const Properties &props);
     };
 
+    /**
+     * Property for the feature name used as an upper bound for the
+     * first phase rank score of a document. When set, documents whose
+     * upper bound cannot beat the lowest score currently kept by the
+     * hit collector are not scored by the first phase. The bound must
+     * never be lower than the real first phase score.
+     **/
+    struct FirstPhaseUpperBound {
+        static const vespalib::string NAME;
+        static const vespalib::string DEFAULT_VALUE;
+        static vespalib::string lookup(const Properties &props);
+    };
+
     /**
      * Property for the feature name used for second phase rank.
      **/
@@ -105,6 +118,19 @@ namespace matching {
         static double lookup(const Properties &props, double defaultValue);
     };
 
+    /**
+     * The number of children of an OR that must be able to be
+     * evaluated termwise (not needing unpack) for them to be
+     * evaluated termwise regardless of the termwise limit. 0 means
+     * never. The default value is 0 (never).
+     **/
+    struct TermwiseOrLimit {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+
     /**
      * Property for the number of threads used per search.
      **/
@@ -133,6 +159,39 @@ namespace matching {
         static uint32_t lookup(const Properties &props);
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
+    /**
+     * Property for the number of docids that may be sampled per query
+     * to correct the hit estimates used to order the children of AND
+     * nodes. 0 (the default) disables sampling.
+     **/
+    struct EstimateSampleBudget {
+        static const vespalib::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+        static uint32_t lookup(const Properties &props, uint32_t defaultValue);
+    };
+    /**
+     * Property for enabling work-stealing between the search threads.
+     * When enabled, idle threads steal half of the remaining docid
+     * range of another thread instead of using the configured search
+     * partitions.
+     **/
+    struct WorkStealing {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+    /**
+     * Property for requesting the cpu time, phase timings and memory
+     * spent by a query to be returned in the trace properties of the
+     * search reply. The default is false.
+     **/
+    struct TraceCost {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+    };
 }
 
 namespace softtimeout {
@@ -256,6 +315,20 @@ namespace matchphase {
         static vespalib::string lookup(const Properties &props);
     };
 
+    /**
+     * Property for letting a query sorted on a single fast-search
+     * numeric attribute only match the first hits in attribute order,
+     * using the match phase limiter with offset + hits as max hits.
+     * The total hit count and coverage then become estimates like
+     * with other match phase limiting. The default is false.
+     **/
+    struct SortedEarlyTermination {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+
 } // namespace matchphase
 
 
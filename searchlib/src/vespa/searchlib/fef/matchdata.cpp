@@ -7,7 +7,8 @@ namespace fef {
 
 MatchData::MatchData(const Params &cparams)
     : _termFields(cparams.numTermFields()),
-      _termwise_limit(1.0)
+      _termwise_limit(1.0),
+      _termwise_or_limit(0)
 {
 }
 
@@ -18,6 +19,16 @@ MatchData::soft_reset()
         tfmd.resetOnlyDocId(TermFieldMatchData::invalidId()).tagAsNeeded();
     }
     _termwise_limit = 1.0;
+    _termwise_or_limit = 0;
+}
+
+void
+MatchData::reinit(const Params &cparams)
+{
+    _termFields.clear();
+    _termFields.resize(cparams.numTermFields());
+    _termwise_limit = 1.0;
+    _termwise_or_limit = 0;
 }
 
 MatchData::UP
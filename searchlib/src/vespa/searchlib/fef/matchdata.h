@@ -18,6 +18,7 @@ class MatchData
 private:
     std::vector<TermFieldMatchData> _termFields;
     double                          _termwise_limit;
+    uint32_t                        _termwise_or_limit;
 
 public:
     /**
@@ -67,6 +68,14 @@ public:
      **/
     void soft_reset();
 
+    /**
+     * Reinitialize this match data to the state of a newly created
+     * object with the given parameters. The storage for the term
+     * fields is kept, so a large match data object can be reused for
+     * a later query without allocating it again.
+     **/
+    void reinit(const Params &cparams);
+
     MatchData(const MatchData &rhs) = delete;
     MatchData & operator=(const MatchData &rhs) = delete;
 
@@ -80,6 +89,14 @@ public:
     double get_termwise_limit() const { return _termwise_limit; }
     void set_termwise_limit(double value) { _termwise_limit = value; }
 
+    /**
+     * The number of children of an OR that must be able to be
+     * evaluated termwise for this to be done regardless of the
+     * termwise limit. 0 means never. The initial value is 0.
+     **/
+    uint32_t get_termwise_or_limit() const { return _termwise_or_limit; }
+    void set_termwise_or_limit(uint32_t value) { _termwise_or_limit = value; }
+
     /**
      * Obtain the number of term fields allocated in this match data
      * structure.
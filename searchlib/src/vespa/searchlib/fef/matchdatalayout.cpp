@@ -16,8 +16,18 @@ MatchDataLayout::~MatchDataLayout() { }
 MatchData::UP
 MatchDataLayout::createMatchData() const
 {
-    MatchData::UP md(new MatchData(MatchData::params()
-                                   .numTermFields(_numTermFields)));
+    return createMatchData(MatchData::UP());
+}
+
+MatchData::UP
+MatchDataLayout::createMatchData(MatchData::UP recycled) const
+{
+    MatchData::UP md(std::move(recycled));
+    if (md) {
+        md->reinit(MatchData::params().numTermFields(_numTermFields));
+    } else {
+        md.reset(new MatchData(MatchData::params().numTermFields(_numTermFields)));
+    }
     assert(_numTermFields == _fieldIds.size());
     for (size_t i = 0; i < _numTermFields; ++i) {
         md->resolveTermField(i)->setFieldId(_fieldIds[i]);
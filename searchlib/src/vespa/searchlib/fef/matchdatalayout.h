@@ -43,6 +43,17 @@ public:
      * @return auto-pointer to a match data object
      **/
     MatchData::UP createMatchData() const;
+
+    /**
+     * Same as createMatchData(), but reinitializes and returns the
+     * given match data object instead of allocating a new one if it
+     * is not null. This lets the term field storage of an earlier
+     * query be reused.
+     *
+     * @return auto-pointer to a match data object
+     * @param recycled match data object to reuse, may be null
+     **/
+    MatchData::UP createMatchData(MatchData::UP recycled) const;
 };
 
 }
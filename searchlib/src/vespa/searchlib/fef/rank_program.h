@@ -60,6 +60,12 @@ public:
 
     size_t num_executors() const { return _executors.size(); }
 
+    /**
+     * The number of bytes allocated for feature executors and their
+     * outputs by this rank program.
+     **/
+    size_t count_used() const { return (_hot_stash.count_used() + _cold_stash.count_used()); }
+
     /**
      * Set up this rank program by creating the needed feature
      * executors and wiring them together. This function will also
@@ -29,15 +29,20 @@ RankSetup::RankSetup(const BlueprintFactory &factory, const IIndexEnvironment &i
     : _factory(factory),
       _indexEnv(indexEnv),
       _first_phase_resolver(new BlueprintResolver(factory, indexEnv)),
+      _first_phase_bound_resolver(new BlueprintResolver(factory, indexEnv)),
       _second_phase_resolver(new BlueprintResolver(factory, indexEnv)),
       _summary_resolver(new BlueprintResolver(factory, indexEnv)),
       _dumpResolver(new BlueprintResolver(factory, indexEnv)),
       _firstPhaseRankFeature(),
+      _firstPhaseUpperBoundFeature(),
       _secondPhaseRankFeature(),
       _degradationAttribute(),
+      _termwise_limit(1.0),
+      _termwise_or_limit(0),
       _numThreads(0),
       _minHitsPerThread(0),
       _numSearchPartitions(0),
+      _workStealing(false),
       _heapSize(0),
       _arraySize(0),
       _estimatePoint(0),
@@ -67,6 +72,7 @@ void
 RankSetup::configure()
 {
     setFirstPhaseRank(rank::FirstPhase::lookup(_indexEnv.getProperties()));
+    setFirstPhaseUpperBound(rank::FirstPhaseUpperBound::lookup(_indexEnv.getProperties()));
     setSecondPhaseRank(rank::SecondPhase::lookup(_indexEnv.getProperties()));
     std::vector<vespalib::string> summaryFeatures = summary::Feature::lookup(_indexEnv.getProperties());
     for (uint32_t i = 0; i < summaryFeatures.size(); ++i) {
@@ -78,9 +84,11 @@ RankSetup::configure()
         addDumpFeature(dumpFeatures[i]);
     }
     set_termwise_limit(matching::TermwiseLimit::lookup(_indexEnv.getProperties()));
+    set_termwise_or_limit(matching::TermwiseOrLimit::lookup(_indexEnv.getProperties()));
     setNumThreadsPerSearch(matching::NumThreadsPerSearch::lookup(_indexEnv.getProperties()));
     setMinHitsPerThread(matching::MinHitsPerThread::lookup(_indexEnv.getProperties()));
     setNumSearchPartitions(matching::NumSearchPartitions::lookup(_indexEnv.getProperties()));
+    setWorkStealing(matching::WorkStealing::lookup(_indexEnv.getProperties()));
     setHeapSize(hitcollector::HeapSize::lookup(_indexEnv.getProperties()));
     setArraySize(hitcollector::ArraySize::lookup(_indexEnv.getProperties()));
     setDegradationAttribute(matchphase::DegradationAttribute::lookup(_indexEnv.getProperties()));
@@ -108,6 +116,13 @@ RankSetup::setFirstPhaseRank(const vespalib::string &featureName)
     _firstPhaseRankFeature = featureName;
 }
 
+void
+RankSetup::setFirstPhaseUpperBound(const vespalib::string &featureName)
+{
+    LOG_ASSERT(!_compiled);
+    _firstPhaseUpperBoundFeature = featureName;
+}
+
 void
 RankSetup::setSecondPhaseRank(const vespalib::string &featureName)
 {
@@ -144,6 +159,17 @@ RankSetup::compile()
             _compileError = true;
         }
     }
+    if (!_firstPhaseUpperBoundFeature.empty()) {
+        FeatureNameParser parser(_firstPhaseUpperBoundFeature);
+        if (parser.valid()) {
+            _firstPhaseUpperBoundFeature = parser.featureName();
+            _first_phase_bound_resolver->addSeed(_firstPhaseUpperBoundFeature);
+        } else {
+            LOG(warning, "invalid feature name for initial rank upper bound: '%s'",
+                _firstPhaseUpperBoundFeature.c_str());
+            _compileError = true;
+        }
+    }
     if (!_secondPhaseRankFeature.empty()) {
         FeatureNameParser parser(_secondPhaseRankFeature);
         if (parser.valid()) {
@@ -167,6 +193,7 @@ RankSetup::compile()
     }
     _indexEnv.hintFeatureMotivation(IIndexEnvironment::RANK);
     _compileError |= !_first_phase_resolver->compile();
+    _compileError |= !_first_phase_bound_resolver->compile();
     _compileError |= !_second_phase_resolver->compile();
     _compileError |= !_summary_resolver->compile();
     _indexEnv.hintFeatureMotivation(IIndexEnvironment::DUMP);
@@ -182,6 +209,9 @@ RankSetup::prepareSharedState(const IQueryEnvironment &queryEnv, IObjectStore &o
     for (const auto &spec : _first_phase_resolver->getExecutorSpecs()) {
         spec.blueprint->prepareSharedState(queryEnv, objectStore);
     }
+    for (const auto &spec : _first_phase_bound_resolver->getExecutorSpecs()) {
+        spec.blueprint->prepareSharedState(queryEnv, objectStore);
+    }
     for (const auto &spec : _second_phase_resolver->getExecutorSpecs()) {
         spec.blueprint->prepareSharedState(queryEnv, objectStore);
     }
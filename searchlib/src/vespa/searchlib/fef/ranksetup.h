@@ -26,16 +26,20 @@ private:
     const BlueprintFactory  &_factory;
     const IIndexEnvironment &_indexEnv;
     BlueprintResolver::SP    _first_phase_resolver;
+    BlueprintResolver::SP    _first_phase_bound_resolver;
     BlueprintResolver::SP    _second_phase_resolver;
     BlueprintResolver::SP    _summary_resolver;
     BlueprintResolver::SP    _dumpResolver;
     vespalib::string         _firstPhaseRankFeature;
+    vespalib::string         _firstPhaseUpperBoundFeature;
     vespalib::string         _secondPhaseRankFeature;
     vespalib::string         _degradationAttribute;
     double                   _termwise_limit;
+    uint32_t                 _termwise_or_limit;
     uint32_t                 _numThreads;
     uint32_t                 _minHitsPerThread;
     uint32_t                 _numSearchPartitions;
+    bool                     _workStealing;
     uint32_t                 _heapSize;
     uint32_t                 _arraySize;
     uint32_t                 _estimatePoint;
@@ -101,6 +105,22 @@ public:
      **/
     const vespalib::string &getFirstPhaseRank() const { return _firstPhaseRankFeature; }
 
+    /**
+     * This method is invoked during setup (before invoking the @ref
+     * compile method) to define what feature to use as an upper bound
+     * for the first phase rank score. An empty name means no bound.
+     *
+     * @param featureName full feature name for the first phase upper bound
+     **/
+    void setFirstPhaseUpperBound(const vespalib::string &featureName);
+
+    /**
+     * Returns the first phase upper bound.
+     *
+     * @return feature name for the first phase upper bound
+     **/
+    const vespalib::string &getFirstPhaseUpperBound() const { return _firstPhaseUpperBoundFeature; }
+
     /**
      * This method is invoked during setup (before invoking the @ref
      * compile method) to define what feature to use as second phase ranking.
@@ -138,6 +158,14 @@ public:
      **/
     double get_termwise_limit() const { return _termwise_limit; }
 
+    /**
+     * Set/get the number of children of an OR that must be able to
+     * be evaluated termwise for termwise evaluation to be used
+     * regardless of the termwise limit. 0 means never.
+     **/
+    void set_termwise_or_limit(uint32_t value) { _termwise_or_limit = value; }
+    uint32_t get_termwise_or_limit() const { return _termwise_or_limit; }
+
     /**
      * Sets the number of threads per search.
      *
@@ -158,6 +186,10 @@ public:
 
     uint32_t getNumSearchPartitions() const { return _numSearchPartitions; }
 
+    void setWorkStealing(bool workStealing) { _workStealing = workStealing; }
+
+    bool getWorkStealing() const { return _workStealing; }
+
     /**
      * Sets the heap size to be used in the hit collector.
      *
@@ -391,6 +423,11 @@ public:
     // program is cheap while setting it up is more expensive.
 
     RankProgram::UP create_first_phase_program() const { return RankProgram::UP(new RankProgram(_first_phase_resolver)); }
+    RankProgram::UP create_first_phase_bound_program() const {
+        return _firstPhaseUpperBoundFeature.empty()
+            ? RankProgram::UP()
+            : RankProgram::UP(new RankProgram(_first_phase_bound_resolver));
+    }
     RankProgram::UP create_second_phase_program() const { return RankProgram::UP(new RankProgram(_second_phase_resolver)); }
     RankProgram::UP create_summary_program() const { return RankProgram::UP(new RankProgram(_summary_resolver)); }
     RankProgram::UP create_dump_program() const { return RankProgram::UP(new RankProgram(_dumpResolver)); }
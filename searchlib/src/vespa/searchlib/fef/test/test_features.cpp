@@ -35,7 +35,9 @@ ImpureValueBlueprint::createExecutor(const IQueryEnvironment &, vespalib::Stash
 //-----------------------------------------------------------------------------
 
 struct DocidExecutor : FeatureExecutor {
+    static feature_t get_docid(const void *, uint32_t docid) { return docid; }
     void execute(uint32_t docid) override { outputs().set_number(0, docid); }
+    DirectNumber get_direct_number() const override { return DirectNumber(&get_docid, nullptr); }
 };
 
 bool
@@ -23,7 +23,7 @@ struct ImpureValueBlueprint : Blueprint {
 
 //-----------------------------------------------------------------------------
 
-// "docid" calculates local document id
+// "docid" calculates local document id, which may also be read directly
 struct DocidBlueprint : Blueprint {
     DocidBlueprint() : Blueprint("docid") {}
     void visitDumpFeatures(const IIndexEnvironment &, IDumpFeatureVisitor &) const override {}
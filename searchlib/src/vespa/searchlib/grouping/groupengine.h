@@ -4,6 +4,7 @@
 #include <vespa/searchlib/aggregation/groupinglevel.h>
 #include <vespa/searchlib/grouping/collect.h>
 #include <vespa/vespalib/util/sort.h>
+#include <vespa/vespalib/stllike/swiss_hash_set.h>
 
 namespace search {
 namespace grouping {
@@ -54,7 +55,7 @@ public:
         const GroupEngine & _engine;
     };
 
-    typedef vespalib::hash_set<GroupRef, GroupHash, GroupEqual> Children;
+    typedef vespalib::swiss_hash_set<GroupRef, GroupHash, GroupEqual> Children;
 
     /**
      * @param request The request creating this engine.
@@ -10,6 +10,7 @@
 #include <vespa/vespalib/objects/serializer.h>
 #include <vespa/vespalib/util/buffer.h>
 #include <algorithm>
+#include <cmath>
 
 namespace search {
 
@@ -70,6 +71,8 @@ public:
     // Aggregates a hash value into the sketch.
     int aggregate(HashT hash) { return _sketch->aggregate(hash); }
     void merge(const HyperLogLog<BucketBits, HashT> &other);
+    // Estimates the number of unique hashes aggregated (and merged) so far.
+    uint64_t estimateCount() const;
     void serialize(vespalib::Serializer &os) const;
     void deserialize(vespalib::Deserializer &is);
 
@@ -115,6 +118,34 @@ merge(const HyperLogLog<BucketBits, HashT> &other) {
     }
 }
 
+template <int BucketBits, typename HashT>
+uint64_t HyperLogLog<BucketBits, HashT>::
+estimateCount() const {
+    typedef SparseSketch<BucketBits, HashT> Sparse;
+    typedef NormalSketch<BucketBits, HashT> Normal;
+
+    if (_sketch->getClassId() == Sparse::classId) {
+        // The sparse sketch keeps all hashes, so only hash collisions are lost.
+        return static_cast<const Sparse &>(*_sketch).getSize();
+    }
+    const Normal &normal = static_cast<const Normal &>(*_sketch);
+    const double m = Normal::BUCKET_COUNT;
+    double sum = 0.0;
+    uint32_t zeros = 0;
+    for (size_t i = 0; i < Normal::BUCKET_COUNT; ++i) {
+        sum += std::ldexp(1.0, -normal.bucket[i]);
+        zeros += (normal.bucket[i] == 0) ? 1 : 0;
+    }
+    double estimate = (0.7213 / (1.0 + 1.079 / m)) * m * m / sum;
+    const double hashSpace = std::ldexp(1.0, sizeof(HashT) * 8);
+    if ((estimate <= 2.5 * m) && (zeros > 0)) {
+        estimate = m * std::log(m / zeros);  // linear counting
+    } else if (estimate > hashSpace / 30) {
+        estimate = -hashSpace * std::log(1.0 - estimate / hashSpace);
+    }
+    return std::llround(estimate);
+}
+
 template <int BucketBits, typename HashT>
 void HyperLogLog<BucketBits, HashT>::
 serialize(vespalib::Serializer &os) const {
@@ -63,12 +63,29 @@ protected:
     // Can be examined after open
     bool _memoryMapped;
 public:
+    /**
+     * Receives the words found by visitPrefix(), in dictionary order.
+     */
+    class PrefixVisitor
+    {
+    public:
+        virtual ~PrefixVisitor() { }
+        virtual void visit(const vespalib::stringref &word, uint64_t wordNum,
+                           const PostingListOffsetAndCounts &offsetAndCounts) = 0;
+    };
+
     DictionaryFileRandRead();
     virtual ~DictionaryFileRandRead();
 
     virtual bool lookup(const vespalib::stringref &word, uint64_t &wordNum,
                         PostingListOffsetAndCounts &offsetAndCounts) = 0;
 
+    /**
+     * Visit all words starting with the given prefix, without a full
+     * lookup per word.
+     */
+    virtual void visitPrefix(const vespalib::stringref &prefix, PrefixVisitor &visitor) = 0;
+
     /**
      * Open dictionary file for random read.
      */
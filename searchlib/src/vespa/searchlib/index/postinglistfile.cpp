@@ -103,6 +103,13 @@ PostingListFileRandRead::afterOpen(FastOS_FileInterface &file)
 }
 
 
+void
+PostingListFileRandRead::prefetchPostingList(const PostingListHandle &handle) const
+{
+    (void) handle;
+}
+
+
 PostingListFileRandReadPassThrough::
 PostingListFileRandReadPassThrough(PostingListFileRandRead *lower,
                                    bool ownLower)
@@ -142,6 +149,14 @@ readPostingList(const PostingListCounts &counts,
 }
 
 
+void
+PostingListFileRandReadPassThrough::
+prefetchPostingList(const PostingListHandle &handle) const
+{
+    _lower->prefetchPostingList(handle);
+}
+
+
 bool
 PostingListFileRandReadPassThrough::open(const vespalib::string &name,
         const TuneFileRandRead &tuneFileRead)
@@ -195,6 +195,13 @@ public:
                     uint32_t numSegments,
                     PostingListHandle &handle) = 0;
 
+    /**
+     * Hint that the posting list at the bit offset and bit length of
+     * the handle will be read soon, letting reads for several terms
+     * proceed in parallel. The default implementation does nothing.
+     */
+    virtual void prefetchPostingList(const PostingListHandle &handle) const;
+
     /**
      * Open posting list file for random read.
      */
@@ -234,6 +241,8 @@ public:
     void readPostingList(const PostingListCounts &counts, uint32_t firstSegment,
                          uint32_t numSegments, PostingListHandle &handle) override;
 
+    void prefetchPostingList(const PostingListHandle &handle) const override;
+
     bool open(const vespalib::string &name, const TuneFileRandRead &tuneFileRead) override;
     bool close() override;
 };
@@ -34,6 +34,7 @@ public:
     const void *_mem;       // Memory backing posting list after read/mmap
     void *_allocMem;        // What to free after posting list
     size_t _allocSize;      // Size of allocated memory
+    std::shared_ptr<void> _sharedMem; // Keeps memory shared with a posting list cache alive
 
     PostingListHandle()
     : _file(NULL),
@@ -44,7 +45,8 @@ public:
       _bitOffsetMem(0),
       _mem(NULL),
       _allocMem(NULL),
-      _allocSize(0)
+      _allocSize(0),
+      _sharedMem()
     { }
 
     ~PostingListHandle()
@@ -79,6 +81,7 @@ public:
             _allocMem = NULL;
         }
         _allocSize = 0;
+        _sharedMem.reset();
     }
 };
 
@@ -27,11 +27,12 @@ using index::Schema;
 namespace memoryindex {
 
 Dictionary::Dictionary(const Schema & schema)
-    : _fieldIndexes(),
+    : _wordStore(),
+      _fieldIndexes(),
       _numFields(schema.getNumIndexFields())
 {
     for (uint32_t fieldId = 0; fieldId < _numFields; ++fieldId) {
-        auto fieldIndex = std::make_unique<MemoryFieldIndex>(schema, fieldId);
+        auto fieldIndex = std::make_unique<MemoryFieldIndex>(schema, fieldId, _wordStore);
         _fieldIndexes.push_back(std::move(fieldIndex));
     }
 }
@@ -54,7 +55,7 @@ Dictionary::dump(search::index::IndexBuilder &indexBuilder)
 MemoryUsage
 Dictionary::getMemoryUsage() const
 {
-    MemoryUsage usage;
+    MemoryUsage usage = _wordStore.getMemoryUsage();
     for (auto &fieldIndex : _fieldIndexes) {
         usage.merge(fieldIndex->getMemoryUsage());
     }
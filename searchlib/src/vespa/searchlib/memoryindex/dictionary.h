@@ -16,6 +16,8 @@ public:
 private:
     typedef vespalib::GenerationHandler GenerationHandler;
 
+    // Words are shared by all field indexes
+    WordStore               _wordStore;
     std::vector<std::unique_ptr<MemoryFieldIndex> > _fieldIndexes;
     uint32_t                _numFields;
 
@@ -54,6 +56,13 @@ public:
     getFieldIndexes() const { return _fieldIndexes; }
 
     uint32_t getNumFields() const { return _numFields; }
+
+    void setHugePages(bool hugePages) {
+        _wordStore.setHugePages(hugePages);
+        for (auto &fieldIndex : _fieldIndexes) {
+            fieldIndex->setHugePages(hugePages);
+        }
+    }
 };
 
 }
@@ -14,6 +14,7 @@
 #include <vespa/searchlib/common/sort.h>
 #include <vespa/document/repo/fixedtyperepo.h>
 #include <vespa/searchlib/common/isequencedtaskexecutor.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".memoryindex.documentinverter");
@@ -47,12 +48,16 @@ using search::util::URL;
 
 DocumentInverter::DocumentInverter(const Schema &schema,
                                    ISequencedTaskExecutor &invertThreads,
-                                   ISequencedTaskExecutor &pushThreads)
+                                   ISequencedTaskExecutor &pushThreads,
+                                   uint32_t numFieldShards)
     : _schema(schema),
       _indexedFieldPaths(),
       _dataType(nullptr),
       _schemaIndexFields(),
       _inverters(),
+      _shardInverters(),
+      _fieldShards(),
+      _removeLocks(),
       _urlInverters(),
       _invertThreads(invertThreads),
       _pushThreads(pushThreads)
@@ -62,6 +67,14 @@ DocumentInverter::DocumentInverter(const Schema &schema,
     for (uint32_t fieldId = 0; fieldId < _schema.getNumIndexFields();
          ++fieldId) {
         _inverters.push_back(std::make_unique<FieldInverter>(_schema, fieldId));
+        _fieldShards.emplace_back(1, _inverters.back().get());
+        _removeLocks.push_back(std::make_unique<std::mutex>());
+    }
+    for (uint32_t fieldId : _schemaIndexFields._textFields) {
+        for (uint32_t shard = 1; shard < numFieldShards; ++shard) {
+            _shardInverters.push_back(std::make_unique<FieldInverter>(_schema, fieldId));
+            _fieldShards[fieldId].push_back(_shardInverters.back().get());
+        }
     }
     for (auto &urlField : _schemaIndexFields._uriFields) {
         Schema::CollectionType collectionType =
@@ -136,8 +149,9 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
             // FieldValue::UP fv = doc.getNestedFieldValue(fieldPath.begin(), fieldPath.end());
             fv = doc.getValue(*fieldPath);
         }
-        FieldInverter *inverter = _inverters[fieldId].get();
-        _invertThreads.execute(fieldId,
+        FieldInverter *inverter = getShard(fieldId, docId);
+        uint32_t shard = docId % getNumShards(fieldId);
+        _invertThreads.execute(getShardComponentId(fieldId, shard),
                                [inverter, docId, fv(std::move(fv))]()
                                { inverter->invertField(docId, fv); });
     }
@@ -164,8 +178,9 @@ void
 DocumentInverter::removeDocument(uint32_t docId)
 {
     for (uint32_t fieldId : _schemaIndexFields._textFields) {
-        FieldInverter *inverter = _inverters[fieldId].get();
-        _invertThreads.execute(fieldId,
+        FieldInverter *inverter = getShard(fieldId, docId);
+        uint32_t shard = docId % getNumShards(fieldId);
+        _invertThreads.execute(getShardComponentId(fieldId, shard),
                                [inverter, docId]()
                                { inverter->removeDocument(docId); });
     }
@@ -190,6 +205,12 @@ DocumentInverter::pushDocuments(Dictionary &dict,
     uint32_t fieldId = 0;
     for (auto &inverter : _inverters) {
         MemoryFieldIndex &fieldIndex(**indexFieldIterator);
+        if (getNumShards(fieldId) > 1) {
+            pushShardedDocuments(fieldId, fieldIndex, onWriteDone);
+            ++indexFieldIterator;
+            ++fieldId;
+            continue;
+        }
         DocumentRemover &remover(fieldIndex.getDocumentRemover());
         OrderedDocumentInserter &inserter(fieldIndex.getInserter());
         _pushThreads.execute(fieldId,
@@ -203,5 +224,40 @@ DocumentInverter::pushDocuments(Dictionary &dict,
     }
 }
 
+
+void
+DocumentInverter::pushShardedDocuments(uint32_t fieldId,
+                                       MemoryFieldIndex &fieldIndex,
+                                       const std::shared_ptr<IDestructorCallback> &
+                                       onWriteDone)
+{
+    DocumentRemover &remover(fieldIndex.getDocumentRemover());
+    OrderedDocumentInserter &inserter(fieldIndex.getInserter());
+    std::mutex &removeLock(*_removeLocks[fieldId]);
+    const std::vector<FieldInverter *> &shards(_fieldShards[fieldId]);
+    auto sorted = std::make_shared<vespalib::CountDownLatch>(shards.size());
+    uint32_t shard = 0;
+    for (FieldInverter *inverter : shards) {
+        // Sort each shard on the thread that inverted it. The memory
+        // field index is not modified until all shards are sorted.
+        _invertThreads.execute(getShardComponentId(fieldId, shard),
+                               [inverter, &remover, &removeLock, sorted]()
+                               { {
+                                     std::lock_guard<std::mutex> guard(removeLock);
+                                     inverter->applyRemoves(remover);
+                                 }
+                                 inverter->sortDocuments();
+                                 sorted->countDown(); });
+        ++shard;
+    }
+    _pushThreads.execute(fieldId,
+                         [shards, &inserter, &fieldIndex, sorted, onWriteDone]()
+                         { sorted->await();
+                             for (FieldInverter *inverter : shards) {
+                                 inverter->pushSortedDocuments(inserter);
+                             }
+                             fieldIndex.commit(); });
+}
+
 }
 
@@ -4,6 +4,7 @@
 
 #include "i_document_remove_listener.h"
 #include <vespa/searchlib/index/doctypebuilder.h>
+#include <mutex>
 
 
 namespace search {
@@ -16,6 +17,7 @@ namespace search::memoryindex {
 class FieldInverter;
 class UrlFieldInverter;
 class Dictionary;
+class MemoryFieldIndex;
 
 class DocumentInverter
 {
@@ -43,10 +45,27 @@ private:
     DocTypeBuilder::SchemaIndexFields  _schemaIndexFields;
 
     std::vector<std::unique_ptr<FieldInverter>> _inverters;
+    // Inverters for shard 1 and up of sharded text fields
+    std::vector<std::unique_ptr<FieldInverter>> _shardInverters;
+    // All inverters for each field, documents are spread on docId
+    std::vector<std::vector<FieldInverter *>> _fieldShards;
+    // Serializes use of document remover when removes are applied for
+    // several shards of the same field in parallel
+    std::vector<std::unique_ptr<std::mutex>> _removeLocks;
     std::vector<std::unique_ptr<UrlFieldInverter>> _urlInverters;
     ISequencedTaskExecutor &_invertThreads;
     ISequencedTaskExecutor &_pushThreads;
 
+    FieldInverter *getShard(uint32_t fieldId, uint32_t docId) const {
+        const auto &shards = _fieldShards[fieldId];
+        return shards[docId % shards.size()];
+    }
+    uint64_t getShardComponentId(uint32_t fieldId, uint32_t shard) const {
+        return static_cast<uint64_t>(shard) * _inverters.size() + fieldId;
+    }
+    void pushShardedDocuments(uint32_t fieldId, MemoryFieldIndex &fieldIndex,
+                              const std::shared_ptr<IDestructorCallback> &onWriteDone);
+
     /**
      * Obtain the schema used by this index.
      *
@@ -58,11 +77,19 @@ public:
     /**
      * Create a new memory index based on the given schema.
      *
+     * Each text field can be split into several shards, spreading
+     * documents on docId. Shards are inverted and sorted in parallel
+     * on the invert threads, but are pushed one after another by the
+     * push thread for the field since the memory field index only
+     * supports a single writer. Uri fields are never sharded.
+     *
      * @param schema the index schema to use
+     * @param numFieldShards number of shards for each text field
      */
     DocumentInverter(const index::Schema &schema,
                      ISequencedTaskExecutor &invertThreads,
-                     ISequencedTaskExecutor &pushThreads);
+                     ISequencedTaskExecutor &pushThreads,
+                     uint32_t numFieldShards = 1);
 
     ~DocumentInverter();
 
@@ -96,6 +123,8 @@ public:
     const std::vector<std::unique_ptr<FieldInverter> > & getInverters() const { return _inverters; }
 
     uint32_t getNumFields() const { return _inverters.size(); }
+
+    uint32_t getNumShards(uint32_t fieldId) const { return _fieldShards[fieldId].size(); }
 };
 
 }
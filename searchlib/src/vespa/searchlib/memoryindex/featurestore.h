@@ -11,10 +11,19 @@ namespace search {
 
 namespace memoryindex {
 
+/**
+ * Storage for the compressed features (elements and word positions)
+ * of the postings in a memory field index. Features are only decoded
+ * when a posting is unpacked for ranking.
+ *
+ * Features are stored with byte alignment. A typical posting needs
+ * only a few bytes, so padding each posting to a wider alignment
+ * would waste a notable share of the store.
+ */
 class FeatureStore
 {
 public:
-    typedef datastore::DataStoreT<datastore::AlignedEntryRefT<22, 2> > DataStoreType;
+    typedef datastore::DataStoreT<datastore::AlignedEntryRefT<22, 0> > DataStoreType;
     typedef DataStoreType::RefType RefType;
     typedef bitcompression::EG2PosOccEncodeContext<true> EncodeContext;
     typedef bitcompression::EG2PosOccDecodeContextCooked<true>
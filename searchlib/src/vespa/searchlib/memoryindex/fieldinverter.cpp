@@ -106,11 +106,23 @@ void
 FieldInverter::processAnnotations(const StringFieldValue &value)
 {
     _terms.clear();
+    _termRefs.clear();
+    const vespalib::string &text = value.getValue();
+    if (_annotationReader.read(value, linguistics::SPANTREE_NAME, AnnotationType::TERM->getId())) {
+        // Common case, read without building the span tree.
+        for (const auto & entry : _annotationReader.entries()) {
+            if (entry.length > 0) {
+                _terms.emplace_back(Span(entry.from, entry.length), _termRefs.size());
+                _termRefs.emplace_back(entry.hasValue ? entry.value.data() : nullptr, entry.value.size());
+            }
+        }
+        processTerms(text);
+        return;
+    }
     StringFieldValue::SpanTrees spanTrees = value.getSpanTrees();
     const SpanTree *tree = StringFieldValue::findTree(spanTrees, linguistics::SPANTREE_NAME);
     if (tree == NULL) {
         /* This is wrong unless field is exact match */
-        const vespalib::string &text = value.getValue();
         if (text.empty())
             return;
         uint32_t wordRef = saveWord(text);
@@ -120,7 +132,6 @@ FieldInverter::processAnnotations(const StringFieldValue &value)
         }
         return;
     }
-    const vespalib::string &text = value.getValue();
     for (const Annotation & annotation : *tree) {
         const SpanNode *span = annotation.getSpanNode();
         if ((span != nullptr) && annotation.valid() &&
@@ -128,11 +139,23 @@ FieldInverter::processAnnotations(const StringFieldValue &value)
         {
             Span sp = getSpan(*span);
             if (sp.length() != 0) {
-                _terms.push_back(std::make_pair(sp,
-                                                annotation.getFieldValue()));
+                _terms.emplace_back(sp, _termRefs.size());
+                const FieldValue *fv = annotation.getFieldValue();
+                if (fv != nullptr) {
+                    assert(fv->getClass().id() == StringFieldValue::classId);
+                    _termRefs.push_back(fv->getAsRaw());
+                } else {
+                    _termRefs.emplace_back(nullptr, 0);
+                }
             }
         }
     }
+    processTerms(text);
+}
+
+void
+FieldInverter::processTerms(const vespalib::string &text)
+{
     std::sort(_terms.begin(), _terms.end());
     SpanTermVector::const_iterator it  = _terms.begin();
     SpanTermVector::const_iterator ite = _terms.end();
@@ -141,8 +164,9 @@ FieldInverter::processAnnotations(const StringFieldValue &value)
     for (; it != ite; ) {
         SpanTermVector::const_iterator it_begin = it;
         for (; it != ite && it->first == it_begin->first; ++it) {
-            if (it->second) {  // it->second is a const FieldValue *.
-                wordRef = saveWord(*it->second);
+            const TermRef &term = _termRefs[it->second];
+            if (term.first != nullptr) {
+                wordRef = saveWord(vespalib::stringref(term.first, term.second));
             } else {
                 const Span &iSpan = it->first;
                 assert(iSpan.from() >= 0);
@@ -267,16 +291,6 @@ FieldInverter::saveWord(const vespalib::stringref word)
 }
 
 
-uint32_t
-FieldInverter::saveWord(const document::FieldValue &fv)
-{
-    assert(fv.getClass().id() == StringFieldValue::classId);
-    typedef std::pair<const char*, size_t> RawRef;
-    RawRef sRef = fv.getAsRaw();
-    return saveWord(vespalib::stringref(sRef.first, sRef.second));
-}
-
-
 void
 FieldInverter::remove(const vespalib::stringref word, uint32_t docId)
 {
@@ -343,6 +357,8 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId)
       _elementWordRefs(),
       _wordRefs(1),
       _terms(),
+      _termRefs(),
+      _annotationReader(),
       _abortedDocs(),
       _pendingDocs(),
       _removeDocs()
@@ -488,11 +504,18 @@ FieldInverter::applyRemoves(DocumentRemover &remover)
 
 void
 FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter)
+{
+    sortDocuments();
+    pushSortedDocuments(inserter);
+}
+
+
+void
+FieldInverter::sortDocuments()
 {
     trimAbortedDocs();
 
     if (_positions.empty()) {
-        reset();
         return;             // All documents with words aborted
     }
 
@@ -501,6 +524,16 @@ FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter)
     // Sort for terms.
     ShiftBasedRadixSorter<PosInfo, FullRadix, std::less<PosInfo>, 56, true>::
         radix_sort(FullRadix(), std::less<PosInfo>(), &_positions[0], _positions.size(), 16);
+}
+
+
+void
+FieldInverter::pushSortedDocuments(IOrderedDocumentInserter &inserter)
+{
+    if (_positions.empty()) {
+        reset();
+        return;             // All documents with words aborted
+    }
 
     constexpr uint32_t NO_ELEMENT_ID = std::numeric_limits<uint32_t>::max();
     constexpr uint32_t NO_WORD_POS = std::numeric_limits<uint32_t>::max();
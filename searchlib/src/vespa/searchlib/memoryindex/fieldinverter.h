@@ -13,6 +13,7 @@
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/bitcompression/posocccompression.h>
 #include <vespa/document/annotation/span.h>
+#include <vespa/document/serialization/flatannotationreader.h>
 
 namespace search
 {
@@ -190,9 +191,14 @@ private:
     std::vector<uint32_t>          _elementWordRefs;
     std::vector<uint32_t>          _wordRefs;
 
-    typedef std::pair<document::Span, const document::FieldValue *> SpanTerm;
+    // Span and term number of the term annotations of a string value
+    typedef std::pair<document::Span, uint32_t> SpanTerm;
     typedef std::vector<SpanTerm> SpanTermVector;
+    // Term of each term annotation; nullptr if it is the spanned text
+    typedef std::pair<const char *, size_t> TermRef;
     SpanTermVector                      _terms;
+    std::vector<TermRef>                _termRefs;
+    document::FlatAnnotationReader      _annotationReader;
 
     // info about aborted and pending documents.
     std::vector<PositionRange>      _abortedDocs;
@@ -229,16 +235,6 @@ private:
     VESPA_DLL_LOCAL uint32_t
     saveWord(const vespalib::stringref word);
 
-    /**
-     * Save field value as word in word buffer.
-     *
-     * @param fv        field value containing word to be stored
-     *
-     * @return          word reference
-     */
-    VESPA_DLL_LOCAL uint32_t
-    saveWord(const document::FieldValue &fv);
-
     /**
      * Get pointer to saved word from a word reference.
      *
@@ -314,6 +310,14 @@ public:
     VESPA_DLL_LOCAL void
     processAnnotations(const document::StringFieldValue &value);
 
+private:
+    /**
+     * Add the collected term annotations, one word position per
+     * distinct span.
+     */
+    VESPA_DLL_LOCAL void
+    processTerms(const vespalib::string &text);
+
 private:
     void
     processNormalDocTextField(const document::StringFieldValue &field);
@@ -391,6 +395,24 @@ public:
     void
     pushDocuments(IOrderedDocumentInserter &inserter);
 
+    /**
+     * Drop aborted documents and sort the inverted documents on word
+     * and document id. This is the first half of pushDocuments(), and
+     * does not touch the memory index structure.
+     */
+    void
+    sortDocuments();
+
+    /**
+     * Push inverted documents already sorted by sortDocuments() to
+     * memory index structure. This is the second half of
+     * pushDocuments().
+     *
+     * @param inserter  ordered document inserter
+     */
+    void
+    pushSortedDocuments(IOrderedDocumentInserter &inserter);
+
     /*
      * Invert a normal text field, based on annotations.
      */
@@ -22,9 +22,44 @@ namespace search {
 using index::DocIdAndFeatures;
 using index::WordDocElementFeatures;
 using index::Schema;
+using vespalib::GenerationHeldBase;
 
 namespace memoryindex {
 
+namespace {
+
+using BitVectorEntries = std::vector<std::pair<uint32_t, std::shared_ptr<const BitVector>>>;
+
+/**
+ * Keeps replaced published bitvectors alive until no reader can use them.
+ * Bitvectors that are still published are shared with the new entries.
+ */
+class HeldBitVectorEntries : public GenerationHeldBase
+{
+    std::unique_ptr<const BitVectorEntries> _entries;
+public:
+    HeldBitVectorEntries(const BitVectorEntries *entries, size_t replacedBytes)
+        : GenerationHeldBase(entries->capacity() * sizeof(BitVectorEntries::value_type) + replacedBytes),
+          _entries(entries)
+    { }
+};
+
+struct BitVectorEntryLess {
+    template <typename Entry>
+    bool operator()(const Entry &lhs, uint32_t rhs) const {
+        return lhs.first < rhs;
+    }
+};
+
+struct WorkBitVectorLess {
+    template <typename Entry>
+    bool operator()(const Entry &lhs, uint32_t rhs) const {
+        return lhs._wordRef < rhs;
+    }
+};
+
+}
+
 vespalib::asciistream &
 operator<<(vespalib::asciistream & os, const MemoryFieldIndex::WordKey & rhs)
 {
@@ -32,8 +67,8 @@ operator<<(vespalib::asciistream & os, const MemoryFieldIndex::WordKey & rhs)
     return os;
 }
 
-MemoryFieldIndex::MemoryFieldIndex(const Schema & schema, uint32_t fieldId)
-    : _wordStore(),
+MemoryFieldIndex::MemoryFieldIndex(const Schema & schema, uint32_t fieldId, WordStore &wordStore)
+    : _wordStore(wordStore),
       _numUniqueWords(0),
       _generationHandler(),
       _dict(),
@@ -41,7 +76,12 @@ MemoryFieldIndex::MemoryFieldIndex(const Schema & schema, uint32_t fieldId)
       _featureStore(schema),
       _fieldId(fieldId),
       _remover(_wordStore),
-      _inserter(std::make_unique<OrderedDocumentInserter>(*this))
+      _inserter(std::make_unique<OrderedDocumentInserter>(*this)),
+      _bitVectorHolder(),
+      _bitVectors(),
+      _bitVectorsDirty(false),
+      _bitVectorEntries(nullptr),
+      _docIdLimit(1)
 { }
 
 MemoryFieldIndex::~MemoryFieldIndex()
@@ -69,6 +109,7 @@ MemoryFieldIndex::~MemoryFieldIndex()
     transferHoldLists();
     incGeneration();
     trimHoldLists();
+    delete _bitVectorEntries.load(std::memory_order_relaxed);
 }
 
 MemoryFieldIndex::PostingList::Iterator
@@ -95,6 +136,120 @@ MemoryFieldIndex::findFrozen(const vespalib::stringref word) const
     return PostingList::Iterator();
 }
 
+MemoryFieldIndex::PostingList::ConstIterator
+MemoryFieldIndex::findFrozen(const vespalib::stringref word, const BitVector *&bitVector) const
+{
+    bitVector = nullptr;
+    DictionaryTree::ConstIterator itr =
+        _dict.getFrozenView().find(WordKey(datastore::EntryRef()),
+                                   KeyComp(_wordStore, word));
+    if (itr.valid()) {
+        bitVector = findFrozenBitVector(itr.getKey()._wordRef);
+        return _postingListStore.beginFrozen(itr.getData());
+    }
+    return PostingList::Iterator();
+}
+
+const BitVector *
+MemoryFieldIndex::findFrozenBitVector(datastore::EntryRef wordRef) const
+{
+    const BitVectorEntries *entries = _bitVectorEntries.load(std::memory_order_acquire);
+    if (entries == nullptr) {
+        return nullptr;
+    }
+    auto itr = std::lower_bound(entries->begin(), entries->end(), wordRef.ref(), BitVectorEntryLess());
+    if (itr != entries->end() && itr->first == wordRef.ref()) {
+        return itr->second.get();
+    }
+    return nullptr;
+}
+
+void
+MemoryFieldIndex::addBitVector(datastore::EntryRef wordRef, datastore::EntryRef pidx)
+{
+    auto bv = std::make_unique<GrowableBitVector>(_docIdLimit, _docIdLimit, _bitVectorHolder);
+    _postingListStore.foreach_unfrozen_key(pidx, [&bv](uint32_t docId) { bv->setBit(docId); });
+    auto pos = std::lower_bound(_bitVectors.begin(), _bitVectors.end(), wordRef.ref(), WorkBitVectorLess());
+    _bitVectors.insert(pos, WorkBitVector{wordRef.ref(), std::move(bv), true});
+    _bitVectorsDirty = true;
+}
+
+void
+MemoryFieldIndex::publishBitVectors()
+{
+    if (!_bitVectorsDirty) {
+        return;
+    }
+    const BitVectorEntries *oldEntries = _bitVectorEntries.load(std::memory_order_relaxed);
+    auto newEntries = std::make_unique<BitVectorEntries>();
+    newEntries->reserve(_bitVectors.size());
+    auto oldItr = (oldEntries != nullptr) ? oldEntries->begin() : BitVectorEntries::const_iterator();
+    auto oldEnd = (oldEntries != nullptr) ? oldEntries->end() : BitVectorEntries::const_iterator();
+    size_t replacedBytes = 0;
+    for (WorkBitVector &work : _bitVectors) {
+        oldItr = std::lower_bound(oldItr, oldEnd, work._wordRef, BitVectorEntryLess());
+        bool published = (oldItr != oldEnd && oldItr->first == work._wordRef);
+        if (work._dirty || !published) {
+            // Readers get a private copy, so they never see a bitvector being modified.
+            auto copy = std::make_shared<AllocatedBitVector>(*work._bv);
+            copy->invalidateCachedCount();
+            copy->countTrueBits();
+            newEntries->emplace_back(work._wordRef, std::move(copy));
+            if (published) {
+                replacedBytes += static_cast<const AllocatedBitVector &>(*oldItr->second).extraByteSize();
+            }
+            work._dirty = false;
+        } else {
+            newEntries->emplace_back(*oldItr);
+        }
+    }
+    // Copies must be complete before readers can find them.
+    _bitVectorEntries.store(newEntries.release(), std::memory_order_release);
+    if (oldEntries != nullptr) {
+        _bitVectorHolder.hold(std::make_unique<HeldBitVectorEntries>(oldEntries, replacedBytes));
+    }
+    _bitVectorsDirty = false;
+}
+
+void
+MemoryFieldIndex::updateBitVector(datastore::EntryRef wordRef, datastore::EntryRef pidx,
+                                  const std::vector<PostingListKeyDataType> &adds,
+                                  const std::vector<uint32_t> &removes)
+{
+    if (!adds.empty()) {
+        _docIdLimit = std::max(_docIdLimit, adds.back()._key + 1);
+    }
+    auto work = std::lower_bound(_bitVectors.begin(), _bitVectors.end(), wordRef.ref(), WorkBitVectorLess());
+    if (work == _bitVectors.end() || work->_wordRef != wordRef.ref()) {
+        if (pidx.valid() && _postingListStore.size(pidx) >= getMinBitVectorDocFreq(_docIdLimit)) {
+            addBitVector(wordRef, pidx);
+        }
+        return;
+    }
+    if (adds.empty() && removes.empty()) {
+        return;
+    }
+    GrowableBitVector *bv = work->_bv.get();
+    work->_dirty = true;
+    _bitVectorsDirty = true;
+    for (uint32_t docId : removes) {
+        if (docId < bv->size()) {
+            bv->clearBit(docId);
+        }
+    }
+    if (!adds.empty() && adds.back()._key >= bv->size()) {
+        // Grow capacity ahead of the doc id limit to avoid reallocating on every extend.
+        uint32_t newSize = _docIdLimit;
+        if (newSize > bv->capacity()) {
+            bv->reserve(std::max(newSize, bv->capacity() + bv->capacity() / 2));
+        }
+        bv->extend(newSize);
+    }
+    for (const PostingListKeyDataType &add : adds) {
+        bv->setBit(add._key);
+    }
+}
+
 
 void
 MemoryFieldIndex::compactFeatures()
@@ -163,7 +318,6 @@ MemoryFieldIndex::dump(search::index::IndexBuilder & indexBuilder)
     vespalib::stringref word;
     FeatureStore::DecodeContextCooked decoder(NULL);
     DocIdAndFeatures features;
-    vespalib::Array<uint32_t> wordMap(_numUniqueWords + 1, 0);
     _featureStore.setupForField(_fieldId, decoder);
     for (DictionaryTree::Iterator itr = _dict.begin(); itr.valid(); ++itr) {
         const WordKey & wk = itr.getKey();
@@ -235,11 +389,23 @@ MemoryUsage
 MemoryFieldIndex::getMemoryUsage() const
 {
     MemoryUsage usage;
-    usage.merge(_wordStore.getMemoryUsage());
     usage.merge(_dict.getMemoryUsage());
     usage.merge(_postingListStore.getMemoryUsage());
     usage.merge(_featureStore.getMemoryUsage());
     usage.merge(_remover.getStore().getMemoryUsage());
+    for (const auto &work : _bitVectors) {
+        usage.incAllocatedBytes(work._bv->extraByteSize());
+        usage.incUsedBytes(work._bv->extraByteSize());
+    }
+    const BitVectorEntries *entries = _bitVectorEntries.load(std::memory_order_relaxed);
+    if (entries != nullptr) {
+        for (const auto &entry : *entries) {
+            size_t bytes = static_cast<const AllocatedBitVector &>(*entry.second).extraByteSize();
+            usage.incAllocatedBytes(bytes);
+            usage.incUsedBytes(bytes);
+        }
+    }
+    usage.incAllocatedBytesOnHold(_bitVectorHolder.getHeldBytes());
     return usage;
 }
 
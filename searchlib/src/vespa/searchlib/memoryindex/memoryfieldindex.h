@@ -9,10 +9,12 @@
 #include <vespa/searchlib/btree/btree.h>
 #include <vespa/searchlib/btree/btreenodeallocator.h>
 #include <vespa/searchlib/btree/btreestore.h>
+#include <vespa/searchlib/common/growablebitvector.h>
 #include <vespa/searchlib/index/docidandfeatures.h>
 #include <vespa/searchlib/index/indexbuilder.h>
 #include <vespa/searchlib/util/memoryusage.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <atomic>
 
 namespace search::memoryindex {
 
@@ -75,8 +77,17 @@ public:
                          const KeyComp> DictionaryTree;
 private:
     typedef vespalib::GenerationHandler GenerationHandler;
+    // word ref -> published bitvector, sorted on word ref
+    typedef std::pair<uint32_t, std::shared_ptr<const BitVector>> BitVectorEntry;
+    typedef std::vector<BitVectorEntry> BitVectorEntries;
+    // Bitvector updated by the push thread, copied to readers on commit
+    struct WorkBitVector {
+        uint32_t _wordRef;
+        std::unique_ptr<GrowableBitVector> _bv;
+        bool _dirty;
+    };
 
-    WordStore               _wordStore;
+    WordStore              &_wordStore;
     uint64_t                _numUniqueWords;
     GenerationHandler       _generationHandler;
     DictionaryTree          _dict;
@@ -85,6 +96,18 @@ private:
     uint32_t                _fieldId;
     DocumentRemover         _remover;
     std::unique_ptr<OrderedDocumentInserter> _inserter;
+    vespalib::GenerationHolder _bitVectorHolder;
+    // Sorted on word ref, only used by the push thread
+    std::vector<WorkBitVector> _bitVectors;
+    bool                    _bitVectorsDirty;
+    // Replaced (copy on write) on commit when bitvectors have changed.
+    // Readers only see bitvector copies matching the frozen posting lists.
+    std::atomic<const BitVectorEntries *> _bitVectorEntries;
+    uint32_t                _docIdLimit;
+
+    const BitVector *findFrozenBitVector(datastore::EntryRef wordRef) const;
+    void addBitVector(datastore::EntryRef wordRef, datastore::EntryRef pidx);
+    void publishBitVectors();
 
 public:
     datastore::EntryRef addWord(const vespalib::stringref word) {
@@ -98,20 +121,61 @@ public:
         return _featureStore.addFeatures(_fieldId, features).first;
     }
 
-    MemoryFieldIndex(const index::Schema &schema, uint32_t fieldId);
+    MemoryFieldIndex(const index::Schema &schema, uint32_t fieldId, WordStore &wordStore);
     ~MemoryFieldIndex();
     PostingList::Iterator find(const vespalib::stringref word) const;
 
     PostingList::ConstIterator
     findFrozen(const vespalib::stringref word) const;
 
+    /**
+     * As above, but also returns the bitvector for the word in
+     * bitVector if the word has one, or nullptr if not. The caller
+     * must hold a generation guard while using the bitvector.
+     */
+    PostingList::ConstIterator
+    findFrozen(const vespalib::stringref word, const BitVector *&bitVector) const;
+
+    /**
+     * Mirrors changes applied to the posting list of the word into its
+     * bitvector. A bitvector is created when the posting list gets as
+     * large as getMinBitVectorDocFreq(). Once created, a bitvector is
+     * kept until the memory index is dropped. Changes become visible
+     * to readers on the next commit.
+     */
+    void updateBitVector(datastore::EntryRef wordRef, datastore::EntryRef pidx,
+                         const std::vector<PostingListKeyDataType> &adds,
+                         const std::vector<uint32_t> &removes);
+
+    /**
+     * Returns the number of documents a word must be present in to get
+     * a bitvector, using the same limit as the disk index. A bitvector
+     * then uses no more memory than the posting list.
+     */
+    static uint32_t getMinBitVectorDocFreq(uint32_t docIdLimit) {
+        uint32_t ret = (docIdLimit + 63) / 64;
+        return std::max(ret, 16u);
+    }
+
+    size_t getNumBitVectors() const { return _bitVectors.size(); }
+
     uint64_t getNumUniqueWords() const { return _numUniqueWords; }
     const FeatureStore & getFeatureStore() const { return _featureStore; }
     const WordStore &getWordStore() const { return _wordStore; }
     OrderedDocumentInserter &getInserter() const { return *_inserter; }
 
+    /**
+     * Select whether new buffers for the dictionary tree and the posting
+     * lists should be backed by huge pages.
+     **/
+    void setHugePages(bool hugePages) {
+        _dict.setHugePages(hugePages);
+        _postingListStore.setHugePages(hugePages);
+    }
+
 private:
     void freeze() {
+        publishBitVectors();
         _postingListStore.freeze();
         _dict.getAllocator().freeze();
     }
@@ -124,6 +188,7 @@ private:
         _postingListStore.trimHoldLists(usedGen);
         _dict.getAllocator().trimHoldLists(usedGen);
         _featureStore.trimHoldLists(usedGen);
+        _bitVectorHolder.trimHoldLists(usedGen);
     }
 
     void
@@ -134,6 +199,7 @@ private:
         _postingListStore.transferHoldLists(generation);
         _dict.getAllocator().transferHoldLists(generation);
         _featureStore.transferHoldLists(generation);
+        _bitVectorHolder.transferHoldLists(generation);
     }
 
     void
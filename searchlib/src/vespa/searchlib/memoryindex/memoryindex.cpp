@@ -3,13 +3,20 @@
 #include "memoryindex.h"
 #include "postingiterator.h"
 #include "documentinverter.h"
+#include "ordereddocumentinserter.h"
+#include <vespa/searchlib/index/docidandfeatures.h>
+#include <vespa/searchlib/index/indexbuilder.h>
 #include <vespa/searchlib/index/schemautil.h>
 #include <vespa/searchlib/queryeval/create_blueprint_visitor_helper.h>
 #include <vespa/searchlib/queryeval/booleanmatchiteratorwrapper.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/searchlib/queryeval/equiv_blueprint.h>
 #include <vespa/searchlib/queryeval/leaf_blueprints.h>
+#include <vespa/searchlib/common/bitvectoriterator.h>
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
 #include <vespa/searchlib/btree/btreenodeallocator.hpp>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.memoryindex.memoryindex");
@@ -22,6 +29,7 @@ using vespalib::GenerationHandler;
 namespace search {
 
 using fef::TermFieldMatchDataArray;
+using index::DocIdAndFeatures;
 using index::IndexBuilder;
 using index::Schema;
 using index::SchemaUtil;
@@ -32,6 +40,7 @@ using query::PredicateQuery;
 using query::PrefixTerm;
 using query::RangeTerm;
 using query::RegExpTerm;
+using query::NearestNeighborTerm;
 using query::StringTerm;
 using query::SubstringTerm;
 using query::SuffixTerm;
@@ -41,6 +50,7 @@ using queryeval::CreateBlueprintVisitorHelper;
 using queryeval::Blueprint;
 using queryeval::BooleanMatchIteratorWrapper;
 using queryeval::EmptyBlueprint;
+using queryeval::EquivBlueprint;
 using queryeval::FieldSpecBase;
 using queryeval::FieldSpecBaseList;
 using queryeval::FieldSpec;
@@ -50,14 +60,35 @@ using queryeval::IRequestContext;
 
 namespace search::memoryindex {
 
+namespace {
+
+/*
+ * Split text fields into shards when there are more invert threads
+ * than index fields, to avoid a single large field limiting the feed
+ * rate to what one thread can invert.
+ */
+uint32_t
+calcNumFieldShards(const Schema &schema, const ISequencedTaskExecutor &invertThreads)
+{
+    uint32_t numFields = schema.getNumIndexFields();
+    if (numFields == 0) {
+        return 1u;
+    }
+    return std::max(1u, invertThreads.getNumExecutors() / numFields);
+}
+
+}
+
 MemoryIndex::MemoryIndex(const Schema &schema,
                          ISequencedTaskExecutor &invertThreads,
                          ISequencedTaskExecutor &pushThreads)
     : _schema(schema),
       _invertThreads(invertThreads),
       _pushThreads(pushThreads),
-      _inverter0(std::make_unique<DocumentInverter>(_schema, _invertThreads, _pushThreads)),
-      _inverter1(std::make_unique<DocumentInverter>(_schema, _invertThreads, _pushThreads)),
+      _inverter0(std::make_unique<DocumentInverter>(_schema, _invertThreads, _pushThreads,
+                                                    calcNumFieldShards(_schema, _invertThreads))),
+      _inverter1(std::make_unique<DocumentInverter>(_schema, _invertThreads, _pushThreads,
+                                                    calcNumFieldShards(_schema, _invertThreads))),
       _inverter(_inverter0.get()),
       _dictionary(std::make_unique<Dictionary>(_schema)),
       _frozen(false),
@@ -77,6 +108,12 @@ MemoryIndex::~MemoryIndex()
     _pushThreads.sync();
 }
 
+void
+MemoryIndex::setHugePages(bool hugePages)
+{
+    _dictionary->setHugePages(hugePages);
+}
+
 void
 MemoryIndex::insertDocument(uint32_t docId, const document::Document &doc)
 {
@@ -136,18 +173,174 @@ MemoryIndex::dump(IndexBuilder &indexBuilder)
 
 namespace {
 
+const uint32_t CHECKPOINT_VERSION = 1;
+
+/*
+ * Serializes the (word, docId, features) tuples dumped from all
+ * fields. The docs of a word end with docId 0 and the words of a
+ * field end with an empty word, neither of which is ever indexed.
+ */
+class CheckpointWriter : public IndexBuilder
+{
+    vespalib::nbostream &_os;
+    DocIdAndFeatures     _features;
+
+public:
+    CheckpointWriter(const Schema &schema, vespalib::nbostream &os)
+        : IndexBuilder(schema),
+          _os(os),
+          _features()
+    {
+    }
+
+    void startWord(const vespalib::stringref &word) override { _os << word; }
+    void endWord() override { _os << uint32_t(0); }
+    void startDocument(uint32_t docId) override { _features.clear(docId); }
+    void endDocument() override {
+        _os << _features._docId << uint32_t(_features._elements.size());
+        for (const auto &element : _features._elements) {
+            _os << element.getElementId() << element.getWeight() << element.getElementLen() << element.getNumOccs();
+        }
+        for (const auto &wordPos : _features._wordPositions) {
+            _os << wordPos.getWordPos();
+        }
+    }
+    void startField(uint32_t) override { }
+    void endField() override { _os << vespalib::stringref(); }
+    void startElement(uint32_t elementId, int32_t weight, uint32_t elementLen) override {
+        _features._elements.emplace_back(elementId, weight, elementLen);
+    }
+    void endElement() override { }
+    void addOcc(const index::WordDocElementWordPosFeatures &features) override {
+        _features._elements.back().incNumOccs();
+        _features._wordPositions.push_back(features);
+    }
+};
+
+void
+readFeatures(vespalib::nbostream &is, uint32_t docId, DocIdAndFeatures &features)
+{
+    features.clear(docId);
+    uint32_t numElements = 0;
+    uint32_t numOccs = 0;
+    is >> numElements;
+    for (uint32_t i = 0; i < numElements; ++i) {
+        uint32_t elementId = 0;
+        int32_t weight = 0;
+        uint32_t elementLen = 0;
+        uint32_t elementOccs = 0;
+        is >> elementId >> weight >> elementLen >> elementOccs;
+        features._elements.emplace_back(elementId, weight, elementLen);
+        features._elements.back().setNumOccs(elementOccs);
+        numOccs += elementOccs;
+    }
+    for (uint32_t i = 0; i < numOccs; ++i) {
+        uint32_t wordPos = 0;
+        is >> wordPos;
+        features._wordPositions.emplace_back(wordPos);
+    }
+}
+
+}
+
+void
+MemoryIndex::saveCheckpoint(vespalib::nbostream &os)
+{
+    os << CHECKPOINT_VERSION << _schema.getNumIndexFields();
+    for (const auto &field : _schema.getIndexFields()) {
+        os << field.getName();
+    }
+    std::vector<uint32_t> docIds(_indexedDocs.begin(), _indexedDocs.end());
+    std::sort(docIds.begin(), docIds.end());
+    os << _maxDocId << docIds;
+    CheckpointWriter writer(_schema, os);
+    _dictionary->dump(writer);
+}
+
+bool
+MemoryIndex::loadCheckpoint(vespalib::nbostream &is)
+{
+    assert(_indexedDocs.empty());
+    uint32_t version = 0;
+    uint32_t numFields = 0;
+    is >> version >> numFields;
+    if (version != CHECKPOINT_VERSION) {
+        return false;
+    }
+    std::vector<uint32_t> fieldIds;
+    for (uint32_t i = 0; i < numFields; ++i) {
+        vespalib::string name;
+        is >> name;
+        fieldIds.push_back(_schema.getIndexFieldId(name));
+    }
+    uint32_t maxDocId = 0;
+    std::vector<uint32_t> docIds;
+    is >> maxDocId >> docIds;
+    updateMaxDocId(maxDocId);
+    for (uint32_t docId : docIds) {
+        if (_indexedDocs.insert(docId).second) {
+            incNumDocs();
+        }
+    }
+    DocIdAndFeatures features;
+    for (uint32_t fieldId : fieldIds) {
+        // Fields removed from the schema are read and dropped, as by pruneRemovedFields()
+        bool known = (fieldId != Schema::UNKNOWN_FIELD_ID);
+        MemoryFieldIndex *fieldIndex = known ? _dictionary->getFieldIndex(fieldId) : nullptr;
+        OrderedDocumentInserter *inserter = known ? &fieldIndex->getInserter() : nullptr;
+        if (known) {
+            inserter->rewind();
+        }
+        // The inserter refers to the previous word, so alternate between two buffers
+        vespalib::string words[2];
+        uint32_t cur = 0;
+        for (is >> words[cur]; !words[cur].empty(); cur ^= 1, is >> words[cur]) {
+            if (known) {
+                inserter->setNextWord(words[cur]);
+            }
+            uint32_t docId = 0;
+            for (is >> docId; docId != 0; is >> docId) {
+                readFeatures(is, docId, features);
+                if (known) {
+                    inserter->add(docId, features);
+                }
+            }
+        }
+        if (known) {
+            inserter->flush();
+            fieldIndex->commit();
+        }
+    }
+    return true;
+}
+
+namespace {
+
+bool
+areAnyParentsEquiv(const Blueprint * node)
+{
+    return (node == NULL)
+           ? false
+           : (dynamic_cast<const EquivBlueprint *>(node) != NULL)
+             ? true
+             : areAnyParentsEquiv(node->getParent());
+}
+
 class MemTermBlueprint : public queryeval::SimpleLeafBlueprint
 {
 private:
     GenerationHandler::Guard               _genGuard;
     Dictionary::PostingList::ConstIterator _pitr;
+    const BitVector                       *_bitVector;
     const FeatureStore                    &_featureStore;
     const uint32_t                         _fieldId;
     const bool                             _useBitVector;
+    bool                                   _hasEquivParent;
 
 public:
     MemTermBlueprint(GenerationHandler::Guard &&genGuard,
                      Dictionary::PostingList::ConstIterator pitr,
+                     const BitVector *bitVector,
                      const FeatureStore &featureStore,
                      const FieldSpecBase &field,
                      uint32_t fieldId,
@@ -155,17 +348,29 @@ public:
         : SimpleLeafBlueprint(field),
           _genGuard(),
           _pitr(pitr),
+          _bitVector(bitVector),
           _featureStore(featureStore),
           _fieldId(fieldId),
-          _useBitVector(useBitVector)
+          _useBitVector(useBitVector),
+          _hasEquivParent(false)
     {
         _genGuard = std::move(genGuard);
         HitEstimate estimate(_pitr.size(), !_pitr.valid());
         setEstimate(estimate);
     }
 
+    void fetchPostings(bool strict) override {
+        (void) strict;
+        _hasEquivParent = areAnyParentsEquiv(getParent());
+    }
+
     SearchIterator::UP
-    createLeafSearch(const TermFieldMatchDataArray &tfmda, bool) const override {
+    createLeafSearch(const TermFieldMatchDataArray &tfmda, bool strict) const override {
+        if ((_bitVector != nullptr) && (_useBitVector || (tfmda[0]->isNotNeeded() && !_hasEquivParent))) {
+            LOG(debug, "Return BitVectorIterator: fieldId(%u), docCount(%zu)",
+                _fieldId, _pitr.size());
+            return BitVectorIterator::create(_bitVector, tfmda, strict);
+        }
         SearchIterator::UP search(new PostingIterator(_pitr, _featureStore, _fieldId, tfmda));
         if (_useBitVector) {
             LOG(debug, "Return BooleanMatchIteratorWrapper: fieldId(%u), docCount(%zu)",
@@ -207,10 +412,11 @@ public:
             termStr.c_str(), _field.getName().c_str());
         MemoryFieldIndex *fieldIndex = _dictionary.getFieldIndex(_fieldId);
         GenerationHandler::Guard genGuard = fieldIndex->takeGenerationGuard();
+        const BitVector *bitVector = nullptr;
         Dictionary::PostingList::ConstIterator pitr
-            = fieldIndex->findFrozen(termStr);
+            = fieldIndex->findFrozen(termStr, bitVector);
         bool useBitVector = _field.isFilter();
-        setResult(make_UP(new MemTermBlueprint(std::move(genGuard), pitr,
+        setResult(make_UP(new MemTermBlueprint(std::move(genGuard), pitr, bitVector,
                                                fieldIndex->getFeatureStore(),
                                               _field, _fieldId, useBitVector)));
     }
@@ -223,6 +429,7 @@ public:
     void visit(SuffixTerm &n)    override { visitTerm(n); }
     void visit(RegExpTerm &n)    override { visitTerm(n); }
     void visit(PredicateQuery &) override { }
+    void visit(NearestNeighborTerm &) override { }
 
     void visit(NumberTerm &n) override {
         handleNumberTermAsText(n);
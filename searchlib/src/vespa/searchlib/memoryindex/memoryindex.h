@@ -14,6 +14,8 @@ namespace search { class ISequencedTaskExecutor; }
 
 namespace document { class Document; }
 
+namespace vespalib { class nbostream; }
+
 namespace search::memoryindex {
 
 class DocumentInverter;
@@ -99,6 +101,15 @@ public:
      **/
     bool isFrozen() const { return _frozen; }
 
+    /**
+     * Select whether the dictionaries of this index should allocate
+     * new buffers backed by huge pages. Must be called before any
+     * documents are inserted.
+     *
+     * @param hugePages true to use huge pages
+     **/
+    void setHugePages(bool hugePages);
+
     /**
      * Insert a document into the index. If the document is already in
      * the index, the old version will be removed first.
@@ -138,6 +149,26 @@ public:
      **/
     void dump(index::IndexBuilder &indexBuilder);
 
+    /**
+     * Serialize the committed content of this index into the given
+     * stream, as a checkpoint image that can be loaded into an empty
+     * index with the same index fields.
+     *
+     * @param os the stream to serialize into
+     **/
+    void saveCheckpoint(vespalib::nbostream &os);
+
+    /**
+     * Load a checkpoint image made by saveCheckpoint() into this
+     * empty index. The postings are inserted directly, without
+     * inverting any documents. Fields are matched by name; fields
+     * not in the schema of this index are dropped.
+     *
+     * @param is the stream to load from
+     * @return false if the image has an unknown version
+     **/
+    bool loadCheckpoint(vespalib::nbostream &is);
+
     // implements Searchable
     queryeval::Blueprint::UP
     createBlueprint(const queryeval::IRequestContext & requestContext,
@@ -64,6 +64,7 @@ OrderedDocumentInserter::flushWord()
         std::atomic_thread_fence(std::memory_order_release);
         _dItr.writeData(pidx.ref());
     }
+    _fieldIndex.updateBitVector(_dItr.getKey()._wordRef, pidx, _adds, _removes);
     _removes.clear();
     _adds.clear();
 }
@@ -2,11 +2,14 @@
 
 #include "wordstore.h"
 #include <vespa/searchlib/datastore/datastore.hpp>
+#include <vespa/vespalib/stllike/hash_fun.h>
+#include <cstring>
 
 namespace search {
 namespace memoryindex {
 
 constexpr size_t MIN_CLUSTERS = 1024;
+constexpr size_t MIN_WORD_REFS = 1024;
 
 WordStore::WordStore()
     : _store(),
@@ -14,7 +17,9 @@ WordStore::WordStore()
       _type(RefType::align(1),
             MIN_CLUSTERS,
             RefType::offsetSize() / RefType::align(1)),
-      _typeId(0)
+      _typeId(0),
+      _wordRefs(MIN_WORD_REFS),
+      _lock()
 {
     _store.addType(&_type);
     _store.initActiveBuffers();
@@ -28,6 +33,61 @@ WordStore::~WordStore()
 
 datastore::EntryRef
 WordStore::addWord(const vespalib::stringref word)
+{
+    size_t hash = vespalib::hashValue(word.data(), word.size());
+    std::lock_guard<std::mutex> guard(_lock);
+    size_t mask = _wordRefs.size() - 1;
+    for (size_t i = hash & mask; _wordRefs[i].valid(); i = (i + 1) & mask) {
+        const char *stored = getWord(_wordRefs[i]);
+        if (strncmp(stored, word.data(), word.size()) == 0 && stored[word.size()] == '\0') {
+            return _wordRefs[i];
+        }
+    }
+    datastore::EntryRef ref = allocWord(word);
+    ++_numWords;
+    if (_numWords * 4 > _wordRefs.size() * 3) {
+        growWordRefs();
+    }
+    insertWordRef(ref, hash);
+    return ref;
+}
+
+void
+WordStore::insertWordRef(datastore::EntryRef ref, size_t hash)
+{
+    size_t mask = _wordRefs.size() - 1;
+    size_t i = hash & mask;
+    while (_wordRefs[i].valid()) {
+        i = (i + 1) & mask;
+    }
+    _wordRefs[i] = ref;
+}
+
+void
+WordStore::growWordRefs()
+{
+    std::vector<datastore::EntryRef> oldWordRefs(_wordRefs.size() * 2);
+    oldWordRefs.swap(_wordRefs);
+    for (datastore::EntryRef ref : oldWordRefs) {
+        if (ref.valid()) {
+            const char *word = getWord(ref);
+            insertWordRef(ref, vespalib::hashValue(word, strlen(word)));
+        }
+    }
+}
+
+MemoryUsage
+WordStore::getMemoryUsage() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    MemoryUsage usage = _store.getMemoryUsage();
+    usage.incAllocatedBytes(_wordRefs.capacity() * sizeof(datastore::EntryRef));
+    usage.incUsedBytes(_wordRefs.size() * sizeof(datastore::EntryRef));
+    return usage;
+}
+
+datastore::EntryRef
+WordStore::allocWord(const vespalib::stringref word)
 {
     size_t wordSize = word.size() + 1;
     size_t bufferSize = RefType::align(wordSize);
@@ -40,7 +100,6 @@ WordStore::addWord(const vespalib::stringref word)
     for (size_t i = wordSize; i < bufferSize; ++i) {
         *be++ = 0;
     }
-    ++_numWords;
     return result.ref;
 }
 
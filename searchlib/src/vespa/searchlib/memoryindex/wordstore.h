@@ -4,10 +4,26 @@
 
 #include <vespa/searchlib/datastore/datastore.h>
 #include <vespa/vespalib/stllike/string.h>
+#include <mutex>
+#include <vector>
 
 namespace search {
 namespace memoryindex {
 
+/**
+ * Store of the words in a memory index, shared by the dictionaries of
+ * all its fields. Each distinct word is stored once, as a zero
+ * terminated string, so fields sharing the same analysis (e.g. the
+ * parts of url fields) do not duplicate their words.
+ *
+ * Words are added from the push threads of several fields, under a
+ * lock, and are never removed. A small buffer may be grown by copying
+ * it (fallback resize), but the old copy stays on the data store hold
+ * list until the store is destroyed. Those hold lists are never
+ * trimmed, since readers are tracked by the generation handlers of the
+ * individual fields. Words handed out to readers therefore stay valid,
+ * and readers may get words without locking.
+ */
 class WordStore
 {
 public:
@@ -19,10 +35,23 @@ private:
     uint32_t                _numWords;
     datastore::BufferType<char> _type;
     const uint32_t          _typeId;
+    // Open addressing hash table of the refs of all words, used by
+    // writers to find words already stored. Size is a power of two.
+    std::vector<datastore::EntryRef> _wordRefs;
+    mutable std::mutex      _lock;
+
+    datastore::EntryRef allocWord(const vespalib::stringref word);
+    void insertWordRef(datastore::EntryRef ref, size_t hash);
+    void growWordRefs();
 
 public:
     WordStore();
     ~WordStore();
+
+    /**
+     * Returns the ref of the given word, adding it to the store if not
+     * already present. Safe to call from multiple threads.
+     */
     datastore::EntryRef addWord(const vespalib::stringref word);
     const char * getWord(datastore::EntryRef ref) const
     {
@@ -31,8 +60,16 @@ public:
                                            internalRef.offset());
     }
 
-    MemoryUsage getMemoryUsage() const {
-        return _store.getMemoryUsage();
+    uint32_t getNumWords() const {
+        std::lock_guard<std::mutex> guard(_lock);
+        return _numWords;
+    }
+
+    MemoryUsage getMemoryUsage() const;
+
+    void setHugePages(bool hugePages) {
+        std::lock_guard<std::mutex> guard(_lock);
+        _store.setHugePages(hugePages);
     }
 };
 
@@ -161,6 +161,17 @@ ParseItem::AppendBuffer(RawBuf *buf) const
             buf->append(_term.c_str(), termLen);
         }
         break;
+    case ITEM_NEAREST_NEIGHBOR:
+        buf->appendCompressedPositiveNumber(indexLen);
+        if (indexLen != 0) {
+            buf->append(_indexName.c_str(), indexLen);
+        }
+        buf->appendCompressedPositiveNumber(termLen);
+        if (termLen != 0) {
+            buf->append(_term.c_str(), termLen);
+        }
+        buf->appendCompressedPositiveNumber(_arg1); // targetNumHits
+        break;
     case ITEM_UNDEF:
     default:
         break;
@@ -222,6 +233,9 @@ ParseItem::GetBufferLen() const
     case ITEM_REGEXP:
         len += sizeof(uint32_t) * 2 + indexLen + termLen;
         break;
+    case ITEM_NEAREST_NEIGHBOR:
+        len += sizeof(uint32_t) * 3 + indexLen + termLen;
+        break;
     case ITEM_PURE_WEIGHTED_STRING:
         len += sizeof(uint32_t) + termLen;
         break;
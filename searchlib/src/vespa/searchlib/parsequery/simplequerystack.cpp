@@ -114,6 +114,7 @@ public:
         _name[ParseItem::ITEM_WAND] = 'A';
         _name[ParseItem::ITEM_PREDICATE_QUERY] = 'P';
         _name[ParseItem::ITEM_REGEXP] = '^';
+        _name[ParseItem::ITEM_NEAREST_NEIGHBOR] = 'n';
     }
     char operator[] (ParseItem::ItemType i) const { return _name[i]; }
     char operator[] (size_t i) const { return _name[i]; }
@@ -251,6 +252,21 @@ SimpleQueryStack::StackbufToString(const vespalib::stringref &theBuf)
                                             idxRefLen, idxRefLen, idxRef,
                                             termRefLen, termRefLen, termRef));
             break;
+        case ParseItem::ITEM_NEAREST_NEIGHBOR:
+            p += vespalib::compress::Integer::decompressPositive(tmp, p);
+            idxRefLen = tmp;
+            idxRef = p;
+            p += idxRefLen;
+            p += vespalib::compress::Integer::decompressPositive(tmp, p);
+            termRefLen = tmp;
+            termRef = p;
+            p += termRefLen;
+            p += vespalib::compress::Integer::decompressPositive(tmp, p);
+            arg1 = tmp;
+            result.append(make_string("%c/%d:%.*s/%d:%.*s/%d~", _G_ItemName[type],
+                                            idxRefLen, idxRefLen, idxRef,
+                                            termRefLen, termRefLen, termRef, arg1));
+            break;
         case ParseItem::ITEM_PURE_WEIGHTED_STRING:
             p += vespalib::compress::Integer::decompressPositive(tmp, p);
             termRefLen = tmp;
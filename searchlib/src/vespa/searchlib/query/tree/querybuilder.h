@@ -202,6 +202,13 @@ createRegExpTerm(const vespalib::stringref &term, const vespalib::stringref &vie
     return new typename NodeTypes::RegExpTerm(term, view, id, weight);
 }
 
+template <class NodeTypes>
+typename NodeTypes::NearestNeighborTerm *
+create_nearest_neighbor_term(vespalib::stringref query_tensor_name, vespalib::stringref field_name,
+                             int32_t id, Weight weight, uint32_t target_num_hits) {
+    return new typename NodeTypes::NearestNeighborTerm(query_tensor_name, field_name, id, weight, target_num_hits);
+}
+
 template <class NodeTypes>
 class QueryBuilder : public QueryBuilderBase {
     template <class T>
@@ -309,6 +316,13 @@ public:
         adjustWeight(weight);
         return addTerm(createRegExpTerm<NodeTypes>(term, view, id, weight));
     }
+    typename NodeTypes::NearestNeighborTerm &add_nearest_neighbor_term(const stringref &query_tensor_name,
+                                                                       const stringref &field_name,
+                                                                       int32_t id, Weight weight,
+                                                                       uint32_t target_num_hits) {
+        adjustWeight(weight);
+        return addTerm(create_nearest_neighbor_term<NodeTypes>(query_tensor_name, field_name, id, weight, target_num_hits));
+    }
 };
 
 }
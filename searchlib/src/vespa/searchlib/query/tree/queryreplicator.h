@@ -164,6 +164,13 @@ private:
                           node.getTerm(), node.getView(),
                           node.getId(), node.getWeight()));
     }
+
+    void visit(NearestNeighborTerm &node) override {
+        replicate(node, _builder.add_nearest_neighbor_term(
+                          node.get_query_tensor_name(), node.getView(),
+                          node.getId(), node.getWeight(),
+                          node.get_target_num_hits()));
+    }
 };
 
 }
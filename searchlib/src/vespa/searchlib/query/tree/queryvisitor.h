@@ -25,6 +25,7 @@ class DotProduct;
 class WandTerm;
 class PredicateQuery;
 class RegExpTerm;
+class NearestNeighborTerm;
 class SameElement;
 
 struct QueryVisitor {
@@ -52,6 +53,7 @@ struct QueryVisitor {
     virtual void visit(WandTerm &) = 0;
     virtual void visit(PredicateQuery &) = 0;
     virtual void visit(RegExpTerm &) = 0;
+    virtual void visit(NearestNeighborTerm &) = 0;
 };
 
 }
@@ -103,6 +103,12 @@ struct SimpleRegExpTerm : RegExpTerm {
         : RegExpTerm(term, view, id, weight) {
     }
 };
+struct SimpleNearestNeighborTerm : NearestNeighborTerm {
+    SimpleNearestNeighborTerm(vespalib::stringref query_tensor_name, vespalib::stringref field_name,
+                              int32_t id, Weight weight, uint32_t target_num_hits)
+        : NearestNeighborTerm(query_tensor_name, field_name, id, weight, target_num_hits) {
+    }
+};
 
 
 struct SimpleQueryNodeTypes {
@@ -128,6 +134,7 @@ struct SimpleQueryNodeTypes {
     typedef SimpleWandTerm WandTerm;
     typedef SimplePredicateQuery PredicateQuery;
     typedef SimpleRegExpTerm RegExpTerm;
+    typedef SimpleNearestNeighborTerm NearestNeighborTerm;
 };
 
 }
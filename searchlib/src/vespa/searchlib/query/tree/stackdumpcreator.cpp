@@ -255,6 +255,26 @@ class QueryNodeConverter : public QueryVisitor {
         createTerm(node, ParseItem::ITEM_REGEXP);
     }
 
+    void visit(NearestNeighborTerm &node) override {
+        uint8_t typefield = ParseItem::ITEM_NEAREST_NEIGHBOR | ParseItem::IF_WEIGHT | ParseItem::IF_UNIQUEID;
+        uint8_t flags = 0;
+        if (!node.isRanked()) {
+            flags |= ParseItem::IFLAG_NORANK;
+        }
+        if (flags != 0) {
+            typefield |= ParseItem::IF_FLAGS;
+        }
+        appendByte(typefield);
+        appendCompressedNumber(node.getWeight().percent());
+        appendCompressedPositiveNumber(node.getId());
+        if (typefield & ParseItem::IF_FLAGS) {
+            appendByte(flags);
+        }
+        appendString(node.getView());
+        appendString(node.get_query_tensor_name());
+        appendCompressedPositiveNumber(node.get_target_num_hits());
+    }
+
 public:
     QueryNodeConverter()
         : _buf(4096)
@@ -147,6 +147,8 @@ private:
                 t = &builder.addPredicateQuery(queryStack.getPredicateQueryTerm(), view, id, weight);
             } else if (type == ParseItem::ITEM_REGEXP) {
                 t = &builder.addRegExpTerm(term, view, id, weight);
+            } else if (type == ParseItem::ITEM_NEAREST_NEIGHBOR) {
+                t = &builder.add_nearest_neighbor_term(term, view, id, weight, queryStack.getArg1());
             } else {
                 LOG(error, "Unable to create query tree from stack dump. node type = %d.", type);
             }
@@ -113,5 +113,30 @@ public:
     virtual ~RegExpTerm() = 0;
 };
 
+//-----------------------------------------------------------------------------
+
+/**
+ * Term searching for the documents closest to a query tensor in a
+ * dense tensor field. The view is the tensor field, and the query
+ * tensor is looked up in the query properties using its name.
+ */
+class NearestNeighborTerm : public QueryNodeMixin<NearestNeighborTerm, TermNode>
+{
+private:
+    vespalib::string _query_tensor_name;
+    uint32_t _target_num_hits;
+
+public:
+    NearestNeighborTerm(vespalib::stringref query_tensor_name, vespalib::stringref field_name,
+                        int32_t id, Weight weight, uint32_t target_num_hits)
+        : QueryNodeMixinType(field_name, id, weight),
+          _query_tensor_name(query_tensor_name),
+          _target_num_hits(target_num_hits)
+    {}
+    virtual ~NearestNeighborTerm() = 0;
+    const vespalib::string &get_query_tensor_name() const { return _query_tensor_name; }
+    uint32_t get_target_num_hits() const { return _target_num_hits; }
+};
+
 
 }
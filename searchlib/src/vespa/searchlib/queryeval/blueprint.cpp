@@ -161,6 +161,9 @@ void
 StateCache::updateState() const
 {
     calculateState().swap(_state);
+    if (_has_sampled_estimate) {
+        _state.estimate(_sampled_estimate);
+    }
     _stale = false;
 }
 
@@ -301,6 +304,21 @@ IntermediateBlueprint::should_do_termwise_eval(const UnpackInfo &unpack, double
     return (count_termwise_nodes(unpack) > 1);
 }
 
+bool
+IntermediateBlueprint::has_many_termwise_children(const UnpackInfo &unpack, uint32_t child_limit) const
+{
+    if (child_limit == 0) {
+        return false;
+    }
+    size_t termwise_children = 0;
+    for (size_t i = 0; i < _children.size(); ++i) {
+        if (_children[i]->getState().allow_termwise_eval() && !unpack.needUnpack(i)) {
+            ++termwise_children;
+        }
+    }
+    return ((termwise_children > 1) && (termwise_children >= child_limit));
+}
+
 void
 IntermediateBlueprint::optimize(Blueprint* &self)
 {
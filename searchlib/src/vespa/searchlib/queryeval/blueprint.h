@@ -8,6 +8,8 @@
 #include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+#include <vespa/vespalib/util/thread_arena.h>
+#include <new>
 
 namespace vespalib { class ObjectVisitor; };
 
@@ -142,6 +144,17 @@ public:
     Blueprint &operator=(const Blueprint &) = delete;
     virtual ~Blueprint();
 
+    // Allocated from the query arena bound to the current thread, if
+    // any (see vespalib::ThreadArena).
+    static void *operator new(size_t size) { return vespalib::ThreadArena::alloc(size); }
+    static void *operator new(size_t, void *ptr) noexcept { return ptr; }
+    static void operator delete(void *ptr) { vespalib::ThreadArena::free(ptr); }
+    static void operator delete(void *, void *) noexcept { }
+    // The arena only guarantees 16 byte alignment; over-aligned
+    // subclasses are allocated from the heap instead.
+    static void *operator new(size_t size, std::align_val_t align) { return ::operator new(size, align); }
+    static void operator delete(void *ptr, std::align_val_t align) { ::operator delete(ptr, align); }
+
     void setParent(Blueprint *parent) { _parent = parent; }
     Blueprint *getParent() const { return _parent; }
     bool has_parent() const { return (_parent != nullptr); }
@@ -163,6 +176,13 @@ public:
     virtual const State &getState() const = 0;
     const Blueprint &root() const;
 
+    /**
+     * Replace the hit estimate of this blueprint with one obtained by
+     * sampling its search iterator. Parents will recalculate their
+     * estimates based on the new value.
+     **/
+    virtual void set_sampled_estimate(HitEstimate est) = 0;
+
     double hit_ratio() const { return getState().hit_ratio(_docid_limit); }        
 
     virtual void fetchPostings(bool strict) = 0;
@@ -189,6 +209,8 @@ class StateCache : public Blueprint
 private:
     mutable bool  _stale;
     mutable State _state;
+    bool          _has_sampled_estimate;
+    HitEstimate   _sampled_estimate;
     void updateState() const;
 
 protected:
@@ -200,7 +222,7 @@ protected:
     virtual State calculateState() const = 0;
 
 public:
-    StateCache() : _stale(true), _state(FieldSpecBaseList()) {}
+    StateCache() : _stale(true), _state(FieldSpecBaseList()), _has_sampled_estimate(false), _sampled_estimate() {}
     const State &getState() const override final {
         if (_stale) {
             assert(!frozen());
@@ -208,6 +230,11 @@ public:
         }
         return _state;
     }
+    void set_sampled_estimate(HitEstimate est) override final {
+        _has_sampled_estimate = true;
+        _sampled_estimate = est;
+        notifyChange();
+    }
 };
 
 } // namespace blueprint
@@ -236,6 +263,7 @@ protected:
     virtual bool isPositive(size_t index) const { (void) index; return true; }
 
     bool should_do_termwise_eval(const UnpackInfo &unpack, double match_limit) const;
+    bool has_many_termwise_children(const UnpackInfo &unpack, uint32_t child_limit) const;
 
 public:
     typedef std::vector<size_t> IndexList;
@@ -255,6 +283,9 @@ public:
     Blueprint::UP removeChild(size_t n);
     SearchIteratorUP createSearch(fef::MatchData &md, bool strict) const override;
 
+    // re-sort children after their estimates have been changed by sampling
+    void sort_children() { sort(_children); }
+
     virtual HitEstimate combine(const std::vector<HitEstimate> &data) const = 0;
     virtual FieldSpecBaseList exposeFields() const = 0;
     virtual void sort(std::vector<Blueprint*> &children) const = 0;
@@ -287,6 +318,7 @@ protected:
 public:
     ~LeafBlueprint();
     const State &getState() const override final { return _state; }
+    void set_sampled_estimate(HitEstimate est) override final { setEstimate(est); }
     void setDocIdLimit(uint32_t limit) override final { Blueprint::setDocIdLimit(limit); }
     void fetchPostings(bool strict) override;
     void freeze() override final;
@@ -74,6 +74,7 @@ public:
     void visit(query::SubstringTerm &n) override = 0;
     void visit(query::SuffixTerm &n) override = 0;
     void visit(query::RegExpTerm &n) override = 0;
+    void visit(query::NearestNeighborTerm &n) override = 0;
 };
 
 }
@@ -3,6 +3,7 @@
 #include "dot_product_search.h"
 #include "iterator_pack.h"
 #include <vespa/vespalib/objects/visit.h>
+#include <algorithm>
 
 
 using search::fef::TermFieldMatchData;
@@ -107,6 +108,233 @@ public:
     void visitMembers(vespalib::ObjectVisitor &) const override {}
 };
 
+/**
+ * Dot product over attribute posting lists that only matches documents
+ * scoring above a threshold, pruning terms with the MaxScore algorithm.
+ *
+ * Terms are ordered by their maximum contribution. The longest prefix of
+ * terms whose contributions sum to no more than the (boosted) threshold
+ * are non-essential; a document matching only those cannot beat the
+ * threshold. Candidates are produced from the essential terms only, and
+ * the non-essential terms are looked up for a candidate in decreasing
+ * order of contribution for as long as the candidate can still beat the
+ * threshold. The threshold is raised from the shared score heap, which
+ * is fed the scores of the produced hits, moving more terms into the
+ * non-essential prefix as matching progresses.
+ */
+template <typename HEAP, typename IteratorPack, bool IS_STRICT>
+class DotProductMaxScoreSearchImpl : public DotProductSearch
+{
+private:
+    typedef uint32_t ref_t;
+    typedef wand::score_t score_t;
+    typedef ParallelWeakAndSearch::MatchParams MatchParams;
+
+    struct CmpDocId {
+        const uint32_t *termPos;
+        CmpDocId(const uint32_t *tp) : termPos(tp) {}
+        bool operator()(const ref_t &a, const ref_t &b) const {
+            return (termPos[a] < termPos[b]);
+        }
+    };
+
+    TermFieldMatchData     &_tmd;
+    std::vector<int32_t>    _weights;
+    std::vector<uint32_t>   _termPos;
+    CmpDocId                _cmpDocId;
+    std::vector<ref_t>      _order;      // terms by increasing max score
+    std::vector<score_t>    _bound;      // sum of max scores of _order[0..i]
+    size_t                  _numNonEssential;
+    std::vector<ref_t>      _data_space; // essential terms
+    ref_t                  *_data_begin;
+    ref_t                  *_data_stash;
+    ref_t                  *_data_end;
+    IteratorPack            _children;
+    score_t                 _threshold;
+    score_t                 _boostedThreshold;
+    const MatchParams       _matchParams;
+    std::vector<score_t>    _localScores;
+    score_t                 _score;
+
+    void seek_child(ref_t child, uint32_t docId) {
+        if (_termPos[child] < docId) {
+            _termPos[child] = _children.seek(child, docId);
+        }
+    }
+
+    score_t score_child(ref_t child, uint32_t docId) {
+        return score_t(_weights[child]) * _children.get_weight(child, docId);
+    }
+
+    void init_essential() {
+        _data_space.clear();
+        for (size_t i = _numNonEssential; i < _order.size(); ++i) {
+            _data_space.push_back(_order[i]);
+        }
+        _data_begin = _data_space.data();
+        _data_stash = _data_begin;
+        _data_end = _data_begin + _data_space.size();
+    }
+
+    void updateThreshold(score_t newThreshold) {
+        if (newThreshold > _threshold) {
+            _threshold = newThreshold;
+            _boostedThreshold = (newThreshold * _matchParams.thresholdBoostFactor);
+            size_t numNonEssential = _numNonEssential;
+            while ((numNonEssential < _order.size()) && (_bound[numNonEssential] <= _boostedThreshold)) {
+                ++numNonEssential;
+            }
+            if (numNonEssential != _numNonEssential) {
+                _numNonEssential = numNonEssential;
+                init_essential();
+            }
+        }
+    }
+
+    // Adds non-essential terms to the score of a candidate while it can still beat the threshold.
+    bool check_non_essential(uint32_t docId, score_t &score) {
+        for (size_t i = _numNonEssential; i-- > 0; ) {
+            if ((score + _bound[i]) <= _boostedThreshold) {
+                return false;
+            }
+            ref_t child = _order[i];
+            seek_child(child, docId);
+            if (_termPos[child] == docId) {
+                score += score_child(child, docId);
+            }
+        }
+        return (score > _threshold);
+    }
+
+    void seek_strict(uint32_t docId) {
+        for (;;) {
+            if (_data_begin == _data_end) {
+                setAtEnd();
+                return;
+            }
+            while (_data_stash < _data_end) {
+                seek_child(*_data_stash, docId);
+                HEAP::push(_data_begin, ++_data_stash, _cmpDocId);
+            }
+            while (_termPos[HEAP::front(_data_begin, _data_stash)] < docId) {
+                seek_child(HEAP::front(_data_begin, _data_stash), docId);
+                HEAP::adjust(_data_begin, _data_stash, _cmpDocId);
+            }
+            uint32_t candidate = _termPos[HEAP::front(_data_begin, _data_stash)];
+            if (isAtEnd(candidate)) {
+                setAtEnd();
+                return;
+            }
+            score_t score = 0;
+            while ((_data_begin < _data_stash) && (_termPos[HEAP::front(_data_begin, _data_stash)] == candidate)) {
+                HEAP::pop(_data_begin, _data_stash--, _cmpDocId);
+                score += score_child(*_data_stash, candidate);
+            }
+            if (check_non_essential(candidate, score)) {
+                _score = score;
+                setDocId(candidate);
+                return;
+            }
+            docId = candidate + 1;
+        }
+    }
+
+    void seek_unstrict(uint32_t docId) {
+        score_t score = 0;
+        bool matched = false;
+        for (size_t i = _order.size(); i-- > 0; ) {
+            if ((score + _bound[i]) <= _boostedThreshold) {
+                return;
+            }
+            ref_t child = _order[i];
+            seek_child(child, docId);
+            if (_termPos[child] == docId) {
+                score += score_child(child, docId);
+                matched = true;
+            }
+        }
+        if (matched && (score > _threshold)) {
+            _score = score;
+            setDocId(docId);
+        }
+    }
+
+public:
+    DotProductMaxScoreSearchImpl(TermFieldMatchData &tmd,
+                                 const std::vector<int32_t> &weights,
+                                 const std::vector<score_t> &maxScores,
+                                 IteratorPack &&iteratorPack,
+                                 const MatchParams &matchParams)
+        : _tmd(tmd),
+          _weights(weights),
+          _termPos(weights.size()),
+          _cmpDocId(&_termPos[0]),
+          _order(),
+          _bound(),
+          _numNonEssential(0),
+          _data_space(),
+          _data_begin(nullptr),
+          _data_stash(nullptr),
+          _data_end(nullptr),
+          _children(std::move(iteratorPack)),
+          _threshold(matchParams.scoreThreshold),
+          _boostedThreshold(matchParams.scoreThreshold * matchParams.thresholdBoostFactor),
+          _matchParams(matchParams),
+          _localScores(),
+          _score(0)
+    {
+        HEAP::require_left_heap();
+        assert(_weights.size() > 0);
+        assert(_weights.size() == _children.size());
+        assert(_weights.size() == maxScores.size());
+        for (size_t i = 0; i < _weights.size(); ++i) {
+            _order.push_back(i);
+        }
+        std::stable_sort(_order.begin(), _order.end(),
+                         [&maxScores](ref_t a, ref_t b) { return (maxScores[a] < maxScores[b]); });
+        score_t sum = 0;
+        for (ref_t ref : _order) {
+            sum += maxScores[ref];
+            _bound.push_back(sum);
+        }
+        while ((_numNonEssential < _order.size()) && (_bound[_numNonEssential] <= _boostedThreshold)) {
+            ++_numNonEssential;
+        }
+        _data_space.reserve(_weights.size());
+        init_essential();
+    }
+
+    void doSeek(uint32_t docId) override {
+        updateThreshold(_matchParams.scores.getMinScore());
+        if (IS_STRICT) {
+            seek_strict(docId);
+        } else {
+            seek_unstrict(docId);
+        }
+    }
+
+    void doUnpack(uint32_t docId) override {
+        _localScores.push_back(_score);
+        if (_localScores.size() == _matchParams.scoresAdjustFrequency) {
+            _matchParams.scores.adjust(&_localScores[0], &_localScores[0] + _localScores.size());
+            _localScores.clear();
+        }
+        _tmd.setRawScore(docId, _score);
+    }
+
+    void initRange(uint32_t begin, uint32_t end) override {
+        DotProductSearch::initRange(begin, end);
+        _children.initRange(begin, end);
+        for (size_t i = 0; i < _children.size(); ++i) {
+            _termPos[i] = _children.get_docid(i);
+        }
+        _data_stash = _data_begin;
+    }
+    Trinary is_strict() const override { return IS_STRICT ? Trinary::True : Trinary::False; }
+
+    void visitMembers(vespalib::ObjectVisitor &) const override {}
+};
+
 class SingleTermDotProductSearch : public DotProductSearch {
 public:
     SingleTermDotProductSearch(TermFieldMatchData &tmd, SearchIterator::UP child,
@@ -181,4 +409,50 @@ DotProductSearch::create(TermFieldMatchData &tmd,
 
 //-----------------------------------------------------------------------------
 
+namespace {
+
+template <typename HEAP>
+SearchIterator::UP
+createMaxScore(TermFieldMatchData &tmd, const std::vector<int32_t> &weights, const std::vector<wand::score_t> &maxScores,
+               std::vector<DocumentWeightIterator> &&iterators, const ParallelWeakAndSearch::MatchParams &matchParams,
+               bool strict)
+{
+    if (strict) {
+        return std::make_unique<DotProductMaxScoreSearchImpl<HEAP, AttributeIteratorPack, true>>(tmd, weights, maxScores,
+                AttributeIteratorPack(std::move(iterators)), matchParams);
+    }
+    return std::make_unique<DotProductMaxScoreSearchImpl<HEAP, AttributeIteratorPack, false>>(tmd, weights, maxScores,
+            AttributeIteratorPack(std::move(iterators)), matchParams);
+}
+
+}
+
+SearchIterator::UP
+DotProductSearch::create(TermFieldMatchData &tmd,
+                         const ParallelWeakAndSearch::MatchParams &matchParams,
+                         const std::vector<int32_t> &weights,
+                         const std::vector<IDocumentWeightAttribute::LookupResult> &dict_entries,
+                         const IDocumentWeightAttribute &attr,
+                         bool strict)
+{
+    assert(weights.size() == dict_entries.size());
+    std::vector<DocumentWeightIterator> iterators;
+    std::vector<wand::score_t> maxScores;
+    iterators.reserve(dict_entries.size());
+    maxScores.reserve(dict_entries.size());
+    for (size_t i = 0; i < dict_entries.size(); ++i) {
+        const IDocumentWeightAttribute::LookupResult &entry = dict_entries[i];
+        attr.create(entry.posting_idx, iterators);
+        // a document not in the posting list gets no contribution, so never bound below zero
+        wand::score_t weight = weights[i];
+        maxScores.push_back(std::max(wand::score_t(0), weight * ((weight < 0) ? entry.min_weight : entry.max_weight)));
+    }
+    if (iterators.size() < 128) {
+        return createMaxScore<vespalib::LeftArrayHeap>(tmd, weights, maxScores, std::move(iterators), matchParams, strict);
+    }
+    return createMaxScore<vespalib::LeftHeap>(tmd, weights, maxScores, std::move(iterators), matchParams, strict);
+}
+
+//-----------------------------------------------------------------------------
+
 }
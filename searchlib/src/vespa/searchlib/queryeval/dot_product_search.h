@@ -3,6 +3,7 @@
 #pragma once
 
 #include "multisearch.h"
+#include "wand/parallel_weak_and_search.h"
 #include <vespa/vespalib/util/priority_queue.h>
 #include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
@@ -34,6 +35,19 @@ public:
     static SearchIterator::UP create(search::fef::TermFieldMatchData &tmd,
                                      const std::vector<int32_t> &weights,
                                      std::vector<DocumentWeightIterator> &&iterators);
+
+    /**
+     * Create a dot product that only matches documents scoring above
+     * the threshold tracked by the score heap in the match params,
+     * using the max weight of each posting list to skip terms that
+     * cannot lift a document above the threshold (MaxScore).
+     **/
+    static SearchIterator::UP create(search::fef::TermFieldMatchData &tmd,
+                                     const ParallelWeakAndSearch::MatchParams &matchParams,
+                                     const std::vector<int32_t> &weights,
+                                     const std::vector<IDocumentWeightAttribute::LookupResult> &dict_entries,
+                                     const IDocumentWeightAttribute &attr,
+                                     bool strict);
 };
 
 }
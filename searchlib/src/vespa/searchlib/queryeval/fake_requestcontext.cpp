@@ -8,8 +8,19 @@ namespace queryeval {
 FakeRequestContext::FakeRequestContext(attribute::IAttributeContext * context, fastos::TimeStamp doom_in) :
     _clock(),
     _doom(_clock, doom_in),
-    _attributeContext(context)
+    _attributeContext(context),
+    _queryTensors()
 { }
 
+std::unique_ptr<vespalib::tensor::Tensor>
+FakeRequestContext::getQueryTensor(const vespalib::string &tensorName) const
+{
+    auto itr = _queryTensors.find(tensorName);
+    if (itr == _queryTensors.end()) {
+        return std::unique_ptr<vespalib::tensor::Tensor>();
+    }
+    return itr->second->clone();
+}
+
 }
 }
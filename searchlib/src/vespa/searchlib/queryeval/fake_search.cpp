@@ -12,8 +12,25 @@ namespace queryeval {
 namespace {
 
 struct FakeContext : search::attribute::ISearchContext {
-    int32_t onFind(DocId, int32_t, int32_t &) const override { return -1; }
-    int32_t onFind(DocId, int32_t) const override { return -1; }
+    const FakeResult &result;
+    FakeContext(const FakeResult &result_in) : result(result_in) {}
+    int32_t onFind(DocId docid, int32_t elem, int32_t &weight) const override {
+        for (const auto &doc: result.inspect()) {
+            if (doc.docId == docid) {
+                for (const auto &element: doc.elements) {
+                    if (element.id >= uint32_t(elem)) {
+                        weight = element.weight;
+                        return element.id;
+                    }
+                }
+            }
+        }
+        return -1;
+    }
+    int32_t onFind(DocId docid, int32_t elem) const override {
+        int32_t weight;
+        return onFind(docid, elem, weight);
+    }
     unsigned int approximateHits() const override { return 0; }
     std::unique_ptr<SearchIterator> createIterator(fef::TermFieldMatchData *, bool) override { abort(); }
     void fetchPostings(bool) override { }
@@ -29,7 +46,7 @@ void
 FakeSearch::is_attr(bool value)
 {
     if (value) {
-        _ctx = std::make_unique<FakeContext>();
+        _ctx = std::make_unique<FakeContext>(_result);
     } else {
         _ctx.reset();
     }
@@ -13,6 +13,7 @@ using search::query::PredicateQuery;
 using search::query::PrefixTerm;
 using search::query::RangeTerm;
 using search::query::RegExpTerm;
+using search::query::NearestNeighborTerm;
 using search::query::StringTerm;
 using search::query::SubstringTerm;
 using search::query::SuffixTerm;
@@ -63,6 +64,7 @@ public:
     void visit(SuffixTerm &n) override { visitTerm(n); }
     void visit(PredicateQuery &n) override { visitTerm(n); }
     void visit(RegExpTerm &n) override { visitTerm(n); }
+    void visit(NearestNeighborTerm &n) override { visitTerm(n); }
 };
 
 template <class Map>
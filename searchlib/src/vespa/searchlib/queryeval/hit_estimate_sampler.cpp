@@ -0,0 +1,116 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hit_estimate_sampler.h"
+#include "intermediate_blueprints.h"
+#include "searchiterator.h"
+
+#include <vespa/log/log.h>
+LOG_SETUP(".queryeval.hit_estimate_sampler");
+
+namespace search::queryeval {
+
+namespace {
+
+// do not bother sampling less than this number of docids for each node
+constexpr uint32_t min_docs_per_node = 256;
+
+}
+
+HitEstimateSampler::HitEstimateSampler(fef::MatchData &md, uint32_t docid_limit, uint32_t budget,
+                                       uint32_t num_windows)
+    : _md(md),
+      _docid_limit(docid_limit),
+      _budget(budget),
+      _num_windows(std::max(1u, num_windows)),
+      _sampled_nodes(0)
+{
+}
+
+void
+HitEstimateSampler::collect(Blueprint &blueprint, std::vector<IntermediateBlueprint *> &and_nodes)
+{
+    if (!blueprint.isIntermediate()) {
+        return;
+    }
+    IntermediateBlueprint &node = static_cast<IntermediateBlueprint &>(blueprint);
+    for (size_t i = 0; i < node.childCnt(); ++i) {
+        collect(node.getChild(i), and_nodes);
+    }
+    if ((dynamic_cast<AndBlueprint *>(&node) != nullptr) && (node.childCnt() > 1)) {
+        and_nodes.push_back(&node);
+    }
+}
+
+void
+HitEstimateSampler::prepare(Blueprint &root)
+{
+    std::vector<IntermediateBlueprint *> and_nodes;
+    collect(root, and_nodes);
+    for (IntermediateBlueprint *node: and_nodes) {
+        static_cast<AndBlueprint *>(node)->set_fetch_all_strict(true);
+    }
+}
+
+uint32_t
+HitEstimateSampler::count_hits(const Blueprint &blueprint, uint32_t docs_per_node, uint32_t &sampled_docs) const
+{
+    uint32_t num_docs = _docid_limit - 1;
+    uint32_t num_windows = (docs_per_node < num_docs) ? _num_windows : 1;
+    uint32_t window_size = (num_windows == 1) ? docs_per_node : (docs_per_node / num_windows);
+    uint32_t stride = num_docs / num_windows;
+    SearchIterator::UP search = blueprint.createSearch(_md, true);
+    uint32_t hits = 0;
+    sampled_docs = 0;
+    for (uint32_t i = 0; i < num_windows; ++i) {
+        uint32_t begin = 1 + i * stride;
+        uint32_t end = std::min(_docid_limit, begin + window_size);
+        sampled_docs += (end - begin);
+        search->initRange(begin, end);
+        for (uint32_t docid = search->seekFirst(begin); !search->isAtEnd(docid); docid = search->seekNext(docid + 1)) {
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+size_t
+HitEstimateSampler::sample(Blueprint &root)
+{
+    std::vector<IntermediateBlueprint *> and_nodes;
+    collect(root, and_nodes);
+    size_t num_children = 0;
+    for (const IntermediateBlueprint *node: and_nodes) {
+        num_children += node->childCnt();
+    }
+    uint32_t num_docs = (_docid_limit > 1) ? (_docid_limit - 1) : 0;
+    if ((num_children == 0) || (num_docs < _num_windows)) {
+        return 0;
+    }
+    uint32_t docs_per_node = std::min(num_docs, uint32_t(_budget / num_children));
+    if (docs_per_node < std::max(min_docs_per_node, _num_windows)) {
+        LOG(debug, "sampling budget %u too small for %zu nodes", _budget, num_children);
+        return 0;
+    }
+    // inner nodes first, so that parents sort children with corrected estimates
+    for (IntermediateBlueprint *node: and_nodes) {
+        for (size_t i = 0; i < node->childCnt(); ++i) {
+            Blueprint &child = node->getChild(i);
+            Blueprint::HitEstimate old_est = child.getState().estimate();
+            if (old_est.empty) {
+                continue;
+            }
+            uint32_t sampled_docs = 0;
+            uint32_t hits = count_hits(child, docs_per_node, sampled_docs);
+            uint64_t est_hits = (uint64_t(hits) * num_docs) / sampled_docs;
+            if ((hits > 0) && (est_hits == 0)) {
+                est_hits = 1;
+            }
+            child.set_sampled_estimate(Blueprint::HitEstimate(std::min(est_hits, uint64_t(num_docs)), false));
+            ++_sampled_nodes;
+        }
+        node->sort_children();
+    }
+    return _sampled_nodes;
+}
+
+}
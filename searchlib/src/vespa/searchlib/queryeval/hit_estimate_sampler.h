@@ -0,0 +1,58 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "blueprint.h"
+
+namespace search::fef { class MatchData; }
+
+namespace search::queryeval {
+
+/**
+ * Corrects the hit estimates of the children of AND blueprints by
+ * sampling their search iterators over a set of docid windows spread
+ * evenly across the docid space, and re-sorts the children based on
+ * the sampled estimates. This makes the choice of strict iterator
+ * robust against crude estimates from intermediate nodes and terms
+ * whose estimates do not account for correlation. The total number of
+ * docids sampled is limited by a fixed budget per query.
+ *
+ * Sampling needs to create search iterators and must be performed
+ * after fetchPostings and before freeze. Since the strict child of an
+ * AND may change, the tree must be prepared before fetchPostings so
+ * that all AND children fetch strict postings.
+ **/
+class HitEstimateSampler
+{
+private:
+    fef::MatchData &_md;
+    uint32_t        _docid_limit;
+    uint32_t        _budget;
+    uint32_t        _num_windows;
+    size_t          _sampled_nodes;
+
+    uint32_t count_hits(const Blueprint &blueprint, uint32_t docs_per_node, uint32_t &sampled_docs) const;
+    static void collect(Blueprint &blueprint, std::vector<IntermediateBlueprint *> &and_nodes);
+
+public:
+    static constexpr uint32_t default_num_windows = 16;
+
+    HitEstimateSampler(fef::MatchData &md, uint32_t docid_limit, uint32_t budget,
+                       uint32_t num_windows = default_num_windows);
+
+    /**
+     * Prepare the given blueprint tree for sampling. Must be called
+     * before fetchPostings.
+     **/
+    static void prepare(Blueprint &root);
+
+    /**
+     * Sample the children of all AND nodes in the given blueprint tree
+     * and re-sort them.
+     *
+     * @return the number of blueprints that got a sampled estimate
+     **/
+    size_t sample(Blueprint &root);
+};
+
+}
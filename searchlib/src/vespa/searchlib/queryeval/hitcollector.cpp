@@ -171,6 +171,17 @@ HitCollector::DocIdCollector<CollectRankedHit>::collectAndChangeCollector(uint32
     hc._collector.reset(new BitVectorCollector<CollectRankedHit>(hc)); // note - self-destruct.
 }
 
+size_t
+HitCollector::getMemoryUsage() const
+{
+    size_t usage = (_hits.capacity() + _reRankedHits.capacity()) * sizeof(Hit);
+    usage += (_scoreOrder.capacity() + _docIdVector.capacity()) * sizeof(uint32_t);
+    if (_bitVector) {
+        usage += _bitVector->getFileBytes();
+    }
+    return usage;
+}
+
 std::vector<feature_t>
 HitCollector::getSortedHeapScores()
 {
@@ -184,6 +195,22 @@ HitCollector::getSortedHeapScores()
     return scores;
 }
 
+std::vector<HitCollector::Hit>
+HitCollector::getSortedHeapHits(size_t count)
+{
+    std::vector<Hit> hits;
+    size_t hitsToReturn = std::min(std::min(_hits.size(), static_cast<size_t>(_maxReRankHitsSize)), count);
+    if (_hasReRanked) {
+        return hits;
+    }
+    hits.reserve(hitsToReturn);
+    sortHitsByScore(hitsToReturn);
+    for (size_t i = 0; i < hitsToReturn; ++i) {
+        hits.push_back(_hits[_scoreOrder[i]]);
+    }
+    return hits;
+}
+
 size_t
 HitCollector::reRank(DocumentScorer &scorer)
 {
@@ -6,6 +6,7 @@
 #include <vespa/searchlib/common/hitrank.h>
 #include <vespa/searchlib/common/resultset.h>
 #include <algorithm>
+#include <cmath>
 #include <vector>
 #include <vespa/vespalib/util/sort.h>
 #include <vespa/fastos/dynamiclibrary.h>
@@ -168,12 +169,36 @@ public:
         _collector->collect(docId, score);
     }
 
+    /**
+     * Returns the score a hit must beat to be stored among the n
+     * (=maxHitsSize) best hits. This is -HUGE_VAL until n hits have
+     * been collected and HUGE_VAL if no scores are stored at all.
+     **/
+    feature_t getScoreThreshold() const {
+        if (_maxHitsSize == 0) {
+            return HUGE_VAL;
+        }
+        return (_hitsSortOrder == SortOrder::HEAP) ? _hits[0].second : -HUGE_VAL;
+    }
+
+    /**
+     * Returns the number of bytes allocated to hold the collected
+     * hits.
+     **/
+    size_t getMemoryUsage() const;
+
     /**
      * Returns a sorted vector of scores for the hits that are stored
      * in the heap. These are the candidates for re-ranking.
      */
     std::vector<feature_t> getSortedHeapScores();
 
+    /**
+     * Returns the best hits stored in the heap, at most count of them,
+     * sorted on score. These are the hits re-ranked by reRank(scorer, count).
+     */
+    std::vector<Hit> getSortedHeapHits(size_t count);
+
     /**
      * Re-ranks the m (=maxHeapSize) best hits by invoking the score()
      * method on the given document scorer. The best m hits are sorted on doc id
@@ -206,6 +206,18 @@ AndBlueprint::inheritStrict(size_t i) const
     return (i == 0);
 }
 
+void
+AndBlueprint::fetchPostings(bool strict)
+{
+    if (!_fetch_all_strict) {
+        IntermediateBlueprint::fetchPostings(strict);
+        return;
+    }
+    for (size_t i = 0; i < childCnt(); ++i) {
+        getChild(i).fetchPostings(strict);
+    }
+}
+
 SearchIterator::UP
 AndBlueprint::createIntermediateSearch(const MultiSearch::Children &subSearches,
                                          bool strict, search::fef::MatchData & md) const
@@ -288,7 +300,12 @@ OrBlueprint::createIntermediateSearch(const MultiSearch::Children &subSearches,
                                       bool strict, search::fef::MatchData & md) const
 {
     UnpackInfo unpackInfo(calculateUnpackInfo(md));
-    if (should_do_termwise_eval(unpackInfo, md.get_termwise_limit())) {
+    // Seeking an OR visits every child, so with many children that need no
+    // unpack it pays to evaluate them into a bitvector up front even when
+    // the query as a whole is too sparse for termwise evaluation.
+    if (should_do_termwise_eval(unpackInfo, md.get_termwise_limit()) ||
+        has_many_termwise_children(unpackInfo, md.get_termwise_or_limit()))
+    {
         TermwiseBlueprintHelper helper(*this, subSearches, unpackInfo);
         bool termwise_strict = (strict && inheritStrict(helper.first_termwise));
         auto termwise_search = SearchIterator::UP(OrSearch::create(helper.termwise, termwise_strict));
@@ -32,7 +32,14 @@ private:
 
 class AndBlueprint : public IntermediateBlueprint
 {
+private:
+    bool _fetch_all_strict;
 public:
+    AndBlueprint() : _fetch_all_strict(false) {}
+    // fetch strict postings for all children, so that any of them may
+    // be sorted first after fetchPostings (see HitEstimateSampler)
+    void set_fetch_all_strict(bool value) { _fetch_all_strict = value; }
+    void fetchPostings(bool strict) override;
     bool supports_termwise_children() const override { return true; }
     HitEstimate combine(const std::vector<HitEstimate> &data) const override;
     FieldSpecBaseList exposeFields() const override;
@@ -15,8 +15,16 @@ namespace sourceselector {
 class Iterator {
 public:
     using SourceStore = SingleValueNumericAttribute<IntegerAttributeTemplate<int8_t> >;
+    /**
+     * The run store holds one entry per block of 2^RUN_BLOCK_BITS
+     * documents; the source used by all documents in the block, or
+     * MIXED_SOURCES if they differ.
+     **/
+    static constexpr uint32_t RUN_BLOCK_BITS = 8;
+    static constexpr queryeval::Source MIXED_SOURCES = 0xff;
 
-    Iterator(const SourceStore & source) : _source(source) { }
+    Iterator(const SourceStore & source) : _source(source), _runs(nullptr) { }
+    Iterator(const SourceStore & source, const SourceStore & runs) : _source(source), _runs(&runs) { }
     Iterator(const Iterator &) = delete;
     Iterator & operator = (const Iterator &) = delete;
     virtual ~Iterator() { }
@@ -35,8 +43,33 @@ public:
     uint32_t getDocIdLimit() const {
         return _source.getCommittedDocIdLimit();
     }
+
+    /**
+     * Obtain the end of the run of documents starting at the given
+     * document that all use the given source, which must be the
+     * source of that document. Runs are only tracked in whole
+     * blocks, so docId + 1 is returned when docId is in a block with
+     * mixed sources.
+     *
+     * @return one above the last document in the run
+     * @param docId document id
+     * @param source the source of docId
+     **/
+    uint32_t getRunEnd(uint32_t docId, queryeval::Source source) const {
+        if (_runs == nullptr) {
+            return docId + 1;
+        }
+        uint32_t block = docId >> RUN_BLOCK_BITS;
+        uint32_t blockLimit = _runs->getCommittedDocIdLimit();
+        uint32_t end = block;
+        while ((end < blockLimit) && (queryeval::Source(_runs->getFast(end)) == source)) {
+            ++end;
+        }
+        return (end > block) ? (end << RUN_BLOCK_BITS) : (docId + 1);
+    }
 private:
     const SourceStore & _source;
+    const SourceStore * _runs;
 };
 
 }
@@ -8,11 +8,12 @@ namespace search::queryeval {
 
 SearchIteratorPack::~SearchIteratorPack() { }
 
-SearchIteratorPack::SearchIteratorPack() : _children(), _childMatch(), _md() {}
+SearchIteratorPack::SearchIteratorPack() : _children(), _childMatch(), _childBlockMax(), _md() {}
 
 SearchIteratorPack::SearchIteratorPack(SearchIteratorPack &&rhs)
     : _children(std::move(rhs._children)),
       _childMatch(std::move(rhs._childMatch)),
+      _childBlockMax(std::move(rhs._childBlockMax)),
       _md(std::move(rhs._md))
 {}
 
@@ -20,6 +21,7 @@ SearchIteratorPack &
 SearchIteratorPack::operator=(SearchIteratorPack &&rhs) {
     _children = std::move(rhs._children);
     _childMatch = std::move(rhs._childMatch);
+    _childBlockMax = std::move(rhs._childBlockMax);
     _md = std::move(rhs._md);
     return *this;
 }
@@ -29,11 +31,22 @@ SearchIteratorPack::SearchIteratorPack(const std::vector<SearchIterator*> &child
                                        MatchDataUP md)
     : _children(),
       _childMatch(childMatch),
+      _childBlockMax(),
       _md(std::move(md))
 {
     _children.reserve(children.size());
+    bool any_block_max = false;
     for (auto child: children) {
         _children.emplace_back(child);
+        auto info = dynamic_cast<BlockMaxWeightInfo *>(child);
+        any_block_max = any_block_max || ((info != nullptr) && info->hasBlockMaxWeights());
+    }
+    if (any_block_max) {
+        _childBlockMax.reserve(children.size());
+        for (auto child: children) {
+            auto info = dynamic_cast<BlockMaxWeightInfo *>(child);
+            _childBlockMax.push_back(((info != nullptr) && info->hasBlockMaxWeights()) ? info : nullptr);
+        }
     }
     assert((_children.size() == _childMatch.size()) || _childMatch.empty());
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "searchiterator.h"
+#include "posting_info.h"
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 
 namespace search::fef { class MatchData; }
@@ -15,6 +16,7 @@ private:
     using MatchDataUP = std::unique_ptr<fef::MatchData>;
     std::vector<SearchIterator::UP>        _children;
     std::vector<fef::TermFieldMatchData*>  _childMatch;
+    std::vector<BlockMaxWeightInfo*>       _childBlockMax;
     MatchDataUP                            _md;
 
 public:
@@ -47,6 +49,19 @@ public:
         _children[ref]->doUnpack(docid);
     }
 
+    bool has_block_max() const { return !_childBlockMax.empty(); }
+
+    // upper bound for the weights in the block of child 'ref' covering
+    // docid; returns the last docid in that block
+    uint32_t get_block_max_weight(uint32_t ref, uint32_t docid, int32_t &max_weight) {
+        BlockMaxWeightInfo *info = _childBlockMax[ref];
+        if (info == nullptr) {
+            max_weight = std::numeric_limits<int32_t>::max();
+            return docid;
+        }
+        return info->getBlockMaxWeight(docid, max_weight);
+    }
+
     size_t size() const {
         return _children.size();
     }
@@ -14,8 +14,17 @@
 namespace search {
 namespace queryeval {
 
+using vespalib::hwaccelrated::IAccelrated;
+
 namespace {
 
+const IAccelrated &
+getAccelrator()
+{
+    static IAccelrated::UP accelrator = IAccelrated::getAccelrator();
+    return *accelrator;
+}
+
 template<typename Update>
 class MultiBitVectorIterator : public MultiBitVectorIteratorBase
 {
@@ -28,7 +37,6 @@ private:
     void doSeek(uint32_t docId) override;
     bool isStrict() const override { return false; }
     bool acceptExtraFilter() const override { return Update::isAnd(); }
-    Update                  _update;
 };
 
 template<typename Update>
@@ -46,12 +54,9 @@ void MultiBitVectorIterator<Update>::updateLastValue(uint32_t docId)
 {
     if (docId >= _lastMaxDocIdLimit) {
         if (__builtin_expect(docId < _numDocs, true)) {
-            const uint32_t index(wordNum(docId));
-            _lastValue = _bvs[0][index];
-            for(uint32_t i(1); i < _bvs.size(); i++) {
-                _lastValue = _update(_lastValue, _bvs[i][index]);
-            }
-            _lastMaxDocIdLimit = (index + 1) * WordLen;
+            const uint32_t chunk(docId / ChunkLen);
+            Update::combine(_accel, chunk * IAccelrated::CHUNK_BYTES, _bvs, _lastWords);
+            _lastMaxDocIdLimit = (chunk + 1) * ChunkLen;
         } else {
             setAtEnd();
         }
@@ -64,7 +69,7 @@ MultiBitVectorIterator<Update>::doSeek(uint32_t docId)
 {
     updateLastValue(docId);
     if (__builtin_expect( ! isAtEnd(), true)) {
-        if (_lastValue & mask(docId)) {
+        if (_lastWords[wordNum(docId) % ChunkWords] & mask(docId)) {
             setDocId(docId);
         }
     }
@@ -74,31 +79,40 @@ template<typename Update>
 void
 MultiBitVectorIterator<Update>::strictSeek(uint32_t docId)
 {
-    for (updateLastValue(docId), _lastValue=_lastValue & checkTab(docId);
-         (_lastValue == 0) && __builtin_expect(! isAtEnd(), true);
-         updateLastValue(_lastMaxDocIdLimit));
-    if (__builtin_expect(!isAtEnd(), true)) {
-        docId = _lastMaxDocIdLimit - WordLen + vespalib::Optimized::lsbIdx(_lastValue);
-        if (__builtin_expect(docId >= _numDocs, false)) {
-            setAtEnd();
-        } else {
-            setDocId(docId);
+    updateLastValue(docId);
+    if (__builtin_expect(isAtEnd(), false)) {
+        return;
+    }
+    uint32_t index(wordNum(docId) % ChunkWords);
+    Word value(_lastWords[index] & checkTab(docId));
+    while (value == 0) {
+        if (++index == ChunkWords) {
+            updateLastValue(_lastMaxDocIdLimit);
+            if (__builtin_expect(isAtEnd(), false)) {
+                return;
+            }
+            index = 0;
         }
+        value = _lastWords[index];
+    }
+    docId = _lastMaxDocIdLimit - ChunkLen + index * WordLen + vespalib::Optimized::lsbIdx(value);
+    if (__builtin_expect(docId >= _numDocs, false)) {
+        setAtEnd();
+    } else {
+        setDocId(docId);
     }
 }
 
 struct And {
-    typedef BitWord::Word Word;
-    Word operator () (const Word a, const Word b) {
-        return a & b;
+    static void combine(const IAccelrated & accel, size_t offset, const IAccelrated::BitSources & src, void * dest) {
+        accel.and64(offset, src, dest);
     }
     static bool isAnd() { return true; }
 };
 
 struct Or {
-    typedef BitWord::Word Word;
-    Word operator () (const Word a, const Word b) {
-        return a | b;
+    static void combine(const IAccelrated & accel, size_t offset, const IAccelrated::BitSources & src, void * dest) {
+        accel.or64(offset, src, dest);
     }
     static bool isAnd() { return false; }
 };
@@ -134,14 +148,16 @@ bool canOptimize(const MultiSearch & s) {
 
 MultiBitVectorIteratorBase::MultiBitVectorIteratorBase(const Children & children) :
     MultiSearch(children),
+    _accel(getAccelrator()),
     _numDocs(std::numeric_limits<unsigned int>::max()),
-    _lastValue(0),
     _lastMaxDocIdLimit(0),
-    _bvs(children.size())
+    _bvs(),
+    _lastWords()
 {
+    _bvs.reserve(children.size());
     for (size_t i(0); i < children.size(); i++) {
         const BitVectorIterator * bv = static_cast<const BitVectorIterator *>(children[i]);
-        _bvs[i] = reinterpret_cast<const Word *>(bv->getBitValues());
+        _bvs.emplace_back(bv->getBitValues(), false);
         _numDocs = std::min(_numDocs, bv->getDocIdLimit());
     }
 }
@@ -150,13 +166,20 @@ MultiBitVectorIteratorBase::~MultiBitVectorIteratorBase()
 {
 }
 
+void
+MultiBitVectorIteratorBase::initRange(uint32_t beginId, uint32_t endId)
+{
+    MultiSearch::initRange(beginId, endId);
+    _lastMaxDocIdLimit = 0;  // force reload, the buffered chunk may be from a later range
+}
+
 SearchIterator::UP
 MultiBitVectorIteratorBase::andWith(UP filter, uint32_t estimate)
 {
     (void) estimate;
     if (filter->isBitVector() && acceptExtraFilter()) {
         const BitVectorIterator & bv = static_cast<const BitVectorIterator &>(*filter);
-        _bvs.push_back(reinterpret_cast<const Word *>(bv.getBitValues()));
+        _bvs.emplace_back(bv.getBitValues(), false);
         insert(getChildren().size(), std::move(filter));
         _lastMaxDocIdLimit = 0;  // force reload
     }
@@ -5,6 +5,7 @@
 #include "multisearch.h"
 #include "unpackinfo.h"
 #include <vespa/searchlib/common/bitword.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 
 namespace search {
 namespace queryeval {
@@ -15,18 +16,24 @@ public:
     ~MultiBitVectorIteratorBase();
     virtual bool isStrict() const = 0;
     void addUnpackIndex(size_t index) { _unpackInfo.add(index); }
+    void initRange(uint32_t beginId, uint32_t endId) override;
     /**
      * Will steal and optimize bitvectoriterators if it can
      * Might return itself or a new structure.
      */
     static SearchIterator::UP optimize(SearchIterator::UP parent);
 protected:
+    using IAccelrated = vespalib::hwaccelrated::IAccelrated;
+    static constexpr size_t ChunkWords = IAccelrated::CHUNK_BYTES / sizeof(Word);
+    static constexpr uint32_t ChunkLen = ChunkWords * WordLen;
+
     MultiBitVectorIteratorBase(const Children & children);
 
+    const IAccelrated &     _accel;
     uint32_t                _numDocs;
-    Word                    _lastValue; // Last value computed
     uint32_t                _lastMaxDocIdLimit; // next documentid requiring recomputation.
-    std::vector<const Word  *> _bvs;
+    IAccelrated::BitSources _bvs;
+    alignas(64) Word        _lastWords[ChunkWords]; // Last chunk computed
 private:
     virtual bool acceptExtraFilter() const = 0;
     UP andWith(UP filter, uint32_t estimate) override;
@@ -0,0 +1,123 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "nearest_neighbor_blueprint.h"
+#include "emptysearch.h"
+#include <vespa/searchlib/tensor/dense_tensor_attribute.h>
+#include <vespa/vespalib/objects/visit.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <queue>
+
+namespace search::queryeval {
+
+namespace {
+
+// Extra candidates explored in the hnsw index to improve recall
+constexpr uint32_t EXPLORE_ADDITIONAL_HITS = 100;
+
+using Hit = NearestNeighborIterator::Hit;
+
+struct FurtherFirst {
+    bool operator()(const Hit &lhs, const Hit &rhs) const {
+        return (lhs.distance < rhs.distance);
+    }
+};
+
+bool
+docIdLess(const Hit &lhs, const Hit &rhs)
+{
+    return (lhs.docId < rhs.docId);
+}
+
+}
+
+NearestNeighborBlueprint::NearestNeighborBlueprint(const FieldSpecBase &field,
+                                                   const tensor::DenseTensorAttribute &attribute,
+                                                   std::vector<double> query_vector,
+                                                   uint32_t target_num_hits)
+    : ComplexLeafBlueprint(field),
+      _attribute(attribute),
+      _query_vector(std::move(query_vector)),
+      _target_num_hits(target_num_hits),
+      _hits()
+{
+    uint32_t est_hits = std::min(_target_num_hits, _attribute.getCommittedDocIdLimit());
+    setEstimate(HitEstimate(est_hits, est_hits == 0));
+}
+
+NearestNeighborBlueprint::~NearestNeighborBlueprint() = default;
+
+void
+NearestNeighborBlueprint::bruteForceSearch()
+{
+    std::priority_queue<Hit, std::vector<Hit>, FurtherFirst> best;
+    uint32_t docIdLimit = _attribute.getCommittedDocIdLimit();
+    for (uint32_t docId = 1; docId < docIdLimit; ++docId) {
+        vespalib::ConstArrayRef<double> vector = _attribute.getVector(docId);
+        if (vector.size() != _query_vector.size()) {
+            continue;
+        }
+        double sum = 0.0;
+        for (size_t i = 0; i < vector.size(); ++i) {
+            double diff = vector[i] - _query_vector[i];
+            sum += diff * diff;
+        }
+        if (best.size() < _target_num_hits) {
+            best.emplace(docId, sum);
+        } else if (sum < best.top().distance) {
+            best.pop();
+            best.emplace(docId, sum);
+        }
+    }
+    _hits.reserve(best.size());
+    while (!best.empty()) {
+        _hits.emplace_back(best.top().docId, std::sqrt(best.top().distance));
+        best.pop();
+    }
+}
+
+void
+NearestNeighborBlueprint::fetchPostings(bool)
+{
+    if (_target_num_hits == 0) {
+        return;
+    }
+    const tensor::HnswIndex *index = _attribute.getIndex();
+    if (index != nullptr) {
+        vespalib::ConstArrayRef<double> vector(_query_vector.data(), _query_vector.size());
+        uint32_t docIdLimit = _attribute.getCommittedDocIdLimit();
+        for (const auto &neighbor : index->findTopK(_target_num_hits, vector,
+                                                    _target_num_hits + EXPLORE_ADDITIONAL_HITS))
+        {
+            // Documents added after the docid limit was committed are not visible yet
+            if (neighbor.docId < docIdLimit) {
+                _hits.emplace_back(neighbor.docId, neighbor.distance);
+            }
+        }
+    } else {
+        bruteForceSearch();
+    }
+    std::sort(_hits.begin(), _hits.end(), docIdLess);
+}
+
+SearchIterator::UP
+NearestNeighborBlueprint::createLeafSearch(const fef::TermFieldMatchDataArray &tfmda, bool) const
+{
+    assert(tfmda.size() == 1);
+    if (_hits.empty()) {
+        return std::make_unique<EmptySearch>();
+    }
+    return std::make_unique<NearestNeighborIterator>(*tfmda[0], _hits);
+}
+
+void
+NearestNeighborBlueprint::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    ComplexLeafBlueprint::visitMembers(visitor);
+    visit(visitor, "attribute", _attribute.getName());
+    visit(visitor, "target_num_hits", _target_num_hits);
+    visit(visitor, "hits", static_cast<uint32_t>(_hits.size()));
+}
+
+}
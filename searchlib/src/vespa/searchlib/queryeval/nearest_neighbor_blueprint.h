@@ -0,0 +1,42 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "blueprint.h"
+#include "nearest_neighbor_iterator.h"
+#include <vector>
+
+namespace search::tensor { class DenseTensorAttribute; }
+
+namespace search::queryeval {
+
+/**
+ * Blueprint for a nearest neighbor search over a dense tensor
+ * attribute. The closest documents are found in fetchPostings, using
+ * the hnsw index of the attribute if it has one and a brute force scan
+ * otherwise. When combined with filters the filters are applied to the
+ * nearest neighbors found, so fewer than the target number of hits may
+ * match.
+ */
+class NearestNeighborBlueprint : public ComplexLeafBlueprint {
+private:
+    const tensor::DenseTensorAttribute &_attribute;
+    std::vector<double> _query_vector;
+    uint32_t _target_num_hits;
+    NearestNeighborIterator::Hits _hits; // sorted on document id
+
+    void bruteForceSearch();
+
+public:
+    NearestNeighborBlueprint(const FieldSpecBase &field,
+                             const tensor::DenseTensorAttribute &attribute,
+                             std::vector<double> query_vector,
+                             uint32_t target_num_hits);
+    ~NearestNeighborBlueprint();
+    void fetchPostings(bool strict) override;
+    SearchIterator::UP createLeafSearch(const fef::TermFieldMatchDataArray &tfmda,
+                                        bool strict) const override;
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+};
+
+}
@@ -0,0 +1,58 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "nearest_neighbor_iterator.h"
+#include <algorithm>
+
+namespace search::queryeval {
+
+namespace {
+
+bool
+docIdLess(const NearestNeighborIterator::Hit &hit, uint32_t docId)
+{
+    return (hit.docId < docId);
+}
+
+}
+
+NearestNeighborIterator::NearestNeighborIterator(fef::TermFieldMatchData &tfmd, const Hits &hits)
+    : _tfmd(tfmd),
+      _hits(hits),
+      _pos(hits.begin())
+{
+}
+
+NearestNeighborIterator::~NearestNeighborIterator() = default;
+
+void
+NearestNeighborIterator::updateDocId()
+{
+    if (_pos != _hits.end() && _pos->docId < getEndId()) {
+        setDocId(_pos->docId);
+    } else {
+        setAtEnd();
+    }
+}
+
+void
+NearestNeighborIterator::initRange(uint32_t begin, uint32_t end)
+{
+    SearchIterator::initRange(begin, end);
+    _pos = std::lower_bound(_hits.begin(), _hits.end(), begin, docIdLess);
+    updateDocId();
+}
+
+void
+NearestNeighborIterator::doSeek(uint32_t docId)
+{
+    _pos = std::lower_bound(_pos, _hits.end(), docId, docIdLess);
+    updateDocId();
+}
+
+void
+NearestNeighborIterator::doUnpack(uint32_t docId)
+{
+    _tfmd.setRawScore(docId, 1.0 / (1.0 + _pos->distance));
+}
+
+}
@@ -0,0 +1,43 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "searchiterator.h"
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vector>
+
+namespace search::queryeval {
+
+/**
+ * Search iterator over the result of a nearest neighbor search. The
+ * hits are found up front by the blueprint and must be sorted on
+ * document id. Unpacking sets the raw score to 1/(1 + distance), so
+ * closer documents get higher scores.
+ */
+class NearestNeighborIterator : public SearchIterator
+{
+public:
+    struct Hit {
+        uint32_t docId;
+        double distance;
+        Hit(uint32_t docId_in, double distance_in) : docId(docId_in), distance(distance_in) {}
+    };
+    using Hits = std::vector<Hit>;
+
+private:
+    fef::TermFieldMatchData &_tfmd;
+    const Hits              &_hits;
+    Hits::const_iterator     _pos;
+
+    void updateDocId();
+
+public:
+    NearestNeighborIterator(fef::TermFieldMatchData &tfmd, const Hits &hits);
+    ~NearestNeighborIterator();
+    void initRange(uint32_t begin, uint32_t end) override;
+    void doSeek(uint32_t docId) override;
+    void doUnpack(uint32_t docId) override;
+    Trinary is_strict() const override { return Trinary::True; }
+};
+
+}
@@ -41,4 +41,32 @@ public:
     int32_t getMaxWeight() const { return _maxWeight; }
 };
 
+
+/**
+ * Interface implemented by search iterators whose underlying posting
+ * list stores an upper bound on the weights within each block of
+ * documents (block-max metadata).
+ *
+ * Lookups must be done with non-decreasing document ids between calls
+ * to initRange on the search iterator.
+ */
+class BlockMaxWeightInfo {
+public:
+    virtual ~BlockMaxWeightInfo() { }
+
+    /**
+     * @return true if block-max metadata is available for this posting list.
+     */
+    virtual bool hasBlockMaxWeights() const = 0;
+
+    /**
+     * Locate the block covering docId.
+     *
+     * @return last document id covered by the block
+     * @param docId the document id to look up
+     * @param maxWeight set to an upper bound of the weights within the block
+     */
+    virtual uint32_t getBlockMaxWeight(uint32_t docId, int32_t &maxWeight) = 0;
+};
+
 }
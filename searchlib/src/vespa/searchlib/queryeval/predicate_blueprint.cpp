@@ -7,6 +7,7 @@
 #include <vespa/searchlib/predicate/predicate_zstar_compressed_posting_list.h>
 #include <vespa/searchlib/predicate/predicate_hash.h>
 #include <vespa/searchlib/query/tree/termnodes.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/log/log.h>
 LOG_SETUP(".searchlib.predicate.predicate_blueprint");
 #include <vespa/searchlib/predicate/predicate_range_term_expander.h>
@@ -26,54 +27,89 @@ namespace {
 typedef PredicateBlueprint::IntervalEntry IntervalEntry;
 typedef PredicateBlueprint::BoundsEntry BoundsEntry;
 
+/**
+ * Collects the dictionary entries of a query. Range terms of nearby
+ * values expand to mostly the same labels, and the same feature may
+ * be given in several subqueries. Each distinct feature is only
+ * looked up once, and gets a single entry covering all its
+ * subqueries, so the search does not iterate the same posting list
+ * more than once.
+ */
+class DictionaryEntryCollector {
+    const SimpleIndex<datastore::EntryRef> &_interval_index;
+    const SimpleIndex<datastore::EntryRef> &_bounds_index;
+    vector<IntervalEntry> &_interval_entries;
+    vector<BoundsEntry> &_bounds_entries;
+    vespalib::hash_map<uint64_t, uint32_t> _interval_pos;
+    vespalib::hash_map<uint64_t, uint32_t> _bounds_pos;
+
+public:
+    DictionaryEntryCollector(const PredicateIndex &index,
+                             vector<IntervalEntry> &interval_entries,
+                             vector<BoundsEntry> &bounds_entries)
+        : _interval_index(index.getIntervalIndex()),
+          _bounds_index(index.getBoundsIndex()),
+          _interval_entries(interval_entries),
+          _bounds_entries(bounds_entries),
+          _interval_pos(),
+          _bounds_pos()
+    { }
+
+    void addInterval(uint64_t feature, uint64_t subquery_bitmap) {
+        auto found = _interval_pos.find(feature);
+        if (found != _interval_pos.end()) {
+            _interval_entries[found->second].subquery |= subquery_bitmap;
+            return;
+        }
+        auto iterator = _interval_index.lookup(feature);
+        if (iterator.valid()) {
+            size_t sz = _interval_index.getPostingListSize(iterator.getData());
+            _interval_pos[feature] = _interval_entries.size();
+            _interval_entries.push_back({iterator.getData(), subquery_bitmap, sz, feature});
+        }
+    }
+    void addBounds(uint64_t feature, uint32_t value_diff, uint64_t subquery_bitmap) {
+        auto found = _bounds_pos.find(feature);
+        if ((found != _bounds_pos.end()) &&
+            (_bounds_entries[found->second].value_diff == value_diff)) {
+            _bounds_entries[found->second].subquery |= subquery_bitmap;
+            return;
+        }
+        auto iterator = _bounds_index.lookup(feature);
+        if (iterator.valid()) {
+            size_t sz = _bounds_index.getPostingListSize(iterator.getData());
+            if (found == _bounds_pos.end()) {
+                _bounds_pos[feature] = _bounds_entries.size();
+            }
+            _bounds_entries.push_back({iterator.getData(), value_diff, subquery_bitmap, sz, feature});
+        }
+    }
+};
+
 template <typename Entry>
-void pushValueDictionaryEntry(const Entry &entry,
-                              const SimpleIndex<datastore::EntryRef> &interval_index,
-                              vector<IntervalEntry> &interval_entries) {
+void pushValueDictionaryEntry(const Entry &entry, DictionaryEntryCollector &collector) {
     const std::string &hash_str = entry.getKey() + "=" + entry.getValue();
     uint64_t feature = PredicateHash::hash64(hash_str);
-    auto iterator = interval_index.lookup(feature);
-    if (iterator.valid()) {
-        size_t sz = interval_index.getPostingListSize(iterator.getData());
-        LOG(debug, "postinglist(%s) = (%d).size = %ld", hash_str.c_str(), iterator.getData().ref(), sz);
-        interval_entries.push_back({iterator.getData(), entry.getSubQueryBitmap(), sz, feature});
-    }
+    collector.addInterval(feature, entry.getSubQueryBitmap());
 }
 
 struct MyRangeHandler {
-    const SimpleIndex<datastore::EntryRef> &interval_index;
-    const SimpleIndex<datastore::EntryRef> &bounds_index;
-    vector<IntervalEntry> &interval_entries;
-    vector<BoundsEntry> &bounds_entries;
+    DictionaryEntryCollector &collector;
     uint64_t subquery_bitmap;
 
     void handleRange(const string &label) {
-        uint64_t feature = PredicateHash::hash64(label);
-        auto iterator = interval_index.lookup(feature);
-        if (iterator.valid()) {
-            size_t sz = interval_index.getPostingListSize(iterator.getData());
-            interval_entries.push_back({iterator.getData(), subquery_bitmap, sz, feature});
-        }
+        collector.addInterval(PredicateHash::hash64(label), subquery_bitmap);
     }
     void handleEdge(const string &label, uint32_t value) {
-        uint64_t feature = PredicateHash::hash64(label);
-        auto iterator = bounds_index.lookup(feature);
-        if (iterator.valid()) {
-            size_t sz = bounds_index.getPostingListSize(iterator.getData());
-            bounds_entries.push_back({iterator.getData(), value, subquery_bitmap, sz, feature});
-        }
+        collector.addBounds(PredicateHash::hash64(label), value, subquery_bitmap);
     }
 };
 
 template <typename Entry>
-void pushRangeDictionaryEntries(
-        const Entry &entry,
-        const PredicateIndex &index,
-        vector<IntervalEntry> &interval_entries,
-        vector<BoundsEntry> &bounds_entries) {
-    PredicateRangeTermExpander expander(index.getArity());
-    MyRangeHandler handler{index.getIntervalIndex(), index.getBoundsIndex(), interval_entries,
-                           bounds_entries, entry.getSubQueryBitmap()};
+void pushRangeDictionaryEntries(const Entry &entry,
+                                PredicateRangeTermExpander &expander,
+                                DictionaryEntryCollector &collector) {
+    MyRangeHandler handler{collector, entry.getSubQueryBitmap()};
     expander.expand(entry.getKey(), entry.getValue(), handler);
 }
 
@@ -162,12 +198,13 @@ PredicateBlueprint::PredicateBlueprint(const FieldSpecBase &field,
     const auto &interval_index = _index.getIntervalIndex();
     const auto zero_constraints_docs = _index.getZeroConstraintDocs();
     const PredicateQueryTerm &term = *query.getTerm();
+    DictionaryEntryCollector collector(_index, _interval_dict_entries, _bounds_dict_entries);
     for (const auto &entry : term.getFeatures()) {
-        pushValueDictionaryEntry(entry, interval_index, _interval_dict_entries);
+        pushValueDictionaryEntry(entry, collector);
     }
+    PredicateRangeTermExpander expander(_index.getArity());
     for (const auto &entry : term.getRangeFeatures()) {
-        pushRangeDictionaryEntries(entry, _index, _interval_dict_entries,
-                                   _bounds_dict_entries);
+        pushRangeDictionaryEntries(entry, expander, collector);
     }
     pushZStarPostingList(interval_index, _interval_dict_entries);
 
@@ -2,6 +2,7 @@
 
 #include "same_element_search.h"
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/attribute/elementiterator.h>
 #include <vespa/vespalib/objects/visit.h>
 #include <vespa/vespalib/objects/visit.hpp>
 #include <algorithm>
@@ -11,26 +12,6 @@ using TFMD = search::fef::TermFieldMatchData;
 
 namespace search::queryeval {
 
-namespace {
-
-template <typename It>
-int32_t try_match(const fef::TermFieldMatchDataArray &match, std::vector<It> &iterators, uint32_t cand) {
-    for (size_t i = 0; i < iterators.size(); ++i) {
-        while ((iterators[i] != match[i]->end()) && (iterators[i]->getElementId() < cand)) {
-            ++iterators[i];
-        }
-        if (iterators[i] == match[i]->end()) {
-            return -1;
-        }
-        if (iterators[i]->getElementId() != cand) {
-            return iterators[i]->getElementId();
-        }
-    }
-    return cand;
-}
-
-}
-
 bool
 SameElementSearch::check_docid_match(uint32_t docid)
 {
@@ -45,25 +26,47 @@ SameElementSearch::check_docid_match(uint32_t docid)
 void
 SameElementSearch::unpack_children(uint32_t docid)
 {
-    for (const auto &child: _children) {
-        child->doUnpack(docid);
+    for (size_t i = 0; i < _children.size(); ++i) {
+        if (_elementChildren[i] == nullptr) {
+            _children[i]->doUnpack(docid);
+            _iterators[i] = _childMatch[i]->begin();
+        }
     }
-    for (size_t i = 0; i < _childMatch.size(); ++i) {
-        _iterators[i] = _childMatch[i]->begin();
+}
+
+int32_t
+SameElementSearch::next_element(size_t child, uint32_t docid, int32_t cand)
+{
+    if (_elementChildren[child] != nullptr) {
+        return _elementChildren[child]->find_element(docid, cand);
     }
+    It &it = _iterators[child];
+    while ((it != _childMatch[child]->end()) && (int32_t(it->getElementId()) < cand)) {
+        ++it;
+    }
+    return (it == _childMatch[child]->end()) ? -1 : int32_t(it->getElementId());
 }
 
 bool
 SameElementSearch::check_element_match(uint32_t docid)
 {
     unpack_children(docid);
+    // leapfrog on element id until all children agree on a candidate
     int32_t cand = 0;
-    int32_t next = try_match(_childMatch, _iterators, cand);
-    while (next > cand) {
-        cand = next;
-        next = try_match(_childMatch, _iterators, cand);
+    size_t agree = 0;
+    for (size_t i = 0; agree < _children.size(); i = (i + 1) % _children.size()) {
+        int32_t next = next_element(i, docid, cand);
+        if (next < 0) {
+            return false;
+        }
+        if (next == cand) {
+            ++agree;
+        } else {
+            cand = next;
+            agree = 1;
+        }
     }
-    return (cand == next);
+    return true;
 }
 
 SameElementSearch::SameElementSearch(fef::MatchData::UP md,
@@ -74,10 +77,14 @@ SameElementSearch::SameElementSearch(fef::MatchData::UP md,
       _children(std::move(children)),
       _childMatch(childMatch),
       _iterators(childMatch.size()),
+      _elementChildren(),
       _strict(strict)
 {
     assert(!_children.empty());
     assert(_childMatch.valid());
+    for (const auto &child: _children) {
+        _elementChildren.push_back(dynamic_cast<const attribute::ElementIterator *>(child.get()));
+    }
 }
 
 void
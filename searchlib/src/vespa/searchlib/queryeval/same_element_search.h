@@ -9,11 +9,15 @@
 #include <memory>
 #include <vector>
 
+namespace search::attribute { class ElementIterator; }
+
 namespace search::queryeval {
 
 /**
  * Search iterator for a collection of terms that need to match within
- * the same element (array index).
+ * the same element (array index). Children searching attributes are
+ * asked for their next matching element directly, the others are
+ * unpacked and their positions are used.
  */
 class SameElementSearch : public SearchIterator
 {
@@ -24,9 +28,11 @@ private:
     std::vector<SearchIterator::UP> _children;
     fef::TermFieldMatchDataArray    _childMatch;
     std::vector<It>                 _iterators;
+    std::vector<const attribute::ElementIterator *> _elementChildren;
     bool                            _strict;
 
     void unpack_children(uint32_t docid);
+    int32_t next_element(size_t child, uint32_t docid, int32_t cand);
     bool check_docid_match(uint32_t docid);
     bool check_element_match(uint32_t docid);
 
@@ -6,7 +6,9 @@
 #include "begin_and_end_id.h"
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/trinary.h>
+#include <vespa/vespalib/util/thread_arena.h>
 #include <memory>
+#include <new>
 #include <vector>
 
 namespace vespalib { class ObjectVisitor; }
@@ -177,6 +179,16 @@ public:
     SearchIterator(const SearchIterator &) = delete;
     SearchIterator &operator=(const SearchIterator &) = delete;
 
+    // Allocated from the query arena bound to the current thread, if
+    // any (see vespalib::ThreadArena).
+    static void *operator new(size_t size) { return vespalib::ThreadArena::alloc(size); }
+    static void *operator new(size_t, void *ptr) noexcept { return ptr; }
+    static void operator delete(void *ptr) { vespalib::ThreadArena::free(ptr); }
+    static void operator delete(void *, void *) noexcept { }
+    // The arena only guarantees 16 byte alignment; over-aligned
+    // subclasses are allocated from the heap instead.
+    static void *operator new(size_t size, std::align_val_t align) { return ::operator new(size, align); }
+    static void operator delete(void *ptr, std::align_val_t align) { ::operator delete(ptr, align); }
 
     /**
      * Special value indicating that this searcher has not yet started
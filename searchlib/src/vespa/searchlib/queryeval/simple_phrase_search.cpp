@@ -3,13 +3,9 @@
 #include "simple_phrase_search.h"
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
 #include <vespa/vespalib/objects/visit.h>
-#include <algorithm>
-#include <functional>
 
 using search::fef::TermFieldMatchData;
 using std::unique_ptr;
-using std::mem_fun_ref;
-using std::transform;
 using std::vector;
 using vespalib::ObjectVisitor;
 
@@ -17,106 +13,26 @@ namespace search {
 namespace queryeval {
 
 namespace {
-// Helper class
-class PhraseMatcher {
-    const fef::TermFieldMatchDataArray &_tmds;
-    const vector<uint32_t> &_eval_order;
-    vector<TermFieldMatchData::PositionsIterator> &_iterators;
-    uint32_t _element_id;
-    uint32_t _position;
-
-    TermFieldMatchData::PositionsIterator &iterator(uint32_t word_index)
-    { return _iterators[word_index]; }
-
-    TermFieldMatchData::PositionsIterator end(uint32_t word_index)
-    { return _tmds[word_index]->end(); }
-
-    uint32_t elementId(uint32_t word_index)
-    { return iterator(word_index)->getElementId(); }
-
-    uint32_t position(uint32_t word_index)
-    { return iterator(word_index)->getPosition(); }
-
-    void iterateToElement(uint32_t word_index) {
-        while (iterator(word_index) != end(word_index) &&
-               elementId(word_index) < _element_id) {
-            ++iterator(word_index);
-        }
-    }
-
-    template <typename FwdIt>
-    bool match(FwdIt first, FwdIt last) {
-        if (first == last) {
-            return true;
-        }
-        uint32_t word_index = *first;
-
-        iterateToElement(word_index);
-        while (iterator(word_index) != end(word_index) &&
-               elementId(word_index) == _element_id) {
-            if (position(word_index) == _position + word_index) {
-                return match(++first, last);
-            } else if (position(word_index) > _position + word_index) {
-                return false;
-            }
-            ++iterator(word_index);
-        }
-        return false;
-    }
-
-    bool match() {
-        _element_id = elementId(_eval_order[0]);
-        if (position(_eval_order[0]) < _eval_order[0]) {
-            // this position too early in element to allow match of other phrase terms
-            return false;
-        }
-        _position = position(_eval_order[0]) - _eval_order[0];
-        return match(++_eval_order.begin(), _eval_order.end());
-    }
 
-public:
-    PhraseMatcher(const fef::TermFieldMatchDataArray &tmds,
-                  const vector<uint32_t> &eval_order,
-                  vector<TermFieldMatchData::PositionsIterator> &iterators)
-        : _tmds(tmds),
-          _eval_order(eval_order),
-          _iterators(iterators)
-    {
-        for (size_t i = 0; i < _tmds.size(); ++i) {
-            _iterators[i] = _tmds[i]->begin();
-        }
-    }
+using vespalib::hwaccelrated::IAccelrated;
 
-    bool hasMatch() {
-        if (_tmds.size() == 1) {
-            return true;
-        }
+const IAccelrated &
+getAccelrator()
+{
+    static IAccelrated::UP accelrator = IAccelrated::getAccelrator();
+    return *accelrator;
+}
 
-        while (iterator(_eval_order[0]) != end(_eval_order[0])) {
-            if (match()) {
-                return true;
-            }
-            ++iterator(_eval_order[0]);
-        }
-        return false;
-    }
+uint64_t positionKey(const fef::TermFieldMatchDataPosition &pos) {
+    return ((uint64_t(pos.getElementId()) << 32) | pos.getPosition());
+}
 
-    void fillPositions(TermFieldMatchData &tmd) {
-        if (_tmds.size() == 1) {
-            for (TermFieldMatchData::PositionsIterator
-                     it = _tmds[0]->begin(); it != _tmds[0]->end(); ++it) {
-                tmd.appendPosition(*it);
-            }
-        } else {
-            while (iterator(_eval_order[0]) != end(_eval_order[0])) {
-                if (match()) {
-                    tmd.appendPosition(*iterator(0));
-                }
-                ++iterator(_eval_order[0]);
-            }
-        }
+void decodePositions(const TermFieldMatchData &tmd, vector<uint64_t> &column) {
+    column.clear();
+    for (TermFieldMatchData::PositionsIterator it = tmd.begin(); it != tmd.end(); ++it) {
+        column.push_back(positionKey(*it));
     }
-};
+}
 
 bool allTermsHaveMatch(const SimplePhraseSearch::Children &terms,
                        const vector<uint32_t> &eval_order, uint32_t doc_id) {
@@ -135,13 +51,44 @@ void SimplePhraseSearch::phraseSeek(uint32_t doc_id) {
             setAtEnd();
         } else {
             AndSearch::doUnpack(doc_id);
-            if (PhraseMatcher(_childMatch, _eval_order, _iterators).hasMatch()) {
+            if (_childMatch.size() == 1) {
                 setDocId(doc_id);
+            } else {
+                findPhraseStarts();
+                if (!_starts.empty()) {
+                    setDocId(doc_id);
+                }
             }
         }
     }
 }
 
+/**
+ * The positions of the first term in evaluation order, shifted back
+ * by its offset in the phrase, are the candidate phrase starts. These
+ * are intersected with the positions of each following term shifted
+ * back by its offset, stopping as soon as no candidates remain.
+ **/
+void SimplePhraseSearch::findPhraseStarts() {
+    const uint32_t first = _eval_order[0];
+    decodePositions(*_childMatch[first], _columns[first]);
+    _starts.clear();
+    for (uint64_t key : _columns[first]) {
+        if (uint32_t(key) >= first) {
+            // positions too early in element cannot start a phrase match
+            _starts.push_back(key - first);
+        }
+    }
+    size_t num_starts = _starts.size();
+    for (size_t i = 1; (i < _eval_order.size()) && (num_starts > 0); ++i) {
+        const uint32_t word_index = _eval_order[i];
+        vector<uint64_t> &column = _columns[word_index];
+        decodePositions(*_childMatch[word_index], column);
+        num_starts = _accel.intersectShifted(&_starts[0], num_starts, column.data(), column.size(),
+                                             word_index, &_starts[0]);
+    }
+    _starts.resize(num_starts);
+}
 
 SimplePhraseSearch::SimplePhraseSearch(const Children &children,
                                        fef::MatchData::UP md,
@@ -155,7 +102,9 @@ SimplePhraseSearch::SimplePhraseSearch(const Children &children,
       _tmd(tmd),
       _doom(nullptr),
       _strict(strict),
-      _iterators(children.size())
+      _accel(getAccelrator()),
+      _columns(children.size()),
+      _starts()
 {
     assert(!children.empty());
     assert(children.size() == _childMatch.size());
@@ -185,7 +134,22 @@ void SimplePhraseSearch::doUnpack(uint32_t doc_id) {
     // All children has already been unpacked before this call is made.
 
     _tmd.reset(doc_id);
-    PhraseMatcher(_childMatch, _eval_order, _iterators).fillPositions(_tmd);
+    const TermFieldMatchData &first = *_childMatch[0];
+    if (_childMatch.size() == 1) {
+        for (TermFieldMatchData::PositionsIterator it = first.begin(); it != first.end(); ++it) {
+            _tmd.appendPosition(*it);
+        }
+        return;
+    }
+    findPhraseStarts();
+    // phrase starts are positions of the first term, report those
+    TermFieldMatchData::PositionsIterator it = first.begin();
+    for (uint64_t start : _starts) {
+        while (positionKey(*it) < start) {
+            ++it;
+        }
+        _tmd.appendPosition(*it);
+    }
 }
 
 void SimplePhraseSearch::visitMembers(ObjectVisitor &visitor) const {
@@ -7,6 +7,7 @@
 #include <vespa/searchlib/fef/matchdata.h>
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 #include <memory>
 #include <vector>
 
@@ -26,11 +27,14 @@ class SimplePhraseSearch : public AndSearch
     const vespalib::Doom        *_doom;
     bool                         _strict;
 
-    typedef fef::TermFieldMatchData::PositionsIterator It;
-    // Reuse this vector instead of allocating a new one when needed.
-    std::vector<It> _iterators;
+    const vespalib::hwaccelrated::IAccelrated &_accel;
+    // Decoded positions for each term, packed as (element id, position).
+    // Reuse these vectors instead of allocating new ones when needed.
+    std::vector<std::vector<uint64_t>> _columns;
+    std::vector<uint64_t>              _starts;
 
     void phraseSeek(uint32_t doc_id);
+    void findPhraseStarts();
 
 public:
     /**
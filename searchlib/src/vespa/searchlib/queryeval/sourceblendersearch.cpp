@@ -10,6 +10,17 @@ namespace queryeval {
 
 EmptySearch SourceBlenderSearch::_emptySearch;
 
+inline SearchIterator *
+SourceBlenderSearch::getRunSearch(uint32_t docid)
+{
+    if (docid >= _runEnd) {
+        Source source = _sourceSelector->getSource(docid);
+        _runSearch = getSearch(source);
+        _runEnd = _sourceSelector->getRunEnd(docid, source);
+    }
+    return _runSearch;
+}
+
 class SourceBlenderSearchStrict : public SourceBlenderSearch
 {
 public:
@@ -38,7 +49,7 @@ SourceBlenderSearch::doSeek(uint32_t docid)
         setDocId(endDocId);
         return;
     }
-    _matchedChild = getSearch(_sourceSelector->getSource(docid));
+    _matchedChild = getRunSearch(docid);
     if (_matchedChild->seek(docid)) {
         setDocId(docid);
     }
@@ -47,19 +58,31 @@ SourceBlenderSearch::doSeek(uint32_t docid)
 void
 SourceBlenderSearchStrict::doSeek(uint32_t docid)
 {
-    if (docid >= _docIdLimit) {
-        setDocId(endDocId);
-        return;
-    }
-    _matchedChild = getSearch(_sourceSelector->getSource(docid));
-    if (_matchedChild->seek(docid)) {
-        setDocId(docid);
-    } else {
-        for (auto & child : _children) {
-            getSearch(child)->seek(docid);
+    for (;;) {
+        if (docid >= _docIdLimit) {
+            setDocId(endDocId);
+            return;
+        }
+        _matchedChild = getRunSearch(docid);
+        if (_matchedChild->seek(docid)) {
+            setDocId(docid);
+            return;
         }
-        advance();
+        if (_runEnd <= docid + 1) {
+            break;
+        }
+        // Only the search of this source can produce hits within the run.
+        uint32_t nextId = _matchedChild->getDocId();
+        if (!isEmptySearch(_matchedChild) && (nextId < _runEnd)) {
+            setDocId(nextId);
+            return;
+        }
+        docid = _runEnd;
+    }
+    for (auto & child : _children) {
+        getSearch(child)->seek(docid);
     }
+    advance();
 }
 
 void
@@ -89,7 +112,7 @@ SourceBlenderSearchStrict::advance()
             setAtEnd();
             return;
         }
-        search = getSearch(_sourceSelector->getSource(minNextId));
+        search = getRunSearch(minNextId);
         for (uint32_t i = 0; i < _nextChildren.size(); ++i) {
             if (_nextChildren[i] == search) {
                 _matchedChild = search;
@@ -113,7 +136,9 @@ SourceBlenderSearch::SourceBlenderSearch(
     _matchedChild(NULL),
     _sourceSelector(std::move(sourceSelector)),
     _children(),
-    _docIdLimit(_sourceSelector->getDocIdLimit())
+    _docIdLimit(_sourceSelector->getDocIdLimit()),
+    _runSearch(&_emptySearch),
+    _runEnd(0)
 {
     for (size_t i(0); i < sizeof(_sources)/sizeof(_sources[0]); i++) {
         _sources[i] = &_emptySearch;
@@ -129,6 +154,7 @@ void
 SourceBlenderSearch::initRange(uint32_t beginid, uint32_t endid)
 {
     SearchIterator::initRange(beginid, endid);
+    _runEnd = 0;
     for (auto & child : _children) {
         getSearch(child)->initRange(beginid, endid);
     }
@@ -156,6 +182,7 @@ void
 SourceBlenderSearch::setChild(size_t index, SearchIterator::UP child) {
     assert(_sources[_children[index]] == NULL);
     _sources[_children[index]] = child.release();
+    _runEnd = 0;
 }
 
 SourceBlenderSearch *
@@ -18,6 +18,11 @@ namespace queryeval {
  * document. The source blender will make sure to only propagate
  * unpack requests to one of the sources below, enabling them to use
  * the same target location for detailed match data unpacking.
+ *
+ * The source of a document is looked up together with the run of
+ * following documents using the same source. Seeks within that run
+ * go directly to the search of that source, and a strict blender
+ * only advances that search while inside the run.
  **/
 class SourceBlenderSearch : public SearchIterator
 {
@@ -49,12 +54,16 @@ protected:
     SourceIndex                 _children;
     uint32_t                    _docIdLimit;
     SearchIterator            * _sources[256];
+    SearchIterator            * _runSearch;
+    uint32_t                    _runEnd;
 
     void doSeek(uint32_t docid) override;
     void doUnpack(uint32_t docid) override;
     Trinary is_strict() const override { return Trinary::False; }
     SourceBlenderSearch(std::unique_ptr<Iterator> sourceSelector, const Children &children);
     SearchIterator * getSearch(Source source) const { return _sources[source]; }
+    SearchIterator * getRunSearch(uint32_t docid);
+    bool isEmptySearch(const SearchIterator * search) const { return search == &_emptySearch; }
 public:
     /**
      * Create a new SourceBlender Search with the given children and
@@ -76,6 +85,7 @@ public:
     SearchIterator::UP steal(size_t index) {
         SearchIterator::UP retval(_sources[_children[index]]);
         _sources[_children[index]] = NULL;
+        _runEnd = 0;
         return retval;
     }
     void setChild(size_t index, SearchIterator::UP child);
@@ -29,6 +29,7 @@ using search::query::QueryVisitor;
 using search::query::RangeTerm;
 using search::query::Rank;
 using search::query::RegExpTerm;
+using search::query::NearestNeighborTerm;
 using search::query::StringTerm;
 using search::query::SubstringTerm;
 using search::query::SuffixTerm;
@@ -101,6 +102,7 @@ struct TermAsStringVisitor : public QueryVisitor {
     void visit(SuffixTerm &n) override {visitTerm(n); }
     void visit(RegExpTerm &n) override {visitTerm(n); }
     void visit(PredicateQuery &) override {illegalVisit(); }
+    void visit(NearestNeighborTerm &) override {illegalVisit(); }
 };
 }  // namespace
 
@@ -14,35 +14,71 @@ struct TermwiseSearch : public SearchIterator {
     BitVector::UP      result;
     uint32_t           my_beginid;
     uint32_t           my_first_hit;
+    uint32_t           my_window_size;
+    uint32_t           my_window_begin;
+    uint32_t           my_window_end;
 
     bool same_range(uint32_t beginid, uint32_t endid) const {
-        return ((beginid == my_beginid) && endid == getEndId());
+        return ((beginid == my_beginid) && endid == getEndId() && (my_window_begin == my_beginid));
     }
 
-    TermwiseSearch(SearchIterator::UP search_in)
-        : search(std::move(search_in)), result(), my_beginid(0), my_first_hit(0) {}
+    void fetch_window(uint32_t beginid) {
+        my_window_begin = beginid;
+        my_window_end = (my_window_size == 0)
+                        ? getEndId()
+                        : std::min(getEndId(), beginid + std::min(my_window_size, getEndId() - beginid));
+        search->initRange(my_window_begin, my_window_end);
+        result = search->get_hits(my_window_begin);
+    }
+
+    // fetch windows until a hit at or after docid is found, returns endDocId if there is none
+    uint32_t find_next_hit(uint32_t docid) {
+        uint32_t nextid = result->getNextTrueBit(docid);
+        while (__builtin_expect(nextid >= my_window_end, false)) {
+            if (isAtEnd(my_window_end)) {
+                return search::endDocId;
+            }
+            fetch_window(my_window_end);
+            nextid = result->getNextTrueBit(my_window_begin);
+        }
+        return nextid;
+    }
+
+    TermwiseSearch(SearchIterator::UP search_in, uint32_t window_size)
+        : search(std::move(search_in)), result(), my_beginid(0), my_first_hit(0),
+          my_window_size(window_size), my_window_begin(0), my_window_end(0) {}
 
     Trinary is_strict() const override { return IS_STRICT ? Trinary::True : Trinary::False; }
     void initRange(uint32_t beginid, uint32_t endid) override {
         if (!same_range(beginid, endid)) {
             my_beginid = beginid;
             SearchIterator::initRange(beginid, endid);
-            search->initRange(beginid, endid);
-            my_first_hit = std::max(getDocId(), search->getDocId());
-            result = search->get_hits(beginid);
+            fetch_window(beginid);
+            // only a strict iterator may be positioned on its first hit; the
+            // window bounds themselves are never reported as hits
+            my_first_hit = IS_STRICT ? find_next_hit(beginid) : (beginid - 1);
+        }
+        if (my_first_hit == search::endDocId) {
+            setAtEnd();
+        } else {
+            setDocId(my_first_hit);
         }
-        setDocId(my_first_hit);
     }
     void doSeek(uint32_t docid) override {
         if (__builtin_expect(isAtEnd(docid), false)) {
             setAtEnd();
-        } else if (IS_STRICT) {
-            uint32_t nextid = result->getNextTrueBit(docid);
-            if (__builtin_expect(isAtEnd(nextid), false)) {
+            return;
+        }
+        if (__builtin_expect(docid >= my_window_end, false)) {
+            fetch_window(docid);
+        }
+        if (IS_STRICT) {
+            uint32_t nextid = find_next_hit(docid);
+            if (nextid == search::endDocId) {
                 setAtEnd();
-            } else {
-                setDocId(nextid);
+                return;
             }
+            setDocId(nextid);
         } else if (result->testBit(docid)) {
             setDocId(docid);
         }
@@ -55,14 +91,20 @@ struct TermwiseSearch : public SearchIterator {
 };
 
 SearchIterator::UP
-make_termwise(SearchIterator::UP search, bool strict)
+make_termwise(SearchIterator::UP search, bool strict, uint32_t window_size)
 {
     if (strict) {
-        return SearchIterator::UP(new TermwiseSearch<true>(std::move(search)));
+        return SearchIterator::UP(new TermwiseSearch<true>(std::move(search), window_size));
     } else {
-        return SearchIterator::UP(new TermwiseSearch<false>(std::move(search)));        
+        return SearchIterator::UP(new TermwiseSearch<false>(std::move(search), window_size));
     }
 }
 
+SearchIterator::UP
+make_termwise(SearchIterator::UP search, bool strict)
+{
+    return make_termwise(std::move(search), strict, default_termwise_window_size);
+}
+
 } // namespace queryeval
 } // namespace search
@@ -23,5 +23,20 @@ namespace queryeval {
  **/
 SearchIterator::UP make_termwise(SearchIterator::UP search, bool strict);
 
+/**
+ * The number of documents evaluated together by the termwise
+ * wrapper. Hits are calculated one window of the active range at a
+ * time, keeping the intermediate bitvectors of the whole subtree small
+ * enough to stay in cache while the bitvector operations combine
+ * them. A window size of 0 evaluates the whole active range at once.
+ **/
+constexpr uint32_t default_termwise_window_size = 64 * 1024;
+
+/**
+ * Creates a termwise wrapper evaluating the underlying search in
+ * windows of the given size.
+ **/
+SearchIterator::UP make_termwise(SearchIterator::UP search, bool strict, uint32_t window_size);
+
 } // namespace queryeval
 } // namespace search
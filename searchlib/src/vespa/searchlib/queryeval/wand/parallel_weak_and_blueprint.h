@@ -13,6 +13,10 @@ namespace search {
 namespace queryeval {
 
 const uint32_t DEFAULT_PARALLEL_WAND_SCORES_ADJUST_FREQUENCY = 4;
+// With at least this many terms over a document weight attribute, the
+// pruned dot product (MaxScore) is used instead of WAND, as the cost of
+// keeping all terms ordered by docid dominates for large queries.
+const uint32_t DEFAULT_PARALLEL_WAND_MAX_SCORE_MIN_TERMS = 256;
 
 /**
  * Blueprint for the parallel weak and search operator.
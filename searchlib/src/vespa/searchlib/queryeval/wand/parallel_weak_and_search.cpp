@@ -33,6 +33,7 @@ private:
     score_t                        _boostedThreshold;
     const MatchParams              _matchParams;
     std::vector<score_t>           _localScores;
+    const bool                     _useBlockMax;
 
     void updateThreshold(score_t newThreshold) {
         if (newThreshold > _threshold) {
@@ -41,10 +42,20 @@ private:
         }
     }
 
+    bool check_block_max(docid_t &skipTo) {
+        if (!_useBlockMax) {
+            return true;
+        }
+        return _algo.check_block_max(_terms, _heaps, skipTo, DotProductScorer(), GreaterThan(_boostedThreshold));
+    }
+
     void seek_strict(uint32_t docid) {
         _algo.set_candidate(_terms, _heaps, docid);
+        docid_t skipTo = 0;
         while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
-            if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
+            if (!check_block_max(skipTo)) {
+                _algo.set_candidate(_terms, _heaps, skipTo);
+            } else if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                 setDocId(_algo.get_candidate());
                 return;
             } else {
@@ -57,7 +68,8 @@ private:
     void seek_unstrict(uint32_t docid) {
         if (docid > _algo.get_candidate()) {
             _algo.set_candidate(_terms, _heaps, docid);
-            if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
+            docid_t skipTo = 0;
+            if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold)) && check_block_max(skipTo)) {
                 if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                     setDocId(_algo.get_candidate());
                 }
@@ -76,7 +88,8 @@ public:
           _threshold(matchParams.scoreThreshold),
           _boostedThreshold(_threshold * matchParams.thresholdBoostFactor),
           _matchParams(matchParams),
-          _localScores()
+          _localScores(),
+          _useBlockMax(_terms.has_block_max())
     {
     }
     virtual size_t get_num_terms() const override { return _terms.size(); }
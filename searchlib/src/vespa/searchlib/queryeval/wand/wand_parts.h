@@ -177,6 +177,10 @@ public:
 
     uint32_t seek(uint16_t ref, uint32_t docid) { return _iteratorPack.seek(ref, docid); }
     int32_t get_weight(uint16_t ref, uint32_t docid) { return _iteratorPack.get_weight(ref, docid); }
+    bool has_block_max() const { return _iteratorPack.has_block_max(); }
+    uint32_t get_block_max_weight(uint16_t ref, uint32_t docid, int32_t &max_weight) {
+        return _iteratorPack.get_block_max_weight(ref, docid, max_weight);
+    }
     
     vespalib::string stringify_docid() const;
 };
@@ -336,6 +340,8 @@ public:
     }
     ref_t *present_begin() const { return _present; }
     ref_t *present_end() const { return _past; }
+    ref_t *past_begin() const { return _past; }
+    ref_t *past_end() const { return _trash; }
     vespalib::string stringify() const;
 };
 
@@ -445,6 +451,18 @@ struct DotProductScorer
     static score_t calculateScore(VectorizedTerms &terms, ref_t ref, docid_t docId) {
         return terms.weight(ref) * (score_t)terms.get_weight(ref, docId);
     }
+
+    // upper bound for the score of the term within the posting list
+    // block covering docId, never above the max score of the term
+    template <typename VectorizedTerms>
+    static score_t calculateBlockMaxScore(VectorizedTerms &terms, ref_t ref, docid_t docId, docid_t &blockEnd) {
+        int32_t maxWeight = 0;
+        blockEnd = terms.get_block_max_weight(ref, docId, maxWeight);
+        if (terms.weight(ref) < 0) {
+            return terms.maxScore(ref);
+        }
+        return std::min(terms.maxScore(ref), terms.weight(ref) * (score_t)maxWeight);
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -616,6 +634,36 @@ public:
         return true;
     }
 
+    /**
+     * Check the candidate against the block max scores of all terms
+     * that may match it. If the combined bound is below the
+     * threshold, no document up to the end of the shortest of those
+     * blocks can be a hit either, and skipTo is set to the first
+     * document id worth looking at.
+     **/
+    template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
+    bool check_block_max(VectorizedTerms &terms, Heaps &heaps, docid_t &skipTo, Scorer &&, AboveThreshold &&aboveThreshold) {
+        score_t bound = 0;
+        docid_t blockEnd = search::endDocId;
+        docid_t termBlockEnd = 0;
+        for (ref_t *ref = heaps.present_begin(); ref != heaps.present_end(); ++ref) {
+            bound += Scorer::calculateBlockMaxScore(terms, *ref, _candidate, termBlockEnd);
+            blockEnd = std::min(blockEnd, termBlockEnd);
+        }
+        for (ref_t *ref = heaps.past_begin(); ref != heaps.past_end(); ++ref) {
+            bound += Scorer::calculateBlockMaxScore(terms, *ref, _candidate, termBlockEnd);
+            blockEnd = std::min(blockEnd, termBlockEnd);
+        }
+        if (aboveThreshold(bound)) {
+            return true;
+        }
+        skipTo = (blockEnd < search::endDocId) ? (blockEnd + 1) : search::endDocId;
+        if (heaps.has_future()) {
+            skipTo = std::min(skipTo, terms.docId(heaps.future()));
+        }
+        return false;
+    }
+
     template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
     bool check_score(VectorizedTerms &terms, Heaps &heaps, Scorer &&scorer, AboveThreshold &&aboveThreshold) {
         _partial_score = 0;
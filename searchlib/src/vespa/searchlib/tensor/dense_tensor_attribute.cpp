@@ -89,13 +89,28 @@ TensorReader::getNumCells() {
 DenseTensorAttribute::DenseTensorAttribute(const vespalib::stringref &baseFileName,
                                  const Config &cfg)
     : TensorAttribute(baseFileName, cfg, _denseTensorStore),
-      _denseTensorStore(cfg.tensorType())
+      _denseTensorStore(cfg.tensorType()),
+      _index()
 {
+    if (cfg.hugePages()) {
+        _denseTensorStore.setHugePages(true);
+    }
+    if (cfg.hnswIndexParams().enabled()) {
+        if (cfg.tensorType().is_dense() && !cfg.tensorType().is_abstract() &&
+            (cfg.tensorType().cell_type() == vespalib::eval::ValueType::CellType::DOUBLE))
+        {
+            _index = std::make_unique<HnswIndex>(*this, cfg.hnswIndexParams(), getGenerationHolder());
+        } else {
+            LOG(warning, "Attribute '%s': hnsw index requires a dense tensor type with bound dimensions and double cells, not '%s'",
+                getName().c_str(), cfg.tensorType().to_spec().c_str());
+        }
+    }
 }
 
 
 DenseTensorAttribute::~DenseTensorAttribute()
 {
+    _index.reset();
     getGenerationHolder().clearHoldLists();
     _tensorStore.clearHoldLists();
 }
@@ -103,9 +118,51 @@ DenseTensorAttribute::~DenseTensorAttribute()
 void
 DenseTensorAttribute::setTensor(DocId docId, const Tensor &tensor)
 {
+    if (_index && _refVector[docId].valid()) {
+        _index->removeDocument(docId);
+    }
     RefType ref = _denseTensorStore.setTensor(
             (_tensorMapper ? *_tensorMapper->map(tensor) : tensor));
     setTensorRef(docId, ref);
+    if (_index) {
+        _index->addDocument(docId);
+    }
+}
+
+uint32_t
+DenseTensorAttribute::clearDoc(DocId docId)
+{
+    if (_index) {
+        _index->removeDocument(docId);
+    }
+    return TensorAttribute::clearDoc(docId);
+}
+
+void
+DenseTensorAttribute::clearDocs(DocId lidLow, DocId lidLimit)
+{
+    if (_index) {
+        for (DocId lid = lidLow; lid < lidLimit; ++lid) {
+            _index->removeDocument(lid);
+        }
+    }
+    TensorAttribute::clearDocs(lidLow, lidLimit);
+}
+
+vespalib::ConstArrayRef<double>
+DenseTensorAttribute::getVector(uint32_t docId) const
+{
+    RefType ref;
+    if (docId < _refVector.size()) {
+        ref = _refVector[docId];
+    }
+    if (!ref.valid()) {
+        return vespalib::ConstArrayRef<double>();
+    }
+    assert(_denseTensorStore.getCellType() == vespalib::eval::ValueType::CellType::DOUBLE);
+    const void *buffer = _denseTensorStore.getRawBuffer(ref);
+    return vespalib::ConstArrayRef<double>(static_cast<const double *>(buffer),
+                                           _denseTensorStore.getNumCells(buffer));
 }
 
 
@@ -161,9 +218,24 @@ DenseTensorAttribute::onLoad()
     }
     setNumDocs(numDocs);
     setCommittedDocIdLimit(numDocs);
+    buildIndex();
     return true;
 }
 
+void
+DenseTensorAttribute::buildIndex()
+{
+    // The graph is not saved, it is built from the loaded tensors
+    if (!_index) {
+        return;
+    }
+    for (uint32_t lid = 0; lid < _refVector.size(); ++lid) {
+        if (_refVector[lid].valid()) {
+            _index->addDocument(lid);
+        }
+    }
+}
+
 
 std::unique_ptr<AttributeSaver>
 DenseTensorAttribute::onInitSave()
@@ -189,6 +261,43 @@ DenseTensorAttribute::getVersion() const
     return DENSE_TENSOR_ATTRIBUTE_VERSION;
 }
 
+void
+DenseTensorAttribute::onUpdateStat()
+{
+    if (!_index) {
+        TensorAttribute::onUpdateStat();
+        return;
+    }
+    MemoryUsage total = _refVector.getMemoryUsage();
+    total.merge(_tensorStore.getMemoryUsage());
+    total.merge(_index->getMemoryUsage());
+    total.mergeGenerationHeldBytes(getGenerationHolder().getHeldBytes());
+    this->updateStatistics(_refVector.size(),
+                           _refVector.size(),
+                           total.allocatedBytes(),
+                           total.usedBytes(),
+                           total.deadBytes(),
+                           total.allocatedBytesOnHold());
+}
+
+void
+DenseTensorAttribute::removeOldGenerations(generation_t firstUsed)
+{
+    TensorAttribute::removeOldGenerations(firstUsed);
+    if (_index) {
+        _index->trimHoldLists(firstUsed);
+    }
+}
+
+void
+DenseTensorAttribute::onGenerationChange(generation_t generation)
+{
+    TensorAttribute::onGenerationChange(generation);
+    if (_index) {
+        _index->transferHoldLists(generation - 1);
+    }
+}
+
 }  // namespace search::tensor
 
 }  // namespace search
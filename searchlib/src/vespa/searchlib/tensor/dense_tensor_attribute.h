@@ -4,6 +4,8 @@
 
 #include "tensor_attribute.h"
 #include "dense_tensor_store.h"
+#include "doc_vector_access.h"
+#include "hnsw_index.h"
 
 namespace vespalib { namespace tensor { class MutableDenseTensorView; }}
 
@@ -13,11 +15,15 @@ namespace tensor {
 
 /**
  * Attribute vector class used to store dense tensors for all
- * documents in memory.
+ * documents in memory. Optionally maintains a hnsw index over the
+ * tensors, used for approximate nearest neighbor search.
  */
-class DenseTensorAttribute : public TensorAttribute
+class DenseTensorAttribute : public TensorAttribute, public DocVectorAccess
 {
     DenseTensorStore _denseTensorStore;
+    std::unique_ptr<HnswIndex> _index;
+
+    void buildIndex();
 public:
     DenseTensorAttribute(const vespalib::stringref &baseFileName, const Config &cfg);
     virtual ~DenseTensorAttribute();
@@ -28,6 +34,13 @@ public:
     virtual std::unique_ptr<AttributeSaver> onInitSave() override;
     virtual void compactWorst() override;
     virtual uint32_t getVersion() const override;
+    virtual uint32_t clearDoc(DocId docId) override;
+    virtual void clearDocs(DocId lidLow, DocId lidLimit) override;
+    virtual void onUpdateStat() override;
+    virtual void removeOldGenerations(generation_t firstUsed) override;
+    virtual void onGenerationChange(generation_t generation) override;
+    vespalib::ConstArrayRef<double> getVector(uint32_t docId) const override;
+    const HnswIndex *getIndex() const { return _index.get(); }
 };
 
 
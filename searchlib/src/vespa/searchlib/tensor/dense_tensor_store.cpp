@@ -50,7 +50,7 @@ DenseTensorStore::DenseTensorStore(const ValueType &type)
       _type(type),
       _numBoundCells(1u),
       _numUnboundDims(0u),
-      _cellSize(sizeof(double)),
+      _cellSize(ValueType::cell_size(type.cell_type())),
       _emptyCells()
 {
     for (const auto & dim : _type.dimensions()) {
@@ -162,6 +162,38 @@ void makeConcreteType(MutableDenseTensorView &tensor,
     tensor.setUnboundDimensions(unboundDimSizeBegin, unboundDimSizeEnd);
 }
 
+ValueType makeConcreteType(const ValueType &type, const void *buffer, uint32_t numUnboundDims)
+{
+    const uint32_t *unboundDimSize = static_cast<const uint32_t *>(buffer) - numUnboundDims;
+    std::vector<ValueType::Dimension> dimensions;
+    for (const auto &dim : type.dimensions()) {
+        dimensions.emplace_back(dim.name, dim.is_bound() ? dim.size : *unboundDimSize++);
+    }
+    return ValueType::tensor_type(std::move(dimensions), type.cell_type());
+}
+
+template <typename CellType>
+vespalib::ConstArrayRef<CellType> storedCells(const void *buffer, size_t numCells)
+{
+    return vespalib::ConstArrayRef<CellType>(static_cast<const CellType *>(buffer), numCells);
+}
+
+template <typename CellType>
+DenseTensor::Cells convertCells(const void *buffer, size_t numCells)
+{
+    auto cells = storedCells<CellType>(buffer, numCells);
+    return DenseTensor::Cells(cells.cbegin(), cells.cend());
+}
+
+template <typename CellType>
+void storeCells(void *buffer, DenseTensorView::CellsRef cells)
+{
+    CellType *dst = static_cast<CellType *>(buffer);
+    for (double cell : cells) {
+        *dst++ = static_cast<CellType>(cell);
+    }
+}
+
 }
 
 std::unique_ptr<Tensor>
@@ -173,6 +205,16 @@ DenseTensorStore::getTensor(EntryRef ref) const
     }
     auto raw = getRawBuffer(ref);
     size_t numCells = getNumCells(raw);
+    switch (getCellType()) {
+    case ValueType::CellType::DOUBLE:
+        break;
+    case ValueType::CellType::FLOAT:
+        return std::make_unique<DenseTensor>(makeConcreteType(_type, raw, _numUnboundDims),
+                                             convertCells<float>(raw, numCells));
+    case ValueType::CellType::INT8:
+        return std::make_unique<DenseTensor>(makeConcreteType(_type, raw, _numUnboundDims),
+                                             convertCells<int8_t>(raw, numCells));
+    }
     if (_numUnboundDims == 0) {
         return std::make_unique<DenseTensorView>(_type, CellsRef(static_cast<const double *>(raw), numCells));
     } else {
@@ -193,7 +235,17 @@ DenseTensorStore::getTensor(EntryRef ref, MutableDenseTensorView &tensor) const
     } else {
         auto raw = getRawBuffer(ref);
         size_t numCells = getNumCells(raw);
-        tensor.setCells(DenseTensorView::CellsRef(static_cast<const double *>(raw), numCells));
+        switch (getCellType()) {
+        case ValueType::CellType::DOUBLE:
+            tensor.setCells(DenseTensorView::CellsRef(static_cast<const double *>(raw), numCells));
+            break;
+        case ValueType::CellType::FLOAT:
+            tensor.setConvertedCells(storedCells<float>(raw, numCells));
+            break;
+        case ValueType::CellType::INT8:
+            tensor.setConvertedCells(storedCells<int8_t>(raw, numCells));
+            break;
+        }
         if (_numUnboundDims > 0) {
             makeConcreteType(tensor, raw, _numUnboundDims);
         }
@@ -254,7 +306,17 @@ DenseTensorStore::setDenseTensor(const TensorType &tensor)
     checkMatchingType(_type, tensor.type(), numCells);
     auto raw = allocRawBuffer(numCells);
     setDenseTensorUnboundDimSizes(raw.data, _type, _numUnboundDims, tensor.type());
-    memcpy(raw.data, &tensor.cellsRef()[0], numCells * _cellSize);
+    switch (getCellType()) {
+    case ValueType::CellType::DOUBLE:
+        memcpy(raw.data, &tensor.cellsRef()[0], numCells * _cellSize);
+        break;
+    case ValueType::CellType::FLOAT:
+        storeCells<float>(raw.data, tensor.cellsRef());
+        break;
+    case ValueType::CellType::INT8:
+        storeCells<int8_t>(raw.data, tensor.cellsRef());
+        break;
+    }
     return raw.ref;
 }
 
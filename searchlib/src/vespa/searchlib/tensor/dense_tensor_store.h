@@ -22,6 +22,10 @@ namespace search::tensor {
  * If both start of tensor dimension size information and start of
  * tensor cells were to be 32 byte aligned then tensors of type tensor(x[3])
  * would use 64 bytes.
+ *
+ * Cells are stored with the cell type of the tensor type, e.g. 4 bytes
+ * per cell for tensor<float>(x[768]). Cells that are not doubles are
+ * converted to doubles when a tensor is read.
  */
 class DenseTensorStore : public TensorStore
 {
@@ -72,6 +76,7 @@ public:
     uint32_t unboundDimSizesSize() const { return _bufferType.unboundDimSizesSize(); }
     size_t getNumCells(const void *buffer) const;
     uint32_t getCellSize() const { return _cellSize; }
+    ValueType::CellType getCellType() const { return _type.cell_type(); }
     const void *getRawBuffer(RefType ref) const;
     datastore::Handle<char> allocRawBuffer(size_t numCells, const std::vector<uint32_t> &unboundDimSizes);
     void holdTensor(EntryRef ref) override;
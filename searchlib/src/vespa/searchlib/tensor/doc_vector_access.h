@@ -0,0 +1,26 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/arrayref.h>
+#include <cstdint>
+
+namespace search::tensor {
+
+/**
+ * Interface that provides access to the vector of a document, used
+ * by a nearest neighbor index to calculate distances.
+ */
+class DocVectorAccess
+{
+public:
+    virtual ~DocVectorAccess() {}
+
+    /**
+     * Returns the cells of the dense tensor of the given document,
+     * or an empty array if the document has no tensor.
+     **/
+    virtual vespalib::ConstArrayRef<double> getVector(uint32_t docId) const = 0;
+};
+
+}
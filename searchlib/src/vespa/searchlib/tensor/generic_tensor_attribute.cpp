@@ -39,6 +39,9 @@ public:
 GenericTensorAttribute::GenericTensorAttribute(const vespalib::stringref &baseFileName, const Config &cfg)
     : TensorAttribute(baseFileName, cfg, _genericTensorStore)
 {
+    if (cfg.hugePages()) {
+        _genericTensorStore.setHugePages(true);
+    }
 }
 
 
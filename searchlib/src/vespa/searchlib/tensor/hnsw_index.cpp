@@ -0,0 +1,453 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "hnsw_index.h"
+#include <vespa/searchlib/common/rcuvector.hpp>
+#include <vespa/searchlib/datastore/array_store.hpp>
+#include <vespa/vespalib/stllike/hash_set.h>
+#include <vespa/vespalib/util/alloc.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+namespace search::tensor {
+
+namespace {
+
+constexpr size_t SMALL_MEMORY_PAGE_SIZE = 4 * 1024;
+constexpr size_t MIN_NUM_ARRAYS_FOR_NEW_BUFFER = 8 * 1024;
+constexpr float ALLOC_GROW_FACTOR = 0.2;
+constexpr uint32_t MAX_LEVEL = 31;
+constexpr size_t MAX_LEVEL_ARRAY_SIZE = MAX_LEVEL + 1;
+
+using Neighbor = HnswIndex::Neighbor;
+
+struct CloserFirst {
+    bool operator()(const Neighbor &lhs, const Neighbor &rhs) const {
+        return (lhs.distance > rhs.distance);
+    }
+};
+
+struct FurtherFirst {
+    bool operator()(const Neighbor &lhs, const Neighbor &rhs) const {
+        return (lhs.distance < rhs.distance);
+    }
+};
+
+bool
+closer(const Neighbor &lhs, const Neighbor &rhs)
+{
+    return (lhs.distance < rhs.distance);
+}
+
+uint32_t
+entryDocId(uint64_t entry)
+{
+    return static_cast<uint32_t>(entry);
+}
+
+uint32_t
+entryLevel(uint64_t entry)
+{
+    return static_cast<uint32_t>(entry >> 32);
+}
+
+}
+
+HnswIndex::HnswIndex(const DocVectorAccess &vectors, const attribute::HnswIndexParams &params,
+                     vespalib::GenerationHolder &genHolder)
+    : _vectors(vectors),
+      _params(params),
+      _nodeRefs(GrowStrategy(), genHolder),
+      _levelStore(LevelArrayStore::optimizedConfigForHugePage(MAX_LEVEL_ARRAY_SIZE,
+                                                              vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE,
+                                                              SMALL_MEMORY_PAGE_SIZE,
+                                                              MIN_NUM_ARRAYS_FOR_NEW_BUFFER,
+                                                              ALLOC_GROW_FACTOR)),
+      _linkStore(LinkArrayStore::optimizedConfigForHugePage(2 * std::max(params.max_links_per_node(), 1u),
+                                                            vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE,
+                                                            SMALL_MEMORY_PAGE_SIZE,
+                                                            MIN_NUM_ARRAYS_FOR_NEW_BUFFER,
+                                                            ALLOC_GROW_FACTOR)),
+      _entry(0u),
+      _levelGenerator(),
+      _levelMultiplier(1.0 / std::log(std::max(params.max_links_per_node(), 2u)))
+{
+}
+
+HnswIndex::~HnswIndex() = default;
+
+uint32_t
+HnswIndex::drawLevel()
+{
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    double r = 1.0 - distribution(_levelGenerator); // (0, 1]
+    double level = std::floor(-std::log(r) * _levelMultiplier);
+    return std::min(static_cast<uint32_t>(level), MAX_LEVEL);
+}
+
+double
+HnswIndex::calcDistance(vespalib::ConstArrayRef<double> lhs, uint32_t docId) const
+{
+    vespalib::ConstArrayRef<double> rhs = _vectors.getVector(docId);
+    if (rhs.size() != lhs.size()) {
+        return std::numeric_limits<double>::max();
+    }
+    double sum = 0.0;
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        double diff = lhs[i] - rhs[i];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+double
+HnswIndex::calcDistance(uint32_t lhsDocId, uint32_t rhsDocId) const
+{
+    return calcDistance(_vectors.getVector(lhsDocId), rhsDocId);
+}
+
+HnswIndex::LevelArrayRef
+HnswIndex::getLevels(uint32_t docId) const
+{
+    if (docId >= _nodeRefs.size()) {
+        return LevelArrayRef();
+    }
+    return _levelStore.get(_nodeRefs[docId]);
+}
+
+HnswIndex::LinkArrayRef
+HnswIndex::getLinks(uint32_t docId, uint32_t level) const
+{
+    LevelArrayRef levels = getLevels(docId);
+    if (level >= levels.size()) {
+        return LinkArrayRef();
+    }
+    return _linkStore.get(levels[level]);
+}
+
+void
+HnswIndex::setLinks(uint32_t docId, uint32_t level, const LinkArray &links)
+{
+    LevelArrayRef oldLevels = getLevels(docId);
+    assert(level < oldLevels.size());
+    std::vector<EntryRef> levels(oldLevels.cbegin(), oldLevels.cend());
+    EntryRef oldLinksRef = levels[level];
+    levels[level] = _linkStore.add(LinkArrayRef(links.data(), links.size()));
+    EntryRef oldLevelsRef = _nodeRefs[docId];
+    EntryRef newLevelsRef = _levelStore.add(LevelArrayRef(levels.data(), levels.size()));
+    std::atomic_thread_fence(std::memory_order_release);
+    _nodeRefs[docId] = newLevelsRef;
+    _levelStore.remove(oldLevelsRef);
+    _linkStore.remove(oldLinksRef);
+}
+
+HnswIndex::LinkArray
+HnswIndex::shrinkLinks(uint32_t docId, uint32_t level, LinkArray &links) const
+{
+    std::vector<Neighbor> candidates;
+    candidates.reserve(links.size());
+    vespalib::ConstArrayRef<double> vector = _vectors.getVector(docId);
+    for (uint32_t link : links) {
+        candidates.emplace_back(link, calcDistance(vector, link));
+    }
+    std::sort(candidates.begin(), candidates.end(), closer);
+    links.clear();
+    LinkArray dropped;
+    for (const auto &candidate : candidates) {
+        if (links.size() < maxLinksOnLevel(level)) {
+            links.push_back(candidate.docId);
+        } else {
+            dropped.push_back(candidate.docId);
+        }
+    }
+    return dropped;
+}
+
+void
+HnswIndex::addLink(uint32_t docId, uint32_t level, uint32_t newLink)
+{
+    LinkArrayRef oldLinks = getLinks(docId, level);
+    LinkArray links(oldLinks.cbegin(), oldLinks.cend());
+    links.push_back(newLink);
+    LinkArray dropped;
+    if (links.size() > maxLinksOnLevel(level)) {
+        dropped = shrinkLinks(docId, level, links);
+    }
+    setLinks(docId, level, links);
+    // Links are kept symmetric, which makes it possible to unlink a removed document
+    for (uint32_t link : dropped) {
+        removeLink(link, level, docId);
+    }
+}
+
+void
+HnswIndex::removeLink(uint32_t docId, uint32_t level, uint32_t oldLink)
+{
+    LinkArrayRef oldLinks = getLinks(docId, level);
+    if (std::find(oldLinks.cbegin(), oldLinks.cend(), oldLink) == oldLinks.cend()) {
+        return;
+    }
+    LinkArray links;
+    links.reserve(oldLinks.size());
+    for (uint32_t link : oldLinks) {
+        if (link != oldLink) {
+            links.push_back(link);
+        }
+    }
+    setLinks(docId, level, links);
+}
+
+bool
+HnswIndex::hasLink(uint32_t docId, uint32_t level, uint32_t link) const
+{
+    LinkArrayRef links = getLinks(docId, level);
+    return (std::find(links.cbegin(), links.cend(), link) != links.cend());
+}
+
+void
+HnswIndex::connect(uint32_t lhsDocId, uint32_t rhsDocId, uint32_t level)
+{
+    addLink(lhsDocId, level, rhsDocId);
+    if (hasLink(lhsDocId, level, rhsDocId)) {
+        addLink(rhsDocId, level, lhsDocId);
+    }
+}
+
+void
+HnswIndex::selectNeighbors(std::vector<Neighbor> &candidates, uint32_t maxLinks) const
+{
+    std::sort(candidates.begin(), candidates.end(), closer);
+    if (candidates.size() > maxLinks) {
+        candidates.erase(candidates.begin() + maxLinks, candidates.end());
+    }
+}
+
+HnswIndex::Neighbor
+HnswIndex::findNearestOnLevel(vespalib::ConstArrayRef<double> vector, Neighbor entry, uint32_t level) const
+{
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        for (uint32_t link : getLinks(entry.docId, level)) {
+            double distance = calcDistance(vector, link);
+            if (distance < entry.distance) {
+                entry = Neighbor(link, distance);
+                improved = true;
+            }
+        }
+    }
+    return entry;
+}
+
+std::vector<HnswIndex::Neighbor>
+HnswIndex::searchLevel(vespalib::ConstArrayRef<double> vector,
+                       const std::vector<Neighbor> &entryPoints,
+                       uint32_t exploreK, uint32_t level) const
+{
+    std::priority_queue<Neighbor, std::vector<Neighbor>, CloserFirst> candidates;
+    std::priority_queue<Neighbor, std::vector<Neighbor>, FurtherFirst> best;
+    vespalib::hash_set<uint32_t> visited(exploreK * 4);
+    for (const auto &entry : entryPoints) {
+        visited.insert(entry.docId);
+        candidates.push(entry);
+        best.push(entry);
+    }
+    while (best.size() > exploreK) {
+        best.pop();
+    }
+    while (!candidates.empty()) {
+        Neighbor candidate = candidates.top();
+        if (candidate.distance > best.top().distance) {
+            break;
+        }
+        candidates.pop();
+        for (uint32_t link : getLinks(candidate.docId, level)) {
+            if (visited.find(link) != visited.end()) {
+                continue;
+            }
+            visited.insert(link);
+            double distance = calcDistance(vector, link);
+            if (best.size() < exploreK || distance < best.top().distance) {
+                candidates.emplace(link, distance);
+                best.emplace(link, distance);
+                if (best.size() > exploreK) {
+                    best.pop();
+                }
+            }
+        }
+    }
+    std::vector<Neighbor> result;
+    result.reserve(best.size());
+    while (!best.empty()) {
+        result.push_back(best.top());
+        best.pop();
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+void
+HnswIndex::addDocument(uint32_t docId)
+{
+    vespalib::ConstArrayRef<double> vector = _vectors.getVector(docId);
+    assert(vector.size() != 0);
+    assert(!hasDocument(docId));
+    uint32_t level = drawLevel();
+    _nodeRefs.ensure_size(docId + 1, EntryRef());
+    std::vector<EntryRef> emptyLevels(level + 1, EntryRef());
+    uint64_t entry = _entry.load(std::memory_order_relaxed);
+    if (entryDocId(entry) == 0) {
+        _nodeRefs[docId] = _levelStore.add(LevelArrayRef(emptyLevels.data(), emptyLevels.size()));
+        _entry.store(makeEntry(docId, level), std::memory_order_release);
+        return;
+    }
+    // Find neighbors before the new node is visible to readers
+    uint32_t entryLevelNum = entryLevel(entry);
+    Neighbor nearest(entryDocId(entry), calcDistance(vector, entryDocId(entry)));
+    for (uint32_t searchLevelNum = entryLevelNum; searchLevelNum > level; --searchLevelNum) {
+        nearest = findNearestOnLevel(vector, nearest, searchLevelNum);
+    }
+    std::vector<std::vector<Neighbor>> neighborsOnLevel(std::min(level, entryLevelNum) + 1);
+    std::vector<Neighbor> entryPoints(1, nearest);
+    for (uint32_t i = neighborsOnLevel.size(); i-- > 0; ) {
+        std::vector<Neighbor> found = searchLevel(vector, entryPoints,
+                                                  std::max(_params.neighbors_to_explore_at_insert(), 1u), i);
+        entryPoints = found;
+        selectNeighbors(found, maxLinksOnLevel(i));
+        neighborsOnLevel[i] = std::move(found);
+    }
+    _nodeRefs[docId] = _levelStore.add(LevelArrayRef(emptyLevels.data(), emptyLevels.size()));
+    for (uint32_t i = 0; i < neighborsOnLevel.size(); ++i) {
+        LinkArray links;
+        links.reserve(neighborsOnLevel[i].size());
+        for (const auto &neighbor : neighborsOnLevel[i]) {
+            links.push_back(neighbor.docId);
+        }
+        setLinks(docId, i, links);
+        for (uint32_t link : links) {
+            addLink(link, i, docId);
+        }
+    }
+    if (level > entryLevelNum) {
+        _entry.store(makeEntry(docId, level), std::memory_order_release);
+    }
+}
+
+void
+HnswIndex::pickNewEntry(uint32_t removedDocId, LevelArrayRef removedLevels)
+{
+    // Prefer the former neighbor present on the highest level
+    for (uint32_t level = removedLevels.size(); level-- > 0; ) {
+        for (uint32_t link : _linkStore.get(removedLevels[level])) {
+            if (link != removedDocId) {
+                uint32_t linkLevels = getLevels(link).size();
+                _entry.store(makeEntry(link, linkLevels - 1), std::memory_order_release);
+                return;
+            }
+        }
+    }
+    uint64_t best = 0u;
+    for (uint32_t docId = 1; docId < _nodeRefs.size(); ++docId) {
+        uint32_t numLevels = getLevels(docId).size();
+        if (docId != removedDocId && numLevels != 0 &&
+            (entryDocId(best) == 0 || numLevels - 1 > entryLevel(best)))
+        {
+            best = makeEntry(docId, numLevels - 1);
+        }
+    }
+    _entry.store(best, std::memory_order_release);
+}
+
+void
+HnswIndex::removeDocument(uint32_t docId)
+{
+    LevelArrayRef levels = getLevels(docId);
+    if (levels.size() == 0) {
+        return;
+    }
+    std::vector<EntryRef> removedLevels(levels.cbegin(), levels.cend());
+    for (uint32_t level = 0; level < removedLevels.size(); ++level) {
+        LinkArrayRef linksRef = _linkStore.get(removedLevels[level]);
+        LinkArray links(linksRef.cbegin(), linksRef.cend());
+        for (uint32_t neighbor : links) {
+            removeLink(neighbor, level, docId);
+        }
+        // Reconnect former neighbors that now have room for another link
+        for (uint32_t neighbor : links) {
+            if (getLinks(neighbor, level).size() >= maxLinksOnLevel(level)) {
+                continue;
+            }
+            Neighbor best(0, std::numeric_limits<double>::max());
+            for (uint32_t other : links) {
+                if (other == neighbor || hasLink(neighbor, level, other)) {
+                    continue;
+                }
+                double distance = calcDistance(neighbor, other);
+                if (distance < best.distance) {
+                    best = Neighbor(other, distance);
+                }
+            }
+            if (best.docId != 0) {
+                connect(neighbor, best.docId, level);
+            }
+        }
+    }
+    EntryRef oldLevelsRef = _nodeRefs[docId];
+    _nodeRefs[docId] = EntryRef();
+    if (entryDocId(_entry.load(std::memory_order_relaxed)) == docId) {
+        pickNewEntry(docId, LevelArrayRef(removedLevels.data(), removedLevels.size()));
+    }
+    _levelStore.remove(oldLevelsRef);
+    for (EntryRef linksRef : removedLevels) {
+        _linkStore.remove(linksRef);
+    }
+}
+
+std::vector<HnswIndex::Neighbor>
+HnswIndex::findTopK(uint32_t k, vespalib::ConstArrayRef<double> vector, uint32_t exploreK) const
+{
+    std::vector<Neighbor> result;
+    uint64_t entry = _entry.load(std::memory_order_acquire);
+    if (entryDocId(entry) == 0 || k == 0) {
+        return result;
+    }
+    Neighbor nearest(entryDocId(entry), calcDistance(vector, entryDocId(entry)));
+    for (uint32_t level = entryLevel(entry); level > 0; --level) {
+        nearest = findNearestOnLevel(vector, nearest, level);
+    }
+    result = searchLevel(vector, std::vector<Neighbor>(1, nearest), std::max(k, exploreK), 0);
+    if (result.size() > k) {
+        result.erase(result.begin() + k, result.end());
+    }
+    for (auto &neighbor : result) {
+        neighbor.distance = std::sqrt(neighbor.distance);
+    }
+    return result;
+}
+
+void
+HnswIndex::transferHoldLists(generation_t generation)
+{
+    _levelStore.transferHoldLists(generation);
+    _linkStore.transferHoldLists(generation);
+}
+
+void
+HnswIndex::trimHoldLists(generation_t firstUsed)
+{
+    _levelStore.trimHoldLists(firstUsed);
+    _linkStore.trimHoldLists(firstUsed);
+}
+
+MemoryUsage
+HnswIndex::getMemoryUsage() const
+{
+    MemoryUsage result = _nodeRefs.getMemoryUsage();
+    result.merge(_levelStore.getMemoryUsage());
+    result.merge(_linkStore.getMemoryUsage());
+    return result;
+}
+
+}
@@ -0,0 +1,116 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "doc_vector_access.h"
+#include <vespa/searchcommon/attribute/hnsw_index_params.h>
+#include <vespa/searchlib/common/rcuvector.h>
+#include <vespa/searchlib/datastore/array_store.h>
+#include <vespa/searchlib/datastore/entryref.h>
+#include <vespa/searchlib/util/memoryusage.h>
+#include <atomic>
+#include <random>
+#include <vector>
+
+namespace search::tensor {
+
+/**
+ * Hierarchical navigable small world graph over the vectors of the
+ * documents in a dense tensor attribute, used for approximate nearest
+ * neighbor search.
+ *
+ * For each document there is an array with one link array per level
+ * the document is present on. Link arrays are never modified in place.
+ * An update stores new arrays and puts the old ones on hold, so reader
+ * threads holding a generation guard can traverse the graph without
+ * locking. Only a single writer thread is allowed.
+ *
+ * The graph is not persisted, it is rebuilt when the attribute is loaded.
+ */
+class HnswIndex
+{
+public:
+    using generation_t = vespalib::GenerationHandler::generation_t;
+
+    struct Neighbor {
+        uint32_t docId;
+        double distance;
+        Neighbor(uint32_t docId_in, double distance_in) : docId(docId_in), distance(distance_in) {}
+    };
+
+private:
+    using EntryRef = datastore::EntryRef;
+    using LevelArrayStore = datastore::ArrayStore<EntryRef>;
+    using LinkArrayStore = datastore::ArrayStore<uint32_t>;
+    using LinkArrayRef = vespalib::ConstArrayRef<uint32_t>;
+    using LevelArrayRef = vespalib::ConstArrayRef<EntryRef>;
+    using NodeRefVector = attribute::RcuVectorBase<EntryRef>;
+    using LinkArray = std::vector<uint32_t>;
+
+    const DocVectorAccess &_vectors;
+    attribute::HnswIndexParams _params;
+    NodeRefVector _nodeRefs;      // docId -> array of link arrays, one per level
+    LevelArrayStore _levelStore;
+    LinkArrayStore _linkStore;
+    // Doc id of entry point in the lower half, its level in the upper half.
+    // Doc id 0 is never used by documents and marks an empty graph.
+    std::atomic<uint64_t> _entry;
+    std::mt19937 _levelGenerator;
+    double _levelMultiplier;
+
+    static uint64_t makeEntry(uint32_t docId, uint32_t level) {
+        return (static_cast<uint64_t>(level) << 32) | docId;
+    }
+    uint32_t maxLinksOnLevel(uint32_t level) const {
+        return (level == 0) ? 2 * _params.max_links_per_node() : _params.max_links_per_node();
+    }
+    uint32_t drawLevel();
+    double calcDistance(vespalib::ConstArrayRef<double> lhs, uint32_t docId) const;
+    double calcDistance(uint32_t lhsDocId, uint32_t rhsDocId) const;
+    LevelArrayRef getLevels(uint32_t docId) const;
+    LinkArrayRef getLinks(uint32_t docId, uint32_t level) const;
+    void setLinks(uint32_t docId, uint32_t level, const LinkArray &links);
+    bool hasLink(uint32_t docId, uint32_t level, uint32_t link) const;
+    void addLink(uint32_t docId, uint32_t level, uint32_t newLink);
+    void removeLink(uint32_t docId, uint32_t level, uint32_t oldLink);
+    void connect(uint32_t lhsDocId, uint32_t rhsDocId, uint32_t level);
+    LinkArray shrinkLinks(uint32_t docId, uint32_t level, LinkArray &links) const;
+    void selectNeighbors(std::vector<Neighbor> &candidates, uint32_t maxLinks) const;
+    Neighbor findNearestOnLevel(vespalib::ConstArrayRef<double> vector, Neighbor entry, uint32_t level) const;
+    std::vector<Neighbor> searchLevel(vespalib::ConstArrayRef<double> vector,
+                                      const std::vector<Neighbor> &entryPoints,
+                                      uint32_t exploreK, uint32_t level) const;
+    void pickNewEntry(uint32_t removedDocId, LevelArrayRef removedLevels);
+
+public:
+    HnswIndex(const DocVectorAccess &vectors, const attribute::HnswIndexParams &params,
+              vespalib::GenerationHolder &genHolder);
+    ~HnswIndex();
+
+    /**
+     * Link the document into the graph, using its current vector.
+     * The document must not already be present.
+     **/
+    void addDocument(uint32_t docId);
+
+    /**
+     * Unlink the document from the graph. The former neighbors of the
+     * document are linked to each other where they have room for it.
+     **/
+    void removeDocument(uint32_t docId);
+
+    /**
+     * Returns the (approximately) k closest documents to the given
+     * vector, sorted on increasing euclidean distance. At least
+     * exploreK candidates are considered on the lowest level. Safe to
+     * call from reader threads while holding a generation guard.
+     **/
+    std::vector<Neighbor> findTopK(uint32_t k, vespalib::ConstArrayRef<double> vector, uint32_t exploreK) const;
+
+    bool hasDocument(uint32_t docId) const { return getLevels(docId).size() != 0; }
+    void transferHoldLists(generation_t generation);
+    void trimHoldLists(generation_t firstUsed);
+    MemoryUsage getMemoryUsage() const;
+};
+
+}
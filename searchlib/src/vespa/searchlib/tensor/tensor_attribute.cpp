@@ -45,7 +45,8 @@ TensorAttribute::TensorAttribute(const vespalib::stringref &baseFileName,
       _refVector(cfg.getGrowStrategy().getDocsInitialCapacity(),
                  cfg.getGrowStrategy().getDocsGrowPercent(),
                  cfg.getGrowStrategy().getDocsGrowDelta(),
-                 getGenerationHolder()),
+                 getGenerationHolder(),
+                 getInitialAlloc(cfg)),
       _tensorStore(tensorStore),
       _tensorMapper(),
       _compactGeneration(0)
@@ -61,6 +61,7 @@ public:
         return _store.getMemoryUsage();
     }
 
+    void setHugePages(bool hugePages) { _store.setHugePages(hugePages); }
 
     virtual void holdTensor(EntryRef ref) = 0;
 
@@ -48,6 +48,11 @@ public:
         _int_attr->commit();
     }
 
+    void add_to_doc(uint32_t docid, int64_t key, int32_t weight) {
+        _int_attr->append(docid, key, weight);
+        _int_attr->commit();
+    }
+
     const IDocumentWeightAttribute &dwa() const { return *_dwa; }
 };
 
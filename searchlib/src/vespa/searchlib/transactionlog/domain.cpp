@@ -25,13 +25,16 @@ namespace search::transactionlog {
 
 Domain::Domain(const string &domainName, const string & baseDir, Executor & commitExecutor,
                Executor & sessionExecutor, uint64_t domainPartSize, DomainPart::Crc defaultCrcType,
+               const DomainPart::CompressionConfig &compression,
                const FileHeaderContext &fileHeaderContext) :
     _defaultCrcType(defaultCrcType),
+    _compression(compression),
     _commitExecutor(commitExecutor),
     _sessionExecutor(sessionExecutor),
     _sessionId(1),
     _syncMonitor(),
     _pendingSync(false),
+    _syncStats(),
     _name(domainName),
     _domainPartSize(domainPartSize),
     _parts(),
@@ -59,12 +62,12 @@ Domain::Domain(const string &domainName, const string & baseDir, Executor & comm
     }
     _sessionExecutor.sync();
     if (_parts.empty() || _parts.crbegin()->second->isClosed()) {
-        _parts[lastPart].reset(new DomainPart(_name, dir(), lastPart, _defaultCrcType, _fileHeaderContext, false));
+        _parts[lastPart].reset(new DomainPart(_name, dir(), lastPart, _defaultCrcType, _compression, _fileHeaderContext, false));
     }
 }
 
 void Domain::addPart(int64_t partId, bool isLastPart) {
-    DomainPart::SP dp(new DomainPart(_name, dir(), partId, _defaultCrcType, _fileHeaderContext, isLastPart));
+    DomainPart::SP dp(new DomainPart(_name, dir(), partId, _defaultCrcType, _compression, _fileHeaderContext, isLastPart));
     if (dp->size() == 0) {
         // Only last domain part is allowed to be truncated down to
         // empty size.
@@ -84,15 +87,24 @@ void Domain::addPart(int64_t partId, bool isLastPart) {
 class Sync : public vespalib::Executor::Task
 {
 public:
-    Sync(Monitor &syncMonitor, const DomainPart::SP &dp, bool &pendingSync) :
+    Sync(Monitor &syncMonitor, const DomainPart::SP &dp, bool &pendingSync, SyncStats &stats) :
         _syncMonitor(syncMonitor),
         _dp(dp),
-        _pendingSync(pendingSync)
+        _pendingSync(pendingSync),
+        _stats(stats)
     { }
 private:
     void run() override {
+        SerialNum prevSynced(_dp->getSynced());
+        auto start = std::chrono::steady_clock::now();
         _dp->sync();
+        SyncStats::DurationSeconds syncTime(std::chrono::steady_clock::now() - start);
+        SerialNum synced(_dp->getSynced());
         MonitorGuard guard(_syncMonitor);
+        SerialNum firstSynced((prevSynced != 0) ? prevSynced + 1 : _dp->range().from());
+        if ((synced > prevSynced) && (synced >= firstSynced)) {
+            _stats.add(synced - firstSynced + 1, syncTime);
+        }
         _pendingSync = false;
         guard.broadcast();
     }
@@ -100,6 +112,7 @@ private:
     Monitor           & _syncMonitor;
     DomainPart::SP      _dp;
     bool              & _pendingSync;
+    SyncStats         & _stats;
 };
 
 Domain::~Domain() { }
@@ -109,6 +122,10 @@ Domain::getDomainInfo() const
 {
     LockGuard guard(_lock);
     DomainInfo info(SerialNumRange(begin(guard), end(guard)), size(guard), byteSize(guard), _maxSessionRunTime);
+    {
+        MonitorGuard syncGuard(_syncMonitor);
+        info.syncStats = _syncStats;
+    }
     for (const auto &entry: _parts) {
         const DomainPart &part = *entry.second;
         info.parts.emplace_back(PartInfo(part.range(), part.size(), part.byteSize(), part.fileName()));
@@ -197,7 +214,7 @@ Domain::triggerSyncNow()
     if (!_pendingSync) {
         _pendingSync = true;
         DomainPart::SP dp(_parts.rbegin()->second);
-        _commitExecutor.execute(Sync::UP(new Sync(_syncMonitor, dp, _pendingSync)));
+        _commitExecutor.execute(Sync::UP(new Sync(_syncMonitor, dp, _pendingSync, _syncStats)));
     }
 }
 
@@ -288,7 +305,7 @@ void Domain::commit(const Packet & packet)
         triggerSyncNow();
         waitPendingSync(_syncMonitor, _pendingSync);
         dp->close();
-        dp.reset(new DomainPart(_name, dir(), entry.serial(), _defaultCrcType, _fileHeaderContext, false));
+        dp.reset(new DomainPart(_name, dir(), entry.serial(), _defaultCrcType, _compression, _fileHeaderContext, false));
         {
             LockGuard guard(_lock);
             _parts[entry.serial()] = dp;
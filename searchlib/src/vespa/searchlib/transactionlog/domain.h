@@ -20,17 +20,38 @@ struct PartInfo {
           file(file_in) {}
 };
 
+/**
+ * Accumulated statistics for the syncs of a domain. Each sync makes all
+ * entries committed since the previous one durable with a single fsync.
+ */
+struct SyncStats {
+    using DurationSeconds = std::chrono::duration<double>;
+    size_t numSyncs;
+    size_t syncedEntries;
+    DurationSeconds syncTime;
+    DurationSeconds maxSyncTime;
+    SyncStats() : numSyncs(0), syncedEntries(0), syncTime(0), maxSyncTime(0) {}
+    void add(size_t entries, DurationSeconds time) {
+        ++numSyncs;
+        syncedEntries += entries;
+        syncTime += time;
+        maxSyncTime = std::max(maxSyncTime, time);
+    }
+};
+
 struct DomainInfo {
     using DurationSeconds = std::chrono::duration<double>;
     SerialNumRange range;
     size_t numEntries;
     size_t byteSize;
     DurationSeconds maxSessionRunTime;
+    SyncStats syncStats;
     std::vector<PartInfo> parts;
     DomainInfo(SerialNumRange range_in, size_t numEntries_in, size_t byteSize_in, DurationSeconds maxSessionRunTime_in)
-        : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts() {}
+        : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in),
+          syncStats(), parts() {}
     DomainInfo()
-        : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts() {}
+        : range(), numEntries(0), byteSize(0), maxSessionRunTime(), syncStats(), parts() {}
 };
 
 typedef std::map<vespalib::string, DomainInfo> DomainStats;
@@ -42,6 +63,7 @@ public:
     using Executor = vespalib::ThreadExecutor;
     Domain(const vespalib::string &name, const vespalib::string &baseDir, Executor & commitExecutor,
            Executor & sessionExecutor, uint64_t domainPartSize, DomainPart::Crc defaultCrcType,
+           const DomainPart::CompressionConfig &compression,
            const common::FileHeaderContext &fileHeaderContext);
 
     virtual ~Domain();
@@ -96,11 +118,13 @@ private:
     using DurationSeconds = std::chrono::duration<double>;
 
     DomainPart::Crc     _defaultCrcType;
+    const DomainPart::CompressionConfig _compression;
     Executor          & _commitExecutor;
     Executor          & _sessionExecutor;
     std::atomic<int>    _sessionId;
-    vespalib::Monitor   _syncMonitor;
+    mutable vespalib::Monitor _syncMonitor;
     bool                _pendingSync;
+    SyncStats           _syncStats;    // Protected by _syncMonitor
     vespalib::string    _name;
     uint64_t            _domainPartSize;
     DomainPartList      _parts;
@@ -4,6 +4,8 @@
 #include <vespa/vespalib/util/crc.h>
 #include <vespa/vespalib/xxhash/xxhash.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/fastlib/io/bufferedfile.h>
@@ -20,6 +22,7 @@ using vespalib::LockGuard;
 using vespalib::nbostream;
 using vespalib::nbostream_longlivedbuf;
 using vespalib::alloc::Alloc;
+using vespalib::compression::CompressionConfig;
 using search::common::FileHeaderContext;
 using std::runtime_error;
 
@@ -34,8 +37,8 @@ string
 handleWriteError(const char *text,
                  FastOS_FileInterface &file,
                  int64_t lastKnownGoodPos,
-                 const Packet::Entry &entry,
-                 int bufLen) __attribute__ ((noinline));
+                 SerialNum lastSerial,
+                 size_t bufLen) __attribute__ ((noinline));
 
 bool
 handleReadError(const char *text,
@@ -75,13 +78,13 @@ string
 handleWriteError(const char *text,
                  FastOS_FileInterface &file,
                  int64_t lastKnownGoodPos,
-                 const Packet::Entry &entry,
-                 int bufLen)
+                 SerialNum lastSerial,
+                 size_t bufLen)
 {
     string last(FastOS_File::getLastErrorString());
-    string e(make_string("%s. File '%s' at position %" PRId64 " for entry %" PRIu64 " of length %u. "
+    string e(make_string("%s. File '%s' at position %" PRId64 " for entries up to %" PRIu64 " of length %zu. "
                          "OS says '%s'. Rewind to last known good position %" PRId64 ".",
-                         text, file.GetFileName(), file.GetPosition(), entry.serial(), bufLen,
+                         text, file.GetFileName(), file.GetPosition(), lastSerial, bufLen,
                          last.c_str(), lastKnownGoodPos));
     LOG(error, "%s",  e.c_str());
     if ( ! file.SetPosition(lastKnownGoodPos) ) {
@@ -266,8 +269,10 @@ DomainPart::buildPacketMapping(bool allowTruncate)
 }
 
 DomainPart::DomainPart(const string & name, const string & baseDir, SerialNum s, Crc defaultCrc,
+                       const CompressionConfig &compression,
                        const FileHeaderContext &fileHeaderContext, bool allowTruncate) :
     _defaultCrc(defaultCrc),
+    _compression(compression),
     _lock(),
     _fileLock(),
     _range(s),
@@ -407,21 +412,27 @@ DomainPart::commit(SerialNum firstSerial, const Packet &packet)
     if (_range.from() == 0) {
         _range.from(firstSerial);
     }
-    for (size_t i(0); h.size() > 0; i++) {
-        //LOG(spam,
-        //"Pos(%d) Len(%d), Lim(%d), Remaining(%d)",
-        //h.getPos(), h.getLength(), h.getLimit(), h.getRemaining());
+    // All entries in the packet are serialized into one buffer and written with a single write.
+    nbostream os;
+    SerialNum lastSerial(_range.to());
+    size_t numEntries(0);
+    while (h.size() > 0) {
         Packet::Entry entry;
         entry.deserialize(h);
-        if (_range.to() < entry.serial()) {
-            write(*_transLog, entry);
-            _sz++;
-            _range.to(entry.serial());
+        if (lastSerial < entry.serial()) {
+            serializeEntry(os, entry);
+            lastSerial = entry.serial();
+            numEntries++;
         } else {
             throw runtime_error(make_string("Incomming serial number(%ld) must be bigger than the last one (%ld).",
-                                            entry.serial(), _range.to()));
+                                            entry.serial(), lastSerial));
         }
     }
+    if (numEntries > 0) {
+        write(*_transLog, lastSerial, os);
+        _sz += numEntries;
+        _range.to(lastSerial);
+    }
 
     bool merged(false);
     LockGuard guard(_lock);
@@ -574,28 +585,50 @@ DomainPart::visit(FastOS_FileInterface &file, SerialNumRange &r, Packet &packet)
 }
 
 void
-DomainPart::write(FastOS_FileInterface &file, const Packet::Entry &entry)
+DomainPart::serializeEntry(nbostream &os, const Packet::Entry &entry) const
 {
-    int64_t lastKnownGoodPos(file.GetPosition());
+    vespalib::DataBuffer compressed;
+    CompressionConfig::Type compressionType(CompressionConfig::NONE);
+    if (_compression.type != CompressionConfig::NONE) {
+        compressionType = vespalib::compression::compress(_compression, entry.data(), compressed, false);
+    }
+    const bool isCompressed(compressionType != CompressionConfig::NONE);
+    Packet::Entry compressedEntry;
+    if (isCompressed) {
+        compressedEntry = Packet::Entry(entry.serial(), entry.type(),
+                                        vespalib::ConstBufferRef(compressed.getData(), compressed.getDataLen()));
+    }
+    const Packet::Entry &toWrite(isCompressed ? compressedEntry : entry);
     int32_t crc(0);
-    uint32_t len(entry.serializedSize() + sizeof(crc));
-    nbostream os;
-    os << static_cast<uint8_t>(_defaultCrc);
+    uint32_t len(toWrite.serializedSize() + sizeof(crc));
+    if (isCompressed) {
+        len += sizeof(uint8_t) + sizeof(uint32_t);
+    }
+    size_t entryStart(os.size());
+    os << static_cast<uint8_t>(isCompressed ? (_defaultCrc | COMPRESSED_ENTRY) : _defaultCrc);
     os << len;
     size_t start(os.size());
-    entry.serialize(os);
+    if (isCompressed) {
+        os << static_cast<uint8_t>(compressionType) << static_cast<uint32_t>(entry.data().size());
+    }
+    toWrite.serialize(os);
     size_t end(os.size());
     crc = calcCrc(_defaultCrc, os.c_str()+start, end - start);
     os << crc;
-    size_t osSize = os.size();
-    assert(osSize == len + sizeof(len) + sizeof(uint8_t));
+    assert(os.size() - entryStart == len + sizeof(len) + sizeof(uint8_t));
+    (void) entryStart;
+}
 
+void
+DomainPart::write(FastOS_FileInterface &file, SerialNum lastSerial, const nbostream &os)
+{
+    int64_t lastKnownGoodPos(file.GetPosition());
     LockGuard guard(_writeLock);
-    if ( ! file.CheckedWrite(os.c_str(), osSize) ) {
-        throw runtime_error(handleWriteError("Failed writing the entry.", file, lastKnownGoodPos, entry, end - start));
+    if ( ! file.CheckedWrite(os.c_str(), os.size()) ) {
+        throw runtime_error(handleWriteError("Failed writing the entries.", file, lastKnownGoodPos, lastSerial, os.size()));
     }
-    _writtenSerial = entry.serial();
-    _byteSize.store(lastKnownGoodPos + osSize, std::memory_order_release);
+    _writtenSerial = lastSerial;
+    _byteSize.store(lastKnownGoodPos + os.size(), std::memory_order_release);
 }
 
 bool
@@ -612,7 +645,9 @@ DomainPart::read(FastOS_FileInterface &file,
     uint8_t version(-1);
     uint32_t len(0);
     his >> version >> len;
+    const bool isCompressed((version & COMPRESSED_ENTRY) != 0);
     if ((retval = (rlen == sizeof(tmp)))) {
+        version &= ~COMPRESSED_ENTRY;
         if ( ! (retval = (version == ccitt_crc32) || version == xxh64)) {
             string msg(make_string("Version mismatch. Expected 'ccitt_crc32=1' or 'xxh64=2',"
                                              " got %d from '%s' at position %ld",
@@ -633,6 +668,11 @@ DomainPart::read(FastOS_FileInterface &file,
             retval = handleReadError("packet blob", file, len, rlen, lastKnownGoodPos, allowTruncate);
         } else {
             nbostream_longlivedbuf is(buf.get(), len);
+            uint8_t compressionType(CompressionConfig::NONE);
+            uint32_t uncompressedLen(0);
+            if (isCompressed) {
+                is >> compressionType >> uncompressedLen;
+            }
             entry.deserialize(is);
             int32_t crc(0);
             is >> crc;
@@ -642,6 +682,9 @@ DomainPart::read(FastOS_FileInterface &file,
                                                 file.GetFileName(), file.GetPosition() - len - sizeof(len),
                                                 static_cast<int>(len), static_cast<int>(crcVerify), static_cast<int>(crc)));
             }
+            if (isCompressed) {
+                decompress(entry, compressionType, uncompressedLen, buf);
+            }
         }
     } else {
         if (rlen == 0) {
@@ -653,6 +696,23 @@ DomainPart::read(FastOS_FileInterface &file,
     return retval;
 }
 
+void
+DomainPart::decompress(Packet::Entry &entry, uint8_t compressionType, uint32_t uncompressedLen, Alloc &buf)
+{
+    vespalib::DataBuffer uncompressed(uncompressedLen);
+    vespalib::compression::decompress(CompressionConfig::toType(compressionType), uncompressedLen,
+                                      entry.data(), uncompressed, false);
+    if (uncompressed.getDataLen() != uncompressedLen) {
+        throw runtime_error(make_string("Decompressed entry %" PRIu64 " has size %zu, but %u was expected",
+                                        entry.serial(), uncompressed.getDataLen(), uncompressedLen));
+    }
+    // The entry refers to the read buffer, which is kept until the next read.
+    Alloc data(Alloc::alloc(std::max(uncompressedLen, 1u)));
+    memcpy(data.get(), uncompressed.getData(), uncompressedLen);
+    entry = Packet::Entry(entry.serial(), entry.type(), vespalib::ConstBufferRef(data.get(), uncompressedLen));
+    buf.swap(data);
+}
+
 int32_t DomainPart::calcCrc(Crc version, const void * buf, size_t sz)
 {
     if (version == xxh64) {
@@ -4,6 +4,7 @@
 #include "common.h"
 #include <vespa/vespalib/util/sync.h>
 #include <vespa/vespalib/util/memory.h>
+#include <vespa/vespalib/util/compressionconfig.h>
 #include <map>
 #include <vector>
 #include <atomic>
@@ -23,8 +24,15 @@ public:
         ccitt_crc32=1,
         xxh64=2
     };
+    /**
+     * Set in the version byte of entries where the data is compressed.
+     * The compression type and uncompressed size then precede the entry.
+     */
+    static constexpr uint8_t COMPRESSED_ENTRY = 0x80;
+    using CompressionConfig = vespalib::compression::CompressionConfig;
     typedef std::shared_ptr<DomainPart> SP;
     DomainPart(const vespalib::string &name, const vespalib::string &baseDir, SerialNum s, Crc defaultCrc,
+               const CompressionConfig &compression,
                const common::FileHeaderContext &FileHeaderContext, bool allowTruncate);
 
     ~DomainPart();
@@ -53,8 +61,11 @@ private:
     int64_t buildPacketMapping(bool allowTruncate);
 
     static bool read(FastOS_FileInterface &file, Packet::Entry &entry, vespalib::alloc::Alloc &buf, bool allowTruncate);
+    static void decompress(Packet::Entry &entry, uint8_t compressionType, uint32_t uncompressedLen,
+                           vespalib::alloc::Alloc &buf);
 
-    void write(FastOS_FileInterface &file, const Packet::Entry &entry);
+    void serializeEntry(vespalib::nbostream &os, const Packet::Entry &entry) const;
+    void write(FastOS_FileInterface &file, SerialNum lastSerial, const vespalib::nbostream &os);
     static int32_t calcCrc(Crc crc, const void * buf, size_t len);
     void writeHeader(const common::FileHeaderContext &fileHeaderContext);
 
@@ -78,6 +89,7 @@ private:
     typedef std::vector<SkipInfo> SkipList;
     typedef std::map<SerialNum, Packet> PacketList;
     const Crc      _defaultCrc;
+    const CompressionConfig _compression;
     vespalib::Lock _lock;
     vespalib::Lock _fileLock;
     SerialNumRange _range;
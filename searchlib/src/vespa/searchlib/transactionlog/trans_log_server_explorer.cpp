@@ -22,6 +22,13 @@ struct DomainExplorer : vespalib::StateExplorer {
         state.setLong("to", info.range.to());
         state.setLong("numEntries", info.numEntries);
         state.setLong("byteSize", info.byteSize);
+        {
+            Cursor &sync = state.setObject("sync");
+            sync.setLong("count", info.syncStats.numSyncs);
+            sync.setLong("entries", info.syncStats.syncedEntries);
+            sync.setDouble("time", info.syncStats.syncTime.count());
+            sync.setDouble("maxTime", info.syncStats.maxSyncTime.count());
+        }
         if (full) {
             Cursor &array = state.setArray("parts");
             for (const PartInfo &part_in: info.parts) {
@@ -36,6 +36,19 @@ getCrc(searchlib::TranslogserverConfig::Crcmethod crcType)
     LOG_ABORT("should not be reached");
 }
 
+DomainPart::CompressionConfig
+getCompression(const searchlib::TranslogserverConfig::Compression &cfg)
+{
+    DomainPart::CompressionConfig compression;
+    if (cfg.type == searchlib::TranslogserverConfig::Compression::LZ4) {
+        compression.type = DomainPart::CompressionConfig::LZ4;
+    } else if (cfg.type == searchlib::TranslogserverConfig::Compression::ZSTD) {
+        compression.type = DomainPart::CompressionConfig::ZSTD;
+    }
+    compression.compressionLevel = cfg.level;
+    return compression;
+}
+
 }
 
 void
@@ -43,7 +56,8 @@ TransLogServerApp::start()
 {
     std::shared_ptr<searchlib::TranslogserverConfig> c = _tlsConfig.get();
     auto tls = std::make_shared<TransLogServer>(c->servername, c->listenport, c->basedir, _fileHeaderContext,
-                                            c->filesizemax, c->maxthreads, getCrc(c->crcmethod));
+                                            c->filesizemax, c->maxthreads, getCrc(c->crcmethod),
+                                            getCompression(c->compression));
     std::lock_guard<std::mutex> guard(_lock);
     _tls = std::move(tls);
 }
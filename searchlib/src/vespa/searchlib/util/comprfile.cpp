@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "comprfile.h"
+#include <vespa/searchlib/common/background_write_limiter.h>
 #include <vespa/fastos/file.h>
 #include <cassert>
 #include <cstring>
@@ -260,6 +261,7 @@ WriteComprBuffer(ComprFileEncodeContext &encodeContext,
                  (flushSlack &&
                   static_cast<unsigned int>(chunksize) <= cbuf._comprBufSize +
                   ComprBuffer::minimumPadding()));
+    BackgroundWriteLimiter::instance().acquire(cbuf._unitSize * chunksize);
     file.WriteBuf(cbuf._comprBuf, cbuf._unitSize * chunksize);
 
     int remainingUnits = chunkUsedUnits - chunksize;
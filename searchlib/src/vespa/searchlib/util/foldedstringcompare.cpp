@@ -77,5 +77,22 @@ compare(const char *key, const char *okey) const
     return strcmp(key, okey);
 }
 
+
+uint32_t
+FoldedStringCompare::
+hashFolded(const char *key) const
+{
+    vespalib::Utf8ReaderForZTS kreader(key);
+    uint64_t hash = 0xcbf29ce484222325ul;
+    for (;;) {
+        uint32_t kval = LowerCase::convert(kreader.getChar());
+        if (kval == 0) {
+            break;
+        }
+        hash = (hash ^ kval) * 0x100000001b3ul;
+    }
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
 } // namespace search
 
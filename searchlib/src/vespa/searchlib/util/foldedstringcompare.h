@@ -3,6 +3,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 
 namespace search {
 
@@ -51,6 +52,15 @@ public:
      * @return integer   -1 if key < okey, 0 if key == okey, 1 if key > okey
      */
     int compare(const char *key, const char *okey) const;
+
+    /**
+     * Hash utf8 key after folding, such that keys that are equal
+     * according to compareFolded() get the same hash.
+     *
+     * @param key       NUL terminated utf8 string
+     * @return integer  32-bit hash of the folded key
+     */
+    uint32_t hashFolded(const char *key) const;
 };
 
 } // namespace search
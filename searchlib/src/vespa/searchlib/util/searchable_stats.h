@@ -2,6 +2,7 @@
 #pragma once
 
 #include "memoryusage.h"
+#include <vespa/searchlib/docstore/cachestats.h>
 
 namespace search {
 
@@ -16,9 +17,10 @@ private:
     MemoryUsage _memoryUsage;
     size_t _docsInMemory;
     size_t _sizeOnDisk;
+    CacheStats _postingListCache;
 
 public:
-    SearchableStats() : _memoryUsage(), _docsInMemory(0), _sizeOnDisk(0) {}
+    SearchableStats() : _memoryUsage(), _docsInMemory(0), _sizeOnDisk(0), _postingListCache() {}
     SearchableStats &memoryUsage(const MemoryUsage &usage) {
         _memoryUsage = usage;
         return *this;
@@ -34,10 +36,16 @@ public:
         return *this;
     }
     size_t sizeOnDisk() const { return _sizeOnDisk; }
+    SearchableStats &postingListCache(const CacheStats &value) {
+        _postingListCache = value;
+        return *this;
+    }
+    const CacheStats &postingListCache() const { return _postingListCache; }
     SearchableStats &add(const SearchableStats &rhs) {
         _memoryUsage.merge(rhs._memoryUsage);
         _docsInMemory += rhs._docsInMemory;
         _sizeOnDisk += rhs._sizeOnDisk;
+        _postingListCache += rhs._postingListCache;
         return *this;
     }
 };
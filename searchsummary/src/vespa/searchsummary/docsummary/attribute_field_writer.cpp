@@ -16,6 +16,7 @@ namespace search::docsummary {
 AttributeFieldWriter::AttributeFieldWriter(vespalib::Memory fieldName,
                                            const IAttributeVector &attr)
     : _fieldName(fieldName),
+      _fieldSymbol(),
       _attr(attr),
       _size(0)
 {
@@ -23,6 +24,15 @@ AttributeFieldWriter::AttributeFieldWriter(vespalib::Memory fieldName,
 
 AttributeFieldWriter::~AttributeFieldWriter() = default;
 
+vespalib::slime::Symbol
+AttributeFieldWriter::fieldSymbol(Cursor &cursor)
+{
+    if (_fieldSymbol.undefined()) {
+        _fieldSymbol = cursor.resolve(_fieldName);
+    }
+    return _fieldSymbol;
+}
+
 namespace {
 
 template <class Content>
@@ -83,6 +93,7 @@ WriteField<Content>::fetch(uint32_t docId)
 {
     _content.fill(_attr, docId);
     _size = _content.size();
+    _fieldSymbol = vespalib::slime::Symbol(); // The next docsum may use another symbol table
 }
 
 WriteStringField::WriteStringField(vespalib::Memory fieldName,
@@ -99,7 +110,7 @@ WriteStringField::print(uint32_t idx, Cursor &cursor)
     if (idx < _size) {
         const char *s = _content[idx];
         if (s[0] != '\0') {
-            cursor.setString(_fieldName, vespalib::Memory(s));
+            cursor.setString(fieldSymbol(cursor), vespalib::Memory(s));
         }
     }
 }
@@ -118,7 +129,7 @@ WriteFloatField::print(uint32_t idx, Cursor &cursor)
     if (idx < _size) {
         double val = _content[idx];
         if (!search::attribute::isUndefined(val)) {
-            cursor.setDouble(_fieldName, val);
+            cursor.setDouble(fieldSymbol(cursor), val);
         }
     }
 }
@@ -139,7 +150,7 @@ WriteIntField::print(uint32_t idx, Cursor &cursor)
     if (idx < _size) {
         auto val = _content[idx];
         if (val != _undefined) {
-            cursor.setLong(_fieldName, _content[idx]);
+            cursor.setLong(fieldSymbol(cursor), _content[idx]);
         }
     }
 }
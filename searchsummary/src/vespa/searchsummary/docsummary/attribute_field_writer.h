@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/vespalib/data/memory.h>
+#include <vespa/vespalib/data/slime/symbol.h>
 
 namespace search::attribute { class IAttributeVector; }
 namespace vespalib::slime { class Cursor; }
@@ -13,16 +14,20 @@ namespace search::docsummary {
  * This class reads values from a struct field attribute and inserts
  * them into proper position in an array of struct or map of struct.
  * If the value to be inserted is considered to be undefined then
- * the value is not inserted.
+ * the value is not inserted. The field name is resolved to a symbol
+ * when the first value of a docsum is inserted, and reused for the
+ * remaining elements.
  */
 class AttributeFieldWriter
 {
 protected:
     const vespalib::Memory                     _fieldName;
+    vespalib::slime::Symbol                    _fieldSymbol;
     const search::attribute::IAttributeVector &_attr;
     size_t                                     _size;
     AttributeFieldWriter(vespalib::Memory fieldName,
                          const search::attribute::IAttributeVector &attr);
+    vespalib::slime::Symbol fieldSymbol(vespalib::slime::Cursor &cursor);
 public:
     virtual ~AttributeFieldWriter();
     virtual void fetch(uint32_t docId) = 0;
@@ -157,12 +157,20 @@ MultiAttrDFW::insertField(uint32_t docid,
                           vespalib::slime::Inserter &target)
 {
     using vespalib::slime::Cursor;
+    using vespalib::slime::Symbol;
     using vespalib::Memory;
     const IAttributeVector & v = vec(*state);
     uint32_t entries = v.getValueCount(docid);
     bool isWeightedSet = v.hasWeightedSetType();
 
     Cursor &arr = target.insertArray();
+    // Resolved once, instead of once per element of a weighted set.
+    Symbol itemSymbol;
+    Symbol weightSymbol;
+    if (isWeightedSet && (entries > 0)) {
+        itemSymbol = arr.resolve("item");
+        weightSymbol = arr.resolve("weight");
+    }
     BasicType::Type t = v.getBasicType();
     switch (t) {
     case BasicType::NONE:
@@ -174,8 +182,8 @@ MultiAttrDFW::insertField(uint32_t docid,
             Memory value(sv.c_str(), sv.size());
             if (isWeightedSet) {
                 Cursor &elem = arr.addObject();
-                elem.setString("item", value);
-                elem.setLong("weight", elements[i].getWeight());
+                elem.setString(itemSymbol, value);
+                elem.setLong(weightSymbol, elements[i].getWeight());
             } else {
                 arr.addString(value);
             }
@@ -193,8 +201,8 @@ MultiAttrDFW::insertField(uint32_t docid,
         for (uint32_t i = 0; i < entries; ++i) {
             if (isWeightedSet) {
                 Cursor &elem = arr.addObject();
-                elem.setLong("item", elements[i].getValue());
-                elem.setLong("weight", elements[i].getWeight());
+                elem.setLong(itemSymbol, elements[i].getValue());
+                elem.setLong(weightSymbol, elements[i].getWeight());
             } else {
                 arr.addLong(elements[i].getValue());
             }
@@ -207,8 +215,8 @@ MultiAttrDFW::insertField(uint32_t docid,
         for (uint32_t i = 0; i < entries; ++i) {
             if (isWeightedSet) {
                 Cursor &elem = arr.addObject();
-                elem.setDouble("item", elements[i].getValue());
-                elem.setLong("weight", elements[i].getWeight());
+                elem.setDouble(itemSymbol, elements[i].getValue());
+                elem.setLong(weightSymbol, elements[i].getWeight());
             } else {
                 arr.addDouble(elements[i].getValue());
             }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "docsumstorevalue.h"
+#include <vector>
 
 namespace search::docsummary {
 
@@ -38,6 +39,14 @@ public:
      **/
     virtual DocsumStoreValue getMappedDocsum(uint32_t docid) = 0;
 
+    /**
+     * Hint that the docsums for the given local document ids are
+     * about to be fetched, so they can be read in one batch.
+     *
+     * @param docids local document ids
+     **/
+    virtual void prefetch(const std::vector<uint32_t> & docids) { (void) docids; }
+
     /**
      * Will return default input class used.
      **/
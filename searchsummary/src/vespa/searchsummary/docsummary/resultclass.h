@@ -4,7 +4,7 @@
 
 #include <vespa/searchlib/util/rawbuf.h>
 #include <vespa/vespalib/stllike/string.h>
-#include <vespa/vespalib/stllike/hash_map.h>
+#include <vespa/vespalib/stllike/swiss_hash_map.h>
 #include <vespa/searchlib/util/stringenum.h>
 
 namespace search::docsummary {
@@ -130,7 +130,7 @@ public:
 private:
     ResultClass(const ResultClass &);
     ResultClass& operator=(const ResultClass &);
-    typedef vespalib::hash_map<vespalib::string, int> NameIdMap;
+    typedef vespalib::swiss_hash_map<vespalib::string, int> NameIdMap;
     typedef std::vector<ResConfigEntry> Configs;
 
     vespalib::string           _name;        // name of this class
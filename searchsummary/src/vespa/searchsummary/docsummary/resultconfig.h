@@ -7,6 +7,7 @@
 #include <vespa/config-summary.h>
 #include <vespa/searchlib/util/rawbuf.h>
 #include <vespa/searchlib/util/stringenum.h>
+#include <vespa/vespalib/stllike/hash_map.h>
 
 namespace search::docsummary {
 
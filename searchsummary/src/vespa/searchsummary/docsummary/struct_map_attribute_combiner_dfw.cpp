@@ -76,12 +76,16 @@ StructMapAttributeFieldWriterState::insertField(uint32_t docId, vespalib::slime:
         return;
     }
     Cursor &arr = target.insertArray();
+    vespalib::slime::Symbol valueSymbol;
     for (uint32_t idx = 0; idx < elems; ++idx) {
         Cursor &keyValueObj = arr.addObject();
         if (_keyWriter) {
             _keyWriter->print(idx, keyValueObj);
         }
-        Cursor &obj = keyValueObj.setObject(valueName);
+        if (valueSymbol.undefined()) {
+            valueSymbol = keyValueObj.resolve(valueName);
+        }
+        Cursor &obj = keyValueObj.setObject(valueSymbol);
         for (auto &valueWriter : _valueWriters) {
             valueWriter->print(idx, obj);
         }
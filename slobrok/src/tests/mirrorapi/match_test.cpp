@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/slobrok/sbmirror.h>
+#include <algorithm>
 
 class MatchTester : public slobrok::api::IMirrorAPI
 {
@@ -78,4 +79,53 @@ TEST("require that double star eats rest of name") {
     name.mustNotMatch("foo/**/suffix");
 }
 
+class SortedLookupTester : public slobrok::api::IMirrorAPI
+{
+    SpecList lookup(const std::string &) const override {
+        return SpecList();
+    }
+    uint32_t updates() const override { return 0; }
+    bool ready() const override { return true; }
+
+    SpecList specs;
+
+public:
+    SortedLookupTester(const std::vector<std::string> &names) : specs() {
+        for (const std::string &name : names) {
+            specs.emplace_back(name, "tcp/" + name);
+        }
+        std::sort(specs.begin(), specs.end());
+    }
+
+    void mustFindAllMatching(const std::string &pattern) {
+        TEST_STATE(pattern.c_str());
+        SpecList expected;
+        for (const Spec &spec : specs) {
+            if (match(spec.first.c_str(), pattern.c_str())) {
+                expected.push_back(spec);
+            }
+        }
+        EXPECT_TRUE(expected == lookupSorted(specs, pattern));
+    }
+};
+
+TEST("require that sorted lookup finds the same services as matching every name") {
+    SortedLookupTester tester({"foo/bar/0/default", "foo/bar/1/default", "foo/baz/0/default",
+                               "foo", "foo/bar", "fo/bar/0/default", "foz/bar/0/default",
+                               "search/cluster.music/0/realtimecontroller", "A"});
+    tester.mustFindAllMatching("foo/bar/0/default");
+    tester.mustFindAllMatching("foo/bar/2/default");
+    tester.mustFindAllMatching("foo");
+    tester.mustFindAllMatching("foo/*/0/default");
+    tester.mustFindAllMatching("foo/bar/*/default");
+    tester.mustFindAllMatching("foo/b*/*/default");
+    tester.mustFindAllMatching("fo*/bar/0/default");
+    tester.mustFindAllMatching("*/bar/0/default");
+    tester.mustFindAllMatching("search/*/*/realtimecontroller");
+    tester.mustFindAllMatching("**");
+    tester.mustFindAllMatching("foo/**");
+    tester.mustFindAllMatching("A**");
+    tester.mustFindAllMatching("");
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -60,6 +60,13 @@ public:
     virtual uint32_t updates() const = 0;
 
     virtual bool ready() const = 0;
+
+protected:
+    /**
+     * Obtain all the services in a list sorted on service name that match a given pattern. Only the range of
+     * names sharing the literal prefix of the pattern (everything before its first '*') is visited.
+     **/
+    static SpecList lookupSorted(const SpecList &sortedSpecs, const std::string & pattern);
 };
 
 } // namespace api
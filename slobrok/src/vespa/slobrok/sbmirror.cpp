@@ -3,6 +3,8 @@
 #include "sbmirror.h"
 #include <vespa/fnet/frt/supervisor.h>
 #include <vespa/fnet/frt/target.h>
+#include <algorithm>
+#include <unordered_set>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".slobrok.mirror");
@@ -55,10 +57,25 @@ MirrorAPI::~MirrorAPI()
 MirrorAPI::SpecList
 MirrorAPI::lookup(const std::string & pattern) const
 {
-    SpecList ret;
     LockGuard guard(_lock);
-    SpecList::const_iterator end = _specs.end();
-    for (SpecList::const_iterator it = _specs.begin(); it != end; ++it) {
+    return lookupSorted(_specs, pattern);
+}
+
+
+IMirrorAPI::SpecList
+IMirrorAPI::lookupSorted(const SpecList &sortedSpecs, const std::string & pattern)
+{
+    SpecList ret;
+    std::string prefix = pattern.substr(0, pattern.find('*'));
+    auto it = std::lower_bound(sortedSpecs.begin(), sortedSpecs.end(), prefix,
+                               [](const Spec &spec, const std::string &name) { return (spec.first < name); });
+    if (prefix.size() == pattern.size()) {
+        if ((it != sortedSpecs.end()) && (it->first == pattern)) {
+            ret.push_back(*it);
+        }
+        return ret;
+    }
+    for (; (it != sortedSpecs.end()) && (it->first.compare(0, prefix.size(), prefix) == 0); ++it) {
         if (match(it->first.c_str(), pattern.c_str())) {
             ret.push_back(*it);
         }
@@ -104,6 +121,8 @@ IMirrorAPI::match(const char *name, const char *pattern)
 void
 MirrorAPI::updateTo(SpecList& newSpecs, uint32_t newGen)
 {
+    std::sort(newSpecs.begin(), newSpecs.end(),
+              [](const Spec &lhs, const Spec &rhs) { return (lhs.first < rhs.first); });
     {
         LockGuard guard(_lock);
         std::swap(newSpecs, _specs);
@@ -212,20 +231,19 @@ MirrorAPI::handleIncrementalFetch()
         updateTo(specs, diff_to);
     } else if (_specsGen == diff_from) {
         // incremental update
+        std::unordered_set<std::string> changed;
+        for (uint32_t idx = 0; idx < numRemove; idx++) {
+            changed.insert(r[idx]._str);
+        }
+        for (uint32_t idx = 0; idx < numNames; idx++) {
+            changed.insert(n[idx]._str);
+        }
         SpecList specs;
-        SpecList::const_iterator end = _specs.end();
-        for (SpecList::const_iterator it = _specs.begin();
-             it != end;
-             ++it)
-        {
-            bool keep = true;
-            for (uint32_t idx = 0; idx < numRemove; idx++) {
-                if (it->first == r[idx]._str) keep = false;
-            }
-            for (uint32_t idx = 0; idx < numNames; idx++) {
-                if (it->first == n[idx]._str) keep = false;
+        specs.reserve(_specs.size() + numNames);
+        for (const Spec &spec : _specs) {
+            if (changed.find(spec.first) == changed.end()) {
+                specs.push_back(spec);
             }
-            if (keep) specs.push_back(*it);
         }
         for (uint32_t idx = 0; idx < numNames; idx++) {
             specs.push_back(
@@ -212,4 +212,68 @@ TEST("use simple_metrics_collector")
     EXPECT_NOT_EQUAL(0u, snap4.gauges()[2].observedCount());
 }
 
+TEST("require that attached sharded metrics are collected on tick")
+{
+    using namespace vespalib::metrics;
+    SimpleManagerConfig cf;
+    cf.sliding_window_seconds = 5;
+    std::shared_ptr<MockTick> ticker = std::make_shared<MockTick>(TimeStamp(1.0));
+    auto manager = SimpleMetricsManager::createForTest(cf, std::make_unique<TickProxy>(ticker));
+
+    auto counter = std::make_shared<ShardedCounter>();
+    auto histogram = std::make_shared<ShardedHistogram>();
+    counter->add(5); // before attaching; not reported
+    histogram->record(1000);
+    manager->attachCounter("hot.count", counter);
+    manager->attachHistogram("hot.latency", histogram);
+    counter->add(7);
+    for (uint64_t v = 1; v <= 4; ++v) {
+        histogram->record(v);
+    }
+
+    EXPECT_EQUAL(1.0, ticker->give(TimeStamp(2.0)).count());
+    Snapshot snap1 = manager->snapshot();
+    ASSERT_EQUAL(1u, snap1.counters().size());
+    EXPECT_EQUAL("hot.count", snap1.counters()[0].name());
+    EXPECT_EQUAL(7u, snap1.counters()[0].count());
+    ASSERT_EQUAL(1u, snap1.histograms().size());
+    EXPECT_EQUAL("hot.latency", snap1.histograms()[0].name());
+    EXPECT_EQUAL(4u, snap1.histograms()[0].observedCount());
+    EXPECT_EQUAL(2.5, snap1.histograms()[0].averageValue());
+    EXPECT_EQUAL(1.0, snap1.histograms()[0].minValue());
+    EXPECT_EQUAL(4.0, snap1.histograms()[0].maxValue());
+    EXPECT_EQUAL(2.0, snap1.histograms()[0].p50());
+    EXPECT_EQUAL(4.0, snap1.histograms()[0].p99());
+
+    counter->add(3);
+    histogram->record(6);
+    EXPECT_EQUAL(2.0, ticker->give(TimeStamp(3.0)).count());
+    Snapshot snap2 = manager->snapshot();
+    EXPECT_EQUAL(10u, snap2.counters()[0].count());
+    EXPECT_EQUAL(5u, snap2.histograms()[0].observedCount());
+    EXPECT_EQUAL(6.0, snap2.histograms()[0].maxValue());
+
+    JsonFormatter fmt(snap2);
+    vespalib::string expect = "{"
+    "   snapshot: { from: 1, to: 3 },"
+    "   values: [ { name: 'hot.count',"
+    "       values: { count: 10, rate: 5 }"
+    "   }, {"
+    "       name: 'hot.latency',"
+    "       values: { count: 5, rate: 2.5, average: 3.2, min: 1, max: 6, p50: 3, p90: 6, p99: 6 }"
+    "   } ]"
+    "}";
+    EXPECT_TRUE(compare_json(expect, fmt.asString()));
+
+    // flush sliding window
+    for (int i = 4; i <= 9; ++i) {
+        ticker->give(TimeStamp(i));
+    }
+    Snapshot snap3 = manager->snapshot();
+    EXPECT_EQUAL(0u, snap3.counters()[0].count());
+    ASSERT_EQUAL(1u, snap3.histograms().size());
+    EXPECT_EQUAL(0u, snap3.histograms()[0].observedCount());
+    EXPECT_EQUAL(5u, manager->totalSnapshot().histograms()[0].observedCount());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -11,6 +11,10 @@
 #include <vespa/vespalib/net/state_explorer.h>
 #include <vespa/vespalib/net/slime_explorer.h>
 #include <vespa/vespalib/net/generic_state_handler.h>
+#include <vespa/vespalib/net/heap_profile_handler.h>
+#include <vespa/vespalib/net/cpu_profile_handler.h>
+#include <vespa/vespalib/util/cpu_profiler.h>
+#include <chrono>
 
 using namespace vespalib;
 
@@ -21,6 +25,8 @@ vespalib::string short_root_path = "/state/v1";
 vespalib::string metrics_path = "/state/v1/metrics";
 vespalib::string health_path = "/state/v1/health";
 vespalib::string config_path = "/state/v1/config";
+vespalib::string heap_profile_path = "/state/v1/heapprofile";
+vespalib::string cpu_profile_path = "/state/v1/cpuprofile";
 
 vespalib::string total_metrics_path = "/metrics/total";
 
@@ -217,6 +223,8 @@ TEST_FFFF("require that state api responds to the expected paths",
     EXPECT_TRUE(!f4.get(host_tag, health_path, empty_params).empty());
     EXPECT_TRUE(!f4.get(host_tag, metrics_path, empty_params).empty());
     EXPECT_TRUE(!f4.get(host_tag, config_path, empty_params).empty());
+    EXPECT_TRUE(!f4.get(host_tag, heap_profile_path, empty_params).empty());
+    EXPECT_TRUE(!f4.get(host_tag, cpu_profile_path, empty_params).empty());
     EXPECT_TRUE(!f4.get(host_tag, total_metrics_path, empty_params).empty());
     EXPECT_TRUE(f4.get(host_tag, unknown_path, empty_params).empty());
     EXPECT_TRUE(f4.get(host_tag, unknown_state_path, empty_params).empty());
@@ -301,6 +309,88 @@ TEST_FFFF("require that state api also can return total metric",
                  f4.get(host_tag, total_metrics_path, empty_params));
 }
 
+struct FakeHeapProfiler {
+    static bool running;
+    static size_t interval;
+    static void start(size_t sampleInterval) { running = true; interval = sampleInterval; }
+    static void stop() { running = false; }
+    static void summary(int *running_out, size_t *interval_out, size_t *liveCount, size_t *liveBytes,
+                        size_t *allocCount, size_t *allocBytes, size_t *startTime)
+    {
+        *running_out = running ? 1 : 0;
+        *interval_out = interval;
+        *liveCount = 1;
+        *liveBytes = 100;
+        *allocCount = 2;
+        *allocBytes = 200;
+        *startTime = 0;
+    }
+    static size_t dump(char *buf, size_t len) {
+        vespalib::string profile("heap profile: 1: 100 [2: 200] @ heap_v2/100\n");
+        memcpy(buf, profile.data(), std::min(len, profile.size()));
+        return profile.size();
+    }
+    static HeapProfileHandler::Api api() {
+        HeapProfileHandler::Api api;
+        api.start = start;
+        api.stop = stop;
+        api.summary = summary;
+        api.dump = dump;
+        return api;
+    }
+};
+bool FakeHeapProfiler::running = false;
+size_t FakeHeapProfiler::interval = 0;
+
+TEST("require that heap profile resource reports missing profiler") {
+    HeapProfileHandler::Api api;
+    memset(&api, 0, sizeof(api));
+    HeapProfileHandler handler(api);
+    EXPECT_EQUAL("{\"available\":false}", handler.get(host_tag, heap_profile_path, {{"start", "1000"}}));
+}
+
+TEST_F("require that heap profile resource controls the profiler", HeapProfileHandler(FakeHeapProfiler::api())) {
+    EXPECT_EQUAL("{\"available\":true,\"running\":false,\"sampleInterval\":0}",
+                 f1.get(host_tag, heap_profile_path, empty_params));
+    vespalib::string started = f1.get(host_tag, heap_profile_path, {{"start", "100"}});
+    EXPECT_TRUE(FakeHeapProfiler::running);
+    EXPECT_EQUAL(100u, FakeHeapProfiler::interval);
+    // 1 sample of 100 bytes at interval 100 is scaled by 1/(1-e^-1)
+    EXPECT_TRUE(started.find("\"liveBytes\":158,") != vespalib::string::npos);
+    EXPECT_TRUE(started.find("\"allocatedBytes\":316,") != vespalib::string::npos);
+    EXPECT_TRUE(started.find("allocatedBytesPerSecond") != vespalib::string::npos);
+    EXPECT_TRUE(started.find("profile") == vespalib::string::npos);
+    vespalib::string stopped = f1.get(host_tag, heap_profile_path, {{"stop", ""}, {"profile", ""}});
+    EXPECT_FALSE(FakeHeapProfiler::running);
+    EXPECT_TRUE(stopped.find("\"running\":false") != vespalib::string::npos);
+    EXPECT_TRUE(stopped.find("allocatedBytesPerSecond") == vespalib::string::npos);
+    EXPECT_TRUE(stopped.find("\"profile\":\"heap profile: 1: 100 [2: 200] @ heap_v2/100\\n\"") != vespalib::string::npos);
+}
+
+size_t burn_cpu(std::chrono::milliseconds duration) {
+    size_t sum = 0;
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+        for (size_t i = 0; i < 10000; ++i) {
+            sum += (i * i) ^ sum;
+        }
+    }
+    return sum;
+}
+
+TEST_F("require that cpu profile resource controls the profiler", CpuProfileHandler()) {
+    EXPECT_TRUE(f1.get(host_tag, cpu_profile_path, {{"start", "0"}}).find("\"error\"") != vespalib::string::npos);
+    vespalib::string started = f1.get(host_tag, cpu_profile_path, {{"start", "1000"}});
+    EXPECT_TRUE(started.find("\"running\":true,\"frequency\":1000,") != vespalib::string::npos);
+    EXPECT_TRUE(burn_cpu(std::chrono::milliseconds(200)) != 1);
+    vespalib::string stopped = f1.get(host_tag, cpu_profile_path, {{"stop", ""}, {"profile", ""}, {"pprof", ""}});
+    EXPECT_TRUE(stopped.find("\"running\":false") != vespalib::string::npos);
+    EXPECT_TRUE(stopped.find("\"samples\":0,") == vespalib::string::npos);
+    EXPECT_TRUE(stopped.find("burn_cpu") != vespalib::string::npos);
+    EXPECT_TRUE(stopped.find("\"pprof\":\"") != vespalib::string::npos);
+    EXPECT_FALSE(CpuProfiler::instance().getStacks().empty());
+}
+
 TEST_FFFFF("require that custom handlers can be added to the state server",
           SimpleHealthProducer(), SimpleMetricsProducer(), SimpleComponentConfigProducer(),
           StateApi(f1, f2, f3), DummyHandler("[123]"))
@@ -120,6 +120,9 @@ void Bucket::merge(const Bucket &other)
 
     std::vector<GaugeAggregator> nextGauges = mergeVectors(gauges, other.gauges);
     gauges = std::move(nextGauges);
+
+    std::vector<HistogramAggregator> nextHistograms = mergeVectors(histograms, other.histograms);
+    histograms = std::move(nextHistograms);
 }
 
 void Bucket::padMetrics(const Bucket &source)
@@ -137,6 +140,11 @@ void Bucket::padMetrics(const Bucket &source)
         aggr.maxValue = 0;
         gauges.push_back(aggr);
     }
+    std::vector<HistogramAggregator> missingH = findMissing(histograms, source.histograms);
+    for (HistogramAggregator aggr : missingH) {
+        aggr.values = ShardedHistogram::Snapshot();
+        histograms.push_back(aggr);
+    }
 }
 
 } // namespace vespalib::metrics
@@ -9,6 +9,7 @@
 #include "clock.h"
 #include "counter_aggregator.h"
 #include "gauge_aggregator.h"
+#include "histogram_aggregator.h"
 #include "current_samples.h"
 
 namespace vespalib {
@@ -21,6 +22,7 @@ struct Bucket {
     TimeStamp endTime;
     std::vector<CounterAggregator> counters;
     std::vector<GaugeAggregator> gauges;
+    std::vector<HistogramAggregator> histograms;
 
     void merge(const CurrentSamples &other);
     void merge(const Bucket &other);
@@ -31,7 +33,8 @@ struct Bucket {
           startTime(started),
           endTime(ended),
           counters(),
-          gauges()
+          gauges(),
+          histograms()
     {}
     ~Bucket() {}
     Bucket(Bucket &&) = default;
@@ -35,6 +35,8 @@ public:
     Gauge gauge(const vespalib::string &, const vespalib::string &) override {
         return Gauge(shared_from_this(), MetricName(0));
     }
+    void attachCounter(const vespalib::string &, std::shared_ptr<const ShardedCounter>) override {}
+    void attachHistogram(const vespalib::string &, std::shared_ptr<const ShardedHistogram>) override {}
 
     Dimension dimension(const vespalib::string &) override {
         return Dimension(0);
@@ -0,0 +1,20 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "histogram_aggregator.h"
+#include <assert.h>
+
+namespace vespalib {
+namespace metrics {
+
+HistogramAggregator::HistogramAggregator(MetricIdentifier id, ShardedHistogram::Snapshot v)
+    : idx(id), values(std::move(v))
+{}
+
+void
+HistogramAggregator::merge(const HistogramAggregator &other)
+{
+    assert(idx == other.idx);
+    values.merge(other.values);
+}
+
+} // namespace vespalib::metrics
+} // namespace vespalib
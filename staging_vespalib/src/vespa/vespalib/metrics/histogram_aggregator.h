@@ -0,0 +1,19 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "metric_identifier.h"
+#include <vespa/vespalib/util/sharded_histogram.h>
+
+namespace vespalib {
+namespace metrics {
+
+struct HistogramAggregator {
+    MetricIdentifier idx;
+    ShardedHistogram::Snapshot values;
+
+    HistogramAggregator(MetricIdentifier id, ShardedHistogram::Snapshot v);
+    void merge(const HistogramAggregator &other);
+};
+
+} // namespace vespalib::metrics
+} // namespace vespalib
@@ -31,6 +31,9 @@ JsonFormatter::handle(const Snapshot &snapshot, vespalib::slime::Cursor &target)
     for (const GaugeSnapshot &entry : snapshot.gauges()) {
         handle(entry, target.addObject());
     }
+    for (const HistogramSnapshot &entry : snapshot.histograms()) {
+        handle(entry, target.addObject());
+    }
 }
 
 void
@@ -59,6 +62,22 @@ JsonFormatter::handle(const GaugeSnapshot &snapshot, vespalib::slime::Cursor &ta
     inner.setDouble("rate", snapshot.observedCount() / _snapLen);
 }
 
+void
+JsonFormatter::handle(const HistogramSnapshot &snapshot, vespalib::slime::Cursor &target)
+{
+    target.setString("name", snapshot.name());
+    handle(snapshot.point(), target);
+    Cursor& inner = target.setObject("values");
+    inner.setDouble("average", snapshot.averageValue());
+    inner.setDouble("min", snapshot.minValue());
+    inner.setDouble("max", snapshot.maxValue());
+    inner.setDouble("p50", snapshot.p50());
+    inner.setDouble("p90", snapshot.p90());
+    inner.setDouble("p99", snapshot.p99());
+    inner.setLong("count", snapshot.observedCount());
+    inner.setDouble("rate", snapshot.observedCount() / _snapLen);
+}
+
 void
 JsonFormatter::handle(const PointSnapshot &snapshot, vespalib::slime::Cursor &target)
 {
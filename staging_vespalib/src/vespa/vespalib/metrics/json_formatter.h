@@ -25,6 +25,7 @@ private:
     void handle(const PointSnapshot &snapshot,   Cursor &target);
     void handle(const CounterSnapshot &snapshot, Cursor &target);
     void handle(const GaugeSnapshot &snapshot,   Cursor &target);
+    void handle(const HistogramSnapshot &snapshot, Cursor &target);
 public:
     JsonFormatter(const Snapshot &snapshot);
 
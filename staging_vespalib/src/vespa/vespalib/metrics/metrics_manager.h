@@ -4,6 +4,8 @@
 #include <memory>
 #include <thread>
 #include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/sharded_counter.h>
+#include <vespa/vespalib/util/sharded_histogram.h>
 #include "name_collection.h"
 #include "counter.h"
 #include "gauge.h"
@@ -39,6 +41,24 @@ public:
      **/
     virtual Gauge gauge(const vespalib::string &name, const vespalib::string &description) = 0;
 
+    /**
+     * Report the value of a counter owned by someone else. Hot code
+     * paths update these without involving the manager at all; the
+     * increase since the previous collection is picked up once per
+     * collecting interval.
+     * @param name the name of the metric.
+     * @param counter the counter to report; kept alive by the manager.
+     **/
+    virtual void attachCounter(const vespalib::string &name, std::shared_ptr<const ShardedCounter> counter) = 0;
+
+    /**
+     * Report the values recorded in a histogram owned by someone
+     * else; collected the same way as attached counters.
+     * @param name the name of the metric.
+     * @param histogram the histogram to report; kept alive by the manager.
+     **/
+    virtual void attachHistogram(const vespalib::string &name, std::shared_ptr<const ShardedHistogram> histogram) = 0;
+
     /**
      * Get or create a dimension for labeling metrics.
      * @param name the name of the dimension.
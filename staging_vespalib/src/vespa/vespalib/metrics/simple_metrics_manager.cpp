@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #include "simple_metrics_manager.h"
 #include "simple_tick.h"
+#include <map>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".vespalib.metrics.simple_metrics_manager");
@@ -17,6 +18,9 @@ SimpleMetricsManager::SimpleMetricsManager(const SimpleManagerConfig &config,
       _labelValues(),
       _pointMaps(),
       _currentSamples(),
+      _attachedLock(),
+      _attachedCounters(),
+      _attachedHistograms(),
       _tickSupplier(std::move(tick_supplier)),
       _startTime(_tickSupplier->first()),
       _curTime(_startTime),
@@ -70,6 +74,28 @@ SimpleMetricsManager::gauge(const vespalib::string &name, const vespalib::string
     return Gauge(shared_from_this(), MetricName(id));
 }
 
+void
+SimpleMetricsManager::attachCounter(const vespalib::string &name, std::shared_ptr<const ShardedCounter> counter)
+{
+    size_t id = _metricNames.resolve(name);
+    _metricTypes.check(id, name, MetricTypes::MetricType::COUNTER);
+    LOG(debug, "attached counter with metric name %s -> %zu", name.c_str(), id);
+    Guard guard(_attachedLock);
+    uint64_t last = counter->value();
+    _attachedCounters.push_back({MetricIdentifier(MetricName(id), Point::empty), std::move(counter), last});
+}
+
+void
+SimpleMetricsManager::attachHistogram(const vespalib::string &name, std::shared_ptr<const ShardedHistogram> histogram)
+{
+    size_t id = _metricNames.resolve(name);
+    _metricTypes.check(id, name, MetricTypes::MetricType::HISTOGRAM);
+    LOG(debug, "attached histogram with metric name %s -> %zu", name.c_str(), id);
+    Guard guard(_attachedLock);
+    ShardedHistogram::Snapshot last = histogram->snapshot();
+    _attachedHistograms.push_back({MetricIdentifier(MetricName(id), Point::empty), std::move(histogram), std::move(last)});
+}
+
 Bucket
 SimpleMetricsManager::mergeBuckets()
 {
@@ -127,6 +153,13 @@ SimpleMetricsManager::snapshotFrom(const Bucket &bucket)
         GaugeSnapshot val(name, snap.points()[pi], entry);
         snap.add(val);
     }
+    for (const HistogramAggregator& entry : bucket.histograms) {
+        size_t ni = entry.idx.name().id();
+        size_t pi = entry.idx.point().id();
+        const vespalib::string &name = _metricNames.lookup(ni);
+        HistogramSnapshot val(name, snap.points()[pi], entry);
+        snap.add(val);
+    }
     return snap;
 }
 
@@ -144,6 +177,31 @@ SimpleMetricsManager::totalSnapshot()
     return snapshotFrom(totals);
 }
 
+void
+SimpleMetricsManager::collectAttached(CurrentSamples &samples, Bucket &bucket)
+{
+    Guard guard(_attachedLock);
+    for (auto &attached : _attachedCounters) {
+        uint64_t value = attached.source->value();
+        samples.add(Counter::Increment(attached.idx, value - attached.last));
+        attached.last = value;
+    }
+    // histograms attached more than once with the same name are reported together
+    std::map<MetricIdentifier, HistogramAggregator> histograms;
+    for (auto &attached : _attachedHistograms) {
+        ShardedHistogram::Snapshot values = attached.source->snapshot();
+        HistogramAggregator aggr(attached.idx, values.since(attached.last));
+        attached.last = std::move(values);
+        auto iter_check = histograms.emplace(attached.idx, aggr);
+        if (!iter_check.second) {
+            iter_check.first->second.merge(aggr);
+        }
+    }
+    for (const auto &entry : histograms) {
+        bucket.histograms.push_back(entry.second);
+    }
+}
+
 void
 SimpleMetricsManager::collectCurrentSamples(TimeStamp prev,
                                             TimeStamp curr)
@@ -151,6 +209,7 @@ SimpleMetricsManager::collectCurrentSamples(TimeStamp prev,
     CurrentSamples samples;
     _currentSamples.extract(samples);
     Bucket newBucket(++_collectCnt, prev, curr);
+    collectAttached(samples, newBucket);
     newBucket.merge(samples);
 
     Guard guard(_bucketsLock);
@@ -46,6 +46,17 @@ private:
 
     CurrentSamples _currentSamples;
 
+    template <typename T, typename V>
+    struct Attached {
+        MetricIdentifier idx;
+        std::shared_ptr<const T> source;
+        V last;
+    };
+    std::mutex _attachedLock;
+    std::vector<Attached<ShardedCounter, uint64_t>> _attachedCounters;
+    std::vector<Attached<ShardedHistogram, ShardedHistogram::Snapshot>> _attachedHistograms;
+    void collectAttached(CurrentSamples &samples, Bucket &bucket);
+
     Tick::UP _tickSupplier;
     TimeStamp _startTime;
     TimeStamp _curTime;
@@ -76,6 +87,8 @@ public:
                                                          Tick::UP tick_supplier);
     Counter counter(const vespalib::string &name, const vespalib::string &description) override;
     Gauge gauge(const vespalib::string &name, const vespalib::string &description) override;
+    void attachCounter(const vespalib::string &name, std::shared_ptr<const ShardedCounter> counter) override;
+    void attachHistogram(const vespalib::string &name, std::shared_ptr<const ShardedHistogram> histogram) override;
     Dimension dimension(const vespalib::string &name) override;
     Label label(const vespalib::string &value) override;
     PointBuilder pointBuilder(Point from) override;
@@ -5,6 +5,7 @@
 #include <vector>
 #include "counter_aggregator.h"
 #include "gauge_aggregator.h"
+#include "histogram_aggregator.h"
 
 namespace vespalib {
 namespace metrics {
@@ -71,12 +72,48 @@ public:
     double lastValue() const { return _lastValue; }
 };
 
+class HistogramSnapshot {
+private:
+    const vespalib::string _name;
+    const PointSnapshot &_point;
+    const size_t _observedCount;
+    const double _averageValue;
+    const double _minValue;
+    const double _maxValue;
+    const double _p50;
+    const double _p90;
+    const double _p99;
+public:
+    HistogramSnapshot(const vespalib::string &n, const PointSnapshot &p, const HistogramAggregator &c)
+        : _name(n),
+          _point(p),
+          _observedCount(c.values.count),
+          _averageValue(c.values.average()),
+          _minValue(c.values.min()),
+          _maxValue(c.values.max()),
+          _p50(c.values.percentile(0.50)),
+          _p90(c.values.percentile(0.90)),
+          _p99(c.values.percentile(0.99))
+    {}
+    ~HistogramSnapshot() {}
+    const vespalib::string &name() const { return _name; }
+    const PointSnapshot &point() const { return _point; }
+    size_t observedCount() const { return _observedCount; }
+    double averageValue() const { return _averageValue; }
+    double minValue() const { return _minValue; }
+    double maxValue() const { return _maxValue; }
+    double p50() const { return _p50; }
+    double p90() const { return _p90; }
+    double p99() const { return _p99; }
+};
+
 class Snapshot {
 private:
     double _start;
     double _end;
     std::vector<CounterSnapshot> _counters;
     std::vector<GaugeSnapshot> _gauges;
+    std::vector<HistogramSnapshot> _histograms;
     std::vector<PointSnapshot> _points;
 public:
     double startTime() const { return _start; }; // seconds since 1970
@@ -88,18 +125,22 @@ public:
     const std::vector<GaugeSnapshot> &gauges() const {
         return _gauges;
     }
+    const std::vector<HistogramSnapshot> &histograms() const {
+        return _histograms;
+    }
     const std::vector<PointSnapshot> &points() const {
         return _points;
     }
 
     // builders:
     Snapshot(double s, double e)
-        : _start(s), _end(e), _counters(), _gauges()
+        : _start(s), _end(e), _counters(), _gauges(), _histograms()
     {}
     ~Snapshot() {}
     void add(const PointSnapshot &entry)   { _points.push_back(entry); }
     void add(const CounterSnapshot &entry) { _counters.push_back(entry); }
     void add(const GaugeSnapshot &entry)   { _gauges.push_back(entry); }
+    void add(const HistogramSnapshot &entry) { _histograms.push_back(entry); }
 };
 
 } // namespace vespalib::metrics
@@ -0,0 +1,62 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "cpu_profile_handler.h"
+#include <vespa/vespalib/encoding/base64.h>
+#include <vespa/vespalib/util/cpu_profiler.h>
+#include <vespa/vespalib/util/jsonwriter.h>
+#include <cstdlib>
+
+namespace vespalib {
+
+vespalib::string
+CpuProfileHandler::get(const vespalib::string &,
+                       const vespalib::string &,
+                       const std::map<vespalib::string,vespalib::string> &params) const
+{
+    CpuProfiler &profiler = CpuProfiler::instance();
+    JSONStringer json;
+    json.beginObject();
+    auto start = params.find("start");
+    if (start != params.end()) {
+        uint32_t frequency = strtoul(start->second.c_str(), nullptr, 0);
+        if ((frequency == 0) || (frequency > CpuProfiler::MAX_FREQUENCY)) {
+            json.appendKey("error");
+            json.appendString("start frequency must be in [1, 1000]");
+        } else if (!profiler.start(frequency)) {
+            json.appendKey("error");
+            json.appendString("could not start profiling; SIGPROF is in use");
+        }
+    }
+    if (params.find("stop") != params.end()) {
+        profiler.stop();
+    }
+    json.appendKey("running");
+    json.appendBool(profiler.isRunning());
+    uint32_t frequency = profiler.getFrequency();
+    json.appendKey("frequency");
+    json.appendUInt64(frequency);
+    if (frequency > 0) {
+        json.appendKey("startTime");
+        json.appendUInt64(profiler.getStartTime());
+        json.appendKey("samples");
+        json.appendUInt64(profiler.getSampleCount());
+        bool folded = (params.find("profile") != params.end());
+        bool pprof = (params.find("pprof") != params.end());
+        if (folded || pprof) {
+            auto stacks = profiler.getStacks();
+            if (folded) {
+                json.appendKey("profile");
+                json.appendString(CpuProfiler::toFolded(stacks));
+            }
+            if (pprof) {
+                vespalib::string data = CpuProfiler::toPprof(stacks, frequency);
+                json.appendKey("pprof");
+                json.appendString(Base64::encode(data.data(), data.size()));
+            }
+        }
+    }
+    json.endObject();
+    return json.toString();
+}
+
+} // namespace vespalib
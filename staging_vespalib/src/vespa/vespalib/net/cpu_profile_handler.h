@@ -0,0 +1,27 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "json_get_handler.h"
+
+namespace vespalib {
+
+/**
+ * Controls the sampling CPU profiler of the process (see CpuProfiler).
+ * Profiling is off until explicitly started.
+ *
+ * Parameters:
+ *   start=<hz>  start sampling with the given frequency (at most 1000)
+ *   stop        stop sampling, keeping what has been collected
+ *   profile     include the profile as folded stacks, for flame graphs
+ *   pprof       include the profile in pprof CPU profile format, base64 encoded
+ **/
+class CpuProfileHandler : public JsonGetHandler
+{
+public:
+    vespalib::string get(const vespalib::string &host,
+                         const vespalib::string &path,
+                         const std::map<vespalib::string,vespalib::string> &params) const override;
+};
+
+} // namespace vespalib
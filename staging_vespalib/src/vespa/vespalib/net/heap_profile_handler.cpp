@@ -0,0 +1,120 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "heap_profile_handler.h"
+#include <vespa/vespalib/util/jsonwriter.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <dlfcn.h>
+
+namespace vespalib {
+
+namespace {
+
+template <typename T>
+T lookup(const char *name) {
+    return reinterpret_cast<T>(dlsym(RTLD_DEFAULT, name));
+}
+
+bool available(const HeapProfileHandler::Api &api) {
+    return (api.start != nullptr) && (api.stop != nullptr) && (api.summary != nullptr) && (api.dump != nullptr);
+}
+
+// Each sample of average size avg represents avg / (1 - e^(-avg/interval))
+// bytes, the same unsampling pprof does for heap_v2 profiles.
+double unsample(size_t count, size_t bytes, size_t interval) {
+    if ((count == 0) || (interval == 0)) {
+        return bytes;
+    }
+    double avg = double(bytes) / count;
+    return bytes / (1.0 - std::exp(-avg / interval));
+}
+
+vespalib::string dump_profile(const HeapProfileHandler::Api &api) {
+    // the profile may grow between the calls; retry until it fits
+    std::vector<char> buf(64 * 1024);
+    for (;;) {
+        size_t len = api.dump(&buf[0], buf.size());
+        if (len <= buf.size()) {
+            return vespalib::string(&buf[0], len);
+        }
+        buf.resize(len + len / 4);
+    }
+}
+
+} // namespace vespalib::<unnamed>
+
+HeapProfileHandler::Api
+HeapProfileHandler::lookupApi()
+{
+    Api api;
+    api.start = lookup<decltype(api.start)>("vespamalloc_heapprofile_start");
+    api.stop = lookup<decltype(api.stop)>("vespamalloc_heapprofile_stop");
+    api.summary = lookup<decltype(api.summary)>("vespamalloc_heapprofile_summary");
+    api.dump = lookup<decltype(api.dump)>("vespamalloc_heapprofile_dump");
+    return api;
+}
+
+HeapProfileHandler::HeapProfileHandler()
+    : HeapProfileHandler(lookupApi())
+{
+}
+
+HeapProfileHandler::HeapProfileHandler(const Api &api)
+    : _api(api)
+{
+}
+
+vespalib::string
+HeapProfileHandler::get(const vespalib::string &,
+                        const vespalib::string &,
+                        const std::map<vespalib::string,vespalib::string> &params) const
+{
+    JSONStringer json;
+    json.beginObject();
+    json.appendKey("available");
+    json.appendBool(available(_api));
+    if (available(_api)) {
+        auto start = params.find("start");
+        if (start != params.end()) {
+            size_t interval = strtoul(start->second.c_str(), nullptr, 0);
+            if (interval > 0) {
+                _api.start(interval);
+            }
+        }
+        if (params.find("stop") != params.end()) {
+            _api.stop();
+        }
+        int running(0);
+        size_t interval(0), liveCount(0), liveBytes(0), allocCount(0), allocBytes(0), startTime(0);
+        _api.summary(&running, &interval, &liveCount, &liveBytes, &allocCount, &allocBytes, &startTime);
+        json.appendKey("running");
+        json.appendBool(running != 0);
+        json.appendKey("sampleInterval");
+        json.appendUInt64(interval);
+        if (interval > 0) {
+            double allocated = unsample(allocCount, allocBytes, interval);
+            size_t seconds = std::max(time(nullptr) - time_t(startTime), time_t(1));
+            json.appendKey("startTime");
+            json.appendUInt64(startTime);
+            json.appendKey("liveBytes");
+            json.appendUInt64(unsample(liveCount, liveBytes, interval));
+            json.appendKey("allocatedBytes");
+            json.appendUInt64(allocated);
+            if (running != 0) {
+                json.appendKey("allocatedBytesPerSecond");
+                json.appendDouble(allocated / seconds);
+            }
+            if (params.find("profile") != params.end()) {
+                json.appendKey("profile");
+                json.appendString(dump_profile(_api));
+            }
+        }
+    }
+    json.endObject();
+    return json.toString();
+}
+
+} // namespace vespalib
@@ -0,0 +1,47 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "json_get_handler.h"
+
+namespace vespalib {
+
+/**
+ * Controls the sampling heap profiler in vespamalloc, if the process
+ * is running with it. The profiler entry points are looked up at
+ * runtime, so other allocators just report the profiler as not
+ * available.
+ *
+ * Parameters:
+ *   start=<bytes>  start sampling with the given mean sample interval
+ *   stop           stop sampling, keeping what has been collected
+ *   profile        include the profile in pprof heap profile format
+ *
+ * Byte counts in the response are estimates scaled up from the
+ * samples.
+ **/
+class HeapProfileHandler : public JsonGetHandler
+{
+public:
+    struct Api {
+        void (*start)(size_t sampleInterval);
+        void (*stop)();
+        void (*summary)(int *running, size_t *sampleInterval, size_t *liveCount, size_t *liveBytes,
+                        size_t *allocCount, size_t *allocBytes, size_t *startTime);
+        size_t (*dump)(char *buf, size_t len);
+    };
+    /**
+     * Looks up the profiler in the running process.
+     **/
+    static Api lookupApi();
+
+    HeapProfileHandler();
+    explicit HeapProfileHandler(const Api &api);
+    vespalib::string get(const vespalib::string &host,
+                         const vespalib::string &path,
+                         const std::map<vespalib::string,vespalib::string> &params) const override;
+private:
+    Api _api;
+};
+
+} // namespace vespalib
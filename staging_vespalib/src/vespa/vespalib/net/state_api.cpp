@@ -148,6 +148,10 @@ StateApi::get(const vespalib::string &host,
         return respond_metrics(get_consumer(params, "statereporter"), _healthProducer, _metricsProducer);
     } else if (path == "/state/v1/config") {
         return respond_config(_componentConfigProducer);
+    } else if (path == "/state/v1/heapprofile") {
+        return _heapProfileHandler.get(host, path, params);
+    } else if (path == "/state/v1/cpuprofile") {
+        return _cpuProfileHandler.get(host, path, params);
     } else if (path == "/metrics/total") {
         return _metricsProducer.getTotalMetrics(get_consumer(params, ""));
     } else {
@@ -162,7 +166,10 @@ StateApi::StateApi(const HealthProducer &hp,
                    ComponentConfigProducer &ccp)
     : _healthProducer(hp),
       _metricsProducer(mp),
-      _componentConfigProducer(ccp)
+      _componentConfigProducer(ccp),
+      _heapProfileHandler(),
+      _cpuProfileHandler(),
+      _handler_repo()
 {
 }
 
@@ -6,6 +6,8 @@
 #include "health_producer.h"
 #include "metrics_producer.h"
 #include "component_config_producer.h"
+#include "heap_profile_handler.h"
+#include "cpu_profile_handler.h"
 #include <memory>
 #include "json_handler_repo.h"
 
@@ -23,6 +25,8 @@ private:
     const HealthProducer &_healthProducer;
     MetricsProducer &_metricsProducer;
     ComponentConfigProducer &_componentConfigProducer;
+    HeapProfileHandler _heapProfileHandler;
+    CpuProfileHandler _cpuProfileHandler;
     JsonHandlerRepo _handler_repo;
 
 public:
@@ -0,0 +1,284 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "cpu_profiler.h"
+#include <vespa/vespalib/util/backtrace.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <dlfcn.h>
+#include <cxxabi.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+namespace vespalib {
+
+namespace {
+
+CpuProfiler *_active = nullptr;
+
+void *interrupted_pc(void *context) {
+#if defined(__x86_64__)
+    return reinterpret_cast<void *>(static_cast<ucontext_t *>(context)->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+    return reinterpret_cast<void *>(static_cast<ucontext_t *>(context)->uc_mcontext.pc);
+#else
+    (void) context;
+    return nullptr;
+#endif
+}
+
+bool set_timer(uint32_t frequency) {
+    struct itimerval timer;
+    memset(&timer, 0, sizeof(timer));
+    if (frequency > 0) {
+        timer.it_interval.tv_usec = 1000000 / frequency;
+        timer.it_value = timer.it_interval;
+    }
+    return (setitimer(ITIMER_PROF, &timer, nullptr) == 0);
+}
+
+vespalib::string symbolize(void *pc) {
+    Dl_info info;
+    if ((dladdr(pc, &info) != 0)) {
+        if ((info.dli_sname != nullptr)) {
+            if (strncmp(info.dli_sname, "_Z", 2) == 0) {
+                int status = 0;
+                char *name = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                if (name != nullptr) {
+                    vespalib::string result(name);
+                    free(name);
+                    return result;
+                }
+            }
+            return info.dli_sname;
+        }
+        if (info.dli_fname != nullptr) {
+            const char *base = strrchr(info.dli_fname, '/');
+            return make_string("[%s+0x%zx]", (base != nullptr) ? (base + 1) : info.dli_fname,
+                               size_t(static_cast<char *>(pc) - static_cast<char *>(info.dli_fbase)));
+        }
+    }
+    return make_string("[%p]", pc);
+}
+
+void append_words(vespalib::string &out, std::initializer_list<uintptr_t> words) {
+    for (uintptr_t word : words) {
+        out.append(reinterpret_cast<const char *>(&word), sizeof(word));
+    }
+}
+
+} // namespace vespalib::<unnamed>
+
+CpuProfiler::CpuProfiler()
+    : _lock(),
+      _slots(),
+      _next(0),
+      _first(0),
+      _running(false),
+      _frequency(0),
+      _startTime(0),
+      _installed(false)
+{
+}
+
+CpuProfiler::~CpuProfiler()
+{
+    stop();
+}
+
+CpuProfiler &
+CpuProfiler::instance()
+{
+    static CpuProfiler profiler;
+    return profiler;
+}
+
+void
+CpuProfiler::onSignal(int, siginfo_t *, void *context)
+{
+    int saved_errno = errno;
+    CpuProfiler *self = _active;
+    if ((self != nullptr) && self->_running.load(std::memory_order_relaxed)) {
+        self->record(context);
+    }
+    errno = saved_errno;
+}
+
+void
+CpuProfiler::record(void *context)
+{
+    void *frames[MAX_DEPTH + 8];
+    int n = getStackTraceFrames(frames, MAX_DEPTH + 8);
+    // drop the frames of the signal handler itself
+    int skip = 0;
+    void *pc = interrupted_pc(context);
+    for (int i = 0; (pc != nullptr) && (i < n); ++i) {
+        if (frames[i] == pc) {
+            skip = i;
+            break;
+        }
+    }
+    uint64_t seq = _next.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = _slots[seq % NUM_SLOTS];
+    slot.seq.store(2 * seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.depth = std::min(size_t(std::max(n - skip, 0)), MAX_DEPTH);
+    memcpy(slot.frames, frames + skip, slot.depth * sizeof(void *));
+    slot.seq.store(2 * seq + 2, std::memory_order_release);
+}
+
+bool
+CpuProfiler::start(uint32_t frequency)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (!_installed) {
+        struct sigaction old;
+        if ((sigaction(SIGPROF, nullptr, &old) != 0) ||
+            (((old.sa_flags & SA_SIGINFO) == 0) && (old.sa_handler != SIG_DFL) && (old.sa_handler != SIG_IGN)) ||
+            (((old.sa_flags & SA_SIGINFO) != 0) && (old.sa_sigaction != onSignal)))
+        {
+            return false;
+        }
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = onSignal;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        // the handler stays installed, so a late signal after stop is harmless
+        if (sigaction(SIGPROF, &action, nullptr) != 0) {
+            return false;
+        }
+        _installed = true;
+    }
+    set_timer(0);
+    _running = false;
+    if (!_slots) {
+        _slots.reset(new Slot[NUM_SLOTS]);
+    }
+    for (size_t i = 0; i < NUM_SLOTS; ++i) {
+        _slots[i].seq.store(0, std::memory_order_relaxed);
+    }
+    // let the unwinder initialize itself outside the signal handler
+    void *frames[MAX_DEPTH];
+    getStackTraceFrames(frames, MAX_DEPTH);
+    _frequency = std::max(1u, std::min(frequency, MAX_FREQUENCY));
+    _first = _next.load();
+    _startTime = time(nullptr);
+    _active = this;
+    _running = true;
+    if (!set_timer(_frequency)) {
+        _running = false;
+        return false;
+    }
+    return true;
+}
+
+void
+CpuProfiler::stop()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_running) {
+        set_timer(0);
+        _running = false;
+    }
+}
+
+uint32_t
+CpuProfiler::getFrequency() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _frequency;
+}
+
+time_t
+CpuProfiler::getStartTime() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _startTime;
+}
+
+uint64_t
+CpuProfiler::getSampleCount() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _next.load() - _first;
+}
+
+std::vector<CpuProfiler::Stack>
+CpuProfiler::getStacks() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    std::map<std::vector<void *>, size_t> counts;
+    if (_slots) {
+        for (size_t i = 0; i < NUM_SLOTS; ++i) {
+            const Slot &slot = _slots[i];
+            uint64_t before = slot.seq.load(std::memory_order_acquire);
+            if ((before == 0) || ((before & 1) != 0)) {
+                continue;
+            }
+            uint32_t depth = std::min(size_t(slot.depth), MAX_DEPTH);
+            std::vector<void *> frames(slot.frames, slot.frames + depth);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != before) {
+                continue; // overwritten while reading
+            }
+            ++counts[frames];
+        }
+    }
+    std::vector<Stack> result;
+    for (auto &entry : counts) {
+        result.emplace_back(entry.first, entry.second);
+    }
+    std::sort(result.begin(), result.end(),
+              [](const Stack &a, const Stack &b) { return (a.count > b.count); });
+    return result;
+}
+
+vespalib::string
+CpuProfiler::toFolded(const std::vector<Stack> &stacks)
+{
+    std::map<void *, vespalib::string> symbols;
+    vespalib::string out;
+    for (const Stack &stack : stacks) {
+        for (size_t i = stack.frames.size(); i-- > 0; ) {
+            // return addresses point after the call; look up the call itself
+            void *pc = stack.frames[i];
+            void *lookup = (i > 0) ? static_cast<void *>(static_cast<char *>(pc) - 1) : pc;
+            auto pos = symbols.find(lookup);
+            if (pos == symbols.end()) {
+                pos = symbols.emplace(lookup, symbolize(lookup)).first;
+            }
+            out.append(pos->second);
+            if (i > 0) {
+                out.push_back(';');
+            }
+        }
+        out.append(make_string(" %zu\n", stack.count));
+    }
+    return out;
+}
+
+vespalib::string
+CpuProfiler::toPprof(const std::vector<Stack> &stacks, uint32_t frequency)
+{
+    vespalib::string out;
+    append_words(out, {0, 3, 0, 1000000 / std::max(frequency, 1u), 0});
+    for (const Stack &stack : stacks) {
+        append_words(out, {stack.count, stack.frames.size()});
+        for (void *pc : stack.frames) {
+            append_words(out, {reinterpret_cast<uintptr_t>(pc)});
+        }
+    }
+    append_words(out, {0, 1, 0});
+    std::ifstream maps("/proc/self/maps");
+    std::stringstream text;
+    text << maps.rdbuf();
+    out.append(text.str());
+    return out;
+}
+
+} // namespace vespalib
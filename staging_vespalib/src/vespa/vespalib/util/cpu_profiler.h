@@ -0,0 +1,113 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/stllike/string.h>
+#include <atomic>
+#include <csignal>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Sampling on-CPU profiler for the whole process. When running, the
+ * process gets SIGPROF at the given frequency per second of consumed
+ * CPU time, and the signal handler records the stack of the
+ * interrupted thread in a fixed size ring buffer. The buffer always
+ * holds the most recent samples, so the profiler can be left running
+ * at a low frequency and inspected when needed.
+ *
+ * Threads are identified by the stack tag of the executor running
+ * them (see VESPA_THREAD_STACK_TAG), which is part of each stack.
+ *
+ * There is only one profiler per process, since the profiling timer
+ * and signal are process wide. It will not start if some other
+ * SIGPROF handler is installed.
+ **/
+class CpuProfiler
+{
+public:
+    static constexpr size_t MAX_DEPTH = 48;
+    static constexpr size_t NUM_SLOTS = 16384;
+    static constexpr uint32_t MAX_FREQUENCY = 1000;
+
+    /**
+     * A unique stack with the number of samples of it. Frames are
+     * return addresses, leaf first.
+     **/
+    struct Stack {
+        std::vector<void *> frames;
+        size_t count;
+        Stack(std::vector<void *> frames_in, size_t count_in)
+            : frames(std::move(frames_in)), count(count_in) {}
+    };
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        uint32_t depth;
+        void *frames[MAX_DEPTH];
+    };
+
+    mutable std::mutex       _lock;
+    std::unique_ptr<Slot[]>  _slots;
+    std::atomic<uint64_t>    _next;
+    uint64_t                 _first;
+    std::atomic<bool>        _running;
+    uint32_t                 _frequency;
+    time_t                   _startTime;
+    bool                     _installed;
+
+    CpuProfiler();
+    static void onSignal(int sig, siginfo_t *info, void *context);
+    void record(void *context);
+
+public:
+    CpuProfiler(const CpuProfiler &) = delete;
+    CpuProfiler &operator=(const CpuProfiler &) = delete;
+    ~CpuProfiler();
+
+    static CpuProfiler &instance();
+
+    /**
+     * Start (or restart) sampling, discarding earlier samples.
+     *
+     * @return false if the profiling signal is used by someone else.
+     * @param frequency samples per second of CPU time, at most MAX_FREQUENCY.
+     **/
+    bool start(uint32_t frequency);
+    void stop();
+    bool isRunning() const { return _running; }
+    uint32_t getFrequency() const;
+    time_t getStartTime() const;
+
+    /**
+     * @return number of samples taken since start, including the ones
+     *         no longer in the ring buffer.
+     **/
+    uint64_t getSampleCount() const;
+
+    /**
+     * @return the samples currently in the ring buffer, aggregated
+     *         per unique stack.
+     **/
+    std::vector<Stack> getStacks() const;
+
+    /**
+     * Render stacks in the folded format used by flame graph tools:
+     * one line per stack with symbolized frames, root first,
+     * separated by ';', followed by the sample count.
+     **/
+    static vespalib::string toFolded(const std::vector<Stack> &stacks);
+
+    /**
+     * Render stacks in the legacy binary CPU profile format read by
+     * pprof, including the memory map of the process for symbolization.
+     **/
+    static vespalib::string toPprof(const std::vector<Stack> &stacks, uint32_t frequency);
+};
+
+} // namespace vespalib
@@ -0,0 +1,76 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vdstestlib/cppunit/macros.h>
+#include <vespa/storage/bucketdb/btree_bucket_database.h>
+#include <tests/distributor/bucketdatabasetest.h>
+
+namespace storage {
+namespace distributor {
+
+using document::BucketId;
+
+struct BTreeBucketDatabaseTest : public BucketDatabaseTest {
+    BTreeBucketDatabase _db;
+    BucketDatabase& db() override { return _db; };
+
+    CPPUNIT_TEST_SUITE(BTreeBucketDatabaseTest);
+    SETUP_DATABASE_TESTS();
+    CPPUNIT_TEST(read_guard_sees_snapshot_of_database);
+    CPPUNIT_TEST(read_guard_finds_parents_and_self);
+    CPPUNIT_TEST_SUITE_END();
+
+    void read_guard_sees_snapshot_of_database();
+    void read_guard_finds_parents_and_self();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BTreeBucketDatabaseTest);
+
+namespace {
+
+BucketDatabase::Entry make_entry(const BucketId& bucket, uint16_t node, uint32_t checksum) {
+    BucketDatabase::Entry entry(bucket);
+    entry->addNode(BucketCopy(0, node, api::BucketInfo(checksum, 1, 1)), {});
+    return entry;
+}
+
+}
+
+void
+BTreeBucketDatabaseTest::read_guard_sees_snapshot_of_database()
+{
+    _db.update(make_entry(BucketId(16, 16), 1, 10));
+    auto guard = _db.acquire_read_guard();
+    _db.update(make_entry(BucketId(16, 16), 2, 20));
+    _db.update(make_entry(BucketId(16, 17), 3, 30));
+    _db.remove(BucketId(16, 16));
+
+    auto entry = guard.get(BucketId(16, 16));
+    CPPUNIT_ASSERT(entry.valid());
+    CPPUNIT_ASSERT_EQUAL(uint32_t(1), entry->getNodeCount());
+    CPPUNIT_ASSERT_EQUAL(uint16_t(1), entry->getNodeRef(0).getNode());
+    CPPUNIT_ASSERT_EQUAL(uint32_t(10), entry->getNodeRef(0).getChecksum());
+    CPPUNIT_ASSERT(!guard.get(BucketId(16, 17)).valid());
+
+    auto fresh_guard = _db.acquire_read_guard();
+    CPPUNIT_ASSERT(!fresh_guard.get(BucketId(16, 16)).valid());
+    CPPUNIT_ASSERT(fresh_guard.get(BucketId(16, 17)).valid());
+    CPPUNIT_ASSERT(fresh_guard.generation() > guard.generation());
+}
+
+void
+BTreeBucketDatabaseTest::read_guard_finds_parents_and_self()
+{
+    _db.update(make_entry(BucketId(1, 0x1), 1, 10));
+    _db.update(make_entry(BucketId(3, 0x5), 1, 10));
+    _db.update(make_entry(BucketId(8, 0x15), 1, 10));
+    _db.update(make_entry(BucketId(8, 0x25), 1, 10));
+    auto guard = _db.acquire_read_guard();
+    std::vector<BucketDatabase::Entry> entries;
+    guard.find_parents_and_self(BucketId(16, 0x1015), entries);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), entries.size());
+    CPPUNIT_ASSERT_EQUAL(BucketId(1, 0x1), entries[0].getBucketId());
+    CPPUNIT_ASSERT_EQUAL(BucketId(3, 0x5), entries[1].getBucketId());
+    CPPUNIT_ASSERT_EQUAL(BucketId(8, 0x15), entries[2].getBucketId());
+}
+
+}
+}
@@ -64,6 +64,8 @@ class Distributor_Test : public CppUnit::TestFixture,
     CPPUNIT_TEST(leaving_recovery_mode_immediately_sends_getnodestate_replies);
     CPPUNIT_TEST(pending_to_no_pending_default_merges_edge_immediately_sends_getnodestate_replies);
     CPPUNIT_TEST(pending_to_no_pending_global_merges_edge_immediately_sends_getnodestate_replies);
+    CPPUNIT_TEST(changed_bucket_is_checked_ahead_of_throttled_scan);
+    CPPUNIT_TEST(changed_buckets_are_not_queued_by_default);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -103,6 +105,8 @@ protected:
     void leaving_recovery_mode_immediately_sends_getnodestate_replies();
     void pending_to_no_pending_default_merges_edge_immediately_sends_getnodestate_replies();
     void pending_to_no_pending_global_merges_edge_immediately_sends_getnodestate_replies();
+    void changed_bucket_is_checked_ahead_of_throttled_scan();
+    void changed_buckets_are_not_queued_by_default();
     // TODO handle edge case for window between getnodestate reply already
     // sent and new request not yet received
 
@@ -220,6 +224,7 @@ private:
     void configure_mutation_sequencing(bool enabled);
     void configure_merge_busy_inhibit_duration(int seconds);
     void do_test_pending_merge_getnodestate_reply_edge(BucketSpace space);
+    void add_single_replica_of_bucket_100();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(Distributor_Test);
@@ -1112,6 +1117,38 @@ void Distributor_Test::pending_to_no_pending_global_merges_edge_immediately_send
     do_test_pending_merge_getnodestate_reply_edge(FixedBucketSpaces::global_space());
 }
 
+void Distributor_Test::add_single_replica_of_bucket_100() {
+    getExternalOperationHandler().updateBucketDatabase(
+            makeDocumentBucket(document::BucketId(16, 100)),
+            BucketCopy(1, 0, api::BucketInfo(10, 1, 100)).setTrusted(true),
+            DatabaseUpdate::CREATE_IF_NONEXISTING);
+}
+
+void Distributor_Test::changed_bucket_is_checked_ahead_of_throttled_scan() {
+    setupDistributor(Redundancy(2), NodeCount(2), "storage:2 distributor:1");
+    getConfig().setIncrementalMaintenanceScanning(true);
+    getConfig().setBackgroundScanTickInterval(1000);
+    CPPUNIT_ASSERT(!_distributor->isInRecoveryMode());
+
+    add_single_replica_of_bucket_100();
+    CPPUNIT_ASSERT_EQUAL(size_t(1), _distributor->_scanner->getQueuedBucketCount());
+
+    // Bucket is missing a replica and is merged without being reached by the scan
+    tick();
+    CPPUNIT_ASSERT_EQUAL(size_t(0), _distributor->_scanner->getQueuedBucketCount());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), _sender.commands.size());
+    CPPUNIT_ASSERT_EQUAL(api::MessageType::MERGEBUCKET, _sender.commands[0]->getType());
+    CPPUNIT_ASSERT_EQUAL(document::BucketId(16, 100), _sender.commands[0]->getBucketId());
+}
+
+void Distributor_Test::changed_buckets_are_not_queued_by_default() {
+    setupDistributor(Redundancy(2), NodeCount(2), "storage:2 distributor:1");
+    CPPUNIT_ASSERT(!getConfig().getIncrementalMaintenanceScanning());
+
+    add_single_replica_of_bucket_100();
+    CPPUNIT_ASSERT_EQUAL(size_t(0), _distributor->_scanner->getQueuedBucketCount());
+}
+
 }
 
 }
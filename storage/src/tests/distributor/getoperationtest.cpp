@@ -41,6 +41,7 @@ class GetOperationTest : public CppUnit::TestFixture, public DistributorTestUtil
     CPPUNIT_TEST(testMultiInconsistentBucketNotFoundDeleted);
     CPPUNIT_TEST(testMultipleCopiesWithFailureOnLocalNode);
     CPPUNIT_TEST(canGetDocumentsWhenAllReplicaNodesRetired);
+    CPPUNIT_TEST(trusted_replica_with_lowest_latency_is_asked_when_routing_by_latency);
     CPPUNIT_TEST_SUITE_END();
 
     std::shared_ptr<const document::DocumentTypeRepo> _repo;
@@ -155,6 +156,7 @@ public:
     void testSendToAllInvalidCopies();
     void testMultipleCopiesWithFailureOnLocalNode();
     void canGetDocumentsWhenAllReplicaNodesRetired();
+    void trusted_replica_with_lowest_latency_is_asked_when_routing_by_latency();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(GetOperationTest);
@@ -564,4 +566,32 @@ GetOperationTest::canGetDocumentsWhenAllReplicaNodesRetired()
             _sender.getCommands(true));
 }
 
+void
+GetOperationTest::trusted_replica_with_lowest_latency_is_asked_when_routing_by_latency()
+{
+    setClusterState("distributor:1 storage:4");
+    getConfig().setLatencyAwareGetRouting(true);
+    auto& nodeInfo = getDistributor().getPendingMessageTracker().getNodeInfo();
+    nodeInfo.addLatencySample(1, std::chrono::milliseconds(30));
+    nodeInfo.addLatencySample(2, std::chrono::milliseconds(5));
+    nodeInfo.addLatencySample(3, std::chrono::milliseconds(20));
+
+    addNodesToBucketDB(bucketId, "1=100/3/10/t,2=100/3/10/t,3=100/3/10/t");
+
+    sendGet();
+
+    CPPUNIT_ASSERT_EQUAL(std::string("Get => 2"), _sender.getCommands(true));
+
+    // Retried on the trusted replica with the next lowest latency
+    replyWithFailure();
+    CPPUNIT_ASSERT_EQUAL(std::string("Get => 2,Get => 3"), _sender.getCommands(true));
+
+    replyWithDocument();
+
+    CPPUNIT_ASSERT_EQUAL(
+            std::string("GetReply(BucketId(0x0000000000000000), doc:test:uri, "
+                        "timestamp 100) ReturnCode(NONE)"),
+            _sender.getLastReply());
+}
+
 }
@@ -26,9 +26,13 @@ namespace distributor {
 class NodeInfoTest : public CppUnit::TestFixture {
     CPPUNIT_TEST_SUITE(NodeInfoTest);
     CPPUNIT_TEST(testSimple);
+    CPPUNIT_TEST(testConcurrencyLimitAdaptsToLatency);
+    CPPUNIT_TEST(testBackOffHalvesConcurrencyLimit);
     CPPUNIT_TEST_SUITE_END();
 public:
     void testSimple();
+    void testConcurrencyLimitAdaptsToLatency();
+    void testBackOffHalvesConcurrencyLimit();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(NodeInfoTest);
@@ -77,6 +81,57 @@ NodeInfoTest::testSimple()
 
 }
 
+void
+NodeInfoTest::testConcurrencyLimitAdaptsToLatency()
+{
+    framework::defaultimplementation::FakeClock clock;
+    NodeInfo info(clock);
+    info.setConcurrencyLimitBounds(4, 64);
+    CPPUNIT_ASSERT_EQUAL(64u, info.getConcurrencyLimit(2));
+
+    for (int i = 0; i < 100; ++i) {
+        info.addLatencySample(2, std::chrono::milliseconds(10));
+    }
+    CPPUNIT_ASSERT_EQUAL(64u, info.getConcurrencyLimit(2));
+
+    // A node becoming much slower than its baseline gets a lower limit,
+    // while other nodes are left alone.
+    for (int i = 0; i < 200; ++i) {
+        info.addLatencySample(2, std::chrono::milliseconds(200));
+        info.addLatencySample(3, std::chrono::milliseconds(10));
+    }
+    CPPUNIT_ASSERT(info.getConcurrencyLimit(2) < 16u);
+    CPPUNIT_ASSERT_EQUAL(64u, info.getConcurrencyLimit(3));
+
+    for (uint32_t i = 0; i < info.getConcurrencyLimit(2); ++i) {
+        info.incPending(2);
+    }
+    CPPUNIT_ASSERT(info.isSaturated(2));
+    CPPUNIT_ASSERT(!info.isSaturated(3));
+    info.decPending(2);
+    CPPUNIT_ASSERT(!info.isSaturated(2));
+
+    // And recovers once latencies are back to normal.
+    for (int i = 0; i < 500; ++i) {
+        info.addLatencySample(2, std::chrono::milliseconds(10));
+    }
+    CPPUNIT_ASSERT_EQUAL(64u, info.getConcurrencyLimit(2));
+}
+
+void
+NodeInfoTest::testBackOffHalvesConcurrencyLimit()
+{
+    framework::defaultimplementation::FakeClock clock;
+    NodeInfo info(clock);
+    info.setConcurrencyLimitBounds(10, 100);
+    info.backOff(1);
+    CPPUNIT_ASSERT_EQUAL(50u, info.getConcurrencyLimit(1));
+    info.backOff(1);
+    info.backOff(1);
+    info.backOff(1);
+    CPPUNIT_ASSERT_EQUAL(10u, info.getConcurrencyLimit(1));
+}
+
 }
 
 }
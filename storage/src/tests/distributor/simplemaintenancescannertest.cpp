@@ -23,6 +23,9 @@ class SimpleMaintenanceScannerTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(testPendingMaintenanceOperationStatistics);
     CPPUNIT_TEST(perNodeMaintenanceStatsAreTracked);
     CPPUNIT_TEST(testReset);
+    CPPUNIT_TEST(queued_buckets_are_prioritized_without_scanning);
+    CPPUNIT_TEST(queued_bucket_is_only_checked_once);
+    CPPUNIT_TEST(full_queue_drops_buckets_until_reset);
     CPPUNIT_TEST_SUITE_END();
 
     using PendingStats = SimpleMaintenanceScanner::PendingMaintenanceStats;
@@ -48,6 +51,9 @@ public:
     void testPendingMaintenanceOperationStatistics();
     void perNodeMaintenanceStatsAreTracked();
     void testReset();
+    void queued_buckets_are_prioritized_without_scanning();
+    void queued_bucket_is_only_checked_once();
+    void full_queue_drops_buckets_until_reset();
 
     void setUp() override;
 };
@@ -241,4 +247,60 @@ SimpleMaintenanceScannerTest::perNodeMaintenanceStatsAreTracked()
     }
 }
 
+void
+SimpleMaintenanceScannerTest::queued_buckets_are_prioritized_without_scanning()
+{
+    addBucketToDb(1);
+    addBucketToDb(2);
+    addBucketToDb(3);
+    _scanner->queueChangedBucket(document::Bucket(makeBucketSpace(), BucketId(16, 3)));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), _scanner->getQueuedBucketCount());
+
+    CPPUNIT_ASSERT_EQUAL(size_t(1), _scanner->checkQueuedBuckets(10));
+    std::string expected("PrioritizedBucket(Bucket(BucketSpace(0x0000000000000001), BucketId(0x4000000000000003)), pri VERY_HIGH)\n");
+    CPPUNIT_ASSERT_EQUAL(expected, _priorityDb->toString());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), _scanner->getQueuedBucketCount());
+    CPPUNIT_ASSERT_EQUAL(size_t(0), _scanner->checkQueuedBuckets(10));
+
+    // Queued checks are not part of the stats for a complete scan
+    NodeMaintenanceStats emptyStats;
+    CPPUNIT_ASSERT_EQUAL(emptyStats, _scanner->getPendingMaintenanceStats().perNodeStats.forNode(1, makeBucketSpace()));
+}
+
+void
+SimpleMaintenanceScannerTest::queued_bucket_is_only_checked_once()
+{
+    addBucketToDb(1);
+    addBucketToDb(2);
+    document::Bucket bucket1(makeBucketSpace(), BucketId(16, 1));
+    document::Bucket bucket2(makeBucketSpace(), BucketId(16, 2));
+    _scanner->queueChangedBucket(bucket1);
+    _scanner->queueChangedBucket(bucket2);
+    _scanner->queueChangedBucket(bucket1);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), _scanner->getQueuedBucketCount());
+
+    CPPUNIT_ASSERT_EQUAL(size_t(1), _scanner->checkQueuedBuckets(1));
+    std::string expected("PrioritizedBucket(Bucket(BucketSpace(0x0000000000000001), BucketId(0x4000000000000001)), pri VERY_HIGH)\n");
+    CPPUNIT_ASSERT_EQUAL(expected, _priorityDb->toString());
+    // Bucket is queued again once it has been checked
+    _scanner->queueChangedBucket(bucket1);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), _scanner->checkQueuedBuckets(10));
+}
+
+void
+SimpleMaintenanceScannerTest::full_queue_drops_buckets_until_reset()
+{
+    _scanner.reset(new SimpleMaintenanceScanner(*_priorityDb, *_priorityGenerator, *_bucketSpaceRepo, 2));
+    _scanner->queueChangedBucket(document::Bucket(makeBucketSpace(), BucketId(16, 1)));
+    _scanner->queueChangedBucket(document::Bucket(makeBucketSpace(), BucketId(16, 2)));
+    CPPUNIT_ASSERT(!_scanner->queueOverflowed());
+    _scanner->queueChangedBucket(document::Bucket(makeBucketSpace(), BucketId(16, 3)));
+    CPPUNIT_ASSERT(_scanner->queueOverflowed());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), _scanner->getQueuedBucketCount());
+
+    _scanner->reset();
+    CPPUNIT_ASSERT(!_scanner->queueOverflowed());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), _scanner->getQueuedBucketCount());
+}
+
 }
@@ -65,6 +65,9 @@ class TwoPhaseUpdateOperationTest : public CppUnit::TestFixture,
     CPPUNIT_TEST(testSafePathConditionWithMissingDocFailsWithTasError);
     CPPUNIT_TEST(testFastPathCloseEdgeSendsCorrectReply);
     CPPUNIT_TEST(testSafePathCloseEdgeSendsCorrectReply);
+    CPPUNIT_TEST(testSafePathConsistentMetadataRestartsWithFastPath);
+    CPPUNIT_TEST(testSafePathInconsistentMetadataFetchesFullDocuments);
+    CPPUNIT_TEST(testSafePathConditionSkipsMetadataFetchPhase);
     CPPUNIT_TEST_SUITE_END();
 
     document::TestDocRepo _testRepo;
@@ -101,11 +104,15 @@ protected:
     void testSafePathConditionWithMissingDocFailsWithTasError();
     void testFastPathCloseEdgeSendsCorrectReply();
     void testSafePathCloseEdgeSendsCorrectReply();
+    void testSafePathConsistentMetadataRestartsWithFastPath();
+    void testSafePathInconsistentMetadataFetchesFullDocuments();
+    void testSafePathConditionSkipsMetadataFetchPhase();
 
     void checkMessageSettingsPropagatedTo(
         const api::StorageCommand::SP& msg) const;
 
     std::string getUpdatedValueFromLastPut(MessageSenderStub&);
+    static std::string getFieldSetOfGet(const MessageSenderStub&, uint32_t index);
 public:
     void setUp() override {
         _repo = _testRepo.getTypeRepoSp();
@@ -1186,4 +1193,85 @@ TwoPhaseUpdateOperationTest::testSafePathCloseEdgeSendsCorrectReply()
 // has pending messages (e.g. n-of-m case).
 
 } // distributor
+std::string
+TwoPhaseUpdateOperationTest::getFieldSetOfGet(const MessageSenderStub& sender, uint32_t index)
+{
+    return dynamic_cast<const api::GetCommand&>(*sender.commands.at(index)).getFieldSet();
+}
+
+void
+TwoPhaseUpdateOperationTest::testSafePathConsistentMetadataRestartsWithFastPath()
+{
+    setupDistributor(3, 3, "storage:3 distributor:1");
+    getConfig().setEnableMetadataOnlyFetchPhaseForInconsistentUpdates(true);
+    std::shared_ptr<TwoPhaseUpdateOperation> cb(
+            sendUpdate("0=1/2/3,1=1/2/3,2=2/3/4"));
+
+    MessageSenderStub sender;
+    cb->start(sender, framework::MilliSecTime(0));
+
+    CPPUNIT_ASSERT_EQUAL(std::string("Get => 0,Get => 2"), sender.getCommands(true));
+    CPPUNIT_ASSERT_EQUAL(std::string("[none]"), getFieldSetOfGet(sender, 0));
+    CPPUNIT_ASSERT_EQUAL(std::string("[none]"), getFieldSetOfGet(sender, 1));
+    replyToGet(*cb, sender, 0, 70);
+    replyToGet(*cb, sender, 1, 70);
+
+    // Replicas agree on the document, so the update is sent to all of them
+    // instead of fetching and writing back the whole document.
+    CPPUNIT_ASSERT_EQUAL(size_t(5), sender.commands.size());
+    for (uint32_t i = 2; i < 5; ++i) {
+        CPPUNIT_ASSERT(dynamic_cast<const api::UpdateCommand*>(sender.commands[i].get()) != nullptr);
+    }
+    replyToMessage(*cb, sender, 2, 70);
+    replyToMessage(*cb, sender, 3, 70);
+    CPPUNIT_ASSERT(sender.replies.empty());
+    replyToMessage(*cb, sender, 4, 70);
+
+    CPPUNIT_ASSERT_EQUAL(
+            std::string("UpdateReply(doc:test:test, BucketId(0x0000000000000000), "
+                        "timestamp 0, timestamp of updated doc: 70) ReturnCode(NONE)"),
+            sender.getLastReply(true));
+}
+
+void
+TwoPhaseUpdateOperationTest::testSafePathInconsistentMetadataFetchesFullDocuments()
+{
+    setupDistributor(3, 3, "storage:3 distributor:1");
+    getConfig().setEnableMetadataOnlyFetchPhaseForInconsistentUpdates(true);
+    std::shared_ptr<TwoPhaseUpdateOperation> cb(
+            sendUpdate("0=1/2/3,1=1/2/3,2=2/3/4"));
+
+    MessageSenderStub sender;
+    cb->start(sender, framework::MilliSecTime(0));
+
+    CPPUNIT_ASSERT_EQUAL(std::string("Get => 0,Get => 2"), sender.getCommands(true));
+    replyToGet(*cb, sender, 0, 50);
+    replyToGet(*cb, sender, 1, 70);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("Get => 0,Get => 2,Get => 0,Get => 2"), sender.getCommands(true));
+    CPPUNIT_ASSERT_EQUAL(std::string("[all]"), getFieldSetOfGet(sender, 2));
+    CPPUNIT_ASSERT_EQUAL(std::string("[all]"), getFieldSetOfGet(sender, 3));
+    replyToGet(*cb, sender, 2, 50);
+    replyToGet(*cb, sender, 3, 70);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("Put => 1,Put => 0,Put => 2"), sender.getCommands(true, false, 4));
+    CPPUNIT_ASSERT_EQUAL(std::string("80"), getUpdatedValueFromLastPut(sender));
+}
+
+void
+TwoPhaseUpdateOperationTest::testSafePathConditionSkipsMetadataFetchPhase()
+{
+    setupDistributor(3, 3, "storage:3 distributor:1");
+    getConfig().setEnableMetadataOnlyFetchPhaseForInconsistentUpdates(true);
+    std::shared_ptr<TwoPhaseUpdateOperation> cb(
+            sendUpdate("0=1/2/3,1=1/2/3,2=2/3/4",
+                       UpdateOptions().condition("testdoctype1.headerval==120")));
+
+    MessageSenderStub sender;
+    cb->start(sender, framework::MilliSecTime(0));
+
+    CPPUNIT_ASSERT_EQUAL(std::string("Get => 0,Get => 2"), sender.getCommands(true));
+    CPPUNIT_ASSERT_EQUAL(std::string("[all]"), getFieldSetOfGet(sender, 0));
+}
+
 } // storage
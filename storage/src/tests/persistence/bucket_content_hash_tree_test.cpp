@@ -0,0 +1,127 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vdstestlib/cppunit/macros.h>
+#include <vespa/storage/persistence/bucket_content_hash_tree.h>
+#include <vespa/storage/persistence/mergehandler.h>
+#include <algorithm>
+
+namespace storage {
+
+struct BucketContentHashTreeTest : public CppUnit::TestFixture {
+    using Entry = BucketContentHashTree::Entry;
+    using Range = BucketContentHashTree::Range;
+
+    void testSplitCoversRange();
+    void testIdenticalReplicasHaveNoDifferingRanges();
+    void testDifferingRangesContainAllDifferences();
+    void testRemoveFlagIsPartOfContent();
+
+    CPPUNIT_TEST_SUITE(BucketContentHashTreeTest);
+    CPPUNIT_TEST(testSplitCoversRange);
+    CPPUNIT_TEST(testIdenticalReplicasHaveNoDifferingRanges);
+    CPPUNIT_TEST(testDifferingRangesContainAllDifferences);
+    CPPUNIT_TEST(testRemoveFlagIsPartOfContent);
+    CPPUNIT_TEST_SUITE_END();
+
+    static Entry makeEntry(api::Timestamp timestamp, bool removed = false) {
+        Entry entry;
+        entry._timestamp = timestamp;
+        entry._flags = MergeHandler::IN_USE | (removed ? MergeHandler::DELETED : 0);
+        entry._hasMask = 1;
+        return entry;
+    }
+
+    static std::vector<Entry> makeEntries(size_t count) {
+        std::vector<Entry> entries;
+        for (size_t i = 0; i < count; ++i) {
+            entries.push_back(makeEntry(1500000000000000ULL + i * 1000));
+        }
+        return entries;
+    }
+
+    static bool contains(const std::vector<Entry>& entries, const Entry& wanted) {
+        return std::any_of(entries.begin(), entries.end(), [&](const Entry& entry) {
+            return ((entry._timestamp == wanted._timestamp) && (entry._flags == wanted._flags));
+        });
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BucketContentHashTreeTest);
+
+void
+BucketContentHashTreeTest::testSplitCoversRange()
+{
+    for (const Range& range : { BucketContentHashTree::rootRange(), Range(10, 25), Range(7, 7) }) {
+        std::vector<Range> children = BucketContentHashTree::split(range, 16);
+        CPPUNIT_ASSERT(!children.empty());
+        CPPUNIT_ASSERT(children.size() <= 16u);
+        CPPUNIT_ASSERT_EQUAL(range.first, children.front().first);
+        CPPUNIT_ASSERT_EQUAL(range.last, children.back().last);
+        for (size_t i = 1; i < children.size(); ++i) {
+            CPPUNIT_ASSERT_EQUAL(children[i - 1].last + 1, children[i].first);
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(16), BucketContentHashTree::split(BucketContentHashTree::rootRange(), 16).size());
+}
+
+void
+BucketContentHashTreeTest::testIdenticalReplicasHaveNoDifferingRanges()
+{
+    std::vector<Entry> entries(makeEntries(10000));
+    std::vector<Entry> reversed(entries.rbegin(), entries.rend());
+    BucketContentHashTree a(entries);
+    BucketContentHashTree b(reversed);
+    CPPUNIT_ASSERT_EQUAL(a.hash(BucketContentHashTree::rootRange()), b.hash(BucketContentHashTree::rootRange()));
+    CPPUNIT_ASSERT(BucketContentHashTree::findDifferingRanges(a, b, 16).empty());
+}
+
+void
+BucketContentHashTreeTest::testDifferingRangesContainAllDifferences()
+{
+    std::vector<Entry> entriesA(makeEntries(100000));
+    std::vector<Entry> entriesB;
+    std::vector<Entry> onlyInA;
+    for (size_t i = 0; i < entriesA.size(); ++i) {
+        if ((i % 25000) == 7) {
+            onlyInA.push_back(entriesA[i]);
+        } else {
+            entriesB.push_back(entriesA[i]);
+        }
+    }
+    Entry onlyInB(makeEntry(1500000000000000ULL + 55555));
+    entriesB.push_back(onlyInB);
+    std::sort(entriesB.begin(), entriesB.end());
+
+    BucketContentHashTree a(entriesA);
+    BucketContentHashTree b(entriesB);
+    std::vector<Range> ranges(BucketContentHashTree::findDifferingRanges(a, b, 16));
+    CPPUNIT_ASSERT(!ranges.empty());
+
+    std::vector<Entry> diffA(BucketContentHashTree::entriesInRanges(entriesA, ranges));
+    std::vector<Entry> diffB(BucketContentHashTree::entriesInRanges(entriesB, ranges));
+    for (const Entry& entry : onlyInA) {
+        CPPUNIT_ASSERT(contains(diffA, entry));
+    }
+    CPPUNIT_ASSERT(contains(diffB, onlyInB));
+    // Only a small fraction of the bucket needs to be diffed.
+    CPPUNIT_ASSERT(diffA.size() <= ranges.size() * 16);
+    CPPUNIT_ASSERT(diffA.size() < entriesA.size() / 100);
+}
+
+void
+BucketContentHashTreeTest::testRemoveFlagIsPartOfContent()
+{
+    std::vector<Entry> entriesA(makeEntries(1000));
+    std::vector<Entry> entriesB(entriesA);
+    entriesB[500] = makeEntry(entriesB[500]._timestamp, true);
+
+    BucketContentHashTree a(entriesA);
+    BucketContentHashTree b(entriesB);
+    std::vector<Range> ranges(BucketContentHashTree::findDifferingRanges(a, b, 1));
+    CPPUNIT_ASSERT_EQUAL(size_t(1), ranges.size());
+    CPPUNIT_ASSERT(ranges[0].first <= entriesA[500]._timestamp);
+    CPPUNIT_ASSERT(ranges[0].last >= entriesA[500]._timestamp);
+    CPPUNIT_ASSERT_EQUAL(1u, a.count(ranges[0]));
+}
+
+}
@@ -0,0 +1,80 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vdstestlib/cppunit/macros.h>
+#include <vespa/storage/persistence/filestorage/filestorlatencymetrics.h>
+#include <vespa/storageapi/message/persistence.h>
+#include <vespa/document/test/make_document_bucket.h>
+
+using document::test::makeDocumentBucket;
+
+namespace storage {
+
+struct FileStorLatencyMetricsTest : public CppUnit::TestFixture {
+    void bucket_bounds_cover_recorded_latency();
+    void percentiles_are_taken_from_drained_counts();
+    void update_adds_percentiles_and_resets_histogram();
+    void messages_are_mapped_to_type_and_priority_band();
+
+    CPPUNIT_TEST_SUITE(FileStorLatencyMetricsTest);
+    CPPUNIT_TEST(bucket_bounds_cover_recorded_latency);
+    CPPUNIT_TEST(percentiles_are_taken_from_drained_counts);
+    CPPUNIT_TEST(update_adds_percentiles_and_resets_histogram);
+    CPPUNIT_TEST(messages_are_mapped_to_type_and_priority_band);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FileStorLatencyMetricsTest);
+
+void FileStorLatencyMetricsTest::bucket_bounds_cover_recorded_latency() {
+    for (double ms : {0.001, 0.007, 0.009, 0.1, 1.0, 3.3, 17.0, 250.0, 9999.0}) {
+        uint32_t bucket = LatencyHistogram::bucketOf(ms);
+        uint64_t us = static_cast<uint64_t>(ms * 1000.0);
+        CPPUNIT_ASSERT(LatencyHistogram::lowerBound(bucket) <= us);
+        CPPUNIT_ASSERT(us < LatencyHistogram::lowerBound(bucket + 1));
+    }
+    CPPUNIT_ASSERT_EQUAL(0u, LatencyHistogram::bucketOf(-1.0));
+    CPPUNIT_ASSERT_EQUAL(LatencyHistogram::NumBuckets - 1, LatencyHistogram::bucketOf(1e12));
+}
+
+void FileStorLatencyMetricsTest::percentiles_are_taken_from_drained_counts() {
+    LatencyHistogram histogram;
+    for (uint32_t i = 0; i < 990; ++i) {
+        histogram.record(1.0);
+    }
+    for (uint32_t i = 0; i < 10; ++i) {
+        histogram.record(100.0);
+    }
+    LatencyHistogram::Counts counts;
+    uint64_t total = histogram.drain(counts);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(1000), total);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, LatencyHistogram::percentile(counts, total, 0.5), 0.125);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, LatencyHistogram::percentile(counts, total, 0.99), 0.125);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(100.0, LatencyHistogram::percentile(counts, total, 0.999), 12.5);
+    CPPUNIT_ASSERT_EQUAL(uint64_t(0), histogram.drain(counts));
+}
+
+void FileStorLatencyMetricsTest::update_adds_percentiles_and_resets_histogram() {
+    LatencyPercentileMetrics metrics("test", "", nullptr);
+    metrics.update();
+    CPPUNIT_ASSERT_EQUAL(0.0, metrics.p50.getCount());
+    metrics.record(2.0);
+    metrics.record(2.0);
+    metrics.update();
+    CPPUNIT_ASSERT_EQUAL(1.0, metrics.p50.getCount());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, metrics.p50.getLast(), 0.25);
+    metrics.update();
+    CPPUNIT_ASSERT_EQUAL(1.0, metrics.p999.getCount());
+}
+
+void FileStorLatencyMetricsTest::messages_are_mapped_to_type_and_priority_band() {
+    api::GetCommand get(makeDocumentBucket(document::BucketId(16, 1)), document::DocumentId("id:ns:type::1"), "[all]");
+    CPPUNIT_ASSERT(FileStorLatencyMetrics::OperationType::GET == FileStorLatencyMetrics::operationTypeOf(get));
+    get.setPriority(api::StorageMessage::VERYHIGH);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), FileStorLatencyMetrics::priorityBandOf(get));
+    get.setPriority(api::StorageMessage::NORMAL);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), FileStorLatencyMetrics::priorityBandOf(get));
+    get.setPriority(255);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), FileStorLatencyMetrics::priorityBandOf(get));
+}
+
+}
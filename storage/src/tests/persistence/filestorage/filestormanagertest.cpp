@@ -74,6 +74,7 @@ struct FileStorManagerTest : public CppUnit::TestFixture {
     void testFlush();
     void testRemapSplit();
     void testHandlerPriority();
+    void testHandlerSharesThreadBetweenOperationClasses();
     void testHandlerMulti();
     void testHandlerTimeout();
     void testHandlerPause();
@@ -112,6 +113,7 @@ struct FileStorManagerTest : public CppUnit::TestFixture {
     CPPUNIT_TEST(testFlush);
     CPPUNIT_TEST(testRemapSplit);
     CPPUNIT_TEST(testHandlerPriority);
+    CPPUNIT_TEST(testHandlerSharesThreadBetweenOperationClasses);
     CPPUNIT_TEST(testHandlerMulti);
     CPPUNIT_TEST(testHandlerTimeout);
     CPPUNIT_TEST(testHandlerPause);
@@ -663,6 +665,53 @@ FileStorManagerTest::testHandlerPriority()
     CPPUNIT_ASSERT_EQUAL(75, (int)filestorHandler.getNextMessage(0, stripeId).second->getPriority());
 }
 
+void
+FileStorManagerTest::testHandlerSharesThreadBetweenOperationClasses()
+{
+    TestName testName("testHandlerSharesThreadBetweenOperationClasses");
+    DummyStorageLink top;
+    DummyStorageLink *dummyManager;
+    top.push_back(std::unique_ptr<StorageLink>(
+                          dummyManager = new DummyStorageLink));
+    top.open();
+    ForwardingMessageSender messageSender(*dummyManager);
+
+    documentapi::LoadTypeSet loadTypes("raw:");
+    FileStorMetrics metrics(loadTypes.getMetricLoadTypes());
+    metrics.initDiskMetrics(_node->getPartitions().size(), loadTypes.getMetricLoadTypes(), 1, 1);
+
+    FileStorHandler filestorHandler(messageSender, metrics, _node->getPartitions(), _node->getComponentRegister());
+    filestorHandler.setGetNextMessageTimeout(50);
+    uint32_t stripeId = filestorHandler.getNextStripeId(0);
+
+    Document::SP doc(createDocument("some content", "userdoc:footype:1234:bar").release());
+    auto address = std::make_shared<api::StorageMessageAddress>("storage", lib::NodeType::STORAGE, 3);
+    // A backlog of maintenance operations with a better priority than the get.
+    for (uint32_t i = 1; i <= 8; i++) {
+        auto cmd = std::make_shared<api::CreateBucketCommand>(makeDocumentBucket(document::BucketId(16, i)));
+        cmd->setAddress(*address);
+        cmd->setPriority(0);
+        filestorHandler.schedule(cmd, 0);
+    }
+    {
+        auto cmd = std::make_shared<api::GetCommand>(makeDocumentBucket(document::BucketId(16, 100)),
+                                                     doc->getId(), "[all]");
+        cmd->setAddress(*address);
+        cmd->setPriority(200);
+        filestorHandler.schedule(cmd, 0);
+    }
+
+    // Keep the bucket locks, as a busy persistence thread would.
+    std::vector<FileStorHandler::LockedMessage> locks;
+    for (uint32_t i = 0; i < 3; ++i) {
+        locks.push_back(filestorHandler.getNextMessage(0, stripeId));
+        CPPUNIT_ASSERT(locks.back().second.get());
+    }
+    CPPUNIT_ASSERT_EQUAL(api::MessageType::CREATEBUCKET_ID, locks[0].second->getType().getId());
+    CPPUNIT_ASSERT_EQUAL(api::MessageType::GET_ID, locks[1].second->getType().getId());
+    CPPUNIT_ASSERT_EQUAL(api::MessageType::CREATEBUCKET_ID, locks[2].second->getType().getId());
+}
+
 class MessagePusherThread : public document::Runnable
 {
 public:
@@ -19,6 +19,9 @@
 #include <vespa/documentapi/messagebus/messages/removedocumentmessage.h>
 #include <vespa/documentapi/messagebus/messages/visitor.h>
 #include <vespa/config/common/exceptions.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/compressor.h>
 #include <optional>
 #include <thread>
 #include <chrono>
@@ -56,6 +59,7 @@ private:
     CPPUNIT_TEST(testVisitorQueingZeroQueueSize);
     CPPUNIT_TEST(testHitCounter);
     CPPUNIT_TEST(testStatusPage);
+    CPPUNIT_TEST(testExportVisitorSendsCompressedBatches);
     CPPUNIT_TEST_SUITE_END();
 
     static uint32_t docCount;
@@ -106,6 +110,7 @@ public:
     void testVisitorQueingZeroQueueSize();
     void testHitCounter();
     void testStatusPage();
+    void testExportVisitorSendsCompressedBatches();
 };
 
 uint32_t VisitorManagerTest::docCount = 10;
@@ -1125,4 +1130,63 @@ VisitorManagerTest::testStatusPage() {
     }
 }
 
+void
+VisitorManagerTest::testExportVisitorSendsCompressedBatches()
+{
+    initializeTest();
+    api::StorageMessageAddress address("storage", lib::NodeType::STORAGE, 0);
+    auto cmd = std::make_shared<api::CreateVisitorCommand>(makeBucketSpace(), "ExportVisitor", "testvis", "");
+    for (uint32_t i=0; i<10; ++i) {
+        cmd->addBucketToBeVisited(document::BucketId(16, i));
+    }
+    // Cut a batch after every document, so each bucket gives one batch and a completion marker.
+    cmd->getParameters().set("batchsize", 1);
+    cmd->setAddress(address);
+    _top->sendDown(cmd);
+
+    TestVisitorMessageSession& session = getSession(0);
+    std::vector<document::Document::SP> docs;
+    uint32_t completedBuckets = 0;
+    for (uint32_t i = 0; i < 20; i++) {
+        session.waitForMessages(i + 1);
+        mbus::Reply::UP reply;
+        {
+            vespalib::MonitorGuard guard(session.getMonitor());
+            auto* msg = dynamic_cast<documentapi::MapVisitorMessage*>(session.sentMessages[i].get());
+            CPPUNIT_ASSERT(msg != nullptr);
+            const vdslib::Parameters& data(msg->getData());
+            uint32_t documents = data.get("documents", uint32_t(0));
+            if (data.get("bucketcompleted") == "true") {
+                ++completedBuckets;
+                CPPUNIT_ASSERT_EQUAL(0u, documents);
+            } else {
+                CPPUNIT_ASSERT_EQUAL(1u, documents);
+            }
+            vespalib::stringref compressed;
+            CPPUNIT_ASSERT(data.get("data", compressed));
+            vespalib::DataBuffer uncompressed;
+            vespalib::compression::decompress(
+                    vespalib::compression::CompressionConfig::toType(data.get("compression", uint32_t(0))),
+                    data.get("uncompressedsize", uint64_t(0)),
+                    vespalib::ConstBufferRef(compressed.data(), compressed.size()),
+                    uncompressed, false);
+            CPPUNIT_ASSERT_EQUAL(size_t(data.get("uncompressedsize", uint64_t(0))), uncompressed.getDataLen());
+            vespalib::nbostream stream(uncompressed.getData(), uncompressed.getDataLen());
+            for (uint32_t j = 0; j < documents; ++j) {
+                docs.push_back(std::make_shared<document::Document>(*_node->getTypeRepo(), stream));
+            }
+            CPPUNIT_ASSERT_EQUAL(size_t(0), stream.size());
+
+            reply = msg->createReply();
+            reply->swapState(*session.sentMessages[i]);
+            reply->setMessage(mbus::Message::UP(session.sentMessages[i].release()));
+        }
+        session.reply(std::move(reply));
+    }
+
+    verifyCreateVisitorReply(api::ReturnCode::OK, int(docs.size()));
+    CPPUNIT_ASSERT_EQUAL(10u, completedBuckets);
+    CPPUNIT_ASSERT_EQUAL(docCount, getMatchingDocuments(docs));
+}
+
 }
@@ -0,0 +1,355 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "btree_bucket_database.h"
+#include <vespa/searchlib/btree/btreebuilder.h>
+#include <vespa/searchlib/btree/btreenodeallocator.hpp>
+#include <vespa/searchlib/btree/btreenode.hpp>
+#include <vespa/searchlib/btree/btreenodestore.hpp>
+#include <vespa/searchlib/btree/btreeiterator.hpp>
+#include <vespa/searchlib/btree/btreeroot.hpp>
+#include <vespa/searchlib/btree/btreebuilder.hpp>
+#include <vespa/searchlib/btree/btree.hpp>
+#include <vespa/searchlib/btree/btreestore.hpp>
+#include <vespa/searchlib/datastore/array_store.hpp>
+#include <vespa/vespalib/util/alloc.h>
+#include <ostream>
+#include <cassert>
+
+/*
+ * Buckets in our tree are represented by their 64-bit numeric key, in what's
+ * known as "reversed bit order with appended used-bits" form. I.e. a bucket ID
+ * (16, 0xbeef) is represented as 0xfeeb << 48 | 16. The used-bits part places
+ * parent buckets before their children, and keeps a bucket's children in a
+ * contiguous key range directly after it. The sort order is identical to an
+ * in-order traversal of the bucket bit tree used by MapBucketDatabase.
+ */
+
+namespace storage {
+
+using document::BucketId;
+using search::datastore::EntryRef;
+using vespalib::ConstArrayRef;
+
+namespace {
+
+constexpr size_t MAX_SMALL_REPLICA_ARRAY_SIZE = 16;
+constexpr size_t SMALL_MEMORY_PAGE_SIZE = 4 * 1024;
+constexpr size_t MIN_NUM_ARRAYS_FOR_NEW_BUFFER = 8 * 1024;
+constexpr float ALLOC_GROW_FACTOR = 0.2;
+
+search::datastore::ArrayStoreConfig make_default_array_store_config() {
+    return BTreeBucketDatabase::ReplicaStore::optimizedConfigForHugePage(
+            MAX_SMALL_REPLICA_ARRAY_SIZE,
+            vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE,
+            SMALL_MEMORY_PAGE_SIZE,
+            MIN_NUM_ARRAYS_FOR_NEW_BUFFER,
+            ALLOC_GROW_FACTOR);
+}
+
+EntryRef entry_ref_from_value(uint64_t value) {
+    return EntryRef(value & 0xffffffffULL);
+}
+
+uint32_t gc_timestamp_from_value(uint64_t value) {
+    return static_cast<uint32_t>(value >> 32u);
+}
+
+uint64_t value_from(uint32_t gc_timestamp, EntryRef ref) {
+    return ((uint64_t(gc_timestamp) << 32u) | ref.ref());
+}
+
+BucketId sibling_of(const BucketId& bucket, uint32_t bit) {
+    return BucketId(bit + 1, bucket.getRawId() ^ (uint64_t(1) << bit)).stripUnused();
+}
+
+/**
+ * Appends all parents of the given bucket (including the bucket itself)
+ * present in the tree view. Parent keys are strictly increasing with the
+ * number of used bits, so a single forward seeking iterator is used.
+ */
+template <typename TreeView, typename EntryFactory>
+void find_parents_and_self(const TreeView& view, const BucketId& bucket,
+                           const EntryFactory& make_entry, std::vector<BucketDatabase::Entry>& entries)
+{
+    const uint32_t used_bits = bucket.getUsedBits();
+    if (used_bits == 0) {
+        return;
+    }
+    auto iter = view.lowerBound(BucketId(1, bucket.getRawId()).toKey());
+    for (uint32_t bits = 1; (bits <= used_bits) && iter.valid(); ++bits) {
+        const uint64_t candidate = BucketId(bits, bucket.getRawId()).toKey();
+        if (iter.getKey() < candidate) {
+            iter.seek(candidate);
+            if (!iter.valid()) {
+                break;
+            }
+        }
+        if (iter.getKey() == candidate) {
+            entries.emplace_back(make_entry(iter.getKey(), iter.getData()));
+        }
+    }
+}
+
+}
+
+BTreeBucketDatabase::BTreeBucketDatabase()
+    : _tree(),
+      _store(make_default_array_store_config()),
+      _generation_handler()
+{
+}
+
+BTreeBucketDatabase::~BTreeBucketDatabase() = default;
+
+void
+BTreeBucketDatabase::commit_tree_changes()
+{
+    _tree.getAllocator().freeze();
+
+    auto current_gen = _generation_handler.getCurrentGeneration();
+    _store.transferHoldLists(current_gen);
+    _tree.getAllocator().transferHoldLists(current_gen);
+
+    _generation_handler.incGeneration();
+
+    auto used_gen = _generation_handler.getFirstUsedGeneration();
+    _store.trimHoldLists(used_gen);
+    _tree.getAllocator().trimHoldLists(used_gen);
+}
+
+BucketDatabase::Entry
+BTreeBucketDatabase::entry_from_value(uint64_t key, uint64_t value) const
+{
+    const auto replicas_ref = _store.get(entry_ref_from_value(value));
+    std::vector<BucketCopy> replicas(replicas_ref.begin(), replicas_ref.end());
+    return Entry(BucketId(BucketId::keyToBucketId(key)),
+                 BucketInfo(gc_timestamp_from_value(value), std::move(replicas)));
+}
+
+uint64_t
+BTreeBucketDatabase::value_from_entry(const Entry& entry)
+{
+    const auto& replicas = entry->getRawNodes();
+    const auto ref = _store.add(ConstArrayRef<BucketCopy>(replicas.data(), replicas.size()));
+    return value_from(entry->getLastGarbageCollectionTime(), ref);
+}
+
+void
+BTreeBucketDatabase::hold_value(uint64_t value)
+{
+    _store.remove(entry_ref_from_value(value));
+}
+
+BucketDatabase::Entry
+BTreeBucketDatabase::get(const BucketId& bucket) const
+{
+    auto iter = _tree.find(bucket.toKey());
+    if (!iter.valid()) {
+        return Entry::createInvalid();
+    }
+    return entry_from_value(iter.getKey(), iter.getData());
+}
+
+void
+BTreeBucketDatabase::remove(const BucketId& bucket)
+{
+    auto iter = _tree.find(bucket.toKey());
+    if (!iter.valid()) {
+        return;
+    }
+    hold_value(iter.getData());
+    _tree.remove(iter);
+    commit_tree_changes();
+}
+
+void
+BTreeBucketDatabase::update(const Entry& newEntry)
+{
+    assert(newEntry.valid());
+    const uint64_t key = newEntry.getBucketId().toKey();
+    const uint64_t new_value = value_from_entry(newEntry);
+    auto iter = _tree.lowerBound(key);
+    if (iter.valid() && (iter.getKey() == key)) {
+        // Copy-on-write the path to the leaf so frozen readers keep seeing
+        // the old value, which is held until no reader can observe it.
+        _tree.thaw(iter);
+        hold_value(iter.getData());
+        iter.writeData(new_value);
+    } else {
+        _tree.insert(iter, key, new_value);
+    }
+    commit_tree_changes();
+}
+
+void
+BTreeBucketDatabase::getParents(const BucketId& childBucket,
+                                std::vector<Entry>& entries) const
+{
+    auto make_entry = [this](uint64_t key, uint64_t value) { return entry_from_value(key, value); };
+    find_parents_and_self(_tree, childBucket, make_entry, entries);
+}
+
+void
+BTreeBucketDatabase::getAll(const BucketId& bucket,
+                            std::vector<Entry>& entries) const
+{
+    getParents(bucket, entries);
+    // All children of the bucket are in the key range directly after it.
+    auto iter = _tree.upperBound(bucket.toKey());
+    for (; iter.valid(); ++iter) {
+        const BucketId candidate(BucketId::keyToBucketId(iter.getKey()));
+        if (!bucket.contains(candidate)) {
+            break;
+        }
+        entries.emplace_back(entry_from_value(iter.getKey(), iter.getData()));
+    }
+}
+
+void
+BTreeBucketDatabase::forEach(EntryProcessor& proc,
+                             const BucketId& after) const
+{
+    for (auto iter = _tree.upperBound(after.toKey()); iter.valid(); ++iter) {
+        if (!proc.process(entry_from_value(iter.getKey(), iter.getData()))) {
+            break;
+        }
+    }
+}
+
+void
+BTreeBucketDatabase::forEach(MutableEntryProcessor& proc,
+                             const BucketId& after)
+{
+    for (auto iter = _tree.upperBound(after.toKey()); iter.valid(); ++iter) {
+        Entry entry(entry_from_value(iter.getKey(), iter.getData()));
+        const BucketInfo original(entry.getBucketInfo());
+        const bool should_continue = proc.process(entry);
+        if (!(entry.getBucketInfo() == original)) {
+            _tree.thaw(iter);
+            hold_value(iter.getData());
+            iter.writeData(value_from_entry(entry));
+        }
+        if (!should_continue) {
+            break;
+        }
+    }
+    commit_tree_changes();
+}
+
+BucketDatabase::Entry
+BTreeBucketDatabase::upperBound(const BucketId& value) const
+{
+    auto iter = _tree.upperBound(value.toKey());
+    if (iter.valid()) {
+        return entry_from_value(iter.getKey(), iter.getData());
+    }
+    return Entry::createInvalid();
+}
+
+uint64_t
+BTreeBucketDatabase::size() const
+{
+    return _tree.size();
+}
+
+void
+BTreeBucketDatabase::clear()
+{
+    for (auto iter = _tree.begin(); iter.valid(); ++iter) {
+        hold_value(iter.getData());
+    }
+    _tree.clear();
+    commit_tree_changes();
+}
+
+bool
+BTreeBucketDatabase::subtree_is_empty(const BucketId& bucket) const
+{
+    auto iter = _tree.lowerBound(bucket.toKey());
+    return (!iter.valid() || !bucket.contains(BucketId(BucketId::keyToBucketId(iter.getKey()))));
+}
+
+/*
+ * Mirrors the bit tree traversal of MapBucketDatabase: walk down the path of
+ * the given bucket for as long as there are buckets below the current prefix,
+ * and remember the deepest level where the sibling branch is non-empty. A new
+ * bucket must be split at least that far to not overlap any existing bucket.
+ */
+BucketId
+BTreeBucketDatabase::getAppropriateBucket(uint16_t minBits, const BucketId& bid)
+{
+    uint32_t split_bits = minBits;
+    for (uint32_t bit = 0; bit < bid.getUsedBits(); ++bit) {
+        if ((bit > 0) && subtree_is_empty(BucketId(bit, bid.getRawId()).stripUnused())) {
+            break;
+        }
+        if (!subtree_is_empty(sibling_of(bid, bit))) {
+            split_bits = std::max(split_bits, bit + 1);
+        }
+    }
+    return BucketId(split_bits, bid.getRawId());
+}
+
+uint32_t
+BTreeBucketDatabase::childCount(const BucketId& bucket) const
+{
+    const uint32_t used_bits = bucket.getUsedBits();
+    if (used_bits >= BucketId::maxNumBits) {
+        return 0;
+    }
+    const BucketId lhs(used_bits + 1, bucket.getRawId() & ~(uint64_t(1) << used_bits));
+    const BucketId rhs(used_bits + 1, bucket.getRawId() | (uint64_t(1) << used_bits));
+    return ((subtree_is_empty(lhs.stripUnused()) ? 0 : 1) +
+            (subtree_is_empty(rhs.stripUnused()) ? 0 : 1));
+}
+
+search::MemoryUsage
+BTreeBucketDatabase::memory_usage() const
+{
+    auto usage = _tree.getMemoryUsage();
+    usage.merge(_store.getMemoryUsage());
+    return usage;
+}
+
+void
+BTreeBucketDatabase::print(std::ostream& out, bool verbose,
+                           const std::string& indent) const
+{
+    (void) indent;
+    if (verbose) {
+        for (auto iter = _tree.begin(); iter.valid(); ++iter) {
+            out << entry_from_value(iter.getKey(), iter.getData()).toString() << "\n";
+        }
+    } else {
+        out << "BTreeBucketDatabase(" << size() << " buckets)";
+    }
+}
+
+BTreeBucketDatabase::ReadGuard::ReadGuard(const BTreeBucketDatabase& db)
+    : _guard(db._generation_handler.takeGuard()),
+      _db(&db),
+      _frozen_view(db._tree.getFrozenView())
+{
+}
+
+BTreeBucketDatabase::ReadGuard::~ReadGuard() = default;
+
+BucketDatabase::Entry
+BTreeBucketDatabase::ReadGuard::get(const BucketId& bucket) const
+{
+    auto iter = _frozen_view.find(bucket.toKey());
+    if (!iter.valid()) {
+        return Entry::createInvalid();
+    }
+    return _db->entry_from_value(iter.getKey(), iter.getData());
+}
+
+void
+BTreeBucketDatabase::ReadGuard::find_parents_and_self(const BucketId& bucket,
+                                                      std::vector<Entry>& entries) const
+{
+    auto make_entry = [this](uint64_t key, uint64_t value) { return _db->entry_from_value(key, value); };
+    storage::find_parents_and_self(_frozen_view, bucket, make_entry, entries);
+}
+
+}
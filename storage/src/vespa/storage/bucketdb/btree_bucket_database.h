@@ -0,0 +1,85 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "bucketdatabase.h"
+#include <vespa/searchlib/btree/btree.h>
+#include <vespa/searchlib/datastore/array_store.h>
+#include <vespa/vespalib/util/generationhandler.h>
+
+namespace storage {
+
+/**
+ * Bucket database implementation built around a B-tree keyed on
+ * bucket keys (bucket IDs with reversed bits), mapping to replica
+ * arrays kept in an array store. B-tree key order is the same as the
+ * in-order traversal of the bucket bit tree, so parent buckets sort
+ * before their children and all children of a bucket are laid out
+ * contiguously after it.
+ *
+ * All mutations are made by a single writer thread. The B-tree and the
+ * array store use generation based hold lists, so readers in other
+ * threads may use a ReadGuard to get a consistent, frozen snapshot of
+ * the database while the writer keeps updating it.
+ */
+class BTreeBucketDatabase : public BucketDatabase {
+public:
+    // Value is (replica array EntryRef | last GC timestamp << 32).
+    using BTree = search::btree::BTree<uint64_t, uint64_t>;
+    using ReplicaStore = search::datastore::ArrayStore<BucketCopy>;
+    using GenerationHandler = vespalib::GenerationHandler;
+
+    /**
+     * Consistent, read only snapshot of the database. The snapshot stays
+     * valid for as long as the guard is alive, regardless of concurrent
+     * updates made through the database itself.
+     */
+    class ReadGuard {
+        GenerationHandler::Guard _guard;
+        const BTreeBucketDatabase* _db;
+        BTree::FrozenView _frozen_view;
+    public:
+        explicit ReadGuard(const BTreeBucketDatabase& db);
+        ReadGuard(ReadGuard&&) = default;
+        ~ReadGuard();
+
+        Entry get(const document::BucketId& bucket) const;
+        void find_parents_and_self(const document::BucketId& bucket,
+                                   std::vector<Entry>& entries) const;
+        uint64_t generation() const noexcept { return _guard.getGeneration(); }
+    };
+
+    BTreeBucketDatabase();
+    ~BTreeBucketDatabase() override;
+
+    Entry get(const document::BucketId& bucket) const override;
+    void remove(const document::BucketId& bucket) override;
+    void getParents(const document::BucketId& childBucket, std::vector<Entry>& entries) const override;
+    void getAll(const document::BucketId& bucket, std::vector<Entry>& entries) const override;
+    void update(const Entry& newEntry) override;
+    void forEach(EntryProcessor&, const document::BucketId& after = document::BucketId()) const override;
+    void forEach(MutableEntryProcessor&, const document::BucketId& after = document::BucketId()) override;
+    uint64_t size() const override;
+    void clear() override;
+
+    uint32_t childCount(const document::BucketId&) const override;
+    Entry upperBound(const document::BucketId& value) const override;
+
+    document::BucketId getAppropriateBucket(uint16_t minBits, const document::BucketId& bid) override;
+    void print(std::ostream& out, bool verbose, const std::string& indent) const override;
+
+    ReadGuard acquire_read_guard() const { return ReadGuard(*this); }
+    search::MemoryUsage memory_usage() const;
+
+private:
+    Entry entry_from_value(uint64_t key, uint64_t value) const;
+    uint64_t value_from_entry(const Entry& entry);
+    void hold_value(uint64_t value);
+    bool subtree_is_empty(const document::BucketId& bucket) const;
+    void commit_tree_changes();
+
+    BTree _tree;
+    ReplicaStore _store;
+    GenerationHandler _generation_handler;
+};
+
+}
@@ -22,6 +22,7 @@ private:
 
 public:
     BucketInfo();
+    BucketInfo(uint32_t lastGarbageCollection, std::vector<BucketCopy> nodes);
     ~BucketInfo();
 
     /**
@@ -127,6 +128,11 @@ public:
      */
     std::vector<uint16_t> getNodes() const;
 
+    /**
+     * Returns the bucket copies of all nodes this entry has.
+     */
+    const std::vector<BucketCopy>& getRawNodes() const noexcept { return _nodes; }
+
     /**
        Returns a reference to the node with the given index in the node
        array. This operation has undefined behaviour if the index given
@@ -14,6 +14,7 @@
  */
 #pragma once
 
+#include <array>
 #include <map>
 #include <vespa/vespalib/util/printable.h>
 #include <vespa/vespalib/stllike/hash_map.h>
@@ -239,9 +240,25 @@ private:
         WaiterMap _map;
     };
 
+    /**
+     * Threads waiting for a locked key wait on one of several condition
+     * variables selected by the key, so that unlocking a key only wakes up
+     * threads that may be waiting for that particular key rather than every
+     * waiter in the map. Stripes are selected by the most significant key
+     * bits, which are the (reversed) least significant bucket bits and thus
+     * evenly distributed.
+     */
+    static constexpr uint32_t CondStripeBits = 6;
+    static constexpr uint32_t CondStripes = (1u << CondStripeBits);
+
+    static uint32_t stripeOf(key_type key) {
+        return static_cast<uint32_t>(key >> (8 * sizeof(key_type) - CondStripeBits));
+    }
+
     Map               _map;
     mutable std::mutex      _lock;
-    std::condition_variable _cond;
+    std::array<std::condition_variable, CondStripes> _conds;
+    std::array<uint32_t, CondStripes> _waitersInStripe;
     LockIdSet         _lockedKeys;
     LockWaiters       _lockWaiters;
 
@@ -253,6 +270,8 @@ private:
                      std::unique_lock<std::mutex> &guard);
     bool handleDecision(key_type& key, mapped_type& val, Decision decision);
     void acquireKey(const LockId & lid, std::unique_lock<std::mutex> &guard);
+    void waitForKey(const LockId & lid, std::unique_lock<std::mutex> &guard);
+    void notifyWaiters(key_type key);
 
     /**
      * Process up to `chunkSize` bucket database entries from--and possibly
@@ -70,7 +70,8 @@ template<typename Map>
 LockableMap<Map>::LockableMap()
     : _map(),
       _lock(),
-      _cond(),
+      _conds(),
+      _waitersInStripe(),
       _lockedKeys(),
       _lockWaiters()
 {}
@@ -110,7 +111,7 @@ LockableMap<Map>::getMemoryUsage() const
 {
     std::lock_guard<std::mutex> guard(_lock);
     return _map.getMemoryUsage() + _lockedKeys.getMemoryUsage() +
-        sizeof(std::mutex) + sizeof(std::condition_variable);
+        sizeof(std::mutex) + sizeof(_conds) + sizeof(_waitersInStripe);
 }
 
 template<typename Map>
@@ -130,15 +131,31 @@ LockableMap<Map>::swap(LockableMap<Map>& other)
     return _map.swap(other._map);
 }
 
+template<typename Map>
+void LockableMap<Map>::waitForKey(const LockId & lid, std::unique_lock<std::mutex> &guard)
+{
+    typename LockWaiters::Key waitId(_lockWaiters.insert(lid));
+    const uint32_t stripe = stripeOf(lid._key);
+    ++_waitersInStripe[stripe];
+    _conds[stripe].wait(guard);
+    --_waitersInStripe[stripe];
+    _lockWaiters.erase(waitId);
+}
+
+template<typename Map>
+void LockableMap<Map>::notifyWaiters(key_type key)
+{
+    const uint32_t stripe = stripeOf(key);
+    if (_waitersInStripe[stripe] != 0) {
+        _conds[stripe].notify_all();
+    }
+}
+
 template<typename Map>
 void LockableMap<Map>::acquireKey(const LockId & lid, std::unique_lock<std::mutex> &guard)
 {
-    if (_lockedKeys.exist(lid)) {
-        typename LockWaiters::Key waitId(_lockWaiters.insert(lid));
-        while (_lockedKeys.exist(lid)) {
-            _cond.wait(guard);
-        }
-        _lockWaiters.erase(waitId);
+    while (_lockedKeys.exist(lid)) {
+        waitForKey(lid, guard);
     }
 }
 
@@ -241,9 +258,7 @@ LockableMap<Map>::findNextKey(key_type& key, mapped_type& val,
     // Wait for next value to unlock.
     typename Map::iterator it(_map.lower_bound(key));
     while (it != _map.end() && _lockedKeys.exist(LockId(it->first, ""))) {
-        typename LockWaiters::Key waitId(_lockWaiters.insert(LockId(it->first, clientId)));
-        _cond.wait(guard);
-        _lockWaiters.erase(waitId);
+        waitForKey(LockId(it->first, clientId), guard);
         it = _map.lower_bound(key);
     }
     if (it == _map.end()) return true;
@@ -290,7 +305,7 @@ LockableMap<Map>::each(Functor& functor, const char* clientId,
             decision = functor(const_cast<const key_type&>(key), val);
             std::unique_lock<std::mutex> guard(_lock);
             _lockedKeys.erase(LockId(key, clientId));
-            _cond.notify_all();
+            notifyWaiters(key);
             if (handleDecision(key, val, decision)) return;
             ++key;
             if (findNextKey(key, val, clientId, guard) || key > last) return;
@@ -301,7 +316,7 @@ LockableMap<Map>::each(Functor& functor, const char* clientId,
             // to unlock the current key before exiting
         std::lock_guard<std::mutex> guard(_lock);
         _lockedKeys.erase(LockId(key, clientId));
-        _cond.notify_all();
+        notifyWaiters(key);
         throw;
     }
 }
@@ -325,7 +340,7 @@ LockableMap<Map>::each(const Functor& functor, const char* clientId,
             decision = functor(const_cast<const key_type&>(key), val);
             std::unique_lock<std::mutex> guard(_lock);
             _lockedKeys.erase(LockId(key, clientId));
-            _cond.notify_all();
+            notifyWaiters(key);
             if (handleDecision(key, val, decision)) return;
             ++key;
             if (findNextKey(key, val, clientId, guard) || key > last) return;
@@ -336,7 +351,7 @@ LockableMap<Map>::each(const Functor& functor, const char* clientId,
             // to unlock the current key before exiting
         std::lock_guard<std::mutex> guard(_lock);
         _lockedKeys.erase(LockId(key, clientId));
-        _cond.notify_all();
+        notifyWaiters(key);
         throw;
     }
 }
@@ -466,7 +481,7 @@ LockableMap<Map>::unlock(const key_type& key)
 {
     std::lock_guard<std::mutex> guard(_lock);
     _lockedKeys.erase(LockId(key, ""));
-    _cond.notify_all();
+    notifyWaiters(key);
 }
 
 /**
@@ -568,9 +583,7 @@ LockableMap<Map>::addAndLockResults(
         }
 
         if (!allOk) {
-            typename LockWaiters::Key waitId(_lockWaiters.insert(LockId(waitingFor, clientId)));
-            _cond.wait(guard);
-            _lockWaiters.erase(waitId);
+            waitForKey(LockId(waitingFor, clientId), guard);
         } else {
             for (uint32_t i=0; i<keys.size(); i++) {
                 typename Map::iterator it = _map.find(keys[i]);
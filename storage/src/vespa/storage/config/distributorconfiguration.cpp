@@ -28,12 +28,19 @@ DistributorConfiguration::DistributorConfiguration(StorageComponent& component)
       _minBucketsPerVisitor(5),
       _maxClusterClockSkew(0),
       _inhibitMergeSendingOnBusyNodeDuration(std::chrono::seconds(60)),
+      _adaptiveNodeThrottlingMinWindow(16),
+      _adaptiveNodeThrottlingMaxWindow(1024),
+      _backgroundScanTickInterval(16),
       _doInlineSplit(true),
       _enableJoinForSiblingLessBuckets(false),
       _enableInconsistentJoin(false),
       _enableHostInfoReporting(true),
       _disableBucketActivation(false),
       _sequenceMutatingOperations(true),
+      _adaptiveNodeThrottling(false),
+      _enableMetadataOnlyFetchPhaseForInconsistentUpdates(false),
+      _incrementalMaintenanceScanning(false),
+      _latencyAwareGetRouting(false),
       _minimumReplicaCountingMode(ReplicaCountingMode::TRUSTED)
 { }
 
@@ -144,6 +151,19 @@ DistributorConfiguration::configure(const vespa::config::content::core::StorDist
     _enableHostInfoReporting = config.enableHostInfoReporting;
     _disableBucketActivation = config.disableBucketActivation;
     _sequenceMutatingOperations = config.sequenceMutatingOperations;
+    _adaptiveNodeThrottling = config.adaptiveNodeThrottling;
+    _enableMetadataOnlyFetchPhaseForInconsistentUpdates = config.enableMetadataOnlyFetchPhaseForInconsistentUpdates;
+    if (config.adaptiveNodeThrottlingMinWindow > 0) {
+        _adaptiveNodeThrottlingMinWindow = config.adaptiveNodeThrottlingMinWindow;
+    }
+    if (config.adaptiveNodeThrottlingMaxWindow > 0) {
+        _adaptiveNodeThrottlingMaxWindow = config.adaptiveNodeThrottlingMaxWindow;
+    }
+    _incrementalMaintenanceScanning = config.incrementalMaintenanceScanning;
+    _latencyAwareGetRouting = config.latencyAwareGetRouting;
+    if (config.backgroundScanTickInterval > 0) {
+        _backgroundScanTickInterval = config.backgroundScanTickInterval;
+    }
 
     _minimumReplicaCountingMode = config.minimumReplicaCountingMode;
 
@@ -235,6 +235,46 @@ public:
     void setSequenceMutatingOperations(bool sequenceMutations) noexcept {
         _sequenceMutatingOperations = sequenceMutations;
     }
+
+    bool getAdaptiveNodeThrottling() const noexcept {
+        return _adaptiveNodeThrottling;
+    }
+    void setAdaptiveNodeThrottling(bool enabled) noexcept {
+        _adaptiveNodeThrottling = enabled;
+    }
+    uint32_t getAdaptiveNodeThrottlingMinWindow() const noexcept {
+        return _adaptiveNodeThrottlingMinWindow;
+    }
+    uint32_t getAdaptiveNodeThrottlingMaxWindow() const noexcept {
+        return _adaptiveNodeThrottlingMaxWindow;
+    }
+
+    bool getEnableMetadataOnlyFetchPhaseForInconsistentUpdates() const noexcept {
+        return _enableMetadataOnlyFetchPhaseForInconsistentUpdates;
+    }
+    void setEnableMetadataOnlyFetchPhaseForInconsistentUpdates(bool enable) noexcept {
+        _enableMetadataOnlyFetchPhaseForInconsistentUpdates = enable;
+    }
+
+    bool getIncrementalMaintenanceScanning() const noexcept {
+        return _incrementalMaintenanceScanning;
+    }
+    void setIncrementalMaintenanceScanning(bool enabled) noexcept {
+        _incrementalMaintenanceScanning = enabled;
+    }
+    uint32_t getBackgroundScanTickInterval() const noexcept {
+        return _backgroundScanTickInterval;
+    }
+    void setBackgroundScanTickInterval(uint32_t ticks) noexcept {
+        _backgroundScanTickInterval = ticks;
+    }
+
+    bool getLatencyAwareGetRouting() const noexcept {
+        return _latencyAwareGetRouting;
+    }
+    void setLatencyAwareGetRouting(bool enabled) noexcept {
+        _latencyAwareGetRouting = enabled;
+    }
     
 private:
     DistributorConfiguration(const DistributorConfiguration& other);
@@ -267,6 +307,9 @@ private:
     MaintenancePriorities _maintenancePriorities;
     std::chrono::seconds _maxClusterClockSkew;
     std::chrono::seconds _inhibitMergeSendingOnBusyNodeDuration;
+    uint32_t _adaptiveNodeThrottlingMinWindow;
+    uint32_t _adaptiveNodeThrottlingMaxWindow;
+    uint32_t _backgroundScanTickInterval;
 
     bool _doInlineSplit;
     bool _enableJoinForSiblingLessBuckets;
@@ -274,6 +317,10 @@ private:
     bool _enableHostInfoReporting;
     bool _disableBucketActivation;
     bool _sequenceMutatingOperations;
+    bool _adaptiveNodeThrottling;
+    bool _enableMetadataOnlyFetchPhaseForInconsistentUpdates;
+    bool _incrementalMaintenanceScanning;
+    bool _latencyAwareGetRouting;
 
     DistrConfig::MinimumReplicaCountingMode _minimumReplicaCountingMode;
     
@@ -3,6 +3,7 @@
 #include "bucketdbupdater.h"
 #include "distributor.h"
 #include "distributor_bucket_space.h"
+#include "pending_bucket_space_db_transition.h"
 #include "simpleclusterinformation.h"
 #include "distributormetricsset.h"
 #include <vespa/storage/common/bucketoperationlogger.h>
@@ -132,6 +133,20 @@ BucketDBUpdater::removeSuperfluousBuckets(
         for (const auto & entry :proc.getBucketsToRemove()) {
             bucketDb.remove(entry);
         }
+        notifyBucketInfoChanged(elem.first, proc.getChangedBuckets());
+    }
+}
+
+void
+BucketDBUpdater::notifyBucketInfoChanged(document::BucketSpace bucketSpace,
+                                         const std::vector<document::BucketId>& buckets)
+{
+    auto& distributor(_distributorComponent.getDistributor());
+    if (!distributor.getConfig().getIncrementalMaintenanceScanning()) {
+        return;
+    }
+    for (const auto& bucketId : buckets) {
+        distributor.notifyBucketInfoChanged(document::Bucket(bucketSpace, bucketId));
     }
 }
 
@@ -486,6 +501,10 @@ void
 BucketDBUpdater::processCompletedPendingClusterState()
 {
     _pendingClusterState->mergeIntoBucketDatabases();
+    for (auto& elem : _distributorComponent.getBucketSpaceRepo()) {
+        notifyBucketInfoChanged(elem.first,
+                                _pendingClusterState->getPendingBucketSpaceDbTransition(elem.first).getChangedBuckets());
+    }
 
     if (_pendingClusterState->getCommand().get()) {
         enableCurrentClusterStateBundleInDistributor();
@@ -709,6 +728,7 @@ BucketDBUpdater::NodeRemover::process(BucketDatabase::Entry& e)
         removeEmptyBucket(bucketId);
     } else {
         setCopiesInEntry(e, remainingCopies);
+        _changedBuckets.push_back(bucketId);
     }
 
     return true;
@@ -41,6 +41,7 @@ public:
     void flush();
     BucketOwnership checkOwnershipInPendingState(const document::Bucket&) const;
     void recheckBucketInfo(uint32_t nodeIdx, const document::Bucket& bucket);
+    bool hasPendingClusterState() const;
 
     bool onSetSystemState(const std::shared_ptr<api::SetSystemStateCommand>& cmd) override;
     bool onRequestBucketInfoReply(const std::shared_ptr<api::RequestBucketInfoReply> & repl) override;
@@ -124,7 +125,6 @@ private:
         }
     };
 
-    bool hasPendingClusterState() const;
     bool pendingClusterStateAccepted(const std::shared_ptr<api::RequestBucketInfoReply>& repl);
     bool processSingleBucketInfoReply(const std::shared_ptr<api::RequestBucketInfoReply>& repl);
     void handleSingleBucketInfoFailure(const std::shared_ptr<api::RequestBucketInfoReply>& repl,
@@ -159,6 +159,8 @@ private:
     void updateState(const lib::ClusterState& oldState, const lib::ClusterState& newState);
 
     void removeSuperfluousBuckets(const lib::ClusterStateBundle& newState);
+    void notifyBucketInfoChanged(document::BucketSpace bucketSpace,
+                                 const std::vector<document::BucketId>& buckets);
 
     void replyToPreviousPendingClusterStateIfAny();
 
@@ -210,6 +212,9 @@ private:
         const std::vector<document::BucketId>& getBucketsToRemove() const {
             return _removedBuckets;
         }
+        const std::vector<document::BucketId>& getChangedBuckets() const {
+            return _changedBuckets;
+        }
     private:
         void setCopiesInEntry(BucketDatabase::Entry& e, const std::vector<BucketCopy>& copies) const;
         void removeEmptyBucket(const document::BucketId& bucketId);
@@ -217,6 +222,7 @@ private:
         const lib::ClusterState _oldState;
         const lib::ClusterState _state;
         std::vector<document::BucketId> _removedBuckets;
+        std::vector<document::BucketId> _changedBuckets;
 
         const document::BucketIdFactory& _factory;
         uint16_t _localIndex;
@@ -88,6 +88,7 @@ Distributor::Distributor(DistributorComponentRegister& compReg,
       _scheduler(new MaintenanceScheduler(_idealStateManager, *_bucketPriorityDb, *_blockingStarter)),
       _schedulingMode(MaintenanceScheduler::NORMAL_SCHEDULING_MODE),
       _recoveryTimeStarted(_component.getClock()),
+      _ticksSinceBackgroundScan(0),
       _tickResult(framework::ThreadWaitInfo::NO_MORE_CRITICAL_WORK_KNOWN),
       _clusterName(_component.getClusterName()),
       _bucketIdHasher(new BucketGcTimeCalculator::BucketIdIdentityHasher()),
@@ -484,6 +485,15 @@ Distributor::recheckBucketInfo(uint16_t nodeIdx, const document::Bucket &bucket)
     _bucketDBUpdater.recheckBucketInfo(nodeIdx, bucket);
 }
 
+void
+Distributor::notifyBucketInfoChanged(const document::Bucket &bucket)
+{
+    // All buckets are scanned when initializing is done
+    if (!initializing() && getConfig().getIncrementalMaintenanceScanning()) {
+        _scanner->queueChangedBucket(bucket);
+    }
+}
+
 namespace {
 
 class MaintenanceChecker : public PendingMessageTracker::Checker
@@ -773,6 +783,45 @@ Distributor::scanNextBucket()
     return scanResult;
 }
 
+namespace {
+
+// Bounds the time spent on changed buckets per tick, so that they do not
+// hold back external operations.
+constexpr size_t ChangedBucketChecksPerTick = 16;
+
+}
+
+void
+Distributor::checkChangedBuckets()
+{
+    // Buckets are checked against the cluster state they were changed for,
+    // so wait until a pending cluster state has been enabled.
+    if (_bucketDBUpdater.hasPendingClusterState()) {
+        return;
+    }
+    if (_scanner->checkQueuedBuckets(ChangedBucketChecksPerTick) != 0) {
+        signalWorkWasDone();
+    }
+}
+
+bool
+Distributor::shouldScanNextBucket()
+{
+    // Scan at full rate when recovering, or when the changed bucket queue has
+    // dropped changes, until a complete scan has covered them.
+    if (!getConfig().getIncrementalMaintenanceScanning()
+        || isInRecoveryMode()
+        || _scanner->queueOverflowed())
+    {
+        return true;
+    }
+    if (++_ticksSinceBackgroundScan < getConfig().getBackgroundScanTickInterval()) {
+        return false;
+    }
+    _ticksSinceBackgroundScan = 0;
+    return true;
+}
+
 void Distributor::send_updated_host_info_if_required() {
     if (_must_send_updated_host_info) {
         _component.getStateUpdater().immediately_send_get_node_state_replies();
@@ -806,7 +855,10 @@ Distributor::doNonCriticalTick(framework::ThreadIndex)
     handleStatusRequests();
     startExternalOperations();
     if (!initializing()) {
-        scanNextBucket();
+        checkChangedBuckets();
+        if (shouldScanNextBucket()) {
+            scanNextBucket();
+        }
         startNextMaintenanceOperation();
         if (isInRecoveryMode()) {
             signalWorkWasDone();
@@ -823,6 +875,9 @@ Distributor::enableNextConfig()
     _bucketDBMetricUpdater.setMinimumReplicaCountingMode(getConfig().getMinimumReplicaCountingMode());
     _ownershipSafeTimeCalc->setMaxClusterClockSkew(getConfig().getMaxClusterClockSkew());
     _pendingMessageTracker.setNodeBusyDuration(getConfig().getInhibitMergesOnBusyNodeDuration());
+    _pendingMessageTracker.getNodeInfo().setConcurrencyLimitBounds(
+            getConfig().getAdaptiveNodeThrottlingMinWindow(),
+            getConfig().getAdaptiveNodeThrottlingMaxWindow());
 }
 
 void
@@ -92,6 +92,8 @@ public:
 
     void recheckBucketInfo(uint16_t nodeIdx, const document::Bucket &bucket) override;
 
+    void notifyBucketInfoChanged(const document::Bucket &bucket) override;
+
     bool handleReply(const std::shared_ptr<api::StorageReply>& reply) override;
 
     // StatusReporter implementation
@@ -213,6 +215,8 @@ private:
     void updateInternalMetricsForCompletedScan();
     void scanAllBuckets();
     MaintenanceScanner::ScanResult scanNextBucket();
+    void checkChangedBuckets();
+    bool shouldScanNextBucket();
     void enableNextConfig();
     void fetchStatusRequests();
     void fetchExternalMessages();
@@ -295,6 +299,7 @@ private:
     std::unique_ptr<MaintenanceScheduler> _scheduler;
     MaintenanceScheduler::SchedulingMode _schedulingMode;
     framework::MilliSecTimer _recoveryTimeStarted;
+    uint32_t _ticksSinceBackgroundScan;
     framework::ThreadWaitInfo _tickResult;
     const std::string _clusterName;
     BucketDBMetricUpdater _bucketDBMetricUpdater;
@@ -3,13 +3,15 @@
 #include "distributor_bucket_space.h"
 #include <vespa/vdslib/state/clusterstate.h>
 #include <vespa/vdslib/distribution/distribution.h>
+#include <vespa/vdslib/distribution/ideal_nodes_cache.h>
 
 namespace storage::distributor {
 
 DistributorBucketSpace::DistributorBucketSpace()
     : _bucketDatabase(),
       _clusterState(),
-      _distribution()
+      _distribution(),
+      _idealNodesCache()
 {
 }
 
@@ -19,12 +21,23 @@ void
 DistributorBucketSpace::setClusterState(std::shared_ptr<const lib::ClusterState> clusterState)
 {
     _clusterState = std::move(clusterState);
+    _idealNodesCache.reset();
 }
 
 
 void
 DistributorBucketSpace::setDistribution(std::shared_ptr<const lib::Distribution> distribution) {
     _distribution = std::move(distribution);
+    _idealNodesCache.reset();
+}
+
+std::vector<uint16_t>
+DistributorBucketSpace::getIdealNodes(const document::BucketId& bucket, const char* upStates) const
+{
+    if (!_idealNodesCache) {
+        _idealNodesCache = std::make_unique<lib::IdealNodesCache>(*_distribution, *_clusterState);
+    }
+    return _idealNodesCache->getIdealStorageNodes(bucket, upStates);
 }
 
 }
@@ -1,12 +1,14 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
-#include <vespa/storage/bucketdb/mapbucketdatabase.h>
+#include <vespa/storage/bucketdb/btree_bucket_database.h>
 #include <memory>
+#include <vector>
 
 namespace storage::lib {
     class ClusterState;
     class Distribution;
+    class IdealNodesCache;
 }
 
 namespace storage::distributor {
@@ -21,11 +23,15 @@ namespace storage::distributor {
  *   Each bucket space _may_ operate with its own distribution config, in
  *   particular so that redundancy, ready copies etc can differ across
  *   bucket spaces.
+ * Ideal nodes cache
+ *   Ideal storage nodes for the current cluster state and distribution,
+ *   invalidated whenever either of them is changed.
  */
 class DistributorBucketSpace {
-    MapBucketDatabase _bucketDatabase;
+    BTreeBucketDatabase _bucketDatabase;
     std::shared_ptr<const lib::ClusterState> _clusterState;
     std::shared_ptr<const lib::Distribution> _distribution;
+    mutable std::unique_ptr<lib::IdealNodesCache> _idealNodesCache;
 public:
     DistributorBucketSpace();
     ~DistributorBucketSpace();
@@ -53,6 +59,9 @@ public:
         return *_distribution;
     }
 
+    // Precondition: both setClusterState and setDistribution have been called.
+    std::vector<uint16_t> getIdealNodes(const document::BucketId& bucket,
+                                        const char* upStates = "uim") const;
 };
 
 }
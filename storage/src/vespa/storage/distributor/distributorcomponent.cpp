@@ -48,10 +48,7 @@ std::vector<uint16_t>
 DistributorComponent::getIdealNodes(const document::Bucket &bucket) const
 {
     auto &bucketSpace(_bucketSpaceRepo.get(bucket.getBucketSpace()));
-    return bucketSpace.getDistribution().getIdealStorageNodes(
-            bucketSpace.getClusterState(),
-            bucket.getBucketId(),
-            _distributor.getStorageNodeUpStates());
+    return bucketSpace.getIdealNodes(bucket.getBucketId(), _distributor.getStorageNodeUpStates());
 }
 
 BucketOwnership
@@ -181,6 +178,7 @@ DistributorComponent::removeNodesFromDB(const document::Bucket &bucket,
 
         if (dbentry->getNodeCount() != 0) {
             bucketSpace.getBucketDatabase().update(dbentry);
+            _distributor.notifyBucketInfoChanged(bucket);
         } else {
             LOG(debug,
                 "After update, bucket %s now has no copies. "
@@ -239,13 +237,15 @@ DistributorComponent::updateBucketDatabase(
         return;
     }
 
-    if (!dbentry.valid()) {
+    const bool created = !dbentry.valid();
+    if (created) {
         if (updateFlags & DatabaseUpdate::CREATE_IF_NONEXISTING) {
             dbentry = BucketDatabase::Entry(bucket.getBucketId(), BucketInfo());
         } else {
             return;
         }
     }
+    const uint32_t oldNodeCount = dbentry->getNodeCount();
 
     // 0 implies bucket was just added. Since we don't know if any other
     // distributor has run GC on it, we just have to assume this and set the
@@ -285,6 +285,11 @@ DistributorComponent::updateBucketDatabase(
         return;
     }
     bucketSpace.getBucketDatabase().update(dbentry);
+    // Replies to feed operations keep replicas in sync, so only report
+    // changes that may leave the bucket needing maintenance.
+    if (created || dbentry->getNodeCount() != oldNodeCount || !dbentry->validAndConsistent()) {
+        _distributor.notifyBucketInfoChanged(bucket);
+    }
 }
 
 void
@@ -32,6 +32,12 @@ public:
      */
     virtual void recheckBucketInfo(uint16_t nodeIdx, const document::Bucket &bucket) = 0;
 
+    /**
+     * Notifies that the replica info for the given bucket has changed in the
+     * bucket database, which may cause it to need maintenance.
+     */
+    virtual void notifyBucketInfoChanged(const document::Bucket &bucket) = 0;
+
     virtual bool handleReply(const std::shared_ptr<api::StorageReply>& reply) = 0;
 
     /**
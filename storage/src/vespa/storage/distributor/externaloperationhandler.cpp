@@ -69,6 +69,32 @@ ExternalOperationHandler::checkSafeTimeReached(api::StorageCommand& cmd)
     return true;
 }
 
+bool
+ExternalOperationHandler::checkTargetNodesNotSaturated(api::StorageCommand& cmd,
+                                                       const document::BucketId &bucketId,
+                                                       PersistenceOperationMetricSet& persistenceMetrics)
+{
+    if (!getDistributor().getConfig().getAdaptiveNodeThrottling()) {
+        return true;
+    }
+    const NodeInfo& nodeInfo(getDistributor().getPendingMessageTracker().getNodeInfo());
+    const auto& bucketSpace(_bucketSpaceRepo.get(cmd.getBucket().getBucketSpace()));
+    for (uint16_t node : bucketSpace.getIdealNodes(bucketId)) {
+        if (nodeInfo.isSaturated(node)) {
+            auto err_msg = vespalib::make_string("Content node %u is saturated (%u pending messages, limit is %u)",
+                                                 node, nodeInfo.getPendingCount(node),
+                                                 nodeInfo.getConcurrencyLimit(node));
+            LOG(debug, "Rejecting incoming %s operation: %s", cmd.getType().toString().c_str(), err_msg.c_str());
+            persistenceMetrics.failures.node_saturated++;
+            api::StorageReply::UP reply(cmd.makeReply());
+            reply->setResult(api::ReturnCode(api::ReturnCode::BUSY, err_msg));
+            sendUp(std::shared_ptr<api::StorageMessage>(reply.release()));
+            return false;
+        }
+    }
+    return true;
+}
+
 bool
 ExternalOperationHandler::checkTimestampMutationPreconditions(api::StorageCommand& cmd,
                                                               const document::BucketId &bucketId,
@@ -86,6 +112,9 @@ ExternalOperationHandler::checkTimestampMutationPreconditions(api::StorageComman
         persistenceMetrics.failures.safe_time_not_reached++;
         return false;
     }
+    if (!checkTargetNodesNotSaturated(cmd, bucketId, persistenceMetrics)) {
+        return false;
+    }
     return true;
 }
 
@@ -56,6 +56,9 @@ private:
     TimePoint _rejectFeedBeforeTimeReached;
 
     bool checkSafeTimeReached(api::StorageCommand& cmd);
+    bool checkTargetNodesNotSaturated(api::StorageCommand& cmd,
+                                      const document::BucketId &bucketId,
+                                      PersistenceOperationMetricSet& persistenceMetrics);
     api::ReturnCode makeSafeTimeRejectionResult(TimePoint unsafeTime);
     bool checkTimestampMutationPreconditions(
             api::StorageCommand& cmd,
@@ -6,12 +6,18 @@ namespace storage::distributor {
 
 SimpleMaintenanceScanner::SimpleMaintenanceScanner(BucketPriorityDatabase& bucketPriorityDb,
                                                    const MaintenancePriorityGenerator& priorityGenerator,
-                                                   const DistributorBucketSpaceRepo& bucketSpaceRepo)
+                                                   const DistributorBucketSpaceRepo& bucketSpaceRepo,
+                                                   size_t maxQueuedBuckets)
     : _bucketPriorityDb(bucketPriorityDb),
       _priorityGenerator(priorityGenerator),
       _bucketSpaceRepo(bucketSpaceRepo),
       _bucketSpaceItr(_bucketSpaceRepo.begin()),
-      _bucketCursor()
+      _bucketCursor(),
+      _pendingMaintenance(),
+      _queuedBuckets(),
+      _queuedBucketSet(),
+      _maxQueuedBuckets(maxQueuedBuckets),
+      _queueOverflowed(false)
 {
 }
 
@@ -50,6 +56,38 @@ SimpleMaintenanceScanner::reset()
     _bucketCursor = document::BucketId();
     _bucketSpaceItr = _bucketSpaceRepo.begin();
     _pendingMaintenance = PendingMaintenanceStats();
+    _queueOverflowed = false;
+}
+
+void
+SimpleMaintenanceScanner::queueChangedBucket(const document::Bucket &bucket)
+{
+    if (_queuedBucketSet.find(bucket) != _queuedBucketSet.end()) {
+        return;
+    }
+    if (_queuedBuckets.size() >= _maxQueuedBuckets) {
+        _queueOverflowed = true;
+        return;
+    }
+    _queuedBucketSet.insert(bucket);
+    _queuedBuckets.push_back(bucket);
+}
+
+size_t
+SimpleMaintenanceScanner::checkQueuedBuckets(size_t maxBuckets)
+{
+    size_t checked = 0;
+    for (; checked < maxBuckets && !_queuedBuckets.empty(); ++checked) {
+        document::Bucket bucket(_queuedBuckets.front());
+        _queuedBuckets.pop_front();
+        _queuedBucketSet.erase(bucket);
+        NodeMaintenanceStatsTracker ignoredStats;
+        MaintenancePriorityAndType pri(_priorityGenerator.prioritize(bucket, ignoredStats));
+        if (pri.requiresMaintenance()) {
+            _bucketPriorityDb.setPriority(PrioritizedBucket(bucket, pri.getPriority().getPriority()));
+        }
+    }
+    return checked;
 }
 
 void
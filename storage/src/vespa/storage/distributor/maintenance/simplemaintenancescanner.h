@@ -6,6 +6,8 @@
 #include "maintenanceprioritygenerator.h"
 #include "node_maintenance_stats_tracker.h"
 #include <vespa/storage/distributor/distributor_bucket_space_repo.h>
+#include <deque>
+#include <unordered_set>
 
 namespace storage {
 namespace distributor {
@@ -35,22 +37,52 @@ private:
     DistributorBucketSpaceRepo::BucketSpaceMap::const_iterator _bucketSpaceItr;
     document::BucketId _bucketCursor;
     PendingMaintenanceStats _pendingMaintenance;
+    std::deque<document::Bucket> _queuedBuckets;
+    std::unordered_set<document::Bucket, document::Bucket::hash> _queuedBucketSet;
+    size_t _maxQueuedBuckets;
+    bool _queueOverflowed;
 
     void countBucket(document::BucketSpace bucketSpace, const BucketInfo &info);
 public:
+    static constexpr size_t DefaultMaxQueuedBuckets = 65536;
+
     SimpleMaintenanceScanner(BucketPriorityDatabase& bucketPriorityDb,
                              const MaintenancePriorityGenerator& priorityGenerator,
-                             const DistributorBucketSpaceRepo& bucketSpaceRepo);
+                             const DistributorBucketSpaceRepo& bucketSpaceRepo,
+                             size_t maxQueuedBuckets = DefaultMaxQueuedBuckets);
     SimpleMaintenanceScanner(const SimpleMaintenanceScanner&) = delete;
     SimpleMaintenanceScanner& operator=(const SimpleMaintenanceScanner&) = delete;
     ~SimpleMaintenanceScanner();
 
     ScanResult scanNext() override;
+    /**
+     * Restarts the scan from the start of the bucket database. Queued
+     * buckets are kept, as they are not covered by the scan position.
+     */
     void reset() override;
 
     // TODO: move out into own interface!
     void prioritizeBucket(const document::Bucket &id);
 
+    /**
+     * Queues a bucket whose replica info has changed, so that it is checked
+     * for maintenance ahead of the regular scan. A bucket already in the
+     * queue is only checked once. If the queue is full the bucket is dropped,
+     * and queueOverflowed() returns true until the next reset, as it is then
+     * up to the scan to find it.
+     */
+    void queueChangedBucket(const document::Bucket &bucket);
+
+    /**
+     * Checks up to maxBuckets queued buckets in the order they were queued,
+     * returning the number of buckets checked. These checks are not counted
+     * in the pending maintenance stats, which cover a complete scan.
+     */
+    size_t checkQueuedBuckets(size_t maxBuckets);
+
+    size_t getQueuedBucketCount() const { return _queuedBuckets.size(); }
+    bool queueOverflowed() const { return _queueOverflowed; }
+
     const PendingMaintenanceStats& getPendingMaintenanceStats() const {
         return _pendingMaintenance;
     }
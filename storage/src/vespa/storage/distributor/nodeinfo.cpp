@@ -2,11 +2,30 @@
 
 #include "nodeinfo.h"
 #include <vespa/storageframework/generic/clock/clock.h>
+#include <algorithm>
+#include <cmath>
 
 namespace storage::distributor {
 
+namespace {
+
+// Weight of a new sample in the smoothed latency.
+constexpr double LatencySmoothing = 0.1;
+// Rate at which the baseline drifts towards the smoothed latency, so that
+// it recovers when a node has become permanently slower.
+constexpr double BaselineDrift = 0.001;
+// Latencies may grow to this factor of the baseline before backing off.
+constexpr double LatencyTolerance = 2.0;
+// Weight of a new limit estimate in the limit.
+constexpr double LimitSmoothing = 0.2;
+
+}
+
 NodeInfo::NodeInfo(const framework::Clock& clock)
-    : _clock(clock) {}
+    : _clock(clock),
+      _minLimit(16),
+      _maxLimit(1024)
+{}
 
 uint32_t NodeInfo::getPendingCount(uint16_t idx) const {
     return getNode(idx)._pending;
@@ -46,10 +65,57 @@ void NodeInfo::clearPending(uint16_t idx) {
     info._pending = 0;
 }
 
+void NodeInfo::setConcurrencyLimitBounds(uint32_t minLimit, uint32_t maxLimit) {
+    _minLimit = std::max(1u, minLimit);
+    _maxLimit = std::max(_minLimit, static_cast<double>(maxLimit));
+    for (SingleNodeInfo& info : _nodes) {
+        info._limit = std::min(std::max(info._limit, _minLimit), _maxLimit);
+    }
+}
+
+uint32_t NodeInfo::getConcurrencyLimit(uint16_t idx) const {
+    return static_cast<uint32_t>(getNode(idx)._limit);
+}
+
+bool NodeInfo::isSaturated(uint16_t idx) const {
+    return (getPendingCount(idx) >= getConcurrencyLimit(idx));
+}
+
+void NodeInfo::addLatencySample(uint16_t idx, std::chrono::milliseconds latency) {
+    SingleNodeInfo& info = getNode(idx);
+    // Offset by one, as many replies arrive within the clock resolution.
+    const double sample = latency.count() + 1.0;
+    if (info._smoothedLatency == 0) {
+        info._smoothedLatency = sample;
+        info._baselineLatency = sample;
+        return;
+    }
+    info._smoothedLatency += (sample - info._smoothedLatency) * LatencySmoothing;
+    if (sample < info._baselineLatency) {
+        info._baselineLatency = sample;
+    } else {
+        info._baselineLatency += (info._smoothedLatency - info._baselineLatency) * BaselineDrift;
+    }
+    const double gradient = std::max(0.5, std::min(1.0, (info._baselineLatency * LatencyTolerance)
+                                                        / info._smoothedLatency));
+    const double estimate = (info._limit * gradient) + std::sqrt(info._limit);
+    info._limit += (estimate - info._limit) * LimitSmoothing;
+    info._limit = std::min(std::max(info._limit, _minLimit), _maxLimit);
+}
+
+double NodeInfo::getSmoothedLatency(uint16_t idx) const {
+    return getNode(idx)._smoothedLatency;
+}
+
+void NodeInfo::backOff(uint16_t idx) {
+    SingleNodeInfo& info = getNode(idx);
+    info._limit = std::max(info._limit * 0.5, _minLimit);
+}
+
 NodeInfo::SingleNodeInfo& NodeInfo::getNode(uint16_t idx) {
     const auto index_lbound = static_cast<size_t>(idx) + 1;
     while (_nodes.size() < index_lbound) {
-        _nodes.emplace_back();
+        _nodes.emplace_back(_maxLimit);
     }
 
     return _nodes[idx];
@@ -58,7 +124,7 @@ NodeInfo::SingleNodeInfo& NodeInfo::getNode(uint16_t idx) {
 const NodeInfo::SingleNodeInfo& NodeInfo::getNode(uint16_t idx) const {
     const auto index_lbound = static_cast<size_t>(idx) + 1;
     while (_nodes.size() < index_lbound) {
-        _nodes.emplace_back();
+        _nodes.emplace_back(_maxLimit);
     }
 
     return _nodes[idx];
@@ -4,10 +4,19 @@
  * \ingroup distributor
  *
  * \brief Keeps track of node state for all storage nodes.
+ *
+ * Also keeps an adaptive concurrency limit per node, driven by the latency
+ * of replies from it. The limit grows while latencies stay close to the
+ * lowest latency seen for the node, and shrinks in proportion to how far
+ * above it latencies rise (a latency gradient, like in TCP Vegas). Busy and
+ * timeout replies halve the limit. A node with as many pending messages as
+ * its limit is saturated, and new external operations towards it can be
+ * shed while it recovers.
  */
 #pragma once
 
 #include <vector>
+#include <chrono>
 #include <vespa/storageframework/generic/clock/time.h>
 
 namespace storage::distributor {
@@ -28,16 +37,40 @@ public:
 
     void clearPending(uint16_t idx);
 
+    void setConcurrencyLimitBounds(uint32_t minLimit, uint32_t maxLimit);
+
+    uint32_t getConcurrencyLimit(uint16_t idx) const;
+
+    /** Returns true if the node has at least as many pending messages as its limit. */
+    bool isSaturated(uint16_t idx) const;
+
+    void addLatencySample(uint16_t idx, std::chrono::milliseconds latency);
+
+    /**
+     * Returns the smoothed reply latency of the node in milliseconds, offset
+     * by one, or 0 if no reply latency has been observed for it.
+     */
+    double getSmoothedLatency(uint16_t idx) const;
+
+    void backOff(uint16_t idx);
+
 private:
     struct SingleNodeInfo {
-        SingleNodeInfo() : _pending(0), _busyUntilTime() {}
+        explicit SingleNodeInfo(double limit)
+            : _pending(0), _busyUntilTime(), _limit(limit),
+              _baselineLatency(0), _smoothedLatency(0) {}
 
         uint32_t _pending;
         mutable framework::MonotonicTimePoint _busyUntilTime;
+        double _limit;
+        double _baselineLatency;
+        double _smoothedLatency;
     };
 
     mutable std::vector<SingleNodeInfo> _nodes;
     const framework::Clock& _clock;
+    double _minLimit;
+    double _maxLimit;
 
     const SingleNodeInfo& getNode(uint16_t idx) const;
     SingleNodeInfo& getNode(uint16_t idx);
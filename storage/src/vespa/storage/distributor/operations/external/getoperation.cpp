@@ -6,6 +6,8 @@
 #include <vespa/vdslib/state/nodestate.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/storage/distributor/distributor_bucket_space.h>
+#include <vespa/storage/distributor/pendingmessagetracker.h>
+#include <vespa/storage/config/distributorconfiguration.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".distributor.callback.doc.get");
@@ -55,8 +57,12 @@ GetOperation::GetOperation(DistributorComponent& manager,
       _returnCode(api::ReturnCode::OK),
       _doc((document::Document*)NULL),
       _lastModified(0),
+      _firstReplicaTimestamp(0),
+      _anyReplicaReplied(false),
+      _replicaTimestampsConsistent(true),
       _metric(metric),
-      _operationTimer(manager.getClock())
+      _operationTimer(manager.getClock()),
+      _routeByLatency(manager.getDistributor().getConfig().getLatencyAwareGetRouting())
 {
     assignTargetNodeGroups();
 }
@@ -77,7 +83,9 @@ GetOperation::copyIsOnLocalNode(const BucketCopy& copy) const
 int
 GetOperation::findBestUnsentTarget(const GroupVector& candidates) const
 {
+    const NodeInfo& nodeInfo = _manager.getDistributor().getPendingMessageTracker().getNodeInfo();
     int best = -1;
+    double bestLatency = 0;
     for (uint32_t i = 0; i < candidates.size(); ++i) {
         if (candidates[i].sent) {
             continue;
@@ -87,6 +95,13 @@ GetOperation::findBestUnsentTarget(const GroupVector& candidates) const
         }
         if (best == -1) {
             best = i;
+            bestLatency = _routeByLatency ? nodeInfo.getSmoothedLatency(candidates[i].copy.getNode()) : 0;
+        } else if (_routeByLatency) {
+            const double latency = nodeInfo.getSmoothedLatency(candidates[i].copy.getNode());
+            if (latency < bestLatency) {
+                best = i;
+                bestLatency = latency;
+            }
         }
     }
     return best;
@@ -153,12 +168,19 @@ GetOperation::onReceive(DistributorMessageSender& sender, const std::shared_ptr<
                 iter->second[i].returnCode = getreply->getResult();
 
                 if (getreply->getResult().success()) {
+                    if (!_anyReplicaReplied) {
+                        _anyReplicaReplied = true;
+                        _firstReplicaTimestamp = getreply->getLastModifiedTimestamp();
+                    } else if (getreply->getLastModifiedTimestamp() != _firstReplicaTimestamp) {
+                        _replicaTimestampsConsistent = false;
+                    }
                     if (getreply->getLastModifiedTimestamp() > _lastModified) {
                         _returnCode = getreply->getResult();
                         _lastModified = getreply->getLastModifiedTimestamp();
                         _doc = getreply->getDocument();
                     }
                 } else {
+                    _replicaTimestampsConsistent = false;
                     if (_lastModified == 0) {
                         _returnCode = getreply->getResult();
                     }
@@ -231,20 +253,29 @@ GetOperation::assignTargetNodeGroups()
         LOG(spam, "Entry for %s: %s", e.getBucketId().toString().c_str(),
             e->toString().c_str());
 
-        bool haveTrusted = false;
+        // Trusted replicas are in sync, so a single one of them is asked.
+        // When routing by latency, all trusted replicas are candidates to
+        // choose from and to retry on.
+        const BucketCopy* firstTrusted = nullptr;
         for (uint32_t i = 0; i < e->getNodeCount(); i++) {
             const BucketCopy& c = e->getNodeRef(i);
 
             if (!c.trusted()) {
                 continue;
             }
+            if (firstTrusted == nullptr) {
+                firstTrusted = &c;
+            } else if (c.getChecksum() != firstTrusted->getChecksum()) {
+                continue;
+            }
 
             _responses[GroupId(e.getBucketId(), c.getChecksum(), -1)].push_back(c);
-            haveTrusted = true;
-            break;
+            if (!_routeByLatency) {
+                break;
+            }
         }
 
-        if (haveTrusted) {
+        if (firstTrusted != nullptr) {
             continue;
         }
 
@@ -34,6 +34,15 @@ public:
 
     bool hasConsistentCopies() const;
 
+    /**
+     * Returns true if all replicas that were asked replied successfully and
+     * agreed on the timestamp of the document (or on it not existing).
+     * Only meaningful once the operation has sent its reply.
+     */
+    bool replicasHaveConsistentTimestamps() const noexcept {
+        return _anyReplicaReplied && _replicaTimestampsConsistent;
+    }
+
 private:
     class GroupId {
     public:
@@ -79,9 +88,13 @@ private:
     std::shared_ptr<document::Document> _doc;
 
     api::Timestamp _lastModified;
+    api::Timestamp _firstReplicaTimestamp;
+    bool _anyReplicaReplied;
+    bool _replicaTimestampsConsistent;
 
     PersistenceOperationMetricSet& _metric;
     framework::MilliSecTimer _operationTimer;
+    bool _routeByLatency;
 
     void sendReply(DistributorMessageSender& sender);
     bool sendForChecksum(DistributorMessageSender& sender, const document::BucketId& id, GroupVector& res);
@@ -91,6 +104,9 @@ private:
     /**
      * Returns the vector index of the target to send to, or -1 if none
      * could be found (i.e. all targets have already been sent to).
+     * A replica on the local node is preferred. When routing by latency,
+     * the replica on the node with the lowest observed latency is chosen
+     * next, with nodes without observed latency first, so they get some.
      */
     int findBestUnsentTarget(const GroupVector& candidates) const;
 };
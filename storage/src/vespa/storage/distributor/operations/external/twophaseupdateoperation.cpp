@@ -93,6 +93,7 @@ TwoPhaseUpdateOperation::stateToString(SendState state)
     switch (state) {
     case SendState::NONE_SENT: return "NONE_SENT";
     case SendState::UPDATES_SENT: return "UPDATES_SENT";
+    case SendState::METADATA_GETS_SENT: return "METADATA_GETS_SENT";
     case SendState::GETS_SENT: return "GETS_SENT";
     case SendState::PUTS_SENT: return "PUTS_SENT";
     default:
@@ -172,21 +173,52 @@ TwoPhaseUpdateOperation::startFastPathUpdate(DistributorMessageSender& sender)
 void
 TwoPhaseUpdateOperation::startSafePathUpdate(DistributorMessageSender& sender)
 {
-    LOG(debug, "Update(%s) safe path: sending Get commands", _updateCmd->getDocumentId().toString().c_str());
-
     _mode = Mode::SLOW_PATH;
+    if (mayRestartWithFastPath()) {
+        LOG(debug, "Update(%s) safe path: sending metadata only Get commands",
+            _updateCmd->getDocumentId().toString().c_str());
+        sendSafePathGets(sender, "[none]", SendState::METADATA_GETS_SENT);
+    } else {
+        LOG(debug, "Update(%s) safe path: sending Get commands", _updateCmd->getDocumentId().toString().c_str());
+        sendSafePathGets(sender, "[all]", SendState::GETS_SENT);
+    }
+}
+
+/**
+ * Updates to buckets with replicas that are out of sync are commonly to
+ * documents that are identical across the replicas. If so, fetching the
+ * whole document to the distributor and writing it back is wasted work, so
+ * first only fetch the document timestamps from the replicas, and apply the
+ * update on the replicas (as for the fast path) if they all agree.
+ * Conditional updates need the document to evaluate their condition on.
+ */
+bool
+TwoPhaseUpdateOperation::mayRestartWithFastPath() const
+{
+    return (_manager.getDistributor().getConfig().getEnableMetadataOnlyFetchPhaseForInconsistentUpdates()
+            && !hasTasCondition());
+}
+
+void
+TwoPhaseUpdateOperation::sendSafePathGets(DistributorMessageSender& sender, const char* fieldSet, SendState newState)
+{
     document::Bucket bucket(_updateCmd->getBucket().getBucketSpace(), document::BucketId(0));
-    auto get = std::make_shared<api::GetCommand>(bucket, _updateCmd->getDocumentId(),"[all]");
+    auto get = std::make_shared<api::GetCommand>(bucket, _updateCmd->getDocumentId(), fieldSet);
     copyMessageSettings(*_updateCmd, *get);
     auto getOperation = std::make_shared<GetOperation>(_manager, _bucketSpace, get, _getMetric);
     GetOperation & op = *getOperation;
     IntermediateMessageSender intermediate(_sentMessageMap, std::move(getOperation), sender);
     op.start(intermediate, _manager.getClock().getTimeInMillis());
-    transitionTo(SendState::GETS_SENT);
+    transitionTo(newState);
 
     if (intermediate._reply.get()) {
         assert(intermediate._reply->getType() == api::MessageType::GET_REPLY);
-        handleSafePathReceivedGet(sender, static_cast<api::GetReply&>(*intermediate._reply));
+        auto& reply = static_cast<api::GetReply&>(*intermediate._reply);
+        if (newState == SendState::METADATA_GETS_SENT) {
+            handleSafePathReceivedMetadataGet(sender, reply, false);
+        } else {
+            handleSafePathReceivedGet(sender, reply);
+        }
     }
 }
 
@@ -341,7 +373,12 @@ TwoPhaseUpdateOperation::handleSafePathReceive(DistributorMessageSender& sender,
         return; // Not enough replies received yet or we're draining callbacks.
     }
     addTraceFromReply(*intermediate._reply);
-    if (_sendState == SendState::GETS_SENT) {
+    if (_sendState == SendState::METADATA_GETS_SENT) {
+        assert(intermediate._reply->getType() == api::MessageType::GET_REPLY);
+        const bool replicasConsistent = static_cast<GetOperation&>(callbackOp).replicasHaveConsistentTimestamps();
+        handleSafePathReceivedMetadataGet(sender, static_cast<api::GetReply&>(*intermediate._reply),
+                                          replicasConsistent);
+    } else if (_sendState == SendState::GETS_SENT) {
         assert(intermediate._reply->getType() == api::MessageType::GET_REPLY);
         handleSafePathReceivedGet(sender, static_cast<api::GetReply&>(*intermediate._reply));
     } else if (_sendState == SendState::PUTS_SENT) {
@@ -352,6 +389,33 @@ TwoPhaseUpdateOperation::handleSafePathReceive(DistributorMessageSender& sender,
     }
 }
 
+void
+TwoPhaseUpdateOperation::handleSafePathReceivedMetadataGet(DistributorMessageSender& sender,
+                                                           const api::GetReply& reply,
+                                                           bool replicasConsistent)
+{
+    LOG(debug, "Update(%s): got metadata Get reply with code %s, replicas %s",
+        _updateCmd->getDocumentId().toString().c_str(),
+        reply.getResult().toString().c_str(),
+        replicasConsistent ? "consistent" : "inconsistent");
+
+    if (!reply.getResult().success()) {
+        sendReplyWithResult(sender, reply.getResult());
+        return;
+    }
+    if (!replicasConsistent) {
+        sendSafePathGets(sender, "[all]", SendState::GETS_SENT);
+        return;
+    }
+    if (lostBucketOwnershipBetweenPhases()) {
+        sendLostOwnershipTransientErrorReply(sender);
+        return;
+    }
+    LOG(debug, "Update(%s): replicas are consistent, restarting with fast path",
+        _updateCmd->getDocumentId().toString().c_str());
+    startFastPathUpdate(sender);
+}
+
 void
 TwoPhaseUpdateOperation::handleSafePathReceivedGet(DistributorMessageSender& sender, api::GetReply& reply)
 {
@@ -74,6 +74,7 @@ private:
     enum class SendState {
         NONE_SENT,
         UPDATES_SENT,
+        METADATA_GETS_SENT,
         GETS_SENT,
         PUTS_SENT,
     };
@@ -94,6 +95,8 @@ private:
     bool isFastPathPossible() const;
     void startFastPathUpdate(DistributorMessageSender&);
     void startSafePathUpdate(DistributorMessageSender&);
+    bool mayRestartWithFastPath() const;
+    void sendSafePathGets(DistributorMessageSender&, const char* fieldSet, SendState);
     bool lostBucketOwnershipBetweenPhases() const;
     void sendLostOwnershipTransientErrorReply(DistributorMessageSender&);
     void schedulePutsWithUpdatedDocument(
@@ -107,6 +110,9 @@ private:
                                const std::shared_ptr<api::StorageReply>&);
     void handleSafePathReceive(DistributorMessageSender&,
                                const std::shared_ptr<api::StorageReply>&);
+    void handleSafePathReceivedMetadataGet(DistributorMessageSender&,
+                                           const api::GetReply&,
+                                           bool replicasConsistent);
     void handleSafePathReceivedGet(DistributorMessageSender&,
                                    api::GetReply&);
     void handleSafePathReceivedPut(DistributorMessageSender&,
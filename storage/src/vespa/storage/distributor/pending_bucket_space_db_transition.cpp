@@ -5,6 +5,7 @@
 #include "pendingclusterstate.h"
 #include "distributor_bucket_space.h"
 #include <vespa/storage/common/bucketoperationlogger.h>
+#include <vespa/vdslib/distribution/ideal_nodes_cache.h>
 #include <algorithm>
 
 #include <vespa/log/log.h>
@@ -24,8 +25,10 @@ PendingBucketSpaceDbTransition::PendingBucketSpaceDbTransition(const PendingClus
                                                                const lib::ClusterState &newClusterState,
                                                                api::Timestamp creationTimestamp)
     : _entries(),
+      _sortedRunEnds(),
       _iter(0),
       _removedBuckets(),
+      _changedBuckets(),
       _missingEntries(),
       _clusterInfo(std::move(clusterInfo)),
       _outdatedNodes(newClusterState.getNodeCount(NodeType::STORAGE)),
@@ -34,6 +37,7 @@ PendingBucketSpaceDbTransition::PendingBucketSpaceDbTransition(const PendingClus
       _creationTimestamp(creationTimestamp),
       _pendingClusterState(pendingClusterState),
       _distributorBucketSpace(distributorBucketSpace),
+      _idealNodesCache(),
       _distributorIndex(_clusterInfo->getDistributorIndex()),
       _bucketOwnershipTransfer(distributionChanged)
 {
@@ -67,6 +71,28 @@ PendingBucketSpaceDbTransition::skipAllForSameBucket()
     return r;
 }
 
+void
+PendingBucketSpaceDbTransition::mergeSortedRuns()
+{
+    while (_sortedRunEnds.size() > 1) {
+        std::vector<uint32_t> mergedRunEnds;
+        mergedRunEnds.reserve((_sortedRunEnds.size() + 1) / 2);
+        uint32_t runStart = 0;
+        for (uint32_t i = 0; i < _sortedRunEnds.size(); i += 2) {
+            if (i + 1 < _sortedRunEnds.size()) {
+                std::inplace_merge(_entries.begin() + runStart,
+                                   _entries.begin() + _sortedRunEnds[i],
+                                   _entries.begin() + _sortedRunEnds[i + 1]);
+                runStart = _sortedRunEnds[i + 1];
+            } else {
+                runStart = _sortedRunEnds[i];
+            }
+            mergedRunEnds.push_back(runStart);
+        }
+        _sortedRunEnds.swap(mergedRunEnds);
+    }
+}
+
 std::vector<BucketCopy>
 PendingBucketSpaceDbTransition::getCopiesThatAreNewOrAltered(BucketDatabase::Entry& info, const Range& range)
 {
@@ -82,16 +108,18 @@ PendingBucketSpaceDbTransition::getCopiesThatAreNewOrAltered(BucketDatabase::Ent
     return copiesToAdd;
 }
 
-void
+bool
 PendingBucketSpaceDbTransition::insertInfo(BucketDatabase::Entry& info, const Range& range)
 {
     std::vector<BucketCopy> copiesToAddOrUpdate(
             getCopiesThatAreNewOrAltered(info, range));
 
-    const auto &dist(_distributorBucketSpace.getDistribution());
+    if (!_idealNodesCache) {
+        _idealNodesCache = std::make_unique<lib::IdealNodesCache>(
+                _distributorBucketSpace.getDistribution(), _newClusterState);
+    }
     std::vector<uint16_t> order(
-            dist.getIdealStorageNodes(
-                    _newClusterState,
+            _idealNodesCache->getIdealStorageNodes(
                     _entries[range.first].bucketId,
                     _clusterInfo->getStorageUpStates()));
     info->addNodes(copiesToAddOrUpdate, order, TrustedUpdate::DEFER);
@@ -100,6 +128,7 @@ PendingBucketSpaceDbTransition::insertInfo(BucketDatabase::Entry& info, const Ra
             _entries[range.first].bucketId,
             vespalib::make_string("insertInfo: %s",
                                         info.toString().c_str()));
+    return !copiesToAddOrUpdate.empty();
 }
 
 std::string
@@ -169,12 +198,13 @@ PendingBucketSpaceDbTransition::process(BucketDatabase::Entry& e)
     }
 
     bool updated(removeCopiesFromNodesThatWereRequested(e, bucketId));
+    bool changed(updated);
 
     if (bucketInfoIteratorPointsToBucket(bucketId)) {
         LOG(spam, "Updating bucket %s",
             _entries[_iter].bucketId.toString().c_str());
 
-        insertInfo(e, skipAllForSameBucket());
+        changed = insertInfo(e, skipAllForSameBucket()) || changed;
         updated = true;
     }
 
@@ -184,6 +214,9 @@ PendingBucketSpaceDbTransition::process(BucketDatabase::Entry& e)
             _removedBuckets.push_back(bucketId);
         } else {
             e.getBucketInfo().updateTrusted();
+            if (changed) {
+                _changedBuckets.push_back(bucketId);
+            }
         }
     }
 
@@ -212,13 +245,14 @@ PendingBucketSpaceDbTransition::addToBucketDB(BucketDatabase& db, const Range& r
     }
     e.getBucketInfo().updateTrusted();
     db.update(e);
+    _changedBuckets.push_back(e.getBucketId());
 }
 
 void
 PendingBucketSpaceDbTransition::mergeIntoBucketDatabase()
 {
     BucketDatabase &db(_distributorBucketSpace.getBucketDatabase());
-    std::sort(_entries.begin(), _entries.end());
+    mergeSortedRuns();
 
     db.forEach(*this);
 
@@ -240,12 +274,19 @@ PendingBucketSpaceDbTransition::mergeIntoBucketDatabase()
 void
 PendingBucketSpaceDbTransition::onRequestBucketInfoReply(const api::RequestBucketInfoReply &reply, uint16_t node)
 {
-    for (const auto &entry : reply.getBucketInfo()) {
+    const auto &bucketInfo(reply.getBucketInfo());
+    const size_t runStart = _entries.size();
+    _entries.reserve(runStart + bucketInfo.size());
+    for (const auto &entry : bucketInfo) {
         _entries.emplace_back(entry._bucketId,
                               BucketCopy(_creationTimestamp,
                                          node,
                                          entry._info));
     }
+    // Sort each reply as it arrives, so that only a merge of the sorted
+    // runs remains to be done when switching to the pending state.
+    std::sort(_entries.begin() + runStart, _entries.end());
+    _sortedRunEnds.push_back(_entries.size());
 }
 
 bool
@@ -416,6 +457,7 @@ void
 PendingBucketSpaceDbTransition::addNodeInfo(const document::BucketId& id, const BucketCopy& copy)
 {
     _entries.emplace_back(id, copy);
+    _sortedRunEnds.push_back(_entries.size());
 }
 
 }
@@ -4,9 +4,10 @@
 #include "pending_bucket_space_db_transition_entry.h"
 #include "outdated_nodes.h"
 #include <vespa/storage/bucketdb/bucketdatabase.h>
+#include <memory>
 
 namespace storage::api { class RequestBucketInfoReply; }
-namespace storage::lib { class ClusterState; class State; }
+namespace storage::lib { class ClusterState; class IdealNodesCache; class State; }
 
 namespace storage::distributor {
 
@@ -29,8 +30,14 @@ private:
     using Range = std::pair<uint32_t, uint32_t>;
 
     EntryList                                 _entries;
+    // End offsets of the individually sorted runs of _entries, one run
+    // per reply received. Runs are merged when applying to the database.
+    std::vector<uint32_t>                     _sortedRunEnds;
     uint32_t                                  _iter;
     std::vector<document::BucketId>           _removedBuckets;
+    // Buckets that got replicas added, altered or removed when merged into
+    // the database.
+    std::vector<document::BucketId>           _changedBuckets;
     std::vector<Range>                        _missingEntries;
     std::shared_ptr<const ClusterInformation> _clusterInfo;
 
@@ -46,6 +53,8 @@ private:
     const api::Timestamp                      _creationTimestamp;
     const PendingClusterState                &_pendingClusterState;
     DistributorBucketSpace                   &_distributorBucketSpace;
+    // Ideal nodes in the new cluster state, created on first use.
+    std::unique_ptr<lib::IdealNodesCache>     _idealNodesCache;
     uint16_t                                  _distributorIndex;
     bool                                      _bucketOwnershipTransfer;
 
@@ -59,8 +68,16 @@ private:
      */
     Range skipAllForSameBucket();
 
+    /**
+     * Merges all sorted runs of _entries into a single sorted run. Merging
+     * k runs of n entries in total is O(n log k), which is cheaper than
+     * sorting all entries from scratch once all replies have arrived.
+     */
+    void mergeSortedRuns();
+
     std::vector<BucketCopy> getCopiesThatAreNewOrAltered(BucketDatabase::Entry& info, const Range& range);
-    void insertInfo(BucketDatabase::Entry& info, const Range& range);
+    // Returns whether any replica was added or had its info altered.
+    bool insertInfo(BucketDatabase::Entry& info, const Range& range);
     void addToBucketDB(BucketDatabase& db, const Range& range);
 
     bool nodeIsOutdated(uint16_t node) const {
@@ -107,6 +124,7 @@ public:
 
     const OutdatedNodes &getOutdatedNodes() { return _outdatedNodes; }
     bool getBucketOwnershipTransfer() const { return _bucketOwnershipTransfer; }
+    const std::vector<document::BucketId>& getChangedBuckets() const { return _changedBuckets; }
 
     // Methods used by unit tests.
     const EntryList& results() const { return _entries; }
@@ -114,10 +114,17 @@ PendingMessageTracker::reply(const api::StorageReply& r)
 
     if (iter != msgs.end()) {
         bucket = iter->bucket;
-        _nodeInfo.decPending(r.getAddress()->getIndex());
+        const uint16_t node = r.getAddress()->getIndex();
+        _nodeInfo.decPending(node);
         api::ReturnCode::Result code = r.getResult().getResult();
         if (code == api::ReturnCode::BUSY || code == api::ReturnCode::TIMEOUT) {
-            _nodeInfo.setBusy(r.getAddress()->getIndex(), _nodeBusyDuration);
+            _nodeInfo.setBusy(node, _nodeBusyDuration);
+            _nodeInfo.backOff(node);
+        } else {
+            const TimePoint now = currentTime();
+            if (now >= iter->timeStamp) {
+                _nodeInfo.addLatencySample(node, now - iter->timeStamp);
+            }
         }
         LOG(debug, "Erased message with id %zu", msgId);
         msgs.erase(msgId);
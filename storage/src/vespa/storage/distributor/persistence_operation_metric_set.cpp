@@ -28,7 +28,9 @@ PersistenceFailuresMetricSet::PersistenceFailuresMetricSet(MetricSet* owner)
                           "being in an inconsistent state or not found", this),
       notfound("notfound", "", "The number of operations that failed because the document did not exist", this),
       concurrent_mutations("concurrent_mutations", "", "The number of operations that were transiently failed due "
-                           "to a mutating operation already being in progress for its document ID", this)
+                           "to a mutating operation already being in progress for its document ID", this),
+      node_saturated("node_saturated", "", "The number of operations that were transiently failed due "
+                     "to a target content node being at its adaptive limit of pending messages", this)
 {
     sum.addMetricToSum(notready);
     sum.addMetricToSum(notconnected);
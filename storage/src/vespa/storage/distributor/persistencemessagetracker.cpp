@@ -4,6 +4,7 @@
 #include <vespa/storage/common/vectorprinter.h>
 #include <vespa/storage/common/bucketoperationlogger.h>
 #include <vespa/storageapi/message/persistence.h>
+#include <vespa/vespalib/trace/latency_trace.h>
 #include "distributor_bucket_space_repo.h"
 #include "distributor_bucket_space.h"
 
@@ -267,7 +268,8 @@ PersistenceMessageTrackerImpl::sendReply(MessageSender& sender)
     updateMetrics();
     _trace.setStrict(false);
     _reply->getTrace().getRoot().addChild(_trace);
-    
+    vespalib::LatencyTrace::add(_reply->getTrace(), "distributor", _requestTimer.getElapsedTimeAsDouble());
+
     sender.sendReply(_reply);
     _reply = std::shared_ptr<api::BucketInfoReply>();
 }
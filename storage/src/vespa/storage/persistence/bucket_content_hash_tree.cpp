@@ -0,0 +1,136 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "bucket_content_hash_tree.h"
+#include <algorithm>
+#include <cassert>
+
+namespace storage {
+
+namespace {
+
+// Bijective 64-bit mix function (splitmix64 finalizer), so that the sum
+// of entry hashes does not cancel out for similar timestamps.
+uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t entryHash(const BucketContentHashTree::Entry& entry) {
+    return mix(entry._timestamp ^ mix(entry._flags));
+}
+
+}
+
+BucketContentHashTree::BucketContentHashTree(const std::vector<Entry>& entries)
+    : _timestamps(),
+      _prefixHash()
+{
+    std::vector<const Entry*> sorted;
+    sorted.reserve(entries.size());
+    for (const Entry& entry : entries) {
+        sorted.push_back(&entry);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const Entry* lhs, const Entry* rhs) { return (lhs->_timestamp < rhs->_timestamp); });
+    _timestamps.reserve(sorted.size());
+    _prefixHash.reserve(sorted.size() + 1);
+    _prefixHash.push_back(0);
+    for (const Entry* entry : sorted) {
+        _timestamps.push_back(entry->_timestamp);
+        _prefixHash.push_back(_prefixHash.back() + entryHash(*entry));
+    }
+}
+
+BucketContentHashTree::~BucketContentHashTree() = default;
+
+std::vector<BucketContentHashTree::Range>
+BucketContentHashTree::split(const Range& range, uint32_t fanOut)
+{
+    assert(fanOut >= 2);
+    std::vector<Range> result;
+    const uint64_t step = ((range.last - range.first) / fanOut) + 1;
+    api::Timestamp first = range.first;
+    while (true) {
+        api::Timestamp last = ((range.last - first) < step) ? range.last : (first + step - 1);
+        result.emplace_back(first, last);
+        if (last == range.last) {
+            break;
+        }
+        first = last + 1;
+    }
+    return result;
+}
+
+std::pair<size_t, size_t>
+BucketContentHashTree::bounds(const Range& range) const
+{
+    auto begin = std::lower_bound(_timestamps.begin(), _timestamps.end(), range.first);
+    auto end = std::upper_bound(begin, _timestamps.end(), range.last);
+    return std::make_pair(begin - _timestamps.begin(), end - _timestamps.begin());
+}
+
+uint64_t
+BucketContentHashTree::hash(const Range& range) const
+{
+    auto b = bounds(range);
+    return (_prefixHash[b.second] - _prefixHash[b.first]);
+}
+
+uint32_t
+BucketContentHashTree::count(const Range& range) const
+{
+    auto b = bounds(range);
+    return (b.second - b.first);
+}
+
+std::vector<BucketContentHashTree::Range>
+BucketContentHashTree::findDifferingRanges(const BucketContentHashTree& a,
+                                           const BucketContentHashTree& b,
+                                           uint32_t maxLeafEntries,
+                                           uint32_t fanOut)
+{
+    std::vector<Range> result;
+    std::vector<Range> pending;
+    pending.push_back(rootRange());
+    while (!pending.empty()) {
+        Range range = pending.back();
+        pending.pop_back();
+        uint32_t countA = a.count(range);
+        uint32_t countB = b.count(range);
+        if ((countA == countB) && (a.hash(range) == b.hash(range))) {
+            continue;
+        }
+        if (((countA <= maxLeafEntries) && (countB <= maxLeafEntries)) || (range.first == range.last)) {
+            result.push_back(range);
+            continue;
+        }
+        // Push in reverse, so that ranges are visited (and reported) in
+        // timestamp order.
+        std::vector<Range> children = split(range, fanOut);
+        pending.insert(pending.end(), children.rbegin(), children.rend());
+    }
+    return result;
+}
+
+std::vector<BucketContentHashTree::Entry>
+BucketContentHashTree::entriesInRanges(const std::vector<Entry>& entries,
+                                       const std::vector<Range>& ranges)
+{
+    std::vector<Entry> result;
+    auto iter = entries.begin();
+    for (const Range& range : ranges) {
+        iter = std::lower_bound(iter, entries.end(), range.first,
+                                [](const Entry& entry, api::Timestamp ts) { return (entry._timestamp < ts); });
+        while ((iter != entries.end()) && (iter->_timestamp <= range.last)) {
+            result.push_back(*iter);
+            ++iter;
+        }
+    }
+    return result;
+}
+
+}
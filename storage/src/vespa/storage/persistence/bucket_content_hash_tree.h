@@ -0,0 +1,89 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * Hierarchical (Merkle style) hash over the merge metadata of a bucket
+ * replica, that is the timestamp and remove flag of every entry.
+ *
+ * The timestamp space is split into a fixed tree of ranges, where each
+ * range is split into a fixed number of equally wide sub ranges. Since the
+ * ranges only depend on the timestamps, and not on the content of a
+ * replica, two replicas can compare the hashes of the same ranges top down
+ * and only descend into ranges where the hashes differ. This finds the
+ * few ranges where replicas differ without exchanging metadata for every
+ * entry in the bucket, after which only the entries in those ranges need
+ * to be diffed.
+ *
+ * The hash of a range is the sum of the hashes of the entries in it, so
+ * the hash of any range is found in O(log n) time from prefix sums over
+ * the timestamp sorted entries.
+ */
+#pragma once
+
+#include <vespa/storageapi/message/bucket.h>
+#include <limits>
+#include <vector>
+
+namespace storage {
+
+class BucketContentHashTree {
+public:
+    using Entry = api::GetBucketDiffCommand::Entry;
+
+    // Inclusive timestamp range [first, last].
+    struct Range {
+        api::Timestamp first;
+        api::Timestamp last;
+
+        Range(api::Timestamp first_, api::Timestamp last_) : first(first_), last(last_) {}
+        bool operator==(const Range& rhs) const {
+            return ((first == rhs.first) && (last == rhs.last));
+        }
+    };
+
+    static constexpr uint32_t DefaultFanOut = 16;
+
+    /**
+     * Builds the tree from the given entries. The entries do not have to
+     * be sorted. The node mask of the entries is not part of the hash.
+     */
+    explicit BucketContentHashTree(const std::vector<Entry>& entries);
+    ~BucketContentHashTree();
+
+    static Range rootRange() { return Range(0, std::numeric_limits<api::Timestamp>::max()); }
+
+    /**
+     * Splits the given range into (at most) fanOut equally wide sub ranges.
+     * Splitting only depends on the range itself.
+     */
+    static std::vector<Range> split(const Range& range, uint32_t fanOut);
+
+    uint64_t hash(const Range& range) const;
+    uint32_t count(const Range& range) const;
+    size_t size() const { return _timestamps.size(); }
+
+    /**
+     * Compares the hashes of the two trees top down and returns the
+     * smallest ranges having different content, descending into ranges
+     * containing more than maxLeafEntries entries in either tree. Only
+     * empty or single timestamp ranges are never split further.
+     */
+    static std::vector<Range> findDifferingRanges(const BucketContentHashTree& a,
+                                                  const BucketContentHashTree& b,
+                                                  uint32_t maxLeafEntries,
+                                                  uint32_t fanOut = DefaultFanOut);
+
+    /**
+     * Returns the entries of the given (timestamp sorted) list that fall
+     * within any of the given ranges, as returned by findDifferingRanges.
+     */
+    static std::vector<Entry> entriesInRanges(const std::vector<Entry>& entries,
+                                              const std::vector<Range>& ranges);
+
+private:
+    std::pair<size_t, size_t> bounds(const Range& range) const;
+
+    std::vector<api::Timestamp> _timestamps;
+    // _prefixHash[i] is the sum of the hashes of the first i entries.
+    std::vector<uint64_t> _prefixHash;
+};
+
+}
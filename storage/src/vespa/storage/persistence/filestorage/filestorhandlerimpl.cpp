@@ -15,6 +15,7 @@
 #include <vespa/storageapi/message/batch.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/trace/latency_trace.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".persistence.filestor.handler.impl");
@@ -291,6 +292,7 @@ FileStorHandlerImpl::updateMetrics(const MetricLockGuard &)
         vespalib::MonitorGuard lockGuard(_mergeStatesLock);
         disk.metrics->pendingMerges.addValue(_mergeStates.size());
         disk.metrics->queueSize.addValue(disk.getQueueSize());
+        disk.metrics->latency.update();
 
         for (auto & entry : disk.metrics->averageQueueWaitingTime.getMetricMap()) {
             metrics::LoadType loadType(entry.first, "ignored");
@@ -340,6 +342,30 @@ FileStorHandlerImpl::tryHandlePause(uint16_t disk) const
     return true;
 }
 
+FileStorHandlerImpl::OperationClass
+FileStorHandlerImpl::operationClassOf(const api::StorageMessage& msg)
+{
+    switch (msg.getType().getId()) {
+    case api::MessageType::PUT_ID:
+    case api::MessageType::REMOVE_ID:
+    case api::MessageType::UPDATE_ID:
+    case api::MessageType::REVERT_ID:
+        return OperationClass::FEED;
+    case api::MessageType::GET_ID:
+        return OperationClass::READ;
+    case api::MessageType::INTERNAL_ID:
+        switch (static_cast<const api::InternalCommand&>(msg).getType()) {
+        case CreateIteratorCommand::ID:
+        case GetIterCommand::ID:
+            return OperationClass::READ;
+        default:
+            return OperationClass::MAINTENANCE;
+        }
+    default:
+        return OperationClass::MAINTENANCE;
+    }
+}
+
 bool
 FileStorHandlerImpl::messageTimedOutInQueue(const api::StorageMessage& msg, uint64_t waitTime)
 {
@@ -842,12 +868,27 @@ FileStorHandlerImpl::sendReply(const std::shared_ptr<api::StorageReply>& msg)
     _messageSender.sendReply(msg);
 }
 
+namespace {
+
+FileStorHandlerImpl::Clock::time_point
+queueDeadline(const api::StorageMessage& msg)
+{
+    if (msg.getType().isReply()) {
+        return FileStorHandlerImpl::Clock::time_point::max(); // Replies cannot time out.
+    }
+    return FileStorHandlerImpl::Clock::now()
+           + std::chrono::milliseconds(static_cast<const api::StorageCommand&>(msg).getTimeout());
+}
+
+}
+
 FileStorHandlerImpl::MessageEntry::MessageEntry(const std::shared_ptr<api::StorageMessage>& cmd,
                                                 const document::Bucket &bucket)
     : _command(cmd),
       _timer(),
       _bucket(bucket),
-      _priority(cmd->getPriority())
+      _priority(cmd->getPriority()),
+      _deadline(queueDeadline(*cmd))
 { }
 
 
@@ -855,7 +896,8 @@ FileStorHandlerImpl::MessageEntry::MessageEntry(const MessageEntry& entry)
     : _command(entry._command),
       _timer(entry._timer),
       _bucket(entry._bucket),
-      _priority(entry._priority)
+      _priority(entry._priority),
+      _deadline(entry._deadline)
 { }
 
 
@@ -863,7 +905,8 @@ FileStorHandlerImpl::MessageEntry::MessageEntry(MessageEntry && entry) noexcept
     : _command(std::move(entry._command)),
       _timer(entry._timer),
       _bucket(entry._bucket),
-      _priority(entry._priority)
+      _priority(entry._priority),
+      _deadline(entry._deadline)
 { }
 
 FileStorHandlerImpl::MessageEntry::~MessageEntry() { }
@@ -917,31 +960,128 @@ FileStorHandlerImpl::Disk::schedule(const std::shared_ptr<api::StorageMessage>&
 
 FileStorHandlerImpl::Stripe::Stripe(const FileStorHandlerImpl & owner, MessageSender & messageSender)
     : _owner(owner),
-      _messageSender(messageSender)
+      _messageSender(messageSender),
+      _classPass(),
+      _virtualTime(0)
 { }
+
+namespace {
+
+// Relative cost of serving one operation of each class. A class with
+// stride N gets 1/N of the share of a class with stride 1 when both
+// have operations ready to run.
+constexpr uint64_t OperationClassStride[FileStorHandlerImpl::NumOperationClasses] = {
+    2, // FEED
+    1, // READ
+    4  // MAINTENANCE
+};
+
+// Number of queue entries looked at past the first runnable one when
+// searching for runnable operations of the other classes.
+constexpr uint32_t MaxSchedulingLookahead = 256;
+
+}
+
+FileStorHandlerImpl::PriorityIdx::iterator
+FileStorHandlerImpl::Stripe::selectNextRunnable(const vespalib::MonitorGuard & guard, PriorityIdx & idx,
+                                                std::vector<std::shared_ptr<api::StorageReply>> & expired)
+{
+    const Clock::time_point now = Clock::now();
+    std::array<PriorityIdx::iterator, NumOperationClasses> candidates;
+    candidates.fill(idx.end());
+    size_t found = 0;
+    uint32_t lookahead = 0;
+    PriorityIdx::iterator iter(idx.begin());
+    while ((iter != idx.end()) && (found < NumOperationClasses) && (lookahead < MaxSchedulingLookahead)) {
+        if (iter->_deadline <= now) {
+            // Drop expired operations as soon as they are seen, whether or
+            // not their bucket is locked, instead of executing them later.
+            expired.emplace_back(makeQueueTimeoutReply(*iter->_command));
+            iter = idx.erase(iter);
+            continue;
+        }
+        if (found > 0) {
+            ++lookahead;
+        }
+        if (!isLocked(guard, iter->_bucket)) {
+            auto opClass = static_cast<size_t>(operationClassOf(*iter->_command));
+            if (candidates[opClass] == idx.end()) {
+                candidates[opClass] = iter;
+                ++found;
+            }
+        }
+        ++iter;
+    }
+    // Pick the class with the earliest virtual start time, breaking ties
+    // by operation priority.
+    size_t best = NumOperationClasses;
+    uint64_t bestStart = 0;
+    for (size_t i = 0; i < NumOperationClasses; ++i) {
+        if (candidates[i] == idx.end()) {
+            continue;
+        }
+        uint64_t start = std::max(_classPass[i], _virtualTime);
+        if ((best == NumOperationClasses) || (start < bestStart) ||
+            ((start == bestStart) && (candidates[i]->_priority < candidates[best]->_priority)))
+        {
+            best = i;
+            bestStart = start;
+        }
+    }
+    if (best == NumOperationClasses) {
+        return idx.end();
+    }
+    _virtualTime = bestStart;
+    _classPass[best] = bestStart + OperationClassStride[best];
+    return candidates[best];
+}
+
 FileStorHandler::LockedMessage
 FileStorHandlerImpl::Stripe::getNextMessage(uint32_t timeout, Disk & disk)
 {
     vespalib::MonitorGuard guard(_lock);
+    std::vector<std::shared_ptr<api::StorageReply>> expired;
+    FileStorHandler::LockedMessage result;
+    bool guardReleased = false;
     // Try to grab a message+lock, immediately retrying once after a wait
     // if none can be found and then exiting if the same is the case on the
     // second attempt. This is key to allowing the run loop to register
     // ticks at regular intervals while not busy-waiting.
     for (int attempt = 0; (attempt < 2) && ! disk.isClosed() && !_owner.isPaused(); ++attempt) {
         PriorityIdx& idx(bmi::get<1>(_queue));
-        PriorityIdx::iterator iter(idx.begin()), end(idx.end());
-
-        while (iter != end && isLocked(guard, iter->_bucket)) {
-            iter++;
-        }
-        if (iter != end) {
-            return getMessage(guard, idx, iter);
+        PriorityIdx::iterator iter = selectNextRunnable(guard, idx, expired);
+        if (iter != idx.end()) {
+            result = getMessage(guard, idx, iter); // Releases the guard.
+            guardReleased = true;
+            break;
         }
         if (attempt == 0) {
+            if (!expired.empty()) {
+                guard.broadcast();
+            }
             guard.wait(timeout);
         }
     }
-    return {}; // No message fetched.
+    if (!expired.empty()) {
+        if (!guardReleased) {
+            guard.broadcast();
+            guard.unlock();
+        }
+        for (auto & reply : expired) {
+            _messageSender.sendReply(reply);
+        }
+    }
+    return result;
+}
+
+void
+FileStorHandlerImpl::Stripe::updateQueueWaitMetrics(api::StorageMessage & msg, uint64_t waitTime)
+{
+    _metrics->averageQueueWaitingTimeByClass[static_cast<size_t>(operationClassOf(msg))]->addValue(waitTime);
+    if (_metrics->diskLatency != nullptr) {
+        _metrics->diskLatency->recordQueueTime(msg, waitTime);
+    }
+    vespalib::LatencyTrace::add(msg.getTrace(), "persistence_queue", waitTime);
 }
 
 FileStorHandler::LockedMessage &
@@ -961,6 +1101,7 @@ FileStorHandlerImpl::Stripe::getNextMessage(FileStorHandler::LockedMessage& lck)
     api::StorageMessage & m(*range.first->_command);
 
     uint64_t waitTime(range.first->_timer.stop(_metrics->averageQueueWaitingTime[m.getLoadType()]));
+    updateQueueWaitMetrics(m, waitTime);
 
     if (!messageTimedOutInQueue(m, waitTime)) {
         std::shared_ptr<api::StorageMessage> msg = std::move(range.first->_command);
@@ -985,6 +1126,7 @@ FileStorHandlerImpl::Stripe::getMessage(vespalib::MonitorGuard & guard, Priority
 
     api::StorageMessage & m(*iter->_command);
     uint64_t waitTime(iter->_timer.stop(_metrics->averageQueueWaitingTime[m.getLoadType()]));
+    updateQueueWaitMetrics(m, waitTime);
 
     std::shared_ptr<api::StorageMessage> msg = std::move(iter->_command);
     document::Bucket bucket(iter->_bucket);
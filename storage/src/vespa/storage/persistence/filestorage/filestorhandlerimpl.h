@@ -29,7 +29,9 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <vespa/storage/common/messagesender.h>
 #include <vespa/vespalib/stllike/hash_map.h>
+#include <array>
 #include <atomic>
+#include <chrono>
 
 namespace storage {
 
@@ -46,12 +48,28 @@ class FileStorHandlerImpl : private framework::MetricUpdateHook,
 public:
     typedef FileStorHandler::DiskState DiskState;
     typedef FileStorHandler::RemapInfo RemapInfo;
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Operations are divided into scheduling classes. When operations from
+     * more than one class are ready to run in a stripe, the classes share
+     * the stripe's thread by weight, so that e.g. a backlog of merges cannot
+     * starve client gets. Within a class, operations run in priority order.
+     */
+    enum class OperationClass : uint8_t {
+        FEED = 0,
+        READ = 1,
+        MAINTENANCE = 2
+    };
+    static constexpr size_t NumOperationClasses = 3;
+    static OperationClass operationClassOf(const api::StorageMessage& msg);
 
     struct MessageEntry {
         std::shared_ptr<api::StorageMessage> _command;
         metrics::MetricTimer _timer;
         document::Bucket _bucket;
         uint8_t _priority;
+        Clock::time_point _deadline;
 
         MessageEntry(const std::shared_ptr<api::StorageMessage>& cmd, const document::Bucket &bId);
         MessageEntry(MessageEntry &&) noexcept ;
@@ -133,6 +151,9 @@ public:
         bool hasActive(vespalib::MonitorGuard & monitor, const AbortBucketOperationsCommand& cmd) const;
         FileStorHandler::LockedMessage getMessage(vespalib::MonitorGuard & guard, PriorityIdx & idx,
                                                   PriorityIdx::iterator iter);
+        PriorityIdx::iterator selectNextRunnable(const vespalib::MonitorGuard & guard, PriorityIdx & idx,
+                                                 std::vector<std::shared_ptr<api::StorageReply>> & expired);
+        void updateQueueWaitMetrics(api::StorageMessage & msg, uint64_t waitTime);
         typedef vespalib::hash_map<document::Bucket, LockEntry, document::Bucket::hash> LockedBuckets;
         const FileStorHandlerImpl  &_owner;
         MessageSender              &_messageSender;
@@ -140,6 +161,11 @@ public:
         vespalib::Monitor           _lock;
         PriorityQueue               _queue;
         LockedBuckets               _lockedBuckets;
+        // Start time fair queueing state for the operation classes: the
+        // virtual time at which each class may next be served, and the
+        // virtual time of the last dispatched operation.
+        std::array<uint64_t, NumOperationClasses> _classPass;
+        uint64_t                    _virtualTime;
     };
     struct Disk {
         FileStorDiskMetrics * metrics;
@@ -0,0 +1,256 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "filestorlatencymetrics.h"
+#include "filestorhandlerimpl.h"
+#include <vespa/storage/persistence/messages.h>
+#include <vespa/storageapi/message/internal.h>
+#include <cassert>
+#include <cmath>
+
+namespace storage {
+
+using metrics::MetricSet;
+
+LatencyHistogram::LatencyHistogram()
+    : _buckets()
+{
+    for (auto& bucket : _buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+LatencyHistogram::~LatencyHistogram() = default;
+
+uint64_t
+LatencyHistogram::drain(Counts& counts)
+{
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < NumBuckets; ++i) {
+        counts[i] = _buckets[i].exchange(0, std::memory_order_relaxed);
+        total += counts[i];
+    }
+    return total;
+}
+
+uint32_t
+LatencyHistogram::bucketOf(double ms)
+{
+    if (!(ms > 0.0)) {
+        return 0;
+    }
+    double us = ms * 1000.0;
+    if (us >= static_cast<double>(lowerBound(NumBuckets - 1))) {
+        return NumBuckets - 1;
+    }
+    uint64_t v = static_cast<uint64_t>(us);
+    if (v < SubBuckets) {
+        return v;
+    }
+    uint32_t msb = 63 - __builtin_clzll(v);
+    uint32_t shift = msb - 3;
+    return (shift + 1) * SubBuckets + ((v >> shift) - SubBuckets);
+}
+
+uint64_t
+LatencyHistogram::lowerBound(uint32_t bucket)
+{
+    if (bucket < SubBuckets) {
+        return bucket;
+    }
+    return (SubBuckets + (bucket % SubBuckets)) << (bucket / SubBuckets - 1);
+}
+
+double
+LatencyHistogram::percentile(const Counts& counts, uint64_t total, double fraction)
+{
+    if (total == 0) {
+        return 0.0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * total));
+    rank = std::max(rank, uint64_t(1));
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < NumBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            uint64_t lower = lowerBound(i);
+            uint64_t upper = (i + 1 < NumBuckets) ? lowerBound(i + 1) : lower;
+            return (lower + upper) / 2000.0;
+        }
+    }
+    return lowerBound(NumBuckets - 1) / 1000.0;
+}
+
+LatencyPercentileMetrics::LatencyPercentileMetrics(const std::string& name, const std::string& description,
+                                                   MetricSet* owner)
+    : MetricSet(name, "", description, owner),
+      p50("p50", "", "50th percentile latency in ms within each update interval.", this),
+      p90("p90", "", "90th percentile latency in ms within each update interval.", this),
+      p99("p99", "", "99th percentile latency in ms within each update interval.", this),
+      p999("p999", "", "99.9th percentile latency in ms within each update interval.", this),
+      histogram()
+{ }
+
+LatencyPercentileMetrics::~LatencyPercentileMetrics() = default;
+
+void
+LatencyPercentileMetrics::update()
+{
+    LatencyHistogram::Counts counts;
+    uint64_t total = histogram.drain(counts);
+    if (total == 0) {
+        return;
+    }
+    p50.addValue(LatencyHistogram::percentile(counts, total, 0.50));
+    p90.addValue(LatencyHistogram::percentile(counts, total, 0.90));
+    p99.addValue(LatencyHistogram::percentile(counts, total, 0.99));
+    p999.addValue(LatencyHistogram::percentile(counts, total, 0.999));
+}
+
+OperationLatencyMetrics::OperationLatencyMetrics(const std::string& name, const std::string& description,
+                                                 MetricSet* owner)
+    : MetricSet(name, "", description, owner),
+      queue("queue", "Time spent in the filestor input queue.", this),
+      execute("execute", "Time spent processing in a persistence thread.", this)
+{ }
+
+OperationLatencyMetrics::~OperationLatencyMetrics() = default;
+
+void
+OperationLatencyMetrics::update()
+{
+    queue.update();
+    execute.update();
+}
+
+FileStorLatencyMetrics::OperationType
+FileStorLatencyMetrics::operationTypeOf(const api::StorageMessage& msg)
+{
+    switch (msg.getType().getId()) {
+    case api::MessageType::PUT_ID: return OperationType::PUT;
+    case api::MessageType::GET_ID: return OperationType::GET;
+    case api::MessageType::REMOVE_ID: return OperationType::REMOVE;
+    case api::MessageType::UPDATE_ID: return OperationType::UPDATE;
+    case api::MessageType::REVERT_ID: return OperationType::REVERT;
+    case api::MessageType::REMOVELOCATION_ID: return OperationType::REMOVE_LOCATION;
+    case api::MessageType::STATBUCKET_ID: return OperationType::STAT_BUCKET;
+    case api::MessageType::SPLITBUCKET_ID: return OperationType::SPLIT;
+    case api::MessageType::JOINBUCKETS_ID: return OperationType::JOIN;
+    case api::MessageType::MERGEBUCKET_ID:
+    case api::MessageType::GETBUCKETDIFF_ID:
+    case api::MessageType::APPLYBUCKETDIFF_ID:
+        return OperationType::MERGE;
+    case api::MessageType::CREATEBUCKET_ID:
+    case api::MessageType::DELETEBUCKET_ID:
+    case api::MessageType::SETBUCKETSTATE_ID:
+        return OperationType::BUCKET_MAINTENANCE;
+    case api::MessageType::INTERNAL_ID:
+        switch (static_cast<const api::InternalCommand&>(msg).getType()) {
+        case CreateIteratorCommand::ID:
+        case GetIterCommand::ID:
+            return OperationType::VISIT;
+        default:
+            return OperationType::BUCKET_MAINTENANCE;
+        }
+    default:
+        return OperationType::OTHER;
+    }
+}
+
+size_t
+FileStorLatencyMetrics::priorityBandOf(const api::StorageMessage& msg)
+{
+    api::StorageMessage::Priority pri = msg.getPriority();
+    if (pri < api::StorageMessage::HIGH) {
+        return 0;
+    } else if (pri < api::StorageMessage::NORMAL) {
+        return 1;
+    } else if (pri < api::StorageMessage::LOW) {
+        return 2;
+    }
+    return 3;
+}
+
+namespace {
+
+void
+addOperations(std::vector<std::unique_ptr<OperationLatencyMetrics>>& list, MetricSet& owner,
+              std::initializer_list<std::pair<const char*, const char*>> names)
+{
+    for (const auto& name : names) {
+        list.push_back(std::make_unique<OperationLatencyMetrics>(name.first, name.second, &owner));
+    }
+}
+
+}
+
+FileStorLatencyMetrics::FileStorLatencyMetrics(MetricSet* owner)
+    : MetricSet("latency", "", "Latency percentiles of queue and execute time in the persistence layer.", owner),
+      _byType("type", "", "Latency per operation type.", this),
+      _byClass("class", "", "Latency per operation scheduling class.", this),
+      _byPriority("priority", "", "Latency per priority band.", this),
+      _types(),
+      _classes(),
+      _priorities()
+{
+    addOperations(_types, _byType, {
+            {"put", "Put operations."},
+            {"get", "Get operations."},
+            {"remove", "Remove operations."},
+            {"update", "Update operations."},
+            {"revert", "Revert operations."},
+            {"removelocation", "Remove location operations."},
+            {"visit", "Iterator creation and visitor iteration."},
+            {"statbucket", "Stat bucket operations."},
+            {"split", "Bucket splits."},
+            {"join", "Bucket joins."},
+            {"merge", "Merge, get bucket diff and apply bucket diff operations."},
+            {"bucketmaintenance", "Bucket creation, deletion, activation and other internal bucket operations."},
+            {"other", "Operations of any other type."}});
+    addOperations(_classes, _byClass, {
+            {"feed", "Puts, removes, updates and reverts."},
+            {"read", "Gets and visitor iteration."},
+            {"maintenance", "Merges, splits, joins and other bucket maintenance."}});
+    addOperations(_priorities, _byPriority, {
+            {"veryhigh", "Operations with priority 0-49."},
+            {"high", "Operations with priority 50-126."},
+            {"normal", "Operations with priority 127-224."},
+            {"low", "Operations with priority 225-255."}});
+    assert(_types.size() == NumOperationTypes);
+    assert(_classes.size() == FileStorHandlerImpl::NumOperationClasses);
+    assert(_priorities.size() == NumPriorityBands);
+}
+
+FileStorLatencyMetrics::~FileStorLatencyMetrics() = default;
+
+template <typename Func>
+void
+FileStorLatencyMetrics::forEach(const api::StorageMessage& msg, Func func)
+{
+    func(*_types[static_cast<size_t>(operationTypeOf(msg))]);
+    func(*_classes[static_cast<size_t>(FileStorHandlerImpl::operationClassOf(msg))]);
+    func(*_priorities[priorityBandOf(msg)]);
+}
+
+void
+FileStorLatencyMetrics::recordQueueTime(const api::StorageMessage& msg, double ms)
+{
+    forEach(msg, [ms](OperationLatencyMetrics& m) { m.queue.record(ms); });
+}
+
+void
+FileStorLatencyMetrics::recordExecuteTime(const api::StorageMessage& msg, double ms)
+{
+    forEach(msg, [ms](OperationLatencyMetrics& m) { m.execute.record(ms); });
+}
+
+void
+FileStorLatencyMetrics::update()
+{
+    for (auto* list : {&_types, &_classes, &_priorities}) {
+        for (auto& metrics : *list) {
+            metrics->update();
+        }
+    }
+}
+
+}
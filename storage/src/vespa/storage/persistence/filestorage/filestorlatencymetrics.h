@@ -0,0 +1,114 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * @class storage::FileStorLatencyMetrics
+ * @ingroup filestorage
+ *
+ * @brief Latency percentiles for operations in the persistence layer.
+ *
+ * Queue time and execute time are recorded separately per operation type,
+ * per operation class and per priority band into lock free histograms.
+ * The histograms are drained into percentile metrics by the metric update
+ * hook, so the percentiles reported are those of each update interval.
+ */
+
+#pragma once
+
+#include <vespa/metrics/metrics.h>
+#include <array>
+#include <atomic>
+
+namespace storage {
+
+namespace api { class StorageMessage; }
+
+/**
+ * Log-linear histogram of latencies in microseconds, with 8 linear
+ * sub-buckets for each power of two, giving at most 12.5% relative error.
+ * Recording and draining only use relaxed atomics, so any number of
+ * threads may record while another drains.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint32_t SubBuckets = 8;
+    static constexpr uint32_t NumBuckets = 256;
+    using Counts = std::array<uint64_t, NumBuckets>;
+
+    LatencyHistogram();
+    ~LatencyHistogram();
+
+    void record(double ms) {
+        _buckets[bucketOf(ms)].fetch_add(1, std::memory_order_relaxed);
+    }
+    /** Moves the counts recorded so far into the given array. */
+    uint64_t drain(Counts& counts);
+
+    static uint32_t bucketOf(double ms);
+    /** Lower bound of a bucket, in microseconds. */
+    static uint64_t lowerBound(uint32_t bucket);
+    /** Latency in ms at the given fraction of the counts, as the bucket midpoint. */
+    static double percentile(const Counts& counts, uint64_t total, double fraction);
+private:
+    std::array<std::atomic<uint64_t>, NumBuckets> _buckets;
+};
+
+struct LatencyPercentileMetrics : metrics::MetricSet
+{
+    metrics::DoubleAverageMetric p50;
+    metrics::DoubleAverageMetric p90;
+    metrics::DoubleAverageMetric p99;
+    metrics::DoubleAverageMetric p999;
+    LatencyHistogram histogram;
+
+    LatencyPercentileMetrics(const std::string& name, const std::string& description, MetricSet* owner);
+    ~LatencyPercentileMetrics() override;
+
+    void record(double ms) { histogram.record(ms); }
+    void update();
+};
+
+struct OperationLatencyMetrics : metrics::MetricSet
+{
+    LatencyPercentileMetrics queue;
+    LatencyPercentileMetrics execute;
+
+    OperationLatencyMetrics(const std::string& name, const std::string& description, MetricSet* owner);
+    ~OperationLatencyMetrics() override;
+
+    void update();
+};
+
+class FileStorLatencyMetrics : public metrics::MetricSet
+{
+public:
+    enum class OperationType : uint8_t {
+        PUT, GET, REMOVE, UPDATE, REVERT, REMOVE_LOCATION, VISIT, STAT_BUCKET,
+        SPLIT, JOIN, MERGE, BUCKET_MAINTENANCE, OTHER
+    };
+    static constexpr size_t NumOperationTypes = 13;
+    static constexpr size_t NumPriorityBands = 4;
+
+    static OperationType operationTypeOf(const api::StorageMessage& msg);
+    static size_t priorityBandOf(const api::StorageMessage& msg);
+
+    explicit FileStorLatencyMetrics(MetricSet* owner);
+    ~FileStorLatencyMetrics() override;
+
+    void recordQueueTime(const api::StorageMessage& msg, double ms);
+    void recordExecuteTime(const api::StorageMessage& msg, double ms);
+    /** Called from the metric update hook to fold histograms into the percentiles. */
+    void update();
+
+private:
+    metrics::MetricSet _byType;
+    metrics::MetricSet _byClass;
+    metrics::MetricSet _byPriority;
+    // Indexed by OperationType, FileStorHandlerImpl::OperationClass and priority band.
+    std::vector<std::unique_ptr<OperationLatencyMetrics>> _types;
+    std::vector<std::unique_ptr<OperationLatencyMetrics>> _classes;
+    std::vector<std::unique_ptr<OperationLatencyMetrics>> _priorities;
+
+    template <typename Func>
+    void forEach(const api::StorageMessage& msg, Func func);
+};
+
+}
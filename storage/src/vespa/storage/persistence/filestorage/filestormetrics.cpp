@@ -169,7 +169,8 @@ FileStorThreadMetrics::FileStorThreadMetrics(const std::string& name, const std:
       mergeAverageDataReceivedNeeded("mergeavgdatareceivedneeded", "", "Amount of data transferred from previous node "
                                      "in chain that we needed to apply locally.", this),
       batchingSize("batchingsize", "", "Number of operations batched per bucket (only counts "
-                   "batches of size > 1)", this)
+                   "batches of size > 1)", this),
+      diskLatency(nullptr)
 { }
 
 FileStorThreadMetrics::~FileStorThreadMetrics() = default;
@@ -180,8 +181,17 @@ FileStorStripeMetrics::FileStorStripeMetrics(const std::string& name, const std:
       averageQueueWaitingTime(loadTypes,
                               metrics::DoubleAverageMetric("averagequeuewait", "",
                                                            "Average time an operation spends in input queue."),
-                              this)
+                              this),
+      averageQueueWaitingTimeByClass(),
+      diskLatency(nullptr)
 {
+    averageQueueWaitingTimeByClass.push_back(std::make_unique<metrics::DoubleAverageMetric>(
+            "averagequeuewaitfeed", "", "Average time a put, remove, update or revert spends in input queue.", this));
+    averageQueueWaitingTimeByClass.push_back(std::make_unique<metrics::DoubleAverageMetric>(
+            "averagequeuewaitread", "", "Average time a get or visitor iteration spends in input queue.", this));
+    averageQueueWaitingTimeByClass.push_back(std::make_unique<metrics::DoubleAverageMetric>(
+            "averagequeuewaitmaintenance", "", "Average time a merge, split, join or other bucket "
+            "maintenance operation spends in input queue.", this));
 }
 
 FileStorStripeMetrics::~FileStorStripeMetrics() = default;
@@ -200,7 +210,8 @@ FileStorDiskMetrics::FileStorDiskMetrics(const std::string& name, const std::str
       waitingForLockHitRate("waitingforlockrate", "",
               "Amount of times a filestor thread has needed to wait for "
               "lock to take next message in queue.", this),
-      lockWaitTime("lockwaittime", "", "Amount of time waiting used waiting for lock.", this)
+      lockWaitTime("lockwaittime", "", "Amount of time waiting used waiting for lock.", this),
+      latency(this)
 {
     pendingMerges.unsetOnZeroValue();
     waitingForLockHitRate.unsetOnZeroValue();
@@ -219,6 +230,7 @@ FileStorDiskMetrics::initDiskMetrics(const LoadTypeSet& loadTypes, uint32_t numS
         name << "thread" << i;
         desc << "Thread " << i << '/' << threadsPerDisk;
         threads[i] = std::make_shared<FileStorThreadMetrics>(name.str(), desc.str(), loadTypes);
+        threads[i]->diskLatency = &latency;
         registerMetric(*threads[i]);
         sumThreads.addMetricToSum(*threads[i]);
     }
@@ -230,6 +242,7 @@ FileStorDiskMetrics::initDiskMetrics(const LoadTypeSet& loadTypes, uint32_t numS
         name << "stripe" << i;
         desc << "Stripe " << i << '/' << numStripes;
         stripes[i] = std::make_shared<FileStorStripeMetrics>(name.str(), desc.str(), loadTypes);
+        stripes[i]->diskLatency = &latency;
         registerMetric(*stripes[i]);
         sumStripes.addMetricToSum(*stripes[i]);
     }
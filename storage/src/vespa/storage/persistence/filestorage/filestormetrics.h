@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "filestorlatencymetrics.h"
 #include <vespa/metrics/metrics.h>
 #include <vespa/documentapi/loadtypes/loadtypeset.h>
 
@@ -109,6 +110,8 @@ struct FileStorThreadMetrics : public metrics::MetricSet
     metrics::DoubleAverageMetric mergeDataWriteLatency;
     metrics::DoubleAverageMetric mergeAverageDataReceivedNeeded;
     metrics::LongAverageMetric batchingSize;
+    // Owned by the disk metrics, set by FileStorDiskMetrics::initDiskMetrics.
+    FileStorLatencyMetrics* diskLatency;
 
     FileStorThreadMetrics(const std::string& name, const std::string& desc, const metrics::LoadTypeSet& lt);
     ~FileStorThreadMetrics() override;
@@ -119,6 +122,10 @@ class FileStorStripeMetrics : public metrics::MetricSet
 public:
     using SP = std::shared_ptr<FileStorStripeMetrics>;
     metrics::LoadMetric<metrics::DoubleAverageMetric> averageQueueWaitingTime;
+    // Indexed by FileStorHandlerImpl::OperationClass.
+    std::vector<std::unique_ptr<metrics::DoubleAverageMetric>> averageQueueWaitingTimeByClass;
+    // Owned by the disk metrics, set by FileStorDiskMetrics::initDiskMetrics.
+    FileStorLatencyMetrics* diskLatency;
     FileStorStripeMetrics(const std::string& name, const std::string& description,
                           const metrics::LoadTypeSet& loadTypes);
     ~FileStorStripeMetrics() override;
@@ -138,6 +145,7 @@ public:
     metrics::LongAverageMetric pendingMerges;
     metrics::DoubleAverageMetric waitingForLockHitRate;
     metrics::DoubleAverageMetric lockWaitTime;
+    FileStorLatencyMetrics latency;
 
     FileStorDiskMetrics(const std::string& name, const std::string& description,
                         const metrics::LoadTypeSet& loadTypes, MetricSet* owner);
@@ -10,6 +10,7 @@
 #include <vespa/document/update/documentupdate.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/util/exceptions.h>
+#include <chrono>
 
 #include <vespa/log/bufferedlogger.h>
 LOG_SETUP(".persistence.thread");
@@ -825,6 +826,7 @@ PersistenceThread::processMessage(api::StorageMessage& msg)
 
         try {
             int64_t startTime(_component->getClock().getTimeInMillis().getTime());
+            auto executeStart = std::chrono::steady_clock::now();
 
             LOG(debug, "Handling command: %s", msg.toString().c_str());
             LOG(spam, "Message content: %s", msg.toString(true).c_str());
@@ -840,6 +842,10 @@ PersistenceThread::processMessage(api::StorageMessage& msg)
                     ++_env._metrics.failedOperations;
                 }
             }
+            if (_env._metrics.diskLatency != nullptr) {
+                std::chrono::duration<double, std::milli> executeTime(std::chrono::steady_clock::now() - executeStart);
+                _env._metrics.diskLatency->recordExecuteTime(msg, executeTime.count());
+            }
 
             int64_t stopTime(_component->getClock().getTimeInMillis().getTime());
             if (stopTime - startTime >= _warnOnSlowOperations) {
@@ -874,6 +880,16 @@ bool isBatchable(const api::StorageMessage& msg)
             msg.getType().getId() == api::MessageType::REVERT_ID);
 }
 
+// Puts without a test-and-set condition can be sent to the provider
+// together, as none of them depend on the outcome of the others.
+bool isUnconditionalPut(const api::StorageMessage& msg)
+{
+    return (msg.getType().getId() == api::MessageType::PUT_ID &&
+            !static_cast<const api::PutCommand&>(msg).getCondition().isPresent());
+}
+
+constexpr size_t MaxPutBatchSize = 64;
+
 bool hasBucketInfo(const api::StorageMessage& msg)
 {
     return (isBatchable(msg) ||
@@ -942,6 +958,79 @@ PersistenceThread::flushAllReplies(
     replies.clear();
 }
 
+void
+PersistenceThread::processPutBatch(FileStorHandler::LockedMessage & lock, const document::Bucket& bucket,
+                                   std::vector<MessageTracker::UP>& trackers)
+{
+    // Coalesce all unconditional puts queued back to back for this bucket.
+    // Leaves the first message that does not fit in the batch in the lock.
+    std::vector<std::shared_ptr<api::PutCommand>> puts;
+    do {
+        puts.push_back(std::static_pointer_cast<api::PutCommand>(lock.second));
+        _env._fileStorHandler.getNextMessage(_env._partition, _stripeId, lock);
+    } while (lock.second && (puts.size() < MaxPutBatchSize) && isUnconditionalPut(*lock.second));
+
+    std::vector<MessageTracker::UP> batchTrackers;
+    std::vector<size_t> batchIndexes;
+    spi::PutBatch batch;
+    batch.reserve(puts.size());
+    for (size_t i = 0; i < puts.size(); ++i) {
+        api::PutCommand& cmd(*puts[i]);
+        MBUS_TRACE(cmd.getTrace(), 5, "PersistenceThread: Processing message in persistence layer");
+        ++_env._metrics.operations;
+        auto& metrics = _env._metrics.put[cmd.getLoadType()];
+        metrics.request_size.addValue(cmd.getApproxByteSize());
+        batchTrackers.push_back(std::make_unique<MessageTracker>(metrics, _env._component.getClock()));
+        try {
+            getBucket(cmd.getDocumentId(), bucket);
+            batch.emplace_back(spi::Timestamp(cmd.getTimestamp()), cmd.getDocument());
+            batchIndexes.push_back(i);
+        } catch (std::exception& e) {
+            batchTrackers[i]->fail(api::ReturnCode::INTERNAL_FAILURE, e.what());
+        }
+    }
+    if (!batch.empty()) {
+        LOG(spam, "Sending batch of %zu puts to provider for bucket %s",
+            batch.size(), bucket.getBucketId().toString().c_str());
+        try {
+            spi::Bucket b(bucket, spi::PartitionId(_env._partition));
+            std::vector<spi::Result> results(_spi.putMultiple(b, batch, _context));
+            assert(results.size() == batch.size());
+            for (size_t i = 0; i < results.size(); ++i) {
+                checkForError(results[i], *batchTrackers[batchIndexes[i]]);
+            }
+        } catch (std::exception& e) {
+            for (size_t index : batchIndexes) {
+                batchTrackers[index]->fail(api::ReturnCode::INTERNAL_FAILURE, e.what());
+            }
+        }
+    }
+
+    bool anySucceeded = false;
+    for (size_t i = 0; i < puts.size(); ++i) {
+        batchTrackers[i]->generateReply(*puts[i]);
+        if (batchTrackers[i]->getReply()->getResult().failed()) {
+            ++_env._metrics.failedOperations;
+        } else {
+            anySucceeded = true;
+        }
+    }
+    // Fetch the bucket info and update the bucket database once for the
+    // whole batch rather than once per put.
+    if (anySucceeded) {
+        api::BucketInfo info = _env.getBucketInfo(bucket);
+        _env.updateBucketDatabase(bucket, info);
+        for (auto& tracker : batchTrackers) {
+            if (tracker->getReply()->getResult().success()) {
+                static_cast<api::BucketInfoReply&>(*tracker->getReply()).setBucketInfo(info);
+            }
+        }
+    }
+    for (auto& tracker : batchTrackers) {
+        trackers.push_back(std::move(tracker));
+    }
+}
+
 void PersistenceThread::processMessages(FileStorHandler::LockedMessage & lock)
 {
     std::vector<MessageTracker::UP> trackers;
@@ -950,6 +1039,10 @@ void PersistenceThread::processMessages(FileStorHandler::LockedMessage & lock)
     while (lock.second) {
         LOG(debug, "Inside while loop %d, nodeIndex %d, ptr=%p", _env._partition, _env._nodeIndex, lock.second.get());
         std::shared_ptr<api::StorageMessage> msg(lock.second);
+        if (isUnconditionalPut(*msg)) {
+            processPutBatch(lock, bucket, trackers);
+            continue;
+        }
         bool batchable = isBatchable(*msg);
 
         // If the next operation wasn't batchable, we should flush
@@ -77,6 +77,8 @@ private:
 
     MessageTracker::UP processMessage(api::StorageMessage& msg);
     void processMessages(FileStorHandler::LockedMessage & lock);
+    void processPutBatch(FileStorHandler::LockedMessage & lock, const document::Bucket& bucket,
+                         std::vector<MessageTracker::UP>& trackers);
 
     // Thread main loop
     void run(framework::ThreadHandle&) override;
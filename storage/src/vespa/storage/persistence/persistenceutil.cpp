@@ -3,6 +3,7 @@
 #include "persistenceutil.h"
 #include <vespa/config/config.h>
 #include <vespa/config/helper/configgetter.hpp>
+#include <vespa/vespalib/trace/latency_trace.h>
 
 #include <vespa/log/bufferedlogger.h>
 LOG_SETUP(".persistence.util");
@@ -51,6 +52,7 @@ MessageTracker::generateReply(api::StorageCommand& cmd)
         _reply.reset(cmd.makeReply().release());
         _reply->setResult(_result);
     }
+    vespalib::LatencyTrace::add(_reply->getTrace(), "persistence_execute", _timer.getElapsedTimeAsDouble());
 
     if (!_reply->getResult().success()) {
         ++_metric.failed;
@@ -82,6 +82,18 @@ ProviderErrorWrapper::put(const spi::Bucket& bucket,
     return checkResult(_impl.put(bucket, ts, doc, context));
 }
 
+std::vector<spi::Result>
+ProviderErrorWrapper::putMultiple(const spi::Bucket& bucket,
+                                  const spi::PutBatch& puts,
+                                  spi::Context& context)
+{
+    std::vector<spi::Result> results(_impl.putMultiple(bucket, puts, context));
+    for (const auto& result : results) {
+        checkResult(result);
+    }
+    return results;
+}
+
 spi::RemoveResult
 ProviderErrorWrapper::remove(const spi::Bucket& bucket,
                                 spi::Timestamp ts,
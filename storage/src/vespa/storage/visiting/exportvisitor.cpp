@@ -0,0 +1,87 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "exportvisitor.h"
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/documentapi/messagebus/messages/visitor.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/compressor.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".visitor.instance.exportvisitor");
+
+using vespalib::compression::CompressionConfig;
+
+namespace storage {
+
+ExportVisitor::ExportVisitor(StorageComponent& component, const vdslib::Parameters& params)
+    : Visitor(component),
+      _batchSize(params.get("batchsize", uint64_t(4 * 1024 * 1024))),
+      _compression(CompressionConfig::toType(vespalib::string(params.get("compression", vespalib::stringref("ZSTD"))).c_str()),
+                   params.get("compressionlevel", uint32_t(3)), 100),
+      _batches()
+{
+}
+
+ExportVisitor::~ExportVisitor() = default;
+
+void
+ExportVisitor::handleDocuments(const document::BucketId& bucketId,
+                               std::vector<spi::DocEntry::UP>& entries,
+                               HitCounter& hitCounter)
+{
+    LOG(debug, "Visitor %s handling block of %zu documents.",
+               _id.c_str(), entries.size());
+
+    Batch& batch(_batches[bucketId]);
+    for (const auto& entry : entries) {
+        if (entry->isRemove()) {
+            continue;
+        }
+        const document::Document* doc = entry->getDocument();
+        if (doc == nullptr) {
+            continue;
+        }
+        hitCounter.addHit(doc->getId(), entry->getDocumentSize());
+        doc->serialize(batch.data);
+        ++batch.documents;
+        if (batch.data.size() >= _batchSize) {
+            sendBatch(bucketId, batch, false);
+        }
+    }
+}
+
+void
+ExportVisitor::completedBucket(const document::BucketId& bucketId, HitCounter&)
+{
+    auto it = _batches.find(bucketId);
+    Batch batch;
+    if (it != _batches.end()) {
+        batch = std::move(it->second);
+        _batches.erase(it);
+    }
+    sendBatch(bucketId, batch, true);
+}
+
+void
+ExportVisitor::sendBatch(const document::BucketId& bucketId, Batch& batch, bool bucketCompleted)
+{
+    vespalib::ConstBufferRef serialized(batch.data.peek(), batch.data.size());
+    vespalib::DataBuffer compressed;
+    CompressionConfig::Type type = vespalib::compression::compress(_compression, serialized, compressed, false);
+
+    auto msg = std::make_unique<documentapi::MapVisitorMessage>();
+    vdslib::Parameters& data(msg->getData());
+    data.set("bucket", bucketId.getRawId());
+    data.set("documents", batch.documents);
+    data.set("compression", uint32_t(type));
+    data.set("uncompressedsize", uint64_t(serialized.size()));
+    data.set("bucketcompleted", bucketCompleted ? "true" : "false");
+    data.set("data", compressed.getData(), compressed.getDataLen());
+    LOG(spam, "Visitor %s sending batch of %u documents for %s, %zu bytes compressed to %zu.",
+        _id.c_str(), batch.documents, bucketId.toString().c_str(), serialized.size(), compressed.getDataLen());
+    batch.data.clear();
+    batch.documents = 0;
+    sendMessage(std::move(msg));
+}
+
+}
@@ -0,0 +1,72 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * @class storage::ExportVisitor
+ * @ingroup visitors
+ *
+ * @brief An export visitor is a visitor that sends the documents of each
+ * bucket to the client in large compressed batches.
+ *
+ * Each batch is a map visitor message holding the serialized documents
+ * back to back, compressed as one frame. Batches are cut when the
+ * serialized size reaches the batch size, and the last batch of each bucket
+ * is flagged, letting the client track which buckets are fully exported.
+ * Removes are not exported. Concurrency and backpressure are controlled by
+ * the usual visitor parameters for parallel buckets and pending messages.
+ *
+ * Visitor parameters:
+ *   batchsize        - Serialized bytes per batch (default 4 MiB).
+ *   compression      - Compression type name (default ZSTD).
+ *   compressionlevel - Compression level (default 3).
+ *
+ * Message data:
+ *   bucket           - Raw bucket id.
+ *   documents        - Number of documents in the batch.
+ *   compression      - Compression type of the data, NONE if it did not compress.
+ *   uncompressedsize - Size of the serialized documents.
+ *   bucketcompleted  - "true" for the last batch of a bucket.
+ *   data             - The (compressed) serialized documents.
+ */
+#pragma once
+
+#include "visitor.h"
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/compressionconfig.h>
+#include <map>
+
+namespace storage {
+
+class ExportVisitor : public Visitor {
+public:
+    ExportVisitor(StorageComponent&, const vdslib::Parameters& params);
+    ~ExportVisitor() override;
+
+private:
+    struct Batch {
+        vespalib::nbostream data;
+        uint32_t documents;
+        Batch() : data(), documents(0) { }
+    };
+
+    void handleDocuments(const document::BucketId&, std::vector<spi::DocEntry::UP>&, HitCounter&) override;
+    void completedBucket(const document::BucketId&, HitCounter&) override;
+    void sendBatch(const document::BucketId& bucketId, Batch& batch, bool bucketCompleted);
+
+    size_t _batchSize;
+    vespalib::compression::CompressionConfig _compression;
+    std::map<document::BucketId, Batch> _batches;
+};
+
+struct ExportVisitorFactory : public VisitorFactory {
+
+    VisitorEnvironment::UP
+    makeVisitorEnvironment(StorageComponent&) override {
+        return VisitorEnvironment::UP(new VisitorEnvironment);
+    };
+
+    Visitor*
+    makeVisitor(StorageComponent& c, VisitorEnvironment&, const vdslib::Parameters& params) override {
+        return new ExportVisitor(c, params);
+    }
+};
+
+}
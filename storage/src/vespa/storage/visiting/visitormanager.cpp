@@ -3,6 +3,7 @@
 #include "visitormanager.h"
 #include "messages.h"
 #include "dumpvisitorsingle.h"
+#include "exportvisitor.h"
 #include "countvisitor.h"
 #include "testvisitor.h"
 #include "recoveryvisitor.h"
@@ -55,6 +56,7 @@ VisitorManager::VisitorManager(const config::ConfigUri & configUri,
     _visitorFactories["dumpvisitorsingle"].reset(new DumpVisitorSingleFactory);
     _visitorFactories["testvisitor"].reset(new TestVisitorFactory);
     _visitorFactories["countvisitor"].reset(new CountVisitorFactory);
+    _visitorFactories["exportvisitor"].reset(new ExportVisitorFactory);
     _visitorFactories["recoveryvisitor"].reset(new RecoveryVisitorFactory);
     _component.registerStatusPage(*this);
 }
@@ -14,7 +14,10 @@
 #include <vespa/searchlib/fef/fef.h>
 #include <vespa/vespalib/geo/zcurve.h>
 #include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".visitor.instance.searchvisitor");
@@ -50,6 +53,22 @@ ForceWordfolderInit::ForceWordfolderInit()
 
 static ForceWordfolderInit _G_forceNormWordFolderInit;
 
+namespace {
+
+// Blocks with fewer documents are not worth spreading over threads
+constexpr size_t MIN_PREFETCH_DOCS = 64;
+constexpr uint32_t PREFETCH_THREADS = 4;
+
+vespalib::ThreadExecutor &
+getPrefetchExecutor()
+{
+    // Shared by all visitor threads
+    static vespalib::ThreadStackExecutor executor(PREFETCH_THREADS, 128 * 1024);
+    return executor;
+}
+
+}
+
 
 AttributeVector::SP
 createMultiValueAttribute(const vespalib::string & name, const document::FieldValue & fv, bool arrayType)
@@ -175,6 +194,7 @@ SearchVisitor::SearchVisitor(StorageComponent& component,
     _query(),
     _queryResult(new documentapi::QueryResultMessage()),
     _fieldSearcherMap(),
+    _searchedFields(),
     _docTypeMapping(),
     _fieldSearchSpecMap(),
     _snippetModifierManager(),
@@ -647,6 +667,12 @@ SearchVisitor::setupFieldSearchers(const std::vector<vespalib::string> & additio
 
     // prepare the field searchers
     _fieldSearcherMap.prepare(_fieldSearchSpecMap.documentTypeMap(), _searchBuffer, _query);
+
+    for (const vsm::FieldSearcherContainer & fSearch : _fieldSearcherMap) {
+        _searchedFields.push_back(fSearch->field());
+    }
+    std::sort(_searchedFields.begin(), _searchedFields.end());
+    _searchedFields.erase(std::unique(_searchedFields.begin(), _searchedFields.end()), _searchedFields.end());
 }
 
 void
@@ -885,9 +911,13 @@ SearchVisitor::handleDocuments(const document::BucketId&,
 
     const document::DocumentType* defaultDocType = _docTypeMapping.getDefaultDocumentType();
     assert(defaultDocType);
+    std::vector<StorageDocument::UP> documents;
+    documents.reserve(entries.size());
     for (const auto & entry : entries) {
-        StorageDocument::UP document(new StorageDocument(entry->releaseDocument(), _fieldPathMap, highestFieldNo));
-
+        documents.emplace_back(new StorageDocument(entry->releaseDocument(), _fieldPathMap, highestFieldNo));
+    }
+    prefetchSearchedFields(documents, *defaultDocType);
+    for (StorageDocument::UP & document : documents) {
         try {
             if (defaultDocType != nullptr
                 && !compatibleDocumentTypes(*defaultDocType, document->docDoc().getType()))
@@ -906,6 +936,45 @@ SearchVisitor::handleDocuments(const document::BucketId&,
     }
 }
 
+void
+SearchVisitor::prefetchSearchedFields(const std::vector<StorageDocument::UP> & documents,
+                                      const document::DocumentType & docType)
+{
+    if ((documents.size() < MIN_PREFETCH_DOCS) || _searchedFields.empty()) {
+        return;
+    }
+    auto prefetch = [this, &documents, &docType](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            StorageDocument & document = *documents[i];
+            if (compatibleDocumentTypes(docType, document.docDoc().getType())) {
+                try {
+                    document.prefetchFields(_searchedFields);
+                } catch (const std::exception &) {
+                    // Reported when the document is matched
+                }
+            }
+        }
+    };
+    // The visitor thread takes its own share
+    size_t numParts = PREFETCH_THREADS + 1;
+    size_t partSize = (documents.size() + numParts - 1) / numParts;
+    vespalib::CountDownLatch latch(numParts - 1);
+    for (size_t part = 1; part < numParts; ++part) {
+        size_t begin = std::min(part * partSize, documents.size());
+        size_t end = std::min(begin + partSize, documents.size());
+        vespalib::Executor::Task::UP rejected =
+            getPrefetchExecutor().execute(vespalib::makeLambdaTask([&prefetch, &latch, begin, end]() {
+                prefetch(begin, end);
+                latch.countDown();
+            }));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    prefetch(0, std::min(partSize, documents.size()));
+    latch.await();
+}
+
 bool
 SearchVisitor::handleDocument(StorageDocument & document)
 {
@@ -304,6 +304,14 @@ private:
     bool compatibleDocumentTypes(const document::DocumentType& typeA,
                                  const document::DocumentType& typeB) const;
 
+    /**
+     * Fetch the searched fields of a block of documents in parallel,
+     * so deserializing them is not done by the visitor thread alone.
+     * Matching and ranking still happen one document at a time.
+     */
+    void prefetchSearchedFields(const std::vector<vsm::StorageDocument::UP> & documents,
+                                const document::DocumentType & docType);
+
     /**
      * Process one document
      * @param document Document to process.
@@ -427,6 +435,7 @@ private:
     search::Query                           _query;
     std::unique_ptr<documentapi::QueryResultMessage>    _queryResult;
     vsm::FieldIdTSearcherMap                _fieldSearcherMap;
+    std::vector<vsm::FieldIdT>              _searchedFields;
     vsm::SharedFieldPathMap                 _fieldPathMap;
     vsm::DocumentTypeMapping                _docTypeMapping;
     vsm::FieldSearchSpecMap                 _fieldSearchSpecMap;
@@ -0,0 +1,49 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vbench/test/all.h>
+
+using namespace vbench;
+
+TEST("require that objects are provided in the order they were handled") {
+    Backlog<int> backlog;
+    backlog.handle(std::unique_ptr<int>(new int(1)));
+    backlog.handle(std::unique_ptr<int>(new int(2)));
+    EXPECT_EQUAL(2u, backlog.size());
+    EXPECT_EQUAL(1, *backlog.provide());
+    EXPECT_EQUAL(2, *backlog.provide());
+    EXPECT_EQUAL(0u, backlog.size());
+}
+
+TEST("require that closing drains the queue before providing empty objects") {
+    Backlog<int> backlog;
+    backlog.handle(std::unique_ptr<int>(new int(1)));
+    backlog.close();
+    backlog.handle(std::unique_ptr<int>(new int(2)));
+    EXPECT_EQUAL(1, *backlog.provide());
+    EXPECT_TRUE(backlog.provide().get() == 0);
+}
+
+TEST("require that discard removes queued objects") {
+    Backlog<int> backlog;
+    backlog.handle(std::unique_ptr<int>(new int(1)));
+    backlog.close();
+    backlog.discard();
+    EXPECT_TRUE(backlog.provide().get() == 0);
+}
+
+TEST_MT_FF("require that waiting threads are woken up", 2, Backlog<int>(), vespalib::Gate()) {
+    if (thread_id == 0) {
+        std::unique_ptr<int> obj = f1.provide();
+        ASSERT_TRUE(obj.get() != 0);
+        EXPECT_EQUAL(5, *obj);
+        EXPECT_TRUE(f1.provide().get() == 0);
+        f2.countDown();
+    } else {
+        f1.handle(std::unique_ptr<int>(new int(5)));
+        EXPECT_FALSE(f2.await(20));
+        f1.close();
+        EXPECT_TRUE(f2.await(20000));
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
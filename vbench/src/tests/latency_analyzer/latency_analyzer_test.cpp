@@ -33,4 +33,22 @@ TEST_FF("verify percentiles", RequestSink(), LatencyAnalyzer(f1)) {
     fprintf(stderr, "%s", stats.toString().c_str());
 }
 
+TEST_FF("require that latency can be measured from scheduled time", RequestSink(), LatencyAnalyzer(f1, true)) {
+    Request::UP req(new Request());
+    req->scheduledTime(1.0).startTime(3.0).endTime(3.5);
+    f2.handle(std::move(req));
+    EXPECT_APPROX(2.5, f2.getStats().min, 10e-6);
+    EXPECT_APPROX(2.5, f2.getStats().max, 10e-6);
+}
+
+TEST_FF("require that percentile distribution reaches the max latency", RequestSink(), LatencyAnalyzer(f1)) {
+    for (size_t i = 1; i <= 1000; ++i) {
+        post(0.001 * i, f2);
+    }
+    string dist = f2.getDistribution();
+    EXPECT_TRUE(dist.find("    0.500500 0.500000000000        500           2.00\n") != string::npos);
+    EXPECT_TRUE(dist.find("    1.000000 1.000000000000       1000            inf\n") != string::npos);
+    fprintf(stderr, "%s", dist.c_str());
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -19,4 +19,18 @@ TEST_FF("qps tagger", RequestReceptor(), QpsTagger(2.0, f1)) {
     EXPECT_APPROX(1.5, f1.request->scheduledTime(), 10e-6);
 }
 
+TEST_FF("qps tagger with poisson arrivals", RequestReceptor(), QpsTagger(100.0, f1, true)) {
+    double prev = -1.0;
+    for (size_t i = 0; i < 10000; ++i) {
+        f2.handle(Request::UP(new Request()));
+        ASSERT_TRUE(f1.request.get() != 0);
+        if (i == 0) {
+            EXPECT_EQUAL(0.0, f1.request->scheduledTime());
+        }
+        EXPECT_GREATER_EQUAL(f1.request->scheduledTime(), prev);
+        prev = f1.request->scheduledTime();
+    }
+    EXPECT_APPROX(100.0, prev, 5.0);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
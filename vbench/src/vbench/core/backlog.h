@@ -0,0 +1,43 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "handler.h"
+#include "provider.h"
+#include "closeable.h"
+#include <vespa/vespalib/util/sync.h>
+#include <vespa/vespalib/util/arrayqueue.hpp>
+
+namespace vbench {
+
+/**
+ * An unbounded queue connecting handled objects to the threads
+ * asking for them. Unlike the Dispatcher, objects are never handed
+ * to a fallback handler when all threads are busy; they wait in line
+ * until a thread is ready to take them. After the backlog is closed,
+ * incoming objects are discarded and threads asking for objects
+ * will get an empty object when the queue has been drained.
+ **/
+template <typename T>
+class Backlog : public Handler<T>,
+                public Provider<T>,
+                public Closeable
+{
+private:
+    vespalib::Monitor                          _monitor;
+    vespalib::ArrayQueue<std::unique_ptr<T> >  _queue;
+    bool                                       _closed;
+
+public:
+    Backlog();
+    ~Backlog();
+    size_t size() const;
+    void handle(std::unique_ptr<T> obj) override;
+    std::unique_ptr<T> provide() override;
+    void close() override;
+    void discard();
+};
+
+} // namespace vbench
+
+#include "backlog.hpp"
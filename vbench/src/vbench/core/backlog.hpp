@@ -0,0 +1,70 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+namespace vbench {
+
+template <typename T>
+Backlog<T>::Backlog()
+    : _monitor(),
+      _queue(),
+      _closed(false)
+{
+}
+
+template <typename T>
+Backlog<T>::~Backlog() {}
+
+template <typename T>
+size_t
+Backlog<T>::size() const
+{
+    vespalib::MonitorGuard guard(_monitor);
+    return _queue.size();
+}
+
+template <typename T>
+void
+Backlog<T>::handle(std::unique_ptr<T> obj)
+{
+    vespalib::MonitorGuard guard(_monitor);
+    if (!_closed) {
+        _queue.push(std::move(obj));
+        guard.signal();
+    }
+}
+
+template <typename T>
+std::unique_ptr<T>
+Backlog<T>::provide()
+{
+    vespalib::MonitorGuard guard(_monitor);
+    while (!_closed && _queue.empty()) {
+        guard.wait();
+    }
+    if (_queue.empty()) {
+        return std::unique_ptr<T>();
+    }
+    std::unique_ptr<T> obj(std::move(_queue.access(0)));
+    _queue.pop();
+    return obj;
+}
+
+template <typename T>
+void
+Backlog<T>::close()
+{
+    vespalib::MonitorGuard guard(_monitor);
+    _closed = true;
+    guard.broadcast();
+}
+
+template <typename T>
+void
+Backlog<T>::discard()
+{
+    vespalib::MonitorGuard guard(_monitor);
+    while (!_queue.empty()) {
+        _queue.pop();
+    }
+}
+
+} // namespace vbench
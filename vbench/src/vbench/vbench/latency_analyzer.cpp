@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "latency_analyzer.h"
+#include <algorithm>
 #include <cmath>
 
 namespace vbench {
@@ -42,8 +43,9 @@ LatencyAnalyzer::Stats::toString() const
     return str;
 }
 
-LatencyAnalyzer::LatencyAnalyzer(Handler<Request> &next)
+LatencyAnalyzer::LatencyAnalyzer(Handler<Request> &next, bool fromScheduledTime)
     : _next(next),
+      _fromScheduledTime(fromScheduledTime),
       _cnt(0),
       _min(0.0),
       _max(0.0),
@@ -56,7 +58,7 @@ void
 LatencyAnalyzer::handle(Request::UP request)
 {
     if (request->status() == Request::STATUS_OK) {
-        addLatency(request->latency());
+        addLatency(_fromScheduledTime ? request->scheduledLatency() : request->latency());
     }
     _next.handle(std::move(request));
 }
@@ -65,6 +67,7 @@ void
 LatencyAnalyzer::report()
 {
     fprintf(stdout, "%s\n", getStats().toString().c_str());
+    fprintf(stdout, "%s\n", getDistribution().c_str());
 }
 
 void
@@ -99,4 +102,26 @@ LatencyAnalyzer::getStats() const
     return stats;
 }
 
+string
+LatencyAnalyzer::getDistribution() const
+{
+    string str = strfmt("%12s %14s %10s %14s\n\n", "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+    if (_cnt == 0) {
+        return str;
+    }
+    // halve the distance to 100% for each step, with 5 ticks per half
+    double base = 0.0;
+    while ((100.0 / (100.0 - base)) <= (double)_cnt) {
+        double half = (100.0 - base) / 2.0;
+        for (size_t i = 0; i < 5; ++i) {
+            double per = base + (half * i) / 5.0;
+            size_t count = std::min((size_t)std::ceil((double)_cnt * (per / 100.0)), _cnt);
+            str += strfmt("%12.6f %14.12f %10zu %14.2f\n", getPercentile(per), per / 100.0, count, 100.0 / (100.0 - per));
+        }
+        base += half;
+    }
+    str += strfmt("%12.6f %14.12f %10zu %14s\n", _max, 1.0, _cnt, "inf");
+    return str;
+}
+
 } // namespace vbench
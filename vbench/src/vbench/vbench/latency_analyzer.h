@@ -8,12 +8,17 @@ namespace vbench {
 
 /**
  * Component picking up the latency of successful requests and
- * calculating relevant aggregated values.
+ * calculating relevant aggregated values. Latency is measured either
+ * from when the request was sent or from when it was scheduled to be
+ * sent; the latter includes any time spent waiting for a worker and
+ * should be used with open loop scheduling to avoid coordinated
+ * omission.
  **/
 class LatencyAnalyzer : public Analyzer
 {
 private:
     Handler<Request>    &_next;
+    bool                 _fromScheduledTime;
     size_t               _cnt;
     double               _min;
     double               _max;
@@ -34,11 +39,13 @@ public:
         Stats() : min(0), avg(0), max(0), per50(0), per95(0), per99(0) {}
         string toString() const;
     };
-    LatencyAnalyzer(Handler<Request> &next);
+    LatencyAnalyzer(Handler<Request> &next, bool fromScheduledTime = false);
     void handle(Request::UP request) override;
     void report() override;
     void addLatency(double latency);
     Stats getStats() const;
+    // percentile distribution in the text format used by HdrHistogram
+    string getDistribution() const;
 };
 
 } // namespace vbench
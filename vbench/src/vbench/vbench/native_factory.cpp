@@ -33,7 +33,7 @@ NativeFactory::createTagger(const vespalib::slime::Inspector &spec,
                                 spec["port"].asLong()), next));
     }
     if (type == "QpsTagger") {
-        return Tagger::UP(new QpsTagger(spec["qps"].asLong(), next));
+        return Tagger::UP(new QpsTagger(spec["qps"].asLong(), next, spec["poisson"].asBool()));
     }
     return Tagger::UP();
 }
@@ -44,7 +44,7 @@ NativeFactory::createAnalyzer(const vespalib::slime::Inspector &spec,
 {
     std::string type = spec["type"].asString().make_string();
     if (type == "LatencyAnalyzer") {
-        return Analyzer::UP(new LatencyAnalyzer(next));
+        return Analyzer::UP(new LatencyAnalyzer(next, spec["from_scheduled_time"].asBool()));
     }
     if (type == "QpsAnalyzer") {
         return Analyzer::UP(new QpsAnalyzer(next));
@@ -4,9 +4,13 @@
 
 namespace vbench {
 
-QpsTagger::QpsTagger(double qps, Handler<Request> &next)
+QpsTagger::QpsTagger(double qps, Handler<Request> &next, bool poisson)
     : _invQps(1.0/qps),
       _count(0),
+      _poisson(poisson),
+      _time(0.0),
+      _rnd(42),
+      _interval(qps),
       _next(next)
 {
 }
@@ -14,7 +18,12 @@ QpsTagger::QpsTagger(double qps, Handler<Request> &next)
 void
 QpsTagger::handle(Request::UP request)
 {
-    request->scheduledTime(((double)(_count++)) * _invQps);
+    if (_poisson) {
+        request->scheduledTime(_time);
+        _time += _interval(_rnd);
+    } else {
+        request->scheduledTime(((double)(_count++)) * _invQps);
+    }
     _next.handle(std::move(request));
 }
 
@@ -4,21 +4,28 @@
 
 #include "tagger.h"
 #include "request.h"
+#include <random>
 
 namespace vbench {
 
 /**
- * Sets the start time of requests based on a given qps.
+ * Sets the start time of requests based on a given qps. The requests
+ * are either evenly spaced or, with poisson arrivals, spaced by
+ * exponentially distributed intervals with the same average.
  **/
 class QpsTagger : public Tagger
 {
 private:
-    double            _invQps;
-    size_t            _count;
-    Handler<Request> &_next;
+    double                                 _invQps;
+    size_t                                 _count;
+    bool                                   _poisson;
+    double                                 _time;
+    std::mt19937                           _rnd;
+    std::exponential_distribution<double>  _interval;
+    Handler<Request>                      &_next;
 
 public:
-    QpsTagger(double qps, Handler<Request> &next);
+    QpsTagger(double qps, Handler<Request> &next, bool poisson = false);
     void handle(Request::UP request) override;
 };
 
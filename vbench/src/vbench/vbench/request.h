@@ -67,6 +67,10 @@ public:
 
     double latency() const { return (_endTime - _startTime); }
 
+    // latency including the time spent waiting to be sent after the
+    // scheduled time; what a client arriving on schedule would see
+    double scheduledLatency() const { return (_endTime - _scheduledTime); }
+
     void handleHeader(const string &name, const string &value) override;
     void handleContent(const Memory &data) override;
     void handleFailure(const string &reason) override;
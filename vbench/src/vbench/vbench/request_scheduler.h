@@ -6,6 +6,7 @@
 #include "dropped_tagger.h"
 #include <vbench/core/time_queue.h>
 #include <vbench/core/dispatcher.h>
+#include <vbench/core/backlog.h>
 #include <vbench/core/handler_thread.h>
 #include <vespa/vespalib/util/sync.h>
 #include <vespa/vespalib/util/active.h>
@@ -15,7 +16,10 @@ namespace vbench {
 /**
  * Component responsible for dispatching requests to workers at the
  * appropriate time based on what start time the requests are tagged
- * with.
+ * with. By default requests are dropped when all workers are busy. In
+ * open loop mode they are queued until a worker is available instead,
+ * so that the load offered does not depend on the response times of
+ * the system being tested.
  **/
 class RequestScheduler : public Handler<Request>,
                          public vespalib::Runnable,
@@ -27,6 +31,8 @@ private:
     TimeQueue<Request>      _queue;
     DroppedTagger           _droppedTagger;
     Dispatcher<Request>     _dispatcher;
+    Backlog<Request>        _backlog;
+    bool                    _openLoop;
     vespalib::Thread        _thread;
     HttpConnectionPool      _connectionPool;
     std::vector<Worker::UP> _workers;
@@ -34,7 +40,7 @@ private:
     void run() override;
 public:
     typedef std::unique_ptr<RequestScheduler> UP;
-    RequestScheduler(Handler<Request> &next, size_t numWorkers);
+    RequestScheduler(Handler<Request> &next, size_t numWorkers, bool openLoop = false);
     void abort();
     void handle(Request::UP request) override;
     void start() override;
@@ -0,0 +1,104 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vdslib/distribution/ideal_nodes_cache.h>
+#include <vespa/vdslib/distribution/distribution.h>
+#include <vespa/vdslib/state/clusterstate.h>
+#include <vespa/config-stor-distribution.h>
+#include <vespa/vdstestlib/cppunit/macros.h>
+
+namespace storage::lib {
+
+struct IdealNodesCacheTest : public CppUnit::TestFixture {
+
+    void testCachedResultsMatchDistribution();
+    void testBatchResultsMatchDistribution();
+    void testCacheIsDisabledWhenDiskIsDown();
+    void testTooFewBucketBitsIsStillRejected();
+
+    CPPUNIT_TEST_SUITE(IdealNodesCacheTest);
+    CPPUNIT_TEST(testCachedResultsMatchDistribution);
+    CPPUNIT_TEST(testBatchResultsMatchDistribution);
+    CPPUNIT_TEST(testCacheIsDisabledWhenDiskIsDown);
+    CPPUNIT_TEST(testTooFewBucketBitsIsStillRejected);
+    CPPUNIT_TEST_SUITE_END();
+
+    static std::vector<document::BucketId> makeBuckets() {
+        std::vector<document::BucketId> buckets;
+        for (uint32_t usedBits : {16u, 20u, 32u, 33u, 34u, 40u, 58u}) {
+            for (uint64_t i = 0; i < 500; ++i) {
+                uint64_t raw = (i * 0x9e3779b97f4a7c15ULL) ^ (i << 40);
+                buckets.emplace_back(usedBits, raw);
+            }
+        }
+        return buckets;
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(IdealNodesCacheTest);
+
+void
+IdealNodesCacheTest::testCachedResultsMatchDistribution()
+{
+    ClusterState state("distributor:10 storage:10 .3.s:d .5.c:0.5");
+    Distribution distr(Distribution::getDefaultDistributionConfig(3, 10));
+    IdealNodesCache cache(distr, state);
+    CPPUNIT_ASSERT(cache.enabled());
+
+    std::vector<document::BucketId> buckets(makeBuckets());
+    // Run twice, so that the second round is served from the cache.
+    for (uint32_t round = 0; round < 2; ++round) {
+        for (const document::BucketId& bucket : buckets) {
+            CPPUNIT_ASSERT_EQUAL(distr.getIdealStorageNodes(state, bucket, "uim"),
+                                 cache.getIdealStorageNodes(bucket, "uim"));
+            CPPUNIT_ASSERT_EQUAL(distr.getIdealStorageNodes(state, bucket, "ui"),
+                                 cache.getIdealStorageNodes(bucket, "ui"));
+        }
+    }
+    CPPUNIT_ASSERT(cache.hits() > cache.misses());
+    // Buckets split to 33 bits or less share entries with their 16 bit
+    // ancestor, so they do not add to the cache size.
+    CPPUNIT_ASSERT(cache.size() < 2 * buckets.size());
+}
+
+void
+IdealNodesCacheTest::testBatchResultsMatchDistribution()
+{
+    ClusterState state("distributor:10 storage:10");
+    Distribution distr(Distribution::getDefaultDistributionConfig(2, 10));
+    IdealNodesCache cache(distr, state);
+
+    std::vector<document::BucketId> buckets(makeBuckets());
+    std::vector<IdealNodesCache::NodeList> result;
+    cache.getIdealStorageNodes(buckets, result);
+    CPPUNIT_ASSERT_EQUAL(buckets.size(), result.size());
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(distr.getIdealStorageNodes(state, buckets[i]), result[i]);
+    }
+}
+
+void
+IdealNodesCacheTest::testCacheIsDisabledWhenDiskIsDown()
+{
+    ClusterState state("distributor:10 storage:10 .2.d:4 .2.d.1:d");
+    Distribution distr(Distribution::getDefaultDistributionConfig(3, 10));
+    IdealNodesCache cache(distr, state);
+    CPPUNIT_ASSERT(!cache.enabled());
+
+    for (const document::BucketId& bucket : makeBuckets()) {
+        CPPUNIT_ASSERT_EQUAL(distr.getIdealStorageNodes(state, bucket),
+                             cache.getIdealStorageNodes(bucket));
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(0), cache.size());
+}
+
+void
+IdealNodesCacheTest::testTooFewBucketBitsIsStillRejected()
+{
+    ClusterState state("bits:16 distributor:10 storage:10");
+    Distribution distr(Distribution::getDefaultDistributionConfig(3, 10));
+    IdealNodesCache cache(distr, state);
+    CPPUNIT_ASSERT_THROW(cache.getIdealStorageNodes(document::BucketId(8, 5)),
+                         TooFewBucketBitsInUseException);
+}
+
+}
@@ -620,6 +620,17 @@ Distribution::getIdealNodes(const NodeType& nodeType,
     }
 }
 
+uint64_t
+Distribution::getIdealStorageNodesKey(const document::BucketId& bucket,
+                                      const ClusterState& clusterState) const
+{
+    // The group seed only depends on the distribution bits, which are
+    // also part of the storage seed.
+    uint64_t distributionBits(static_cast<uint32_t>(bucket.getRawId())
+            & _distributionBitMasks[clusterState.getDistributionBitCount()]);
+    return ((static_cast<uint64_t>(getStorageSeed(bucket, clusterState)) << 32) | distributionBits);
+}
+
 Distribution::ConfigWrapper
 Distribution::getDefaultDistributionConfig(uint16_t redundancy, uint16_t nodeCount, DiskDistribution distr)
 {
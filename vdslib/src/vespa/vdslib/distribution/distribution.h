@@ -176,6 +176,15 @@ public:
                        const char* upStates = "uim",
                        uint16_t redundancy = DEFAULT_REDUNDANCY) const;
 
+    /**
+     * Returns a key identifying the bucket id bits that ideal storage node
+     * computation depends on. Buckets with equal keys have the same ideal
+     * storage nodes in a given cluster state, unless a disk is down on one
+     * of the nodes, as ideal disk selection depends on the whole bucket id.
+     */
+    uint64_t getIdealStorageNodesKey(const document::BucketId&,
+                                     const ClusterState&) const;
+
     /**
      * Unit tests can use this function to get raw config for this class to use
      * with a really simple setup with no hierarchical grouping. This function
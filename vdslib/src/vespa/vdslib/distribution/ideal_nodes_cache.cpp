@@ -0,0 +1,114 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "ideal_nodes_cache.h"
+#include "distribution.h"
+#include <vespa/vdslib/state/clusterstate.h>
+#include <vespa/vdslib/state/nodestate.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+
+namespace storage::lib {
+
+namespace {
+
+bool anyStorageDiskDown(const ClusterState& clusterState) {
+    for (uint16_t i = 0, n = clusterState.getNodeCount(NodeType::STORAGE); i < n; ++i) {
+        if (clusterState.getNodeState(Node(NodeType::STORAGE, i)).isAnyDiskDown()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+IdealNodesCache::IdealNodesCache(const Distribution& distribution, const ClusterState& clusterState)
+    : _distribution(distribution),
+      _clusterState(clusterState),
+      _enabled(!anyStorageDiskDown(clusterState)),
+      _cache(),
+      _hits(0),
+      _misses(0)
+{
+}
+
+IdealNodesCache::~IdealNodesCache() = default;
+
+uint32_t
+IdealNodesCache::upStatesMask(const char* upStates)
+{
+    // States are identified by a single lower case letter.
+    uint32_t mask = 0;
+    for (const char* c = upStates; *c != '\0'; ++c) {
+        mask |= (1u << (*c & 0x1f));
+    }
+    return mask;
+}
+
+bool
+IdealNodesCache::cacheable(const document::BucketId& bucket) const
+{
+    // Buckets using too few bits are left to the distribution to reject.
+    return (_enabled && (bucket.getUsedBits() >= _clusterState.getDistributionBitCount()));
+}
+
+IdealNodesCache::Key
+IdealNodesCache::makeKey(const document::BucketId& bucket, uint32_t upStates) const
+{
+    return Key{_distribution.getIdealStorageNodesKey(bucket, _clusterState), upStates};
+}
+
+const IdealNodesCache::NodeList&
+IdealNodesCache::lookup(const Key& key, const document::BucketId& bucket, const char* upStates)
+{
+    auto found = _cache.find(key);
+    if (found != _cache.end()) {
+        ++_hits;
+        return found->second;
+    }
+    ++_misses;
+    if (_cache.size() >= MaxEntries) {
+        _cache.clear();
+    }
+    NodeList nodes;
+    _distribution.getIdealNodes(NodeType::STORAGE, _clusterState, bucket, nodes, upStates);
+    return _cache.insert(std::make_pair(key, std::move(nodes))).first->second;
+}
+
+IdealNodesCache::NodeList
+IdealNodesCache::getIdealStorageNodes(const document::BucketId& bucket, const char* upStates)
+{
+    if (!cacheable(bucket)) {
+        return _distribution.getIdealStorageNodes(_clusterState, bucket, upStates);
+    }
+    return lookup(makeKey(bucket, upStatesMask(upStates)), bucket, upStates);
+}
+
+void
+IdealNodesCache::getIdealStorageNodes(const std::vector<document::BucketId>& buckets,
+                                      std::vector<NodeList>& result,
+                                      const char* upStates)
+{
+    result.clear();
+    result.reserve(buckets.size());
+    const uint32_t mask = upStatesMask(upStates);
+    bool havePrevious = false;
+    Key previous{0, 0};
+    for (const document::BucketId& bucket : buckets) {
+        if (!cacheable(bucket)) {
+            result.push_back(_distribution.getIdealStorageNodes(_clusterState, bucket, upStates));
+            havePrevious = false;
+            continue;
+        }
+        Key key(makeKey(bucket, mask));
+        if (havePrevious && (key == previous)) {
+            ++_hits;
+            result.push_back(result.back());
+        } else {
+            result.push_back(lookup(key, bucket, upStates));
+            previous = key;
+            havePrevious = true;
+        }
+    }
+}
+
+}
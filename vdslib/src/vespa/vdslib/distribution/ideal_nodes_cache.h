@@ -0,0 +1,79 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * Cache of ideal storage nodes for a fixed distribution and cluster state.
+ *
+ * Ideal storage nodes only depend on the distribution bits of a bucket, and
+ * for buckets split beyond 33 bits, on some of the upper bits as well. Most
+ * buckets in a cluster are split to about the same level, so a large share
+ * of the buckets seen by the distributor maps to already computed results.
+ * Entries are keyed on Distribution::getIdealStorageNodesKey() and the set of
+ * up states, so the cache must be recreated whenever the distribution or the
+ * cluster state changes.
+ *
+ * The cache is not thread safe.
+ */
+#pragma once
+
+#include <vespa/document/bucket/bucketid.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <vector>
+
+namespace storage::lib {
+
+class ClusterState;
+class Distribution;
+
+class IdealNodesCache {
+public:
+    using NodeList = std::vector<uint16_t>;
+
+    IdealNodesCache(const Distribution& distribution, const ClusterState& clusterState);
+    ~IdealNodesCache();
+
+    NodeList getIdealStorageNodes(const document::BucketId& bucket, const char* upStates = "uim");
+
+    /**
+     * Computes ideal storage nodes for all the given buckets in one call.
+     * Consecutive buckets sharing a cache key, such as siblings in bucket
+     * database order, are resolved with a single lookup.
+     */
+    void getIdealStorageNodes(const std::vector<document::BucketId>& buckets,
+                              std::vector<NodeList>& result,
+                              const char* upStates = "uim");
+
+    bool enabled() const { return _enabled; }
+    size_t size() const { return _cache.size(); }
+    uint64_t hits() const { return _hits; }
+    uint64_t misses() const { return _misses; }
+
+    static constexpr size_t MaxEntries = 1 << 20;
+
+private:
+    struct Key {
+        uint64_t _nodesKey;
+        uint32_t _upStates;
+
+        bool operator==(const Key& rhs) const {
+            return ((_nodesKey == rhs._nodesKey) && (_upStates == rhs._upStates));
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return (key._nodesKey * 0x9e3779b97f4a7c15ULL) ^ key._upStates;
+        }
+    };
+
+    bool cacheable(const document::BucketId& bucket) const;
+    Key makeKey(const document::BucketId& bucket, uint32_t upStates) const;
+    static uint32_t upStatesMask(const char* upStates);
+    const NodeList& lookup(const Key& key, const document::BucketId& bucket, const char* upStates);
+
+    const Distribution& _distribution;
+    const ClusterState& _clusterState;
+    const bool _enabled;
+    vespalib::hash_map<Key, NodeList, KeyHash> _cache;
+    uint64_t _hits;
+    uint64_t _misses;
+};
+
+}
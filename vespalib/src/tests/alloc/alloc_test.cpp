@@ -4,6 +4,10 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
 
 using namespace vespalib;
 using namespace vespalib::alloc;
@@ -246,4 +250,59 @@ TEST("auto alloced mmap alloc can not be shrinked below HUGEPAGE_SIZE/2 + 1 ") {
     EXPECT_EQUAL(SZ, buf.size());
 }
 
+TEST("huge page alloc uses heap for small buffers") {
+    Alloc buf = Alloc::allocHugePages(101);
+    EXPECT_EQUAL(101ul, buf.size());
+    EXPECT_FALSE(buf.resize_inplace(MemoryAllocator::HUGEPAGE_SIZE));
+    Alloc other = buf.create(102);
+    EXPECT_EQUAL(102ul, other.size());
+}
+
+TEST("huge page alloc gives aligned mmapped buffers") {
+    static constexpr size_t SZ = MemoryAllocator::HUGEPAGE_SIZE;
+    Alloc buf = Alloc::allocHugePages(SZ + 1);
+    EXPECT_EQUAL(SZ * 2, buf.size());
+    EXPECT_EQUAL(0ul, reinterpret_cast<uintptr_t>(buf.get()) & (SZ - 1));
+    memset(buf.get(), 0x55, buf.size());
+    Alloc other = buf.create(SZ * 3 - 1);
+    EXPECT_EQUAL(SZ * 3, other.size());
+    EXPECT_EQUAL(0ul, reinterpret_cast<uintptr_t>(other.get()) & (SZ - 1));
+}
+
+TEST("huge page alloc can be shrinked") {
+    static constexpr size_t SZ = MemoryAllocator::HUGEPAGE_SIZE;
+    Alloc buf = Alloc::allocHugePages(SZ * 2);
+    void * oldPtr = buf.get();
+    EXPECT_TRUE(buf.resize_inplace(SZ - 1));
+    EXPECT_EQUAL(oldPtr, buf.get());
+    EXPECT_EQUAL(SZ, buf.size());
+}
+
+TEST("mapped file is private copy on write memory") {
+    const char *fileName = "mapped_file.dat";
+    std::vector<char> content(3 * 4096, 'a');
+    memset(&content[4096], 'b', 4096);
+    FILE *fp = fopen(fileName, "w");
+    ASSERT_TRUE(fp != nullptr);
+    EXPECT_EQUAL(content.size(), fwrite(&content[0], 1, content.size(), fp));
+    fclose(fp);
+    {
+        Alloc buf = Alloc::allocMMapFile(fileName, 4096, 4096 + 100);
+        EXPECT_EQUAL(8192u, buf.size());
+        char *p = static_cast<char *>(buf.get());
+        EXPECT_EQUAL('b', p[0]);
+        EXPECT_EQUAL('a', p[4096 + 99]);
+        p[0] = 'c';
+        Alloc other = buf.create(4096);
+        EXPECT_EQUAL(4096u, other.size());
+    }
+    {
+        Alloc buf = Alloc::allocMMapFile(fileName, 4096, 4096);
+        EXPECT_EQUAL('b', static_cast<const char *>(buf.get())[0]);
+    }
+    EXPECT_EXCEPTION(Alloc::allocMMapFile(fileName, 100, 4096), IllegalArgumentException, "not page aligned");
+    EXPECT_EXCEPTION(Alloc::allocMMapFile("no_such_file.dat", 0, 4096), IllegalStateException, "Failed opening");
+    unlink(fileName);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
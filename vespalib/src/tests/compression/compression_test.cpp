@@ -3,6 +3,9 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstdcompressor.h>
+#include <vespa/vespalib/util/zstdstream.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/data/databuffer.h>
 
 #include <vespa/log/log.h>
@@ -40,6 +43,77 @@ TEST("requireThatZStdCompressFine") {
     EXPECT_EQUAL(64u, compressed.getDataLen());
 }
 
+vespalib::string
+makeDocument(uint32_t id)
+{
+    return make_string("{\"id\":\"id:music:music::%u\",\"title\":\"Title number %u\",\"artist\":\"Artist %u\","
+                       "\"year\":%u,\"genre\":\"rock\",\"label\":\"Record label %u\",\"popularity\":%u}",
+                       id, id * 7, id % 113, 1950 + (id % 70), id % 31, id % 100);
+}
+
+TEST("requireThatZStdDictionaryCompressesSmallDocumentsBetter") {
+    std::vector<char> samples;
+    std::vector<size_t> sampleSizes;
+    for (uint32_t id(0); id < 2000; id++) {
+        vespalib::string doc = makeDocument(id);
+        samples.insert(samples.end(), doc.begin(), doc.end());
+        sampleSizes.push_back(doc.size());
+    }
+    std::vector<char> data = ZStdDictionary::train(samples.data(), sampleSizes, 4096);
+    ASSERT_FALSE(data.empty());
+    EXPECT_GREATER_EQUAL(4096u, data.size());
+    ZStdDictionary dictionary(std::move(data));
+    EXPECT_NOT_EQUAL(0u, dictionary.getId());
+
+    vespalib::string doc = makeDocument(12345);
+    ConstBufferRef ref(doc.c_str(), doc.size());
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD, 9, 100);
+    ZStdCompressor plain;
+    DataBuffer plainCompressed;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(plain, cfg, ref, plainCompressed));
+    ZStdCompressor withDictionary(&dictionary);
+    DataBuffer compressed;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(withDictionary, cfg, ref, compressed));
+    EXPECT_LESS(compressed.getDataLen() * 2, plainCompressed.getDataLen());
+
+    DataBuffer decompressed;
+    decompress(withDictionary, doc.size(), ConstBufferRef(compressed.getData(), compressed.getDataLen()), decompressed, false);
+    EXPECT_EQUAL(doc, vespalib::string(decompressed.getData(), decompressed.getDataLen()));
+
+    CompressionConfig otherLevel(CompressionConfig::Type::ZSTD, 3, 100);
+    DataBuffer compressedOtherLevel;
+    EXPECT_EQUAL(CompressionConfig::Type::ZSTD, compress(withDictionary, otherLevel, ref, compressedOtherLevel));
+    DataBuffer decompressedOtherLevel;
+    decompress(withDictionary, doc.size(), ConstBufferRef(compressedOtherLevel.getData(), compressedOtherLevel.getDataLen()),
+               decompressedOtherLevel, false);
+    EXPECT_EQUAL(doc, vespalib::string(decompressedOtherLevel.getData(), decompressedOtherLevel.getDataLen()));
+}
+
+TEST("requireThatZStdStreamCompressesAcrossMessages") {
+    ZStdStreamCompressor compressor(3);
+    ZStdStreamDecompressor decompressor;
+    vespalib::string common;
+    for (uint32_t id(1000); id < 1050; id++) {
+        common += makeDocument(id);
+    }
+    size_t firstLen = 0;
+    for (uint32_t i(0); i < 10; i++) {
+        // Every message repeats most of the previous one.
+        vespalib::string doc = common + makeDocument(i);
+        std::vector<char> compressed(ZStdStreamCompressor::maxCompressedSize(doc.size()));
+        size_t len = compressor.compress(doc.c_str(), doc.size(), compressed.data(), compressed.size());
+        ASSERT_NOT_EQUAL(0u, len);
+        if (i == 0) {
+            firstLen = len;
+        } else {
+            EXPECT_LESS(len * 2, firstLen);
+        }
+        std::vector<char> decompressed(doc.size());
+        ASSERT_TRUE(decompressor.decompress(compressed.data(), len, decompressed.data(), decompressed.size()));
+        EXPECT_EQUAL(doc, vespalib::string(decompressed.data(), decompressed.size()));
+    }
+}
+
 TEST_MAIN() {
     TEST_RUN_ALL();
 }
@@ -0,0 +1,68 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/blockingthreadstackexecutor.h>
+#include <vespa/vespalib/util/lockfreethreadexecutor.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace vespalib;
+
+// Measures executor throughput when many threads post small tasks at
+// the same time, which is where a single executor lock gets contended.
+
+const uint32_t num_workers = 8;
+const uint32_t task_limit = 4096;
+const uint32_t tasks_per_producer = 200000;
+
+struct SmallTask : public Executor::Task {
+    std::atomic<uint64_t> &sum;
+    uint64_t value;
+    SmallTask(std::atomic<uint64_t> &sum_in, uint64_t value_in) : sum(sum_in), value(value_in) {}
+    void run() override { sum.fetch_add(value, std::memory_order_relaxed); }
+};
+
+double run_producers(ThreadExecutor &executor, uint32_t num_producers, std::atomic<uint64_t> &sum) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&executor, &sum]() {
+                for (uint32_t i = 0; i < tasks_per_producer; ++i) {
+                    Executor::Task::UP task = std::make_unique<SmallTask>(sum, 1);
+                    while ((task = executor.execute(std::move(task)))) {
+                        std::this_thread::yield(); // queue full
+                    }
+                }
+            });
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+    executor.sync();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+void benchmark(const char *name, ThreadExecutor &executor, uint32_t num_producers) {
+    std::atomic<uint64_t> sum(0);
+    double seconds = run_producers(executor, num_producers, sum);
+    EXPECT_EQUAL(uint64_t(num_producers) * tasks_per_producer, sum.load());
+    fprintf(stderr, "%-30s producers: %2u, %8.0f tasks/s\n", name, num_producers,
+            (num_producers * tasks_per_producer) / seconds);
+}
+
+TEST("benchmark executors with contended task posting") {
+    for (uint32_t num_producers: {1u, 4u, 16u}) {
+        {
+            BlockingThreadStackExecutor executor(num_workers, 128*1024, task_limit);
+            benchmark("BlockingThreadStackExecutor", executor, num_producers);
+        }
+        {
+            LockFreeThreadExecutor executor(num_workers, 128*1024, task_limit);
+            benchmark("LockFreeThreadExecutor", executor, num_producers);
+        }
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
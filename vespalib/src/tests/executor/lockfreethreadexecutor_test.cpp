@@ -0,0 +1,167 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/lockfreethreadexecutor.h>
+#include <vespa/vespalib/util/threadstackexecutorbase.h>
+#include <vespa/vespalib/util/sync.h>
+#include <vespa/vespalib/util/backtrace.h>
+#include <atomic>
+#include <thread>
+
+using namespace vespalib;
+
+typedef Executor::Task Task;
+
+struct BlockedTask : public Task {
+    Gate &gate;
+    CountDownLatch &latch;
+    std::atomic<uint32_t> &runCnt;
+    BlockedTask(Gate &g, CountDownLatch &l, std::atomic<uint32_t> &cnt) : gate(g), latch(l), runCnt(cnt) {}
+    void run() override {
+        latch.countDown();
+        gate.await();
+        runCnt.fetch_add(1);
+    }
+};
+
+struct CountTask : public Task {
+    std::atomic<uint32_t> &runCnt;
+    explicit CountTask(std::atomic<uint32_t> &cnt) : runCnt(cnt) {}
+    void run() override { runCnt.fetch_add(1); }
+};
+
+TEST("require that task limit is rounded up to a power of 2") {
+    EXPECT_EQUAL(2u, LockFreeThreadExecutor(1, 128*1024, 1).getTaskLimit());
+    EXPECT_EQUAL(16u, LockFreeThreadExecutor(1, 128*1024, 16).getTaskLimit());
+    EXPECT_EQUAL(32u, LockFreeThreadExecutor(1, 128*1024, 17).getTaskLimit());
+}
+
+TEST("require that tasks are rejected when the queue is full") {
+    Gate gate;
+    CountDownLatch latch(2);
+    std::atomic<uint32_t> runCnt(0);
+    LockFreeThreadExecutor executor(2, 128*1024, 4);
+    for (uint32_t i = 0; i < 2; ++i) {
+        EXPECT_TRUE(executor.execute(std::make_unique<BlockedTask>(gate, latch, runCnt)).get() == nullptr);
+    }
+    latch.await(); // both workers are busy
+    for (uint32_t i = 0; i < 4; ++i) {
+        EXPECT_TRUE(executor.execute(std::make_unique<CountTask>(runCnt)).get() == nullptr);
+    }
+    EXPECT_TRUE(executor.execute(std::make_unique<CountTask>(runCnt)).get() != nullptr);
+    LockFreeThreadExecutor::Stats stats = executor.getStats();
+    EXPECT_EQUAL(6u, stats.acceptedTasks);
+    EXPECT_EQUAL(1u, stats.rejectedTasks);
+    EXPECT_EQUAL(6u, stats.maxPendingTasks);
+    gate.countDown();
+    executor.sync();
+    EXPECT_EQUAL(6u, runCnt.load());
+    stats = executor.getStats();
+    EXPECT_EQUAL(0u, stats.acceptedTasks);
+    EXPECT_EQUAL(0u, stats.rejectedTasks);
+    EXPECT_EQUAL(6u, stats.maxPendingTasks); // reset to current pending count on previous observe
+    EXPECT_EQUAL(0u, executor.getStats().maxPendingTasks);
+}
+
+TEST("require that tasks are rejected after shutdown") {
+    std::atomic<uint32_t> runCnt(0);
+    LockFreeThreadExecutor executor(1, 128*1024, 16);
+    EXPECT_TRUE(executor.execute(std::make_unique<CountTask>(runCnt)).get() == nullptr);
+    executor.shutdown();
+    EXPECT_TRUE(executor.execute(std::make_unique<CountTask>(runCnt)).get() != nullptr);
+    executor.sync();
+    EXPECT_EQUAL(1u, runCnt.load());
+}
+
+TEST("require that sync waits for tasks posted from multiple threads") {
+    const uint32_t numProducers = 4;
+    const uint32_t numTasks = 100000;
+    std::atomic<uint32_t> runCnt(0);
+    std::atomic<uint32_t> acceptCnt(0);
+    LockFreeThreadExecutor executor(4, 128*1024, 256);
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < numProducers; ++p) {
+        producers.emplace_back([&]() {
+                for (uint32_t i = 0; i < numTasks; ++i) {
+                    if (executor.execute(std::make_unique<CountTask>(runCnt)).get() == nullptr) {
+                        acceptCnt.fetch_add(1);
+                    }
+                    if ((i % 1000) == 0) {
+                        executor.sync();
+                    }
+                }
+            });
+    }
+    for (auto &producer: producers) {
+        producer.join();
+    }
+    executor.sync();
+    EXPECT_EQUAL(acceptCnt.load(), runCnt.load());
+    EXPECT_EQUAL(acceptCnt.load(), executor.getStats().acceptedTasks);
+}
+
+TEST("require that destructor runs all accepted tasks") {
+    Gate gate;
+    CountDownLatch latch(1);
+    std::atomic<uint32_t> runCnt(0);
+    {
+        LockFreeThreadExecutor executor(1, 128*1024, 16);
+        executor.execute(std::make_unique<BlockedTask>(gate, latch, runCnt));
+        latch.await();
+        for (uint32_t i = 0; i < 10; ++i) {
+            executor.execute(std::make_unique<CountTask>(runCnt));
+        }
+        gate.countDown();
+    }
+    EXPECT_EQUAL(11u, runCnt.load());
+}
+
+TEST("require that tasks racing with shutdown are either rejected or run") {
+    for (uint32_t round = 0; round < 100; ++round) {
+        std::atomic<uint32_t> runCnt(0);
+        std::atomic<uint32_t> acceptCnt(0);
+        {
+            LockFreeThreadExecutor executor(2, 128*1024, 1024);
+            std::thread producer([&]() {
+                    for (uint32_t i = 0; i < 1000; ++i) {
+                        if (executor.execute(std::make_unique<CountTask>(runCnt)).get() == nullptr) {
+                            acceptCnt.fetch_add(1);
+                        }
+                    }
+                });
+            executor.shutdown();
+            producer.join();
+        }
+        EXPECT_EQUAL(acceptCnt.load(), runCnt.load());
+    }
+}
+
+vespalib::string get_worker_stack_trace(LockFreeThreadExecutor &executor) {
+    struct StackTraceTask : public Executor::Task {
+        vespalib::string &trace;
+        explicit StackTraceTask(vespalib::string &t) : trace(t) {}
+        void run() override { trace = getStackTrace(0); }
+    };
+    vespalib::string trace;
+    executor.execute(std::make_unique<StackTraceTask>(trace));
+    executor.sync();
+    return trace;
+}
+
+VESPA_THREAD_STACK_TAG(my_stack_tag);
+
+TEST_F("require that executor has appropriate default thread stack tag", LockFreeThreadExecutor(1, 128*1024, 10)) {
+    vespalib::string trace = get_worker_stack_trace(f1);
+    if (!EXPECT_TRUE(trace.find("unnamed_lockfree_executor") != vespalib::string::npos)) {
+        fprintf(stderr, "%s\n", trace.c_str());
+    }
+}
+
+TEST_F("require that executor thread stack tag can be set", LockFreeThreadExecutor(1, 128*1024, 10, my_stack_tag)) {
+    vespalib::string trace = get_worker_stack_trace(f1);
+    if (!EXPECT_TRUE(trace.find("my_stack_tag") != vespalib::string::npos)) {
+        fprintf(stderr, "%s\n", trace.c_str());
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
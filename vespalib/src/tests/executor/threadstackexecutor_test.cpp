@@ -5,6 +5,7 @@
 #include <vespa/vespalib/util/sync.h>
 #include <vespa/vespalib/util/backtrace.h>
 #include <atomic>
+#include <chrono>
 
 using namespace vespalib;
 
@@ -186,4 +187,76 @@ TEST_F("require that executor thread stack tag can be set", ThreadStackExecutor(
     }
 }
 
+struct BusyTask : public Executor::Task {
+    std::chrono::milliseconds duration;
+    explicit BusyTask(std::chrono::milliseconds duration_in) : duration(duration_in) {}
+    void run() override {
+        auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end) {}
+    }
+};
+
+TEST_F("require that executor accounts for task time", ThreadStackExecutor(2, 128*1024)) {
+    f1.getStats();
+    for (size_t i = 0; i < 10; ++i) {
+        f1.execute(std::make_unique<BusyTask>(std::chrono::milliseconds(5)));
+    }
+    f1.sync();
+    ThreadStackExecutor::Stats stats = f1.getStats();
+    EXPECT_EQUAL(10u, stats.acceptedTasks);
+    EXPECT_EQUAL(10u, stats.executedTasks);
+    EXPECT_EQUAL(2u, stats.threads);
+    EXPECT_GREATER_EQUAL(stats.busyTime, 0.05);
+    EXPECT_GREATER(stats.cpuTime, 0.0);
+    EXPECT_GREATER(stats.waitTime, 0.0);
+    EXPECT_GREATER_EQUAL(stats.wallTime, 0.025);
+    EXPECT_GREATER(stats.getUtilization(), 0.0);
+    EXPECT_GREATER_EQUAL(stats.getRunTimePercentile(0.5), 0.005);
+    size_t histogramCount = 0;
+    for (size_t count : stats.runTimeHistogram) {
+        histogramCount += count;
+    }
+    EXPECT_EQUAL(10u, histogramCount);
+    stats = f1.getStats();
+    EXPECT_EQUAL(0u, stats.executedTasks);
+    EXPECT_EQUAL(0.0, stats.busyTime);
+}
+
+TEST("require that executor stats run time buckets are powers of two microseconds") {
+    EXPECT_EQUAL(0u, ExecutorStats::runTimeBucket(0.0));
+    EXPECT_EQUAL(0u, ExecutorStats::runTimeBucket(0.0000004));
+    EXPECT_EQUAL(1u, ExecutorStats::runTimeBucket(0.000001));
+    EXPECT_EQUAL(2u, ExecutorStats::runTimeBucket(0.000003));
+    EXPECT_EQUAL(10u, ExecutorStats::runTimeBucket(0.001));
+    EXPECT_EQUAL(11u, ExecutorStats::runTimeBucket(0.001024));
+    EXPECT_EQUAL(ExecutorStats::NUM_RUN_TIME_BUCKETS - 1, ExecutorStats::runTimeBucket(3600.0));
+    EXPECT_EQUAL(0.001024, ExecutorStats::runTimeBucketLimit(10));
+}
+
+TEST("require that executor stats can be aggregated") {
+    ExecutorStats a;
+    a.threads = 1;
+    a.wallTime = 2.0;
+    a.busyTime = 1.0;
+    a.executedTasks = 2;
+    a.waitTime = 0.5;
+    a.maxWaitTime = 0.4;
+    a.runTimeHistogram[3] = 2;
+    ExecutorStats b;
+    b.threads = 1;
+    b.wallTime = 1.0;
+    b.busyTime = 2.0;
+    b.executedTasks = 1;
+    b.maxWaitTime = 0.1;
+    b.runTimeHistogram[5] = 1;
+    a.aggregate(b);
+    EXPECT_EQUAL(2u, a.threads);
+    EXPECT_EQUAL(2.0, a.wallTime);
+    EXPECT_EQUAL(0.75, a.getUtilization());
+    EXPECT_EQUAL(0.4, a.maxWaitTime);
+    EXPECT_APPROX(0.5 / 3, a.getAverageWaitTime(), 1e-9);
+    EXPECT_EQUAL(ExecutorStats::runTimeBucketLimit(3), a.getRunTimePercentile(0.5));
+    EXPECT_EQUAL(ExecutorStats::runTimeBucketLimit(5), a.getRunTimePercentile(0.99));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
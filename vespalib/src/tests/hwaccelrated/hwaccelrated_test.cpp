@@ -0,0 +1,158 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/hwaccelrated/generic.h>
+#include <vespa/vespalib/hwaccelrated/sse2.h>
+#include <vespa/vespalib/hwaccelrated/avx.h>
+#include <vespa/vespalib/hwaccelrated/avx2.h>
+#include <vespa/vespalib/hwaccelrated/avx512.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <cstring>
+
+using namespace vespalib::hwaccelrated;
+
+namespace {
+
+/**
+ * All accelrators this cpu can run, each compared against the
+ * generic implementation below.
+ */
+std::vector<std::pair<vespalib::string, IAccelrated::UP>>
+supportedAccelrators()
+{
+    std::vector<std::pair<vespalib::string, IAccelrated::UP>> result;
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) {
+        result.emplace_back("sse2", std::make_unique<Sse2Accelrator>());
+    }
+    if (__builtin_cpu_supports("avx")) {
+        result.emplace_back("avx", std::make_unique<AvxAccelrator>());
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        result.emplace_back("avx2", std::make_unique<Avx2Accelrator>());
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        result.emplace_back("avx512", std::make_unique<Avx512Accelrator>());
+    }
+    return result;
+}
+
+std::vector<uint64_t>
+makeWords(size_t sz, uint64_t seed)
+{
+    std::vector<uint64_t> words;
+    for (uint64_t i(0); i < sz; i++) {
+        words.push_back((i + seed) * 0x9e3779b97f4a7c15ul);
+    }
+    return words;
+}
+
+}
+
+TEST("require that all accelrators compute the same dot products") {
+    GenericAccelrator generic;
+    for (const auto & accel : supportedAccelrators()) {
+        TEST_STATE(accel.first.c_str());
+        for (size_t sz : {0, 1, 7, 16, 33, 1000}) {
+            std::vector<int32_t> a32(sz), b32(sz);
+            std::vector<int64_t> a64(sz), b64(sz);
+            std::vector<float> af(sz), bf(sz);
+            std::vector<double> ad(sz), bd(sz);
+            for (size_t i(0); i < sz; i++) {
+                a32[i] = a64[i] = i % 13;
+                b32[i] = b64[i] = 7 - int(i % 5);
+                af[i] = ad[i] = 0.5 * (i % 11);
+                bf[i] = bd[i] = 0.25 * (i % 3);
+            }
+            EXPECT_EQUAL(generic.dotProduct(a32.data(), b32.data(), sz), accel.second->dotProduct(a32.data(), b32.data(), sz));
+            EXPECT_EQUAL(generic.dotProduct(a64.data(), b64.data(), sz), accel.second->dotProduct(a64.data(), b64.data(), sz));
+            EXPECT_EQUAL(generic.dotProduct(af.data(), bf.data(), sz), accel.second->dotProduct(af.data(), bf.data(), sz));
+            EXPECT_EQUAL(generic.dotProduct(ad.data(), bd.data(), sz), accel.second->dotProduct(ad.data(), bd.data(), sz));
+        }
+    }
+}
+
+TEST("require that all accelrators compute the same bit operations") {
+    GenericAccelrator generic;
+    for (const auto & accel : supportedAccelrators()) {
+        TEST_STATE(accel.first.c_str());
+        std::vector<uint64_t> a = makeWords(48, 1);
+        std::vector<uint64_t> b = makeWords(48, 2);
+        std::vector<uint64_t> c = makeWords(48, 3);
+        for (size_t bytes : {0, 3, 64, 100, 384}) {
+            std::vector<uint64_t> expected(a), actual(a);
+            generic.orBit(expected.data(), b.data(), bytes);
+            accel.second->orBit(actual.data(), b.data(), bytes);
+            generic.andNotBit(expected.data(), c.data(), bytes);
+            accel.second->andNotBit(actual.data(), c.data(), bytes);
+            generic.andBit(expected.data(), a.data(), bytes);
+            accel.second->andBit(actual.data(), a.data(), bytes);
+            generic.notBit(expected.data(), bytes);
+            accel.second->notBit(actual.data(), bytes);
+            EXPECT_TRUE(expected == actual);
+        }
+        IAccelrated::BitSources src = {{a.data(), false}, {b.data(), true}, {c.data(), false}};
+        for (size_t offset(0); offset < a.size() * sizeof(uint64_t); offset += IAccelrated::CHUNK_BYTES) {
+            uint64_t expected[IAccelrated::CHUNK_BYTES / sizeof(uint64_t)];
+            uint64_t actual[IAccelrated::CHUNK_BYTES / sizeof(uint64_t)];
+            generic.and64(offset, src, expected);
+            accel.second->and64(offset, src, actual);
+            EXPECT_EQUAL(0, memcmp(expected, actual, sizeof(expected)));
+            generic.or64(offset, src, expected);
+            accel.second->or64(offset, src, actual);
+            EXPECT_EQUAL(0, memcmp(expected, actual, sizeof(expected)));
+        }
+    }
+}
+
+TEST("require that all accelrators count the same number of bits") {
+    GenericAccelrator generic;
+    for (const auto & accel : supportedAccelrators()) {
+        TEST_STATE(accel.first.c_str());
+        std::vector<uint64_t> words = makeWords(131, 5);
+        words[17] = 0;
+        words[18] = -1;
+        for (size_t sz(0); sz <= words.size(); sz++) {
+            EXPECT_EQUAL(generic.populationCount(words.data(), sz), accel.second->populationCount(words.data(), sz));
+        }
+    }
+}
+
+TEST("require that all accelrators intersect shifted positions the same way") {
+    GenericAccelrator generic;
+    std::vector<uint64_t> a, b;
+    for (uint64_t i(0); i < 300; i++) {
+        a.push_back(5 * i + (i % 3));
+        b.push_back(3 * i + 1);
+    }
+    for (const auto & accel : supportedAccelrators()) {
+        TEST_STATE(accel.first.c_str());
+        for (uint64_t shift(0); shift < 6; shift++) {
+            std::vector<uint64_t> expected(a.size()), actual(a.size());
+            expected.resize(generic.intersectShifted(a.data(), a.size(), b.data(), b.size(), shift, expected.data()));
+            actual.resize(accel.second->intersectShifted(a.data(), a.size(), b.data(), b.size(), shift, actual.data()));
+            EXPECT_TRUE(expected == actual);
+        }
+    }
+}
+
+TEST("require that all accelrators fold ascii words the same way") {
+    GenericAccelrator generic;
+    char text[300];
+    for (size_t i(0); i < sizeof(text); i++) {
+        text[i] = (i * 7) % 128;
+    }
+    text[250] = char(0xc3);
+    for (const auto & accel : supportedAccelrators()) {
+        TEST_STATE(accel.first.c_str());
+        char expected[sizeof(text)];
+        char actual[sizeof(text)];
+        size_t expectedFolded = generic.foldAsciiWords(text, sizeof(text), expected);
+        size_t actualFolded = accel.second->foldAsciiWords(text, sizeof(text), actual);
+        size_t common = std::min(expectedFolded, actualFolded);
+        EXPECT_GREATER(common, 128u);
+        EXPECT_EQUAL(0, memcmp(expected, actual, common));
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,64 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/numa.h>
+#include <vespa/vespalib/util/simple_thread_bundle.h>
+#include <sys/mman.h>
+#include <sched.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace vespalib;
+
+struct CpuProbe : Runnable {
+    int cpu = -1;
+    void run() override { cpu = sched_getcpu(); }
+};
+
+TEST("require that there is at least one node") {
+    EXPECT_GREATER_EQUAL(Numa::numNodes(), 1u);
+    if (Numa::numNodes() > 1) {
+        for (size_t node = 0; node < Numa::numNodes(); ++node) {
+            EXPECT_FALSE(Numa::cpus(node).empty());
+        }
+    }
+}
+
+TEST("require that interleaved memory can be used") {
+    size_t sz = 4 * 1024 * 1024;
+    void *buf = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_ANON | MAP_PRIVATE, -1, 0);
+    ASSERT_TRUE(buf != MAP_FAILED);
+    EXPECT_EQUAL(Numa::numNodes() > 1, Numa::interleave(buf, sz));
+    memset(buf, 0x55, sz);
+    EXPECT_EQUAL(0x55, static_cast<unsigned char *>(buf)[sz - 1]);
+    munmap(buf, sz);
+}
+
+TEST("require that bound bundle threads only run on their node") {
+    SimpleThreadBundle::Pool pool(4, true);
+    for (size_t i = 0; i < Numa::numNodes(); ++i) {
+        SimpleThreadBundle::UP bundle = pool.obtain();
+        std::vector<CpuProbe> probes(bundle->size());
+        std::vector<Runnable *> targets;
+        for (auto &probe: probes) {
+            targets.push_back(&probe);
+        }
+        cpu_set_t before;
+        cpu_set_t after;
+        ASSERT_EQUAL(0, sched_getaffinity(0, sizeof(before), &before));
+        bundle->run(targets);
+        ASSERT_EQUAL(0, sched_getaffinity(0, sizeof(after), &after));
+        EXPECT_TRUE(CPU_EQUAL(&before, &after)); // calling thread is unbound again
+        if (Numa::numNodes() > 1) {
+            const std::vector<int> &cpus = Numa::cpus(i);
+            for (const auto &probe: probes) {
+                EXPECT_TRUE(std::find(cpus.begin(), cpus.end(), probe.cpu) != cpus.end());
+            }
+        } else {
+            for (const auto &probe: probes) {
+                EXPECT_GREATER_EQUAL(probe.cpu, 0);
+            }
+        }
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -4,6 +4,7 @@
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/objects/hexdump.h>
 #include <vespa/vespalib/test/insertion_operators.h>
+#include <vespa/vespalib/util/exceptions.h>
 #include <ostream>
 
 using vespalib::nbostream;
@@ -280,4 +281,15 @@ TEST_F("Test writeSmallString", Fixture)
 }
 
 
+TEST_F("Test writeAt", Fixture)
+{
+    f._stream << static_cast<uint8_t>(0x12);
+    f._stream.adjustReadPos(1);
+    f._stream << static_cast<uint8_t>(0x34) << static_cast<uint32_t>(0) << static_cast<uint8_t>(0x56);
+    f._stream.writeAt(1, static_cast<uint32_t>(0x01020304));
+    EXPECT_EQUAL(ExpBuffer({ 0x34, 0x01, 0x02, 0x03, 0x04, 0x56 }), f._stream);
+    EXPECT_EXCEPTION(f._stream.writeAt(3, static_cast<uint32_t>(0)), vespalib::IllegalStateException, "Stream failed");
+}
+
+
 TEST_MAIN() { TEST_RUN_ALL(); }
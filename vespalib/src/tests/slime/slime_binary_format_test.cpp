@@ -669,4 +669,26 @@ TEST("require that decode failure results in 0 return value") {
     EXPECT_EQUAL(BinaryFormat::decode(buf.get(), slime), 0u);
 }
 
+bool points_into(Memory value, Memory buf) {
+    return ((value.data >= buf.data) && ((value.data + value.size) <= (buf.data + buf.size)));
+}
+
+TEST("require that borrowed decode refers to strings and data in the input") {
+    Slime slime = from_json("{a:'foo',b:[1,'bar'],c:{d:'baz'}}");
+    slime.get().setData("e", Memory("data"));
+    SimpleBuffer buf;
+    BinaryFormat::encode(slime, buf);
+    Slime copied;
+    Slime borrowed;
+    EXPECT_EQUAL(BinaryFormat::decode(buf.get(), copied), buf.get().size);
+    EXPECT_EQUAL(BinaryFormat::decode_borrowed(buf.get(), borrowed), buf.get().size);
+    EXPECT_EQUAL(slime, copied);
+    EXPECT_EQUAL(slime, borrowed);
+    EXPECT_FALSE(points_into(copied.get()["a"].asString(), buf.get()));
+    EXPECT_TRUE(points_into(borrowed.get()["a"].asString(), buf.get()));
+    EXPECT_TRUE(points_into(borrowed.get()["b"][1].asString(), buf.get()));
+    EXPECT_TRUE(points_into(borrowed.get()["c"]["d"].asString(), buf.get()));
+    EXPECT_TRUE(points_into(borrowed.get()["e"].asData(), buf.get()));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -3,6 +3,8 @@
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/data/input.h>
 #include <vespa/vespalib/data/memory_input.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/data/databuffer_output.h>
 #include <iostream>
 #include <fstream>
 
@@ -132,6 +134,31 @@ TEST_F("encode string", Slime) {
     EXPECT_EQUAL("\"foo\"\n", make_json(f, false));
 }
 
+TEST("encode string escapes characters at any position") {
+    const char specials[] = { '"', '\\', '\n', '\x01', '\x1f' };
+    const char *escaped[] = { "\\\"", "\\\\", "\\n", "\\u0001", "\\u001F" };
+    for (size_t len: {1, 15, 16, 17, 31, 32, 33, 70}) {
+        for (size_t pos = 0; pos < len; ++pos) {
+            for (size_t i = 0; i < 5; ++i) {
+                std::string str(len, 'x');
+                str[pos] = specials[i];
+                str[len - 1 - pos] = specials[i];
+                size_t first = std::min(pos, len - 1 - pos);
+                size_t last = std::max(pos, len - 1 - pos);
+                std::string expect = "\"" + str.substr(0, first) + escaped[i] +
+                                     ((first == last) ? std::string() : (str.substr(first + 1, last - first - 1) + escaped[i])) +
+                                     str.substr(last + 1) + "\"";
+                Slime slime;
+                slime.setString(str);
+                EXPECT_EQUAL(expect, make_json(slime, true));
+            }
+        }
+    }
+    Slime slime;
+    slime.setString(std::string("high bit \xc3\xa6\xc3\xb8\xc3\xa5 is not escaped"));
+    EXPECT_EQUAL(std::string("\"high bit \xc3\xa6\xc3\xb8\xc3\xa5 is not escaped\""), make_json(slime, true));
+}
+
 TEST_F("encode data", Slime) {
     char buf[8];
     for (int i = 0; i < 8; ++i) {
@@ -384,4 +411,48 @@ TEST("require that multiple adjacent values can be decoded from a single input")
     EXPECT_EQUAL(input.obtain().size, 0u);
 }
 
+TEST("require that borrowed decode refers to unescaped strings in the input") {
+    vespalib::string json("{a:'foo',b:[\"bar\",'esc\\naped'],c:''}");
+    Memory mem(json);
+    Slime slime;
+    EXPECT_EQUAL(vespalib::slime::JsonFormat::decode_borrowed(mem, slime), json.size());
+    EXPECT_EQUAL(std::string("{\"a\":\"foo\",\"b\":[\"bar\",\"esc\\naped\"],\"c\":\"\"}"), make_json(slime, true));
+    auto points_into = [&mem](Memory value) {
+        return ((value.data >= mem.data) && ((value.data + value.size) <= (mem.data + mem.size)));
+    };
+    EXPECT_TRUE(points_into(slime.get()["a"].asString()));
+    EXPECT_TRUE(points_into(slime.get()["b"][0].asString()));
+    EXPECT_FALSE(points_into(slime.get()["b"][1].asString()));
+    EXPECT_EQUAL(0u, slime.get()["c"].asString().size);
+}
+
+struct CollectSink : vespalib::DataBufferOutput::Sink {
+    std::string data;
+    size_t flushes = 0;
+    void flush(vespalib::DataBuffer &buffer) override {
+        data.append(buffer.getData(), buffer.getDataLen());
+        buffer.moveDataToDead(buffer.getDataLen());
+        ++flushes;
+    }
+};
+
+TEST("require that json can be streamed through a data buffer") {
+    Slime slime;
+    Cursor &arr = slime.setArray();
+    for (size_t i = 0; i < 1000; ++i) {
+        Cursor &obj = arr.addObject();
+        obj.setLong("id", i);
+        obj.setString("text", "some text that \"needs\" escaping now and then");
+    }
+    CollectSink sink;
+    vespalib::DataBuffer buffer;
+    {
+        vespalib::DataBufferOutput output(buffer, sink, 16 * 1024);
+        vespalib::slime::JsonFormat::encode(slime, output, true);
+    }
+    EXPECT_EQUAL(make_json(slime, true), sink.data);
+    EXPECT_GREATER(sink.flushes, 1u);
+    EXPECT_LESS(buffer.getBufSize(), 64 * 1024u);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -8,6 +8,7 @@
 #include <vector>
 #include <algorithm>
 #include <vespa/vespalib/stllike/hash_set.hpp>
+#include <vespa/vespalib/stllike/swiss_hash_set.h>
 
 template <typename S>
 void fill(S & s, size_t count)
@@ -63,6 +64,12 @@ size_t benchHashVespaLib2(size_t sz, size_t numLookups)
     return bench(set, sz, numLookups);
 }
 
+size_t benchSwissHash(size_t sz, size_t numLookups)
+{
+    vespalib::swiss_hash_set<uint32_t> set;
+    return bench(set, sz, numLookups);
+}
+
 int main(int argc, char *argv[])
 {
     size_t count(1000);
@@ -82,17 +89,20 @@ int main(int argc, char *argv[])
     description['h'] = "std::hash_set";
     description['g'] = "vespalib::hash_set";
     description['G'] = "vespalib::hash_set with simple and modulator.";
+    description['s'] = "vespalib::swiss_hash_set";
     size_t found(0);
     switch (type) {
     case 'm': found = benchMap(count, rep); break;
     case 'h': found = benchHashStl(count, rep); break;
     case 'g': found = benchHashVespaLib(count, rep); break;
     case 'G': found = benchHashVespaLib2(count, rep); break;
+    case 's': found = benchSwissHash(count, rep); break;
     default:
         printf("'m' = %s\n", description[type]);
         printf("'h' = %s\n", description[type]);
         printf("'g' = %s\n", description[type]);
         printf("'G' = %s\n", description[type]);
+        printf("'s' = %s\n", description[type]);
         printf("Unspecified type %c. Running map lookup benchmark\n", type);
         exit(1);
         break;
@@ -0,0 +1,200 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/stllike/swiss_hash_map.h>
+#include <vespa/vespalib/stllike/swiss_hash_set.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <map>
+#include <memory>
+#include <random>
+
+using namespace vespalib;
+
+TEST("require that empty map behaves") {
+    swiss_hash_map<int, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQUAL(0u, map.size());
+    EXPECT_EQUAL(0u, map.capacity());
+    EXPECT_TRUE(map.begin() == map.end());
+    EXPECT_TRUE(map.find(7) == map.end());
+    map.erase(7);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+}
+
+TEST("require that map insert, find and operator[] work") {
+    swiss_hash_map<int, int> map;
+    for (int i = 0; i < 1000; ++i) {
+        auto res = map.insert(std::make_pair(i, i * 10));
+        EXPECT_TRUE(res.second);
+        EXPECT_EQUAL(i, res.first->first);
+    }
+    EXPECT_FALSE(map.insert(std::make_pair(5, 0)).second);
+    EXPECT_EQUAL(1000u, map.size());
+    for (int i = 0; i < 1000; ++i) {
+        auto found = map.find(i);
+        ASSERT_TRUE(found != map.end());
+        EXPECT_EQUAL(i * 10, found->second);
+    }
+    EXPECT_TRUE(map.find(1000) == map.end());
+    map[1000] = 7;
+    ++map[1000];
+    EXPECT_EQUAL(8, map[1000]);
+    EXPECT_EQUAL(1001u, map.size());
+    const auto &cmap = map;
+    EXPECT_EQUAL(50, cmap[5]);
+}
+
+TEST("require that iteration and for_each visit all elements once") {
+    swiss_hash_map<uint32_t, uint32_t> map;
+    for (uint32_t i = 0; i < 100; ++i) {
+        map[i] = i;
+    }
+    std::map<uint32_t, size_t> seen;
+    for (const auto &entry: map) {
+        ++seen[entry.first];
+    }
+    map.for_each([&seen](const auto &entry) { ++seen[entry.first]; });
+    EXPECT_EQUAL(100u, seen.size());
+    for (const auto &entry: seen) {
+        EXPECT_EQUAL(2u, entry.second);
+    }
+}
+
+TEST("require that random operations match std::map") {
+    std::mt19937 rnd(42);
+    swiss_hash_map<uint64_t, uint64_t> map;
+    std::map<uint64_t, uint64_t> oracle;
+    for (size_t i = 0; i < 200000; ++i) {
+        uint64_t key = (rnd() % 5000) << 12; // low bits all zero
+        switch (rnd() % 3) {
+        case 0:
+            map[key] = i;
+            oracle[key] = i;
+            break;
+        case 1:
+            map.erase(key);
+            oracle.erase(key);
+            break;
+        case 2: {
+            auto found = map.find(key);
+            auto expect = oracle.find(key);
+            ASSERT_EQUAL((expect != oracle.end()), (found != map.end()));
+            if (found != map.end()) {
+                EXPECT_EQUAL(expect->second, found->second);
+            }
+        }
+        }
+        ASSERT_EQUAL(oracle.size(), map.size());
+    }
+    size_t count = 0;
+    for (const auto &entry: map) {
+        EXPECT_EQUAL(oracle[entry.first], entry.second);
+        ++count;
+    }
+    EXPECT_EQUAL(oracle.size(), count);
+    // deleted slots are reused instead of growing the table forever
+    EXPECT_LESS_EQUAL(map.capacity(), 16384u);
+}
+
+TEST("require that erase by iterator works") {
+    swiss_hash_map<int, int> map;
+    for (int i = 0; i < 100; ++i) {
+        map[i] = i;
+    }
+    for (int i = 0; i < 100; i += 2) {
+        map.erase(map.find(i));
+    }
+    EXPECT_EQUAL(50u, map.size());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQUAL((i % 2) == 1, map.find(i) != map.end());
+    }
+}
+
+TEST("require that maps can be copied, moved, swapped and compared") {
+    swiss_hash_map<vespalib::string, int> a;
+    for (int i = 0; i < 100; ++i) {
+        a[vespalib::make_string("key%d", i)] = i;
+    }
+    swiss_hash_map<vespalib::string, int> b(a);
+    EXPECT_TRUE(a == b);
+    b["key7"] = 8;
+    EXPECT_FALSE(a == b);
+    b = a;
+    EXPECT_TRUE(a == b);
+    swiss_hash_map<vespalib::string, int> c(std::move(b));
+    EXPECT_TRUE(a == c);
+    EXPECT_TRUE(b.empty());
+    swiss_hash_map<vespalib::string, int> d;
+    d["other"] = 1;
+    swap(c, d);
+    EXPECT_EQUAL(1u, c.size());
+    EXPECT_EQUAL(100u, d.size());
+    EXPECT_EQUAL(7, d["key7"]);
+    d.clear();
+    EXPECT_TRUE(d.empty());
+    EXPECT_TRUE(d.find("key7") == d.end());
+}
+
+TEST("require that resize reserves room for the given number of elements") {
+    swiss_hash_map<int, int> map;
+    map.resize(1000);
+    size_t capacity = map.capacity();
+    EXPECT_GREATER_EQUAL(capacity, 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        map[i] = i;
+    }
+    EXPECT_EQUAL(capacity, map.capacity());
+    EXPECT_GREATER(map.getMemoryConsumption(), 1000 * sizeof(std::pair<int, int>));
+}
+
+TEST("require that map can hold non-copyable values") {
+    swiss_hash_map<int, std::unique_ptr<int>> map;
+    for (int i = 0; i < 100; ++i) {
+        map.insert(std::make_pair(i, std::make_unique<int>(i)));
+    }
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQUAL(i, *map[i]);
+    }
+}
+
+TEST("require that set works") {
+    swiss_hash_set<int> set({1, 2, 3, 2});
+    EXPECT_EQUAL(3u, set.size());
+    EXPECT_TRUE(set.find(2) != set.end());
+    EXPECT_TRUE(set.find(4) == set.end());
+    EXPECT_FALSE(set.insert(3).second);
+    set.erase(3);
+    EXPECT_TRUE(set.find(3) == set.end());
+    EXPECT_TRUE(set == swiss_hash_set<int>({2, 1}));
+    EXPECT_FALSE(set == swiss_hash_set<int>({2, 3}));
+}
+
+struct Name {
+    vespalib::string name;
+    Name(const vespalib::string &n) : name(n) {}
+};
+struct NameHash {
+    size_t operator()(const Name &n) const { return vespalib::hash<vespalib::string>()(n.name); }
+    size_t operator()(const char *n) const { return vespalib::hash<vespalib::string>()(n); }
+};
+struct NameEqual {
+    bool operator()(const Name &a, const Name &b) const { return (a.name == b.name); }
+    bool operator()(const vespalib::string &a, const char *b) const { return (a == b); }
+};
+struct NameExtract {
+    const vespalib::string &operator()(const Name &n) const { return n.name; }
+};
+
+TEST("require that set can be searched with an alternative key") {
+    swiss_hash_set<Name, NameHash, NameEqual> set;
+    set.insert(Name("foo"));
+    set.insert(Name("bar"));
+    auto found = set.find<const char *, NameExtract, NameHash, NameEqual>("bar", NameExtract());
+    ASSERT_TRUE(found != set.end());
+    EXPECT_EQUAL("bar", found->name);
+    EXPECT_TRUE((set.find<const char *, NameExtract, NameHash, NameEqual>("baz", NameExtract()) == set.end()));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
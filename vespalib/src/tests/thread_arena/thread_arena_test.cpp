@@ -0,0 +1,128 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/thread_arena.h>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace vespalib;
+
+struct Node {
+    static std::atomic<size_t> alive;
+    std::unique_ptr<Node> next;
+    char payload[40];
+    Node() : next(), payload() { ++alive; memset(payload, 0x55, sizeof(payload)); }
+    ~Node() { --alive; }
+    static void *operator new(size_t size) { return ThreadArena::alloc(size); }
+    static void operator delete(void *ptr) { ThreadArena::free(ptr); }
+};
+std::atomic<size_t> Node::alive(0);
+
+std::unique_ptr<Node> make_list(size_t n) {
+    std::unique_ptr<Node> head;
+    for (size_t i = 0; i < n; ++i) {
+        auto node = std::make_unique<Node>();
+        node->next = std::move(head);
+        head = std::move(node);
+    }
+    return head;
+}
+
+void release_list(std::unique_ptr<Node> head) {
+    while (head) {
+        head = std::move(head->next);
+    }
+}
+
+bool is_aligned(const void *ptr) {
+    return ((reinterpret_cast<uintptr_t>(ptr) % 16) == 0);
+}
+
+TEST("require that allocation works without a scope") {
+    EXPECT_FALSE(ThreadArena::active());
+    auto node = std::make_unique<Node>();
+    EXPECT_TRUE(is_aligned(node.get()));
+    EXPECT_EQUAL(1u, Node::alive.load());
+    node.reset();
+    EXPECT_EQUAL(0u, Node::alive.load());
+}
+
+TEST("require that objects allocated in a scope share chunks") {
+    ThreadArena::Scope scope(4096);
+    EXPECT_TRUE(ThreadArena::active());
+    auto list = make_list(1000);
+    EXPECT_EQUAL(1000u, Node::alive.load());
+    // 1000 objects of 64 bytes each (incl header) in 4k chunks
+    EXPECT_GREATER(scope.chunks_allocated(), 10u);
+    EXPECT_LESS(scope.chunks_allocated(), 20u);
+    for (Node *node = list.get(); node != nullptr; node = node->next.get()) {
+        EXPECT_TRUE(is_aligned(node));
+    }
+    release_list(std::move(list));
+    EXPECT_EQUAL(0u, Node::alive.load());
+}
+
+TEST("require that large objects are allocated outside the chunks") {
+    ThreadArena::Scope scope(4096);
+    void *small = ThreadArena::alloc(100);
+    EXPECT_EQUAL(1u, scope.chunks_allocated());
+    void *large = ThreadArena::alloc(2000);
+    EXPECT_EQUAL(1u, scope.chunks_allocated());
+    EXPECT_TRUE(is_aligned(small));
+    EXPECT_TRUE(is_aligned(large));
+    memset(large, 0, 2000);
+    ThreadArena::free(large);
+    ThreadArena::free(small);
+    ThreadArena::free(nullptr);
+}
+
+TEST("require that objects may outlive the scope they were allocated in") {
+    std::unique_ptr<Node> list;
+    {
+        ThreadArena::Scope scope;
+        list = make_list(100);
+    }
+    EXPECT_FALSE(ThreadArena::active());
+    EXPECT_EQUAL(100u, Node::alive.load());
+    release_list(std::move(list));
+    EXPECT_EQUAL(0u, Node::alive.load());
+}
+
+TEST("require that scopes can be nested") {
+    ThreadArena::Scope outer;
+    auto a = make_list(10);
+    {
+        ThreadArena::Scope inner;
+        auto b = make_list(10);
+        EXPECT_EQUAL(1u, inner.chunks_allocated());
+        release_list(std::move(b));
+    }
+    EXPECT_TRUE(ThreadArena::active());
+    auto c = make_list(10);
+    EXPECT_EQUAL(1u, outer.chunks_allocated());
+    release_list(std::move(a));
+    release_list(std::move(c));
+}
+
+TEST("require that objects can be freed by other threads") {
+    std::vector<std::unique_ptr<Node>> lists;
+    {
+        ThreadArena::Scope scope(4096);
+        for (size_t i = 0; i < 8; ++i) {
+            lists.push_back(make_list(500));
+        }
+    }
+    std::vector<std::thread> threads;
+    for (auto &list : lists) {
+        Node *head = list.release();
+        threads.emplace_back([head]() { release_list(std::unique_ptr<Node>(head)); });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQUAL(0u, Node::alive.load());
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
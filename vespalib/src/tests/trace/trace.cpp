@@ -2,7 +2,9 @@
 #include <vespa/log/log.h>
 LOG_SETUP("trace_test");
 #include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/trace/latency_trace.h>
 #include <vespa/vespalib/trace/trace.h>
+#include <vespa/vespalib/trace/tracelevel.h>
 #include <vespa/vespalib/trace/tracevisitor.h>
 
 using namespace vespalib;
@@ -21,6 +23,7 @@ private:
     void testTraceDump();
     void testVisiting();
     void testTimestamp();
+    void testLatency();
 
 public:
     int Main() override;
@@ -44,6 +47,7 @@ Test::Main()
     testTraceDump();
     testVisiting();
     testTimestamp();
+    testLatency();
     TEST_DONE();
 }
 
@@ -407,3 +411,38 @@ Test::testConstruct()
     EXPECT_EQUAL("", leaf2.getNote());
     EXPECT_EQUAL(124, leaf2.getTimestamp());
 }
+
+void
+Test::testLatency()
+{
+    EXPECT_EQUAL("latency queue 1.500 ms", LatencyTrace::makeNote("queue", 1.5));
+
+    string stage;
+    double millis(0.0);
+    EXPECT_TRUE(LatencyTrace::parseNote("latency spi 12.250 ms", stage, millis));
+    EXPECT_EQUAL("spi", stage);
+    EXPECT_APPROX(12.25, millis, 0.0001);
+    EXPECT_FALSE(LatencyTrace::parseNote("latency spi ms", stage, millis));
+    EXPECT_FALSE(LatencyTrace::parseNote("latency spi abc ms", stage, millis));
+    EXPECT_FALSE(LatencyTrace::parseNote("Sending message", stage, millis));
+
+    Trace t1(TraceLevel::ERROR);
+    EXPECT_FALSE(LatencyTrace::add(t1, "queue", 1.0));
+    EXPECT_TRUE(t1.getRoot().isEmpty());
+
+    Trace t2(TraceLevel::LATENCY);
+    EXPECT_TRUE(LatencyTrace::add(t2, "queue", 1.0));
+    t2.trace(TraceLevel::LATENCY, "unrelated note");
+    Trace replica1(TraceLevel::LATENCY);
+    LatencyTrace::add(replica1, "spi", 2.0);
+    Trace replica2(TraceLevel::LATENCY);
+    LatencyTrace::add(replica2, "spi", 3.0);
+    LatencyTrace::add(replica2, "queue", 0.5);
+    t2.getRoot().addChild(replica1.getRoot()).addChild(replica2.getRoot());
+
+    TraceNode decoded(TraceNode::decode(t2.getRoot().encode()));
+    LatencyTrace::StageMap stages(LatencyTrace::collect(decoded));
+    EXPECT_EQUAL(2u, stages.size());
+    EXPECT_APPROX(1.5, stages["queue"], 0.0001);
+    EXPECT_APPROX(5.0, stages["spi"], 0.0001);
+}
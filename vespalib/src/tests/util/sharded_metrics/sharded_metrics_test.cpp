@@ -0,0 +1,93 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/util/sharded_counter.h>
+#include <vespa/vespalib/util/sharded_histogram.h>
+
+using namespace vespalib;
+
+using Histogram = ShardedHistogram;
+
+TEST("require that counter sums all additions") {
+    ShardedCounter counter;
+    EXPECT_EQUAL(0u, counter.value());
+    counter.add();
+    counter.add(41);
+    EXPECT_EQUAL(42u, counter.value());
+}
+
+TEST_MT_F("require that counter can be updated by many threads", 8, ShardedCounter()) {
+    for (size_t i = 0; i < 10000; ++i) {
+        f1.add();
+    }
+    TEST_BARRIER();
+    EXPECT_EQUAL(80000u, f1.value());
+}
+
+TEST("require that small values get exact buckets") {
+    for (uint64_t v = 0; v < Histogram::SUB_BUCKETS * 2; ++v) {
+        size_t bucket = Histogram::bucket_of(v);
+        EXPECT_EQUAL(v, Histogram::bucket_low(bucket));
+        EXPECT_EQUAL(v, Histogram::bucket_high(bucket));
+    }
+}
+
+TEST("require that buckets are contiguous with bounded relative error") {
+    for (size_t i = 0; i + 2 < Histogram::NUM_BUCKETS; ++i) {
+        uint64_t low = Histogram::bucket_low(i);
+        uint64_t high = Histogram::bucket_high(i);
+        EXPECT_EQUAL(high + 1, Histogram::bucket_low(i + 1));
+        EXPECT_EQUAL(i, Histogram::bucket_of(low));
+        EXPECT_EQUAL(i, Histogram::bucket_of(high));
+        EXPECT_LESS_EQUAL(double(high - low), 0.125 * low);
+    }
+    EXPECT_EQUAL(Histogram::NUM_BUCKETS - 1, Histogram::bucket_of(uint64_t(1) << 40));
+    EXPECT_EQUAL(Histogram::NUM_BUCKETS - 1, Histogram::bucket_of(uint64_t(-1)));
+}
+
+TEST("require that histogram snapshot has count, sum and percentiles") {
+    Histogram hist;
+    Histogram::Snapshot empty = hist.snapshot();
+    EXPECT_EQUAL(0u, empty.count);
+    EXPECT_EQUAL(0u, empty.percentile(0.5));
+    for (uint64_t v = 1; v <= 1000; ++v) {
+        hist.record(v);
+    }
+    Histogram::Snapshot snap = hist.snapshot();
+    EXPECT_EQUAL(1000u, snap.count);
+    EXPECT_EQUAL(500500u, snap.sum);
+    EXPECT_EQUAL(500.5, snap.average());
+    EXPECT_EQUAL(1u, snap.min());
+    EXPECT_APPROX(1000.0, double(snap.max()), 125.0);
+    EXPECT_APPROX(500.0, double(snap.percentile(0.5)), 62.5);
+    EXPECT_APPROX(990.0, double(snap.percentile(0.99)), 124.0);
+    EXPECT_LESS_EQUAL(snap.percentile(0.5), snap.percentile(0.9));
+}
+
+TEST("require that snapshots can be subtracted and merged") {
+    Histogram hist;
+    hist.record(10);
+    Histogram::Snapshot first = hist.snapshot();
+    hist.record(20);
+    hist.record(30);
+    Histogram::Snapshot delta = hist.snapshot().since(first);
+    EXPECT_EQUAL(2u, delta.count);
+    EXPECT_EQUAL(50u, delta.sum);
+    EXPECT_EQUAL(20u, delta.min());
+    delta.merge(first);
+    EXPECT_EQUAL(3u, delta.count);
+    EXPECT_EQUAL(60u, delta.sum);
+    EXPECT_EQUAL(10u, delta.min());
+}
+
+TEST_MT_F("require that histogram can be updated by many threads", 8, Histogram()) {
+    for (size_t i = 0; i < 10000; ++i) {
+        f1.record(i);
+    }
+    TEST_BARRIER();
+    Histogram::Snapshot snap = f1.snapshot();
+    EXPECT_EQUAL(80000u, snap.count);
+    EXPECT_EQUAL(8u * (9999u * 10000u / 2), snap.sum);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
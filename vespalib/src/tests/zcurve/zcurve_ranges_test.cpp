@@ -19,6 +19,16 @@ bool inside(int x, int y, const Z::RangeVector &ranges) {
     return false;
 }
 
+bool inside_any(int x, int y, const Z::RangeVector &ranges) {
+    int64_t z = Z::encode(x, y);
+    for (auto range: ranges) {
+        if (z >= range.min() && z <= range.max()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool verify_ranges(int min_x, int min_y, int max_x, int max_y) {
     Z::RangeVector ranges = Z::find_ranges(min_x, min_y, max_x, max_y);
     for (int x = min_x; x <= max_x; ++x) {
@@ -54,4 +64,50 @@ TEST("require that silly bounding box does not explode") {
     EXPECT_EQUAL(42u, ranges.size());
 }
 
+bool verify_circle_ranges(int x, int y, uint32_t radius, uint32_t x_aspect) {
+    Z::Circle circle(x, y, radius, x_aspect);
+    int max_dx = radius;
+    if (x_aspect != 0) {
+        max_dx = ((uint64_t(radius) << 32) + 0xffffffffu) / x_aspect;
+    }
+    Z::RangeVector ranges = Z::find_ranges(x - max_dx, y - radius, x + max_dx, y + radius, circle);
+    for (int px = x - max_dx; px <= x + max_dx; ++px) {
+        for (int py = y - (int)radius; py <= y + (int)radius; ++py) {
+            if (circle.contains(px, py) && !EXPECT_TRUE(inside(px, py, ranges))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int64_t total_size(const Z::RangeVector &ranges) {
+    int64_t size = 0;
+    for (auto range: ranges) {
+        size += (range.max() - range.min() + 1);
+    }
+    return size;
+}
+
+TEST("require that returned ranges contains circle") {
+    for (int x: {-20, -3, 0, 5, 17}) {
+        for (int y: {-11, 0, 2, 30}) {
+            for (uint32_t radius: {0u, 1u, 7u, 25u}) {
+                EXPECT_TRUE(verify_circle_ranges(x, y, radius, 0));
+                EXPECT_TRUE(verify_circle_ranges(x, y, radius, 0x80000000u));
+            }
+        }
+    }
+}
+
+TEST("require that circle ranges leave out corners of the bounding box") {
+    Z::Circle circle(0, 0, 10000, 0);
+    Z::RangeVector box = Z::find_ranges(-10000, -10000, 10000, 10000);
+    Z::RangeVector ranges = Z::find_ranges(-10000, -10000, 10000, 10000, circle);
+    EXPECT_LESS_EQUAL(ranges.size(), 42u);
+    EXPECT_LESS(total_size(ranges), total_size(box));
+    EXPECT_LESS_EQUAL(total_size(ranges), 20001L * 20001L);
+    EXPECT_FALSE(inside_any(10000, 10000, ranges));
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,45 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "databuffer_output.h"
+#include "databuffer.h"
+
+namespace vespalib {
+
+DataBufferOutput::DataBufferOutput(DataBuffer &buffer, Sink &sink, size_t flush_limit)
+    : _buffer(buffer),
+      _sink(sink),
+      _flush_limit(flush_limit)
+{
+}
+
+DataBufferOutput::~DataBufferOutput()
+{
+    flush();
+}
+
+WritableMemory
+DataBufferOutput::reserve(size_t bytes)
+{
+    _buffer.ensureFree(bytes);
+    return WritableMemory(_buffer.getFree(), _buffer.getFreeLen());
+}
+
+Output &
+DataBufferOutput::commit(size_t bytes)
+{
+    _buffer.moveFreeToData(bytes);
+    if (_buffer.getDataLen() >= _flush_limit) {
+        _sink.flush(_buffer);
+    }
+    return *this;
+}
+
+void
+DataBufferOutput::flush()
+{
+    if (_buffer.getDataLen() > 0) {
+        _sink.flush(_buffer);
+    }
+}
+
+} // namespace vespalib
@@ -0,0 +1,48 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "output.h"
+
+namespace vespalib {
+
+class DataBuffer;
+
+/**
+ * Output writing directly into a DataBuffer, handing the buffered
+ * data over to a sink (typically writing it to a socket) whenever
+ * the amount of buffered data reaches the flush limit. This lets
+ * large encoded objects be streamed in big chunks without ever
+ * holding the complete encoding in memory.
+ **/
+class DataBufferOutput : public Output
+{
+public:
+    struct Sink {
+        /**
+         * Consume data from the buffer, moving it from 'data' to
+         * 'dead'. Data left in the buffer is kept and handed over
+         * again on the next flush.
+         **/
+        virtual void flush(DataBuffer &buffer) = 0;
+        virtual ~Sink() {}
+    };
+
+private:
+    DataBuffer &_buffer;
+    Sink       &_sink;
+    size_t      _flush_limit;
+
+public:
+    DataBufferOutput(DataBuffer &buffer, Sink &sink, size_t flush_limit);
+    ~DataBufferOutput();
+    WritableMemory reserve(size_t bytes) override;
+    Output &commit(size_t bytes) override;
+    /**
+     * Hand all buffered data over to the sink, regardless of the
+     * flush limit.
+     **/
+    void flush();
+};
+
+} // namespace vespalib
@@ -59,6 +59,27 @@ public:
     Type type() const override { return DATA::instance; }
 };
 
+/**
+ * String and data values referring to memory owned by someone else,
+ * which must outlive the Slime they are part of. Used when decoding
+ * straight out of an input buffer.
+ **/
+class BorrowedStringValue : public Value {
+    Memory _value;
+public:
+    BorrowedStringValue(Memory str) : _value(str) {}
+    Memory asString() const override { return _value; }
+    Type type() const override { return STRING::instance; }
+};
+
+class BorrowedDataValue : public Value {
+    Memory _value;
+public:
+    BorrowedDataValue(Memory data) : _value(data) {}
+    Memory asData() const override { return _value; }
+    Type type() const override { return DATA::instance; }
+};
+
 } // namespace vespalib::slime
 } // namespace vespalib
 
@@ -67,3 +88,5 @@ VESPA_CAN_SKIP_DESTRUCTION(vespalib::slime::BasicLongValue);
 VESPA_CAN_SKIP_DESTRUCTION(vespalib::slime::BasicDoubleValue);
 VESPA_CAN_SKIP_DESTRUCTION(vespalib::slime::BasicStringValue);
 VESPA_CAN_SKIP_DESTRUCTION(vespalib::slime::BasicDataValue);
+VESPA_CAN_SKIP_DESTRUCTION(vespalib::slime::BorrowedStringValue);
+VESPA_CAN_SKIP_DESTRUCTION(vespalib::slime::BorrowedDataValue);
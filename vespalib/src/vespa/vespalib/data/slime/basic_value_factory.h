@@ -39,6 +39,18 @@ struct DataValueFactory : public ValueFactory {
     Value *create(Stash & stash) const override { return & stash.create<BasicDataValue>(input, stash); }
 };
 
+struct BorrowedStringValueFactory : public ValueFactory {
+    Memory input;
+    BorrowedStringValueFactory(Memory in) : input(in) {}
+    Value *create(Stash & stash) const override { return & stash.create<BorrowedStringValue>(input); }
+};
+
+struct BorrowedDataValueFactory : public ValueFactory {
+    Memory input;
+    BorrowedDataValueFactory(Memory in) : input(in) {}
+    Value *create(Stash & stash) const override { return & stash.create<BorrowedDataValue>(input); }
+};
+
 } // namespace vespalib::slime
 } // namespace vespalib
 
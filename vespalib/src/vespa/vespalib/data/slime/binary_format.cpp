@@ -125,12 +125,19 @@ template <bool remap_symbols>
 struct BinaryDecoder : SymbolHandler<remap_symbols>::type {
 
     InputReader &in;
+    Memory borrow; // strings and data inside this memory are not copied
 
     using SymbolHandler<remap_symbols>::type::hint_symbol_count;
     using SymbolHandler<remap_symbols>::type::add_symbol;
     using SymbolHandler<remap_symbols>::type::map_symbol;
 
-    BinaryDecoder(InputReader &input) : in(input) {}
+    BinaryDecoder(InputReader &input, Memory borrow_in) : in(input), borrow(borrow_in) {}
+
+    bool borrowed(Memory value) const {
+        return ((borrow.data != nullptr) &&
+                (value.data >= borrow.data) &&
+                ((value.data + value.size) <= (borrow.data + borrow.size)));
+    }
 
     Cursor &decodeNix(const Inserter &inserter) {
         return inserter.insertNix();
@@ -150,12 +157,14 @@ struct BinaryDecoder : SymbolHandler<remap_symbols>::type {
 
     Cursor &decodeString(const Inserter &inserter, uint32_t meta) {
         uint64_t size = read_size(in, meta);
-        return inserter.insertString(in.read(size));
+        Memory value = in.read(size);
+        return borrowed(value) ? inserter.insertBorrowedString(value) : inserter.insertString(value);
     }
 
     Cursor &decodeData(const Inserter &inserter, uint32_t meta) {
         uint64_t size = read_size(in, meta);
-        return inserter.insertData(in.read(size));
+        Memory value = in.read(size);
+        return borrowed(value) ? inserter.insertBorrowedData(value) : inserter.insertData(value);
     }
 
     Cursor &decodeArray(const Inserter &inserter, uint32_t meta);
@@ -228,10 +237,10 @@ BinaryDecoder<remap_symbols>::decodeObject(const Inserter &inserter, uint32_t me
 }
 
 template <bool remap_symbols>
-size_t decode(const Memory &memory, Slime &slime, const Inserter &inserter) {
+size_t decode(const Memory &memory, Slime &slime, const Inserter &inserter, bool borrow) {
     MemoryInput memory_input(memory);
     InputReader input(memory_input);
-    binary_format::BinaryDecoder<remap_symbols> decoder(input);
+    binary_format::BinaryDecoder<remap_symbols> decoder(input, borrow ? memory : Memory());
     decoder.decodeSymbolTable(slime);
     decoder.decodeValue(inserter);
     if (input.failed() && !remap_symbols) {
@@ -257,13 +266,19 @@ BinaryFormat::encode(const Slime &slime, Output &output)
 size_t
 BinaryFormat::decode(const Memory &memory, Slime &slime)
 {
-    return binary_format::decode<false>(memory, slime, SlimeInserter(slime));
+    return binary_format::decode<false>(memory, slime, SlimeInserter(slime), false);
+}
+
+size_t
+BinaryFormat::decode_borrowed(const Memory &memory, Slime &slime)
+{
+    return binary_format::decode<false>(memory, slime, SlimeInserter(slime), true);
 }
 
 size_t
 BinaryFormat::decode_into(const Memory &memory, Slime &slime, const Inserter &inserter)
 {
-    return binary_format::decode<true>(memory, slime, inserter);
+    return binary_format::decode<true>(memory, slime, inserter, false);
 }
 
 namespace binary_format {
@@ -18,6 +18,11 @@ namespace slime {
 struct BinaryFormat {
     static void encode(const Slime &slime, Output &output);
     static size_t decode(const Memory &memory, Slime &slime);
+    /**
+     * Decode without copying strings and data; they will refer
+     * directly into the given memory, which must outlive the Slime.
+     **/
+    static size_t decode_borrowed(const Memory &memory, Slime &slime);
     static size_t decode_into(const Memory &memory, Slime &slime, const Inserter &inserter);
 };
 
@@ -43,6 +43,14 @@ struct Cursor : public Inspector {
     virtual Cursor &setArray(Memory name) = 0;
     virtual Cursor &setObject(Memory name) = 0;
 
+    // strings and data referring to memory that must outlive the Slime
+    virtual Cursor &addBorrowedString(Memory str) = 0;
+    virtual Cursor &addBorrowedData(Memory data) = 0;
+    virtual Cursor &setBorrowedString(Symbol sym, Memory str) = 0;
+    virtual Cursor &setBorrowedData(Symbol sym, Memory data) = 0;
+    virtual Cursor &setBorrowedString(Memory name, Memory str) = 0;
+    virtual Cursor &setBorrowedData(Memory name, Memory data) = 0;
+
     virtual Symbol resolve(Memory symbol_name) = 0;
 };
 
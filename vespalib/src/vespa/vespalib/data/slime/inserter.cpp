@@ -15,6 +15,8 @@ Cursor &SlimeInserter::insertDouble(double value) const { return slime.setDouble
 Cursor &SlimeInserter::insertString(Memory value) const { return slime.setString(value); }
 Cursor &SlimeInserter::insertData(Memory value)   const { return slime.setData(value); }
 Cursor &SlimeInserter::insertData(ExtMemUP value) const { return slime.setData(std::move(value)); }
+Cursor &SlimeInserter::insertBorrowedString(Memory value) const { return slime.setBorrowedString(value); }
+Cursor &SlimeInserter::insertBorrowedData(Memory value) const { return slime.setBorrowedData(value); }
 Cursor &SlimeInserter::insertArray()              const { return slime.setArray(); }
 Cursor &SlimeInserter::insertObject()             const { return slime.setObject(); }
 
@@ -25,6 +27,8 @@ Cursor &ArrayInserter::insertDouble(double value) const { return cursor.addDoubl
 Cursor &ArrayInserter::insertString(Memory value) const { return cursor.addString(value); }
 Cursor &ArrayInserter::insertData(Memory value)   const { return cursor.addData(value); }
 Cursor &ArrayInserter::insertData(ExtMemUP value) const { return cursor.addData(std::move(value)); }
+Cursor &ArrayInserter::insertBorrowedString(Memory value) const { return cursor.addBorrowedString(value); }
+Cursor &ArrayInserter::insertBorrowedData(Memory value) const { return cursor.addBorrowedData(value); }
 Cursor &ArrayInserter::insertArray()              const { return cursor.addArray(); }
 Cursor &ArrayInserter::insertObject()             const { return cursor.addObject(); }
 
@@ -35,6 +39,8 @@ Cursor &ObjectSymbolInserter::insertDouble(double value) const { return cursor.s
 Cursor &ObjectSymbolInserter::insertString(Memory value) const { return cursor.setString(symbol, value); }
 Cursor &ObjectSymbolInserter::insertData(Memory value)   const { return cursor.setData(symbol, value); }
 Cursor &ObjectSymbolInserter::insertData(ExtMemUP value) const { return cursor.setData(symbol, std::move(value)); }
+Cursor &ObjectSymbolInserter::insertBorrowedString(Memory value) const { return cursor.setBorrowedString(symbol, value); }
+Cursor &ObjectSymbolInserter::insertBorrowedData(Memory value) const { return cursor.setBorrowedData(symbol, value); }
 Cursor &ObjectSymbolInserter::insertArray()              const { return cursor.setArray(symbol); }
 Cursor &ObjectSymbolInserter::insertObject()             const { return cursor.setObject(symbol); }
 
@@ -45,6 +51,8 @@ Cursor &ObjectInserter::insertDouble(double value) const { return cursor.setDoub
 Cursor &ObjectInserter::insertString(Memory value) const { return cursor.setString(name, value); }
 Cursor &ObjectInserter::insertData(Memory value)   const { return cursor.setData(name, value); }
 Cursor &ObjectInserter::insertData(ExtMemUP value) const { return cursor.setData(name, std::move(value)); }
+Cursor &ObjectInserter::insertBorrowedString(Memory value) const { return cursor.setBorrowedString(name, value); }
+Cursor &ObjectInserter::insertBorrowedData(Memory value) const { return cursor.setBorrowedData(name, value); }
 Cursor &ObjectInserter::insertArray()              const { return cursor.setArray(name); }
 Cursor &ObjectInserter::insertObject()             const { return cursor.setObject(name); }
 
@@ -29,6 +29,8 @@ struct Inserter {
     virtual Cursor &insertString(Memory value) const = 0;
     virtual Cursor &insertData(Memory value) const = 0;
     virtual Cursor &insertData(ExternalMemory::UP value) const = 0;
+    virtual Cursor &insertBorrowedString(Memory value) const = 0;
+    virtual Cursor &insertBorrowedData(Memory value) const = 0;
     virtual Cursor &insertArray() const = 0;
     virtual Cursor &insertObject() const = 0;
     virtual ~Inserter() {}
@@ -47,6 +49,8 @@ struct SlimeInserter : Inserter {
     Cursor &insertString(Memory value) const override;
     Cursor &insertData(Memory value) const override;
     Cursor &insertData(ExternalMemory::UP value) const override;
+    Cursor &insertBorrowedString(Memory value) const override;
+    Cursor &insertBorrowedData(Memory value) const override;
     Cursor &insertArray() const override;
     Cursor &insertObject() const override;
 };
@@ -62,6 +66,8 @@ struct ArrayInserter : Inserter {
     Cursor &insertString(Memory value) const override;
     Cursor &insertData(Memory value) const override;
     Cursor &insertData(ExternalMemory::UP value) const override;
+    Cursor &insertBorrowedString(Memory value) const override;
+    Cursor &insertBorrowedData(Memory value) const override;
     Cursor &insertArray() const override;
     Cursor &insertObject() const override;
 };
@@ -78,6 +84,8 @@ struct ObjectSymbolInserter : Inserter {
     Cursor &insertString(Memory value) const override;
     Cursor &insertData(Memory value) const override;
     Cursor &insertData(ExternalMemory::UP value) const override;
+    Cursor &insertBorrowedString(Memory value) const override;
+    Cursor &insertBorrowedData(Memory value) const override;
     Cursor &insertArray() const override;
     Cursor &insertObject() const override;
 };
@@ -94,6 +102,8 @@ struct ObjectInserter : Inserter {
     Cursor &insertString(Memory value) const override;
     Cursor &insertData(Memory value) const override;
     Cursor &insertData(ExternalMemory::UP value) const override;
+    Cursor &insertBorrowedString(Memory value) const override;
+    Cursor &insertBorrowedData(Memory value) const override;
     Cursor &insertArray() const override;
     Cursor &insertObject() const override;
 };
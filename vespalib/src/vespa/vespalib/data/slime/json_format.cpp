@@ -7,7 +7,11 @@
 #include <vespa/vespalib/data/memory_input.h>
 #include <vespa/vespalib/locale/c.h>
 #include <cmath>
+#include <cstring>
 #include <sstream>
+#ifdef __SSE2__
+#include <immintrin.h>
+#endif
 
 #include <vespa/log/log.h>
 LOG_SETUP(".vespalib.data.slime.json_format");
@@ -16,6 +20,59 @@ namespace vespalib::slime {
 
 namespace {
 
+bool needs_escape(uint8_t c) {
+    return ((c == '"') || (c == '\\') || (c < 0x20));
+}
+
+/**
+ * Find the first character in [pos, end) that must be escaped in a
+ * json string. Most strings contain none, so we look at as many bytes
+ * at a time as the target allows and let the caller copy the clean
+ * run in one go.
+ **/
+const char *find_escape(const char *pos, const char *end) {
+#ifdef __AVX2__
+    {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i control = _mm256_set1_epi8(0x1f);
+        for (; (end - pos) >= 32; pos += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+            __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote),
+                                                          _mm256_cmpeq_epi8(v, backslash)),
+                                          _mm256_cmpeq_epi8(_mm256_min_epu8(v, control), v));
+            uint32_t mask = _mm256_movemask_epi8(hit);
+            if (mask != 0) {
+                return pos + __builtin_ctz(mask);
+            }
+        }
+    }
+#endif
+#ifdef __SSE2__
+    {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control = _mm_set1_epi8(0x1f);
+        for (; (end - pos) >= 16; pos += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+            __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote),
+                                                    _mm_cmpeq_epi8(v, backslash)),
+                                       _mm_cmpeq_epi8(_mm_min_epu8(v, control), v));
+            uint32_t mask = _mm_movemask_epi8(hit);
+            if (mask != 0) {
+                return pos + __builtin_ctz(mask);
+            }
+        }
+    }
+#endif
+    for (; pos < end; ++pos) {
+        if (needs_escape(*pos)) {
+            return pos;
+        }
+    }
+    return end;
+}
+
 template <bool COMPACT>
 struct JsonEncoder : public ArrayTraverser,
                      public ObjectTraverser
@@ -72,33 +129,35 @@ struct JsonEncoder : public ArrayTraverser,
     }
     void encodeSTRING(const Memory &memory) {
         const char *hex = "0123456789ABCDEF";
-        char *p = out.reserve(memory.size * 6 + 2);
-        size_t len = 2;
+        char *start = out.reserve(memory.size * 6 + 2);
+        char *p = start;
         *p++ = '"';
         const char *pos = memory.data;
         const char *end = memory.data + memory.size;
-        for (; pos < end; ++pos) {
-            uint8_t c = *pos;
+        for (;;) {
+            const char *hit = find_escape(pos, end);
+            memcpy(p, pos, hit - pos);
+            p += (hit - pos);
+            if (hit == end) {
+                break;
+            }
+            uint8_t c = *hit;
             switch(c) {
-            case '"':  *p++ = '\\'; *p++ = '"';  len += 2; break;
-            case '\\': *p++ = '\\'; *p++ = '\\'; len += 2; break;
-            case '\b': *p++ = '\\'; *p++ = 'b';  len += 2; break;
-            case '\f': *p++ = '\\'; *p++ = 'f';  len += 2; break;
-            case '\n': *p++ = '\\'; *p++ = 'n';  len += 2; break;
-            case '\r': *p++ = '\\'; *p++ = 'r';  len += 2; break;
-            case '\t': *p++ = '\\'; *p++ = 't';  len += 2; break;
-            default:
-                if (c > 0x1f) {
-                    *p++ = c; ++len;
-                } else { // requires escaping according to RFC 4627
-                    *p++ = '\\'; *p++ = 'u'; *p++ = '0'; *p++ = '0';
-                    *p++ = hex[(c >> 4) & 0xf]; *p++ = hex[c & 0xf];
-                    len += 6;
-                }
+            case '"':  *p++ = '\\'; *p++ = '"';  break;
+            case '\\': *p++ = '\\'; *p++ = '\\'; break;
+            case '\b': *p++ = '\\'; *p++ = 'b';  break;
+            case '\f': *p++ = '\\'; *p++ = 'f';  break;
+            case '\n': *p++ = '\\'; *p++ = 'n';  break;
+            case '\r': *p++ = '\\'; *p++ = 'r';  break;
+            case '\t': *p++ = '\\'; *p++ = 't';  break;
+            default: // requires escaping according to RFC 4627
+                *p++ = '\\'; *p++ = 'u'; *p++ = '0'; *p++ = '0';
+                *p++ = hex[(c >> 4) & 0xf]; *p++ = hex[c & 0xf];
             }
+            pos = hit + 1;
         }
-        *p = '"';
-        out.commit(len);
+        *p++ = '"';
+        out.commit(p - start);
     }
     void encodeDATA(const Memory &memory) {
         const char *hex = "0123456789ABCDEF";
@@ -176,11 +235,13 @@ JsonEncoder<COMPACT>::field(const Memory &symbol_name, const Inspector &inspecto
 
 struct JsonDecoder {
     InputReader &in;
+    Memory borrow; // input being decoded, if strings may refer into it
     char c;
     vespalib::string key;
     vespalib::string value;
 
-    JsonDecoder(InputReader &reader) : in(reader), c(in.read()), key(), value() {}
+    JsonDecoder(InputReader &reader, Memory borrow_in)
+        : in(reader), borrow(borrow_in), c(in.read()), key(), value() {}
 
     void next() {
         c = in.try_read();
@@ -216,7 +277,7 @@ struct JsonDecoder {
 
     uint32_t readHexValue(uint32_t len);
     uint32_t dequoteUtf16();
-    void readString(vespalib::string &str);
+    bool readString(vespalib::string &str);
     void readKey();
     void decodeString(Inserter &inserter);
     void decodeObject(Inserter &inserter);
@@ -304,16 +365,20 @@ void writeUtf8(uint32_t codepoint, vespalib::string &str, uint32_t mask = 0xffff
     }
 }
 
-void
+// returns whether the string was read without any escapes, meaning
+// it is an exact copy of the input between the quotes.
+bool
 JsonDecoder::readString(vespalib::string &str)
 {
     str.clear();
+    bool plain = true;
     char quote = c;
     assert(quote == '"' || quote == '\'');
     next();
     for (;;) {
         switch (c) {
         case '\\':
+            plain = false;
             next();
             switch (c) {
             case '"': case '\\': case '/': case '\'':
@@ -334,7 +399,7 @@ JsonDecoder::readString(vespalib::string &str)
         case '"': case '\'':
             if (c == quote) {
                 next();
-                return;
+                return plain;
             } else {
                 str.push_back(c);
                 next();
@@ -342,7 +407,7 @@ JsonDecoder::readString(vespalib::string &str)
             break;
         case '\0':
             in.fail("unterminated string");
-            return;
+            return false;
         default:
             str.push_back(c);
             next();
@@ -354,7 +419,7 @@ JsonDecoder::readString(vespalib::string &str)
 void
 JsonDecoder::readKey() {
     switch (c) {
-    case '"': case '\'': return readString(key);
+    case '"': case '\'': readString(key); return;
     default:
         key.clear();
         for (;;) {
@@ -372,8 +437,13 @@ JsonDecoder::readKey() {
 void
 JsonDecoder::decodeString(Inserter &inserter)
 {
-    readString(value);
-    inserter.insertString(value);
+    size_t begin = in.get_offset(); // c is the opening quote
+    bool plain = readString(value);
+    if (plain && (borrow.data != nullptr) && !in.failed()) {
+        inserter.insertBorrowedString(Memory(borrow.data + begin, value.size()));
+    } else {
+        inserter.insertString(value);
+    }
 }
 
 void
@@ -482,11 +552,11 @@ JsonFormat::encode(const Slime &slime, Output &output, bool compact)
     encode(slime.get(), output, compact);
 }
 
-size_t
-JsonFormat::decode(Input &input, Slime &slime)
-{
+namespace {
+
+size_t decode_json(Input &input, Slime &slime, Memory borrow) {
     InputReader reader(input);
-    JsonDecoder decoder(reader);
+    JsonDecoder decoder(reader, borrow);
     decoder.decodeValue(slime);
     reader.try_unread();
     if (reader.failed()) {
@@ -497,11 +567,26 @@ JsonFormat::decode(Input &input, Slime &slime)
     return reader.failed() ? 0 : reader.get_offset();
 }
 
+} // namespace vespalib::slime::<unnamed>
+
+size_t
+JsonFormat::decode(Input &input, Slime &slime)
+{
+    return decode_json(input, slime, Memory());
+}
+
 size_t
 JsonFormat::decode(const Memory &memory, Slime &slime)
 {
     MemoryInput input(memory);
-    return decode(input, slime);
+    return decode_json(input, slime, Memory());
+}
+
+size_t
+JsonFormat::decode_borrowed(const Memory &memory, Slime &slime)
+{
+    MemoryInput input(memory);
+    return decode_json(input, slime, memory);
 }
 
 } // namespace vespalib::slime
@@ -20,6 +20,12 @@ struct JsonFormat {
     static void encode(const Slime &slime, Output &output, bool compact);
     static size_t decode(Input &input, Slime &slime);
     static size_t decode(const Memory &memory, Slime &slime);
+    /**
+     * Decode without copying strings that contain no escapes; they
+     * will refer directly into the given memory, which must outlive
+     * the Slime.
+     **/
+    static size_t decode_borrowed(const Memory &memory, Slime &slime);
 };
 
 } // namespace vespalib::slime
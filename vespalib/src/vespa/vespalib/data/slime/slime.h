@@ -157,6 +157,12 @@ public:
     Cursor &setData(slime::ExternalMemory::UP data) {
         return _root.set(slime::ExternalDataValueFactory(std::move(data)));
     }
+    Cursor &setBorrowedString(const Memory& str) {
+        return _root.set(slime::BorrowedStringValueFactory(str));
+    }
+    Cursor &setBorrowedData(const Memory& data) {
+        return _root.set(slime::BorrowedDataValueFactory(data));
+    }
     Cursor &setArray() {
         return _root.set(slime::ArrayValueFactory(*_names));
     }
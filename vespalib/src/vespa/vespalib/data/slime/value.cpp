@@ -129,6 +129,20 @@ Value::setData(Memory name, Memory data) { return setLeaf(name, DataValueFactory
 Cursor &
 Value::setData(Memory name, ExternalMemory::UP data) { return setLeaf(name, ExternalDataValueFactory(std::move(data))); }
 
+// borrowed strings and data
+Cursor &
+Value::addBorrowedString(Memory str) { return addLeaf(BorrowedStringValueFactory(str)); }
+Cursor &
+Value::addBorrowedData(Memory data) { return addLeaf(BorrowedDataValueFactory(data)); }
+Cursor &
+Value::setBorrowedString(Symbol sym, Memory str) { return setLeaf(sym, BorrowedStringValueFactory(str)); }
+Cursor &
+Value::setBorrowedData(Symbol sym, Memory data) { return setLeaf(sym, BorrowedDataValueFactory(data)); }
+Cursor &
+Value::setBorrowedString(Memory name, Memory str) { return setLeaf(name, BorrowedStringValueFactory(str)); }
+Cursor &
+Value::setBorrowedData(Memory name, Memory data) { return setLeaf(name, BorrowedDataValueFactory(data)); }
+
 // nop defaults for array/objects
 Cursor &
 Value::addArray() { return *NixValue::invalid(); }
@@ -81,6 +81,13 @@ public:
     Cursor &setArray(Memory name) override;
     Cursor &setObject(Memory name) override;
 
+    Cursor &addBorrowedString(Memory str) override;
+    Cursor &addBorrowedData(Memory data) override;
+    Cursor &setBorrowedString(Symbol sym, Memory str) override;
+    Cursor &setBorrowedData(Symbol sym, Memory data) override;
+    Cursor &setBorrowedString(Memory name, Memory str) override;
+    Cursor &setBorrowedData(Memory name, Memory data) override;
+
     Symbol resolve(Memory symbol_name) override;
 };
 
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/geo/zcurve.h>
 #include <vespa/vespalib/util/priority_queue.h>
 #include <vespa/vespalib/util/fiddle.h>
+#include <algorithm>
 
 namespace vespalib {
 namespace geo {
@@ -12,15 +13,21 @@ namespace {
 class ZAreaQueue
 {
 private:
-    struct MaxAreaErrorCmp {
-        bool operator()(const ZCurve::Area &a, const ZCurve::Area &b) const {
-            return (a.error() > b.error());
+    // areas with the highest cost are split first
+    struct Entry {
+        ZCurve::Area area;
+        int64_t      cost;
+        Entry(ZCurve::Area area_in, int64_t cost_in) : area(std::move(area_in)), cost(cost_in) {}
+    };
+    struct MaxCostCmp {
+        bool operator()(const Entry &a, const Entry &b) const {
+            return (a.cost > b.cost);
         }
     };
     typedef ZCurve::Area Area;
     typedef ZCurve::Range Range;
     typedef ZCurve::RangeVector RangeVector;
-    typedef PriorityQueue<Area, MaxAreaErrorCmp, LeftArrayHeap> Queue;
+    typedef PriorityQueue<Entry, MaxCostCmp, LeftArrayHeap> Queue;
 
     Queue   _queue;
     int64_t _total_estimate;
@@ -30,14 +37,16 @@ public:
 
     int64_t total_estimate() const { return _total_estimate; }
 
-    void put(Area area) {
+    void put(Area area, int64_t cost) {
         _total_estimate += area.estimate();
-        _queue.push(std::move(area));
+        _queue.push(Entry(std::move(area), cost));
     }
 
+    int64_t worst_cost() { return _queue.empty() ? 0 : _queue.front().cost; }
+
     Area get() {
         assert(!_queue.empty());
-        Area area(_queue.front());
+        Area area(_queue.front().area);
         _queue.pop_front();
         _total_estimate -= area.estimate();
         return area;
@@ -49,7 +58,7 @@ public:
         RangeVector ranges;
         ranges.reserve(_queue.size());
         while (!_queue.empty()) {
-            const Area &area = _queue.any();
+            const Area &area = _queue.any().area;
             ranges.push_back(Range(area.min.z, area.max.z));
             _queue.pop_any();
         }
@@ -63,30 +72,48 @@ private:
     typedef ZCurve::Area Area;
     typedef ZCurve::RangeVector RangeVector;
 
-    ZAreaQueue _queue;
+    ZAreaQueue            _queue;
+    const ZCurve::Circle *_circle;
+
+    void put(Area area) {
+        int64_t cost = area.error();
+        if (_circle != nullptr) {
+            if (!_circle->intersects(area)) {
+                return;
+            }
+            if (!_circle->contains(area)) {
+                // some of the area is outside the circle, guess half of it
+                cost += area.size() / 2;
+            }
+        }
+        _queue.put(std::move(area), cost);
+    }
 
 public:
-    ZAreaSplitter(int min_x, int min_y, int max_x, int max_y) : _queue() {
+    ZAreaSplitter(int min_x, int min_y, int max_x, int max_y, const ZCurve::Circle *circle = nullptr)
+        : _queue(),
+          _circle(circle)
+    {
         assert(min_x <= max_x);
         assert(min_y <= max_y);
         bool cross_x = (min_x < 0) != (max_x < 0);
         bool cross_y = (min_y < 0) != (max_y < 0);
         if (cross_x) {
             if (cross_y) {
-                _queue.put(Area(min_x, min_y,    -1,    -1));
-                _queue.put(Area(    0, min_y, max_x,    -1));
-                _queue.put(Area(min_x,     0,    -1, max_y));
-                _queue.put(Area(    0,     0, max_x, max_y));
+                put(Area(min_x, min_y,    -1,    -1));
+                put(Area(    0, min_y, max_x,    -1));
+                put(Area(min_x,     0,    -1, max_y));
+                put(Area(    0,     0, max_x, max_y));
             } else {
-                _queue.put(Area(min_x, min_y,    -1, max_y));
-                _queue.put(Area(    0, min_y, max_x, max_y));
+                put(Area(min_x, min_y,    -1, max_y));
+                put(Area(    0, min_y, max_x, max_y));
             }
         } else {
             if (cross_y) {
-                _queue.put(Area(min_x, min_y, max_x,    -1));
-                _queue.put(Area(min_x,     0, max_x, max_y));
+                put(Area(min_x, min_y, max_x,    -1));
+                put(Area(min_x,     0, max_x, max_y));
             } else {
-                _queue.put(Area(min_x, min_y, max_x, max_y));
+                put(Area(min_x, min_y, max_x, max_y));
             }
         }
     }
@@ -95,6 +122,8 @@ public:
 
     int64_t total_estimate() const { return _queue.total_estimate(); }
 
+    int64_t worst_cost() { return _queue.worst_cost(); }
+
     void split_worst() {
         Area area = _queue.get();
         uint32_t x_first_max, x_last_min;
@@ -102,20 +131,56 @@ public:
         uint32_t x_bits = bits::split_range(area.min.x, area.max.x, x_first_max, x_last_min);
         uint32_t y_bits = bits::split_range(area.min.y, area.max.y, y_first_max, y_last_min);
         if (x_bits > y_bits) {
-            _queue.put(Area(area.min.x, area.min.y, x_first_max, area.max.y));
-            _queue.put(Area(x_last_min, area.min.y,  area.max.x, area.max.y));
+            put(Area(area.min.x, area.min.y, x_first_max, area.max.y));
+            put(Area(x_last_min, area.min.y,  area.max.x, area.max.y));
         } else {
             assert(y_bits > 0);
-            _queue.put(Area(area.min.x, area.min.y, area.max.x, y_first_max));
-            _queue.put(Area(area.min.x, y_last_min, area.max.x,  area.max.y));
+            put(Area(area.min.x, area.min.y, area.max.x, y_first_max));
+            put(Area(area.min.x, y_last_min, area.max.x,  area.max.y));
         }
     }
 
     RangeVector extract_ranges() { return _queue.extract_ranges(); }
 };
 
+uint64_t distance(int32_t a, int32_t b) {
+    return (a > b) ? (uint64_t(int64_t(a) - b)) : (uint64_t(int64_t(b) - a));
+}
+
+int32_t clamp(int32_t value, int32_t min, int32_t max) {
+    return std::max(min, std::min(value, max));
+}
+
 } // namespace vespalib::geo::<unnamed>
 
+bool
+ZCurve::Circle::contains(int32_t px, int32_t py) const
+{
+    uint64_t dx = distance(px, x);
+    if (x_aspect != 0) {
+        dx = (dx * x_aspect) >> 32;
+    }
+    uint64_t dy = distance(py, y);
+    if ((dx > radius) || (dy > radius)) {
+        return false;
+    }
+    uint64_t radius2 = uint64_t(radius) * radius;
+    return (dx * dx <= radius2 - dy * dy);
+}
+
+bool
+ZCurve::Circle::intersects(const Area &area) const
+{
+    return contains(clamp(x, area.min.x, area.max.x), clamp(y, area.min.y, area.max.y));
+}
+
+bool
+ZCurve::Circle::contains(const Area &area) const
+{
+    return (contains(area.min.x, area.min.y) && contains(area.min.x, area.max.y) &&
+            contains(area.max.x, area.min.y) && contains(area.max.x, area.max.y));
+}
+
 ZCurve::BoundingBox::BoundingBox(int32_t minx,
                                  int32_t maxx,
                                  int32_t miny,
@@ -142,6 +207,25 @@ ZCurve::find_ranges(int min_x, int min_y,
     return ranges;
 }
 
+ZCurve::RangeVector
+ZCurve::find_ranges(int min_x, int min_y,
+                    int max_x, int max_y,
+                    const Circle &circle)
+{
+    // aim for no more than the bounding box itself, which is more
+    // than the circle it contains
+    int64_t estimate_target = ((int64_t(max_x) - min_x + 1) * (int64_t(max_y) - min_y + 1));
+    ZAreaSplitter splitter(min_x, min_y, max_x, max_y, &circle);
+    while (splitter.num_ranges() > 0 && splitter.total_estimate() > estimate_target &&
+           splitter.num_ranges() < 42 && splitter.worst_cost() > 0)
+    {
+        splitter.split_worst();
+    }
+    RangeVector ranges = splitter.extract_ranges();
+    std::sort(ranges.begin(), ranges.end());
+    return ranges;
+}
+
 int64_t
 ZCurve::encodeSlow(int32_t x, int32_t y)
 {
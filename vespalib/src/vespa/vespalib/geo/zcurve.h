@@ -183,7 +183,7 @@ public:
             assert((min_y <= max_y) && ((min_y < 0) == (max_y < 0)));
         }
         Area &operator=(Area &&rhs) { new ((void*)this) Area(rhs); return *this; }
-        int64_t size() const { return (max.x - min.x + 1) * (max.y - min.y + 1); }
+        int64_t size() const { return (int64_t(max.x) - min.x + 1) * (int64_t(max.y) - min.y + 1); }
         int64_t estimate() const { return (max.z - min.z + 1); }
         int64_t error() const { return estimate() - size(); }
     };
@@ -204,6 +204,22 @@ public:
     };
     typedef std::vector<Range> RangeVector;
 
+    /**
+     * A circle in xy-space, where x distances are scaled by
+     * x_aspect/2^32 when x_aspect is not 0, like geo locations.
+     **/
+    struct Circle {
+        int32_t  x;
+        int32_t  y;
+        uint32_t radius;
+        uint32_t x_aspect;
+        Circle(int32_t x_, int32_t y_, uint32_t radius_, uint32_t x_aspect_)
+            : x(x_), y(y_), radius(radius_), x_aspect(x_aspect_) {}
+        bool contains(int32_t px, int32_t py) const;
+        bool intersects(const Area &area) const;
+        bool contains(const Area &area) const;
+    };
+
     /**
      * Given an inclusive bounding box, return a set of ranges in
      * z-curve values that contain all points inside the bounding
@@ -213,6 +229,16 @@ public:
     static RangeVector find_ranges(int min_x, int min_y,
                                    int max_x, int max_y);
 
+    /**
+     * Like find_ranges above, but areas entirely outside the circle
+     * are left out and areas crossing its border are split further,
+     * so that the ranges follow the circle instead of its bounding
+     * box. The number of ranges is capped like for find_ranges.
+     **/
+    static RangeVector find_ranges(int min_x, int min_y,
+                                   int max_x, int max_y,
+                                   const Circle &circle);
+
     static int64_t
     encodeSlow(int32_t x, int32_t y);
 
@@ -2,6 +2,7 @@
 
 #include "avx.h"
 #include "avxprivate.hpp"
+#include "private_helpers.hpp"
 
 namespace vespalib::hwaccelrated {
 
@@ -17,4 +18,10 @@ AvxAccelrator::dotProduct(const double * af, const double * bf, size_t sz) const
     return avx::dotProductSelectAlignment<double, 32>(af, bf, sz);
 }
 
+size_t
+AvxAccelrator::populationCount(const uint64_t * a, size_t sz) const
+{
+    return helper::populationCount<4>(a, sz);
+}
+
 }
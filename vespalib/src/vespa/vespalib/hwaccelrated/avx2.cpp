@@ -2,6 +2,7 @@
 
 #include "avx2.h"
 #include "avxprivate.hpp"
+#include "private_helpers.hpp"
 
 namespace vespalib::hwaccelrated {
 
@@ -17,4 +18,29 @@ Avx2Accelrator::dotProduct(const double * af, const double * bf, size_t sz) cons
     return avx::dotProductSelectAlignment<double, 32>(af, bf, sz);
 }
 
+void
+Avx2Accelrator::and64(size_t offset, const BitSources & src, void * dest) const
+{
+    helper::andChunk<32>(offset, src, dest);
+}
+
+void
+Avx2Accelrator::or64(size_t offset, const BitSources & src, void * dest) const
+{
+    helper::orChunk<32>(offset, src, dest);
+}
+
+size_t
+Avx2Accelrator::intersectShifted(const uint64_t * a, size_t aSz, const uint64_t * b, size_t bSz,
+                                 uint64_t shift, uint64_t * dest) const
+{
+    return helper::intersectShifted<32>(a, aSz, b, bSz, shift, dest);
+}
+
+size_t
+Avx2Accelrator::foldAsciiWords(const void * toFold, size_t sz, void * folded) const
+{
+    return helper::foldAsciiWords<32>(static_cast<const uint8_t *>(toFold), sz, static_cast<uint8_t *>(folded));
+}
+
 }
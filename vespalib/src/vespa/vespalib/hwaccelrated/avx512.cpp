@@ -2,6 +2,7 @@
 
 #include "avx512.h"
 #include "avxprivate.hpp"
+#include "private_helpers.hpp"
 
 namespace vespalib:: hwaccelrated {
 
@@ -17,4 +18,29 @@ Avx512Accelrator::dotProduct(const double * af, const double * bf, size_t sz) co
     return avx::dotProductSelectAlignment<double, 64>(af, bf, sz);
 }
 
+void
+Avx512Accelrator::and64(size_t offset, const BitSources & src, void * dest) const
+{
+    helper::andChunk<64>(offset, src, dest);
+}
+
+void
+Avx512Accelrator::or64(size_t offset, const BitSources & src, void * dest) const
+{
+    helper::orChunk<64>(offset, src, dest);
+}
+
+size_t
+Avx512Accelrator::intersectShifted(const uint64_t * a, size_t aSz, const uint64_t * b, size_t bSz,
+                                   uint64_t shift, uint64_t * dest) const
+{
+    return helper::intersectShifted<64>(a, aSz, b, bSz, shift, dest);
+}
+
+size_t
+Avx512Accelrator::foldAsciiWords(const void * toFold, size_t sz, void * folded) const
+{
+    return helper::foldAsciiWords<64>(static_cast<const uint8_t *>(toFold), sz, static_cast<uint8_t *>(folded));
+}
+
 }
@@ -14,6 +14,11 @@ class Avx512Accelrator : public Avx2Accelrator
 public:
     float dotProduct(const float * a, const float * b, size_t sz) const override;
     double dotProduct(const double * a, const double * b, size_t sz) const override;
+    void and64(size_t offset, const BitSources & src, void * dest) const override;
+    void or64(size_t offset, const BitSources & src, void * dest) const override;
+    size_t intersectShifted(const uint64_t * a, size_t aSz, const uint64_t * b, size_t bSz,
+                            uint64_t shift, uint64_t * dest) const override;
+    size_t foldAsciiWords(const void * toFold, size_t sz, void * folded) const override;
 };
 
 }
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "generic.h"
+#include "private_helpers.hpp"
 
 namespace vespalib::hwaccelrated {
 
@@ -113,4 +114,35 @@ GenericAccelrator::notBit(void * aOrg, size_t bytes) const
     }
 }
 
+void
+GenericAccelrator::and64(size_t offset, const BitSources & src, void * dest) const
+{
+    helper::andChunk<16>(offset, src, dest);
+}
+
+void
+GenericAccelrator::or64(size_t offset, const BitSources & src, void * dest) const
+{
+    helper::orChunk<16>(offset, src, dest);
+}
+
+size_t
+GenericAccelrator::intersectShifted(const uint64_t * a, size_t aSz, const uint64_t * b, size_t bSz,
+                                    uint64_t shift, uint64_t * dest) const
+{
+    return helper::intersectShifted<16>(a, aSz, b, bSz, shift, dest);
+}
+
+size_t
+GenericAccelrator::foldAsciiWords(const void * toFold, size_t sz, void * folded) const
+{
+    return helper::foldAsciiWords<16>(static_cast<const uint8_t *>(toFold), sz, static_cast<uint8_t *>(folded));
+}
+
+size_t
+GenericAccelrator::populationCount(const uint64_t * a, size_t sz) const
+{
+    return helper::populationCount<4>(a, sz);
+}
+
 }
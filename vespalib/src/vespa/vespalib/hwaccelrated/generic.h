@@ -20,6 +20,12 @@ public:
     void andBit(void * a, const void * b, size_t bytes) const override;
     void andNotBit(void * a, const void * b, size_t bytes) const override;
     void notBit(void * a, size_t bytes) const override;
+    void and64(size_t offset, const BitSources & src, void * dest) const override;
+    void or64(size_t offset, const BitSources & src, void * dest) const override;
+    size_t intersectShifted(const uint64_t * a, size_t aSz, const uint64_t * b, size_t bSz,
+                            uint64_t shift, uint64_t * dest) const override;
+    size_t foldAsciiWords(const void * toFold, size_t sz, void * folded) const override;
+    size_t populationCount(const uint64_t * a, size_t sz) const override;
 };
 
 }
@@ -6,6 +6,7 @@
 #include "avx.h"
 #include "avx2.h"
 #include "avx512.h"
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".vespalib.hwaccelrated");
@@ -67,6 +68,94 @@ void verifyAccelrator(const IAccelrated & accel)
     delete [] b;
 }
 
+void verifyChunkedBitOperations(const IAccelrated & accel)
+{
+    constexpr size_t numWords = 3 * IAccelrated::CHUNK_BYTES / sizeof(uint64_t);
+    std::vector<uint64_t> a(numWords), b(numWords), c(numWords);
+    for (size_t i(0); i < numWords; i++) {
+        a[i] = 0x5555aaaa33330000ul + i;
+        b[i] = 0x0f0f0f0ff0f0f0f0ul ^ (i << 17);
+        c[i] = 0xffff00000000fffful - i;
+    }
+    IAccelrated::BitSources src = {{&a[0], false}, {&b[0], true}, {&c[0], false}};
+    for (size_t chunk(0); chunk < 3; chunk++) {
+        uint64_t andResult[IAccelrated::CHUNK_BYTES / sizeof(uint64_t)];
+        uint64_t orResult[IAccelrated::CHUNK_BYTES / sizeof(uint64_t)];
+        accel.and64(chunk * IAccelrated::CHUNK_BYTES, src, andResult);
+        accel.or64(chunk * IAccelrated::CHUNK_BYTES, src, orResult);
+        for (size_t j(0); j < IAccelrated::CHUNK_BYTES / sizeof(uint64_t); j++) {
+            size_t i = chunk * IAccelrated::CHUNK_BYTES / sizeof(uint64_t) + j;
+            if ((andResult[j] != (a[i] & ~b[i] & c[i])) || (orResult[j] != (a[i] | ~b[i] | c[i]))) {
+                fprintf(stderr, "Accelrator is not computing chunked bit operations correctly.\n");
+                LOG_ABORT("should not be reached");
+            }
+        }
+    }
+}
+
+void verifyIntersectShifted(const IAccelrated & accel)
+{
+    std::vector<uint64_t> a, b;
+    for (uint64_t i(0); i < 200; i++) {
+        a.push_back(3 * i);
+        b.push_back(2 * i + 5);
+    }
+    for (uint64_t shift(0); shift < 4; shift++) {
+        std::vector<uint64_t> expected;
+        for (uint64_t x : a) {
+            if (std::binary_search(b.begin(), b.end(), x + shift)) {
+                expected.push_back(x);
+            }
+        }
+        std::vector<uint64_t> result(a.size());
+        result.resize(accel.intersectShifted(&a[0], a.size(), &b[0], b.size(), shift, &result[0]));
+        if (result != expected) {
+            fprintf(stderr, "Accelrator is not computing shifted intersection correctly.\n");
+            LOG_ABORT("should not be reached");
+        }
+    }
+}
+
+void verifyFoldAsciiWords(const IAccelrated & accel)
+{
+    char text[256];
+    char folded[256];
+    for (size_t i(0); i < sizeof(text); i++) {
+        text[i] = i % 128;
+    }
+    size_t numFolded = accel.foldAsciiWords(text, sizeof(text), folded);
+    bool ok = (numFolded == sizeof(text));
+    for (size_t i(0); ok && (i < numFolded); i++) {
+        char c = text[i];
+        char expected = ((c >= '0') && (c <= '9')) || ((c >= 'a') && (c <= 'z'))
+                        ? c
+                        : ((c >= 'A') && (c <= 'Z')) ? (c + 'a' - 'A') : 0;
+        ok = (folded[i] == expected);
+    }
+    text[100] = char(0xc3);
+    ok = ok && (accel.foldAsciiWords(text, sizeof(text), folded) <= 100);
+    if (!ok) {
+        fprintf(stderr, "Accelrator is not folding ascii words correctly.\n");
+        LOG_ABORT("should not be reached");
+    }
+}
+
+void verifyPopulationCount(const IAccelrated & accel)
+{
+    std::vector<uint64_t> words;
+    size_t expected(0);
+    for (uint64_t i(0); i < 67; i++) {
+        words.push_back((i * 0x9e3779b97f4a7c15ul) ^ (i << 7));
+        for (uint64_t w(words.back()); w != 0; w &= w - 1) {
+            expected++;
+        }
+    }
+    if (accel.populationCount(&words[0], words.size()) != expected) {
+        fprintf(stderr, "Accelrator is not counting bits correctly.\n");
+        LOG_ABORT("should not be reached");
+    }
+}
+
 class RuntimeVerificator
 {
 public:
@@ -80,12 +169,20 @@ RuntimeVerificator::RuntimeVerificator()
    verifyAccelrator<double>(generic); 
    verifyAccelrator<int32_t>(generic); 
    verifyAccelrator<int64_t>(generic); 
+   verifyChunkedBitOperations(generic);
+   verifyIntersectShifted(generic);
+   verifyFoldAsciiWords(generic);
+   verifyPopulationCount(generic);
 
    IAccelrated::UP thisCpu(IAccelrated::getAccelrator());
    verifyAccelrator<float>(*thisCpu); 
    verifyAccelrator<double>(*thisCpu); 
    verifyAccelrator<int32_t>(*thisCpu); 
    verifyAccelrator<int64_t>(*thisCpu); 
+   verifyChunkedBitOperations(*thisCpu);
+   verifyIntersectShifted(*thisCpu);
+   verifyFoldAsciiWords(*thisCpu);
+   verifyPopulationCount(*thisCpu);
    
 }
 
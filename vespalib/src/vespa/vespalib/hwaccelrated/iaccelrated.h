@@ -4,6 +4,7 @@
 
 #include <memory>
 #include <cstdint>
+#include <vector>
 
 namespace vespalib::hwaccelrated {
 
@@ -16,6 +17,12 @@ class IAccelrated
 public:
     virtual ~IAccelrated() = default;
     typedef std::unique_ptr<IAccelrated> UP;
+    /**
+     * Sources for the chunked bit operations; a pointer to the start of
+     * each bit buffer and whether that buffer should be inverted.
+     */
+    typedef std::vector<std::pair<const void *, bool>> BitSources;
+    static constexpr size_t CHUNK_BYTES = 64;
     virtual float dotProduct(const float * a, const float * b, size_t sz) const = 0;
     virtual double dotProduct(const double * a, const double * b, size_t sz) const = 0;
     virtual int64_t dotProduct(const int32_t * a, const int32_t * b, size_t sz) const = 0;
@@ -24,6 +31,39 @@ public:
     virtual void andBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andNotBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void notBit(void * a, size_t bytes) const = 0;
+    /**
+     * Combine the CHUNK_BYTES (512 bits) found at byte 'offset' in all
+     * sources and write the result to 'dest'. 'offset' should be a
+     * multiple of CHUNK_BYTES and all sources must be readable for the
+     * whole chunk. Used by iterators that evaluate many bitvectors one
+     * chunk at a time instead of one word at a time.
+     */
+    virtual void and64(size_t offset, const BitSources & src, void * dest) const = 0;
+    virtual void or64(size_t offset, const BitSources & src, void * dest) const = 0;
+    /**
+     * Write each value x found in 'a' where x + 'shift' is also found
+     * in 'b' to 'dest', and return the number of values written. Both
+     * inputs must be sorted in increasing order. 'dest' may be the
+     * same buffer as 'a'. Used to match phrases on decoded position
+     * lists, where the positions of each term are shifted by the
+     * offset of that term in the phrase.
+     */
+    virtual size_t intersectShifted(const uint64_t * a, size_t aSz, const uint64_t * b, size_t bSz,
+                                    uint64_t shift, uint64_t * dest) const = 0;
+    /**
+     * Fold 7 bit ascii text for word matching: letters are lower
+     * cased, digits are kept and all other characters become 0.
+     * Whole vectors are folded until one holding a non-ascii byte is
+     * found, and the number of bytes folded is returned. The caller
+     * handles the remaining bytes. Used by streaming search.
+     */
+    virtual size_t foldAsciiWords(const void * toFold, size_t sz, void * folded) const = 0;
+    /**
+     * Count the number of bits set in the 'sz' words found at 'a'.
+     * Builds with the popcnt instruction where the cpu has it, as the
+     * generic builtin falls back to a slow bit twiddling call.
+     */
+    virtual size_t populationCount(const uint64_t * a, size_t sz) const = 0;
 
     static IAccelrated::UP getAccelrator() __attribute__((noinline));
 };
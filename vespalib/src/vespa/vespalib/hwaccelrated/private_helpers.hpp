@@ -0,0 +1,169 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "iaccelrated.h"
+#include <cstring>
+
+namespace vespalib::hwaccelrated::helper {
+
+namespace {
+
+/**
+ * Combines one 64 byte chunk of each source using vectors of VLEN
+ * bytes. Each source may be inverted before it is combined. This is
+ * compiled once for each accelrator, so the vector operations map
+ * directly to the instruction set that accelrator is built for.
+ */
+template <size_t VLEN, typename Operation>
+void
+combineChunk(Operation operation, size_t offset, const IAccelrated::BitSources & src, void * dest)
+{
+    static_assert((IAccelrated::CHUNK_BYTES % VLEN) == 0, "chunk must be a whole number of vectors");
+    constexpr size_t VectorsPerChunk = IAccelrated::CHUNK_BYTES / VLEN;
+    typedef uint64_t V __attribute__ ((vector_size (VLEN)));
+    typedef uint64_t U __attribute__ ((vector_size (VLEN), aligned(1)));
+
+    V combined[VectorsPerChunk];
+    {
+        const U * a = reinterpret_cast<const U *>(static_cast<const char *>(src[0].first) + offset);
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            combined[j] = src[0].second ? ~a[j] : a[j];
+        }
+    }
+    for (size_t i(1); i < src.size(); i++) {
+        const U * a = reinterpret_cast<const U *>(static_cast<const char *>(src[i].first) + offset);
+        if (src[i].second) {
+            for (size_t j(0); j < VectorsPerChunk; j++) {
+                combined[j] = operation(combined[j], ~a[j]);
+            }
+        } else {
+            for (size_t j(0); j < VectorsPerChunk; j++) {
+                combined[j] = operation(combined[j], a[j]);
+            }
+        }
+    }
+    memcpy(dest, combined, sizeof(combined));
+}
+
+template <size_t VLEN>
+void
+andChunk(size_t offset, const IAccelrated::BitSources & src, void * dest)
+{
+    typedef uint64_t V __attribute__ ((vector_size (VLEN)));
+    combineChunk<VLEN>([](V a, V b) { return a & b; }, offset, src, dest);
+}
+
+template <size_t VLEN>
+void
+orChunk(size_t offset, const IAccelrated::BitSources & src, void * dest)
+{
+    typedef uint64_t V __attribute__ ((vector_size (VLEN)));
+    combineChunk<VLEN>([](V a, V b) { return a | b; }, offset, src, dest);
+}
+
+
+/**
+ * Merge intersection of 'a' shifted by 'shift' with 'b'. Whole vectors
+ * of VLEN bytes of 'b' are skipped while their last value is too small,
+ * and the remaining vector is compared against the wanted value in one
+ * go. Output is written without branching on the outcome.
+ */
+template <size_t VLEN>
+size_t
+intersectShifted(const uint64_t * a, size_t aSz, const uint64_t * b, size_t bSz, uint64_t shift, uint64_t * dest)
+{
+    constexpr size_t N = VLEN / sizeof(uint64_t);
+    typedef uint64_t V __attribute__ ((vector_size (VLEN)));
+    typedef uint64_t U __attribute__ ((vector_size (VLEN), aligned(1)));
+
+    size_t found(0);
+    size_t j(0);
+    for (size_t i(0); i < aSz; i++) {
+        const uint64_t wanted = a[i] + shift;
+        while ((j + N <= bSz) && (b[j + N - 1] < wanted)) {
+            j += N;
+        }
+        bool hit(false);
+        if (j + N <= bSz) {
+            V eq = (*reinterpret_cast<const U *>(b + j) == (V{} + wanted));
+            uint64_t lanes[N];
+            memcpy(lanes, &eq, sizeof(lanes));
+            for (size_t k(0); k < N; k++) {
+                hit |= (lanes[k] != 0);
+            }
+        } else {
+            while ((j < bSz) && (b[j] < wanted)) {
+                j++;
+            }
+            hit = (j < bSz) && (b[j] == wanted);
+        }
+        dest[found] = a[i];
+        found += hit;
+    }
+    return found;
+}
+
+/**
+ * Fold whole vectors of VLEN bytes as long as they are pure ascii.
+ * Digits are found before lower casing, as or'ing in 0x20 would
+ * otherwise turn some control characters into digits.
+ */
+template <size_t VLEN>
+size_t
+foldAsciiWords(const uint8_t * toFold, size_t sz, uint8_t * folded)
+{
+    typedef int8_t V __attribute__ ((vector_size (VLEN)));
+    typedef int8_t U __attribute__ ((vector_size (VLEN), aligned(1)));
+
+    size_t i(0);
+    for (; i + VLEN <= sz; i += VLEN) {
+        V c = *reinterpret_cast<const U *>(toFold + i);
+        uint64_t words[VLEN / sizeof(uint64_t)];
+        memcpy(words, &c, sizeof(words));
+        uint64_t highBits(0);
+        for (uint64_t word : words) {
+            highBits |= word;
+        }
+        if ((highBits & 0x8080808080808080ul) != 0) {
+            break;
+        }
+        V low = c | 0x20;
+        V digit = (c >= '0') & (c <= '9');
+        V letter = (low >= 'a') & (low <= 'z');
+        *reinterpret_cast<U *>(folded + i) = (digit & c) | (letter & low);
+    }
+    return i;
+}
+
+/**
+ * Count bits set using UNROLL independent counters, so the popcnt
+ * instructions are not serialized on a single accumulator.
+ */
+template <size_t UNROLL>
+size_t
+populationCount(const uint64_t * a, size_t sz)
+{
+    size_t count[UNROLL];
+    for (size_t j(0); j < UNROLL; j++) {
+        count[j] = 0;
+    }
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            count[j] += __builtin_popcountl(a[i + j]);
+        }
+    }
+    for (; i < sz; i++) {
+        count[0] += __builtin_popcountl(a[i]);
+    }
+    size_t sum(0);
+    for (size_t j(0); j < UNROLL; j++) {
+        sum += count[j];
+    }
+    return sum;
+}
+
+}
+
+}
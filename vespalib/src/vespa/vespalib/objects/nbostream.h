@@ -158,6 +158,19 @@ public:
         memcpy(&_wbuf[_wp], v, sz);
         _wp += sz;
     }
+    /**
+     * Overwrite already written bytes, starting offset bytes after the
+     * current read position. Used to fill in a length that is only known
+     * after the data following it has been written.
+     */
+    void writeAt(size_t offset, const void *v, size_t sz) {
+        if (__builtin_expect(offset + sz <= left(), true)) {
+            memcpy(&_wbuf[_rp + offset], v, sz);
+        } else {
+            fail(eof);
+        }
+    }
+    void writeAt(size_t offset, uint32_t v) { uint32_t n(nbo::n2h(v)); writeAt(offset, &n, sizeof(n)); }
     void read(void *v, size_t sz) {
         if (__builtin_expect(left() >= sz, true)) {
             memcpy(v, &_rbuf[_rp], sz);
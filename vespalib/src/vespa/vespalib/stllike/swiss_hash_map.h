@@ -0,0 +1,88 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "swisstable.hpp"
+#include "hash_fun.h"
+
+namespace vespalib {
+
+/**
+ * Drop-in alternative to hash_map for hot lookups, backed by an open
+ * addressing swisstable. Offers the commonly used subset of the
+ * hash_map API; note that growing the map invalidates iterators and
+ * references to elements.
+ **/
+template <typename K, typename V, typename H = vespalib::hash<K>, typename EQ = std::equal_to<K>>
+class swiss_hash_map
+{
+public:
+    typedef std::pair<K, V> value_type;
+    typedef K key_type;
+    typedef V mapped_type;
+    using HashTable = swisstable<K, value_type, H, EQ, std::_Select1st<value_type>>;
+private:
+    HashTable _ht;
+public:
+    typedef typename HashTable::iterator iterator;
+    typedef typename HashTable::const_iterator const_iterator;
+    typedef typename HashTable::insert_result insert_result;
+public:
+    swiss_hash_map(size_t reserveSize=0) : _ht(reserveSize, H(), EQ()) {}
+    swiss_hash_map(size_t reserveSize, H hasher, EQ equality) : _ht(reserveSize, hasher, equality) {}
+    iterator begin()                         { return _ht.begin(); }
+    iterator end()                           { return _ht.end(); }
+    const_iterator begin()             const { return _ht.begin(); }
+    const_iterator end()               const { return _ht.end(); }
+    size_t capacity()                  const { return _ht.capacity(); }
+    size_t size()                      const { return _ht.size(); }
+    bool empty()                       const { return _ht.empty(); }
+    insert_result insert(const value_type & value) { return _ht.insert(value); }
+    insert_result insert(value_type &&value) { return _ht.insert(std::move(value)); }
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    template <typename Func>
+    void for_each(Func func) const { _ht.for_each(func); }
+    const V & operator [] (const K & key) const { return _ht.find(key)->second; }
+    V & operator [] (const K & key) {
+        iterator found = _ht.find(key);
+        if (found != _ht.end()) {
+            return found->second;
+        }
+        return _ht.insert(value_type(key, V())).first->second;
+    }
+    void erase(const K & key)                   { _ht.erase(key); }
+    void erase(iterator it)                     { _ht.erase(it); }
+    void erase(const_iterator it)               { _ht.erase(it); }
+    iterator find(const K & key)                { return _ht.find(key); }
+    const_iterator find(const K & key)    const { return _ht.find(key); }
+    void clear()                                { _ht.clear(); }
+    void resize(size_t newSize)                 { _ht.resize(newSize); }
+    void swap(swiss_hash_map & rhs)             { _ht.swap(rhs._ht); }
+    bool operator == (const swiss_hash_map & rhs) const {
+        if (size() != rhs.size()) {
+            return false;
+        }
+        for (const value_type &value: *this) {
+            const_iterator found = rhs.find(value.first);
+            if ((found == rhs.end()) || !(found->second == value.second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    size_t getMemoryConsumption() const { return _ht.getMemoryConsumption(); }
+    size_t getMemoryUsed() const { return _ht.getMemoryUsed(); }
+};
+
+template <typename K, typename V, typename H, typename EQ>
+void swap(swiss_hash_map<K, V, H, EQ> & a, swiss_hash_map<K, V, H, EQ> & b)
+{
+    a.swap(b);
+}
+
+}
@@ -0,0 +1,88 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "swisstable.hpp"
+#include "hash_fun.h"
+#include <initializer_list>
+
+namespace vespalib {
+
+/**
+ * Drop-in alternative to hash_set for hot lookups, backed by an open
+ * addressing swisstable. Offers the commonly used subset of the
+ * hash_set API; note that growing the set invalidates iterators.
+ **/
+template <typename K, typename H = vespalib::hash<K>, typename EQ = std::equal_to<K>>
+class swiss_hash_set
+{
+private:
+    using HashTable = swisstable<K, K, H, EQ, std::_Identity<K>>;
+    HashTable _ht;
+public:
+    typedef typename HashTable::iterator iterator;
+    typedef typename HashTable::const_iterator const_iterator;
+    typedef typename HashTable::insert_result insert_result;
+public:
+    swiss_hash_set(size_t reserveSize=0) : _ht(reserveSize, H(), EQ()) {}
+    swiss_hash_set(size_t reserveSize, const H & hasher, const EQ & equal) : _ht(reserveSize, hasher, equal) {}
+    swiss_hash_set(std::initializer_list<K> input) : _ht(input.size(), H(), EQ()) {
+        insert(input.begin(), input.end());
+    }
+    iterator begin()                         { return _ht.begin(); }
+    iterator end()                           { return _ht.end(); }
+    const_iterator begin()             const { return _ht.begin(); }
+    const_iterator end()               const { return _ht.end(); }
+    size_t capacity()                  const { return _ht.capacity(); }
+    size_t size()                      const { return _ht.size(); }
+    bool empty()                       const { return _ht.empty(); }
+    insert_result insert(const K & value)    { return _ht.insert(value); }
+    insert_result insert(K &&value)          { return _ht.insert(std::move(value)); }
+    template<typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+    void erase(const K & key)                { _ht.erase(key); }
+    iterator find(const K & key)             { return _ht.find(key); }
+    const_iterator find(const K & key) const { return _ht.find(key); }
+
+    template <typename Func>
+    void for_each(Func func) const { _ht.for_each(func); }
+
+    template< typename AltKey, typename AltExtract, typename AltHash, typename AltEqual >
+    const_iterator find(const AltKey & key, const AltExtract & altExtract) const {
+        return _ht.template find<AltKey, AltExtract, AltHash, AltEqual>(key, altExtract);
+    }
+
+    template< typename AltKey, typename AltExtract, typename AltHash, typename AltEqual >
+    iterator find(const AltKey & key, const AltExtract & altExtract) {
+        return _ht.template find<AltKey, AltExtract, AltHash, AltEqual>(key, altExtract);
+    }
+
+    void clear()                             { _ht.clear(); }
+    void resize(size_t newSize)              { _ht.resize(newSize); }
+    void swap(swiss_hash_set & rhs)          { _ht.swap(rhs._ht); }
+
+    bool operator==(const swiss_hash_set &rhs) const {
+        if (size() != rhs.size()) {
+            return false;
+        }
+        for (const K &key: *this) {
+            if (rhs.find(key) == rhs.end()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t getMemoryConsumption() const { return _ht.getMemoryConsumption(); }
+};
+
+template <typename K, typename H, typename EQ>
+void swap(swiss_hash_set<K, H, EQ> & a, swiss_hash_set<K, H, EQ> & b)
+{
+    a.swap(b);
+}
+
+}
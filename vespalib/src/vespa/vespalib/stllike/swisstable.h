@@ -0,0 +1,318 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace vespalib {
+
+/**
+ * Helpers shared by all instantiations of swisstable.
+ *
+ * Each slot in the table has a control byte. Free slots are marked
+ * EMPTY or DELETED (both negative), while a used slot holds the 7
+ * lowest bits of the hash of its key. Lookups load a group of 16
+ * control bytes at a time and compare them all against the wanted
+ * bits in one go, so the slots themselves are only touched for
+ * likely matches.
+ **/
+class swisstable_base
+{
+public:
+    using ctrl_t = int8_t;
+    static constexpr ctrl_t EMPTY = -128;
+    static constexpr ctrl_t DELETED = -2;
+    static constexpr size_t GROUP_WIDTH = 16;
+    static constexpr size_t MIN_CAPACITY = GROUP_WIDTH;
+
+    /**
+     * The hash functions in hash_fun.h are mostly identity functions,
+     * which is fine for prime sized tables but not for power of two
+     * sized ones picking bits from the hash.
+     **/
+    static size_t mix(size_t hash) {
+        uint64_t h = (uint64_t(hash) ^ (uint64_t(hash) >> 32)) * 0x9e3779b97f4a7c15ul;
+        return (h ^ (h >> 29));
+    }
+    static size_t h1(size_t hash) { return (hash >> 7); }
+    static ctrl_t h2(size_t hash) { return (hash & 0x7f); }
+    static bool is_full(ctrl_t c) { return (c >= 0); }
+
+    /** Max number of elements before the table must grow; 7/8 of capacity. */
+    static size_t capacity_to_growth(size_t capacity) { return capacity - capacity / 8; }
+    static size_t growth_to_capacity(size_t growth) {
+        size_t capacity = MIN_CAPACITY;
+        while (capacity_to_growth(capacity) < growth) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    class Group {
+    private:
+#ifdef __SSE2__
+        __m128i _ctrl;
+#else
+        const ctrl_t *_ctrl;
+#endif
+    public:
+        explicit Group(const ctrl_t *pos)
+#ifdef __SSE2__
+            : _ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos)))
+#else
+            : _ctrl(pos)
+#endif
+        {}
+        /** Bitmask of the positions holding the given control byte. */
+        uint32_t match(ctrl_t c) const {
+#ifdef __SSE2__
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(c), _ctrl));
+#else
+            uint32_t mask = 0;
+            for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+                mask |= (uint32_t(_ctrl[i] == c) << i);
+            }
+            return mask;
+#endif
+        }
+        uint32_t match_empty() const { return match(EMPTY); }
+        uint32_t match_empty_or_deleted() const {
+#ifdef __SSE2__
+            return _mm_movemask_epi8(_ctrl);
+#else
+            uint32_t mask = 0;
+            for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+                mask |= (uint32_t(!is_full(_ctrl[i])) << i);
+            }
+            return mask;
+#endif
+        }
+    };
+
+    /**
+     * Quadratic probing over groups. With a power of two capacity
+     * this visits every group before repeating.
+     **/
+    class ProbeSeq {
+    private:
+        size_t _mask;
+        size_t _offset;
+        size_t _index;
+    public:
+        ProbeSeq(size_t hash, size_t mask) : _mask(mask), _offset(h1(hash) & mask), _index(0) {}
+        size_t offset() const { return _offset; }
+        size_t offset(size_t i) const { return ((_offset + i) & _mask); }
+        void next() {
+            _index += GROUP_WIDTH;
+            _offset = ((_offset + _index) & _mask);
+        }
+    };
+};
+
+/**
+ * Open addressing hash table with SIMD probing of control bytes, in
+ * the style of the Swiss tables from Abseil. Elements are stored
+ * directly in a power of two sized slot array, so a successful lookup
+ * usually costs a single cache miss in the control bytes and one in
+ * the slots. Erasing leaves tombstones that are cleaned up when the
+ * table is rebuilt. Iterators and references are invalidated by
+ * inserts that grow the table.
+ *
+ * This is the engine behind swiss_hash_map and swiss_hash_set, which
+ * offer the commonly used subset of the hash_map and hash_set API.
+ **/
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+class swisstable : public swisstable_base
+{
+private:
+    template <typename TablePtr, typename V>
+    class iterator_base {
+    private:
+        TablePtr _table;
+        size_t   _idx;
+        void skip() {
+            while ((_idx < _table->_capacity) && !is_full(_table->_ctrl[_idx])) {
+                ++_idx;
+            }
+        }
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef V value_type;
+        typedef ptrdiff_t difference_type;
+        typedef V * pointer;
+        typedef V & reference;
+        iterator_base(TablePtr table, size_t idx) : _table(table), _idx(idx) {}
+        static iterator_base first(TablePtr table) {
+            iterator_base it(table, 0);
+            it.skip();
+            return it;
+        }
+        V & operator * () const { return _table->_slots[_idx]; }
+        V * operator -> () const { return &_table->_slots[_idx]; }
+        iterator_base & operator ++ () {
+            ++_idx;
+            skip();
+            return *this;
+        }
+        iterator_base operator ++ (int) {
+            iterator_base prev = *this;
+            ++*this;
+            return prev;
+        }
+        bool operator == (const iterator_base &rhs) const { return (_idx == rhs._idx); }
+        bool operator != (const iterator_base &rhs) const { return (_idx != rhs._idx); }
+        size_t getInternalIndex() const { return _idx; }
+        template <typename, typename> friend class iterator_base;
+        template <typename OtherPtr, typename OtherV>
+        iterator_base(const iterator_base<OtherPtr, OtherV> &rhs) : _table(rhs._table), _idx(rhs._idx) {}
+    };
+    static constexpr size_t npos = size_t(-1);
+
+    std::unique_ptr<ctrl_t[]> _ctrl;
+    Value                    *_slots;
+    size_t                    _capacity;
+    size_t                    _size;
+    size_t                    _growth_left;
+    Hash                      _hasher;
+    Equal                     _equal;
+    KeyExtract                _keyExtractor;
+
+    size_t hash(const Key &key) const { return mix(_hasher(key)); }
+    void set_ctrl(size_t idx, ctrl_t c) {
+        _ctrl[idx] = c;
+        if (idx < GROUP_WIDTH) { // mirrored after the end for unaligned group loads
+            _ctrl[_capacity + idx] = c;
+        }
+    }
+    template <typename AltKey, typename Eq>
+    size_t find_index(const AltKey &key, size_t hashValue, const Eq &eq) const;
+    size_t find_index(const Key &key) const {
+        auto eq = [this](const Value &value, const Key &k) { return _equal(_keyExtractor(value), k); };
+        return find_index(key, hash(key), eq);
+    }
+    size_t find_first_non_full(size_t hashValue) const;
+    size_t prepare_insert(size_t hashValue);
+    void allocate(size_t capacity);
+    void destroy_and_free();
+    void rehash(size_t capacity);
+    void grow();
+    template <typename V>
+    std::pair<size_t, bool> insert_internal(V &&value);
+public:
+    typedef iterator_base<swisstable *, Value> iterator;
+    typedef iterator_base<const swisstable *, const Value> const_iterator;
+    typedef std::pair<iterator, bool> insert_result;
+
+    swisstable(size_t reservedSpace, const Hash &hasher, const Equal &equal);
+    swisstable(const swisstable &rhs);
+    swisstable &operator = (const swisstable &rhs);
+    swisstable(swisstable &&rhs) noexcept;
+    swisstable &operator = (swisstable &&rhs) noexcept;
+    ~swisstable();
+
+    iterator begin() { return iterator::first(this); }
+    iterator end() { return iterator(this, _capacity); }
+    const_iterator begin() const { return const_iterator::first(this); }
+    const_iterator end() const { return const_iterator(this, _capacity); }
+    size_t capacity() const { return _capacity; }
+    size_t size() const { return _size; }
+    bool empty() const { return (_size == 0); }
+
+    iterator find(const Key &key) {
+        size_t idx = find_index(key);
+        return iterator(this, (idx == npos) ? _capacity : idx);
+    }
+    const_iterator find(const Key &key) const {
+        size_t idx = find_index(key);
+        return const_iterator(this, (idx == npos) ? _capacity : idx);
+    }
+    /**
+     * Lookup with a key of another type; AltHash must give the same
+     * hash values as Hash for equal keys.
+     **/
+    template <typename AltKey, typename AltExtract, typename AltHash, typename AltEqual>
+    iterator find(const AltKey &key, const AltExtract &altExtract);
+    template <typename AltKey, typename AltExtract, typename AltHash, typename AltEqual>
+    const_iterator find(const AltKey &key, const AltExtract &altExtract) const;
+
+    insert_result insert(const Value &value) {
+        auto res = insert_internal(value);
+        return insert_result(iterator(this, res.first), res.second);
+    }
+    insert_result insert(Value &&value) {
+        auto res = insert_internal(std::move(value));
+        return insert_result(iterator(this, res.first), res.second);
+    }
+    void erase(const Key &key);
+    void erase(const_iterator it);
+    void clear();
+    /** Make room for at least the given number of elements without growing. */
+    void resize(size_t newSize);
+    void swap(swisstable &rhs);
+
+    template <typename Func>
+    void for_each(Func func) const {
+        for (size_t i = 0; i < _capacity; ++i) {
+            if (is_full(_ctrl[i])) {
+                func(_slots[i]);
+            }
+        }
+    }
+    size_t getMemoryConsumption() const;
+    size_t getMemoryUsed() const;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+template <typename AltKey, typename Eq>
+size_t
+swisstable<Key, Value, Hash, Equal, KeyExtract>::find_index(const AltKey &key, size_t hashValue, const Eq &eq) const
+{
+    if (_capacity == 0) {
+        return npos;
+    }
+    ProbeSeq seq(hashValue, _capacity - 1);
+    for (;;) {
+        Group g(&_ctrl[seq.offset()]);
+        for (uint32_t mask = g.match(h2(hashValue)); mask != 0; mask &= (mask - 1)) {
+            size_t idx = seq.offset(__builtin_ctz(mask));
+            if (__builtin_expect(eq(_slots[idx], key), true)) {
+                return idx;
+            }
+        }
+        if (g.match_empty() != 0) {
+            return npos;
+        }
+        seq.next();
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+template <typename AltKey, typename AltExtract, typename AltHash, typename AltEqual>
+typename swisstable<Key, Value, Hash, Equal, KeyExtract>::iterator
+swisstable<Key, Value, Hash, Equal, KeyExtract>::find(const AltKey &key, const AltExtract &altExtract)
+{
+    const auto &self = *this;
+    return iterator(this, self.template find<AltKey, AltExtract, AltHash, AltEqual>(key, altExtract).getInternalIndex());
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+template <typename AltKey, typename AltExtract, typename AltHash, typename AltEqual>
+typename swisstable<Key, Value, Hash, Equal, KeyExtract>::const_iterator
+swisstable<Key, Value, Hash, Equal, KeyExtract>::find(const AltKey &key, const AltExtract &altExtract) const
+{
+    AltEqual altEqual;
+    auto eq = [&](const Value &value, const AltKey &k) {
+                  return altEqual(altExtract(_keyExtractor(value)), k);
+              };
+    size_t idx = find_index(key, mix(AltHash()(key)), eq);
+    return const_iterator(this, (idx == npos) ? _capacity : idx);
+}
+
+} // namespace vespalib
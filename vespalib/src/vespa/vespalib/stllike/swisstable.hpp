@@ -0,0 +1,292 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "swisstable.h"
+#include <algorithm>
+#include <new>
+
+namespace vespalib {
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+size_t
+swisstable<Key, Value, Hash, Equal, KeyExtract>::find_first_non_full(size_t hashValue) const
+{
+    ProbeSeq seq(hashValue, _capacity - 1);
+    for (;;) {
+        uint32_t mask = Group(&_ctrl[seq.offset()]).match_empty_or_deleted();
+        if (mask != 0) {
+            return seq.offset(__builtin_ctz(mask));
+        }
+        seq.next();
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+size_t
+swisstable<Key, Value, Hash, Equal, KeyExtract>::prepare_insert(size_t hashValue)
+{
+    if (_capacity == 0) {
+        grow();
+    }
+    size_t idx = find_first_non_full(hashValue);
+    if ((_growth_left == 0) && (_ctrl[idx] != DELETED)) {
+        grow();
+        idx = find_first_non_full(hashValue);
+    }
+    if (_ctrl[idx] == EMPTY) {
+        --_growth_left;
+    }
+    set_ctrl(idx, h2(hashValue));
+    ++_size;
+    return idx;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swisstable<Key, Value, Hash, Equal, KeyExtract>::allocate(size_t capacity)
+{
+    _ctrl.reset(new ctrl_t[capacity + GROUP_WIDTH]);
+    memset(_ctrl.get(), EMPTY, capacity + GROUP_WIDTH);
+    _slots = static_cast<Value *>(::operator new(capacity * sizeof(Value)));
+    _capacity = capacity;
+    _size = 0;
+    _growth_left = capacity_to_growth(capacity);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swisstable<Key, Value, Hash, Equal, KeyExtract>::destroy_and_free()
+{
+    for (size_t i = 0; i < _capacity; ++i) {
+        if (is_full(_ctrl[i])) {
+            _slots[i].~Value();
+        }
+    }
+    ::operator delete(_slots);
+    _slots = nullptr;
+    _ctrl.reset();
+    _capacity = 0;
+    _size = 0;
+    _growth_left = 0;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swisstable<Key, Value, Hash, Equal, KeyExtract>::rehash(size_t capacity)
+{
+    std::unique_ptr<ctrl_t[]> oldCtrl(std::move(_ctrl));
+    Value *oldSlots = _slots;
+    size_t oldCapacity = _capacity;
+    size_t size = _size;
+    allocate(capacity);
+    for (size_t i = 0; i < oldCapacity; ++i) {
+        if (is_full(oldCtrl[i])) {
+            size_t hashValue = hash(_keyExtractor(oldSlots[i]));
+            size_t idx = find_first_non_full(hashValue);
+            set_ctrl(idx, h2(hashValue));
+            new (&_slots[idx]) Value(std::move(oldSlots[i]));
+            oldSlots[i].~Value();
+        }
+    }
+    _size = size;
+    _growth_left -= size;
+    ::operator delete(oldSlots);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swisstable<Key, Value, Hash, Equal, KeyExtract>::grow()
+{
+    if ((_capacity > 0) && (_size <= capacity_to_growth(_capacity) / 2)) {
+        rehash(_capacity); // mostly tombstones; clean up instead of growing
+    } else {
+        rehash(std::max(MIN_CAPACITY, _capacity * 2));
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+template <typename V>
+std::pair<size_t, bool>
+swisstable<Key, Value, Hash, Equal, KeyExtract>::insert_internal(V &&value)
+{
+    const Key &key = _keyExtractor(value);
+    size_t hashValue = hash(key);
+    auto eq = [this](const Value &v, const Key &k) { return _equal(_keyExtractor(v), k); };
+    size_t idx = find_index(key, hashValue, eq);
+    if (idx != npos) {
+        return std::make_pair(idx, false);
+    }
+    idx = prepare_insert(hashValue);
+    new (&_slots[idx]) Value(std::forward<V>(value));
+    return std::make_pair(idx, true);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swisstable<Key, Value, Hash, Equal, KeyExtract>::swisstable(size_t reservedSpace, const Hash &hasher, const Equal &equal)
+    : _ctrl(),
+      _slots(nullptr),
+      _capacity(0),
+      _size(0),
+      _growth_left(0),
+      _hasher(hasher),
+      _equal(equal),
+      _keyExtractor()
+{
+    if (reservedSpace > 0) {
+        allocate(growth_to_capacity(reservedSpace));
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swisstable<Key, Value, Hash, Equal, KeyExtract>::swisstable(const swisstable &rhs)
+    : _ctrl(),
+      _slots(nullptr),
+      _capacity(0),
+      _size(0),
+      _growth_left(0),
+      _hasher(rhs._hasher),
+      _equal(rhs._equal),
+      _keyExtractor(rhs._keyExtractor)
+{
+    if (rhs._capacity > 0) {
+        // same capacity and hash gives the same layout
+        allocate(rhs._capacity);
+        memcpy(_ctrl.get(), rhs._ctrl.get(), _capacity + GROUP_WIDTH);
+        for (size_t i = 0; i < _capacity; ++i) {
+            if (is_full(_ctrl[i])) {
+                new (&_slots[i]) Value(rhs._slots[i]);
+            }
+        }
+        _size = rhs._size;
+        _growth_left = rhs._growth_left;
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swisstable<Key, Value, Hash, Equal, KeyExtract> &
+swisstable<Key, Value, Hash, Equal, KeyExtract>::operator = (const swisstable &rhs)
+{
+    swisstable tmp(rhs);
+    swap(tmp);
+    return *this;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swisstable<Key, Value, Hash, Equal, KeyExtract>::swisstable(swisstable &&rhs) noexcept
+    : _ctrl(std::move(rhs._ctrl)),
+      _slots(rhs._slots),
+      _capacity(rhs._capacity),
+      _size(rhs._size),
+      _growth_left(rhs._growth_left),
+      _hasher(std::move(rhs._hasher)),
+      _equal(std::move(rhs._equal)),
+      _keyExtractor(std::move(rhs._keyExtractor))
+{
+    rhs._slots = nullptr;
+    rhs._capacity = 0;
+    rhs._size = 0;
+    rhs._growth_left = 0;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swisstable<Key, Value, Hash, Equal, KeyExtract> &
+swisstable<Key, Value, Hash, Equal, KeyExtract>::operator = (swisstable &&rhs) noexcept
+{
+    swap(rhs);
+    return *this;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+swisstable<Key, Value, Hash, Equal, KeyExtract>::~swisstable()
+{
+    destroy_and_free();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swisstable<Key, Value, Hash, Equal, KeyExtract>::erase(const Key &key)
+{
+    size_t idx = find_index(key);
+    if (idx != npos) {
+        erase(const_iterator(this, idx));
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swisstable<Key, Value, Hash, Equal, KeyExtract>::erase(const_iterator it)
+{
+    size_t idx = it.getInternalIndex();
+    _slots[idx].~Value();
+    --_size;
+    // A lookup passing this slot has seen no empty slot in any group
+    // covering it, unless the groups before and after it both have
+    // one within reach. Only then may the slot become empty again.
+    size_t before = ((idx - GROUP_WIDTH) & (_capacity - 1));
+    uint32_t emptyAfter = Group(&_ctrl[idx]).match_empty();
+    uint32_t emptyBefore = Group(&_ctrl[before]).match_empty();
+    bool wasNeverFull = (emptyBefore != 0) && (emptyAfter != 0) &&
+                        ((__builtin_ctz(emptyAfter) + __builtin_clz(emptyBefore << 16)) < GROUP_WIDTH);
+    if (wasNeverFull) {
+        set_ctrl(idx, EMPTY);
+        ++_growth_left;
+    } else {
+        set_ctrl(idx, DELETED);
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swisstable<Key, Value, Hash, Equal, KeyExtract>::clear()
+{
+    for (size_t i = 0; i < _capacity; ++i) {
+        if (is_full(_ctrl[i])) {
+            _slots[i].~Value();
+        }
+    }
+    if (_capacity > 0) {
+        memset(_ctrl.get(), EMPTY, _capacity + GROUP_WIDTH);
+    }
+    _size = 0;
+    _growth_left = capacity_to_growth(_capacity);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swisstable<Key, Value, Hash, Equal, KeyExtract>::resize(size_t newSize)
+{
+    size_t capacity = growth_to_capacity(std::max(newSize, _size));
+    if (capacity > _capacity) {
+        rehash(capacity);
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+void
+swisstable<Key, Value, Hash, Equal, KeyExtract>::swap(swisstable &rhs)
+{
+    std::swap(_ctrl, rhs._ctrl);
+    std::swap(_slots, rhs._slots);
+    std::swap(_capacity, rhs._capacity);
+    std::swap(_size, rhs._size);
+    std::swap(_growth_left, rhs._growth_left);
+    std::swap(_hasher, rhs._hasher);
+    std::swap(_equal, rhs._equal);
+    std::swap(_keyExtractor, rhs._keyExtractor);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+size_t
+swisstable<Key, Value, Hash, Equal, KeyExtract>::getMemoryConsumption() const
+{
+    return sizeof(swisstable) + (_capacity > 0 ? (_capacity * (sizeof(Value) + 1) + GROUP_WIDTH) : 0);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal, typename KeyExtract>
+size_t
+swisstable<Key, Value, Hash, Equal, KeyExtract>::getMemoryUsed() const
+{
+    return sizeof(swisstable) + _size * sizeof(Value) + (_capacity > 0 ? (_capacity + GROUP_WIDTH) : 0);
+}
+
+} // namespace vespalib
@@ -0,0 +1,79 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "latency_trace.h"
+#include "tracelevel.h"
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <cstdlib>
+
+namespace vespalib {
+
+namespace {
+
+const string PREFIX("latency ");
+const string SUFFIX(" ms");
+
+void
+collectFrom(const TraceNode &node, LatencyTrace::StageMap &stages)
+{
+    string stage;
+    double millis(0.0);
+    if (node.hasNote() && LatencyTrace::parseNote(node.getNote(), stage, millis)) {
+        stages[stage] += millis;
+    }
+    for (uint32_t i = 0; i < node.getNumChildren(); ++i) {
+        collectFrom(node.getChild(i), stages);
+    }
+}
+
+}
+
+bool
+LatencyTrace::add(Trace &trace, stringref stage, double millis)
+{
+    if (!trace.shouldTrace(TraceLevel::LATENCY)) {
+        return false;
+    }
+    return trace.trace(TraceLevel::LATENCY, makeNote(stage, millis), false);
+}
+
+string
+LatencyTrace::makeNote(stringref stage, double millis)
+{
+    asciistream os;
+    os << PREFIX << stage << ' ' << asciistream::Precision(3) << forcedot << fixed << millis << SUFFIX;
+    return os.str();
+}
+
+bool
+LatencyTrace::parseNote(const string &note, string &stage, double &millis)
+{
+    if ((note.size() <= PREFIX.size() + SUFFIX.size()) ||
+        (note.substr(0, PREFIX.size()) != PREFIX) ||
+        (note.substr(note.size() - SUFFIX.size()) != SUFFIX))
+    {
+        return false;
+    }
+    size_t space = note.find(' ', PREFIX.size());
+    if ((space == string::npos) || (space == PREFIX.size()) || (space + 1 >= note.size() - SUFFIX.size())) {
+        return false;
+    }
+    string value(note.substr(space + 1, note.size() - SUFFIX.size() - space - 1));
+    char *end = nullptr;
+    double parsed = strtod(value.c_str(), &end);
+    if (end != value.c_str() + value.size()) {
+        return false;
+    }
+    stage = note.substr(PREFIX.size(), space - PREFIX.size());
+    millis = parsed;
+    return true;
+}
+
+LatencyTrace::StageMap
+LatencyTrace::collect(const TraceNode &root)
+{
+    StageMap stages;
+    collectFrom(root, stages);
+    return stages;
+}
+
+} // namespace vespalib
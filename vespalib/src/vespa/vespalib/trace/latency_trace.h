@@ -0,0 +1,54 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "trace.h"
+#include <map>
+
+namespace vespalib {
+
+/**
+ * Helpers for recording how long a routable spends in each stage along its
+ * path (queueing, encoding, persistence, ...) as ordinary trace notes at
+ * TraceLevel::LATENCY. Since the notes travel with the trace, a client that
+ * sends a request with trace level 2 or above gets the latency breakdown of
+ * that request back in the reply, and sampling is simply a matter of which
+ * requests are sent with tracing enabled.
+ */
+class LatencyTrace {
+private:
+    LatencyTrace(); // hide
+
+public:
+    using StageMap = std::map<string, double>;
+
+    /**
+     * Adds a latency note for the given stage if the trace level allows it.
+     *
+     * @param trace  The trace to add the note to.
+     * @param stage  The name of the stage, must not contain whitespace.
+     * @param millis The time spent in the stage, in milliseconds.
+     * @return True if the note was added.
+     */
+    static bool add(Trace &trace, stringref stage, double millis);
+
+    /**
+     * Returns the note recorded for the given stage and duration.
+     */
+    static string makeNote(stringref stage, double millis);
+
+    /**
+     * Parses a note created by makeNote().
+     *
+     * @return True if the note was a latency note.
+     */
+    static bool parseNote(const string &note, string &stage, double &millis);
+
+    /**
+     * Sums the time spent in each stage over all latency notes found in the
+     * given trace tree. Notes from parallel branches (e.g. replicas written
+     * by the distributor) are added together.
+     */
+    static StageMap collect(const TraceNode &root);
+};
+
+} // namespace vespalib
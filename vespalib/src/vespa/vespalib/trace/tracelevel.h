@@ -16,6 +16,10 @@ public:
         // Reply.
         ERROR = 1,
 
+        // The trace level used to record how long a routable spent in each
+        // stage along its path, see LatencyTrace.
+        LATENCY = 2,
+
         // The trace level used by messagebus when sending and receiving
         // messages and replies on network level.
         SEND_RECEIVE = 4,
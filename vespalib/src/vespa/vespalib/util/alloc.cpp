@@ -5,11 +5,13 @@
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/backtrace.h>
 #include <vespa/vespalib/util/sync.h>
+#include <vespa/vespalib/util/numa.h>
 #include <map>
 #include <atomic>
 #include <unordered_map>
 #include <vespa/fastos/file.h>
 #include <unistd.h>
+#include <fcntl.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".vespalib.alloc");
@@ -20,6 +22,7 @@ namespace {
 
 volatile bool _G_hasHugePageFailureJustHappened(false);
 bool _G_SilenceCoreOnOOM(false);
+bool _G_NumaInterleave(false);
 int  _G_HugeFlags = 0;
 const size_t _G_pageSize = getpagesize();
 size_t _G_MMapLogLimit = std::numeric_limits<size_t>::max();
@@ -68,6 +71,7 @@ void initializeEnvironment()
 {
     _G_HugeFlags = (getenv("VESPA_USE_HUGEPAGES") != nullptr) ? MAP_HUGETLB : 0;
     _G_SilenceCoreOnOOM = (getenv("VESPA_SILENCE_CORE_ON_OOM") != nullptr) ? true : false;
+    _G_NumaInterleave = (getenv("VESPA_NUMA_INTERLEAVE") != nullptr) ? true : false;
     _G_MMapLogLimit = readOptionalEnvironmentVar("VESPA_MMAP_LOG_LIMIT", std::numeric_limits<size_t>::max());
     _G_MMapNoCoreLimit = readOptionalEnvironmentVar("VESPA_MMAP_NOCORE_LIMIT", std::numeric_limits<size_t>::max());
 }
@@ -145,6 +149,9 @@ public:
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
     static size_t sresize_inplace(PtrAndSize current, size_t newSize);
     static PtrAndSize salloc(size_t sz, void * wantedAddress);
+    static PtrAndSize sallocHugePages(size_t sz);
+    static void adviseHugePages(void * buf, size_t sz);
+    static PtrAndSize smapFile(const char *fileName, size_t offset, size_t sz);
     static void sfree(PtrAndSize alloc);
     static MemoryAllocator & getDefault();
 private:
@@ -160,7 +167,7 @@ public:
     size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
     static MemoryAllocator & getDefault();
     static MemoryAllocator & getAllocator(size_t mmapLimit, size_t alignment);
-private:
+protected:
     size_t roundUpToHugePages(size_t sz) const {
         return (_mmapLimit >= MemoryAllocator::HUGEPAGE_SIZE)
             ? MMapAllocator::roundUpToHugePages(sz)
@@ -178,6 +185,18 @@ private:
     size_t _alignment;
 };
 
+/**
+ * Auto allocator where the mmapped buffers are aligned to huge page
+ * boundaries and advised to be backed by transparent huge pages.
+ */
+class HugePageAllocator : public AutoAllocator {
+public:
+    HugePageAllocator() : AutoAllocator(MemoryAllocator::HUGEPAGE_SIZE, 0) { }
+    PtrAndSize alloc(size_t sz) const override;
+    size_t resize_inplace(PtrAndSize current, size_t newSize) const override;
+    static MemoryAllocator & getDefault();
+};
+
 
 namespace {
 
@@ -238,6 +257,7 @@ alloc::AlignedHeapAllocator _G_4KalignedHeapAllocator(1024);
 alloc::AlignedHeapAllocator _G_1KalignedHeapAllocator(4096);
 alloc::AlignedHeapAllocator _G_512BalignedHeapAllocator(512);
 alloc::MMapAllocator _G_mmapAllocatorDefault;
+alloc::HugePageAllocator _G_hugePageAllocatorDefault;
 
 }
 
@@ -265,6 +285,11 @@ MMapAllocator::getDefault() {
     return _G_mmapAllocatorDefault;
 }
 
+MemoryAllocator &
+HugePageAllocator::getDefault() {
+    return _G_hugePageAllocatorDefault;
+}
+
 MemoryAllocator &
 AutoAllocator::getDefault() {
     return *_G_availableAutoAllocators.second;
@@ -352,6 +377,12 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
                 _G_hasHugePageFailureJustHappened = false;
             }
         }
+        if (_G_NumaInterleave) {
+            // Spread large buffers across nodes so no single memory controller gets all the traffic
+            if ( ! Numa::interleave(buf, sz)) {
+                LOG(debug, "Failed interleaving %ld bytes at %p across numa nodes", sz, buf);
+            }
+        }
         if (sz >= _G_MMapNoCoreLimit) {
             if (madvise(buf, sz, MADV_DONTDUMP) != 0) {
                 LOG(warning, "Failed madvise(%p, %ld, MADV_DONTDUMP) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
@@ -366,6 +397,78 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
     return PtrAndSize(buf, sz);
 }
 
+MemoryAllocator::PtrAndSize
+MMapAllocator::sallocHugePages(size_t sz)
+{
+    sz = roundUpToHugePages(sz);
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0);
+    }
+    // Find a huge page aligned hole by reserving address space with room to spare,
+    // then map the buffer at the aligned address inside it.
+    void * wantedAddress(nullptr);
+    void * reserved = mmap(nullptr, sz + HUGEPAGE_SIZE, PROT_NONE, MAP_ANON | MAP_PRIVATE | MAP_NORESERVE, -1, 0);
+    if (reserved != MAP_FAILED) {
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(reserved) + (HUGEPAGE_SIZE - 1)) & ~uintptr_t(HUGEPAGE_SIZE - 1);
+        wantedAddress = reinterpret_cast<void *>(aligned);
+        int retval = munmap(reserved, sz + HUGEPAGE_SIZE);
+        assert(retval == 0);
+        (void) retval;
+    }
+    PtrAndSize buf = salloc(sz, wantedAddress);
+    adviseHugePages(buf.first, buf.second);
+    return buf;
+}
+
+void
+MMapAllocator::adviseHugePages(void * buf, size_t sz)
+{
+#ifdef MADV_HUGEPAGE
+    if (madvise(buf, sz, MADV_HUGEPAGE) != 0) {
+        LOG(debug, "Failed madvise(%p, %ld, MADV_HUGEPAGE) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+    }
+#else
+    (void) buf;
+    (void) sz;
+#endif
+}
+
+MemoryAllocator::PtrAndSize
+MMapAllocator::smapFile(const char *fileName, size_t offset, size_t sz)
+{
+    if ((offset % _G_pageSize) != 0) {
+        throw IllegalArgumentException(make_string("Cannot mmap '%s' at offset %ld, not page aligned", fileName, offset));
+    }
+    sz = roundUp2PageSize(sz);
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0);
+    }
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        throw IllegalStateException(make_string("Failed opening '%s' for mmap errno(%d)", fileName, errno));
+    }
+    size_t mmapId = std::atomic_fetch_add(&_G_mmapCount, 1ul);
+    string stackTrace;
+    if (sz >= _G_MMapLogLimit) {
+        stackTrace = getStackTrace(1);
+        LOG(info, "mmap %ld of file '%s' size %ld from %s", mmapId, fileName, sz, stackTrace.c_str());
+    }
+    // Private writable mapping gives copy on write of the pages that are modified
+    void * buf = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, offset);
+    int savedErrno = errno;
+    close(fd);
+    if (buf == MAP_FAILED) {
+        throw IllegalStateException(make_string("Failed mmaping '%s' at offset %ld of size %ld errno(%d)",
+                                                fileName, offset, sz, savedErrno));
+    }
+    if (sz >= _G_MMapLogLimit) {
+        LockGuard guard(_G_lock);
+        _G_HugeMappings[buf] = MMapInfo(mmapId, sz, stackTrace);
+        LOG(info, "%ld mappings of accumulated size %ld", _G_HugeMappings.size(), sum(_G_HugeMappings));
+    }
+    return PtrAndSize(buf, sz);
+}
+
 size_t
 MMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize) {
     newSize = roundUp2PageSize(newSize);
@@ -451,6 +554,22 @@ AutoAllocator::free(PtrAndSize alloc) const {
     }
 }
 
+MemoryAllocator::PtrAndSize
+HugePageAllocator::alloc(size_t sz) const {
+    return useMMap(sz)
+        ? MMapAllocator::sallocHugePages(sz)
+        : HeapAllocator::salloc(sz);
+}
+
+size_t
+HugePageAllocator::resize_inplace(PtrAndSize current, size_t newSize) const {
+    size_t resized = AutoAllocator::resize_inplace(current, newSize);
+    if (resized > current.second) {
+        MMapAllocator::adviseHugePages(static_cast<char *>(current.first) + current.second, resized - current.second);
+    }
+    return resized;
+}
+
 Alloc
 Alloc::allocHeap(size_t sz)
 {
@@ -490,6 +609,18 @@ Alloc::allocMMap(size_t sz)
     return Alloc(&MMapAllocator::getDefault(), sz);
 }
 
+Alloc
+Alloc::allocHugePages(size_t sz)
+{
+    return Alloc(&HugePageAllocator::getDefault(), sz);
+}
+
+Alloc
+Alloc::allocMMapFile(const char *fileName, size_t offset, size_t sz)
+{
+    return Alloc(&MMapAllocator::getDefault(), MMapAllocator::smapFile(fileName, offset, sz));
+}
+
 Alloc
 Alloc::alloc()
 {
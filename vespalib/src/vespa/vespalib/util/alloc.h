@@ -94,6 +94,21 @@ public:
     static Alloc allocAlignedHeap(size_t sz, size_t alignment);
     static Alloc allocHeap(size_t sz=0);
     static Alloc allocMMap(size_t sz=0);
+    /**
+     * Like alloc(), but mmapped buffers are aligned to huge page boundaries
+     * and advised to be backed by transparent huge pages. Meant for large
+     * buffers with random access, where TLB misses dominate. Buffers below
+     * half a huge page are taken from the heap.
+     */
+    static Alloc allocHugePages(size_t sz=0);
+    /**
+     * Maps sz bytes of the given file, starting at offset, into private
+     * memory. Pages are shared with the page cache until modified, and
+     * modifications are never written back to the file. The offset must
+     * be page aligned, and offset + sz must not exceed the file size.
+     * Further allocations created from this one are anonymous mappings.
+     */
+    static Alloc allocMMapFile(const char *fileName, size_t offset, size_t sz);
     /**
      * Optional alignment is assumed to be <= system page size, since mmap
      * is always used when size is above limit.
@@ -103,6 +118,7 @@ public:
 private:
     Alloc(const MemoryAllocator * allocator, size_t sz) : _alloc(allocator->alloc(sz)), _allocator(allocator) { }
     Alloc(const MemoryAllocator * allocator) : _alloc(nullptr, 0), _allocator(allocator) { }
+    Alloc(const MemoryAllocator * allocator, PtrAndSize alloc) : _alloc(alloc), _allocator(allocator) { }
     void clear() {
         _alloc.first = nullptr;
         _alloc.second = 0;
@@ -41,6 +41,17 @@ CompressionConfig::Type compress(const CompressionConfig & compression, const ve
  */
 void decompress(const CompressionConfig::Type & compression, size_t uncompressedLen, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap);
 
+/**
+ * Will try to compress a buffer with the given compressor. If the criteria
+ * can not be met it will return NONE and leave dest untouched.
+ */
+CompressionConfig::Type compress(ICompressor & compressor, const CompressionConfig & compression, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest);
+
+/**
+ * Will decompress a buffer with the given decompressor.
+ */
+void decompress(ICompressor & decompressor, size_t uncompressedLen, const vespalib::ConstBufferRef & org, vespalib::DataBuffer & dest, bool allowSwap);
+
 size_t computeMaxCompressedsize(CompressionConfig::Type type, size_t uncompressedSize);
 
 }
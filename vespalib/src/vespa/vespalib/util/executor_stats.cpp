@@ -0,0 +1,162 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "executor_stats.h"
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+
+namespace vespalib {
+
+namespace {
+
+// longest time between cpu time samples for a busy worker
+constexpr auto maxCpuSampleInterval = std::chrono::milliseconds(10);
+
+double
+to_s(ExecutorThreadAccounting::clock::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+} // namespace vespalib::<unnamed>
+
+ExecutorStats &
+ExecutorStats::aggregate(const ExecutorStats &rhs)
+{
+    maxPendingTasks += rhs.maxPendingTasks;
+    acceptedTasks += rhs.acceptedTasks;
+    rejectedTasks += rhs.rejectedTasks;
+    executedTasks += rhs.executedTasks;
+    threads += rhs.threads;
+    wallTime = std::max(wallTime, rhs.wallTime);
+    busyTime += rhs.busyTime;
+    cpuTime += rhs.cpuTime;
+    waitTime += rhs.waitTime;
+    maxWaitTime = std::max(maxWaitTime, rhs.maxWaitTime);
+    for (size_t i = 0; i < NUM_RUN_TIME_BUCKETS; ++i) {
+        runTimeHistogram[i] += rhs.runTimeHistogram[i];
+    }
+    return *this;
+}
+
+double
+ExecutorStats::getUtilization() const
+{
+    double available = wallTime * threads;
+    return (available > 0.0) ? std::min(1.0, busyTime / available) : 0.0;
+}
+
+double
+ExecutorStats::getCpuUtilization() const
+{
+    double available = wallTime * threads;
+    return (available > 0.0) ? std::min(1.0, cpuTime / available) : 0.0;
+}
+
+double
+ExecutorStats::getAverageWaitTime() const
+{
+    return (executedTasks > 0) ? (waitTime / executedTasks) : 0.0;
+}
+
+double
+ExecutorStats::getRunTimePercentile(double fraction) const
+{
+    size_t total = 0;
+    for (size_t count : runTimeHistogram) {
+        total += count;
+    }
+    if (total == 0) {
+        return 0.0;
+    }
+    size_t seen = 0;
+    for (size_t i = 0; i < NUM_RUN_TIME_BUCKETS; ++i) {
+        seen += runTimeHistogram[i];
+        if (seen >= (fraction * total)) {
+            return runTimeBucketLimit(i);
+        }
+    }
+    return runTimeBucketLimit(NUM_RUN_TIME_BUCKETS - 1);
+}
+
+size_t
+ExecutorStats::runTimeBucket(double seconds)
+{
+    uint64_t us = (seconds > 0.0) ? uint64_t(seconds * 1000000.0 + 0.5) : 0;
+    size_t bits = (us == 0) ? 0 : (64 - __builtin_clzll(us));
+    return std::min(bits, NUM_RUN_TIME_BUCKETS - 1);
+}
+
+double
+ExecutorStats::runTimeBucketLimit(size_t bucket)
+{
+    return double(size_t(1) << bucket) / 1000000.0;
+}
+
+ExecutorThreadAccounting::ExecutorThreadAccounting()
+    : _pending(),
+      _lastTaskEnd(clock::now()),
+      _lastCpuSample(_lastTaskEnd),
+      _cpuStart(threadCpuTime())
+{
+}
+
+void
+ExecutorThreadAccounting::sampleCpu(ExecutorStats &stats)
+{
+    double now = threadCpuTime();
+    stats.cpuTime += (now - _cpuStart);
+    _cpuStart = now;
+    _lastCpuSample = _lastTaskEnd;
+}
+
+void
+ExecutorThreadAccounting::taskDone(clock::time_point queued, clock::time_point start, clock::time_point end)
+{
+    double runTime = to_s(end - start);
+    double waitTime = std::max(0.0, to_s(start - queued));
+    ++_pending.executedTasks;
+    _pending.busyTime += runTime;
+    _pending.waitTime += waitTime;
+    _pending.maxWaitTime = std::max(_pending.maxWaitTime, waitTime);
+    ++_pending.runTimeHistogram[ExecutorStats::runTimeBucket(runTime)];
+    _lastTaskEnd = end;
+}
+
+void
+ExecutorThreadAccounting::flush(ExecutorStats &stats, bool idle)
+{
+    if (_pending.executedTasks > 0) {
+        stats.executedTasks += _pending.executedTasks;
+        stats.busyTime += _pending.busyTime;
+        stats.waitTime += _pending.waitTime;
+        stats.maxWaitTime = std::max(stats.maxWaitTime, _pending.maxWaitTime);
+        for (size_t i = 0; i < ExecutorStats::NUM_RUN_TIME_BUCKETS; ++i) {
+            stats.runTimeHistogram[i] += _pending.runTimeHistogram[i];
+        }
+        _pending = ExecutorStats();
+    }
+    if (idle || ((_lastTaskEnd - _lastCpuSample) >= maxCpuSampleInterval)) {
+        sampleCpu(stats);
+    }
+}
+
+void
+ExecutorThreadAccounting::wakeup()
+{
+    _cpuStart = threadCpuTime();
+    _lastTaskEnd = clock::now();
+    _lastCpuSample = _lastTaskEnd;
+}
+
+double
+ExecutorThreadAccounting::threadCpuTime()
+{
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0.0;
+    }
+    return ts.tv_sec + (ts.tv_nsec / 1000000000.0);
+}
+
+}
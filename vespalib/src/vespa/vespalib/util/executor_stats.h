@@ -2,17 +2,111 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
+#include <cstddef>
+
 namespace vespalib {
 
 /**
  * Struct representing stats for an executor.
+ *
+ * Times are in seconds and summed over all worker threads. Busy time
+ * is wall time spent running tasks, cpu time is the cpu time used by
+ * the worker threads while doing so, and wait time is the time tasks
+ * spent queued before a worker started running them. Wall time is
+ * the length of the period the stats cover.
  **/
 struct ExecutorStats {
+    // bucket 0 counts tasks running for less than 1 us, bucket i > 0
+    // tasks running for [2^(i-1), 2^i) us, and the last one the rest
+    static constexpr size_t NUM_RUN_TIME_BUCKETS = 24;
+    using RunTimeHistogram = std::array<size_t, NUM_RUN_TIME_BUCKETS>;
+
     size_t maxPendingTasks;
     size_t acceptedTasks;
     size_t rejectedTasks;
-    ExecutorStats() : maxPendingTasks(0), acceptedTasks(0), rejectedTasks(0) {}
+    size_t executedTasks;
+    size_t threads;
+    double wallTime;
+    double busyTime;
+    double cpuTime;
+    double waitTime;
+    double maxWaitTime;
+    RunTimeHistogram runTimeHistogram;
+
+    ExecutorStats()
+        : maxPendingTasks(0), acceptedTasks(0), rejectedTasks(0), executedTasks(0), threads(0),
+          wallTime(0.0), busyTime(0.0), cpuTime(0.0), waitTime(0.0), maxWaitTime(0.0), runTimeHistogram()
+    {}
+
+    /**
+     * Add the stats of another executor (or part of one) running in
+     * parallel with this one.
+     **/
+    ExecutorStats &aggregate(const ExecutorStats &rhs);
+
+    // fraction of the available thread time spent running tasks
+    double getUtilization() const;
+    // fraction of the available thread time spent on the cpu
+    double getCpuUtilization() const;
+    double getAverageWaitTime() const;
+
+    /**
+     * @return upper bound (in seconds) of the run time of the given
+     *         fraction of executed tasks, as seen by the histogram.
+     **/
+    double getRunTimePercentile(double fraction) const;
+
+    static size_t runTimeBucket(double seconds);
+    static double runTimeBucketLimit(size_t bucket);
 };
 
-}
+/**
+ * Task time accounting for a single executor worker thread. Task
+ * times are collected locally and moved into the shared stats of
+ * the executor when the worker is holding the executor lock anyway.
+ * Thread cpu time is sampled per batch of tasks, that is when the
+ * worker goes idle and at most every few milliseconds while it is
+ * busy, to keep the overhead per task low.
+ *
+ * Must be created and used by the worker thread itself.
+ **/
+class ExecutorThreadAccounting
+{
+public:
+    using clock = std::chrono::steady_clock;
 
+private:
+    ExecutorStats     _pending;
+    clock::time_point _lastTaskEnd;
+    clock::time_point _lastCpuSample;
+    double            _cpuStart;
+
+    void sampleCpu(ExecutorStats &stats);
+
+public:
+    ExecutorThreadAccounting();
+
+    /**
+     * Record a task that was queued at the given time and ran from
+     * start to end.
+     **/
+    void taskDone(clock::time_point queued, clock::time_point start, clock::time_point end);
+
+    /**
+     * Move recorded times into the executor stats. Should be called
+     * with the executor lock held. Set idle if the worker is about to
+     * wait for more tasks.
+     **/
+    void flush(ExecutorStats &stats, bool idle);
+
+    /**
+     * The worker was given new work after waiting.
+     **/
+    void wakeup();
+
+    static double threadCpuTime();
+};
+
+}
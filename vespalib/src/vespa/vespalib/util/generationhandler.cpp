@@ -1,16 +1,37 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "generationhandler.h"
+#include <algorithm>
 
 namespace vespalib {
 
+namespace {
+
+std::atomic<uint32_t> _nextThreadSlotLine(0);
+
+// Threads are spread evenly over the slot lines, in order of first use.
+uint32_t threadSlotLine() {
+    thread_local uint32_t line = _nextThreadSlotLine.fetch_add(1, std::memory_order_relaxed);
+    return line;
+}
+
+}
+
 GenerationHandler::Guard::Guard()
-    : _hold(nullptr)
+    : _hold(nullptr),
+      _slot(nullptr)
 {
 }
 
 GenerationHandler::Guard::Guard(GenerationHold *hold)
-    : _hold(hold->acquire())
+    : _hold(hold->acquire()),
+      _slot(nullptr)
+{
+}
+
+GenerationHandler::Guard::Guard(ReaderSlot *slot)
+    : _hold(nullptr),
+      _slot(slot)
 {
 }
 
@@ -20,14 +41,17 @@ GenerationHandler::Guard::~Guard()
 }
 
 GenerationHandler::Guard::Guard(const Guard & rhs)
-    : _hold(GenerationHold::copy(rhs._hold))
+    : _hold(GenerationHold::copy(rhs._hold)),
+      _slot(ReaderSlot::copy(rhs._slot))
 {
 }
 
 GenerationHandler::Guard::Guard(Guard &&rhs)
-    : _hold(rhs._hold)
+    : _hold(rhs._hold),
+      _slot(rhs._slot)
 {
     rhs._hold = nullptr;
+    rhs._slot = nullptr;
 }
 
 GenerationHandler::Guard &
@@ -36,6 +60,7 @@ GenerationHandler::Guard::operator=(const Guard & rhs)
     if (&rhs != this) {
         cleanup();
         _hold = GenerationHold::copy(rhs._hold);
+        _slot = ReaderSlot::copy(rhs._slot);
     }
     return *this;
 }
@@ -46,7 +71,9 @@ GenerationHandler::Guard::operator=(Guard &&rhs)
     if (&rhs != this) {
         cleanup();
         _hold = rhs._hold;
+        _slot = rhs._slot;
         rhs._hold = nullptr;
+        rhs._slot = nullptr;
     }
     return *this;
 }
@@ -70,13 +97,49 @@ GenerationHandler::updateFirstUsedGeneration()
         toFree->_next = _free;
         _free = toFree;
     }
-    _firstUsedGeneration = _first->_generation;
+    generation_t firstUsed = _first->_generation;
+    // Pairs with the reader rechecking the current generation after
+    // announcing its own; a reader we miss will move on to a newer one.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (size_t i = 0; i < NumSlots; ++i) {
+        const ReaderSlot &slot = getSlot(i);
+        if (slot._refCount.load(std::memory_order_seq_cst) != 0) {
+            firstUsed = std::min(firstUsed, slot._generation.load(std::memory_order_seq_cst));
+        }
+    }
+    // A slot just being acquired might still show the generation of
+    // its previous user, making the minimum lower than it should be.
+    // Real readers never hold anything older than the previous result.
+    _firstUsedGeneration = std::max(_firstUsedGeneration, firstUsed);
+}
+
+GenerationHandler::ReaderSlot *
+GenerationHandler::acquireSlot() const
+{
+    size_t first = (threadSlotLine() % NumSlotLines) * SlotsPerLine;
+    for (size_t i = 0; i < MaxSlotProbes; ++i) {
+        ReaderSlot &slot = getSlot((first + i) % NumSlots);
+        uint32_t refCount = slot._refCount.load(std::memory_order_relaxed);
+        if ((refCount == 0) && slot._refCount.compare_exchange_strong(refCount, 1, std::memory_order_seq_cst)) {
+            generation_t gen = _generation.load(std::memory_order_relaxed);
+            for (;;) {
+                slot._generation.store(gen, std::memory_order_seq_cst);
+                generation_t current = _generation.load(std::memory_order_seq_cst);
+                if (current == gen) {
+                    return &slot;
+                }
+                gen = current; // writer moved on, it might not have seen us
+            }
+        }
+    }
+    return nullptr;
 }
 
 
 GenerationHandler::GenerationHandler()
     : _generation(0),
       _firstUsedGeneration(0),
+      _slotLines(new ReaderSlotLine[NumSlotLines]),
       _last(nullptr),
       _first(nullptr),
       _free(nullptr),
@@ -84,7 +147,7 @@ GenerationHandler::GenerationHandler()
 {
     _last = _first = new GenerationHold;
     ++_numHolds;
-    _last->_generation = _generation;
+    _last->_generation = getCurrentGeneration();
     _last->setValid();
 }
 
@@ -94,6 +157,7 @@ GenerationHandler::~GenerationHandler(void)
 
     updateFirstUsedGeneration();
     assert(_first == _last);
+    assert(getGenerationRefCount() == 0);
     while (_free != nullptr) {
         GenerationHold *toFree = _free;
         _free = toFree->_next;
@@ -107,6 +171,10 @@ GenerationHandler::~GenerationHandler(void)
 GenerationHandler::Guard
 GenerationHandler::takeGuard() const
 {
+    ReaderSlot *slot = acquireSlot();
+    if (slot != nullptr) {
+        return Guard(slot);
+    }
     Guard guard(_last);
     for (;;) {
         // Must check valid() after increasing refcount
@@ -132,7 +200,7 @@ GenerationHandler::incGeneration()
     if (_last->getRefCount() == 0) {
         // Last generation is unused, morph it to new generation.  This is
         // the typical case when no readers are present.
-        _generation = ngen;
+        _generation.store(ngen, std::memory_order_seq_cst);
         _last->_generation = ngen;
         std::atomic_thread_fence(std::memory_order_release);
         updateFirstUsedGeneration();
@@ -156,7 +224,7 @@ GenerationHandler::incGeneration()
 
     // next pointer must be updated before _last is updated
     std::atomic_thread_fence(std::memory_order_release);
-    _generation = ngen;
+    _generation.store(ngen, std::memory_order_seq_cst);
     _last = nhold;
 
     // _last must be updated before _first is changed
@@ -168,15 +236,23 @@ GenerationHandler::incGeneration()
 uint32_t
 GenerationHandler::getGenerationRefCount(generation_t gen) const
 {
-    if (static_cast<sgeneration_t>(gen - _generation) > 0)
+    if (static_cast<sgeneration_t>(gen - getCurrentGeneration()) > 0)
         return 0u;
     if (static_cast<sgeneration_t>(_firstUsedGeneration - gen) > 0)
         return 0u;
+    uint32_t ret = 0;
+    for (size_t i = 0; i < NumSlots; ++i) {
+        const ReaderSlot &slot = getSlot(i);
+        uint32_t refCount = slot._refCount.load(std::memory_order_acquire);
+        if ((refCount != 0) && (slot._generation.load(std::memory_order_relaxed) == gen)) {
+            ret += refCount;
+        }
+    }
     for (GenerationHold *hold = _first; hold != nullptr; hold = hold->_next) {
         if (hold->_generation == gen)
-            return hold->getRefCount();
+            return ret + hold->getRefCount();
     }
-    return 0u;
+    return ret;
 }
 
 
@@ -184,6 +260,9 @@ uint64_t
 GenerationHandler::getGenerationRefCount(void) const
 {
     uint64_t ret = 0;
+    for (size_t i = 0; i < NumSlots; ++i) {
+        ret += getSlot(i)._refCount.load(std::memory_order_acquire);
+    }
     for (GenerationHold *hold = _first; hold != nullptr; hold = hold->_next) {
         ret += hold->getRefCount();
     }
@@ -194,6 +273,11 @@ GenerationHandler::getGenerationRefCount(void) const
 bool
 GenerationHandler::hasReaders(void) const
 {
+    for (size_t i = 0; i < NumSlots; ++i) {
+        if (getSlot(i)._refCount.load(std::memory_order_acquire) != 0) {
+            return true;
+        }
+    }
     return (_first != _last) ? true : (_first->getRefCount() > 0);
 }
 
@@ -5,6 +5,7 @@
 #include <stdint.h>
 #include <atomic>
 #include <cassert>
+#include <memory>
 
 namespace vespalib {
 
@@ -13,6 +14,14 @@ namespace vespalib {
  * (changed by a single writer), and previous generations still
  * occupied by multiple readers.  Readers will take a generation guard
  * by calling takeGuard().
+ *
+ * Readers announce the generation they use in a reader slot, picked
+ * among slots on a cache line preferred by the calling thread, so
+ * taking and releasing guards from many threads does not bounce a
+ * shared cache line between cores. The writer scans the slots when
+ * updating the first used generation. When all slots nearby are taken
+ * the reader falls back to reference counting a shared generation
+ * hold entry.
  **/
 class GenerationHandler {
 public:
@@ -80,21 +89,48 @@ public:
         uint32_t getRefCount() const { return _refCount / 2; }
     };
 
+    /*
+     * Generation announced by readers. The reference count is only
+     * above one when a guard has been copied.
+     */
+    struct ReaderSlot
+    {
+        std::atomic<uint32_t>     _refCount;
+        std::atomic<generation_t> _generation;
+
+        ReaderSlot() : _refCount(0), _generation(0) { }
+        void release() { _refCount.fetch_sub(1, std::memory_order_release); }
+        static ReaderSlot *copy(ReaderSlot *self) {
+            if (self != nullptr) {
+                uint32_t oldRefCount = self->_refCount.fetch_add(1, std::memory_order_relaxed);
+                (void) oldRefCount;
+                assert(oldRefCount != 0);
+            }
+            return self;
+        }
+    };
+
     /**
      * Class that keeps a reference to a generation until destroyed.
      **/
     class Guard {
     private:
         GenerationHold *_hold;
+        ReaderSlot     *_slot;
         void cleanup() {
             if (_hold != nullptr) {
                 _hold->release();
                 _hold = nullptr;
             }
+            if (_slot != nullptr) {
+                _slot->release();
+                _slot = nullptr;
+            }
         }
     public:
         Guard();
         Guard(GenerationHold *hold); // hold is never nullptr
+        Guard(ReaderSlot *slot);     // slot is already acquired
         ~Guard();
         Guard(const Guard & rhs);
         Guard(Guard &&rhs);
@@ -102,19 +138,37 @@ public:
         Guard & operator=(Guard &&rhs);
 
         bool valid(void) const {
-            return _hold != nullptr;
+            return (_hold != nullptr) || (_slot != nullptr);
+        }
+        generation_t getGeneration() const {
+            return (_slot != nullptr) ? _slot->_generation.load(std::memory_order_relaxed) : _hold->_generation;
         }
-        generation_t getGeneration() const { return _hold->_generation; }
     };
 
 private:
-    generation_t _generation;
+    enum {
+        SlotsPerLine = 4,
+        NumSlotLines = 32,
+        NumSlots = SlotsPerLine * NumSlotLines,
+        MaxSlotProbes = 64
+    };
+    struct alignas(64) ReaderSlotLine {
+        ReaderSlot _slots[SlotsPerLine];
+    };
+
+    std::atomic<generation_t> _generation;
     generation_t _firstUsedGeneration;
+    std::unique_ptr<ReaderSlotLine[]> _slotLines;
     GenerationHold *_last;	// Points to "current generation" entry
     GenerationHold *_first;	// Points to "firstUsedGeneration" entry
     GenerationHold *_free;	// List of free entries
     uint32_t _numHolds;		// Number of allocated generation hold entries
 
+    ReaderSlot &getSlot(size_t idx) const {
+        return _slotLines[idx / SlotsPerLine]._slots[idx % SlotsPerLine];
+    }
+    ReaderSlot *acquireSlot() const;
+
 public:
     /**
      * Creates a new generation handler.
@@ -153,11 +207,11 @@ public:
      * Returns the current generation.
      **/
     generation_t getCurrentGeneration() const {
-        return _generation;
+        return _generation.load(std::memory_order_relaxed);
     }
 
     generation_t getNextGeneration(void) const {
-        return _generation + 1;
+        return getCurrentGeneration() + 1;
     }
 
     /**
@@ -0,0 +1,289 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "lockfreethreadexecutor.h"
+#include "alloc.h"
+#include "threadstackexecutorbase.h"
+#include <vespa/fastos/thread.h>
+#include <cassert>
+
+namespace vespalib {
+
+VESPA_THREAD_STACK_TAG(unnamed_lockfree_executor);
+
+struct LockFreeThreadExecutor::ThreadInit : public FastOS_Runnable {
+    Runnable &worker;
+    init_fun_t init_fun;
+
+    ThreadInit(Runnable &worker_in, init_fun_t init_fun_in)
+        : worker(worker_in), init_fun(std::move(init_fun_in)) {}
+
+    void Run(FastOS_ThreadInterface *, void *) override { init_fun(worker); }
+};
+
+//-----------------------------------------------------------------------------
+
+bool
+LockFreeThreadExecutor::push(Task *task)
+{
+    uint64_t pos = _enqueuePos.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+        cell = &_cells[pos & _mask];
+        uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+        int64_t diff = int64_t(seq) - int64_t(pos);
+        if (diff == 0) {
+            if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false; // full
+        } else {
+            pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+    cell->task = task;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+LockFreeThreadExecutor::Task *
+LockFreeThreadExecutor::pop(uint64_t &pos)
+{
+    pos = _dequeuePos.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+        cell = &_cells[pos & _mask];
+        uint64_t seq = cell->sequence.load(std::memory_order_acquire);
+        int64_t diff = int64_t(seq) - int64_t(pos + 1);
+        if (diff == 0) {
+            // seq_cst, since sync relies on this being ordered after
+            // the worker announcing that it is busy.
+            if (_dequeuePos.compare_exchange_weak(pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return nullptr; // empty
+        } else {
+            pos = _dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+    Task *task = cell->task;
+    cell->task = nullptr;
+    cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return task;
+}
+
+bool
+LockFreeThreadExecutor::hasTask() const
+{
+    uint64_t pos = _dequeuePos.load(std::memory_order_relaxed);
+    return (_cells[pos & _mask].sequence.load(std::memory_order_acquire) == (pos + 1));
+}
+
+bool
+LockFreeThreadExecutor::isDrained() const
+{
+    // A producer that has seen the executor open may still be about
+    // to push its task; workers must stay around until it is done.
+    return (_closed.load() && (_producers.load() == 0) && !hasTask());
+}
+
+void
+LockFreeThreadExecutor::park()
+{
+    uint64_t key = _epoch.load(std::memory_order_acquire);
+    _sleepers.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!hasTask() && !_closed.load()) {
+        std::unique_lock<std::mutex> guard(_lock);
+        _workCond.wait(guard, [&]{ return ((_epoch.load(std::memory_order_relaxed) != key) || _closed.load()); });
+    }
+    _sleepers.fetch_sub(1);
+}
+
+void
+LockFreeThreadExecutor::wakeupWorker()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_sleepers.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> guard(_lock);
+        _epoch.fetch_add(1, std::memory_order_relaxed);
+        _workCond.notify_one();
+    }
+}
+
+void
+LockFreeThreadExecutor::notifySyncWaiters()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_syncWaiters.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> guard(_lock);
+        _syncCond.notify_all();
+    }
+}
+
+bool
+LockFreeThreadExecutor::isDone(uint64_t target) const
+{
+    if (_dequeuePos.load() < target) {
+        return false;
+    }
+    for (const auto &state: _workerStates) {
+        if (state->position.load() <= target) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+LockFreeThreadExecutor::updateMaxPending(size_t pending)
+{
+    size_t max = _maxPendingTasks.load(std::memory_order_relaxed);
+    while ((pending > max) && !_maxPendingTasks.compare_exchange_weak(max, pending, std::memory_order_relaxed)) {
+    }
+}
+
+void
+LockFreeThreadExecutor::run()
+{
+    uint32_t idx = _nextWorker.fetch_add(1);
+    assert(idx < _workerStates.size());
+    WorkerState &self = *_workerStates[idx];
+    for (;;) {
+        self.position.store(WorkerState::BUSY);
+        uint64_t pos;
+        Task::UP task(pop(pos));
+        if (task) {
+            self.position.store(pos + 1);
+            task->run();
+            task.reset();
+            _pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+            notifySyncWaiters();
+            continue;
+        }
+        self.position.store(WorkerState::IDLE);
+        notifySyncWaiters();
+        if (isDrained()) {
+            return;
+        }
+        park();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+LockFreeThreadExecutor::LockFreeThreadExecutor(uint32_t threads, uint32_t stackSize, uint32_t taskLimit)
+    : LockFreeThreadExecutor(threads, stackSize, taskLimit, unnamed_lockfree_executor)
+{
+}
+
+LockFreeThreadExecutor::LockFreeThreadExecutor(uint32_t threads, uint32_t stackSize, uint32_t taskLimit,
+                                               init_fun_t init_function)
+    : _pool(std::make_unique<FastOS_ThreadPool>(stackSize)),
+      _cells(),
+      _mask(roundUp2inN(std::max(taskLimit, 2u)) - 1),
+      _enqueuePos(0),
+      _dequeuePos(0),
+      _sleepers(0),
+      _syncWaiters(0),
+      _closed(false),
+      _producers(0),
+      _epoch(0),
+      _workerStates(),
+      _nextWorker(0),
+      _acceptedTasks(0),
+      _rejectedTasks(0),
+      _pendingTasks(0),
+      _maxPendingTasks(0),
+      _lock(),
+      _workCond(),
+      _syncCond(),
+      _threadInit(std::make_unique<ThreadInit>(*this, std::move(init_function)))
+{
+    assert(threads > 0);
+    assert(taskLimit > 0);
+    _cells.reset(new Cell[_mask + 1]);
+    for (uint64_t i = 0; i <= _mask; ++i) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    for (uint32_t i = 0; i < threads; ++i) {
+        _workerStates.push_back(std::make_unique<WorkerState>());
+    }
+    for (uint32_t i = 0; i < threads; ++i) {
+        FastOS_ThreadInterface *thread = _pool->NewThread(_threadInit.get());
+        assert(thread != nullptr);
+        (void) thread;
+    }
+}
+
+LockFreeThreadExecutor::~LockFreeThreadExecutor()
+{
+    shutdown().sync();
+    _pool->Close();
+    assert(!hasTask());
+}
+
+LockFreeThreadExecutor::Stats
+LockFreeThreadExecutor::getStats()
+{
+    Stats stats;
+    stats.acceptedTasks = _acceptedTasks.exchange(0, std::memory_order_relaxed);
+    stats.rejectedTasks = _rejectedTasks.exchange(0, std::memory_order_relaxed);
+    stats.maxPendingTasks = _maxPendingTasks.exchange(_pendingTasks.load(std::memory_order_relaxed),
+                                                      std::memory_order_relaxed);
+    return stats;
+}
+
+LockFreeThreadExecutor::Task::UP
+LockFreeThreadExecutor::execute(Task::UP task)
+{
+    _producers.fetch_add(1);
+    // counted before the push, so a worker finishing the task can
+    // never make the pending count wrap around
+    size_t pending = _pendingTasks.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (!_closed.load() && push(task.get())) {
+        task.release();
+        _acceptedTasks.fetch_add(1, std::memory_order_relaxed);
+        updateMaxPending(pending);
+        wakeupWorker();
+    } else {
+        _pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+        _rejectedTasks.fetch_add(1, std::memory_order_relaxed);
+    }
+    _producers.fetch_sub(1);
+    return task;
+}
+
+LockFreeThreadExecutor &
+LockFreeThreadExecutor::sync()
+{
+    uint64_t target = _enqueuePos.load();
+    if (isDone(target)) {
+        return *this;
+    }
+    _syncWaiters.fetch_add(1);
+    {
+        std::unique_lock<std::mutex> guard(_lock);
+        _syncCond.wait(guard, [&]{ return isDone(target); });
+    }
+    _syncWaiters.fetch_sub(1);
+    return *this;
+}
+
+size_t
+LockFreeThreadExecutor::getNumThreads() const
+{
+    return _pool->GetNumStartedThreads();
+}
+
+LockFreeThreadExecutor &
+LockFreeThreadExecutor::shutdown()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _closed.store(true);
+    _workCond.notify_all();
+    return *this;
+}
+
+} // namespace vespalib
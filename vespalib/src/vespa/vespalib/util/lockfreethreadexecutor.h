@@ -0,0 +1,148 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "threadexecutor.h"
+#include "executor_stats.h"
+#include "runnable.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class FastOS_ThreadPool;
+
+namespace vespalib {
+
+/**
+ * An executor service that executes tasks in multiple threads, using
+ * a bounded lock-free multi-producer/multi-consumer queue for the
+ * tasks. Posting a task and picking up a task only touch the queue
+ * itself; the internal mutex is only taken to wake up parked workers
+ * or threads waiting in sync. This avoids contention on a single lock
+ * when many threads post small tasks at the same time.
+ *
+ * The task limit is the capacity of the queue (rounded up to a power
+ * of 2), and does not include the tasks currently being run. Tasks
+ * are rejected when the queue is full or the executor is shut down.
+ **/
+class LockFreeThreadExecutor : public ThreadExecutor,
+                               public Runnable
+{
+public:
+    using Stats = ExecutorStats;
+    using init_fun_t = std::function<int(Runnable&)>;
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<uint64_t> sequence;
+        Task                 *task;
+        Cell() : sequence(0), task(nullptr) {}
+    };
+
+    // The position of the task a worker is running plus one, or one
+    // of the special values below.
+    struct alignas(64) WorkerState {
+        static constexpr uint64_t BUSY = 0;
+        static constexpr uint64_t IDLE = uint64_t(-1);
+        std::atomic<uint64_t> position;
+        WorkerState() : position(IDLE) {}
+    };
+
+    struct ThreadInit;
+
+    std::unique_ptr<FastOS_ThreadPool>        _pool;
+    std::unique_ptr<Cell[]>                   _cells;
+    const uint64_t                            _mask;
+    alignas(64) std::atomic<uint64_t>         _enqueuePos;
+    alignas(64) std::atomic<uint64_t>         _dequeuePos;
+    alignas(64) std::atomic<uint32_t>         _sleepers;
+    std::atomic<uint32_t>                     _syncWaiters;
+    std::atomic<bool>                         _closed;
+    std::atomic<uint32_t>                     _producers; // threads inside execute
+    std::atomic<uint64_t>                     _epoch;
+    std::vector<std::unique_ptr<WorkerState>> _workerStates;
+    std::atomic<uint32_t>                     _nextWorker;
+    std::atomic<size_t>                       _acceptedTasks;
+    std::atomic<size_t>                       _rejectedTasks;
+    std::atomic<size_t>                       _pendingTasks;
+    std::atomic<size_t>                       _maxPendingTasks;
+    std::mutex                                _lock;
+    std::condition_variable                   _workCond;
+    std::condition_variable                   _syncCond;
+    std::unique_ptr<ThreadInit>               _threadInit;
+
+    bool push(Task *task);
+    Task *pop(uint64_t &pos);
+    bool hasTask() const;
+    bool isDrained() const;
+    void park();
+    void wakeupWorker();
+    void notifySyncWaiters();
+    bool isDone(uint64_t target) const;
+    void updateMaxPending(size_t pending);
+
+    // Runnable (all workers live here)
+    void run() override;
+
+public:
+    LockFreeThreadExecutor(const LockFreeThreadExecutor &) = delete;
+    LockFreeThreadExecutor & operator = (const LockFreeThreadExecutor &) = delete;
+
+    /**
+     * Create a new lock-free thread executor.
+     *
+     * @param threads number of worker threads (concurrent tasks)
+     * @param stackSize stack size per worker thread
+     * @param taskLimit upper limit on queued tasks
+     **/
+    LockFreeThreadExecutor(uint32_t threads, uint32_t stackSize, uint32_t taskLimit);
+
+    // same as above, but enables you to specify a custom function
+    // used to wrap the main loop of all worker threads
+    LockFreeThreadExecutor(uint32_t threads, uint32_t stackSize, uint32_t taskLimit,
+                           init_fun_t init_function);
+
+    /**
+     * Will invoke shutdown then sync.
+     **/
+    ~LockFreeThreadExecutor();
+
+    /**
+     * Observe and reset stats for this object. Pending tasks include
+     * both queued tasks and tasks currently being run.
+     *
+     * @return stats
+     **/
+    Stats getStats();
+
+    // inherited from Executor
+    Task::UP execute(Task::UP task) override;
+
+    /**
+     * Synchronize with this executor. This function will block until
+     * all previously accepted tasks have been executed.
+     *
+     * @return this object; for chaining
+     **/
+    LockFreeThreadExecutor &sync() override;
+
+    size_t getNumThreads() const override;
+
+    /**
+     * Shut down this executor. This will make this executor reject
+     * all new tasks. Tasks already accepted will still be run.
+     *
+     * @return this object; for chaining
+     **/
+    LockFreeThreadExecutor &shutdown();
+
+    /**
+     * @return the capacity of the task queue
+     **/
+    size_t getTaskLimit() const { return _mask + 1; }
+};
+
+} // namespace vespalib
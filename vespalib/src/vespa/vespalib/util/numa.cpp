@@ -0,0 +1,139 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "numa.h"
+#include <vespa/vespalib/util/stringfmt.h>
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+
+namespace vespalib {
+
+namespace {
+
+/**
+ * Parse a sysfs list like "0-3,8,10-11".
+ **/
+std::vector<int> parseList(const char *str) {
+    std::vector<int> result;
+    while (*str != '\0' && *str != '\n') {
+        char *end = nullptr;
+        long first = strtol(str, &end, 10);
+        if (end == str) {
+            break;
+        }
+        long last = first;
+        str = end;
+        if (*str == '-') {
+            last = strtol(str + 1, &end, 10);
+            str = end;
+        }
+        for (long i = first; i <= last; ++i) {
+            result.push_back(i);
+        }
+        if (*str == ',') {
+            ++str;
+        }
+    }
+    return result;
+}
+
+std::vector<int> readList(const vespalib::string &path) {
+    std::vector<int> result;
+    FILE *file = fopen(path.c_str(), "r");
+    if (file != nullptr) {
+        char buf[4096];
+        if (fgets(buf, sizeof(buf), file) != nullptr) {
+            result = parseList(buf);
+        }
+        fclose(file);
+    }
+    return result;
+}
+
+struct Topology {
+    std::vector<int> nodes;
+    std::vector<std::vector<int>> cpus;
+    unsigned long nodeMask;
+    Topology() : nodes(readList("/sys/devices/system/node/has_memory")), cpus(), nodeMask(0) {
+        for (int node : nodes) {
+            cpus.push_back(readList(make_string("/sys/devices/system/node/node%d/cpulist", node)));
+            if (node < int(8 * sizeof(nodeMask))) {
+                nodeMask |= (1ul << node);
+            }
+        }
+        if (nodes.empty()) {
+            nodes.push_back(0);
+            cpus.emplace_back();
+        }
+    }
+};
+
+const Topology &topology() {
+    static Topology topology;
+    return topology;
+}
+
+} // namespace vespalib::<unnamed>
+
+size_t
+Numa::numNodes()
+{
+    return topology().nodes.size();
+}
+
+const std::vector<int> &
+Numa::cpus(size_t node)
+{
+    return topology().cpus[node % numNodes()];
+}
+
+bool
+Numa::bindCurrentThread(size_t node)
+{
+    if (numNodes() < 2) {
+        return false;
+    }
+    const std::vector<int> &nodeCpus = cpus(node);
+    if (nodeCpus.empty()) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : nodeCpus) {
+        CPU_SET(cpu, &set);
+    }
+    return (sched_setaffinity(0, sizeof(set), &set) == 0);
+}
+
+bool
+Numa::interleave(void *buf, size_t sz)
+{
+    if (numNodes() < 2) {
+        return false;
+    }
+    unsigned long mask = topology().nodeMask;
+    return (syscall(SYS_mbind, buf, sz, MPOL_INTERLEAVE, &mask, 8 * sizeof(mask), 0) == 0);
+}
+
+Numa::ScopedThreadBinding::ScopedThreadBinding(int node)
+    : _oldSet(),
+      _bound(false)
+{
+    if ((node >= 0) && (numNodes() > 1) &&
+        (sched_getaffinity(0, sizeof(_oldSet), &_oldSet) == 0))
+    {
+        _bound = bindCurrentThread(node);
+    }
+}
+
+Numa::ScopedThreadBinding::~ScopedThreadBinding()
+{
+    if (_bound) {
+        sched_setaffinity(0, sizeof(_oldSet), &_oldSet);
+    }
+}
+
+} // namespace vespalib
@@ -0,0 +1,62 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <sched.h>
+#include <cstddef>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Minimal view of the NUMA topology of the host, read from sysfs at
+ * startup. Hosts without NUMA information are seen as a single node
+ * containing all cpus, in which case all operations are no-ops.
+ **/
+class Numa
+{
+public:
+    /**
+     * The number of memory nodes, at least 1.
+     **/
+    static size_t numNodes();
+
+    /**
+     * The cpus belonging to the given node.
+     **/
+    static const std::vector<int> &cpus(size_t node);
+
+    /**
+     * Restrict the calling thread to run on the cpus of the given node.
+     *
+     * @return true if the thread was bound
+     **/
+    static bool bindCurrentThread(size_t node);
+
+    /**
+     * Spread the pages of the given memory area round-robin across all
+     * nodes. Must be called before the pages are touched to take effect.
+     *
+     * @return true if the memory policy was applied
+     **/
+    static bool interleave(void *buf, size_t sz);
+
+    /**
+     * Binds the calling thread to the cpus of a node while in scope,
+     * and restores its previous cpu affinity when leaving the scope.
+     * A negative node gives no binding.
+     **/
+    class ScopedThreadBinding
+    {
+    private:
+        cpu_set_t _oldSet;
+        bool      _bound;
+    public:
+        explicit ScopedThreadBinding(int node);
+        ~ScopedThreadBinding();
+        ScopedThreadBinding(const ScopedThreadBinding &) = delete;
+        ScopedThreadBinding &operator=(const ScopedThreadBinding &) = delete;
+    };
+};
+
+} // namespace vespalib
@@ -0,0 +1,31 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sharded_counter.h"
+
+namespace vespalib {
+
+size_t
+ShardedCounter::next_shard()
+{
+    static std::atomic<size_t> next(0);
+    return (next.fetch_add(1, std::memory_order_relaxed) % NUM_SHARDS);
+}
+
+ShardedCounter::ShardedCounter()
+    : _shards(new Shard[NUM_SHARDS])
+{
+}
+
+ShardedCounter::~ShardedCounter() = default;
+
+uint64_t
+ShardedCounter::value() const
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < NUM_SHARDS; ++i) {
+        sum += _shards[i].value.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+} // namespace vespalib
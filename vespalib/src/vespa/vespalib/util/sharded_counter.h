@@ -0,0 +1,53 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace vespalib {
+
+/**
+ * Monotonic counter for hot code paths updated by many threads.
+ *
+ * The count is split into cache line sized shards, and each thread
+ * always adds to the same shard, so concurrent writers do not bounce
+ * a shared cache line between cores. Reading the value sums all
+ * shards and is only meant to be done when taking a snapshot.
+ **/
+class ShardedCounter
+{
+public:
+    static constexpr size_t NUM_SHARDS = 16;
+
+    /**
+     * The shard used by the calling thread. Threads are assigned
+     * shards round-robin the first time they ask.
+     **/
+    static size_t thread_shard() {
+        static thread_local size_t shard = next_shard();
+        return shard;
+    }
+
+    ShardedCounter();
+    ShardedCounter(const ShardedCounter &) = delete;
+    ShardedCounter &operator=(const ShardedCounter &) = delete;
+    ~ShardedCounter();
+
+    void add(uint64_t n = 1) {
+        _shards[thread_shard()].value.fetch_add(n, std::memory_order_relaxed);
+    }
+    uint64_t value() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value;
+        Shard() : value(0) {}
+    };
+    static size_t next_shard();
+
+    std::unique_ptr<Shard[]> _shards;
+};
+
+} // namespace vespalib
@@ -0,0 +1,133 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "sharded_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace vespalib {
+
+uint64_t
+ShardedHistogram::bucket_low(size_t bucket)
+{
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    size_t exp = (bucket / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+    uint64_t sub = (bucket % SUB_BUCKETS);
+    return ((SUB_BUCKETS + sub) << (exp - SUB_BUCKET_BITS));
+}
+
+uint64_t
+ShardedHistogram::bucket_high(size_t bucket)
+{
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    if (bucket == (NUM_BUCKETS - 1)) {
+        return uint64_t(-1);
+    }
+    return (bucket_low(bucket + 1) - 1);
+}
+
+ShardedHistogram::Snapshot::Snapshot()
+    : buckets(NUM_BUCKETS, 0),
+      count(0),
+      sum(0)
+{
+}
+
+ShardedHistogram::Snapshot::~Snapshot() = default;
+
+void
+ShardedHistogram::Snapshot::merge(const Snapshot &rhs)
+{
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        buckets[i] += rhs.buckets[i];
+    }
+    count += rhs.count;
+    sum += rhs.sum;
+}
+
+ShardedHistogram::Snapshot
+ShardedHistogram::Snapshot::since(const Snapshot &earlier) const
+{
+    Snapshot result;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        result.buckets[i] = buckets[i] - earlier.buckets[i];
+    }
+    result.count = count - earlier.count;
+    result.sum = sum - earlier.sum;
+    return result;
+}
+
+uint64_t
+ShardedHistogram::Snapshot::min() const
+{
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        if (buckets[i] != 0) {
+            return bucket_low(i);
+        }
+    }
+    return 0;
+}
+
+uint64_t
+ShardedHistogram::Snapshot::max() const
+{
+    for (size_t i = NUM_BUCKETS; i-- > 0; ) {
+        if (buckets[i] != 0) {
+            return (i == (NUM_BUCKETS - 1)) ? bucket_low(i) : bucket_high(i);
+        }
+    }
+    return 0;
+}
+
+uint64_t
+ShardedHistogram::Snapshot::percentile(double quantile) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = std::max(uint64_t(1), uint64_t(std::ceil(quantile * count)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return (i == (NUM_BUCKETS - 1)) ? bucket_low(i) : bucket_high(i);
+        }
+    }
+    return max();
+}
+
+ShardedHistogram::Shard::Shard()
+    : sum(0)
+{
+    for (auto &bucket: buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+ShardedHistogram::ShardedHistogram()
+    : _shards(new Shard[NUM_SHARDS])
+{
+}
+
+ShardedHistogram::~ShardedHistogram() = default;
+
+ShardedHistogram::Snapshot
+ShardedHistogram::snapshot() const
+{
+    Snapshot result;
+    for (size_t s = 0; s < NUM_SHARDS; ++s) {
+        const Shard &shard = _shards[s];
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            uint64_t n = shard.buckets[i].load(std::memory_order_relaxed);
+            result.buckets[i] += n;
+            result.count += n;
+        }
+        result.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+} // namespace vespalib
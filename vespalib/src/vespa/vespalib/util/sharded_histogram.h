@@ -0,0 +1,92 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "sharded_counter.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace vespalib {
+
+/**
+ * Histogram of non-negative integer values (typically latencies in
+ * microseconds or sizes in bytes) for hot code paths updated by many
+ * threads.
+ *
+ * Buckets are laid out in the HDR histogram style: each power of two
+ * is split into 8 linear sub-buckets, giving a relative error of at
+ * most 12.5% for any value. Values of 2^40 and above end up in the
+ * last bucket. Like ShardedCounter each thread records into its own
+ * shard; the shards are only combined when taking a snapshot.
+ **/
+class ShardedHistogram
+{
+public:
+    static constexpr size_t SUB_BUCKET_BITS = 3;
+    static constexpr size_t SUB_BUCKETS = (1 << SUB_BUCKET_BITS);
+    static constexpr size_t MAX_EXPONENT = 40;
+    static constexpr size_t NUM_BUCKETS = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+    static constexpr size_t NUM_SHARDS = 8;
+
+    static size_t bucket_of(uint64_t value) {
+        if (value < SUB_BUCKETS) {
+            return value;
+        }
+        size_t exp = (63 - __builtin_clzl(value));
+        if (exp >= MAX_EXPONENT) {
+            return (NUM_BUCKETS - 1);
+        }
+        size_t sub = ((value >> (exp - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+        return ((exp - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub);
+    }
+    /** Smallest value that maps to the given bucket. */
+    static uint64_t bucket_low(size_t bucket);
+    /** Largest value that maps to the given bucket. */
+    static uint64_t bucket_high(size_t bucket);
+
+    /**
+     * Plain copy of the histogram at some point in time. Snapshots
+     * can be merged and subtracted, and are what percentiles are
+     * calculated from.
+     **/
+    struct Snapshot {
+        std::vector<uint64_t> buckets;
+        uint64_t count;
+        uint64_t sum;
+
+        Snapshot();
+        ~Snapshot();
+        void merge(const Snapshot &rhs);
+        /** The values recorded since the given earlier snapshot. */
+        Snapshot since(const Snapshot &earlier) const;
+        double average() const { return (count > 0) ? (double(sum) / count) : 0.0; }
+        uint64_t min() const;
+        uint64_t max() const;
+        /** The value at the given quantile (0.0 - 1.0); 0 if empty. */
+        uint64_t percentile(double quantile) const;
+    };
+
+    ShardedHistogram();
+    ShardedHistogram(const ShardedHistogram &) = delete;
+    ShardedHistogram &operator=(const ShardedHistogram &) = delete;
+    ~ShardedHistogram();
+
+    void record(uint64_t value) {
+        Shard &shard = _shards[ShardedCounter::thread_shard() % NUM_SHARDS];
+        shard.buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+    }
+    Snapshot snapshot() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> buckets[NUM_BUCKETS];
+        Shard();
+    };
+    std::unique_ptr<Shard[]> _shards;
+};
+
+} // namespace vespalib
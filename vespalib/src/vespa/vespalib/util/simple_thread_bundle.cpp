@@ -49,9 +49,11 @@ Runnable::UP chain(Runnable::UP first, Runnable::UP second) {
 
 //-----------------------------------------------------------------------------
 
-SimpleThreadBundle::Pool::Pool(size_t bundleSize)
+SimpleThreadBundle::Pool::Pool(size_t bundleSize, bool bindToNumaNodes)
     : _lock(),
       _bundleSize(bundleSize),
+      _bindToNumaNodes(bindToNumaNodes && (Numa::numNodes() > 1)),
+      _nextNumaNode(0),
       _bundles()
 {
 }
@@ -67,6 +69,7 @@ SimpleThreadBundle::Pool::~Pool()
 SimpleThreadBundle::UP
 SimpleThreadBundle::Pool::obtain()
 {
+    int numaNode = -1;
     {
         LockGuard guard(_lock);
         if (!_bundles.empty()) {
@@ -74,8 +77,11 @@ SimpleThreadBundle::Pool::obtain()
             _bundles.pop_back();
             return ret;
         }
+        if (_bindToNumaNodes) {
+            numaNode = (_nextNumaNode++ % Numa::numNodes());
+        }
     }
-    return SimpleThreadBundle::UP(new SimpleThreadBundle(_bundleSize));
+    return SimpleThreadBundle::UP(new SimpleThreadBundle(_bundleSize, USE_SIGNAL_LIST, numaNode));
 }
 
 void
@@ -88,11 +94,12 @@ SimpleThreadBundle::Pool::release(SimpleThreadBundle::UP bundle)
 
 //-----------------------------------------------------------------------------
 
-SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Strategy strategy)
+SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Strategy strategy, int numaNode)
     : _work(),
       _signals(),
       _workers(),
-      _hook()
+      _hook(),
+      _numaNode(numaNode)
 {
     if (size_in == 0) {
         throw IllegalArgumentException("size must be greater than 0");
@@ -123,7 +130,7 @@ SimpleThreadBundle::SimpleThreadBundle(size_t size_in, Strategy strategy)
             _hook = std::move(hook);
         } else {
             size_t signal_idx = (strategy == USE_BROADCAST) ? 0 : (i - 1);
-            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], std::move(hook)));
+            _workers.push_back(std::make_unique<Worker>(_signals[signal_idx], std::move(hook), numaNode));
         }
     }
 }
@@ -153,6 +160,7 @@ SimpleThreadBundle::run(const std::vector<Runnable*> &targets)
     if (targets.empty()) {
         return;
     }
+    Numa::ScopedThreadBinding binding(_numaNode);
     if (targets.size() == 1) {
         targets[0]->run();
         return;
@@ -8,6 +8,7 @@
 #include "runnable.h"
 #include "thread_bundle.h"
 #include "noncopyable.hpp"
+#include "numa.h"
 
 namespace vespalib {
 
@@ -81,6 +82,12 @@ struct Signal {
 /**
  * A ThreadBundle implementation employing a fixed set of internal
  * threads. The internal Pool class can be used to recycle bundles.
+ *
+ * The internal threads of a bundle may be bound to a single numa
+ * node, letting the parts of a task share the caches and local
+ * memory of that node. The thread calling run performs a part of
+ * the task as well; it is bound to the same node while doing so, and
+ * gets its previous cpu affinity back before run returns.
  **/
 class SimpleThreadBundle : public ThreadBundle
 {
@@ -96,10 +103,16 @@ public:
     private:
         Lock _lock;
         size_t _bundleSize;
+        bool _bindToNumaNodes;
+        size_t _nextNumaNode;
         std::vector<SimpleThreadBundle*> _bundles;
 
     public:
-        Pool(size_t bundleSize);
+        /**
+         * @param bindToNumaNodes bind the threads of each new bundle to
+         *        a numa node, assigning nodes to bundles round-robin.
+         **/
+        Pool(size_t bundleSize, bool bindToNumaNodes = false);
         ~Pool();
         SimpleThreadBundle::UP obtain();
         void release(SimpleThreadBundle::UP bundle);
@@ -111,10 +124,14 @@ private:
         Thread thread;
         Signal &signal;
         Runnable::UP hook;
-        Worker(Signal &s, Runnable::UP h) : thread(*this), signal(s), hook(std::move(h)) {
+        int numaNode;
+        Worker(Signal &s, Runnable::UP h, int node) : thread(*this), signal(s), hook(std::move(h)), numaNode(node) {
             thread.start();
         }
         void run() override {
+            if (numaNode >= 0) {
+                Numa::bindCurrentThread(numaNode);
+            }
             for (size_t gen = 0; signal.wait(gen) > 0; ) {
                 hook->run();
             }
@@ -125,9 +142,10 @@ private:
     std::vector<Signal>     _signals;
     std::vector<Worker::UP> _workers;
     Runnable::UP            _hook;
+    int                     _numaNode;
 
 public:
-    SimpleThreadBundle(size_t size, Strategy strategy = USE_SIGNAL_LIST);
+    SimpleThreadBundle(size_t size, Strategy strategy = USE_SIGNAL_LIST, int numaNode = -1);
     ~SimpleThreadBundle();
     size_t size() const override;
     void run(const std::vector<Runnable*> &targets) override;
@@ -0,0 +1,140 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "thread_arena.h"
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace vespalib {
+
+// While a chunk is owned by a scope, its reference count is offset
+// by OWNED instead of being incremented for each allocation. When
+// the scope lets go of the chunk, the offset is replaced by the
+// number of allocations made from it.
+class ThreadArena::Chunk {
+public:
+    static constexpr int64_t OWNED = (int64_t(1) << 62);
+    std::atomic<int64_t> refs;
+    size_t               allocs;
+    size_t               used;
+    size_t               size;
+    Chunk(size_t used_in, size_t size_in) : refs(OWNED), allocs(0), used(used_in), size(size_in) {}
+};
+
+namespace {
+
+constexpr size_t ALIGNMENT = 16;
+
+constexpr size_t align_up(size_t size) {
+    return ((size + (ALIGNMENT - 1)) & ~(ALIGNMENT - 1));
+}
+
+// prefix of all memory handed out; chunk is nullptr for memory
+// allocated directly with malloc.
+struct alignas(ALIGNMENT) Header {
+    ThreadArena::Chunk *chunk;
+};
+
+static_assert(sizeof(Header) == ALIGNMENT, "header must keep alignment");
+
+__thread ThreadArena::Scope *_T_scope = nullptr;
+
+void release(ThreadArena::Chunk *chunk, int64_t refs) {
+    if (chunk->refs.fetch_sub(refs, std::memory_order_acq_rel) == refs) {
+        chunk->~Chunk();
+        ::free(chunk);
+    }
+}
+
+void disown(ThreadArena::Chunk *chunk) {
+    release(chunk, ThreadArena::Chunk::OWNED - int64_t(chunk->allocs));
+}
+
+void *malloc_with_header(size_t size) {
+    void *mem = malloc(sizeof(Header) + size);
+    if (mem == nullptr) {
+        throw std::bad_alloc();
+    }
+    Header *header = new (mem) Header();
+    header->chunk = nullptr;
+    return (header + 1);
+}
+
+} // namespace vespalib::<unnamed>
+
+ThreadArena::Scope::Scope(size_t chunk_size)
+    : _prev(_T_scope),
+      _chunk(nullptr),
+      _chunk_size(align_up(chunk_size)),
+      _chunks_allocated(0)
+{
+    _T_scope = this;
+}
+
+ThreadArena::Scope::~Scope()
+{
+    assert(_T_scope == this);
+    _T_scope = _prev;
+    if (_chunk != nullptr) {
+        disown(_chunk);
+    }
+}
+
+void *
+ThreadArena::Scope::alloc(size_t size)
+{
+    size_t needed = align_up(sizeof(Header) + size);
+    if (needed > (_chunk_size / 4)) {
+        return malloc_with_header(size);
+    }
+    if ((_chunk == nullptr) || (_chunk->used + needed > _chunk->size)) {
+        void *mem = malloc(_chunk_size);
+        if (mem == nullptr) {
+            throw std::bad_alloc();
+        }
+        if (_chunk != nullptr) {
+            disown(_chunk);
+        }
+        _chunk = new (mem) Chunk(align_up(sizeof(Chunk)), _chunk_size);
+        ++_chunks_allocated;
+    }
+    Header *header = new (reinterpret_cast<char *>(_chunk) + _chunk->used) Header();
+    header->chunk = _chunk;
+    _chunk->used += needed;
+    ++_chunk->allocs;
+    return (header + 1);
+}
+
+void *
+ThreadArena::alloc(size_t size)
+{
+    Scope *scope = _T_scope;
+    if (scope == nullptr) {
+        return malloc_with_header(size);
+    }
+    return scope->alloc(size);
+}
+
+void
+ThreadArena::free(void *ptr)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    Header *header = static_cast<Header *>(ptr) - 1;
+    if (header->chunk == nullptr) {
+        ::free(header);
+    } else {
+        release(header->chunk, 1);
+    }
+}
+
+bool
+ThreadArena::active()
+{
+    return (_T_scope != nullptr);
+}
+
+} // namespace vespalib
@@ -0,0 +1,61 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstddef>
+
+namespace vespalib {
+
+/**
+ * Bump allocator for many small objects with roughly the same
+ * lifetime, like the objects built for a single query.
+ *
+ * While a ThreadArena::Scope is bound to the current thread,
+ * ThreadArena::alloc hands out memory from large chunks owned by that
+ * scope instead of going to the global allocator for each
+ * object. Outside a scope (or for large objects) it falls back to
+ * malloc. Memory is given back with ThreadArena::free, which may be
+ * called from any thread, also after the scope is gone. Each chunk
+ * counts the objects living in it and is released in one go when the
+ * last of them is freed and the scope is done with it.
+ *
+ * Classes opt in by forwarding their operator new/delete to
+ * ThreadArena::alloc/free.
+ **/
+class ThreadArena
+{
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    class Chunk;
+
+    /**
+     * Binds an arena to the current thread for the lifetime of this
+     * object. Scopes may be nested; the innermost one is used.
+     **/
+    class Scope {
+    private:
+        Scope  *_prev;
+        Chunk  *_chunk;
+        size_t  _chunk_size;
+        size_t  _chunks_allocated;
+        friend class ThreadArena;
+        void *alloc(size_t size);
+    public:
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+        explicit Scope(size_t chunk_size = DEFAULT_CHUNK_SIZE);
+        ~Scope();
+        size_t chunks_allocated() const { return _chunks_allocated; }
+    };
+
+    static void *alloc(size_t size);
+    static void free(void *ptr);
+
+    /**
+     * @return whether an arena scope is bound to the current thread
+     **/
+    static bool active();
+};
+
+} // namespace vespalib
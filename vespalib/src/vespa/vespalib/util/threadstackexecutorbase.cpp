@@ -86,6 +86,7 @@ ThreadStackExecutorBase::obtainTask(Worker &worker)
             _barrier.completeEvent(worker.task.token);
             worker.idle = true;
         }
+        worker.accounting.flush(_stats, _tasks.empty());
         worker.verify(/* idle: */ true);
         unblock_threads(monitor);
         if (!_tasks.empty()) {
@@ -106,6 +107,7 @@ ThreadStackExecutorBase::obtainTask(Worker &worker)
             monitor.wait();
         }
     }
+    worker.accounting.wakeup();
     worker.idle = !worker.task.task;
     return !worker.idle;
 }
@@ -117,8 +119,10 @@ ThreadStackExecutorBase::run()
     worker.verify(/* idle: */ true);
     while (obtainTask(worker)) {
         worker.verify(/* idle: */ false);
+        clock::time_point start = clock::now();
         worker.task.task->run();
         worker.task.task.reset();
+        worker.accounting.taskDone(worker.task.queued, start, clock::now());
     }
     _executorCompletion.await(); // to allow unsafe signaling
     worker.verify(/* idle: */ true);
@@ -132,6 +136,7 @@ ThreadStackExecutorBase::ThreadStackExecutorBase(uint32_t stackSize,
     : _pool(std::make_unique<FastOS_ThreadPool>(stackSize)),
       _monitor(),
       _stats(),
+      _statsStart(clock::now()),
       _executorCompletion(),
       _tasks(),
       _workers(),
@@ -173,9 +178,13 @@ ThreadStackExecutorBase::Stats
 ThreadStackExecutorBase::getStats()
 {
     LockGuard lock(_monitor);
+    clock::time_point now = clock::now();
     Stats stats = _stats;
+    stats.threads = getNumThreads();
+    stats.wallTime = std::chrono::duration<double>(now - _statsStart).count();
     _stats = Stats();
     _stats.maxPendingTasks = _taskCount;
+    _statsStart = now;
     return stats;
 }
 
@@ -184,7 +193,7 @@ ThreadStackExecutorBase::execute(Task::UP task)
 {
     MonitorGuard monitor(_monitor);
     if (acceptNewTask(monitor)) {
-        TaggedTask taggedTask(std::move(task), _barrier.startEvent());
+        TaggedTask taggedTask(std::move(task), _barrier.startEvent(), clock::now());
         ++_taskCount;
         ++_stats.acceptedTasks;
         _stats.maxPendingTasks = (_taskCount > _stats.maxPendingTasks)
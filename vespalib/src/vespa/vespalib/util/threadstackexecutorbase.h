@@ -46,12 +46,15 @@ public:
 
 private:
 
+    using clock = ExecutorThreadAccounting::clock;
+
     struct TaggedTask {
         Task::UP task;
         uint32_t token;
-        TaggedTask() : task(nullptr), token(0) {}
-        TaggedTask(Task::UP task_in, uint32_t token_in)
-            : task(std::move(task_in)), token(token_in) {}
+        clock::time_point queued;
+        TaggedTask() : task(nullptr), token(0), queued() {}
+        TaggedTask(Task::UP task_in, uint32_t token_in, clock::time_point queued_in)
+            : task(std::move(task_in)), token(token_in), queued(queued_in) {}
         TaggedTask(TaggedTask &&rhs) = default;
         TaggedTask(const TaggedTask &rhs) = delete;
         TaggedTask &operator=(const TaggedTask &rhs) = delete;
@@ -59,6 +62,7 @@ private:
             assert(task.get() == nullptr); // no overwrites
             task = std::move(rhs.task);
             token = rhs.token;
+            queued = rhs.queued;
             return *this;
         }
     };
@@ -69,7 +73,8 @@ private:
         bool       idle;
         uint32_t   post_guard;
         TaggedTask task;
-        Worker() : monitor(), pre_guard(0xaaaaaaaa), idle(true), post_guard(0x55555555), task() {}
+        ExecutorThreadAccounting accounting;
+        Worker() : monitor(), pre_guard(0xaaaaaaaa), idle(true), post_guard(0x55555555), task(), accounting() {}
         void verify(bool expect_idle) {
             (void) expect_idle;
             assert(pre_guard == 0xaaaaaaaa);
@@ -97,6 +102,7 @@ private:
     std::unique_ptr<FastOS_ThreadPool>   _pool;
     Monitor                              _monitor;
     Stats                                _stats;
+    clock::time_point                    _statsStart;
     Gate                                 _executorCompletion;
     ArrayQueue<TaggedTask>               _tasks;
     ArrayQueue<Worker*>                  _workers;
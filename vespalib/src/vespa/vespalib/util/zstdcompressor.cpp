@@ -4,6 +4,7 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/sync.h>
 #include <zstd.h>
+#include <zdict.h>
 #include <vector>
 #include <cassert>
 
@@ -35,6 +36,47 @@ thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
 
 }
 
+ZStdDictionary::ZStdDictionary(std::vector<char> data)
+    : _data(std::move(data)),
+      _id(ZDICT_getDictID(_data.data(), _data.size())),
+      _ddict(ZSTD_createDDict(_data.data(), _data.size())),
+      _cdictOnce(),
+      _cdictLevel(0),
+      _cdict(nullptr)
+{
+    assert(_ddict != nullptr);
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+}
+
+std::vector<char>
+ZStdDictionary::train(const void * samples, const std::vector<size_t> & sampleSizes, size_t maxSize)
+{
+    std::vector<char> data(maxSize);
+    size_t sz = ZDICT_trainFromBuffer(data.data(), data.size(), samples, sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return std::vector<char>();
+    }
+    data.resize(sz);
+    data.shrink_to_fit();
+    return data;
+}
+
+const ZSTD_CDict *
+ZStdDictionary::getCDict(int compressionLevel) const
+{
+    // Preparing the dictionary is costly, so it is only done for the first level used.
+    std::call_once(_cdictOnce, [this, compressionLevel]() {
+        _cdictLevel = compressionLevel;
+        _cdict = ZSTD_createCDict(_data.data(), _data.size(), compressionLevel);
+    });
+    return (_cdictLevel == compressionLevel) ? _cdict : nullptr;
+}
+
 size_t ZStdCompressor::adjustProcessLen(uint16_t, size_t len)   const { return ZSTD_compressBound(len); }
 
 bool
@@ -44,7 +86,16 @@ ZStdCompressor::process(const CompressionConfig& config, const void * inputV, si
     if ( ! _tlCompressState) {
         _tlCompressState = std::make_unique<CompressContext>();
     }
-    size_t sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    size_t sz;
+    if (_dictionary != nullptr) {
+        const ZSTD_CDict * cdict = _dictionary->getCDict(config.compressionLevel);
+        sz = (cdict != nullptr)
+             ? ZSTD_compress_usingCDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, cdict)
+             : ZSTD_compress_usingDict(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen,
+                                       _dictionary->getData().data(), _dictionary->size(), config.compressionLevel);
+    } else {
+        sz = ZSTD_compressCCtx(_tlCompressState->get(), outputV, maxOutputLen, inputV, inputLen, config.compressionLevel);
+    }
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
@@ -56,7 +107,10 @@ ZStdCompressor::unprocess(const void * inputV, size_t inputLen, void * outputV,
     if ( ! _tlDecompressState) {
         _tlDecompressState = std::make_unique<DecompressContext>();
     }
-    size_t sz = ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
+    size_t sz = (_dictionary != nullptr)
+                ? ZSTD_decompress_usingDDict(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen,
+                                             _dictionary->getDDict())
+                : ZSTD_decompressDCtx(_tlDecompressState->get(), outputV, outputLenV, inputV, inputLen);
     assert( ! ZSTD_isError(sz) );
     outputLenV = sz;
     return ! ZSTD_isError(sz);
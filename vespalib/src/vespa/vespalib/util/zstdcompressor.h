@@ -2,15 +2,66 @@
 #pragma once
 
 #include "compressor.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
 
 namespace vespalib::compression {
 
+/**
+ * A zstd dictionary trained from samples of the data to be compressed.
+ * Small documents compressed one by one, or in small chunks, compress a
+ * lot better when they share a dictionary.
+ * Data compressed with a dictionary can only be decompressed with the
+ * same dictionary, so the content must be stored alongside the data.
+ */
+class ZStdDictionary
+{
+public:
+    using SP = std::shared_ptr<const ZStdDictionary>;
+    ZStdDictionary(std::vector<char> data);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator = (const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+
+    /**
+     * Train a dictionary from the given samples, stored back to back.
+     * @return the dictionary content, or empty if training failed (typically too few samples).
+     */
+    static std::vector<char> train(const void * samples, const std::vector<size_t> & sampleSizes, size_t maxSize);
+
+    const std::vector<char> & getData() const { return _data; }
+    uint32_t getId() const { return _id; }
+    size_t size() const { return _data.size(); }
+private:
+    friend class ZStdCompressor;
+    const ZSTD_CDict_s * getCDict(int compressionLevel) const;
+    const ZSTD_DDict_s * getDDict() const { return _ddict; }
+
+    std::vector<char>              _data;
+    uint32_t                       _id;
+    ZSTD_DDict_s                 * _ddict;
+    mutable std::once_flag         _cdictOnce;
+    mutable int                    _cdictLevel;
+    mutable ZSTD_CDict_s         * _cdict;
+};
+
 class ZStdCompressor : public ICompressor
 {
 public:
+    ZStdCompressor() : _dictionary(nullptr) { }
+    /**
+     * Compressor using the given dictionary, which must outlive it.
+     */
+    explicit ZStdCompressor(const ZStdDictionary * dictionary) : _dictionary(dictionary) { }
     bool process(const CompressionConfig& config, const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     bool unprocess(const void * input, size_t inputLen, void * output, size_t & outputLen) override;
     size_t adjustProcessLen(uint16_t options, size_t len)   const override;
+private:
+    const ZStdDictionary * _dictionary;
 };
 
 }
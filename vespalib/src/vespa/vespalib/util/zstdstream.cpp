@@ -0,0 +1,87 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "zstdstream.h"
+#include <zstd.h>
+#include <cassert>
+
+namespace vespalib::compression {
+
+ZStdStreamCompressor::ZStdStreamCompressor(int compressionLevel)
+    : _stream(ZSTD_createCStream())
+{
+    assert(_stream != nullptr);
+    size_t rc = ZSTD_initCStream(_stream, compressionLevel);
+    assert(!ZSTD_isError(rc));
+    (void) rc;
+}
+
+ZStdStreamCompressor::~ZStdStreamCompressor()
+{
+    ZSTD_freeCStream(_stream);
+}
+
+size_t
+ZStdStreamCompressor::maxCompressedSize(size_t inputLen)
+{
+    // Room for the frame header, written on the first call, and the
+    // block headers of the flush.
+    return ZSTD_compressBound(inputLen) + 64;
+}
+
+size_t
+ZStdStreamCompressor::compress(const void * input, size_t inputLen, void * output, size_t outputCapacity)
+{
+    ZSTD_inBuffer in = { input, inputLen, 0 };
+    ZSTD_outBuffer out = { output, outputCapacity, 0 };
+    while (in.pos < in.size) {
+        size_t rc = ZSTD_compressStream(_stream, &out, &in);
+        if (ZSTD_isError(rc) || ((out.pos == out.size) && (in.pos < in.size))) {
+            return 0;
+        }
+    }
+    size_t remaining;
+    do {
+        remaining = ZSTD_flushStream(_stream, &out);
+        if (ZSTD_isError(remaining) || ((remaining > 0) && (out.pos == out.size))) {
+            return 0;
+        }
+    } while (remaining > 0);
+    return out.pos;
+}
+
+ZStdStreamDecompressor::ZStdStreamDecompressor()
+    : _stream(ZSTD_createDStream()),
+      _failed(false)
+{
+    assert(_stream != nullptr);
+    size_t rc = ZSTD_initDStream(_stream);
+    assert(!ZSTD_isError(rc));
+    (void) rc;
+}
+
+ZStdStreamDecompressor::~ZStdStreamDecompressor()
+{
+    ZSTD_freeDStream(_stream);
+}
+
+bool
+ZStdStreamDecompressor::decompress(const void * input, size_t inputLen, void * output, size_t outputLen)
+{
+    if (_failed) {
+        return false;
+    }
+    ZSTD_inBuffer in = { input, inputLen, 0 };
+    ZSTD_outBuffer out = { output, outputLen, 0 };
+    while ((in.pos < in.size) || (out.pos < out.size)) {
+        size_t inPos = in.pos;
+        size_t outPos = out.pos;
+        size_t rc = ZSTD_decompressStream(_stream, &out, &in);
+        if (ZSTD_isError(rc) || ((in.pos == inPos) && (out.pos == outPos))) {
+            _failed = true;
+            break;
+        }
+    }
+    return !_failed;
+}
+
+}
@@ -0,0 +1,62 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstddef>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+
+namespace vespalib::compression {
+
+/**
+ * Streaming zstd compressor. Each call to compress() produces output
+ * that can be decompressed in full by a ZStdStreamDecompressor that has
+ * seen all previous output, while later data may refer back to data
+ * compressed in earlier calls. This is used to compress a sequence of
+ * messages on a single connection, taking advantage of redundancy across
+ * messages.
+ */
+class ZStdStreamCompressor
+{
+public:
+    explicit ZStdStreamCompressor(int compressionLevel);
+    ZStdStreamCompressor(const ZStdStreamCompressor &) = delete;
+    ZStdStreamCompressor & operator = (const ZStdStreamCompressor &) = delete;
+    ~ZStdStreamCompressor();
+
+    /**
+     * Upper bound of the output produced when compressing inputLen bytes.
+     */
+    static size_t maxCompressedSize(size_t inputLen);
+
+    /**
+     * Compress and flush the given input.
+     * @return number of bytes written to output, or 0 on failure.
+     */
+    size_t compress(const void * input, size_t inputLen, void * output, size_t outputCapacity);
+private:
+    ZSTD_CCtx_s * _stream;
+};
+
+/**
+ * Streaming zstd decompressor, see ZStdStreamCompressor.
+ */
+class ZStdStreamDecompressor
+{
+public:
+    ZStdStreamDecompressor();
+    ZStdStreamDecompressor(const ZStdStreamDecompressor &) = delete;
+    ZStdStreamDecompressor & operator = (const ZStdStreamDecompressor &) = delete;
+    ~ZStdStreamDecompressor();
+
+    /**
+     * Decompress the output of a single ZStdStreamCompressor::compress() call.
+     * @return true if all input was consumed and exactly outputLen bytes were produced.
+     */
+    bool decompress(const void * input, size_t inputLen, void * output, size_t outputLen);
+private:
+    ZSTD_DCtx_s * _stream;
+    bool          _failed;
+};
+
+}
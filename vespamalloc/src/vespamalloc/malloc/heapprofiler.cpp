@@ -0,0 +1,398 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include "heapprofiler.h"
+#include <execinfo.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+namespace vespamalloc {
+
+namespace {
+
+// How far a thread may allocate before looking at the profiler state
+// again while the profiler is stopped.
+const long DisabledRecheckInterval = 0x1000000;
+
+struct StackRecord {
+    uint64_t hash;
+    uint32_t depth;
+    void   * frames[HeapProfiler::MaxFrames];
+    size_t   liveCount;
+    size_t   liveBytes;
+    size_t   allocCount;
+    size_t   allocBytes;
+};
+
+struct LiveSample {
+    void   * ptr;
+    uint32_t stack;
+    size_t   size;
+};
+
+class SpinLock
+{
+public:
+    void lock() {
+        while (_flag.test_and_set(std::memory_order_acquire)) {
+            sched_yield();
+        }
+    }
+    void unlock() { _flag.clear(std::memory_order_release); }
+private:
+    std::atomic_flag _flag = ATOMIC_FLAG_INIT;
+};
+
+class SpinGuard
+{
+public:
+    SpinGuard(SpinLock & lock) : _lock(lock) { _lock.lock(); }
+    ~SpinGuard() { _lock.unlock(); }
+private:
+    SpinLock & _lock;
+};
+
+SpinLock                 _lock;
+std::atomic<uint32_t>    _generation(0);
+size_t                   _startTime(0);
+size_t                   _profileInterval(0);
+size_t                   _liveCount(0);
+size_t                   _liveBytes(0);
+size_t                   _allocCount(0);
+size_t                   _allocBytes(0);
+size_t                   _droppedSamples(0);
+size_t                   _numStacks(0);
+StackRecord              _stacks[HeapProfiler::MaxStacks];
+LiveSample               _live[HeapProfiler::MaxLiveSamples];
+
+__thread uint32_t _threadGeneration TLS_LINKAGE = 0;
+__thread uint64_t _random TLS_LINKAGE = 0;
+__thread bool     _inProfiler TLS_LINKAGE = false;
+
+uint64_t nextRandom() {
+    uint64_t x(_random);
+    if (x == 0) {
+        x = reinterpret_cast<uint64_t>(&_random) ^ (uint64_t(time(nullptr)) << 32) ^ 0x2545f4914f6cdd1dul;
+    }
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    _random = x;
+    return x * 0x2545f4914f6cdd1dul;
+}
+
+// log2(q) for q > 0, with an error well below what matters for
+// drawing sample intervals. Avoids depending on libm.
+double approxLog2(uint32_t q) {
+    int e(31 - __builtin_clz(q));
+    double f((double(q) / double(uint64_t(1) << e)) - 1.0);
+    return e + f * (1.0 + 0.3466 * (1.0 - f));
+}
+
+// Exponentially distributed with the given mean, which makes the
+// sampling a Poisson process over the allocated bytes.
+long nextSampleInterval(size_t mean) {
+    uint32_t q((nextRandom() >> 38) + 1); // [1, 2^26]
+    double interval((26.0 - approxLog2(q)) * 0.6931471805599453 * double(mean));
+    return long(interval) + 1;
+}
+
+uint64_t hashStack(void * const * frames, uint32_t depth) {
+    uint64_t h(0xcbf29ce484222325ul);
+    for (uint32_t i(0); i < depth; i++) {
+        h = (h ^ reinterpret_cast<uint64_t>(frames[i])) * 0x100000001b3ul;
+    }
+    return h;
+}
+
+uint32_t liveSlot(const void * ptr) {
+    uint64_t v(reinterpret_cast<uint64_t>(ptr) >> 4);
+    return ((v * 0x9e3779b97f4a7c15ul) >> 32) % HeapProfiler::MaxLiveSamples;
+}
+
+// Returns MaxStacks if the stack table is full.
+uint32_t findOrAddStack(void * const * frames, uint32_t depth) {
+    uint64_t h(hashStack(frames, depth));
+    for (uint32_t i(0); i < HeapProfiler::MaxStacks; i++) {
+        uint32_t slot((h + i) % HeapProfiler::MaxStacks);
+        StackRecord & s = _stacks[slot];
+        if (s.depth == 0) {
+            if (_numStacks * 4 >= HeapProfiler::MaxStacks * 3) {
+                return HeapProfiler::MaxStacks;
+            }
+            s.hash = h;
+            s.depth = depth;
+            memcpy(s.frames, frames, depth * sizeof(void *));
+            _numStacks++;
+            return slot;
+        }
+        if ((s.hash == h) && (s.depth == depth) && (memcmp(s.frames, frames, depth * sizeof(void *)) == 0)) {
+            return slot;
+        }
+    }
+    return HeapProfiler::MaxStacks;
+}
+
+bool addLive(void * ptr, uint32_t stack, size_t sz) {
+    if (_liveCount * 4 >= HeapProfiler::MaxLiveSamples * 3) {
+        return false;
+    }
+    uint32_t slot(liveSlot(ptr));
+    while (_live[slot].ptr != nullptr) {
+        slot = (slot + 1) % HeapProfiler::MaxLiveSamples;
+    }
+    _live[slot].ptr = ptr;
+    _live[slot].stack = stack;
+    _live[slot].size = sz;
+    return true;
+}
+
+// Linear probing with backward shift deletion, so no tombstones pile up.
+bool removeLive(void * ptr, LiveSample & removed) {
+    uint32_t slot(liveSlot(ptr));
+    while (_live[slot].ptr != ptr) {
+        if (_live[slot].ptr == nullptr) {
+            return false;
+        }
+        slot = (slot + 1) % HeapProfiler::MaxLiveSamples;
+    }
+    removed = _live[slot];
+    uint32_t hole(slot);
+    for (uint32_t next((hole + 1) % HeapProfiler::MaxLiveSamples); _live[next].ptr != nullptr; next = (next + 1) % HeapProfiler::MaxLiveSamples) {
+        uint32_t home(liveSlot(_live[next].ptr));
+        bool movable = (hole <= next)
+                       ? ((home <= hole) || (home > next))
+                       : ((home <= hole) && (home > next));
+        if (movable) {
+            _live[hole] = _live[next];
+            hole = next;
+        }
+    }
+    _live[hole].ptr = nullptr;
+    return true;
+}
+
+class Output
+{
+public:
+    Output(char * buf, size_t len) : _buf(buf), _len(len), _pos(0) { }
+    void put(char c) {
+        if (_pos < _len) {
+            _buf[_pos] = c;
+        }
+        _pos++;
+    }
+    void put(const char * s) {
+        while (*s) {
+            put(*s++);
+        }
+    }
+    void putDec(size_t v) {
+        char tmp[24];
+        int n(0);
+        do {
+            tmp[n++] = '0' + (v % 10);
+            v /= 10;
+        } while (v != 0);
+        while (n > 0) {
+            put(tmp[--n]);
+        }
+    }
+    void putHex(uint64_t v) {
+        static const char digits[] = "0123456789abcdef";
+        char tmp[16];
+        int n(0);
+        do {
+            tmp[n++] = digits[v & 0xf];
+            v >>= 4;
+        } while (v != 0);
+        put("0x");
+        while (n > 0) {
+            put(tmp[--n]);
+        }
+    }
+    void putCounts(size_t liveCount, size_t liveBytes, size_t allocCount, size_t allocBytes) {
+        putDec(liveCount);
+        put(": ");
+        putDec(liveBytes);
+        put(" [");
+        putDec(allocCount);
+        put(": ");
+        putDec(allocBytes);
+        put("] @");
+    }
+    void putFile(const char * fileName) {
+        int fd = open(fileName, O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        char tmp[0x1000];
+        for (;;) {
+            char * dst = (_pos < _len) ? (_buf + _pos) : tmp;
+            size_t room = (_pos < _len) ? std::min(_len - _pos, sizeof(tmp)) : sizeof(tmp);
+            ssize_t got = read(fd, dst, room);
+            if (got <= 0) {
+                break;
+            }
+            _pos += got;
+        }
+        close(fd);
+    }
+    size_t size() const { return _pos; }
+private:
+    char * _buf;
+    size_t _len;
+    size_t _pos;
+};
+
+}
+
+__thread long HeapProfiler::_bytesUntilSample TLS_LINKAGE = 0;
+std::atomic<size_t> HeapProfiler::_sampleInterval(0);
+std::atomic<uint16_t> HeapProfiler::_filter[FilterSize];
+
+void
+HeapProfiler::start(size_t sampleInterval)
+{
+    if (sampleInterval == 0) {
+        stop();
+        return;
+    }
+    // backtrace may allocate the first time it is used. Get that done
+    // outside of the allocator.
+    void * dummy[1];
+    backtrace(dummy, 1);
+
+    SpinGuard guard(_lock);
+    for (size_t i(0); i < FilterSize; i++) {
+        _filter[i].store(0, std::memory_order_relaxed);
+    }
+    memset(_stacks, 0, sizeof(_stacks));
+    memset(_live, 0, sizeof(_live));
+    _numStacks = 0;
+    _liveCount = 0;
+    _liveBytes = 0;
+    _allocCount = 0;
+    _allocBytes = 0;
+    _droppedSamples = 0;
+    _startTime = time(nullptr);
+    _profileInterval = sampleInterval;
+    _generation.fetch_add(1, std::memory_order_relaxed);
+    _sampleInterval.store(sampleInterval, std::memory_order_relaxed);
+}
+
+void
+HeapProfiler::stop()
+{
+    _sampleInterval.store(0, std::memory_order_relaxed);
+}
+
+void
+HeapProfiler::sampleAlloc(void *ptr, size_t sz)
+{
+    size_t interval(_sampleInterval.load(std::memory_order_relaxed));
+    if (interval == 0) {
+        _bytesUntilSample = DisabledRecheckInterval;
+        return;
+    }
+    uint32_t generation(_generation.load(std::memory_order_relaxed));
+    _bytesUntilSample = nextSampleInterval(interval);
+    if (_threadGeneration != generation) {
+        // The count down was not drawn for this profiling session.
+        _threadGeneration = generation;
+        return;
+    }
+    if (_inProfiler || (ptr == nullptr)) {
+        return;
+    }
+    _inProfiler = true;
+    void * frames[MaxFrames + 1];
+    int depth = backtrace(frames, MaxFrames + 1);
+    // Skip ourselves
+    depth = (depth > 1) ? depth - 1 : 0;
+    SpinGuard guard(_lock);
+    if (_generation.load(std::memory_order_relaxed) == generation) {
+        uint32_t stack(findOrAddStack(frames + 1, depth));
+        if ((stack < MaxStacks) && addLive(ptr, stack, sz)) {
+            StackRecord & s = _stacks[stack];
+            s.liveCount++;
+            s.liveBytes += sz;
+            s.allocCount++;
+            s.allocBytes += sz;
+            _liveCount++;
+            _liveBytes += sz;
+            _allocCount++;
+            _allocBytes += sz;
+            _filter[filterIdx(ptr)].fetch_add(1, std::memory_order_relaxed);
+        } else {
+            _droppedSamples++;
+        }
+    }
+    _inProfiler = false;
+}
+
+void
+HeapProfiler::forget(void *ptr)
+{
+    if (_inProfiler) {
+        return;
+    }
+    SpinGuard guard(_lock);
+    LiveSample removed;
+    if (removeLive(ptr, removed)) {
+        StackRecord & s = _stacks[removed.stack];
+        s.liveCount--;
+        s.liveBytes -= removed.size;
+        _liveCount--;
+        _liveBytes -= removed.size;
+        _filter[filterIdx(ptr)].fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+HeapProfiler::Summary
+HeapProfiler::summary()
+{
+    SpinGuard guard(_lock);
+    Summary s;
+    s.running = isRunning();
+    s.sampleInterval = _profileInterval;
+    s.liveCount = _liveCount;
+    s.liveBytes = _liveBytes;
+    s.allocCount = _allocCount;
+    s.allocBytes = _allocBytes;
+    s.droppedSamples = _droppedSamples;
+    s.startTime = _startTime;
+    return s;
+}
+
+size_t
+HeapProfiler::dump(char *buf, size_t len)
+{
+    Output out(buf, len);
+    {
+        SpinGuard guard(_lock);
+        out.put("heap profile: ");
+        out.putCounts(_liveCount, _liveBytes, _allocCount, _allocBytes);
+        out.put(" heap_v2/");
+        out.putDec(_profileInterval);
+        out.put('\n');
+        for (const StackRecord & s : _stacks) {
+            if (s.allocCount == 0) {
+                continue;
+            }
+            out.putCounts(s.liveCount, s.liveBytes, s.allocCount, s.allocBytes);
+            for (uint32_t i(0); i < s.depth; i++) {
+                out.put(' ');
+                out.putHex(reinterpret_cast<uint64_t>(s.frames[i]));
+            }
+            out.put('\n');
+        }
+    }
+    out.put("\nMAPPED_LIBRARIES:\n");
+    out.putFile("/proc/self/maps");
+    return out.size();
+}
+
+}
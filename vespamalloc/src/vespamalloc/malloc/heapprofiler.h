@@ -0,0 +1,93 @@
+// Copyright 2018 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "threadlist.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace vespamalloc {
+
+/**
+ * Sampling heap profiler cheap enough to be compiled into the
+ * production allocator.
+ *
+ * Each thread counts down the bytes it allocates. When the counter
+ * runs out the allocation is sampled: its call stack is captured and
+ * the block is remembered until it is freed. The distance between
+ * samples is drawn from an exponential distribution with the
+ * configured sample interval as mean, so the profile can be unsampled
+ * the same way pprof does for heap_v2 profiles.
+ *
+ * When the profiler is stopped the only cost on the allocation path
+ * is the thread local count down, and on the free path a lookup in a
+ * small filter of sampled addresses.
+ **/
+class HeapProfiler
+{
+public:
+    enum {
+        MaxFrames = 32,
+        MaxStacks = 8192,
+        MaxLiveSamples = 65536
+    };
+    struct Summary {
+        bool   running;
+        size_t sampleInterval;
+        size_t liveCount;
+        size_t liveBytes;
+        size_t allocCount;
+        size_t allocBytes;
+        size_t droppedSamples;
+        size_t startTime;
+    };
+    /**
+     * Starts sampling with the given mean number of bytes between
+     * samples. Any previously collected samples are discarded.
+     **/
+    static void start(size_t sampleInterval);
+    /**
+     * Stops taking new samples. Frees of sampled blocks are still
+     * tracked, so the collected profile can be dumped afterwards.
+     **/
+    static void stop();
+    static bool isRunning() { return _sampleInterval.load(std::memory_order_relaxed) != 0; }
+    /**
+     * Sampled (not scaled) totals for the live heap and for all
+     * allocations since the profiler was started.
+     **/
+    static Summary summary();
+    /**
+     * Writes the profile in the legacy pprof heap profile text format,
+     * followed by the memory mappings of the process. Returns the
+     * number of bytes needed, which may be larger than len. Does not
+     * allocate memory.
+     **/
+    static size_t dump(char *buf, size_t len);
+
+    static void recordAlloc(void *ptr, size_t sz) {
+        _bytesUntilSample -= sz;
+        if (__builtin_expect(_bytesUntilSample < 0, false)) {
+            sampleAlloc(ptr, sz);
+        }
+    }
+    static void recordFree(void *ptr) {
+        if (__builtin_expect(_filter[filterIdx(ptr)].load(std::memory_order_relaxed) != 0, false)) {
+            forget(ptr);
+        }
+    }
+private:
+    enum { FilterSize = 0x10000 };
+    static uint32_t filterIdx(const void *ptr) {
+        uint64_t v(reinterpret_cast<uint64_t>(ptr) >> 4);
+        return ((v * 0x9e3779b97f4a7c15ul) >> 48);
+    }
+    static void sampleAlloc(void *ptr, size_t sz) __attribute__((noinline));
+    static void forget(void *ptr) __attribute__((noinline));
+
+    static __thread long _bytesUntilSample TLS_LINKAGE;
+    static std::atomic<size_t> _sampleInterval;
+    static std::atomic<uint16_t> _filter[FilterSize];
+};
+
+}
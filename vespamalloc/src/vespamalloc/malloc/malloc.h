@@ -8,6 +8,7 @@
 #include "threadpool.h"
 #include "threadlist.h"
 #include "threadproxy.h"
+#include "heapprofiler.h"
 
 namespace vespamalloc {
 
@@ -162,6 +163,7 @@ void * MemoryManager<MemBlockPtrT, ThreadListT>::malloc(size_t sz)
     PARANOID_CHECK2(if (!mem.validFree() && mem.ptr()) { crash(); } );
     mem.setExact(sz);
     mem.alloc(_prAllocLimit<=mem.adjustSize(sz));
+    HeapProfiler::recordAlloc(mem.ptr(), sz);
     return mem.ptr();
 }
 
@@ -173,6 +175,7 @@ void MemoryManager<MemBlockPtrT, ThreadListT>::freeSC(void *ptr, SizeClassT sc)
         MemBlockPtrT mem(ptr);
         mem.readjustAlignment(_segment);
         if (mem.validAlloc()) {
+            HeapProfiler::recordFree(ptr);
             mem.free();
             tp.free(mem, sc);
         } else if (mem.validFree()) {
@@ -130,6 +130,39 @@ void free(void * ptr) {
     if (ptr) { vespamalloc::_GmemP->free(ptr); }
 }
 
+// Sampling heap profiler. Looked up with dlsym by the state api, so
+// processes not running with vespamalloc simply lack them.
+void vespamalloc_heapprofile_start(size_t sampleInterval) __attribute__((visibility ("default")));
+void vespamalloc_heapprofile_start(size_t sampleInterval)
+{
+    vespamalloc::HeapProfiler::start(sampleInterval);
+}
+
+void vespamalloc_heapprofile_stop() __attribute__((visibility ("default")));
+void vespamalloc_heapprofile_stop()
+{
+    vespamalloc::HeapProfiler::stop();
+}
+
+void vespamalloc_heapprofile_summary(int *running, size_t *sampleInterval, size_t *liveCount, size_t *liveBytes, size_t *allocCount, size_t *allocBytes, size_t *startTime) __attribute__((visibility ("default")));
+void vespamalloc_heapprofile_summary(int *running, size_t *sampleInterval, size_t *liveCount, size_t *liveBytes, size_t *allocCount, size_t *allocBytes, size_t *startTime)
+{
+    vespamalloc::HeapProfiler::Summary summary(vespamalloc::HeapProfiler::summary());
+    *running = summary.running ? 1 : 0;
+    *sampleInterval = summary.sampleInterval;
+    *liveCount = summary.liveCount;
+    *liveBytes = summary.liveBytes;
+    *allocCount = summary.allocCount;
+    *allocBytes = summary.allocBytes;
+    *startTime = summary.startTime;
+}
+
+size_t vespamalloc_heapprofile_dump(char *buf, size_t len) __attribute__((visibility ("default")));
+size_t vespamalloc_heapprofile_dump(char *buf, size_t len)
+{
+    return vespamalloc::HeapProfiler::dump(buf, len);
+}
+
 #define ALIAS(x) __attribute__ ((weak, alias (x), visibility ("default")))
 void cfree(void *)                                   ALIAS("free");
 void* __libc_malloc(size_t sz)                       ALIAS("malloc");
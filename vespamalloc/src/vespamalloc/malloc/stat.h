@@ -12,6 +12,7 @@ public:
     void incFree()          { }
     void incExchangeAlloc() { }
     void incExactAlloc()    { }
+    void incFlush()         { }
 
     static bool isDummy()        { return true; }
     size_t alloc()         const { return 0; }
@@ -20,6 +21,7 @@ public:
     size_t exchangeFree()  const { return 0; }
     size_t returnFree()    const { return 0; }
     size_t exactAlloc()    const { return 0; }
+    size_t flush()         const { return 0; }
     bool   isUsed()        const { return false; }
 };
 
@@ -32,7 +34,8 @@ public:
           _exchangeAlloc(0),
           _exchangeFree(0),
           _exactAlloc(0),
-          _return(0)
+          _return(0),
+          _flush(0)
     { }
     void incAlloc()         { _alloc++; }
     void incExchangeFree()  { _exchangeFree++; }
@@ -40,6 +43,7 @@ public:
     void incFree()          { _free++; }
     void incExchangeAlloc() { _exchangeAlloc++; }
     void incExactAlloc()    { _exactAlloc++; }
+    void incFlush()         { _flush++; }
 
     bool isUsed()       const {
         return (_alloc || _free || _exchangeAlloc || _exchangeFree || _exactAlloc || _return);
@@ -51,6 +55,7 @@ public:
     size_t exchangeFree()  const { return _exchangeFree; }
     size_t exactAlloc()    const { return _exactAlloc; }
     size_t returnFree()    const { return _return; }
+    size_t flush()         const { return _flush; }
 private:
     size_t _free;
     size_t _alloc;
@@ -58,6 +63,7 @@ private:
     size_t _exchangeFree;
     size_t _exactAlloc;
     size_t _return;
+    size_t _flush;
 };
 
 }
@@ -27,10 +27,12 @@ void ThreadListT<MemBlockPtrT, ThreadStatT>::info(FILE * os, size_t level)
 {
     size_t peakThreads(0);
     size_t activeThreads(0);
+    size_t cachedBytes(0);
     for (size_t i(0); i < getMaxNumThreads(); i++) {
         const ThreadPool & thread = _threadVector[i];
         if (thread.isActive()) {
             activeThreads++;
+            cachedBytes += thread.cachedBytes();
             if ( ! ThreadStatT::isDummy()) {
                 fprintf(os, "Thread #%ld = pid # %d\n", i, thread.osThreadId());
                 if (thread.isUsed()) {
@@ -41,12 +43,16 @@ void ThreadListT<MemBlockPtrT, ThreadStatT>::info(FILE * os, size_t level)
         }
     }
     fprintf(os, "#%ld active threads. Peak threads #%ld\n", activeThreads, peakThreads);
+    fprintf(os, "%ld bytes cached in active threads\n", cachedBytes);
 }
 
 template <typename MemBlockPtrT, typename ThreadStatT>
 bool ThreadListT<MemBlockPtrT, ThreadStatT>::quitThisThread()
 {
     ThreadPool & tp = getCurrent();
+    // The slot may not be reused by another thread for a long time,
+    // so do not let it keep memory.
+    tp.flushCaches();
     tp.quit();
     _threadCount.fetch_sub(1);
     return true;
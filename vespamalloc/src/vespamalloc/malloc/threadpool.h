@@ -35,6 +35,15 @@ public:
     bool isUsed() const;
     int osThreadId()       const { return _osThreadId; }
     void quit() { _osThreadId = 0; } // Implicit memory barrier
+    /**
+     * Hand all blocks cached by this thread back to the global pool,
+     * so that they can be used by other threads.
+     */
+    void flushCaches() __attribute__((noinline));
+    /**
+     * @return number of bytes cached by this thread.
+     */
+    size_t cachedBytes() const;
     void init(int thrId);
     static void setParams(size_t alwayReuseLimit, size_t threadCacheLimit);
     bool grabAvailable();
@@ -19,12 +19,15 @@ void ThreadPoolT<MemBlockPtrT, ThreadStatT>::info(FILE * os, size_t level, const
             if (s.isUsed()) {
                 size_t localAvailCount((af._freeTo ? af._freeTo->count() : 0)
                                        + (af._allocFrom ? af._allocFrom->count() : 0));
+                size_t misses(s.exchangeAlloc() + s.exactAlloc());
+                double hitRate((s.alloc() > misses) ? (100.0 * (s.alloc() - misses)) / s.alloc() : 0.0);
                 fprintf(os, "SC %2ld(%10ld) Local(%3ld) Alloc(%10ld), "
                         "Free(%10ld) ExchangeAlloc(%8ld), ExChangeFree(%8ld) "
-                        "Returned(%8ld) ExactAlloc(%8ld)\n",
+                        "Returned(%8ld) ExactAlloc(%8ld) Flushed(%6ld) CacheHit(%5.1f%%)\n",
                         i, MemBlockPtrT::classSize(i), localAvailCount,
                         s.alloc(), s.free(), s.exchangeAlloc(),
-                        s.exchangeFree(), s.returnFree(), s.exactAlloc());
+                        s.exchangeFree(), s.returnFree(), s.exactAlloc(),
+                        s.flush(), hitRate);
             }
         }
     }
@@ -153,6 +156,42 @@ void ThreadPoolT<MemBlockPtrT, ThreadStatT>::free(MemBlockPtrT mem, SizeClassT s
     PARANOID_CHECK2(if (af._freeTo->full()) { *(int *)1 = 1; } );
 }
 
+template <typename MemBlockPtrT, typename ThreadStatT >
+void ThreadPoolT<MemBlockPtrT, ThreadStatT>::flushCaches()
+{
+    for (size_t i=0; i < NELEMS(_memList); i++) {
+        AllocFree & af = _memList[i];
+        if (af._allocFrom == NULL) {
+            continue;
+        }
+        bool flushed(false);
+        if ( ! af._allocFrom->empty()) {
+            af._allocFrom = _allocPool->exchangeFree(i, af._allocFrom);
+            flushed = true;
+        }
+        if ( ! af._freeTo->empty()) {
+            af._freeTo = _allocPool->exchangeFree(i, af._freeTo);
+            flushed = true;
+        }
+        if (flushed) {
+            _stat[i].incFlush();
+        }
+    }
+}
+
+template <typename MemBlockPtrT, typename ThreadStatT >
+size_t ThreadPoolT<MemBlockPtrT, ThreadStatT>::cachedBytes() const
+{
+    size_t sum(0);
+    for (size_t i=0; i < NELEMS(_memList); i++) {
+        const AllocFree & af = _memList[i];
+        if (af._allocFrom != NULL) {
+            sum += (af._allocFrom->count() + af._freeTo->count()) * MemBlockPtrT::classSize(i);
+        }
+    }
+    return sum;
+}
+
 template <typename MemBlockPtrT, typename ThreadStatT >
 bool ThreadPoolT<MemBlockPtrT, ThreadStatT>::isActive() const
 {
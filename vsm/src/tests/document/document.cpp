@@ -14,6 +14,7 @@ class DocumentTest : public vespalib::TestApp
 {
 private:
     void testStorageDocument();
+    void testPrefetchFields();
     void testStringFieldIdTMap();
 public:
     int Main() override;
@@ -75,6 +76,43 @@ DocumentTest::testStorageDocument()
     EXPECT_EQUAL(vespalib::string("null::"), s2.docDoc().getId().toString());
 }
 
+void
+DocumentTest::testPrefetchFields()
+{
+    DocumentType dt("testdoc", 0);
+    Field fa("a", 0, *DataType::STRING, true);
+    Field fb("b", 1, *DataType::STRING, true);
+    dt.addField(fa);
+    dt.addField(fb);
+
+    SharedFieldPathMap fpmap(new FieldPathMapT());
+    fpmap->emplace_back();
+    dt.buildFieldPath(fpmap->back(),"a");
+    fpmap->emplace_back();
+    dt.buildFieldPath(fpmap->back(), "b");
+    fpmap->emplace_back();
+
+    document::Document::UP doc1(new document::Document(dt, DocumentId()));
+    doc1->setValue(fa, StringFieldValue("foo"));
+    document::Document::UP doc2(new document::Document(dt, DocumentId()));
+    doc2->setValue(fa, StringFieldValue("bar"));
+    doc2->setValue(fb, StringFieldValue("baz"));
+    StorageDocument sdoc1(std::move(doc1), fpmap, 3);
+    StorageDocument sdoc2(std::move(doc2), fpmap, 3);
+
+    // prefetched values are owned by each document, not shared through the field path map
+    std::vector<FieldIdT> fields = {0, 1, 2, 3};
+    sdoc1.prefetchFields(fields);
+    sdoc2.prefetchFields(fields);
+    EXPECT_EQUAL(std::string("foo"), sdoc1.getField(0)->getAsString());
+    EXPECT_TRUE(sdoc1.getField(1) == NULL);
+    EXPECT_TRUE(sdoc1.getField(2) == NULL);
+    EXPECT_EQUAL(std::string("bar"), sdoc2.getField(0)->getAsString());
+    EXPECT_EQUAL(std::string("baz"), sdoc2.getField(1)->getAsString());
+    EXPECT_TRUE(sdoc2.getField(2) == NULL);
+    EXPECT_TRUE(sdoc1.getField(0) != sdoc2.getField(0));
+}
+
 void DocumentTest::testStringFieldIdTMap()
 {
     StringFieldIdTMap m;
@@ -118,6 +156,7 @@ DocumentTest::Main()
     TEST_INIT("document_test");
 
     testStorageDocument();
+    testPrefetchFields();
     testStringFieldIdTMap();
 
     TEST_DONE();
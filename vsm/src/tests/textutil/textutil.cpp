@@ -225,6 +225,25 @@ TextUtilTest::test_lfoldua()
     size_t len = strlen(toFold);
     EXPECT_TRUE(FSFS::lfoldua(toFold, len, folded, alignedStart));
     EXPECT_EQUAL(std::string(folded + alignedStart, len), "abcdefghijklmnopqrstuvwxyz");
+
+    // vectorized folding must match the scalar one for all lengths and ascii characters
+    std::string ascii;
+    for (size_t i = 0; i < 300; ++i) {
+        ascii.push_back(char((i * 7) % 128));
+    }
+    char expected[512];
+    char lfolded[512];
+    for (size_t sz = 0; sz <= ascii.size(); ++sz) {
+        EXPECT_TRUE(FSFS::ansiFold(ascii.c_str(), sz, expected));
+        EXPECT_TRUE(FSFS::lfoldua(ascii.c_str(), sz, lfolded, alignedStart));
+        EXPECT_EQUAL(std::string(expected, sz), std::string(lfolded + alignedStart, sz));
+    }
+    // a non-ascii character anywhere makes it fail
+    for (size_t pos = 0; pos < ascii.size(); ++pos) {
+        std::string nonAscii(ascii);
+        nonAscii[pos] = char(0xc3);
+        EXPECT_FALSE(FSFS::lfoldua(nonAscii.c_str(), nonAscii.size(), lfolded, alignedStart));
+    }
 }
 
 void
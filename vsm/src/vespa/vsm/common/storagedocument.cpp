@@ -66,6 +66,27 @@ StorageDocument::getField(FieldIdT fId) const
     return getComplexField(fId).getFieldValue();
 }
 
+void StorageDocument::prefetchFields(const std::vector<FieldIdT> & fields)
+{
+    for (FieldIdT fId : fields) {
+        if ((fId >= _cachedFields.size()) || (_cachedFields[fId].getFieldValue() != NULL)) {
+            continue;
+        }
+        const FieldPath & fp = (*_fieldMap)[fId];
+        if (fp.empty()) {
+            continue;
+        }
+        NestedIterator nested = fp.getFullRange();
+        const document::Field & field = nested.cur().getFieldRef();
+        document::FieldValue::UP fv(field.getDataType().createFieldValue());
+        if (_doc->getValue(field, *fv)) {
+            _backedFields.emplace_back(std::move(fv));
+            SubDocument tmp(_backedFields.back().get(), nested.next());
+            _cachedFields[fId].swap(tmp);
+        }
+    }
+}
+
 bool StorageDocument::setField(FieldIdT fId, document::FieldValue::UP fv)
 {
     bool ok(fId < _cachedFields.size());
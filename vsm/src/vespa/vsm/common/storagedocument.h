@@ -47,6 +47,13 @@ public:
     const SubDocument &getComplexField(FieldIdT fId) const;
     const document::FieldValue *getField(FieldIdT fId) const override;
     bool setField(FieldIdT fId, document::FieldValue::UP fv) override ;
+    /**
+     * Fetch the given fields into values owned by this document, so
+     * that later lookups are cheap. Unlike getField() this does not
+     * use the values kept in the shared field path map, so documents
+     * sharing that map may prefetch in parallel.
+     */
+    void prefetchFields(const std::vector<FieldIdT> & fields);
     void saveCachedFields() const;
 private:
     document::Document::UP _doc;
@@ -2,14 +2,27 @@
 
 #include "futf8strchrfieldsearcher.h"
 #include "fold.h"
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
 
 using vespalib::Optimized;
+using vespalib::hwaccelrated::IAccelrated;
 using search::byte;
 using search::QueryTerm;
 using search::v16qi;
 
 namespace vsm {
 
+namespace {
+
+const IAccelrated &
+getAccelrator()
+{
+    static IAccelrated::UP accelrator = IAccelrated::getAccelrator();
+    return *accelrator;
+}
+
+}
+
 IMPLEMENT_DUPLICATE(FUTF8StrChrFieldSearcher);
 
 FUTF8StrChrFieldSearcher::FUTF8StrChrFieldSearcher()
@@ -65,21 +78,11 @@ FUTF8StrChrFieldSearcher::lfoldaa(const char * toFold, size_t sz, char * folded,
 bool
 FUTF8StrChrFieldSearcher::lfoldua(const char * toFold, size_t sz, char * folded, size_t & alignedStart)
 {
-  bool retval(true);
-
   alignedStart =  0xF - (size_t(folded + 0xF) % 0x10);
 
-  size_t alignsz16 = sz & 0xFFFFFFF0;
-  size_t rest = sz - alignsz16;
-
-  if (alignsz16) {
-    const byte * end = sse2_foldua(reinterpret_cast<const byte *>(toFold), alignsz16, reinterpret_cast<byte *>(folded+alignedStart));
-    retval = (end == reinterpret_cast<const byte *>(toFold+alignsz16));
-  }
-  if(rest && retval) {
-    retval = ansiFold(toFold + alignsz16, rest, folded+alignedStart+alignsz16);
-  }
-  return retval;
+  // Widest vectors the cpu supports, the scalar fold handles the tail and finds any non-ascii byte.
+  size_t vectorsz = getAccelrator().foldAsciiWords(toFold, sz, folded+alignedStart);
+  return ansiFold(toFold + vectorsz, sz - vectorsz, folded+alignedStart+vectorsz);
 }
 
 namespace {